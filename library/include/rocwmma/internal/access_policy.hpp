@@ -0,0 +1,248 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_ACCESS_POLICY_HPP
+#define ROCWMMA_ACCESS_POLICY_HPP
+
+#include "api_fwd.hpp"
+#include "types.hpp"
+
+namespace rocwmma
+{
+
+    namespace detail
+    {
+        // Raw storage types of a given size that are accepted by the nontemporal builtins
+        template <uint32_t Bytes>
+        struct cache_policy_raw;
+
+        template <>
+        struct cache_policy_raw<1u>
+        {
+            using Type = int8_t;
+        };
+
+        template <>
+        struct cache_policy_raw<2u>
+        {
+            using Type = int16_t;
+        };
+
+        template <>
+        struct cache_policy_raw<4u>
+        {
+            using Type = int32_t;
+        };
+
+        template <>
+        struct cache_policy_raw<8u>
+        {
+            using Type = int32_t __attribute__((ext_vector_type(2)));
+        };
+
+        template <>
+        struct cache_policy_raw<16u>
+        {
+            using Type = int32_t __attribute__((ext_vector_type(4)));
+        };
+
+        // Raw memory access of a single IO vector with an access policy.
+        // Default policy is a regular cached access.
+        template <class AccessPolicy, typename T>
+        struct amdgcn_access_policy
+        {
+            ROCWMMA_DEVICE static inline void load(T& data, T const* dataPtr)
+            {
+                data = *dataPtr;
+            }
+
+            ROCWMMA_DEVICE static inline void store(T* dataPtr, T const& data)
+            {
+                *dataPtr = data;
+            }
+        };
+
+        // Non-temporal access marks the data as having no expected reuse. The
+        // backend maps the nontemporal hint to the streaming cache policy bits
+        // of the target (GLC/SLC on gfx9 and gfx11, NT on gfx94x, TH_NT on gfx12).
+        // IO vectors are split into the largest raw chunks that divide them.
+        template <typename T>
+        struct amdgcn_access_policy<cache_non_temporal, T>
+        {
+            enum : uint32_t
+            {
+                Bytes     = sizeof(T),
+                ChunkSize = (Bytes % 16u == 0u)  ? 16u
+                            : (Bytes % 8u == 0u) ? 8u
+                            : (Bytes % 4u == 0u) ? 4u
+                            : (Bytes % 2u == 0u) ? 2u
+                                                 : 1u,
+                Chunks    = Bytes / ChunkSize
+            };
+
+            using RawT = typename cache_policy_raw<ChunkSize>::Type;
+
+            ROCWMMA_DEVICE static inline void load(T& data, T const* dataPtr)
+            {
+                auto rawPtr = reinterpret_cast<RawT const*>(dataPtr);
+
+#pragma unroll
+                for(uint32_t i = 0; i < Chunks; i++)
+                {
+                    auto raw = __builtin_nontemporal_load(rawPtr + i);
+                    __builtin_memcpy(reinterpret_cast<char*>(&data) + i * ChunkSize,
+                                     &raw,
+                                     ChunkSize);
+                }
+            }
+
+            ROCWMMA_DEVICE static inline void store(T* dataPtr, T const& data)
+            {
+                auto rawPtr = reinterpret_cast<RawT*>(dataPtr);
+
+#pragma unroll
+                for(uint32_t i = 0; i < Chunks; i++)
+                {
+                    RawT raw;
+                    __builtin_memcpy(&raw,
+                                     reinterpret_cast<char const*>(&data) + i * ChunkSize,
+                                     ChunkSize);
+                    __builtin_nontemporal_store(raw, rawPtr + i);
+                }
+            }
+        };
+
+        // Local memory access of a single IO vector. Generic pointers are cast to the LDS
+        // address space, such that the backend emits ds_read / ds_write instead of flat
+        // accesses. Vectors are split into naturally aligned chunks of up to 16B, accessed
+        // with ds_read_b128 / ds_write_b128, and the backend pairs the chunks at constant
+        // offsets of each thread into ds_read2(st64) / ds_write2(st64).
+        template <typename T>
+        struct amdgcn_lds_access
+        {
+            enum : uint32_t
+            {
+                Bytes     = sizeof(T),
+                ChunkSize = (Bytes % 16u == 0u)  ? 16u
+                            : (Bytes % 8u == 0u) ? 8u
+                            : (Bytes % 4u == 0u) ? 4u
+                            : (Bytes % 2u == 0u) ? 2u
+                                                 : 1u,
+                Chunks    = Bytes / ChunkSize
+            };
+
+            using RawT    = typename cache_policy_raw<ChunkSize>::Type;
+            using LdsRawT = __attribute__((address_space(3))) RawT;
+
+            ROCWMMA_DEVICE static inline void load(T& data, T const* dataPtr)
+            {
+                auto rawPtr = (LdsRawT const*)(reinterpret_cast<RawT const*>(dataPtr));
+
+#pragma unroll
+                for(uint32_t i = 0; i < Chunks; i++)
+                {
+                    RawT raw = rawPtr[i];
+                    __builtin_memcpy(reinterpret_cast<char*>(&data) + i * ChunkSize,
+                                     &raw,
+                                     ChunkSize);
+                }
+            }
+
+            ROCWMMA_DEVICE static inline void store(T* dataPtr, T const& data)
+            {
+                auto rawPtr = (LdsRawT*)(reinterpret_cast<RawT*>(dataPtr));
+
+#pragma unroll
+                for(uint32_t i = 0; i < Chunks; i++)
+                {
+                    RawT raw;
+                    __builtin_memcpy(&raw,
+                                     reinterpret_cast<char const*>(&data) + i * ChunkSize,
+                                     ChunkSize);
+                    rawPtr[i] = raw;
+                }
+            }
+        };
+
+        template <typename T>
+        struct amdgcn_access_policy<lds_access, T> : public amdgcn_lds_access<T>
+        {
+        };
+
+        // XOR swizzle of absolute byte addresses. Each RowBytes row permutes its chunks of
+        // ChunkBytes within aligned windows of Phases * ChunkBytes, by XOR with the row index
+        // modulo Phases. Since the XOR is an involution on each window, the mapping is a
+        // bijection over any region whose base and size are multiples of the window.
+        template <uint32_t Phases, uint32_t ChunkBytes, uint32_t RowBytes>
+        struct XorSwizzle
+        {
+            static_assert(Phases > 0u && (Phases & (Phases - 1u)) == 0u,
+                          "Phases must be a power of 2");
+            static_assert(ChunkBytes > 0u && (ChunkBytes & (ChunkBytes - 1u)) == 0u,
+                          "ChunkBytes must be a power of 2");
+            static_assert(RowBytes > 0u && (RowBytes & (RowBytes - 1u)) == 0u,
+                          "RowBytes must be a power of 2");
+            static_assert(Phases * ChunkBytes <= RowBytes,
+                          "Swizzle window must not exceed the row size");
+
+            ROCWMMA_HOST_DEVICE constexpr static inline uintptr_t exec(uintptr_t addr)
+            {
+                return addr ^ (((addr / RowBytes) % Phases) * ChunkBytes);
+            }
+
+            template <typename T>
+            ROCWMMA_HOST_DEVICE static inline T* exec(T* ptr)
+            {
+                return reinterpret_cast<T*>(exec(reinterpret_cast<uintptr_t>(ptr)));
+            }
+        };
+
+        // Swizzled access moves each IO vector to its swizzled address. Vectors must be
+        // aligned to their size and must not straddle a chunk boundary. Swizzled data is
+        // local memory, accessed as with lds_access.
+        template <uint32_t Phases, uint32_t ChunkBytes, uint32_t RowBytes, typename T>
+        struct amdgcn_access_policy<xor_swizzle<Phases, ChunkBytes, RowBytes>, T>
+        {
+            using Swizzle = XorSwizzle<Phases, ChunkBytes, RowBytes>;
+
+            static_assert(sizeof(T) <= ChunkBytes,
+                          "IO vector size must not exceed the swizzle chunk size");
+
+            ROCWMMA_DEVICE static inline void load(T& data, T const* dataPtr)
+            {
+                amdgcn_lds_access<T>::load(data, Swizzle::exec(dataPtr));
+            }
+
+            ROCWMMA_DEVICE static inline void store(T* dataPtr, T const& data)
+            {
+                amdgcn_lds_access<T>::store(Swizzle::exec(dataPtr), data);
+            }
+        };
+
+    } // namespace detail
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_ACCESS_POLICY_HPP
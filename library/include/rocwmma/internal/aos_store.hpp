@@ -0,0 +1,74 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_AOS_STORE_HPP
+#define ROCWMMA_AOS_STORE_HPP
+
+#include "opaque_store.hpp"
+#include "transforms.hpp"
+#include "types.hpp"
+
+namespace rocwmma
+{
+
+    // Stores a block from the SOA register layout of the mma through wide IO vectors.
+    // Each IO is first moved to AOS order in registers, such that vectors of VectorWidth
+    // run along BlockDim (MatrixLayout is ColInlineVW or RowInlineVW). This replaces
+    // VectorWidth 1 stores in mma order, with VectorWidth times fewer stores.
+    // E.g. row_major accumulators of 32 x 32 mma hold 4 rows of one column per lane, and
+    // store 4 columns of one row per lane after the transform.
+    template <uint32_t BlockDim,
+              uint32_t BlockK,
+              typename DataT,
+              class DataLayout,
+              class MatrixLayout,
+              uint32_t VectorWidth,
+              class AccessPolicy = cache_default>
+    struct AosStore
+    {
+        using AosStorer = OpaqueStore<BlockDim,
+                                      BlockK,
+                                      DataT,
+                                      DataLayout,
+                                      MatrixLayout,
+                                      VectorWidth,
+                                      AccessPolicy>;
+
+        struct Traits
+        {
+            using StoreT = typename AosStorer::Traits::StoreT;
+            using InputT = typename AosStorer::Traits::InputT;
+        };
+
+        ROCWMMA_DEVICE static inline void
+            exec(DataT* dataPtr, typename Traits::InputT const& data, uint32_t ldm)
+        {
+            AosStorer::exec(dataPtr, Transforms::SoaToAos<BlockDim, VectorWidth>::exec(data), ldm);
+        }
+    };
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_AOS_STORE_HPP
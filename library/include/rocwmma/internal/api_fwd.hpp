@@ -34,6 +34,15 @@ namespace rocwmma
     struct matrix_a;
     struct matrix_b;
     struct accumulator;
+    struct cache_default;
+    struct cache_non_temporal;
+    struct lds_access;
+    template <uint32_t Phases, uint32_t ChunkBytes, uint32_t RowBytes>
+    struct xor_swizzle;
+    struct conv2d_nhwc;
+    struct conv2d_nhwc_dgrad;
+    struct conv2d_nhwc_grouped;
+    struct tensor_view;
 
     template <typename MatrixT,
               uint32_t BlockM,
@@ -0,0 +1,200 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_ASYNC_LOAD_HPP
+#define ROCWMMA_ASYNC_LOAD_HPP
+
+#include "constants.hpp"
+#include "flow_control.hpp"
+#include "layout.hpp"
+#include "mapping_util.hpp"
+#include "types.hpp"
+#include "utils.hpp"
+
+// Compiler support for direct global to LDS loads
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_amdgcn_global_load_lds)
+#define ROCWMMA_GLOBAL_LOAD_LDS_BUILTIN 1
+#endif
+#endif
+
+#if !defined(ROCWMMA_GLOBAL_LOAD_LDS_BUILTIN)
+#define ROCWMMA_GLOBAL_LOAD_LDS_BUILTIN 0
+#endif
+
+// Direct global to LDS loads are enabled for gfx94x targets
+#if ROCWMMA_GLOBAL_LOAD_LDS_BUILTIN \
+    && (ROCWMMA_ARCH_GFX940 || ROCWMMA_ARCH_GFX941 || ROCWMMA_ARCH_GFX942)
+#define ROCWMMA_ASYNC_LOAD_LDS_DIRECT 1
+#else
+#define ROCWMMA_ASYNC_LOAD_LDS_DIRECT 0
+#endif
+
+namespace rocwmma
+{
+
+    namespace detail
+    {
+        // Direct global to LDS transfers are available on gfx94x
+        // via global_load_lds_dword. Each lane moves one dword from its own
+        // global address to (LDS base + lane * 4).
+        struct amdgcn_global_load_lds_dword
+        {
+            struct Traits
+            {
+                enum : uint32_t
+                {
+                    Bytes = Constants::AMDGCN_DWORD_SIZE_BYTES,
+
+                    // Whether the transfer bypasses VGPRs entirely.
+                    IsDirect = ROCWMMA_ASYNC_LOAD_LDS_DIRECT,
+                };
+            };
+
+            // ldsBase must be wave-uniform.
+            // Fallback path stages through a VGPR, which is functionally equivalent.
+            ROCWMMA_DEVICE static inline void
+                exec(void* ldsBase, void const* globalAddr, uint32_t laneId)
+            {
+#if ROCWMMA_ASYNC_LOAD_LDS_DIRECT
+                using GlobalPtrT = __attribute__((address_space(1))) void*;
+                using LocalPtrT  = __attribute__((address_space(3))) void*;
+
+                __builtin_amdgcn_global_load_lds((GlobalPtrT)(const_cast<void*>(globalAddr)),
+                                                 (LocalPtrT)(ldsBase),
+                                                 Traits::Bytes,
+                                                 0, // Instruction offset
+                                                 0); // Aux / cache policy
+#else
+                reinterpret_cast<uint32_t*>(ldsBase)[laneId]
+                    = *reinterpret_cast<uint32_t const*>(globalAddr);
+#endif // ROCWMMA_ASYNC_LOAD_LDS_DIRECT
+            }
+        };
+
+    } // namespace detail
+
+    /*! \struct AsyncLoad
+    *  \brief Cooperatively moves a 2D block of data from global memory into LDS
+    *         without the data having to be held in fragment registers.
+    *
+    *  The block is moved in dword granularity, each wave instruction moving
+    *  AMDGCN_WAVE_SIZE contiguous dwords. The LDS destination is densely packed with
+    *  the same DataLayout as the source, such that its leading dimension equals
+    *  the contiguous block extent (BlockHeight for col_major, BlockWidth for row_major).
+    *
+    *  IO work items are assigned round-robin to waves. Each wave issues exactly
+    *  Traits::IssueCount instructions so that wait counts can be reasoned about statically.
+    *  Waves having fewer work items re-issue their last item, which is benign
+    *  because it writes the same data to the same LDS location.
+    *
+    * @tparam BlockHeight Height of the block
+    * @tparam BlockWidth Width of the block
+    * @tparam DataT Data type
+    * @tparam DataLayoutT In-memory layout of the block as row_major or col_major
+    * @tparam WaveCount Count of cooperating waves
+    */
+    template <uint32_t BlockHeight,
+              uint32_t BlockWidth,
+              typename DataT,
+              typename DataLayoutT,
+              uint32_t WaveCount>
+    struct AsyncLoad
+    {
+        using Loader = detail::amdgcn_global_load_lds_dword;
+
+        struct Traits
+        {
+            enum : uint32_t
+            {
+                // Contiguous line geometry in memory
+                LineLength = is_same<DataLayoutT, row_major>::value ? BlockWidth : BlockHeight,
+                LineCount  = is_same<DataLayoutT, row_major>::value ? BlockHeight : BlockWidth,
+                LineDwords = LineLength * sizeof(DataT) / Loader::Traits::Bytes,
+
+                // Wave IO geometry
+                TotalDwords = LineDwords * LineCount,
+                IOCount     = ceilDiv(TotalDwords, (uint32_t)Constants::AMDGCN_WAVE_SIZE),
+                IssueCount  = ceilDiv(IOCount, WaveCount),
+
+                // Leading dimension of the packed LDS destination
+                LdsLd = LineLength,
+
+                IsDirect = Loader::Traits::IsDirect,
+            };
+        };
+
+        static_assert(!is_same<DataLayoutT, void>::value, "Must provide a data layout");
+        static_assert(WaveCount > 0u, "WaveCount must be greater than 0");
+        static_assert((BlockHeight * BlockWidth * sizeof(DataT)) % Loader::Traits::Bytes == 0u,
+                      "Block size must be a multiple of dwords");
+        static_assert((Traits::LineLength * sizeof(DataT)) % Loader::Traits::Bytes == 0u,
+                      "Contiguous block dimension must be a multiple of dwords");
+
+        ROCWMMA_DEVICE static inline void
+            exec(DataT* ldsPtr, DataT const* dataPtr, uint32_t ldm, uint32_t waveIndex)
+        {
+            using Bytes = uint8_t;
+
+            auto const laneId   = detail::WaveSpace<>::localLaneId();
+            auto const ldmBytes = ldm * static_cast<uint32_t>(sizeof(DataT));
+
+            // Keep wave-uniform quantities in SGPRs
+            waveIndex = __builtin_amdgcn_readfirstlane(waveIndex);
+
+#pragma unroll
+            for(uint32_t i = 0; i < Traits::IssueCount; i++)
+            {
+                auto ioIndex = min(waveIndex + i * WaveCount, (uint32_t)Traits::IOCount - 1u);
+
+                // Current lane dword position in the flattened block
+                auto dword = ioIndex * Constants::AMDGCN_WAVE_SIZE + laneId;
+                auto line  = dword / Traits::LineDwords;
+                auto inner = dword % Traits::LineDwords;
+
+                auto* ldsBase = reinterpret_cast<Bytes*>(ldsPtr)
+                                + ioIndex * Constants::AMDGCN_WAVE_SIZE * Loader::Traits::Bytes;
+                auto const* globalAddr = reinterpret_cast<Bytes const*>(dataPtr)
+                                         + line * ldmBytes + inner * Loader::Traits::Bytes;
+
+                // Only the last IO may be partial
+                if constexpr(Traits::TotalDwords % Constants::AMDGCN_WAVE_SIZE != 0u)
+                {
+                    if(dword < Traits::TotalDwords)
+                    {
+                        Loader::exec(ldsBase, globalAddr, laneId);
+                    }
+                }
+                else
+                {
+                    Loader::exec(ldsBase, globalAddr, laneId);
+                }
+            }
+        }
+    };
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_ASYNC_LOAD_HPP
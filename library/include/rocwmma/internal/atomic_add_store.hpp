@@ -0,0 +1,319 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_ATOMIC_ADD_STORE_HPP
+#define ROCWMMA_ATOMIC_ADD_STORE_HPP
+
+#include "io_traits.hpp"
+#include "layout.hpp"
+#include "types.hpp"
+#include "vector_iterator.hpp"
+
+// Packed 16-bit float atomic adds on global memory:
+// global_atomic_pk_add_f16 on gfx90a, gfx94x and gfx12,
+// global_atomic_pk_add_bf16 on gfx94x and gfx12.
+#if ROCWMMA_ARCH_GFX90A || ROCWMMA_ARCH_GFX940 || ROCWMMA_ARCH_GFX941 || ROCWMMA_ARCH_GFX942 \
+    || ROCWMMA_ARCH_GFX12
+#define ROCWMMA_ATOMIC_PK_ADD_F16 1
+#else
+#define ROCWMMA_ATOMIC_PK_ADD_F16 0
+#endif
+
+#if ROCWMMA_ARCH_GFX940 || ROCWMMA_ARCH_GFX941 || ROCWMMA_ARCH_GFX942 || ROCWMMA_ARCH_GFX12
+#define ROCWMMA_ATOMIC_PK_ADD_BF16 1
+#else
+#define ROCWMMA_ATOMIC_PK_ADD_BF16 0
+#endif
+
+namespace rocwmma
+{
+
+    namespace detail
+    {
+
+        // Atomic adds of 16-bit floats on the dword holding them. The lower element
+        // of the dword is the first in memory.
+        template <typename DataT>
+        struct amdgcn_atomic_add_16b
+        {
+            static_assert(sizeof(DataT) == 2u, "DataT must be a 16-bit type");
+
+            // Packed vector types of the builtins
+            using PackedF16T = _Float16 __attribute__((ext_vector_type(2)));
+#if __clang_major__ >= 19
+            using PackedBF16T = __bf16 __attribute__((ext_vector_type(2)));
+#else
+            using PackedBF16T = short __attribute__((ext_vector_type(2)));
+#endif // __clang_major__ >= 19
+
+            ROCWMMA_DEVICE static inline uint32_t bits(DataT value)
+            {
+                return static_cast<uint32_t>(__builtin_bit_cast(uint16_t, value));
+            }
+
+            ROCWMMA_DEVICE static inline uint32_t add(uint32_t bits, DataT value)
+            {
+                auto old = __builtin_bit_cast(DataT, static_cast<uint16_t>(bits));
+                return amdgcn_atomic_add_16b::bits(static_cast<DataT>(
+                    static_cast<float32_t>(old) + static_cast<float32_t>(value)));
+            }
+
+            // Compare-and-swap loop adding lo and / or hi to the halves of the dword.
+            // A half that is not added is left unchanged.
+            ROCWMMA_DEVICE static inline void
+                exec_cas(uint32_t* word, DataT lo, DataT hi, bool addLo, bool addHi)
+            {
+                auto old = __hip_atomic_load(word, __ATOMIC_RELAXED, __HIP_MEMORY_SCOPE_AGENT);
+                auto assumed = old;
+                do
+                {
+                    assumed      = old;
+                    auto wordLo  = assumed & 0xFFFFu;
+                    auto wordHi  = assumed >> 16u;
+                    auto updated = (addLo ? add(wordLo, lo) : wordLo)
+                                   | ((addHi ? add(wordHi, hi) : wordHi) << 16u);
+                    old          = atomicCAS(word, assumed, updated);
+                } while(assumed != old);
+            }
+
+            // Adds the contiguous pair (lo, hi) at a dword aligned address
+            ROCWMMA_DEVICE static inline void exec_pair(DataT* dataPtr, DataT lo, DataT hi)
+            {
+                auto packed = bits(lo) | (bits(hi) << 16u);
+
+#if ROCWMMA_ATOMIC_PK_ADD_F16
+                if constexpr(is_same_v<DataT, float16_t> || is_same_v<DataT, hfloat16_t>)
+                {
+                    using GlobalPtrT = __attribute__((address_space(1))) PackedF16T*;
+                    __builtin_amdgcn_global_atomic_fadd_v2f16(
+                        (GlobalPtrT)(dataPtr), __builtin_bit_cast(PackedF16T, packed));
+                    return;
+                }
+#endif // ROCWMMA_ATOMIC_PK_ADD_F16
+
+#if ROCWMMA_ATOMIC_PK_ADD_BF16
+                if constexpr(is_same_v<DataT, bfloat16_t>)
+                {
+                    using GlobalPtrT = __attribute__((address_space(1))) PackedBF16T*;
+                    __builtin_amdgcn_global_atomic_fadd_v2bf16(
+                        (GlobalPtrT)(dataPtr), __builtin_bit_cast(PackedBF16T, packed));
+                    return;
+                }
+#endif // ROCWMMA_ATOMIC_PK_ADD_BF16
+
+                (void)packed;
+                exec_cas(reinterpret_cast<uint32_t*>(dataPtr), lo, hi, true, true);
+            }
+
+            // Adds a single element, in the lower or upper half of its dword
+            ROCWMMA_DEVICE static inline void exec_single(DataT* dataPtr, DataT value)
+            {
+                auto addr = reinterpret_cast<uintptr_t>(dataPtr);
+                auto word = reinterpret_cast<uint32_t*>(addr & ~static_cast<uintptr_t>(3u));
+                auto isHi = (addr & 2u) != 0u;
+                exec_cas(word, value, value, !isHi, isHi);
+            }
+
+            // Single elements held by neighbouring lanes are paired: in accumulator layouts with
+            // a vector width of 1, lanes 2i and 2i + 1 hold adjacent elements of the minor
+            // dimension. The lower lane of a dword aligned pair issues the packed add for both,
+            // any other element is added on its own. Must be called by the entire wave.
+            ROCWMMA_DEVICE static inline void exec_lane_pair(DataT* dataPtr, DataT value)
+            {
+                auto partner = static_cast<int>((__lane_id() ^ 1u) * 4u);
+                auto addr    = reinterpret_cast<uint64_t>(dataPtr);
+
+                auto partnerLo   = static_cast<uint32_t>(
+                    __builtin_amdgcn_ds_bpermute(partner, static_cast<int>(addr)));
+                auto partnerHi   = static_cast<uint32_t>(
+                    __builtin_amdgcn_ds_bpermute(partner, static_cast<int>(addr >> 32u)));
+                auto partnerBits = static_cast<uint32_t>(
+                    __builtin_amdgcn_ds_bpermute(partner, static_cast<int>(bits(value))));
+
+                auto partnerAddr = (static_cast<uint64_t>(partnerHi) << 32u) | partnerLo;
+                auto isLo        = (addr % 4u == 0u) && (partnerAddr == addr + 2u);
+                auto isHi        = (partnerAddr % 4u == 0u) && (addr == partnerAddr + 2u);
+
+                if(isLo)
+                {
+                    exec_pair(dataPtr,
+                              value,
+                              __builtin_bit_cast(DataT, static_cast<uint16_t>(partnerBits)));
+                }
+                else if(!isHi)
+                {
+                    exec_single(dataPtr, value);
+                }
+            }
+        };
+
+        // Atomically adds VectorWidth contiguous elements to memory.
+        // Vector elements are contiguous in the minor dimension of the data layout.
+        // 32 and 64-bit types issue one atomic add per element. 16-bit floats are grouped
+        // in dword pairs for packed atomic adds: within the vector for even vector widths,
+        // or across neighbouring lanes for a vector width of 1.
+        template <typename DataT, uint32_t VectorWidth>
+        struct amdgcn_atomic_add_store
+        {
+            static_assert(VectorWidth > 0, "Vector width must be greater than 0");
+            static_assert(sizeof(DataT[VectorWidth]) == sizeof(VecT<DataT, VectorWidth>),
+                          "Cannot vectorize output");
+            static_assert(is_same_v<DataT, float16_t> || is_same_v<DataT, hfloat16_t>
+                              || is_same_v<DataT, bfloat16_t> || is_same_v<DataT, float32_t>
+                              || is_same_v<DataT, float64_t> || is_same_v<DataT, int32_t>
+                              || is_same_v<DataT, uint32_t>,
+                          "Atomic add stores are not available for this DataT");
+
+            using StoreT = VecT<DataT, VectorWidth>;
+
+            ROCWMMA_DEVICE static inline void exec(DataT* dataPtr, StoreT const& data)
+            {
+                if constexpr(sizeof(DataT) == 2u && VectorWidth % 2u == 0u)
+                {
+#pragma unroll
+                    for(uint32_t i = 0; i < VectorWidth; i += 2u)
+                    {
+                        amdgcn_atomic_add_16b<DataT>::exec_pair(
+                            dataPtr + i, data.data[i], data.data[i + 1u]);
+                    }
+                }
+                else if constexpr(sizeof(DataT) == 2u && VectorWidth == 1u)
+                {
+                    amdgcn_atomic_add_16b<DataT>::exec_lane_pair(dataPtr, data.data[0]);
+                }
+                else if constexpr(sizeof(DataT) == 2u)
+                {
+#pragma unroll
+                    for(uint32_t i = 0; i < VectorWidth; i++)
+                    {
+                        amdgcn_atomic_add_16b<DataT>::exec_single(dataPtr + i, data.data[i]);
+                    }
+                }
+                else if constexpr(is_same_v<DataT, float32_t> || is_same_v<DataT, float64_t>)
+                {
+                    // Hardware float atomics where available, otherwise compare-and-swap
+#pragma unroll
+                    for(uint32_t i = 0; i < VectorWidth; i++)
+                    {
+                        unsafeAtomicAdd(dataPtr + i, data.data[i]);
+                    }
+                }
+                else
+                {
+#pragma unroll
+                    for(uint32_t i = 0; i < VectorWidth; i++)
+                    {
+                        atomicAdd(dataPtr + i, data.data[i]);
+                    }
+                }
+            }
+        };
+
+    } // namespace detail
+
+    // Stores with the same matrix layout as OpaqueStore, however each vector is
+    // atomically added to the existing data in memory instead of overwriting it.
+    template <uint32_t BlockDim,
+              uint32_t BlockK,
+              typename DataT,
+              class DataLayout,
+              class MatrixLayout,
+              uint32_t VectorWidth>
+    struct AtomicAddStore
+    {
+        using IOTraits = IOTraits<BlockDim, BlockK, DataT, VectorWidth>;
+        struct Traits
+        {
+            // Raw IO on unpacked register data.
+            using Storer = detail::amdgcn_atomic_add_store<DataT, VectorWidth>;
+            using StoreT = typename Storer::StoreT;
+            using InputT = VecT<DataT, IOTraits::UnpackedSize>;
+        };
+
+        using StoreVecTraits = VecTraits<typename Traits::StoreT>;
+
+        template <size_t Depth = 0,
+                  typename Iterator,
+                  typename StrideCounts,
+                  typename Strides2d>
+        ROCWMMA_DEVICE static inline auto unroll_right(DataT*         dataPtr,
+                                                       Iterator&      in,
+                                                       uint32_t       ldm,
+                                                       StrideCounts&& strideCounts,
+                                                       Strides2d&&    strides2d)
+        {
+            auto strideOffset = DataLayout::fromMatrixCoord(get<Depth>(strides2d), ldm);
+            auto strideCount  = get<Depth>(strideCounts);
+
+            // Last depth layer will invoke the store
+            if constexpr(Depth == (VecTraits<decay_t<StrideCounts>>::size() - 1u))
+            {
+#pragma unroll
+                for(int i = 0; i < strideCount; i++)
+                {
+                    Traits::Storer::exec(dataPtr, *in);
+                    dataPtr += strideOffset;
+                    in++;
+                }
+            }
+            // Recurse to the next nested layer
+            else
+            {
+#pragma unroll
+                for(int i = 0; i < strideCount; i++)
+                {
+                    unroll_right<Depth + 1>(dataPtr, in, ldm, strideCounts, strides2d);
+                    dataPtr += strideOffset;
+                }
+            }
+        }
+
+        ROCWMMA_DEVICE static void
+            exec(DataT* dataPtr, typename Traits::InputT const& data, uint32_t ldm)
+        {
+            // Arrange wave threads to starting matrix layout offsets.
+            auto baseOffset2d = MatrixLayout::baseOffset();
+            auto it           = makeVectorIterator<StoreVecTraits::size()>(data).begin();
+
+            static_assert(decltype(it)::range() == IOTraits::IOCount,
+                          "IOCount inconsistent with iterator range");
+
+            // Make sure that the IOCount is consistent with the number of total strides
+            static_assert(IOTraits::IOCount
+                              == apply([](auto... items) { return (items * ...); },
+                                       MatrixLayout::strideCounts()),
+                          "IOCount inconsistent with total strides");
+
+            unroll_right(dataPtr + DataLayout::fromMatrixCoord(baseOffset2d, ldm),
+                         it,
+                         ldm,
+                         MatrixLayout::strideCounts(),
+                         MatrixLayout::strides());
+        }
+    };
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_ATOMIC_ADD_STORE_HPP
@@ -0,0 +1,292 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_BUFFER_LOAD_HPP
+#define ROCWMMA_BUFFER_LOAD_HPP
+
+#include "io_traits.hpp"
+#include "layout.hpp"
+#include "tuple.hpp"
+#include "types.hpp"
+#include "vector_iterator.hpp"
+
+// Buffer loads through a buffer resource descriptor (SRD) are enabled for
+// all supported device targets, with a functionally equivalent host fallback.
+#if ROCWMMA_ARCH_GFX9 || ROCWMMA_ARCH_GFX11 || ROCWMMA_ARCH_GFX12
+#define ROCWMMA_BUFFER_LOAD_SRD 1
+#else
+#define ROCWMMA_BUFFER_LOAD_SRD 0
+#endif
+
+namespace rocwmma
+{
+
+    namespace detail
+    {
+        // 128-bit buffer resource descriptor, held in SGPRs
+        using BufferRsrcT  = int32_t __attribute__((ext_vector_type(4)));
+        using BufferI32x2T = int32_t __attribute__((ext_vector_type(2)));
+        using BufferI32x4T = int32_t __attribute__((ext_vector_type(4)));
+
+        // SRD dword 3: data format and OOB selection for raw (stride 0) buffers
+#if ROCWMMA_ARCH_GFX9
+        constexpr int32_t BufferRsrcDword3 = 0x00020000;
+#elif ROCWMMA_ARCH_GFX11 || ROCWMMA_ARCH_GFX12
+        constexpr int32_t BufferRsrcDword3 = 0x31004000;
+#else
+        constexpr int32_t BufferRsrcDword3 = 0;
+#endif
+
+        // Raw buffer load intrinsics. Offsets are in bytes:
+        // voffset is the per-lane offset (VGPR), soffset is the wave-uniform offset (SGPR).
+        ROCWMMA_DEVICE int8_t llvm_amdgcn_raw_buffer_load_i8(BufferRsrcT rsrc,
+                                                             int32_t     voffset,
+                                                             int32_t     soffset,
+                                                             int32_t     aux)
+            __asm("llvm.amdgcn.raw.buffer.load.i8");
+
+        ROCWMMA_DEVICE int16_t llvm_amdgcn_raw_buffer_load_i16(BufferRsrcT rsrc,
+                                                               int32_t     voffset,
+                                                               int32_t     soffset,
+                                                               int32_t     aux)
+            __asm("llvm.amdgcn.raw.buffer.load.i16");
+
+        ROCWMMA_DEVICE int32_t llvm_amdgcn_raw_buffer_load_i32(BufferRsrcT rsrc,
+                                                               int32_t     voffset,
+                                                               int32_t     soffset,
+                                                               int32_t     aux)
+            __asm("llvm.amdgcn.raw.buffer.load.i32");
+
+        ROCWMMA_DEVICE BufferI32x2T llvm_amdgcn_raw_buffer_load_i32x2(BufferRsrcT rsrc,
+                                                                      int32_t     voffset,
+                                                                      int32_t     soffset,
+                                                                      int32_t     aux)
+            __asm("llvm.amdgcn.raw.buffer.load.v2i32");
+
+        ROCWMMA_DEVICE BufferI32x4T llvm_amdgcn_raw_buffer_load_i32x4(BufferRsrcT rsrc,
+                                                                      int32_t     voffset,
+                                                                      int32_t     soffset,
+                                                                      int32_t     aux)
+            __asm("llvm.amdgcn.raw.buffer.load.v4i32");
+
+        // Builds a raw buffer SRD over numBytes from the base pointer.
+        // Base pointer and size must be wave-uniform.
+        ROCWMMA_DEVICE inline BufferRsrcT makeBufferRsrc(void const* base, uint32_t numBytes)
+        {
+            auto address = reinterpret_cast<uint64_t>(base);
+
+            // Dword 1 upper bits hold the stride, which is 0 for raw buffers
+            BufferRsrcT rsrc;
+            rsrc[0] = static_cast<int32_t>(address & 0xFFFFFFFFull);
+            rsrc[1] = static_cast<int32_t>((address >> 32u) & 0xFFFFull);
+            rsrc[2] = static_cast<int32_t>(numBytes);
+            rsrc[3] = BufferRsrcDword3;
+
+#if ROCWMMA_BUFFER_LOAD_SRD
+            // Keep the SRD in SGPRs
+            rsrc[0] = __builtin_amdgcn_readfirstlane(rsrc[0]);
+            rsrc[1] = __builtin_amdgcn_readfirstlane(rsrc[1]);
+            rsrc[2] = __builtin_amdgcn_readfirstlane(rsrc[2]);
+#endif // ROCWMMA_BUFFER_LOAD_SRD
+
+            return rsrc;
+        }
+
+        // Loads VectorWidth contiguous elements at byte offset (voffset + soffset)
+        // of the buffer. Loads outside of the buffer range return zero.
+        template <typename DataT, uint32_t VectorWidth>
+        struct amdgcn_buffer_load
+        {
+            static_assert(VectorWidth > 0, "Vector width must be greater than 0");
+            static_assert(sizeof(DataT[VectorWidth]) == sizeof(VecT<DataT, VectorWidth>),
+                          "Cannot vectorize input");
+
+            using LoadT = VecT<DataT, VectorWidth>;
+
+            enum : uint32_t
+            {
+                Bytes = sizeof(LoadT)
+            };
+
+            static_assert(Bytes == 1u || Bytes == 2u || Bytes == 4u || Bytes == 8u || Bytes == 16u,
+                          "Unsupported buffer load size");
+
+            ROCWMMA_DEVICE static inline void
+                exec(LoadT& data, BufferRsrcT rsrc, index_t voffset, index_t soffset)
+            {
+#if ROCWMMA_BUFFER_LOAD_SRD
+                if constexpr(Bytes == 1u)
+                {
+                    auto raw = llvm_amdgcn_raw_buffer_load_i8(rsrc, voffset, soffset, 0);
+                    __builtin_memcpy(&data, &raw, Bytes);
+                }
+                else if constexpr(Bytes == 2u)
+                {
+                    auto raw = llvm_amdgcn_raw_buffer_load_i16(rsrc, voffset, soffset, 0);
+                    __builtin_memcpy(&data, &raw, Bytes);
+                }
+                else if constexpr(Bytes == 4u)
+                {
+                    auto raw = llvm_amdgcn_raw_buffer_load_i32(rsrc, voffset, soffset, 0);
+                    __builtin_memcpy(&data, &raw, Bytes);
+                }
+                else if constexpr(Bytes == 8u)
+                {
+                    auto raw = llvm_amdgcn_raw_buffer_load_i32x2(rsrc, voffset, soffset, 0);
+                    __builtin_memcpy(&data, &raw, Bytes);
+                }
+                else
+                {
+                    auto raw = llvm_amdgcn_raw_buffer_load_i32x4(rsrc, voffset, soffset, 0);
+                    __builtin_memcpy(&data, &raw, Bytes);
+                }
+#else
+                // Decode the SRD and emulate the range check
+                auto address = (static_cast<uint64_t>(static_cast<uint32_t>(rsrc[1])) << 32u)
+                               | static_cast<uint32_t>(rsrc[0]);
+                auto offset   = static_cast<uint32_t>(voffset + soffset);
+                auto numBytes = static_cast<uint32_t>(rsrc[2]);
+
+                if(offset + Bytes <= numBytes)
+                {
+                    data = *reinterpret_cast<LoadT const*>(reinterpret_cast<char const*>(address)
+                                                           + offset);
+                }
+                else
+                {
+                    __builtin_memset(&data, 0, Bytes);
+                }
+#endif // ROCWMMA_BUFFER_LOAD_SRD
+            }
+        };
+
+    } // namespace detail
+
+    // Loads with the same matrix layout as OpaqueLoad, however through buffer
+    // instructions on a wave-uniform SRD rather than flat 64-bit addresses.
+    // The per-lane base offset is computed once (voffset), and the unrolled
+    // stride offsets are accumulated as wave-uniform scalar offsets (soffset).
+    // This removes 64-bit VGPR address arithmetic from the unrolled loads.
+    // Buffer range checking returns zero for loads outside of the buffer.
+    template <uint32_t BlockDim,
+              uint32_t BlockK,
+              typename DataT,
+              class DataLayout,
+              class MatrixLayout,
+              uint32_t VectorWidth>
+    struct BufferLoad
+    {
+        using IOTraits = IOTraits<BlockDim, BlockK, DataT, VectorWidth>;
+
+        struct Traits
+        {
+            // Raw IO on unpacked register data.
+            using Loader  = detail::amdgcn_buffer_load<DataT, VectorWidth>;
+            using LoadT   = typename Loader::LoadT;
+            using OutputT = VecT<DataT, IOTraits::UnpackedSize>;
+        };
+
+        using LoadVecTraits = VecTraits<typename Traits::LoadT>;
+
+        // Outer loop = index 0,
+        // Inner loop = index N-1
+        template <size_t Depth = 0,
+                  typename Iterator,
+                  typename StrideCounts,
+                  typename Strides2d>
+        ROCWMMA_DEVICE static inline auto unroll_right(Iterator&           out,
+                                                       detail::BufferRsrcT rsrc,
+                                                       index_t             voffset,
+                                                       index_t             soffset,
+                                                       uint32_t            ldm,
+                                                       StrideCounts&&      strideCounts,
+                                                       Strides2d&&         strides2d)
+        {
+            auto strideOffset
+                = DataLayout::fromMatrixCoord(get<Depth>(strides2d), ldm) * sizeof(DataT);
+            auto strideCount = get<Depth>(strideCounts);
+
+            // Last depth layer will invoke the load
+            if constexpr(Depth == (VecTraits<decay_t<StrideCounts>>::size() - 1u))
+            {
+#pragma unroll
+                for(int i = 0; i < strideCount; i++)
+                {
+                    Traits::Loader::exec(*out, rsrc, voffset, soffset);
+                    soffset += strideOffset;
+                    out++;
+                }
+            }
+            // Recurse to the next nested layer
+            else
+            {
+#pragma unroll
+                for(int i = 0; i < strideCount; i++)
+                {
+                    unroll_right<Depth + 1>(
+                        out, rsrc, voffset, soffset, ldm, strideCounts, strides2d);
+                    soffset += strideOffset;
+                }
+            }
+        }
+
+        // numElements is the wave-uniform count of elements from dataPtr within the buffer range.
+        ROCWMMA_DEVICE static void exec(typename Traits::OutputT& data,
+                                        DataT const*              dataPtr,
+                                        uint32_t                  ldm,
+                                        uint32_t                  numElements)
+        {
+            // Arrange wave threads to starting matrix layout offsets.
+            auto baseOffset2d = MatrixLayout::baseOffset();
+            auto it           = makeVectorIterator<LoadVecTraits::size()>(data).begin();
+
+            static_assert(decltype(it)::range() == IOTraits::IOCount,
+                          "IOCount inconsistent with iterator range");
+
+            // Make sure that the IOCount is consistent with the number of total strides
+            static_assert(IOTraits::IOCount
+                              == apply([](auto... items) { return (items * ...); },
+                                       MatrixLayout::strideCounts()),
+                          "IOCount inconsistent with total strides");
+
+            // Buffer range is limited to 32-bit byte offsets
+            auto numBytes = static_cast<uint64_t>(numElements) * sizeof(DataT);
+            auto rsrc     = detail::makeBufferRsrc(
+                dataPtr, numBytes > 0xFFFFFFFFull ? 0xFFFFFFFFu : static_cast<uint32_t>(numBytes));
+
+            // Unroll loading in each strided dimension
+            unroll_right(it,
+                         rsrc,
+                         DataLayout::fromMatrixCoord(baseOffset2d, ldm) * sizeof(DataT),
+                         0,
+                         ldm,
+                         MatrixLayout::strideCounts(),
+                         MatrixLayout::strides());
+        }
+    };
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_BUFFER_LOAD_HPP
@@ -214,4 +214,13 @@ static_assert((bool)(ROCWMMA_BLOCK_DIM_16_SUPPORTED) && !(bool)(ROCWMMA_BLOCK_DI
 
 #define ROCWMMA_KERNEL __global__
 
+///
+/// Kernel register allocation
+/// ROCWMMA_WAVES_PER_EU(MIN, MAX): range of waves per SIMD that the registers of a kernel are
+/// allocated for. A MAX of 1 gives the kernel the whole register file: 256 VGPRs and 256 AGPRs
+/// on gfx9, where gfx90a and gfx94x split their unified 512 registers as needed. Accumulators
+/// then stay in AGPRs across the K loop, instead of spilling or being copied to VGPRs.
+///
+#define ROCWMMA_WAVES_PER_EU(MIN, MAX) __attribute__((amdgpu_waves_per_eu(MIN, MAX)))
+
 #endif // ROCWMMA_CONFIG_HPP
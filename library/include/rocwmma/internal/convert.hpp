@@ -102,11 +102,421 @@ namespace rocwmma
 
 #endif // !ROCWMMA_NO_HALF
 
+        // Round to nearest even, as hip_bfloat16(float). Each pair of
+        // results is packed into one b32 with a single byte permute.
+        template <>
+        struct amdgcn_convert<float32_t, bfloat16_t>
+        {
+            ROCWMMA_DEVICE static inline uint32_t roundToBf16(float32_t v)
+            {
+                auto bits = __builtin_bit_cast(uint32_t, v);
+                if(~bits & 0x7F800000u)
+                {
+                    bits += 0x7FFFu + ((bits >> 16) & 1u);
+                }
+                else if(bits & 0xFFFFu)
+                {
+                    // Keep NaN from truncating to Inf
+                    bits |= 0x10000u;
+                }
+                return bits;
+            }
+
+            template <uint32_t NumRegs>
+            ROCWMMA_DEVICE static inline auto exec(VecT<float32_t, NumRegs> const& regsIn)
+                -> VecT<bfloat16_t, NumRegs>
+            {
+                if constexpr(NumRegs % 2u == 0u)
+                {
+                    VecT<uint32_t, NumRegs / 2u> result;
+
+#pragma unroll
+                    for(unsigned i = 0; i < NumRegs / 2u; i++)
+                    {
+                        auto lo = roundToBf16(regsIn.data[2u * i]);
+                        auto hi = roundToBf16(regsIn.data[2u * i + 1u]);
+
+                        // High halves of both: lo -> bytes [1:0], hi -> bytes [3:2]
+                        result.data[i] = __builtin_amdgcn_perm(hi, lo, 0x07060302u);
+                    }
+                    return reinterpret_cast<VecT<bfloat16_t, NumRegs> const&>(result);
+                }
+                else
+                {
+                    VecT<bfloat16_t, NumRegs> result;
+
+#pragma unroll
+                    for(unsigned i = 0; i < NumRegs; i++)
+                    {
+                        result.data[i] = static_cast<bfloat16_t>(regsIn.data[i]);
+                    }
+                    return result;
+                }
+            }
+        };
+
+        // Whether F8T is one of the OCP encodings, rather than FNUZ
+        template <typename F8T>
+        constexpr bool IsF8Ocp
+            = is_same<F8T, float8_ocp_t>::value || is_same<F8T, bfloat8_ocp_t>::value;
+
+        // Whether F8T is an E4M3 type, rather than E5M2
+        template <typename F8T>
+        constexpr bool IsF8E4M3
+            = is_same<F8T, float8_t>::value || is_same<F8T, float8_ocp_t>::value;
+
+        // Whether the current target converts F8T in hardware:
+        // FNUZ on gfx940, gfx941 and gfx942, OCP on gfx12.
+        template <typename F8T>
+        constexpr bool IsF8HwConvert
+            = IsF8Ocp<F8T> ? bool(ROCWMMA_F8_OCP_DEVICE_SUPPORT) : bool(ROCWMMA_F8_DEVICE_SUPPORT);
+
+#if ROCWMMA_F8_DEVICE_SUPPORT || ROCWMMA_F8_OCP_DEVICE_SUPPORT
+
+        // float32 -> float8 / bfloat8 with v_cvt_pk_fp8_f32 / v_cvt_pk_bf8_f32,
+        // converting two elements per instruction and four per b32.
+        // Rounding and clipping match the scalar rocwmma_f8 / rocwmma_bf8 casts,
+        // or rocwmma_f8_ocp / rocwmma_bf8_ocp on gfx12.
+        template <typename F8T>
+        struct amdgcn_convert_pk_f8
+        {
+            ROCWMMA_DEVICE static inline float32_t clip(float32_t v)
+            {
+#ifdef rocwmma_F8_downcast_clipping
+                constexpr float32_t MaxVal
+                    = IsF8E4M3<F8T> ? (IsF8Ocp<F8T> ? 448.0f : 240.0f) : 57344.0f;
+
+                // Propagate NaN / Inf, no clipping
+                if((__builtin_bit_cast(uint32_t, v) & 0x7F800000u) != 0x7F800000u)
+                {
+                    v = __builtin_amdgcn_fmed3f(v, MaxVal, -MaxVal);
+                }
+#endif // rocwmma_F8_downcast_clipping
+                return v;
+            }
+
+            ROCWMMA_DEVICE static inline uint32_t
+                cvtPk(float32_t a, float32_t b, uint32_t old, bool hiWord)
+            {
+                if constexpr(IsF8E4M3<F8T>)
+                {
+                    return __builtin_amdgcn_cvt_pk_fp8_f32(clip(a), clip(b), old, hiWord);
+                }
+                else
+                {
+                    return __builtin_amdgcn_cvt_pk_bf8_f32(clip(a), clip(b), old, hiWord);
+                }
+            }
+
+            template <uint32_t NumRegs>
+            ROCWMMA_DEVICE static inline auto exec(VecT<float32_t, NumRegs> const& regsIn)
+                -> VecT<F8T, NumRegs>
+            {
+                if constexpr(NumRegs % 4u == 0u)
+                {
+                    VecT<uint32_t, NumRegs / 4u> result;
+
+#pragma unroll
+                    for(unsigned i = 0; i < NumRegs / 4u; i++)
+                    {
+                        // Elements [1:0] -> WORD0, [3:2] -> WORD1
+                        auto packed
+                            = cvtPk(regsIn.data[4u * i], regsIn.data[4u * i + 1u], 0u, false);
+                        result.data[i] = cvtPk(
+                            regsIn.data[4u * i + 2u], regsIn.data[4u * i + 3u], packed, true);
+                    }
+                    return reinterpret_cast<VecT<F8T, NumRegs> const&>(result);
+                }
+                else
+                {
+                    VecT<F8T, NumRegs> result;
+
+#pragma unroll
+                    for(unsigned i = 0; i < NumRegs; i++)
+                    {
+                        result.data[i] = static_cast<F8T>(regsIn.data[i]);
+                    }
+                    return result;
+                }
+            }
+        };
+
+#endif // ROCWMMA_F8_DEVICE_SUPPORT || ROCWMMA_F8_OCP_DEVICE_SUPPORT
+
+#if ROCWMMA_F8_DEVICE_SUPPORT
+
+        template <>
+        struct amdgcn_convert<float32_t, float8_t> : public amdgcn_convert_pk_f8<float8_t>
+        {
+        };
+
+        template <>
+        struct amdgcn_convert<float32_t, bfloat8_t> : public amdgcn_convert_pk_f8<bfloat8_t>
+        {
+        };
+
+#endif // ROCWMMA_F8_DEVICE_SUPPORT
+
+#if ROCWMMA_F8_OCP_DEVICE_SUPPORT
+
+        template <>
+        struct amdgcn_convert<float32_t, float8_ocp_t> : public amdgcn_convert_pk_f8<float8_ocp_t>
+        {
+        };
+
+        template <>
+        struct amdgcn_convert<float32_t, bfloat8_ocp_t>
+            : public amdgcn_convert_pk_f8<bfloat8_ocp_t>
+        {
+        };
+
+#endif // ROCWMMA_F8_OCP_DEVICE_SUPPORT
+
+        // Re-encoding between the FNUZ (gfx940+) and OCP (gfx12) 8-bit floating point types
+        // of the same width. Elements decode to float32_t, then round and clip to the
+        // finite range of OutputT: OCP E4M3 values above 240 clip to the FNUZ max.
+        template <typename InputT, typename OutputT>
+        struct amdgcn_convert_f8_encoding
+        {
+            template <uint32_t NumRegs>
+            ROCWMMA_DEVICE static inline auto exec(VecT<InputT, NumRegs> const& regsIn)
+                -> VecT<OutputT, NumRegs>
+            {
+                VecT<float32_t, NumRegs> wide;
+
+#pragma unroll
+                for(unsigned i = 0; i < NumRegs; i++)
+                {
+                    wide.data[i] = static_cast<float32_t>(regsIn.data[i]);
+                }
+
+                // Packed down-conversion, where the target has one
+                return amdgcn_convert<float32_t, OutputT>::exec(wide);
+            }
+        };
+
+        template <>
+        struct amdgcn_convert<float8_t, float8_ocp_t>
+            : public amdgcn_convert_f8_encoding<float8_t, float8_ocp_t>
+        {
+        };
+
+        template <>
+        struct amdgcn_convert<float8_ocp_t, float8_t>
+            : public amdgcn_convert_f8_encoding<float8_ocp_t, float8_t>
+        {
+        };
+
+        template <>
+        struct amdgcn_convert<bfloat8_t, bfloat8_ocp_t>
+            : public amdgcn_convert_f8_encoding<bfloat8_t, bfloat8_ocp_t>
+        {
+        };
+
+        template <>
+        struct amdgcn_convert<bfloat8_ocp_t, bfloat8_t>
+            : public amdgcn_convert_f8_encoding<bfloat8_ocp_t, bfloat8_t>
+        {
+        };
+
+        // Saturating int32 -> int8. Each element clamps with one
+        // v_med3_i32 and four results pack into one b32.
+        template <>
+        struct amdgcn_convert<int32_t, int8_t>
+        {
+            ROCWMMA_DEVICE static inline int32_t saturate(int32_t v)
+            {
+                return v < -128 ? -128 : (v > 127 ? 127 : v);
+            }
+
+            template <uint32_t NumRegs>
+            ROCWMMA_DEVICE static inline auto exec(VecT<int32_t, NumRegs> const& regsIn)
+                -> VecT<int8_t, NumRegs>
+            {
+                if constexpr(NumRegs % 4u == 0u)
+                {
+                    VecT<uint32_t, NumRegs / 4u> result;
+
+#pragma unroll
+                    for(unsigned i = 0; i < NumRegs / 4u; i++)
+                    {
+                        auto b0 = static_cast<uint32_t>(saturate(regsIn.data[4u * i])) & 0xFFu;
+                        auto b1 = static_cast<uint32_t>(saturate(regsIn.data[4u * i + 1u])) & 0xFFu;
+                        auto b2 = static_cast<uint32_t>(saturate(regsIn.data[4u * i + 2u])) & 0xFFu;
+                        auto b3 = static_cast<uint32_t>(saturate(regsIn.data[4u * i + 3u]));
+
+                        result.data[i] = b0 | (b1 << 8u) | (b2 << 16u) | (b3 << 24u);
+                    }
+                    return reinterpret_cast<VecT<int8_t, NumRegs> const&>(result);
+                }
+                else
+                {
+                    VecT<int8_t, NumRegs> result;
+
+#pragma unroll
+                    for(unsigned i = 0; i < NumRegs; i++)
+                    {
+                        result.data[i] = static_cast<int8_t>(saturate(regsIn.data[i]));
+                    }
+                    return result;
+                }
+            }
+        };
+
+        // Stochastic rounding conversions. Each element takes one
+        // uniformly distributed random word from rand.
+        template <typename InputT, typename OutputT>
+        struct amdgcn_convert_sr;
+
+        // Adds 16 random bits below the bfloat16 mantissa, then truncates.
+        // NaN and Inf convert as in amdgcn_convert.
+        template <>
+        struct amdgcn_convert_sr<float32_t, bfloat16_t>
+        {
+            ROCWMMA_DEVICE static inline uint32_t roundToBf16(float32_t v, uint32_t rand)
+            {
+                auto bits = __builtin_bit_cast(uint32_t, v);
+                if(~bits & 0x7F800000u)
+                {
+                    bits += rand & 0xFFFFu;
+                }
+                else if(bits & 0xFFFFu)
+                {
+                    // Keep NaN from truncating to Inf
+                    bits |= 0x10000u;
+                }
+                return bits;
+            }
+
+            template <uint32_t NumRegs>
+            ROCWMMA_DEVICE static inline auto exec(VecT<float32_t, NumRegs> const& regsIn,
+                                                   VecT<uint32_t, NumRegs> const&  rand)
+                -> VecT<bfloat16_t, NumRegs>
+            {
+                if constexpr(NumRegs % 2u == 0u)
+                {
+                    VecT<uint32_t, NumRegs / 2u> result;
+
+#pragma unroll
+                    for(unsigned i = 0; i < NumRegs / 2u; i++)
+                    {
+                        auto lo = roundToBf16(regsIn.data[2u * i], rand.data[2u * i]);
+                        auto hi = roundToBf16(regsIn.data[2u * i + 1u], rand.data[2u * i + 1u]);
+
+                        // High halves of both: lo -> bytes [1:0], hi -> bytes [3:2]
+                        result.data[i] = __builtin_amdgcn_perm(hi, lo, 0x07060302u);
+                    }
+                    return reinterpret_cast<VecT<bfloat16_t, NumRegs> const&>(result);
+                }
+                else
+                {
+                    VecT<bfloat16_t, NumRegs> result;
+
+#pragma unroll
+                    for(unsigned i = 0; i < NumRegs; i++)
+                    {
+                        auto bits      = roundToBf16(regsIn.data[i], rand.data[i]);
+                        result.data[i] = bfloat16_t(__builtin_bit_cast(float32_t, bits),
+                                                    bfloat16_t::truncate);
+                    }
+                    return result;
+                }
+            }
+        };
+
+        // float32 -> float8 / bfloat8. On gfx940+ (FNUZ) and gfx12 (OCP) each element is
+        // converted with v_cvt_sr_fp8_f32 / v_cvt_sr_bf8_f32 into its byte of the packed b32.
+        // Other targets use the stochastic casts of F8T.
+        template <typename F8T>
+        struct amdgcn_convert_sr_f8
+        {
+#if ROCWMMA_F8_DEVICE_SUPPORT || ROCWMMA_F8_OCP_DEVICE_SUPPORT
+            template <uint32_t ByteSel>
+            ROCWMMA_DEVICE static inline uint32_t cvtSr(float32_t v, uint32_t rand, uint32_t old)
+            {
+                using Clip = amdgcn_convert_pk_f8<F8T>;
+
+                if constexpr(IsF8E4M3<F8T>)
+                {
+                    return __builtin_amdgcn_cvt_sr_fp8_f32(Clip::clip(v), rand, old, ByteSel);
+                }
+                else
+                {
+                    return __builtin_amdgcn_cvt_sr_bf8_f32(Clip::clip(v), rand, old, ByteSel);
+                }
+            }
+#endif // ROCWMMA_F8_DEVICE_SUPPORT || ROCWMMA_F8_OCP_DEVICE_SUPPORT
+
+            template <uint32_t NumRegs>
+            ROCWMMA_DEVICE static inline auto exec(VecT<float32_t, NumRegs> const& regsIn,
+                                                   VecT<uint32_t, NumRegs> const&  rand)
+                -> VecT<F8T, NumRegs>
+            {
+#if ROCWMMA_F8_DEVICE_SUPPORT || ROCWMMA_F8_OCP_DEVICE_SUPPORT
+                if constexpr(IsF8HwConvert<F8T> && NumRegs % 4u == 0u)
+                {
+                    VecT<uint32_t, NumRegs / 4u> result;
+
+#pragma unroll
+                    for(unsigned i = 0; i < NumRegs / 4u; i++)
+                    {
+                        auto j = 4u * i;
+
+                        auto packed = cvtSr<0u>(regsIn.data[j], rand.data[j], 0u);
+                        packed      = cvtSr<1u>(regsIn.data[j + 1u], rand.data[j + 1u], packed);
+                        packed      = cvtSr<2u>(regsIn.data[j + 2u], rand.data[j + 2u], packed);
+                        result.data[i] = cvtSr<3u>(regsIn.data[j + 3u], rand.data[j + 3u], packed);
+                    }
+                    return reinterpret_cast<VecT<F8T, NumRegs> const&>(result);
+                }
+                else
+#endif // ROCWMMA_F8_DEVICE_SUPPORT || ROCWMMA_F8_OCP_DEVICE_SUPPORT
+                {
+                    using RoundingMode = typename F8T::rocwmma_hip_f8_rounding_mode;
+
+                    VecT<F8T, NumRegs> result;
+
+#pragma unroll
+                    for(unsigned i = 0; i < NumRegs; i++)
+                    {
+                        result.data[i]
+                            = F8T(regsIn.data[i], RoundingMode::stochastic, rand.data[i]);
+                    }
+                    return result;
+                }
+            }
+        };
+
+        template <>
+        struct amdgcn_convert_sr<float32_t, float8_t> : public amdgcn_convert_sr_f8<float8_t>
+        {
+        };
+
+        template <>
+        struct amdgcn_convert_sr<float32_t, bfloat8_t> : public amdgcn_convert_sr_f8<bfloat8_t>
+        {
+        };
+
+        template <>
+        struct amdgcn_convert_sr<float32_t, float8_ocp_t>
+            : public amdgcn_convert_sr_f8<float8_ocp_t>
+        {
+        };
+
+        template <>
+        struct amdgcn_convert_sr<float32_t, bfloat8_ocp_t>
+            : public amdgcn_convert_sr_f8<bfloat8_ocp_t>
+        {
+        };
+
     } // namespace detail
 
     template <typename InputT, typename OutputT>
     using Convert = detail::amdgcn_convert<InputT, OutputT>;
 
+    template <typename InputT, typename OutputT>
+    using ConvertSr = detail::amdgcn_convert_sr<InputT, OutputT>;
+
 } // namespace rocwmma
 
 #endif // ROCWMMA_CONVERT_HPP
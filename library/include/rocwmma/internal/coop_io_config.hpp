@@ -58,6 +58,9 @@ namespace rocwmma
  * @param MappingUtil global mapping utility for current fragment
  * @param Loader Issues cooperative load instructions for raw fragment data
  * @param Storer Issues cooperative store instructions for raw fragment data
+ * @param PolicyLoader Issues cooperative load instructions with an access policy
+ * @param ConvertLoader Issues cooperative loads of SrcT data, converted to DataT in registers
+ * @param PolicyStorer Issues cooperative store instructions with an access policy
  */
 
     template <typename MatrixT,
@@ -78,19 +81,30 @@ namespace rocwmma
         using MappingUtil
             = MappingUtil<IOShape::BlockHeight, IOShape::BlockWidth, DataT, DataLayoutT>;
 
-        using Loader = CooperativeLoad<IOShape::BlockDim,
-                                       IOShape::KDim,
-                                       DataT,
-                                       typename IOLayout::DataLayout,
-                                       typename IOLayout::MatrixLayout,
-                                       IOLayout::VW>;
+        template <class AccessPolicy, typename SrcT = DataT>
+        using PolicyLoader = CooperativeLoad<IOShape::BlockDim,
+                                             IOShape::KDim,
+                                             DataT,
+                                             typename IOLayout::DataLayout,
+                                             typename IOLayout::MatrixLayout,
+                                             IOLayout::VW,
+                                             AccessPolicy,
+                                             SrcT>;
 
-        using Storer = CooperativeStore<IOShape::BlockDim,
-                                        IOShape::KDim,
-                                        DataT,
-                                        typename IOLayout::DataLayout,
-                                        typename IOLayout::MatrixLayout,
-                                        IOLayout::VW>;
+        template <class AccessPolicy>
+        using PolicyStorer = CooperativeStore<IOShape::BlockDim,
+                                              IOShape::KDim,
+                                              DataT,
+                                              typename IOLayout::DataLayout,
+                                              typename IOLayout::MatrixLayout,
+                                              IOLayout::VW,
+                                              AccessPolicy>;
+
+        template <typename SrcT>
+        using ConvertLoader = PolicyLoader<cache_default, SrcT>;
+
+        using Loader = PolicyLoader<cache_default>;
+        using Storer = PolicyStorer<cache_default>;
     };
 
     /************************************************
@@ -26,6 +26,7 @@
 #ifndef ROCWMMA_COOP_LOAD_HPP
 #define ROCWMMA_COOP_LOAD_HPP
 
+#include "dequant_load.hpp"
 #include "io_traits.hpp"
 #include "layout.hpp"
 #include "opaque_load.hpp"
@@ -35,12 +36,17 @@
 namespace rocwmma
 {
 
+    // SrcT is the datatype in memory. When it differs from the fragment DataT, each
+    // vector is converted to DataT in registers as it is loaded, e.g. float32_t data
+    // into float16_t fragments. Converting loads ignore the access policy.
     template <uint32_t BlockDim,
               uint32_t BlockK,
               typename DataT,
               class DataLayout,
               class MatrixLayout,
-              uint32_t VectorWidth>
+              uint32_t VectorWidth,
+              class AccessPolicy = cache_default,
+              typename SrcT      = DataT>
     struct CooperativeLoad
     {
         using IOTraits = IOTraits<BlockDim, BlockK, DataT, VectorWidth>;
@@ -52,8 +58,11 @@ namespace rocwmma
             };
 
             // Load implementation
-            using Loader = detail::amdgcn_opaque_load<DataT, VectorWidth>;
-            using LoadT  = typename Loader::LoadT;
+            using Loader
+                = conditional_t<is_same<SrcT, DataT>::value,
+                                detail::amdgcn_opaque_load<DataT, VectorWidth, AccessPolicy>,
+                                detail::amdgcn_dequant_load<SrcT, DataT, VectorWidth>>;
+            using LoadT = VecT<DataT, VectorWidth>;
 
             // Block output vector
             using OutputT = VecT<DataT, IOTraits::UnpackedSize>;
@@ -65,7 +74,7 @@ namespace rocwmma
         // Inner loop = index N-1
         template <size_t Depth = 0, typename Iterator, typename StrideSpace, typename Strides2d>
         ROCWMMA_DEVICE static inline auto unroll_right(Iterator&     out,
-                                                       DataT const*  dataPtr,
+                                                       SrcT const*   dataPtr,
                                                        uint32_t      ldm,
                                                        StrideSpace&& strideSpace,
                                                        Strides2d&&   strides2d)
@@ -100,12 +109,11 @@ namespace rocwmma
 
         constexpr static uint32_t calcMaxWaves(uint32_t workItems, uint32_t waveCount)
         {
-            return (workItems % waveCount == 0 ? waveCount
-                                               : calcMaxWaves(workItems, waveCount / 2));
+            return detail::coopSplitWaves(workItems, waveCount);
         };
 
         ROCWMMA_DEVICE static inline void exec(typename Traits::OutputT& data,
-                                               DataT const*              dataPtr,
+                                               SrcT const*               dataPtr,
                                                uint32_t                  ldm,
                                                uint32_t                  waveIndex,
                                                uint32_t                  waveCount)
@@ -157,7 +165,7 @@ namespace rocwmma
 
         template <uint32_t WaveCount>
         ROCWMMA_DEVICE static inline void exec(typename Traits::OutputT& data,
-                                               DataT const*              dataPtr,
+                                               SrcT const*               dataPtr,
                                                uint32_t                  ldm,
                                                uint32_t                  waveIndex)
         {
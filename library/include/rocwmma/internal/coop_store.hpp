@@ -40,7 +40,8 @@ namespace rocwmma
               typename DataT,
               class DataLayout,
               class MatrixLayout,
-              uint32_t VectorWidth>
+              uint32_t VectorWidth,
+              class AccessPolicy = cache_default>
     struct CooperativeStore
     {
         using IOTraits = IOTraits<BlockDim, BlockK, DataT, VectorWidth>;
@@ -53,7 +54,7 @@ namespace rocwmma
 
             // Store implementation
             // Iteratively stores the entire block
-            using Storer = detail::amdgcn_opaque_store<DataT, VectorWidth>;
+            using Storer = detail::amdgcn_opaque_store<DataT, VectorWidth, AccessPolicy>;
             using StoreT = typename Storer::StoreT;
 
             // Block input vector
@@ -101,8 +102,7 @@ namespace rocwmma
 
         constexpr static uint32_t calcMaxWaves(uint32_t workItems, uint32_t waveCount)
         {
-            return (workItems % waveCount == 0 ? waveCount
-                                               : calcMaxWaves(workItems, waveCount / 2));
+            return detail::coopSplitWaves(workItems, waveCount);
         };
 
         ROCWMMA_DEVICE static inline void exec(DataT*                         dataPtr,
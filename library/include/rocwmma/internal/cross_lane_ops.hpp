@@ -27,6 +27,7 @@
 #define ROCWMMA_CROSS_LANE_OPS_HPP
 
 #include "constants.hpp"
+#include "utility/type_traits.hpp"
 
 namespace rocwmma
 {
@@ -117,6 +118,122 @@ namespace rocwmma
             }
         };
 
+        // Cost of ops that the backend cannot implement on the current target
+        constexpr uint32_t OP_COST_UNSUPPORTED = ~0u;
+
+        /*! \class OpCost
+        *  \brief Relative cost of one 32b cross-lane op on the current target, in VALU issue
+        * slots of a dependent chain. Ops the backend cannot implement on the target cost
+        * OP_COST_UNSUPPORTED.
+        *
+        * - gfx9: dpp is a single VALU op, while ds_swizzle and ds_(b)permute round trip
+        *   through the LDS crossbar at ~4x the latency, plus the lane address for permute.
+        * - gfx11, gfx12: wave32 ds_swizzle completes in one crossbar pass, and is favoured
+        *   over dpp movs, which cannot dual issue.
+        *
+        * cross_lane_ops_test-bench times a dependent chain of each op on every backend of the
+        * device, and reports the ops for which this table selects the slower backend.
+        *
+        * @tparam OpId classification of the operation: see Properties
+        * @tparam SubGroupSize sub-group size of the operation
+        * @tparam OpImpl backend implementation of the op: see Properties
+        */
+        template <uint32_t OpId, uint32_t SubGroupSize, uint32_t OpImpl>
+        struct OpCost
+        {
+        private:
+            constexpr static uint32_t implCost()
+            {
+#if ROCWMMA_ARCH_GFX11 || ROCWMMA_ARCH_GFX12
+                return OpImpl == OP_IMPL_DPP        ? 2u
+                       : OpImpl == OP_IMPL_SWIZZLE  ? 1u
+                       : OpImpl == OP_IMPL_PERMUTE  ? 2u
+                       : OpImpl == OP_IMPL_BPERMUTE ? 2u
+                                                    : 1u; // VPERM, VBLEND
+#else // ROCWMMA_ARCH_GFX9 + Host
+                return OpImpl == OP_IMPL_DPP        ? 1u
+                       : OpImpl == OP_IMPL_SWIZZLE  ? 4u
+                       : OpImpl == OP_IMPL_PERMUTE  ? 5u
+                       : OpImpl == OP_IMPL_BPERMUTE ? 5u
+                                                    : 1u; // VPERM, VBLEND
+#endif // ROCWMMA_ARCH_GFX11 || ROCWMMA_ARCH_GFX12
+            }
+
+            constexpr static bool isLegal()
+            {
+                // Same exclusions as the dpp backend (dpp_impl.hpp)
+                if constexpr(OpImpl == OP_IMPL_DPP)
+                {
+                    // No row_newbcast on gfx908
+                    if constexpr((bool)ROCWMMA_ARCH_GFX908 && OpId == OP_ID_BCAST
+                                 && SubGroupSize == OP_GROUP_SIZE_16)
+                    {
+                        return false;
+                    }
+                    // No wave shift / rotate or row_bcast15 / row_bcast31 on gfx10+
+                    else if constexpr((bool)(ROCWMMA_ARCH_GFX11 || ROCWMMA_ARCH_GFX12)
+                                      && ((SubGroupSize == OP_GROUP_SIZE_WARP
+                                           && (OpId == OP_ID_SHIFT || OpId == OP_ID_ROTATE))
+                                          || OpId == OP_ID_WFALL_BCAST))
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+        public:
+            enum : uint32_t
+            {
+                value = isLegal() ? implCost() : OP_COST_UNSUPPORTED,
+            };
+        };
+
+        template <typename CrossLaneOp>
+        constexpr uint32_t opCost()
+        {
+            return OpCost<CrossLaneOp::opId(), CrossLaneOp::groupSize(), CrossLaneOp::opImpl()>::
+                value;
+        }
+
+        template <typename CrossLaneOp>
+        constexpr bool isSupported()
+        {
+            return opCost<CrossLaneOp>() != OP_COST_UNSUPPORTED;
+        }
+
+        /*! \class OpSelect
+        *  \brief Selects the cheapest of equivalent cross-lane ops on the current target, by
+        * OpCost. Ties go to the first candidate.
+        *
+        * @tparam CandidateOps ops with the same OpId and SubGroupSize, on different backends
+        */
+        template <typename CandidateOp, typename... CandidateOps>
+        struct OpSelect
+        {
+            using Type = CandidateOp;
+        };
+
+        template <typename CandidateOp0, typename CandidateOp1, typename... CandidateOps>
+        struct OpSelect<CandidateOp0, CandidateOp1, CandidateOps...>
+        {
+        private:
+            using Next = typename OpSelect<CandidateOp1, CandidateOps...>::Type;
+
+            static_assert(CandidateOp0::opId() == Next::opId(),
+                          "Candidate ops must have the same OpId");
+            static_assert(CandidateOp0::groupSize() == Next::groupSize(),
+                          "Candidate ops must have the same SubGroupSize");
+
+        public:
+            using Type = conditional_t<(opCost<CandidateOp0>() <= opCost<Next>()),
+                                       CandidateOp0,
+                                       Next>;
+        };
+
+        template <typename... CandidateOps>
+        using OpSelect_t = typename OpSelect<CandidateOps...>::Type;
+
         /** @}*/
     } // namespace CrossLaneOps
 
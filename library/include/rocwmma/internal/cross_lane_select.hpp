@@ -0,0 +1,155 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_CROSS_LANE_SELECT_HPP
+#define ROCWMMA_CROSS_LANE_SELECT_HPP
+
+#include "cross_lane_ops.hpp"
+#include "dpp.hpp"
+#include "permute.hpp"
+#include "swizzle.hpp"
+
+namespace rocwmma
+{
+
+    namespace CrossLane
+    {
+        /**
+         * \ingroup Cross_Lane_Operations
+         *
+         * @brief Cross-lane operations that more than one backend implements. Each op is
+         * issued on the cheapest backend supported by the current target, according to
+         * CrossLaneOps::OpCost.
+         *
+         * Use these in place of the backend front-ends (Dpp, Swizzle, Permute) unless the
+         * op needs backend-specific features, such as dpp row and bank write masks.
+         *
+         * @{
+         */
+
+        /*! \class Driver
+        *  \brief A front-end utility that invokes a cross-lane op through the driver of its backend.
+        *
+        * @tparam CrossLaneOp - fully qualified op class of the dpp, swizzle or permute backend
+        */
+        template <typename CrossLaneOp>
+        struct Driver
+        {
+            static_assert(CrossLaneOps::isSupported<CrossLaneOp>(),
+                          "CrossLaneOp is not supported on this target");
+
+            template <typename DataT>
+            ROCWMMA_DEVICE static inline auto exec(DataT const& src)
+            {
+                if constexpr(CrossLaneOp::opImpl() == CrossLaneOps::Properties::OP_IMPL_DPP)
+                {
+                    return Dpp::Driver<CrossLaneOp>::exec(src);
+                }
+                else if constexpr(CrossLaneOp::opImpl()
+                                  == CrossLaneOps::Properties::OP_IMPL_SWIZZLE)
+                {
+                    return Swizzle::Driver<CrossLaneOp>::exec(src);
+                }
+                else
+                {
+                    return Permute::Driver<CrossLaneOp>::exec(src);
+                }
+            }
+        };
+
+        template <typename... CandidateOps>
+        using Select = Driver<CrossLaneOps::OpSelect_t<CandidateOps...>>;
+
+        /// Cross-lane ops interface
+        // Func::exec(src0)
+
+        // BCast variants
+        template <uint32_t ElementIdx>
+        using BCast16 = Select<DppImpl::Ops::BCast16<ElementIdx>,
+                               SwizzleImpl::Ops::BCast16<ElementIdx>>;
+
+        template <uint32_t ElementIdx>
+        using BCast4
+            = Select<DppImpl::Ops::BCast4<ElementIdx>, SwizzleImpl::Ops::BCast4<ElementIdx>>;
+
+        template <uint32_t ElementIdx>
+        using BCast2
+            = Select<DppImpl::Ops::BCast2<ElementIdx>, SwizzleImpl::Ops::BCast2<ElementIdx>>;
+
+        // Reversal variants
+        using Reverse16 = Select<DppImpl::Ops::Reverse16, SwizzleImpl::Ops::Reverse16>;
+
+        using Reverse8 = Select<DppImpl::Ops::Reverse8, SwizzleImpl::Ops::Reverse8>;
+
+        using Reverse4 = Select<DppImpl::Ops::Reverse4, SwizzleImpl::Ops::Reverse4>;
+
+        using Reverse2 = Select<DppImpl::Ops::Reverse2, SwizzleImpl::Ops::Reverse2>;
+
+        // Rotation variants
+        using RotateWaveR1
+            = Select<DppImpl::Ops::RotateWaveR1, PermuteImpl::Ops::RotateWaveR<1u>>;
+
+        using RotateWaveL1
+            = Select<DppImpl::Ops::RotateWaveL1, PermuteImpl::Ops::RotateWaveL<1u>>;
+
+        template <uint32_t RotateDistance>
+        using RotateR16 = Select<DppImpl::Ops::RotateR16<RotateDistance>,
+                                 SwizzleImpl::Ops::RotateR16<RotateDistance>>;
+
+        template <uint32_t RotateDistance>
+        using RotateR4 = Select<DppImpl::Ops::RotateR4<RotateDistance>,
+                                SwizzleImpl::Ops::RotateR4<RotateDistance>>;
+
+        template <uint32_t RotateDistance>
+        using RotateL4 = Select<DppImpl::Ops::RotateL4<RotateDistance>,
+                                SwizzleImpl::Ops::RotateL4<RotateDistance>>;
+
+        template <uint32_t RotateDistance>
+        using RotateR2 = Select<DppImpl::Ops::RotateR2<RotateDistance>,
+                                SwizzleImpl::Ops::RotateR2<RotateDistance>>;
+
+        template <uint32_t RotateDistance>
+        using RotateL2 = Select<DppImpl::Ops::RotateL2<RotateDistance>,
+                                SwizzleImpl::Ops::RotateL2<RotateDistance>>;
+
+        // Shuffle variants
+        template <uint32_t Select0, uint32_t Select1, uint32_t Select2, uint32_t Select3>
+        using Shuffle4 = Select<DppImpl::Ops::Shuffle4<Select0, Select1, Select2, Select3>,
+                                SwizzleImpl::Ops::Shuffle4<Select0, Select1, Select2, Select3>>;
+
+        template <uint32_t Select0, uint32_t Select1>
+        using Shuffle2 = Select<DppImpl::Ops::Shuffle2<Select0, Select1>,
+                                SwizzleImpl::Ops::Shuffle2<Select0, Select1>>;
+
+        // Swap variants
+        using Swap2 = Select<DppImpl::Ops::Swap2, SwizzleImpl::Ops::Swap2>;
+
+        /** @}*/
+
+    } // namespace CrossLane
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_CROSS_LANE_SELECT_HPP
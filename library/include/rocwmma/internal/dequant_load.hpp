@@ -0,0 +1,209 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_DEQUANT_LOAD_HPP
+#define ROCWMMA_DEQUANT_LOAD_HPP
+
+#include "convert.hpp"
+#include "io_traits.hpp"
+#include "layout.hpp"
+#include "tuple.hpp"
+#include "types.hpp"
+#include "vector_iterator.hpp"
+
+namespace rocwmma
+{
+
+    namespace detail
+    {
+
+        // Loads VectorWidth contiguous elements of QuantT and converts them to DataT.
+        // Offset is in elements of QuantT.
+        template <typename QuantT, typename DataT, uint32_t VectorWidth>
+        struct amdgcn_dequant_load
+        {
+            static_assert(VectorWidth > 0, "Vector width must be greater than 0");
+            static_assert(sizeof(QuantT[VectorWidth]) == sizeof(VecT<QuantT, VectorWidth>),
+                          "Cannot vectorize input");
+
+            using LoadT   = VecT<QuantT, VectorWidth>;
+            using OutputT = VecT<DataT, VectorWidth>;
+
+            ROCWMMA_DEVICE static inline void
+                exec(OutputT& data, QuantT const* dataPtr, index_t offset = 0)
+            {
+                data = Convert<QuantT, DataT>::exec(
+                    *reinterpret_cast<LoadT const*>(&(dataPtr[offset])));
+            }
+        };
+
+        // Packed int4 has no addressable element, so the offset is in int4 elements
+        // and is resolved to the byte and nibble here.
+        // Even vector widths load VectorWidth / 2 whole bytes, and assume an even offset.
+        template <typename DataT, uint32_t VectorWidth>
+        struct amdgcn_dequant_load<int4x2_t, DataT, VectorWidth>
+        {
+            static_assert(VectorWidth > 0, "Vector width must be greater than 0");
+            static_assert(VectorWidth <= 16u, "Vector width must be 16 or less");
+
+            using OutputT = VecT<DataT, VectorWidth>;
+
+            // Sign-extends the int4 at nibble index idx of bits
+            template <typename BitsT>
+            ROCWMMA_DEVICE static inline DataT unpack(BitsT bits, uint32_t idx)
+            {
+                auto nibble = static_cast<int32_t>((bits >> (4u * idx)) & 0xFu);
+                return static_cast<DataT>(static_cast<float32_t>((nibble ^ 0x8) - 0x8));
+            }
+
+            ROCWMMA_DEVICE static inline void
+                exec(OutputT& data, int4x2_t const* dataPtr, index_t offset = 0)
+            {
+                auto bytes = reinterpret_cast<uint8_t const*>(dataPtr);
+
+                if constexpr(VectorWidth % 2u == 0u)
+                {
+                    using BitsT = conditional_t<
+                        VectorWidth == 2u,
+                        uint8_t,
+                        conditional_t<VectorWidth == 4u,
+                                      uint16_t,
+                                      conditional_t<VectorWidth == 8u, uint32_t, uint64_t>>>;
+
+                    auto bits = *reinterpret_cast<BitsT const*>(bytes + offset / 2);
+
+#pragma unroll
+                    for(uint32_t i = 0; i < VectorWidth; i++)
+                    {
+                        data.data[i] = unpack(bits, i);
+                    }
+                }
+                else
+                {
+#pragma unroll
+                    for(uint32_t i = 0; i < VectorWidth; i++)
+                    {
+                        auto element = offset + static_cast<index_t>(i);
+                        data.data[i] = unpack(bytes[element / 2], element % 2);
+                    }
+                }
+            }
+        };
+
+    } // namespace detail
+
+    // Loads quantized data of QuantT with the matrix layout of a DataT fragment,
+    // then converts each vector to DataT in registers.
+    // Structurally identical to OpaqueLoad, however the data is traversed by element
+    // offsets rather than pointers, as packed types are not element addressable.
+    template <uint32_t BlockDim,
+              uint32_t BlockK,
+              typename QuantT,
+              typename DataT,
+              class DataLayout,
+              class MatrixLayout,
+              uint32_t VectorWidth>
+    struct DequantLoad
+    {
+        using IOTraits = IOTraits<BlockDim, BlockK, DataT, VectorWidth>;
+
+        struct Traits
+        {
+            // Raw IO on unpacked register data.
+            using Loader  = detail::amdgcn_dequant_load<QuantT, DataT, VectorWidth>;
+            using LoadT   = typename Loader::OutputT;
+            using OutputT = VecT<DataT, IOTraits::UnpackedSize>;
+        };
+
+        using LoadVecTraits = VecTraits<typename Traits::LoadT>;
+
+        // Outer loop = index 0,
+        // Inner loop = index N-1
+        template <size_t Depth = 0,
+                  typename Iterator,
+                  typename StrideCounts,
+                  typename Strides2d>
+        ROCWMMA_DEVICE static inline auto unroll_right(Iterator&      out,
+                                                       QuantT const*  dataPtr,
+                                                       index_t        offset,
+                                                       uint32_t       ldm,
+                                                       StrideCounts&& strideCounts,
+                                                       Strides2d&&    strides2d)
+        {
+            auto strideOffset = DataLayout::fromMatrixCoord(get<Depth>(strides2d), ldm);
+            auto strideCount  = get<Depth>(strideCounts);
+
+            // Last depth layer will invoke the load
+            if constexpr(Depth == (VecTraits<decay_t<StrideCounts>>::size() - 1u))
+            {
+#pragma unroll
+                for(int i = 0; i < strideCount; i++)
+                {
+                    Traits::Loader::exec(*out, dataPtr, offset);
+                    offset += strideOffset;
+                    out++;
+                }
+            }
+            // Recurse to the next nested layer
+            else
+            {
+#pragma unroll
+                for(int i = 0; i < strideCount; i++)
+                {
+                    unroll_right<Depth + 1>(out, dataPtr, offset, ldm, strideCounts, strides2d);
+                    offset += strideOffset;
+                }
+            }
+        }
+
+        ROCWMMA_DEVICE static void
+            exec(typename Traits::OutputT& data, QuantT const* dataPtr, uint32_t ldm)
+        {
+            // Arrange wave threads to starting matrix layout offsets.
+            auto baseOffset2d = MatrixLayout::baseOffset();
+            auto it           = makeVectorIterator<LoadVecTraits::size()>(data).begin();
+
+            static_assert(decltype(it)::range() == IOTraits::IOCount,
+                          "IOCount inconsistent with iterator range");
+
+            // Make sure that the IOCount is consistent with the number of total strides
+            static_assert(IOTraits::IOCount
+                              == apply([](auto... items) { return (items * ...); },
+                                       MatrixLayout::strideCounts()),
+                          "IOCount inconsistent with total strides");
+
+            // Unroll loading in each strided dimension
+            unroll_right(it,
+                         dataPtr,
+                         DataLayout::fromMatrixCoord(baseOffset2d, ldm),
+                         ldm,
+                         MatrixLayout::strideCounts(),
+                         MatrixLayout::strides());
+        }
+    };
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_DEQUANT_LOAD_HPP
@@ -0,0 +1,112 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_FAST_MATH_HPP
+#define ROCWMMA_FAST_MATH_HPP
+
+#include "types.hpp"
+
+namespace rocwmma
+{
+    namespace detail
+    {
+        // Float32 transcendentals on the hardware approximations, in place of the libm
+        // sequences that range-reduce, handle denormals and refine to 0.5 ulp.
+        // Error bounds are relative (rel) or absolute (abs), and assume finite inputs:
+        // - exp2:    v_exp_f32, rel 2^-23. Results below 2^-126 flush to zero.
+        // - log2:    v_log_f32, abs 2^-21. Denormal inputs flush to zero.
+        // - rcp:     v_rcp_f32, rel 2^-23. Denormal results flush to zero.
+        // - exp:     exp2(x * log2(e)), rel 2^-22 + |x| * 2^-24, from the rounding of x * log2(e).
+        // - log:     log2(x) * ln(2), abs 2^-21.
+        // - sigmoid: rcp(1 + exp(-x)), rel 2^-21 + |x| * 2^-24.
+        // - tanh:    2 * sigmoid(2x) - 1, abs 2^-20 + |x| * 2^-22.
+        // - silu:    x * sigmoid(x), rel 2^-21 + |x| * 2^-24.
+        // - gelu:    x * sigmoid(2u) = 0.5 * x * (1 + tanh(u)),
+        //            u = sqrt(2 / pi) * (x + 0.044715 * x^3), rel 2^-20 + |u| * 2^-21.
+        //            Unlike the tanh form, 1 + tanh(u) doesn't cancel for x < 0.
+        // Activations saturate correctly: exp(-x) overflows to inf for large negative x, and
+        // rcp(inf) = 0.
+        // Transcendental units have no packed forms, and v_exp_f16 runs at the rate of v_exp_f32:
+        // reduced precision types are evaluated in float32_t by the callers.
+        struct FastMath
+        {
+            constexpr static float32_t Log2E = 1.4426950408889634f;
+            constexpr static float32_t Ln2   = 0.6931471805599453f;
+
+            // 2 * sqrt(2 / pi) and 2 * sqrt(2 / pi) * 0.044715
+            constexpr static float32_t GeluA = 1.5957691216057308f;
+            constexpr static float32_t GeluB = 0.0713548162726003f;
+
+            ROCWMMA_DEVICE static inline float32_t exp2(float32_t x)
+            {
+                return __builtin_amdgcn_exp2f(x);
+            }
+
+            ROCWMMA_DEVICE static inline float32_t log2(float32_t x)
+            {
+                return __builtin_amdgcn_logf(x);
+            }
+
+            ROCWMMA_DEVICE static inline float32_t rcp(float32_t x)
+            {
+                return __builtin_amdgcn_rcpf(x);
+            }
+
+            ROCWMMA_DEVICE static inline float32_t exp(float32_t x)
+            {
+                return exp2(x * Log2E);
+            }
+
+            ROCWMMA_DEVICE static inline float32_t log(float32_t x)
+            {
+                return log2(x) * Ln2;
+            }
+
+            ROCWMMA_DEVICE static inline float32_t sigmoid(float32_t x)
+            {
+                return rcp(1.0f + exp(-x));
+            }
+
+            ROCWMMA_DEVICE static inline float32_t tanh(float32_t x)
+            {
+                return __builtin_fmaf(2.0f, sigmoid(2.0f * x), -1.0f);
+            }
+
+            ROCWMMA_DEVICE static inline float32_t silu(float32_t x)
+            {
+                return x * sigmoid(x);
+            }
+
+            ROCWMMA_DEVICE static inline float32_t gelu(float32_t x)
+            {
+                return x * sigmoid(x * __builtin_fmaf(GeluB, x * x, GeluA));
+            }
+        };
+
+    } // namespace detail
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_FAST_MATH_HPP
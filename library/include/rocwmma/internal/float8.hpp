@@ -39,15 +39,26 @@ using uint16_t = __hip_internal::uint16_t;
 // We are clipping in down conversion by default
 #define rocwmma_F8_downcast_clipping 1
 
+// Hardware conversions of the FNUZ encodings (rocwmma_f8, rocwmma_bf8)
 #define ROCWMMA_F8_DEVICE_SUPPORT \
-    ROCWMMA_ARCH_GFX940 || ROCWMMA_ARCH_GFX941 || ROCWMMA_ARCH_GFX942 || ROCWMMA_GFX12
+    ROCWMMA_ARCH_GFX940 || ROCWMMA_ARCH_GFX941 || ROCWMMA_ARCH_GFX942
+
+// Hardware conversions of the OCP encodings (rocwmma_f8_ocp, rocwmma_bf8_ocp)
+#define ROCWMMA_F8_OCP_DEVICE_SUPPORT ROCWMMA_ARCH_GFX12
 
 namespace rocwmma_hip_f8_impl
 {
-    template <int wm, int we, typename T, bool negative_zero_nan, bool clip>
+    // ocp selects the OCP 8-bit floating point encodings (E4M3FN, E5M2), requires
+    // negative_zero_nan = false.
+    template <int  wm,
+              int  we,
+              typename T,
+              bool negative_zero_nan,
+              bool clip,
+              bool ocp = false>
     ROCWMMA_HOST_DEVICE uint8_t cast_to_f8(T _x, bool stoch = false, uint32_t rng = 0);
 
-    template <int wm, int we, typename T, bool negative_zero_nan>
+    template <int wm, int we, typename T, bool negative_zero_nan, bool ocp = false>
     ROCWMMA_HOST_DEVICE T cast_from_f8(uint8_t x);
 
 } // namespace rocwmma_hip_f8_impl
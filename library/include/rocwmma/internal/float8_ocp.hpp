@@ -0,0 +1,560 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef ROCWMMA_FLOAT8_OCP_H
+#define ROCWMMA_FLOAT8_OCP_H
+
+#include "float8.hpp"
+
+// OCP 8-bit floating point types, as defined by the OCP OFP8 specification.
+//
+// rocwmma_f8 / rocwmma_bf8 (float8.hpp) use the FNUZ encodings of gfx940, gfx941 and gfx942:
+// exponent biases of 8 / 16, a single NaN at 0x80 and no negative zero or infinity.
+// gfx1200 and gfx1201 instead use the OCP encodings:
+// : E4M3 (E4M3FN) - bias 7, max 448, NaN at S.1111.111, no infinity
+// : E5M2          - bias 15, max 57344, IEEE-like infinity and NaN
+// Both encodings carry negative zero. The same bit pattern therefore decodes to
+// different values (e.g. 0x40 is 2.0f in FNUZ E4M3, 4.0f in OCP E4M3), and data
+// must be converted when exchanged between the two. Conversions go through float32_t,
+// with RNE rounding and clipping to the finite range of the destination.
+template <int wm, int we>
+struct rocwmma_ocp_f8
+{
+    static_assert((wm == 3 && we == 4) || (wm == 2 && we == 5),
+                  "OCP 8-bit floating point is one of E4M3 or E5M2");
+
+    uint8_t data;
+    enum class rocwmma_hip_f8_rounding_mode
+    {
+        standard,
+        stochastic
+    };
+
+    // Largest finite value, as the clipping bound
+    static constexpr float max_finite = (we == 4) ? 448.0f : 57344.0f;
+
+    // default constructor
+    ROCWMMA_HOST_DEVICE rocwmma_ocp_f8() = default;
+
+#if ROCWMMA_F8_OCP_DEVICE_SUPPORT
+    // device specific optimized OCP F8 down-conversion code
+    template <bool stochastic_rounding = false>
+    static ROCWMMA_DEVICE uint8_t cast_to_f8_from_f32(float v, uint32_t rng = 0)
+    {
+#ifdef rocwmma_F8_downcast_clipping
+        /// propagate NAN/INF, no clipping
+        if((__builtin_bit_cast(uint32_t, v) & 0x7F800000) != 0x7F800000)
+        {
+            v = __builtin_amdgcn_fmed3f(v, max_finite, -max_finite);
+        }
+#endif // rocwmma_F8_downcast_clipping
+
+        uint32_t ival;
+        if constexpr(stochastic_rounding)
+        {
+            ival = (we == 4) ? __builtin_amdgcn_cvt_sr_fp8_f32(v, rng, 0, 0)
+                             : __builtin_amdgcn_cvt_sr_bf8_f32(v, rng, 0, 0);
+        }
+        else // RNE CVT
+        {
+            ival = (we == 4) ? __builtin_amdgcn_cvt_pk_fp8_f32(v, v, 0, false)
+                             : __builtin_amdgcn_cvt_pk_bf8_f32(v, v, 0, false);
+        }
+        return static_cast<uint8_t>(ival & 0xFF); // BYTE0
+    }
+
+    // NOTE: ON-DEVICE... OCP encoding in h/w
+    explicit ROCWMMA_DEVICE rocwmma_ocp_f8(float                        v,
+                                           rocwmma_hip_f8_rounding_mode rm
+                                           = rocwmma_hip_f8_rounding_mode::standard,
+                                           uint32_t rng = 0)
+    {
+        if(rm == rocwmma_hip_f8_rounding_mode::stochastic)
+        {
+            data = cast_to_f8_from_f32<true>(v, rng);
+        }
+        else
+        {
+            data = cast_to_f8_from_f32<false>(v);
+        }
+    }
+
+    // Host only implementation using s/w simulation
+    explicit ROCWMMA_HOST
+#else
+    // both Host and DEVICE for non-gfx12 using s/w simulation
+    explicit ROCWMMA_HOST_DEVICE
+#endif // ROCWMMA_F8_OCP_DEVICE_SUPPORT
+        rocwmma_ocp_f8(float                        v,
+                       rocwmma_hip_f8_rounding_mode rm  = rocwmma_hip_f8_rounding_mode::standard,
+                       uint32_t                     rng = 0)
+    {
+#ifdef rocwmma_F8_downcast_clipping
+        data = rocwmma_hip_f8_impl::
+            cast_to_f8<wm, we, float, false /*negative_zero_nan*/, true /*clip*/, true /*ocp*/>(
+                v, (rm == rocwmma_hip_f8_rounding_mode::stochastic), rng);
+#else // rocwmma_F8_downcast_clipping
+        data = rocwmma_hip_f8_impl::
+            cast_to_f8<wm, we, float, false /*negative_zero_nan*/, false /*clip*/, true /*ocp*/>(
+                v, (rm == rocwmma_hip_f8_rounding_mode::stochastic), rng);
+#endif // rocwmma_F8_downcast_clipping
+    }
+
+    // Constructor from half
+    explicit ROCWMMA_HOST_DEVICE rocwmma_ocp_f8(_Float16                     v,
+                                                rocwmma_hip_f8_rounding_mode rm
+                                                = rocwmma_hip_f8_rounding_mode::standard,
+                                                uint32_t rng = 0)
+        : rocwmma_ocp_f8((float)v, rm, rng)
+    {
+    }
+
+    // constructor from int
+    explicit ROCWMMA_HOST_DEVICE rocwmma_ocp_f8(int                          v,
+                                                rocwmma_hip_f8_rounding_mode rm
+                                                = rocwmma_hip_f8_rounding_mode::standard,
+                                                uint32_t rng = 0)
+        : rocwmma_ocp_f8((float)v, rm, rng)
+    {
+    }
+
+    // constructor from unsigned int
+    explicit ROCWMMA_HOST_DEVICE rocwmma_ocp_f8(unsigned int                 v,
+                                                rocwmma_hip_f8_rounding_mode rm
+                                                = rocwmma_hip_f8_rounding_mode::standard,
+                                                uint32_t rng = 0)
+        : rocwmma_ocp_f8((float)v, rm, rng)
+    {
+    }
+
+    // constructor from double
+    explicit ROCWMMA_HOST_DEVICE rocwmma_ocp_f8(double                       v,
+                                                rocwmma_hip_f8_rounding_mode rm
+                                                = rocwmma_hip_f8_rounding_mode::standard,
+                                                uint32_t rng = 0)
+        : rocwmma_ocp_f8((float)v, rm, rng)
+    {
+    }
+
+    // Re-encoding constructors from the FNUZ types. Every FNUZ value is in the
+    // finite range of the OCP type of the same width, but FNUZ NaN stays NaN and
+    // the smallest FNUZ subnormals round.
+    explicit ROCWMMA_HOST_DEVICE rocwmma_ocp_f8(rocwmma_f8 v)
+        : rocwmma_ocp_f8(float(v))
+    {
+    }
+
+    explicit ROCWMMA_HOST_DEVICE rocwmma_ocp_f8(rocwmma_bf8 v)
+        : rocwmma_ocp_f8(float(v))
+    {
+    }
+
+    // convert to float
+#if ROCWMMA_F8_OCP_DEVICE_SUPPORT
+    // upcast using device specific intrinsic
+    explicit inline ROCWMMA_DEVICE operator float() const
+    {
+        if constexpr(we == 4)
+        {
+            return __builtin_amdgcn_cvt_f32_fp8(static_cast<int>(data), 0);
+        }
+        else
+        {
+            return __builtin_amdgcn_cvt_f32_bf8(static_cast<int>(data), 0);
+        }
+    }
+
+    explicit inline ROCWMMA_HOST operator float() const
+#else // non gfx12
+    explicit inline ROCWMMA_HOST_DEVICE operator float() const
+#endif // ROCWMMA_F8_OCP_DEVICE_SUPPORT
+    {
+        return rocwmma_hip_f8_impl::
+            cast_from_f8<wm, we, float, false /*negative_zero_nan*/, true /*ocp*/>(data);
+    }
+
+    // convert to half
+    explicit inline ROCWMMA_HOST_DEVICE operator _Float16() const
+    {
+        return _Float16(float(*this)); // convert to float, then convert to f16
+    }
+
+    // convert to unsigned int
+    explicit inline ROCWMMA_HOST_DEVICE operator uint32_t() const
+    {
+        return uint32_t(float(*this)); // convert to float, then convert to u32
+    }
+
+    // convert to long
+    explicit inline ROCWMMA_HOST_DEVICE operator long() const
+    {
+        return long(float(*this)); // convert to float, then convert to long
+    }
+
+    // convert to double
+    explicit inline ROCWMMA_HOST_DEVICE operator double() const
+    {
+        return double(float(*this)); // convert to float, then convert to double
+    }
+
+    // Re-encoding to the FNUZ types. Values above the FNUZ range clip to its max,
+    // and the OCP infinities and NaNs become the FNUZ NaN.
+    explicit inline ROCWMMA_HOST_DEVICE operator rocwmma_f8() const
+    {
+        return rocwmma_f8(float(*this));
+    }
+
+    explicit inline ROCWMMA_HOST_DEVICE operator rocwmma_bf8() const
+    {
+        return rocwmma_bf8(float(*this));
+    }
+
+    inline ROCWMMA_HOST_DEVICE rocwmma_ocp_f8 operator-()
+    {
+        this->data ^= 0x80;
+        return *this;
+    }
+
+    // check for zero, of either sign
+    inline ROCWMMA_HOST_DEVICE bool is_zero() const
+    {
+        return (data & 0x7F) == 0x00;
+    }
+
+    // check for nan
+    inline ROCWMMA_HOST_DEVICE bool is_nan() const
+    {
+        return (we == 4) ? ((data & 0x7F) == 0x7F) : ((data & 0x7F) > 0x7C);
+    }
+
+    // check for inf
+    inline ROCWMMA_HOST_DEVICE bool is_inf() const
+    {
+        return (we == 4) ? false : ((data & 0x7F) == 0x7C);
+    }
+};
+
+// OCP E4M3
+using rocwmma_f8_ocp = rocwmma_ocp_f8<3, 4>;
+
+// OCP E5M2
+using rocwmma_bf8_ocp = rocwmma_ocp_f8<2, 5>;
+
+#if !defined(__HIPCC_RTC__)
+
+// Special operator overloading
+template <int wm, int we>
+inline std::ostream& operator<<(std::ostream& os, const rocwmma_ocp_f8<wm, we>& f8)
+{
+    return os << float(f8);
+}
+
+#endif // !defined(__HIPCC_RTC__)
+
+// Arithmetic converts to f32, does computation in f32, and returns float,
+// except for same-type + and - as with rocwmma_f8 / rocwmma_bf8.
+template <int wm, int we>
+inline ROCWMMA_HOST_DEVICE float operator+(const float fa, rocwmma_ocp_f8<wm, we> b)
+{
+    return (fa + float(b));
+}
+
+template <int wm, int we>
+inline ROCWMMA_HOST_DEVICE float operator+(rocwmma_ocp_f8<wm, we> a, const float fb)
+{
+    return (float(a) + fb);
+}
+
+template <int wm, int we>
+inline ROCWMMA_HOST_DEVICE rocwmma_ocp_f8<wm, we> operator+(rocwmma_ocp_f8<wm, we> a,
+                                                            rocwmma_ocp_f8<wm, we> b)
+{
+    return rocwmma_ocp_f8<wm, we>(float(a) + float(b));
+}
+
+template <int wm, int we>
+inline ROCWMMA_HOST_DEVICE rocwmma_ocp_f8<wm, we>& operator+=(rocwmma_ocp_f8<wm, we>& a,
+                                                              rocwmma_ocp_f8<wm, we>  b)
+{
+    return a = rocwmma_ocp_f8<wm, we>(float(a) + float(b));
+}
+
+template <int wm, int we>
+inline ROCWMMA_HOST_DEVICE float operator-(const float fa, rocwmma_ocp_f8<wm, we> b)
+{
+    return (fa - float(b));
+}
+
+template <int wm, int we>
+inline ROCWMMA_HOST_DEVICE float operator-(rocwmma_ocp_f8<wm, we> a, const float fb)
+{
+    return (float(a) - fb);
+}
+
+template <int wm, int we>
+inline ROCWMMA_HOST_DEVICE rocwmma_ocp_f8<wm, we> operator-(rocwmma_ocp_f8<wm, we> a,
+                                                            rocwmma_ocp_f8<wm, we> b)
+{
+    return rocwmma_ocp_f8<wm, we>(float(a) - float(b));
+}
+
+template <int wm, int we>
+inline ROCWMMA_HOST_DEVICE rocwmma_ocp_f8<wm, we>& operator-=(rocwmma_ocp_f8<wm, we>& a,
+                                                              rocwmma_ocp_f8<wm, we>  b)
+{
+    return a = rocwmma_ocp_f8<wm, we>(float(a) - float(b));
+}
+
+template <int wm, int we>
+inline ROCWMMA_HOST_DEVICE float operator*(rocwmma_ocp_f8<wm, we> a, rocwmma_ocp_f8<wm, we> b)
+{
+    return float(a) * float(b);
+}
+
+template <int wm, int we>
+inline ROCWMMA_HOST_DEVICE float operator*(float a, rocwmma_ocp_f8<wm, we> b)
+{
+    return (a * float(b));
+}
+
+template <int wm, int we>
+inline ROCWMMA_HOST_DEVICE float operator*(rocwmma_ocp_f8<wm, we> a, float b)
+{
+    return (float(a) * b);
+}
+
+template <int wm, int we>
+inline ROCWMMA_HOST_DEVICE float operator*(int32_t a, rocwmma_ocp_f8<wm, we> b)
+{
+    return ((float)a * float(b));
+}
+
+template <int wm, int we>
+inline ROCWMMA_HOST_DEVICE float operator*(double a, rocwmma_ocp_f8<wm, we> b)
+{
+    return ((float)a * float(b));
+}
+
+template <int wm, int we>
+inline ROCWMMA_HOST_DEVICE float operator/(rocwmma_ocp_f8<wm, we> a, rocwmma_ocp_f8<wm, we> b)
+{
+    return float(a) / float(b);
+}
+
+template <int wm, int we>
+inline ROCWMMA_HOST_DEVICE float operator/(float a, rocwmma_ocp_f8<wm, we> b)
+{
+    return (a / float(b));
+}
+
+template <int wm, int we>
+inline ROCWMMA_HOST_DEVICE float operator/(rocwmma_ocp_f8<wm, we> a, float b)
+{
+    return (float(a) / b);
+}
+
+template <int wm, int we>
+inline ROCWMMA_HOST_DEVICE float operator/(int32_t a, rocwmma_ocp_f8<wm, we> b)
+{
+    return ((float)a / float(b));
+}
+
+template <int wm, int we>
+inline ROCWMMA_HOST_DEVICE float operator/(double a, rocwmma_ocp_f8<wm, we> b)
+{
+    return ((float)a / float(b));
+}
+
+template <int wm, int we>
+inline ROCWMMA_HOST_DEVICE rocwmma_ocp_f8<wm, we>& operator/=(rocwmma_ocp_f8<wm, we>& a,
+                                                              rocwmma_ocp_f8<wm, we>  b)
+{
+    return a = rocwmma_ocp_f8<wm, we>(float(a) / float(b));
+}
+
+// overloading for compare
+template <int wm, int we>
+inline ROCWMMA_HOST_DEVICE bool operator==(rocwmma_ocp_f8<wm, we> a, rocwmma_ocp_f8<wm, we> b)
+{
+    return (a.data == b.data);
+}
+
+template <int wm, int we>
+inline ROCWMMA_HOST_DEVICE bool operator!=(rocwmma_ocp_f8<wm, we> a, rocwmma_ocp_f8<wm, we> b)
+{
+    return (a.data != b.data);
+}
+
+#include "utility/numeric_limits.hpp"
+namespace rocwmma
+{
+    namespace detail
+    {
+        struct Fp8OcpBits
+        {
+            union
+            {
+                uint8_t         i8;
+                rocwmma_f8_ocp  f8;
+                rocwmma_bf8_ocp bf8;
+            };
+            constexpr Fp8OcpBits(uint8_t initVal)
+                : i8(initVal)
+            {
+            }
+            constexpr Fp8OcpBits(rocwmma_f8_ocp initVal)
+                : f8(initVal)
+            {
+            }
+            constexpr Fp8OcpBits(rocwmma_bf8_ocp initVal)
+                : bf8(initVal)
+            {
+            }
+        };
+
+    } // namespace detail
+
+} // namespace rocwmma
+
+namespace ROCWMMA_NUMERIC_LIMITS_IMPL_NAMESPACE
+{
+    ///////////////////////////////////////////////////////////
+    ////////////  numeric_limits<rocwmma_f8_ocp>  /////////////
+    ///////////////////////////////////////////////////////////
+    // @cond
+    template <>
+    ROCWMMA_HOST_DEVICE constexpr rocwmma_f8_ocp numeric_limits<rocwmma_f8_ocp>::epsilon() noexcept
+    {
+        rocwmma::detail::Fp8OcpBits eps(static_cast<uint8_t>(0x20));
+        return eps.f8;
+    }
+
+    // E4M3FN has no infinity
+    template <>
+    ROCWMMA_HOST_DEVICE constexpr rocwmma_f8_ocp numeric_limits<rocwmma_f8_ocp>::infinity() noexcept
+    {
+        rocwmma::detail::Fp8OcpBits eps(static_cast<uint8_t>(0x7F));
+        return eps.f8;
+    }
+
+    template <>
+    ROCWMMA_HOST_DEVICE constexpr rocwmma_f8_ocp numeric_limits<rocwmma_f8_ocp>::lowest() noexcept
+    {
+        rocwmma::detail::Fp8OcpBits eps(static_cast<uint8_t>(0xFE));
+        return eps.f8;
+    }
+
+    template <>
+    ROCWMMA_HOST_DEVICE constexpr rocwmma_f8_ocp numeric_limits<rocwmma_f8_ocp>::max() noexcept
+    {
+        rocwmma::detail::Fp8OcpBits eps(static_cast<uint8_t>(0x7E));
+        return eps.f8;
+    }
+
+    template <>
+    ROCWMMA_HOST_DEVICE constexpr rocwmma_f8_ocp numeric_limits<rocwmma_f8_ocp>::min() noexcept
+    {
+        rocwmma::detail::Fp8OcpBits eps(static_cast<uint8_t>(0x01));
+        return eps.f8;
+    }
+
+    template <>
+    ROCWMMA_HOST_DEVICE constexpr rocwmma_f8_ocp
+        numeric_limits<rocwmma_f8_ocp>::quiet_NaN() noexcept
+    {
+        rocwmma::detail::Fp8OcpBits eps(static_cast<uint8_t>(0x7F));
+        return eps.f8;
+    }
+
+    template <>
+    ROCWMMA_HOST_DEVICE constexpr rocwmma_f8_ocp
+        numeric_limits<rocwmma_f8_ocp>::signaling_NaN() noexcept
+    {
+        rocwmma::detail::Fp8OcpBits eps(static_cast<uint8_t>(0x7F));
+        return eps.f8;
+    }
+
+    ///////////////////////////////////////////////////////////
+    ////////////  numeric_limits<rocwmma_bf8_ocp>  ////////////
+    ///////////////////////////////////////////////////////////
+
+    template <>
+    ROCWMMA_HOST_DEVICE constexpr rocwmma_bf8_ocp
+        numeric_limits<rocwmma_bf8_ocp>::epsilon() noexcept
+    {
+        rocwmma::detail::Fp8OcpBits eps(static_cast<uint8_t>(0x34));
+        return eps.bf8;
+    }
+
+    template <>
+    ROCWMMA_HOST_DEVICE constexpr rocwmma_bf8_ocp
+        numeric_limits<rocwmma_bf8_ocp>::infinity() noexcept
+    {
+        rocwmma::detail::Fp8OcpBits eps(static_cast<uint8_t>(0x7C));
+        return eps.bf8;
+    }
+
+    template <>
+    ROCWMMA_HOST_DEVICE constexpr rocwmma_bf8_ocp numeric_limits<rocwmma_bf8_ocp>::lowest() noexcept
+    {
+        rocwmma::detail::Fp8OcpBits eps(static_cast<uint8_t>(0xFB));
+        return eps.bf8;
+    }
+
+    template <>
+    ROCWMMA_HOST_DEVICE constexpr rocwmma_bf8_ocp numeric_limits<rocwmma_bf8_ocp>::max() noexcept
+    {
+        rocwmma::detail::Fp8OcpBits eps(static_cast<uint8_t>(0x7B));
+        return eps.bf8;
+    }
+
+    template <>
+    ROCWMMA_HOST_DEVICE constexpr rocwmma_bf8_ocp numeric_limits<rocwmma_bf8_ocp>::min() noexcept
+    {
+        rocwmma::detail::Fp8OcpBits eps(static_cast<uint8_t>(0x01));
+        return eps.bf8;
+    }
+
+    template <>
+    ROCWMMA_HOST_DEVICE constexpr rocwmma_bf8_ocp
+        numeric_limits<rocwmma_bf8_ocp>::quiet_NaN() noexcept
+    {
+        rocwmma::detail::Fp8OcpBits eps(static_cast<uint8_t>(0x7E));
+        return eps.bf8;
+    }
+
+    template <>
+    ROCWMMA_HOST_DEVICE constexpr rocwmma_bf8_ocp
+        numeric_limits<rocwmma_bf8_ocp>::signaling_NaN() noexcept
+    {
+        rocwmma::detail::Fp8OcpBits eps(static_cast<uint8_t>(0x7D));
+        return eps.bf8;
+    }
+    //@endcond
+
+} // namespace ROCWMMA_NUMERIC_LIMITS_IMPL_NAMESPACE
+
+#endif // ROCWMMA_FLOAT8_OCP_H
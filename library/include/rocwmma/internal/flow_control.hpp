@@ -67,10 +67,39 @@ namespace rocwmma
             }
         };
 
+        // Fills a scheduling group of size instructions matching mask.
+        // Groups with the same syncId are pipelined in program order.
+        template <int32_t mask, int32_t size, int32_t syncId = 0>
+        struct amdgcn_sched_group_barrier
+        {
+            ROCWMMA_DEVICE static inline auto exec()
+            {
+                static_assert(size > 0, "Scheduling group size must be positive");
+                static_assert(syncId >= 0, "Scheduling group sync id must be non-negative");
+
+                return __builtin_amdgcn_sched_group_barrier(mask, size, syncId);
+            }
+        };
+
+        // Requests one of the compiler's built-in instruction group-level parallelism strategies
+        template <int32_t variant = 0>
+        struct amdgcn_iglp_opt
+        {
+            ROCWMMA_DEVICE static inline auto exec()
+            {
+                static_assert(variant >= 0, "IGLP variant must be non-negative");
+
+                return __builtin_amdgcn_iglp_opt(variant);
+            }
+        };
+
+        // Waits until at most vmcnt vector memory and lgkmcnt LDS / scalar memory operations
+        // of the wave are outstanding, and on all exports. Encoded in the gfx9 s_waitcnt layout.
         template <int32_t vmcnt, int32_t lgkmcnt>
         struct amdgcn_s_waitcnt
         {
-            enum : const int16_t
+            // Unsigned: the high vmcnt bits reach bit 15
+            enum : const uint16_t
             {
                 vmcnt16   = (((0xF) & vmcnt) | (((0x30) & vmcnt) << 10)),
                 lgkmcnt16 = (((0xF) & lgkmcnt) << 8),
@@ -100,11 +129,95 @@ namespace rocwmma
 
     } // namespace detail
 
+    //! @struct SchedMask
+    //! @brief Instruction classes for SchedBarrier and SchedGroup masks. SchedBarrier masks
+    //! select the classes that may be scheduled across the barrier.
+    struct SchedMask
+    {
+        enum : int32_t
+        {
+            None      = 0x0,
+            NonMemory = 0x1,
+            Valu      = 0x2,
+            Salu      = 0x4,
+            Mma       = 0x8,
+            Vmem      = 0x10,
+            VmemRead  = 0x20,
+            VmemWrite = 0x40,
+            Ds        = 0x80,
+            DsRead    = 0x100,
+            DsWrite   = 0x200,
+            Trans     = 0x400
+        };
+    };
+
+    //! @struct SchedGroup
+    //! @brief A group of Size instructions of the SchedMask classes in Mask
+    //! @tparam Mask Bitwise or of SchedMask classes
+    //! @tparam Size Number of instructions in the group
+    template <int32_t Mask, int32_t Size>
+    struct SchedGroup
+    {
+        enum : int32_t
+        {
+            mask = Mask,
+            size = Size
+        };
+    };
+
+    //! @struct SchedInterleave
+    //! @brief Scheduling policy that interleaves the Groups in order, Repeat times. For example,
+    //! 1 MFMA : 2 DS_READ : 1 VMEM_READ, four times over:
+    //!
+    //!     SchedInterleave<4u,
+    //!                     SchedGroup<SchedMask::Mma, 1>,
+    //!                     SchedGroup<SchedMask::DsRead, 2>,
+    //!                     SchedGroup<SchedMask::VmemRead, 1>>
+    //!
+    //! exec() shapes the scheduling region it ends, which is bounded by Barrier and
+    //! SchedBarrier. Instructions not claimed by a group are scheduled freely, and policies
+    //! with different SyncId are scheduled independently.
+    //! @tparam Repeat Number of times the sequence of groups is repeated
+    //! @tparam Groups SchedGroup sequence
+    template <uint32_t Repeat, typename... Groups>
+    struct SchedInterleave
+    {
+        template <int32_t SyncId = 0>
+        ROCWMMA_DEVICE static inline void exec()
+        {
+            if constexpr(Repeat > 0u && sizeof...(Groups) > 0u)
+            {
+                (detail::amdgcn_sched_group_barrier<Groups::mask, Groups::size, SyncId>::exec(),
+                 ...);
+                SchedInterleave<Repeat - 1u, Groups...>::template exec<SyncId>();
+            }
+        }
+    };
+
+    //! Default scheduling policy, which leaves scheduling to the compiler
+    using SchedNone = SchedInterleave<0u>;
+
+    //! @struct SchedIglp
+    //! @brief Scheduling policy that defers to a built-in compiler strategy
+    //! @tparam Variant Compiler instruction group-level parallelism strategy
+    template <int32_t Variant>
+    struct SchedIglp
+    {
+        template <int32_t SyncId = 0>
+        ROCWMMA_DEVICE static inline void exec()
+        {
+            detail::amdgcn_iglp_opt<Variant>::exec();
+        }
+    };
+
     using Barrier = detail::amdgcn_barrier;
 
     template <int32_t mask>
     using SchedBarrier = detail::amdgcn_sched_barrier<mask>;
 
+    template <int32_t mask, int32_t size, int32_t syncId = 0>
+    using SchedGroupBarrier = detail::amdgcn_sched_group_barrier<mask, size, syncId>;
+
     template <int32_t priority>
     using SetPrio = detail::amdgcn_setprio<priority>;
 
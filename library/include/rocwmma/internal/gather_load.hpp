@@ -0,0 +1,193 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_GATHER_LOAD_HPP
+#define ROCWMMA_GATHER_LOAD_HPP
+
+#include "io_traits.hpp"
+#include "layout.hpp"
+#include "tuple.hpp"
+#include "types.hpp"
+#include "vector_iterator.hpp"
+
+namespace rocwmma
+{
+
+    namespace detail
+    {
+
+        // Loads VectorWidth elements at matrix coordinate (row, col) of a matrix whose rows
+        // are gathered through an index array: element (row, col) is element
+        // (rowIndices[row], col) of the source matrix in DataLayout.
+        // Vectors along the columns (row major) stay contiguous and are loaded whole.
+        // Vectors along the rows (col major) span gathered rows and are loaded element-wise.
+        // Rows with a negative index are not read and are zero-filled.
+        template <typename DataT, uint32_t VectorWidth, class DataLayout>
+        struct amdgcn_gather_load
+        {
+            static_assert(VectorWidth > 0, "Vector width must be greater than 0");
+            static_assert(sizeof(DataT[VectorWidth]) == sizeof(VecT<DataT, VectorWidth>),
+                          "Cannot vectorize input");
+
+            using LoadT = VecT<DataT, VectorWidth>;
+
+            ROCWMMA_DEVICE static inline void exec(LoadT&         data,
+                                                   DataT const*   dataPtr,
+                                                   index_t const* rowIndices,
+                                                   uint32_t       ldm,
+                                                   Coord2d        coord)
+            {
+                auto row = get<0>(coord);
+                auto col = get<1>(coord);
+
+                if constexpr(is_same_v<DataLayout, rocwmma::DataLayout::RowMajor>)
+                {
+                    auto index = rowIndices[row];
+                    if(index >= 0)
+                    {
+                        data = *reinterpret_cast<LoadT const*>(
+                            dataPtr + DataLayout::fromMatrixCoord(make_coord2d(index, col), ldm));
+                    }
+                    else
+                    {
+#pragma unroll
+                        for(uint32_t i = 0; i < VectorWidth; i++)
+                        {
+                            data.data[i] = static_cast<DataT>(0);
+                        }
+                    }
+                }
+                else
+                {
+#pragma unroll
+                    for(uint32_t i = 0; i < VectorWidth; i++)
+                    {
+                        auto index   = rowIndices[row + i];
+                        auto offset  = DataLayout::fromMatrixCoord(make_coord2d(index, col), ldm);
+                        data.data[i] = index >= 0 ? dataPtr[offset] : static_cast<DataT>(0);
+                    }
+                }
+            }
+        };
+
+    } // namespace detail
+
+    // Loads with the same matrix layout as OpaqueLoad, however the rows of the
+    // block are gathered from the source matrix through an index array, such that
+    // the permuted matrix is never materialized. The matrix coordinate of each
+    // vector is tracked in place of a data pointer.
+    template <uint32_t BlockDim,
+              uint32_t BlockK,
+              typename DataT,
+              class DataLayout,
+              class MatrixLayout,
+              uint32_t VectorWidth>
+    struct GatherLoad
+    {
+        using IOTraits = IOTraits<BlockDim, BlockK, DataT, VectorWidth>;
+
+        struct Traits
+        {
+            // Raw IO on unpacked register data.
+            using Loader  = detail::amdgcn_gather_load<DataT, VectorWidth, DataLayout>;
+            using LoadT   = typename Loader::LoadT;
+            using OutputT = VecT<DataT, IOTraits::UnpackedSize>;
+        };
+
+        using LoadVecTraits = VecTraits<typename Traits::LoadT>;
+
+        // Outer loop = index 0,
+        // Inner loop = index N-1
+        template <size_t Depth = 0,
+                  typename Iterator,
+                  typename StrideCounts,
+                  typename Strides2d>
+        ROCWMMA_DEVICE static inline auto unroll_right(Iterator&      out,
+                                                       DataT const*   dataPtr,
+                                                       index_t const* rowIndices,
+                                                       uint32_t       ldm,
+                                                       Coord2d        coord,
+                                                       StrideCounts&& strideCounts,
+                                                       Strides2d&&    strides2d)
+        {
+            auto stride2d    = get<Depth>(strides2d);
+            auto strideCount = get<Depth>(strideCounts);
+
+            // Last depth layer will invoke the load
+            if constexpr(Depth == (VecTraits<decay_t<StrideCounts>>::size() - 1u))
+            {
+#pragma unroll
+                for(int i = 0; i < strideCount; i++)
+                {
+                    Traits::Loader::exec(*out, dataPtr, rowIndices, ldm, coord);
+                    coord += stride2d;
+                    out++;
+                }
+            }
+            // Recurse to the next nested layer
+            else
+            {
+#pragma unroll
+                for(int i = 0; i < strideCount; i++)
+                {
+                    unroll_right<Depth + 1>(
+                        out, dataPtr, rowIndices, ldm, coord, strideCounts, strides2d);
+                    coord += stride2d;
+                }
+            }
+        }
+
+        ROCWMMA_DEVICE static void exec(typename Traits::OutputT& data,
+                                        DataT const*              dataPtr,
+                                        index_t const*            rowIndices,
+                                        uint32_t                  ldm)
+        {
+            // Arrange wave threads to starting matrix layout offsets.
+            auto baseOffset2d = MatrixLayout::baseOffset();
+            auto it           = makeVectorIterator<LoadVecTraits::size()>(data).begin();
+
+            static_assert(decltype(it)::range() == IOTraits::IOCount,
+                          "IOCount inconsistent with iterator range");
+
+            // Make sure that the IOCount is consistent with the number of total strides
+            static_assert(IOTraits::IOCount
+                              == apply([](auto... items) { return (items * ...); },
+                                       MatrixLayout::strideCounts()),
+                          "IOCount inconsistent with total strides");
+
+            // Unroll loading in each strided dimension
+            unroll_right(it,
+                         dataPtr,
+                         rowIndices,
+                         ldm,
+                         baseOffset2d,
+                         MatrixLayout::strideCounts(),
+                         MatrixLayout::strides());
+        }
+    };
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_GATHER_LOAD_HPP
@@ -0,0 +1,291 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_IM2COL_LOAD_HPP
+#define ROCWMMA_IM2COL_LOAD_HPP
+
+#include "api_fwd.hpp"
+#include "io_traits.hpp"
+#include "layout.hpp"
+#include "tuple.hpp"
+#include "types.hpp"
+#include "vector_iterator.hpp"
+
+namespace rocwmma
+{
+
+    namespace detail
+    {
+
+        // Loads VectorWidth contiguous elements of the implicit im2col matrix A of a
+        // 2D convolution, at matrix coordinate (row, col):
+        // - row indexes output pixels (n, p, q), q fastest
+        // - col indexes filter taps (r, s, c), c fastest
+        // Element (row, col) is input pixel (n, p * strideH + r * dilationH - padH,
+        // q * strideW + s * dilationW - padW) at channel c of the NHWC input.
+        // Vectors start at multiples of VectorWidth in col. If the channel count is a
+        // multiple of VectorWidth, each vector lies within a single input pixel and is
+        // loaded whole, otherwise element-wise. Padding and out-of-range elements are not read and are zero-filled.
+        //
+        // The backward data (dgrad) matrix A of a conv2d_nhwc_dgrad is gathered the same way:
+        // - row indexes input pixels (n, h, w), w fastest
+        // - col indexes filter taps (r, s, k), k fastest
+        // Element (row, col) is output gradient pixel (n, (h + padH - r * dilationH) / strideH,
+        // (w + padW - s * dilationW) / strideW) at channel k of the NPQK output gradient, where
+        // both divisions are exact and in range. Taps without a contributing output pixel are zero.
+        //
+        // The matrix A of one group of a conv2d_nhwc_grouped is the im2col matrix over the cg
+        // channels of the group, with c fastest in col. The input pointer is the first channel
+        // of the group, and pixels are c elements apart.
+        template <typename DataT, uint32_t VectorWidth>
+        struct amdgcn_im2col_load
+        {
+            static_assert(VectorWidth > 0, "Vector width must be greater than 0");
+            static_assert(sizeof(DataT[VectorWidth]) == sizeof(VecT<DataT, VectorWidth>),
+                          "Cannot vectorize input");
+
+            using LoadT = VecT<DataT, VectorWidth>;
+
+            // Channel count of the gathered tensor
+            template <typename ConvT>
+            ROCWMMA_DEVICE static inline uint32_t channels(ConvT const& conv)
+            {
+                if constexpr(is_same<ConvT, conv2d_nhwc_dgrad>::value)
+                {
+                    return conv.conv.k;
+                }
+                else if constexpr(is_same<ConvT, conv2d_nhwc_grouped>::value)
+                {
+                    return conv.conv.c / conv.groups;
+                }
+                else
+                {
+                    return conv.c;
+                }
+            }
+
+            // Element offset of the first channel of the pixel gathered by row at filter
+            // tap rs, or -1 if the pixel is padding or out of range:
+            // - forward and grouped: the input pixel read by output pixel row
+            // - dgrad: the output gradient pixel contributing to input pixel row
+            template <typename ConvT>
+            ROCWMMA_DEVICE static inline int64_t
+                pixelOffset(ConvT const& conv, uint32_t row, uint32_t rs)
+            {
+                if constexpr(is_same<ConvT, conv2d_nhwc_dgrad>::value)
+                {
+                    auto const& fwd = conv.conv;
+
+                    auto w = row % fwd.w;
+                    auto h = (row / fwd.w) % fwd.h;
+                    auto n = row / (fwd.w * fwd.h);
+                    auto s = rs % fwd.s;
+                    auto r = rs / fwd.s;
+
+                    auto ph = static_cast<int32_t>(h + fwd.padH)
+                              - static_cast<int32_t>(r * fwd.dilationH);
+                    auto qw = static_cast<int32_t>(w + fwd.padW)
+                              - static_cast<int32_t>(s * fwd.dilationW);
+
+                    // Strided taps only receive gradient from every stride-th pixel
+                    if(n >= fwd.n || r >= fwd.r || ph < 0 || qw < 0 || ph % fwd.strideH != 0
+                       || qw % fwd.strideW != 0)
+                    {
+                        return -1;
+                    }
+
+                    auto p = static_cast<uint32_t>(ph) / fwd.strideH;
+                    auto q = static_cast<uint32_t>(qw) / fwd.strideW;
+                    if(p >= fwd.p || q >= fwd.q)
+                    {
+                        return -1;
+                    }
+
+                    return ((static_cast<int64_t>(n) * fwd.p + p) * fwd.q + q) * fwd.k;
+                }
+                else if constexpr(is_same<ConvT, conv2d_nhwc_grouped>::value)
+                {
+                    // Groups share the pixel addressing of the whole convolution
+                    return pixelOffset(conv.conv, row, rs);
+                }
+                else
+                {
+                    auto q = row % conv.q;
+                    auto p = (row / conv.q) % conv.p;
+                    auto n = row / (conv.q * conv.p);
+                    auto s = rs % conv.s;
+                    auto r = rs / conv.s;
+
+                    auto h = static_cast<int32_t>(p * conv.strideH + r * conv.dilationH)
+                             - static_cast<int32_t>(conv.padH);
+                    auto w = static_cast<int32_t>(q * conv.strideW + s * conv.dilationW)
+                             - static_cast<int32_t>(conv.padW);
+
+                    if(n >= conv.n || r >= conv.r || h < 0 || h >= static_cast<int32_t>(conv.h)
+                       || w < 0 || w >= static_cast<int32_t>(conv.w))
+                    {
+                        return -1;
+                    }
+
+                    return ((static_cast<int64_t>(n) * conv.h + h) * conv.w + w) * conv.c;
+                }
+            }
+
+            template <typename ConvT>
+            ROCWMMA_DEVICE static inline void
+                exec(LoadT& data, DataT const* input, ConvT const& conv, Coord2d coord)
+            {
+                auto row      = get<0>(coord);
+                auto col      = get<1>(coord);
+                auto channelN = channels(conv);
+                auto c        = col % channelN;
+
+                if(channelN % VectorWidth == 0)
+                {
+                    auto offset = pixelOffset(conv, row, col / channelN);
+                    if(offset >= 0)
+                    {
+                        data = *reinterpret_cast<LoadT const*>(input + offset + c);
+                    }
+                    else
+                    {
+#pragma unroll
+                        for(uint32_t i = 0; i < VectorWidth; i++)
+                        {
+                            data.data[i] = static_cast<DataT>(0);
+                        }
+                    }
+                }
+                else
+                {
+#pragma unroll
+                    for(uint32_t i = 0; i < VectorWidth; i++)
+                    {
+                        auto offset  = pixelOffset(conv, row, (col + i) / channelN);
+                        data.data[i] = offset >= 0 ? input[offset + (col + i) % channelN]
+                                                   : static_cast<DataT>(0);
+                    }
+                }
+            }
+        };
+
+    } // namespace detail
+
+    // Loads with the same matrix layout as OpaqueLoad, however each vector is
+    // gathered from the convolution input through its im2col address, such that
+    // the im2col matrix is never materialized. The matrix coordinate of each
+    // vector is tracked in place of a data pointer.
+    // Vectors run along the minor dimension, which must be the filter taps: the
+    // data layout is row_major, as matrix_a of the forward and dgrad GEMMs, or as
+    // matrix_b of the wgrad GEMM.
+    template <uint32_t BlockDim,
+              uint32_t BlockK,
+              typename DataT,
+              class DataLayout,
+              class MatrixLayout,
+              uint32_t VectorWidth>
+    struct Im2colLoad
+    {
+        using IOTraits = IOTraits<BlockDim, BlockK, DataT, VectorWidth>;
+
+        struct Traits
+        {
+            // Raw IO on unpacked register data.
+            using Loader  = detail::amdgcn_im2col_load<DataT, VectorWidth>;
+            using LoadT   = typename Loader::LoadT;
+            using OutputT = VecT<DataT, IOTraits::UnpackedSize>;
+        };
+
+        using LoadVecTraits = VecTraits<typename Traits::LoadT>;
+
+        // Outer loop = index 0,
+        // Inner loop = index N-1
+        template <size_t Depth = 0,
+                  typename Iterator,
+                  typename ConvT,
+                  typename StrideCounts,
+                  typename Strides2d>
+        ROCWMMA_DEVICE static inline auto unroll_right(Iterator&      out,
+                                                       DataT const*   input,
+                                                       ConvT const&   conv,
+                                                       Coord2d        coord,
+                                                       StrideCounts&& strideCounts,
+                                                       Strides2d&&    strides2d)
+        {
+            auto stride2d    = get<Depth>(strides2d);
+            auto strideCount = get<Depth>(strideCounts);
+
+            // Last depth layer will invoke the load
+            if constexpr(Depth == (VecTraits<decay_t<StrideCounts>>::size() - 1u))
+            {
+#pragma unroll
+                for(int i = 0; i < strideCount; i++)
+                {
+                    Traits::Loader::exec(*out, input, conv, coord);
+                    coord += stride2d;
+                    out++;
+                }
+            }
+            // Recurse to the next nested layer
+            else
+            {
+#pragma unroll
+                for(int i = 0; i < strideCount; i++)
+                {
+                    unroll_right<Depth + 1>(out, input, conv, coord, strideCounts, strides2d);
+                    coord += stride2d;
+                }
+            }
+        }
+
+        template <typename ConvT>
+        ROCWMMA_DEVICE static void exec(typename Traits::OutputT& data,
+                                        DataT const*              input,
+                                        ConvT const&              conv,
+                                        Coord2d                   origin)
+        {
+            // Arrange wave threads to starting matrix layout offsets.
+            auto baseOffset2d = MatrixLayout::baseOffset();
+            auto it           = makeVectorIterator<LoadVecTraits::size()>(data).begin();
+
+            static_assert(decltype(it)::range() == IOTraits::IOCount,
+                          "IOCount inconsistent with iterator range");
+
+            // Make sure that the IOCount is consistent with the number of total strides
+            static_assert(IOTraits::IOCount
+                              == apply([](auto... items) { return (items * ...); },
+                                       MatrixLayout::strideCounts()),
+                          "IOCount inconsistent with total strides");
+
+            // Unroll loading in each strided dimension
+            origin += baseOffset2d;
+            unroll_right(
+                it, input, conv, origin, MatrixLayout::strideCounts(), MatrixLayout::strides());
+        }
+    };
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_IM2COL_LOAD_HPP
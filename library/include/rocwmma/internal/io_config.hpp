@@ -26,13 +26,26 @@
 #ifndef ROCWMMA_IO_CONFIG_HPP
 #define ROCWMMA_IO_CONFIG_HPP
 
+#include "aos_store.hpp"
+#include "atomic_add_store.hpp"
+#include "bounded_load.hpp"
+#include "bounded_store.hpp"
 #include "broadcast.hpp"
+#include "buffer_load.hpp"
 #include "coop_load.hpp"
 #include "coop_store.hpp"
+#include "gather_load.hpp"
+#include "im2col_load.hpp"
 #include "io_shape.hpp"
 #include "opaque_load.hpp"
 #include "opaque_store.hpp"
 #include "pack_util.hpp"
+#include "paged_load.hpp"
+#include "paged_store.hpp"
+#include "scatter_store.hpp"
+#include "soa_load.hpp"
+#include "tensor_load.hpp"
+#include "tensor_store.hpp"
 #include "types.hpp"
 
 namespace rocwmma
@@ -60,6 +73,21 @@ namespace rocwmma
  * @param MappingUtil global mapping utility for current fragment
  * @param Loader Issues load instructions for raw fragment data
  * @param Storer Issues store instructions for raw fragment data
+ * @param PolicyLoader Issues load instructions for raw fragment data with an access policy
+ * @param PolicyStorer Issues store instructions for raw fragment data with an access policy
+ * @param AlignedLoader Issues load instructions for raw fragment data, in vectors of at most the data alignment
+ * @param AlignedStorer Issues store instructions for raw fragment data, in vectors of at most the data alignment
+ * @param BoundedLoader Issues predicated load instructions for partial fragment data
+ * @param BoundedStorer Issues predicated store instructions for partial fragment data
+ * @param AtomicAddStorer Issues atomic add instructions accumulating raw fragment data into memory
+ * @param BufferLoader Issues buffer load instructions for raw fragment data in global memory
+ * @param Im2colLoader Issues load instructions gathering implicit GEMM data of a convolution
+ * @param GatherLoader Issues load instructions for fragment rows gathered through an index array
+ * @param ScatterStorer Issues store instructions for fragment rows scattered through an index array
+ * @param TensorLoader Issues load instructions through the matrix view of a strided tensor
+ * @param TensorStorer Issues store instructions through the matrix view of a strided tensor
+ * @param PagedLoader Issues load instructions for fragment vectors located through a page table
+ * @param PagedStorer Issues store instructions for fragment vectors located through a page table
  */
 
     template <typename MatrixT,
@@ -81,19 +109,158 @@ namespace rocwmma
         using MappingUtil
             = MappingUtil<IOShape::BlockHeight, IOShape::BlockWidth, DataT, DataLayoutT>;
 
-        using Loader = OpaqueLoad<IOShape::BlockDim,
-                                  IOShape::KDim,
-                                  DataT,
-                                  typename IOLayout::DataLayout,
-                                  typename IOLayout::MatrixLayout,
-                                  IOLayout::VW>;
-
-        using Storer = OpaqueStore<IOShape::BlockDim,
-                                   IOShape::KDim,
-                                   DataT,
-                                   typename IOLayout::DataLayout,
-                                   typename IOLayout::MatrixLayout,
-                                   IOLayout::VW>;
+        // Wide AOS loads transformed to SOA registers where IOLayout selects them
+        template <class AccessPolicy>
+        using PolicyLoader = conditional_t<(bool)IOLayout::SoaLoad,
+                                           SoaLoad<IOShape::BlockDim,
+                                                   IOShape::KDim,
+                                                   DataT,
+                                                   typename IOLayout::DataLayout,
+                                                   typename IOLayout::SoaLoadMatrixLayout,
+                                                   IOLayout::MaxVW,
+                                                   AccessPolicy>,
+                                           OpaqueLoad<IOShape::BlockDim,
+                                                      IOShape::KDim,
+                                                      DataT,
+                                                      typename IOLayout::DataLayout,
+                                                      typename IOLayout::MatrixLayout,
+                                                      IOLayout::VW,
+                                                      AccessPolicy>>;
+
+        // Wide AOS stores transformed from SOA registers where IOLayout selects them
+        template <class AccessPolicy>
+        using PolicyStorer = conditional_t<(bool)IOLayout::AosStore,
+                                           AosStore<IOShape::BlockDim,
+                                                    IOShape::KDim,
+                                                    DataT,
+                                                    typename IOLayout::DataLayout,
+                                                    typename IOLayout::AosStoreMatrixLayout,
+                                                    IOLayout::MaxVW,
+                                                    AccessPolicy>,
+                                           OpaqueStore<IOShape::BlockDim,
+                                                       IOShape::KDim,
+                                                       DataT,
+                                                       typename IOLayout::DataLayout,
+                                                       typename IOLayout::MatrixLayout,
+                                                       IOLayout::VW,
+                                                       AccessPolicy>>;
+
+        using Loader = PolicyLoader<cache_default>;
+        using Storer = PolicyStorer<cache_default>;
+
+        // Widest IO vector of data aligned to AlignBytes, in elements
+        template <uint32_t AlignBytes>
+        constexpr static uint32_t AlignedVW
+            = AlignBytes > (uint32_t)sizeof(DataT) ? AlignBytes / (uint32_t)sizeof(DataT) : 1u;
+
+        // IO vectors of data aligned to AlignBytes. Loaders and storers whose vectors fit the
+        // alignment are kept, others are narrowed to the widest aligned vector in the same
+        // register layout.
+        template <uint32_t AlignBytes>
+        constexpr static uint32_t NarrowVW
+            = (uint32_t)IOLayout::VW < AlignedVW<AlignBytes> ? (uint32_t)IOLayout::VW
+                                                             : AlignedVW<AlignBytes>;
+
+        template <uint32_t AlignBytes>
+        using AlignedLoader = conditional_t<
+            ((bool)IOLayout::SoaLoad ? (uint32_t)IOLayout::MaxVW : (uint32_t)IOLayout::VW)
+                <= AlignedVW<AlignBytes>,
+            Loader,
+            OpaqueLoad<IOShape::BlockDim,
+                       IOShape::KDim,
+                       DataT,
+                       typename IOLayout::DataLayout,
+                       typename IOLayout::template NarrowMatrixLayout<NarrowVW<AlignBytes>>,
+                       NarrowVW<AlignBytes>>>;
+
+        template <uint32_t AlignBytes>
+        using AlignedStorer = conditional_t<
+            ((bool)IOLayout::AosStore ? (uint32_t)IOLayout::MaxVW : (uint32_t)IOLayout::VW)
+                <= AlignedVW<AlignBytes>,
+            Storer,
+            OpaqueStore<IOShape::BlockDim,
+                        IOShape::KDim,
+                        DataT,
+                        typename IOLayout::DataLayout,
+                        typename IOLayout::template NarrowMatrixLayout<NarrowVW<AlignBytes>>,
+                        NarrowVW<AlignBytes>>>;
+
+        using BoundedLoader = BoundedLoad<IOShape::BlockDim,
+                                          IOShape::KDim,
+                                          DataT,
+                                          typename IOLayout::DataLayout,
+                                          typename IOLayout::MatrixLayout,
+                                          IOLayout::VW>;
+
+        using BoundedStorer = BoundedStore<IOShape::BlockDim,
+                                           IOShape::KDim,
+                                           DataT,
+                                           typename IOLayout::DataLayout,
+                                           typename IOLayout::MatrixLayout,
+                                           IOLayout::VW>;
+
+        using AtomicAddStorer = AtomicAddStore<IOShape::BlockDim,
+                                               IOShape::KDim,
+                                               DataT,
+                                               typename IOLayout::DataLayout,
+                                               typename IOLayout::MatrixLayout,
+                                               IOLayout::VW>;
+
+        using BufferLoader = BufferLoad<IOShape::BlockDim,
+                                        IOShape::KDim,
+                                        DataT,
+                                        typename IOLayout::DataLayout,
+                                        typename IOLayout::MatrixLayout,
+                                        IOLayout::VW>;
+
+        using Im2colLoader = Im2colLoad<IOShape::BlockDim,
+                                        IOShape::KDim,
+                                        DataT,
+                                        typename IOLayout::DataLayout,
+                                        typename IOLayout::MatrixLayout,
+                                        IOLayout::VW>;
+
+        using GatherLoader = GatherLoad<IOShape::BlockDim,
+                                        IOShape::KDim,
+                                        DataT,
+                                        typename IOLayout::DataLayout,
+                                        typename IOLayout::MatrixLayout,
+                                        IOLayout::VW>;
+
+        using ScatterStorer = ScatterStore<IOShape::BlockDim,
+                                           IOShape::KDim,
+                                           DataT,
+                                           typename IOLayout::DataLayout,
+                                           typename IOLayout::MatrixLayout,
+                                           IOLayout::VW>;
+
+        using TensorLoader = TensorLoad<IOShape::BlockDim,
+                                        IOShape::KDim,
+                                        DataT,
+                                        typename IOLayout::DataLayout,
+                                        typename IOLayout::MatrixLayout,
+                                        IOLayout::VW>;
+
+        using TensorStorer = TensorStore<IOShape::BlockDim,
+                                         IOShape::KDim,
+                                         DataT,
+                                         typename IOLayout::DataLayout,
+                                         typename IOLayout::MatrixLayout,
+                                         IOLayout::VW>;
+
+        using PagedLoader = PagedLoad<IOShape::BlockDim,
+                                      IOShape::KDim,
+                                      DataT,
+                                      typename IOLayout::DataLayout,
+                                      typename IOLayout::MatrixLayout,
+                                      IOLayout::VW>;
+
+        using PagedStorer = PagedStore<IOShape::BlockDim,
+                                       IOShape::KDim,
+                                       DataT,
+                                       typename IOLayout::DataLayout,
+                                       typename IOLayout::MatrixLayout,
+                                       IOLayout::VW>;
     };
 
     /************************************************
@@ -28,6 +28,7 @@
 
 #include "api_fwd.hpp"
 #include "constants.hpp"
+#include "io_traits.hpp"
 #include "layout.hpp"
 #include "types.hpp"
 
@@ -45,44 +46,51 @@ namespace rocwmma
                   = 4u * Constants::AMDGCN_DWORD_SIZE_BYTES / (uint32_t)sizeof(DataT)>
         struct MaxVWSelector
         {
-
         private:
+            using Next = MaxVWSelector<MatrixT,
+                                       BlockDim,
+                                       BlockK,
+                                       DataT,
+                                       DataLayoutT,
+                                       WaveCount,
+                                       TestWidth / 2>;
+
             enum : uint32_t
             {
                 // For small block sizes (16, 32):
                 // Best to keep MaxVW high and reduce splits amongst waves.
                 WaveCountFactor = (BlockDim <= 32) ? 1u : WaveCount,
 
-                // Total number of elements in a single I/O operation
-                ElementsPerIO = Constants::AMDGCN_WAVE_SIZE * TestWidth * WaveCountFactor,
+                // Total number of elements in a single I/O operation of one wave
+                ElementsPerIO = Constants::AMDGCN_WAVE_SIZE * TestWidth,
 
                 // Total number of elements for the entire block
                 ElementCount = BlockDim * BlockK,
 
-                // Ensure that for MaxVW:
-                // - A minimum of one IO from each wave can fit
-                // - A balanced multiple of IOs from each wave
-                ElementCountTest
-                = (ElementsPerIO <= ElementCount) && (ElementCount % ElementsPerIO == 0),
-
-                // Currently, all layouts are using ColOrthoVW. This means that VW must be less than BlockK
-                LeadingDimTest = (TestWidth <= BlockK),
-
-                MaxVectorWidth = (bool)ElementCountTest && (bool)LeadingDimTest
-                                     ? TestWidth
-                                     : MaxVWSelector<MatrixT,
-                                                     BlockDim,
-                                                     BlockK,
-                                                     DataT,
-                                                     DataLayoutT,
-                                                     WaveCount,
-                                                     TestWidth / 2>::Result,
+                // Ensure that for TestWidth:
+                // - A minimum of one IO can fit, and IOs are balanced
+                // - Currently, all layouts are using ColOrthoVW. This means that VW must be
+                //   less than BlockK
+                WidthTest = (ElementsPerIO <= ElementCount) && (ElementCount % ElementsPerIO == 0)
+                            && (TestWidth <= BlockK),
+
+                // Waves that evenly split the IOs. Wave counts that are not powers of 2
+                // may leave some waves idle, e.g. 4 of 6 waves split 8 IOs.
+                SplitWaves = WidthTest ? coopSplitWaves(ElementCount / ElementsPerIO,
+                                                        WaveCountFactor)
+                                       : 0u,
             };
 
         public:
             enum : uint32_t
             {
-                Result = (uint32_t)MaxVectorWidth
+                // Elements moved per IO step of all split waves. The fewest IOs per
+                // wave is the best split. On ties, the narrower width is preferred
+                // because more waves participate.
+                Score = SplitWaves * TestWidth,
+
+                Result = (Score > 0u && Score > (uint32_t)Next::Score) ? TestWidth
+                                                                       : (uint32_t)Next::Result
             };
         };
 
@@ -96,10 +104,52 @@ namespace rocwmma
         {
             enum : uint32_t
             {
+                Score  = 0u,
                 Result = 1u
             };
         };
 
+        // Selects how matrix_a in col_major and matrix_b in row_major reach the SOA register
+        // layout of the mma, for BlockDim <= 32 where the in-memory vectors run along BlockDim:
+        // - Direct:   each lane loads its elements in mma operand order, with VW = 1.
+        // - AosToSoa: loads of MaxVW along BlockDim in AOS order, MaxVW times fewer,
+        //             followed by the AosToSoa register transform of each IO.
+        // Costs are counted in issued instructions, with IssueWeight per load. The transform
+        // of an IO has log2(MaxVW) unpack steps and a gather, each over the dwords of the IO.
+        // The same model selects stores through the SoaToAos transform (see AosStore).
+        template <uint32_t BlockDim,
+                  uint32_t BlockK,
+                  typename DataT,
+                  uint32_t MaxVW,
+                  uint32_t IssueWeight = 4u>
+        struct SoaLoadSelector
+        {
+        private:
+            enum : uint32_t
+            {
+
+                DirectIOCount = BlockDim * BlockK / Constants::AMDGCN_WAVE_SIZE,
+                AosIOCount    = DirectIOCount / MaxVW,
+
+                DwordsPerIO = (MaxVW * sizeof(DataT) + Constants::AMDGCN_DWORD_SIZE_BYTES - 1u)
+                              / Constants::AMDGCN_DWORD_SIZE_BYTES,
+                TransformSteps = Log2<MaxVW>::value + 1u,
+
+                DirectCost = DirectIOCount * IssueWeight,
+                AosCost    = AosIOCount * (IssueWeight + DwordsPerIO * TransformSteps),
+
+                // Register transforms assume whole elements packed into dwords
+                Packable = (PackTraits<DataT>::PackRatio * sizeof(DataT)
+                            == Constants::AMDGCN_DWORD_SIZE_BYTES)
+            };
+
+        public:
+            enum : bool
+            {
+                Result = (BlockDim <= 32u) && (MaxVW > 1u) && Packable && (AosCost < DirectCost)
+            };
+        };
+
     } // namespace detail
 
     /*! \struct IOLayout
@@ -146,6 +196,32 @@ namespace rocwmma
         using DataLayout     = typename Profile::DataLayout;
         using MatrixLayout   = typename Profile::MatrixLayout;
         using RegisterLayout = typename Profile::RegisterLayout;
+
+        // Matrix layout of the profile with IO vectors narrowed to NarrowVW, a divisor of VW.
+        // The register layout follows MaxVW, so narrowed IO fills the same registers.
+        template <uint32_t NarrowVW>
+        using NarrowMatrixLayout = typename conditional_t<
+            BlockDim <= 32,
+            LayoutProfile::template ColNT<BlockDim, BlockK, DataT, DataLayoutT, NarrowVW, MaxVW>,
+            LayoutProfile::
+                template Col<BlockDim, BlockK, DataT, DataLayoutT, NarrowVW, MaxVW>>::MatrixLayout;
+
+        // Small col_major frags may load MaxVW wide AOS vectors, transformed to SOA registers
+        enum : bool
+        {
+            SoaLoad = is_same<DataLayoutT, col_major>::value
+                      && detail::SoaLoadSelector<BlockDim, BlockK, DataT, MaxVW>::Result,
+
+            // Operands store in mma order directly
+            AosStore = false
+        };
+
+        using SoaLoadMatrixLayout = conditional_t<
+            (bool)SoaLoad,
+            rocwmma::MatrixLayout::ColInlineVW<BlockDim, BlockK, DataT, MaxVW, MaxVW>,
+            MatrixLayout>;
+
+        using AosStoreMatrixLayout = MatrixLayout;
     };
 
     template <uint32_t BlockDim,
@@ -173,6 +249,32 @@ namespace rocwmma
         using DataLayout     = typename Profile::DataLayout;
         using MatrixLayout   = typename Profile::MatrixLayout;
         using RegisterLayout = typename Profile::RegisterLayout;
+
+        // Matrix layout of the profile with IO vectors narrowed to NarrowVW, a divisor of VW.
+        // The register layout follows MaxVW, so narrowed IO fills the same registers.
+        template <uint32_t NarrowVW>
+        using NarrowMatrixLayout = typename conditional_t<
+            BlockDim <= 32,
+            LayoutProfile::template RowNT<BlockDim, BlockK, DataT, DataLayoutT, NarrowVW, MaxVW>,
+            LayoutProfile::
+                template Row<BlockDim, BlockK, DataT, DataLayoutT, NarrowVW, MaxVW>>::MatrixLayout;
+
+        // Small row_major frags may load MaxVW wide AOS vectors, transformed to SOA registers
+        enum : bool
+        {
+            SoaLoad = is_same<DataLayoutT, row_major>::value
+                      && detail::SoaLoadSelector<BlockDim, BlockK, DataT, MaxVW>::Result,
+
+            // Operands store in mma order directly
+            AosStore = false
+        };
+
+        using SoaLoadMatrixLayout = conditional_t<
+            (bool)SoaLoad,
+            rocwmma::MatrixLayout::RowInlineVW<BlockDim, BlockK, DataT, MaxVW, MaxVW>,
+            MatrixLayout>;
+
+        using AosStoreMatrixLayout = MatrixLayout;
     };
 
     template <uint32_t BlockDim,
@@ -198,6 +300,31 @@ namespace rocwmma
         using DataLayout     = typename Profile::DataLayout;
         using MatrixLayout   = typename Profile::MatrixLayout;
         using RegisterLayout = typename Profile::RegisterLayout;
+
+        // Matrix layout of the profile with IO vectors narrowed to NarrowVW, a divisor of VW.
+        // The register layout follows MaxVW, so narrowed IO fills the same registers.
+        template <uint32_t NarrowVW>
+        using NarrowMatrixLayout = typename LayoutProfile::
+            template RowNT<BlockDim, BlockK, DataT, DataLayoutT, NarrowVW, MaxVW>::MatrixLayout;
+
+        // Accumulators load in mma order directly. Small row_major accumulators hold MaxVW
+        // rows of one column per lane, and may store MaxVW wide AOS vectors along the rows
+        // after the SoaToAos transform. Narrow stores are weighed twice as heavy as loads,
+        // for the partial cache line writes they leave to the memory system.
+        enum : bool
+        {
+            SoaLoad = false,
+
+            AosStore = is_same<DataLayoutT, row_major>::value
+                       && detail::SoaLoadSelector<BlockDim, BlockK, DataT, MaxVW, 8u>::Result
+        };
+
+        using SoaLoadMatrixLayout = MatrixLayout;
+
+        using AosStoreMatrixLayout = conditional_t<
+            (bool)AosStore,
+            rocwmma::MatrixLayout::RowInlineVW<BlockDim, BlockK, DataT, MaxVW, MaxVW>,
+            MatrixLayout>;
     };
 
     template <uint32_t BlockDim, uint32_t BlockK, typename DataT, uint32_t WaveCount>
@@ -33,6 +33,25 @@
 
 namespace rocwmma
 {
+    namespace detail
+    {
+        // Largest number of waves in [1, waveCount] that evenly divides workItems.
+        // Cooperative IO splits the work items evenly amongst these waves, such that
+        // wave counts that are not powers of 2 (e.g. 3, 6 or 12) still share the work.
+        static constexpr uint32_t coopSplitWaves(uint32_t workItems, uint32_t waveCount)
+        {
+            for(uint32_t waves = waveCount; waves > 1u; waves--)
+            {
+                if(workItems % waves == 0u)
+                {
+                    return waves;
+                }
+            }
+            return 1u;
+        }
+
+    } // namespace detail
+
     /*
 * The following class provides IO meta-data that is used
 * to provide static information used in inference and controlling
@@ -50,6 +50,7 @@ namespace rocwmma
             ROCWMMA_DEVICE static inline uint32_t localLaneId();
 
             // Local wave coordinate relative to current workgroup.
+            // Wave coordinates are wave-uniform, and held in scalar registers.
             ROCWMMA_DEVICE constexpr static inline WaveCoordT localWaveCoord();
 
             // Global wave grid coordinate relative to all workgroups.
@@ -109,6 +110,36 @@ namespace rocwmma
         template <>
         struct DataSpace<void>;
 
+        /*
+    Calculate the memory offsets of a matrix coordinate in the matrix view of a strided tensor.
+    The row, column and batch indices are each folded over their group of tensor modes.
+    */
+        struct TensorSpace
+        {
+            using MatrixCoordT = Coord2d;
+
+            // Element offset of an index folded over a group of modes, last mode fastest.
+            template <typename TensorModesT>
+            ROCWMMA_DEVICE constexpr static inline int64_t fromModeIndex(uint32_t            index,
+                                                                         TensorModesT const& modes);
+
+            // Global data coordinate space (1d element) transform for a matrix coordinate.
+            template <typename TensorViewT>
+            ROCWMMA_DEVICE constexpr static inline int64_t
+                fromMatrixCoord(MatrixCoordT const& matrixCoord, TensorViewT const& view);
+
+            // Global data coordinate space (1d element) transform for a batch index.
+            template <typename TensorViewT>
+            ROCWMMA_DEVICE constexpr static inline int64_t fromBatchIndex(uint32_t           batch,
+                                                                          TensorViewT const& view);
+
+            // True if VectorWidth consecutive indices from a multiple of VectorWidth are
+            // contiguous in memory: the fastest mode has unit stride and an extent that is
+            // a multiple of VectorWidth.
+            template <uint32_t VectorWidth, typename TensorModesT>
+            ROCWMMA_DEVICE constexpr static inline bool isContiguous(TensorModesT const& modes);
+        };
+
     } // namespace detail;
 
     /*
@@ -167,7 +198,7 @@ workgroup.
         // Matrix coordinate of current wave
         ROCWMMA_DEVICE static inline MatrixCoordT matrixCoord();
 
-        // Data address of current wave
+        // Data address of current wave. ldm must be wave-uniform.
         ROCWMMA_DEVICE static inline DataT const* dataCoord(DataT const* baseAddr, uint32_t ldm);
         ROCWMMA_DEVICE static inline DataT*       dataCoord(DataT* baseAddr, uint32_t ldm);
 
@@ -203,6 +234,20 @@ workgroup.
             dataCoord(DataT const* baseAddr, MatrixCoordT const& matrixCoord, uint32_t ldm);
         ROCWMMA_DEVICE static inline DataT*
             dataCoord(DataT* baseAddr, MatrixCoordT const& matrixCoord, uint32_t ldm);
+
+        // Convert from any matrix coord to data offset in a tensor view
+        template <typename TensorViewT>
+        ROCWMMA_DEVICE static inline int64_t tensorOffset(MatrixCoordT const& matrixCoord,
+                                                          TensorViewT const&  view);
+
+        // Convert from any matrix coord to data address in a tensor view
+        template <typename TensorViewT>
+        ROCWMMA_DEVICE static inline DataT const* tensorCoord(DataT const*        baseAddr,
+                                                              MatrixCoordT const& matrixCoord,
+                                                              TensorViewT const&  view);
+        template <typename TensorViewT>
+        ROCWMMA_DEVICE static inline DataT*
+            tensorCoord(DataT* baseAddr, MatrixCoordT const& matrixCoord, TensorViewT const& view);
     };
 
 } // namespace rocwmma
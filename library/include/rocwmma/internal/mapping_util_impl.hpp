@@ -65,6 +65,19 @@ namespace rocwmma
                                 get<1>(waveCount));
         }
 
+        // Reads a wave-uniform value from the first active lane. The compiler then keeps the
+        // value, and any math on other uniform values, in SGPRs instead of per-lane VGPRs.
+        ROCWMMA_DEVICE inline uint32_t waveUniform(uint32_t value)
+        {
+            return static_cast<uint32_t>(
+                __builtin_amdgcn_readfirstlane(static_cast<int32_t>(value)));
+        }
+
+        ROCWMMA_DEVICE inline Coord2d waveUniform(Coord2d const& coord)
+        {
+            return make_coord2d(waveUniform(get<0>(coord)), waveUniform(get<1>(coord)));
+        }
+
         /// WaveSpace
 
         template <uint32_t TBlockX, uint32_t TBlockY>
@@ -77,22 +90,22 @@ namespace rocwmma
         ROCWMMA_DEVICE constexpr inline auto WaveSpace<TBlockX, TBlockY>::localWaveCoord()
             -> WaveCoordT
         {
-            return waveCount(make_coord2d(static_cast<uint32_t>(threadIdx.x),
-                                          static_cast<uint32_t>(threadIdx.y)));
+            // Wave coordinates derive from threadIdx, but are uniform across the wave
+            // when blockDim.x is a multiple of the wave size.
+            return waveUniform(waveCount(make_coord2d(static_cast<uint32_t>(threadIdx.x),
+                                                      static_cast<uint32_t>(threadIdx.y))));
         }
 
         template <uint32_t TBlockX, uint32_t TBlockY>
         ROCWMMA_DEVICE inline auto WaveSpace<TBlockX, TBlockY>::globalWaveCoord() -> WaveCoordT
         {
-            return waveCount(make_coord2d(blockIdx.x * TBlockX + threadIdx.x,
-                                          blockIdx.y * TBlockY + threadIdx.y));
-        }
-
-        template <>
-        ROCWMMA_DEVICE inline auto WaveSpace<0, 0>::globalWaveCoord() -> WaveCoordT
-        {
-            return waveCount(make_coord2d(blockIdx.x * blockDim.x + threadIdx.x,
-                                          blockIdx.y * blockDim.y + threadIdx.y));
+            // Equivalent to waveCount(blockIdx * blockDim + threadIdx), with the workgroup
+            // offset computed in scalar registers and only the local wave coord read from lanes.
+            auto wgCoord    = workgroupCoord();
+            auto wgDim      = workgroupDim();
+            auto localCoord = localWaveCoord();
+            return make_coord2d(get<0>(wgCoord) * get<0>(wgDim) + get<0>(localCoord),
+                                get<1>(wgCoord) * get<1>(wgDim) + get<1>(localCoord));
         }
 
         template <uint32_t TBlockX, uint32_t TBlockY>
@@ -148,6 +161,42 @@ namespace rocwmma
             return get<MajorIndex>(matrixCoord) * leadingDim + get<MinorIndex>(matrixCoord);
         }
 
+        /// TensorSpace
+        template <typename TensorModesT>
+        ROCWMMA_DEVICE constexpr inline int64_t
+            TensorSpace::fromModeIndex(uint32_t index, TensorModesT const& modes)
+        {
+            int64_t offset = 0;
+            for(auto i = static_cast<int32_t>(modes.count) - 1; i >= 0; i--)
+            {
+                offset += static_cast<int64_t>(index % modes.extents[i]) * modes.strides[i];
+                index /= modes.extents[i];
+            }
+            return offset;
+        }
+
+        template <typename TensorViewT>
+        ROCWMMA_DEVICE constexpr inline int64_t
+            TensorSpace::fromMatrixCoord(MatrixCoordT const& matrixCoord, TensorViewT const& view)
+        {
+            return fromModeIndex(get<0>(matrixCoord), view.rows)
+                   + fromModeIndex(get<1>(matrixCoord), view.cols);
+        }
+
+        template <typename TensorViewT>
+        ROCWMMA_DEVICE constexpr inline int64_t
+            TensorSpace::fromBatchIndex(uint32_t batch, TensorViewT const& view)
+        {
+            return fromModeIndex(batch, view.batch);
+        }
+
+        template <uint32_t VectorWidth, typename TensorModesT>
+        ROCWMMA_DEVICE constexpr inline bool TensorSpace::isContiguous(TensorModesT const& modes)
+        {
+            return modes.count > 0u && modes.strides[modes.count - 1u] == 1
+                   && modes.extents[modes.count - 1u] % VectorWidth == 0u;
+        }
+
     } // namespace detail
 
     template <uint32_t BlockHeight, uint32_t BlockWidth, typename DataT, typename DataLayout>
@@ -183,7 +232,8 @@ namespace rocwmma
         MappingUtil<BlockHeight, BlockWidth, DataT, DataLayout>::dataCoord(DataT const* baseAddr,
                                                                            uint32_t     ldm)
     {
-        return baseAddr + DataSpace::fromMatrixCoord(matrixCoord(), ldm);
+        // Wave-uniform offset with a wave-uniform ldm
+        return baseAddr + detail::waveUniform(DataSpace::fromMatrixCoord(matrixCoord(), ldm));
     }
 
     template <uint32_t BlockHeight, uint32_t BlockWidth, typename DataT, typename DataLayout>
@@ -191,7 +241,8 @@ namespace rocwmma
         MappingUtil<BlockHeight, BlockWidth, DataT, DataLayout>::dataCoord(DataT*   baseAddr,
                                                                            uint32_t ldm)
     {
-        return baseAddr + DataSpace::fromMatrixCoord(matrixCoord(), ldm);
+        // Wave-uniform offset with a wave-uniform ldm
+        return baseAddr + detail::waveUniform(DataSpace::fromMatrixCoord(matrixCoord(), ldm));
     }
 
     /// Current workgroup perspective
@@ -279,6 +330,33 @@ namespace rocwmma
                + DataSpace::fromMatrixCoord(forward<MatrixCoordT const>(matrixCoord), ldm);
     }
 
+    template <uint32_t BlockHeight, uint32_t BlockWidth, typename DataT, typename DataLayout>
+    template <typename TensorViewT>
+    ROCWMMA_DEVICE inline int64_t
+        MappingUtil<BlockHeight, BlockWidth, DataT, DataLayout>::tensorOffset(
+            MatrixCoordT const& matrixCoord, TensorViewT const& view)
+    {
+        return detail::TensorSpace::fromMatrixCoord(matrixCoord, view);
+    }
+
+    template <uint32_t BlockHeight, uint32_t BlockWidth, typename DataT, typename DataLayout>
+    template <typename TensorViewT>
+    ROCWMMA_DEVICE inline DataT const*
+        MappingUtil<BlockHeight, BlockWidth, DataT, DataLayout>::tensorCoord(
+            DataT const* baseAddr, MatrixCoordT const& matrixCoord, TensorViewT const& view)
+    {
+        return baseAddr + detail::TensorSpace::fromMatrixCoord(matrixCoord, view);
+    }
+
+    template <uint32_t BlockHeight, uint32_t BlockWidth, typename DataT, typename DataLayout>
+    template <typename TensorViewT>
+    ROCWMMA_DEVICE inline DataT*
+        MappingUtil<BlockHeight, BlockWidth, DataT, DataLayout>::tensorCoord(
+            DataT* baseAddr, MatrixCoordT const& matrixCoord, TensorViewT const& view)
+    {
+        return baseAddr + detail::TensorSpace::fromMatrixCoord(matrixCoord, view);
+    }
+
 } // namespace rocwmma
 
 #endif // ROCWMMA_MAPPING_UTIL_IMPL_HPP
@@ -27,6 +27,8 @@
 #define ROCWMMA_MFMA_HPP
 
 #include "config.hpp"
+#include "convert.hpp"
+#include "pack_util.hpp"
 #include "vector.hpp"
 #include "vector_iterator.hpp"
 
@@ -43,6 +45,24 @@ namespace rocwmma
               typename Enabler = void>
     struct Mfma : public detail::amdgcn_mfma<InputT, ComputeT, BlockM, BlockN>
     {
+        template <typename InputCRegsT>
+        ROCWMMA_DEVICE static inline auto toNative(InputCRegsT const& regsC)
+        {
+            return regsC;
+        }
+
+        template <typename AccumRegsT>
+        ROCWMMA_DEVICE static inline auto fromNative(AccumRegsT const& accum)
+        {
+            return accum;
+        }
+
+        template <typename InputARegsT, typename InputBRegsT, typename AccumRegsT>
+        ROCWMMA_DEVICE static inline auto
+            execNative(InputARegsT const& regsA, InputBRegsT const& regsB, AccumRegsT const& accum)
+        {
+            return accum;
+        }
     };
 
     // Unlock the mfma backend only on MI cards
@@ -129,6 +149,63 @@ namespace rocwmma
             }
             return result;
         }
+
+        // Native accumulation.
+        // MFMA of 16b accumulators (f16, hf16, bf16) up-converts C to f32 and down-converts D
+        // on every exec. The native accumulator is the f32 accumulator of the upconverting
+        // backend, such that K loops convert once on each side.
+        // Other accumulators are natively supported, and the native accumulator is C.
+        constexpr static bool NativeUpconvert
+            = is_same_v<InputT, ComputeT>
+              && (is_same_v<ComputeT, float16_t> || is_same_v<ComputeT, bfloat16_t>
+#if !ROCWMMA_NO_HALF
+                  || is_same_v<ComputeT, hfloat16_t>
+#endif // !ROCWMMA_NO_HALF
+              );
+
+        using NativeMfma = Mfma<InputT, float32_t, BlockM, BlockN, BlockK>;
+        using PackUtilC  = PackUtil<ComputeT>;
+
+        ROCWMMA_DEVICE static inline auto toNative(typename Traits::CRegsT const& regsC)
+        {
+            if constexpr(NativeUpconvert)
+            {
+                return Convert<ComputeT, float32_t>::exec(PackUtilC::unpack(regsC));
+            }
+            else
+            {
+                return regsC;
+            }
+        }
+
+        template <typename AccumRegsT>
+        ROCWMMA_DEVICE static inline auto fromNative(AccumRegsT const& accum) ->
+            typename Traits::DRegsT
+        {
+            if constexpr(NativeUpconvert)
+            {
+                return PackUtilC::pack(Convert<float32_t, ComputeT>::exec(accum));
+            }
+            else
+            {
+                return accum;
+            }
+        }
+
+        template <typename AccumRegsT>
+        ROCWMMA_DEVICE static inline auto execNative(typename Traits::ARegsT const& regsA,
+                                                     typename Traits::BRegsT const& regsB,
+                                                     AccumRegsT const&              accum)
+        {
+            if constexpr(NativeUpconvert)
+            {
+                return NativeMfma::exec(regsA, regsB, accum);
+            }
+            else
+            {
+                return exec(regsA, regsB, accum);
+            }
+        }
     };
 
 } // namespace rocwmma
@@ -0,0 +1,287 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_MFMA_MULTIBLOCK_HPP
+#define ROCWMMA_MFMA_MULTIBLOCK_HPP
+
+#include "pack_util.hpp"
+#include "types.hpp"
+#include "vector.hpp"
+
+namespace rocwmma
+{
+
+    namespace detail
+    {
+        // Multi-block 4 x 4 MFMA. One instruction executes 16 independent 4 x 4 x KPerMfma
+        // products, block b in lanes [4b, 4b + 4): A lanes hold one row and B lanes one
+        // column of their block, with KPerMfma consecutive K elements each. D lanes hold
+        // one column of their block, with one register per row.
+        // Cbsz and Abid broadcast the A block Abid to 2^Cbsz blocks, such that with Cbsz = 4
+        // all 16 blocks share one A block against 16 different B blocks.
+        template <typename InputT, typename ComputeT>
+        struct amdgcn_mfma_4x4
+        {
+            template <uint32_t Cbsz = 0u,
+                      uint32_t Abid = 0u,
+                      typename RegsA,
+                      typename RegsB,
+                      typename RegsC>
+            ROCWMMA_DEVICE static inline auto exec(RegsA&& regsA, RegsB&& regsB, RegsC& regsC)
+            {
+                return regsC;
+            }
+        };
+
+// MFMA is MI architecture specific
+#if ROCWMMA_ARCH_GFX9
+
+        template <>
+        struct amdgcn_mfma_4x4<float32_t, float32_t>
+        {
+            // Packed register traits
+            struct Traits
+            {
+                enum : uint32_t
+                {
+                    KPerMfma = 1
+                };
+                using ARegsT = VRegF32x1;
+                using BRegsT = VRegF32x1;
+                using CRegsT = AccRegF32x4;
+                using DRegsT = AccRegF32x4;
+            };
+
+            template <uint32_t Cbsz = 0u, uint32_t Abid = 0u>
+            ROCWMMA_DEVICE static inline auto exec(typename Traits::ARegsT const& regsA,
+                                                   typename Traits::BRegsT const& regsB,
+                                                   typename Traits::CRegsT const& regsC) ->
+                typename Traits::DRegsT
+            {
+                typename Traits::DRegsT result;
+                result.data = {__builtin_amdgcn_mfma_f32_4x4x1f32(
+                    regsA.data[0], regsB.data[0], regsC.data, Cbsz, Abid, 0)};
+                return result;
+            }
+        };
+
+        template <>
+        struct amdgcn_mfma_4x4<float16_t, float32_t>
+        {
+            // Packed register traits
+            struct Traits
+            {
+                enum : uint32_t
+                {
+                    KPerMfma = 4
+                };
+                using ARegsT = VRegF32x2;
+                using BRegsT = VRegF32x2;
+                using CRegsT = AccRegF32x4;
+                using DRegsT = AccRegF32x4;
+            };
+
+            template <uint32_t Cbsz = 0u, uint32_t Abid = 0u>
+            ROCWMMA_DEVICE static inline auto exec(typename Traits::ARegsT const& regsA,
+                                                   typename Traits::BRegsT const& regsB,
+                                                   typename Traits::CRegsT const& regsC) ->
+                typename Traits::DRegsT
+            {
+                typename Traits::DRegsT result;
+                result.data = {__builtin_amdgcn_mfma_f32_4x4x4f16(
+                    regsA.data, regsB.data, regsC.data, Cbsz, Abid, 0)};
+                return result;
+            }
+        };
+
+#if !ROCWMMA_ARCH_GFX908
+
+        template <>
+        struct amdgcn_mfma_4x4<bfloat16_t, float32_t>
+        {
+            // Packed register traits
+            struct Traits
+            {
+                enum : uint32_t
+                {
+                    KPerMfma = 4
+                };
+                using ARegsT = VRegF32x2;
+                using BRegsT = VRegF32x2;
+                using CRegsT = AccRegF32x4;
+                using DRegsT = AccRegF32x4;
+            };
+
+            template <uint32_t Cbsz = 0u, uint32_t Abid = 0u>
+            ROCWMMA_DEVICE static inline auto exec(typename Traits::ARegsT const& regsA,
+                                                   typename Traits::BRegsT const& regsB,
+                                                   typename Traits::CRegsT const& regsC) ->
+                typename Traits::DRegsT
+            {
+                typename Traits::DRegsT result;
+                result.data = {__builtin_amdgcn_mfma_f32_4x4x4bf16_1k(
+                    regsA.data, regsB.data, regsC.data, Cbsz, Abid, 0)};
+                return result;
+            }
+        };
+
+#else // ROCWMMA_ARCH_GFX908
+
+        template <>
+        struct amdgcn_mfma_4x4<bfloat16_t, float32_t>
+        {
+            // Packed register traits
+            struct Traits
+            {
+                enum : uint32_t
+                {
+                    KPerMfma = 2
+                };
+                using ARegsT = VRegF32x1;
+                using BRegsT = VRegF32x1;
+                using CRegsT = AccRegF32x4;
+                using DRegsT = AccRegF32x4;
+            };
+
+            template <uint32_t Cbsz = 0u, uint32_t Abid = 0u>
+            ROCWMMA_DEVICE static inline auto exec(typename Traits::ARegsT const& regsA,
+                                                   typename Traits::BRegsT const& regsB,
+                                                   typename Traits::CRegsT const& regsC) ->
+                typename Traits::DRegsT
+            {
+                // Built-in expects unpacked vector of short.
+                using TypeIn = VecT<short, 2>;
+
+                static_assert(sizeof(TypeIn) == sizeof(decltype(regsA)),
+                              "Inconsistent data formats");
+
+                typename Traits::DRegsT result;
+                result.data = {__builtin_amdgcn_mfma_f32_4x4x2bf16(
+                    reinterpret_cast<TypeIn const&>(regsA).data,
+                    reinterpret_cast<TypeIn const&>(regsB).data,
+                    regsC.data,
+                    Cbsz,
+                    Abid,
+                    0)};
+                return result;
+            }
+        };
+
+#endif // !ROCWMMA_ARCH_GFX908
+
+        template <>
+        struct amdgcn_mfma_4x4<int8_t, int32_t>
+        {
+            // Packed register traits
+            struct Traits
+            {
+                enum : uint32_t
+                {
+                    KPerMfma = 4
+                };
+                using ARegsT = VRegI32x1;
+                using BRegsT = VRegI32x1;
+                using CRegsT = AccRegI32x4;
+                using DRegsT = AccRegI32x4;
+            };
+
+            template <uint32_t Cbsz = 0u, uint32_t Abid = 0u>
+            ROCWMMA_DEVICE static inline auto exec(typename Traits::ARegsT const& regsA,
+                                                   typename Traits::BRegsT const& regsB,
+                                                   typename Traits::CRegsT const& regsC) ->
+                typename Traits::DRegsT
+            {
+                typename Traits::DRegsT result;
+                result.data = {__builtin_amdgcn_mfma_i32_4x4x4i8(
+                    regsA.data[0], regsB.data[0], regsC.data, Cbsz, Abid, 0)};
+                return result;
+            }
+        };
+
+#else // !ROCWMMA_ARCH_GFX9
+
+        // Required for general multi-block support
+        template <typename InputT, typename ComputeT, uint32_t K>
+        struct amdgcn_mfma_4x4_unsupported
+        {
+            // Packed register traits
+            struct Traits
+            {
+                enum : uint32_t
+                {
+                    KPerMfma = K
+                };
+                using ARegsT = VecT<typename PackTraits<InputT>::PackedT,
+                                    K / PackTraits<InputT>::PackRatio>;
+                using BRegsT = ARegsT;
+                using CRegsT = VecT<ComputeT, 4u>;
+                using DRegsT = VecT<ComputeT, 4u>;
+            };
+
+            // This implementation is needed to satisfy the multi-block mma_sync interface,
+            // and WILL not function as intended.
+            // Only gfx9 targets support multi-block 4 x 4 mfma instructions.
+            template <uint32_t Cbsz = 0u, uint32_t Abid = 0u>
+            ROCWMMA_UNSUPPORTED_IMPL("4x4 multi-block mfma only supported on gfx9")
+            ROCWMMA_DEVICE static inline auto exec(typename Traits::ARegsT const& regsA,
+                                                   typename Traits::BRegsT const& regsB,
+                                                   typename Traits::CRegsT const& regsC)
+                -> typename Traits::DRegsT const&
+            {
+                return regsC;
+            }
+        };
+
+        template <>
+        struct amdgcn_mfma_4x4<float32_t, float32_t>
+            : public amdgcn_mfma_4x4_unsupported<float32_t, float32_t, 1>
+        {
+        };
+
+        template <>
+        struct amdgcn_mfma_4x4<float16_t, float32_t>
+            : public amdgcn_mfma_4x4_unsupported<float16_t, float32_t, 4>
+        {
+        };
+
+        template <>
+        struct amdgcn_mfma_4x4<bfloat16_t, float32_t>
+            : public amdgcn_mfma_4x4_unsupported<bfloat16_t, float32_t, 4>
+        {
+        };
+
+        template <>
+        struct amdgcn_mfma_4x4<int8_t, int32_t>
+            : public amdgcn_mfma_4x4_unsupported<int8_t, int32_t, 4>
+        {
+        };
+
+#endif // ROCWMMA_ARCH_GFX9
+
+    } // namespace detail
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_MFMA_MULTIBLOCK_HPP
@@ -0,0 +1,375 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_MX_LOAD_HPP
+#define ROCWMMA_MX_LOAD_HPP
+
+#include "convert.hpp"
+#include "io_traits.hpp"
+#include "layout.hpp"
+#include "tuple.hpp"
+#include "types.hpp"
+#include "vector_iterator.hpp"
+
+namespace rocwmma
+{
+
+    namespace detail
+    {
+
+        // Elements sharing one MX scale, along K
+        constexpr uint32_t MxBlockSize = 32u;
+
+        // Decodes an MX element of ExpBits exponent and ManBits mantissa bits, held in the
+        // low bits of bits. MX element types have no inf or NaN encodings.
+        template <uint32_t ExpBits, uint32_t ManBits>
+        ROCWMMA_HOST_DEVICE inline float32_t decodeMx(uint32_t bits)
+        {
+            constexpr uint32_t Bias = (1u << (ExpBits - 1u)) - 1u;
+
+            // Subnormals are man * 2^(1 - Bias - ManBits)
+            constexpr float32_t SubnormalUnit
+                = 1.0f / static_cast<float32_t>(1u << (Bias + ManBits - 1u));
+
+            auto sign = (bits >> (ExpBits + ManBits)) & 1u;
+            auto exp  = (bits >> ManBits) & ((1u << ExpBits) - 1u);
+            auto man  = bits & ((1u << ManBits) - 1u);
+
+            auto normal = __builtin_bit_cast(
+                float32_t, ((exp + 127u - Bias) << 23u) | (man << (23u - ManBits)));
+            auto result = (exp == 0u) ? static_cast<float32_t>(man) * SubnormalUnit : normal;
+            return sign ? -result : result;
+        }
+
+        // Decodes an MX scale. 2^-127 is a float32_t subnormal.
+        ROCWMMA_HOST_DEVICE inline float32_t decodeE8m0(e8m0_t scale)
+        {
+            auto bits = static_cast<uint32_t>(scale.data);
+            return __builtin_bit_cast(float32_t,
+                                      bits == 0u      ? 0x00400000u
+                                      : bits == 0xFFu ? 0x7FC00000u
+                                                      : bits << 23u);
+        }
+
+        // Loads VectorWidth contiguous MX elements of QuantT as float32_t.
+        // Offset is in elements of QuantT.
+        // Byte-sized element types (float8_ocp_t, bfloat8_ocp_t) are loaded as a vector.
+        template <typename QuantT, uint32_t VectorWidth>
+        struct amdgcn_mx_unpack
+        {
+            static_assert(VectorWidth > 0, "Vector width must be greater than 0");
+            static_assert(sizeof(QuantT) == 1u, "MX element types are 8 bits or packed");
+
+            using LoadT   = VecT<QuantT, VectorWidth>;
+            using OutputT = VecT<float32_t, VectorWidth>;
+
+            ROCWMMA_DEVICE static inline void
+                exec(OutputT& data, QuantT const* dataPtr, index_t offset)
+            {
+                data = Convert<QuantT, float32_t>::exec(
+                    *reinterpret_cast<LoadT const*>(&(dataPtr[offset])));
+            }
+        };
+
+        // Packed FP4 has no addressable element, so the offset is in FP4 elements
+        // and is resolved to the byte and nibble here, as for int4x2_t.
+        // Even vector widths load VectorWidth / 2 whole bytes, and assume an even offset.
+        template <uint32_t VectorWidth>
+        struct amdgcn_mx_unpack<float4_e2m1x2_t, VectorWidth>
+        {
+            static_assert(VectorWidth > 0, "Vector width must be greater than 0");
+            static_assert(VectorWidth <= 16u, "Vector width must be 16 or less");
+
+            using OutputT = VecT<float32_t, VectorWidth>;
+
+            ROCWMMA_DEVICE static inline void
+                exec(OutputT& data, float4_e2m1x2_t const* dataPtr, index_t offset)
+            {
+                auto bytes = reinterpret_cast<uint8_t const*>(dataPtr);
+
+                if constexpr(VectorWidth % 2u == 0u)
+                {
+                    using BitsT = conditional_t<
+                        VectorWidth == 2u,
+                        uint8_t,
+                        conditional_t<VectorWidth == 4u,
+                                      uint16_t,
+                                      conditional_t<VectorWidth == 8u, uint32_t, uint64_t>>>;
+
+                    auto bits = *reinterpret_cast<BitsT const*>(bytes + offset / 2);
+
+#pragma unroll
+                    for(uint32_t i = 0; i < VectorWidth; i++)
+                    {
+                        data.data[i] = decodeMx<2u, 1u>(static_cast<uint32_t>(bits >> (4u * i)));
+                    }
+                }
+                else
+                {
+#pragma unroll
+                    for(uint32_t i = 0; i < VectorWidth; i++)
+                    {
+                        auto element = offset + static_cast<index_t>(i);
+                        data.data[i] = decodeMx<2u, 1u>(bytes[element / 2] >> (4u * (element % 2)));
+                    }
+                }
+            }
+        };
+
+        // Packed FP6 groups four elements in 3 bytes, so the offset is in FP6 elements
+        // and is resolved to the group and field here.
+        // Vector widths that are multiples of 4 load whole groups, and assume an offset
+        // that is a multiple of 4.
+        template <typename QuantT, uint32_t ExpBits, uint32_t ManBits, uint32_t VectorWidth>
+        struct amdgcn_mx_unpack_fp6
+        {
+            static_assert(VectorWidth > 0, "Vector width must be greater than 0");
+            static_assert(ExpBits + ManBits == 5u, "FP6 has 5 exponent and mantissa bits");
+
+            using OutputT = VecT<float32_t, VectorWidth>;
+
+            ROCWMMA_DEVICE static inline uint32_t group(uint8_t const* bytes, index_t idx)
+            {
+                auto p = bytes + 3 * idx;
+                return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8u)
+                       | (static_cast<uint32_t>(p[2]) << 16u);
+            }
+
+            ROCWMMA_DEVICE static inline void
+                exec(OutputT& data, QuantT const* dataPtr, index_t offset)
+            {
+                auto bytes = reinterpret_cast<uint8_t const*>(dataPtr);
+
+                if constexpr(VectorWidth % 4u == 0u)
+                {
+#pragma unroll
+                    for(uint32_t i = 0; i < VectorWidth / 4u; i++)
+                    {
+                        auto bits = group(bytes, offset / 4 + static_cast<index_t>(i));
+
+#pragma unroll
+                        for(uint32_t j = 0; j < 4u; j++)
+                        {
+                            data.data[4u * i + j] = decodeMx<ExpBits, ManBits>(bits >> (6u * j));
+                        }
+                    }
+                }
+                else
+                {
+#pragma unroll
+                    for(uint32_t i = 0; i < VectorWidth; i++)
+                    {
+                        auto element = offset + static_cast<index_t>(i);
+                        auto bits    = group(bytes, element / 4);
+                        data.data[i]
+                            = decodeMx<ExpBits, ManBits>(bits >> (6u * (element % 4)));
+                    }
+                }
+            }
+        };
+
+        template <uint32_t VectorWidth>
+        struct amdgcn_mx_unpack<float6_e2m3x4_t, VectorWidth>
+            : public amdgcn_mx_unpack_fp6<float6_e2m3x4_t, 2u, 3u, VectorWidth>
+        {
+        };
+
+        template <uint32_t VectorWidth>
+        struct amdgcn_mx_unpack<float6_e3m2x4_t, VectorWidth>
+            : public amdgcn_mx_unpack_fp6<float6_e3m2x4_t, 3u, 2u, VectorWidth>
+        {
+        };
+
+        // Loads VectorWidth contiguous MX elements at the matrix coordinate coord, then
+        // scales them by their block scales and converts them to DataT.
+        // KIndex is the index of the K dimension in matrix coordinates.
+        template <typename QuantT,
+                  typename DataT,
+                  class DataLayout,
+                  uint32_t VectorWidth,
+                  uint32_t KIndex>
+        struct amdgcn_mx_load
+        {
+            using Unpacker = amdgcn_mx_unpack<QuantT, VectorWidth>;
+            using OutputT  = VecT<DataT, VectorWidth>;
+
+            // Offset of the block scale of the element at coord
+            ROCWMMA_DEVICE static inline index_t scaleOffset(Coord2d coord, uint32_t lds)
+            {
+                get<KIndex>(coord) /= MxBlockSize;
+                return DataLayout::fromMatrixCoord(coord, lds);
+            }
+
+            ROCWMMA_DEVICE static inline void exec(OutputT&      data,
+                                                   QuantT const* dataPtr,
+                                                   index_t       offset,
+                                                   e8m0_t const* scalePtr,
+                                                   Coord2d       coord,
+                                                   uint32_t      lds)
+            {
+                typename Unpacker::OutputT values;
+                Unpacker::exec(values, dataPtr, offset);
+
+                // Vectors contiguous in K are aligned within one scale block,
+                // otherwise each element has its own scale.
+                if constexpr(DataLayout::MinorIndex == KIndex)
+                {
+                    static_assert(MxBlockSize % VectorWidth == 0u,
+                                  "Vector width must divide the MX block size");
+
+                    auto scale = decodeE8m0(scalePtr[scaleOffset(coord, lds)]);
+
+#pragma unroll
+                    for(uint32_t i = 0; i < VectorWidth; i++)
+                    {
+                        data.data[i] = static_cast<DataT>(values.data[i] * scale);
+                    }
+                }
+                else
+                {
+#pragma unroll
+                    for(uint32_t i = 0; i < VectorWidth; i++)
+                    {
+                        auto elementCoord = coord;
+                        get<DataLayout::MinorIndex>(elementCoord) += i;
+
+                        auto scale   = decodeE8m0(scalePtr[scaleOffset(elementCoord, lds)]);
+                        data.data[i] = static_cast<DataT>(values.data[i] * scale);
+                    }
+                }
+            }
+        };
+
+    } // namespace detail
+
+    // Loads MX data of QuantT with the matrix layout of a DataT fragment, then
+    // scales each element by the e8m0_t scale of its block of 32 along K and
+    // converts it to DataT in registers.
+    // Data is traversed by element offsets as in DequantLoad, and the matrix
+    // coordinate of each vector is tracked as in BoundedLoad to locate its scales.
+    template <uint32_t BlockDim,
+              uint32_t BlockK,
+              typename QuantT,
+              typename DataT,
+              class DataLayout,
+              class MatrixLayout,
+              uint32_t VectorWidth,
+              uint32_t KIndex>
+    struct MxLoad
+    {
+        using IOTraits = IOTraits<BlockDim, BlockK, DataT, VectorWidth>;
+
+        struct Traits
+        {
+            // Raw IO on unpacked register data.
+            using Loader
+                = detail::amdgcn_mx_load<QuantT, DataT, DataLayout, VectorWidth, KIndex>;
+            using LoadT   = typename Loader::OutputT;
+            using OutputT = VecT<DataT, IOTraits::UnpackedSize>;
+        };
+
+        using LoadVecTraits = VecTraits<typename Traits::LoadT>;
+
+        // Outer loop = index 0,
+        // Inner loop = index N-1
+        template <size_t Depth = 0,
+                  typename Iterator,
+                  typename StrideCounts,
+                  typename Strides2d>
+        ROCWMMA_DEVICE static inline auto unroll_right(Iterator&      out,
+                                                       QuantT const*  dataPtr,
+                                                       index_t        offset,
+                                                       e8m0_t const*  scalePtr,
+                                                       Coord2d        coord,
+                                                       uint32_t       ldm,
+                                                       uint32_t       lds,
+                                                       StrideCounts&& strideCounts,
+                                                       Strides2d&&    strides2d)
+        {
+            auto stride2d     = get<Depth>(strides2d);
+            auto strideOffset = DataLayout::fromMatrixCoord(stride2d, ldm);
+            auto strideCount  = get<Depth>(strideCounts);
+
+            // Last depth layer will invoke the load
+            if constexpr(Depth == (VecTraits<decay_t<StrideCounts>>::size() - 1u))
+            {
+#pragma unroll
+                for(int i = 0; i < strideCount; i++)
+                {
+                    Traits::Loader::exec(*out, dataPtr, offset, scalePtr, coord, lds);
+                    offset += strideOffset;
+                    coord += stride2d;
+                    out++;
+                }
+            }
+            // Recurse to the next nested layer
+            else
+            {
+#pragma unroll
+                for(int i = 0; i < strideCount; i++)
+                {
+                    unroll_right<Depth + 1>(
+                        out, dataPtr, offset, scalePtr, coord, ldm, lds, strideCounts, strides2d);
+                    offset += strideOffset;
+                    coord += stride2d;
+                }
+            }
+        }
+
+        ROCWMMA_DEVICE static void exec(typename Traits::OutputT& data,
+                                        QuantT const*             dataPtr,
+                                        e8m0_t const*             scalePtr,
+                                        uint32_t                  ldm,
+                                        uint32_t                  lds)
+        {
+            // Arrange wave threads to starting matrix layout offsets.
+            auto baseOffset2d = MatrixLayout::baseOffset();
+            auto it           = makeVectorIterator<LoadVecTraits::size()>(data).begin();
+
+            static_assert(decltype(it)::range() == IOTraits::IOCount,
+                          "IOCount inconsistent with iterator range");
+
+            // Make sure that the IOCount is consistent with the number of total strides
+            static_assert(IOTraits::IOCount
+                              == apply([](auto... items) { return (items * ...); },
+                                       MatrixLayout::strideCounts()),
+                          "IOCount inconsistent with total strides");
+
+            // Unroll loading in each strided dimension
+            unroll_right(it,
+                         dataPtr,
+                         DataLayout::fromMatrixCoord(baseOffset2d, ldm),
+                         scalePtr,
+                         baseOffset2d,
+                         ldm,
+                         lds,
+                         MatrixLayout::strideCounts(),
+                         MatrixLayout::strides());
+        }
+    };
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_MX_LOAD_HPP
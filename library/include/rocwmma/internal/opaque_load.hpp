@@ -26,6 +26,7 @@
 #ifndef ROCWMMA_OPAQUE_LOAD_HPP
 #define ROCWMMA_OPAQUE_LOAD_HPP
 
+#include "access_policy.hpp"
 #include "io_traits.hpp"
 #include "layout.hpp"
 #include "tuple.hpp"
@@ -38,7 +39,7 @@ namespace rocwmma
     namespace detail
     {
 
-        template <typename DataT, uint32_t VectorWidth>
+        template <typename DataT, uint32_t VectorWidth, class AccessPolicy = cache_default>
         struct amdgcn_opaque_load
         {
             static_assert(VectorWidth > 0, "Vector width must be greater than 0");
@@ -50,7 +51,8 @@ namespace rocwmma
             ROCWMMA_DEVICE static inline void
                 exec(LoadT& data, DataT const* dataPtr, index_t offset = 0)
             {
-                data = *reinterpret_cast<LoadT const*>(&(dataPtr[offset]));
+                detail::amdgcn_access_policy<AccessPolicy, LoadT>::load(
+                    data, reinterpret_cast<LoadT const*>(&(dataPtr[offset])));
             }
         };
 
@@ -61,7 +63,8 @@ namespace rocwmma
               typename DataT,
               class DataLayout,
               class MatrixLayout,
-              uint32_t VectorWidth>
+              uint32_t VectorWidth,
+              class AccessPolicy = cache_default>
     struct OpaqueLoad
     {
         using IOTraits = IOTraits<BlockDim, BlockK, DataT, VectorWidth>;
@@ -69,7 +72,7 @@ namespace rocwmma
         struct Traits
         {
             // Raw IO on unpacked register data.
-            using Loader  = detail::amdgcn_opaque_load<DataT, VectorWidth>;
+            using Loader  = detail::amdgcn_opaque_load<DataT, VectorWidth, AccessPolicy>;
             using LoadT   = typename Loader::LoadT;
             using OutputT = VecT<DataT, IOTraits::UnpackedSize>;
         };
@@ -26,6 +26,7 @@
 #ifndef ROCWMMA_OPAQUE_STORE_HPP
 #define ROCWMMA_OPAQUE_STORE_HPP
 
+#include "access_policy.hpp"
 #include "io_traits.hpp"
 #include "layout.hpp"
 #include "types.hpp"
@@ -37,7 +38,7 @@ namespace rocwmma
     namespace detail
     {
 
-        template <typename DataT, uint32_t VectorWidth>
+        template <typename DataT, uint32_t VectorWidth, class AccessPolicy = cache_default>
         struct amdgcn_opaque_store
         {
             static_assert(VectorWidth > 0, "Vector width must be greater than 0");
@@ -48,7 +49,8 @@ namespace rocwmma
             ROCWMMA_DEVICE static inline void
                 exec(DataT* dataPtr, StoreT const& data, index_t offset = 0)
             {
-                *reinterpret_cast<StoreT*>(&(dataPtr[offset])) = data;
+                detail::amdgcn_access_policy<AccessPolicy, StoreT>::store(
+                    reinterpret_cast<StoreT*>(&(dataPtr[offset])), data);
             }
         };
 
@@ -59,14 +61,15 @@ namespace rocwmma
               typename DataT,
               class DataLayout,
               class MatrixLayout,
-              uint32_t VectorWidth>
+              uint32_t VectorWidth,
+              class AccessPolicy = cache_default>
     struct OpaqueStore
     {
         using IOTraits = IOTraits<BlockDim, BlockK, DataT, VectorWidth>;
         struct Traits
         {
             // Raw IO on unpacked register data.
-            using Storer = detail::amdgcn_opaque_store<DataT, VectorWidth>;
+            using Storer = detail::amdgcn_opaque_store<DataT, VectorWidth, AccessPolicy>;
             using StoreT = typename Storer::StoreT;
             using InputT = VecT<DataT, IOTraits::UnpackedSize>;
         };
@@ -58,6 +58,11 @@ namespace rocwmma
         using PackedT   = typename Traits::PackedT;
         using UnpackedT = typename Traits::UnpackedT;
 
+        // Sub-byte elements (e.g. int4) are held one per UnpackedT, and are
+        // packed by bit manipulation rather than by reinterpretation.
+        constexpr static bool IsSubByte
+            = (sizeof(UnpackedT) * Traits::PackRatio > sizeof(PackedT));
+
         using PaddingB32 = union
         {
             PackedT   packed;
@@ -75,10 +80,10 @@ namespace rocwmma
         ROCWMMA_DEVICE static inline decltype(auto) unpadHelper(VecT<PackedT, VecSize> const& v);
 
         template <uint32_t VecSize>
-        ROCWMMA_DEVICE static inline auto& packHelper(VecT<UnpackedT, VecSize> const& v);
+        ROCWMMA_DEVICE static inline decltype(auto) packHelper(VecT<UnpackedT, VecSize> const& v);
 
         template <uint32_t VecSize>
-        ROCWMMA_DEVICE static inline auto& unpackHelper(VecT<PackedT, VecSize> const& v);
+        ROCWMMA_DEVICE static inline decltype(auto) unpackHelper(VecT<PackedT, VecSize> const& v);
 
         template <uint32_t PadIdx = 0u, uint32_t VecSize, uint32_t... GetIdx>
         ROCWMMA_DEVICE static inline decltype(auto) pad(VecT<UnpackedT, VecSize> const& v,
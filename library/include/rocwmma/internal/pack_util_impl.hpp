@@ -57,6 +57,18 @@ namespace rocwmma
         using PackedT   = uint32_t;
     };
 
+    template <>
+    struct PackTraits<int4_t>
+    {
+        enum : uint32_t
+        {
+            PackRatio = 8 // 8 nibbles combine to one
+        };
+
+        using UnpackedT = int8_t;
+        using PackedT   = int32_t;
+    };
+
     template <>
     struct PackTraits<int16_t>
     {
@@ -141,6 +153,30 @@ namespace rocwmma
         using PackedT   = float32_t;
     };
 
+    template <>
+    struct PackTraits<float8_ocp_t>
+    {
+        enum : uint32_t
+        {
+            PackRatio = 4
+        };
+
+        using UnpackedT = float8_ocp_t;
+        using PackedT   = float32_t;
+    };
+
+    template <>
+    struct PackTraits<bfloat8_ocp_t>
+    {
+        enum : uint32_t
+        {
+            PackRatio = 4
+        };
+
+        using UnpackedT = bfloat8_ocp_t;
+        using PackedT   = float32_t;
+    };
+
     template <>
     struct PackTraits<float16_t>
     {
@@ -215,6 +251,49 @@ namespace rocwmma
         using PackedT   = float64_t;
     };
 
+    namespace detail
+    {
+        // Packs eight sign-extended int4 bytes, 64 bits as lo = [e3, e2, e1, e0]
+        // and hi = [e7, e6, e5, e4], to one b32 of nibbles [e7, e6, ... e0].
+        struct amdgcn_pack_b4
+        {
+            ROCWMMA_DEVICE static inline uint32_t exec(uint32_t lo, uint32_t hi)
+            {
+                // Gather evens = [e6, e4, e2, e0] and odds = [e7, e5, e3, e1]
+                auto evens = __builtin_amdgcn_perm(hi, lo, 0x06040200u);
+                auto odds  = __builtin_amdgcn_perm(hi, lo, 0x07050301u);
+
+                // Byte i = (e[2i + 1] << 4) | e[2i]
+                return (evens & 0x0F0F0F0Fu) | ((odds << 4u) & 0xF0F0F0F0u);
+            }
+        };
+
+        // Inverse of amdgcn_pack_b4: unpacks one b32 of nibbles to eight
+        // sign-extended int4 bytes, returned as 64 bits.
+        struct amdgcn_unpack_b4
+        {
+            // Sign-extends the low nibble of each byte. Biasing each byte with
+            // its top bit keeps the subtraction from borrowing across bytes.
+            ROCWMMA_DEVICE static inline uint32_t signExtend(uint32_t nibbles)
+            {
+                return (((nibbles ^ 0x08080808u) | 0x80808080u) - 0x08080808u) ^ 0x80808080u;
+            }
+
+            ROCWMMA_DEVICE static inline uint64_t exec(uint32_t packed)
+            {
+                auto evens = signExtend(packed & 0x0F0F0F0Fu);
+                auto odds  = signExtend((packed >> 4u) & 0x0F0F0F0Fu);
+
+                // Interleave back to lo = [e3, e2, e1, e0] and hi = [e7, e6, e5, e4]
+                auto lo = __builtin_amdgcn_perm(odds, evens, 0x05010400u);
+                auto hi = __builtin_amdgcn_perm(odds, evens, 0x07030602u);
+
+                return (static_cast<uint64_t>(hi) << 32u) | static_cast<uint64_t>(lo);
+            }
+        };
+
+    } // namespace detail
+
     template <typename DataT>
     template <uint32_t PadIdx /*= 0u*/, uint32_t GetIdx /*= 0u*/, uint32_t VecSize>
     ROCWMMA_DEVICE /*static*/ inline decltype(auto)
@@ -228,7 +307,13 @@ namespace rocwmma
         {
             return get<GetIdx>(v);
         }
-        // Case 2: Pad out to 32b
+        // Case 2: Pad a sub-byte element out to 32b, at nibble PadIdx
+        else if constexpr(IsSubByte)
+        {
+            auto bits = static_cast<uint32_t>(get<GetIdx>(v)) & 0xFu;
+            return static_cast<PackedT>(bits << (4u * PadIdx));
+        }
+        // Case 3: Pad out to 32b
         else
         {
             PaddingB32 p;
@@ -250,7 +335,13 @@ namespace rocwmma
         {
             return get<GetIdx>(v);
         }
-        // Case 2: unpad from 32b
+        // Case 2: Sign-extending bitfield extract of nibble PadIdx
+        else if constexpr(IsSubByte)
+        {
+            auto bits = static_cast<int32_t>(get<GetIdx>(v));
+            return static_cast<UnpackedT>(__builtin_amdgcn_sbfe(bits, 4u * PadIdx, 4u));
+        }
+        // Case 3: unpad from 32b
         else
         {
             PaddingB32 p;
@@ -261,21 +352,42 @@ namespace rocwmma
 
     template <typename DataT>
     template <uint32_t VecSize>
-    ROCWMMA_DEVICE /*static*/ inline auto&
+    ROCWMMA_DEVICE /*static*/ inline decltype(auto)
         PackUtil<DataT>::packHelper(VecT<UnpackedT, VecSize> const& v)
     {
         static_assert(VecSize % Traits::PackRatio == 0,
                       "Cannot pack partial b32 vector. Use paddedPack instead.");
 
-        // NOTE: Assumes that there is NO padding...
         using PackedVecT   = VecT<PackedT, VecSize / Traits::PackRatio>;
         using UnpackedVecT = decay_t<decltype(v)>;
-        return reinterpret_cast<PackedVecT const&>(v);
+
+        if constexpr(IsSubByte)
+        {
+            // Each b32 packs 64 bits of unpacked elements
+            using B32VecT = VecT<uint32_t, VecSize * sizeof(UnpackedT) / sizeof(uint32_t)>;
+
+            auto const& bits = reinterpret_cast<B32VecT const&>(v);
+            PackedVecT  result;
+
+#pragma unroll
+            for(uint32_t i = 0; i < VecSize / Traits::PackRatio; i++)
+            {
+                auto packed
+                    = detail::amdgcn_pack_b4::exec(bits.data[2u * i], bits.data[2u * i + 1u]);
+                result.data[i] = static_cast<PackedT>(packed);
+            }
+            return result;
+        }
+        else
+        {
+            // NOTE: Assumes that there is NO padding...
+            return reinterpret_cast<PackedVecT const&>(v);
+        }
     }
 
     template <typename DataT>
     template <uint32_t VecSize>
-    ROCWMMA_DEVICE /*static*/ inline auto&
+    ROCWMMA_DEVICE /*static*/ inline decltype(auto)
         PackUtil<DataT>::unpackHelper(VecT<PackedT, VecSize> const& v)
     {
         if constexpr(is_same_v<PackedT, UnpackedT>)
@@ -283,11 +395,32 @@ namespace rocwmma
             static_assert(Traits::PackRatio == 1, "Input vector must be packed");
         }
 
-        // NOTE: Assumes that there is NO padding...
         using PackedVecT   = decay_t<decltype(v)>;
         using UnpackedVecT = VecT<UnpackedT, VecSize * Traits::PackRatio>;
 
-        return reinterpret_cast<UnpackedVecT const&>(v);
+        if constexpr(IsSubByte)
+        {
+            // Each b32 unpacks to 64 bits of unpacked elements
+            using B32VecT = VecT<uint32_t, VecSize * Traits::PackRatio * sizeof(UnpackedT)
+                                               / sizeof(uint32_t)>;
+
+            UnpackedVecT result;
+            auto&        bits = reinterpret_cast<B32VecT&>(result);
+
+#pragma unroll
+            for(uint32_t i = 0; i < VecSize; i++)
+            {
+                auto unpacked = detail::amdgcn_unpack_b4::exec(static_cast<uint32_t>(v.data[i]));
+                bits.data[2u * i]      = static_cast<uint32_t>(unpacked);
+                bits.data[2u * i + 1u] = static_cast<uint32_t>(unpacked >> 32u);
+            }
+            return result;
+        }
+        else
+        {
+            // NOTE: Assumes that there is NO padding...
+            return reinterpret_cast<UnpackedVecT const&>(v);
+        }
     }
 
     template <typename DataT>
@@ -0,0 +1,208 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_PAGED_LOAD_HPP
+#define ROCWMMA_PAGED_LOAD_HPP
+
+#include "dequant_load.hpp"
+#include "io_traits.hpp"
+#include "layout.hpp"
+#include "tuple.hpp"
+#include "types.hpp"
+#include "vector_iterator.hpp"
+
+namespace rocwmma
+{
+
+    namespace detail
+    {
+
+        // Loads VectorWidth elements at matrix coordinate (row, col) of a paged matrix.
+        // The major index (rows for row major, columns for col major) is split into pages
+        // of pageSize vectors, such that major index i is vector (i % pageSize) of page
+        // pageTable[i / pageSize] in the page pool. Vectors run along the minor index,
+        // always lie within one page and are loaded whole.
+        // Vectors of a negative page are not read and are zero-filled.
+        // A QuantT other than DataT is a quantized page pool, converted to DataT after the load.
+        template <typename DataT, class DataLayout, uint32_t VectorWidth, typename QuantT = DataT>
+        struct amdgcn_paged_load
+        {
+            static_assert(VectorWidth > 0, "Vector width must be greater than 0");
+            static_assert(sizeof(DataT[VectorWidth]) == sizeof(VecT<DataT, VectorWidth>),
+                          "Cannot vectorize input");
+
+            using LoadT = VecT<DataT, VectorWidth>;
+
+            ROCWMMA_DEVICE static inline void exec(LoadT&         data,
+                                                   QuantT const*  dataPtr,
+                                                   index_t const* pageTable,
+                                                   uint32_t       pageSize,
+                                                   uint32_t       ldm,
+                                                   Coord2d        coord)
+            {
+                auto major = get<DataLayout::MajorIndex>(coord);
+                auto minor = get<DataLayout::MinorIndex>(coord);
+                auto page  = pageTable[major / pageSize];
+
+                if(page >= 0)
+                {
+                    // Page pools may exceed 32-bit element offsets
+                    auto vector = static_cast<int64_t>(page) * pageSize + major % pageSize;
+                    if constexpr(is_same<QuantT, DataT>::value)
+                    {
+                        data = *reinterpret_cast<LoadT const*>(dataPtr + vector * ldm + minor);
+                    }
+                    else if constexpr(is_same<QuantT, int4x2_t>::value)
+                    {
+                        // Two elements per byte: the vector offset is even for an even ldm
+                        auto vectorPtr = reinterpret_cast<int4x2_t const*>(
+                            reinterpret_cast<uint8_t const*>(dataPtr) + vector * ldm / 2);
+                        amdgcn_dequant_load<QuantT, DataT, VectorWidth>::exec(
+                            data, vectorPtr, minor);
+                    }
+                    else
+                    {
+                        amdgcn_dequant_load<QuantT, DataT, VectorWidth>::exec(
+                            data, dataPtr + vector * ldm, minor);
+                    }
+                }
+                else
+                {
+#pragma unroll
+                    for(uint32_t i = 0; i < VectorWidth; i++)
+                    {
+                        data.data[i] = static_cast<DataT>(0);
+                    }
+                }
+            }
+        };
+
+    } // namespace detail
+
+    // Loads with the same matrix layout as OpaqueLoad, however the major vectors
+    // of the matrix are located through a page table, such that paged storage
+    // (e.g. a paged KV cache) is read in place. The matrix coordinate of each
+    // vector is tracked in place of a data pointer.
+    // With a QuantT other than DataT, the page pool holds quantized data that is read with
+    // the matrix layout of the DataT fragment and converted in registers, as in DequantLoad.
+    template <uint32_t BlockDim,
+              uint32_t BlockK,
+              typename DataT,
+              class DataLayout,
+              class MatrixLayout,
+              uint32_t VectorWidth,
+              typename QuantT = DataT>
+    struct PagedLoad
+    {
+        using IOTraits = IOTraits<BlockDim, BlockK, DataT, VectorWidth>;
+
+        struct Traits
+        {
+            // Raw IO on unpacked register data.
+            using Loader  = detail::amdgcn_paged_load<DataT, DataLayout, VectorWidth, QuantT>;
+            using LoadT   = typename Loader::LoadT;
+            using OutputT = VecT<DataT, IOTraits::UnpackedSize>;
+        };
+
+        using LoadVecTraits = VecTraits<typename Traits::LoadT>;
+
+        // Outer loop = index 0,
+        // Inner loop = index N-1
+        template <size_t Depth = 0,
+                  typename Iterator,
+                  typename StrideCounts,
+                  typename Strides2d>
+        ROCWMMA_DEVICE static inline auto unroll_right(Iterator&      out,
+                                                       QuantT const*  dataPtr,
+                                                       index_t const* pageTable,
+                                                       uint32_t       pageSize,
+                                                       uint32_t       ldm,
+                                                       Coord2d        coord,
+                                                       StrideCounts&& strideCounts,
+                                                       Strides2d&&    strides2d)
+        {
+            auto stride2d    = get<Depth>(strides2d);
+            auto strideCount = get<Depth>(strideCounts);
+
+            // Last depth layer will invoke the load
+            if constexpr(Depth == (VecTraits<decay_t<StrideCounts>>::size() - 1u))
+            {
+#pragma unroll
+                for(int i = 0; i < strideCount; i++)
+                {
+                    Traits::Loader::exec(*out, dataPtr, pageTable, pageSize, ldm, coord);
+                    coord += stride2d;
+                    out++;
+                }
+            }
+            // Recurse to the next nested layer
+            else
+            {
+#pragma unroll
+                for(int i = 0; i < strideCount; i++)
+                {
+                    unroll_right<Depth + 1>(
+                        out, dataPtr, pageTable, pageSize, ldm, coord, strideCounts, strides2d);
+                    coord += stride2d;
+                }
+            }
+        }
+
+        ROCWMMA_DEVICE static void exec(typename Traits::OutputT& data,
+                                        QuantT const*             dataPtr,
+                                        index_t const*            pageTable,
+                                        uint32_t                  pageSize,
+                                        uint32_t                  ldm,
+                                        Coord2d                   origin)
+        {
+            // Arrange wave threads to starting matrix layout offsets.
+            auto baseOffset2d = MatrixLayout::baseOffset();
+            auto it           = makeVectorIterator<LoadVecTraits::size()>(data).begin();
+
+            static_assert(decltype(it)::range() == IOTraits::IOCount,
+                          "IOCount inconsistent with iterator range");
+
+            // Make sure that the IOCount is consistent with the number of total strides
+            static_assert(IOTraits::IOCount
+                              == apply([](auto... items) { return (items * ...); },
+                                       MatrixLayout::strideCounts()),
+                          "IOCount inconsistent with total strides");
+
+            // Unroll loading in each strided dimension
+            origin += baseOffset2d;
+            unroll_right(it,
+                         dataPtr,
+                         pageTable,
+                         pageSize,
+                         ldm,
+                         origin,
+                         MatrixLayout::strideCounts(),
+                         MatrixLayout::strides());
+        }
+    };
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_PAGED_LOAD_HPP
@@ -0,0 +1,178 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_PAGED_STORE_HPP
+#define ROCWMMA_PAGED_STORE_HPP
+
+#include "io_traits.hpp"
+#include "layout.hpp"
+#include "tuple.hpp"
+#include "types.hpp"
+#include "vector_iterator.hpp"
+
+namespace rocwmma
+{
+
+    namespace detail
+    {
+
+        // Stores VectorWidth elements at matrix coordinate (row, col) of a paged matrix,
+        // with the same page addressing as amdgcn_paged_load: major index i is vector
+        // (i % pageSize) of page pageTable[i / pageSize] in the page pool.
+        // Vectors run along the minor index, always lie within one page and are stored whole.
+        // Vectors of a negative page are not written.
+        template <typename DataT, class DataLayout, uint32_t VectorWidth>
+        struct amdgcn_paged_store
+        {
+            static_assert(VectorWidth > 0, "Vector width must be greater than 0");
+            static_assert(sizeof(DataT[VectorWidth]) == sizeof(VecT<DataT, VectorWidth>),
+                          "Cannot vectorize output");
+
+            using StoreT = VecT<DataT, VectorWidth>;
+
+            ROCWMMA_DEVICE static inline void exec(DataT*         dataPtr,
+                                                   StoreT const&  data,
+                                                   index_t const* pageTable,
+                                                   uint32_t       pageSize,
+                                                   uint32_t       ldm,
+                                                   Coord2d        coord)
+            {
+                auto major = get<DataLayout::MajorIndex>(coord);
+                auto minor = get<DataLayout::MinorIndex>(coord);
+                auto page  = pageTable[major / pageSize];
+
+                if(page >= 0)
+                {
+                    // Page pools may exceed 32-bit element offsets
+                    auto vector = static_cast<int64_t>(page) * pageSize + major % pageSize;
+                    *reinterpret_cast<StoreT*>(dataPtr + vector * ldm + minor) = data;
+                }
+            }
+        };
+
+    } // namespace detail
+
+    // Stores with the same matrix layout as OpaqueStore, however the major vectors
+    // of the matrix are located through a page table, such that paged storage
+    // (e.g. a paged KV cache) is written in place. The matrix coordinate of each
+    // vector is tracked in place of a data pointer.
+    template <uint32_t BlockDim,
+              uint32_t BlockK,
+              typename DataT,
+              class DataLayout,
+              class MatrixLayout,
+              uint32_t VectorWidth>
+    struct PagedStore
+    {
+        using IOTraits = IOTraits<BlockDim, BlockK, DataT, VectorWidth>;
+
+        struct Traits
+        {
+            // Raw IO on unpacked register data.
+            using Storer = detail::amdgcn_paged_store<DataT, DataLayout, VectorWidth>;
+            using StoreT = typename Storer::StoreT;
+            using InputT = VecT<DataT, IOTraits::UnpackedSize>;
+        };
+
+        using StoreVecTraits = VecTraits<typename Traits::StoreT>;
+
+        // Outer loop = index 0,
+        // Inner loop = index N-1
+        template <size_t Depth = 0,
+                  typename Iterator,
+                  typename StrideCounts,
+                  typename Strides2d>
+        ROCWMMA_DEVICE static inline auto unroll_right(DataT*         dataPtr,
+                                                       Iterator&      in,
+                                                       index_t const* pageTable,
+                                                       uint32_t       pageSize,
+                                                       uint32_t       ldm,
+                                                       Coord2d        coord,
+                                                       StrideCounts&& strideCounts,
+                                                       Strides2d&&    strides2d)
+        {
+            auto stride2d    = get<Depth>(strides2d);
+            auto strideCount = get<Depth>(strideCounts);
+
+            // Last depth layer will invoke the store
+            if constexpr(Depth == (VecTraits<decay_t<StrideCounts>>::size() - 1u))
+            {
+#pragma unroll
+                for(int i = 0; i < strideCount; i++)
+                {
+                    Traits::Storer::exec(dataPtr, *in, pageTable, pageSize, ldm, coord);
+                    coord += stride2d;
+                    in++;
+                }
+            }
+            // Recurse to the next nested layer
+            else
+            {
+#pragma unroll
+                for(int i = 0; i < strideCount; i++)
+                {
+                    unroll_right<Depth + 1>(
+                        dataPtr, in, pageTable, pageSize, ldm, coord, strideCounts, strides2d);
+                    coord += stride2d;
+                }
+            }
+        }
+
+        ROCWMMA_DEVICE static void exec(DataT*                          dataPtr,
+                                        typename Traits::InputT const& data,
+                                        index_t const*                  pageTable,
+                                        uint32_t                        pageSize,
+                                        uint32_t                        ldm,
+                                        Coord2d                         origin)
+        {
+            // Arrange wave threads to starting matrix layout offsets.
+            auto baseOffset2d = MatrixLayout::baseOffset();
+            auto it           = makeVectorIterator<StoreVecTraits::size()>(data).begin();
+
+            static_assert(decltype(it)::range() == IOTraits::IOCount,
+                          "IOCount inconsistent with iterator range");
+
+            // Make sure that the IOCount is consistent with the number of total strides
+            static_assert(IOTraits::IOCount
+                              == apply([](auto... items) { return (items * ...); },
+                                       MatrixLayout::strideCounts()),
+                          "IOCount inconsistent with total strides");
+
+            // Unroll storing in each strided dimension
+            origin += baseOffset2d;
+            unroll_right(dataPtr,
+                         it,
+                         pageTable,
+                         pageSize,
+                         ldm,
+                         origin,
+                         MatrixLayout::strideCounts(),
+                         MatrixLayout::strides());
+        }
+    };
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_PAGED_STORE_HPP
@@ -0,0 +1,87 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_PHILOX_HPP
+#define ROCWMMA_PHILOX_HPP
+
+#include "types.hpp"
+
+namespace rocwmma
+{
+    namespace detail
+    {
+        // Philox4x32-10 counter-based generator (Salmon et al., SC'11).
+        // Output is a pure function of (seed, counter): random streams are
+        // reproducible from the seed and need no state between calls.
+        struct Philox4x32
+        {
+            struct uint4_t
+            {
+                uint32_t x, y, z, w;
+            };
+
+            constexpr static uint32_t M0     = 0xD2511F53u;
+            constexpr static uint32_t M1     = 0xCD9E8D57u;
+            constexpr static uint32_t W0     = 0x9E3779B9u;
+            constexpr static uint32_t W1     = 0xBB67AE85u;
+            constexpr static uint32_t Rounds = 10u;
+
+            ROCWMMA_HOST_DEVICE static inline uint4_t generate(uint64_t seed, uint4_t ctr)
+            {
+                uint32_t key0 = static_cast<uint32_t>(seed);
+                uint32_t key1 = static_cast<uint32_t>(seed >> 32u);
+
+#pragma unroll
+                for(uint32_t i = 0; i < Rounds; ++i)
+                {
+                    auto prod0 = static_cast<uint64_t>(M0) * ctr.x;
+                    auto prod1 = static_cast<uint64_t>(M1) * ctr.z;
+
+                    ctr = {static_cast<uint32_t>(prod1 >> 32u) ^ ctr.y ^ key0,
+                           static_cast<uint32_t>(prod1),
+                           static_cast<uint32_t>(prod0 >> 32u) ^ ctr.w ^ key1,
+                           static_cast<uint32_t>(prod0)};
+
+                    key0 += W0;
+                    key1 += W1;
+                }
+                return ctr;
+            }
+
+            ROCWMMA_HOST_DEVICE static inline uint4_t generate(uint64_t seed, uint64_t counter)
+            {
+                return generate(seed,
+                                uint4_t{static_cast<uint32_t>(counter),
+                                        static_cast<uint32_t>(counter >> 32u),
+                                        0u,
+                                        0u});
+            }
+        };
+
+    } // namespace detail
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_PHILOX_HPP
@@ -0,0 +1,193 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_PREFETCH_HPP
+#define ROCWMMA_PREFETCH_HPP
+
+#include "async_load.hpp"
+#include "constants.hpp"
+#include "layout.hpp"
+#include "mapping_util.hpp"
+#include "types.hpp"
+#include "utils.hpp"
+
+// Compiler support for scalar data prefetch
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_amdgcn_s_prefetch_data)
+#define ROCWMMA_PREFETCH_DATA_BUILTIN 1
+#endif
+#endif
+
+#if !defined(ROCWMMA_PREFETCH_DATA_BUILTIN)
+#define ROCWMMA_PREFETCH_DATA_BUILTIN 0
+#endif
+
+// gfx12 prefetches each contiguous line of the block with s_prefetch_data.
+#if ROCWMMA_PREFETCH_DATA_BUILTIN && ROCWMMA_ARCH_GFX12
+#define ROCWMMA_PREFETCH_SCALAR 1
+#else
+#define ROCWMMA_PREFETCH_SCALAR 0
+#endif
+
+// gfx94x prefetches with direct global to LDS loads, whose destination is
+// a discarded LDS sink rather than VGPRs.
+#if ROCWMMA_ASYNC_LOAD_LDS_DIRECT && !ROCWMMA_PREFETCH_SCALAR
+#define ROCWMMA_PREFETCH_LDS_DMA 1
+#else
+#define ROCWMMA_PREFETCH_LDS_DMA 0
+#endif
+
+namespace rocwmma
+{
+
+    namespace detail
+    {
+        // Prefetches bytes from a wave-uniform address into the cache hierarchy
+        struct amdgcn_s_prefetch_data
+        {
+            ROCWMMA_DEVICE static inline void exec(void const* addr, uint32_t bytes)
+            {
+#if ROCWMMA_PREFETCH_SCALAR
+                __builtin_amdgcn_s_prefetch_data(addr, bytes);
+#endif // ROCWMMA_PREFETCH_SCALAR
+            }
+        };
+
+        // Fetches the cache line of each lane address with a one byte global to LDS load.
+        // The data lands in a workgroup-shared sink of one dword per lane and is never read,
+        // such that no VGPR is written and the load is not eliminated by the compiler.
+        struct amdgcn_prefetch_lds_dma
+        {
+            ROCWMMA_DEVICE static inline void* sink()
+            {
+                __shared__ uint32_t sink[Constants::AMDGCN_WAVE_SIZE_64];
+                return sink;
+            }
+
+            ROCWMMA_DEVICE static inline void exec(void const* addr)
+            {
+#if ROCWMMA_PREFETCH_LDS_DMA
+                using GlobalPtrT = __attribute__((address_space(1))) void*;
+                using LocalPtrT  = __attribute__((address_space(3))) void*;
+
+                __builtin_amdgcn_global_load_lds((GlobalPtrT)(const_cast<void*>(addr)),
+                                                 (LocalPtrT)(sink()),
+                                                 1, // Bytes
+                                                 0, // Instruction offset
+                                                 0); // Aux / cache policy
+#endif // ROCWMMA_PREFETCH_LDS_DMA
+            }
+        };
+
+    } // namespace detail
+
+    /*! \struct Prefetch
+    *  \brief Warms the cache lines of a 2D block ahead of its load, without holding
+    *         the data in registers.
+    *
+    *  The block is a set of contiguous lines in memory (rows for row_major, columns for
+    *  col_major), located through a functor such that strided and paged blocks share the
+    *  same path. lineAddr(i) returns the address of line i, or nullptr if the line is
+    *  not to be fetched.
+    *
+    *  On gfx12, each line is prefetched by the scalar unit, such that line addresses
+    *  must be wave-uniform. On gfx94x, each lane touches one cache line with an LDS DMA
+    *  load, covering every cache line of each line at any alignment. The loads count
+    *  against vmcnt, such that waits on later loads also cover them. Other targets
+    *  do not prefetch.
+    *
+    * @tparam BlockHeight Height of the block
+    * @tparam BlockWidth Width of the block
+    * @tparam DataT Data type
+    * @tparam DataLayoutT In-memory layout of the block as row_major or col_major
+    */
+    template <uint32_t BlockHeight, uint32_t BlockWidth, typename DataT, typename DataLayoutT>
+    struct Prefetch
+    {
+        struct Traits
+        {
+            enum : uint32_t
+            {
+                // Contiguous line geometry in memory
+                LineLength = is_same<DataLayoutT, row_major>::value ? BlockWidth : BlockHeight,
+                LineCount  = is_same<DataLayoutT, row_major>::value ? BlockHeight : BlockWidth,
+                LineBytes  = LineLength * (uint32_t)sizeof(DataT),
+
+                // Cache lines touched per line, including the one straddled by an unaligned end
+                CacheLineBytes = Constants::AMDGCN_CACHE_LINE_SIZE_BYTES,
+                LineTouches    = ceilDiv(LineBytes, CacheLineBytes) + 1u,
+
+                // Wave IO geometry
+                TouchCount = LineTouches * LineCount,
+                IssueCount = ceilDiv(TouchCount, (uint32_t)Constants::AMDGCN_WAVE_SIZE),
+            };
+        };
+
+        static_assert(!is_same<DataLayoutT, void>::value, "Must provide a data layout");
+
+        template <typename LineAddrOp>
+        ROCWMMA_DEVICE static inline void exec(LineAddrOp&& lineAddr)
+        {
+#if ROCWMMA_PREFETCH_SCALAR
+#pragma unroll
+            for(uint32_t i = 0; i < Traits::LineCount; i++)
+            {
+                auto const* line = lineAddr(i);
+                if(line != nullptr)
+                {
+                    detail::amdgcn_s_prefetch_data::exec(line, Traits::LineBytes);
+                }
+            }
+#elif ROCWMMA_PREFETCH_LDS_DMA
+            using Bytes = uint8_t;
+
+            auto const laneId = detail::WaveSpace<>::localLaneId();
+
+#pragma unroll
+            for(uint32_t i = 0; i < Traits::IssueCount; i++)
+            {
+                // Lanes past the last touch repeat it, which is benign
+                auto touch = min(i * Constants::AMDGCN_WAVE_SIZE + laneId,
+                                 (uint32_t)Traits::TouchCount - 1u);
+                auto cacheLine = touch % Traits::LineTouches;
+                auto offset
+                    = min(cacheLine * Traits::CacheLineBytes, (uint32_t)Traits::LineBytes - 1u);
+
+                auto const* line = lineAddr(touch / Traits::LineTouches);
+                if(line != nullptr)
+                {
+                    detail::amdgcn_prefetch_lds_dma::exec(reinterpret_cast<Bytes const*>(line)
+                                                          + offset);
+                }
+            }
+#else
+            (void)lineAddr;
+#endif // ROCWMMA_PREFETCH_SCALAR
+        }
+    };
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_PREFETCH_HPP
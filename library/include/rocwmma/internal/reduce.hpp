@@ -0,0 +1,459 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_REDUCE_HPP
+#define ROCWMMA_REDUCE_HPP
+
+#include "cross_lane_select.hpp"
+#include "dpp.hpp"
+#include "io_config.hpp"
+#include "permute.hpp"
+#include "swizzle.hpp"
+#include "types.hpp"
+#include "vector.hpp"
+
+namespace rocwmma
+{
+    namespace reduce
+    {
+        struct Sum
+        {
+            template <typename T>
+            ROCWMMA_HOST_DEVICE static inline T exec(T const& lhs, T const& rhs)
+            {
+                return lhs + rhs;
+            }
+        };
+
+        struct Max
+        {
+            template <typename T>
+            ROCWMMA_HOST_DEVICE static inline T exec(T const& lhs, T const& rhs)
+            {
+                return lhs > rhs ? lhs : rhs;
+            }
+        };
+
+        struct Min
+        {
+            template <typename T>
+            ROCWMMA_HOST_DEVICE static inline T exec(T const& lhs, T const& rhs)
+            {
+                return lhs < rhs ? lhs : rhs;
+            }
+        };
+
+    } // namespace reduce
+
+    namespace detail
+    {
+        // Butterfly partner exchange for each power of 2 lane stride.
+        // Lanes combine with the partner (laneId ^ Stride), such that after
+        // log2(N) steps every lane in the group of N holds the full result.
+        template <uint32_t Stride>
+        struct ButterflyExchange;
+
+        template <>
+        struct ButterflyExchange<1u>
+        {
+            template <typename InputT>
+            ROCWMMA_DEVICE static inline auto exec(InputT const& v)
+            {
+                return CrossLane::Swap2::exec(v);
+            }
+        };
+
+        template <>
+        struct ButterflyExchange<2u>
+        {
+            template <typename InputT>
+            ROCWMMA_DEVICE static inline auto exec(InputT const& v)
+            {
+                return CrossLane::Shuffle4<2u, 3u, 0u, 1u>::exec(v);
+            }
+        };
+
+        template <>
+        struct ButterflyExchange<4u>
+        {
+            template <typename InputT>
+            ROCWMMA_DEVICE static inline auto exec(InputT const& v)
+            {
+                return Swizzle::Swap4::exec(v);
+            }
+        };
+
+        template <>
+        struct ButterflyExchange<8u>
+        {
+            template <typename InputT>
+            ROCWMMA_DEVICE static inline auto exec(InputT const& v)
+            {
+                return Swizzle::Swap8::exec(v);
+            }
+        };
+
+        template <>
+        struct ButterflyExchange<16u>
+        {
+            template <typename InputT>
+            ROCWMMA_DEVICE static inline auto exec(InputT const& v)
+            {
+                return Swizzle::Swap16::exec(v);
+            }
+        };
+
+        // Wave64 only
+        template <>
+        struct ButterflyExchange<32u>
+        {
+            template <typename InputT>
+            ROCWMMA_DEVICE static inline auto exec(InputT const& v)
+            {
+                return Permute::RotateWaveL<32u>::exec(v);
+            }
+        };
+
+        // Once every group of Stride lanes holds a uniform value, any partner in
+        // the neighbouring group is as good as (laneId ^ Stride). This allows the
+        // reversals, which dpp also implements, to replace swizzles for strides 4 and 8.
+        template <uint32_t Stride>
+        struct UniformExchange : public ButterflyExchange<Stride>
+        {
+        };
+
+        template <>
+        struct UniformExchange<4u>
+        {
+            template <typename InputT>
+            ROCWMMA_DEVICE static inline auto exec(InputT const& v)
+            {
+                return CrossLane::Reverse8::exec(v);
+            }
+        };
+
+        template <>
+        struct UniformExchange<8u>
+        {
+            template <typename InputT>
+            ROCWMMA_DEVICE static inline auto exec(InputT const& v)
+            {
+                return CrossLane::Reverse16::exec(v);
+            }
+        };
+
+        // Reduces each vector element across lanes with the same (laneId % StrideBegin),
+        // in groups of StrideEnd lanes. All lanes in the group receive the result.
+        template <typename ReduceOpT,
+                  uint32_t StrideBegin,
+                  uint32_t StrideEnd,
+                  bool     IsUniform = (StrideBegin == 1u)>
+        struct CrossLaneReduce
+        {
+            template <typename DataT, uint32_t VecSize>
+            ROCWMMA_DEVICE static inline auto exec(VecT<DataT, VecSize> const& v)
+            {
+                if constexpr(StrideBegin >= StrideEnd)
+                {
+                    return v;
+                }
+                else
+                {
+                    using Exchange = conditional_t<IsUniform,
+                                                   UniformExchange<StrideBegin>,
+                                                   ButterflyExchange<StrideBegin>>;
+
+                    auto partner = Exchange::exec(v);
+                    auto result  = VecT<DataT, VecSize>{};
+#pragma unroll
+                    for(uint32_t i = 0; i < VecSize; i++)
+                    {
+                        result.data[i] = ReduceOpT::exec(v.data[i], partner.data[i]);
+                    }
+                    return CrossLaneReduce<ReduceOpT, StrideBegin * 2u, StrideEnd, IsUniform>::
+                        exec(result);
+                }
+            }
+        };
+
+        template <typename FragT>
+        struct ReduceFragment;
+
+        template <uint32_t BlockM,
+                  uint32_t BlockN,
+                  uint32_t BlockK,
+                  typename DataT,
+                  typename DataLayoutT>
+        struct ReduceFragment<fragment<accumulator, BlockM, BlockN, BlockK, DataT, DataLayoutT>>
+        {
+        private:
+            using FragT = fragment<accumulator, BlockM, BlockN, BlockK, DataT, DataLayoutT>;
+
+            // Accumulators use the RowNT layout profile, for which the register layout
+            // is the same for both data layouts. Assume row_major to query the geometry.
+            using IOLayout =
+                typename IOConfig<accumulator, BlockM, BlockN, BlockK, DataT, row_major>::IOLayout;
+            using LayoutTraits =
+                typename IOLayout::MatrixLayout::Traits::OrthoLayout::Traits;
+
+            // Per-lane register elements are ordered by:
+            // 1. MaxVW consecutive rows (VWSegs)
+            // 2. Row strides over the remaining lanes (BlockKSegs)
+            // 3. Column strides over the wave (BlockDimSegs)
+            // E.g. element (colSeg * RowElements + rowElem) is at matrix coordinate:
+            // (baseRow + rowOffset(rowElem), laneId % LaneCols + colSeg * LaneCols)
+            enum : uint32_t
+            {
+                WaveSize    = LayoutTraits::WaveSize,
+                LaneCols    = LayoutTraits::BlockDimStride_X,
+                ColSegs     = LayoutTraits::BlockDimSegs,
+                RowElements = LayoutTraits::VWSegs * LayoutTraits::BlockKSegs,
+            };
+
+            static_assert(FragT::num_elements == ColSegs * RowElements,
+                          "Unexpected accumulator register geometry");
+
+            // Cross-lane ops move b32 elements. Reduce smaller types in float32_t.
+            using ReduceT = conditional_t<(sizeof(DataT) < sizeof(uint32_t)), float32_t, DataT>;
+
+        public:
+            // Each row is spread over LaneCols neighbouring lanes and ColSegs registers.
+            template <typename ReduceOpT>
+            ROCWMMA_DEVICE static inline FragT rows(FragT const& frag)
+            {
+                auto partial = VecT<ReduceT, RowElements>{};
+
+#pragma unroll
+                for(uint32_t r = 0; r < RowElements; r++)
+                {
+                    partial.data[r] = static_cast<ReduceT>(frag.x[r]);
+                }
+
+#pragma unroll
+                for(uint32_t c = 1; c < ColSegs; c++)
+                {
+#pragma unroll
+                    for(uint32_t r = 0; r < RowElements; r++)
+                    {
+                        partial.data[r] = ReduceOpT::exec(
+                            partial.data[r], static_cast<ReduceT>(frag.x[c * RowElements + r]));
+                    }
+                }
+
+                partial = CrossLaneReduce<ReduceOpT, 1u, LaneCols>::exec(partial);
+
+                auto result = FragT{};
+#pragma unroll
+                for(uint32_t c = 0; c < ColSegs; c++)
+                {
+#pragma unroll
+                    for(uint32_t r = 0; r < RowElements; r++)
+                    {
+                        result.x[c * RowElements + r] = static_cast<DataT>(partial.data[r]);
+                    }
+                }
+                return result;
+            }
+
+            // Each column is spread over RowElements registers, in lanes LaneCols apart.
+            template <typename ReduceOpT>
+            ROCWMMA_DEVICE static inline FragT cols(FragT const& frag)
+            {
+                auto partial = VecT<ReduceT, ColSegs>{};
+
+#pragma unroll
+                for(uint32_t c = 0; c < ColSegs; c++)
+                {
+                    partial.data[c] = static_cast<ReduceT>(frag.x[c * RowElements]);
+#pragma unroll
+                    for(uint32_t r = 1; r < RowElements; r++)
+                    {
+                        partial.data[c] = ReduceOpT::exec(
+                            partial.data[c], static_cast<ReduceT>(frag.x[c * RowElements + r]));
+                    }
+                }
+
+                partial = CrossLaneReduce<ReduceOpT, LaneCols, WaveSize>::exec(partial);
+
+                auto result = FragT{};
+#pragma unroll
+                for(uint32_t c = 0; c < ColSegs; c++)
+                {
+#pragma unroll
+                    for(uint32_t r = 0; r < RowElements; r++)
+                    {
+                        result.x[c * RowElements + r] = static_cast<DataT>(partial.data[c]);
+                    }
+                }
+                return result;
+            }
+
+            // Matrix column of register element i of the calling lane
+            ROCWMMA_DEVICE static inline uint32_t col(uint32_t i)
+            {
+                return laneId() % LaneCols + (i / RowElements) * LaneCols;
+            }
+
+            // Row max and sum are kept co-indexed with the block, such that the update is
+            // element-wise after the row reductions.
+            ROCWMMA_DEVICE static inline FragT
+                softmaxOnline(FragT& frag, FragT& fragMax, FragT& fragSum, float32_t scale)
+            {
+                auto expT = [](ReduceT x) {
+                    if constexpr(is_same_v<ReduceT, float64_t>)
+                    {
+                        return ::exp(x);
+                    }
+                    else
+                    {
+                        return static_cast<ReduceT>(__expf(static_cast<float32_t>(x)));
+                    }
+                };
+
+                auto scaled = FragT{};
+#pragma unroll
+                for(uint32_t i = 0; i < FragT::num_elements; i++)
+                {
+                    scaled.x[i] = static_cast<DataT>(static_cast<ReduceT>(frag.x[i])
+                                                     * static_cast<ReduceT>(scale));
+                }
+                auto blockMax = rows<reduce::Max>(scaled);
+
+                // Running max and the correction of previous blocks
+                auto correction = FragT{};
+#pragma unroll
+                for(uint32_t i = 0; i < FragT::num_elements; i++)
+                {
+                    auto oldMax = static_cast<ReduceT>(fragMax.x[i]);
+                    auto newMax = reduce::Max::exec(oldMax, static_cast<ReduceT>(blockMax.x[i]));
+                    correction.x[i] = static_cast<DataT>(expT(oldMax - newMax));
+                    fragMax.x[i]    = static_cast<DataT>(newMax);
+                }
+
+                // Un-normalized probabilities and their row sum
+#pragma unroll
+                for(uint32_t i = 0; i < FragT::num_elements; i++)
+                {
+                    frag.x[i] = static_cast<DataT>(expT(static_cast<ReduceT>(scaled.x[i])
+                                                        - static_cast<ReduceT>(fragMax.x[i])));
+                }
+                auto blockSum = rows<reduce::Sum>(frag);
+
+#pragma unroll
+                for(uint32_t i = 0; i < FragT::num_elements; i++)
+                {
+                    fragSum.x[i] = static_cast<DataT>(
+                        static_cast<ReduceT>(fragSum.x[i]) * static_cast<ReduceT>(correction.x[i])
+                        + static_cast<ReduceT>(blockSum.x[i]));
+                }
+
+                return correction;
+            }
+
+            // Selects up to K candidates per row from the block, one per iteration: the row
+            // max and its lowest column are found with two row reductions, then inserted
+            // into the sorted list of each row. Lists are kept co-indexed with the block.
+            // Iterations stop as soon as no row max of the wave enters its list, which
+            // is the common case once the lists have filled up.
+            template <uint32_t K, typename FragIdxT>
+            ROCWMMA_DEVICE static inline void
+                topk(FragT const& frag, uint32_t colOffset, FragT (&vals)[K], FragIdxT (&idx)[K])
+            {
+                using IndexT = typename FragIdxT::element_type;
+
+                static_assert(is_same_v<IndexT, int32_t>, "Indices must be int32_t");
+                static_assert(FragIdxT::num_elements == FragT::num_elements,
+                              "Index fragment must be co-indexed with the value fragment");
+
+                auto const lowest = static_cast<DataT>(numeric_limits<ReduceT>::lowest());
+                auto       work   = frag;
+
+#pragma unroll
+                for(uint32_t iter = 0; iter < K; iter++)
+                {
+                    auto rowMax = rows<reduce::Max>(work);
+
+                    int enters = 0;
+#pragma unroll
+                    for(uint32_t i = 0; i < FragT::num_elements; i++)
+                    {
+                        enters |= static_cast<ReduceT>(rowMax.x[i])
+                                  > static_cast<ReduceT>(vals[K - 1u].x[i]);
+                    }
+
+                    // Wave-uniform exit
+                    if(!__any(enters))
+                    {
+                        break;
+                    }
+
+                    // Lowest column holding the row max
+                    auto cols = FragIdxT{};
+#pragma unroll
+                    for(uint32_t i = 0; i < FragT::num_elements; i++)
+                    {
+                        cols.x[i] = static_cast<ReduceT>(work.x[i])
+                                            == static_cast<ReduceT>(rowMax.x[i])
+                                        ? static_cast<IndexT>(colOffset + col(i))
+                                        : numeric_limits<IndexT>::max();
+                    }
+                    cols = ReduceFragment<FragIdxT>::template rows<reduce::Min>(cols);
+
+                    // Insert, keeping earlier candidates ahead on ties, then retire the
+                    // selected element from the block.
+#pragma unroll
+                    for(uint32_t i = 0; i < FragT::num_elements; i++)
+                    {
+                        auto value = rowMax.x[i];
+                        auto index = cols.x[i];
+
+#pragma unroll
+                        for(uint32_t j = 0; j < K; j++)
+                        {
+                            if(static_cast<ReduceT>(value) > static_cast<ReduceT>(vals[j].x[i]))
+                            {
+                                auto tmpValue = vals[j].x[i];
+                                auto tmpIndex = idx[j].x[i];
+                                vals[j].x[i]  = value;
+                                idx[j].x[i]   = index;
+                                value         = tmpValue;
+                                index         = tmpIndex;
+                            }
+                        }
+
+                        if(static_cast<IndexT>(colOffset + col(i)) == cols.x[i])
+                        {
+                            work.x[i] = lowest;
+                        }
+                    }
+                }
+            }
+        };
+
+    } // namespace detail
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_REDUCE_HPP
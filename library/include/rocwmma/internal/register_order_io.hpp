@@ -0,0 +1,99 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_REGISTER_ORDER_IO_HPP
+#define ROCWMMA_REGISTER_ORDER_IO_HPP
+
+#include "access_policy.hpp"
+#include "mapping_util.hpp"
+
+namespace rocwmma
+{
+
+    namespace detail
+    {
+        // Memory image of the registers of a fragment, in register order. The StorageT of each
+        // lane is split into chunks of up to 16B, interleaved across the lanes of the wave:
+        //
+        //     byte offset of chunk c of lane l = (c * WaveSize + l) * ChunkSize
+        //
+        // Each chunk is then a single access of the widest width over WaveSize * ChunkSize
+        // contiguous bytes: fully coalesced in global memory, and without bank conflicts in LDS.
+        template <typename StorageT,
+                  uint32_t WaveSize      = Constants::AMDGCN_WAVE_SIZE,
+                  typename AccessPolicyT = cache_default>
+        struct RegisterOrderIO
+        {
+            enum : uint32_t
+            {
+                Bytes      = sizeof(StorageT),
+                ChunkSize  = (Bytes % 16u == 0u)  ? 16u
+                             : (Bytes % 8u == 0u) ? 8u
+                             : (Bytes % 4u == 0u) ? 4u
+                             : (Bytes % 2u == 0u) ? 2u
+                                                  : 1u,
+                Chunks     = Bytes / ChunkSize,
+                BlockBytes = Bytes * WaveSize
+            };
+
+            using RawT   = typename cache_policy_raw<ChunkSize>::Type;
+            using Access = amdgcn_access_policy<AccessPolicyT, RawT>;
+
+            ROCWMMA_DEVICE static inline void store(char* block, StorageT const& data)
+            {
+                auto rawPtr = reinterpret_cast<RawT*>(block) + laneId();
+
+#pragma unroll
+                for(uint32_t i = 0; i < Chunks; i++)
+                {
+                    RawT raw;
+                    __builtin_memcpy(&raw,
+                                     reinterpret_cast<char const*>(&data) + i * ChunkSize,
+                                     ChunkSize);
+                    Access::store(rawPtr + i * WaveSize, raw);
+                }
+            }
+
+            ROCWMMA_DEVICE static inline void load(StorageT& data, char const* block)
+            {
+                auto rawPtr = reinterpret_cast<RawT const*>(block) + laneId();
+
+#pragma unroll
+                for(uint32_t i = 0; i < Chunks; i++)
+                {
+                    RawT raw;
+                    Access::load(raw, rawPtr + i * WaveSize);
+                    __builtin_memcpy(reinterpret_cast<char*>(&data) + i * ChunkSize,
+                                     &raw,
+                                     ChunkSize);
+                }
+            }
+        };
+
+    } // namespace detail
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_REGISTER_ORDER_IO_HPP
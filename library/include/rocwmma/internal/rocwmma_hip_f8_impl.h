@@ -43,7 +43,7 @@ namespace rocwmma_hip_f8_impl
         return __clz(x);
     }
 
-    template <int wm, int we, typename T, bool negative_zero_nan, bool clip>
+    template <int wm, int we, typename T, bool negative_zero_nan, bool clip, bool ocp>
     ROCWMMA_HOST_DEVICE uint8_t cast_to_f8(T _x, bool stoch, uint32_t rng)
     {
         constexpr bool is_half  = is_same<T, _Float16>::value;
@@ -85,8 +85,28 @@ namespace rocwmma_hip_f8_impl
 
         uint32_t signed_inf = (sign << 7) + (((1 << we) - 1) << wm);
 
+        // OCP E4M3 (E4M3FN) has no infinity, and S.1111.111 is its only NaN.
+        // The top exponent holds normal values, up to S.1111.110 = 448.
+        // Inf and NaN inputs become NaN, as clipping only applies to finite values.
+        constexpr bool e4m3fn     = ocp && (we == 4);
+        uint32_t       signed_nan = (sign << 7) | 0x7F;
+        uint32_t       signed_max = (sign << 7) | 0x7E;
+
         // Deal with inf and NaNs
-        if(negative_zero_nan)
+        if(e4m3fn)
+        {
+            if(sizeof(T) == 4)
+            {
+                if((x & 0x7F800000) == 0x7F800000)
+                    return signed_nan;
+            }
+            else
+            {
+                if((x & 0x7C00) == 0x7C00)
+                    return signed_nan;
+            }
+        }
+        else if(negative_zero_nan)
         {
             if(sizeof(T) == 4)
             {
@@ -217,10 +237,16 @@ namespace rocwmma_hip_f8_impl
         mantissa >>= (mfmt - wm);
 
         // above range: quantize to maximum possible float of the same sign
-        const int max_exp = (1 << we) - (negative_zero_nan ? 1 : 2);
-        if(f8_exponent > max_exp)
+        const int max_exp = (1 << we) - ((negative_zero_nan || e4m3fn) ? 1 : 2);
+        if(f8_exponent > max_exp
+           || (e4m3fn && f8_exponent == max_exp
+               && (mantissa & ((1 << wm) - 1)) == ((1 << wm) - 1)))
         {
-            if(clip)
+            if(e4m3fn)
+            {
+                return clip ? signed_max : signed_nan;
+            }
+            else if(clip)
             {
                 mantissa    = (1 << wm) - 1;
                 f8_exponent = max_exp;
@@ -240,7 +266,7 @@ namespace rocwmma_hip_f8_impl
         return (sign << 7) | (f8_exponent << wm) | mantissa;
     }
 
-    template <int wm, int we, typename T, bool negative_zero_nan>
+    template <int wm, int we, typename T, bool negative_zero_nan, bool ocp>
     ROCWMMA_HOST_DEVICE T cast_from_f8(uint8_t x)
     {
         constexpr bool is_half  = is_same<T, _Float16>::value;
@@ -295,7 +321,15 @@ namespace rocwmma_hip_f8_impl
             {
                 return fNeg0;
             }
-            if(exponent == ((1 << we) - 1))
+            if(ocp && we == 4)
+            {
+                // OCP E4M3: S.1111.111 is NaN, the rest of the top exponent is normal
+                if((x & 0x7F) == 0x7F)
+                {
+                    return fNaN;
+                }
+            }
+            else if(exponent == ((1 << we) - 1))
             {
                 return (mantissa == 0) ? (sign ? fNegInf : fInf) : fNaN;
             }
@@ -0,0 +1,232 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_SMFMAC_HPP
+#define ROCWMMA_SMFMAC_HPP
+
+#include "types.hpp"
+#include "vector.hpp"
+
+namespace rocwmma
+{
+
+    namespace detail
+    {
+        // Structured sparse (2:4) MFMA. The A operand is compressed to half of its K
+        // extent, with each lane holding an 8-bit index selecting the positions of its
+        // two surviving values within every group of four K elements.
+        template <typename InputT, typename ComputeT, uint32_t BlockM, uint32_t BlockN>
+        struct amdgcn_smfmac
+        {
+            template <typename RegsA, typename RegsB, typename RegsC>
+            ROCWMMA_DEVICE static inline auto
+                exec(RegsA&& regsA, RegsB&& regsB, RegsC& regsC, uint32_t index)
+            {
+                return regsC;
+            }
+        };
+
+#if ROCWMMA_ARCH_GFX940 || ROCWMMA_ARCH_GFX941 || ROCWMMA_ARCH_GFX942
+
+        template <>
+        struct amdgcn_smfmac<float16_t, float32_t, 16, 16>
+        {
+            // Packed register traits
+            struct Traits
+            {
+                enum : uint32_t
+                {
+                    KPerSmfmac = 32
+                };
+                using ARegsT = VRegF32x2;
+                using BRegsT = VRegF32x4;
+                using CRegsT = AccRegF32x4;
+                using DRegsT = AccRegF32x4;
+            };
+
+            ROCWMMA_DEVICE static inline auto exec(typename Traits::ARegsT const& regsA,
+                                                   typename Traits::BRegsT const& regsB,
+                                                   typename Traits::CRegsT const& regsC,
+                                                   uint32_t                       index) ->
+                typename Traits::DRegsT
+            {
+                typename Traits::DRegsT result;
+                result.data = {__builtin_amdgcn_smfmac_f32_16x16x32_f16(
+                    regsA.data, regsB.data, regsC.data, index, 0, 0)};
+                return result;
+            }
+        };
+
+        template <>
+        struct amdgcn_smfmac<float16_t, float32_t, 32, 32>
+        {
+            // Packed register traits
+            struct Traits
+            {
+                enum : uint32_t
+                {
+                    KPerSmfmac = 16
+                };
+                using ARegsT = VRegF32x2;
+                using BRegsT = VRegF32x4;
+                using CRegsT = AccRegF32x16;
+                using DRegsT = AccRegF32x16;
+            };
+
+            ROCWMMA_DEVICE static inline auto exec(typename Traits::ARegsT const& regsA,
+                                                   typename Traits::BRegsT const& regsB,
+                                                   typename Traits::CRegsT const& regsC,
+                                                   uint32_t                       index) ->
+                typename Traits::DRegsT
+            {
+                typename Traits::DRegsT result;
+                result.data = {__builtin_amdgcn_smfmac_f32_32x32x16_f16(
+                    regsA.data, regsB.data, regsC.data, index, 0, 0)};
+                return result;
+            }
+        };
+
+        template <>
+        struct amdgcn_smfmac<bfloat16_t, float32_t, 16, 16>
+        {
+            // Packed register traits
+            struct Traits
+            {
+                enum : uint32_t
+                {
+                    KPerSmfmac = 32
+                };
+                using ARegsT = VRegF32x2;
+                using BRegsT = VRegF32x4;
+                using CRegsT = AccRegF32x4;
+                using DRegsT = AccRegF32x4;
+            };
+
+            ROCWMMA_DEVICE static inline auto exec(typename Traits::ARegsT const& regsA,
+                                                   typename Traits::BRegsT const& regsB,
+                                                   typename Traits::CRegsT const& regsC,
+                                                   uint32_t                       index) ->
+                typename Traits::DRegsT
+            {
+                typename Traits::DRegsT result;
+                result.data = {__builtin_amdgcn_smfmac_f32_16x16x32_bf16(
+                    regsA.data, regsB.data, regsC.data, index, 0, 0)};
+                return result;
+            }
+        };
+
+        template <>
+        struct amdgcn_smfmac<bfloat16_t, float32_t, 32, 32>
+        {
+            // Packed register traits
+            struct Traits
+            {
+                enum : uint32_t
+                {
+                    KPerSmfmac = 16
+                };
+                using ARegsT = VRegF32x2;
+                using BRegsT = VRegF32x4;
+                using CRegsT = AccRegF32x16;
+                using DRegsT = AccRegF32x16;
+            };
+
+            ROCWMMA_DEVICE static inline auto exec(typename Traits::ARegsT const& regsA,
+                                                   typename Traits::BRegsT const& regsB,
+                                                   typename Traits::CRegsT const& regsC,
+                                                   uint32_t                       index) ->
+                typename Traits::DRegsT
+            {
+                typename Traits::DRegsT result;
+                result.data = {__builtin_amdgcn_smfmac_f32_32x32x16_bf16(
+                    regsA.data, regsB.data, regsC.data, index, 0, 0)};
+                return result;
+            }
+        };
+
+#else // (!ROCWMMA_ARCH_GFX940) && (!ROCWMMA_ARCH_GFX941) && (!ROCWMMA_ARCH_GFX942)
+
+        // Required for general sparse support
+        template <typename InputT, uint32_t BlockDim>
+        struct amdgcn_smfmac_unsupported
+        {
+            // Packed register traits
+            struct Traits
+            {
+                enum : uint32_t
+                {
+                    KPerSmfmac = (BlockDim == 16u ? 32u : 16u)
+                };
+                using ARegsT = VRegF32x2;
+                using BRegsT = VRegF32x4;
+                using CRegsT = VecT<float32_t, BlockDim * BlockDim / 64u>;
+                using DRegsT = VecT<float32_t, BlockDim * BlockDim / 64u>;
+            };
+
+            // This implementation is needed to satisfy the sparse mma_sync interface,
+            // and WILL not function as intended.
+            // Only gfx940, gfx941 and gfx942 support smfmac instructions.
+            ROCWMMA_UNSUPPORTED_IMPL("smfmac only supported on gfx940/gfx941/gfx942")
+            ROCWMMA_DEVICE static inline auto exec(typename Traits::ARegsT const& regsA,
+                                                   typename Traits::BRegsT const& regsB,
+                                                   typename Traits::CRegsT const& regsC,
+                                                   uint32_t                       index)
+                -> typename Traits::DRegsT const&
+            {
+                return regsC;
+            }
+        };
+
+        template <>
+        struct amdgcn_smfmac<float16_t, float32_t, 16, 16>
+            : public amdgcn_smfmac_unsupported<float16_t, 16>
+        {
+        };
+
+        template <>
+        struct amdgcn_smfmac<float16_t, float32_t, 32, 32>
+            : public amdgcn_smfmac_unsupported<float16_t, 32>
+        {
+        };
+
+        template <>
+        struct amdgcn_smfmac<bfloat16_t, float32_t, 16, 16>
+            : public amdgcn_smfmac_unsupported<bfloat16_t, 16>
+        {
+        };
+
+        template <>
+        struct amdgcn_smfmac<bfloat16_t, float32_t, 32, 32>
+            : public amdgcn_smfmac_unsupported<bfloat16_t, 32>
+        {
+        };
+
+#endif // ROCWMMA_ARCH_GFX940 || ROCWMMA_ARCH_GFX941 || ROCWMMA_ARCH_GFX942
+
+    } // namespace detail
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_SMFMAC_HPP
@@ -0,0 +1,74 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_SOA_LOAD_HPP
+#define ROCWMMA_SOA_LOAD_HPP
+
+#include "opaque_load.hpp"
+#include "transforms.hpp"
+#include "types.hpp"
+
+namespace rocwmma
+{
+
+    // Loads a block into the SOA register layout of the mma through wide IO vectors.
+    // Vectors of VectorWidth run along BlockDim in AOS order (MatrixLayout is ColInlineVW
+    // or RowInlineVW), and each IO is then moved to SOA order in registers. This replaces
+    // VectorWidth 1 loads in mma operand order, with VectorWidth times fewer loads.
+    template <uint32_t BlockDim,
+              uint32_t BlockK,
+              typename DataT,
+              class DataLayout,
+              class MatrixLayout,
+              uint32_t VectorWidth,
+              class AccessPolicy = cache_default>
+    struct SoaLoad
+    {
+        using AosLoader = OpaqueLoad<BlockDim,
+                                     BlockK,
+                                     DataT,
+                                     DataLayout,
+                                     MatrixLayout,
+                                     VectorWidth,
+                                     AccessPolicy>;
+
+        struct Traits
+        {
+            using LoadT   = typename AosLoader::Traits::LoadT;
+            using OutputT = typename AosLoader::Traits::OutputT;
+        };
+
+        ROCWMMA_DEVICE static inline void
+            exec(typename Traits::OutputT& data, DataT const* dataPtr, uint32_t ldm)
+        {
+            typename Traits::OutputT aos;
+            AosLoader::exec(aos, dataPtr, ldm);
+            data = Transforms::AosToSoa<BlockDim, VectorWidth>::exec(aos);
+        }
+    };
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_SOA_LOAD_HPP
@@ -0,0 +1,184 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_TENSOR_LOAD_HPP
+#define ROCWMMA_TENSOR_LOAD_HPP
+
+#include "io_traits.hpp"
+#include "layout.hpp"
+#include "mapping_util.hpp"
+#include "tuple.hpp"
+#include "types.hpp"
+#include "vector_iterator.hpp"
+
+namespace rocwmma
+{
+
+    namespace detail
+    {
+
+        // Loads VectorWidth elements at matrix coordinate (row, col) of the matrix view
+        // of a strided tensor. The row and col indices are folded over their tensor modes,
+        // such that element (row, col) may be anywhere in the tensor.
+        // Vector elements are consecutive in the minor dimension of the data layout. If the
+        // fastest minor mode is contiguous, each vector lies within it and is loaded whole,
+        // otherwise element-wise. Elements beyond the view are not read and are zero-filled.
+        template <typename DataT, class DataLayout, uint32_t VectorWidth>
+        struct amdgcn_tensor_load
+        {
+            static_assert(VectorWidth > 0, "Vector width must be greater than 0");
+            static_assert(sizeof(DataT[VectorWidth]) == sizeof(VecT<DataT, VectorWidth>),
+                          "Cannot vectorize input");
+
+            using LoadT = VecT<DataT, VectorWidth>;
+
+            template <typename TensorViewT>
+            ROCWMMA_DEVICE static inline void
+                exec(LoadT& data, DataT const* dataPtr, TensorViewT const& view, Coord2d coord)
+            {
+                auto const& majorModes = (DataLayout::MajorIndex == 0) ? view.rows : view.cols;
+                auto const& minorModes = (DataLayout::MinorIndex == 0) ? view.rows : view.cols;
+
+                auto major = get<DataLayout::MajorIndex>(coord);
+                auto minor = get<DataLayout::MinorIndex>(coord);
+
+                auto majorOffset = TensorSpace::fromModeIndex(major, majorModes);
+
+                if(major < majorModes.size && minor + VectorWidth <= minorModes.size
+                   && TensorSpace::isContiguous<VectorWidth>(minorModes))
+                {
+                    data = *reinterpret_cast<LoadT const*>(
+                        dataPtr + majorOffset + TensorSpace::fromModeIndex(minor, minorModes));
+                }
+                else
+                {
+#pragma unroll
+                    for(uint32_t i = 0; i < VectorWidth; i++)
+                    {
+                        data.data[i]
+                            = (major < majorModes.size && minor + i < minorModes.size)
+                                  ? dataPtr[majorOffset
+                                            + TensorSpace::fromModeIndex(minor + i, minorModes)]
+                                  : static_cast<DataT>(0);
+                    }
+                }
+            }
+        };
+
+    } // namespace detail
+
+    // Loads with the same matrix layout as OpaqueLoad, however each vector is
+    // addressed through the matrix view of a strided tensor, such that the
+    // permuted tensor is never materialized. The matrix coordinate of each
+    // vector is tracked in place of a data pointer.
+    template <uint32_t BlockDim,
+              uint32_t BlockK,
+              typename DataT,
+              class DataLayout,
+              class MatrixLayout,
+              uint32_t VectorWidth>
+    struct TensorLoad
+    {
+        using IOTraits = IOTraits<BlockDim, BlockK, DataT, VectorWidth>;
+
+        struct Traits
+        {
+            // Raw IO on unpacked register data.
+            using Loader  = detail::amdgcn_tensor_load<DataT, DataLayout, VectorWidth>;
+            using LoadT   = typename Loader::LoadT;
+            using OutputT = VecT<DataT, IOTraits::UnpackedSize>;
+        };
+
+        using LoadVecTraits = VecTraits<typename Traits::LoadT>;
+
+        // Outer loop = index 0,
+        // Inner loop = index N-1
+        template <size_t Depth = 0,
+                  typename Iterator,
+                  typename TensorViewT,
+                  typename StrideCounts,
+                  typename Strides2d>
+        ROCWMMA_DEVICE static inline auto unroll_right(Iterator&          out,
+                                                       DataT const*       dataPtr,
+                                                       TensorViewT const& view,
+                                                       Coord2d            coord,
+                                                       StrideCounts&&     strideCounts,
+                                                       Strides2d&&        strides2d)
+        {
+            auto stride2d    = get<Depth>(strides2d);
+            auto strideCount = get<Depth>(strideCounts);
+
+            // Last depth layer will invoke the load
+            if constexpr(Depth == (VecTraits<decay_t<StrideCounts>>::size() - 1u))
+            {
+#pragma unroll
+                for(int i = 0; i < strideCount; i++)
+                {
+                    Traits::Loader::exec(*out, dataPtr, view, coord);
+                    coord += stride2d;
+                    out++;
+                }
+            }
+            // Recurse to the next nested layer
+            else
+            {
+#pragma unroll
+                for(int i = 0; i < strideCount; i++)
+                {
+                    unroll_right<Depth + 1>(out, dataPtr, view, coord, strideCounts, strides2d);
+                    coord += stride2d;
+                }
+            }
+        }
+
+        template <typename TensorViewT>
+        ROCWMMA_DEVICE static void exec(typename Traits::OutputT& data,
+                                        DataT const*              dataPtr,
+                                        TensorViewT const&        view,
+                                        Coord2d                   origin)
+        {
+            // Arrange wave threads to starting matrix layout offsets.
+            auto baseOffset2d = MatrixLayout::baseOffset();
+            auto it           = makeVectorIterator<LoadVecTraits::size()>(data).begin();
+
+            static_assert(decltype(it)::range() == IOTraits::IOCount,
+                          "IOCount inconsistent with iterator range");
+
+            // Make sure that the IOCount is consistent with the number of total strides
+            static_assert(IOTraits::IOCount
+                              == apply([](auto... items) { return (items * ...); },
+                                       MatrixLayout::strideCounts()),
+                          "IOCount inconsistent with total strides");
+
+            // Unroll loading in each strided dimension
+            origin += baseOffset2d;
+            unroll_right(
+                it, dataPtr, view, origin, MatrixLayout::strideCounts(), MatrixLayout::strides());
+        }
+    };
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_TENSOR_LOAD_HPP
@@ -0,0 +1,186 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_TENSOR_STORE_HPP
+#define ROCWMMA_TENSOR_STORE_HPP
+
+#include "io_traits.hpp"
+#include "layout.hpp"
+#include "mapping_util.hpp"
+#include "tuple.hpp"
+#include "types.hpp"
+#include "vector_iterator.hpp"
+
+namespace rocwmma
+{
+
+    namespace detail
+    {
+
+        // Stores VectorWidth elements at matrix coordinate (row, col) of the matrix view
+        // of a strided tensor. The row and col indices are folded over their tensor modes,
+        // such that element (row, col) may be anywhere in the tensor.
+        // Vector elements are consecutive in the minor dimension of the data layout. If the
+        // fastest minor mode is contiguous, each vector lies within it and is stored whole,
+        // otherwise element-wise. Elements beyond the view are not written.
+        template <typename DataT, class DataLayout, uint32_t VectorWidth>
+        struct amdgcn_tensor_store
+        {
+            static_assert(VectorWidth > 0, "Vector width must be greater than 0");
+            static_assert(sizeof(DataT[VectorWidth]) == sizeof(VecT<DataT, VectorWidth>),
+                          "Cannot vectorize output");
+
+            using StoreT = VecT<DataT, VectorWidth>;
+
+            template <typename TensorViewT>
+            ROCWMMA_DEVICE static inline void
+                exec(DataT* dataPtr, StoreT const& data, TensorViewT const& view, Coord2d coord)
+            {
+                auto const& majorModes = (DataLayout::MajorIndex == 0) ? view.rows : view.cols;
+                auto const& minorModes = (DataLayout::MinorIndex == 0) ? view.rows : view.cols;
+
+                auto major = get<DataLayout::MajorIndex>(coord);
+                auto minor = get<DataLayout::MinorIndex>(coord);
+
+                if(major >= majorModes.size)
+                {
+                    return;
+                }
+
+                auto majorOffset = TensorSpace::fromModeIndex(major, majorModes);
+
+                if(minor + VectorWidth <= minorModes.size
+                   && TensorSpace::isContiguous<VectorWidth>(minorModes))
+                {
+                    *reinterpret_cast<StoreT*>(
+                        dataPtr + majorOffset + TensorSpace::fromModeIndex(minor, minorModes))
+                        = data;
+                }
+                else
+                {
+#pragma unroll
+                    for(uint32_t i = 0; i < VectorWidth; i++)
+                    {
+                        if(minor + i < minorModes.size)
+                        {
+                            dataPtr[majorOffset + TensorSpace::fromModeIndex(minor + i, minorModes)]
+                                = data.data[i];
+                        }
+                    }
+                }
+            }
+        };
+
+    } // namespace detail
+
+    // Stores with the same matrix layout as OpaqueStore, however each vector is
+    // addressed through the matrix view of a strided tensor, such that no
+    // permute pass is required afterwards. The matrix coordinate of each vector
+    // is tracked in place of a data pointer.
+    template <uint32_t BlockDim,
+              uint32_t BlockK,
+              typename DataT,
+              class DataLayout,
+              class MatrixLayout,
+              uint32_t VectorWidth>
+    struct TensorStore
+    {
+        using IOTraits = IOTraits<BlockDim, BlockK, DataT, VectorWidth>;
+        struct Traits
+        {
+            // Raw IO on unpacked register data.
+            using Storer = detail::amdgcn_tensor_store<DataT, DataLayout, VectorWidth>;
+            using StoreT = typename Storer::StoreT;
+            using InputT = VecT<DataT, IOTraits::UnpackedSize>;
+        };
+
+        using StoreVecTraits = VecTraits<typename Traits::StoreT>;
+
+        template <size_t Depth = 0,
+                  typename Iterator,
+                  typename TensorViewT,
+                  typename StrideCounts,
+                  typename Strides2d>
+        ROCWMMA_DEVICE static inline auto unroll_right(DataT*             dataPtr,
+                                                       Iterator&          in,
+                                                       TensorViewT const& view,
+                                                       Coord2d            coord,
+                                                       StrideCounts&&     strideCounts,
+                                                       Strides2d&&        strides2d)
+        {
+            auto stride2d    = get<Depth>(strides2d);
+            auto strideCount = get<Depth>(strideCounts);
+
+            // Last depth layer will invoke the store
+            if constexpr(Depth == (VecTraits<decay_t<StrideCounts>>::size() - 1u))
+            {
+#pragma unroll
+                for(int i = 0; i < strideCount; i++)
+                {
+                    Traits::Storer::exec(dataPtr, *in, view, coord);
+                    coord += stride2d;
+                    in++;
+                }
+            }
+            // Recurse to the next nested layer
+            else
+            {
+#pragma unroll
+                for(int i = 0; i < strideCount; i++)
+                {
+                    unroll_right<Depth + 1>(dataPtr, in, view, coord, strideCounts, strides2d);
+                    coord += stride2d;
+                }
+            }
+        }
+
+        template <typename TensorViewT>
+        ROCWMMA_DEVICE static void exec(DataT*                          dataPtr,
+                                        typename Traits::InputT const& data,
+                                        TensorViewT const&              view,
+                                        Coord2d                         origin)
+        {
+            // Arrange wave threads to starting matrix layout offsets.
+            auto baseOffset2d = MatrixLayout::baseOffset();
+            auto it           = makeVectorIterator<StoreVecTraits::size()>(data).begin();
+
+            static_assert(decltype(it)::range() == IOTraits::IOCount,
+                          "IOCount inconsistent with iterator range");
+
+            // Make sure that the IOCount is consistent with the number of total strides
+            static_assert(IOTraits::IOCount
+                              == apply([](auto... items) { return (items * ...); },
+                                       MatrixLayout::strideCounts()),
+                          "IOCount inconsistent with total strides");
+
+            origin += baseOffset2d;
+            unroll_right(
+                dataPtr, it, view, origin, MatrixLayout::strideCounts(), MatrixLayout::strides());
+        }
+    };
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_TENSOR_STORE_HPP
@@ -28,6 +28,7 @@
 
 #include "transforms.hpp"
 
+#include "cross_lane_select.hpp"
 #include "dpp.hpp"
 #include "io_traits.hpp"
 #include "pack_util.hpp"
@@ -49,7 +50,7 @@ namespace rocwmma
 
         return PackUtil::template paddedUnpack<VecSize / 2>(
             Blend::Zip2::exec(PackUtil::paddedPack(extractEven(v)),
-                              Dpp::RotateR16<2>::exec(PackUtil::paddedPack(extractOdd(v)))));
+                              CrossLane::RotateR16<2>::exec(PackUtil::paddedPack(extractOdd(v)))));
     }
 
     template <typename DataT, uint32_t VecSize>
@@ -81,7 +82,7 @@ namespace rocwmma
         using PackUtil = PackUtil<DataT>;
 
         return PackUtil::template paddedUnpack<VecSize / 2>(
-            Blend::Zip2::exec(Dpp::RotateR16<14>::exec(PackUtil::paddedPack(extractEven(v))),
+            Blend::Zip2::exec(CrossLane::RotateR16<14>::exec(PackUtil::paddedPack(extractEven(v))),
                               PackUtil::paddedPack(extractOdd(v))));
     }
 
@@ -115,8 +116,8 @@ namespace rocwmma
 
         auto evens = PackUtil::paddedPack(extractEven(v));
         auto odds  = PackUtil::paddedPack(extractOdd(v));
-        auto lo    = Blend::Zip1::exec(evens, Dpp::RotateR16<1>::exec(odds));
-        auto hi    = Blend::Zip1::exec(Dpp::RotateR16<15>::exec(evens), odds);
+        auto lo    = Blend::Zip1::exec(evens, CrossLane::RotateR16<1>::exec(odds));
+        auto hi    = Blend::Zip1::exec(CrossLane::RotateR16<15>::exec(evens), odds);
 
         return concat(PackUtil::template paddedUnpack<VecSize / 2u>(lo),
                       PackUtil::template paddedUnpack<VecSize / 2u>(hi));
@@ -130,8 +131,8 @@ namespace rocwmma
 
         auto evens = PackUtil::paddedPack(extractEven(v));
         auto odds  = PackUtil::paddedPack(extractOdd(v));
-        auto lo    = Blend::Zip2::exec(evens, Dpp::RotateR16<2>::exec(odds));
-        auto hi    = Blend::Zip2::exec(Dpp::RotateR16<14>::exec(evens), odds);
+        auto lo    = Blend::Zip2::exec(evens, CrossLane::RotateR16<2>::exec(odds));
+        auto hi    = Blend::Zip2::exec(CrossLane::RotateR16<14>::exec(evens), odds);
 
         return concat(PackUtil::template paddedUnpack<VecSize / 2u>(lo),
                       PackUtil::template paddedUnpack<VecSize / 2u>(hi));
@@ -214,9 +215,15 @@ namespace rocwmma
         namespace Ops
         {
 
+            // With a vector width of 1, AOS and SOA register layouts are the same.
+            // Every other supported BlockDim / VW combination has a register-only
+            // (DPP / swizzle / permute) specialization below.
             template <uint32_t BlockDim, uint32_t VectorWidth>
             struct AosToSoa
             {
+                static_assert(VectorWidth == 1u,
+                              "No register-only AosToSoa for this BlockDim and VectorWidth");
+
                 constexpr static uint32_t VW      = VectorWidth;
                 constexpr static uint32_t VecSize = VW * (BlockDim / Constants::AMDGCN_WAVE_SIZE);
 
@@ -1272,9 +1279,15 @@ namespace rocwmma
 
 #endif
 
+            // With a vector width of 1, AOS and SOA register layouts are the same.
+            // Every other supported BlockDim / VW combination has a register-only
+            // (DPP / swizzle / permute) specialization below.
             template <uint32_t BlockDim, uint32_t VectorWidth>
             struct SoaToAos
             {
+                static_assert(VectorWidth == 1u,
+                              "No register-only SoaToAos for this BlockDim and VectorWidth");
+
                 constexpr static uint32_t VW      = VectorWidth;
                 constexpr static uint32_t VecSize = VW * (BlockDim / Constants::AMDGCN_WAVE_SIZE);
 
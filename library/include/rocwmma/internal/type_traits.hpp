@@ -395,14 +395,20 @@ namespace rocwmma
         return ((int32_t)1 << 8);
     }
 
-    template <typename T, enable_if_t<is_same<T, rocwmma::float8_t>::value, int> = 0>
+    template <typename T,
+              enable_if_t<is_same<T, rocwmma::float8_t>::value
+                              || is_same<T, rocwmma::float8_ocp_t>::value,
+                          int>
+              = 0>
     constexpr auto maxExactInteger() -> int32_t
     {
         // f8 mantissa is 3 bits
         return ((int32_t)1 << 4);
     }
 
-    template <typename T, enable_if_t<is_same<T, bfloat8_t>::value, int> = 0>
+    template <typename T,
+              enable_if_t<is_same<T, bfloat8_t>::value || is_same<T, bfloat8_ocp_t>::value, int>
+              = 0>
     constexpr auto maxExactInteger() -> int32_t
     {
         // bf8 mantissa is 2 bits
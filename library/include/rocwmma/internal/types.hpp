@@ -37,6 +37,7 @@
 
 #include "config.hpp"
 #include "float8.hpp"
+#include "float8_ocp.hpp"
 #include "rocwmma_xfloat32.hpp"
 
 namespace rocwmma
@@ -93,8 +94,58 @@ namespace rocwmma
 
     using bfloat8_t = rocwmma_bf8;
 
+    // OCP encodings (E4M3FN, E5M2) of the 8-bit floating point types, native to gfx12
+    using float8_ocp_t = rocwmma_f8_ocp;
+
+    using bfloat8_ocp_t = rocwmma_bf8_ocp;
+
     using xfloat32_t = rocwmma_xfloat32;
 
+    // Storage type of packed int4 data: two signed 4-bit integers per byte,
+    // the lower element index in the low nibble.
+    // Only used as a source of dequantizing loads.
+    struct int4x2_t
+    {
+        uint8_t data;
+    };
+
+    // Signed 4-bit integer, held unpacked in registers as a sign-extended int8_t.
+    // PackUtil<int4_t> packs eight to a 32-bit register with the same nibble order
+    // as int4x2_t.
+    struct int4_t
+    {
+        int8_t data;
+    };
+
+    // Storage types of the OCP microscaling (MX) formats. Elements share one
+    // e8m0_t scale per block of 32 along K, and have no inf or NaN encodings.
+    // Only used as sources of MX loads.
+
+    // Packed FP4 (E2M1) data: two elements per byte, the lower element index in the low nibble.
+    struct float4_e2m1x2_t
+    {
+        uint8_t data;
+    };
+
+    // Packed FP6 (E2M3) data: four elements per 3 bytes, element i in bits [6i, 6i + 6)
+    // of the little-endian 24-bit group.
+    struct float6_e2m3x4_t
+    {
+        uint8_t data[3];
+    };
+
+    // Packed FP6 (E3M2) data, with the same packing as float6_e2m3x4_t.
+    struct float6_e3m2x4_t
+    {
+        uint8_t data[3];
+    };
+
+    // MX block scale: the power of two 2^(data - 127). 0xFF is NaN.
+    struct e8m0_t
+    {
+        uint8_t data;
+    };
+
     /** @}*/
 
 } // namespace rocwmma
@@ -29,6 +29,13 @@
 
 #include "type_traits.hpp"
 
+// Compiler support for building integer sequences without recursion
+#if defined(__has_builtin)
+#if __has_builtin(__make_integer_seq)
+#define ROCWMMA_MAKE_INTEGER_SEQ_BUILTIN 1
+#endif
+#endif
+
 namespace rocwmma
 {
     namespace detail
@@ -47,6 +54,15 @@ namespace rocwmma
         template <size_t... Indices>
         using index_sequence = integer_sequence<size_t, Indices...>;
 
+#if defined(ROCWMMA_MAKE_INTEGER_SEQ_BUILTIN)
+
+        // The compiler builds the sequence in a single step, instead of
+        // instantiating log(N) merge layers for every new N.
+        template <typename Int, Int N>
+        using make_integer_sequence = __make_integer_seq<integer_sequence, Int, N>;
+
+#else
+
         namespace
         {
             // Merge two integer sequences, adding an offset to the right-hand side.
@@ -90,6 +106,8 @@ namespace rocwmma
         using make_integer_sequence =
             typename log_make_sequence<Int, integral_constant<Int, N>>::type;
 
+#endif // ROCWMMA_MAKE_INTEGER_SEQ_BUILTIN
+
         template <size_t N>
         using make_index_sequence = make_integer_sequence<size_t, N>;
     } // namespace detail
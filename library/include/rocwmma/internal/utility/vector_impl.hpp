@@ -55,14 +55,9 @@ namespace rocwmma
         template <typename... Ts>
         struct is_same_type;
 
-        template <typename T>
-        struct is_same_type<T> : true_type
-        {
-        };
-
-        template <typename T, typename U, typename... Ts>
-        struct is_same_type<T, U, Ts...>
-            : conditional_t<is_same<T, U>{}, is_same_type<U, Ts...>, false_type>
+        // Fold over the pack, rather than recursing once per type.
+        template <typename T, typename... Ts>
+        struct is_same_type<T, Ts...> : bool_constant<(is_same<T, Ts>::value && ...)>
         {
         };
 
@@ -176,26 +171,18 @@ namespace rocwmma
 
     namespace detail
     {
-        template <class BinOp, typename T, typename... Ts>
-        ROCWMMA_HOST_DEVICE constexpr static inline decay_t<T> reduceOp_impl(T&& t,
-                                                                             Ts&&... ts) noexcept
-        {
-            using CastT = decay_t<T>;
-            if constexpr(sizeof...(Ts) >= 1)
-            {
-                return BinOp::exec(static_cast<CastT>(t), reduceOp_impl<BinOp>(forward<Ts>(ts)...));
-            }
-            else
-            {
-                return static_cast<CastT>(t);
-            }
-        }
-
+        // Reduces as v0 op (v1 op (... op vN-1)), accumulating with a fold
+        // instead of one recursive call per element. Is spans [0, N - 1).
         template <class BinOp, typename VecT, size_t... Is>
         ROCWMMA_HOST_DEVICE constexpr static inline decltype(auto)
             vector_reduce_impl(VecT&& v, index_sequence<Is...>) noexcept
         {
-            return reduceOp_impl<BinOp>(get<Is>(forward<VecT>(v))...);
+            constexpr auto Last = sizeof...(Is);
+            using CastT         = decay_t<decltype(get<0>(v))>;
+
+            auto result = static_cast<CastT>(get<Last>(v));
+            ((result = BinOp::exec(static_cast<CastT>(get<Last - 1u - Is>(v)), result)), ...);
+            return result;
         }
 
         // Use with operations that have 1 operands
@@ -205,7 +192,7 @@ namespace rocwmma
         {
             return vector_reduce_impl<BinOp>(
                 forward<VecT>(lhs),
-                detail::make_index_sequence<VecTraits<decay_t<VecT>>::size()>{});
+                detail::make_index_sequence<VecTraits<decay_t<VecT>>::size() - 1u>{});
         }
     }
 
@@ -218,6 +218,18 @@ namespace rocwmma
         return "bf8";
     }
 
+    template <>
+    constexpr const char* dataTypeToString<float8_ocp_t>()
+    {
+        return "f8_ocp";
+    }
+
+    template <>
+    constexpr const char* dataTypeToString<bfloat8_ocp_t>()
+    {
+        return "bf8_ocp";
+    }
+
     template <>
     constexpr const char* dataTypeToString<float16_t>()
     {
@@ -49,6 +49,25 @@ namespace rocwmma
         {
             return regsC;
         }
+
+        template <typename InputCRegsT>
+        ROCWMMA_DEVICE static inline auto toNative(InputCRegsT const& regsC)
+        {
+            return regsC;
+        }
+
+        template <typename AccumRegsT>
+        ROCWMMA_DEVICE static inline auto fromNative(AccumRegsT const& accum)
+        {
+            return accum;
+        }
+
+        template <typename InputARegsT, typename InputBRegsT, typename AccumRegsT>
+        ROCWMMA_DEVICE static inline auto
+            execNative(InputARegsT const& regsA, InputBRegsT const& regsB, AccumRegsT const& accum)
+        {
+            return accum;
+        }
     };
 
 #if ROCWMMA_ARCH_GFX11 || ROCWMMA_ARCH_GFX12
@@ -62,6 +81,9 @@ namespace rocwmma
     // bfloat16_t / bfloat16_t
     // bfloat16_t / float32_t
     // int8_t / int32_t
+    // int4_t / int32_t (packed A / B registers, K = 32 per WMMA on gfx12)
+    // float8_ocp_t / float32_t (gfx12)
+    // bfloat8_ocp_t / float32_t (gfx12)
     // Supported block sizes (M, N) = 16
     template <typename InputT, typename ComputeT, uint32_t BlockM, uint32_t BlockN, uint32_t BlockK>
     struct Wmma<
@@ -74,10 +96,12 @@ namespace rocwmma
             ((is_same<InputT, float16_t>::value && is_same<ComputeT, float16_t>::value)
              || (is_same<InputT, float16_t>::value && is_same<ComputeT, float32_t>::value)
 
-            // TODO: update
-            // || (is_same<InputT, float8_t>::value && is_same<ComputeT, float32_t>::value)
-            // || (is_same<InputT, bfloat8_t>::value && is_same<ComputeT, float32_t>::value)
-             
+             // OCP fp8 / bf8 on gfx12 only
+             || (ROCWMMA_ARCH_GFX12 && is_same<InputT, float8_ocp_t>::value
+                 && is_same<ComputeT, float32_t>::value)
+             || (ROCWMMA_ARCH_GFX12 && is_same<InputT, bfloat8_ocp_t>::value
+                 && is_same<ComputeT, float32_t>::value)
+
 #if !ROCWMMA_NO_HALF
              || (is_same<InputT, hfloat16_t>::value && is_same<ComputeT, hfloat16_t>::value)
              || (is_same<InputT, hfloat16_t>::value && is_same<ComputeT, float32_t>::value)
@@ -85,7 +109,8 @@ namespace rocwmma
 
              || (is_same<InputT, bfloat16_t>::value && is_same<ComputeT, bfloat16_t>::value)
              || (is_same<InputT, bfloat16_t>::value && is_same<ComputeT, float32_t>::value)
-             || (is_same<InputT, int8_t>::value && is_same<ComputeT, int32_t>::value))
+             || (is_same<InputT, int8_t>::value && is_same<ComputeT, int32_t>::value)
+             || (is_same<InputT, int4_t>::value && is_same<ComputeT, int32_t>::value))
             && (BlockM == 16) && (BlockN == 16) && (BlockK >= 16) // 16 block size only
             >::type>
     {
@@ -128,24 +153,89 @@ namespace rocwmma
         static_assert(VecTraitsC::size() == IOTraitsAcc::UnpackedSize,
                       "WMMA backend input size mismatch");
 
-        template <typename InputARegsT, typename InputBRegsT, typename InputCRegsT>
+        // WMMA accumulator operates on unpacked, padded data in separate 32b elements.
+        // In the case of f16, what needs to happen is extend each unpacked element to 32b wide
+        // and shift the 16b data to the correct spot (determined by the WMMA backend).
+        // The nasty bit is that due of the extended 32b element size, the final accumulation vector
+        // is masqueraded as a 'packed' type, but with the same vector size as unpacked.
+        template <typename InputCRegsT>
+        ROCWMMA_DEVICE static inline auto toNative(InputCRegsT const& regsC)
+        {
+            static_assert(VecTraits<InputCRegsT>::size() == IOTraitsAcc::PackedSize,
+                          "WMMA input size mismatch");
+
+            return PackUtil::template pad<WMMA::Traits::AccumBits>(PackUtil::unpack(regsC));
+        }
+
+        // Inverse of toNative: returns the packed accumulator fragment data.
+        template <typename AccumRegsT>
+        ROCWMMA_DEVICE static inline auto fromNative(AccumRegsT const& accum)
+        {
+            static_assert(VecTraits<AccumRegsT>::size() == VecTraitsC::size(),
+                          "WMMA accumulator size mismatch");
+
+            return PackUtil::pack(PackUtil::template unpad<WMMA::Traits::AccumBits>(accum));
+        }
+
+        // Integer inputs select signed or unsigned A / B per WMMA
+        template <bool SignedA, bool SignedB, typename ARegsT, typename BRegsT, typename AccumRegsT>
         ROCWMMA_DEVICE static inline auto
-            exec(InputARegsT const& regsA, InputBRegsT const& regsB, InputCRegsT const& regsC)
+            wmma(ARegsT const& regsA, BRegsT const& regsB, AccumRegsT const& accum)
+        {
+            if constexpr(is_same<ComputeT, int32_t>::value)
+            {
+                using Flags = detail::WmmaCtrlFlags;
+                return WMMA::template exec<SignedA ? Flags::SIGNED : Flags::UNSIGNED,
+                                           SignedB ? Flags::SIGNED : Flags::UNSIGNED>(
+                    regsA, regsB, accum);
+            }
+            else
+            {
+                return WMMA::exec(regsA, regsB, accum);
+            }
+        }
+
+#if ROCWMMA_ARCH_GFX11
+        // Combine duplicated data for mult/accum.
+        // Evens: non-swapped
+        // Odds: swapped
+        template <typename RegsT>
+        ROCWMMA_DEVICE static inline auto duplicate(RegsT const& regs, RegsT const& swapped)
+        {
+            // A single register (e.g. packed int4) has no halves to interleave
+            if constexpr(VecTraits<RegsT>::size() == 1u)
+            {
+                return concat(regs, swapped);
+            }
+            else
+            {
+                return concat(unpackLo(regs, swapped), unpackHi(regs, swapped));
+            }
+        }
+#endif // ROCWMMA_ARCH_GFX11
+
+        // Accumulates A x B into the padded (native) accumulator from toNative.
+        // Kernels iterating over K may keep the accumulator padded across the whole loop
+        // and unpad once, saving the pad / unpad of every exec when ComputeT is 16b.
+        // SignedA / SignedB only apply to integer inputs.
+        template <bool SignedA = true,
+                  bool SignedB = true,
+                  typename InputARegsT,
+                  typename InputBRegsT,
+                  typename AccumRegsT>
+        ROCWMMA_DEVICE static inline auto execNative(InputARegsT const& regsA,
+                                                     InputBRegsT const& regsB,
+                                                     AccumRegsT const&  accumIn)
         {
             // Inputs from outside will come in as fully packed
             static_assert(VecTraits<InputARegsT>::size() == IOTraitsA::PackedSize,
                           "WMMA input size mismatch");
             static_assert(VecTraits<InputBRegsT>::size() == IOTraitsB::PackedSize,
                           "WMMA input size mismatch");
-            static_assert(VecTraits<InputCRegsT>::size() == IOTraitsAcc::PackedSize,
-                          "WMMA input size mismatch");
+            static_assert(VecTraits<AccumRegsT>::size() == VecTraitsC::size(),
+                          "WMMA accumulator size mismatch");
 
-            // WMMA accumulator operates on unpacked, padded data in separate 32b elements.
-            // In the case of f16, what needs to happen is extend each unpacked element to 32b wide
-            // and shift the 16b data to the correct spot (determined by the WMMA backend).
-            // The nasty bit is that due of the extended 32b element size, the final accumulation vector
-            // is masqueraded as a 'packed' type, but with the same vector size as unpacked.
-            auto accum = PackUtil::template pad<WMMA::Traits::AccumBits>(PackUtil::unpack(regsC));
+            auto accum = accumIn;
 
             // Iterate over packed WMMA inputs
             auto const aIt
@@ -162,15 +252,11 @@ namespace rocwmma
                 auto swappedA = Swizzle::Swap16::exec(*aIt);
                 auto swappedB = Swizzle::Swap16::exec(*bIt);
 
-                // Combine duplicated data for mult/accum.
-                // Evens: non-swapped
-                // Odds: swapped
-                accum = WMMA::exec(concat(unpackLo(*aIt, swappedA), unpackHi(*aIt, swappedA)),
-                                   concat(unpackLo(*bIt, swappedB), unpackHi(*bIt, swappedB)),
-                                   accum);
+                accum = wmma<SignedA, SignedB>(
+                    duplicate(*aIt, swappedA), duplicate(*bIt, swappedB), accum);
 #else
 
-                accum = WMMA::exec(*aIt, *bIt, accum);
+                accum = wmma<SignedA, SignedB>(*aIt, *bIt, accum);
 
 #endif
 
@@ -178,7 +264,18 @@ namespace rocwmma
                 bIt++;
             }
 
-            return PackUtil::pack(PackUtil::template unpad<WMMA::Traits::AccumBits>(accum));
+            return accum;
+        }
+
+        template <bool SignedA = true,
+                  bool SignedB = true,
+                  typename InputARegsT,
+                  typename InputBRegsT,
+                  typename InputCRegsT>
+        ROCWMMA_DEVICE static inline auto
+            exec(InputARegsT const& regsA, InputBRegsT const& regsB, InputCRegsT const& regsC)
+        {
+            return fromNative(execNative<SignedA, SignedB>(regsA, regsB, toNative(regsC)));
         }
     };
 
@@ -221,18 +221,50 @@ namespace rocwmma
                 using DRegsT = AccRegI32x8;
             };
 
+            // SignA / SignB select signed or unsigned interpretation of the A / B bytes
+            template <uint32_t SignA = Traits::InputSign, uint32_t SignB = Traits::InputSign>
             ROCWMMA_DEVICE static inline auto exec(typename Traits::ARegsT const& regsA,
                                                    typename Traits::BRegsT const& regsB,
                                                    typename Traits::CRegsT const& regsC) ->
                 typename Traits::DRegsT
             {
                 typename Traits::DRegsT result;
-                result.data = {__builtin_amdgcn_wmma_i32_16x16x16_iu8_w32(Traits::InputSign,
-                                                                          regsA.data,
-                                                                          Traits::InputSign,
-                                                                          regsB.data,
-                                                                          regsC.data,
-                                                                          Traits::AccumSign)};
+                result.data = {__builtin_amdgcn_wmma_i32_16x16x16_iu8_w32(
+                    SignA, regsA.data, SignB, regsB.data, regsC.data, Traits::AccumSign)};
+                return result;
+            }
+        };
+
+        // Inputs are packed eight 4-bit integers per register
+        template <>
+        struct amdgcn_wmma<int4_t, int32_t, 16, 16>
+        {
+            // Packed register traits
+            struct Traits
+            {
+                enum : uint32_t
+                {
+                    KPerWmma  = 16,
+                    InputSign = WmmaCtrlFlags::SIGNED,
+                    AccumBits = WmmaCtrlFlags::LOW,
+                    AccumSign = WmmaCtrlFlags::SIGNED
+                };
+                using ARegsT = VRegI32x2;
+                using BRegsT = VRegI32x2;
+                using CRegsT = AccRegI32x8;
+                using DRegsT = AccRegI32x8;
+            };
+
+            // SignA / SignB select signed or unsigned interpretation of the A / B nibbles
+            template <uint32_t SignA = Traits::InputSign, uint32_t SignB = Traits::InputSign>
+            ROCWMMA_DEVICE static inline auto exec(typename Traits::ARegsT const& regsA,
+                                                   typename Traits::BRegsT const& regsB,
+                                                   typename Traits::CRegsT const& regsC) ->
+                typename Traits::DRegsT
+            {
+                typename Traits::DRegsT result;
+                result.data = {__builtin_amdgcn_wmma_i32_16x16x16_iu4_w32(
+                    SignA, regsA.data, SignB, regsB.data, regsC.data, Traits::AccumSign)};
                 return result;
             }
         };
@@ -417,24 +449,58 @@ namespace rocwmma
                 using DRegsT = AccRegI32x8;
             };
 
+            // SignA / SignB select signed or unsigned interpretation of the A / B bytes
+            template <uint32_t SignA = Traits::InputSign, uint32_t SignB = Traits::InputSign>
             ROCWMMA_DEVICE static inline auto exec(typename Traits::ARegsT const& regsA,
                                                    typename Traits::BRegsT const& regsB,
                                                    typename Traits::CRegsT const& regsC) ->
                 typename Traits::DRegsT
             {
                 typename Traits::DRegsT result;
-                result.data = {__builtin_amdgcn_wmma_i32_16x16x16_iu8_w32_gfx12(Traits::InputSign,
-                                                                                regsA.data,
-                                                                                Traits::InputSign,
-                                                                                regsB.data,
-                                                                                regsC.data,
-                                                                                Traits::AccumSign)};
+                result.data = {__builtin_amdgcn_wmma_i32_16x16x16_iu8_w32_gfx12(
+                    SignA, regsA.data, SignB, regsB.data, regsC.data, Traits::AccumSign)};
                 return result;
             }
         };
 
+        // Inputs are packed eight 4-bit integers per register.
+        // The K = 32 variant doubles the K of int8_t per instruction.
         template <>
-        struct amdgcn_wmma<float8_t, float32_t, 16, 16>
+        struct amdgcn_wmma<int4_t, int32_t, 16, 16>
+        {
+            // Packed register traits
+            struct Traits
+            {
+                enum : uint32_t
+                {
+                    KPerWmma  = 32,
+                    InputSign = WmmaCtrlFlags::SIGNED,
+                    AccumBits = WmmaCtrlFlags::LOW,
+                    AccumSign = WmmaCtrlFlags::SIGNED
+                };
+                using ARegsT = VRegI32x2;
+                using BRegsT = VRegI32x2;
+                using CRegsT = AccRegI32x8;
+                using DRegsT = AccRegI32x8;
+            };
+
+            // SignA / SignB select signed or unsigned interpretation of the A / B nibbles
+            template <uint32_t SignA = Traits::InputSign, uint32_t SignB = Traits::InputSign>
+            ROCWMMA_DEVICE static inline auto exec(typename Traits::ARegsT const& regsA,
+                                                   typename Traits::BRegsT const& regsB,
+                                                   typename Traits::CRegsT const& regsC) ->
+                typename Traits::DRegsT
+            {
+                typename Traits::DRegsT result;
+                result.data = {__builtin_amdgcn_wmma_i32_16x16x32_iu4_w32_gfx12(
+                    SignA, regsA.data, SignB, regsB.data, regsC.data, Traits::AccumSign)};
+                return result;
+            }
+        };
+
+        // gfx12 WMMA fp8 / bf8 inputs are in the OCP encodings
+        template <>
+        struct amdgcn_wmma<float8_ocp_t, float32_t, 16, 16>
         {
             // Packed register traits
             struct Traits
@@ -470,7 +536,7 @@ namespace rocwmma
         };
 
         template <>
-        struct amdgcn_wmma<bfloat8_t, float32_t, 16, 16>
+        struct amdgcn_wmma<bfloat8_ocp_t, float32_t, 16, 16>
         {
             // Packed register traits
             struct Traits
@@ -495,10 +561,12 @@ namespace rocwmma
             {
                 // Built-in expects vector of int.
                 using TypeIn = VecT<int, 2>;
-                
+
                 typename Traits::DRegsT result;
                 result.data = {__builtin_amdgcn_wmma_f32_16x16x16_bf8_bf8_w32_gfx12(
-                    reinterpret_cast<TypeIn const&>(regsA).data, reinterpret_cast<TypeIn const&>(regsB).data, regsC.data)};
+                    reinterpret_cast<TypeIn const&>(regsA).data,
+                    reinterpret_cast<TypeIn const&>(regsB).data,
+                    regsC.data)};
                 return result;
             }
         };
@@ -99,6 +99,58 @@ namespace rocwmma
     {
     };
 
+    //! @struct cache_default
+    //! @brief Meta-tag indicating regular cached memory access.
+    struct cache_default
+    {
+    };
+
+    //! @struct cache_non_temporal
+    //! @brief Meta-tag indicating non-temporal (streaming) memory access, for data that is
+    //! not expected to be re-used. Preserves cache capacity for data with re-use.
+    struct cache_non_temporal
+    {
+    };
+
+    //! @struct lds_access
+    //! @brief Meta-tag indicating local memory (LDS) access. IO vectors are accessed through the
+    //! LDS address space as ds_read / ds_write of up to 128 bits, instead of flat accesses. The
+    //! data pointer must point to local memory.
+    struct lds_access
+    {
+    };
+
+    //! @struct xor_swizzle
+    //! @brief Meta-tag indicating XOR swizzled memory access, to remove LDS bank conflicts.
+    //! Chunks of ChunkBytes are permuted within each RowBytes row, by XOR of the row index
+    //! modulo Phases. The swizzle is applied to absolute addresses, so every access to the
+    //! swizzled region must use the same xor_swizzle policy. Swizzled data must be in local
+    //! memory, which is accessed as with lds_access.
+    //! @tparam Phases Number of distinct swizzle phases, a power of 2
+    //! @tparam ChunkBytes Size of the permuted chunk in bytes, at least the IO vector size
+    //! @tparam RowBytes Size of the row over which the phase is constant, in bytes
+    template <uint32_t Phases, uint32_t ChunkBytes, uint32_t RowBytes>
+    struct xor_swizzle
+    {
+    };
+
+    //! @struct aligned_ptr
+    //! @brief Data pointer with an alignment known at compile time. The pointer and the leading dimension
+    //! stride of the matrix, in bytes, are both multiples of AlignBytes. Loads and stores through an aligned_ptr
+    //! issue vectors of at most AlignBytes: aligned data of 16B keeps the widest vectors of the fragment, and
+    //! lesser alignments narrow the vectors instead of accessing unaligned addresses.
+    //! See make_aligned_ptr, and is_aligned for the run-time check.
+    //! @tparam DataT Datatype, const for loads
+    //! @tparam AlignBytes Alignment in bytes, a power of 2
+    template <typename DataT, uint32_t AlignBytes>
+    struct aligned_ptr
+    {
+        static_assert(AlignBytes > 0u && (AlignBytes & (AlignBytes - 1u)) == 0u,
+                      "AlignBytes must be a power of 2");
+
+        DataT* ptr;
+    };
+
     //! @struct layout_t
     //! @brief Runtime data layout tags
     //! @var mem_row_major
@@ -109,6 +161,166 @@ namespace rocwmma
         mem_col_major
     };
 
+    //! @struct conv2d_nhwc
+    //! @brief Geometry of a forward 2D convolution of an NHWC input with KRSC filters into an NPQK output.
+    //! The convolution is the implicit GEMM D (M x N) = A (M x K) x B (K x N), where:
+    //! - M = n * p * q output pixels, the rows of the im2col matrix A
+    //! - N = k filters, with B the col_major view of the filters (ldb = r * s * c)
+    //! - K = r * s * c filter taps, with c fastest
+    //! D is the row_major view of the output (ldd = k).
+    //! @note Output sizes follow p = (h + 2 * padH - dilationH * (r - 1) - 1) / strideH + 1, and likewise q.
+    //! See make_conv2d_nhwc.
+    struct conv2d_nhwc
+    {
+        uint32_t n, h, w, c; //!< Input batch, height, width and channels
+        uint32_t k, r, s; //!< Filter count, height and width
+        uint32_t p, q; //!< Output height and width
+        uint32_t padH, padW;
+        uint32_t strideH, strideW;
+        uint32_t dilationH, dilationW;
+    };
+
+    //! @struct conv2d_nhwc_dgrad
+    //! @brief Backward data (dgrad) view of a conv2d_nhwc, computing the NHWC input gradient dX from the NPQK output
+    //! gradient dY. The transposed convolution is the implicit GEMM dX (M x N) = A (M x K) x B (K x N), where:
+    //! - M = n * h * w input pixels, the rows of the gathered output gradient A
+    //! - N = c input channels, with B the row_major view of the filters reordered to RSKC (ldb = c)
+    //! - K = r * s * k filter taps, with k fastest
+    //! dX is the row_major view of the input gradient (ldd = c).
+    //! A(row, col) is dY at output pixel ((h + padH - r * dilationH) / strideH, (w + padW - s * dilationW) / strideW)
+    //! and channel k where both divisions are exact and in range, and 0 otherwise.
+    struct conv2d_nhwc_dgrad
+    {
+        conv2d_nhwc conv; //!< Geometry of the forward convolution
+    };
+
+    //! @struct conv2d_nhwc_grouped
+    //! @brief Grouped view of a conv2d_nhwc, whose c channels and k filters are split into groups of
+    //! cg = c / groups channels and kg = k / groups filters, e.g. ResNeXt blocks, or depthwise convolutions
+    //! with groups = c. Group g is the implicit GEMM D_g (M x kg) = A_g (M x K) x B_g (K x kg), where:
+    //! - M = n * p * q output pixels, the rows of the im2col matrix A_g of channels [g * cg, (g + 1) * cg)
+    //! - K = r * s * cg filter taps, with the channels of the group fastest
+    //! - B_g is the col_major view of the KRSC filters of the group, at g * kg * K elements (ldb = K)
+    //! D_g is the row_major view of the output channels of the group, at g * kg elements (ldd = k).
+    //! @note c and k must be multiples of groups.
+    struct conv2d_nhwc_grouped
+    {
+        conv2d_nhwc conv; //!< Geometry of the whole convolution, with c and k over all groups
+        uint32_t    groups; //!< Number of groups
+    };
+
+    //! Builds the geometry of a forward 2D convolution, computing the output height and width
+    //! @returns conv2d_nhwc of the given input, filter and convolution parameters
+    ROCWMMA_HOST_DEVICE constexpr inline conv2d_nhwc make_conv2d_nhwc(uint32_t n,
+                                                                      uint32_t h,
+                                                                      uint32_t w,
+                                                                      uint32_t c,
+                                                                      uint32_t k,
+                                                                      uint32_t r,
+                                                                      uint32_t s,
+                                                                      uint32_t padH      = 0u,
+                                                                      uint32_t padW      = 0u,
+                                                                      uint32_t strideH   = 1u,
+                                                                      uint32_t strideW   = 1u,
+                                                                      uint32_t dilationH = 1u,
+                                                                      uint32_t dilationW = 1u);
+
+    //! @struct tensor_modes
+    //! @brief Extents and strides of the tensor modes folded into one index of a tensor_view, in fold order.
+    //! Index i is decomposed over the modes with the last mode fastest, and the element offset is the sum of
+    //! each mode index times its stride.
+    struct tensor_modes
+    {
+        static constexpr uint32_t MaxModes = 6u; //!< Maximum rank of a tensor
+
+        uint32_t count; //!< Number of folded modes
+        uint32_t size; //!< Product of the extents, the range of the folded index
+        uint32_t extents[MaxModes];
+        int64_t  strides[MaxModes]; //!< Element strides, non-negative
+    };
+
+    //! @struct tensor_view
+    //! @brief Matrix view of a strided tensor, for tensor contractions in which the GEMM rows, columns and batches are each
+    //! a group of tensor modes. E.g. the attention scores S[b, h, s, t] = sum_d Q[b, s, h, d] * K[b, t, h, d] view
+    //! the BSHD tensor Q as a batch (b, h) of (s x d) matrices.
+    //! The element offset of matrix coordinate (row, col) in batch b is the sum of the folded offsets of the row, col and batch
+    //! indices, such that any permutation of the tensor dimensions is addressed in place, without a permute copy.
+    //! See make_tensor_view and make_tensor_contraction.
+    struct tensor_view
+    {
+        tensor_modes rows; //!< Modes folded into the matrix row index
+        tensor_modes cols; //!< Modes folded into the matrix column index
+        tensor_modes batch; //!< Modes folded into the batch index
+    };
+
+    //! @struct tensor_contraction
+    //! @brief Tensor contraction D = A x B, in einsum notation, as a batched GEMM over tensor_view operands:
+    //! - M modes appear in A and D, N modes in B and D, K modes in A and B and batch modes in all three tensors
+    //! - a views A as (M x K), b views B as (K x N) and d views C and D as (M x N)
+    //! - M, N and batch modes are folded in the order of D, and K modes in the order of A
+    //! See make_tensor_contraction.
+    struct tensor_contraction
+    {
+        tensor_view a, b, d;
+        uint32_t    m, n, k, batch; //!< GEMM sizes and batch count
+    };
+
+    //! Builds the matrix view of a tensor from einsum mode labels, e.g. make_tensor_view("bshd", extents, strides, "s", "d", "bh")
+    //! @param modes Labels of the tensor modes, one character per mode, in the order of extents and strides
+    //! @param extents Extent of each tensor mode
+    //! @param strides Element stride of each tensor mode
+    //! @param rowModes Labels of the modes folded into the row index, last fastest
+    //! @param colModes Labels of the modes folded into the column index, last fastest
+    //! @param batchModes Labels of the modes folded into the batch index, last fastest
+    //! @returns tensor_view of the tensor
+    //! @note Labels must be unique within a tensor and at most tensor_modes::MaxModes per tensor.
+    //! Modes not listed in rowModes, colModes or batchModes are fixed at index 0.
+    ROCWMMA_HOST_DEVICE constexpr inline tensor_view
+        make_tensor_view(const char*     modes,
+                         const uint32_t* extents,
+                         const int64_t*  strides,
+                         const char*     rowModes,
+                         const char*     colModes,
+                         const char*     batchModes = "");
+
+    //! Builds the batched GEMM of a tensor contraction from its einsum expression, e.g. "bshd,bthd->bhst"
+    //! @param expression Einsum expression of the contraction, as "A,B->D" labels without spaces
+    //! @param extentsA Extent of each mode of A
+    //! @param stridesA Element stride of each mode of A
+    //! @param extentsB Extent of each mode of B
+    //! @param stridesB Element stride of each mode of B
+    //! @param extentsD Extent of each mode of C and D
+    //! @param stridesD Element stride of each mode of C and D
+    //! @returns tensor_contraction of the expression
+    //! @note Each label must appear in exactly two of the tensors, or in all three as a batch mode.
+    ROCWMMA_HOST_DEVICE constexpr inline tensor_contraction
+        make_tensor_contraction(const char*     expression,
+                                const uint32_t* extentsA,
+                                const int64_t*  stridesA,
+                                const uint32_t* extentsB,
+                                const int64_t*  stridesB,
+                                const uint32_t* extentsD,
+                                const int64_t*  stridesD);
+
+    //! Wraps a data pointer with the alignment guarantee of AlignBytes, e.g. make_aligned_ptr<16u>(a)
+    //! @param ptr Data pointer, aligned to AlignBytes
+    //! @returns aligned_ptr of ptr
+    //! @tparam AlignBytes Alignment in bytes, a power of 2
+    //! @tparam DataT Datatype
+    template <uint32_t AlignBytes, typename DataT>
+    ROCWMMA_HOST_DEVICE constexpr inline aligned_ptr<DataT, AlignBytes>
+        make_aligned_ptr(DataT* ptr);
+
+    //! Checks the alignment guarantee of aligned_ptr at run-time, e.g. to dispatch between kernels
+    //! instantiated with full and element alignment.
+    //! @param ptr Data pointer
+    //! @param ldm Leading dimension size, in elements
+    //! @returns True if ptr and ldm * sizeof(DataT) are multiples of AlignBytes
+    //! @tparam AlignBytes Alignment in bytes, a power of 2
+    //! @tparam DataT Datatype
+    template <uint32_t AlignBytes, typename DataT>
+    ROCWMMA_HOST_DEVICE inline bool is_aligned(const DataT* ptr, uint32_t ldm);
+
     //! @class fragment
     //! @brief rocWMMA fragment class. This is the primary object used in block-wise decomposition of the matrix multiply-accumulate (mma)
     //! problem space. In general, fragment data is associated with a matrix context (matrix_a, matrix_b or accumulator), a block size (BlockM/N/K),
@@ -218,6 +430,26 @@ namespace rocwmma
         fill_fragment(fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>& frag,
                       DataT                                                          value);
 
+    //! Tests whether every element of the fragment is zero across the wave, e.g. to skip the mma_sync of an all-zero
+    //! matrix_a block of ReLU activations, together with the load of its matrix_b block.
+    //! @param frag Fragment of type MatrixT with its associated block sizes, data type and layout
+    //! @tparam Matrix Fragment context
+    //! @tparam BlockM/N/K Block dimensions
+    //! @tparam DataT Datatype
+    //! @tparam DataLayoutT in-memory layout as col_major or row_major
+    //! @returns True if all elements held by the wave are zero, of either sign for floating point types, as a
+    //! wave-uniform value for scalar branches
+    //! @note One ballot per call. Skipping the mma of a zero block drops the propagation of NaN and infinity from
+    //! the other input.
+    template <typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE bool
+        is_zero_sync(fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& frag);
+
     //! Loads the entire fragment from the data pointer according to its matrix and data layout contexts. Data pointer may point to either local or global memory.
     //! @param frag Fragment of type MatrixT with its associated block sizes, data type and layout
     //! @param data Data pointer to global or local memory
@@ -252,6 +484,482 @@ namespace rocwmma
                                          uint32_t                                          ldm,
                                          layout_t                                          layout);
 
+    //! Loads the entire fragment from the data pointer according to its matrix and data layout contexts, with a memory access policy.
+    //! Non-temporal loads suit data that is read once (e.g. single pass weights), leaving cache capacity to the operand that is re-used.
+    //! Data pointer may point to either local or global memory. Cache policy hints have no effect on local memory.
+    //! XOR swizzled access permutes local memory addresses to avoid bank conflicts.
+    //! LDS access issues ds_read / ds_write of up to 128 bits on local memory, instead of flat accesses.
+    //! @param frag Fragment of type MatrixT with its associated block sizes, data type and layout
+    //! @param data Data pointer to global or local memory
+    //! @param ldm Leading dimension size
+    //! @tparam AccessPolicyT Access policy as cache_default, cache_non_temporal, lds_access or xor_swizzle
+    //! @tparam MatrixT Fragment context
+    //! @tparam BlockM/N/K Block dimensions
+    //! @tparam DataT Datatype
+    //! @tparam DataLayoutT In-memory layout as col_major or row_major
+    template <typename AccessPolicyT,
+              typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void
+        load_matrix_sync(fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>& frag,
+                         const DataT*                                                   data,
+                         uint32_t                                                       ldm);
+
+    //! Loads the entire fragment from aligned data according to its matrix and data layout contexts. Fragment vectors wider
+    //! than AlignBytes are loaded as narrower vectors of AlignBytes, into the same register layout as load_matrix_sync.
+    //! Data pointer may point to either local or global memory.
+    //! @param frag Fragment of type MatrixT with its associated block sizes, data type and layout
+    //! @param data Aligned data pointer to global/local memory
+    //! @param ldm Leading dimension size, with ldm * sizeof(DataT) a multiple of AlignBytes
+    //! @tparam MatrixT Fragment context
+    //! @tparam BlockM/N/K Block dimensions
+    //! @tparam DataT Datatype
+    //! @tparam DataLayoutT In-memory layout as col_major or row_major
+    //! @tparam PtrDataT Datatype of the aligned pointer, DataT or const DataT
+    //! @tparam AlignBytes Alignment of data and ldm in bytes
+    template <typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT,
+              typename PtrDataT,
+              uint32_t AlignBytes>
+    ROCWMMA_DEVICE void
+        load_matrix_sync(fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>& frag,
+                         aligned_ptr<PtrDataT, AlignBytes>                              data,
+                         uint32_t                                                       ldm);
+
+    //! Loads the entire fragment from quantized data, converting elements to the fragment datatype in registers.
+    //! Data is read with the same matrix and data layouts as load_matrix_sync, but at the reduced size of QuantT.
+    //! E.g. int4 or float8_t weights are dequantized into float16_t matrix_b fragments, for mma_sync with float16_t activations.
+    //! @param frag Fragment of type MatrixT with its associated block sizes, data type and layout
+    //! @param data Data pointer to global or local memory, of quantized type float8_t, bfloat8_t, int8_t or int4x2_t
+    //! @param ldm Leading dimension size, in elements
+    //! @tparam MatrixT Fragment context
+    //! @tparam BlockM/N/K Block dimensions
+    //! @tparam DataT Datatype of the fragment
+    //! @tparam DataLayoutT In-memory layout as col_major or row_major
+    //! @tparam QuantT Datatype of the quantized data
+    //! @note Elements are converted without scaling. Per-channel or group-wise scales may be applied to the
+    //! fragment, or to the accumulator of each group.
+    //! @note For int4x2_t, data points to two elements per byte. The fragment origin and ldm must be even.
+    template <typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT,
+              typename QuantT>
+    ROCWMMA_DEVICE void load_matrix_dequant_sync(
+        fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>& frag,
+        const QuantT*                                                  data,
+        uint32_t                                                       ldm);
+
+    //! Loads the entire fragment from OCP microscaling (MX) data, scaling each element by the shared e8m0_t scale of its block of 32 along K,
+    //! and converting it to the fragment datatype in registers.
+    //! Data is read with the same matrix and data layouts as load_matrix_sync, but at the reduced size of QuantT.
+    //! Scales are read with the same data layout as data, from a BlockM x (BlockK / 32) matrix for matrix_a, or (BlockK / 32) x BlockN for matrix_b.
+    //! E.g. MXFP4 weights are loaded into bfloat16_t matrix_b fragments for mma_sync, emulating MX GEMM on targets without scaled MMA.
+    //! @param frag Fragment of type MatrixT with its associated block sizes, data type and layout
+    //! @param data Data pointer to global or local memory, of MX element type float8_ocp_t, bfloat8_ocp_t, float6_e2m3x4_t, float6_e3m2x4_t or float4_e2m1x2_t
+    //! @param scales Scale pointer to global or local memory, to the scale of the fragment origin
+    //! @param ldm Leading dimension size of data, in elements
+    //! @param lds Leading dimension size of scales, in scales
+    //! @tparam MatrixT Fragment context, matrix_a or matrix_b
+    //! @tparam BlockM/N/K Block dimensions
+    //! @tparam DataT Datatype of the fragment
+    //! @tparam DataLayoutT In-memory layout of data and scales as col_major or row_major
+    //! @tparam QuantT Element type of the MX data
+    //! @note BlockK must be a multiple or a divisor of 32, and the fragment origin along K a multiple of BlockK.
+    //! @note Scaled values may exceed the range of float16_t. bfloat16_t or float32_t fragments are recommended.
+    //! @note For float4_e2m1x2_t, data points to two elements per byte, and the fragment origin and ldm must be even.
+    //! For float6_e2m3x4_t and float6_e3m2x4_t, data points to four elements per 3 bytes, and the fragment origin and ldm must be multiples of 4.
+    template <typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT,
+              typename QuantT>
+    ROCWMMA_DEVICE void
+        load_matrix_mx_sync(fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>& frag,
+                            const QuantT*                                                  data,
+                            const e8m0_t*                                                  scales,
+                            uint32_t                                                       ldm,
+                            uint32_t                                                       lds);
+
+    //! Loads float32_t data and splits each element into high and low parts of the fragment datatype, such that
+    //! data ~= hi + lo. hi holds data rounded to DataT, and lo holds the residual (data - hi) rounded to DataT.
+    //! Data is read with the same matrix and data layouts as load_matrix_sync of the DataT fragments.
+    //! Use with mma_sync_split to emulate float32_t GEMM on bfloat16_t MMA.
+    //! @param hi Fragment of the high parts, of type MatrixT with its associated block sizes, data type and layout
+    //! @param lo Fragment of the low parts, of the same type as hi
+    //! @param data Data pointer to global or local memory, of float32_t
+    //! @param ldm Leading dimension size, in elements
+    //! @tparam MatrixT Fragment context
+    //! @tparam BlockM/N/K Block dimensions
+    //! @tparam DataT Datatype of the fragments, e.g. bfloat16_t, or xfloat32_t on gfx940+
+    //! @tparam DataLayoutT In-memory layout as col_major or row_major
+    template <typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void
+        load_matrix_split_sync(fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>& hi,
+                               fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>& lo,
+                               const float32_t*                                               data,
+                               uint32_t                                                       ldm);
+
+    //! Loads the fragment from the data pointer according to its matrix and data layout contexts, reading only elements within the valid extent of the block.
+    //! Elements outside of the valid extent are not read and are zero-filled, so partial blocks at the ragged edges of problem sizes that are not
+    //! multiples of the block size can be loaded without padding. Data pointer may point to either local or global memory.
+    //! @param frag Fragment of type MatrixT with its associated block sizes, data type and layout
+    //! @param data Data pointer to global or local memory
+    //! @param ldm Leading dimension size
+    //! @param rows Valid rows from the fragment origin in matrix space: BlockM for matrix_a and accumulator, BlockK for matrix_b
+    //! @param cols Valid columns from the fragment origin in matrix space: BlockK for matrix_a, BlockN for matrix_b and accumulator
+    //! @tparam MatrixT Fragment context
+    //! @tparam BlockM/N/K Block dimensions
+    //! @tparam DataT Datatype
+    //! @tparam DataLayoutT In-memory layout as col_major or row_major
+    //! @note Rows or cols greater than or equal to the block size are not bounded. E.g. pass the remaining problem size (M - row, ...).
+    template <typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void load_matrix_bounded_sync(
+        fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>& frag,
+        const DataT*                                                   data,
+        uint32_t                                                       ldm,
+        uint32_t                                                       rows,
+        uint32_t                                                       cols);
+
+    //! Loads the fragment from the data pointer, reading only elements within the valid extent of the block.
+    //! This overload provides a run-time ability to choose the data layout of the target fragment.
+    //! @param frag Fragment of type MatrixT with its associated block sizes, data type and layout
+    //! @param data Data pointer to global/local memory
+    //! @param ldm Leading dimension size
+    //! @param rows Valid rows from the fragment origin in matrix space
+    //! @param cols Valid columns from the fragment origin in matrix space
+    //! @param layout Data layout
+    //! @tparam MatrixT Fragment context
+    //! @tparam BlockM/N/K Block dimensions
+    //! @tparam DataT Datatype
+    template <typename MatrixT, uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename DataT>
+    ROCWMMA_DEVICE void
+        load_matrix_bounded_sync(fragment<MatrixT, BlockM, BlockN, BlockK, DataT>& frag,
+                                 const DataT*                                      data,
+                                 uint32_t                                          ldm,
+                                 uint32_t                                          rows,
+                                 uint32_t                                          cols,
+                                 layout_t                                          layout);
+
+    //! Loads a matrix_a fragment of the implicit GEMM of a 2D convolution, computing the im2col address of each element
+    //! on the fly from the NHWC input, such that the im2col matrix is never materialized.
+    //! Elements that fall in the padding, or beyond M or K, are not read and are zero-filled.
+    //! @param frag Fragment of type matrix_a with its associated block sizes and data type. The layout must be row_major.
+    //! @param input Data pointer to the NHWC input tensor in global memory
+    //! @param conv Convolution geometry
+    //! @param row Fragment origin in M, the output pixel index
+    //! @param col Fragment origin in K, the filter tap index
+    //! @tparam BlockM/N/K Block dimensions
+    //! @tparam DataT Datatype
+    //! @note Vectors are loaded whole when conv.c is a multiple of the vector width, and element-wise otherwise.
+    template <uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename DataT>
+    ROCWMMA_DEVICE void
+        load_matrix_im2col_sync(fragment<matrix_a, BlockM, BlockN, BlockK, DataT, row_major>& frag,
+                                const DataT*                                                  input,
+                                conv2d_nhwc const&                                            conv,
+                                uint32_t                                                      row,
+                                uint32_t                                                      col);
+
+    //! Loads a matrix_b fragment of the im2col matrix of a 2D convolution, gathered on the fly from the NHWC input.
+    //! E.g. the backward weight (wgrad) implicit GEMM dW (k x r * s * c) = dY^T (k x n * p * q) x im2col(input), with
+    //! the NPQK output gradient as the col_major A (lda = k) and dW as the row_major D of the KRSC filters.
+    //! Elements that fall in the padding, or beyond M or K, are not read and are zero-filled.
+    //! @param frag Fragment of type matrix_b with its associated block sizes and data type. The layout must be row_major.
+    //! @param input Data pointer to the NHWC input tensor in global memory
+    //! @param conv Convolution geometry
+    //! @param row Fragment origin in the im2col rows, the output pixel index
+    //! @param col Fragment origin in the im2col columns, the filter tap index
+    //! @tparam BlockM/N/K Block dimensions
+    //! @tparam DataT Datatype
+    //! @note Vectors are loaded whole when conv.c is a multiple of the vector width, and element-wise otherwise.
+    template <uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename DataT>
+    ROCWMMA_DEVICE void
+        load_matrix_im2col_sync(fragment<matrix_b, BlockM, BlockN, BlockK, DataT, row_major>& frag,
+                                const DataT*                                                  input,
+                                conv2d_nhwc const&                                            conv,
+                                uint32_t                                                      row,
+                                uint32_t                                                      col);
+
+    //! Loads a matrix_a fragment of the backward data (dgrad) implicit GEMM of a 2D convolution, gathering the output
+    //! gradient of each input pixel and filter tap on the fly from the NPQK output gradient, such that neither the
+    //! zero-inserted (strided) output gradient nor its im2col matrix are materialized.
+    //! Elements without a contributing output pixel, or beyond M or K, are not read and are zero-filled.
+    //! @param frag Fragment of type matrix_a with its associated block sizes and data type. The layout must be row_major.
+    //! @param grad Data pointer to the NPQK output gradient tensor in global memory
+    //! @param dgrad Backward data view of the convolution geometry
+    //! @param row Fragment origin in M, the input pixel index
+    //! @param col Fragment origin in K, the filter tap index
+    //! @tparam BlockM/N/K Block dimensions
+    //! @tparam DataT Datatype
+    //! @note Vectors are loaded whole when conv.k is a multiple of the vector width, and element-wise otherwise.
+    template <uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename DataT>
+    ROCWMMA_DEVICE void
+        load_matrix_im2col_sync(fragment<matrix_a, BlockM, BlockN, BlockK, DataT, row_major>& frag,
+                                const DataT*                                                  grad,
+                                conv2d_nhwc_dgrad const&                                      dgrad,
+                                uint32_t                                                      row,
+                                uint32_t                                                      col);
+
+    //! Loads a matrix_a fragment of the im2col matrix of one group of a grouped 2D convolution, gathered on the fly
+    //! from the channels of the group in the NHWC input.
+    //! Elements that fall in the padding, or beyond M or K, are not read and are zero-filled.
+    //! @param frag Fragment of type matrix_a with its associated block sizes and data type. The layout must be row_major.
+    //! @param input Data pointer to the first channel of the group in the NHWC input tensor in global memory, e.g.
+    //! input + g * cg for group g
+    //! @param conv Grouped convolution geometry
+    //! @param row Fragment origin in M, the output pixel index
+    //! @param col Fragment origin in K, the filter tap index within the group
+    //! @tparam BlockM/N/K Block dimensions
+    //! @tparam DataT Datatype
+    //! @note Vectors are loaded whole when cg is a multiple of the vector width, and element-wise otherwise.
+    template <uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename DataT>
+    ROCWMMA_DEVICE void
+        load_matrix_im2col_sync(fragment<matrix_a, BlockM, BlockN, BlockK, DataT, row_major>& frag,
+                                const DataT*                                                  input,
+                                conv2d_nhwc_grouped const&                                    conv,
+                                uint32_t                                                      row,
+                                uint32_t                                                      col);
+
+    //! Loads a matrix_a fragment whose rows are gathered from the data pointer through an index array, such that
+    //! row i of the fragment is row rowIndices[i] of the source matrix. E.g. MoE token routing or embedding lookups
+    //! can feed the GEMM directly, without an explicit permute copy. Data pointer may point to either local or global memory.
+    //! Rows with a negative index are not read and are zero-filled.
+    //! @param frag Fragment of type matrix_a with its associated block sizes, data type and layout
+    //! @param data Data pointer to the first column (K origin) of the source matrix
+    //! @param rowIndices Pointer to the BlockM source row indices of the fragment
+    //! @param ldm Leading dimension size of the source matrix
+    //! @tparam BlockM/N/K Block dimensions
+    //! @tparam DataT Datatype
+    //! @tparam DataLayoutT In-memory layout as col_major or row_major
+    //! @note Vectors are loaded whole in row_major layout, and element-wise in col_major layout.
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void load_matrix_gather_sync(
+        fragment<matrix_a, BlockM, BlockN, BlockK, DataT, DataLayoutT>& frag,
+        const DataT*                                                    data,
+        const index_t*                                                  rowIndices,
+        uint32_t                                                        ldm);
+
+    //! Loads the fragment from a strided tensor through its matrix view, such that row and column modes are folded into
+    //! the matrix coordinates of each element in the address calculation, rather than permuting the tensor beforehand.
+    //! Elements beyond the extent of the view are not read and are zero-filled.
+    //! @param frag Fragment of type MatrixT with its associated block sizes, data type and layout
+    //! @param data Data pointer to the first element of the tensor in global or local memory
+    //! @param view Matrix view of the tensor: (M x K) for matrix_a, (K x N) for matrix_b and (M x N) for accumulator
+    //! @param row Fragment origin in matrix rows
+    //! @param col Fragment origin in matrix columns
+    //! @param batch Batch index of the view
+    //! @tparam MatrixT Fragment context
+    //! @tparam BlockM/N/K Block dimensions
+    //! @tparam DataT Datatype
+    //! @tparam DataLayoutT Layout of the fragment: vectors run along the columns for row_major and along the rows for col_major
+    //! @note Vectors are loaded whole when their fastest mode in the view has a unit stride and an extent that is a multiple
+    //! of the vector width, and element-wise otherwise.
+    template <typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void load_matrix_tensor_sync(
+        fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>& frag,
+        const DataT*                                                   data,
+        tensor_view const&                                             view,
+        uint32_t                                                       row,
+        uint32_t                                                       col,
+        uint32_t                                                       batch = 0u);
+
+    //! Loads the fragment from a paged matrix, whose major vectors (rows for row_major, columns for col_major) are split
+    //! into pages of pageSize vectors located through a page table. Major index i of the matrix is vector (i % pageSize)
+    //! of page pageTable[i / pageSize]. E.g. the K and V blocks of a paged KV cache, where token i of a sequence is read
+    //! from the page pool in place, without gathering the sequence into contiguous memory.
+    //! Vectors of pages with a negative index are not read and are zero-filled.
+    //! @param frag Fragment of type matrix_a or matrix_b with its associated block sizes, data type and layout
+    //! @param data Data pointer to the first element of page 0 of the page pool, in global or local memory
+    //! @param pageTable Pointer to the page indices of the matrix
+    //! @param pageSize Number of major vectors per page
+    //! @param ldm Leading dimension size, the stride between the major vectors of a page
+    //! @param row Fragment origin in matrix rows
+    //! @param col Fragment origin in matrix columns
+    //! @tparam MatrixT Fragment context
+    //! @tparam BlockM/N/K Block dimensions
+    //! @tparam DataT Datatype
+    //! @tparam DataLayoutT In-memory layout as col_major or row_major
+    //! @note Vectors run along the minor dimension and always lie within one page, so they are loaded whole.
+    //! The page index is looked up for every vector, so pageSize need not be a multiple of the block size.
+    template <typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void load_matrix_paged_sync(
+        fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>& frag,
+        const DataT*                                                   data,
+        const index_t*                                                 pageTable,
+        uint32_t                                                       pageSize,
+        uint32_t                                                       ldm,
+        uint32_t                                                       row,
+        uint32_t                                                       col);
+
+    //! Loads the fragment from a paged matrix of quantized data, converting elements to the fragment datatype in registers.
+    //! Pages are addressed as in load_matrix_paged_sync, and data is converted as in load_matrix_dequant_sync.
+    //! E.g. the K and V blocks of a float8_t or int8_t paged KV cache, read in place into float16_t fragments.
+    //! Vectors of pages with a negative index are not read and are zero-filled.
+    //! @param frag Fragment of type matrix_a or matrix_b with its associated block sizes, data type and layout
+    //! @param data Data pointer to the first element of page 0 of the quantized page pool, in global or local memory
+    //! @param pageTable Pointer to the page indices of the matrix
+    //! @param pageSize Number of major vectors per page
+    //! @param ldm Leading dimension size, the stride between the major vectors of a page, in elements
+    //! @param row Fragment origin in matrix rows
+    //! @param col Fragment origin in matrix columns
+    //! @tparam MatrixT Fragment context
+    //! @tparam BlockM/N/K Block dimensions
+    //! @tparam DataT Datatype of the fragment
+    //! @tparam DataLayoutT In-memory layout as col_major or row_major
+    //! @tparam QuantT Datatype of the quantized data, float8_t, bfloat8_t, int8_t or int4x2_t
+    //! @note Elements are converted without scaling. Scales shared by a page, e.g. per head and page
+    //! of a KV cache, may be applied to the fragment or folded into the products it feeds.
+    //! @note For int4x2_t, data points to two elements per byte. The fragment origin and ldm must be even.
+    template <typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT,
+              typename QuantT>
+    ROCWMMA_DEVICE void load_matrix_paged_dequant_sync(
+        fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>& frag,
+        const QuantT*                                                  data,
+        const index_t*                                                 pageTable,
+        uint32_t                                                       pageSize,
+        uint32_t                                                       ldm,
+        uint32_t                                                       row,
+        uint32_t                                                       col);
+
+    //! Loads the entire fragment from global memory through buffer instructions, according to its matrix and data layout contexts.
+    //! A wave-uniform buffer resource descriptor is built from the data pointer, such that per-lane offsets are computed once
+    //! and the unrolled strides are applied as scalar offsets. This reduces VGPR usage and vector address arithmetic compared to load_matrix_sync.
+    //! @param frag Fragment of type MatrixT with its associated block sizes, data type and layout
+    //! @param data Data pointer to global memory. Must be wave-uniform.
+    //! @param ldm Leading dimension size
+    //! @tparam MatrixT Fragment context
+    //! @tparam BlockM/N/K Block dimensions
+    //! @tparam DataT Datatype
+    //! @tparam DataLayoutT In-memory layout as col_major or row_major
+    //! @note Data pointer may NOT point to local memory. Total block offsets must be less than 4GB.
+    template <typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void load_matrix_buffer_sync(
+        fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>& frag,
+        const DataT*                                                   data,
+        uint32_t                                                       ldm);
+
+    //! Loads the entire fragment from global memory through buffer instructions, with buffer range checking.
+    //! Elements at or beyond numElements from the data pointer are not read and are returned as zero by the hardware.
+    //! E.g. for a row_major block at (row, col) of an M x N matrix, numElements = (M - row) * ldm - col zero-fills the rows beyond M.
+    //! @param frag Fragment of type MatrixT with its associated block sizes, data type and layout
+    //! @param data Data pointer to global memory. Must be wave-uniform.
+    //! @param ldm Leading dimension size
+    //! @param numElements Count of valid elements from the data pointer. Must be wave-uniform.
+    //! @tparam MatrixT Fragment context
+    //! @tparam BlockM/N/K Block dimensions
+    //! @tparam DataT Datatype
+    //! @tparam DataLayoutT In-memory layout as col_major or row_major
+    //! @note Range checking is one-dimensional in memory. For two-dimensional bounds, see load_matrix_bounded_sync.
+    template <typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void load_matrix_buffer_sync(
+        fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>& frag,
+        const DataT*                                                   data,
+        uint32_t                                                       ldm,
+        uint32_t                                                       numElements);
+
+    //! Prefetches the block of the fragment from global memory into the cache ahead of its load, e.g. the K panel of
+    //! the next one or two pipeline stages. The data is not held in fragment registers and the fragment is not modified.
+    //! On gfx94x, each lane fetches one cache line through an LDS DMA load into a 256 byte shared sink, counted by vmcnt.
+    //! On gfx12, each contiguous line of the block is prefetched with s_prefetch_data. Other targets do not prefetch.
+    //! @param frag Fragment of type MatrixT with its associated block sizes, data type and layout, whose block is prefetched
+    //! @param data Data pointer to global memory. Must be wave-uniform.
+    //! @param ldm Leading dimension size
+    //! @tparam MatrixT Fragment context
+    //! @tparam BlockM/N/K Block dimensions
+    //! @tparam DataT Datatype
+    //! @tparam DataLayoutT In-memory layout as col_major or row_major
+    //! @note The block must be addressable, as for load_matrix_sync.
+    template <typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void prefetch_matrix_sync(
+        fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& frag,
+        const DataT*                                                         data,
+        uint32_t                                                             ldm);
+
+    //! Prefetches the block of the fragment from a paged matrix into the cache ahead of load_matrix_paged_sync, with the
+    //! same arguments. Vectors of pages with a negative index are not fetched. Irregular page addresses are not followed
+    //! by hardware prefetchers, so fetching the next pages one or two stages ahead hides the most latency.
+    //! @param frag Fragment of type matrix_a or matrix_b with its associated block sizes, data type and layout
+    //! @param data Data pointer to the first element of page 0 of the page pool in global memory
+    //! @param pageTable Pointer to the page indices of the matrix
+    //! @param pageSize Number of major vectors per page
+    //! @param ldm Leading dimension size, the stride between the major vectors of a page
+    //! @param row Fragment origin in matrix rows
+    //! @param col Fragment origin in matrix columns
+    //! @tparam MatrixT Fragment context
+    //! @tparam BlockM/N/K Block dimensions
+    //! @tparam DataT Datatype
+    //! @tparam DataLayoutT In-memory layout as col_major or row_major
+    template <typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void prefetch_matrix_paged_sync(
+        fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& frag,
+        const DataT*                                                         data,
+        const index_t*                                                       pageTable,
+        uint32_t                                                             pageSize,
+        uint32_t                                                             ldm,
+        uint32_t                                                             row,
+        uint32_t                                                             col);
+
     //! Stores the entire fragment to the data pointer according to its matrix and data layouts. Data pointer may point to either local or global memory.
     //! @param frag Fragment of type MatrixT with its associated block sizes, data type and layout
     //! @param data Data pointer to global/local memory
@@ -287,6 +995,237 @@ namespace rocwmma
                           uint32_t                                                ldm,
                           layout_t                                                layout);
 
+    //! Stores the entire fragment to aligned data according to its matrix and data layouts. Fragment vectors wider
+    //! than AlignBytes are stored as narrower vectors of AlignBytes, from the same register layout as store_matrix_sync.
+    //! Data pointer may point to either local or global memory.
+    //! @param data Aligned data pointer to global/local memory
+    //! @param frag Fragment of type MatrixT with its associated block sizes, data type and layout
+    //! @param ldm Leading dimension size, with ldm * sizeof(DataT) a multiple of AlignBytes
+    //! @tparam MatrixT Fragment context
+    //! @tparam BlockM/N/K Block dimensions
+    //! @tparam DataT Datatype
+    //! @tparam DataLayoutT In-memory layout as col_major or row_major
+    //! @tparam AlignBytes Alignment of data and ldm in bytes
+    template <typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT,
+              uint32_t AlignBytes>
+    ROCWMMA_DEVICE void
+        store_matrix_sync(aligned_ptr<DataT, AlignBytes>                                       data,
+                          fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& frag,
+                          uint32_t                                                             ldm);
+
+    //! Stores the entire fragment to the data pointer according to its matrix and data layouts, with a memory access policy.
+    //! Non-temporal stores suit output that is not re-read by the kernel (e.g. streaming C / D), leaving cache capacity to re-used operands.
+    //! Data pointer may point to either local or global memory. Cache policy hints have no effect on local memory.
+    //! XOR swizzled access permutes local memory addresses to avoid bank conflicts.
+    //! LDS access issues ds_read / ds_write of up to 128 bits on local memory, instead of flat accesses.
+    //! @param data Data pointer to global/local memory
+    //! @param frag Fragment of type MatrixT with its associated block sizes, data type and layout
+    //! @param ldm Leading dimension size
+    //! @tparam AccessPolicyT Access policy as cache_default, cache_non_temporal, lds_access or xor_swizzle
+    //! @tparam MatrixT Fragment context
+    //! @tparam BlockM/N/K Block dimensions
+    //! @tparam DataT Datatype
+    //! @tparam DataLayoutT in-memory layout as col_major or row_major
+    template <typename AccessPolicyT,
+              typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void
+        store_matrix_sync(DataT*                                                               data,
+                          fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& frag,
+                          uint32_t                                                             ldm);
+
+    //! Stores the fragment to the data pointer according to its matrix and data layouts, writing only elements within the valid extent of the block.
+    //! Elements outside of the valid extent are not written, so partial blocks at the ragged edges of problem sizes that are not
+    //! multiples of the block size can be stored without padding. Data pointer may point to either local or global memory.
+    //! @param data Data pointer to global/local memory
+    //! @param frag Fragment of type MatrixT with its associated block sizes, data type and layout
+    //! @param ldm Leading dimension size
+    //! @param rows Valid rows from the fragment origin in matrix space: BlockM for matrix_a and accumulator, BlockK for matrix_b
+    //! @param cols Valid columns from the fragment origin in matrix space: BlockK for matrix_a, BlockN for matrix_b and accumulator
+    //! @tparam MatrixT Fragment context
+    //! @tparam BlockM/N/K Block dimensions
+    //! @tparam DataT Datatype
+    //! @tparam DataLayoutT in-memory layout as col_major or row_major
+    //! @note Rows or cols greater than or equal to the block size are not bounded. E.g. pass the remaining problem size (M - row, ...).
+    template <typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void store_matrix_bounded_sync(
+        DataT*                                                               data,
+        fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& frag,
+        uint32_t                                                             ldm,
+        uint32_t                                                             rows,
+        uint32_t                                                             cols);
+
+    //! Stores the fragment to the data pointer, writing only elements within the valid extent of the block.
+    //! This overload provides a run-time ability to choose the data layout of the target fragment.
+    //! @param data Data pointer to global/local memory
+    //! @param frag Fragment of type MatrixT with its associated block sizes, data type and layout
+    //! @param ldm Leading dimension size
+    //! @param rows Valid rows from the fragment origin in matrix space
+    //! @param cols Valid columns from the fragment origin in matrix space
+    //! @param layout Data layout
+    //! @tparam MatrixT Fragment context
+    //! @tparam BlockM/N/K Block dimensions
+    //! @tparam DataT Datatype
+    template <typename MatrixT, uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename DataT>
+    ROCWMMA_DEVICE void
+        store_matrix_bounded_sync(DataT*                                                  data,
+                                  fragment<MatrixT, BlockM, BlockN, BlockK, DataT> const& frag,
+                                  uint32_t                                                ldm,
+                                  uint32_t                                                rows,
+                                  uint32_t                                                cols,
+                                  layout_t                                                layout);
+
+    //! Atomically adds an accumulator fragment to the data pointer according to its matrix and data layouts, instead of
+    //! overwriting the destination. E.g. split-K partial products or gradient contributions of several waves or workgroups
+    //! accumulate directly into D, without a workspace and a separate reduction pass. Data pointer must point to global memory.
+    //! 16-bit float elements are grouped in contiguous pairs for packed atomic adds (global_atomic_pk_add_f16 on gfx90a,
+    //! gfx94x and gfx12, global_atomic_pk_add_bf16 on gfx94x and gfx12), float32_t and float64_t use hardware float atomics
+    //! where available. Other architectures fall back to compare-and-swap loops.
+    //! @param data Data pointer to global memory
+    //! @param frag Fragment of type accumulator with its associated block sizes, data type and layout
+    //! @param ldm Leading dimension size
+    //! @tparam BlockM/N/K Block dimensions
+    //! @tparam DataT Datatype: float16_t, hfloat16_t, bfloat16_t, float32_t, float64_t, int32_t or uint32_t
+    //! @tparam DataLayoutT in-memory layout as col_major or row_major
+    //! @note The order of the additions is not deterministic, such that float results may differ in rounding between runs.
+    //! 16-bit data must be dword aligned, with an even ldm.
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void store_matrix_atomic_add_sync(
+        DataT*                                                                   data,
+        fragment<accumulator, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& frag,
+        uint32_t                                                                 ldm);
+
+    //! Atomically adds an accumulator fragment to the data pointer according to its matrix and data layouts.
+    //! This overload provides a run-time ability to choose the data layout of the target fragment.
+    //! @param data Data pointer to global memory
+    //! @param frag Fragment of type accumulator with its associated block sizes and data type
+    //! @param ldm Leading dimension size
+    //! @param layout Data layout
+    //! @tparam BlockM/N/K Block dimensions
+    //! @tparam DataT Datatype
+    template <uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename DataT>
+    ROCWMMA_DEVICE void store_matrix_atomic_add_sync(
+        DataT*                                                      data,
+        fragment<accumulator, BlockM, BlockN, BlockK, DataT> const& frag,
+        uint32_t                                                    ldm,
+        layout_t                                                    layout);
+
+    //! Stores an accumulator fragment whose rows are scattered to the data pointer through an index array, such that
+    //! row i of the fragment is written to row rowIndices[i] of the destination matrix. E.g. MoE expert outputs can be
+    //! written back to token order directly, without an explicit un-permute pass. Data pointer may point to either local or global memory.
+    //! Rows with a negative index are not written.
+    //! @param data Data pointer to the first column (N origin) of the destination matrix
+    //! @param frag Fragment of type accumulator with its associated block sizes, data type and layout
+    //! @param rowIndices Pointer to the BlockM destination row indices of the fragment
+    //! @param ldm Leading dimension size of the destination matrix
+    //! @tparam BlockM/N/K Block dimensions
+    //! @tparam DataT Datatype
+    //! @tparam DataLayoutT In-memory layout as col_major or row_major
+    //! @note Stores are not atomic. Valid row indices must be distinct across all concurrent stores, e.g. top-k > 1 routing
+    //! must scatter to separate outputs per k and reduce them afterwards.
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void store_matrix_scatter_sync(
+        DataT*                                                                   data,
+        fragment<accumulator, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& frag,
+        const index_t*                                                           rowIndices,
+        uint32_t                                                                 ldm);
+
+    //! Stores an accumulator fragment whose rows are scattered to the data pointer through an index array.
+    //! This overload provides a run-time ability to choose the data layout of the target fragment.
+    //! @param data Data pointer to the first column (N origin) of the destination matrix
+    //! @param frag Fragment of type accumulator with its associated block sizes and data type
+    //! @param rowIndices Pointer to the BlockM destination row indices of the fragment
+    //! @param ldm Leading dimension size of the destination matrix
+    //! @param layout Data layout
+    //! @tparam BlockM/N/K Block dimensions
+    //! @tparam DataT Datatype
+    template <uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename DataT>
+    ROCWMMA_DEVICE void store_matrix_scatter_sync(
+        DataT*                                                      data,
+        fragment<accumulator, BlockM, BlockN, BlockK, DataT> const& frag,
+        const index_t*                                              rowIndices,
+        uint32_t                                                    ldm,
+        layout_t                                                    layout);
+
+    //! Stores an accumulator fragment to a paged matrix, with the same page addressing as load_matrix_paged_sync: major index i
+    //! of the matrix (rows for row_major, columns for col_major) is vector (i % pageSize) of page pageTable[i / pageSize].
+    //! E.g. the K and V blocks of a projection GEMM written straight into the slots of a paged KV cache through the block
+    //! table of the sequence, without a separate cache write kernel re-reading K and V.
+    //! Vectors of pages with a negative index are not written.
+    //! @param data Data pointer to the first element of page 0 of the page pool, in global or local memory
+    //! @param frag Fragment of type accumulator with its associated block sizes, data type and layout
+    //! @param pageTable Pointer to the page indices of the matrix
+    //! @param pageSize Number of major vectors per page
+    //! @param ldm Leading dimension size, the stride between the major vectors of a page
+    //! @param row Fragment origin in matrix rows
+    //! @param col Fragment origin in matrix columns
+    //! @tparam BlockM/N/K Block dimensions
+    //! @tparam DataT Datatype
+    //! @tparam DataLayoutT In-memory layout as col_major or row_major
+    //! @note Vectors run along the minor dimension and always lie within one page, so they are stored whole.
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void store_matrix_paged_sync(
+        DataT*                                                                   data,
+        fragment<accumulator, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& frag,
+        const index_t*                                                           pageTable,
+        uint32_t                                                                 pageSize,
+        uint32_t                                                                 ldm,
+        uint32_t                                                                 row,
+        uint32_t                                                                 col);
+
+    //! Stores an accumulator fragment to a strided tensor through its matrix view, such that row and column modes are folded
+    //! into the matrix coordinates of each element in the address calculation, rather than permuting the tensor afterwards.
+    //! Elements beyond the extent of the view are not written.
+    //! @param data Data pointer to the first element of the tensor in global or local memory
+    //! @param frag Fragment of type accumulator with its associated block sizes, data type and layout
+    //! @param view (M x N) matrix view of the tensor
+    //! @param row Fragment origin in matrix rows
+    //! @param col Fragment origin in matrix columns
+    //! @param batch Batch index of the view
+    //! @tparam BlockM/N/K Block dimensions
+    //! @tparam DataT Datatype
+    //! @tparam DataLayoutT Layout of the fragment: vectors run along the columns for row_major and along the rows for col_major
+    //! @note Vectors are stored whole when their fastest mode in the view has a unit stride and an extent that is a multiple
+    //! of the vector width, and element-wise otherwise.
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void store_matrix_tensor_sync(
+        DataT*                                                                   data,
+        fragment<accumulator, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& frag,
+        tensor_view const&                                                       view,
+        uint32_t                                                                 row,
+        uint32_t                                                                 col,
+        uint32_t                                                                 batch = 0u);
+
     //! Performs the Multiply-Accumulate operation on the fragments A, B, C and D (D = A * B + C)
     //! @param d Accumulator output D
     //! @param a Input fragment A
@@ -312,9 +1251,344 @@ namespace rocwmma
                  fragment<matrix_b, BlockM, BlockN, BlockK, InputT, LayoutB> const&      b,
                  fragment<accumulator, BlockM, BlockN, BlockK, ComputeT, LayoutC> const& c);
 
+    //! Performs the Multiply-Accumulate operation on the fragments A, B, C and D (D = A * B + C), where C
+    //! is held in a different datatype than D, e.g. a bfloat16_t row_major C with a float32_t col_major D.
+    //! C is converted to ComputeT in registers, without a converted copy of C in memory.
+    //! @param d Accumulator output D
+    //! @param a Input fragment A
+    //! @param b Input fragment B
+    //! @param c Input accumulator fragment C
+    //! @tparam BlockM/N/K block dimensions
+    //! @tparam InputT Datatype of input frags A and B
+    //! @tparam ComputeT Datatype of accumulator fragment D
+    //! @tparam DataTC Datatype of accumulator fragment C
+    //! @tparam LayoutA/B/C/D In-memory layout of frag as col_major or row_major
+    //! @note Accumulator elements are in the same register order in any data layout, so LayoutC and LayoutD
+    //! need no transform. C and D must share a register layout: e.g. float64_t and float32_t accumulators
+    //! differ on gfx9, and are rejected at compile time.
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename InputT,
+              typename ComputeT,
+              typename DataTC,
+              typename LayoutA,
+              typename LayoutB,
+              typename LayoutC,
+              typename LayoutD>
+    ROCWMMA_DEVICE void
+        mma_sync(fragment<accumulator, BlockM, BlockN, BlockK, ComputeT, LayoutD>&     d,
+                 fragment<matrix_a, BlockM, BlockN, BlockK, InputT, LayoutA> const&    a,
+                 fragment<matrix_b, BlockM, BlockN, BlockK, InputT, LayoutB> const&    b,
+                 fragment<accumulator, BlockM, BlockN, BlockK, DataTC, LayoutC> const& c);
+
+    //! Performs the Multiply-Accumulate operation on split inputs (D = A * B + C), where A = aHi + aLo and
+    //! B = bHi + bLo as loaded by load_matrix_split_sync. Three mma are issued: aLo * bHi, aHi * bLo and
+    //! aHi * bHi, in that order such that the small terms accumulate first. The aLo * bLo term is dropped.
+    //! With bfloat16_t inputs, products carry about 16 bits of mantissa instead of 8, i.e. a relative error
+    //! near 1e-5 rather than 1e-2, at the bfloat16_t mma rate.
+    //! @param d Accumulator output D
+    //! @param aHi Input fragment of the high parts of A
+    //! @param aLo Input fragment of the low parts of A
+    //! @param bHi Input fragment of the high parts of B
+    //! @param bLo Input fragment of the low parts of B
+    //! @param c Input accumulator fragment C
+    //! @tparam BlockM/N/K block dimensions
+    //! @tparam InputT Datatype of the split input frags, e.g. bfloat16_t, or xfloat32_t on gfx940+
+    //! @tparam ComputeT Datatype of accumulator fragment C / D, e.g. float32_t
+    //! @tparam LayoutA/B/C/D In-memory layout of frag as col_major or row_major
+    //! @note Frag c = d is valid
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename InputT,
+              typename ComputeT,
+              typename LayoutA,
+              typename LayoutB,
+              typename LayoutC,
+              typename LayoutD>
+    ROCWMMA_DEVICE void
+        mma_sync_split(fragment<accumulator, BlockM, BlockN, BlockK, ComputeT, LayoutD>&       d,
+                       fragment<matrix_a, BlockM, BlockN, BlockK, InputT, LayoutA> const&      aHi,
+                       fragment<matrix_a, BlockM, BlockN, BlockK, InputT, LayoutA> const&      aLo,
+                       fragment<matrix_b, BlockM, BlockN, BlockK, InputT, LayoutB> const&      bHi,
+                       fragment<matrix_b, BlockM, BlockN, BlockK, InputT, LayoutB> const&      bLo,
+                       fragment<accumulator, BlockM, BlockN, BlockK, ComputeT, LayoutC> const& c);
+
+    //! Performs the Multiply-Accumulate operation on 4-bit integer inputs (D = A * B + C).
+    //! A and B are int8_t fragments holding one 4-bit value per element, e.g. from load_matrix_dequant_sync of int4x2_t data.
+    //! On gfx11 and gfx12, the elements are packed to eight nibbles per register for the iu4 WMMA instructions, in place of int8_t MMA.
+    //! Other targets perform mma_sync on the int8_t fragments, which holds 4-bit values exactly.
+    //! @param d Accumulator output D
+    //! @param a Input fragment A
+    //! @param b Input fragment B
+    //! @param c Input accumulator fragment C
+    //! @tparam SignedA Elements of A are signed in [-8, 7] if true, or unsigned in [0, 15] if false
+    //! @tparam SignedB Elements of B are signed in [-8, 7] if true, or unsigned in [0, 15] if false
+    //! @tparam BlockM/N/K block dimensions
+    //! @tparam LayoutA/B/C/D In-memory layout of frag as col_major or row_major
+    //! @note Frag c = d is valid
+    //! @note Elements outside of the 4-bit range are truncated on gfx11 and gfx12.
+    //! @note BlockM and BlockN must be 16. BlockK must be a multiple of 16 on gfx11, and of 32 on gfx12.
+    template <bool SignedA = true,
+              bool SignedB = true,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename LayoutA,
+              typename LayoutB,
+              typename LayoutC,
+              typename LayoutD>
+    ROCWMMA_DEVICE void
+        mma_sync_iu4(fragment<accumulator, BlockM, BlockN, BlockK, int32_t, LayoutD>&       d,
+                     fragment<matrix_a, BlockM, BlockN, BlockK, int8_t, LayoutA> const&      a,
+                     fragment<matrix_b, BlockM, BlockN, BlockK, int8_t, LayoutB> const&      b,
+                     fragment<accumulator, BlockM, BlockN, BlockK, int32_t, LayoutC> const& c);
+
+    // @cond
+    namespace detail
+    {
+        template <uint32_t BlockM,
+                  uint32_t BlockN,
+                  uint32_t BlockK,
+                  typename InputT,
+                  typename ComputeT>
+        struct NativeAccumTraits;
+
+    } // namespace detail
+    // @endcond
+
+    //! @class native_accumulator
+    //! @brief Accumulator held in the native register layout of the mma instruction, for K loops.
+    //! mma_sync with accumulator fragments converts C into the register layout of the instruction and D back
+    //! on every call: e.g. WMMA pads 16b accumulators into 32b elements, and MFMA up-converts
+    //! f16 / bf16 accumulators to f32. Accumulating into a native_accumulator converts once with to_native
+    //! before the K loop and once with from_native after it.
+    //! @tparam BlockM/N/K block dimensions
+    //! @tparam InputT Datatype of input frags A and B
+    //! @tparam ComputeT Datatype of the accumulator fragment
+    //! @note 16b accumulators are rounded to ComputeT once in from_native rather than after every mma,
+    //! such that results may differ from mma_sync in the last bits.
+    template <uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename InputT, typename ComputeT>
+    class native_accumulator
+    {
+    public:
+        using Traits = detail::NativeAccumTraits<BlockM, BlockN, BlockK, InputT, ComputeT>;
+
+        //! @returns Mutable native register storage accessor
+        ROCWMMA_DEVICE inline typename Traits::StorageT& operator*();
+        //! @returns Immutable native register storage accessor
+        ROCWMMA_DEVICE inline typename Traits::StorageT const& operator*() const;
+
+    private:
+        typename Traits::StorageT mStorage;
+    };
+
+    //! Converts the accumulator fragment C into the native accumulator.
+    //! @param acc Native accumulator output
+    //! @param c Input accumulator fragment C
+    //! @tparam BlockM/N/K block dimensions
+    //! @tparam InputT Datatype of input frags A and B
+    //! @tparam ComputeT Datatype of accumulator fragment C
+    //! @tparam LayoutC In-memory layout of frag as col_major or row_major
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename InputT,
+              typename ComputeT,
+              typename LayoutC>
+    ROCWMMA_DEVICE void
+        to_native(native_accumulator<BlockM, BlockN, BlockK, InputT, ComputeT>&     acc,
+                  fragment<accumulator, BlockM, BlockN, BlockK, ComputeT, LayoutC> const& c);
+
+    //! Converts the native accumulator back into the accumulator fragment D.
+    //! @param d Accumulator fragment output D
+    //! @param acc Native accumulator input
+    //! @tparam BlockM/N/K block dimensions
+    //! @tparam InputT Datatype of input frags A and B
+    //! @tparam ComputeT Datatype of accumulator fragment D
+    //! @tparam LayoutD In-memory layout of frag as col_major or row_major
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename InputT,
+              typename ComputeT,
+              typename LayoutD>
+    ROCWMMA_DEVICE void
+        from_native(fragment<accumulator, BlockM, BlockN, BlockK, ComputeT, LayoutD>&   d,
+                    native_accumulator<BlockM, BlockN, BlockK, InputT, ComputeT> const& acc);
+
+    //! Performs the Multiply-Accumulate operation in place on the native accumulator (acc = A * B + acc)
+    //! @param acc Native accumulator input / output
+    //! @param a Input fragment A
+    //! @param b Input fragment B
+    //! @tparam BlockM/N/K block dimensions
+    //! @tparam InputT Datatype of input frags A and B
+    //! @tparam ComputeT Datatype of the accumulator
+    //! @tparam LayoutA/B In-memory layout of frag as col_major or row_major
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename InputT,
+              typename ComputeT,
+              typename LayoutA,
+              typename LayoutB>
+    ROCWMMA_DEVICE void
+        mma_sync(native_accumulator<BlockM, BlockN, BlockK, InputT, ComputeT>& acc,
+                 fragment<matrix_a, BlockM, BlockN, BlockK, InputT, LayoutA> const& a,
+                 fragment<matrix_b, BlockM, BlockN, BlockK, InputT, LayoutB> const& b);
+
+    //! @class chunked_accumulator
+    //! @brief Mixed precision accumulator for long K loops. mma_sync accumulates into a 16b chunk fragment of ChunkT,
+    //! which is promoted and added to a float32_t master fragment every ChunkK calls. The rounding error of 16b
+    //! accumulation grows with the number of accumulated blocks: bounding it to ChunkK blocks keeps results close to
+    //! float32_t accumulation for long K, e.g. K = 16384 in chunks of 8 blocks.
+    //! @tparam BlockM/N/K block dimensions
+    //! @tparam InputT Datatype of input frags A and B
+    //! @tparam ChunkT Datatype of the chunk accumulator, e.g. float16_t or bfloat16_t
+    //! @tparam ChunkK Number of mma_sync calls accumulated in the chunk between folds
+    //! @note Initialize with to_chunked before the K loop. The chunk and the master fragment are both live in it.
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename InputT,
+              typename ChunkT,
+              uint32_t ChunkK>
+    class chunked_accumulator
+    {
+    public:
+        using FragChunk  = fragment<accumulator, BlockM, BlockN, BlockK, ChunkT>;
+        using FragMaster = fragment<accumulator, BlockM, BlockN, BlockK, float32_t>;
+
+        //! @returns Mutable chunk accumulator accessor
+        ROCWMMA_DEVICE inline FragChunk& chunk();
+        //! @returns Immutable chunk accumulator accessor
+        ROCWMMA_DEVICE inline FragChunk const& chunk() const;
+
+        //! @returns Mutable master accumulator accessor
+        ROCWMMA_DEVICE inline FragMaster& master();
+        //! @returns Immutable master accumulator accessor
+        ROCWMMA_DEVICE inline FragMaster const& master() const;
+
+        //! @returns Mutable count of the mma_sync calls accumulated in the chunk
+        ROCWMMA_DEVICE inline uint32_t& count();
+        //! @returns Immutable count of the mma_sync calls accumulated in the chunk
+        ROCWMMA_DEVICE inline uint32_t const& count() const;
+
+    private:
+        FragChunk  mChunk;
+        FragMaster mMaster;
+        uint32_t   mCount;
+    };
+
+    //! Initializes the chunked accumulator with the accumulator fragment C in the master, and an empty chunk.
+    //! @param acc Chunked accumulator output
+    //! @param c Input accumulator fragment C
+    //! @tparam BlockM/N/K block dimensions
+    //! @tparam InputT Datatype of input frags A and B
+    //! @tparam ChunkT Datatype of the chunk accumulator
+    //! @tparam ChunkK Number of mma_sync calls accumulated in the chunk between folds
+    //! @tparam LayoutC In-memory layout of frag as col_major or row_major
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename InputT,
+              typename ChunkT,
+              uint32_t ChunkK,
+              typename LayoutC>
+    ROCWMMA_DEVICE void
+        to_chunked(chunked_accumulator<BlockM, BlockN, BlockK, InputT, ChunkT, ChunkK>&     acc,
+                   fragment<accumulator, BlockM, BlockN, BlockK, float32_t, LayoutC> const& c);
+
+    //! Adds the chunk to the master accumulator in float32_t, and empties the chunk.
+    //! mma_sync folds every ChunkK calls: an explicit fold is only needed to read a partial chunk from the master.
+    //! @param acc Chunked accumulator input / output
+    //! @tparam BlockM/N/K block dimensions
+    //! @tparam InputT Datatype of input frags A and B
+    //! @tparam ChunkT Datatype of the chunk accumulator
+    //! @tparam ChunkK Number of mma_sync calls accumulated in the chunk between folds
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename InputT,
+              typename ChunkT,
+              uint32_t ChunkK>
+    ROCWMMA_DEVICE void
+        fold_chunked(chunked_accumulator<BlockM, BlockN, BlockK, InputT, ChunkT, ChunkK>& acc);
+
+    //! Returns the sum of the master accumulator and the chunk in the accumulator fragment D.
+    //! @param d Accumulator fragment output D
+    //! @param acc Chunked accumulator input
+    //! @tparam BlockM/N/K block dimensions
+    //! @tparam InputT Datatype of input frags A and B
+    //! @tparam ChunkT Datatype of the chunk accumulator
+    //! @tparam ChunkK Number of mma_sync calls accumulated in the chunk between folds
+    //! @tparam LayoutD In-memory layout of frag as col_major or row_major
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename InputT,
+              typename ChunkT,
+              uint32_t ChunkK,
+              typename LayoutD>
+    ROCWMMA_DEVICE void from_chunked(
+        fragment<accumulator, BlockM, BlockN, BlockK, float32_t, LayoutD>&         d,
+        chunked_accumulator<BlockM, BlockN, BlockK, InputT, ChunkT, ChunkK> const& acc);
+
+    //! Performs the Multiply-Accumulate operation into the chunk of the chunked accumulator (chunk = A * B + chunk),
+    //! and folds the chunk into the master accumulator after every ChunkK calls.
+    //! @param acc Chunked accumulator input / output
+    //! @param a Input fragment A
+    //! @param b Input fragment B
+    //! @tparam BlockM/N/K block dimensions
+    //! @tparam InputT Datatype of input frags A and B
+    //! @tparam ChunkT Datatype of the chunk accumulator
+    //! @tparam ChunkK Number of mma_sync calls accumulated in the chunk between folds
+    //! @tparam LayoutA/B In-memory layout of frag as col_major or row_major
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename InputT,
+              typename ChunkT,
+              uint32_t ChunkK,
+              typename LayoutA,
+              typename LayoutB>
+    ROCWMMA_DEVICE void
+        mma_sync(chunked_accumulator<BlockM, BlockN, BlockK, InputT, ChunkT, ChunkK>& acc,
+                 fragment<matrix_a, BlockM, BlockN, BlockK, InputT, LayoutA> const&   a,
+                 fragment<matrix_b, BlockM, BlockN, BlockK, InputT, LayoutB> const&   b);
+
     //! Synchronization point for all wavefronts in a workgroup. Guarantees pending reads / writes to LDS are flushed.
     ROCWMMA_DEVICE void synchronize_workgroup();
 
+    //! Synchronization point for all workgroups in the grid, e.g. between the phases of a persistent kernel. Global
+    //! memory writes of every workgroup before the barrier are visible to every workgroup after it.
+    //! Must be called by all threads of all workgroups, which must be resident at once: launch with
+    //! hipLaunchCooperativeKernel, or with at most the resident workgroups of get_launch_occupancy.
+    //! @param barrier Counter in global memory, zeroed once before the first launch. It returns to an equivalent
+    //! state after each barrier, such that it is reused by later barriers and launches of the same grid size.
+    ROCWMMA_DEVICE void synchronize_grid(uint32_t* barrier);
+
+    //! Arrives on a counter shared by workgroups, e.g. to elect the last of the workgroups contributing to a result.
+    //! Global memory writes of the workgroup before the call are released at agent scope, and the writes released
+    //! by the earlier arrivals are acquired. Must be called by all threads of the workgroup.
+    //! @param counter Counter in global memory, incremented once per workgroup
+    //! @returns The number of earlier arrivals, in all threads of the workgroup
+    ROCWMMA_DEVICE uint32_t arrive_workgroup_counter(uint32_t* counter);
+
+    //! Sets a flag for workgroups waiting on it with wait_workgroup_flag. Global memory writes of the workgroup
+    //! before the call are released at agent scope. Must be called by all threads of the workgroup.
+    //! @param flag Flag in global memory
+    //! @param value Value to set, e.g. a monotonic epoch per phase, such that the flag does not need resetting
+    ROCWMMA_DEVICE void signal_workgroup_flag(uint32_t* flag, uint32_t value);
+
+    //! Waits until a flag reaches at least value, after which the writes released by the signalling workgroup are
+    //! visible to the workgroup. Must be called by all threads of the workgroup.
+    //! @param flag Flag in global memory
+    //! @param value Value to wait for
+    //! @note The signalling workgroup must be resident or already finished, otherwise the wait never completes.
+    ROCWMMA_DEVICE void wait_workgroup_flag(uint32_t const* flag, uint32_t value);
+
     /** @}*/
 } // namespace rocwmma
 
@@ -50,6 +50,13 @@
 //!
 //! Fragments are stored in packed registers in optimal load / store patterns.
 //! In-register elements have no guaranteed order, which have been optimized for loading / storing efficiency.
+//!
+//! \n
+//! **load_matrix_async / wait_async**
+//!
+//! Moves data from global memory directly into LDS without staging in fragment registers where supported.
+//! Loads are issued asynchronously and return a token, which may be waited on later to overlap
+//! data movement with other work such as mma_sync.
 
 namespace rocwmma
 {
@@ -411,6 +418,254 @@ namespace rocwmma
         uint32_t                                                             ldm,
         uint32_t                                                             waveIndex);
 
+    //! Loads the fragment from memory address cooperatively across wavefronts, with a memory access policy.
+    //! Otherwise identical to load_matrix_coop_sync with runtime waveIndex and waveCount.
+    //! Non-temporal loads suit data that is read once, leaving cache capacity to the operand that is re-used.
+    //! Cache policy hints have no effect on local memory.
+    //! XOR swizzled access permutes local memory addresses to avoid bank conflicts.
+    //! LDS access issues ds_read / ds_write of up to 128 bits on local memory, instead of flat accesses.
+    //!
+    //! @param frag Fragment of type MatrixT with its associated block sizes, data type and layout
+    //! @param data Data pointer to global/local memory
+    //! @param ldm Leading dimension size
+    //! @param waveIndex Index assignment of current wave in collaboration
+    //! @param waveCount Number of waves assigned for collaboration
+    //! @tparam AccessPolicyT Access policy as cache_default, cache_non_temporal, lds_access or xor_swizzle
+    //! @tparam MatrixT fragment context
+    //! @tparam BlockM/N/K block dimensions
+    //! @tparam DataT data type
+    //! @tparam DataLayoutT in-memory layout as col_major or row_major
+    template <typename AccessPolicyT,
+              typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void
+        load_matrix_coop_sync(fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>& frag,
+                              const DataT*                                                   data,
+                              uint32_t                                                       ldm,
+                              uint32_t waveIndex,
+                              uint32_t waveCount);
+
+    //! Loads the fragment from memory address cooperatively across wavefronts, with a memory access policy.
+    //! Otherwise identical to load_matrix_coop_sync with compile-time WaveCount.
+    //! Non-temporal loads suit data that is read once, leaving cache capacity to the operand that is re-used.
+    //! Cache policy hints have no effect on local memory.
+    //! XOR swizzled access permutes local memory addresses to avoid bank conflicts.
+    //! LDS access issues ds_read / ds_write of up to 128 bits on local memory, instead of flat accesses.
+    //!
+    //! @param frag Fragment of type MatrixT with its associated block sizes, data type and layout
+    //! @param data Data pointer to global/local memory
+    //! @param ldm Leading dimension size
+    //! @param waveIndex Index assignment of current wave in collaboration
+    //! @tparam AccessPolicyT Access policy as cache_default, cache_non_temporal, lds_access or xor_swizzle
+    //! @tparam WaveCount Number of waves participating
+    //! @tparam MatrixT fragment context
+    //! @tparam BlockM/N/K block dimensions
+    //! @tparam DataT data type
+    //! @tparam DataLayoutT in-memory layout as col_major or row_major
+    template <typename AccessPolicyT,
+              uint32_t WaveCount,
+              typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void
+        load_matrix_coop_sync(fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>& frag,
+                              const DataT*                                                   data,
+                              uint32_t                                                       ldm,
+                              uint32_t waveIndex);
+
+    //! Cooperative Store Matrix - Stores the entire fragment to data address cooperatively across waves, with a memory access policy.
+    //! Otherwise identical to store_matrix_coop_sync with runtime waveIndex and waveCount.
+    //! Non-temporal stores suit output that is not re-read by the kernel, leaving cache capacity to re-used operands.
+    //! Cache policy hints have no effect on local memory.
+    //! XOR swizzled access permutes local memory addresses to avoid bank conflicts.
+    //! LDS access issues ds_read / ds_write of up to 128 bits on local memory, instead of flat accesses.
+    //!
+    //! @param data Data pointer to global/local memory
+    //! @param frag Fragment of type MatrixT with its associated block sizes, data type and layout
+    //! @param ldm Leading dimension size
+    //! @param waveIndex Index assignment of current wave in collaboration
+    //! @param waveCount Number of waves assigned for collaboration
+    //! @tparam AccessPolicyT Access policy as cache_default, cache_non_temporal, lds_access or xor_swizzle
+    //! @tparam MatrixT fragment context
+    //! @tparam BlockM/N/K block dimensions
+    //! @tparam DataT data type
+    //! @tparam DataLayoutT in-memory layout as col_major or row_major
+    template <typename AccessPolicyT,
+              typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void store_matrix_coop_sync(
+        DataT*                                                               data,
+        fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& frag,
+        uint32_t                                                             ldm,
+        uint32_t                                                             waveIndex,
+        uint32_t                                                             waveCount);
+
+    //! Cooperative Store Matrix - Stores the entire fragment to data address cooperatively across waves, with a memory access policy.
+    //! Otherwise identical to store_matrix_coop_sync with compile-time WaveCount.
+    //! Non-temporal stores suit output that is not re-read by the kernel, leaving cache capacity to re-used operands.
+    //! Cache policy hints have no effect on local memory.
+    //! XOR swizzled access permutes local memory addresses to avoid bank conflicts.
+    //! LDS access issues ds_read / ds_write of up to 128 bits on local memory, instead of flat accesses.
+    //!
+    //! @param data Data pointer to global/local memory
+    //! @param frag Fragment of type MatrixT with its associated block sizes, data type and layout
+    //! @param ldm Leading dimension size
+    //! @param waveIndex Index assignment of current wave in collaboration
+    //! @tparam AccessPolicyT Access policy as cache_default, cache_non_temporal, lds_access or xor_swizzle
+    //! @tparam WaveCount Number of waves participating
+    //! @tparam MatrixT fragment context
+    //! @tparam BlockM/N/K block dimensions
+    //! @tparam DataT data type
+    //! @tparam DataLayoutT in-memory layout as col_major or row_major
+    template <typename AccessPolicyT,
+              uint32_t WaveCount,
+              typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void store_matrix_coop_sync(
+        DataT*                                                               data,
+        fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& frag,
+        uint32_t                                                             ldm,
+        uint32_t                                                             waveIndex);
+
+    //! Loads the fragment cooperatively across wavefronts from data of another datatype, converting elements to the
+    //! fragment datatype in registers. Otherwise identical to load_matrix_coop_sync with runtime waveIndex and waveCount.
+    //! Data is read with the matrix and data layouts of the fragment, at the size of SrcT.
+    //! E.g. float32_t operands are staged into LDS as float16_t, bfloat16_t or float8_t fragments for the mma_sync of
+    //! that type, without a separate conversion pass through global memory.
+    //!
+    //! @param frag Fragment of type MatrixT with its associated block sizes, data type and layout
+    //! @param data Data pointer to global/local memory, of datatype SrcT
+    //! @param ldm Leading dimension size, in elements
+    //! @param waveIndex Index assignment of current wave in collaboration
+    //! @param waveCount Number of waves assigned for collaboration
+    //! @tparam MatrixT fragment context
+    //! @tparam BlockM/N/K block dimensions
+    //! @tparam DataT data type of the fragment
+    //! @tparam DataLayoutT in-memory layout as col_major or row_major
+    //! @tparam SrcT data type in memory, e.g. float32_t
+    //! @note Vectors are converted with the packed conversion instructions of the target where available,
+    //! with round to nearest even. The fragment may be written to LDS with store_matrix_coop_sync.
+    template <typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT,
+              typename SrcT>
+    ROCWMMA_DEVICE void load_matrix_coop_convert_sync(
+        fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>& frag,
+        const SrcT*                                                    data,
+        uint32_t                                                       ldm,
+        uint32_t                                                       waveIndex,
+        uint32_t                                                       waveCount);
+
+    //! Loads the fragment cooperatively across wavefronts from data of another datatype, converting elements to the
+    //! fragment datatype in registers. Otherwise identical to load_matrix_coop_sync with compile-time WaveCount.
+    //!
+    //! @param frag Fragment of type MatrixT with its associated block sizes, data type and layout
+    //! @param data Data pointer to global/local memory, of datatype SrcT
+    //! @param ldm Leading dimension size, in elements
+    //! @param waveIndex Index assignment of current wave in collaboration
+    //! @tparam WaveCount Number of waves participating
+    //! @tparam MatrixT fragment context
+    //! @tparam BlockM/N/K block dimensions
+    //! @tparam DataT data type of the fragment
+    //! @tparam DataLayoutT in-memory layout as col_major or row_major
+    //! @tparam SrcT data type in memory, e.g. float32_t
+    template <uint32_t WaveCount,
+              typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT,
+              typename SrcT>
+    ROCWMMA_DEVICE void load_matrix_coop_convert_sync(
+        fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>& frag,
+        const SrcT*                                                    data,
+        uint32_t                                                       ldm,
+        uint32_t                                                       waveIndex);
+
+    //! @struct async_token
+    //! @brief Handle to the asynchronous loads issued by the current wave in a single call to load_matrix_async.
+    //! The issue count is known at compile time, such that waiting on the token may leave more recently issued
+    //! asynchronous loads in flight.
+    //! @tparam IssueCount Count of asynchronous memory instructions issued by the current wave.
+    //! A count of zero indicates the loads have already completed at issue time.
+    template <uint32_t IssueCount>
+    struct async_token
+    {
+        constexpr static uint32_t issue_count = IssueCount;
+    };
+
+    //! Asynchronously loads the block of data described by the fragment from global memory directly into LDS,
+    //! cooperatively across wavefronts. Data is not staged in fragment registers where supported by
+    //! the hardware (global_load_lds on gfx94x). Other targets fall back to a register staged copy
+    //! that is complete on return.
+    //!
+    //! The LDS destination is densely packed in the fragment's data layout, such that the
+    //! leading dimension equals the contiguous block extent: fragment height for col_major,
+    //! and fragment width for row_major. Once the load is complete and visible to the workgroup,
+    //! it may be consumed with load_matrix_sync using the same leading dimension.
+    //!
+    //! Work items are assigned in round robin fashion to waves in the range of [0, WaveCount).
+    //! Every cooperating wave issues the same amount of work, so each wave in [0, WaveCount)
+    //! must make this call.
+    //!
+    //! @param frag Fragment describing the block geometry, data type and data layout. Fragment data is not modified.
+    //! @param ldsData Data pointer to local memory (LDS) destination
+    //! @param data Data pointer to global memory source
+    //! @param ldm Leading dimension size of the global source
+    //! @param waveIndex Index assignment of current wave in collaboration
+    //! @tparam WaveCount Number of waves participating
+    //! @tparam MatrixT fragment context
+    //! @tparam BlockM/N/K block dimensions
+    //! @tparam DataT data type
+    //! @tparam DataLayoutT in-memory layout as col_major or row_major
+    //! @returns async_token to wait on with wait_async
+    //! @note Global source and leading dimension must be dword aligned. Completion is per-wave:
+    //! waves must wait on their own tokens and then synchronize_workgroup before reading LDS data
+    //! written by other waves.
+    template <uint32_t WaveCount,
+              typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE inline auto
+        load_matrix_async(fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& frag,
+                          DataT*                                                               ldsData,
+                          const DataT*                                                         data,
+                          uint32_t                                                             ldm,
+                          uint32_t waveIndex);
+
+    //! Waits for the asynchronous loads tracked by token to complete in the current wave.
+    //! Asynchronous loads issued after token and tracked by pending tokens are permitted to remain in flight.
+    //! @param token Token of the asynchronous load to complete
+    //! @param pending Tokens of the asynchronous loads issued after token, which may remain in flight
+    //! @tparam IssueCount Instruction count tracked by token
+    //! @tparam PendingCounts Instruction counts tracked by pending tokens
+    //! @note Uses the s_waitcnt vmcnt counter. Waits are conservative in the presence of other global memory operations.
+    template <uint32_t IssueCount, uint32_t... PendingCounts>
+    ROCWMMA_DEVICE inline void wait_async(async_token<IssueCount> const& token,
+                                          async_token<PendingCounts> const&... pending);
+
 } // namespace rocwmma
 
 #include "rocwmma_coop_impl.hpp"
@@ -26,6 +26,7 @@
 #ifndef ROCWMMA_COOP_API_IMPL_HPP
 #define ROCWMMA_COOP_API_IMPL_HPP
 
+#include "internal/async_load.hpp"
 #include "internal/coop_io_config.hpp"
 #include "internal/coop_load.hpp"
 #include "internal/coop_store.hpp"
@@ -284,6 +285,243 @@ namespace rocwmma
         Storer::template exec<WaveCount>(data, frag.mAccess, ldm, waveIndex);
     }
 
+    template <typename AccessPolicyT,
+              typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void
+        load_matrix_coop_sync(fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>& frag,
+                              const DataT*                                                   data,
+                              uint32_t                                                       ldm,
+                              uint32_t waveIndex,
+                              uint32_t waveCount)
+    {
+        using FragT  = decay_t<decltype(frag)>;
+        using Loader = typename GetCoopIOConfig_t<FragT>::template PolicyLoader<AccessPolicyT>;
+
+        // Sanity checks
+        static_assert(!is_same<DataLayoutT, void>::value,
+                      "Must provide layout information. Statically assign data layout in "
+                      "fragment declaration to use access policy loads.");
+
+        static_assert(
+            is_same<typename FragT::Traits::AccessT, typename Loader::Traits::OutputT>::value,
+            "Fragment access and coop load output types do not match");
+
+        // Load and implicit pack
+        // Note: the frag will only be partially filled with useful data.
+        // Layout and thread locality is not guaranteed.
+        Loader::exec(frag.mAccess, data, ldm, waveIndex, waveCount);
+    }
+
+    template <typename AccessPolicyT,
+              uint32_t WaveCount,
+              typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void
+        load_matrix_coop_sync(fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>& frag,
+                              const DataT*                                                   data,
+                              uint32_t                                                       ldm,
+                              uint32_t waveIndex)
+    {
+        using FragT = decay_t<decltype(frag)>;
+        using Loader =
+            typename GetCoopIOConfig_t<FragT, WaveCount>::template PolicyLoader<AccessPolicyT>;
+
+        // Sanity checks
+        static_assert(!is_same<DataLayoutT, void>::value,
+                      "Must provide layout information. Statically assign data layout in "
+                      "fragment declaration to use access policy loads.");
+
+        static_assert(
+            is_same<typename FragT::Traits::AccessT, typename Loader::Traits::OutputT>::value,
+            "Fragment access and coop load output types do not match");
+
+        // Load and implicit pack
+        // Note: the frag will only be partially filled with useful data.
+        // Layout and thread locality is not guaranteed.
+        Loader::template exec<WaveCount>(frag.mAccess, data, ldm, waveIndex);
+    }
+
+    template <typename AccessPolicyT,
+              typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void store_matrix_coop_sync(
+        DataT*                                                               data,
+        fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& frag,
+        uint32_t                                                             ldm,
+        uint32_t                                                             waveIndex,
+        uint32_t                                                             waveCount)
+    {
+        using FragT  = decay_t<decltype(frag)>;
+        using Storer = typename GetCoopIOConfig_t<FragT>::template PolicyStorer<AccessPolicyT>;
+
+        // Sanity checks
+        static_assert(!is_same<DataLayoutT, void>::value,
+                      "Must provide data layout. Statically assign data layout in "
+                      "fragment declaration to use access policy stores.");
+
+        static_assert(
+            is_same<typename FragT::Traits::AccessT, typename Storer::Traits::InputT>::value,
+            "Fragment access and coop store input types do not match");
+
+        // Implicit unpack and store
+        // Note: the frag is only be partially filled with useful data.
+        // Layout and thread locality is not guaranteed.
+        Storer::exec(data, frag.mAccess, ldm, waveIndex, waveCount);
+    }
+
+    template <typename AccessPolicyT,
+              uint32_t WaveCount,
+              typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void store_matrix_coop_sync(
+        DataT*                                                               data,
+        fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& frag,
+        uint32_t                                                             ldm,
+        uint32_t                                                             waveIndex)
+    {
+        using FragT = decay_t<decltype(frag)>;
+        using Storer =
+            typename GetCoopIOConfig_t<FragT, WaveCount>::template PolicyStorer<AccessPolicyT>;
+
+        // Sanity checks
+        static_assert(!is_same<DataLayoutT, void>::value,
+                      "Must provide data layout. Statically assign data layout in "
+                      "fragment declaration to use access policy stores.");
+
+        static_assert(
+            is_same<typename FragT::Traits::AccessT, typename Storer::Traits::InputT>::value,
+            "Fragment access and coop store input types do not match");
+
+        // Implicit unpack and store
+        // Note: the frag is only be partially filled with useful data.
+        // Layout and thread locality is not guaranteed.
+        Storer::template exec<WaveCount>(data, frag.mAccess, ldm, waveIndex);
+    }
+
+    template <typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT,
+              typename SrcT>
+    ROCWMMA_DEVICE void load_matrix_coop_convert_sync(
+        fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>& frag,
+        const SrcT*                                                    data,
+        uint32_t                                                       ldm,
+        uint32_t                                                       waveIndex,
+        uint32_t                                                       waveCount)
+    {
+        using FragT  = decay_t<decltype(frag)>;
+        using Loader = typename GetCoopIOConfig_t<FragT>::template ConvertLoader<SrcT>;
+
+        // Sanity checks
+        static_assert(!is_same<DataLayoutT, void>::value,
+                      "Must provide layout information. Statically assign data layout in "
+                      "fragment declaration to use converting loads.");
+
+        static_assert(
+            is_same<typename FragT::Traits::AccessT, typename Loader::Traits::OutputT>::value,
+            "Fragment access and coop load output types do not match");
+
+        // Load, convert and implicit pack
+        // Note: the frag will only be partially filled with useful data.
+        // Layout and thread locality is not guaranteed.
+        Loader::exec(frag.mAccess, data, ldm, waveIndex, waveCount);
+    }
+
+    template <uint32_t WaveCount,
+              typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT,
+              typename SrcT>
+    ROCWMMA_DEVICE void load_matrix_coop_convert_sync(
+        fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>& frag,
+        const SrcT*                                                    data,
+        uint32_t                                                       ldm,
+        uint32_t                                                       waveIndex)
+    {
+        using FragT  = decay_t<decltype(frag)>;
+        using Loader = typename GetCoopIOConfig_t<FragT, WaveCount>::template ConvertLoader<SrcT>;
+
+        // Sanity checks
+        static_assert(!is_same<DataLayoutT, void>::value,
+                      "Must provide layout information. Statically assign data layout in "
+                      "fragment declaration to use converting loads.");
+
+        static_assert(
+            is_same<typename FragT::Traits::AccessT, typename Loader::Traits::OutputT>::value,
+            "Fragment access and coop load output types do not match");
+
+        // Load, convert and implicit pack
+        // Note: the frag will only be partially filled with useful data.
+        // Layout and thread locality is not guaranteed.
+        Loader::template exec<WaveCount>(frag.mAccess, data, ldm, waveIndex);
+    }
+
+    template <uint32_t WaveCount,
+              typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE inline auto
+        load_matrix_async(fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& frag,
+                          DataT*                                                               ldsData,
+                          const DataT*                                                         data,
+                          uint32_t                                                             ldm,
+                          uint32_t waveIndex)
+    {
+        using FragT   = decay_t<decltype(frag)>;
+        using IOShape = GetIOShape_t<FragT>;
+        using Loader
+            = AsyncLoad<IOShape::BlockHeight, IOShape::BlockWidth, DataT, DataLayoutT, WaveCount>;
+
+        // Sanity checks
+        static_assert(!is_same<DataLayoutT, void>::value,
+                      "Must provide layout information. Statically assign data layout in "
+                      "fragment declaration.");
+
+        Loader::exec(ldsData, data, ldm, waveIndex);
+
+        // Fallback loads are complete on return
+        return async_token<(Loader::Traits::IsDirect ? Loader::Traits::IssueCount : 0u)>{};
+    }
+
+    template <uint32_t IssueCount, uint32_t... PendingCounts>
+    ROCWMMA_DEVICE inline void wait_async(async_token<IssueCount> const& token,
+                                          async_token<PendingCounts> const&... pending)
+    {
+        if constexpr(IssueCount > 0u)
+        {
+            // Loads complete in order. Later loads may remain in flight.
+            // Only vmcnt is waited on, lgkmcnt is left at its maximum.
+            constexpr uint32_t Pending = (0u + ... + PendingCounts);
+            Waitcnt<(Pending < 63u ? Pending : 63u), 15>::exec();
+        }
+    }
+
 } // namespace rocwmma
 
 #endif // ROCWMMA_COOP_API_IMPL_HPP
@@ -0,0 +1,175 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_DISPATCH_API_HPP
+#define ROCWMMA_DISPATCH_API_HPP
+
+#if !defined(__HIPCC_RTC__)
+#include <utility>
+#include <vector>
+#endif // !__HIPCC_RTC__
+
+#include "rocwmma.hpp"
+
+//! rocWMMA dispatch API selects host-side variants by the architecture of the device.
+//!
+//! A binary built for several --offload-arch targets carries a code object for each of them,
+//! but template configs valid on one target may not compile or perform on another, e.g.
+//! 32 x 32 mma blocks on gfx11. Host code registers one variant per arch (or arch family) of
+//! a kernel launcher, each instantiated with the config of its target, and resolves the
+//! variant of the device at runtime:
+//!
+//!     arch_dispatch<void (*)(Args const&)> dispatch;
+//!     dispatch.add_each<Constants::AMDGCN_ARCH_ID_GFX90A, Constants::AMDGCN_ARCH_ID_GFX942>(
+//!                 [](auto archId) { return &launch<warp_tile_config<archId, float16_t>>; })
+//!             .add_family(arch_family_gfx11, &launch_wave32)
+//!             .add_fallback(&launch_generic);
+//!
+//!     if(auto variant = dispatch.resolve_device()) { (*variant)(args); }
+//!
+//! Variants are resolved in order of specificity: the variant of the exact arch, then the
+//! variant of its family, then the fallback. Resolving queries the device properties, so
+//! launchers should resolve once per device and keep the variant.
+//!
+//! Launchers sizing persistent grids query the occupancy of the resolved kernel on the
+//! device, with the resource that limits it:
+//!
+//!     auto occupancy = get_launch_occupancy(kernel, blockSize, ldsBytes);
+//!     auto gridDim   = dim3(min(occupancy.resident_blocks(), tileCount));
+
+namespace rocwmma
+{
+    //! @enum arch_family_t
+    //! @brief Architecture families sharing an mma instruction set and wave size
+    enum arch_family_t : uint32_t
+    {
+        arch_family_none = 0u,
+        arch_family_gfx9, // gfx908, gfx90a, gfx940, gfx941, gfx942: wave64 mfma
+        arch_family_gfx11, // gfx1100, gfx1101, gfx1102: wave32 wmma
+        arch_family_gfx12, // gfx1200, gfx1201: wave32 wmma
+    };
+
+    //! @param archId One of the Constants::AMDGCN_ARCH_ID values
+    //! @returns The family of the arch, or arch_family_none if unsupported
+    ROCWMMA_HOST_DEVICE constexpr inline arch_family_t get_arch_family(uint32_t archId);
+
+    //! @param gcnArchName Device arch name, with or without target features,
+    //! e.g. "gfx90a:sramecc+:xnack-"
+    //! @returns The Constants::AMDGCN_ARCH_ID value of the arch, or AMDGCN_ARCH_ID_NONE if
+    //! unsupported
+    ROCWMMA_HOST inline uint32_t arch_id_from_name(char const* gcnArchName);
+
+    //! @param deviceId HIP device ordinal, or negative for the current device
+    //! @returns The Constants::AMDGCN_ARCH_ID value of the device, or AMDGCN_ARCH_ID_NONE if
+    //! unsupported or the device cannot be queried
+    ROCWMMA_HOST inline uint32_t get_device_arch_id(int deviceId = -1);
+
+    //! @enum occupancy_limiter_t
+    //! @brief Resource limiting the number of resident workgroups of a kernel
+    enum occupancy_limiter_t : uint32_t
+    {
+        occupancy_limiter_none = 0u, // The occupancy could not be queried
+        occupancy_limiter_wave_slots, // Waves per CU of the workgroup size
+        occupancy_limiter_lds, // Static and dynamic LDS per workgroup
+        occupancy_limiter_registers, // VGPRs, AGPRs or SGPRs per wave
+    };
+
+    //! @struct launch_occupancy
+    //! @brief Achieved occupancy of a kernel launch configuration on a device
+    struct launch_occupancy
+    {
+        uint32_t            cu_count; // CUs (WGPs on gfx11 / gfx12) of the device
+        uint32_t            blocks_per_cu; // Resident workgroups per CU
+        float64_t           waves_per_simd; // Resident waves per SIMD
+        uint32_t            max_waves_per_simd; // Wave slots per SIMD
+        occupancy_limiter_t limiter;
+
+        //! @returns Workgroups resident at once on the device, at least one per CU: the grid
+        //! size of a single wave of persistent workgroups
+        ROCWMMA_HOST constexpr inline uint32_t resident_blocks() const;
+    };
+
+    //! @param limiter Occupancy limiter
+    //! @returns Readable name of the limiter
+    ROCWMMA_HOST constexpr inline char const* occupancy_limiter_name(occupancy_limiter_t limiter);
+
+    //! Queries the occupancy of a kernel on the current device
+    //! @param kernel Kernel function
+    //! @param blockSize Threads per workgroup
+    //! @param ldsBytes Dynamic LDS bytes per workgroup
+    //! @returns The achieved occupancy, with occupancy_limiter_none if the device or kernel
+    //! cannot be queried
+    template <typename KernelT>
+    ROCWMMA_HOST inline launch_occupancy
+        get_launch_occupancy(KernelT kernel, uint32_t blockSize, uint32_t ldsBytes = 0u);
+
+    //! @class arch_dispatch
+    //! @brief Registry of host-side variants per arch, resolved for the device at runtime
+    //! @tparam VariantT Copyable variant type, e.g. a kernel launcher function pointer
+    template <typename VariantT>
+    class arch_dispatch
+    {
+    public:
+        //! Registers the variant of one arch, replacing any previous one
+        //! @param archId One of the Constants::AMDGCN_ARCH_ID values
+        //! @param variant Variant to register
+        ROCWMMA_HOST inline arch_dispatch& add(uint32_t archId, VariantT const& variant);
+
+        //! Registers the variant of each ArchIds, make(std::integral_constant<uint32_t, ArchId>)
+        //! @tparam ArchIds Constants::AMDGCN_ARCH_ID values to register
+        //! @param make Generic callable returning the variant of an arch
+        template <uint32_t... ArchIds, typename MakeT>
+        ROCWMMA_HOST inline arch_dispatch& add_each(MakeT&& make);
+
+        //! Registers the variant of the archs of a family without a variant of their own,
+        //! replacing any previous one
+        //! @param family Arch family
+        //! @param variant Variant to register
+        ROCWMMA_HOST inline arch_dispatch& add_family(arch_family_t    family,
+                                                      VariantT const& variant);
+
+        //! Registers the variant of the archs without an arch or family variant
+        //! @param variant Variant to register
+        ROCWMMA_HOST inline arch_dispatch& add_fallback(VariantT const& variant);
+
+        //! @param archId One of the Constants::AMDGCN_ARCH_ID values
+        //! @returns The most specific variant of the arch, or nullptr if there is none
+        ROCWMMA_HOST inline VariantT const* resolve(uint32_t archId) const;
+
+        //! @param deviceId HIP device ordinal, or negative for the current device
+        //! @returns The most specific variant of the device arch, or nullptr if there is none
+        ROCWMMA_HOST inline VariantT const* resolve_device(int deviceId = -1) const;
+
+    private:
+        std::vector<std::pair<uint32_t, VariantT>>      mArchVariants;
+        std::vector<std::pair<arch_family_t, VariantT>> mFamilyVariants;
+        std::vector<VariantT>                           mFallback;
+    };
+
+} // namespace rocwmma
+
+#include "rocwmma_dispatch_impl.hpp"
+
+#endif // ROCWMMA_DISPATCH_API_HPP
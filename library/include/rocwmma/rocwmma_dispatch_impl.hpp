@@ -0,0 +1,269 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_DISPATCH_API_IMPL_HPP
+#define ROCWMMA_DISPATCH_API_IMPL_HPP
+
+#include "rocwmma_dispatch.hpp"
+
+namespace rocwmma
+{
+    ROCWMMA_HOST_DEVICE constexpr inline arch_family_t get_arch_family(uint32_t archId)
+    {
+        switch(archId)
+        {
+        case Constants::AMDGCN_ARCH_ID_GFX908:
+        case Constants::AMDGCN_ARCH_ID_GFX90A:
+        case Constants::AMDGCN_ARCH_ID_GFX940:
+        case Constants::AMDGCN_ARCH_ID_GFX941:
+        case Constants::AMDGCN_ARCH_ID_GFX942:
+            return arch_family_gfx9;
+        case Constants::AMDGCN_ARCH_ID_GFX1100:
+        case Constants::AMDGCN_ARCH_ID_GFX1101:
+        case Constants::AMDGCN_ARCH_ID_GFX1102:
+            return arch_family_gfx11;
+        case Constants::AMDGCN_ARCH_ID_GFX1200:
+        case Constants::AMDGCN_ARCH_ID_GFX1201:
+            return arch_family_gfx12;
+        default:
+            return arch_family_none;
+        }
+    }
+
+    ROCWMMA_HOST inline uint32_t arch_id_from_name(char const* gcnArchName)
+    {
+        struct ArchName
+        {
+            char const* name;
+            uint32_t    archId;
+        };
+
+        constexpr ArchName archNames[] = {{"gfx908", Constants::AMDGCN_ARCH_ID_GFX908},
+                                          {"gfx90a", Constants::AMDGCN_ARCH_ID_GFX90A},
+                                          {"gfx940", Constants::AMDGCN_ARCH_ID_GFX940},
+                                          {"gfx941", Constants::AMDGCN_ARCH_ID_GFX941},
+                                          {"gfx942", Constants::AMDGCN_ARCH_ID_GFX942},
+                                          {"gfx1100", Constants::AMDGCN_ARCH_ID_GFX1100},
+                                          {"gfx1101", Constants::AMDGCN_ARCH_ID_GFX1101},
+                                          {"gfx1102", Constants::AMDGCN_ARCH_ID_GFX1102},
+                                          {"gfx1200", Constants::AMDGCN_ARCH_ID_GFX1200},
+                                          {"gfx1201", Constants::AMDGCN_ARCH_ID_GFX1201}};
+
+        if(gcnArchName == nullptr)
+        {
+            return Constants::AMDGCN_ARCH_ID_NONE;
+        }
+
+        // The processor name ends at the first target feature, e.g. gfx90a:sramecc+:xnack-
+        for(auto const& archName : archNames)
+        {
+            uint32_t i = 0u;
+            while(archName.name[i] != '\0' && archName.name[i] == gcnArchName[i])
+            {
+                i++;
+            }
+
+            if(archName.name[i] == '\0' && (gcnArchName[i] == '\0' || gcnArchName[i] == ':'))
+            {
+                return archName.archId;
+            }
+        }
+
+        return Constants::AMDGCN_ARCH_ID_NONE;
+    }
+
+    ROCWMMA_HOST inline uint32_t get_device_arch_id(int deviceId)
+    {
+        if(deviceId < 0 && hipGetDevice(&deviceId) != hipSuccess)
+        {
+            return Constants::AMDGCN_ARCH_ID_NONE;
+        }
+
+        hipDeviceProp_t props;
+        if(hipGetDeviceProperties(&props, deviceId) != hipSuccess)
+        {
+            return Constants::AMDGCN_ARCH_ID_NONE;
+        }
+
+        return arch_id_from_name(props.gcnArchName);
+    }
+
+    ROCWMMA_HOST constexpr inline uint32_t launch_occupancy::resident_blocks() const
+    {
+        return cu_count * (blocks_per_cu > 0u ? blocks_per_cu : 1u);
+    }
+
+    ROCWMMA_HOST constexpr inline char const* occupancy_limiter_name(occupancy_limiter_t limiter)
+    {
+        switch(limiter)
+        {
+        case occupancy_limiter_wave_slots:
+            return "Waves";
+        case occupancy_limiter_lds:
+            return "LDS";
+        case occupancy_limiter_registers:
+            return "Registers";
+        default:
+            return "n/a";
+        }
+    }
+
+    template <typename KernelT>
+    ROCWMMA_HOST inline launch_occupancy
+        get_launch_occupancy(KernelT kernel, uint32_t blockSize, uint32_t ldsBytes)
+    {
+        // CUs in CU mode, or WGPs on gfx11 / gfx12, have four SIMDs
+        constexpr uint32_t SimdsPerCu = 4u;
+
+        launch_occupancy result = {0u, 0u, 0.0, 0u, occupancy_limiter_none};
+
+        int               deviceId;
+        hipDeviceProp_t   props;
+        hipFuncAttributes attributes;
+        int               blocks = 0;
+        if(blockSize == 0u || hipGetDevice(&deviceId) != hipSuccess
+           || hipGetDeviceProperties(&props, deviceId) != hipSuccess
+           || hipFuncGetAttributes(&attributes, reinterpret_cast<void const*>(kernel))
+                  != hipSuccess
+           || hipOccupancyMaxActiveBlocksPerMultiprocessor(
+                  &blocks, kernel, static_cast<int>(blockSize), ldsBytes)
+                  != hipSuccess)
+        {
+            return result;
+        }
+
+        auto waveSize      = static_cast<uint32_t>(props.warpSize);
+        auto wavesPerBlock = (blockSize + waveSize - 1u) / waveSize;
+        auto wavesPerCu    = static_cast<uint32_t>(props.maxThreadsPerMultiProcessor) / waveSize;
+        auto ldsPerBlock   = static_cast<uint32_t>(attributes.sharedSizeBytes) + ldsBytes;
+
+        // Workgroup limits of the wave slots and LDS. Registers limit whatever is left.
+        auto waveLimit = wavesPerCu / wavesPerBlock;
+        auto ldsLimit
+            = ldsPerBlock > 0u
+                  ? static_cast<uint32_t>(props.maxSharedMemoryPerMultiProcessor) / ldsPerBlock
+                  : waveLimit;
+
+        result.cu_count           = static_cast<uint32_t>(props.multiProcessorCount);
+        result.blocks_per_cu      = static_cast<uint32_t>(blocks);
+        result.waves_per_simd     = static_cast<float64_t>(result.blocks_per_cu * wavesPerBlock)
+                                    / static_cast<float64_t>(SimdsPerCu);
+        result.max_waves_per_simd = wavesPerCu / SimdsPerCu;
+
+        if(result.blocks_per_cu < (ldsLimit < waveLimit ? ldsLimit : waveLimit))
+        {
+            result.limiter = occupancy_limiter_registers;
+        }
+        else
+        {
+            result.limiter = ldsLimit < waveLimit ? occupancy_limiter_lds
+                                                  : occupancy_limiter_wave_slots;
+        }
+
+        return result;
+    }
+
+    template <typename VariantT>
+    ROCWMMA_HOST inline arch_dispatch<VariantT>&
+        arch_dispatch<VariantT>::add(uint32_t archId, VariantT const& variant)
+    {
+        for(auto& archVariant : mArchVariants)
+        {
+            if(archVariant.first == archId)
+            {
+                archVariant.second = variant;
+                return *this;
+            }
+        }
+
+        mArchVariants.emplace_back(archId, variant);
+        return *this;
+    }
+
+    template <typename VariantT>
+    template <uint32_t... ArchIds, typename MakeT>
+    ROCWMMA_HOST inline arch_dispatch<VariantT>& arch_dispatch<VariantT>::add_each(MakeT&& make)
+    {
+        (add(ArchIds, make(std::integral_constant<uint32_t, ArchIds>{})), ...);
+        return *this;
+    }
+
+    template <typename VariantT>
+    ROCWMMA_HOST inline arch_dispatch<VariantT>&
+        arch_dispatch<VariantT>::add_family(arch_family_t family, VariantT const& variant)
+    {
+        for(auto& familyVariant : mFamilyVariants)
+        {
+            if(familyVariant.first == family)
+            {
+                familyVariant.second = variant;
+                return *this;
+            }
+        }
+
+        mFamilyVariants.emplace_back(family, variant);
+        return *this;
+    }
+
+    template <typename VariantT>
+    ROCWMMA_HOST inline arch_dispatch<VariantT>&
+        arch_dispatch<VariantT>::add_fallback(VariantT const& variant)
+    {
+        mFallback.assign(1u, variant);
+        return *this;
+    }
+
+    template <typename VariantT>
+    ROCWMMA_HOST inline VariantT const* arch_dispatch<VariantT>::resolve(uint32_t archId) const
+    {
+        for(auto const& archVariant : mArchVariants)
+        {
+            if(archVariant.first == archId)
+            {
+                return &archVariant.second;
+            }
+        }
+
+        auto family = get_arch_family(archId);
+        for(auto const& familyVariant : mFamilyVariants)
+        {
+            if(family != arch_family_none && familyVariant.first == family)
+            {
+                return &familyVariant.second;
+            }
+        }
+
+        return mFallback.empty() ? nullptr : &mFallback.front();
+    }
+
+    template <typename VariantT>
+    ROCWMMA_HOST inline VariantT const* arch_dispatch<VariantT>::resolve_device(int deviceId) const
+    {
+        return resolve(get_device_arch_id(deviceId));
+    }
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_DISPATCH_API_IMPL_HPP
@@ -0,0 +1,159 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_DLRM_API_HPP
+#define ROCWMMA_DLRM_API_HPP
+
+#include <hip/hip_runtime.h>
+
+#include "rocwmma.hpp"
+
+/**
+ * rocWMMA dlrm is a complimentary API for rocWMMA, exposing the dot interaction layer of
+ * the DLRM recommender model, forward and backward, for any number of features and
+ * embedding dimension.
+ *
+ * Each sample of the batch has numFeatures feature vectors of embeddingDim elements,
+ * stored as a row major numFeatures x embeddingDim matrix X. Feature 0 is the output
+ * of the bottom MLP. The forward pass computes the pairwise dot products Z = X x X^T
+ * and writes, for each sample:
+ *  - embeddingDim elements: a copy of the bottom MLP output, feature 0
+ *  - interaction_count(numFeatures) elements: the strictly lower triangle of Z, row by row,
+ *    such that Z(i, j) with j < i is at embeddingDim + i * (i - 1) / 2 + j
+ *
+ * The backward pass takes the upstream gradient dY in the same layout and computes:
+ *  - the input gradient dX = S x X, where S is the symmetric numFeatures x numFeatures
+ *    matrix holding the interaction gradients in both triangles and zero on the diagonal
+ *  - the bottom MLP gradient, a copy of the first embeddingDim elements of dY
+ *
+ * Each wave processes one sample, over the lower triangular tiles of Z or the tiles of dX.
+ * Tiles over the edges of numFeatures and embeddingDim are loaded and stored bounded, so
+ * inputs and outputs need no padding. Products accumulate in float32_t.
+ *
+ * Usage:
+ *  - Call dot_interaction_fwd() or dot_interaction_bwd() with device pointers from the host.
+ *    Both enqueue a single kernel on the given stream.
+ *  - Alternatively, launch the kernels directly with dlrm_workgroup_size() threads per
+ *    workgroup and dlrm_workgroup_count() workgroups.
+ *
+ * Supported DataT: float16_t, bfloat16_t on all targets, float32_t on gfx9 targets.
+ */
+
+namespace rocwmma
+{
+    namespace dlrm
+    {
+        //! Waves per workgroup of the interaction kernels, one sample each
+        constexpr uint32_t DLRM_WAVE_COUNT = 4u;
+
+        //! @returns Number of pairwise interactions between numFeatures features
+        ROCWMMA_HOST_DEVICE constexpr inline uint32_t interaction_count(uint32_t numFeatures);
+
+        //! @returns Elements per sample of the forward output and backward upstream gradient,
+        //! without padding
+        ROCWMMA_HOST_DEVICE constexpr inline uint32_t output_size(uint32_t numFeatures,
+                                                                  uint32_t embeddingDim);
+
+        //! @returns Threads per workgroup for the interaction kernels, with the given wave size
+        ROCWMMA_HOST_DEVICE constexpr inline uint32_t dlrm_workgroup_size(uint32_t waveSize);
+
+        //! @returns Workgroups covering the given batch size
+        ROCWMMA_HOST_DEVICE constexpr inline uint32_t dlrm_workgroup_count(uint32_t batchSize);
+
+        //! Forward dot interaction kernel
+        //! @param input Features of each sample (batchSize x numFeatures x embeddingDim)
+        //! @param output Bottom MLP copy and interactions of each sample, outputStride apart
+        //! @param numFeatures Features per sample, including the bottom MLP output
+        //! @param embeddingDim Elements per feature
+        //! @param batchSize Number of samples
+        //! @param outputStride Elements between consecutive samples of output, at least output_size()
+        //! @tparam DataT Datatype of the input and output
+        template <typename DataT>
+        ROCWMMA_KERNEL void __launch_bounds__(DLRM_WAVE_COUNT* Constants::AMDGCN_WAVE_SIZE)
+            dot_interaction_fwd_kernel(DataT const* __restrict__ input,
+                                       DataT* __restrict__ output,
+                                       uint32_t numFeatures,
+                                       uint32_t embeddingDim,
+                                       uint32_t batchSize,
+                                       uint32_t outputStride);
+
+        //! Backward dot interaction kernel
+        //! @param input Features of each sample (batchSize x numFeatures x embeddingDim)
+        //! @param upstreamGrad Gradient of the forward output of each sample, upstreamStride apart
+        //! @param inputGrad Gradient of the features of each sample (batchSize x numFeatures x embeddingDim)
+        //! @param bottomMlpGrad Gradient of the bottom MLP output of each sample (batchSize x embeddingDim)
+        //! @param numFeatures Features per sample, including the bottom MLP output
+        //! @param embeddingDim Elements per feature
+        //! @param batchSize Number of samples
+        //! @param upstreamStride Elements between consecutive samples of upstreamGrad, at least output_size()
+        //! @tparam DataT Datatype of the inputs and outputs
+        //! @note inputGrad holds the gradient of the interactions only. The full gradient of the bottom
+        //! MLP output is the sum of bottomMlpGrad and the first row of inputGrad.
+        template <typename DataT>
+        ROCWMMA_KERNEL void __launch_bounds__(DLRM_WAVE_COUNT* Constants::AMDGCN_WAVE_SIZE)
+            dot_interaction_bwd_kernel(DataT const* __restrict__ input,
+                                       DataT const* __restrict__ upstreamGrad,
+                                       DataT* __restrict__ inputGrad,
+                                       DataT* __restrict__ bottomMlpGrad,
+                                       uint32_t numFeatures,
+                                       uint32_t embeddingDim,
+                                       uint32_t batchSize,
+                                       uint32_t upstreamStride);
+
+        //! Enqueues the forward dot interaction of the batch on the stream.
+        //! Arguments are as for dot_interaction_fwd_kernel. An outputStride of 0 selects output_size().
+        //! @returns hipErrorInvalidValue for zero numFeatures or embeddingDim, or an outputStride
+        //! smaller than output_size(), otherwise the status of the launch
+        template <typename DataT>
+        ROCWMMA_HOST inline hipError_t dot_interaction_fwd(DataT const* input,
+                                                           DataT*       output,
+                                                           uint32_t     numFeatures,
+                                                           uint32_t     embeddingDim,
+                                                           uint32_t     batchSize,
+                                                           uint32_t     outputStride = 0u,
+                                                           hipStream_t  stream       = 0);
+
+        //! Enqueues the backward dot interaction of the batch on the stream.
+        //! Arguments are as for dot_interaction_bwd_kernel. An upstreamStride of 0 selects output_size().
+        //! @returns hipErrorInvalidValue for zero numFeatures or embeddingDim, or an upstreamStride
+        //! smaller than output_size(), otherwise the status of the launch
+        template <typename DataT>
+        ROCWMMA_HOST inline hipError_t dot_interaction_bwd(DataT const* input,
+                                                           DataT const* upstreamGrad,
+                                                           DataT*       inputGrad,
+                                                           DataT*       bottomMlpGrad,
+                                                           uint32_t     numFeatures,
+                                                           uint32_t     embeddingDim,
+                                                           uint32_t     batchSize,
+                                                           uint32_t     upstreamStride = 0u,
+                                                           hipStream_t  stream         = 0);
+
+    } // namespace dlrm
+
+} // namespace rocwmma
+
+#include "rocwmma_dlrm_impl.hpp"
+
+#endif // ROCWMMA_DLRM_API_HPP
@@ -0,0 +1,380 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_DLRM_API_IMPL_HPP
+#define ROCWMMA_DLRM_API_IMPL_HPP
+
+#include "rocwmma_dlrm.hpp"
+
+namespace rocwmma
+{
+    namespace dlrm
+    {
+        // @cond
+        namespace detail
+        {
+            // Square tiles of the interaction matrix Z, and of dX
+            constexpr uint32_t TileDim = 16u;
+
+            // Tiles of dX accumulated per pass over the features in the backward kernel
+            constexpr uint32_t BwdTilesPerPass = 4u;
+
+            template <typename DataT>
+            using FragA = fragment<matrix_a, TileDim, TileDim, TileDim, DataT, row_major>;
+
+            template <typename DataT, typename DataLayoutT>
+            using FragB = fragment<matrix_b, TileDim, TileDim, TileDim, DataT, DataLayoutT>;
+
+            template <typename DataT>
+            using FragC = fragment<accumulator, TileDim, TileDim, TileDim, DataT>;
+
+            using FragAcc = fragment<accumulator, TileDim, TileDim, TileDim, float32_t>;
+
+            // Offset of interaction (row, col), col < row, within the output of one sample
+            ROCWMMA_HOST_DEVICE constexpr inline uint32_t
+                interactionOffset(uint32_t embeddingDim, uint32_t row, uint32_t col)
+            {
+                return embeddingDim + row * (row - 1u) / 2u + col;
+            }
+
+            ROCWMMA_HOST inline hipError_t hostWaveSize(uint32_t& waveSize)
+            {
+                int  device = 0;
+                int  size   = 0;
+                auto status = hipGetDevice(&device);
+                if(status == hipSuccess)
+                {
+                    status = hipDeviceGetAttribute(&size, hipDeviceAttributeWarpSize, device);
+                }
+                waveSize = static_cast<uint32_t>(size);
+                return status;
+            }
+
+        } // namespace detail
+        // @endcond
+
+        ROCWMMA_HOST_DEVICE constexpr inline uint32_t interaction_count(uint32_t numFeatures)
+        {
+            return numFeatures * (numFeatures - 1u) / 2u;
+        }
+
+        ROCWMMA_HOST_DEVICE constexpr inline uint32_t output_size(uint32_t numFeatures,
+                                                                  uint32_t embeddingDim)
+        {
+            return embeddingDim + interaction_count(numFeatures);
+        }
+
+        ROCWMMA_HOST_DEVICE constexpr inline uint32_t dlrm_workgroup_size(uint32_t waveSize)
+        {
+            return DLRM_WAVE_COUNT * waveSize;
+        }
+
+        ROCWMMA_HOST_DEVICE constexpr inline uint32_t dlrm_workgroup_count(uint32_t batchSize)
+        {
+            return (batchSize + DLRM_WAVE_COUNT - 1u) / DLRM_WAVE_COUNT;
+        }
+
+        template <typename DataT>
+        ROCWMMA_KERNEL void __launch_bounds__(DLRM_WAVE_COUNT* Constants::AMDGCN_WAVE_SIZE)
+            dot_interaction_fwd_kernel(DataT const* __restrict__ input,
+                                       DataT* __restrict__ output,
+                                       uint32_t numFeatures,
+                                       uint32_t embeddingDim,
+                                       uint32_t batchSize,
+                                       uint32_t outputStride)
+        {
+            using namespace detail;
+
+            // Accumulators are staged per wave, to scatter the lower triangle of each tile
+            __shared__ float32_t staging[DLRM_WAVE_COUNT][TileDim * TileDim];
+
+            auto waveIdx = threadIdx.x / Constants::AMDGCN_WAVE_SIZE;
+            auto laneIdx = threadIdx.x % Constants::AMDGCN_WAVE_SIZE;
+            auto sample  = blockIdx.x * DLRM_WAVE_COUNT + waveIdx;
+            bool active  = sample < batchSize;
+
+            auto m   = numFeatures;
+            auto k   = embeddingDim;
+            auto x   = input + static_cast<uint64_t>(sample) * m * k;
+            auto out = output + static_cast<uint64_t>(sample) * outputStride;
+
+            // Bottom MLP passthrough
+            for(uint32_t i = laneIdx; active && i < k; i += Constants::AMDGCN_WAVE_SIZE)
+            {
+                out[i] = x[i];
+            }
+
+            // Lower triangular tiles of Z = X x X^T, in row order. The tile
+            // sequence depends only on m, so the workgroup barriers are uniform.
+            auto     tiles   = (m + TileDim - 1u) / TileDim;
+            uint32_t tileRow = 0u;
+            uint32_t tileCol = 0u;
+            for(uint32_t t = 0; t < tiles * (tiles + 1u) / 2u; ++t)
+            {
+                auto row0 = tileRow * TileDim;
+                auto col0 = tileCol * TileDim;
+
+                if(active)
+                {
+                    FragA<DataT>            fragA;
+                    FragB<DataT, col_major> fragB;
+                    FragAcc                 fragAcc;
+                    fill_fragment(fragAcc, 0.0f);
+
+                    // X^T is the col_major view of X
+                    for(uint32_t h = 0; h < k; h += TileDim)
+                    {
+                        load_matrix_bounded_sync(fragA, x + (row0 * k + h), k, m - row0, k - h);
+                        load_matrix_bounded_sync(fragB, x + (col0 * k + h), k, k - h, m - col0);
+                        mma_sync(fragAcc, fragA, fragB, fragAcc);
+                    }
+
+                    store_matrix_sync(staging[waveIdx], fragAcc, TileDim, mem_row_major);
+                }
+
+                synchronize_workgroup();
+
+                // Scatter the strictly lower triangle
+                for(uint32_t e = laneIdx; active && e < TileDim * TileDim;
+                    e += Constants::AMDGCN_WAVE_SIZE)
+                {
+                    auto row = row0 + e / TileDim;
+                    auto col = col0 + e % TileDim;
+                    if(row < m && col < row)
+                    {
+                        out[interactionOffset(k, row, col)]
+                            = static_cast<DataT>(staging[waveIdx][e]);
+                    }
+                }
+
+                synchronize_workgroup();
+
+                // Next lower triangular tile
+                if(++tileCol > tileRow)
+                {
+                    ++tileRow;
+                    tileCol = 0u;
+                }
+            }
+        }
+
+        template <typename DataT>
+        ROCWMMA_KERNEL void __launch_bounds__(DLRM_WAVE_COUNT* Constants::AMDGCN_WAVE_SIZE)
+            dot_interaction_bwd_kernel(DataT const* __restrict__ input,
+                                       DataT const* __restrict__ upstreamGrad,
+                                       DataT* __restrict__ inputGrad,
+                                       DataT* __restrict__ bottomMlpGrad,
+                                       uint32_t numFeatures,
+                                       uint32_t embeddingDim,
+                                       uint32_t batchSize,
+                                       uint32_t upstreamStride)
+        {
+            using namespace detail;
+
+            // Tiles of S are gathered per wave from the triangle of the upstream gradient
+            __shared__ DataT staging[DLRM_WAVE_COUNT][TileDim * TileDim];
+
+            auto waveIdx = threadIdx.x / Constants::AMDGCN_WAVE_SIZE;
+            auto laneIdx = threadIdx.x % Constants::AMDGCN_WAVE_SIZE;
+            auto sample  = blockIdx.x * DLRM_WAVE_COUNT + waveIdx;
+            bool active  = sample < batchSize;
+
+            auto m  = numFeatures;
+            auto k  = embeddingDim;
+            auto x  = input + static_cast<uint64_t>(sample) * m * k;
+            auto dy = upstreamGrad + static_cast<uint64_t>(sample) * upstreamStride;
+            auto dx = inputGrad + static_cast<uint64_t>(sample) * m * k;
+
+            // Bottom MLP gradient passthrough
+            for(uint32_t i = laneIdx; active && i < k; i += Constants::AMDGCN_WAVE_SIZE)
+            {
+                bottomMlpGrad[static_cast<uint64_t>(sample) * k + i] = dy[i];
+            }
+
+            // dX = S x X, in passes of BwdTilesPerPass tiles of dX along k. The
+            // loop bounds depend only on m and k, so the workgroup barriers are uniform.
+            for(uint32_t row0 = 0; row0 < m; row0 += TileDim)
+            {
+                for(uint32_t pass0 = 0; pass0 < k; pass0 += BwdTilesPerPass * TileDim)
+                {
+                    FragAcc fragsAcc[BwdTilesPerPass];
+                    for(uint32_t j = 0; j < BwdTilesPerPass; ++j)
+                    {
+                        fill_fragment(fragsAcc[j], 0.0f);
+                    }
+
+                    for(uint32_t h = 0; h < m; h += TileDim)
+                    {
+                        // Gather S(row0 : row0 + TileDim, h : h + TileDim), zero outside of m
+                        for(uint32_t e = laneIdx; active && e < TileDim * TileDim;
+                            e += Constants::AMDGCN_WAVE_SIZE)
+                        {
+                            auto  row   = row0 + e / TileDim;
+                            auto  col   = h + e % TileDim;
+                            DataT value = static_cast<DataT>(0.0f);
+                            if(row < m && col < m && row != col)
+                            {
+                                value = row > col ? dy[interactionOffset(k, row, col)]
+                                                  : dy[interactionOffset(k, col, row)];
+                            }
+                            staging[waveIdx][e] = value;
+                        }
+
+                        synchronize_workgroup();
+
+                        if(active)
+                        {
+                            FragA<DataT> fragA;
+                            load_matrix_sync(fragA, staging[waveIdx], TileDim);
+
+                            for(uint32_t j = 0; j < BwdTilesPerPass; ++j)
+                            {
+                                auto col0 = pass0 + j * TileDim;
+                                if(col0 < k)
+                                {
+                                    FragB<DataT, row_major> fragB;
+                                    load_matrix_bounded_sync(
+                                        fragB, x + (h * k + col0), k, m - h, k - col0);
+                                    mma_sync(fragsAcc[j], fragA, fragB, fragsAcc[j]);
+                                }
+                            }
+                        }
+
+                        synchronize_workgroup();
+                    }
+
+                    for(uint32_t j = 0; active && j < BwdTilesPerPass; ++j)
+                    {
+                        auto col0 = pass0 + j * TileDim;
+                        if(col0 < k)
+                        {
+                            FragC<DataT> fragC;
+                            for(uint32_t i = 0; i < fragC.num_elements; ++i)
+                            {
+                                fragC.x[i] = static_cast<DataT>(fragsAcc[j].x[i]);
+                            }
+                            store_matrix_bounded_sync(dx + (row0 * k + col0),
+                                                      fragC,
+                                                      k,
+                                                      m - row0,
+                                                      k - col0,
+                                                      mem_row_major);
+                        }
+                    }
+                }
+            }
+        }
+
+        template <typename DataT>
+        ROCWMMA_HOST inline hipError_t dot_interaction_fwd(DataT const* input,
+                                                           DataT*       output,
+                                                           uint32_t     numFeatures,
+                                                           uint32_t     embeddingDim,
+                                                           uint32_t     batchSize,
+                                                           uint32_t     outputStride,
+                                                           hipStream_t  stream)
+        {
+            auto outputSize = output_size(numFeatures, embeddingDim);
+            outputStride    = (outputStride == 0u) ? outputSize : outputStride;
+            if(numFeatures == 0u || embeddingDim == 0u || outputStride < outputSize)
+            {
+                return hipErrorInvalidValue;
+            }
+            if(batchSize == 0u)
+            {
+                return hipSuccess;
+            }
+
+            uint32_t waveSize = 0u;
+            auto     status   = detail::hostWaveSize(waveSize);
+            if(status != hipSuccess)
+            {
+                return status;
+            }
+
+            hipLaunchKernelGGL((dot_interaction_fwd_kernel<DataT>),
+                               dim3(dlrm_workgroup_count(batchSize)),
+                               dim3(dlrm_workgroup_size(waveSize)),
+                               0, // sharedMemBytes
+                               stream,
+                               input,
+                               output,
+                               numFeatures,
+                               embeddingDim,
+                               batchSize,
+                               outputStride);
+            return hipGetLastError();
+        }
+
+        template <typename DataT>
+        ROCWMMA_HOST inline hipError_t dot_interaction_bwd(DataT const* input,
+                                                           DataT const* upstreamGrad,
+                                                           DataT*       inputGrad,
+                                                           DataT*       bottomMlpGrad,
+                                                           uint32_t     numFeatures,
+                                                           uint32_t     embeddingDim,
+                                                           uint32_t     batchSize,
+                                                           uint32_t     upstreamStride,
+                                                           hipStream_t  stream)
+        {
+            auto outputSize = output_size(numFeatures, embeddingDim);
+            upstreamStride  = (upstreamStride == 0u) ? outputSize : upstreamStride;
+            if(numFeatures == 0u || embeddingDim == 0u || upstreamStride < outputSize)
+            {
+                return hipErrorInvalidValue;
+            }
+            if(batchSize == 0u)
+            {
+                return hipSuccess;
+            }
+
+            uint32_t waveSize = 0u;
+            auto     status   = detail::hostWaveSize(waveSize);
+            if(status != hipSuccess)
+            {
+                return status;
+            }
+
+            hipLaunchKernelGGL((dot_interaction_bwd_kernel<DataT>),
+                               dim3(dlrm_workgroup_count(batchSize)),
+                               dim3(dlrm_workgroup_size(waveSize)),
+                               0, // sharedMemBytes
+                               stream,
+                               input,
+                               upstreamGrad,
+                               inputGrad,
+                               bottomMlpGrad,
+                               numFeatures,
+                               embeddingDim,
+                               batchSize,
+                               upstreamStride);
+            return hipGetLastError();
+        }
+
+    } // namespace dlrm
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_DLRM_API_IMPL_HPP
@@ -0,0 +1,251 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_ELEMENTWISE_API_HPP
+#define ROCWMMA_ELEMENTWISE_API_HPP
+
+#include "rocwmma.hpp"
+
+/**
+ * rocWMMA elementwise is a complimentary API for rocWMMA, applying element-wise arithmetic to
+ * whole fragments of any matrix context, e.g. the prologue of an operand or a custom epilogue.
+ *
+ * Loops over fragment elements with scalar arithmetic tend to compile to one instruction per
+ * element. Instead, elements are evaluated in pairs, as two-element vectors of the compute type:
+ *  - float16_t in float16_t, e.g. v_pk_fma_f16
+ *  - float32_t in float32_t, e.g. v_pk_fma_f32 on gfx90a and gfx94x
+ *  - float64_t, int32_t and uint32_t in their own type
+ *  - bfloat16_t and other non-native datatypes in float32_t
+ * such that the compiler emits packed instructions wherever the target has them.
+ *
+ * Operators are light objects exposing:
+ *
+ *      template <typename PairT>
+ *      PairT operator()(PairT a, ...) const;
+ *
+ * with one argument per input fragment, where PairT is elementwise::pair_t<DataT>. Scalars
+ * of the compute type broadcast to both elements. Any type satisfying the above, including
+ * generic lambdas, may be used as an operator.
+ *
+ * Results are converted to the datatype of the output fragment as a whole vector, using
+ * packed conversions where available.
+ */
+
+namespace rocwmma
+{
+    // @cond
+    namespace detail
+    {
+        template <typename DataT>
+        struct ElementwiseTraits;
+
+    } // namespace detail
+    // @endcond
+
+    namespace elementwise
+    {
+        //! Compute type of the elements of DataT
+        template <typename DataT>
+        using compute_t = typename detail::ElementwiseTraits<DataT>::ComputeT;
+
+        //! Two-element vector of the compute type of DataT, passed to the operators
+        template <typename DataT>
+        using pair_t = typename detail::ElementwiseTraits<DataT>::PairT;
+
+        //! Binary operators computing a + b, a - b, a * b, max(a, b) and min(a, b)
+        struct Add;
+        struct Sub;
+        struct Mul;
+        struct Max;
+        struct Min;
+
+        //! Ternary operator computing a * b + c
+        struct Fma;
+
+        //! Unary operator computing scale * a
+        //! @tparam ComputeT Compute type of the fragment, e.g. compute_t<DataT>
+        template <typename ComputeT>
+        struct Scale;
+
+        //! Binary operator computing alpha * a + beta * b
+        //! @tparam ComputeT Compute type of the fragments, e.g. compute_t<DataT>
+        template <typename ComputeT>
+        struct Axpby;
+
+    } // namespace elementwise
+
+    //! Applies a unary operator to each element of the fragment, in place.
+    //! E.g. frag = relu(frag)
+    //! @param frag Fragment of any matrix context
+    //! @param op Unary operator on pairs of elements
+    //! @tparam FragT Fragment type
+    //! @tparam OpT Operator type
+    template <typename FragT, typename OpT>
+    ROCWMMA_DEVICE inline void transform_fragment(FragT& frag, OpT const& op);
+
+    //! Applies a unary operator to each element of the input fragment.
+    //! E.g. fragOut = scale * fragAcc, in the datatype of fragOut
+    //! @param out Output fragment with as many elements as the input
+    //! @param a Input fragment
+    //! @param op Unary operator on pairs of elements
+    //! @tparam FragOutT Output fragment type
+    //! @tparam FragT Input fragment type, whose datatype determines the compute type
+    //! @tparam OpT Operator type
+    template <typename FragOutT, typename FragT, typename OpT>
+    ROCWMMA_DEVICE inline void transform_fragment(FragOutT& out, FragT const& a, OpT const& op);
+
+    //! Applies a binary operator to each pair of co-indexed elements of the input fragments.
+    //! E.g. fragOut = max(fragA, fragB)
+    //! @param out Output fragment with as many elements as the inputs
+    //! @param a/b Input fragments
+    //! @param op Binary operator on pairs of elements
+    //! @tparam FragOutT Output fragment type
+    //! @tparam FragT Input fragment type, whose datatype determines the compute type
+    //! @tparam OpT Operator type
+    template <typename FragOutT, typename FragT, typename OpT>
+    ROCWMMA_DEVICE inline void
+        transform_fragment(FragOutT& out, FragT const& a, FragT const& b, OpT const& op);
+
+    //! Applies a ternary operator to each triple of co-indexed elements of the input fragments.
+    //! E.g. fragOut = fragA * fragB + fragC
+    //! @param out Output fragment with as many elements as the inputs
+    //! @param a/b/c Input fragments
+    //! @param op Ternary operator on pairs of elements
+    //! @tparam FragOutT Output fragment type
+    //! @tparam FragT Input fragment type, whose datatype determines the compute type
+    //! @tparam OpT Operator type
+    template <typename FragOutT, typename FragT, typename OpT>
+    ROCWMMA_DEVICE inline void transform_fragment(
+        FragOutT& out, FragT const& a, FragT const& b, FragT const& c, OpT const& op);
+
+    //! Computes the fused multiply-add of the input fragments, d = a * b + c
+    //! @param d Output fragment with as many elements as the inputs
+    //! @param a/b/c Input fragments
+    //! @tparam FragOutT Output fragment type
+    //! @tparam FragT Input fragment type
+    template <typename FragOutT, typename FragT>
+    ROCWMMA_DEVICE inline void
+        fma_fragment(FragOutT& d, FragT const& a, FragT const& b, FragT const& c);
+
+    //! Element-wise arithmetic operators of fragments of the same type, evaluated in pairs with
+    //! transform_fragment. E.g. fragAcc += fragPartial, or fragC = fragC * beta
+    //! @param a/b Fragments of any matrix context
+    //! @param s Scalar of the compute type, broadcast to all elements
+    //! @returns Fragment of the result, of the same type as the inputs
+    template <typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE inline fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>
+        operator+(fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& a,
+                  fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& b);
+
+    template <typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE inline fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>
+        operator-(fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& a,
+                  fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& b);
+
+    template <typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE inline fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>
+        operator*(fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& a,
+                  fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& b);
+
+    template <typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE inline fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>
+        operator*(fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& a,
+                  elementwise::compute_t<DataT>                                        s);
+
+    template <typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE inline fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>
+        operator*(elementwise::compute_t<DataT>                                        s,
+                  fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& a);
+
+    template <typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE inline fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>&
+        operator+=(fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>&       a,
+                   fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& b);
+
+    template <typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE inline fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>&
+        operator-=(fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>&       a,
+                   fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& b);
+
+    template <typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE inline fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>&
+        operator*=(fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>&       a,
+                   fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& b);
+
+    template <typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE inline fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>&
+        operator*=(fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>& a,
+                   elementwise::compute_t<DataT>                                  s);
+
+} // namespace rocwmma
+
+#include "rocwmma_elementwise_impl.hpp"
+
+#endif // ROCWMMA_ELEMENTWISE_API_HPP
@@ -0,0 +1,374 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_ELEMENTWISE_API_IMPL_HPP
+#define ROCWMMA_ELEMENTWISE_API_IMPL_HPP
+
+#include "internal/convert.hpp"
+#include "rocwmma_elementwise.hpp"
+
+namespace rocwmma
+{
+    // @cond
+    namespace detail
+    {
+        template <typename ComputeT_>
+        struct ElementwisePairTraits
+        {
+            using ComputeT = ComputeT_;
+            using PairT    = ComputeT_ __attribute__((ext_vector_type(2)));
+        };
+
+        // Types without native arithmetic, e.g. bfloat16_t or float8_t, are computed in
+        // float32_t, for packed fp32 math on gfx90a and gfx94x.
+        template <typename DataT>
+        struct ElementwiseTraits : public ElementwisePairTraits<float32_t>
+        {
+        };
+
+        template <>
+        struct ElementwiseTraits<float16_t> : public ElementwisePairTraits<float16_t>
+        {
+        };
+
+        template <>
+        struct ElementwiseTraits<float64_t> : public ElementwisePairTraits<float64_t>
+        {
+        };
+
+        template <>
+        struct ElementwiseTraits<int32_t> : public ElementwisePairTraits<int32_t>
+        {
+        };
+
+        template <>
+        struct ElementwiseTraits<uint32_t> : public ElementwisePairTraits<uint32_t>
+        {
+        };
+
+        // Applies op to the co-indexed elements of the input fragments, two at a time.
+        // The inputs are all read before out is written, such that out may alias an input.
+        template <typename FragOutT, typename OpT, typename FragT, typename... FragsT>
+        ROCWMMA_DEVICE static inline void elementwiseTransform(FragOutT&       out,
+                                                               OpT const&      op,
+                                                               FragT const&    a,
+                                                               FragsT const&... others)
+        {
+            using ComputeT = elementwise::compute_t<typename FragT::element_type>;
+            using PairT    = elementwise::pair_t<typename FragT::element_type>;
+            using OutputT  = typename FragOutT::element_type;
+
+            constexpr uint32_t Size = FragT::num_elements;
+
+            static_assert(((FragsT::num_elements == Size) && ... && true),
+                          "Input fragments must have the same number of elements");
+            static_assert(FragOutT::num_elements == Size,
+                          "Output and input fragments must have the same number of elements");
+
+            // The last element of an odd sized fragment is paired with itself
+            auto pair = [](auto const& frag, uint32_t i) {
+                auto j = (i + 1u < Size) ? i + 1u : i;
+                return PairT{static_cast<ComputeT>(frag.x[i]), static_cast<ComputeT>(frag.x[j])};
+            };
+
+            VecT<ComputeT, Size> result;
+
+#pragma unroll
+            for(uint32_t i = 0; i < Size; i += 2u)
+            {
+                PairT value    = op(pair(a, i), pair(others, i)...);
+                result.data[i] = value[0];
+                if(i + 1u < Size)
+                {
+                    result.data[i + 1u] = value[1];
+                }
+            }
+
+            out.mAccess = Convert<ComputeT, OutputT>::exec(result);
+        }
+
+    } // namespace detail
+
+    namespace elementwise
+    {
+        struct Add
+        {
+            template <typename T>
+            ROCWMMA_HOST_DEVICE inline T operator()(T a, T b) const
+            {
+                return a + b;
+            }
+        };
+
+        struct Sub
+        {
+            template <typename T>
+            ROCWMMA_HOST_DEVICE inline T operator()(T a, T b) const
+            {
+                return a - b;
+            }
+        };
+
+        struct Mul
+        {
+            template <typename T>
+            ROCWMMA_HOST_DEVICE inline T operator()(T a, T b) const
+            {
+                return a * b;
+            }
+        };
+
+        struct Max
+        {
+            template <typename T>
+            ROCWMMA_HOST_DEVICE inline T operator()(T a, T b) const
+            {
+                return __builtin_elementwise_max(a, b);
+            }
+        };
+
+        struct Min
+        {
+            template <typename T>
+            ROCWMMA_HOST_DEVICE inline T operator()(T a, T b) const
+            {
+                return __builtin_elementwise_min(a, b);
+            }
+        };
+
+        // Contracted to a fused multiply-add with the default -ffp-contract=fast of hipcc
+        struct Fma
+        {
+            template <typename T>
+            ROCWMMA_HOST_DEVICE inline T operator()(T a, T b, T c) const
+            {
+                return a * b + c;
+            }
+        };
+
+        template <typename ComputeT>
+        struct Scale
+        {
+            ROCWMMA_HOST_DEVICE Scale(ComputeT scale)
+                : mScale(scale)
+            {
+            }
+
+            template <typename T>
+            ROCWMMA_HOST_DEVICE inline T operator()(T a) const
+            {
+                return mScale * a;
+            }
+
+            ComputeT mScale;
+        };
+
+        template <typename ComputeT>
+        struct Axpby
+        {
+            ROCWMMA_HOST_DEVICE Axpby(ComputeT alpha, ComputeT beta)
+                : mAlpha(alpha)
+                , mBeta(beta)
+            {
+            }
+
+            template <typename T>
+            ROCWMMA_HOST_DEVICE inline T operator()(T a, T b) const
+            {
+                return mAlpha * a + mBeta * b;
+            }
+
+            ComputeT mAlpha;
+            ComputeT mBeta;
+        };
+
+    } // namespace elementwise
+
+    template <typename FragT, typename OpT>
+    ROCWMMA_DEVICE inline void transform_fragment(FragT& frag, OpT const& op)
+    {
+        detail::elementwiseTransform(frag, op, frag);
+    }
+
+    template <typename FragOutT, typename FragT, typename OpT>
+    ROCWMMA_DEVICE inline void transform_fragment(FragOutT& out, FragT const& a, OpT const& op)
+    {
+        detail::elementwiseTransform(out, op, a);
+    }
+
+    template <typename FragOutT, typename FragT, typename OpT>
+    ROCWMMA_DEVICE inline void
+        transform_fragment(FragOutT& out, FragT const& a, FragT const& b, OpT const& op)
+    {
+        detail::elementwiseTransform(out, op, a, b);
+    }
+
+    template <typename FragOutT, typename FragT, typename OpT>
+    ROCWMMA_DEVICE inline void transform_fragment(
+        FragOutT& out, FragT const& a, FragT const& b, FragT const& c, OpT const& op)
+    {
+        detail::elementwiseTransform(out, op, a, b, c);
+    }
+
+    template <typename FragOutT, typename FragT>
+    ROCWMMA_DEVICE inline void
+        fma_fragment(FragOutT& d, FragT const& a, FragT const& b, FragT const& c)
+    {
+        detail::elementwiseTransform(d, elementwise::Fma{}, a, b, c);
+    }
+
+    template <typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE inline fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>
+        operator+(fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& a,
+                  fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& b)
+    {
+        fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT> result;
+        detail::elementwiseTransform(result, elementwise::Add{}, a, b);
+        return result;
+    }
+
+    template <typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE inline fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>
+        operator-(fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& a,
+                  fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& b)
+    {
+        fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT> result;
+        detail::elementwiseTransform(result, elementwise::Sub{}, a, b);
+        return result;
+    }
+
+    template <typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE inline fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>
+        operator*(fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& a,
+                  fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& b)
+    {
+        fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT> result;
+        detail::elementwiseTransform(result, elementwise::Mul{}, a, b);
+        return result;
+    }
+
+    template <typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE inline fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>
+        operator*(fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& a,
+                  elementwise::compute_t<DataT>                                        s)
+    {
+        fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT> result;
+        detail::elementwiseTransform(result, elementwise::Scale(s), a);
+        return result;
+    }
+
+    template <typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE inline fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>
+        operator*(elementwise::compute_t<DataT>                                        s,
+                  fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& a)
+    {
+        return a * s;
+    }
+
+    template <typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE inline fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>&
+        operator+=(fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>&       a,
+                   fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& b)
+    {
+        detail::elementwiseTransform(a, elementwise::Add{}, a, b);
+        return a;
+    }
+
+    template <typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE inline fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>&
+        operator-=(fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>&       a,
+                   fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& b)
+    {
+        detail::elementwiseTransform(a, elementwise::Sub{}, a, b);
+        return a;
+    }
+
+    template <typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE inline fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>&
+        operator*=(fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>&       a,
+                   fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& b)
+    {
+        detail::elementwiseTransform(a, elementwise::Mul{}, a, b);
+        return a;
+    }
+
+    template <typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE inline fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>&
+        operator*=(fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>& a,
+                   elementwise::compute_t<DataT>                                  s)
+    {
+        detail::elementwiseTransform(a, elementwise::Scale(s), a);
+        return a;
+    }
+    // @endcond
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_ELEMENTWISE_API_IMPL_HPP
@@ -0,0 +1,526 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_EPILOGUE_API_HPP
+#define ROCWMMA_EPILOGUE_API_HPP
+
+#include "rocwmma.hpp"
+#include "rocwmma_transforms.hpp"
+
+#include "rocwmma_epilogue_impl.hpp"
+
+/**
+ * rocWMMA epilogue is a complimentary API for rocWMMA, defining fused element-wise
+ * operations on accumulator fragments between mma_sync and store_matrix_sync.
+ *
+ * A GEMM output may be post-processed in registers (e.g. bias, activation,
+ * scaling, residual add and output conversion) with a single call to apply_epilogue(),
+ * saving a global memory round trip of the output for each element-wise pass.
+ *
+ * Epilogue stages are light objects exposing:
+ *
+ *      template <typename ComputeT>
+ *      ComputeT operator()(ComputeT value, uint32_t idx) const;
+ *
+ * where idx is the fragment element index. Stages are applied left to right in the
+ * accumulator DataT. Any type satisfying the above may be used as a custom stage.
+ *
+ * Per-channel vectors are loaded into accumulator fragments with load_row_vector_sync()
+ * or load_col_vector_sync(), which broadcast the vector such that the fragment elements
+ * line up with those of a co-sized accumulator.
+ *
+ * Auxiliary outputs are taken along the stage chain, each saving a separate pass over the
+ * output: Save copies the value at its position (e.g. the pre-activation for the backward
+ * pass), Amax and Accumulate record element-wise statistics. Statistics are reduced per row
+ * with reduce_rows() and stored with store_col_vector_sync(), or reduced to a device scalar
+ * with atomic_amax_sync(). Row and column statistics of tiles spanning several waves or
+ * workgroups are merged into vectors with atomic_reduce_col_vector_sync() and
+ * atomic_argmax_col_vector_sync().
+ *
+ */
+
+namespace rocwmma
+{
+    namespace epilogue
+    {
+        //! Activation functors, evaluated element-wise by the Activation stage.
+        //! Reduced precision types are evaluated in float32_t.
+        struct Identity;
+        struct Relu;
+        struct Gelu; // Tanh approximation
+        struct Silu;
+
+        //! Activation functors on the hardware exp and rcp approximations, in place of libm.
+        //! float32_t errors are below 2^-20 + |x| * 2^-21, relative, or absolute for FastTanh.
+        //! Reduced precision types are evaluated in float32_t, float64_t with libm.
+        struct FastSigmoid;
+        struct FastTanh;
+        struct FastGelu; // Tanh approximation
+        struct FastSilu;
+
+        //! Distance metrics of the PairwiseDistance stage, from the dot product x.y of a row x and
+        //! a column y, and the norm terms of x and y.
+        struct SquaredEuclidean; // |x|^2 + |y|^2 - 2 x.y, clamped to 0. Norm terms |x|^2 and |y|^2.
+        struct Cosine; // 1 - x.y / (|x| |y|). Norm terms 1 / |x| and 1 / |y|.
+
+        //! Epilogue stage computing alpha * value + beta * c
+        //! @tparam ComputeT Datatype of the alpha and beta scalars
+        //! @tparam FragC Fragment type of the C input
+        //! @note C may be held in any datatype and data layout, e.g. a bfloat16_t row_major C with a
+        //! float32_t col_major accumulator. Elements convert in registers, provided both accumulators share
+        //! a register layout (not float64_t with 32-bit types on gfx9).
+        template <typename ComputeT, typename FragC>
+        struct LinearCombination;
+
+        //! Epilogue stage computing value + bias, where bias is a broadcast vector fragment
+        //! @tparam FragBias Fragment type of the bias input
+        template <typename FragBias>
+        struct BiasAdd;
+
+        //! Epilogue stage computing value * scale, where scale is a broadcast vector fragment
+        //! @tparam FragScale Fragment type of the scale input
+        template <typename FragScale>
+        struct Scale;
+
+        //! Epilogue stage computing value * scale, where scale is a scalar, as for per-tensor quantization scales
+        //! @tparam ComputeT Datatype of the scale
+        template <typename ComputeT>
+        struct TensorScale;
+
+        //! Epilogue stage clamping value to the finite range of DataT, as required before narrowing conversions
+        //! @tparam DataT Datatype of the output, e.g. float8_t
+        template <typename DataT>
+        struct Saturate;
+
+        //! Epilogue stage requantizing integer accumulators: round(value * scale) + zeroPoint, saturated to
+        //! the range of DataT. Scale is applied in float32_t and rounds to nearest even.
+        //! E.g. an int32_t accumulator into an int8_t output, with per-channel scale and zero point vectors.
+        //! @tparam FragScale Fragment type of the float32_t scale input
+        //! @tparam FragZeroPoint Fragment type of the integer zero point input
+        //! @tparam DataT Datatype of the quantized output, default int8_t
+        //! @note An int32_t bias is added exactly beforehand with BiasAdd, in the accumulator DataT.
+        template <typename FragScale, typename FragZeroPoint, typename DataT = int8_t>
+        struct Requantize;
+
+        //! Epilogue stage quantizing value symmetrically to DataT with a dynamic scale of
+        //! amax / max(DataT), saturated to [-max, max]. Integral DataT rounds to nearest even.
+        //! E.g. per-token quantization of a GEMM output, with fragAmax holding the row amax.
+        //! The dequantization scale amax / max(DataT) is stored separately, e.g. per row.
+        //! @tparam FragAmax Fragment type of the amax input, co-indexed with the accumulator
+        //! @tparam DataT Datatype of the quantized output, e.g. int8_t or float8_t
+        //! @note Elements whose amax is 0 quantize to 0.
+        template <typename FragAmax, typename DataT>
+        struct DynamicQuantize;
+
+        //! Epilogue stage recording the running maximum of |value| into each element of fragAmax.
+        //! Value is passed through unchanged.
+        //! @tparam FragAmax Accumulator fragment type receiving the element-wise maximum
+        //! @note fragAmax must be initialized (e.g. to 0) before the first use. A whole-block
+        //! amax can be obtained with reduce_rows and reduce_cols (rocwmma_transforms.hpp).
+        template <typename FragAmax>
+        struct Amax;
+
+        //! Epilogue stage adding value into each element of fragSum, e.g. over the column blocks
+        //! of a row. Value is passed through unchanged.
+        //! @tparam FragSum Accumulator fragment type receiving the element-wise sums
+        //! @note fragSum must be initialized (e.g. to 0) before the first use. Row sums can be
+        //! obtained with reduce_rows (rocwmma_transforms.hpp) and stored with store_col_vector_sync.
+        template <typename FragSum>
+        struct Accumulate;
+
+        //! Epilogue stage saving value into fragAux, converted to its DataT. Value is passed
+        //! through unchanged. E.g. the pre-activation saved for the backward pass in bfloat16_t,
+        //! when placed before the Activation stage.
+        //! @tparam FragAux Accumulator fragment type receiving the values, stored alongside the output
+        template <typename FragAux>
+        struct Save;
+
+        //! Epilogue stage computing value + residual
+        //! @tparam FragResidual Fragment type of the residual input
+        //! @note The residual may be held in any datatype and data layout, as C of LinearCombination.
+        template <typename FragResidual>
+        struct ResidualAdd;
+
+        //! Epilogue stage applying the activation functor ActivationT
+        //! @tparam ActivationT One of the activation functors above, or a custom functor with a static exec(T)
+        template <typename ActivationT>
+        struct Activation;
+
+        //! Epilogue stage computing act(value) * up, the gated linear unit of a GLU feed-forward
+        //! layer, where value is the gate projection and up the up projection of the same block.
+        //! E.g. SwiGLU with Silu, GeGLU with Gelu.
+        //! @tparam ActivationT Activation functor of the gate
+        //! @tparam FragUp Fragment type of the up projection input
+        template <typename ActivationT, typename FragUp>
+        struct GatedLinearUnit;
+
+        //! Epilogue stage turning the dot products of a GEMM of X (M x K) and Y (K x N) into the pairwise
+        //! distances of the rows of X and the columns of Y, from precomputed norm terms of both.
+        //! E.g. point to centroid distances of a k-means assignment, ranked in registers with argmax_rows or
+        //! topk_rows on their negation, without writing the distance matrix.
+        //! Constructed with (MetricT{}, fragRowNorm, fragColNorm), where the row norm terms are loaded with
+        //! load_col_vector_sync and the column norm terms with load_row_vector_sync.
+        //! @tparam MetricT SquaredEuclidean or Cosine
+        //! @tparam FragRowNorm Fragment type of the norm terms of the rows of X
+        //! @tparam FragColNorm Fragment type of the norm terms of the columns of Y
+        //! @note Squared distances of nearby points lose relative accuracy to cancellation, of the order
+        //! of the accumulator epsilon times |x|^2 + |y|^2.
+        template <typename MetricT, typename FragRowNorm, typename FragColNorm>
+        struct PairwiseDistance;
+
+        //! Epilogue stage applying dropout: value is zeroed with probability p, and kept values are scaled
+        //! by 1 / (1 - p). Each element draws from Philox4x32-10 keyed by seed, offset and its matrix
+        //! coordinate, such that the mask depends on neither the launch configuration nor the target,
+        //! and may be regenerated by the backward pass.
+        //! Constructed with (seed, offset, p, blockCoord, keepBits = nullptr), where blockCoord is the
+        //! matrix coordinate of the fragment in the output. Kept elements are recorded as bits of the
+        //! optional keepBits (bit idx for element idx), for store_dropout_mask_sync.
+        //! @tparam FragT Accumulator fragment type the stage is applied to, mapping element indices to
+        //! matrix coordinates
+        //! @note p must be in [0, 1). The offset selects fresh random numbers, e.g. per training step.
+        template <typename FragT>
+        struct Dropout;
+
+        //! Epilogue stage applying a stored dropout mask: value / (1 - p) where bit idx of keepBits is set,
+        //! 0 elsewhere. E.g. the gradient of Dropout, with keepBits from load_dropout_mask_sync.
+        struct DropoutMask;
+
+        //! Epilogue stage masking attention scores: value is replaced by -infinity where the key column is
+        //! at or past keyCount (e.g. the tail of a ragged sequence), or when causal, where the key column
+        //! is after the query row or at window or more keys before it (sliding window).
+        //! Constructed with (blockCoord, causal, window = 0, keyCount = unbounded), where blockCoord is the
+        //! (query row, key column) matrix coordinate of the fragment in the score matrix, and a window of 0
+        //! is unbounded. Masked scores have a probability of 0 after the softmax.
+        //! @tparam FragT Accumulator fragment type the stage is applied to, mapping element indices to
+        //! matrix coordinates
+        //! @note Only blocks crossing the diagonal, the window edge or the key count need the stage. Blocks
+        //! entirely inside the mask should be skipped rather than masked.
+        template <typename FragT>
+        struct AttentionMask;
+
+        //! Epilogue stage applying rotary position embedding (RoPE) to the Q or K projection of one or
+        //! more heads, in the rotate-half pairing: dimension d of the first half of a head is rotated
+        //! with dimension d + headDim / 2, by the angle position * thetaBase^(-2d / headDim).
+        //! Constructed with (fragPartner, blockCoord, headDim, thetaBase = 10000, positions = nullptr),
+        //! where fragPartner holds the accumulators of the paired half of the head, co-indexed with the
+        //! fragment the stage is applied to, and blockCoord is the (token row, projection column) matrix
+        //! coordinate of the fragment. Positions are read from positions[row] if given, and are the token
+        //! row otherwise.
+        //! E.g. with headDim = 128 and BlockN = 32, the rotated block 1 of a head pairs with block 3, and
+        //! block 3 with block 1.
+        //! @tparam FragT Accumulator fragment type the stage is applied to, mapping element indices to
+        //! matrix coordinates
+        //! @tparam FragPartner Fragment type of the paired half of the head
+        //! @note Both halves are read before either is rotated, so the stage must be applied to each
+        //! half from the unrotated accumulators. Head columns must not straddle a fragment, i.e. headDim
+        //! / 2 is a multiple of BlockN. Angles are evaluated in float32_t with full range reduction.
+        template <typename FragT, typename FragPartner>
+        struct RotaryEmbedding;
+
+        //! Epilogue output policy storing each output fragment into the buffers of up to MaxPeers
+        //! GPUs, e.g. the all-reduce staging buffers of a tensor parallel group, then signalling
+        //! completion of the fragment tile with a flag on each peer.
+        //! Peers may begin reducing a tile as soon as its flag is observed, while other tiles are
+        //! still computing.
+        //! @tparam DataT Datatype of the peer buffers
+        //! @tparam MaxPeers Capacity of the peer group
+        //! @note Buffers and flags must be peer-accessible device pointers, e.g. from
+        //! hipDeviceEnablePeerAccess or IPC handles. Flags are read by spinning peers and should
+        //! be allocated fine-grained (hipDeviceMallocFinegrained).
+        template <typename DataT, uint32_t MaxPeers>
+        struct PeerStore;
+
+    } // namespace epilogue
+
+    //! @struct linear_combination_t
+    //! @brief Cases of the linear combination alpha * acc + beta * C, in increasing cost
+    //! @var linear_identity alpha == 1 and beta == 0: the output is acc, without a stage
+    //! @var linear_scale beta == 0: the output is alpha * acc (TensorScale), without reading C
+    //! @var linear_full the output is alpha * acc + beta * C (LinearCombination)
+    enum linear_combination_t : uint32_t
+    {
+        linear_identity,
+        linear_scale,
+        linear_full
+    };
+
+    //! Selects the cheapest case of alpha * acc + beta * C, such that C is only loaded for linear_full.
+    //! E.g. with beta == 0, the load of C and its multiply-add are skipped entirely.
+    //! @param alpha Scalar multiplier of the accumulator
+    //! @param beta Scalar multiplier of C
+    //! @tparam ComputeT Datatype of the alpha and beta scalars
+    //! @returns The case of alpha and beta, as a wave-uniform value
+    //! @note alpha and beta must be uniform across the wave (e.g. kernel arguments), such that branches on
+    //! the result are scalar branches.
+    template <typename ComputeT>
+    ROCWMMA_DEVICE static inline linear_combination_t get_linear_combination(ComputeT alpha,
+                                                                             ComputeT beta);
+
+    //! Loads a vector of BlockN elements into an accumulator fragment, such that each row holds a copy of the vector.
+    //! E.g. frag(i, j) = data[j], as for a per-column bias of the GEMM output D.
+    //! @param frag Accumulator fragment with its associated block sizes, data type and layout
+    //! @param data Data pointer to global or local memory
+    //! @tparam BlockM/N/K Block dimensions
+    //! @tparam DataT Datatype
+    //! @tparam DataLayoutT In-register layout of the fragment (any, including void)
+    //! @note Fragment elements co-index with any accumulator of the same block sizes
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void load_row_vector_sync(
+        fragment<accumulator, BlockM, BlockN, BlockK, DataT, DataLayoutT>& frag, const DataT* data);
+
+    //! Loads a vector of BlockM elements into an accumulator fragment, such that each column holds a copy of the vector.
+    //! E.g. frag(i, j) = data[i], as for a per-row scale of the GEMM output D.
+    //! @param frag Accumulator fragment with its associated block sizes, data type and layout
+    //! @param data Data pointer to global or local memory
+    //! @tparam BlockM/N/K Block dimensions
+    //! @tparam DataT Datatype
+    //! @tparam DataLayoutT In-register layout of the fragment (any, including void)
+    //! @note Fragment elements co-index with any accumulator of the same block sizes
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void load_col_vector_sync(
+        fragment<accumulator, BlockM, BlockN, BlockK, DataT, DataLayoutT>& frag, const DataT* data);
+
+    //! Loads a vector of BlockN elements into an accumulator fragment as load_row_vector_sync, reading the vector once per wave.
+    //! Vectors of up to 64 bytes are read with scalar loads and written to the first lanes, larger ones with one dword load per lane.
+    //! Each element is then broadcast from the lane holding its column with ds_bpermute, instead of a vector memory read per element.
+    //! E.g. a per-column bias or scale, relieving vector memory in the epilogue.
+    //! @param frag Accumulator fragment with its associated block sizes, data type and layout
+    //! @param data Data pointer to global memory, wave-uniform and 4-byte aligned
+    //! @tparam BlockM/N/K Block dimensions
+    //! @tparam DataT Datatype
+    //! @tparam DataLayoutT In-register layout of the fragment (any, including void)
+    //! @note Data is read through the scalar cache, and must not be written by the kernel.
+    //! @note Datatypes wider than 32 bits, and vectors wider than one dword per lane, use load_row_vector_sync.
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void load_row_vector_uniform_sync(
+        fragment<accumulator, BlockM, BlockN, BlockK, DataT, DataLayoutT>& frag, const DataT* data);
+
+    //! Loads a vector of BlockM elements into an accumulator fragment as load_col_vector_sync, reading the vector once per wave.
+    //! Vectors of up to 64 bytes are read with scalar loads and written to the first lanes, larger ones with one dword load per lane.
+    //! Each element is then broadcast from the lane holding its row with ds_bpermute, instead of a vector memory read per element.
+    //! E.g. a per-row scale, relieving vector memory in the epilogue.
+    //! @param frag Accumulator fragment with its associated block sizes, data type and layout
+    //! @param data Data pointer to global memory, wave-uniform and 4-byte aligned
+    //! @tparam BlockM/N/K Block dimensions
+    //! @tparam DataT Datatype
+    //! @tparam DataLayoutT In-register layout of the fragment (any, including void)
+    //! @note Data is read through the scalar cache, and must not be written by the kernel.
+    //! @note Datatypes wider than 32 bits, and vectors wider than one dword per lane, use load_col_vector_sync.
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void load_col_vector_uniform_sync(
+        fragment<accumulator, BlockM, BlockN, BlockK, DataT, DataLayoutT>& frag, const DataT* data);
+
+    //! Stores the rows of an accumulator fragment holding one value per row as a vector of BlockM elements.
+    //! E.g. data[i] = frag(i, j), as for the row statistics of reduce_rows or online_softmax_rows.
+    //! @param data Data pointer to global or local memory
+    //! @param frag Accumulator fragment with its associated block sizes, data type and layout
+    //! @tparam BlockM/N/K Block dimensions
+    //! @tparam DataT Datatype
+    //! @tparam DataLayoutT In-register layout of the fragment (any, including void)
+    //! @note Every column of a row stores to the same address, so the result is only defined
+    //! if the elements of each row are equal.
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void store_col_vector_sync(
+        DataT* data, fragment<accumulator, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& frag);
+
+    //! Stores an accumulator fragment of D in both row major and transposed forms: row major D into data, and row major D^T
+    //! into dataT. E.g. an FP8 activation for the forward GEMM, with its transpose for the backward GEMM which needs it
+    //! as the other operand, without a separate transpose kernel re-reading D.
+    //! @param data Data pointer of D to global or local memory, at the fragment origin (row, col)
+    //! @param dataT Data pointer of D^T to global or local memory, at the transposed origin (col, row)
+    //! @param frag Accumulator fragment with its associated block sizes, data type and layout
+    //! @param ldm Leading dimension size of D, in elements
+    //! @param ldmT Leading dimension size of D^T, in elements
+    //! @tparam BlockM/N/K Block dimensions
+    //! @tparam DataT Datatype
+    //! @tparam DataLayoutT In-register layout of the fragment (any, including void)
+    //! @note Row major D^T is col major D. The transposed store writes the same registers with the col major data
+    //! layout, which needs no register transpose: accumulator register layouts do not change with the data layout.
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void store_matrix_dual_sync(
+        DataT*                                                                   data,
+        DataT*                                                                   dataT,
+        fragment<accumulator, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& frag,
+        uint32_t                                                                 ldm,
+        uint32_t                                                                 ldmT);
+
+    //! Reduces an amax fragment to its maximum, and combines it into a device scalar with an atomic
+    //! max from one lane of the wave. E.g. the per-tensor amax of an FP8 recipe, after the Amax stage.
+    //! @param data Device scalar, initialized to 0 before the first combine
+    //! @param fragAmax Accumulator fragment of non-negative float32_t values
+    //! @tparam BlockM/N/K Block dimensions
+    //! @tparam DataLayoutT In-register layout of the fragment (any, including void)
+    //! @note Non-negative floats order the same as their bit patterns, so the combine is an
+    //! integer atomic max.
+    template <uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename DataLayoutT>
+    ROCWMMA_DEVICE void atomic_amax_sync(
+        float32_t*                                                                   data,
+        fragment<accumulator, BlockM, BlockN, BlockK, float32_t, DataLayoutT> const& fragAmax);
+
+    //! Combines the rows of an accumulator fragment holding one value per row into a vector of BlockM
+    //! elements with atomics, e.g. data[i] = op(data[i], frag(i, 0)) for the row statistics of reduce_rows.
+    //! Waves and workgroups covering different columns of the same rows merge into the same vector.
+    //! @param data Data pointer to global or local memory, initialized to the identity of ReduceOpT
+    //! @param frag Accumulator fragment with its associated block sizes, data type and layout
+    //! @tparam ReduceOpT One of reduce::Sum, reduce::Max or reduce::Min
+    //! @tparam BlockM/N/K Block dimensions
+    //! @tparam DataT Datatype of a device atomic: float32_t, int32_t or uint32_t
+    //! @tparam DataLayoutT In-register layout of the fragment (any, including void)
+    //! @note Only column 0 of each row is combined. Sums of float32_t depend on the order of the atomics.
+    template <typename ReduceOpT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void atomic_reduce_col_vector_sync(
+        DataT* data, fragment<accumulator, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& frag);
+
+    //! Combines the columns of an accumulator fragment holding one value per column into a vector of BlockN
+    //! elements with atomics, e.g. data[j] = op(data[j], frag(0, j)) for the column statistics of reduce_cols.
+    //! @param data Data pointer to global or local memory, initialized to the identity of ReduceOpT
+    //! @param frag Accumulator fragment with its associated block sizes, data type and layout
+    //! @tparam ReduceOpT One of reduce::Sum, reduce::Max or reduce::Min
+    //! @tparam BlockM/N/K Block dimensions
+    //! @tparam DataT Datatype of a device atomic: float32_t, int32_t or uint32_t
+    //! @tparam DataLayoutT In-register layout of the fragment (any, including void)
+    //! @note Only row 0 of each column is combined.
+    template <typename ReduceOpT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void atomic_reduce_row_vector_sync(
+        DataT* data, fragment<accumulator, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& frag);
+
+    //! Combines the running argmax of argmax_rows into a vector of BlockM keys with a 64-bit atomic max.
+    //! Each key packs the value in its upper word, ordered as an integer, and the inverted index in its lower
+    //! word, such that the maximum key holds the largest value with its lowest index.
+    //! @param keys Key pointer to global or local memory, initialized to 0
+    //! @param vals Accumulator fragment of the running max of each row
+    //! @param idx Accumulator fragment of int32_t indices, co-indexed with vals
+    //! @tparam BlockM/N/K Block dimensions
+    //! @tparam DataLayoutT In-register layout of the fragments (any, including void)
+    //! @note Keys are decoded with argmax_key_value and argmax_key_index. NaN values are not supported.
+    template <uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename DataLayoutT>
+    ROCWMMA_DEVICE void atomic_argmax_col_vector_sync(
+        uint64_t*                                                                    keys,
+        fragment<accumulator, BlockM, BlockN, BlockK, float32_t, DataLayoutT> const& vals,
+        fragment<accumulator, BlockM, BlockN, BlockK, int32_t, DataLayoutT> const&   idx);
+
+    //! Combines the running argmax of argmax_cols into a vector of BlockN keys with a 64-bit atomic max.
+    //! @param keys Key pointer to global or local memory, initialized to 0
+    //! @param vals Accumulator fragment of the running max of each column
+    //! @param idx Accumulator fragment of int32_t indices, co-indexed with vals
+    //! @tparam BlockM/N/K Block dimensions
+    //! @tparam DataLayoutT In-register layout of the fragments (any, including void)
+    //! @note Keys are packed as for atomic_argmax_col_vector_sync.
+    template <uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename DataLayoutT>
+    ROCWMMA_DEVICE void atomic_argmax_row_vector_sync(
+        uint64_t*                                                                    keys,
+        fragment<accumulator, BlockM, BlockN, BlockK, float32_t, DataLayoutT> const& vals,
+        fragment<accumulator, BlockM, BlockN, BlockK, int32_t, DataLayoutT> const&   idx);
+
+    //! @returns The value of an argmax key, on the host or the device
+    ROCWMMA_HOST_DEVICE static inline float32_t argmax_key_value(uint64_t key);
+
+    //! @returns The index of an argmax key, on the host or the device
+    ROCWMMA_HOST_DEVICE static inline int32_t argmax_key_index(uint64_t key);
+
+    //! Stores the kept bits recorded by the Dropout stage as a mask of one bit per element, in
+    //! BlockM * BlockN / 32 uint32_t words at data.
+    //! @param data Mask words of the fragment, e.g. at its block index * BlockM * BlockN / 32
+    //! @param keepBits Kept bits of the lane, bit idx for fragment element idx
+    //! @tparam FragT Accumulator fragment type the bits were recorded for
+    //! @note Bits are packed with one ballot per element, in register order: the mask is opaque, and
+    //! only loaded by load_dropout_mask_sync with the same block sizes on the same target.
+    template <typename FragT>
+    ROCWMMA_DEVICE void store_dropout_mask_sync(uint32_t* data, uint32_t keepBits);
+
+    //! Loads a mask stored by store_dropout_mask_sync
+    //! @param data Mask words of the fragment
+    //! @tparam FragT Accumulator fragment type of the mask
+    //! @returns Kept bits of the lane, for the DropoutMask stage
+    template <typename FragT>
+    ROCWMMA_DEVICE uint32_t load_dropout_mask_sync(uint32_t const* data);
+
+    //! Stores whether an output fragment holds any non-zero element, as the skip map entry of its block.
+    //! E.g. a ReLU layer records its zero blocks, such that the next layer skips the load and mma_sync of
+    //! the matching matrix_a blocks, and of their matrix_b blocks.
+    //! @param flag Skip map entry of the block, e.g. at blockRow * blockCols + blockCol
+    //! @param frag Output fragment, after the epilogue
+    //! @note Entries are 1 for blocks with a non-zero element, 0 otherwise, as by is_zero_sync.
+    template <typename FragT>
+    ROCWMMA_DEVICE void store_nonzero_flag_sync(uint32_t* flag, FragT const& frag);
+
+    //! Loads a skip map entry stored by store_nonzero_flag_sync
+    //! @param flag Skip map entry of the block, wave-uniform
+    //! @returns True if the block holds a non-zero element, as a wave-uniform value for scalar branches
+    ROCWMMA_DEVICE static inline bool load_nonzero_flag_sync(uint32_t const* flag);
+
+    //! Applies the epilogue stages to each element of the accumulator fragment in a single pass, then converts
+    //! the result to the datatype of the output fragment.
+    //! E.g. fragOut = relu(alpha * fragAcc + beta * fragC + bias), in OutputT
+    //! @param fragOut Output accumulator fragment, ready for store_matrix_sync
+    //! @param fragAcc Input accumulator fragment. Its DataT is the compute type of all stages.
+    //! @param stages Epilogue stages, applied left to right
+    //! @tparam FragOutT Output fragment type
+    //! @tparam FragAccT Input fragment type
+    //! @tparam StageTs Epilogue stage types
+    //! @note fragOut = fragAcc is valid if both have the same type
+    //! @note The output conversion is vectorized, using packed conversions where available,
+    //! e.g. int32_t to int8_t packs four saturated outputs per register.
+    template <typename FragOutT, typename FragAccT, typename... StageTs>
+    ROCWMMA_DEVICE static inline void
+        apply_epilogue(FragOutT& fragOut, FragAccT const& fragAcc, StageTs const&... stages);
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_EPILOGUE_API_HPP
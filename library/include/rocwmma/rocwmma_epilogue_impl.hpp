@@ -0,0 +1,1125 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_EPILOGUE_API_IMPL_HPP
+#define ROCWMMA_EPILOGUE_API_IMPL_HPP
+
+#include "internal/fast_math.hpp"
+#include "internal/philox.hpp"
+#include "rocwmma_epilogue.hpp"
+
+namespace rocwmma
+{
+    namespace epilogue
+    {
+        namespace detail
+        {
+            // Transcendentals are evaluated in float32_t, unless the input is float64_t.
+            template <typename T>
+            using ActivationComputeT = conditional_t<is_same_v<T, float64_t>, float64_t, float32_t>;
+
+            template <typename T>
+            ROCWMMA_DEVICE static inline T exp(T x)
+            {
+                if constexpr(is_same_v<T, float64_t>)
+                {
+                    return ::exp(x);
+                }
+                else
+                {
+                    return __expf(x);
+                }
+            }
+
+            template <typename T>
+            ROCWMMA_DEVICE static inline T tanh(T x)
+            {
+                if constexpr(is_same_v<T, float64_t>)
+                {
+                    return ::tanh(x);
+                }
+                else
+                {
+                    return ::tanhf(x);
+                }
+            }
+
+        } // namespace detail
+
+        struct Identity
+        {
+            template <typename T>
+            ROCWMMA_DEVICE static inline T exec(T x)
+            {
+                return x;
+            }
+        };
+
+        struct Relu
+        {
+            template <typename T>
+            ROCWMMA_DEVICE static inline T exec(T x)
+            {
+                return x > static_cast<T>(0) ? x : static_cast<T>(0);
+            }
+        };
+
+        // gelu(x) = 0.5 * x * (1 + tanh(sqrt(2 / pi) * (x + 0.044715 * x^3)))
+        struct Gelu
+        {
+            template <typename T>
+            ROCWMMA_DEVICE static inline T exec(T x)
+            {
+                using ComputeT = detail::ActivationComputeT<T>;
+
+                constexpr auto SqrtTwoOverPi = static_cast<ComputeT>(0.7978845608028654);
+                constexpr auto Coeff         = static_cast<ComputeT>(0.044715);
+
+                auto xc    = static_cast<ComputeT>(x);
+                auto inner = SqrtTwoOverPi * (xc + Coeff * xc * xc * xc);
+                return static_cast<T>(static_cast<ComputeT>(0.5) * xc
+                                      * (static_cast<ComputeT>(1) + detail::tanh(inner)));
+            }
+        };
+
+        // silu(x) = x / (1 + exp(-x))
+        struct Silu
+        {
+            template <typename T>
+            ROCWMMA_DEVICE static inline T exec(T x)
+            {
+                using ComputeT = detail::ActivationComputeT<T>;
+
+                auto xc = static_cast<ComputeT>(x);
+                return static_cast<T>(xc / (static_cast<ComputeT>(1) + detail::exp(-xc)));
+            }
+        };
+
+        // sigmoid(x) = 1 / (1 + exp(-x))
+        struct FastSigmoid
+        {
+            template <typename T>
+            ROCWMMA_DEVICE static inline T exec(T x)
+            {
+                if constexpr(is_same_v<T, float64_t>)
+                {
+                    return 1.0 / (1.0 + detail::exp(-x));
+                }
+                else
+                {
+                    return static_cast<T>(
+                        rocwmma::detail::FastMath::sigmoid(static_cast<float32_t>(x)));
+                }
+            }
+        };
+
+        struct FastTanh
+        {
+            template <typename T>
+            ROCWMMA_DEVICE static inline T exec(T x)
+            {
+                if constexpr(is_same_v<T, float64_t>)
+                {
+                    return detail::tanh(x);
+                }
+                else
+                {
+                    return static_cast<T>(
+                        rocwmma::detail::FastMath::tanh(static_cast<float32_t>(x)));
+                }
+            }
+        };
+
+        // gelu(x) = x * sigmoid(2 * sqrt(2 / pi) * (x + 0.044715 * x^3))
+        struct FastGelu
+        {
+            template <typename T>
+            ROCWMMA_DEVICE static inline T exec(T x)
+            {
+                if constexpr(is_same_v<T, float64_t>)
+                {
+                    return Gelu::exec(x);
+                }
+                else
+                {
+                    return static_cast<T>(
+                        rocwmma::detail::FastMath::gelu(static_cast<float32_t>(x)));
+                }
+            }
+        };
+
+        struct FastSilu
+        {
+            template <typename T>
+            ROCWMMA_DEVICE static inline T exec(T x)
+            {
+                if constexpr(is_same_v<T, float64_t>)
+                {
+                    return Silu::exec(x);
+                }
+                else
+                {
+                    return static_cast<T>(
+                        rocwmma::detail::FastMath::silu(static_cast<float32_t>(x)));
+                }
+            }
+        };
+
+        template <typename ComputeT, typename FragC>
+        struct LinearCombination
+        {
+            ROCWMMA_DEVICE LinearCombination(ComputeT alpha, ComputeT beta, FragC const& fragC)
+                : mAlpha(alpha)
+                , mBeta(beta)
+                , mFragC(fragC)
+            {
+            }
+
+            template <typename T>
+            ROCWMMA_DEVICE inline T operator()(T value, uint32_t idx) const
+            {
+                return static_cast<T>(mAlpha) * value
+                       + static_cast<T>(mBeta) * static_cast<T>(mFragC.x[idx]);
+            }
+
+            ComputeT     mAlpha;
+            ComputeT     mBeta;
+            FragC const& mFragC;
+        };
+
+        template <typename FragBias>
+        struct BiasAdd
+        {
+            ROCWMMA_DEVICE BiasAdd(FragBias const& fragBias)
+                : mFragBias(fragBias)
+            {
+            }
+
+            template <typename T>
+            ROCWMMA_DEVICE inline T operator()(T value, uint32_t idx) const
+            {
+                return value + static_cast<T>(mFragBias.x[idx]);
+            }
+
+            FragBias const& mFragBias;
+        };
+
+        template <typename FragScale>
+        struct Scale
+        {
+            ROCWMMA_DEVICE Scale(FragScale const& fragScale)
+                : mFragScale(fragScale)
+            {
+            }
+
+            template <typename T>
+            ROCWMMA_DEVICE inline T operator()(T value, uint32_t idx) const
+            {
+                return value * static_cast<T>(mFragScale.x[idx]);
+            }
+
+            FragScale const& mFragScale;
+        };
+
+        template <typename ComputeT>
+        struct TensorScale
+        {
+            ROCWMMA_DEVICE TensorScale(ComputeT scale)
+                : mScale(scale)
+            {
+            }
+
+            template <typename T>
+            ROCWMMA_DEVICE inline T operator()(T value, uint32_t /*idx*/) const
+            {
+                return value * static_cast<T>(mScale);
+            }
+
+            ComputeT mScale;
+        };
+
+        template <typename DataT>
+        struct Saturate
+        {
+            template <typename T>
+            ROCWMMA_DEVICE inline T operator()(T value, uint32_t /*idx*/) const
+            {
+                auto const lowest = static_cast<T>(numeric_limits<DataT>::lowest());
+                auto const max    = static_cast<T>(numeric_limits<DataT>::max());
+                return value < lowest ? lowest : (value > max ? max : value);
+            }
+        };
+
+        template <typename FragScale, typename FragZeroPoint, typename DataT>
+        struct Requantize
+        {
+            ROCWMMA_DEVICE Requantize(FragScale const&     fragScale,
+                                      FragZeroPoint const& fragZeroPoint)
+                : mFragScale(fragScale)
+                , mFragZeroPoint(fragZeroPoint)
+            {
+            }
+
+            template <typename T>
+            ROCWMMA_DEVICE inline T operator()(T value, uint32_t idx) const
+            {
+                auto const lowest = static_cast<float32_t>(numeric_limits<DataT>::lowest());
+                auto const max    = static_cast<float32_t>(numeric_limits<DataT>::max());
+
+                // Zero point is added after rounding, such that it shifts the integer grid exactly
+                auto scaled = ::rintf(static_cast<float32_t>(value)
+                                      * static_cast<float32_t>(mFragScale.x[idx]))
+                              + static_cast<float32_t>(mFragZeroPoint.x[idx]);
+                return static_cast<T>(scaled < lowest ? lowest : (scaled > max ? max : scaled));
+            }
+
+            FragScale const&     mFragScale;
+            FragZeroPoint const& mFragZeroPoint;
+        };
+
+        template <typename FragAmax, typename DataT>
+        struct DynamicQuantize
+        {
+            ROCWMMA_DEVICE DynamicQuantize(FragAmax const& fragAmax)
+                : mFragAmax(fragAmax)
+            {
+            }
+
+            template <typename T>
+            ROCWMMA_DEVICE inline T operator()(T value, uint32_t idx) const
+            {
+                auto const max  = static_cast<float32_t>(numeric_limits<DataT>::max());
+                auto const amax = static_cast<float32_t>(mFragAmax.x[idx]);
+
+                auto scaled = amax > 0.0f ? static_cast<float32_t>(value) * (max / amax) : 0.0f;
+                if constexpr(is_integral_v<DataT>)
+                {
+                    scaled = ::rintf(scaled);
+                }
+                return static_cast<T>(scaled < -max ? -max : (scaled > max ? max : scaled));
+            }
+
+            FragAmax const& mFragAmax;
+        };
+
+        template <typename FragAmax>
+        struct Amax
+        {
+            ROCWMMA_DEVICE Amax(FragAmax& fragAmax)
+                : mFragAmax(fragAmax)
+            {
+            }
+
+            // The stage is const, but the amax fragment is not.
+            template <typename T>
+            ROCWMMA_DEVICE inline T operator()(T value, uint32_t idx) const
+            {
+                using AmaxT = typename FragAmax::element_type;
+
+                auto  absValue = static_cast<AmaxT>(value < static_cast<T>(0) ? -value : value);
+                auto& amax     = mFragAmax.x[idx];
+                amax           = absValue > amax ? absValue : amax;
+                return value;
+            }
+
+            FragAmax& mFragAmax;
+        };
+
+        template <typename FragSum>
+        struct Accumulate
+        {
+            ROCWMMA_DEVICE Accumulate(FragSum& fragSum)
+                : mFragSum(fragSum)
+            {
+            }
+
+            // The stage is const, but the sum fragment is not.
+            template <typename T>
+            ROCWMMA_DEVICE inline T operator()(T value, uint32_t idx) const
+            {
+                using SumT = typename FragSum::element_type;
+
+                mFragSum.x[idx] += static_cast<SumT>(value);
+                return value;
+            }
+
+            FragSum& mFragSum;
+        };
+
+        template <typename FragAux>
+        struct Save
+        {
+            ROCWMMA_DEVICE Save(FragAux& fragAux)
+                : mFragAux(fragAux)
+            {
+            }
+
+            template <typename T>
+            ROCWMMA_DEVICE inline T operator()(T value, uint32_t idx) const
+            {
+                using AuxT = typename FragAux::element_type;
+
+                mFragAux.x[idx] = static_cast<AuxT>(value);
+                return value;
+            }
+
+            FragAux& mFragAux;
+        };
+
+        template <typename FragResidual>
+        struct ResidualAdd
+        {
+            ROCWMMA_DEVICE ResidualAdd(FragResidual const& fragResidual)
+                : mFragResidual(fragResidual)
+            {
+            }
+
+            template <typename T>
+            ROCWMMA_DEVICE inline T operator()(T value, uint32_t idx) const
+            {
+                return value + static_cast<T>(mFragResidual.x[idx]);
+            }
+
+            FragResidual const& mFragResidual;
+        };
+
+        template <typename ActivationT>
+        struct Activation
+        {
+            template <typename T>
+            ROCWMMA_DEVICE inline T operator()(T value, uint32_t /*idx*/) const
+            {
+                return ActivationT::exec(value);
+            }
+        };
+
+        template <typename ActivationT, typename FragUp>
+        struct GatedLinearUnit
+        {
+            ROCWMMA_DEVICE GatedLinearUnit(FragUp const& fragUp)
+                : mFragUp(fragUp)
+            {
+            }
+
+            template <typename T>
+            ROCWMMA_DEVICE inline T operator()(T value, uint32_t idx) const
+            {
+                return ActivationT::exec(value) * static_cast<T>(mFragUp.x[idx]);
+            }
+
+            FragUp const& mFragUp;
+        };
+
+        struct SquaredEuclidean
+        {
+            template <typename T>
+            ROCWMMA_DEVICE static inline T exec(T dot, T rowNorm, T colNorm)
+            {
+                auto dist = rowNorm + colNorm - static_cast<T>(2) * dot;
+                return dist > static_cast<T>(0) ? dist : static_cast<T>(0);
+            }
+        };
+
+        struct Cosine
+        {
+            template <typename T>
+            ROCWMMA_DEVICE static inline T exec(T dot, T rowNorm, T colNorm)
+            {
+                return static_cast<T>(1) - dot * rowNorm * colNorm;
+            }
+        };
+
+        template <typename MetricT, typename FragRowNorm, typename FragColNorm>
+        struct PairwiseDistance
+        {
+            ROCWMMA_DEVICE PairwiseDistance(MetricT,
+                                            FragRowNorm const& fragRowNorm,
+                                            FragColNorm const& fragColNorm)
+                : mFragRowNorm(fragRowNorm)
+                , mFragColNorm(fragColNorm)
+            {
+            }
+
+            template <typename T>
+            ROCWMMA_DEVICE inline T operator()(T value, uint32_t idx) const
+            {
+                return MetricT::exec(value,
+                                     static_cast<T>(mFragRowNorm.x[idx]),
+                                     static_cast<T>(mFragColNorm.x[idx]));
+            }
+
+            FragRowNorm const& mFragRowNorm;
+            FragColNorm const& mFragColNorm;
+        };
+
+        template <typename FragT>
+        struct Dropout
+        {
+            ROCWMMA_DEVICE Dropout(uint64_t  seed,
+                                   uint64_t  offset,
+                                   float32_t probability,
+                                   Coord2d   blockCoord,
+                                   uint32_t* keepBits = nullptr)
+                : mSeed(seed)
+                , mOffset(offset)
+                , mThreshold(static_cast<uint32_t>(probability * 4294967296.0f))
+                , mScale(1.0f / (1.0f - probability))
+                , mBlockCoord(blockCoord)
+                , mKeepBits(keepBits)
+            {
+                if(mKeepBits)
+                {
+                    *mKeepBits = 0u;
+                }
+            }
+
+            template <typename T>
+            ROCWMMA_DEVICE inline T operator()(T value, uint32_t idx) const
+            {
+                static_assert(FragT::num_elements <= 32u,
+                              "Kept bits hold up to 32 fragment elements per lane");
+
+                // Counter = (offset, row, col): one Philox stream per element of the output
+                auto coord = mBlockCoord + fragment_coords<FragT>::coord(idx);
+                auto rand  = rocwmma::detail::Philox4x32::generate(
+                    mSeed,
+                    {static_cast<uint32_t>(mOffset),
+                     static_cast<uint32_t>(mOffset >> 32u),
+                     static_cast<uint32_t>(get<0>(coord)),
+                     static_cast<uint32_t>(get<1>(coord))});
+
+                auto keep = rand.x >= mThreshold;
+                if(mKeepBits)
+                {
+                    *mKeepBits |= static_cast<uint32_t>(keep) << idx;
+                }
+                return keep ? value * static_cast<T>(mScale) : static_cast<T>(0);
+            }
+
+            uint64_t  mSeed;
+            uint64_t  mOffset;
+            uint32_t  mThreshold;
+            float32_t mScale;
+            Coord2d   mBlockCoord;
+            uint32_t* mKeepBits;
+        };
+
+        struct DropoutMask
+        {
+            ROCWMMA_DEVICE DropoutMask(uint32_t keepBits, float32_t probability)
+                : mKeepBits(keepBits)
+                , mScale(1.0f / (1.0f - probability))
+            {
+            }
+
+            template <typename T>
+            ROCWMMA_DEVICE inline T operator()(T value, uint32_t idx) const
+            {
+                return ((mKeepBits >> idx) & 1u) ? value * static_cast<T>(mScale)
+                                                 : static_cast<T>(0);
+            }
+
+            uint32_t  mKeepBits;
+            float32_t mScale;
+        };
+
+        template <typename FragT>
+        struct AttentionMask
+        {
+            ROCWMMA_DEVICE AttentionMask(Coord2d  blockCoord,
+                                         bool     causal,
+                                         uint32_t window   = 0u,
+                                         uint32_t keyCount = numeric_limits<uint32_t>::max())
+                : mBlockCoord(blockCoord)
+                , mCausal(causal)
+                , mWindow(window)
+                , mKeyCount(keyCount)
+            {
+            }
+
+            template <typename T>
+            ROCWMMA_DEVICE inline T operator()(T value, uint32_t idx) const
+            {
+                auto coord = mBlockCoord + fragment_coords<FragT>::coord(idx);
+                auto row   = get<0>(coord);
+                auto col   = get<1>(coord);
+
+                auto masked = col >= mKeyCount
+                              || (mCausal && (col > row || (mWindow > 0u && row - col >= mWindow)));
+                return masked ? -numeric_limits<T>::infinity() : value;
+            }
+
+            Coord2d  mBlockCoord;
+            bool     mCausal;
+            uint32_t mWindow;
+            uint32_t mKeyCount;
+        };
+
+        template <typename FragT, typename FragPartner>
+        struct RotaryEmbedding
+        {
+            ROCWMMA_DEVICE RotaryEmbedding(FragPartner const& fragPartner,
+                                           Coord2d            blockCoord,
+                                           uint32_t           headDim,
+                                           float32_t          thetaBase = 10000.0f,
+                                           index_t const*     positions = nullptr)
+                : mFragPartner(fragPartner)
+                , mBlockCoord(blockCoord)
+                , mHalfDim(headDim / 2u)
+                , mFreqScale(-::log2f(thetaBase) / static_cast<float32_t>(mHalfDim))
+                , mPositions(positions)
+            {
+            }
+
+            template <typename T>
+            ROCWMMA_DEVICE inline T operator()(T value, uint32_t idx) const
+            {
+                auto coord = mBlockCoord + fragment_coords<FragT>::coord(idx);
+                auto row   = get<0>(coord);
+                auto dim   = get<1>(coord) % (2u * mHalfDim);
+
+                // Pairs share the frequency of the first half dimension
+                auto pair     = dim % mHalfDim;
+                auto position = mPositions ? mPositions[row] : static_cast<index_t>(row);
+                auto angle    = static_cast<float32_t>(position)
+                             * ::exp2f(mFreqScale * static_cast<float32_t>(pair));
+
+                float32_t sinAngle, cosAngle;
+                ::sincosf(angle, &sinAngle, &cosAngle);
+
+                // x0' = x0 * cos - x1 * sin, x1' = x1 * cos + x0 * sin
+                auto partner = static_cast<float32_t>(mFragPartner.x[idx]);
+                auto rotated = static_cast<float32_t>(value) * cosAngle
+                               + (dim < mHalfDim ? -partner : partner) * sinAngle;
+                return static_cast<T>(rotated);
+            }
+
+            FragPartner const& mFragPartner;
+            Coord2d            mBlockCoord;
+            uint32_t           mHalfDim;
+            float32_t          mFreqScale;
+            index_t const*     mPositions;
+        };
+
+        template <typename DataT, uint32_t MaxPeers>
+        struct PeerStore
+        {
+            //! Stores frag at the element offset of each peer buffer
+            template <typename FragT>
+            ROCWMMA_DEVICE inline void
+                store(FragT const& frag, uint64_t offset, uint32_t ldm, layout_t layout) const
+            {
+                for(uint32_t i = 0; i < mPeerCount; i++)
+                {
+                    store_matrix_sync(mBuffers[i] + offset, frag, ldm, layout);
+                }
+            }
+
+            //! Publishes all prior stores of the wave, then sets flagIdx of each peer to epoch.
+            //! A monotonic epoch per invocation avoids resetting the flags between invocations.
+            ROCWMMA_DEVICE inline void signal(uint32_t flagIdx, uint32_t epoch) const
+            {
+                // Stores of every lane retire before the flags are written
+                __threadfence_system();
+                if(threadIdx.x % Constants::AMDGCN_WAVE_SIZE == 0u)
+                {
+                    for(uint32_t i = 0; i < mPeerCount; i++)
+                    {
+                        __hip_atomic_store(mFlags[i] + flagIdx,
+                                           epoch,
+                                           __ATOMIC_RELEASE,
+                                           __HIP_MEMORY_SCOPE_SYSTEM);
+                    }
+                }
+            }
+
+            //! Spins until the local flag reaches epoch, after which the peer's stores are visible
+            ROCWMMA_DEVICE static inline void wait(uint32_t const* flag, uint32_t epoch)
+            {
+                while(__hip_atomic_load(flag, __ATOMIC_ACQUIRE, __HIP_MEMORY_SCOPE_SYSTEM) < epoch)
+                {
+                    __builtin_amdgcn_s_sleep(1);
+                }
+            }
+
+            DataT*    mBuffers[MaxPeers];
+            uint32_t* mFlags[MaxPeers];
+            uint32_t  mPeerCount;
+        };
+
+    } // namespace epilogue
+
+    // Vector broadcasts are loaded through accumulators of fixed data layout with a
+    // leading dimension of 0, such that one of the matrix coordinates doesn't contribute
+    // to the data offset:
+    // - row_major: offset(i, j) = i * 0 + j
+    // - col_major: offset(i, j) = i + j * 0
+    // Accumulator fragments use the RowNT layout profile, whose register layout does not
+    // change with the data layout. The broadcast elements therefore line up with the
+    // target fragment, regardless of its own data layout.
+    // Column vectors are stored the same way, with all columns of a row writing one address.
+    // @cond
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void load_row_vector_sync(
+        fragment<accumulator, BlockM, BlockN, BlockK, DataT, DataLayoutT>& frag, const DataT* data)
+    {
+        using BroadcastFragT = fragment<accumulator, BlockM, BlockN, BlockK, DataT, row_major>;
+        load_matrix_sync(reinterpret_cast<BroadcastFragT&>(frag), data, 0u);
+    }
+
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void load_col_vector_sync(
+        fragment<accumulator, BlockM, BlockN, BlockK, DataT, DataLayoutT>& frag, const DataT* data)
+    {
+        using BroadcastFragT = fragment<accumulator, BlockM, BlockN, BlockK, DataT, col_major>;
+        load_matrix_sync(reinterpret_cast<BroadcastFragT&>(frag), data, 0u);
+    }
+
+    namespace detail
+    {
+        // A wave-uniform vector of Size elements, read once per wave into one register
+        // holding dword i of the vector in lane i.
+        template <typename DataT, uint32_t Size>
+        struct UniformVector
+        {
+            enum : uint32_t
+            {
+                Dwords = ceilDiv(Size * static_cast<uint32_t>(sizeof(DataT)), 4u),
+
+                // Widest scalar load, s_load_dwordx16
+                MaxScalarDwords = 16u,
+
+                Supported = (sizeof(DataT) <= 4u) && (Dwords <= Constants::AMDGCN_WAVE_SIZE)
+            };
+
+            ROCWMMA_DEVICE static inline uint32_t load(DataT const* data)
+            {
+                if constexpr(Dwords <= MaxScalarDwords)
+                {
+                    // Uniform addresses in the constant address space are read with s_load
+                    using ConstantPtrT = __attribute__((address_space(4))) uint32_t const*;
+
+                    // Keep the address in SGPRs
+                    auto address = reinterpret_cast<uint64_t>(data);
+                    auto lo      = static_cast<uint32_t>(address);
+                    auto hi      = static_cast<uint32_t>(address >> 32u);
+                    lo           = __builtin_amdgcn_readfirstlane(lo);
+                    hi           = __builtin_amdgcn_readfirstlane(hi);
+
+                    auto words
+                        = reinterpret_cast<ConstantPtrT>((static_cast<uint64_t>(hi) << 32u) | lo);
+
+                    auto result = 0;
+#pragma unroll
+                    for(uint32_t i = 0u; i < Dwords; i++)
+                    {
+                        result = __builtin_amdgcn_writelane(static_cast<int>(words[i]), i, result);
+                    }
+                    return static_cast<uint32_t>(result);
+                }
+                else
+                {
+                    auto lane  = laneId();
+                    auto words = reinterpret_cast<uint32_t const*>(data);
+                    return lane < Dwords ? words[lane] : 0u;
+                }
+            }
+
+            // Element idx of the vector, read from the lane holding its dword
+            ROCWMMA_DEVICE static inline DataT get(uint32_t dwords, uint32_t idx)
+            {
+                auto byte = idx * static_cast<uint32_t>(sizeof(DataT));
+                auto word = static_cast<uint32_t>(
+                    __builtin_amdgcn_ds_bpermute((byte / 4u) * 4u, static_cast<int>(dwords)));
+
+                using BitsT = conditional_t<sizeof(DataT) == 4u,
+                                            uint32_t,
+                                            conditional_t<sizeof(DataT) == 2u, uint16_t, uint8_t>>;
+
+                auto bits = static_cast<BitsT>(word >> (8u * (byte % 4u)));
+                return reinterpret_cast<DataT const&>(bits);
+            }
+        };
+
+    } // namespace detail
+
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void load_row_vector_uniform_sync(
+        fragment<accumulator, BlockM, BlockN, BlockK, DataT, DataLayoutT>& frag, const DataT* data)
+    {
+        using FragT  = decay_t<decltype(frag)>;
+        using Vector = detail::UniformVector<DataT, BlockN>;
+
+        if constexpr((bool)Vector::Supported)
+        {
+            using Coords = fragment_coords<FragT>;
+
+            auto dwords = Vector::load(data);
+
+#pragma unroll
+            for(uint32_t i = 0u; i < FragT::num_elements; i++)
+            {
+                frag.x[i] = Vector::get(dwords, Coords::col(i));
+            }
+        }
+        else
+        {
+            load_row_vector_sync(frag, data);
+        }
+    }
+
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void load_col_vector_uniform_sync(
+        fragment<accumulator, BlockM, BlockN, BlockK, DataT, DataLayoutT>& frag, const DataT* data)
+    {
+        using FragT  = decay_t<decltype(frag)>;
+        using Vector = detail::UniformVector<DataT, BlockM>;
+
+        if constexpr((bool)Vector::Supported)
+        {
+            using Coords = fragment_coords<FragT>;
+
+            auto dwords = Vector::load(data);
+
+#pragma unroll
+            for(uint32_t i = 0u; i < FragT::num_elements; i++)
+            {
+                frag.x[i] = Vector::get(dwords, Coords::row(i));
+            }
+        }
+        else
+        {
+            load_col_vector_sync(frag, data);
+        }
+    }
+
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void store_col_vector_sync(
+        DataT* data, fragment<accumulator, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& frag)
+    {
+        using BroadcastFragT = fragment<accumulator, BlockM, BlockN, BlockK, DataT, col_major>;
+        store_matrix_sync(data, reinterpret_cast<BroadcastFragT const&>(frag), 0u);
+    }
+
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void store_matrix_dual_sync(
+        DataT*                                                                   data,
+        DataT*                                                                   dataT,
+        fragment<accumulator, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& frag,
+        uint32_t                                                                 ldm,
+        uint32_t                                                                 ldmT)
+    {
+        using FragRowMajor = fragment<accumulator, BlockM, BlockN, BlockK, DataT, row_major>;
+        using FragColMajor = fragment<accumulator, BlockM, BlockN, BlockK, DataT, col_major>;
+
+        // D^T(j, i) = dataT[j * ldmT + i] is the col major store of D
+        store_matrix_sync(data, reinterpret_cast<FragRowMajor const&>(frag), ldm);
+        store_matrix_sync(dataT, reinterpret_cast<FragColMajor const&>(frag), ldmT);
+    }
+
+    template <uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename DataLayoutT>
+    ROCWMMA_DEVICE void atomic_amax_sync(
+        float32_t*                                                                   data,
+        fragment<accumulator, BlockM, BlockN, BlockK, float32_t, DataLayoutT> const& fragAmax)
+    {
+        // Every element holds the block maximum after both reductions
+        auto blockAmax = reduce_cols<reduce::Max>(reduce_rows<reduce::Max>(fragAmax));
+        if(detail::laneId() == 0u)
+        {
+            atomicMax(reinterpret_cast<uint32_t*>(data), __float_as_uint(blockAmax.x[0]));
+        }
+    }
+
+    namespace detail
+    {
+        template <typename ReduceOpT, typename DataT>
+        ROCWMMA_DEVICE static inline void atomicReduce(DataT* data, DataT value)
+        {
+            static_assert(is_same_v<DataT, float32_t> || is_same_v<DataT, int32_t>
+                              || is_same_v<DataT, uint32_t>,
+                          "Atomic vector reductions are not available for this DataT");
+
+            if constexpr(is_same_v<ReduceOpT, reduce::Sum>)
+            {
+                atomicAdd(data, value);
+            }
+            else if constexpr(is_same_v<ReduceOpT, reduce::Max>)
+            {
+                atomicMax(data, value);
+            }
+            else
+            {
+                static_assert(is_same_v<ReduceOpT, reduce::Min>, "Unsupported ReduceOpT");
+                atomicMin(data, value);
+            }
+        }
+
+        // Orders float32_t bit patterns as unsigned integers: negatives are inverted, positives
+        // have their sign bit set, such that the integer max is the float max.
+        ROCWMMA_HOST_DEVICE static inline uint32_t argmaxOrderedBits(float32_t value)
+        {
+            auto bits = __builtin_bit_cast(uint32_t, value);
+            return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+        }
+
+        ROCWMMA_DEVICE static inline void atomicArgmax(uint64_t* key, float32_t value, int32_t index)
+        {
+            // Lower indices pack to larger keys, which keep the first max on ties
+            uint64_t packed = (static_cast<uint64_t>(argmaxOrderedBits(value)) << 32u)
+                              | static_cast<uint32_t>(~static_cast<uint32_t>(index));
+            atomicMax(reinterpret_cast<unsigned long long*>(key),
+                      static_cast<unsigned long long>(packed));
+        }
+
+    } // namespace detail
+
+    template <typename ReduceOpT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void atomic_reduce_col_vector_sync(
+        DataT* data, fragment<accumulator, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& frag)
+    {
+        using FragT  = decay_t<decltype(frag)>;
+        using Coords = fragment_coords<FragT>;
+
+#pragma unroll
+        for(uint32_t i = 0u; i < FragT::num_elements; i++)
+        {
+            if(Coords::col(i) == 0u)
+            {
+                detail::atomicReduce<ReduceOpT>(data + Coords::row(i), frag.x[i]);
+            }
+        }
+    }
+
+    template <typename ReduceOpT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void atomic_reduce_row_vector_sync(
+        DataT* data, fragment<accumulator, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& frag)
+    {
+        using FragT  = decay_t<decltype(frag)>;
+        using Coords = fragment_coords<FragT>;
+
+#pragma unroll
+        for(uint32_t i = 0u; i < FragT::num_elements; i++)
+        {
+            if(Coords::row(i) == 0u)
+            {
+                detail::atomicReduce<ReduceOpT>(data + Coords::col(i), frag.x[i]);
+            }
+        }
+    }
+
+    template <uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename DataLayoutT>
+    ROCWMMA_DEVICE void atomic_argmax_col_vector_sync(
+        uint64_t*                                                                    keys,
+        fragment<accumulator, BlockM, BlockN, BlockK, float32_t, DataLayoutT> const& vals,
+        fragment<accumulator, BlockM, BlockN, BlockK, int32_t, DataLayoutT> const&   idx)
+    {
+        using FragT  = decay_t<decltype(vals)>;
+        using Coords = fragment_coords<FragT>;
+
+#pragma unroll
+        for(uint32_t i = 0u; i < FragT::num_elements; i++)
+        {
+            if(Coords::col(i) == 0u)
+            {
+                detail::atomicArgmax(keys + Coords::row(i), vals.x[i], idx.x[i]);
+            }
+        }
+    }
+
+    template <uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename DataLayoutT>
+    ROCWMMA_DEVICE void atomic_argmax_row_vector_sync(
+        uint64_t*                                                                    keys,
+        fragment<accumulator, BlockM, BlockN, BlockK, float32_t, DataLayoutT> const& vals,
+        fragment<accumulator, BlockM, BlockN, BlockK, int32_t, DataLayoutT> const&   idx)
+    {
+        using FragT  = decay_t<decltype(vals)>;
+        using Coords = fragment_coords<FragT>;
+
+#pragma unroll
+        for(uint32_t i = 0u; i < FragT::num_elements; i++)
+        {
+            if(Coords::row(i) == 0u)
+            {
+                detail::atomicArgmax(keys + Coords::col(i), vals.x[i], idx.x[i]);
+            }
+        }
+    }
+
+    ROCWMMA_HOST_DEVICE static inline float32_t argmax_key_value(uint64_t key)
+    {
+        auto bits = static_cast<uint32_t>(key >> 32u);
+        bits      = (bits & 0x80000000u) ? (bits & 0x7FFFFFFFu) : ~bits;
+        return __builtin_bit_cast(float32_t, bits);
+    }
+
+    ROCWMMA_HOST_DEVICE static inline int32_t argmax_key_index(uint64_t key)
+    {
+        return static_cast<int32_t>(~static_cast<uint32_t>(key));
+    }
+
+    template <typename FragT>
+    ROCWMMA_DEVICE void store_dropout_mask_sync(uint32_t* data, uint32_t keepBits)
+    {
+        // Each element is one ballot over the wave, of WaveWords words of 32 lanes
+        constexpr uint32_t WaveWords = Constants::AMDGCN_WAVE_SIZE / 32u;
+        constexpr uint32_t Words     = FragT::num_elements * WaveWords;
+        static_assert(Words <= Constants::AMDGCN_WAVE_SIZE, "Mask words exceed the wave size");
+
+        // Lane i keeps word i, such that the block is stored in a single access
+        auto     lane = detail::laneId();
+        uint32_t word = 0u;
+
+#pragma unroll
+        for(uint32_t idx = 0u; idx < FragT::num_elements; idx++)
+        {
+            uint64_t ballot = __ballot((keepBits >> idx) & 1u);
+
+#pragma unroll
+            for(uint32_t w = 0u; w < WaveWords; w++)
+            {
+                if(lane == idx * WaveWords + w)
+                {
+                    word = static_cast<uint32_t>(ballot >> (32u * w));
+                }
+            }
+        }
+
+        if(lane < Words)
+        {
+            data[lane] = word;
+        }
+    }
+
+    template <typename FragT>
+    ROCWMMA_DEVICE uint32_t load_dropout_mask_sync(uint32_t const* data)
+    {
+        constexpr uint32_t WaveWords = Constants::AMDGCN_WAVE_SIZE / 32u;
+
+        auto     lane     = detail::laneId();
+        uint32_t keepBits = 0u;
+
+#pragma unroll
+        for(uint32_t idx = 0u; idx < FragT::num_elements; idx++)
+        {
+            auto word = data[idx * WaveWords + lane / 32u];
+            keepBits |= ((word >> (lane % 32u)) & 1u) << idx;
+        }
+        return keepBits;
+    }
+
+    template <typename FragT>
+    ROCWMMA_DEVICE void store_nonzero_flag_sync(uint32_t* flag, FragT const& frag)
+    {
+        auto isZero = is_zero_sync(frag);
+        if(detail::laneId() == 0u)
+        {
+            *flag = isZero ? 0u : 1u;
+        }
+    }
+
+    ROCWMMA_DEVICE static inline bool load_nonzero_flag_sync(uint32_t const* flag)
+    {
+        // A single uniform read: keep the result in a scalar register for scalar branches
+        return __builtin_amdgcn_readfirstlane(*flag) != 0u;
+    }
+
+    template <typename ComputeT>
+    ROCWMMA_DEVICE static inline linear_combination_t get_linear_combination(ComputeT alpha,
+                                                                             ComputeT beta)
+    {
+        auto result = linear_full;
+        if(beta == static_cast<ComputeT>(0))
+        {
+            result = (alpha == static_cast<ComputeT>(1)) ? linear_identity : linear_scale;
+        }
+
+        // Uniform inputs give a uniform case: keep it in a scalar register for scalar branches
+        return static_cast<linear_combination_t>(
+            __builtin_amdgcn_readfirstlane(static_cast<uint32_t>(result)));
+    }
+
+    template <typename FragOutT, typename FragAccT, typename... StageTs>
+    ROCWMMA_DEVICE static inline void
+        apply_epilogue(FragOutT& fragOut, FragAccT const& fragAcc, StageTs const&... stages)
+    {
+        using ComputeT = typename FragAccT::element_type;
+        using OutputT  = typename FragOutT::element_type;
+
+        static_assert(FragOutT::num_elements == FragAccT::num_elements,
+                      "Output and accumulator fragments must have the same number of elements");
+
+        // Stages are applied in ComputeT, then the output is converted as a whole vector
+        // to allow packed conversions (e.g. int32_t -> int8_t).
+        VecT<ComputeT, FragAccT::num_elements> result;
+
+#pragma unroll
+        for(uint32_t i = 0; i < FragAccT::num_elements; i++)
+        {
+            auto value = static_cast<ComputeT>(fragAcc.x[i]);
+            ((value = stages(value, i)), ...);
+            result.data[i] = value;
+        }
+
+        fragOut.mAccess = Convert<ComputeT, OutputT>::exec(result);
+    }
+    // @endcond
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_EPILOGUE_API_IMPL_HPP
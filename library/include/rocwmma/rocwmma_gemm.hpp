@@ -0,0 +1,210 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_GEMM_API_HPP
+#define ROCWMMA_GEMM_API_HPP
+
+#include <algorithm>
+
+#include <hip/hip_runtime.h>
+
+#include "rocwmma.hpp"
+#include "rocwmma_dispatch.hpp"
+#include "rocwmma_tile.hpp"
+
+/**
+ * rocWMMA gemm is a complimentary host API for rocWMMA, computing
+ *
+ *     D = alpha * op(A) x op(B) + beta * C
+ *
+ * for any M, N and K, without writing a kernel. Matrices are column major, following the
+ * BLAS convention: op(A) is M x K, op(B) is K x N, and C and D are M x N. A transposed
+ * operand is read as the row major view of the stored matrix, so no transpose pass is needed.
+ *
+ * The kernels hold the warp tile of warp_tile_config for the input type and the target
+ * being compiled, such that each target of an --offload-arch fat binary runs its validated
+ * tile. Workgroups visit the macro tiles in grouped raster order. Edge tiles are loaded and
+ * stored bounded, so neither the sizes nor the leading dimensions need padding. Products
+ * accumulate in float32_t. A and B are loaded in 16B vectors when the pointers, leading
+ * dimensions and batch strides of both are 16B aligned, and in element vectors otherwise.
+ *
+ * When the problem has fewer macro tiles than the device has CUs and a deep K, K is split
+ * over several workgroups per tile. Each split writes float32_t partial sums to the workspace,
+ * and a reduction applies alpha, beta and C.
+ *
+ * Usage:
+ *  - Create a handle with gemm_create_handle() on the device it will run on. A handle binds
+ *    the device, a stream and a workspace, and is used by one host thread at a time.
+ *  - Optionally bind a stream with gemm_set_stream(), and a workspace with gemm_set_workspace().
+ *    Without a user workspace, the handle allocates one on demand and grows it as needed;
+ *    growing it synchronizes the device.
+ *  - Call gemm(), gemm_strided_batched() or gemm_grouped() with device pointers. All calls
+ *    are asynchronous, in order on the stream of the handle.
+ *
+ * Supported InputT: float16_t, bfloat16_t. Supported OutputT: InputT, float32_t.
+ */
+
+namespace rocwmma
+{
+    //! Transposition of a GEMM operand
+    enum operation_t : uint32_t
+    {
+        operation_none,
+        operation_transpose
+    };
+
+    //! Opaque state of the gemm API: device, stream and workspace
+    struct gemm_handle;
+    using gemm_handle_t = gemm_handle*;
+
+    //! @struct gemm_grouped_problem
+    //! @brief One GEMM of a group, D = alpha * op(A) x op(B) + beta * C, with the arguments
+    //! of gemm()
+    template <typename InputT, typename OutputT>
+    struct gemm_grouped_problem
+    {
+        uint32_t       m, n, k;
+        InputT const*  a;
+        uint32_t       lda;
+        InputT const*  b;
+        uint32_t       ldb;
+        OutputT const* c;
+        uint32_t       ldc;
+        OutputT*       d;
+        uint32_t       ldd;
+        float32_t      alpha;
+        float32_t      beta;
+    };
+
+    //! Creates a handle on the current device, bound to the null stream
+    //! @param handle Receives the new handle
+    //! @returns hipErrorInvalidValue for a null handle pointer, otherwise the status of the
+    //! device queries
+    ROCWMMA_HOST inline hipError_t gemm_create_handle(gemm_handle_t* handle);
+
+    //! Releases the handle and its handle-owned workspace. Synchronizes the stream of the handle.
+    ROCWMMA_HOST inline hipError_t gemm_destroy_handle(gemm_handle_t handle);
+
+    //! Binds the stream that subsequent calls on the handle are enqueued on
+    //! @note The workspace is shared by all calls on the handle: work pending on the previous
+    //! stream must complete before the new stream uses it.
+    ROCWMMA_HOST inline hipError_t gemm_set_stream(gemm_handle_t handle, hipStream_t stream);
+
+    //! @returns The stream bound to the handle, through stream
+    ROCWMMA_HOST inline hipError_t gemm_get_stream(gemm_handle_t handle, hipStream_t* stream);
+
+    //! Binds a user workspace to the handle, replacing the handle-owned one
+    //! @param workspace Device memory of at least bytes, or nullptr to return to a handle-owned
+    //! workspace
+    //! @param bytes Size of the workspace. Split-K is limited to the splits that fit.
+    ROCWMMA_HOST inline hipError_t
+        gemm_set_workspace(gemm_handle_t handle, void* workspace, size_t bytes);
+
+    //! Queries the workspace that gemm() or gemm_strided_batched() will use for a problem
+    //! @param bytes Receives the workspace size, 0 when K is not split
+    //! @tparam InputT Datatype of A and B
+    template <typename InputT>
+    ROCWMMA_HOST inline hipError_t gemm_get_workspace_size(gemm_handle_t handle,
+                                                           uint32_t      m,
+                                                           uint32_t      n,
+                                                           uint32_t      k,
+                                                           uint32_t      batchCount,
+                                                           size_t*       bytes);
+
+    //! @returns The workspace that gemm_grouped() uses for groupCount problems
+    template <typename InputT, typename OutputT>
+    ROCWMMA_HOST constexpr inline size_t gemm_grouped_workspace_size(uint32_t groupCount);
+
+    //! Enqueues D = alpha * op(A) x op(B) + beta * C on the stream of the handle
+    //! @param opA/opB Transposition of A and B
+    //! @param m/n/k Problem size
+    //! @param a A, M x K (opA none) or K x M (opA transpose), with leading dimension lda
+    //! @param b B, K x N (opB none) or N x K (opB transpose), with leading dimension ldb
+    //! @param c C, M x N with leading dimension ldc. Not read when beta is 0.
+    //! @param d D, M x N with leading dimension ldd. May be the same matrix as C.
+    //! @returns hipErrorInvalidHandle for a null handle, hipErrorInvalidValue for a leading
+    //! dimension smaller than the rows of its matrix, otherwise the status of the launches
+    template <typename InputT, typename OutputT>
+    ROCWMMA_HOST inline hipError_t gemm(gemm_handle_t  handle,
+                                        operation_t    opA,
+                                        operation_t    opB,
+                                        uint32_t       m,
+                                        uint32_t       n,
+                                        uint32_t       k,
+                                        float32_t      alpha,
+                                        InputT const*  a,
+                                        uint32_t       lda,
+                                        InputT const*  b,
+                                        uint32_t       ldb,
+                                        float32_t      beta,
+                                        OutputT const* c,
+                                        uint32_t       ldc,
+                                        OutputT*       d,
+                                        uint32_t       ldd);
+
+    //! Enqueues batchCount GEMMs of the same size, matrix i of each operand at i * stride
+    //! elements from the first. Arguments are as for gemm().
+    template <typename InputT, typename OutputT>
+    ROCWMMA_HOST inline hipError_t gemm_strided_batched(gemm_handle_t  handle,
+                                                        operation_t    opA,
+                                                        operation_t    opB,
+                                                        uint32_t       m,
+                                                        uint32_t       n,
+                                                        uint32_t       k,
+                                                        float32_t      alpha,
+                                                        InputT const*  a,
+                                                        uint32_t       lda,
+                                                        uint64_t       strideA,
+                                                        InputT const*  b,
+                                                        uint32_t       ldb,
+                                                        uint64_t       strideB,
+                                                        float32_t      beta,
+                                                        OutputT const* c,
+                                                        uint32_t       ldc,
+                                                        uint64_t       strideC,
+                                                        OutputT*       d,
+                                                        uint32_t       ldd,
+                                                        uint64_t       strideD,
+                                                        uint32_t       batchCount);
+
+    //! Enqueues a group of GEMMs of different sizes with the same transpositions, in a single
+    //! launch over the macro tiles of all problems. K is not split.
+    //! @param problems Host array of groupCount problem descriptors. It is staged to the
+    //! workspace, and may be reused as soon as the call returns.
+    //! @returns hipErrorInvalidValue when a user workspace is smaller than
+    //! gemm_grouped_workspace_size(), otherwise as for gemm()
+    template <typename InputT, typename OutputT>
+    ROCWMMA_HOST inline hipError_t
+        gemm_grouped(gemm_handle_t                                handle,
+                     operation_t                                  opA,
+                     operation_t                                  opB,
+                     gemm_grouped_problem<InputT, OutputT> const* problems,
+                     uint32_t                                     groupCount);
+
+} // namespace rocwmma
+
+#include "rocwmma_gemm_impl.hpp"
+
+#endif // ROCWMMA_GEMM_API_HPP
@@ -0,0 +1,906 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_GEMM_API_IMPL_HPP
+#define ROCWMMA_GEMM_API_IMPL_HPP
+
+#include "rocwmma_gemm.hpp"
+
+namespace rocwmma
+{
+    struct gemm_handle
+    {
+        int         device;
+        uint32_t    archId;
+        uint32_t    cuCount;
+        hipStream_t stream;
+
+        // Split-K partials and grouped descriptors. Grown on demand unless set by the user.
+        void*  workspace;
+        size_t workspaceBytes;
+        bool   userWorkspace;
+
+        // Pinned staging of the grouped descriptors, free once the last copy from it is done
+        void*      staging;
+        size_t     stagingBytes;
+        hipEvent_t stagingDone;
+    };
+
+    // @cond
+    namespace detail
+    {
+        // Band height, in macro tiles, of the grouped raster order
+        constexpr uint32_t GemmTileGroup = 4u;
+
+        // Split-K limits: K per split, and splits per macro tile
+        constexpr uint32_t GemmMinSplitK = 256u;
+        constexpr uint32_t GemmMaxSplits = 16u;
+
+        // Threads per workgroup of the split-K reduction
+        constexpr uint32_t GemmReduceThreads = 256u;
+
+        // Alignment of the widest A and B loads
+        constexpr uint32_t GemmAlignBytes = 16u;
+
+        template <typename InputT>
+        using GemmConfig = warp_tile_config_t<InputT>;
+
+        template <typename InputT, typename OutputT>
+        constexpr bool isGemmSupported
+            = (is_same_v<InputT, float16_t> || is_same_v<InputT, bfloat16_t>)
+              && (is_same_v<OutputT, InputT> || is_same_v<OutputT, float32_t>);
+
+        // Arguments of gemm_kernel: one problem size, batchCount strided matrices per operand
+        // and the K split of each macro tile
+        template <typename InputT, typename OutputT>
+        struct GemmBatchArgs
+        {
+            gemm_grouped_problem<InputT, OutputT> problem;
+
+            uint64_t strideA, strideB, strideC, strideD;
+
+            // K of each split, and the splitCount float32_t partials of each batch
+            uint32_t   splitK;
+            uint32_t   splitCount;
+            float32_t* partials;
+        };
+
+        // Computes the warp tile at (row, col) of D over [kBegin, kEnd). Without partials, the
+        // warp tile is finished with alpha, beta and C, otherwise its float32_t partial sums are
+        // stored to partials with leading dimension M. The warp tile must start inside D.
+        // A, B and their leading dimensions are aligned to AlignBytes.
+        template <typename InputT,
+                  typename OutputT,
+                  typename LayoutA,
+                  typename LayoutB,
+                  uint32_t AlignBytes>
+        ROCWMMA_DEVICE inline void
+            gemmWarpTile(gemm_grouped_problem<InputT, OutputT> const& p,
+                         uint32_t                                     row,
+                         uint32_t                                     col,
+                         uint32_t                                     kBegin,
+                         uint32_t                                     kEnd,
+                         float32_t*                                   partials)
+        {
+            using Config = GemmConfig<InputT>;
+
+            constexpr uint32_t BlockM  = Config::block_m;
+            constexpr uint32_t BlockN  = Config::block_n;
+            constexpr uint32_t BlockK  = Config::block_k;
+            constexpr uint32_t BlocksX = Config::blocks_x;
+            constexpr uint32_t BlocksY = Config::blocks_y;
+
+            using FragA   = fragment<matrix_a, BlockM, BlockN, BlockK, InputT, LayoutA>;
+            using FragB   = fragment<matrix_b, BlockM, BlockN, BlockK, InputT, LayoutB>;
+            using FragC   = fragment<accumulator, BlockM, BlockN, BlockK, OutputT, col_major>;
+            using FragAcc = fragment<accumulator, BlockM, BlockN, BlockK, float32_t>;
+
+            using MapA = GetDataLayout_t<FragA>;
+            using MapB = GetDataLayout_t<FragB>;
+            using MapC = GetDataLayout_t<FragC>;
+
+            // Warp tiles and K steps start at multiples of the block sizes
+            constexpr uint32_t OriginBytes = (BlockM | BlockN | BlockK) * (uint32_t)sizeof(InputT);
+            constexpr uint32_t OriginAlign = OriginBytes & (~OriginBytes + 1u);
+            constexpr uint32_t TileAlign   = OriginAlign < AlignBytes ? OriginAlign : AlignBytes;
+
+            // Interior warp tiles load whole blocks, edge tiles and the K tail are bounded
+            auto rows     = p.m - row;
+            auto cols     = p.n - col;
+            bool interior = rows >= Config::warp_tile_x && cols >= Config::warp_tile_y;
+
+            // Rows and columns of D from the origin of block i or j, 0 past the edge
+            auto blockRows = [rows](uint32_t i) {
+                return rows > i * BlockM ? rows - i * BlockM : 0u;
+            };
+            auto blockCols = [cols](uint32_t j) {
+                return cols > j * BlockN ? cols - j * BlockN : 0u;
+            };
+
+            fragment_array<FragA, BlocksX, 1u>        tileA;
+            fragment_array<FragB, 1u, BlocksY>        tileB;
+            fragment_array<FragAcc, BlocksX, BlocksY> tileAcc;
+
+            fill_fragment(tileAcc, 0.0f);
+
+            for(auto k = kBegin; k < kEnd; k += BlockK)
+            {
+                auto depth = kEnd - k;
+                auto a     = p.a + MapA::fromMatrixCoord(make_coord2d(row, k), p.lda);
+                auto b     = p.b + MapB::fromMatrixCoord(make_coord2d(k, col), p.ldb);
+
+                if(interior && depth >= BlockK)
+                {
+                    load_matrix_sync(tileA, make_aligned_ptr<TileAlign>(a), p.lda);
+                    load_matrix_sync(tileB, make_aligned_ptr<TileAlign>(b), p.ldb);
+                }
+                else
+                {
+#pragma unroll
+                    for(uint32_t i = 0u; i < BlocksX; i++)
+                    {
+                        load_matrix_bounded_sync(
+                            tileA(i),
+                            a + MapA::fromMatrixCoord(make_coord2d(i * BlockM, 0u), p.lda),
+                            p.lda,
+                            blockRows(i),
+                            depth);
+                    }
+#pragma unroll
+                    for(uint32_t j = 0u; j < BlocksY; j++)
+                    {
+                        load_matrix_bounded_sync(
+                            tileB(0u, j),
+                            b + MapB::fromMatrixCoord(make_coord2d(0u, j * BlockN), p.ldb),
+                            p.ldb,
+                            depth,
+                            blockCols(j));
+                    }
+                }
+
+                mma_sync(tileAcc, tileA, tileB, tileAcc);
+            }
+
+#pragma unroll
+            for(uint32_t i = 0u; i < BlocksX; i++)
+            {
+#pragma unroll
+                for(uint32_t j = 0u; j < BlocksY; j++)
+                {
+                    auto blockRow = row + i * BlockM;
+                    auto blockCol = col + j * BlockN;
+                    if(blockRows(i) == 0u || blockCols(j) == 0u)
+                    {
+                        continue;
+                    }
+
+                    if(partials != nullptr)
+                    {
+                        store_matrix_bounded_sync(partials + static_cast<uint64_t>(blockCol) * p.m
+                                                      + blockRow,
+                                                  tileAcc(i, j),
+                                                  p.m,
+                                                  blockRows(i),
+                                                  blockCols(j),
+                                                  mem_col_major);
+                        continue;
+                    }
+
+                    // D = alpha * acc + beta * C, C not read when beta is 0
+                    FragC fragC;
+                    if(p.beta != 0.0f)
+                    {
+                        load_matrix_bounded_sync(
+                            fragC,
+                            p.c + MapC::fromMatrixCoord(make_coord2d(blockRow, blockCol), p.ldc),
+                            p.ldc,
+                            blockRows(i),
+                            blockCols(j));
+                    }
+                    else
+                    {
+                        fill_fragment(fragC, static_cast<OutputT>(0.0f));
+                    }
+
+                    auto const& fragAcc = tileAcc(i, j);
+                    for(uint32_t e = 0u; e < fragC.num_elements; e++)
+                    {
+                        fragC.x[e] = static_cast<OutputT>(
+                            p.alpha * fragAcc.x[e] + p.beta * static_cast<float32_t>(fragC.x[e]));
+                    }
+
+                    store_matrix_bounded_sync(
+                        p.d + MapC::fromMatrixCoord(make_coord2d(blockRow, blockCol), p.ldd),
+                        fragC,
+                        p.ldd,
+                        blockRows(i),
+                        blockCols(j));
+                }
+            }
+        }
+
+        // Origin of the warp tile of this wave in the macro tile (tileX, tileY)
+        template <typename InputT>
+        ROCWMMA_DEVICE inline Coord2d gemmWarpTileCoord(uint32_t tileX, uint32_t tileY)
+        {
+            using Config = GemmConfig<InputT>;
+            return make_coord2d(tileX * Config::macro_tile_x
+                                    + threadIdx.x / Config::wave_size * Config::warp_tile_x,
+                                tileY * Config::macro_tile_y + threadIdx.y * Config::warp_tile_y);
+        }
+
+        // Macro tiles over (blockIdx.x), K splits (blockIdx.y) and batches (blockIdx.z)
+        template <typename InputT,
+                  typename OutputT,
+                  typename LayoutA,
+                  typename LayoutB,
+                  uint32_t AlignBytes>
+        ROCWMMA_KERNEL void __launch_bounds__(GemmConfig<InputT>::tblock_x
+                                              * GemmConfig<InputT>::tblock_y)
+            gemm_kernel(GemmBatchArgs<InputT, OutputT> args)
+        {
+            using Config = GemmConfig<InputT>;
+
+            auto p      = args.problem;
+            auto tilesX = ceilDiv(p.m, Config::macro_tile_x);
+            auto tilesY = ceilDiv(p.n, Config::macro_tile_y);
+            auto tile   = raster::grouped<GemmTileGroup>::tile_coord(blockIdx.x, tilesX, tilesY);
+            auto origin = gemmWarpTileCoord<InputT>(get<0>(tile), get<1>(tile));
+            if(get<0>(origin) >= p.m || get<1>(origin) >= p.n)
+            {
+                return;
+            }
+
+            auto split = blockIdx.y;
+            auto batch = static_cast<uint64_t>(blockIdx.z);
+            p.a += batch * args.strideA;
+            p.b += batch * args.strideB;
+            p.c += batch * args.strideC;
+            p.d += batch * args.strideD;
+
+            auto kBegin = split * args.splitK;
+            auto kEnd   = min(p.k, kBegin + args.splitK);
+
+            auto partials = args.splitCount > 1u
+                                ? args.partials
+                                      + (batch * args.splitCount + split)
+                                            * static_cast<uint64_t>(p.m) * p.n
+                                : nullptr;
+
+            gemmWarpTile<InputT, OutputT, LayoutA, LayoutB, AlignBytes>(
+                p, get<0>(origin), get<1>(origin), kBegin, kEnd, partials);
+        }
+
+        // Sums the K splits of each element of D (blockIdx.x) for each batch (blockIdx.y), and
+        // applies alpha, beta and C
+        template <typename InputT, typename OutputT>
+        ROCWMMA_KERNEL void __launch_bounds__(GemmReduceThreads)
+            gemm_reduce_kernel(GemmBatchArgs<InputT, OutputT> args)
+        {
+            auto const& p        = args.problem;
+            auto        size     = static_cast<uint64_t>(p.m) * p.n;
+            auto        batch    = static_cast<uint64_t>(blockIdx.y);
+            auto        partials = args.partials + batch * args.splitCount * size;
+
+            for(auto idx = static_cast<uint64_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+                idx < size;
+                idx += static_cast<uint64_t>(gridDim.x) * blockDim.x)
+            {
+                float32_t accum = 0.0f;
+                for(uint32_t s = 0u; s < args.splitCount; s++)
+                {
+                    accum += partials[s * size + idx];
+                }
+
+                auto row    = static_cast<uint32_t>(idx % p.m);
+                auto col    = static_cast<uint32_t>(idx / p.m);
+                auto result = p.alpha * accum;
+                if(p.beta != 0.0f)
+                {
+                    result += p.beta
+                              * static_cast<float32_t>(p.c[batch * args.strideC
+                                                           + static_cast<uint64_t>(col) * p.ldc
+                                                           + row]);
+                }
+                p.d[batch * args.strideD + static_cast<uint64_t>(col) * p.ldd + row]
+                    = static_cast<OutputT>(result);
+            }
+        }
+
+        // Finds the problem of the given macro tile in the exclusive prefix sum of the tile
+        // counts: the largest i such that tileOffsets[i] <= tileIndex
+        ROCWMMA_DEVICE inline uint32_t
+            gemmFindProblem(uint32_t const* tileOffsets, uint32_t groupCount, uint32_t tileIndex)
+        {
+            uint32_t lo = 0u;
+            uint32_t hi = groupCount;
+            while(hi - lo > 1u)
+            {
+                auto mid = (lo + hi) / 2u;
+                if(tileOffsets[mid] <= tileIndex)
+                {
+                    lo = mid;
+                }
+                else
+                {
+                    hi = mid;
+                }
+            }
+            return lo;
+        }
+
+        // Macro tiles of all problems of the group (blockIdx.x)
+        template <typename InputT,
+                  typename OutputT,
+                  typename LayoutA,
+                  typename LayoutB,
+                  uint32_t AlignBytes>
+        ROCWMMA_KERNEL void __launch_bounds__(GemmConfig<InputT>::tblock_x
+                                              * GemmConfig<InputT>::tblock_y)
+            gemm_grouped_kernel(gemm_grouped_problem<InputT, OutputT> const* problems,
+                                uint32_t const*                              tileOffsets,
+                                uint32_t                                     groupCount)
+        {
+            using Config = GemmConfig<InputT>;
+
+            auto  problemIndex = gemmFindProblem(tileOffsets, groupCount, blockIdx.x);
+            auto  localTile    = blockIdx.x - tileOffsets[problemIndex];
+            auto& p            = problems[problemIndex];
+
+            auto tilesX = ceilDiv(p.m, Config::macro_tile_x);
+            auto tilesY = ceilDiv(p.n, Config::macro_tile_y);
+            auto tile   = raster::grouped<GemmTileGroup>::tile_coord(localTile, tilesX, tilesY);
+            auto origin = gemmWarpTileCoord<InputT>(get<0>(tile), get<1>(tile));
+            if(get<0>(origin) >= p.m || get<1>(origin) >= p.n)
+            {
+                return;
+            }
+
+            gemmWarpTile<InputT, OutputT, LayoutA, LayoutB, AlignBytes>(
+                p, get<0>(origin), get<1>(origin), 0u, p.k, nullptr);
+        }
+
+        // Calls func with the data layouts of A and B for the transpositions. Column major
+        // matrices are read transposed as row major.
+        template <typename FuncT>
+        ROCWMMA_HOST inline hipError_t
+            gemmDispatchLayouts(operation_t opA, operation_t opB, FuncT&& func)
+        {
+            auto withLayoutB = [&](auto layoutA) {
+                return opB == operation_none ? func(layoutA, col_major{})
+                                             : func(layoutA, row_major{});
+            };
+            return opA == operation_none ? withLayoutB(col_major{}) : withLayoutB(row_major{});
+        }
+
+        // Calls func with the alignment of the A and B loads: the widest vectors when aligned,
+        // otherwise element vectors
+        template <typename InputT, typename FuncT>
+        ROCWMMA_HOST inline hipError_t gemmDispatchAlign(bool aligned, FuncT&& func)
+        {
+            return aligned ? func(integral_constant<uint32_t, GemmAlignBytes>{})
+                           : func(integral_constant<uint32_t, (uint32_t)sizeof(InputT)>{});
+        }
+
+        template <typename InputT, typename OutputT>
+        ROCWMMA_HOST inline bool gemmAligned(gemm_grouped_problem<InputT, OutputT> const& p)
+        {
+            return is_aligned<GemmAlignBytes>(p.a, p.lda) && is_aligned<GemmAlignBytes>(p.b, p.ldb);
+        }
+
+        ROCWMMA_HOST inline bool gemmValidOps(operation_t opA, operation_t opB)
+        {
+            return (opA == operation_none || opA == operation_transpose)
+                   && (opB == operation_none || opB == operation_transpose);
+        }
+
+        // Leading dimensions at least the rows of each stored matrix
+        template <typename InputT, typename OutputT>
+        ROCWMMA_HOST inline bool gemmValidProblem(operation_t                                  opA,
+                                                  operation_t                                  opB,
+                                                  gemm_grouped_problem<InputT, OutputT> const& p)
+        {
+            auto rowsA = opA == operation_none ? p.m : p.k;
+            auto rowsB = opB == operation_none ? p.k : p.n;
+            return p.lda >= std::max(rowsA, 1u) && p.ldb >= std::max(rowsB, 1u)
+                   && (p.beta == 0.0f || p.ldc >= std::max(p.m, 1u)) && p.ldd >= std::max(p.m, 1u);
+        }
+
+        // Grid of gemm_kernel for one batch and split
+        ROCWMMA_HOST inline uint32_t
+            gemmTileCount(warp_tile_params const& params, uint32_t m, uint32_t n)
+        {
+            auto macroTileX = params.tblock_x / params.wave_size * params.blocks_x * params.block_m;
+            auto macroTileY = params.tblock_y * params.blocks_y * params.block_n;
+            return ceilDiv(m, macroTileX) * ceilDiv(n, macroTileY);
+        }
+
+        // Deep K over fewer macro tiles than CUs is split to fill the CUs
+        ROCWMMA_HOST inline uint32_t gemmSplitCount(uint32_t cuCount, uint32_t tiles, uint32_t k)
+        {
+            if(tiles >= cuCount)
+            {
+                return 1u;
+            }
+            return std::max(std::min({cuCount / tiles, k / GemmMinSplitK, GemmMaxSplits}), 1u);
+        }
+
+        // K of each split, a multiple of block_k. The rounding may leave fewer splits.
+        ROCWMMA_HOST inline uint32_t
+            gemmSplitK(warp_tile_params const& params, uint32_t k, uint32_t splitCount)
+        {
+            return splitCount > 1u
+                       ? ceilDiv(ceilDiv(k, splitCount), params.block_k) * params.block_k
+                       : std::max(k, 1u);
+        }
+
+        ROCWMMA_HOST inline size_t
+            gemmPartialsBytes(uint32_t m, uint32_t n, uint32_t batchCount, uint32_t splitCount)
+        {
+            return splitCount > 1u ? static_cast<size_t>(m) * n * batchCount * splitCount
+                                         * sizeof(float32_t)
+                                   : 0u;
+        }
+
+        // Returns a workspace of at least bytes. A user workspace is never grown.
+        ROCWMMA_HOST inline hipError_t
+            gemmAcquireWorkspace(gemm_handle_t handle, size_t bytes, void** workspace)
+        {
+            if(bytes > handle->workspaceBytes)
+            {
+                if(handle->userWorkspace)
+                {
+                    return hipErrorInvalidValue;
+                }
+
+                // hipFree synchronizes the device, no work on the old workspace is pending
+                if(handle->workspace != nullptr)
+                {
+                    auto status = hipFree(handle->workspace);
+                    handle->workspace      = nullptr;
+                    handle->workspaceBytes = 0u;
+                    if(status != hipSuccess)
+                    {
+                        return status;
+                    }
+                }
+
+                auto status = hipMalloc(&handle->workspace, bytes);
+                if(status != hipSuccess)
+                {
+                    handle->workspace = nullptr;
+                    return status;
+                }
+                handle->workspaceBytes = bytes;
+            }
+
+            *workspace = handle->workspace;
+            return hipSuccess;
+        }
+
+        template <typename InputT, typename OutputT>
+        ROCWMMA_HOST inline hipError_t gemmLaunch(gemm_handle_t                   handle,
+                                                  operation_t                     opA,
+                                                  operation_t                     opB,
+                                                  GemmBatchArgs<InputT, OutputT>& args,
+                                                  uint32_t                        batchCount)
+        {
+            static_assert(isGemmSupported<InputT, OutputT>,
+                          "Supported InputT: float16_t, bfloat16_t. OutputT: InputT, float32_t");
+
+            auto const& p = args.problem;
+            if(handle == nullptr)
+            {
+                return hipErrorInvalidHandle;
+            }
+            if(!gemmValidOps(opA, opB) || !gemmValidProblem(opA, opB, p))
+            {
+                return hipErrorInvalidValue;
+            }
+            if(p.m == 0u || p.n == 0u || batchCount == 0u)
+            {
+                return hipSuccess;
+            }
+
+            auto params = get_warp_tile_params<InputT>(handle->archId);
+            auto tiles  = gemmTileCount(params, p.m, p.n);
+
+            // A user workspace limits the splits to those that fit
+            auto splitCount = gemmSplitCount(handle->cuCount, tiles * batchCount, p.k);
+            if(handle->userWorkspace
+               && gemmPartialsBytes(p.m, p.n, batchCount, splitCount) > handle->workspaceBytes)
+            {
+                auto splitBytes = static_cast<size_t>(p.m) * p.n * batchCount * sizeof(float32_t);
+                splitCount      = static_cast<uint32_t>(
+                    std::min<size_t>(handle->workspaceBytes / splitBytes, splitCount));
+            }
+            args.splitK     = gemmSplitK(params, p.k, splitCount);
+            args.splitCount = ceilDiv(std::max(p.k, 1u), args.splitK);
+
+            void* workspace = nullptr;
+            auto  status    = gemmAcquireWorkspace(
+                handle, gemmPartialsBytes(p.m, p.n, batchCount, args.splitCount), &workspace);
+            if(status != hipSuccess)
+            {
+                return status;
+            }
+            args.partials = reinterpret_cast<float32_t*>(workspace);
+
+            // Batch strides keep the alignment of the first batch
+            auto aligned = gemmAligned(p)
+                           && (batchCount == 1u
+                               || (args.strideA * sizeof(InputT) % GemmAlignBytes == 0u
+                                   && args.strideB * sizeof(InputT) % GemmAlignBytes == 0u));
+
+            auto gridDim  = dim3(tiles, args.splitCount, batchCount);
+            auto blockDim = dim3(params.tblock_x, params.tblock_y);
+            status        = gemmDispatchLayouts(opA, opB, [&](auto layoutA, auto layoutB) {
+                return gemmDispatchAlign<InputT>(aligned, [&](auto align) {
+                    using LayoutA = decltype(layoutA);
+                    using LayoutB = decltype(layoutB);
+                    hipLaunchKernelGGL(
+                        (gemm_kernel<InputT, OutputT, LayoutA, LayoutB, decltype(align)::value>),
+                        gridDim,
+                        blockDim,
+                        0, // sharedMemBytes
+                        handle->stream,
+                        args);
+                    return hipGetLastError();
+                });
+            });
+            if(status != hipSuccess || args.splitCount == 1u)
+            {
+                return status;
+            }
+
+            auto reduceBlocks = std::min(ceilDiv(static_cast<uint64_t>(p.m) * p.n,
+                                                 static_cast<uint64_t>(GemmReduceThreads)),
+                                         static_cast<uint64_t>(handle->cuCount) * 8u);
+            hipLaunchKernelGGL((gemm_reduce_kernel<InputT, OutputT>),
+                               dim3(static_cast<uint32_t>(reduceBlocks), batchCount),
+                               dim3(GemmReduceThreads),
+                               0, // sharedMemBytes
+                               handle->stream,
+                               args);
+            return hipGetLastError();
+        }
+
+    } // namespace detail
+    // @endcond
+
+    ROCWMMA_HOST inline hipError_t gemm_create_handle(gemm_handle_t* handle)
+    {
+        if(handle == nullptr)
+        {
+            return hipErrorInvalidValue;
+        }
+
+        auto result  = new gemm_handle{};
+        int  cuCount = 0;
+        auto status  = hipGetDevice(&result->device);
+        if(status == hipSuccess)
+        {
+            status = hipDeviceGetAttribute(
+                &cuCount, hipDeviceAttributeMultiprocessorCount, result->device);
+        }
+        if(status == hipSuccess)
+        {
+            status = hipEventCreateWithFlags(&result->stagingDone, hipEventDisableTiming);
+        }
+        if(status != hipSuccess)
+        {
+            delete result;
+            return status;
+        }
+
+        result->archId  = get_device_arch_id(result->device);
+        result->cuCount = std::max(static_cast<uint32_t>(cuCount), 1u);
+        *handle         = result;
+        return hipSuccess;
+    }
+
+    ROCWMMA_HOST inline hipError_t gemm_destroy_handle(gemm_handle_t handle)
+    {
+        if(handle == nullptr)
+        {
+            return hipErrorInvalidHandle;
+        }
+
+        auto status  = hipStreamSynchronize(handle->stream);
+        auto release = [&status](hipError_t result) {
+            status = (status == hipSuccess) ? result : status;
+        };
+        if(!handle->userWorkspace && handle->workspace != nullptr)
+        {
+            release(hipFree(handle->workspace));
+        }
+        if(handle->staging != nullptr)
+        {
+            release(hipHostFree(handle->staging));
+        }
+        release(hipEventDestroy(handle->stagingDone));
+
+        delete handle;
+        return status;
+    }
+
+    ROCWMMA_HOST inline hipError_t gemm_set_stream(gemm_handle_t handle, hipStream_t stream)
+    {
+        if(handle == nullptr)
+        {
+            return hipErrorInvalidHandle;
+        }
+        handle->stream = stream;
+        return hipSuccess;
+    }
+
+    ROCWMMA_HOST inline hipError_t gemm_get_stream(gemm_handle_t handle, hipStream_t* stream)
+    {
+        if(handle == nullptr)
+        {
+            return hipErrorInvalidHandle;
+        }
+        if(stream == nullptr)
+        {
+            return hipErrorInvalidValue;
+        }
+        *stream = handle->stream;
+        return hipSuccess;
+    }
+
+    ROCWMMA_HOST inline hipError_t
+        gemm_set_workspace(gemm_handle_t handle, void* workspace, size_t bytes)
+    {
+        if(handle == nullptr)
+        {
+            return hipErrorInvalidHandle;
+        }
+
+        // Pending work may still use the handle-owned workspace, hipFree synchronizes
+        if(!handle->userWorkspace && handle->workspace != nullptr)
+        {
+            auto status = hipFree(handle->workspace);
+            if(status != hipSuccess)
+            {
+                return status;
+            }
+        }
+
+        handle->userWorkspace  = workspace != nullptr;
+        handle->workspace      = workspace;
+        handle->workspaceBytes = workspace != nullptr ? bytes : 0u;
+        return hipSuccess;
+    }
+
+    template <typename InputT>
+    ROCWMMA_HOST inline hipError_t gemm_get_workspace_size(gemm_handle_t handle,
+                                                           uint32_t      m,
+                                                           uint32_t      n,
+                                                           uint32_t      k,
+                                                           uint32_t      batchCount,
+                                                           size_t*       bytes)
+    {
+        if(handle == nullptr)
+        {
+            return hipErrorInvalidHandle;
+        }
+        if(bytes == nullptr)
+        {
+            return hipErrorInvalidValue;
+        }
+
+        *bytes = 0u;
+        if(m == 0u || n == 0u || batchCount == 0u)
+        {
+            return hipSuccess;
+        }
+
+        auto params     = get_warp_tile_params<InputT>(handle->archId);
+        auto tiles      = detail::gemmTileCount(params, m, n) * batchCount;
+        auto splitCount = detail::gemmSplitCount(handle->cuCount, tiles, k);
+        auto splitK     = detail::gemmSplitK(params, k, splitCount);
+        splitCount      = ceilDiv(std::max(k, 1u), splitK);
+        *bytes          = detail::gemmPartialsBytes(m, n, batchCount, splitCount);
+        return hipSuccess;
+    }
+
+    template <typename InputT, typename OutputT>
+    ROCWMMA_HOST constexpr inline size_t gemm_grouped_workspace_size(uint32_t groupCount)
+    {
+        // Descriptors, then the tile offsets
+        return static_cast<size_t>(groupCount) * sizeof(gemm_grouped_problem<InputT, OutputT>)
+               + (static_cast<size_t>(groupCount) + 1u) * sizeof(uint32_t);
+    }
+
+    template <typename InputT, typename OutputT>
+    ROCWMMA_HOST inline hipError_t gemm(gemm_handle_t  handle,
+                                        operation_t    opA,
+                                        operation_t    opB,
+                                        uint32_t       m,
+                                        uint32_t       n,
+                                        uint32_t       k,
+                                        float32_t      alpha,
+                                        InputT const*  a,
+                                        uint32_t       lda,
+                                        InputT const*  b,
+                                        uint32_t       ldb,
+                                        float32_t      beta,
+                                        OutputT const* c,
+                                        uint32_t       ldc,
+                                        OutputT*       d,
+                                        uint32_t       ldd)
+    {
+        auto args    = detail::GemmBatchArgs<InputT, OutputT>{};
+        args.problem = {m, n, k, a, lda, b, ldb, c, ldc, d, ldd, alpha, beta};
+        return detail::gemmLaunch(handle, opA, opB, args, 1u);
+    }
+
+    template <typename InputT, typename OutputT>
+    ROCWMMA_HOST inline hipError_t gemm_strided_batched(gemm_handle_t  handle,
+                                                        operation_t    opA,
+                                                        operation_t    opB,
+                                                        uint32_t       m,
+                                                        uint32_t       n,
+                                                        uint32_t       k,
+                                                        float32_t      alpha,
+                                                        InputT const*  a,
+                                                        uint32_t       lda,
+                                                        uint64_t       strideA,
+                                                        InputT const*  b,
+                                                        uint32_t       ldb,
+                                                        uint64_t       strideB,
+                                                        float32_t      beta,
+                                                        OutputT const* c,
+                                                        uint32_t       ldc,
+                                                        uint64_t       strideC,
+                                                        OutputT*       d,
+                                                        uint32_t       ldd,
+                                                        uint64_t       strideD,
+                                                        uint32_t       batchCount)
+    {
+        auto args    = detail::GemmBatchArgs<InputT, OutputT>{};
+        args.problem = {m, n, k, a, lda, b, ldb, c, ldc, d, ldd, alpha, beta};
+        args.strideA = strideA;
+        args.strideB = strideB;
+        args.strideC = strideC;
+        args.strideD = strideD;
+        return detail::gemmLaunch(handle, opA, opB, args, batchCount);
+    }
+
+    template <typename InputT, typename OutputT>
+    ROCWMMA_HOST inline hipError_t
+        gemm_grouped(gemm_handle_t                                handle,
+                     operation_t                                  opA,
+                     operation_t                                  opB,
+                     gemm_grouped_problem<InputT, OutputT> const* problems,
+                     uint32_t                                     groupCount)
+    {
+        static_assert(detail::isGemmSupported<InputT, OutputT>,
+                      "Supported InputT: float16_t, bfloat16_t. OutputT: InputT, float32_t");
+
+        using Problem = gemm_grouped_problem<InputT, OutputT>;
+
+        if(handle == nullptr)
+        {
+            return hipErrorInvalidHandle;
+        }
+        if(!detail::gemmValidOps(opA, opB) || (problems == nullptr && groupCount > 0u))
+        {
+            return hipErrorInvalidValue;
+        }
+        for(uint32_t i = 0u; i < groupCount; i++)
+        {
+            if(!detail::gemmValidProblem(opA, opB, problems[i]))
+            {
+                return hipErrorInvalidValue;
+            }
+        }
+
+        // Pinned staging of the descriptors and tile offsets, reused once the previous
+        // copy from it is done
+        auto bytes  = gemm_grouped_workspace_size<InputT, OutputT>(groupCount);
+        auto status = hipEventSynchronize(handle->stagingDone);
+        if(status == hipSuccess && bytes > handle->stagingBytes)
+        {
+            if(handle->staging != nullptr)
+            {
+                status               = hipHostFree(handle->staging);
+                handle->staging      = nullptr;
+                handle->stagingBytes = 0u;
+            }
+            if(status == hipSuccess)
+            {
+                status               = hipHostMalloc(&handle->staging, bytes);
+                handle->stagingBytes = (status == hipSuccess) ? bytes : 0u;
+            }
+        }
+        if(status != hipSuccess)
+        {
+            return status;
+        }
+
+        auto params      = get_warp_tile_params<InputT>(handle->archId);
+        auto descs       = reinterpret_cast<Problem*>(handle->staging);
+        auto tileOffsets = reinterpret_cast<uint32_t*>(descs + groupCount);
+
+        // Exclusive prefix sum of the macro tiles of each problem
+        uint32_t totalTiles = 0u;
+        bool     aligned    = true;
+        for(uint32_t i = 0u; i < groupCount; i++)
+        {
+            descs[i]       = problems[i];
+            tileOffsets[i] = totalTiles;
+            totalTiles += detail::gemmTileCount(params, problems[i].m, problems[i].n);
+            aligned = aligned && detail::gemmAligned(problems[i]);
+        }
+        tileOffsets[groupCount] = totalTiles;
+        if(totalTiles == 0u)
+        {
+            return hipSuccess;
+        }
+
+        void* workspace = nullptr;
+        status          = detail::gemmAcquireWorkspace(handle, bytes, &workspace);
+        if(status == hipSuccess)
+        {
+            status = hipMemcpyAsync(
+                workspace, handle->staging, bytes, hipMemcpyHostToDevice, handle->stream);
+        }
+        if(status == hipSuccess)
+        {
+            status = hipEventRecord(handle->stagingDone, handle->stream);
+        }
+        if(status != hipSuccess)
+        {
+            return status;
+        }
+
+        auto deviceDescs       = reinterpret_cast<Problem const*>(workspace);
+        auto deviceTileOffsets = reinterpret_cast<uint32_t const*>(deviceDescs + groupCount);
+        auto blockDim          = dim3(params.tblock_x, params.tblock_y);
+        return detail::gemmDispatchLayouts(opA, opB, [&](auto layoutA, auto layoutB) {
+            return detail::gemmDispatchAlign<InputT>(aligned, [&](auto align) {
+                using LayoutA = decltype(layoutA);
+                using LayoutB = decltype(layoutB);
+                hipLaunchKernelGGL((detail::gemm_grouped_kernel<InputT,
+                                                                OutputT,
+                                                                LayoutA,
+                                                                LayoutB,
+                                                                decltype(align)::value>),
+                                   dim3(totalTiles),
+                                   blockDim,
+                                   0, // sharedMemBytes
+                                   handle->stream,
+                                   deviceDescs,
+                                   deviceTileOffsets,
+                                   groupCount);
+                return hipGetLastError();
+            });
+        });
+    }
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_GEMM_API_IMPL_HPP
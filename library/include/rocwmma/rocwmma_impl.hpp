@@ -29,10 +29,15 @@
 #include "rocwmma.hpp"
 
 #include "internal/accessors.hpp"
+#include "internal/atomic_add_store.hpp"
 #include "internal/blend.hpp"
+#include "internal/bounded_load.hpp"
+#include "internal/bounded_store.hpp"
 #include "internal/broadcast.hpp"
+#include "internal/buffer_load.hpp"
 #include "internal/constants.hpp"
 #include "internal/convert.hpp"
+#include "internal/dequant_load.hpp"
 #include "internal/dpp.hpp"
 #include "internal/flow_control.hpp"
 #include "internal/io_config.hpp"
@@ -42,10 +47,12 @@
 #include "internal/layout.hpp"
 #include "internal/mapping_util.hpp"
 #include "internal/mfma.hpp"
+#include "internal/mx_load.hpp"
 #include "internal/opaque_load.hpp"
 #include "internal/opaque_store.hpp"
 #include "internal/pack_util.hpp"
 #include "internal/permute.hpp"
+#include "internal/prefetch.hpp"
 #include "internal/swizzle.hpp"
 #include "internal/transforms.hpp"
 #include "internal/types.hpp"
@@ -216,6 +223,53 @@ namespace rocwmma
         Broadcaster::exec(frag.mAccess, value);
     }
 
+    template <typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE bool
+        is_zero_sync(fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& frag)
+    {
+        using FragT = decay_t<decltype(frag)>;
+
+        constexpr uint32_t Bytes = sizeof(typename FragT::Traits::AccessT);
+        constexpr uint32_t Bits  = sizeof(DataT) * 8u;
+
+        uint32_t nonZero = 0u;
+        if constexpr(Bytes % 4u == 0u)
+        {
+            // Whole registers are tested at once. Floating point sign bits are masked out,
+            // such that -0 tests as zero.
+            constexpr uint32_t SignBits = is_integral<DataT>::value ? 0u
+                                          : Bits == 8u              ? 0x80808080u
+                                          : Bits == 16u             ? 0x80008000u
+                                                                    : 0x80000000u;
+
+            auto const* words = reinterpret_cast<uint32_t const*>(&frag.mAccess);
+
+#pragma unroll
+            for(uint32_t i = 0u; i < Bytes / 4u; i++)
+            {
+                // 64-bit elements hold their sign in the upper word
+                auto mask = (Bits == 64u && i % 2u == 0u) ? ~0u : ~SignBits;
+                nonZero |= words[i] & mask;
+            }
+        }
+        else
+        {
+#pragma unroll
+            for(uint32_t i = 0u; i < FragT::num_elements; i++)
+            {
+                nonZero |= static_cast<uint32_t>(frag.x[i] != static_cast<DataT>(0));
+            }
+        }
+
+        // The ballot is shared by the wave
+        return !__any(nonZero != 0u);
+    }
+
     template <typename MatrixT,
               uint32_t BlockM,
               uint32_t BlockN,
@@ -263,6 +317,158 @@ namespace rocwmma
         }
     }
 
+    template <typename AccessPolicyT,
+              typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void
+        load_matrix_sync(fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>& frag,
+                         const DataT*                                                   data,
+                         uint32_t                                                       ldm)
+    {
+        using FragT  = decay_t<decltype(frag)>;
+        using Loader = typename GetIOConfig_t<FragT>::template PolicyLoader<AccessPolicyT>;
+
+        // Sanity checks
+        static_assert(!is_same<DataLayoutT, void>::value,
+                      "Must provide layout information. Statically assign data layout in "
+                      "fragment declaration to use access policy loads.");
+
+        static_assert(
+            is_same<typename FragT::Traits::AccessT, typename Loader::Traits::OutputT>::value,
+            "Fragment access and load output types do not match");
+
+        // Load then implicit pack
+        Loader::exec(frag.mAccess, data, ldm);
+    }
+
+    template <typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT,
+              typename PtrDataT,
+              uint32_t AlignBytes>
+    ROCWMMA_DEVICE void
+        load_matrix_sync(fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>& frag,
+                         aligned_ptr<PtrDataT, AlignBytes>                              data,
+                         uint32_t                                                       ldm)
+    {
+        using FragT  = decay_t<decltype(frag)>;
+        using Loader = typename GetIOConfig_t<FragT>::template AlignedLoader<AlignBytes>;
+
+        // Sanity checks
+        static_assert(!is_same<DataLayoutT, void>::value,
+                      "Must provide layout information. Statically assign data layout in "
+                      "fragment declaration to use aligned loads.");
+
+        static_assert(is_same<remove_const_t<PtrDataT>, DataT>::value,
+                      "Aligned pointer and fragment datatypes do not match");
+
+        static_assert(
+            is_same<typename FragT::Traits::AccessT, typename Loader::Traits::OutputT>::value,
+            "Fragment access and load output types do not match");
+
+        // Load then implicit pack
+        Loader::exec(frag.mAccess,
+                     static_cast<DataT const*>(__builtin_assume_aligned(data.ptr, AlignBytes)),
+                     ldm);
+    }
+
+    template <typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT,
+              typename QuantT>
+    ROCWMMA_DEVICE void load_matrix_dequant_sync(
+        fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>& frag,
+        const QuantT*                                                  data,
+        uint32_t                                                       ldm)
+    {
+        using FragT    = decay_t<decltype(frag)>;
+        using IOConfig = GetIOConfig_t<FragT>;
+        using IOShape  = typename IOConfig::IOShape;
+        using IOLayout = typename IOConfig::IOLayout;
+
+        // Quantized data is read with the matrix layout of the target fragment
+        using Loader = DequantLoad<IOShape::BlockDim,
+                                   IOShape::KDim,
+                                   QuantT,
+                                   DataT,
+                                   typename IOLayout::DataLayout,
+                                   typename IOLayout::MatrixLayout,
+                                   IOLayout::VW>;
+
+        // Sanity checks
+        static_assert(!is_same<DataLayoutT, void>::value,
+                      "Must provide layout information. Statically assign data layout in "
+                      "fragment declaration.");
+
+        static_assert(
+            is_same<typename FragT::Traits::AccessT, typename Loader::Traits::OutputT>::value,
+            "Fragment access and load output types do not match");
+
+        // Load, convert then implicit pack
+        Loader::exec(frag.mAccess, data, ldm);
+    }
+
+    template <typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT,
+              typename QuantT>
+    ROCWMMA_DEVICE void
+        load_matrix_mx_sync(fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>& frag,
+                            const QuantT*                                                  data,
+                            const e8m0_t*                                                  scales,
+                            uint32_t                                                       ldm,
+                            uint32_t                                                       lds)
+    {
+        using FragT    = decay_t<decltype(frag)>;
+        using IOConfig = GetIOConfig_t<FragT>;
+        using IOShape  = typename IOConfig::IOShape;
+        using IOLayout = typename IOConfig::IOLayout;
+
+        // K is the column dimension of matrix_a and the row dimension of matrix_b
+        constexpr uint32_t KIndex = is_same<MatrixT, matrix_a>::value ? 1u : 0u;
+
+        // MX data is read with the matrix layout of the target fragment
+        using Loader = MxLoad<IOShape::BlockDim,
+                              IOShape::KDim,
+                              QuantT,
+                              DataT,
+                              typename IOLayout::DataLayout,
+                              typename IOLayout::MatrixLayout,
+                              IOLayout::VW,
+                              KIndex>;
+
+        // Sanity checks
+        static_assert(!is_same<MatrixT, accumulator>::value,
+                      "MX scales apply along K of matrix_a or matrix_b fragments");
+
+        static_assert(BlockK % detail::MxBlockSize == 0u || detail::MxBlockSize % BlockK == 0u,
+                      "BlockK must be a multiple or a divisor of the MX block size");
+
+        static_assert(!is_same<DataLayoutT, void>::value,
+                      "Must provide layout information. Statically assign data layout in "
+                      "fragment declaration.");
+
+        static_assert(
+            is_same<typename FragT::Traits::AccessT, typename Loader::Traits::OutputT>::value,
+            "Fragment access and load output types do not match");
+
+        // Load, scale and convert then implicit pack
+        Loader::exec(frag.mAccess, data, scales, ldm, lds);
+    }
+
     template <typename MatrixT,
               uint32_t BlockM,
               uint32_t BlockN,
@@ -270,32 +476,81 @@ namespace rocwmma
               typename DataT,
               typename DataLayoutT>
     ROCWMMA_DEVICE void
-        store_matrix_sync(DataT*                                                               data,
-                          fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& frag,
-                          uint32_t                                                             ldm)
+        load_matrix_split_sync(fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>& hi,
+                               fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>& lo,
+                               const float32_t*                                               data,
+                               uint32_t                                                       ldm)
+    {
+        using FragT    = decay_t<decltype(hi)>;
+        using IOConfig = GetIOConfig_t<FragT>;
+        using IOShape  = typename IOConfig::IOShape;
+        using IOLayout = typename IOConfig::IOLayout;
+
+        // float32_t data is read with the matrix layout of the target fragments,
+        // so the split is element-wise in registers.
+        using Loader = DequantLoad<IOShape::BlockDim,
+                                   IOShape::KDim,
+                                   float32_t,
+                                   float32_t,
+                                   typename IOLayout::DataLayout,
+                                   typename IOLayout::MatrixLayout,
+                                   IOLayout::VW>;
+
+        // Sanity checks
+        static_assert(!is_same<DataLayoutT, void>::value,
+                      "Must provide layout information. Statically assign data layout in "
+                      "fragment declaration.");
+
+        static_assert(VecTraits<typename FragT::Traits::AccessT>::size()
+                          == VecTraits<typename Loader::Traits::OutputT>::size(),
+                      "Fragment access and load output sizes do not match");
+
+        typename Loader::Traits::OutputT full;
+        Loader::exec(full, data, ldm);
+
+        // hi = rnd(data), lo = rnd(data - hi), then implicit pack
+        hi.mAccess = Convert<float32_t, DataT>::exec(full);
+        lo.mAccess = Convert<float32_t, DataT>::exec(full
+                                                     - Convert<DataT, float32_t>::exec(hi.mAccess));
+    }
+
+    template <typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void load_matrix_bounded_sync(
+        fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>& frag,
+        const DataT*                                                   data,
+        uint32_t                                                       ldm,
+        uint32_t                                                       rows,
+        uint32_t                                                       cols)
     {
         using FragT  = decay_t<decltype(frag)>;
-        using Storer = typename GetIOConfig_t<FragT>::Storer;
+        using Loader = typename GetIOConfig_t<FragT>::BoundedLoader;
 
-        // Sanity check
+        // Sanity checks
         static_assert(!is_same<DataLayoutT, void>::value,
-                      "Must provide data layout. Either statically assign data layout in "
+                      "Must provide layout information. Either statically assign data layout in "
                       "fragment declaration or use the run-time function overload.");
 
         static_assert(
-            is_same<typename FragT::Traits::AccessT, typename Storer::Traits::InputT>::value,
-            "Fragment access and store input types do not match");
+            is_same<typename FragT::Traits::AccessT, typename Loader::Traits::OutputT>::value,
+            "Fragment access and load output types do not match");
 
-        // Implicit unpack and then store
-        Storer::exec(data, frag.mAccess, ldm);
+        // Predicated load then implicit pack
+        Loader::exec(frag.mAccess, data, ldm, make_coord2d(rows, cols));
     }
 
     template <typename MatrixT, uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename DataT>
     ROCWMMA_DEVICE void
-        store_matrix_sync(DataT*                                                  data,
-                          fragment<MatrixT, BlockM, BlockN, BlockK, DataT> const& frag,
-                          uint32_t                                                ldm,
-                          layout_t                                                layout)
+        load_matrix_bounded_sync(fragment<MatrixT, BlockM, BlockN, BlockK, DataT>& frag,
+                                 const DataT*                                      data,
+                                 uint32_t                                          ldm,
+                                 uint32_t                                          rows,
+                                 uint32_t                                          cols,
+                                 layout_t                                          layout)
     {
         using FragRowMajor = fragment<MatrixT, BlockM, BlockN, BlockK, DataT, row_major>;
         using FragColMajor = fragment<MatrixT, BlockM, BlockN, BlockK, DataT, col_major>;
@@ -303,69 +558,1384 @@ namespace rocwmma
         // Dispatch on layout type
         if(layout == layout_t::mem_row_major)
         {
-            store_matrix_sync(data, reinterpret_cast<FragRowMajor const&>(frag), ldm);
+            load_matrix_bounded_sync(reinterpret_cast<FragRowMajor&>(frag), data, ldm, rows, cols);
         }
         else
         {
-            store_matrix_sync(data, reinterpret_cast<FragColMajor const&>(frag), ldm);
+            load_matrix_bounded_sync(reinterpret_cast<FragColMajor&>(frag), data, ldm, rows, cols);
         }
     }
 
-    template <uint32_t BlockM,
-              uint32_t BlockN,
-              uint32_t BlockK,
-              typename InputT,
-              typename ComputeT,
-              typename LayoutA,
-              typename LayoutB,
-              typename LayoutC,
-              typename LayoutD>
+    template <uint32_t AlignBytes, typename DataT>
+    ROCWMMA_HOST_DEVICE constexpr inline aligned_ptr<DataT, AlignBytes>
+        make_aligned_ptr(DataT* ptr)
+    {
+        return aligned_ptr<DataT, AlignBytes>{ptr};
+    }
+
+    template <uint32_t AlignBytes, typename DataT>
+    ROCWMMA_HOST_DEVICE inline bool is_aligned(const DataT* ptr, uint32_t ldm)
+    {
+        static_assert(AlignBytes > 0u && (AlignBytes & (AlignBytes - 1u)) == 0u,
+                      "AlignBytes must be a power of 2");
+
+        return (reinterpret_cast<uintptr_t>(ptr) % AlignBytes == 0u)
+               && (static_cast<uint64_t>(ldm) * sizeof(DataT) % AlignBytes == 0u);
+    }
+
+    ROCWMMA_HOST_DEVICE constexpr inline conv2d_nhwc make_conv2d_nhwc(uint32_t n,
+                                                                      uint32_t h,
+                                                                      uint32_t w,
+                                                                      uint32_t c,
+                                                                      uint32_t k,
+                                                                      uint32_t r,
+                                                                      uint32_t s,
+                                                                      uint32_t padH,
+                                                                      uint32_t padW,
+                                                                      uint32_t strideH,
+                                                                      uint32_t strideW,
+                                                                      uint32_t dilationH,
+                                                                      uint32_t dilationW)
+    {
+        auto p = (h + 2u * padH - dilationH * (r - 1u) - 1u) / strideH + 1u;
+        auto q = (w + 2u * padW - dilationW * (s - 1u) - 1u) / strideW + 1u;
+        return conv2d_nhwc{
+            n, h, w, c, k, r, s, p, q, padH, padW, strideH, strideW, dilationH, dilationW};
+    }
+
+    namespace detail
+    {
+        // End of a null-terminated string of mode labels
+        ROCWMMA_HOST_DEVICE constexpr inline const char* tensorModesEnd(const char* labels)
+        {
+            while(*labels != '\0')
+            {
+                labels++;
+            }
+            return labels;
+        }
+
+        // Position of a mode label within the labels [first, last), or -1 if absent
+        ROCWMMA_HOST_DEVICE constexpr inline int32_t
+            findTensorMode(const char* first, const char* last, char label)
+        {
+            for(auto it = first; it != last; it++)
+            {
+                if(*it == label)
+                {
+                    return static_cast<int32_t>(it - first);
+                }
+            }
+            return -1;
+        }
+
+        // Folds the modes labelled [first, last) of a tensor with the given mode labels,
+        // in label order. Labels absent from the tensor are skipped.
+        ROCWMMA_HOST_DEVICE constexpr inline tensor_modes makeTensorModes(const char*     modes,
+                                                                          const char*     modesEnd,
+                                                                          const uint32_t* extents,
+                                                                          const int64_t*  strides,
+                                                                          const char*     first,
+                                                                          const char*     last)
+        {
+            auto result = tensor_modes{0u, 1u, {}, {}};
+            for(auto it = first; it != last && result.count < tensor_modes::MaxModes; it++)
+            {
+                auto mode = findTensorMode(modes, modesEnd, *it);
+                if(mode >= 0)
+                {
+                    result.extents[result.count] = extents[mode];
+                    result.strides[result.count] = strides[mode];
+                    result.size *= extents[mode];
+                    result.count++;
+                }
+            }
+            return result;
+        }
+
+    } // namespace detail
+
+    ROCWMMA_HOST_DEVICE constexpr inline tensor_view make_tensor_view(const char*     modes,
+                                                                      const uint32_t* extents,
+                                                                      const int64_t*  strides,
+                                                                      const char*     rowModes,
+                                                                      const char*     colModes,
+                                                                      const char*     batchModes)
+    {
+        auto modesEnd = detail::tensorModesEnd(modes);
+        auto fold     = [&](const char* labels) {
+            return detail::makeTensorModes(
+                modes, modesEnd, extents, strides, labels, detail::tensorModesEnd(labels));
+        };
+        return tensor_view{fold(rowModes), fold(colModes), fold(batchModes)};
+    }
+
+    ROCWMMA_HOST_DEVICE constexpr inline tensor_contraction
+        make_tensor_contraction(const char*     expression,
+                                const uint32_t* extentsA,
+                                const int64_t*  stridesA,
+                                const uint32_t* extentsB,
+                                const int64_t*  stridesB,
+                                const uint32_t* extentsD,
+                                const int64_t*  stridesD)
+    {
+        using detail::findTensorMode;
+
+        // Split "A,B->D" into the mode labels of each tensor
+        auto end  = detail::tensorModesEnd(expression);
+        auto a    = expression;
+        auto aEnd = a;
+        while(aEnd != end && *aEnd != ',')
+        {
+            aEnd++;
+        }
+        auto b    = aEnd != end ? aEnd + 1 : end;
+        auto bEnd = b;
+        while(bEnd != end && *bEnd != '-')
+        {
+            bEnd++;
+        }
+        auto d    = (end - bEnd) > 2 ? bEnd + 2 : end;
+        auto dEnd = end;
+
+        // Classify the labels of D, then the contracted labels of A
+        char     mModes[tensor_modes::MaxModes]     = {};
+        char     nModes[tensor_modes::MaxModes]     = {};
+        char     kModes[tensor_modes::MaxModes]     = {};
+        char     batchModes[tensor_modes::MaxModes] = {};
+        uint32_t mCount = 0u, nCount = 0u, kCount = 0u, batchCount = 0u;
+
+        for(auto it = d; it != dEnd && batchCount + mCount + nCount < tensor_modes::MaxModes;
+            it++)
+        {
+            auto inA = findTensorMode(a, aEnd, *it) >= 0;
+            auto inB = findTensorMode(b, bEnd, *it) >= 0;
+            if(inA && inB)
+            {
+                batchModes[batchCount++] = *it;
+            }
+            else if(inA)
+            {
+                mModes[mCount++] = *it;
+            }
+            else if(inB)
+            {
+                nModes[nCount++] = *it;
+            }
+        }
+
+        for(auto it = a; it != aEnd && kCount < tensor_modes::MaxModes; it++)
+        {
+            if(findTensorMode(b, bEnd, *it) >= 0 && findTensorMode(d, dEnd, *it) < 0)
+            {
+                kModes[kCount++] = *it;
+            }
+        }
+
+        auto view = [&](const char*     modes,
+                        const char*     modesEnd,
+                        const uint32_t* extents,
+                        const int64_t*  strides,
+                        const char*     rowModes,
+                        uint32_t        rowCount,
+                        const char*     colModes,
+                        uint32_t        colCount) {
+            return tensor_view{
+                detail::makeTensorModes(
+                    modes, modesEnd, extents, strides, rowModes, rowModes + rowCount),
+                detail::makeTensorModes(
+                    modes, modesEnd, extents, strides, colModes, colModes + colCount),
+                detail::makeTensorModes(
+                    modes, modesEnd, extents, strides, batchModes, batchModes + batchCount)};
+        };
+
+        auto result = tensor_contraction{
+            view(a, aEnd, extentsA, stridesA, mModes, mCount, kModes, kCount),
+            view(b, bEnd, extentsB, stridesB, kModes, kCount, nModes, nCount),
+            view(d, dEnd, extentsD, stridesD, mModes, mCount, nModes, nCount),
+            0u,
+            0u,
+            0u,
+            0u};
+
+        result.m     = result.d.rows.size;
+        result.n     = result.d.cols.size;
+        result.k     = result.a.cols.size;
+        result.batch = result.d.batch.size;
+        return result;
+    }
+
+    template <uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename DataT>
     ROCWMMA_DEVICE void
-        mma_sync(fragment<accumulator, BlockM, BlockN, BlockK, ComputeT, LayoutD>&       d,
-                 fragment<matrix_a, BlockM, BlockN, BlockK, InputT, LayoutA> const&      a,
-                 fragment<matrix_b, BlockM, BlockN, BlockK, InputT, LayoutB> const&      b,
-                 fragment<accumulator, BlockM, BlockN, BlockK, ComputeT, LayoutC> const& c)
+        load_matrix_im2col_sync(fragment<matrix_a, BlockM, BlockN, BlockK, DataT, row_major>& frag,
+                                const DataT*                                                  input,
+                                conv2d_nhwc const&                                            conv,
+                                uint32_t                                                      row,
+                                uint32_t                                                      col)
     {
-        using FragA = decay_t<decltype(a)>;
-        using FragB = decay_t<decltype(b)>;
+        using FragT  = decay_t<decltype(frag)>;
+        using Loader = typename GetIOConfig_t<FragT>::Im2colLoader;
+
+        // Sanity checks
+        static_assert(
+            is_same<typename FragT::Traits::AccessT, typename Loader::Traits::OutputT>::value,
+            "Fragment access and load output types do not match");
 
-        using IOConfigA = GetIOConfig_t<FragA>;
-        using IOConfigB = GetIOConfig_t<FragB>;
+        // Gather then implicit pack
+        Loader::exec(frag.mAccess, input, conv, make_coord2d(row, col));
+    }
+
+    template <uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename DataT>
+    ROCWMMA_DEVICE void
+        load_matrix_im2col_sync(fragment<matrix_b, BlockM, BlockN, BlockK, DataT, row_major>& frag,
+                                const DataT*                                                  input,
+                                conv2d_nhwc const&                                            conv,
+                                uint32_t                                                      row,
+                                uint32_t                                                      col)
+    {
+        using FragT  = decay_t<decltype(frag)>;
+        using Loader = typename GetIOConfig_t<FragT>::Im2colLoader;
 
         // Sanity checks
-        static_assert((IOConfigA::IOShape::BlockDim >= 16) && (IOConfigB::IOShape::BlockDim >= 16)
-                          && (IOConfigA::IOShape::BlockDim <= 32)
-                          && (IOConfigB::IOShape::BlockDim <= 32),
-                      "Input fragment BlockDim is not mfma friendly");
+        static_assert(
+            is_same<typename FragT::Traits::AccessT, typename Loader::Traits::OutputT>::value,
+            "Fragment access and load output types do not match");
 
-        static_assert(IOConfigA::IOShape::KDim == IOConfigB::IOShape::KDim,
-                      "KDim of input fragments must match");
+        // Gather then implicit pack
+        Loader::exec(frag.mAccess, input, conv, make_coord2d(row, col));
+    }
 
-        static_assert(is_orthogonal_v<typename IOConfigA::IOLayout::MatrixLayout,
-                                      typename IOConfigB::IOLayout::MatrixLayout>,
-                      "Input fragment matrix layouts are not orthogonal");
+    template <uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename DataT>
+    ROCWMMA_DEVICE void
+        load_matrix_im2col_sync(fragment<matrix_a, BlockM, BlockN, BlockK, DataT, row_major>& frag,
+                                const DataT*                                                  grad,
+                                conv2d_nhwc_dgrad const&                                      dgrad,
+                                uint32_t                                                      row,
+                                uint32_t                                                      col)
+    {
+        using FragT  = decay_t<decltype(frag)>;
+        using Loader = typename GetIOConfig_t<FragT>::Im2colLoader;
 
-        static_assert(is_same_v<typename IOConfigA::IOLayout::RegisterLayout,
-                                typename IOConfigB::IOLayout::RegisterLayout>,
-                      "Input fragment register layouts do not match");
+        // Sanity checks
+        static_assert(
+            is_same<typename FragT::Traits::AccessT, typename Loader::Traits::OutputT>::value,
+            "Fragment access and load output types do not match");
 
-        static_assert(is_same_v<typename IOConfigA::IOLayout::RegisterLayout,
-                                RegisterLayout::template Soa<IOConfigA::IOShape::BlockDim,
-                                                             IOConfigA::IOLayout::MaxVW>>,
-                      "Input fragment register layouts are not mfma friendly");
+        // Gather then implicit pack
+        Loader::exec(frag.mAccess, grad, dgrad, make_coord2d(row, col));
+    }
 
-        // Gfx9 uses MFMA, gfx11 uses WMMA
-        using MMA = conditional_t<ROCWMMA_ARCH_GFX9,
-                                  Mfma<InputT, ComputeT, BlockM, BlockN, BlockK>,
-                                  Wmma<InputT, ComputeT, BlockM, BlockN, BlockK>>;
+    template <uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename DataT>
+    ROCWMMA_DEVICE void
+        load_matrix_im2col_sync(fragment<matrix_a, BlockM, BlockN, BlockK, DataT, row_major>& frag,
+                                const DataT*                                                  input,
+                                conv2d_nhwc_grouped const&                                    conv,
+                                uint32_t                                                      row,
+                                uint32_t                                                      col)
+    {
+        using FragT  = decay_t<decltype(frag)>;
+        using Loader = typename GetIOConfig_t<FragT>::Im2colLoader;
 
-        // mma functions operate on packed vectors
-        (*d) = MMA::exec(*a, *b, *c);
+        // Sanity checks
+        static_assert(
+            is_same<typename FragT::Traits::AccessT, typename Loader::Traits::OutputT>::value,
+            "Fragment access and load output types do not match");
+
+        // Gather then implicit pack
+        Loader::exec(frag.mAccess, input, conv, make_coord2d(row, col));
     }
 
-    ROCWMMA_DEVICE void synchronize_workgroup()
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void load_matrix_gather_sync(
+        fragment<matrix_a, BlockM, BlockN, BlockK, DataT, DataLayoutT>& frag,
+        const DataT*                                                    data,
+        const index_t*                                                  rowIndices,
+        uint32_t                                                        ldm)
     {
-        __syncthreads();
+        using FragT  = decay_t<decltype(frag)>;
+        using Loader = typename GetIOConfig_t<FragT>::GatherLoader;
+
+        // Sanity checks
+        static_assert(!is_same<DataLayoutT, void>::value,
+                      "Must provide layout information. Statically assign data layout in "
+                      "fragment declaration.");
+
+        static_assert(
+            is_same<typename FragT::Traits::AccessT, typename Loader::Traits::OutputT>::value,
+            "Fragment access and load output types do not match");
+
+        // Gather then implicit pack
+        Loader::exec(frag.mAccess, data, rowIndices, ldm);
+    }
+
+    template <typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void load_matrix_tensor_sync(
+        fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>& frag,
+        const DataT*                                                   data,
+        tensor_view const&                                             view,
+        uint32_t                                                       row,
+        uint32_t                                                       col,
+        uint32_t                                                       batch)
+    {
+        using FragT  = decay_t<decltype(frag)>;
+        using Loader = typename GetIOConfig_t<FragT>::TensorLoader;
+
+        // Sanity checks
+        static_assert(!is_same<DataLayoutT, void>::value,
+                      "Must provide layout information. Statically assign data layout in "
+                      "fragment declaration.");
+
+        static_assert(
+            is_same<typename FragT::Traits::AccessT, typename Loader::Traits::OutputT>::value,
+            "Fragment access and load output types do not match");
+
+        // Tensor addressed load then implicit pack
+        Loader::exec(frag.mAccess,
+                     data + detail::TensorSpace::fromBatchIndex(batch, view),
+                     view,
+                     make_coord2d(row, col));
+    }
+
+    template <typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void load_matrix_paged_sync(
+        fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>& frag,
+        const DataT*                                                   data,
+        const index_t*                                                 pageTable,
+        uint32_t                                                       pageSize,
+        uint32_t                                                       ldm,
+        uint32_t                                                       row,
+        uint32_t                                                       col)
+    {
+        using FragT  = decay_t<decltype(frag)>;
+        using Loader = typename GetIOConfig_t<FragT>::PagedLoader;
+
+        // Sanity checks
+        static_assert(!is_same<DataLayoutT, void>::value,
+                      "Must provide layout information. Statically assign data layout in "
+                      "fragment declaration.");
+
+        static_assert(
+            is_same<typename FragT::Traits::AccessT, typename Loader::Traits::OutputT>::value,
+            "Fragment access and load output types do not match");
+
+        // Paged load then implicit pack
+        Loader::exec(frag.mAccess, data, pageTable, pageSize, ldm, make_coord2d(row, col));
+    }
+
+    template <typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT,
+              typename QuantT>
+    ROCWMMA_DEVICE void load_matrix_paged_dequant_sync(
+        fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>& frag,
+        const QuantT*                                                  data,
+        const index_t*                                                 pageTable,
+        uint32_t                                                       pageSize,
+        uint32_t                                                       ldm,
+        uint32_t                                                       row,
+        uint32_t                                                       col)
+    {
+        using FragT    = decay_t<decltype(frag)>;
+        using IOConfig = GetIOConfig_t<FragT>;
+        using IOShape  = typename IOConfig::IOShape;
+        using IOLayout = typename IOConfig::IOLayout;
+
+        // Quantized pages are read with the matrix layout of the target fragment
+        using Loader = PagedLoad<IOShape::BlockDim,
+                                 IOShape::KDim,
+                                 DataT,
+                                 typename IOLayout::DataLayout,
+                                 typename IOLayout::MatrixLayout,
+                                 IOLayout::VW,
+                                 QuantT>;
+
+        // Sanity checks
+        static_assert(!is_same<DataLayoutT, void>::value,
+                      "Must provide layout information. Statically assign data layout in "
+                      "fragment declaration.");
+
+        static_assert(
+            is_same<typename FragT::Traits::AccessT, typename Loader::Traits::OutputT>::value,
+            "Fragment access and load output types do not match");
+
+        // Paged load, convert then implicit pack
+        Loader::exec(frag.mAccess, data, pageTable, pageSize, ldm, make_coord2d(row, col));
+    }
+
+    template <typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void load_matrix_buffer_sync(
+        fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>& frag,
+        const DataT*                                                   data,
+        uint32_t                                                       ldm)
+    {
+        // Full 32-bit buffer range
+        load_matrix_buffer_sync(frag, data, ldm, 0xFFFFFFFFu / (uint32_t)sizeof(DataT));
+    }
+
+    template <typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void load_matrix_buffer_sync(
+        fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>& frag,
+        const DataT*                                                   data,
+        uint32_t                                                       ldm,
+        uint32_t                                                       numElements)
+    {
+        using FragT  = decay_t<decltype(frag)>;
+        using Loader = typename GetIOConfig_t<FragT>::BufferLoader;
+
+        // Sanity checks
+        static_assert(!is_same<DataLayoutT, void>::value,
+                      "Must provide layout information. Statically assign data layout in "
+                      "fragment declaration.");
+
+        static_assert(
+            is_same<typename FragT::Traits::AccessT, typename Loader::Traits::OutputT>::value,
+            "Fragment access and load output types do not match");
+
+        // Buffer load then implicit pack
+        Loader::exec(frag.mAccess, data, ldm, numElements);
+    }
+
+    template <typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void prefetch_matrix_sync(
+        fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& frag,
+        const DataT*                                                         data,
+        uint32_t                                                             ldm)
+    {
+        using FragT   = decay_t<decltype(frag)>;
+        using IOShape = GetIOShape_t<FragT>;
+        using Prefetcher
+            = Prefetch<IOShape::BlockHeight, IOShape::BlockWidth, DataT, DataLayoutT>;
+
+        // Sanity checks
+        static_assert(!is_same<DataLayoutT, void>::value,
+                      "Must provide layout information. Statically assign data layout in "
+                      "fragment declaration.");
+
+        // Contiguous lines of the block are ldm apart
+        Prefetcher::exec([data, ldm](uint32_t line) { return data + line * ldm; });
+    }
+
+    template <typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void prefetch_matrix_paged_sync(
+        fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& frag,
+        const DataT*                                                         data,
+        const index_t*                                                       pageTable,
+        uint32_t                                                             pageSize,
+        uint32_t                                                             ldm,
+        uint32_t                                                             row,
+        uint32_t                                                             col)
+    {
+        using FragT   = decay_t<decltype(frag)>;
+        using IOShape = GetIOShape_t<FragT>;
+        using Prefetcher
+            = Prefetch<IOShape::BlockHeight, IOShape::BlockWidth, DataT, DataLayoutT>;
+
+        // Sanity checks
+        static_assert(!is_same<DataLayoutT, void>::value,
+                      "Must provide layout information. Statically assign data layout in "
+                      "fragment declaration.");
+
+        // Major vectors of the block are looked up in the page table, as in PagedLoad
+        constexpr bool IsRowMajor = is_same<DataLayoutT, row_major>::value;
+        auto const     origin     = IsRowMajor ? row : col;
+        auto const     minor      = IsRowMajor ? col : row;
+
+        Prefetcher::exec([=](uint32_t line) -> DataT const* {
+            auto major = origin + line;
+            auto page  = pageTable[major / pageSize];
+            if(page < 0)
+            {
+                return nullptr;
+            }
+
+            // Page pools may exceed 32-bit element offsets
+            auto vector = static_cast<int64_t>(page) * pageSize + major % pageSize;
+            return data + vector * ldm + minor;
+        });
+    }
+
+    template <typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void
+        store_matrix_sync(DataT*                                                               data,
+                          fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& frag,
+                          uint32_t                                                             ldm)
+    {
+        using FragT  = decay_t<decltype(frag)>;
+        using Storer = typename GetIOConfig_t<FragT>::Storer;
+
+        // Sanity check
+        static_assert(!is_same<DataLayoutT, void>::value,
+                      "Must provide data layout. Either statically assign data layout in "
+                      "fragment declaration or use the run-time function overload.");
+
+        static_assert(
+            is_same<typename FragT::Traits::AccessT, typename Storer::Traits::InputT>::value,
+            "Fragment access and store input types do not match");
+
+        // Implicit unpack and then store
+        Storer::exec(data, frag.mAccess, ldm);
+    }
+
+    template <typename MatrixT, uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename DataT>
+    ROCWMMA_DEVICE void
+        store_matrix_sync(DataT*                                                  data,
+                          fragment<MatrixT, BlockM, BlockN, BlockK, DataT> const& frag,
+                          uint32_t                                                ldm,
+                          layout_t                                                layout)
+    {
+        using FragRowMajor = fragment<MatrixT, BlockM, BlockN, BlockK, DataT, row_major>;
+        using FragColMajor = fragment<MatrixT, BlockM, BlockN, BlockK, DataT, col_major>;
+
+        // Dispatch on layout type
+        if(layout == layout_t::mem_row_major)
+        {
+            store_matrix_sync(data, reinterpret_cast<FragRowMajor const&>(frag), ldm);
+        }
+        else
+        {
+            store_matrix_sync(data, reinterpret_cast<FragColMajor const&>(frag), ldm);
+        }
+    }
+
+    template <typename AccessPolicyT,
+              typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void
+        store_matrix_sync(DataT*                                                               data,
+                          fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& frag,
+                          uint32_t                                                             ldm)
+    {
+        using FragT  = decay_t<decltype(frag)>;
+        using Storer = typename GetIOConfig_t<FragT>::template PolicyStorer<AccessPolicyT>;
+
+        // Sanity check
+        static_assert(!is_same<DataLayoutT, void>::value,
+                      "Must provide data layout. Statically assign data layout in "
+                      "fragment declaration to use access policy stores.");
+
+        static_assert(
+            is_same<typename FragT::Traits::AccessT, typename Storer::Traits::InputT>::value,
+            "Fragment access and store input types do not match");
+
+        // Implicit unpack and then store
+        Storer::exec(data, frag.mAccess, ldm);
+    }
+
+    template <typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT,
+              uint32_t AlignBytes>
+    ROCWMMA_DEVICE void
+        store_matrix_sync(aligned_ptr<DataT, AlignBytes>                                       data,
+                          fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& frag,
+                          uint32_t                                                             ldm)
+    {
+        using FragT  = decay_t<decltype(frag)>;
+        using Storer = typename GetIOConfig_t<FragT>::template AlignedStorer<AlignBytes>;
+
+        // Sanity check
+        static_assert(!is_same<DataLayoutT, void>::value,
+                      "Must provide data layout. Statically assign data layout in "
+                      "fragment declaration to use aligned stores.");
+
+        static_assert(
+            is_same<typename FragT::Traits::AccessT, typename Storer::Traits::InputT>::value,
+            "Fragment access and store input types do not match");
+
+        // Implicit unpack and then store
+        Storer::exec(static_cast<DataT*>(__builtin_assume_aligned(data.ptr, AlignBytes)),
+                     frag.mAccess,
+                     ldm);
+    }
+
+    template <typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void store_matrix_bounded_sync(
+        DataT*                                                               data,
+        fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& frag,
+        uint32_t                                                             ldm,
+        uint32_t                                                             rows,
+        uint32_t                                                             cols)
+    {
+        using FragT  = decay_t<decltype(frag)>;
+        using Storer = typename GetIOConfig_t<FragT>::BoundedStorer;
+
+        // Sanity check
+        static_assert(!is_same<DataLayoutT, void>::value,
+                      "Must provide data layout. Either statically assign data layout in "
+                      "fragment declaration or use the run-time function overload.");
+
+        static_assert(
+            is_same<typename FragT::Traits::AccessT, typename Storer::Traits::InputT>::value,
+            "Fragment access and store input types do not match");
+
+        // Implicit unpack and then predicated store
+        Storer::exec(data, frag.mAccess, ldm, make_coord2d(rows, cols));
+    }
+
+    template <typename MatrixT, uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename DataT>
+    ROCWMMA_DEVICE void
+        store_matrix_bounded_sync(DataT*                                                  data,
+                                  fragment<MatrixT, BlockM, BlockN, BlockK, DataT> const& frag,
+                                  uint32_t                                                ldm,
+                                  uint32_t                                                rows,
+                                  uint32_t                                                cols,
+                                  layout_t                                                layout)
+    {
+        using FragRowMajor = fragment<MatrixT, BlockM, BlockN, BlockK, DataT, row_major>;
+        using FragColMajor = fragment<MatrixT, BlockM, BlockN, BlockK, DataT, col_major>;
+
+        // Dispatch on layout type
+        if(layout == layout_t::mem_row_major)
+        {
+            store_matrix_bounded_sync(
+                data, reinterpret_cast<FragRowMajor const&>(frag), ldm, rows, cols);
+        }
+        else
+        {
+            store_matrix_bounded_sync(
+                data, reinterpret_cast<FragColMajor const&>(frag), ldm, rows, cols);
+        }
+    }
+
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void store_matrix_atomic_add_sync(
+        DataT*                                                                   data,
+        fragment<accumulator, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& frag,
+        uint32_t                                                                 ldm)
+    {
+        using FragT  = decay_t<decltype(frag)>;
+        using Storer = typename GetIOConfig_t<FragT>::AtomicAddStorer;
+
+        // Sanity check
+        static_assert(!is_same<DataLayoutT, void>::value,
+                      "Must provide data layout. Either statically assign data layout in "
+                      "fragment declaration or use the run-time function overload.");
+
+        static_assert(
+            is_same<typename FragT::Traits::AccessT, typename Storer::Traits::InputT>::value,
+            "Fragment access and store input types do not match");
+
+        // Implicit unpack and then atomic add
+        Storer::exec(data, frag.mAccess, ldm);
+    }
+
+    template <uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename DataT>
+    ROCWMMA_DEVICE void store_matrix_atomic_add_sync(
+        DataT*                                                      data,
+        fragment<accumulator, BlockM, BlockN, BlockK, DataT> const& frag,
+        uint32_t                                                    ldm,
+        layout_t                                                    layout)
+    {
+        using FragRowMajor = fragment<accumulator, BlockM, BlockN, BlockK, DataT, row_major>;
+        using FragColMajor = fragment<accumulator, BlockM, BlockN, BlockK, DataT, col_major>;
+
+        // Dispatch on layout type
+        if(layout == layout_t::mem_row_major)
+        {
+            store_matrix_atomic_add_sync(data, reinterpret_cast<FragRowMajor const&>(frag), ldm);
+        }
+        else
+        {
+            store_matrix_atomic_add_sync(data, reinterpret_cast<FragColMajor const&>(frag), ldm);
+        }
+    }
+
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void store_matrix_scatter_sync(
+        DataT*                                                                   data,
+        fragment<accumulator, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& frag,
+        const index_t*                                                           rowIndices,
+        uint32_t                                                                 ldm)
+    {
+        using FragT  = decay_t<decltype(frag)>;
+        using Storer = typename GetIOConfig_t<FragT>::ScatterStorer;
+
+        // Sanity check
+        static_assert(!is_same<DataLayoutT, void>::value,
+                      "Must provide data layout. Either statically assign data layout in "
+                      "fragment declaration or use the run-time function overload.");
+
+        static_assert(
+            is_same<typename FragT::Traits::AccessT, typename Storer::Traits::InputT>::value,
+            "Fragment access and store input types do not match");
+
+        // Implicit unpack and then scatter
+        Storer::exec(data, frag.mAccess, rowIndices, ldm);
+    }
+
+    template <uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename DataT>
+    ROCWMMA_DEVICE void store_matrix_scatter_sync(
+        DataT*                                                      data,
+        fragment<accumulator, BlockM, BlockN, BlockK, DataT> const& frag,
+        const index_t*                                              rowIndices,
+        uint32_t                                                    ldm,
+        layout_t                                                    layout)
+    {
+        using FragRowMajor = fragment<accumulator, BlockM, BlockN, BlockK, DataT, row_major>;
+        using FragColMajor = fragment<accumulator, BlockM, BlockN, BlockK, DataT, col_major>;
+
+        // Dispatch on layout type
+        if(layout == layout_t::mem_row_major)
+        {
+            store_matrix_scatter_sync(
+                data, reinterpret_cast<FragRowMajor const&>(frag), rowIndices, ldm);
+        }
+        else
+        {
+            store_matrix_scatter_sync(
+                data, reinterpret_cast<FragColMajor const&>(frag), rowIndices, ldm);
+        }
+    }
+
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void store_matrix_paged_sync(
+        DataT*                                                                   data,
+        fragment<accumulator, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& frag,
+        const index_t*                                                           pageTable,
+        uint32_t                                                                 pageSize,
+        uint32_t                                                                 ldm,
+        uint32_t                                                                 row,
+        uint32_t                                                                 col)
+    {
+        using FragT  = decay_t<decltype(frag)>;
+        using Storer = typename GetIOConfig_t<FragT>::PagedStorer;
+
+        // Sanity check
+        static_assert(!is_same<DataLayoutT, void>::value,
+                      "Must provide layout information. Statically assign data layout in "
+                      "fragment declaration.");
+
+        static_assert(
+            is_same<typename FragT::Traits::AccessT, typename Storer::Traits::InputT>::value,
+            "Fragment access and store input types do not match");
+
+        // Implicit unpack and then paged store
+        Storer::exec(data, frag.mAccess, pageTable, pageSize, ldm, make_coord2d(row, col));
+    }
+
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void store_matrix_tensor_sync(
+        DataT*                                                                   data,
+        fragment<accumulator, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& frag,
+        tensor_view const&                                                       view,
+        uint32_t                                                                 row,
+        uint32_t                                                                 col,
+        uint32_t                                                                 batch)
+    {
+        using FragT  = decay_t<decltype(frag)>;
+        using Storer = typename GetIOConfig_t<FragT>::TensorStorer;
+
+        // Sanity check
+        static_assert(!is_same<DataLayoutT, void>::value,
+                      "Must provide data layout. Statically assign data layout in "
+                      "fragment declaration.");
+
+        static_assert(
+            is_same<typename FragT::Traits::AccessT, typename Storer::Traits::InputT>::value,
+            "Fragment access and store input types do not match");
+
+        // Implicit unpack and then tensor addressed store
+        Storer::exec(data + detail::TensorSpace::fromBatchIndex(batch, view),
+                     frag.mAccess,
+                     view,
+                     make_coord2d(row, col));
+    }
+
+    namespace detail
+    {
+        // Gfx9 uses MFMA, gfx11 uses WMMA
+        template <typename InputT,
+                  typename ComputeT,
+                  uint32_t BlockM,
+                  uint32_t BlockN,
+                  uint32_t BlockK>
+        using MmaBackend_t = conditional_t<ROCWMMA_ARCH_GFX9,
+                                           Mfma<InputT, ComputeT, BlockM, BlockN, BlockK>,
+                                           Wmma<InputT, ComputeT, BlockM, BlockN, BlockK>>;
+
+        template <typename FragA, typename FragB>
+        ROCWMMA_DEVICE constexpr inline void checkMmaInputs()
+        {
+            using IOConfigA = GetIOConfig_t<FragA>;
+            using IOConfigB = GetIOConfig_t<FragB>;
+
+            // Sanity checks
+            static_assert((IOConfigA::IOShape::BlockDim >= 16)
+                              && (IOConfigB::IOShape::BlockDim >= 16)
+                              && (IOConfigA::IOShape::BlockDim <= 32)
+                              && (IOConfigB::IOShape::BlockDim <= 32),
+                          "Input fragment BlockDim is not mfma friendly");
+
+            static_assert(IOConfigA::IOShape::KDim == IOConfigB::IOShape::KDim,
+                          "KDim of input fragments must match");
+
+            static_assert(is_orthogonal_v<typename IOConfigA::IOLayout::MatrixLayout,
+                                          typename IOConfigB::IOLayout::MatrixLayout>,
+                          "Input fragment matrix layouts are not orthogonal");
+
+            static_assert(is_same_v<typename IOConfigA::IOLayout::RegisterLayout,
+                                    typename IOConfigB::IOLayout::RegisterLayout>,
+                          "Input fragment register layouts do not match");
+
+            static_assert(is_same_v<typename IOConfigA::IOLayout::RegisterLayout,
+                                    RegisterLayout::template Soa<IOConfigA::IOShape::BlockDim,
+                                                                 IOConfigA::IOLayout::MaxVW>>,
+                          "Input fragment register layouts are not mfma friendly");
+        }
+
+        // Accumulators of different datatypes are co-indexed if their register layouts match.
+        // The register layout doesn't depend on the data layout, which may be void.
+        template <typename FragD, typename FragC>
+        ROCWMMA_DEVICE constexpr inline void checkCoIndexed()
+        {
+            using IOShapeD = typename GetIOConfig_t<FragD>::IOShape;
+            using IOShapeC = typename GetIOConfig_t<FragC>::IOShape;
+
+            using IOLayoutD = IOLayout<accumulator,
+                                       IOShapeD::BlockDim,
+                                       IOShapeD::KDim,
+                                       typename FragD::element_type,
+                                       row_major,
+                                       1u>;
+            using IOLayoutC = IOLayout<accumulator,
+                                       IOShapeC::BlockDim,
+                                       IOShapeC::KDim,
+                                       typename FragC::element_type,
+                                       row_major,
+                                       1u>;
+
+            static_assert(is_same_v<typename IOLayoutD::RegisterLayout,
+                                    typename IOLayoutC::RegisterLayout>,
+                          "Accumulator fragment register layouts do not match");
+        }
+
+        template <uint32_t BlockM,
+                  uint32_t BlockN,
+                  uint32_t BlockK,
+                  typename InputT,
+                  typename ComputeT>
+        struct NativeAccumTraits
+        {
+            using MMA = MmaBackend_t<InputT, ComputeT, BlockM, BlockN, BlockK>;
+
+            // Native register layout of the packed accumulator fragment
+            using FragAcc  = fragment<accumulator, BlockM, BlockN, BlockK, ComputeT>;
+            using StorageT = decltype(MMA::toNative(typename FragAcc::Traits::StorageT{}));
+        };
+
+    } // namespace detail
+
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename InputT,
+              typename ComputeT,
+              typename LayoutA,
+              typename LayoutB,
+              typename LayoutC,
+              typename LayoutD>
+    ROCWMMA_DEVICE void
+        mma_sync(fragment<accumulator, BlockM, BlockN, BlockK, ComputeT, LayoutD>&       d,
+                 fragment<matrix_a, BlockM, BlockN, BlockK, InputT, LayoutA> const&      a,
+                 fragment<matrix_b, BlockM, BlockN, BlockK, InputT, LayoutB> const&      b,
+                 fragment<accumulator, BlockM, BlockN, BlockK, ComputeT, LayoutC> const& c)
+    {
+        detail::checkMmaInputs<decay_t<decltype(a)>, decay_t<decltype(b)>>();
+
+        using MMA = detail::MmaBackend_t<InputT, ComputeT, BlockM, BlockN, BlockK>;
+
+        // mma functions operate on packed vectors
+        (*d) = MMA::exec(*a, *b, *c);
+    }
+
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename InputT,
+              typename ComputeT,
+              typename LayoutA,
+              typename LayoutB,
+              typename LayoutC,
+              typename LayoutD>
+    ROCWMMA_DEVICE void
+        mma_sync_split(fragment<accumulator, BlockM, BlockN, BlockK, ComputeT, LayoutD>&       d,
+                       fragment<matrix_a, BlockM, BlockN, BlockK, InputT, LayoutA> const&      aHi,
+                       fragment<matrix_a, BlockM, BlockN, BlockK, InputT, LayoutA> const&      aLo,
+                       fragment<matrix_b, BlockM, BlockN, BlockK, InputT, LayoutB> const&      bHi,
+                       fragment<matrix_b, BlockM, BlockN, BlockK, InputT, LayoutB> const&      bLo,
+                       fragment<accumulator, BlockM, BlockN, BlockK, ComputeT, LayoutC> const& c)
+    {
+        detail::checkMmaInputs<decay_t<decltype(aHi)>, decay_t<decltype(bHi)>>();
+
+        using MMA = detail::MmaBackend_t<InputT, ComputeT, BlockM, BlockN, BlockK>;
+
+        // Small terms first, so they are not lost to the rounding of the large term
+        auto accum = MMA::exec(*aLo, *bHi, *c);
+        accum      = MMA::exec(*aHi, *bLo, accum);
+        (*d)       = MMA::exec(*aHi, *bHi, accum);
+    }
+
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename InputT,
+              typename ComputeT,
+              typename DataTC,
+              typename LayoutA,
+              typename LayoutB,
+              typename LayoutC,
+              typename LayoutD>
+    ROCWMMA_DEVICE void
+        mma_sync(fragment<accumulator, BlockM, BlockN, BlockK, ComputeT, LayoutD>&     d,
+                 fragment<matrix_a, BlockM, BlockN, BlockK, InputT, LayoutA> const&    a,
+                 fragment<matrix_b, BlockM, BlockN, BlockK, InputT, LayoutB> const&    b,
+                 fragment<accumulator, BlockM, BlockN, BlockK, DataTC, LayoutC> const& c)
+    {
+        using FragC   = decay_t<decltype(c)>;
+        using FragAcc = fragment<accumulator, BlockM, BlockN, BlockK, ComputeT, LayoutC>;
+
+        detail::checkCoIndexed<decay_t<decltype(d)>, FragC>();
+
+        // Element-wise conversion of the whole vector, using packed conversions where available
+        FragAcc accum;
+        accum.mAccess = Convert<DataTC, ComputeT>::exec(c.mAccess);
+
+        mma_sync(d, a, b, accum);
+    }
+
+    template <bool SignedA,
+              bool SignedB,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename LayoutA,
+              typename LayoutB,
+              typename LayoutC,
+              typename LayoutD>
+    ROCWMMA_DEVICE void
+        mma_sync_iu4(fragment<accumulator, BlockM, BlockN, BlockK, int32_t, LayoutD>&       d,
+                     fragment<matrix_a, BlockM, BlockN, BlockK, int8_t, LayoutA> const&      a,
+                     fragment<matrix_b, BlockM, BlockN, BlockK, int8_t, LayoutB> const&      b,
+                     fragment<accumulator, BlockM, BlockN, BlockK, int32_t, LayoutC> const& c)
+    {
+        detail::checkMmaInputs<decay_t<decltype(a)>, decay_t<decltype(b)>>();
+
+        if constexpr(ROCWMMA_ARCH_GFX11 || ROCWMMA_ARCH_GFX12)
+        {
+            static_assert(BlockM == 16u && BlockN == 16u, "iu4 WMMA supports 16 x 16 blocks only");
+
+            using MMA      = Wmma<int4_t, int32_t, BlockM, BlockN, BlockK>;
+            using PackUtil = PackUtil<int4_t>;
+
+            // Nibbles of the int8_t elements, in the register order of the fragments
+            (*d) = MMA::template exec<SignedA, SignedB>(
+                PackUtil::pack(a.mAccess), PackUtil::pack(b.mAccess), *c);
+        }
+        else
+        {
+            // 4-bit values of either sign are exact in int8_t
+            mma_sync(d, a, b, c);
+        }
+    }
+
+    template <uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename InputT, typename ComputeT>
+    ROCWMMA_DEVICE inline auto
+        native_accumulator<BlockM, BlockN, BlockK, InputT, ComputeT>::operator*() ->
+        typename Traits::StorageT&
+    {
+        return mStorage;
+    }
+
+    template <uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename InputT, typename ComputeT>
+    ROCWMMA_DEVICE inline auto
+        native_accumulator<BlockM, BlockN, BlockK, InputT, ComputeT>::operator*() const ->
+        typename Traits::StorageT const&
+    {
+        return mStorage;
+    }
+
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename InputT,
+              typename ComputeT,
+              typename LayoutC>
+    ROCWMMA_DEVICE void
+        to_native(native_accumulator<BlockM, BlockN, BlockK, InputT, ComputeT>&     acc,
+                  fragment<accumulator, BlockM, BlockN, BlockK, ComputeT, LayoutC> const& c)
+    {
+        using MMA = detail::MmaBackend_t<InputT, ComputeT, BlockM, BlockN, BlockK>;
+        (*acc)    = MMA::toNative(*c);
+    }
+
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename InputT,
+              typename ComputeT,
+              typename LayoutD>
+    ROCWMMA_DEVICE void
+        from_native(fragment<accumulator, BlockM, BlockN, BlockK, ComputeT, LayoutD>&   d,
+                    native_accumulator<BlockM, BlockN, BlockK, InputT, ComputeT> const& acc)
+    {
+        using MMA = detail::MmaBackend_t<InputT, ComputeT, BlockM, BlockN, BlockK>;
+        (*d)      = MMA::fromNative(*acc);
+    }
+
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename InputT,
+              typename ComputeT,
+              typename LayoutA,
+              typename LayoutB>
+    ROCWMMA_DEVICE void
+        mma_sync(native_accumulator<BlockM, BlockN, BlockK, InputT, ComputeT>& acc,
+                 fragment<matrix_a, BlockM, BlockN, BlockK, InputT, LayoutA> const& a,
+                 fragment<matrix_b, BlockM, BlockN, BlockK, InputT, LayoutB> const& b)
+    {
+        detail::checkMmaInputs<decay_t<decltype(a)>, decay_t<decltype(b)>>();
+
+        using MMA = detail::MmaBackend_t<InputT, ComputeT, BlockM, BlockN, BlockK>;
+        (*acc)    = MMA::execNative(*a, *b, *acc);
+    }
+
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename InputT,
+              typename ChunkT,
+              uint32_t ChunkK>
+    ROCWMMA_DEVICE inline auto
+        chunked_accumulator<BlockM, BlockN, BlockK, InputT, ChunkT, ChunkK>::chunk() ->
+        FragChunk&
+    {
+        return mChunk;
+    }
+
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename InputT,
+              typename ChunkT,
+              uint32_t ChunkK>
+    ROCWMMA_DEVICE inline auto
+        chunked_accumulator<BlockM, BlockN, BlockK, InputT, ChunkT, ChunkK>::chunk() const ->
+        FragChunk const&
+    {
+        return mChunk;
+    }
+
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename InputT,
+              typename ChunkT,
+              uint32_t ChunkK>
+    ROCWMMA_DEVICE inline auto
+        chunked_accumulator<BlockM, BlockN, BlockK, InputT, ChunkT, ChunkK>::master() ->
+        FragMaster&
+    {
+        return mMaster;
+    }
+
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename InputT,
+              typename ChunkT,
+              uint32_t ChunkK>
+    ROCWMMA_DEVICE inline auto
+        chunked_accumulator<BlockM, BlockN, BlockK, InputT, ChunkT, ChunkK>::master() const ->
+        FragMaster const&
+    {
+        return mMaster;
+    }
+
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename InputT,
+              typename ChunkT,
+              uint32_t ChunkK>
+    ROCWMMA_DEVICE inline auto
+        chunked_accumulator<BlockM, BlockN, BlockK, InputT, ChunkT, ChunkK>::count() ->
+        uint32_t&
+    {
+        return mCount;
+    }
+
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename InputT,
+              typename ChunkT,
+              uint32_t ChunkK>
+    ROCWMMA_DEVICE inline auto
+        chunked_accumulator<BlockM, BlockN, BlockK, InputT, ChunkT, ChunkK>::count() const ->
+        uint32_t const&
+    {
+        return mCount;
+    }
+
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename InputT,
+              typename ChunkT,
+              uint32_t ChunkK>
+    ROCWMMA_DEVICE void
+        fold_chunked(chunked_accumulator<BlockM, BlockN, BlockK, InputT, ChunkT, ChunkK>& acc)
+    {
+        using FragChunk  = typename decay_t<decltype(acc)>::FragChunk;
+        using FragMaster = typename decay_t<decltype(acc)>::FragMaster;
+
+        // Accumulator register layouts don't depend on the 16 or 32b data type
+        static_assert(FragChunk::num_elements == FragMaster::num_elements,
+                      "Chunk and master accumulators are not co-indexed");
+
+        auto& chunk  = acc.chunk();
+        auto& master = acc.master();
+
+#pragma unroll
+        for(uint32_t i = 0; i < FragMaster::num_elements; i++)
+        {
+            master.x[i] += static_cast<float32_t>(chunk.x[i]);
+        }
+
+        fill_fragment(chunk, static_cast<ChunkT>(0));
+        acc.count() = 0u;
+    }
+
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename InputT,
+              typename ChunkT,
+              uint32_t ChunkK,
+              typename LayoutC>
+    ROCWMMA_DEVICE void
+        to_chunked(chunked_accumulator<BlockM, BlockN, BlockK, InputT, ChunkT, ChunkK>&     acc,
+                   fragment<accumulator, BlockM, BlockN, BlockK, float32_t, LayoutC> const& c)
+    {
+        (*acc.master()) = (*c);
+        fill_fragment(acc.chunk(), static_cast<ChunkT>(0));
+        acc.count() = 0u;
+    }
+
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename InputT,
+              typename ChunkT,
+              uint32_t ChunkK,
+              typename LayoutD>
+    ROCWMMA_DEVICE void from_chunked(
+        fragment<accumulator, BlockM, BlockN, BlockK, float32_t, LayoutD>&         d,
+        chunked_accumulator<BlockM, BlockN, BlockK, InputT, ChunkT, ChunkK> const& acc)
+    {
+        auto const& chunk  = acc.chunk();
+        auto const& master = acc.master();
+
+#pragma unroll
+        for(uint32_t i = 0; i < d.num_elements; i++)
+        {
+            d.x[i] = master.x[i] + static_cast<float32_t>(chunk.x[i]);
+        }
+    }
+
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename InputT,
+              typename ChunkT,
+              uint32_t ChunkK,
+              typename LayoutA,
+              typename LayoutB>
+    ROCWMMA_DEVICE void
+        mma_sync(chunked_accumulator<BlockM, BlockN, BlockK, InputT, ChunkT, ChunkK>& acc,
+                 fragment<matrix_a, BlockM, BlockN, BlockK, InputT, LayoutA> const&   a,
+                 fragment<matrix_b, BlockM, BlockN, BlockK, InputT, LayoutB> const&   b)
+    {
+        detail::checkMmaInputs<decay_t<decltype(a)>, decay_t<decltype(b)>>();
+
+        using MMA = detail::MmaBackend_t<InputT, ChunkT, BlockM, BlockN, BlockK>;
+        (*acc.chunk()) = MMA::exec(*a, *b, *acc.chunk());
+
+        // Uniform across the wave: the chunk is folded by all lanes at once
+        if(++acc.count() == ChunkK)
+        {
+            fold_chunked(acc);
+        }
+    }
+
+    ROCWMMA_DEVICE void synchronize_workgroup()
+    {
+        __syncthreads();
+    }
+
+    // @cond
+    namespace detail
+    {
+        // The single thread of the workgroup that operates the inter-workgroup atomics
+        ROCWMMA_DEVICE inline bool isWorkgroupLeader()
+        {
+            return threadIdx.x == 0u && threadIdx.y == 0u && threadIdx.z == 0u;
+        }
+
+        // Retires the global writes of every thread of the workgroup at agent scope,
+        // before the leader publishes them.
+        ROCWMMA_DEVICE inline void workgroupRelease()
+        {
+            __builtin_amdgcn_fence(__ATOMIC_RELEASE, "agent");
+            synchronize_workgroup();
+        }
+
+        // Orders the following global reads of every thread after those acquired by the leader
+        ROCWMMA_DEVICE inline void workgroupAcquire()
+        {
+            synchronize_workgroup();
+            __builtin_amdgcn_fence(__ATOMIC_ACQUIRE, "agent");
+        }
+
+    } // namespace detail
+    // @endcond
+
+    ROCWMMA_DEVICE void synchronize_grid(uint32_t* barrier)
+    {
+        detail::workgroupRelease();
+
+        if(detail::isWorkgroupLeader())
+        {
+            // The first workgroup adds 2^31 - (workgroups - 1) and the others add 1: once all have
+            // arrived, the top bit of the counter has flipped, and its other bits are unchanged.
+            constexpr uint32_t phaseBit = 0x80000000u;
+
+            auto workgroups = gridDim.x * gridDim.y * gridDim.z;
+            auto first      = blockIdx.x == 0u && blockIdx.y == 0u && blockIdx.z == 0u;
+            auto arrive     = first ? phaseBit - (workgroups - 1u) : 1u;
+
+            auto old = __hip_atomic_fetch_add(
+                barrier, arrive, __ATOMIC_RELEASE, __HIP_MEMORY_SCOPE_AGENT);
+            auto phase = old & phaseBit;
+            while((__hip_atomic_load(barrier, __ATOMIC_ACQUIRE, __HIP_MEMORY_SCOPE_AGENT)
+                   & phaseBit)
+                  == phase)
+            {
+                __builtin_amdgcn_s_sleep(1);
+            }
+        }
+
+        detail::workgroupAcquire();
+    }
+
+    ROCWMMA_DEVICE uint32_t arrive_workgroup_counter(uint32_t* counter)
+    {
+        __shared__ uint32_t arrivals;
+
+        detail::workgroupRelease();
+
+        if(detail::isWorkgroupLeader())
+        {
+            arrivals
+                = __hip_atomic_fetch_add(counter, 1u, __ATOMIC_ACQ_REL, __HIP_MEMORY_SCOPE_AGENT);
+        }
+
+        detail::workgroupAcquire();
+        return arrivals;
+    }
+
+    ROCWMMA_DEVICE void signal_workgroup_flag(uint32_t* flag, uint32_t value)
+    {
+        detail::workgroupRelease();
+
+        if(detail::isWorkgroupLeader())
+        {
+            __hip_atomic_store(flag, value, __ATOMIC_RELEASE, __HIP_MEMORY_SCOPE_AGENT);
+        }
+    }
+
+    ROCWMMA_DEVICE void wait_workgroup_flag(uint32_t const* flag, uint32_t value)
+    {
+        if(detail::isWorkgroupLeader())
+        {
+            while(__hip_atomic_load(flag, __ATOMIC_ACQUIRE, __HIP_MEMORY_SCOPE_AGENT) < value)
+            {
+                __builtin_amdgcn_s_sleep(1);
+            }
+        }
+
+        detail::workgroupAcquire();
     }
 
 } // namespace rocwmma
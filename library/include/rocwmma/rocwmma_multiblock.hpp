@@ -0,0 +1,276 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_MULTIBLOCK_API_HPP
+#define ROCWMMA_MULTIBLOCK_API_HPP
+
+#include "rocwmma.hpp"
+
+/**
+ * rocWMMA multiblock is a complimentary API for rocWMMA, exposing the multi-block 4 x 4 MFMA
+ * instructions of gfx9 targets for batches of tiny problems and for skinny panels.
+ *
+ * The 4 x 4 instructions execute 16 independent 4 x 4 blocks per wave at once. They are offered
+ * in two shapes, selected by the data layout tag of the fragments:
+ *  - batched_4x4: each wave computes 16 independent 4 x 4 x BlockK problems
+ *    D[b] = A[b] x B[b] + C[b], e.g. batched small matrix updates. Problem b is held in
+ *    lanes [4b, 4b + 4), and is read from and written to memory at b * batchStride elements
+ *    from the first.
+ *  - panel_64x4: each wave computes one 64 x 4 x BlockK panel D = A x B + C, e.g. a tall and
+ *    skinny GEMM or a multiply by few right hand sides. The 4 columns of B are broadcast to all
+ *    16 blocks, which each compute 4 rows of the panel.
+ * Where the square 16 x 16 and 32 x 32 blocks of rocwmma.hpp would be mostly padding for these
+ * problems, the 4 x 4 blocks keep every lane busy with useful data.
+ *
+ * Usage:
+ *  - Declare fragment<MatrixT, 4, 4, BlockK, DataT, batched_4x4> or
+ *    fragment<MatrixT, 64, 4, BlockK, DataT, panel_64x4> for each of matrix_a, matrix_b and
+ *    accumulator.
+ *  - Load and store with load_matrix_sync() and store_matrix_sync(), giving the in-memory
+ *    layout of each matrix at runtime.
+ *  - Multiply with mma_sync().
+ *
+ * Each lane holds BlockK elements of matrix_a and matrix_b fragments, and 4 elements of
+ * accumulator fragments. BlockK must be a multiple of 4.
+ *
+ * Supported configurations (InputT / ComputeT):
+ *  - float32_t / float32_t
+ *  - float16_t / float32_t
+ *  - bfloat16_t / float32_t
+ *  - int8_t / int32_t
+ *
+ * Only available on gfx9 targets in wave64; other targets receive an unsupported stub.
+ */
+
+namespace rocwmma
+{
+    //! @struct batched_4x4
+    //! @brief Data layout tag of fragments holding 16 independent 4 x 4 x BlockK problems per wave
+    struct batched_4x4;
+
+    //! @struct panel_64x4
+    //! @brief Data layout tag of fragments holding one 64 x 4 x BlockK panel per wave
+    struct panel_64x4;
+
+    //! @class fragment
+    //! @brief Fragment of 16 independent 4 x 4 x BlockK problems. Lane l holds problem l / 4:
+    //! row l % 4 of matrix_a, column l % 4 of matrix_b, and column l % 4 of the accumulator.
+    //!
+    //! @tparam MatrixT fragment context
+    //! @tparam BlockM/N/K block dimensions of each problem. BlockM and BlockN must be 4.
+    //! @tparam DataT datatype
+    template <typename MatrixT, uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename DataT>
+    class __align__(4) fragment<MatrixT, BlockM, BlockN, BlockK, DataT, batched_4x4>
+    {
+    public:
+        struct Traits
+        {
+        private:
+            //! The packed type for element data
+            using PackedElementT = typename PackTraits<DataT>::PackedT;
+
+            //! The unpacked type for element data
+            using UnpackedElementT = typename PackTraits<DataT>::UnpackedT;
+
+        public:
+            //! Elements per lane
+            constexpr static uint32_t Size = is_same_v<MatrixT, accumulator> ? 4u : BlockK;
+
+            //! Unpacked data access view
+            using AccessT = VecT<UnpackedElementT, Size>;
+
+            //! Packed data storage view
+            using StorageT = VecT<PackedElementT, Size / PackTraits<DataT>::PackRatio>;
+
+            static_assert(BlockM == 4u && BlockN == 4u, "Batched problems must be 4 x 4");
+            static_assert(BlockK % 4u == 0u, "BlockK must be a multiple of 4");
+            static_assert(Size % PackTraits<DataT>::PackRatio == 0,
+                          "Unable to pack fragment elements");
+        };
+
+        //! @returns Mutable packed storage vector accessor
+        ROCWMMA_DEVICE inline typename Traits::StorageT& operator*();
+        //! @returns Immutable packed storage vector accessor
+        ROCWMMA_DEVICE inline typename Traits::StorageT const& operator*() const;
+
+        //! Internal data storage views
+        union
+        {
+            typename Traits::StorageT             mStorage; // Packed
+            typename Traits::AccessT              mAccess; // Unpacked
+            typename Traits::AccessT::Native_vec_ x; // Nuanced access
+        };
+
+        constexpr static uint32_t num_elements = Traits::Size;
+        using element_type                     = DataT;
+    };
+
+    //! @class fragment
+    //! @brief Fragment of one 64 x 4 x BlockK panel. Lane l holds row l of matrix_a,
+    //! column l % 4 of matrix_b and row l of the accumulator.
+    //!
+    //! @tparam MatrixT fragment context
+    //! @tparam BlockM/N/K block dimensions of the panel. BlockM must be 64, and BlockN 4.
+    //! @tparam DataT datatype
+    //!
+    //! @note mma_sync() only reads the matrix_b data of lanes 0 to 3, and broadcasts it.
+    template <typename MatrixT, uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename DataT>
+    class __align__(4) fragment<MatrixT, BlockM, BlockN, BlockK, DataT, panel_64x4>
+    {
+    public:
+        struct Traits
+        {
+        private:
+            //! The packed type for element data
+            using PackedElementT = typename PackTraits<DataT>::PackedT;
+
+            //! The unpacked type for element data
+            using UnpackedElementT = typename PackTraits<DataT>::UnpackedT;
+
+        public:
+            //! Elements per lane
+            constexpr static uint32_t Size = is_same_v<MatrixT, accumulator> ? 4u : BlockK;
+
+            //! Unpacked data access view
+            using AccessT = VecT<UnpackedElementT, Size>;
+
+            //! Packed data storage view
+            using StorageT = VecT<PackedElementT, Size / PackTraits<DataT>::PackRatio>;
+
+            static_assert(BlockM == 64u && BlockN == 4u, "Panels must be 64 x 4");
+            static_assert(BlockK % 4u == 0u, "BlockK must be a multiple of 4");
+            static_assert(Size % PackTraits<DataT>::PackRatio == 0,
+                          "Unable to pack fragment elements");
+        };
+
+        //! @returns Mutable packed storage vector accessor
+        ROCWMMA_DEVICE inline typename Traits::StorageT& operator*();
+        //! @returns Immutable packed storage vector accessor
+        ROCWMMA_DEVICE inline typename Traits::StorageT const& operator*() const;
+
+        //! Internal data storage views
+        union
+        {
+            typename Traits::StorageT             mStorage; // Packed
+            typename Traits::AccessT              mAccess; // Unpacked
+            typename Traits::AccessT::Native_vec_ x; // Nuanced access
+        };
+
+        constexpr static uint32_t num_elements = Traits::Size;
+        using element_type                     = DataT;
+    };
+
+    //! Fills the batched fragment with the desired value.
+    //! @param frag Batched fragment of any context
+    //! @param value Fill value
+    template <typename MatrixT, uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename DataT>
+    ROCWMMA_DEVICE void
+        fill_fragment(fragment<MatrixT, BlockM, BlockN, BlockK, DataT, batched_4x4>& frag,
+                      DataT                                                          value);
+
+    //! Fills the panel fragment with the desired value.
+    //! @param frag Panel fragment of any context
+    //! @param value Fill value
+    template <typename MatrixT, uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename DataT>
+    ROCWMMA_DEVICE void
+        fill_fragment(fragment<MatrixT, BlockM, BlockN, BlockK, DataT, panel_64x4>& frag,
+                      DataT                                                         value);
+
+    //! Loads 16 problems into the batched fragment. Data pointers may point to either local or
+    //! global memory.
+    //! @param frag Batched fragment of any context
+    //! @param data Pointer to the first element of problem 0
+    //! @param ldm Leading dimension of each problem matrix
+    //! @param layout In-memory layout of each problem matrix as mem_row_major or mem_col_major
+    //! @param batchStride Elements between the first elements of consecutive problems
+    template <typename MatrixT, uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename DataT>
+    ROCWMMA_DEVICE void load_matrix_sync(
+        fragment<MatrixT, BlockM, BlockN, BlockK, DataT, batched_4x4>& frag,
+        const DataT*                                                   data,
+        uint32_t                                                       ldm,
+        layout_t                                                       layout,
+        uint32_t                                                       batchStride);
+
+    //! Loads a panel fragment. Data pointers may point to either local or global memory.
+    //! @param frag Panel fragment of any context
+    //! @param data Pointer to the first element of the panel matrix
+    //! @param ldm Leading dimension of the panel matrix
+    //! @param layout In-memory layout of the panel matrix as mem_row_major or mem_col_major
+    template <typename MatrixT, uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename DataT>
+    ROCWMMA_DEVICE void
+        load_matrix_sync(fragment<MatrixT, BlockM, BlockN, BlockK, DataT, panel_64x4>& frag,
+                         const DataT*                                                  data,
+                         uint32_t                                                      ldm,
+                         layout_t                                                      layout);
+
+    //! Stores the 16 problems of a batched accumulator fragment. Arguments are as for the
+    //! batched load_matrix_sync().
+    template <uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename DataT>
+    ROCWMMA_DEVICE void store_matrix_sync(
+        DataT*                                                                   data,
+        fragment<accumulator, BlockM, BlockN, BlockK, DataT, batched_4x4> const& frag,
+        uint32_t                                                                 ldm,
+        layout_t                                                                 layout,
+        uint32_t                                                                 batchStride);
+
+    //! Stores a panel accumulator fragment. Arguments are as for the panel load_matrix_sync().
+    template <uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename DataT>
+    ROCWMMA_DEVICE void store_matrix_sync(
+        DataT*                                                                  data,
+        fragment<accumulator, BlockM, BlockN, BlockK, DataT, panel_64x4> const& frag,
+        uint32_t                                                                ldm,
+        layout_t                                                                layout);
+
+    //! Performs the Multiply-Accumulate operation D[b] = A[b] * B[b] + C[b] on the 16 problems of
+    //! the batched fragments.
+    //! @param d Accumulator output D
+    //! @param a Input A
+    //! @param b Input B
+    //! @param c Accumulator input C
+    //! @tparam BlockM/N/K Block dimensions of each problem
+    //! @tparam InputT Datatype of input frags A and B
+    //! @tparam ComputeT Datatype of accumulator fragment C / D
+    //! @note Frag c = d is valid
+    template <uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename InputT, typename ComputeT>
+    ROCWMMA_DEVICE void
+        mma_sync(fragment<accumulator, BlockM, BlockN, BlockK, ComputeT, batched_4x4>&       d,
+                 fragment<matrix_a, BlockM, BlockN, BlockK, InputT, batched_4x4> const&      a,
+                 fragment<matrix_b, BlockM, BlockN, BlockK, InputT, batched_4x4> const&      b,
+                 fragment<accumulator, BlockM, BlockN, BlockK, ComputeT, batched_4x4> const& c);
+
+    //! Performs the Multiply-Accumulate operation D = A * B + C on the panel fragments.
+    //! Arguments are as for the batched mma_sync().
+    template <uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename InputT, typename ComputeT>
+    ROCWMMA_DEVICE void
+        mma_sync(fragment<accumulator, BlockM, BlockN, BlockK, ComputeT, panel_64x4>&       d,
+                 fragment<matrix_a, BlockM, BlockN, BlockK, InputT, panel_64x4> const&      a,
+                 fragment<matrix_b, BlockM, BlockN, BlockK, InputT, panel_64x4> const&      b,
+                 fragment<accumulator, BlockM, BlockN, BlockK, ComputeT, panel_64x4> const& c);
+
+} // namespace rocwmma
+
+#include "rocwmma_multiblock_impl.hpp"
+
+#endif // ROCWMMA_MULTIBLOCK_API_HPP
@@ -0,0 +1,275 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_MULTIBLOCK_API_IMPL_HPP
+#define ROCWMMA_MULTIBLOCK_API_IMPL_HPP
+
+#include "rocwmma_multiblock.hpp"
+
+#include "internal/mfma_multiblock.hpp"
+
+namespace rocwmma
+{
+    // @cond
+    namespace detail
+    {
+        // Offset of element idx of the lane in memory. matrix_a lanes hold rows, and
+        // matrix_b lanes hold columns. Accumulator lanes hold the columns of batched
+        // problems, following the mfma output, and the rows of panels, whose mfma computes
+        // the transposed panel.
+        template <typename MatrixT, typename DataLayoutT>
+        ROCWMMA_DEVICE inline uint32_t multiBlockOffset(
+            uint32_t lane, uint32_t idx, uint32_t ldm, layout_t layout, uint32_t batchStride)
+        {
+            constexpr bool     IsBatched = is_same_v<DataLayoutT, batched_4x4>;
+            constexpr uint32_t BlockM    = IsBatched ? 4u : 64u;
+            constexpr bool     LaneIsRow = is_same_v<MatrixT, matrix_a>
+                                       || (is_same_v<MatrixT, accumulator> && !IsBatched);
+
+            // Batched problem b is held in lanes [4b, 4b + 4)
+            auto batch = IsBatched ? lane / 4u : 0u;
+            auto row   = LaneIsRow ? lane % BlockM : idx;
+            auto col   = LaneIsRow ? idx : lane % 4u;
+
+            return batch * batchStride
+                   + (layout == mem_row_major ? row * ldm + col : col * ldm + row);
+        }
+
+        // Chains the mfma over the K elements of the lane, KPerMfma at a time.
+        // Cbsz = 4 broadcasts the A registers of lanes 0 to 3 to all blocks.
+        template <typename InputT,
+                  typename ComputeT,
+                  uint32_t Cbsz,
+                  typename RegsA,
+                  typename RegsB,
+                  typename RegsC>
+        ROCWMMA_DEVICE inline auto
+            multiBlockMma(RegsA const& regsA, RegsB const& regsB, RegsC const& regsC)
+        {
+            using MFMA   = amdgcn_mfma_4x4<InputT, ComputeT>;
+            using ARegsT = typename MFMA::Traits::ARegsT;
+            using BRegsT = typename MFMA::Traits::BRegsT;
+
+            constexpr uint32_t RegsPerMfma = VecTraits<ARegsT>::size();
+            constexpr uint32_t MfmaCount   = VecTraits<RegsA>::size() / RegsPerMfma;
+
+            // Sanity checks
+            static_assert(VecTraits<RegsA>::size() % RegsPerMfma == 0u,
+                          "BlockK must be a multiple of the mfma K dimension");
+            static_assert(VecTraits<RegsB>::size() == VecTraits<RegsA>::size(),
+                          "Input fragment sizes do not match");
+            static_assert(VecTraits<RegsC>::size()
+                              == VecTraits<typename MFMA::Traits::CRegsT>::size(),
+                          "Accumulator fragment size does not match mfma");
+
+            auto accum = regsC;
+
+#pragma unroll
+            for(uint32_t i = 0u; i < MfmaCount; i++)
+            {
+                ARegsT a;
+                BRegsT b;
+
+#pragma unroll
+                for(uint32_t j = 0u; j < RegsPerMfma; j++)
+                {
+                    a.data[j] = regsA.data[i * RegsPerMfma + j];
+                    b.data[j] = regsB.data[i * RegsPerMfma + j];
+                }
+
+                accum = MFMA::template exec<Cbsz, 0u>(a, b, accum);
+            }
+
+            return accum;
+        }
+
+    } // namespace detail
+
+    template <typename MatrixT, uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename DataT>
+    ROCWMMA_DEVICE inline auto
+        fragment<MatrixT, BlockM, BlockN, BlockK, DataT, batched_4x4>::operator*() ->
+        typename Traits::StorageT&
+    {
+        return mStorage;
+    }
+
+    template <typename MatrixT, uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename DataT>
+    ROCWMMA_DEVICE inline auto
+        fragment<MatrixT, BlockM, BlockN, BlockK, DataT, batched_4x4>::operator*() const ->
+        typename Traits::StorageT const&
+    {
+        return mStorage;
+    }
+
+    template <typename MatrixT, uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename DataT>
+    ROCWMMA_DEVICE inline auto
+        fragment<MatrixT, BlockM, BlockN, BlockK, DataT, panel_64x4>::operator*() ->
+        typename Traits::StorageT&
+    {
+        return mStorage;
+    }
+
+    template <typename MatrixT, uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename DataT>
+    ROCWMMA_DEVICE inline auto
+        fragment<MatrixT, BlockM, BlockN, BlockK, DataT, panel_64x4>::operator*() const ->
+        typename Traits::StorageT const&
+    {
+        return mStorage;
+    }
+
+    template <typename MatrixT, uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename DataT>
+    ROCWMMA_DEVICE void
+        fill_fragment(fragment<MatrixT, BlockM, BlockN, BlockK, DataT, batched_4x4>& frag,
+                      DataT                                                          value)
+    {
+#pragma unroll
+        for(uint32_t i = 0u; i < frag.num_elements; i++)
+        {
+            frag.x[i] = value;
+        }
+    }
+
+    template <typename MatrixT, uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename DataT>
+    ROCWMMA_DEVICE void
+        fill_fragment(fragment<MatrixT, BlockM, BlockN, BlockK, DataT, panel_64x4>& frag,
+                      DataT                                                         value)
+    {
+#pragma unroll
+        for(uint32_t i = 0u; i < frag.num_elements; i++)
+        {
+            frag.x[i] = value;
+        }
+    }
+
+    template <typename MatrixT, uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename DataT>
+    ROCWMMA_DEVICE void load_matrix_sync(
+        fragment<MatrixT, BlockM, BlockN, BlockK, DataT, batched_4x4>& frag,
+        const DataT*                                                   data,
+        uint32_t                                                       ldm,
+        layout_t                                                       layout,
+        uint32_t                                                       batchStride)
+    {
+        static_assert(Constants::AMDGCN_WAVE_SIZE == Constants::AMDGCN_WAVE_SIZE_64,
+                      "Multi-block fragments require wave64");
+
+        auto lane = detail::laneId();
+
+#pragma unroll
+        for(uint32_t i = 0u; i < frag.num_elements; i++)
+        {
+            frag.x[i] = data[detail::multiBlockOffset<MatrixT, batched_4x4>(
+                lane, i, ldm, layout, batchStride)];
+        }
+    }
+
+    template <typename MatrixT, uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename DataT>
+    ROCWMMA_DEVICE void
+        load_matrix_sync(fragment<MatrixT, BlockM, BlockN, BlockK, DataT, panel_64x4>& frag,
+                         const DataT*                                                  data,
+                         uint32_t                                                      ldm,
+                         layout_t                                                      layout)
+    {
+        static_assert(Constants::AMDGCN_WAVE_SIZE == Constants::AMDGCN_WAVE_SIZE_64,
+                      "Multi-block fragments require wave64");
+
+        auto lane = detail::laneId();
+
+#pragma unroll
+        for(uint32_t i = 0u; i < frag.num_elements; i++)
+        {
+            frag.x[i]
+                = data[detail::multiBlockOffset<MatrixT, panel_64x4>(lane, i, ldm, layout, 0u)];
+        }
+    }
+
+    template <uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename DataT>
+    ROCWMMA_DEVICE void store_matrix_sync(
+        DataT*                                                                   data,
+        fragment<accumulator, BlockM, BlockN, BlockK, DataT, batched_4x4> const& frag,
+        uint32_t                                                                 ldm,
+        layout_t                                                                 layout,
+        uint32_t                                                                 batchStride)
+    {
+        static_assert(Constants::AMDGCN_WAVE_SIZE == Constants::AMDGCN_WAVE_SIZE_64,
+                      "Multi-block fragments require wave64");
+
+        auto lane = detail::laneId();
+
+#pragma unroll
+        for(uint32_t i = 0u; i < frag.num_elements; i++)
+        {
+            data[detail::multiBlockOffset<accumulator, batched_4x4>(
+                lane, i, ldm, layout, batchStride)]
+                = frag.x[i];
+        }
+    }
+
+    template <uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename DataT>
+    ROCWMMA_DEVICE void store_matrix_sync(
+        DataT*                                                                  data,
+        fragment<accumulator, BlockM, BlockN, BlockK, DataT, panel_64x4> const& frag,
+        uint32_t                                                                ldm,
+        layout_t                                                                layout)
+    {
+        static_assert(Constants::AMDGCN_WAVE_SIZE == Constants::AMDGCN_WAVE_SIZE_64,
+                      "Multi-block fragments require wave64");
+
+        auto lane = detail::laneId();
+
+#pragma unroll
+        for(uint32_t i = 0u; i < frag.num_elements; i++)
+        {
+            data[detail::multiBlockOffset<accumulator, panel_64x4>(lane, i, ldm, layout, 0u)]
+                = frag.x[i];
+        }
+    }
+
+    template <uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename InputT, typename ComputeT>
+    ROCWMMA_DEVICE void
+        mma_sync(fragment<accumulator, BlockM, BlockN, BlockK, ComputeT, batched_4x4>&       d,
+                 fragment<matrix_a, BlockM, BlockN, BlockK, InputT, batched_4x4> const&      a,
+                 fragment<matrix_b, BlockM, BlockN, BlockK, InputT, batched_4x4> const&      b,
+                 fragment<accumulator, BlockM, BlockN, BlockK, ComputeT, batched_4x4> const& c)
+    {
+        // Each block of the mfma is one problem
+        (*d) = detail::multiBlockMma<InputT, ComputeT, 0u>(*a, *b, *c);
+    }
+
+    template <uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename InputT, typename ComputeT>
+    ROCWMMA_DEVICE void
+        mma_sync(fragment<accumulator, BlockM, BlockN, BlockK, ComputeT, panel_64x4>&       d,
+                 fragment<matrix_a, BlockM, BlockN, BlockK, InputT, panel_64x4> const&      a,
+                 fragment<matrix_b, BlockM, BlockN, BlockK, InputT, panel_64x4> const&      b,
+                 fragment<accumulator, BlockM, BlockN, BlockK, ComputeT, panel_64x4> const& c)
+    {
+        // The mfma computes the 4 x 64 transposed panel D^T = B^T x A^T + C^T: the columns of
+        // B are the broadcast A operand, and the rows of A are the 64 B operand columns.
+        (*d) = detail::multiBlockMma<InputT, ComputeT, 4u>(*b, *a, *c);
+    }
+    // @endcond
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_MULTIBLOCK_API_IMPL_HPP
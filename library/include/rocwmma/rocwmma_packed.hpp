@@ -0,0 +1,139 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_PACKED_API_HPP
+#define ROCWMMA_PACKED_API_HPP
+
+#include <hip/hip_runtime.h>
+
+#include "rocwmma.hpp"
+
+/**
+ * rocWMMA packed is a complimentary API for rocWMMA, storing matrix_a and matrix_b operands
+ * that are read many times, such as the weights of an inference model, in the register order
+ * of their fragments. A packed operand is loaded straight into registers with the widest
+ * coalesced global loads, without the layout transforms or LDS round trip of
+ * load_matrix_sync.
+ *
+ * The packed matrix is a sequence of blocks of the fragment size, ordered along K first:
+ *  - matrix_a block (i, k), of BlockM x BlockK, is block i * kBlocks + k
+ *  - matrix_b block (k, j), of BlockK x BlockN, is block j * kBlocks + k
+ * such that the blocks that one wave walks over K are contiguous. Within a block, the
+ * registers of each lane are split into chunks of up to 16B, interleaved across the lanes
+ * of the wave. Blocks over the edges of the matrix are padded with zeros.
+ *
+ * The register order depends on the fragment type and on the wave size of the target.
+ * Packed data is therefore specific to FragT and to the target it was packed on, and is not
+ * portable between wave32 and wave64 targets.
+ *
+ * Usage:
+ *  - Allocate packed_matrix_size<FragT>(rows, cols) elements, and call repack_matrix<FragT>()
+ *    once from the host on the device that will run the consumer kernels.
+ *  - In the kernels, load fragments with load_matrix_packed_sync() from
+ *    packed + packed_matrix_offset<FragT>(row, col, rows, cols).
+ *  - Alternatively, pack fragments from a kernel with store_matrix_packed_sync().
+ *
+ * Supported FragT: fragment<matrix_a, ...> and fragment<matrix_b, ...> of any datatype and
+ * layout supported by load_matrix_sync.
+ */
+
+namespace rocwmma
+{
+    //! Waves per workgroup of the repacking kernel, one block each
+    constexpr uint32_t PACKED_WAVE_COUNT = 4u;
+
+    //! @returns Elements of one packed block of FragT
+    template <typename FragT>
+    ROCWMMA_HOST_DEVICE constexpr inline uint32_t packed_block_size();
+
+    //! @returns Elements of the packed rows x cols matrix, including the padding of edge blocks
+    template <typename FragT>
+    ROCWMMA_HOST_DEVICE constexpr inline uint64_t packed_matrix_size(uint32_t rows, uint32_t cols);
+
+    //! @returns Offset, in elements, of the packed block at matrix coordinate (row, col). Both
+    //! coordinates must be multiples of the block dimensions of FragT.
+    //! @param rows/cols Size of the packed matrix
+    template <typename FragT>
+    ROCWMMA_HOST_DEVICE constexpr inline uint64_t
+        packed_matrix_offset(uint32_t row, uint32_t col, uint32_t rows, uint32_t cols);
+
+    //! Loads the fragment from one packed block, with fully coalesced loads of up to 16B
+    //! @param frag Fragment of type matrix_a or matrix_b
+    //! @param data Packed block in global or local memory, aligned to 16B
+    //! @tparam AccessPolicyT Cache policy of the loads, e.g. cache_non_temporal for weights
+    //! streamed once per kernel
+    template <typename AccessPolicyT = cache_default,
+              typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE inline void load_matrix_packed_sync(
+        fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>& frag, const DataT* data);
+
+    //! Stores the fragment to one packed block
+    //! @param data Packed block in global or local memory, aligned to 16B
+    //! @param frag Fragment of type matrix_a or matrix_b
+    template <typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE inline void store_matrix_packed_sync(
+        DataT* data, fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& frag);
+
+    //! Repacking kernel: each wave loads one block of the matrix bounded, and stores it packed
+    //! @param packed Packed matrix of packed_matrix_size<FragT>(rows, cols) elements
+    //! @param data Source matrix in the layout of FragT
+    //! @param rows/cols Size of the source matrix
+    //! @param ldm Leading dimension of the source matrix
+    //! @tparam FragT Fragment type of the consumer kernels
+    template <typename FragT>
+    ROCWMMA_KERNEL void __launch_bounds__(PACKED_WAVE_COUNT* Constants::AMDGCN_WAVE_SIZE)
+        repack_matrix_kernel(GetDataType_t<FragT>* __restrict__ packed,
+                             GetDataType_t<FragT> const* __restrict__ data,
+                             uint32_t rows,
+                             uint32_t cols,
+                             uint32_t ldm);
+
+    //! Enqueues the repacking of the rows x cols matrix on the stream.
+    //! Arguments are as for repack_matrix_kernel.
+    //! @returns hipErrorInvalidValue for a leading dimension smaller than the rows (col_major)
+    //! or cols (row_major) of the matrix, otherwise the status of the launch
+    template <typename FragT>
+    ROCWMMA_HOST inline hipError_t repack_matrix(GetDataType_t<FragT>*       packed,
+                                                 GetDataType_t<FragT> const* data,
+                                                 uint32_t                    rows,
+                                                 uint32_t                    cols,
+                                                 uint32_t                    ldm,
+                                                 hipStream_t                 stream = 0);
+
+} // namespace rocwmma
+
+#include "rocwmma_packed_impl.hpp"
+
+#endif // ROCWMMA_PACKED_API_HPP
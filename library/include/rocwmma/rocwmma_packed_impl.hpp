@@ -0,0 +1,261 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_PACKED_API_IMPL_HPP
+#define ROCWMMA_PACKED_API_IMPL_HPP
+
+#include "rocwmma_packed.hpp"
+
+#include "internal/register_order_io.hpp"
+
+namespace rocwmma
+{
+    // @cond
+    namespace detail
+    {
+        template <typename FragT>
+        struct PackedTraits;
+
+        template <typename MatrixT,
+                  uint32_t BlockM,
+                  uint32_t BlockN,
+                  uint32_t BlockK,
+                  typename DataT,
+                  typename DataLayoutT>
+        struct PackedTraits<fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>>
+        {
+            using FragT   = fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>;
+            using IOShape = GetIOShape_t<FragT>;
+            using Layout  = DataLayoutT;
+
+            enum : uint32_t
+            {
+                BlockHeight = IOShape::BlockHeight,
+                BlockWidth  = IOShape::BlockWidth,
+                BlockSize   = BlockHeight * BlockWidth,
+            };
+
+            // Blocks are ordered along K: the columns of matrix_a, the rows of matrix_b
+            constexpr static bool KIsWidth = is_same<MatrixT, matrix_a>::value;
+
+            static_assert(is_same<MatrixT, matrix_a>::value || is_same<MatrixT, matrix_b>::value,
+                          "Only matrix_a and matrix_b fragments can be packed");
+
+            ROCWMMA_HOST_DEVICE constexpr static inline uint32_t rowBlocks(uint32_t rows)
+            {
+                return (rows + BlockHeight - 1u) / BlockHeight;
+            }
+
+            ROCWMMA_HOST_DEVICE constexpr static inline uint32_t colBlocks(uint32_t cols)
+            {
+                return (cols + BlockWidth - 1u) / BlockWidth;
+            }
+
+            // Index of block (blockRow, blockCol) in the K-first block order
+            ROCWMMA_HOST_DEVICE constexpr static inline uint64_t
+                blockIndex(uint32_t blockRow, uint32_t blockCol, uint32_t rows, uint32_t cols)
+            {
+                return KIsWidth ? static_cast<uint64_t>(blockRow) * colBlocks(cols) + blockCol
+                                : static_cast<uint64_t>(blockCol) * rowBlocks(rows) + blockRow;
+            }
+        };
+
+        // Packed block IO of the fragment storage, for the wave size of the current target
+        template <typename FragT, typename AccessPolicyT = cache_default>
+        struct PackedBlockIO
+        {
+            using StorageT = typename FragT::Traits::StorageT;
+            using Block    = RegisterOrderIO<StorageT, Constants::AMDGCN_WAVE_SIZE, AccessPolicyT>;
+
+            static_assert(Block::BlockBytes
+                              == PackedTraits<FragT>::BlockSize * sizeof(GetDataType_t<FragT>),
+                          "Fragment registers must hold exactly one block to be packed");
+        };
+
+        ROCWMMA_HOST inline hipError_t packedHostWaveSize(uint32_t& waveSize)
+        {
+            int  device = 0;
+            int  size   = 0;
+            auto status = hipGetDevice(&device);
+            if(status == hipSuccess)
+            {
+                status = hipDeviceGetAttribute(&size, hipDeviceAttributeWarpSize, device);
+            }
+            waveSize = static_cast<uint32_t>(size);
+            return status;
+        }
+
+    } // namespace detail
+    // @endcond
+
+    template <typename FragT>
+    ROCWMMA_HOST_DEVICE constexpr inline uint32_t packed_block_size()
+    {
+        return detail::PackedTraits<FragT>::BlockSize;
+    }
+
+    template <typename FragT>
+    ROCWMMA_HOST_DEVICE constexpr inline uint64_t packed_matrix_size(uint32_t rows, uint32_t cols)
+    {
+        using Traits = detail::PackedTraits<FragT>;
+        return static_cast<uint64_t>(Traits::rowBlocks(rows)) * Traits::colBlocks(cols)
+               * Traits::BlockSize;
+    }
+
+    template <typename FragT>
+    ROCWMMA_HOST_DEVICE constexpr inline uint64_t
+        packed_matrix_offset(uint32_t row, uint32_t col, uint32_t rows, uint32_t cols)
+    {
+        using Traits = detail::PackedTraits<FragT>;
+        return Traits::blockIndex(row / Traits::BlockHeight, col / Traits::BlockWidth, rows, cols)
+               * Traits::BlockSize;
+    }
+
+    template <typename AccessPolicyT,
+              typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE inline void load_matrix_packed_sync(
+        fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>& frag, const DataT* data)
+    {
+        using FragT = fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>;
+        using Block = typename detail::PackedBlockIO<FragT, AccessPolicyT>::Block;
+
+        Block::load(*frag, reinterpret_cast<char const*>(data));
+    }
+
+    template <typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE inline void store_matrix_packed_sync(
+        DataT* data, fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT> const& frag)
+    {
+        using FragT = fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>;
+        using Block = typename detail::PackedBlockIO<FragT>::Block;
+
+        Block::store(reinterpret_cast<char*>(data), *frag);
+    }
+
+    template <typename FragT>
+    ROCWMMA_KERNEL void __launch_bounds__(PACKED_WAVE_COUNT* Constants::AMDGCN_WAVE_SIZE)
+        repack_matrix_kernel(GetDataType_t<FragT>* __restrict__ packed,
+                             GetDataType_t<FragT> const* __restrict__ data,
+                             uint32_t rows,
+                             uint32_t cols,
+                             uint32_t ldm)
+    {
+        using Traits    = detail::PackedTraits<FragT>;
+        using MapMatrix = GetDataLayout_t<FragT>;
+
+        static_assert(!is_same<typename Traits::Layout, void>::value,
+                      "Must provide the layout of the source matrix in the fragment type");
+
+        auto waveIdx = threadIdx.x / Constants::AMDGCN_WAVE_SIZE;
+        auto block   = static_cast<uint64_t>(blockIdx.x) * PACKED_WAVE_COUNT + waveIdx;
+
+        auto rowBlocks = Traits::rowBlocks(rows);
+        auto colBlocks = Traits::colBlocks(cols);
+        if(block >= static_cast<uint64_t>(rowBlocks) * colBlocks)
+        {
+            return;
+        }
+
+        // Source block of the packed block index, inverting the K-first order
+        uint32_t blockRow, blockCol;
+        if(Traits::KIsWidth)
+        {
+            blockRow = static_cast<uint32_t>(block / colBlocks);
+            blockCol = static_cast<uint32_t>(block % colBlocks);
+        }
+        else
+        {
+            blockCol = static_cast<uint32_t>(block / rowBlocks);
+            blockRow = static_cast<uint32_t>(block % rowBlocks);
+        }
+
+        auto row = blockRow * Traits::BlockHeight;
+        auto col = blockCol * Traits::BlockWidth;
+
+        // Edge blocks are zero filled by the bounded load
+        FragT frag;
+        load_matrix_bounded_sync(frag,
+                                 data + MapMatrix::fromMatrixCoord(make_coord2d(row, col), ldm),
+                                 ldm,
+                                 rows - row,
+                                 cols - col);
+        store_matrix_packed_sync(packed + block * Traits::BlockSize, frag);
+    }
+
+    template <typename FragT>
+    ROCWMMA_HOST inline hipError_t repack_matrix(GetDataType_t<FragT>*       packed,
+                                                 GetDataType_t<FragT> const* data,
+                                                 uint32_t                    rows,
+                                                 uint32_t                    cols,
+                                                 uint32_t                    ldm,
+                                                 hipStream_t                 stream)
+    {
+        using Traits = detail::PackedTraits<FragT>;
+
+        auto minLd = is_same<typename Traits::Layout, row_major>::value ? cols : rows;
+        if(ldm < minLd)
+        {
+            return hipErrorInvalidValue;
+        }
+
+        auto blocks = static_cast<uint64_t>(Traits::rowBlocks(rows)) * Traits::colBlocks(cols);
+        if(blocks == 0u)
+        {
+            return hipSuccess;
+        }
+
+        uint32_t waveSize = 0u;
+        auto     status   = detail::packedHostWaveSize(waveSize);
+        if(status != hipSuccess)
+        {
+            return status;
+        }
+
+        hipLaunchKernelGGL((repack_matrix_kernel<FragT>),
+                           dim3((blocks + PACKED_WAVE_COUNT - 1u) / PACKED_WAVE_COUNT),
+                           dim3(PACKED_WAVE_COUNT * waveSize),
+                           0, // sharedMemBytes
+                           stream,
+                           packed,
+                           data,
+                           rows,
+                           cols,
+                           ldm);
+        return hipGetLastError();
+    }
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_PACKED_API_IMPL_HPP
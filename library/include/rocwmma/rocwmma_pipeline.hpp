@@ -0,0 +1,562 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_PIPELINE_API_HPP
+#define ROCWMMA_PIPELINE_API_HPP
+
+#include "rocwmma.hpp"
+#include "rocwmma_coop.hpp"
+#include "rocwmma_tile.hpp"
+#include "rocwmma_transforms.hpp"
+
+//! rocWMMA pipeline API complements the rocWMMA API with multi-buffered LDS staging of
+//! the A and B inputs of a workgroup macro tile, as used in the K loop of GEMM-like kernels.
+//!
+//! \n
+//! **lds_pipeline**
+//!
+//! Owns a ring of Depth LDS stages. Each stage holds one BlockK step of the macro tile:
+//! the A macro tile (MacroM x BlockK) followed by the transposed B macro tile (MacroN x BlockK),
+//! stacked vertically with a width of BlockK in the LDS data layout, such that no padding is needed.
+//! Waves of the workgroup cooperatively read global A and B into registers and write them to
+//! the next write stage, and each wave then reads its own mma blocks from the read stage.
+//!
+//! The write stage leads the read stage by Depth - 1 steps. The prologue fills Depth - 1
+//! stages before the first read, and each K step then reads one stage and writes
+//! the stage Depth - 1 steps ahead.
+//!
+//! Double buffering (Depth = 2) requires the workgroup barrier between the local write
+//! of a step and the local read of the next:
+//!
+//!     for(step < prologue = Depth - 1) { global_read(); local_write(); }
+//!     synchronize_workgroup();
+//!     loop: local_read(); global_read(); mma; local_write(); synchronize_workgroup(); advance();
+//!
+//! With Depth >= 3 the stage written in a step is read at the earliest two steps later,
+//! so the barrier may move ahead of the mma and local write. The LDS writes of a step then
+//! overlap with the local reads of the next:
+//!
+//!     loop: local_read(); synchronize_workgroup(); global_read(); mma; local_write(); advance();
+//!
+//! In both cases, the workgroup must synchronize after the prologue. Every cooperating wave
+//! in [0, WaveCount) must make each global_read and local_write call.
+//!
+//! \n
+//! **lds_stage_barrier**
+//!
+//! Emulates a pair of named barriers per LDS stage with counters in LDS, for wave-specialized
+//! workgroups. ProducerCount waves stream global memory into the LDS stages, and ConsumerCount
+//! waves read the stages for mma. Producers and consumers only wait on each other per stage,
+//! instead of synchronizing the whole workgroup at every K step. Producers then never hold mma
+//! accumulators and consumers never hold global read buffers:
+//!
+//!     producer: loop: global_read(); producer_acquire(step); local_write(); producer_commit(step);
+//!     consumer: loop: consumer_wait(step); local_read(); consumer_release(step); mma; advance();
+//!
+//! Producers may run up to Depth steps ahead of the slowest consumer. An lds_pipeline with a
+//! WaveCount of ProducerCount stages the data, where consumers only use the local reads.
+//!
+//! Cooperative workgroups, where all W waves both write and read every stage, split the workgroup
+//! barrier of each K step with an lds_stage_barrier<Depth, W, W>. Each wave then only waits for
+//! the local writes of the stage it reads next, and for the local reads of the stage it
+//! overwrites, instead of every wave stalling on the slowest one at every step:
+//!
+//!     loop: consumer_wait(step); local_read(); consumer_release(step); global_read(); mma;
+//!           producer_acquire(step + 1); local_write(); producer_commit(step + 1);
+//!
+//! Arrivals release, and waits acquire, the prior memory accesses of the wave at workgroup scope.
+//!
+//! \n
+//! **fragment_pipeline**
+//!
+//! Register double buffering of the A and B fragments of a wave over the K loop. Two register
+//! sets alternate between steps: the local read of step + 1 is issued into one set before the
+//! mma of step consume the other, with a scheduling barrier in between such that the compiler
+//! cannot sink the reads below the mma. The local read latency then hides behind the mma:
+//!
+//!     fragment_pipeline<TileA, TileB> frags;
+//!     frags.run(kSteps,
+//!               [&](TileA& a, TileB& b, uint32_t step) { local reads of step; },
+//!               [&](TileA& a, TileB& b, uint32_t step) { mma_sync(acc, a, b, acc); ... });
+//!
+//! The loop is unrolled by 2 so that each set is a distinct group of registers, without moves.
+//! run<Unroll> unrolls Unroll such pairs per iteration. When the K size is a compile time
+//! constant, e.g. the head dimension of attention, run<Steps> flattens the whole loop without
+//! branches, and the step indices passed to the functors are constants:
+//!
+//!     frags.run<HeadDim / BlockK>(read, compute);
+//!
+//! With an lds_pipeline, the stage of step + 1 must be readable during step, which requires
+//! Depth >= 3 and the workgroup barrier after each local write:
+//!
+//!     read:    local_read(); advance();
+//!     compute: global_read(); mma; local_write(); synchronize_workgroup();
+//!
+//! \n
+//! **lds_stash**
+//!
+//! Explicit LDS spill slots of a wave, for fragments that do not fit the register budget,
+//! e.g. the accumulators of a macro tile past the register file size. Instead of compiler
+//! spills to scratch, a kernel time-multiplexes several accumulator sets through one set
+//! of registers:
+//!
+//!     lds_stash<AccTile, 2u> stash(ldsPtr, waveIndex);
+//!     mma over the first half of N into acc;  stash.stash(0u, acc);
+//!     mma over the second half of N into acc; stash.stash(1u, acc);
+//!     epilogue of acc; stash.restore(acc, 0u); epilogue of acc;
+//!
+//! A slot holds the StorageT of a fragment, or of each block of a fragment_array, in register
+//! order without any data layout transform. Registers are split into chunks of up to 16B that
+//! are interleaved across the lanes of the wave, such that each chunk is one ds_write_b128 /
+//! ds_read_b128 over a contiguous range of LDS, without bank conflicts:
+//!
+//!     byte offset of chunk c of lane l = (c * WaveSize + l) * ChunkBytes
+//!
+//! Each lane only reads back its own data, so a restore needs no barrier after the stash.
+//! Slots of different waves are disjoint.
+//!
+//! \n
+//! **lds_channel**
+//!
+//! Hands fragments from one wave to other waves of the workgroup, e.g. the operands of a
+//! wave-specialized producer, or the partial accumulators of waves splitting K. A channel is a
+//! ring of Depth slots in the register order of lds_stash, synchronized by an
+//! lds_stage_barrier<Depth, 1, ReceiverCount>. Messages are numbered from 0 by seq:
+//!
+//!     lds_channel<AccTile> channel(ldsPtr);
+//!     sender:   send_fragment(channel, acc, seq);
+//!     receiver: recv_fragment(other, channel, seq);
+//!
+//! The sender of seq waits until every receiver has released the slot of seq - Depth, then
+//! writes and commits the slot. Each receiver waits for the commit of seq, then reads and
+//! releases the slot. Only the bytes of the fragment move through LDS, without conflicts, and
+//! only the sender and receivers wait on each other. Channels of disjoint LDS ranges are
+//! independent.
+//!
+//! \n
+//! **lds_reduction**
+//!
+//! Tree reduction of a fragment over the waves of a workgroup through lds_channels. At stride
+//! 2^r, each wave with bit r of its index set sends to the wave 2^r below and leaves, and the
+//! remaining waves combine the fragment of the wave 2^r above. Each wave but wave 0 sends once,
+//! so WaveCount - 1 fragments move through LDS in log2(WaveCount) rounds:
+//!
+//!     lds_reduction<AccTile, WaveCount> reduction(ldsPtr, waveIndex);
+//!     reduction.reduce(acc, seq);
+//!     if(waveIndex == 0u) { epilogue of acc; }
+//!
+//! Wave 0 holds the result. The fragments of other waves hold partial results.
+
+namespace rocwmma
+{
+    // @cond
+    namespace detail
+    {
+        template <typename GlobalFragA, typename GlobalFragB, typename DataLayoutLds>
+        struct LdsPipelineTraits;
+
+        template <typename FragT, uint32_t WaveSize>
+        struct LdsStashTraits;
+
+    } // namespace detail
+    // @endcond
+
+    //! @class lds_pipeline
+    //! @brief Multi-buffered LDS staging of the A and B macro tiles of a workgroup
+    //! @tparam Depth Number of LDS stages, at least 2
+    //! @tparam WaveCount Number of waves cooperating in the global reads and local writes
+    //! @tparam GlobalFragA matrix_a fragment of the A macro tile (MacroM x BlockK)
+    //! @tparam GlobalFragB matrix_b fragment of the B macro tile (BlockK x MacroN)
+    //! @tparam DataLayoutLds LDS data layout as col_major or row_major
+    //! @tparam AccessPolicyT LDS access policy as lds_access or xor_swizzle
+    template <uint32_t Depth,
+              uint32_t WaveCount,
+              typename GlobalFragA,
+              typename GlobalFragB,
+              typename DataLayoutLds = col_major,
+              typename AccessPolicyT = lds_access>
+    class lds_pipeline
+    {
+        using Traits = detail::LdsPipelineTraits<GlobalFragA, GlobalFragB, DataLayoutLds>;
+
+        static_assert(Depth >= 2u, "LDS pipelines require at least 2 stages");
+
+    public:
+        using DataT = typename Traits::DataT;
+
+        //! Number of LDS stages
+        constexpr static uint32_t depth = Depth;
+
+        //! Leading dimension of each LDS stage
+        constexpr static uint32_t ld = Traits::Ld;
+
+        //! Elements of each LDS stage
+        constexpr static uint32_t stage_size = Traits::StageSize;
+
+        //! LDS bytes required for all stages, e.g. for the dynamic shared memory launch size
+        constexpr static uint32_t size_bytes = Depth * stage_size * sizeof(DataT);
+
+        //! Binds the pipeline to its LDS allocation. Read and write stages start at stage 0.
+        //! @param ldsBase LDS pointer to at least size_bytes, identical across the workgroup
+        //! @param waveIndex Index assignment of current wave in collaboration
+        ROCWMMA_DEVICE inline lds_pipeline(DataT* ldsBase, uint32_t waveIndex);
+
+        //! Cooperatively reads the next A and B macro tiles from global memory into registers
+        //! @param a Global pointer to the A macro tile
+        //! @param lda Leading dimension of A
+        //! @param b Global pointer to the B macro tile
+        //! @param ldb Leading dimension of B
+        ROCWMMA_DEVICE inline void
+            global_read(DataT const* a, uint32_t lda, DataT const* b, uint32_t ldb);
+
+        //! Cooperatively writes the last global_read to the write stage, then advances the write stage
+        ROCWMMA_DEVICE inline void local_write();
+
+        //! Reads an A block of the read stage for mma
+        //! @param frag A fragment of the BlockM x BlockK block
+        //! @param row Row offset of the block in the A macro tile
+        template <uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename DataLayoutT>
+        ROCWMMA_DEVICE inline void
+            local_read_a(fragment<matrix_a, BlockM, BlockN, BlockK, DataT, DataLayoutT>& frag,
+                         uint32_t                                                        row) const;
+
+        //! Reads consecutive A blocks of the read stage for mma
+        //! @param frags A fragments of the BlockCount x BlockM rows starting at row
+        //! @param row Row offset of the first block in the A macro tile
+        template <uint32_t BlockCount,
+                  uint32_t BlockM,
+                  uint32_t BlockN,
+                  uint32_t BlockK,
+                  typename DataLayoutT>
+        ROCWMMA_DEVICE inline void local_read_a(
+            fragment<matrix_a, BlockM, BlockN, BlockK, DataT, DataLayoutT> (&frags)[BlockCount],
+            uint32_t row) const;
+
+        //! Reads the A blocks of a fragment array from the read stage for mma
+        //! @param frags BlockCount x 1 A fragment array of the rows starting at row
+        //! @param row Row offset of the first block in the A macro tile
+        template <uint32_t BlockCount, typename FragA>
+        ROCWMMA_DEVICE inline void local_read_a(fragment_array<FragA, BlockCount, 1u>& frags,
+                                                uint32_t                               row) const;
+
+        //! Reads a B block of the read stage for mma
+        //! @param frag B fragment of the BlockK x BlockN block
+        //! @param col Column offset of the block in the B macro tile
+        template <uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename DataLayoutT>
+        ROCWMMA_DEVICE inline void
+            local_read_b(fragment<matrix_b, BlockM, BlockN, BlockK, DataT, DataLayoutT>& frag,
+                         uint32_t                                                        col) const;
+
+        //! Reads consecutive B blocks of the read stage for mma
+        //! @param frags B fragments of the BlockCount x BlockN columns starting at col
+        //! @param col Column offset of the first block in the B macro tile
+        template <uint32_t BlockCount,
+                  uint32_t BlockM,
+                  uint32_t BlockN,
+                  uint32_t BlockK,
+                  typename DataLayoutT>
+        ROCWMMA_DEVICE inline void local_read_b(
+            fragment<matrix_b, BlockM, BlockN, BlockK, DataT, DataLayoutT> (&frags)[BlockCount],
+            uint32_t col) const;
+
+        //! Reads the B blocks of a fragment array from the read stage for mma
+        //! @param frags 1 x BlockCount B fragment array of the columns starting at col
+        //! @param col Column offset of the first block in the B macro tile
+        template <uint32_t BlockCount, typename FragB>
+        ROCWMMA_DEVICE inline void local_read_b(fragment_array<FragB, 1u, BlockCount>& frags,
+                                                uint32_t                               col) const;
+
+        //! Advances the read stage to the next K step
+        ROCWMMA_DEVICE inline void advance();
+
+    private:
+        GlobalFragA mBuffA;
+        GlobalFragB mBuffB;
+        DataT*      mLds;
+        uint32_t    mWaveIndex;
+        uint32_t    mReadStage;
+        uint32_t    mWriteStage;
+    };
+
+    //! @class lds_stage_barrier
+    //! @brief Per-stage producer / consumer synchronization of a Depth stage LDS ring
+    //! @note Orders the LDS accesses of the waves only, not global memory
+    //! @tparam Depth Number of LDS stages
+    //! @tparam ProducerCount Number of waves that write each stage
+    //! @tparam ConsumerCount Number of waves that read each stage
+    template <uint32_t Depth, uint32_t ProducerCount, uint32_t ConsumerCount>
+    class lds_stage_barrier
+    {
+        static_assert(Depth >= 1u, "Stage barriers require at least 1 stage");
+        static_assert(ProducerCount > 0u && ConsumerCount > 0u,
+                      "Stage barriers require producers and consumers");
+
+    public:
+        //! Number of LDS stages
+        constexpr static uint32_t depth = Depth;
+
+        //! LDS bytes required for the stage counters
+        constexpr static uint32_t size_bytes = 2u * Depth * sizeof(uint32_t);
+
+        //! Binds the barrier to its LDS counters
+        //! @param ldsFlags LDS pointer to at least size_bytes, identical across the workgroup
+        ROCWMMA_DEVICE inline lds_stage_barrier(uint32_t* ldsFlags);
+
+        //! Zeroes the stage counters. Called by a single wave, followed by synchronize_workgroup
+        //! before first use.
+        ROCWMMA_DEVICE inline void reset() const;
+
+        //! Producer wave: waits until all consumers have released the stage of step
+        //! @param step K step index, starting at 0
+        ROCWMMA_DEVICE inline void producer_acquire(uint32_t step) const;
+
+        //! Producer wave: publishes the local writes of step to consumers
+        //! @param step K step index, starting at 0
+        ROCWMMA_DEVICE inline void producer_commit(uint32_t step) const;
+
+        //! Consumer wave: waits until all producers have committed step
+        //! @param step K step index, starting at 0
+        ROCWMMA_DEVICE inline void consumer_wait(uint32_t step) const;
+
+        //! Consumer wave: completes the local reads of step and releases its stage to producers
+        //! @param step K step index, starting at 0
+        ROCWMMA_DEVICE inline void consumer_release(uint32_t step) const;
+
+    private:
+        uint32_t* mFull;
+        uint32_t* mEmpty;
+    };
+
+    //! @class fragment_pipeline
+    //! @brief Register double buffering of the A and B fragments of a wave over the K loop
+    //! @tparam FragsA matrix_a fragment or fragment_array of each step
+    //! @tparam FragsB matrix_b fragment or fragment_array of each step
+    template <typename FragsA, typename FragsB>
+    class fragment_pipeline
+    {
+    public:
+        //! Runs the K loop, reading the fragments of each step one step ahead of their use
+        //! @param steps Number of K steps
+        //! @param read Functor read(FragsA&, FragsB&, uint32_t step) reading the fragments of
+        //! step, called in order of step
+        //! @param compute Functor compute(FragsA&, FragsB&, uint32_t step) consuming the
+        //! fragments of step, called in order of step after the read of step + 1 is issued
+        //! @tparam Unroll Number of step pairs per loop iteration
+        template <uint32_t Unroll = 1u, typename ReadFuncT, typename ComputeFuncT>
+        ROCWMMA_DEVICE inline void run(uint32_t steps, ReadFuncT&& read, ComputeFuncT&& compute);
+
+        //! Runs the K loop of a compile time number of steps, fully unrolled
+        //! @param read Functor read(FragsA&, FragsB&, uint32_t step), as for run(steps, ...)
+        //! @param compute Functor compute(FragsA&, FragsB&, uint32_t step), as for run(steps, ...)
+        //! @tparam Steps Number of K steps
+        template <uint32_t Steps, typename ReadFuncT, typename ComputeFuncT>
+        ROCWMMA_DEVICE inline void run(ReadFuncT&& read, ComputeFuncT&& compute);
+
+    private:
+        template <uint32_t Set, bool ReadNext, typename ReadFuncT, typename ComputeFuncT>
+        ROCWMMA_DEVICE inline void kStep(uint32_t step, ReadFuncT& read, ComputeFuncT& compute);
+
+        template <uint32_t Step, uint32_t Steps, typename ReadFuncT, typename ComputeFuncT>
+        ROCWMMA_DEVICE inline void kSteps(ReadFuncT& read, ComputeFuncT& compute);
+
+        FragsA mFragsA[2];
+        FragsB mFragsB[2];
+    };
+
+    //! Writes the registers of a fragment to an LDS slot of the wave, in register order
+    //! @param ldsSlot LDS pointer to the slot, 16B aligned and identical across the wave
+    //! @param frag fragment or fragment_array to stash
+    //! @tparam WaveSize Number of lanes of the wave
+    template <uint32_t WaveSize = Constants::AMDGCN_WAVE_SIZE, typename FragT>
+    ROCWMMA_DEVICE inline void stash_fragment(void* ldsSlot, FragT const& frag);
+
+    //! Reads the registers of a fragment back from an LDS slot written by stash_fragment
+    //! @param frag fragment or fragment_array to restore
+    //! @param ldsSlot LDS pointer to the slot, 16B aligned and identical across the wave
+    //! @tparam WaveSize Number of lanes of the wave
+    template <uint32_t WaveSize = Constants::AMDGCN_WAVE_SIZE, typename FragT>
+    ROCWMMA_DEVICE inline void restore_fragment(FragT& frag, void const* ldsSlot);
+
+    //! @class lds_stash
+    //! @brief SlotCount LDS spill slots of a fragment per wave
+    //! @tparam FragT fragment or fragment_array held by each slot
+    //! @tparam SlotCount Number of slots of each wave
+    //! @tparam WaveSize Number of lanes of the wave
+    template <typename FragT,
+              uint32_t SlotCount = 1u,
+              uint32_t WaveSize  = Constants::AMDGCN_WAVE_SIZE>
+    class lds_stash
+    {
+        using Traits = detail::LdsStashTraits<FragT, WaveSize>;
+
+        static_assert(SlotCount > 0u, "LDS stashes require at least 1 slot");
+
+    public:
+        //! Number of slots of each wave
+        constexpr static uint32_t slot_count = SlotCount;
+
+        //! LDS bytes of each slot
+        constexpr static uint32_t slot_bytes = Traits::SlotBytes;
+
+        //! LDS bytes of the slots of one wave. A workgroup of W waves requires W * size_bytes.
+        constexpr static uint32_t size_bytes = SlotCount * slot_bytes;
+
+        //! Binds the stash to the slots of the current wave
+        //! @param ldsBase LDS pointer to the stashes of all waves, 16B aligned
+        //! @param waveIndex Index of the current wave, selecting its size_bytes range
+        ROCWMMA_DEVICE inline lds_stash(void* ldsBase, uint32_t waveIndex);
+
+        //! Writes frag to slot
+        ROCWMMA_DEVICE inline void stash(uint32_t slot, FragT const& frag) const;
+
+        //! Reads frag back from slot
+        ROCWMMA_DEVICE inline void restore(FragT& frag, uint32_t slot) const;
+
+    private:
+        char* mLds;
+    };
+
+    //! @class lds_channel
+    //! @brief Ring of Depth LDS slots handing a fragment from one sender wave to receiver waves
+    //! @note Orders the LDS accesses of the waves only, not global memory
+    //! @tparam FragT fragment or fragment_array of each message
+    //! @tparam Depth Number of slots, the messages the sender may run ahead of the receivers
+    //! @tparam ReceiverCount Number of waves that receive each message
+    //! @tparam WaveSize Number of lanes of the wave
+    template <typename FragT,
+              uint32_t Depth         = 1u,
+              uint32_t ReceiverCount = 1u,
+              uint32_t WaveSize      = Constants::AMDGCN_WAVE_SIZE>
+    class lds_channel
+    {
+        using Traits  = detail::LdsStashTraits<FragT, WaveSize>;
+        using Barrier = lds_stage_barrier<Depth, 1u, ReceiverCount>;
+
+    public:
+        //! Number of slots
+        constexpr static uint32_t depth = Depth;
+
+        //! LDS bytes of each slot
+        constexpr static uint32_t slot_bytes = Traits::SlotBytes;
+
+        //! LDS bytes of the slots and counters, rounded up to 16B such that channels may be
+        //! packed back to back
+        constexpr static uint32_t size_bytes
+            = (Depth * slot_bytes + Barrier::size_bytes + 15u) / 16u * 16u;
+
+        //! Binds the channel to its LDS range
+        //! @param ldsBase LDS pointer to at least size_bytes, 16B aligned and identical across the
+        //! workgroup
+        ROCWMMA_DEVICE inline lds_channel(void* ldsBase);
+
+        //! Zeroes the counters. Called by a single wave, followed by synchronize_workgroup
+        //! before first use.
+        ROCWMMA_DEVICE inline void reset() const;
+
+        //! Sender wave: waits for a free slot, then writes frag as message seq
+        //! @param frag fragment to send
+        //! @param seq Message index, starting at 0
+        ROCWMMA_DEVICE inline void send(FragT const& frag, uint32_t seq) const;
+
+        //! Receiver wave: waits for message seq, then reads it to frag and releases its slot
+        //! @param frag fragment to receive
+        //! @param seq Message index, starting at 0
+        ROCWMMA_DEVICE inline void recv(FragT& frag, uint32_t seq) const;
+
+    private:
+        char*   mLds;
+        Barrier mBarrier;
+    };
+
+    //! Sends a fragment as message seq of a channel
+    //! @param channel Channel of the sender wave
+    //! @param frag fragment or fragment_array to send
+    //! @param seq Message index, starting at 0
+    template <typename FragT, uint32_t Depth, uint32_t ReceiverCount, uint32_t WaveSize>
+    ROCWMMA_DEVICE inline void
+        send_fragment(lds_channel<FragT, Depth, ReceiverCount, WaveSize> const& channel,
+                      FragT const&                                             frag,
+                      uint32_t                                                 seq);
+
+    //! Receives message seq of a channel into a fragment
+    //! @param frag fragment or fragment_array to receive
+    //! @param channel Channel of the receiver wave
+    //! @param seq Message index, starting at 0
+    template <typename FragT, uint32_t Depth, uint32_t ReceiverCount, uint32_t WaveSize>
+    ROCWMMA_DEVICE inline void
+        recv_fragment(FragT&                                                   frag,
+                      lds_channel<FragT, Depth, ReceiverCount, WaveSize> const& channel,
+                      uint32_t                                                 seq);
+
+    //! @class lds_reduction
+    //! @brief Tree reduction of a fragment over the waves of a workgroup, into wave 0
+    //! @note Orders the LDS accesses of the waves only, not global memory
+    //! @tparam FragT fragment or fragment_array to reduce
+    //! @tparam WaveCount Number of waves taking part in each reduction
+    //! @tparam WaveSize Number of lanes of the wave
+    template <typename FragT,
+              uint32_t WaveCount,
+              uint32_t WaveSize = Constants::AMDGCN_WAVE_SIZE>
+    class lds_reduction
+    {
+        using Channel = lds_channel<FragT, 1u, 1u, WaveSize>;
+
+        static_assert(WaveCount > 0u, "LDS reductions require at least 1 wave");
+
+    public:
+        //! Number of waves taking part in each reduction
+        constexpr static uint32_t wave_count = WaveCount;
+
+        //! LDS bytes of the channels of all waves but wave 0
+        constexpr static uint32_t size_bytes = (WaveCount - 1u) * Channel::size_bytes;
+
+        //! Binds the reduction to its LDS range
+        //! @param ldsBase LDS pointer to at least size_bytes, 16B aligned and identical across the
+        //! workgroup
+        //! @param waveIndex Index of the current wave in [0, WaveCount)
+        ROCWMMA_DEVICE inline lds_reduction(void* ldsBase, uint32_t waveIndex);
+
+        //! Zeroes the counters. Called by a single wave, followed by synchronize_workgroup
+        //! before first use.
+        ROCWMMA_DEVICE inline void reset() const;
+
+        //! Reduces frag over all waves into wave 0. Every wave in [0, WaveCount) must call
+        //! each reduction.
+        //! @param frag fragment of the wave, holding the result on wave 0
+        //! @param seq Reduction index, starting at 0
+        //! @tparam ReduceOp Elementwise operation as reduce::Sum, reduce::Max or reduce::Min
+        template <typename ReduceOp = reduce::Sum>
+        ROCWMMA_DEVICE inline void reduce(FragT& frag, uint32_t seq) const;
+
+    private:
+        char*    mLds;
+        uint32_t mWaveIndex;
+    };
+
+} // namespace rocwmma
+
+#include "rocwmma_pipeline_impl.hpp"
+
+#endif // ROCWMMA_PIPELINE_API_HPP
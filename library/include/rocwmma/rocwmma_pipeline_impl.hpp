@@ -0,0 +1,681 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_PIPELINE_API_IMPL_HPP
+#define ROCWMMA_PIPELINE_API_IMPL_HPP
+
+#include "internal/register_order_io.hpp"
+#include "rocwmma_pipeline.hpp"
+
+namespace rocwmma
+{
+    // @cond
+    namespace detail
+    {
+        template <uint32_t MacroM,
+                  uint32_t BlockNA,
+                  uint32_t BlockMB,
+                  uint32_t MacroN,
+                  uint32_t BlockK,
+                  typename DataT_,
+                  typename DataLayoutA,
+                  typename DataLayoutB,
+                  typename DataLayoutLds>
+        struct LdsPipelineTraits<fragment<matrix_a, MacroM, BlockNA, BlockK, DataT_, DataLayoutA>,
+                                 fragment<matrix_b, BlockMB, MacroN, BlockK, DataT_, DataLayoutB>,
+                                 DataLayoutLds>
+        {
+            using DataT = DataT_;
+
+            // Local write of global buffers, in the LDS data layout. B is transposed.
+            using LWBuffA
+                = ApplyDataLayout_t<fragment<matrix_a, MacroM, BlockNA, BlockK, DataT, DataLayoutA>,
+                                    DataLayoutLds>;
+            using LWBuffB = ApplyDataLayout_t<
+                ApplyTranspose_t<fragment<matrix_b, BlockMB, MacroN, BlockK, DataT, DataLayoutB>>,
+                DataLayoutLds>;
+
+            // The stage width is BlockK, the height stacks the A and B macro tiles
+            constexpr static uint32_t StageWidth  = BlockK;
+            constexpr static uint32_t StageHeight = MacroM + MacroN;
+            constexpr static uint32_t StageSize   = StageWidth * StageHeight;
+            constexpr static uint32_t Ld
+                = std::is_same_v<DataLayoutLds, row_major> ? StageWidth : StageHeight;
+            constexpr static uint32_t RowB = MacroM;
+        };
+
+        template <typename MatrixT,
+                  uint32_t BlockM,
+                  uint32_t BlockN,
+                  uint32_t BlockK,
+                  typename DataT,
+                  typename DataLayoutT,
+                  uint32_t WaveSize>
+        struct LdsStashTraits<fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>,
+                              WaveSize>
+        {
+            using FragT = fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>;
+            using Block = RegisterOrderIO<typename FragT::Traits::StorageT, WaveSize, lds_access>;
+
+            constexpr static uint32_t SlotBytes = Block::BlockBytes;
+
+            ROCWMMA_DEVICE static inline void store(char* ldsSlot, FragT const& frag)
+            {
+                Block::store(ldsSlot, *frag);
+            }
+
+            ROCWMMA_DEVICE static inline void load(FragT& frag, char const* ldsSlot)
+            {
+                Block::load(*frag, ldsSlot);
+            }
+
+            // Elementwise combine of two fragments of the same register order
+            template <typename ReduceOp>
+            ROCWMMA_DEVICE static inline void combine(FragT& frag, FragT const& other)
+            {
+#pragma unroll
+                for(uint32_t i = 0; i < FragT::num_elements; i++)
+                {
+                    frag.x[i] = ReduceOp::exec(frag.x[i], other.x[i]);
+                }
+            }
+        };
+
+        // Blocks of a fragment array follow each other in row order
+        template <typename FragT, uint32_t BlocksX, uint32_t BlocksY, uint32_t WaveSize>
+        struct LdsStashTraits<fragment_array<FragT, BlocksX, BlocksY>, WaveSize>
+        {
+            using Base = LdsStashTraits<FragT, WaveSize>;
+
+            constexpr static uint32_t SlotBytes = BlocksX * BlocksY * Base::SlotBytes;
+
+            ROCWMMA_DEVICE static inline void
+                store(char* ldsSlot, fragment_array<FragT, BlocksX, BlocksY> const& frags)
+            {
+#pragma unroll
+                for(uint32_t i = 0; i < BlocksX; i++)
+                {
+#pragma unroll
+                    for(uint32_t j = 0; j < BlocksY; j++)
+                    {
+                        Base::store(ldsSlot + (i * BlocksY + j) * Base::SlotBytes, frags(i, j));
+                    }
+                }
+            }
+
+            ROCWMMA_DEVICE static inline void
+                load(fragment_array<FragT, BlocksX, BlocksY>& frags, char const* ldsSlot)
+            {
+#pragma unroll
+                for(uint32_t i = 0; i < BlocksX; i++)
+                {
+#pragma unroll
+                    for(uint32_t j = 0; j < BlocksY; j++)
+                    {
+                        Base::load(frags(i, j), ldsSlot + (i * BlocksY + j) * Base::SlotBytes);
+                    }
+                }
+            }
+
+            template <typename ReduceOp>
+            ROCWMMA_DEVICE static inline void
+                combine(fragment_array<FragT, BlocksX, BlocksY>&       frags,
+                        fragment_array<FragT, BlocksX, BlocksY> const& others)
+            {
+#pragma unroll
+                for(uint32_t i = 0; i < BlocksX; i++)
+                {
+#pragma unroll
+                    for(uint32_t j = 0; j < BlocksY; j++)
+                    {
+                        Base::template combine<ReduceOp>(frags(i, j), others(i, j));
+                    }
+                }
+            }
+        };
+
+    } // namespace detail
+    // @endcond
+
+    template <uint32_t Depth,
+              uint32_t WaveCount,
+              typename GlobalFragA,
+              typename GlobalFragB,
+              typename DataLayoutLds,
+              typename AccessPolicyT>
+    ROCWMMA_DEVICE inline lds_pipeline<Depth,
+                                       WaveCount,
+                                       GlobalFragA,
+                                       GlobalFragB,
+                                       DataLayoutLds,
+                                       AccessPolicyT>::lds_pipeline(DataT*   ldsBase,
+                                                                    uint32_t waveIndex)
+        : mLds(ldsBase)
+        , mWaveIndex(waveIndex)
+        , mReadStage(0u)
+        , mWriteStage(0u)
+    {
+    }
+
+    template <uint32_t Depth,
+              uint32_t WaveCount,
+              typename GlobalFragA,
+              typename GlobalFragB,
+              typename DataLayoutLds,
+              typename AccessPolicyT>
+    ROCWMMA_DEVICE inline void
+        lds_pipeline<Depth, WaveCount, GlobalFragA, GlobalFragB, DataLayoutLds, AccessPolicyT>::
+            global_read(DataT const* a, uint32_t lda, DataT const* b, uint32_t ldb)
+    {
+        load_matrix_coop_sync<WaveCount>(mBuffA, a, lda, mWaveIndex);
+        load_matrix_coop_sync<WaveCount>(mBuffB, b, ldb, mWaveIndex);
+    }
+
+    template <uint32_t Depth,
+              uint32_t WaveCount,
+              typename GlobalFragA,
+              typename GlobalFragB,
+              typename DataLayoutLds,
+              typename AccessPolicyT>
+    ROCWMMA_DEVICE inline void
+        lds_pipeline<Depth, WaveCount, GlobalFragA, GlobalFragB, DataLayoutLds, AccessPolicyT>::
+            local_write()
+    {
+        using LWBuffAMap1d = GetDataLayout_t<typename Traits::LWBuffA>;
+
+        auto* ldsStage = mLds + mWriteStage * stage_size;
+        auto  offsetB  = LWBuffAMap1d::fromMatrixCoord(make_coord2d(Traits::RowB, 0u), ld);
+
+        // No transpose for A, but apply the lds data layout
+        store_matrix_coop_sync<AccessPolicyT, WaveCount>(
+            ldsStage, applyDataLayout<DataLayoutLds, WaveCount>(mBuffA), ld, mWaveIndex);
+
+        // Transpose B and then apply the lds data layout
+        store_matrix_coop_sync<AccessPolicyT, WaveCount>(
+            ldsStage + offsetB,
+            applyDataLayout<DataLayoutLds, WaveCount>(applyTranspose(mBuffB)),
+            ld,
+            mWaveIndex);
+
+        mWriteStage = (mWriteStage + 1u == Depth) ? 0u : mWriteStage + 1u;
+    }
+
+    template <uint32_t Depth,
+              uint32_t WaveCount,
+              typename GlobalFragA,
+              typename GlobalFragB,
+              typename DataLayoutLds,
+              typename AccessPolicyT>
+    template <uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename DataLayoutT>
+    ROCWMMA_DEVICE inline void
+        lds_pipeline<Depth, WaveCount, GlobalFragA, GlobalFragB, DataLayoutLds, AccessPolicyT>::
+            local_read_a(fragment<matrix_a, BlockM, BlockN, BlockK, DataT, DataLayoutT>& frag,
+                         uint32_t row) const
+    {
+        using LRFragA  = ApplyDataLayout_t<std::decay_t<decltype(frag)>, DataLayoutLds>;
+        using Mapper1d = GetDataLayout_t<LRFragA>;
+
+        LRFragA tmp;
+        load_matrix_sync<AccessPolicyT>(
+            tmp,
+            mLds + mReadStage * stage_size + Mapper1d::fromMatrixCoord(make_coord2d(row, 0u), ld),
+            ld);
+        frag = applyDataLayout<DataLayoutT>(tmp);
+    }
+
+    template <uint32_t Depth,
+              uint32_t WaveCount,
+              typename GlobalFragA,
+              typename GlobalFragB,
+              typename DataLayoutLds,
+              typename AccessPolicyT>
+    template <uint32_t BlockCount,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE inline void
+        lds_pipeline<Depth, WaveCount, GlobalFragA, GlobalFragB, DataLayoutLds, AccessPolicyT>::
+            local_read_a(
+                fragment<matrix_a, BlockM, BlockN, BlockK, DataT, DataLayoutT> (&frags)[BlockCount],
+                uint32_t row) const
+    {
+        // Each A block is stacked vertically in LDS
+#pragma unroll
+        for(uint32_t i = 0u; i < BlockCount; i++)
+        {
+            local_read_a(frags[i], row + i * BlockM);
+        }
+    }
+
+    template <uint32_t Depth,
+              uint32_t WaveCount,
+              typename GlobalFragA,
+              typename GlobalFragB,
+              typename DataLayoutLds,
+              typename AccessPolicyT>
+    template <uint32_t BlockCount, typename FragA>
+    ROCWMMA_DEVICE inline void
+        lds_pipeline<Depth, WaveCount, GlobalFragA, GlobalFragB, DataLayoutLds, AccessPolicyT>::
+            local_read_a(fragment_array<FragA, BlockCount, 1u>& frags, uint32_t row) const
+    {
+#pragma unroll
+        for(uint32_t i = 0u; i < BlockCount; i++)
+        {
+            local_read_a(frags(i, 0u), row + i * frags.block_height);
+        }
+    }
+
+    template <uint32_t Depth,
+              uint32_t WaveCount,
+              typename GlobalFragA,
+              typename GlobalFragB,
+              typename DataLayoutLds,
+              typename AccessPolicyT>
+    template <uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename DataLayoutT>
+    ROCWMMA_DEVICE inline void
+        lds_pipeline<Depth, WaveCount, GlobalFragA, GlobalFragB, DataLayoutLds, AccessPolicyT>::
+            local_read_b(fragment<matrix_b, BlockM, BlockN, BlockK, DataT, DataLayoutT>& frag,
+                         uint32_t col) const
+    {
+        using LRFragB
+            = ApplyDataLayout_t<ApplyTranspose_t<std::decay_t<decltype(frag)>>, DataLayoutLds>;
+        using Mapper1d = GetDataLayout_t<LRFragB>;
+
+        // B blocks are stored transposed, below the A macro tile
+        LRFragB tmp;
+        load_matrix_sync<AccessPolicyT>(
+            tmp,
+            mLds + mReadStage * stage_size
+                + Mapper1d::fromMatrixCoord(make_coord2d(Traits::RowB + col, 0u), ld),
+            ld);
+
+        // Transform back to the mma block
+        frag = applyDataLayout<DataLayoutT>(applyTranspose(tmp));
+    }
+
+    template <uint32_t Depth,
+              uint32_t WaveCount,
+              typename GlobalFragA,
+              typename GlobalFragB,
+              typename DataLayoutLds,
+              typename AccessPolicyT>
+    template <uint32_t BlockCount,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE inline void
+        lds_pipeline<Depth, WaveCount, GlobalFragA, GlobalFragB, DataLayoutLds, AccessPolicyT>::
+            local_read_b(
+                fragment<matrix_b, BlockM, BlockN, BlockK, DataT, DataLayoutT> (&frags)[BlockCount],
+                uint32_t col) const
+    {
+        // Each transposed B block is stacked vertically in LDS
+#pragma unroll
+        for(uint32_t i = 0u; i < BlockCount; i++)
+        {
+            local_read_b(frags[i], col + i * BlockN);
+        }
+    }
+
+    template <uint32_t Depth,
+              uint32_t WaveCount,
+              typename GlobalFragA,
+              typename GlobalFragB,
+              typename DataLayoutLds,
+              typename AccessPolicyT>
+    template <uint32_t BlockCount, typename FragB>
+    ROCWMMA_DEVICE inline void
+        lds_pipeline<Depth, WaveCount, GlobalFragA, GlobalFragB, DataLayoutLds, AccessPolicyT>::
+            local_read_b(fragment_array<FragB, 1u, BlockCount>& frags, uint32_t col) const
+    {
+#pragma unroll
+        for(uint32_t j = 0u; j < BlockCount; j++)
+        {
+            local_read_b(frags(0u, j), col + j * frags.block_width);
+        }
+    }
+
+    template <uint32_t Depth,
+              uint32_t WaveCount,
+              typename GlobalFragA,
+              typename GlobalFragB,
+              typename DataLayoutLds,
+              typename AccessPolicyT>
+    ROCWMMA_DEVICE inline void
+        lds_pipeline<Depth, WaveCount, GlobalFragA, GlobalFragB, DataLayoutLds, AccessPolicyT>::
+            advance()
+    {
+        mReadStage = (mReadStage + 1u == Depth) ? 0u : mReadStage + 1u;
+    }
+
+    // @cond
+    namespace detail
+    {
+        // Spins until the LDS counter reaches count. The acquire orders the following
+        // local reads / writes of the wave after those published by the arrivals.
+        ROCWMMA_DEVICE inline void ldsStageWait(uint32_t* counter, uint32_t count)
+        {
+            while(__hip_atomic_load(counter, __ATOMIC_RELAXED, __HIP_MEMORY_SCOPE_WORKGROUP)
+                  < count)
+            {
+                __builtin_amdgcn_s_sleep(1);
+            }
+            __builtin_amdgcn_fence(__ATOMIC_ACQUIRE, "workgroup");
+        }
+
+        // Completes all prior local reads / writes of the wave, then arrives once for the wave
+        ROCWMMA_DEVICE inline void ldsStageArrive(uint32_t* counter)
+        {
+            __builtin_amdgcn_fence(__ATOMIC_RELEASE, "workgroup");
+            if(laneId() == 0u)
+            {
+                __hip_atomic_fetch_add(counter, 1u, __ATOMIC_RELAXED, __HIP_MEMORY_SCOPE_WORKGROUP);
+            }
+        }
+
+    } // namespace detail
+    // @endcond
+
+    // Counters are monotonic: the n-th use of a stage is complete when its counter
+    // reaches n times the number of arriving waves.
+    template <uint32_t Depth, uint32_t ProducerCount, uint32_t ConsumerCount>
+    ROCWMMA_DEVICE inline lds_stage_barrier<Depth, ProducerCount, ConsumerCount>::lds_stage_barrier(
+        uint32_t* ldsFlags)
+        : mFull(ldsFlags)
+        , mEmpty(ldsFlags + Depth)
+    {
+    }
+
+    template <uint32_t Depth, uint32_t ProducerCount, uint32_t ConsumerCount>
+    ROCWMMA_DEVICE inline void lds_stage_barrier<Depth, ProducerCount, ConsumerCount>::reset() const
+    {
+        for(uint32_t i = detail::laneId(); i < 2u * Depth; i += Constants::AMDGCN_WAVE_SIZE)
+        {
+            mFull[i] = 0u;
+        }
+    }
+
+    template <uint32_t Depth, uint32_t ProducerCount, uint32_t ConsumerCount>
+    ROCWMMA_DEVICE inline void
+        lds_stage_barrier<Depth, ProducerCount, ConsumerCount>::producer_acquire(
+            uint32_t step) const
+    {
+        // The first use of each stage is free
+        detail::ldsStageWait(mEmpty + step % Depth, (step / Depth) * ConsumerCount);
+    }
+
+    template <uint32_t Depth, uint32_t ProducerCount, uint32_t ConsumerCount>
+    ROCWMMA_DEVICE inline void
+        lds_stage_barrier<Depth, ProducerCount, ConsumerCount>::producer_commit(
+            uint32_t step) const
+    {
+        detail::ldsStageArrive(mFull + step % Depth);
+    }
+
+    template <uint32_t Depth, uint32_t ProducerCount, uint32_t ConsumerCount>
+    ROCWMMA_DEVICE inline void
+        lds_stage_barrier<Depth, ProducerCount, ConsumerCount>::consumer_wait(uint32_t step) const
+    {
+        detail::ldsStageWait(mFull + step % Depth, (step / Depth + 1u) * ProducerCount);
+    }
+
+    template <uint32_t Depth, uint32_t ProducerCount, uint32_t ConsumerCount>
+    ROCWMMA_DEVICE inline void
+        lds_stage_barrier<Depth, ProducerCount, ConsumerCount>::consumer_release(
+            uint32_t step) const
+    {
+        detail::ldsStageArrive(mEmpty + step % Depth);
+    }
+
+    template <typename FragsA, typename FragsB>
+    template <uint32_t Unroll, typename ReadFuncT, typename ComputeFuncT>
+    ROCWMMA_DEVICE inline void fragment_pipeline<FragsA, FragsB>::run(uint32_t       steps,
+                                                                      ReadFuncT&&    read,
+                                                                      ComputeFuncT&& compute)
+    {
+        static_assert(Unroll > 0u, "Unroll must be at least 1");
+
+        if(steps == 0u)
+        {
+            return;
+        }
+
+        read(mFragsA[0], mFragsB[0], 0u);
+
+        // Pairs of steps that both read ahead. Sets alternate at compile time.
+        uint32_t k = 0u;
+        if constexpr(Unroll > 1u)
+        {
+            for(; k + 2u * Unroll < steps; k += 2u * Unroll)
+            {
+#pragma unroll
+                for(uint32_t u = 0u; u < Unroll; u++)
+                {
+                    kStep<0u, true>(k + 2u * u, read, compute);
+                    kStep<1u, true>(k + 2u * u + 1u, read, compute);
+                }
+            }
+        }
+
+        // Remaining pairs, fewer than Unroll
+        for(; k + 2u < steps; k += 2u)
+        {
+            kStep<0u, true>(k, read, compute);
+            kStep<1u, true>(k + 1u, read, compute);
+        }
+
+        // Last one or two steps
+        if(k + 1u < steps)
+        {
+            kStep<0u, true>(k, read, compute);
+            kStep<1u, false>(k + 1u, read, compute);
+        }
+        else
+        {
+            kStep<0u, false>(k, read, compute);
+        }
+    }
+
+    template <typename FragsA, typename FragsB>
+    template <uint32_t Set, bool ReadNext, typename ReadFuncT, typename ComputeFuncT>
+    ROCWMMA_DEVICE inline void fragment_pipeline<FragsA, FragsB>::kStep(uint32_t      step,
+                                                                       ReadFuncT&    read,
+                                                                       ComputeFuncT& compute)
+    {
+        if constexpr(ReadNext)
+        {
+            read(mFragsA[1u - Set], mFragsB[1u - Set], step + 1u);
+        }
+
+        // Keep the reads of the next step ahead of the mma of this step
+        SchedBarrier<SchedMask::None>::exec();
+
+        compute(mFragsA[Set], mFragsB[Set], step);
+    }
+
+    template <typename FragsA, typename FragsB>
+    template <uint32_t Steps, typename ReadFuncT, typename ComputeFuncT>
+    ROCWMMA_DEVICE inline void fragment_pipeline<FragsA, FragsB>::run(ReadFuncT&&    read,
+                                                                      ComputeFuncT&& compute)
+    {
+        if constexpr(Steps > 0u)
+        {
+            read(mFragsA[0], mFragsB[0], 0u);
+            kSteps<0u, Steps>(read, compute);
+        }
+    }
+
+    template <typename FragsA, typename FragsB>
+    template <uint32_t Step, uint32_t Steps, typename ReadFuncT, typename ComputeFuncT>
+    ROCWMMA_DEVICE inline void fragment_pipeline<FragsA, FragsB>::kSteps(ReadFuncT&    read,
+                                                                        ComputeFuncT& compute)
+    {
+        // Every step reads ahead but the last
+        kStep<Step % 2u, (Step + 1u < Steps)>(Step, read, compute);
+
+        if constexpr(Step + 1u < Steps)
+        {
+            kSteps<Step + 1u, Steps>(read, compute);
+        }
+    }
+
+    template <uint32_t WaveSize, typename FragT>
+    ROCWMMA_DEVICE inline void stash_fragment(void* ldsSlot, FragT const& frag)
+    {
+        detail::LdsStashTraits<FragT, WaveSize>::store(reinterpret_cast<char*>(ldsSlot), frag);
+    }
+
+    template <uint32_t WaveSize, typename FragT>
+    ROCWMMA_DEVICE inline void restore_fragment(FragT& frag, void const* ldsSlot)
+    {
+        detail::LdsStashTraits<FragT, WaveSize>::load(frag,
+                                                      reinterpret_cast<char const*>(ldsSlot));
+    }
+
+    template <typename FragT, uint32_t SlotCount, uint32_t WaveSize>
+    ROCWMMA_DEVICE inline lds_stash<FragT, SlotCount, WaveSize>::lds_stash(void*    ldsBase,
+                                                                           uint32_t waveIndex)
+        : mLds(reinterpret_cast<char*>(ldsBase) + waveIndex * size_bytes)
+    {
+    }
+
+    template <typename FragT, uint32_t SlotCount, uint32_t WaveSize>
+    ROCWMMA_DEVICE inline void lds_stash<FragT, SlotCount, WaveSize>::stash(uint32_t     slot,
+                                                                            FragT const& frag) const
+    {
+        stash_fragment<WaveSize>(mLds + slot * slot_bytes, frag);
+    }
+
+    template <typename FragT, uint32_t SlotCount, uint32_t WaveSize>
+    ROCWMMA_DEVICE inline void lds_stash<FragT, SlotCount, WaveSize>::restore(FragT&   frag,
+                                                                              uint32_t slot) const
+    {
+        restore_fragment<WaveSize>(frag, mLds + slot * slot_bytes);
+    }
+
+    // Slots first, keeping their 16B alignment, then the stage counters
+    template <typename FragT, uint32_t Depth, uint32_t ReceiverCount, uint32_t WaveSize>
+    ROCWMMA_DEVICE inline lds_channel<FragT, Depth, ReceiverCount, WaveSize>::lds_channel(
+        void* ldsBase)
+        : mLds(reinterpret_cast<char*>(ldsBase))
+        , mBarrier(reinterpret_cast<uint32_t*>(mLds + Depth * slot_bytes))
+    {
+    }
+
+    template <typename FragT, uint32_t Depth, uint32_t ReceiverCount, uint32_t WaveSize>
+    ROCWMMA_DEVICE inline void lds_channel<FragT, Depth, ReceiverCount, WaveSize>::reset() const
+    {
+        mBarrier.reset();
+    }
+
+    template <typename FragT, uint32_t Depth, uint32_t ReceiverCount, uint32_t WaveSize>
+    ROCWMMA_DEVICE inline void
+        lds_channel<FragT, Depth, ReceiverCount, WaveSize>::send(FragT const& frag,
+                                                                 uint32_t     seq) const
+    {
+        mBarrier.producer_acquire(seq);
+        stash_fragment<WaveSize>(mLds + (seq % Depth) * slot_bytes, frag);
+        mBarrier.producer_commit(seq);
+    }
+
+    template <typename FragT, uint32_t Depth, uint32_t ReceiverCount, uint32_t WaveSize>
+    ROCWMMA_DEVICE inline void
+        lds_channel<FragT, Depth, ReceiverCount, WaveSize>::recv(FragT&   frag,
+                                                                 uint32_t seq) const
+    {
+        // The release waits on the local reads, so the slot is free once it is observed
+        mBarrier.consumer_wait(seq);
+        restore_fragment<WaveSize>(frag, mLds + (seq % Depth) * slot_bytes);
+        mBarrier.consumer_release(seq);
+    }
+
+    template <typename FragT, uint32_t Depth, uint32_t ReceiverCount, uint32_t WaveSize>
+    ROCWMMA_DEVICE inline void
+        send_fragment(lds_channel<FragT, Depth, ReceiverCount, WaveSize> const& channel,
+                      FragT const&                                             frag,
+                      uint32_t                                                 seq)
+    {
+        channel.send(frag, seq);
+    }
+
+    template <typename FragT, uint32_t Depth, uint32_t ReceiverCount, uint32_t WaveSize>
+    ROCWMMA_DEVICE inline void
+        recv_fragment(FragT&                                                   frag,
+                      lds_channel<FragT, Depth, ReceiverCount, WaveSize> const& channel,
+                      uint32_t                                                 seq)
+    {
+        channel.recv(frag, seq);
+    }
+
+    // Wave w > 0 sends on the channel w - 1
+    template <typename FragT, uint32_t WaveCount, uint32_t WaveSize>
+    ROCWMMA_DEVICE inline lds_reduction<FragT, WaveCount, WaveSize>::lds_reduction(
+        void* ldsBase, uint32_t waveIndex)
+        : mLds(reinterpret_cast<char*>(ldsBase))
+        , mWaveIndex(waveIndex)
+    {
+    }
+
+    template <typename FragT, uint32_t WaveCount, uint32_t WaveSize>
+    ROCWMMA_DEVICE inline void lds_reduction<FragT, WaveCount, WaveSize>::reset() const
+    {
+#pragma unroll
+        for(uint32_t w = 1u; w < WaveCount; w++)
+        {
+            Channel(mLds + (w - 1u) * Channel::size_bytes).reset();
+        }
+    }
+
+    template <typename FragT, uint32_t WaveCount, uint32_t WaveSize>
+    template <typename ReduceOp>
+    ROCWMMA_DEVICE inline void lds_reduction<FragT, WaveCount, WaveSize>::reduce(FragT&   frag,
+                                                                                 uint32_t seq) const
+    {
+        using Traits = detail::LdsStashTraits<FragT, WaveSize>;
+
+        // The wave index is uniform, so are the branches
+#pragma unroll
+        for(uint32_t stride = 1u; stride < WaveCount; stride *= 2u)
+        {
+            if(mWaveIndex & stride)
+            {
+                Channel(mLds + (mWaveIndex - 1u) * Channel::size_bytes).send(frag, seq);
+                return;
+            }
+
+            if(mWaveIndex + stride < WaveCount)
+            {
+                FragT other;
+                Channel(mLds + (mWaveIndex + stride - 1u) * Channel::size_bytes).recv(other, seq);
+                Traits::template combine<ReduceOp>(frag, other);
+            }
+        }
+    }
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_PIPELINE_API_IMPL_HPP
@@ -0,0 +1,170 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_PROFILE_API_HPP
+#define ROCWMMA_PROFILE_API_HPP
+
+#include "rocwmma.hpp"
+
+/**
+ * rocWMMA profile is an opt-in instrumentation API for rocWMMA, recording
+ * cycle stamps at pipeline phases inside kernels.
+ *
+ * Instrumentation is compiled out by default. Building with -DROCWMMA_PROFILE_STAMPS=1
+ * enables the device-side stamps, otherwise stamp_ring is an empty object and all of
+ * its calls compile to nothing.
+ *
+ * Each wave owns a ring buffer of stamp_record in device memory. A stamp records the
+ * shader clock (s_memtime on gfx9, s_sendmsg_rtn on gfx11+) and the constant rate
+ * real time clock (s_memrealtime) on entry to a phase. The time between a stamp and
+ * the next one from the same wave is attributed to the phase of the first.
+ *
+ * Usage:
+ *  - Host:   allocate a stamp_buffer with capacity records per wave and zeroed counts,
+ *            then bind it with set_stamp_buffer() before launching the kernel.
+ *  - Device: construct a stamp_ring, call stamp() on entry to each phase and flush()
+ *            before the kernel exits.
+ *  - Host:   copy the buffer back and summarize it with decode_stamps().
+ *
+ * Rings persist across launches: each launch appends to the ring of each wave, and only
+ * the latest capacity stamps are kept. On gfx9, reading the shader clock waits on
+ * outstanding LDS and scalar memory accesses, which should be considered when reading
+ * results at fine granularity.
+ *
+ * The buffer binding is a device symbol per translation unit, so set_stamp_buffer()
+ * must be called from the same translation unit that instantiates the kernel.
+ */
+
+#if !defined(ROCWMMA_PROFILE_STAMPS)
+#define ROCWMMA_PROFILE_STAMPS 0
+#endif
+
+namespace rocwmma
+{
+    namespace profile
+    {
+        //! @enum phase_t
+        //! @brief Pipeline phases of an instrumented kernel
+        enum phase_t : uint32_t
+        {
+            phase_global_read = 0u,
+            phase_local_write,
+            phase_local_read,
+            phase_mma,
+            phase_epilogue,
+            phase_end, // Wave exit, closes the last phase
+            phase_count
+        };
+
+        //! @struct stamp_record
+        //! @brief A single cycle stamp on entry to a phase
+        struct stamp_record
+        {
+            uint64_t cycles; // Shader clock
+            uint32_t realtime; // Low bits of the real time clock
+            uint32_t phase; // phase_t
+        };
+
+        //! @struct stamp_buffer
+        //! @brief Device memory for the per-wave stamp rings
+        //! @var records Ring storage, of capacity records for each of waveCount waves
+        //! @var counts Total stamps issued by each wave, zero initialized
+        struct stamp_buffer
+        {
+            stamp_record* records;
+            uint32_t*     counts;
+            uint32_t      capacity;
+            uint32_t      waveCount;
+        };
+
+        //! @struct phase_summary
+        //! @brief Stamps decoded on the host, accumulated per phase over all waves
+        struct phase_summary
+        {
+            uint64_t cycles[phase_count];
+            uint64_t realtime[phase_count];
+            uint64_t stamps[phase_count];
+            uint32_t waves;
+        };
+
+        //! @class stamp_ring
+        //! @brief The calling wave's view of the bound stamp buffer. Stamps are written by
+        //! the first lane of each wave. Waves beyond the buffer's waveCount do not record.
+        class stamp_ring
+        {
+        public:
+            //! Binds the calling wave to its ring in the buffer set by set_stamp_buffer()
+            ROCWMMA_DEVICE inline stamp_ring();
+
+            //! Records entry to the given phase
+            //! @param phase Phase that the wave is about to enter
+            ROCWMMA_DEVICE inline void stamp(phase_t phase);
+
+            //! Records the wave exit and publishes the stamp count
+            ROCWMMA_DEVICE inline void flush();
+
+#if ROCWMMA_PROFILE_STAMPS
+        private:
+            stamp_record* mRecords;
+            uint32_t*     mCount;
+            uint32_t      mCapacity;
+            uint32_t      mIndex;
+#endif // ROCWMMA_PROFILE_STAMPS
+        };
+
+        //! Binds the stamp buffer for kernels of the calling translation unit.
+        //! Has no effect unless ROCWMMA_PROFILE_STAMPS is enabled.
+        //! @param buffer Device buffer to bind
+        ROCWMMA_HOST static inline void set_stamp_buffer(stamp_buffer const& buffer);
+
+        //! Accumulates the stamps of every wave per phase. Gaps following phase_end
+        //! (between launches) are not counted.
+        //! @param records Host copy of the stamp records
+        //! @param counts Host copy of the per-wave stamp counts
+        //! @param capacity Ring capacity per wave
+        //! @param waveCount Number of wave rings in the buffer
+        ROCWMMA_HOST inline phase_summary decode_stamps(stamp_record const* records,
+                                                        uint32_t const*     counts,
+                                                        uint32_t            capacity,
+                                                        uint32_t            waveCount);
+
+        //! @returns Printable name of the phase
+        ROCWMMA_HOST inline const char* phase_name(phase_t phase);
+
+        //! Prints one line per phase with its stamp count, total cycles, average cycles
+        //! per stamp and share of the total cycles
+        //! @param stream Output stream
+        //! @param summary Decoded stamps
+        template <typename OStreamT>
+        ROCWMMA_HOST inline OStreamT& print_phase_summary(OStreamT&            stream,
+                                                          phase_summary const& summary);
+
+    } // namespace profile
+
+} // namespace rocwmma
+
+#include "rocwmma_profile_impl.hpp"
+
+#endif // ROCWMMA_PROFILE_API_HPP
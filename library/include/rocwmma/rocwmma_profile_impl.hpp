@@ -0,0 +1,193 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_PROFILE_API_IMPL_HPP
+#define ROCWMMA_PROFILE_API_IMPL_HPP
+
+#include "rocwmma_profile.hpp"
+
+namespace rocwmma
+{
+    namespace profile
+    {
+#if ROCWMMA_PROFILE_STAMPS
+        namespace detail
+        {
+            // Buffer binding, local to the translation unit
+            static __device__ stamp_buffer gStampBuffer;
+
+        } // namespace detail
+#endif // ROCWMMA_PROFILE_STAMPS
+
+        ROCWMMA_DEVICE inline stamp_ring::stamp_ring()
+        {
+#if ROCWMMA_PROFILE_STAMPS
+            constexpr uint32_t WaveSize = Constants::AMDGCN_WAVE_SIZE;
+
+            auto blockId    = blockIdx.x + gridDim.x * (blockIdx.y + gridDim.y * blockIdx.z);
+            auto threadId   = threadIdx.x + blockDim.x * (threadIdx.y + blockDim.y * threadIdx.z);
+            auto blockSize  = blockDim.x * blockDim.y * blockDim.z;
+            auto blockWaves = (blockSize + WaveSize - 1u) / WaveSize;
+            auto waveId     = blockId * blockWaves + threadId / WaveSize;
+
+            auto const& buffer = detail::gStampBuffer;
+
+            // Only the first lane of each wave records
+            bool const record = (buffer.records != nullptr) && (waveId < buffer.waveCount)
+                                && (threadId % WaveSize == 0u);
+
+            mRecords  = record ? buffer.records + waveId * buffer.capacity : nullptr;
+            mCount    = record ? buffer.counts + waveId : nullptr;
+            mCapacity = buffer.capacity;
+            mIndex    = record ? *mCount : 0u;
+#endif // ROCWMMA_PROFILE_STAMPS
+        }
+
+        ROCWMMA_DEVICE inline void stamp_ring::stamp(phase_t phase)
+        {
+#if ROCWMMA_PROFILE_STAMPS
+            if(mRecords != nullptr)
+            {
+                // clock64() reads s_memtime on gfx9 and s_sendmsg_rtn on gfx11+.
+                // wall_clock64() reads s_memrealtime on gfx9 and s_sendmsg_rtn on gfx11+.
+                stamp_record record;
+                record.cycles   = static_cast<uint64_t>(clock64());
+                record.realtime = static_cast<uint32_t>(wall_clock64());
+                record.phase    = static_cast<uint32_t>(phase);
+
+                mRecords[mIndex % mCapacity] = record;
+                mIndex++;
+            }
+#endif // ROCWMMA_PROFILE_STAMPS
+        }
+
+        ROCWMMA_DEVICE inline void stamp_ring::flush()
+        {
+#if ROCWMMA_PROFILE_STAMPS
+            stamp(phase_end);
+            if(mCount != nullptr)
+            {
+                *mCount = mIndex;
+            }
+#endif // ROCWMMA_PROFILE_STAMPS
+        }
+
+        ROCWMMA_HOST static inline void set_stamp_buffer(stamp_buffer const& buffer)
+        {
+#if ROCWMMA_PROFILE_STAMPS
+            (void)hipMemcpyToSymbol(
+                HIP_SYMBOL(detail::gStampBuffer), &buffer, sizeof(stamp_buffer));
+#else
+            (void)buffer;
+#endif // ROCWMMA_PROFILE_STAMPS
+        }
+
+        ROCWMMA_HOST inline phase_summary decode_stamps(stamp_record const* records,
+                                                        uint32_t const*     counts,
+                                                        uint32_t            capacity,
+                                                        uint32_t            waveCount)
+        {
+            phase_summary result = {};
+
+            for(uint32_t w = 0; w < waveCount; w++)
+            {
+                auto const* ring  = records + static_cast<uint64_t>(w) * capacity;
+                auto const  count = counts[w];
+
+                if(count == 0u)
+                {
+                    continue;
+                }
+                result.waves++;
+
+                // Only the latest capacity stamps are kept in the ring
+                auto const first = count > capacity ? count - capacity : 0u;
+                for(uint32_t i = first + 1u; i < count; i++)
+                {
+                    auto const& prev = ring[(i - 1u) % capacity];
+                    auto const& curr = ring[i % capacity];
+
+                    if(prev.phase < phase_end)
+                    {
+                        result.cycles[prev.phase] += curr.cycles - prev.cycles;
+                        result.realtime[prev.phase]
+                            += static_cast<uint32_t>(curr.realtime - prev.realtime);
+                        result.stamps[prev.phase]++;
+                    }
+                }
+            }
+
+            return result;
+        }
+
+        ROCWMMA_HOST inline const char* phase_name(phase_t phase)
+        {
+            switch(phase)
+            {
+            case phase_global_read:
+                return "global_read";
+            case phase_local_write:
+                return "local_write";
+            case phase_local_read:
+                return "local_read";
+            case phase_mma:
+                return "mma";
+            case phase_epilogue:
+                return "epilogue";
+            case phase_end:
+                return "end";
+            default:
+                return "unknown";
+            }
+        }
+
+        template <typename OStreamT>
+        ROCWMMA_HOST inline OStreamT& print_phase_summary(OStreamT&            stream,
+                                                          phase_summary const& summary)
+        {
+            uint64_t total = 0u;
+            for(uint32_t p = 0; p < phase_end; p++)
+            {
+                total += summary.cycles[p];
+            }
+
+            stream << "Phase, Stamps, Cycles, Cycles/Stamp, Share(%), Waves: " << summary.waves
+                   << "\n";
+            for(uint32_t p = 0; p < phase_end; p++)
+            {
+                auto const stamps = summary.stamps[p];
+                auto const cycles = summary.cycles[p];
+                stream << phase_name(static_cast<phase_t>(p)) << ", " << stamps << ", " << cycles
+                       << ", " << (stamps > 0u ? cycles / stamps : 0u) << ", "
+                       << (total > 0u ? 100.0 * cycles / total : 0.0) << "\n";
+            }
+            return stream;
+        }
+
+    } // namespace profile
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_PROFILE_API_IMPL_HPP
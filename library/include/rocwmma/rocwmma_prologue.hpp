@@ -0,0 +1,127 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_PROLOGUE_API_HPP
+#define ROCWMMA_PROLOGUE_API_HPP
+
+#include "rocwmma.hpp"
+#include "rocwmma_transforms.hpp"
+#include "rocwmma_prologue_impl.hpp"
+
+/**
+ * rocWMMA prologue is a complimentary API for rocWMMA, defining fused element-wise
+ * operations on matrix_a fragments between load_matrix_sync and mma_sync.
+ *
+ * A GEMM input may be pre-processed in registers (e.g. the normalization and gamma
+ * scaling of LayerNorm or RMSNorm) with a single call to apply_prologue(), such that
+ * the pre-processed input is never written to global memory.
+ *
+ * Prologue stages are light objects exposing:
+ *
+ *      template <typename ComputeT>
+ *      ComputeT operator()(ComputeT value, uint32_t idx) const;
+ *
+ * where idx is the fragment element index. Stages are applied left to right in float32_t
+ * (float64_t for float64_t inputs). Any type satisfying the above may be used as a custom stage.
+ *
+ * Per-row and per-K vectors are loaded into matrix_a fragments with load_col_vector_sync()
+ * or load_row_vector_sync(), which broadcast the vector such that the fragment elements
+ * line up with those of a matrix_a fragment of the same type.
+ *
+ * Normalization statistics are per-row of A over the whole of K, and must be known before
+ * the first fragment of the row is used. They may be computed by a light pre-pass over A,
+ * or within the GEMM kernel when the BlockM rows of A fit in LDS.
+ *
+ */
+
+namespace rocwmma
+{
+    namespace prologue
+    {
+        //! Prologue stage computing value * rstd * gamma, as for RMSNorm
+        //! @tparam FragVec Fragment type of the broadcast rstd (per-row) and gamma (per-K) inputs
+        //! @note rstd = 1 / sqrt(mean(x^2) + eps) over the row of A
+        template <typename FragVec>
+        struct RmsNorm;
+
+        //! Prologue stage computing (value - mean) * rstd * gamma + beta, as for LayerNorm
+        //! @tparam FragVec Fragment type of the broadcast mean, rstd (per-row) and gamma, beta (per-K) inputs
+        //! @note rstd = 1 / sqrt(var(x) + eps) over the row of A
+        template <typename FragVec>
+        struct LayerNorm;
+
+    } // namespace prologue
+
+    //! Loads a vector of BlockK elements into a matrix_a fragment, such that each row holds a copy of the vector.
+    //! E.g. frag(i, k) = data[k], as for the per-channel gamma or beta of a normalization of A.
+    //! @param frag matrix_a fragment with its associated block sizes, data type and layout
+    //! @param data Data pointer to global or local memory
+    //! @tparam BlockM/N/K Block dimensions
+    //! @tparam DataT Datatype
+    //! @tparam DataLayoutT In-register layout of the fragment (row_major or col_major)
+    //! @note Fragment elements co-index with any matrix_a fragment of the same type
+    //! @note For col_major fragments larger than 32 x BlockK, the broadcast requires a register
+    //! transform of the data layout.
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void load_row_vector_sync(
+        fragment<matrix_a, BlockM, BlockN, BlockK, DataT, DataLayoutT>& frag, const DataT* data);
+
+    //! Loads a vector of BlockM elements into a matrix_a fragment, such that each column holds a copy of the vector.
+    //! E.g. frag(i, k) = data[i], as for the per-row statistics of a normalization of A.
+    //! @param frag matrix_a fragment with its associated block sizes, data type and layout
+    //! @param data Data pointer to global or local memory
+    //! @tparam BlockM/N/K Block dimensions
+    //! @tparam DataT Datatype
+    //! @tparam DataLayoutT In-register layout of the fragment (row_major or col_major)
+    //! @note Fragment elements co-index with any matrix_a fragment of the same type
+    //! @note For row_major fragments larger than 32 x BlockK, the broadcast requires a register
+    //! transform of the data layout. Per-row vectors are constant over K, and should be loaded
+    //! once outside of the K loop.
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void load_col_vector_sync(
+        fragment<matrix_a, BlockM, BlockN, BlockK, DataT, DataLayoutT>& frag, const DataT* data);
+
+    //! Applies the prologue stages to each element of the matrix_a fragment in place, in a single pass.
+    //! E.g. fragA = fragA * rstd * gamma, before mma_sync
+    //! @param frag matrix_a fragment, as loaded by load_matrix_sync
+    //! @param stages Prologue stages, applied left to right
+    //! @tparam FragT Fragment type
+    //! @tparam StageTs Prologue stage types
+    //! @note Broadcast inputs of the stages must have the same type as frag, such that the elements
+    //! line up. The result is converted back to the fragment DataT as a whole vector.
+    template <typename FragT, typename... StageTs>
+    ROCWMMA_DEVICE static inline void apply_prologue(FragT& frag, StageTs const&... stages);
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_PROLOGUE_API_HPP
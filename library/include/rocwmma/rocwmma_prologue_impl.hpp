@@ -0,0 +1,173 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_PROLOGUE_API_IMPL_HPP
+#define ROCWMMA_PROLOGUE_API_IMPL_HPP
+
+#include "rocwmma_prologue.hpp"
+
+namespace rocwmma
+{
+    namespace prologue
+    {
+        namespace detail
+        {
+            // Reduced precision inputs are normalized in float32_t, unless the input is float64_t.
+            template <typename T>
+            using PrologueComputeT = conditional_t<is_same_v<T, float64_t>, float64_t, float32_t>;
+
+        } // namespace detail
+
+        template <typename FragVec>
+        struct RmsNorm
+        {
+            ROCWMMA_DEVICE RmsNorm(FragVec const& fragRstd, FragVec const& fragGamma)
+                : mFragRstd(fragRstd)
+                , mFragGamma(fragGamma)
+            {
+            }
+
+            template <typename T>
+            ROCWMMA_DEVICE inline T operator()(T value, uint32_t idx) const
+            {
+                return value * static_cast<T>(mFragRstd.x[idx])
+                       * static_cast<T>(mFragGamma.x[idx]);
+            }
+
+            FragVec const& mFragRstd;
+            FragVec const& mFragGamma;
+        };
+
+        template <typename FragVec>
+        struct LayerNorm
+        {
+            ROCWMMA_DEVICE LayerNorm(FragVec const& fragMean,
+                                     FragVec const& fragRstd,
+                                     FragVec const& fragGamma,
+                                     FragVec const& fragBeta)
+                : mFragMean(fragMean)
+                , mFragRstd(fragRstd)
+                , mFragGamma(fragGamma)
+                , mFragBeta(fragBeta)
+            {
+            }
+
+            template <typename T>
+            ROCWMMA_DEVICE inline T operator()(T value, uint32_t idx) const
+            {
+                return (value - static_cast<T>(mFragMean.x[idx])) * static_cast<T>(mFragRstd.x[idx])
+                           * static_cast<T>(mFragGamma.x[idx])
+                       + static_cast<T>(mFragBeta.x[idx]);
+            }
+
+            FragVec const& mFragMean;
+            FragVec const& mFragRstd;
+            FragVec const& mFragGamma;
+            FragVec const& mFragBeta;
+        };
+
+    } // namespace prologue
+
+    // Vector broadcasts are loaded through matrix_a fragments with a leading dimension of 0,
+    // such that one of the matrix coordinates doesn't contribute to the data offset:
+    // - row_major: offset(i, k) = i * 0 + k
+    // - col_major: offset(i, k) = i + k * 0
+    // Unlike accumulators, the register layout of large matrix_a fragments (Col profile)
+    // depends on the data layout. Broadcasts in the other layout are therefore loaded into
+    // a temporary and transformed with applyDataLayout, such that the elements line up with
+    // the target fragment. Small fragments (ColNT profile) share one register layout, for
+    // which the transform is trivial.
+    // @cond
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void load_row_vector_sync(
+        fragment<matrix_a, BlockM, BlockN, BlockK, DataT, DataLayoutT>& frag, const DataT* data)
+    {
+        static_assert(is_same_v<DataLayoutT, row_major> || is_same_v<DataLayoutT, col_major>,
+                      "Broadcast requires a row_major or col_major fragment");
+
+        if constexpr(is_same_v<DataLayoutT, row_major>)
+        {
+            load_matrix_sync(frag, data, 0u);
+        }
+        else
+        {
+            fragment<matrix_a, BlockM, BlockN, BlockK, DataT, row_major> broadcast;
+            load_matrix_sync(broadcast, data, 0u);
+            frag = applyDataLayout<DataLayoutT>(broadcast);
+        }
+    }
+
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT>
+    ROCWMMA_DEVICE void load_col_vector_sync(
+        fragment<matrix_a, BlockM, BlockN, BlockK, DataT, DataLayoutT>& frag, const DataT* data)
+    {
+        static_assert(is_same_v<DataLayoutT, row_major> || is_same_v<DataLayoutT, col_major>,
+                      "Broadcast requires a row_major or col_major fragment");
+
+        if constexpr(is_same_v<DataLayoutT, col_major>)
+        {
+            load_matrix_sync(frag, data, 0u);
+        }
+        else
+        {
+            fragment<matrix_a, BlockM, BlockN, BlockK, DataT, col_major> broadcast;
+            load_matrix_sync(broadcast, data, 0u);
+            frag = applyDataLayout<DataLayoutT>(broadcast);
+        }
+    }
+
+    template <typename FragT, typename... StageTs>
+    ROCWMMA_DEVICE static inline void apply_prologue(FragT& frag, StageTs const&... stages)
+    {
+        using DataT    = typename FragT::element_type;
+        using ComputeT = prologue::detail::PrologueComputeT<DataT>;
+
+        // Stages are applied in ComputeT, then the result is converted back as a whole
+        // vector to allow packed conversions (e.g. float32_t -> float16_t).
+        VecT<ComputeT, FragT::num_elements> result;
+
+#pragma unroll
+        for(uint32_t i = 0; i < FragT::num_elements; i++)
+        {
+            auto value = static_cast<ComputeT>(frag.x[i]);
+            ((value = stages(value, i)), ...);
+            result.data[i] = value;
+        }
+
+        frag.mAccess = Convert<ComputeT, DataT>::exec(result);
+    }
+    // @endcond
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_PROLOGUE_API_IMPL_HPP
@@ -0,0 +1,124 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_REFORMAT_API_HPP
+#define ROCWMMA_REFORMAT_API_HPP
+
+#include <hip/hip_runtime.h>
+
+#include "rocwmma.hpp"
+#include "rocwmma_transforms.hpp"
+
+/**
+ * rocWMMA reformat is a complimentary API for rocWMMA, converting batched matrices between
+ * row major and col major layouts, or equivalently transposing them, at close to the memory
+ * bandwidth of the device.
+ *
+ * Each wave moves a tile of blocks: it loads the fragments of the tile in the source layout,
+ * changes their layout in registers with applyDataLayout, and stores them in the destination
+ * layout. Both the loads and the stores are vectorized along the contiguous dimension of their
+ * layout, so neither side is strided per element and no LDS is used. Edge tiles are loaded and
+ * stored bounded, so neither the sizes nor the leading dimensions need padding.
+ *
+ * The conversion only moves bits: elements are carried by a type of the same size, such that
+ * every datatype of 1, 2, 4 or 8 bytes is supported, including the 8-bit floating point types
+ * and user types.
+ *
+ * Usage:
+ *  - Call reformat_matrix() to change the layout of rows x cols matrices, e.g. row major
+ *    weights to the col major layout of a kernel. Matching layouts copy with a new leading
+ *    dimension.
+ *  - Call transpose_matrix() to write the transpose of row major matrices, row major.
+ *  - Both enqueue a single kernel on the given stream. Source and destination must not overlap.
+ */
+
+namespace rocwmma
+{
+    //! Waves per workgroup of the reformat kernel, one tile each
+    constexpr uint32_t REFORMAT_WAVE_COUNT = 4u;
+
+    //! Reformat kernel
+    //! @param src Source matrices, rows x cols in SrcLayoutT with leading dimension lds
+    //! @param lds Leading dimension of the source matrices
+    //! @param strideSrc Elements between consecutive source matrices
+    //! @param dst Destination matrices, rows x cols in DstLayoutT with leading dimension ldd
+    //! @param ldd Leading dimension of the destination matrices
+    //! @param strideDst Elements between consecutive destination matrices
+    //! @param rows/cols Size of each matrix
+    //! @param batchCount Number of matrices
+    //! @tparam DataT Element carrier type of 1, 2, 4 or 8 bytes
+    //! @tparam SrcLayoutT/DstLayoutT Source and destination layouts, row_major or col_major
+    template <typename DataT, typename SrcLayoutT, typename DstLayoutT>
+    ROCWMMA_KERNEL void __launch_bounds__(REFORMAT_WAVE_COUNT* Constants::AMDGCN_WAVE_SIZE)
+        reformat_matrix_kernel(DataT const* __restrict__ src,
+                               uint32_t lds,
+                               uint64_t strideSrc,
+                               DataT* __restrict__ dst,
+                               uint32_t ldd,
+                               uint64_t strideDst,
+                               uint32_t rows,
+                               uint32_t cols,
+                               uint32_t batchCount);
+
+    //! Enqueues the conversion of batchCount rows x cols matrices from srcLayout to dstLayout
+    //! on the stream. Arguments are as for reformat_matrix_kernel.
+    //! @param srcLayout/dstLayout Source and destination layouts, mem_row_major or mem_col_major
+    //! @returns hipErrorInvalidValue for a leading dimension smaller than the contiguous extent
+    //! of its matrix, otherwise the status of the launch
+    //! @tparam DataT Datatype of 1, 2, 4 or 8 bytes
+    template <typename DataT>
+    ROCWMMA_HOST inline hipError_t reformat_matrix(layout_t     srcLayout,
+                                                   DataT const* src,
+                                                   uint32_t     lds,
+                                                   uint64_t     strideSrc,
+                                                   layout_t     dstLayout,
+                                                   DataT*       dst,
+                                                   uint32_t     ldd,
+                                                   uint64_t     strideDst,
+                                                   uint32_t     rows,
+                                                   uint32_t     cols,
+                                                   uint32_t     batchCount = 1u,
+                                                   hipStream_t  stream     = 0);
+
+    //! Enqueues dst = src^T for batchCount row major matrices on the stream: src is rows x cols
+    //! with leading dimension lds, and dst is cols x rows with leading dimension ldd.
+    //! Equivalent to reformat_matrix() from mem_row_major to mem_col_major.
+    template <typename DataT>
+    ROCWMMA_HOST inline hipError_t transpose_matrix(DataT const* src,
+                                                    uint32_t     lds,
+                                                    DataT*       dst,
+                                                    uint32_t     ldd,
+                                                    uint32_t     rows,
+                                                    uint32_t     cols,
+                                                    uint32_t     batchCount = 1u,
+                                                    uint64_t     strideSrc  = 0u,
+                                                    uint64_t     strideDst  = 0u,
+                                                    hipStream_t  stream     = 0);
+
+} // namespace rocwmma
+
+#include "rocwmma_reformat_impl.hpp"
+
+#endif // ROCWMMA_REFORMAT_API_HPP
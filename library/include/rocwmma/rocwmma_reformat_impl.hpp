@@ -0,0 +1,352 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_REFORMAT_API_IMPL_HPP
+#define ROCWMMA_REFORMAT_API_IMPL_HPP
+
+#include "rocwmma_reformat.hpp"
+
+namespace rocwmma
+{
+    // @cond
+    namespace detail
+    {
+        // Element carriers by size, of fragment types supported on all targets
+        template <uint32_t Bytes>
+        struct ReformatCarrier;
+
+        template <>
+        struct ReformatCarrier<1u>
+        {
+            using Type = int8_t;
+        };
+
+        template <>
+        struct ReformatCarrier<2u>
+        {
+            using Type = float16_t;
+        };
+
+        template <>
+        struct ReformatCarrier<4u>
+        {
+            using Type = int32_t;
+        };
+
+        template <>
+        struct ReformatCarrier<8u>
+        {
+            using Type = float64_t;
+        };
+
+        template <typename DataT>
+        struct ReformatTraits
+        {
+            enum : uint32_t
+            {
+                // Square blocks of one fragment
+                BlockDim = 16u,
+
+                // Blocks per tile dimension, for tiles of 4KB to 8KB per wave
+                WaveBlocks = sizeof(DataT) <= 2u ? 4u : 2u,
+
+                WaveTileDim = BlockDim * WaveBlocks,
+            };
+        };
+
+        ROCWMMA_HOST_DEVICE constexpr inline uint32_t reformatMinLd(layout_t layout,
+                                                                    uint32_t rows,
+                                                                    uint32_t cols)
+        {
+            return layout == mem_row_major ? cols : rows;
+        }
+
+        template <typename DataT, typename SrcLayoutT, typename DstLayoutT>
+        ROCWMMA_HOST inline void reformatLaunch(DataT const* src,
+                                                uint32_t     lds,
+                                                uint64_t     strideSrc,
+                                                DataT*       dst,
+                                                uint32_t     ldd,
+                                                uint64_t     strideDst,
+                                                uint32_t     rows,
+                                                uint32_t     cols,
+                                                uint32_t     batchCount,
+                                                uint32_t     waveSize,
+                                                hipStream_t  stream)
+        {
+            using Traits = ReformatTraits<DataT>;
+
+            auto tilesX = (cols + Traits::WaveTileDim - 1u) / Traits::WaveTileDim;
+            auto tilesY = (rows + Traits::WaveTileDim - 1u) / Traits::WaveTileDim;
+            auto tiles  = static_cast<uint64_t>(tilesX) * tilesY;
+
+            // Batches beyond the grid limit are strided over by the kernel
+            auto gridDim = dim3((tiles + REFORMAT_WAVE_COUNT - 1u) / REFORMAT_WAVE_COUNT,
+                                batchCount < 65535u ? batchCount : 65535u);
+
+            hipLaunchKernelGGL((reformat_matrix_kernel<DataT, SrcLayoutT, DstLayoutT>),
+                               gridDim,
+                               dim3(REFORMAT_WAVE_COUNT * waveSize),
+                               0, // sharedMemBytes
+                               stream,
+                               src,
+                               lds,
+                               strideSrc,
+                               dst,
+                               ldd,
+                               strideDst,
+                               rows,
+                               cols,
+                               batchCount);
+        }
+
+        ROCWMMA_HOST inline hipError_t reformatHostWaveSize(uint32_t& waveSize)
+        {
+            int  device = 0;
+            int  size   = 0;
+            auto status = hipGetDevice(&device);
+            if(status == hipSuccess)
+            {
+                status = hipDeviceGetAttribute(&size, hipDeviceAttributeWarpSize, device);
+            }
+            waveSize = static_cast<uint32_t>(size);
+            return status;
+        }
+
+    } // namespace detail
+    // @endcond
+
+    template <typename DataT, typename SrcLayoutT, typename DstLayoutT>
+    ROCWMMA_KERNEL void __launch_bounds__(REFORMAT_WAVE_COUNT* Constants::AMDGCN_WAVE_SIZE)
+        reformat_matrix_kernel(DataT const* __restrict__ src,
+                               uint32_t lds,
+                               uint64_t strideSrc,
+                               DataT* __restrict__ dst,
+                               uint32_t ldd,
+                               uint64_t strideDst,
+                               uint32_t rows,
+                               uint32_t cols,
+                               uint32_t batchCount)
+    {
+        using Traits = detail::ReformatTraits<DataT>;
+
+        constexpr uint32_t BlockDim   = Traits::BlockDim;
+        constexpr uint32_t WaveBlocks = Traits::WaveBlocks;
+        constexpr uint32_t TileDim    = Traits::WaveTileDim;
+
+        using FragSrc = fragment<matrix_a, BlockDim, 1, BlockDim, DataT, SrcLayoutT>;
+        using FragDst = ApplyDataLayout_t<FragSrc, DstLayoutT>;
+        using MapSrc  = GetDataLayout_t<FragSrc>;
+        using MapDst  = GetDataLayout_t<FragDst>;
+
+        auto waveIdx = threadIdx.x / Constants::AMDGCN_WAVE_SIZE;
+        auto tile    = static_cast<uint64_t>(blockIdx.x) * REFORMAT_WAVE_COUNT + waveIdx;
+
+        auto tilesX = (cols + TileDim - 1u) / TileDim;
+        auto tilesY = (rows + TileDim - 1u) / TileDim;
+        if(tile >= static_cast<uint64_t>(tilesX) * tilesY)
+        {
+            return;
+        }
+
+        // Consecutive waves walk the contiguous dimension of the source
+        uint32_t row0, col0;
+        if(is_same<SrcLayoutT, row_major>::value)
+        {
+            row0 = static_cast<uint32_t>(tile / tilesX) * TileDim;
+            col0 = static_cast<uint32_t>(tile % tilesX) * TileDim;
+        }
+        else
+        {
+            col0 = static_cast<uint32_t>(tile / tilesY) * TileDim;
+            row0 = static_cast<uint32_t>(tile % tilesY) * TileDim;
+        }
+
+        bool interior = (row0 + TileDim <= rows) && (col0 + TileDim <= cols);
+
+        for(auto batch = blockIdx.y; batch < batchCount; batch += gridDim.y)
+        {
+            auto s = src + batch * strideSrc;
+            auto d = dst + batch * strideDst;
+
+            FragSrc frags[WaveBlocks][WaveBlocks];
+
+            if(interior)
+            {
+                // Issue all loads of the tile before the first store
+#pragma unroll
+                for(uint32_t i = 0; i < WaveBlocks; i++)
+                {
+#pragma unroll
+                    for(uint32_t j = 0; j < WaveBlocks; j++)
+                    {
+                        auto coord = make_coord2d(row0 + i * BlockDim, col0 + j * BlockDim);
+                        load_matrix_sync(frags[i][j], s + MapSrc::fromMatrixCoord(coord, lds), lds);
+                    }
+                }
+
+#pragma unroll
+                for(uint32_t i = 0; i < WaveBlocks; i++)
+                {
+#pragma unroll
+                    for(uint32_t j = 0; j < WaveBlocks; j++)
+                    {
+                        auto coord = make_coord2d(row0 + i * BlockDim, col0 + j * BlockDim);
+                        store_matrix_sync(d + MapDst::fromMatrixCoord(coord, ldd),
+                                          applyDataLayout<DstLayoutT>(frags[i][j]),
+                                          ldd);
+                    }
+                }
+            }
+            else
+            {
+                // Edge tile: blocks are bounded, and skipped past the edges
+                for(uint32_t i = 0; i < WaveBlocks; i++)
+                {
+                    for(uint32_t j = 0; j < WaveBlocks; j++)
+                    {
+                        auto row = row0 + i * BlockDim;
+                        auto col = col0 + j * BlockDim;
+                        if(row >= rows || col >= cols)
+                        {
+                            continue;
+                        }
+
+                        auto coord = make_coord2d(row, col);
+                        load_matrix_bounded_sync(frags[i][j],
+                                                 s + MapSrc::fromMatrixCoord(coord, lds),
+                                                 lds,
+                                                 rows - row,
+                                                 cols - col);
+                        store_matrix_bounded_sync(d + MapDst::fromMatrixCoord(coord, ldd),
+                                                  applyDataLayout<DstLayoutT>(frags[i][j]),
+                                                  ldd,
+                                                  rows - row,
+                                                  cols - col);
+                    }
+                }
+            }
+        }
+    }
+
+    template <typename DataT>
+    ROCWMMA_HOST inline hipError_t reformat_matrix(layout_t     srcLayout,
+                                                   DataT const* src,
+                                                   uint32_t     lds,
+                                                   uint64_t     strideSrc,
+                                                   layout_t     dstLayout,
+                                                   DataT*       dst,
+                                                   uint32_t     ldd,
+                                                   uint64_t     strideDst,
+                                                   uint32_t     rows,
+                                                   uint32_t     cols,
+                                                   uint32_t     batchCount,
+                                                   hipStream_t  stream)
+    {
+        static_assert(sizeof(DataT) == 1u || sizeof(DataT) == 2u || sizeof(DataT) == 4u
+                          || sizeof(DataT) == 8u,
+                      "Only datatypes of 1, 2, 4 or 8 bytes can be reformatted");
+
+        using CarrierT = typename detail::ReformatCarrier<sizeof(DataT)>::Type;
+
+        if(lds < detail::reformatMinLd(srcLayout, rows, cols)
+           || ldd < detail::reformatMinLd(dstLayout, rows, cols))
+        {
+            return hipErrorInvalidValue;
+        }
+        if(rows == 0u || cols == 0u || batchCount == 0u)
+        {
+            return hipSuccess;
+        }
+
+        uint32_t waveSize = 0u;
+        auto     status   = detail::reformatHostWaveSize(waveSize);
+        if(status != hipSuccess)
+        {
+            return status;
+        }
+
+        auto s = reinterpret_cast<CarrierT const*>(src);
+        auto d = reinterpret_cast<CarrierT*>(dst);
+
+        if(srcLayout == mem_row_major)
+        {
+            if(dstLayout == mem_row_major)
+            {
+                detail::reformatLaunch<CarrierT, row_major, row_major>(
+                    s, lds, strideSrc, d, ldd, strideDst, rows, cols, batchCount, waveSize, stream);
+            }
+            else
+            {
+                detail::reformatLaunch<CarrierT, row_major, col_major>(
+                    s, lds, strideSrc, d, ldd, strideDst, rows, cols, batchCount, waveSize, stream);
+            }
+        }
+        else
+        {
+            if(dstLayout == mem_row_major)
+            {
+                detail::reformatLaunch<CarrierT, col_major, row_major>(
+                    s, lds, strideSrc, d, ldd, strideDst, rows, cols, batchCount, waveSize, stream);
+            }
+            else
+            {
+                detail::reformatLaunch<CarrierT, col_major, col_major>(
+                    s, lds, strideSrc, d, ldd, strideDst, rows, cols, batchCount, waveSize, stream);
+            }
+        }
+        return hipGetLastError();
+    }
+
+    template <typename DataT>
+    ROCWMMA_HOST inline hipError_t transpose_matrix(DataT const* src,
+                                                    uint32_t     lds,
+                                                    DataT*       dst,
+                                                    uint32_t     ldd,
+                                                    uint32_t     rows,
+                                                    uint32_t     cols,
+                                                    uint32_t     batchCount,
+                                                    uint64_t     strideSrc,
+                                                    uint64_t     strideDst,
+                                                    hipStream_t  stream)
+    {
+        // The col major image of src is its transpose in row major
+        return reformat_matrix(mem_row_major,
+                               src,
+                               lds,
+                               strideSrc,
+                               mem_col_major,
+                               dst,
+                               ldd,
+                               strideDst,
+                               rows,
+                               cols,
+                               batchCount,
+                               stream);
+    }
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_REFORMAT_API_IMPL_HPP
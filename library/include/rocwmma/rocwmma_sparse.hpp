@@ -0,0 +1,175 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_SPARSE_API_HPP
+#define ROCWMMA_SPARSE_API_HPP
+
+#include "rocwmma.hpp"
+
+/**
+ * rocWMMA sparse is a complimentary API for rocWMMA, exposing 2:4 structured sparse
+ * matrix multiply-accumulate on targets with smfmac support (gfx940, gfx941 and gfx942).
+ *
+ * In a 2:4 structured sparse matrix_a, at most two of every four consecutive K elements
+ * in each row are non-zero. The matrix is stored compressed to half of its K extent,
+ * with a 2-bit index per surviving value recording its position within the group of four.
+ * The smfmac instructions consume the compressed values and indices directly, executing
+ * a BlockM x BlockN x BlockK multiply in the time of a dense BlockK / 2 multiply.
+ *
+ * Usage:
+ *  - Compress each BlockM x BlockK block of A on the host with compress_sparse_2_4().
+ *    Values and indices are written in wave lane order, ready to be loaded.
+ *  - Load the compressed blocks into fragment<matrix_a, ..., sparse_2_4> with load_matrix_sync().
+ *  - Multiply with the dense matrix_b fragment using mma_sync().
+ *
+ * Supported configurations (InputT / ComputeT / BlockM x BlockN x BlockK):
+ *  - float16_t / float32_t / 16 x 16 x 32
+ *  - float16_t / float32_t / 32 x 32 x 16
+ *  - bfloat16_t / float32_t / 16 x 16 x 32
+ *  - bfloat16_t / float32_t / 32 x 32 x 16
+ *
+ */
+
+namespace rocwmma
+{
+    //! @struct sparse_2_4
+    //! @brief Data layout tag of compressed 2:4 structured sparse matrix_a fragments
+    struct sparse_2_4;
+
+    //! @class fragment
+    //! @brief Compressed 2:4 structured sparse matrix_a fragment. Each lane holds BlockM * BlockK / 128 values
+    //! of the compressed block, and a 32-bit index register of which the low 8 bits are used.
+    //!
+    //! @tparam BlockM/N/K block dimensions of the dense problem
+    //! @tparam DataT datatype
+    //!
+    //! @note Fragments are filled from buffers written by compress_sparse_2_4(), and consumed by the sparse mma_sync() overload.
+    template <uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename DataT>
+    class __align__(4) fragment<matrix_a, BlockM, BlockN, BlockK, DataT, sparse_2_4>
+    {
+    public:
+        struct Traits
+        {
+        private:
+            //! The packed type for element data
+            using PackedElementT = typename PackTraits<DataT>::PackedT;
+
+            //! The unpacked type for element data
+            using UnpackedElementT = typename PackTraits<DataT>::UnpackedT;
+
+        public:
+            //! Compressed elements per lane
+            constexpr static uint32_t Size
+                = BlockM * BlockK / 2u / Constants::AMDGCN_WAVE_SIZE_64;
+
+            //! Unpacked data access view
+            using AccessT = VecT<UnpackedElementT, Size>;
+
+            //! Packed data storage view
+            using StorageT = VecT<PackedElementT, Size / PackTraits<DataT>::PackRatio>;
+
+            static_assert(Size % PackTraits<DataT>::PackRatio == 0,
+                          "Unable to pack fragment elements");
+        };
+
+        //! @returns Mutable packed storage vector accessor
+        ROCWMMA_DEVICE inline typename Traits::StorageT& operator*();
+        //! @returns Immutable packed storage vector accessor
+        ROCWMMA_DEVICE inline typename Traits::StorageT const& operator*() const;
+
+        //! Internal data storage views
+        union
+        {
+            typename Traits::StorageT mStorage; // Packed
+            typename Traits::AccessT  mAccess; // Unpacked
+        };
+
+        //! 2-bit position of each compressed element within its group of four
+        uint32_t mIndex;
+
+        constexpr static uint32_t num_elements = Traits::Size;
+        using element_type                     = DataT;
+    };
+
+    //! Loads a compressed 2:4 sparse block into the fragment. Data pointers may point to either local or global memory.
+    //! @param frag Sparse matrix_a fragment
+    //! @param values Pointer to the compressed values of one block, as written by compress_sparse_2_4()
+    //! @param indices Pointer to the indices of the same block, as written by compress_sparse_2_4()
+    //! @tparam BlockM/N/K Block dimensions
+    //! @tparam DataT Datatype
+    template <uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename DataT>
+    ROCWMMA_DEVICE void
+        load_matrix_sync(fragment<matrix_a, BlockM, BlockN, BlockK, DataT, sparse_2_4>& frag,
+                         const DataT*                                                   values,
+                         const uint32_t*                                                indices);
+
+    //! Performs the sparse Multiply-Accumulate operation on the fragments A, B, C and D(D = A * B + C)
+    //! where A is a compressed 2:4 structured sparse fragment.
+    //! @param d Accumulator output D
+    //! @param a Compressed sparse input A
+    //! @param b Dense input B
+    //! @param c Accumulator input C
+    //! @tparam BlockM/N/K Block dimensions
+    //! @tparam InputT Datatype of input frags A and B
+    //! @tparam ComputeT Datatype of accumulator fragment C / D
+    //! @tparam LayoutB In-memory layout of frag B as col_major or row_major
+    //! @tparam LayoutC/D In-memory layout of accumulator frags C / D as col_major or row_major, or void
+    //! @note Frag c = d is valid
+    //! @note Only available on gfx940, gfx941 and gfx942; other targets receive an unsupported stub
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename InputT,
+              typename ComputeT,
+              typename LayoutB,
+              typename LayoutC,
+              typename LayoutD>
+    ROCWMMA_DEVICE void
+        mma_sync(fragment<accumulator, BlockM, BlockN, BlockK, ComputeT, LayoutD>&       d,
+                 fragment<matrix_a, BlockM, BlockN, BlockK, InputT, sparse_2_4> const&   a,
+                 fragment<matrix_b, BlockM, BlockN, BlockK, InputT, LayoutB> const&      b,
+                 fragment<accumulator, BlockM, BlockN, BlockK, ComputeT, LayoutC> const& c);
+
+    //! Compresses one BlockM x BlockK block of a 2:4 structured sparse matrix A on the host.
+    //! Of each group of four consecutive K elements in a row, the two of largest magnitude are kept,
+    //! such that dense inputs are pruned to the 2:4 pattern.
+    //! @param dense Pointer to the top-left element of the dense block
+    //! @param ldm Leading dimension of the dense matrix
+    //! @param values Output of BlockM * BlockK / 2 compressed values, in lane order
+    //! @param indices Output of 64 lane indices
+    //! @tparam BlockM/K Block dimensions
+    //! @tparam DataLayoutT In-memory layout of the dense matrix as col_major or row_major
+    //! @tparam DataT Datatype
+    template <uint32_t BlockM, uint32_t BlockK, typename DataLayoutT, typename DataT>
+    ROCWMMA_HOST void compress_sparse_2_4(DataT const* dense,
+                                          uint32_t     ldm,
+                                          DataT*       values,
+                                          uint32_t*    indices);
+
+} // namespace rocwmma
+
+#include "rocwmma_sparse_impl.hpp"
+
+#endif // ROCWMMA_SPARSE_API_HPP
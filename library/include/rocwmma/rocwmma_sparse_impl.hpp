@@ -0,0 +1,174 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_SPARSE_API_IMPL_HPP
+#define ROCWMMA_SPARSE_API_IMPL_HPP
+
+#include "rocwmma_sparse.hpp"
+
+#include "internal/smfmac.hpp"
+
+namespace rocwmma
+{
+    // @cond
+    template <uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename DataT>
+    ROCWMMA_DEVICE inline auto
+        fragment<matrix_a, BlockM, BlockN, BlockK, DataT, sparse_2_4>::operator*() ->
+        typename Traits::StorageT&
+    {
+        return mStorage;
+    }
+
+    template <uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename DataT>
+    ROCWMMA_DEVICE inline auto
+        fragment<matrix_a, BlockM, BlockN, BlockK, DataT, sparse_2_4>::operator*() const ->
+        typename Traits::StorageT const&
+    {
+        return mStorage;
+    }
+
+    template <uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename DataT>
+    ROCWMMA_DEVICE void
+        load_matrix_sync(fragment<matrix_a, BlockM, BlockN, BlockK, DataT, sparse_2_4>& frag,
+                         const DataT*                                                   values,
+                         const uint32_t*                                                indices)
+    {
+        using FragT   = decay_t<decltype(frag)>;
+        using AccessT = typename FragT::Traits::AccessT;
+
+        static_assert(Constants::AMDGCN_WAVE_SIZE == Constants::AMDGCN_WAVE_SIZE_64,
+                      "Sparse fragments require wave64");
+
+        // Compressed blocks are stored in lane order
+        auto laneId = detail::laneId();
+        frag.mAccess = reinterpret_cast<AccessT const*>(values)[laneId];
+        frag.mIndex  = indices[laneId];
+    }
+
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename InputT,
+              typename ComputeT,
+              typename LayoutB,
+              typename LayoutC,
+              typename LayoutD>
+    ROCWMMA_DEVICE void
+        mma_sync(fragment<accumulator, BlockM, BlockN, BlockK, ComputeT, LayoutD>&       d,
+                 fragment<matrix_a, BlockM, BlockN, BlockK, InputT, sparse_2_4> const&   a,
+                 fragment<matrix_b, BlockM, BlockN, BlockK, InputT, LayoutB> const&      b,
+                 fragment<accumulator, BlockM, BlockN, BlockK, ComputeT, LayoutC> const& c)
+    {
+        using FragB     = decay_t<decltype(b)>;
+        using IOConfigB = GetIOConfig_t<FragB>;
+
+        using SMFMAC = detail::amdgcn_smfmac<InputT, ComputeT, BlockM, BlockN>;
+
+        // Sanity checks
+        static_assert(BlockM == BlockN, "Sparse mma requires square blocks");
+
+        static_assert(BlockK == SMFMAC::Traits::KPerSmfmac,
+                      "BlockK must match the smfmac K dimension");
+
+        static_assert(is_same_v<typename IOConfigB::IOLayout::RegisterLayout,
+                                RegisterLayout::template Soa<IOConfigB::IOShape::BlockDim,
+                                                             IOConfigB::IOLayout::MaxVW>>,
+                      "Input fragment register layouts are not smfmac friendly");
+
+        static_assert(VecTraits<decay_t<decltype(*b)>>::size()
+                          == VecTraits<typename SMFMAC::Traits::BRegsT>::size(),
+                      "Input fragment B size does not match smfmac");
+
+        // smfmac operates on packed vectors
+        (*d) = SMFMAC::exec(*a, *b, *c, a.mIndex);
+    }
+
+    template <uint32_t BlockM, uint32_t BlockK, typename DataLayoutT, typename DataT>
+    ROCWMMA_HOST void compress_sparse_2_4(DataT const* dense,
+                                          uint32_t     ldm,
+                                          DataT*       values,
+                                          uint32_t*    indices)
+    {
+        constexpr uint32_t WaveSize      = Constants::AMDGCN_WAVE_SIZE_64;
+        constexpr uint32_t ValuesPerLane = BlockM * BlockK / 2u / WaveSize;
+        constexpr uint32_t HalfK         = BlockK / 2u;
+
+        static_assert(ValuesPerLane == 4u, "Unsupported sparse block size");
+
+        auto denseAt = [dense, ldm](uint32_t row, uint32_t k) {
+            return is_same_v<DataLayoutT, row_major> ? dense[row * ldm + k]
+                                                     : dense[k * ldm + row];
+        };
+
+        for(uint32_t lane = 0; lane < WaveSize; lane++)
+        {
+            // Each lane covers one row, and two groups of four K elements: one in each
+            // half of BlockK. Lane groups of BlockM step through K in fours.
+            auto row   = lane % BlockM;
+            auto kBase = (lane / BlockM) * 4u;
+
+            uint32_t index = 0u;
+            for(uint32_t half = 0; half < 2u; half++)
+            {
+                auto k = half * HalfK + kBase;
+
+                // Keep the two largest magnitudes, in order of position
+                uint32_t first = 0u, second = 1u;
+                for(uint32_t pos = 1u; pos < 4u; pos++)
+                {
+                    auto mag = std::abs(static_cast<float32_t>(denseAt(row, k + pos)));
+                    if(mag > std::abs(static_cast<float32_t>(denseAt(row, k + first))))
+                    {
+                        second = first;
+                        first  = pos;
+                    }
+                    else if(pos != second
+                            && mag > std::abs(static_cast<float32_t>(denseAt(row, k + second))))
+                    {
+                        second = pos;
+                    }
+                }
+                if(first > second)
+                {
+                    auto tmp = first;
+                    first    = second;
+                    second   = tmp;
+                }
+
+                auto out         = lane * ValuesPerLane + half * 2u;
+                values[out]      = denseAt(row, k + first);
+                values[out + 1u] = denseAt(row, k + second);
+
+                // 2-bit position per value
+                index |= (first | (second << 2u)) << (half * 4u);
+            }
+            indices[lane] = index;
+        }
+    }
+    // @endcond
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_SPARSE_API_IMPL_HPP
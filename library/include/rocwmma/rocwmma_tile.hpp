@@ -0,0 +1,471 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_TILE_API_HPP
+#define ROCWMMA_TILE_API_HPP
+
+#include "rocwmma.hpp"
+
+//! rocWMMA tile API complements the rocWMMA API with register-blocked warp tiles.
+//!
+//! \n
+//! **fragment_array**
+//!
+//! A BlocksX x BlocksY array of fragments of the same type, covering adjacent blocks of a
+//! wave tile. Block (i, j) starts at matrix coordinate (i * block_height, j * block_width).
+//! For a warp tile of BlocksX x BlocksY mma blocks, the A operand is a BlocksX x 1 array of
+//! matrix_a fragments, the B operand a 1 x BlocksY array of matrix_b fragments and the
+//! accumulator a BlocksX x BlocksY array of accumulator fragments:
+//!
+//!     fragment_array<FragA, BlocksX, 1>         tileA;
+//!     fragment_array<FragB, 1, BlocksY>         tileB;
+//!     fragment_array<FragAcc, BlocksX, BlocksY> tileAcc;
+//!
+//!     fill_fragment(tileAcc, 0.0f);
+//!     loop: load_matrix_sync(tileA, a, lda); load_matrix_sync(tileB, b, ldb);
+//!           mma_sync(tileAcc, tileA, tileB, tileAcc);
+//!     store_matrix_sync(d, tileAcc, ldd);
+//!
+//! All functions are unrolled over the blocks at compile time. mma_sync issues the block
+//! products in serpentine order: each row of blocks reuses its A fragment, and the B fragment
+//! is reused at each turn between rows. Consecutive mma never accumulate into the same block,
+//! unless the tile has a single block.
+//!
+//! \n
+//! **super_fragment**
+//!
+//! A fragment of SuperM x SuperN blocks, e.g. 64 or 128, composed of a fragment_array of
+//! native mma blocks: SuperM / NativeM x 1 blocks of matrix_a, 1 x SuperN / NativeN blocks of
+//! matrix_b and SuperM / NativeM x SuperN / NativeN blocks of accumulator. The native blocks
+//! are 32 x 32 where the target has them for the data type, and 16 x 16 otherwise:
+//!
+//!     super_fragment<matrix_a, 64, 64, 16, float16_t, row_major> fragA;
+//!     super_fragment<matrix_b, 64, 64, 16, float16_t, col_major> fragB;
+//!     super_fragment<accumulator, 64, 64, 16, float32_t>         fragAcc;
+//!
+//! Super fragments use the fragment_array functions. Loads and stores issue the blocks of
+//! each contiguous span of the super-block back to back, and mma_sync issues the native
+//! mma in serpentine order.
+//!
+//! \n
+//! **fragment_slice**
+//!
+//! A zero-copy view of the K range [K0, K1) of a matrix_a or matrix_b fragment, as a fragment of
+//! BlockK = K1 - K0 aliasing the registers of the whole fragment. A fragment loaded once at a
+//! large BlockK can be fed to mma_sync in K slices, e.g. to interleave them with other work:
+//!
+//!     fragment<matrix_a, 16, 16, 64, float16_t, row_major> fragA;
+//!     fragment<matrix_b, 16, 16, 64, float16_t, col_major> fragB;
+//!     load_matrix_sync(fragA, a, lda); load_matrix_sync(fragB, b, ldb);
+//!     mma_sync(acc, fragment_slice<0, 16>(fragA), fragment_slice<0, 16>(fragB), acc);
+//!     ...
+//!     mma_sync(acc, fragment_slice<48, 64>(fragA), fragment_slice<48, 64>(fragB), acc);
+//!
+//! Slices of the same K range of matrix_a and matrix_b hold the same subset of K, such that the
+//! mma of all slices sum to the mma of the whole fragments. Elements within a slice are not in
+//! the order of a fragment loaded from the K0 offset.
+//!
+//! \n
+//! **raster**
+//!
+//! Rasterization policies map the linear index of a macro tile to its 2D tile coordinate,
+//! such that the workgroups resident at the same time share A row panels and B column panels
+//! in L2. Workgroups are dispatched in linear ID order, with blockIdx.x fastest:
+//!
+//!     auto tileCoord = raster_workgroup_coord<raster::grouped<4u>>();
+//!
+//! - linear: the launch grid order, such that tile (i, j) is computed by workgroup (i, j)
+//! - grouped: column by column within bands of GroupX tile rows (super-tiles)
+//! - morton, hilbert: Z-order / Hilbert curves within 2^Order x 2^Order super-tiles
+//! - xcd: consecutive tiles of the inner policy to the workgroups of the same XCD, for
+//!   chiplet GPUs such as MI300 that distribute workgroups round-robin over XCDs,
+//!   each with a private L2
+//!
+//! \n
+//! **warp_tile_config**
+//!
+//! Validated warp tile defaults of a target architecture for an input data type: the mma block
+//! size, the blocks per wave, the workgroup shape and the LDS data layout. Kernels select the
+//! config of the target being compiled, such that one kernel source compiles to the tuned
+//! tile of each target of an --offload-arch fat binary:
+//!
+//!     using Config = warp_tile_config_t<float16_t>;
+//!     using FragA  = fragment<matrix_a, Config::block_m, Config::block_n, Config::block_k,
+//!                             float16_t, col_major>;
+//!
+//! The host selects the launch parameters of the same config at runtime, from the arch ID of
+//! the device:
+//!
+//!     auto params = get_warp_tile_params<float16_t>(Constants::AMDGCN_ARCH_ID_GFX942);
+//!     auto blockDim = dim3(params.tblock_x, params.tblock_y);
+
+namespace rocwmma
+{
+    //! @struct fragment_array
+    //! @brief Register-blocked array of fragments, covering BlocksX x BlocksY adjacent blocks
+    //! @tparam FragT Fragment type of each block
+    //! @tparam BlocksX Number of blocks in the row (M) direction
+    //! @tparam BlocksY Number of blocks in the column (N) direction
+    template <typename FragT, uint32_t BlocksX, uint32_t BlocksY = 1u>
+    struct fragment_array
+    {
+        static_assert(BlocksX > 0u && BlocksY > 0u, "Fragment arrays require at least 1 block");
+
+        using fragment_type = FragT;
+
+        //! Number of blocks in each direction
+        constexpr static uint32_t blocks_x = BlocksX;
+        constexpr static uint32_t blocks_y = BlocksY;
+
+        //! Matrix rows and columns covered by each block
+        constexpr static uint32_t block_height = GetIOShape_t<FragT>::BlockHeight;
+        constexpr static uint32_t block_width  = GetIOShape_t<FragT>::BlockWidth;
+
+        //! Access to block (i, j)
+        ROCWMMA_DEVICE inline FragT&       operator()(uint32_t i, uint32_t j = 0u);
+        ROCWMMA_DEVICE inline FragT const& operator()(uint32_t i, uint32_t j = 0u) const;
+
+        FragT frags[BlocksX][BlocksY];
+    };
+
+    // @cond
+    namespace detail
+    {
+        template <typename MatrixT,
+                  uint32_t SuperM,
+                  uint32_t SuperN,
+                  uint32_t BlockK,
+                  typename DataT,
+                  typename DataLayoutT>
+        struct SuperFragment;
+
+    } // namespace detail
+    // @endcond
+
+    //! Super-block fragment: a fragment_array of native mma blocks covering a SuperM x SuperN
+    //! block, with the BlockK, data type and data layout of a fragment.
+    //! @tparam MatrixT fragment context
+    //! @tparam SuperM/SuperN/BlockK super-block dimensions, SuperM and SuperN multiples of 16
+    //! @tparam DataT datatype
+    //! @tparam DataLayoutT in-memory layout as col_major or row_major
+    template <typename MatrixT,
+              uint32_t SuperM,
+              uint32_t SuperN,
+              uint32_t BlockK,
+              typename DataT,
+              typename DataLayoutT = void>
+    using super_fragment =
+        typename detail::SuperFragment<MatrixT, SuperM, SuperN, BlockK, DataT, DataLayoutT>::Type;
+
+    // @cond
+    namespace detail
+    {
+        template <typename FragT, uint32_t K0, uint32_t K1>
+        struct FragmentSlice;
+
+    } // namespace detail
+    // @endcond
+
+    //! Fragment type of the K range [K0, K1) of a matrix_a or matrix_b fragment
+    template <typename FragT, uint32_t K0, uint32_t K1>
+    using fragment_slice_t = typename detail::FragmentSlice<FragT, K0, K1>::Type;
+
+    //! Zero-copy view of the K range [K0, K1) of a fragment, aliasing its registers
+    //! @tparam K0 First K index of the slice
+    //! @tparam K1 One past the last K index of the slice. K1 - K0 must divide K0 and BlockK
+    //! @param frag matrix_a or matrix_b fragment
+    //! @returns The slice as a fragment of BlockK = K1 - K0
+    template <uint32_t K0, uint32_t K1, typename FragT>
+    ROCWMMA_DEVICE inline fragment_slice_t<FragT, K0, K1>& fragment_slice(FragT& frag);
+
+    //! Zero-copy view of the K range [K0, K1) of a fragment, aliasing its registers
+    //! @tparam K0 First K index of the slice
+    //! @tparam K1 One past the last K index of the slice. K1 - K0 must divide K0 and BlockK
+    //! @param frag matrix_a or matrix_b fragment
+    //! @returns The immutable slice as a fragment of BlockK = K1 - K0
+    template <uint32_t K0, uint32_t K1, typename FragT>
+    ROCWMMA_DEVICE inline fragment_slice_t<FragT, K0, K1> const&
+        fragment_slice(FragT const& frag);
+
+    //! Fills every block of the fragment array with the same value
+    //! @param frags Fragment array to fill
+    //! @param value Value to fill the fragments with
+    template <typename FragT, uint32_t BlocksX, uint32_t BlocksY>
+    ROCWMMA_DEVICE inline void fill_fragment(fragment_array<FragT, BlocksX, BlocksY>& frags,
+                                             GetDataType_t<FragT>                     value);
+
+    //! Loads every block of the fragment array from the tile at data
+    //! @param frags Fragment array to load
+    //! @param data Data pointer to the top left of the tile, in global or local memory
+    //! @param ldm Leading dimension size
+    template <typename FragT, uint32_t BlocksX, uint32_t BlocksY>
+    ROCWMMA_DEVICE inline void load_matrix_sync(fragment_array<FragT, BlocksX, BlocksY>& frags,
+                                                const GetDataType_t<FragT>*              data,
+                                                uint32_t                                 ldm);
+
+    //! Loads every block of the fragment array from the aligned tile at data, with vectors of at most AlignBytes
+    //! @param frags Fragment array to load
+    //! @param data Aligned data pointer to the top left of the tile, in global or local memory
+    //! @param ldm Leading dimension size, with ldm * sizeof(DataT) a multiple of AlignBytes
+    template <typename FragT,
+              uint32_t BlocksX,
+              uint32_t BlocksY,
+              typename PtrDataT,
+              uint32_t AlignBytes>
+    ROCWMMA_DEVICE inline void load_matrix_sync(fragment_array<FragT, BlocksX, BlocksY>& frags,
+                                                aligned_ptr<PtrDataT, AlignBytes>        data,
+                                                uint32_t                                 ldm);
+
+    //! Loads every block of the accumulator fragment array from the tile at data
+    //! @param frags Fragment array of accumulator fragments without data layout
+    //! @param data Data pointer to the top left of the tile, in global or local memory
+    //! @param ldm Leading dimension size
+    //! @param layout Data layout of the tile in memory
+    template <typename FragT, uint32_t BlocksX, uint32_t BlocksY>
+    ROCWMMA_DEVICE inline void load_matrix_sync(fragment_array<FragT, BlocksX, BlocksY>& frags,
+                                                const GetDataType_t<FragT>*              data,
+                                                uint32_t                                 ldm,
+                                                layout_t                                 layout);
+
+    //! Stores every block of the fragment array to the tile at data
+    //! @param data Data pointer to the top left of the tile, in global or local memory
+    //! @param frags Fragment array to store
+    //! @param ldm Leading dimension size
+    template <typename FragT, uint32_t BlocksX, uint32_t BlocksY>
+    ROCWMMA_DEVICE inline void
+        store_matrix_sync(GetDataType_t<FragT>*                          data,
+                          fragment_array<FragT, BlocksX, BlocksY> const& frags,
+                          uint32_t                                       ldm);
+
+    //! Stores every block of the fragment array to the aligned tile at data, with vectors of at most AlignBytes
+    //! @param data Aligned data pointer to the top left of the tile, in global or local memory
+    //! @param frags Fragment array to store
+    //! @param ldm Leading dimension size, with ldm * sizeof(DataT) a multiple of AlignBytes
+    template <typename FragT, uint32_t BlocksX, uint32_t BlocksY, uint32_t AlignBytes>
+    ROCWMMA_DEVICE inline void
+        store_matrix_sync(aligned_ptr<GetDataType_t<FragT>, AlignBytes>  data,
+                          fragment_array<FragT, BlocksX, BlocksY> const& frags,
+                          uint32_t                                       ldm);
+
+    //! Stores every block of the accumulator fragment array to the tile at data
+    //! @param data Data pointer to the top left of the tile, in global or local memory
+    //! @param frags Fragment array of accumulator fragments without data layout
+    //! @param ldm Leading dimension size
+    //! @param layout Data layout of the tile in memory
+    template <typename FragT, uint32_t BlocksX, uint32_t BlocksY>
+    ROCWMMA_DEVICE inline void
+        store_matrix_sync(GetDataType_t<FragT>*                          data,
+                          fragment_array<FragT, BlocksX, BlocksY> const& frags,
+                          uint32_t                                       ldm,
+                          layout_t                                       layout);
+
+    //! Performs the warp tile multiply-accumulate D = A x B + C, one mma_sync per block of D,
+    //! in serpentine order
+    //! @param d Accumulator output D, BlocksX x BlocksY blocks
+    //! @param a Input A, BlocksX x 1 blocks
+    //! @param b Input B, 1 x BlocksY blocks
+    //! @param c Input accumulator C, BlocksX x BlocksY blocks
+    //! @note d and c may be the same fragment array
+    template <typename FragA,
+              typename FragB,
+              typename FragAccOut,
+              typename FragAccIn,
+              uint32_t BlocksX,
+              uint32_t BlocksY>
+    ROCWMMA_DEVICE inline void mma_sync(fragment_array<FragAccOut, BlocksX, BlocksY>&      d,
+                                        fragment_array<FragA, BlocksX, 1u> const&          a,
+                                        fragment_array<FragB, 1u, BlocksY> const&          b,
+                                        fragment_array<FragAccIn, BlocksX, BlocksY> const& c);
+
+    //! @struct warp_tile_params
+    //! @brief Launch parameters of a warp_tile_config, as runtime values for host code
+    struct warp_tile_params
+    {
+        uint32_t block_m;
+        uint32_t block_n;
+        uint32_t block_k;
+        uint32_t blocks_x;
+        uint32_t blocks_y;
+        uint32_t tblock_x;
+        uint32_t tblock_y;
+        uint32_t wave_size;
+    };
+
+    // @cond
+    namespace detail
+    {
+        template <uint32_t ArchId, typename DataT>
+        struct WarpTileTuning;
+
+    } // namespace detail
+    // @endcond
+
+    //! @struct warp_tile_config
+    //! @brief Validated warp tile defaults of a target architecture for input DataT
+    //! @tparam ArchId Target arch ID, one of the Constants::AMDGCN_ARCH_ID values. The host
+    //! pass (AMDGCN_ARCH_ID_NONE) uses the gfx9 defaults.
+    //! @tparam DataT Input datatype of matrix_a and matrix_b
+    template <uint32_t ArchId, typename DataT>
+    struct warp_tile_config
+    {
+    private:
+        using Tuning = detail::WarpTileTuning<ArchId, DataT>;
+
+    public:
+        //! Mma block size of each fragment
+        constexpr static uint32_t block_m = Tuning::BlockM;
+        constexpr static uint32_t block_n = Tuning::BlockN;
+        constexpr static uint32_t block_k = Tuning::BlockK;
+
+        //! Blocks per wave, in the row (M) and column (N) directions
+        constexpr static uint32_t blocks_x = Tuning::BlocksX;
+        constexpr static uint32_t blocks_y = Tuning::BlocksY;
+
+        //! Workgroup shape, in threads. tblock_x is a multiple of wave_size.
+        constexpr static uint32_t tblock_x  = Tuning::TBlockX;
+        constexpr static uint32_t tblock_y  = Tuning::TBlockY;
+        constexpr static uint32_t wave_size = Tuning::WaveSize;
+
+        //! Data layout of the A and B macro tiles staged in LDS
+        using lds_layout = typename Tuning::LdsLayout;
+
+        //! Warp tile computed by each wave, and macro tile computed by each workgroup
+        constexpr static uint32_t warp_tile_x  = blocks_x * block_m;
+        constexpr static uint32_t warp_tile_y  = blocks_y * block_n;
+        constexpr static uint32_t warps_x      = tblock_x / wave_size;
+        constexpr static uint32_t warps_y      = tblock_y;
+        constexpr static uint32_t macro_tile_x = warps_x * warp_tile_x;
+        constexpr static uint32_t macro_tile_y = warps_y * warp_tile_y;
+
+        static_assert(tblock_x % wave_size == 0u, "tblock_x must be a multiple of wave_size");
+
+        //! @returns The config as runtime launch parameters
+        ROCWMMA_HOST_DEVICE constexpr static inline warp_tile_params params();
+    };
+
+    //! Warp tile config of the target currently being compiled
+    template <typename DataT>
+    using warp_tile_config_t = warp_tile_config<Constants::AMDGCN_CURRENT_ARCH_ID, DataT>;
+
+    //! Selects the warp tile config of a device at runtime
+    //! @tparam DataT Input datatype of matrix_a and matrix_b
+    //! @param archId Arch ID of the device, one of the Constants::AMDGCN_ARCH_ID values
+    //! @returns The launch parameters of warp_tile_config<archId, DataT>. Unsupported arch IDs
+    //! return the host pass (gfx9) defaults.
+    template <typename DataT>
+    ROCWMMA_HOST constexpr inline warp_tile_params get_warp_tile_params(uint32_t archId);
+
+    namespace raster
+    {
+        //! @struct linear
+        //! @brief Launch grid order: tile index t maps to (t % tilesX, t / tilesX)
+        struct linear
+        {
+            //! @param tileIndex Linear index of the tile, in [0, tilesX * tilesY)
+            //! @param tilesX Number of tiles in the row (M) direction
+            //! @param tilesY Number of tiles in the column (N) direction
+            //! @returns The 2D tile coordinate
+            ROCWMMA_HOST_DEVICE constexpr static inline Coord2d
+                tile_coord(uint32_t tileIndex, uint32_t tilesX, uint32_t tilesY);
+        };
+
+        //! @struct grouped
+        //! @brief Visits tiles column by column within bands of GroupX tile rows. The last
+        //! band may be partial.
+        //! @tparam GroupX Band height, in tiles
+        //!
+        //! E.g. GroupX = 2, tilesX = 4, tilesY = 3:
+        //!
+        //!     0  2  4
+        //!     1  3  5
+        //!     6  8 10
+        //!     7  9 11
+        template <uint32_t GroupX>
+        struct grouped
+        {
+            static_assert(GroupX > 0u, "Band height must be at least 1 tile");
+
+            ROCWMMA_HOST_DEVICE constexpr static inline Coord2d
+                tile_coord(uint32_t tileIndex, uint32_t tilesX, uint32_t tilesY);
+        };
+
+        //! @struct morton
+        //! @brief Visits tiles in Z-order within super-tiles of 2^Order x 2^Order tiles.
+        //! Super-tiles are visited left to right within bands of 2^Order tile rows. Partial
+        //! super-tiles at the edges are visited column by column.
+        //! @tparam Order Log2 of the super-tile side, in tiles
+        template <uint32_t Order>
+        struct morton
+        {
+            static_assert(Order > 0u && Order < 16u, "Order must be in [1, 16)");
+
+            ROCWMMA_HOST_DEVICE constexpr static inline Coord2d
+                tile_coord(uint32_t tileIndex, uint32_t tilesX, uint32_t tilesY);
+        };
+
+        //! @struct hilbert
+        //! @brief Visits tiles along the Hilbert curve within super-tiles of 2^Order x 2^Order
+        //! tiles, with the super-tile order of morton. Consecutive tiles are always adjacent
+        //! within a super-tile.
+        //! @tparam Order Log2 of the super-tile side, in tiles
+        template <uint32_t Order>
+        struct hilbert
+        {
+            static_assert(Order > 0u && Order < 16u, "Order must be in [1, 16)");
+
+            ROCWMMA_HOST_DEVICE constexpr static inline Coord2d
+                tile_coord(uint32_t tileIndex, uint32_t tilesX, uint32_t tilesY);
+        };
+
+        //! @struct xcd
+        //! @brief Distributes the tiles of Inner in contiguous ranges over XcdCount XCDs.
+        //! Workgroup IDs are dispatched round-robin over the XCDs, such that XCD x runs IDs
+        //! x, x + XcdCount, ... Those IDs are remapped to the x-th range of Inner tile
+        //! indices, which share panels in the private L2 of the XCD.
+        //! @tparam XcdCount Number of XCDs, e.g. 8 on MI300X
+        //! @tparam Inner Rasterization policy of the remapped tile indices
+        template <uint32_t XcdCount, typename Inner = grouped<4u>>
+        struct xcd
+        {
+            static_assert(XcdCount > 0u, "XCD count must be at least 1");
+
+            ROCWMMA_HOST_DEVICE constexpr static inline Coord2d
+                tile_coord(uint32_t tileIndex, uint32_t tilesX, uint32_t tilesY);
+        };
+
+    } // namespace raster
+
+    //! Maps the current workgroup to its macro tile through a rasterization policy, over a
+    //! launch grid of gridDim.x x gridDim.y tiles
+    //! @tparam RasterPolicy One of the raster policies
+    //! @returns The 2D tile coordinate of the current workgroup
+    template <typename RasterPolicy>
+    ROCWMMA_DEVICE inline Coord2d raster_workgroup_coord();
+
+} // namespace rocwmma
+
+#include "rocwmma_tile_impl.hpp"
+
+#endif // ROCWMMA_TILE_API_HPP
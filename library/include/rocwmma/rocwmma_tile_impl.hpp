@@ -0,0 +1,601 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_TILE_API_IMPL_HPP
+#define ROCWMMA_TILE_API_IMPL_HPP
+
+#include "rocwmma_tile.hpp"
+
+namespace rocwmma
+{
+    // @cond
+    namespace detail
+    {
+        // Offset of block (i, j) of the fragment array from the top left of its tile
+        template <typename FragArrayT, typename Mapper1d>
+        ROCWMMA_DEVICE constexpr inline auto
+            fragmentArrayOffset(uint32_t i, uint32_t j, uint32_t ldm)
+        {
+            return Mapper1d::fromMatrixCoord(
+                make_coord2d(i * FragArrayT::block_height, j * FragArrayT::block_width), ldm);
+        }
+
+        // Alignment of each block of the fragment array, with the tile aligned to AlignBytes.
+        // Blocks are offset by multiples of the block size in the contiguous direction.
+        template <typename FragArrayT, typename Mapper1d, uint32_t AlignBytes>
+        constexpr inline uint32_t fragmentArrayAlign()
+        {
+            constexpr uint32_t BlockBytes
+                = (is_same_v<Mapper1d, DataLayout::RowMajor> ? FragArrayT::block_width
+                                                             : FragArrayT::block_height)
+                  * (uint32_t)sizeof(GetDataType_t<typename FragArrayT::fragment_type>);
+            constexpr uint32_t BlockAlign = BlockBytes & (~BlockBytes + 1u);
+            return BlockAlign < AlignBytes ? BlockAlign : AlignBytes;
+        }
+
+        // Visits the blocks (i, j) of a fragment array with the blocks adjacent in the
+        // contiguous direction of the data layout innermost. The IO of consecutive blocks
+        // then sweeps one contiguous span of the super-block.
+        template <bool IsRowMajor, uint32_t BlocksX, uint32_t BlocksY, typename FuncT>
+        ROCWMMA_DEVICE inline void forEachBlock(FuncT&& func)
+        {
+            constexpr uint32_t OuterCount = IsRowMajor ? BlocksX : BlocksY;
+            constexpr uint32_t InnerCount = IsRowMajor ? BlocksY : BlocksX;
+
+#pragma unroll
+            for(uint32_t outer = 0u; outer < OuterCount; outer++)
+            {
+#pragma unroll
+                for(uint32_t inner = 0u; inner < InnerCount; inner++)
+                {
+                    if constexpr(IsRowMajor)
+                    {
+                        func(outer, inner);
+                    }
+                    else
+                    {
+                        func(inner, outer);
+                    }
+                }
+            }
+        }
+
+        // Native block size of super fragments. The 32 x 32 mma of gfx9 reuse each
+        // operand element twice as often as 16 x 16 mma, and their IO covers twice the
+        // contiguous span of 16 x 16 blocks. f64 mma, and the wmma of gfx11 and gfx12,
+        // only have 16 x 16 blocks.
+        template <uint32_t SuperM, uint32_t SuperN, typename DataT>
+        struct SuperBlockNativeDim
+        {
+            static_assert(SuperM % 16u == 0u && SuperN % 16u == 0u,
+                          "Super-block dimensions must be multiples of 16");
+
+            enum : uint32_t
+            {
+                Value = ((bool)ROCWMMA_ARCH_GFX9 && !is_same_v<DataT, float64_t>
+                         && SuperM % 32u == 0u && SuperN % 32u == 0u)
+                            ? 32u
+                            : 16u
+            };
+        };
+
+        template <uint32_t SuperM,
+                  uint32_t SuperN,
+                  uint32_t BlockK,
+                  typename DataT,
+                  typename DataLayoutT>
+        struct SuperFragment<matrix_a, SuperM, SuperN, BlockK, DataT, DataLayoutT>
+        {
+            using NativeDim = SuperBlockNativeDim<SuperM, SuperN, DataT>;
+            using Type      = fragment_array<
+                fragment<matrix_a, NativeDim::Value, NativeDim::Value, BlockK, DataT, DataLayoutT>,
+                SuperM / NativeDim::Value,
+                1u>;
+        };
+
+        template <uint32_t SuperM,
+                  uint32_t SuperN,
+                  uint32_t BlockK,
+                  typename DataT,
+                  typename DataLayoutT>
+        struct SuperFragment<matrix_b, SuperM, SuperN, BlockK, DataT, DataLayoutT>
+        {
+            using NativeDim = SuperBlockNativeDim<SuperM, SuperN, DataT>;
+            using Type      = fragment_array<
+                fragment<matrix_b, NativeDim::Value, NativeDim::Value, BlockK, DataT, DataLayoutT>,
+                1u,
+                SuperN / NativeDim::Value>;
+        };
+
+        template <uint32_t SuperM,
+                  uint32_t SuperN,
+                  uint32_t BlockK,
+                  typename DataT,
+                  typename DataLayoutT>
+        struct SuperFragment<accumulator, SuperM, SuperN, BlockK, DataT, DataLayoutT>
+        {
+            using NativeDim = SuperBlockNativeDim<SuperM, SuperN, DataT>;
+            using Type      = fragment_array<fragment<accumulator,
+                                                      NativeDim::Value,
+                                                      NativeDim::Value,
+                                                      BlockK,
+                                                      DataT,
+                                                      DataLayoutT>,
+                                             SuperM / NativeDim::Value,
+                                             SuperN / NativeDim::Value>;
+        };
+
+        // Fragment storage is ordered by mma step, each step over the same subset of K in
+        // matrix_a and matrix_b. An even partition of K is then a partition of the packed
+        // registers, slice i being the i-th range of registers.
+        template <typename MatrixT,
+                  uint32_t BlockM,
+                  uint32_t BlockN,
+                  uint32_t BlockK,
+                  typename DataT,
+                  typename DataLayoutT,
+                  uint32_t K0,
+                  uint32_t K1>
+        struct FragmentSlice<fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>, K0, K1>
+        {
+            static_assert(!is_same_v<MatrixT, accumulator>,
+                          "Only matrix_a and matrix_b fragments can be sliced in K");
+            static_assert(K0 < K1 && K1 <= BlockK, "Slice must be a non-empty range of K");
+            static_assert(K0 % (K1 - K0) == 0u && BlockK % (K1 - K0) == 0u,
+                          "Slices must evenly partition K");
+
+            using FragT = fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>;
+            using Type  = fragment<MatrixT, BlockM, BlockN, K1 - K0, DataT, DataLayoutT>;
+
+            using FragStorageT  = typename FragT::Traits::StorageT;
+            using SliceStorageT = typename Type::Traits::StorageT;
+
+            static_assert(VecTraits<SliceStorageT>::size() * (BlockK / (K1 - K0))
+                              == VecTraits<FragStorageT>::size(),
+                          "Slice registers must partition the fragment registers");
+
+            enum : uint32_t
+            {
+                // Offset of the slice, in packed elements
+                Offset = VecTraits<SliceStorageT>::size() * (K0 / (K1 - K0))
+            };
+
+            using PackedT = typename VecTraits<FragStorageT>::DataT;
+
+            ROCWMMA_DEVICE static inline Type& exec(FragT& frag)
+            {
+                return *reinterpret_cast<Type*>(reinterpret_cast<PackedT*>(&(*frag)) + Offset);
+            }
+
+            ROCWMMA_DEVICE static inline Type const& exec(FragT const& frag)
+            {
+                return *reinterpret_cast<Type const*>(reinterpret_cast<PackedT const*>(&(*frag))
+                                                      + Offset);
+            }
+        };
+
+        // Band of super-tiles common to morton and hilbert: Side x Side super-tiles
+        // left to right within bands of Side tile rows. Full super-tiles are visited by
+        // CurveT, partial super-tiles at the edges column by column.
+        template <uint32_t Side, typename CurveT>
+        ROCWMMA_HOST_DEVICE constexpr inline Coord2d
+            superTileCoord(uint32_t tileIndex, uint32_t tilesX, uint32_t tilesY, CurveT curve)
+        {
+            auto bandStart = tileIndex / (Side * tilesY) * Side;
+            auto bandIndex = tileIndex - bandStart * tilesY;
+            auto height    = (tilesX - bandStart) < Side ? (tilesX - bandStart) : Side;
+
+            auto colStart = bandIndex / (height * Side) * Side;
+            auto local    = bandIndex - colStart * height;
+            auto width    = (tilesY - colStart) < Side ? (tilesY - colStart) : Side;
+
+            auto coord = (height == Side && width == Side)
+                             ? curve(local)
+                             : make_coord2d(local % height, local / height);
+
+            return make_coord2d(bandStart + get<0>(coord), colStart + get<1>(coord));
+        }
+
+    } // namespace detail
+    // @endcond
+
+    template <typename FragT, uint32_t BlocksX, uint32_t BlocksY>
+    ROCWMMA_DEVICE inline FragT&
+        fragment_array<FragT, BlocksX, BlocksY>::operator()(uint32_t i, uint32_t j)
+    {
+        return frags[i][j];
+    }
+
+    template <typename FragT, uint32_t BlocksX, uint32_t BlocksY>
+    ROCWMMA_DEVICE inline FragT const&
+        fragment_array<FragT, BlocksX, BlocksY>::operator()(uint32_t i, uint32_t j) const
+    {
+        return frags[i][j];
+    }
+
+    template <uint32_t K0, uint32_t K1, typename FragT>
+    ROCWMMA_DEVICE inline fragment_slice_t<FragT, K0, K1>& fragment_slice(FragT& frag)
+    {
+        return detail::FragmentSlice<FragT, K0, K1>::exec(frag);
+    }
+
+    template <uint32_t K0, uint32_t K1, typename FragT>
+    ROCWMMA_DEVICE inline fragment_slice_t<FragT, K0, K1> const&
+        fragment_slice(FragT const& frag)
+    {
+        return detail::FragmentSlice<FragT, K0, K1>::exec(frag);
+    }
+
+    template <typename FragT, uint32_t BlocksX, uint32_t BlocksY>
+    ROCWMMA_DEVICE inline void fill_fragment(fragment_array<FragT, BlocksX, BlocksY>& frags,
+                                             GetDataType_t<FragT>                     value)
+    {
+#pragma unroll
+        for(uint32_t i = 0u; i < BlocksX; i++)
+        {
+#pragma unroll
+            for(uint32_t j = 0u; j < BlocksY; j++)
+            {
+                fill_fragment(frags(i, j), value);
+            }
+        }
+    }
+
+    template <typename FragT, uint32_t BlocksX, uint32_t BlocksY>
+    ROCWMMA_DEVICE inline void load_matrix_sync(fragment_array<FragT, BlocksX, BlocksY>& frags,
+                                                const GetDataType_t<FragT>*              data,
+                                                uint32_t                                 ldm)
+    {
+        using FragArrayT = fragment_array<FragT, BlocksX, BlocksY>;
+        using Mapper1d   = GetDataLayout_t<FragT>;
+
+        detail::forEachBlock<is_same_v<Mapper1d, DataLayout::RowMajor>, BlocksX, BlocksY>(
+            [&](uint32_t i, uint32_t j) {
+                load_matrix_sync(
+                    frags(i, j),
+                    data + detail::fragmentArrayOffset<FragArrayT, Mapper1d>(i, j, ldm),
+                    ldm);
+            });
+    }
+
+    template <typename FragT,
+              uint32_t BlocksX,
+              uint32_t BlocksY,
+              typename PtrDataT,
+              uint32_t AlignBytes>
+    ROCWMMA_DEVICE inline void load_matrix_sync(fragment_array<FragT, BlocksX, BlocksY>& frags,
+                                                aligned_ptr<PtrDataT, AlignBytes>        data,
+                                                uint32_t                                 ldm)
+    {
+        using FragArrayT = fragment_array<FragT, BlocksX, BlocksY>;
+        using Mapper1d   = GetDataLayout_t<FragT>;
+
+        constexpr uint32_t BlockAlign
+            = detail::fragmentArrayAlign<FragArrayT, Mapper1d, AlignBytes>();
+
+        detail::forEachBlock<is_same_v<Mapper1d, DataLayout::RowMajor>, BlocksX, BlocksY>(
+            [&](uint32_t i, uint32_t j) {
+                load_matrix_sync(
+                    frags(i, j),
+                    make_aligned_ptr<BlockAlign>(
+                        data.ptr + detail::fragmentArrayOffset<FragArrayT, Mapper1d>(i, j, ldm)),
+                    ldm);
+            });
+    }
+
+    template <typename FragT, uint32_t BlocksX, uint32_t BlocksY>
+    ROCWMMA_DEVICE inline void load_matrix_sync(fragment_array<FragT, BlocksX, BlocksY>& frags,
+                                                const GetDataType_t<FragT>*              data,
+                                                uint32_t                                 ldm,
+                                                layout_t                                 layout)
+    {
+        using FragArrayT = fragment_array<FragT, BlocksX, BlocksY>;
+        using RowMajor1d = DataLayout::RowMajor;
+        using ColMajor1d = DataLayout::ColMajor;
+
+        if(layout == mem_row_major)
+        {
+            detail::forEachBlock<true, BlocksX, BlocksY>([&](uint32_t i, uint32_t j) {
+                auto offset = detail::fragmentArrayOffset<FragArrayT, RowMajor1d>(i, j, ldm);
+                load_matrix_sync(frags(i, j), data + offset, ldm, layout);
+            });
+        }
+        else
+        {
+            detail::forEachBlock<false, BlocksX, BlocksY>([&](uint32_t i, uint32_t j) {
+                auto offset = detail::fragmentArrayOffset<FragArrayT, ColMajor1d>(i, j, ldm);
+                load_matrix_sync(frags(i, j), data + offset, ldm, layout);
+            });
+        }
+    }
+
+    template <typename FragT, uint32_t BlocksX, uint32_t BlocksY>
+    ROCWMMA_DEVICE inline void
+        store_matrix_sync(GetDataType_t<FragT>*                          data,
+                          fragment_array<FragT, BlocksX, BlocksY> const& frags,
+                          uint32_t                                       ldm)
+    {
+        using FragArrayT = fragment_array<FragT, BlocksX, BlocksY>;
+        using Mapper1d   = GetDataLayout_t<FragT>;
+
+        detail::forEachBlock<is_same_v<Mapper1d, DataLayout::RowMajor>, BlocksX, BlocksY>(
+            [&](uint32_t i, uint32_t j) {
+                store_matrix_sync(
+                    data + detail::fragmentArrayOffset<FragArrayT, Mapper1d>(i, j, ldm),
+                    frags(i, j),
+                    ldm);
+            });
+    }
+
+    template <typename FragT, uint32_t BlocksX, uint32_t BlocksY, uint32_t AlignBytes>
+    ROCWMMA_DEVICE inline void
+        store_matrix_sync(aligned_ptr<GetDataType_t<FragT>, AlignBytes>  data,
+                          fragment_array<FragT, BlocksX, BlocksY> const& frags,
+                          uint32_t                                       ldm)
+    {
+        using FragArrayT = fragment_array<FragT, BlocksX, BlocksY>;
+        using Mapper1d   = GetDataLayout_t<FragT>;
+
+        constexpr uint32_t BlockAlign
+            = detail::fragmentArrayAlign<FragArrayT, Mapper1d, AlignBytes>();
+
+        detail::forEachBlock<is_same_v<Mapper1d, DataLayout::RowMajor>, BlocksX, BlocksY>(
+            [&](uint32_t i, uint32_t j) {
+                store_matrix_sync(
+                    make_aligned_ptr<BlockAlign>(
+                        data.ptr + detail::fragmentArrayOffset<FragArrayT, Mapper1d>(i, j, ldm)),
+                    frags(i, j),
+                    ldm);
+            });
+    }
+
+    template <typename FragT, uint32_t BlocksX, uint32_t BlocksY>
+    ROCWMMA_DEVICE inline void
+        store_matrix_sync(GetDataType_t<FragT>*                          data,
+                          fragment_array<FragT, BlocksX, BlocksY> const& frags,
+                          uint32_t                                       ldm,
+                          layout_t                                       layout)
+    {
+        using FragArrayT = fragment_array<FragT, BlocksX, BlocksY>;
+        using RowMajor1d = DataLayout::RowMajor;
+        using ColMajor1d = DataLayout::ColMajor;
+
+        if(layout == mem_row_major)
+        {
+            detail::forEachBlock<true, BlocksX, BlocksY>([&](uint32_t i, uint32_t j) {
+                auto offset = detail::fragmentArrayOffset<FragArrayT, RowMajor1d>(i, j, ldm);
+                store_matrix_sync(data + offset, frags(i, j), ldm, layout);
+            });
+        }
+        else
+        {
+            detail::forEachBlock<false, BlocksX, BlocksY>([&](uint32_t i, uint32_t j) {
+                auto offset = detail::fragmentArrayOffset<FragArrayT, ColMajor1d>(i, j, ldm);
+                store_matrix_sync(data + offset, frags(i, j), ldm, layout);
+            });
+        }
+    }
+
+    template <typename FragA,
+              typename FragB,
+              typename FragAccOut,
+              typename FragAccIn,
+              uint32_t BlocksX,
+              uint32_t BlocksY>
+    ROCWMMA_DEVICE inline void mma_sync(fragment_array<FragAccOut, BlocksX, BlocksY>&      d,
+                                        fragment_array<FragA, BlocksX, 1u> const&          a,
+                                        fragment_array<FragB, 1u, BlocksY> const&          b,
+                                        fragment_array<FragAccIn, BlocksX, BlocksY> const& c)
+    {
+        // Serpentine order: odd rows of blocks run right to left, such that the
+        // B fragment of the last product of a row is the first of the next.
+#pragma unroll
+        for(uint32_t i = 0u; i < BlocksX; i++)
+        {
+#pragma unroll
+            for(uint32_t k = 0u; k < BlocksY; k++)
+            {
+                auto j = (i % 2u == 0u) ? k : BlocksY - 1u - k;
+                mma_sync(d(i, j), a(i, 0u), b(0u, j), c(i, j));
+            }
+        }
+    }
+
+    // @cond
+    namespace detail
+    {
+        // Warp tiles validated on perf_hgemm. gfx9 uses 32 x 32 blocks of wave64 mfma, or
+        // 16 x 16 for float64_t which has no 32 x 32 mfma. gfx11 and gfx12 use 16 x 16 blocks
+        // of wave32 wmma. 8-bit inputs double BlockK, keeping the bytes read per K step.
+        template <uint32_t ArchId, typename DataT>
+        struct WarpTileTuning
+        {
+        private:
+            constexpr static bool IsWave32 = ArchId == Constants::AMDGCN_ARCH_ID_GFX1100
+                                             || ArchId == Constants::AMDGCN_ARCH_ID_GFX1101
+                                             || ArchId == Constants::AMDGCN_ARCH_ID_GFX1102
+                                             || ArchId == Constants::AMDGCN_ARCH_ID_GFX1200
+                                             || ArchId == Constants::AMDGCN_ARCH_ID_GFX1201;
+
+        public:
+            constexpr static uint32_t BlockM
+                = (IsWave32 || is_same_v<DataT, float64_t>) ? 16u : 32u;
+            constexpr static uint32_t BlockN   = BlockM;
+            constexpr static uint32_t BlockK   = sizeof(DataT) == 1u ? 32u : 16u;
+            constexpr static uint32_t BlocksX  = IsWave32 ? 4u : 2u;
+            constexpr static uint32_t BlocksY  = 2u;
+            constexpr static uint32_t TBlockX  = IsWave32 ? 64u : 128u;
+            constexpr static uint32_t TBlockY  = IsWave32 ? 4u : 2u;
+            constexpr static uint32_t WaveSize = IsWave32 ? Constants::AMDGCN_WAVE_SIZE_32
+                                                          : Constants::AMDGCN_WAVE_SIZE_64;
+
+            using LdsLayout = col_major;
+        };
+
+    } // namespace detail
+    // @endcond
+
+    template <uint32_t ArchId, typename DataT>
+    ROCWMMA_HOST_DEVICE constexpr inline warp_tile_params
+        warp_tile_config<ArchId, DataT>::params()
+    {
+        return {block_m, block_n, block_k, blocks_x, blocks_y, tblock_x, tblock_y, wave_size};
+    }
+
+    template <typename DataT>
+    ROCWMMA_HOST constexpr inline warp_tile_params get_warp_tile_params(uint32_t archId)
+    {
+        switch(archId)
+        {
+        case Constants::AMDGCN_ARCH_ID_GFX908:
+            return warp_tile_config<Constants::AMDGCN_ARCH_ID_GFX908, DataT>::params();
+        case Constants::AMDGCN_ARCH_ID_GFX90A:
+            return warp_tile_config<Constants::AMDGCN_ARCH_ID_GFX90A, DataT>::params();
+        case Constants::AMDGCN_ARCH_ID_GFX940:
+            return warp_tile_config<Constants::AMDGCN_ARCH_ID_GFX940, DataT>::params();
+        case Constants::AMDGCN_ARCH_ID_GFX941:
+            return warp_tile_config<Constants::AMDGCN_ARCH_ID_GFX941, DataT>::params();
+        case Constants::AMDGCN_ARCH_ID_GFX942:
+            return warp_tile_config<Constants::AMDGCN_ARCH_ID_GFX942, DataT>::params();
+        case Constants::AMDGCN_ARCH_ID_GFX1100:
+            return warp_tile_config<Constants::AMDGCN_ARCH_ID_GFX1100, DataT>::params();
+        case Constants::AMDGCN_ARCH_ID_GFX1101:
+            return warp_tile_config<Constants::AMDGCN_ARCH_ID_GFX1101, DataT>::params();
+        case Constants::AMDGCN_ARCH_ID_GFX1102:
+            return warp_tile_config<Constants::AMDGCN_ARCH_ID_GFX1102, DataT>::params();
+        case Constants::AMDGCN_ARCH_ID_GFX1200:
+            return warp_tile_config<Constants::AMDGCN_ARCH_ID_GFX1200, DataT>::params();
+        case Constants::AMDGCN_ARCH_ID_GFX1201:
+            return warp_tile_config<Constants::AMDGCN_ARCH_ID_GFX1201, DataT>::params();
+        default:
+            return warp_tile_config<Constants::AMDGCN_ARCH_ID_NONE, DataT>::params();
+        }
+    }
+
+    namespace raster
+    {
+        ROCWMMA_HOST_DEVICE constexpr inline Coord2d
+            linear::tile_coord(uint32_t tileIndex, uint32_t tilesX, uint32_t tilesY)
+        {
+            return make_coord2d(tileIndex % tilesX, tileIndex / tilesX);
+        }
+
+        template <uint32_t GroupX>
+        ROCWMMA_HOST_DEVICE constexpr inline Coord2d
+            grouped<GroupX>::tile_coord(uint32_t tileIndex, uint32_t tilesX, uint32_t tilesY)
+        {
+            auto tilesPerBand = GroupX * tilesY;
+            auto bandStart    = tileIndex / tilesPerBand * GroupX;
+            auto bandIndex    = tileIndex % tilesPerBand;
+
+            // Last band may be partial
+            auto height = (tilesX - bandStart) < GroupX ? (tilesX - bandStart) : GroupX;
+
+            return make_coord2d(bandStart + bandIndex % height, bandIndex / height);
+        }
+
+        template <uint32_t Order>
+        ROCWMMA_HOST_DEVICE constexpr inline Coord2d
+            morton<Order>::tile_coord(uint32_t tileIndex, uint32_t tilesX, uint32_t tilesY)
+        {
+            // Even bits of the index are x, odd bits are y
+            auto curve = [](uint32_t d) {
+                uint32_t x = 0u;
+                uint32_t y = 0u;
+                for(uint32_t b = 0u; b < Order; b++)
+                {
+                    x |= ((d >> (2u * b)) & 1u) << b;
+                    y |= ((d >> (2u * b + 1u)) & 1u) << b;
+                }
+                return make_coord2d(x, y);
+            };
+
+            return rocwmma::detail::superTileCoord<1u << Order>(tileIndex, tilesX, tilesY, curve);
+        }
+
+        template <uint32_t Order>
+        ROCWMMA_HOST_DEVICE constexpr inline Coord2d
+            hilbert<Order>::tile_coord(uint32_t tileIndex, uint32_t tilesX, uint32_t tilesY)
+        {
+            // Builds the curve from the 2 x 2 base case up, rotating each quadrant
+            auto curve = [](uint32_t d) {
+                uint32_t x = 0u;
+                uint32_t y = 0u;
+                for(uint32_t s = 1u; s < (1u << Order); s *= 2u)
+                {
+                    uint32_t rx = 1u & (d / 2u);
+                    uint32_t ry = 1u & (d ^ rx);
+                    if(ry == 0u)
+                    {
+                        if(rx == 1u)
+                        {
+                            x = s - 1u - x;
+                            y = s - 1u - y;
+                        }
+                        auto t = x;
+                        x      = y;
+                        y      = t;
+                    }
+                    x += s * rx;
+                    y += s * ry;
+                    d /= 4u;
+                }
+                return make_coord2d(x, y);
+            };
+
+            return rocwmma::detail::superTileCoord<1u << Order>(tileIndex, tilesX, tilesY, curve);
+        }
+
+        template <uint32_t XcdCount, typename Inner>
+        ROCWMMA_HOST_DEVICE constexpr inline Coord2d
+            xcd<XcdCount, Inner>::tile_coord(uint32_t tileIndex, uint32_t tilesX, uint32_t tilesY)
+        {
+            // The first (tileCount % XcdCount) XCDs run one more tile than the others
+            auto tileCount = tilesX * tilesY;
+            auto perXcd    = tileCount / XcdCount;
+            auto remainder = tileCount % XcdCount;
+
+            auto xcdId = tileIndex % XcdCount;
+            auto local = tileIndex / XcdCount;
+
+            auto remapped = xcdId * perXcd + (xcdId < remainder ? xcdId : remainder) + local;
+            return Inner::tile_coord(remapped, tilesX, tilesY);
+        }
+
+    } // namespace raster
+
+    template <typename RasterPolicy>
+    ROCWMMA_DEVICE inline Coord2d raster_workgroup_coord()
+    {
+        auto tilesX    = static_cast<uint32_t>(gridDim.x);
+        auto tilesY    = static_cast<uint32_t>(gridDim.y);
+        auto tileIndex
+            = static_cast<uint32_t>(blockIdx.x) + static_cast<uint32_t>(blockIdx.y) * tilesX;
+        return RasterPolicy::tile_coord(tileIndex, tilesX, tilesY);
+    }
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_TILE_API_IMPL_HPP
@@ -65,6 +65,174 @@ namespace rocwmma
     template <typename DataLayoutT, uint32_t WaveCount = 1, typename FragT>
     ROCWMMA_DEVICE static inline decltype(auto) applyDataLayout(FragT&& frag);
 
+    //! Reinterprets an accumulator fragment holding C^T as the matrix_a fragment of C, without the use of LDS memory.
+    //! The result of one GEMM can feed the next GEMM directly from registers, e.g. computing H^T = W1^T x X^T
+    //! then H x W2 for back-to-back GEMMs.
+    //! E.g. T(fragment<accumulator, BlockM, BlockN, BlockK, DataT, col_major>) = fragment<matrix_a, BlockN, NextBlockN, BlockM, DataT, row_major>
+    //! @param frag Accumulator fragment of C^T, already converted to the input data type (e.g. with apply_epilogue)
+    //! @tparam NextBlockN The BlockN dimension of the following GEMM
+    //! @tparam FragT The incoming fragment type
+    //! @returns matrix_a fragment of C, whose BlockK is the BlockM of the accumulator
+    //! @note Requires matching accumulator and matrix_b register layouts, e.g. 16 x 16 blocks on gfx9,
+    //! or 16 x 16 blocks of 8 and 16-bit data on gfx12. Not available on gfx11.
+    template <uint32_t NextBlockN, typename FragT>
+    ROCWMMA_DEVICE static inline decltype(auto) applyAccumToMatrixA(FragT const& frag);
+
+    //! Matrix coordinates of the fragment elements held by the current lane, in the block of the fragment.
+    //! Element i of the lane is at (row(i), col(i)) of the BlockM x BlockK (matrix_a), BlockK x BlockN
+    //! (matrix_b) or BlockM x BlockN (accumulator) block, e.g. for masking, bias or position dependent
+    //! element-wise ops. Coordinates split into the lane dependent base(), computed once, and offset(i),
+    //! which folds to a compile-time constant for unrolled element indices.
+    //! @tparam FragT The fragment type
+    //! @note Accumulator elements are in the same register order in any data layout.
+    template <typename FragT>
+    struct fragment_coords
+    {
+        //! @returns Coordinate of the first element of the current lane
+        ROCWMMA_DEVICE static inline Coord2d base()
+        {
+            return detail::FragmentCoords<FragT>::base();
+        }
+
+        //! @param i Element index of the fragment
+        //! @returns Lane independent offset of element i from base()
+        ROCWMMA_DEVICE static inline Coord2d offset(uint32_t i)
+        {
+            return detail::FragmentCoords<FragT>::offset(i);
+        }
+
+        //! @param i Element index of the fragment
+        //! @returns Coordinate (row, col) of element i of the current lane
+        ROCWMMA_DEVICE static inline Coord2d coord(uint32_t i)
+        {
+            return base() + offset(i);
+        }
+
+        //! @param i Element index of the fragment
+        //! @returns Row of element i of the current lane
+        ROCWMMA_DEVICE static inline uint32_t row(uint32_t i)
+        {
+            return get<0>(coord(i));
+        }
+
+        //! @param i Element index of the fragment
+        //! @returns Column of element i of the current lane
+        ROCWMMA_DEVICE static inline uint32_t col(uint32_t i)
+        {
+            return get<1>(coord(i));
+        }
+    };
+
+    namespace reduce
+    {
+        //! Binary reduction operators for use with reduce_rows() and reduce_cols() below
+        struct Sum;
+        struct Max;
+        struct Min;
+
+    } // namespace reduce
+
+    //! Reduces each row of the accumulator fragment with ReduceOpT, without the use of LDS memory.
+    //! Every element of the result holds the reduction of its row. E.g. result(i, j) = max_k(frag(i, k))
+    //! @param frag Accumulator fragment with its associated block sizes, data type and layout
+    //! @tparam ReduceOpT The reduction operator, e.g. reduce::Sum, reduce::Max or reduce::Min
+    //! @tparam FragT The incoming fragment type
+    //! @returns Fragment of the row reductions, co-indexed with the input fragment
+    //! @note Data types smaller than 32 bits are reduced in float32_t
+    template <typename ReduceOpT, typename FragT>
+    ROCWMMA_DEVICE static inline FragT reduce_rows(FragT const& frag);
+
+    //! Reduces each column of the accumulator fragment with ReduceOpT, without the use of LDS memory.
+    //! Every element of the result holds the reduction of its column. E.g. result(i, j) = sum_k(frag(k, j))
+    //! @param frag Accumulator fragment with its associated block sizes, data type and layout
+    //! @tparam ReduceOpT The reduction operator, e.g. reduce::Sum, reduce::Max or reduce::Min
+    //! @tparam FragT The incoming fragment type
+    //! @returns Fragment of the column reductions, co-indexed with the input fragment
+    //! @note Data types smaller than 32 bits are reduced in float32_t
+    template <typename ReduceOpT, typename FragT>
+    ROCWMMA_DEVICE static inline FragT reduce_cols(FragT const& frag);
+
+    //! Online softmax over the rows of an accumulator fragment, as one column block of longer rows.
+    //! fragMax and fragSum hold the running row max and row sum of exp(scale * x - max) over the blocks
+    //! seen so far, and are updated with the block. frag is replaced by its un-normalized probabilities
+    //! exp(scale * frag - max). Once all blocks are seen, softmax(scale * x) = exp(scale * x - fragMax) / fragSum.
+    //! @param frag Accumulator fragment of the block, e.g. logits of a vocabulary projection GEMM
+    //! @param fragMax Running row max, co-indexed with frag
+    //! @param fragSum Running row sum, co-indexed with frag
+    //! @param scale Scale of the inputs, e.g. 1 / temperature
+    //! @tparam FragT The incoming fragment type
+    //! @returns Correction fragment exp(oldMax - newMax), to rescale results accumulated from
+    //! previous blocks, e.g. O = O * correction + P x V
+    //! @note fragMax must be initialized to numeric_limits<DataT>::lowest() and fragSum to 0 before
+    //! the first block. Data types smaller than 32 bits are evaluated in float32_t.
+    template <typename FragT>
+    ROCWMMA_DEVICE static inline FragT
+        online_softmax_rows(FragT& frag, FragT& fragMax, FragT& fragSum, float32_t scale = 1.0f);
+
+    //! Running top-K selection over the rows of an accumulator fragment, as one column block of longer rows.
+    //! vals and idx hold the K largest values of each row over the blocks seen so far, and their column
+    //! indices, sorted in descending order. They are updated with the block without the use of LDS memory.
+    //! Equal values rank by lower column first, provided blocks are visited in increasing column order.
+    //! @param frag Accumulator fragment of the block, e.g. logits of a vocabulary projection GEMM
+    //! @param colOffset Column index of the first column of the block
+    //! @param vals Sorted candidate values, co-indexed with frag
+    //! @param idx Candidate column indices, co-indexed with frag
+    //! @tparam K Number of candidates per row
+    //! @tparam FragT The incoming fragment type
+    //! @tparam FragIdxT int32_t accumulator fragment type of the same block sizes
+    //! @note vals must be initialized to numeric_limits<DataT>::lowest() and idx to -1 before the
+    //! first block. Rows with fewer than K values above lowest() keep -1 indices.
+    //! @note Blocks without a candidate for any row of the wave cost one row reduction. Not available
+    //! for float64_t, whose register layout differs from int32_t.
+    template <uint32_t K, typename FragT, typename FragIdxT>
+    ROCWMMA_DEVICE static inline void
+        topk_rows(FragT const& frag, uint32_t colOffset, FragT (&vals)[K], FragIdxT (&idx)[K]);
+
+    //! Running argmax over the rows of an accumulator fragment, as one column block of longer rows.
+    //! vals and idx hold the maximum of each row over the blocks seen so far, and its column index.
+    //! They are updated with the block without the use of LDS memory, at the cost of two row reductions.
+    //! Equal values keep the lower column, provided blocks are visited in increasing column order.
+    //! @param frag Accumulator fragment of the block, e.g. similarity scores of queries and documents
+    //! @param colOffset Column index of the first column of the block
+    //! @param vals Running row max, co-indexed with frag
+    //! @param idx Column index of the running row max, co-indexed with frag
+    //! @tparam FragT The incoming fragment type
+    //! @tparam FragIdxT int32_t accumulator fragment type of the same block sizes
+    //! @note vals must be initialized to numeric_limits<DataT>::lowest() and idx to -1 before the
+    //! first block. Not available for float64_t, whose register layout differs from int32_t.
+    template <typename FragT, typename FragIdxT>
+    ROCWMMA_DEVICE static inline void
+        argmax_rows(FragT const& frag, uint32_t colOffset, FragT& vals, FragIdxT& idx);
+
+    //! Running argmax over the columns of an accumulator fragment, as one row block of longer columns.
+    //! vals and idx hold the maximum of each column over the blocks seen so far, and its row index.
+    //! Equal values keep the lower row, provided blocks are visited in increasing row order.
+    //! @param frag Accumulator fragment of the block
+    //! @param rowOffset Row index of the first row of the block
+    //! @param vals Running column max, co-indexed with frag
+    //! @param idx Row index of the running column max, co-indexed with frag
+    //! @tparam FragT The incoming fragment type
+    //! @tparam FragIdxT int32_t accumulator fragment type of the same block sizes
+    //! @note vals must be initialized to numeric_limits<DataT>::lowest() and idx to -1 before the
+    //! first block. Not available for float64_t, whose register layout differs from int32_t.
+    template <typename FragT, typename FragIdxT>
+    ROCWMMA_DEVICE static inline void
+        argmax_cols(FragT const& frag, uint32_t rowOffset, FragT& vals, FragIdxT& idx);
+
+    //! Converts a float32_t accumulator fragment to OutputT with stochastic rounding.
+    //! Random bits come from a per-thread Philox4x32-10 stream keyed by seed, so the same
+    //! seed, offset and launch configuration reproduce the same result.
+    //! @param frag Accumulator fragment of float32_t with its associated block sizes and layout
+    //! @param seed Philox key for the random stream
+    //! @param offset Position in the random stream, e.g. the training step, for fresh random bits
+    //! @tparam OutputT The desired data type: bfloat16_t, float8_t or bfloat8_t
+    //! @tparam FragT The incoming fragment type
+    //! @returns Accumulator fragment of OutputT, co-indexed with the input fragment
+    //! @note float8_t and bfloat8_t use the hardware stochastic rounding conversions on gfx940+
+    template <typename OutputT, typename FragT>
+    ROCWMMA_DEVICE static inline auto
+        convert_stochastic(FragT const& frag, uint64_t seed, uint64_t offset = 0u);
+
 } // namespace rocwmma
 
 #endif // ROCWMMA_TRANSFORMS_API_HPP
@@ -26,6 +26,9 @@
 #ifndef ROCWMMA_TRANSFORMS_API_IMPL_HPP
 #define ROCWMMA_TRANSFORMS_API_IMPL_HPP
 
+#include "internal/convert.hpp"
+#include "internal/philox.hpp"
+#include "internal/reduce.hpp"
 #include "internal/transforms.hpp"
 #include "rocwmma_transforms.hpp"
 
@@ -160,6 +163,72 @@ namespace rocwmma
             }
         };
 
+        ///
+        /// Reinterpret accumulator of C^T as matrix_a of C
+        ///
+
+        // Back-to-back GEMMs consume the result of the first GEMM as the matrix_a input
+        // of the second, which usually requires a round trip through LDS memory.
+        // Assumptions:
+        // - Accumulators and small matrix_b fragments share the RowNT layout profile,
+        //   so that where MaxVW also matches, an accumulator of (BlockM x BlockN) is
+        //   register identical to a matrix_b fragment of (BlockK x BlockN) = (BlockM x BlockN).
+        // - The matrix_b fragment is then the implicit transpose of a matrix_a fragment.
+        // - The accumulator has already been converted to the input data type.
+        // Example:
+        // - An accumulator of H^T = W1^T x X^T of (BlockM x BlockN) = 16x16 in col_major may be
+        //   reinterpreted as a matrix_a fragment of H (BlockM x BlockK) = 16x16 in row_major,
+        //   ready for H x W2.
+        template <typename FragT, uint32_t NextBlockN>
+        struct ApplyAccumToMatrixA;
+
+        template <uint32_t BlockM,
+                  uint32_t BlockN,
+                  uint32_t BlockK,
+                  typename DataT,
+                  typename DataLayoutT,
+                  uint32_t NextBlockN>
+        struct ApplyAccumToMatrixA<
+            fragment<accumulator, BlockM, BlockN, BlockK, DataT, DataLayoutT>,
+            NextBlockN>
+        {
+        private:
+            static_assert(!is_same_v<DataLayoutT, void>,
+                          "Accumulator must have a data layout, e.g. col_major");
+
+            using FragAcc = fragment<accumulator, BlockM, BlockN, BlockK, DataT, DataLayoutT>;
+
+            // Accumulator rows become the K dimension of matrix_b
+            using FragB = fragment<matrix_b, NextBlockN, BlockN, BlockM, DataT, DataLayoutT>;
+
+            using IOConfigAcc = GetIOConfig_t<FragAcc>;
+            using IOConfigB   = GetIOConfig_t<FragB>;
+
+            // Assumptions check
+            static_assert(IOConfigAcc::IOShape::BlockDim == IOConfigB::IOShape::BlockDim,
+                          "BlockDim of reinterpreted frag doesn't match");
+
+            static_assert(IOConfigAcc::IOShape::KDim == IOConfigB::IOShape::KDim,
+                          "KDim of reinterpreted frag doesn't match");
+
+            static_assert(is_same_v<typename IOConfigAcc::IOLayout::MatrixLayout,
+                                    typename IOConfigB::IOLayout::MatrixLayout>,
+                          "Matrix layouts do not match. Try 16 x 16 blocks");
+
+            static_assert(is_same_v<typename IOConfigAcc::IOLayout::RegisterLayout,
+                                    typename IOConfigB::IOLayout::RegisterLayout>,
+                          "Register layouts do not match. Try 16 x 16 blocks");
+
+        public:
+            // Interface
+            using Type = typename ApplyTranspose<FragB>::Type;
+
+            ROCWMMA_DEVICE static inline Type const& exec(FragAcc const& frag)
+            {
+                return ApplyTranspose<FragB>::exec(reinterpret_cast<FragB const&>(frag));
+            }
+        };
+
         // Below are defined data layout transforms:
         // - The same fragment data is to be re-arranged in the format
         //   of another another Data Layout.
@@ -256,7 +325,12 @@ namespace rocwmma
 
                 auto result = FragOut{};
 
-                if constexpr(is_same_v<AosLayout, RegisterLayoutIncoming>)
+                // AOS and SOA coincide with a single element per vector
+                if constexpr(MaxVW == 1u)
+                {
+                    result.mAccess = frag.mAccess;
+                }
+                else if constexpr(is_same_v<AosLayout, RegisterLayoutIncoming>)
                 {
                     result.mAccess = Transforms::AosToSoa<BlockDim, MaxVW>::exec(frag.mAccess);
                 }
@@ -264,6 +338,11 @@ namespace rocwmma
                 {
                     result.mAccess = Transforms::SoaToAos<BlockDim, MaxVW>::exec(frag.mAccess);
                 }
+                else
+                {
+                    static_assert(is_same_v<SoaLayout, RegisterLayoutIncoming>,
+                                  "Register layout must be AOS or SOA to change data layout");
+                }
 
                 return result;
             }
@@ -287,6 +366,102 @@ namespace rocwmma
             using Type = fragment<matrix_b, 1, registerFileWidth, FragT::size(), DataT, DataLayout>;
         };
 
+        ///
+        /// Stochastic rounding conversion of accumulator fragments
+        ///
+
+        // Accumulator register layouts don't depend on the data type (other than
+        // float64_t), so converted elements stay co-indexed with the input.
+        template <typename FragT, typename OutputT>
+        struct ConvertStochastic;
+        template <uint32_t BlockM,
+                  uint32_t BlockN,
+                  uint32_t BlockK,
+                  typename DataLayoutT,
+                  typename OutputT>
+        struct ConvertStochastic<
+            fragment<accumulator, BlockM, BlockN, BlockK, float32_t, DataLayoutT>,
+            OutputT>
+        {
+            using FragT = fragment<accumulator, BlockM, BlockN, BlockK, float32_t, DataLayoutT>;
+            using Type  = fragment<accumulator, BlockM, BlockN, BlockK, OutputT, DataLayoutT>;
+
+            ROCWMMA_DEVICE static inline Type
+                exec(FragT const& frag, uint64_t seed, uint64_t offset)
+            {
+                using Philox            = Philox4x32;
+                constexpr uint32_t Size = FragT::size();
+
+                // Per-thread stream: counter = (offset, global thread id, element group)
+                auto blockId  = (blockIdx.z * gridDim.y + blockIdx.y) * gridDim.x + blockIdx.x;
+                auto threadId = (blockId * blockDim.z + threadIdx.z) * blockDim.y * blockDim.x
+                                + threadIdx.y * blockDim.x + threadIdx.x;
+
+                VecT<uint32_t, Size> rand;
+
+#pragma unroll
+                for(uint32_t i = 0; i < Size; i += 4u)
+                {
+                    auto r = Philox::generate(seed,
+                                              {static_cast<uint32_t>(offset),
+                                               static_cast<uint32_t>(offset >> 32u),
+                                               threadId,
+                                               i / 4u});
+
+                    uint32_t words[4] = {r.x, r.y, r.z, r.w};
+
+#pragma unroll
+                    for(uint32_t j = 0; j < 4u && i + j < Size; j++)
+                    {
+                        rand.data[i + j] = words[j];
+                    }
+                }
+
+                Type result;
+                result.mAccess = ConvertSr<float32_t, OutputT>::exec(frag.mAccess, rand);
+                return result;
+            }
+        };
+
+        ///
+        /// Matrix coordinates of fragment elements
+        ///
+
+        // Element i of a lane is vector element (i % VW) of iteration (i / VW) of the matrix
+        // layout. Vector elements are contiguous in the data layout. Accumulators use the
+        // row_major layout, with one element per iteration.
+        template <typename FragT>
+        struct FragmentCoords;
+        template <typename MatrixT,
+                  uint32_t BlockM,
+                  uint32_t BlockN,
+                  uint32_t BlockK,
+                  typename DataT,
+                  typename DataLayoutT>
+        struct FragmentCoords<fragment<MatrixT, BlockM, BlockN, BlockK, DataT, DataLayoutT>>
+        {
+            using LayoutT
+                = conditional_t<is_same_v<MatrixT, accumulator>, row_major, DataLayoutT>;
+            using FragLayoutT  = fragment<MatrixT, BlockM, BlockN, BlockK, DataT, LayoutT>;
+            using IOLayout     = typename GetIOConfig_t<FragLayoutT>::IOLayout;
+            using MatrixLayout = typename IOLayout::MatrixLayout;
+
+            ROCWMMA_DEVICE static inline Coord2d base()
+            {
+                return MatrixLayout::baseOffset();
+            }
+
+            ROCWMMA_DEVICE static inline Coord2d offset(uint32_t i)
+            {
+                constexpr uint32_t VW = IOLayout::VW;
+
+                auto v    = i % VW;
+                auto step = is_same_v<LayoutT, row_major> ? make_coord2d(0u, v)
+                                                          : make_coord2d(v, 0u);
+                return MatrixLayout::cumulativeOffset(i / VW) + step;
+            }
+        };
+
     } // namespace detail
 
     /// These wrappers must perfect-forward and perfect-return because the return types and
@@ -304,6 +479,123 @@ namespace rocwmma
         return detail::template ApplyDataLayout<decay_t<FragT>, DataLayoutT>::template exec<
             WaveCount>(forward<FragT>(frag));
     }
+
+    template <uint32_t NextBlockN, typename FragT>
+    ROCWMMA_DEVICE static inline decltype(auto) applyAccumToMatrixA(FragT const& frag)
+    {
+        return detail::template ApplyAccumToMatrixA<FragT, NextBlockN>::exec(frag);
+    }
+
+    template <typename ReduceOpT, typename FragT>
+    ROCWMMA_DEVICE static inline FragT reduce_rows(FragT const& frag)
+    {
+        return detail::template ReduceFragment<FragT>::template rows<ReduceOpT>(frag);
+    }
+
+    template <typename ReduceOpT, typename FragT>
+    ROCWMMA_DEVICE static inline FragT reduce_cols(FragT const& frag)
+    {
+        return detail::template ReduceFragment<FragT>::template cols<ReduceOpT>(frag);
+    }
+
+    template <typename FragT>
+    ROCWMMA_DEVICE static inline FragT
+        online_softmax_rows(FragT& frag, FragT& fragMax, FragT& fragSum, float32_t scale /*= 1.0f*/)
+    {
+        return detail::template ReduceFragment<FragT>::softmaxOnline(frag, fragMax, fragSum, scale);
+    }
+
+    template <uint32_t K, typename FragT, typename FragIdxT>
+    ROCWMMA_DEVICE static inline void
+        topk_rows(FragT const& frag, uint32_t colOffset, FragT (&vals)[K], FragIdxT (&idx)[K])
+    {
+        static_assert(!is_same_v<typename FragT::element_type, float64_t>,
+                      "topk_rows is not available for float64_t");
+        detail::template ReduceFragment<FragT>::template topk<K>(frag, colOffset, vals, idx);
+    }
+
+    namespace detail
+    {
+        // Running argmax along the rows (IsRows) or the columns of the block. The block max
+        // and its lowest column or row are found with two reductions, then replace the
+        // running max where strictly greater, keeping earlier blocks ahead on ties.
+        template <bool IsRows, typename FragT, typename FragIdxT>
+        ROCWMMA_DEVICE static inline void
+            argmax(FragT const& frag, uint32_t offset, FragT& vals, FragIdxT& idx)
+        {
+            using DataT  = typename FragT::element_type;
+            using IndexT = typename FragIdxT::element_type;
+
+            // Compare in the reduction type of sub-dword data
+            using CompareT = conditional_t<(sizeof(DataT) < sizeof(uint32_t)), float32_t, DataT>;
+
+            static_assert(!is_same_v<DataT, float64_t>, "argmax is not available for float64_t");
+            static_assert(is_same_v<IndexT, int32_t>, "Indices must be int32_t");
+            static_assert(FragIdxT::num_elements == FragT::num_elements,
+                          "Index fragment must be co-indexed with the value fragment");
+
+            auto reduceLines = [](auto const& f, auto op) {
+                using ReduceOpT = decltype(op);
+                using ReduceT   = ReduceFragment<decay_t<decltype(f)>>;
+                if constexpr(IsRows)
+                {
+                    return ReduceT::template rows<ReduceOpT>(f);
+                }
+                else
+                {
+                    return ReduceT::template cols<ReduceOpT>(f);
+                }
+            };
+
+            auto blockMax = reduceLines(frag, reduce::Max{});
+
+            auto base  = FragmentCoords<FragT>::base();
+            auto index = FragIdxT{};
+#pragma unroll
+            for(uint32_t i = 0; i < FragT::num_elements; i++)
+            {
+                auto coord = base + FragmentCoords<FragT>::offset(i);
+                auto pos   = IsRows ? get<1>(coord) : get<0>(coord);
+                auto isMax = static_cast<CompareT>(frag.x[i])
+                             == static_cast<CompareT>(blockMax.x[i]);
+                index.x[i] = isMax ? static_cast<IndexT>(offset + pos)
+                                   : numeric_limits<IndexT>::max();
+            }
+            index = reduceLines(index, reduce::Min{});
+
+#pragma unroll
+            for(uint32_t i = 0; i < FragT::num_elements; i++)
+            {
+                if(static_cast<CompareT>(blockMax.x[i]) > static_cast<CompareT>(vals.x[i]))
+                {
+                    vals.x[i] = blockMax.x[i];
+                    idx.x[i]  = index.x[i];
+                }
+            }
+        }
+
+    } // namespace detail
+
+    template <typename FragT, typename FragIdxT>
+    ROCWMMA_DEVICE static inline void
+        argmax_rows(FragT const& frag, uint32_t colOffset, FragT& vals, FragIdxT& idx)
+    {
+        detail::argmax<true>(frag, colOffset, vals, idx);
+    }
+
+    template <typename FragT, typename FragIdxT>
+    ROCWMMA_DEVICE static inline void
+        argmax_cols(FragT const& frag, uint32_t rowOffset, FragT& vals, FragIdxT& idx)
+    {
+        detail::argmax<false>(frag, rowOffset, vals, idx);
+    }
+
+    template <typename OutputT, typename FragT>
+    ROCWMMA_DEVICE static inline auto
+        convert_stochastic(FragT const& frag, uint64_t seed, uint64_t offset /*= 0u*/)
+    {
+        return detail::template ConvertStochastic<FragT, OutputT>::exec(frag, seed, offset);
+    }
     // @endcond
 
 } // namespace rocwmma
@@ -0,0 +1,332 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef ROCWMMA_SAMPLES_BENCHMARK_HARNESS_HPP
+#define ROCWMMA_SAMPLES_BENCHMARK_HARNESS_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <hip/hip_runtime.h>
+#include <rocm_smi/rocm_smi.h>
+
+#include "common.hpp"
+
+// Timing statistics over the recorded runs of one benchmark
+struct BenchmarkStats
+{
+    uint32_t mRuns;
+    double   mMinMs, mMedianMs, mP99Ms, mMeanMs, mStdDevMs;
+    double   mCi95Ms; // Half width of the 95% confidence interval of the mean
+    bool     mConverged;
+};
+
+// Benchmark harness for the perf samples.
+//
+// Each recorded run is timed individually between its own pair of events:
+// : Warm runs re-use whatever the previous run left in the caches.
+// : Cold runs first overwrite a scratch buffer larger than the last level cache,
+//   outside of the timed region, so inputs are fetched from memory again.
+//
+// Warmup runs repeat until two consecutive runs agree within 2%, then recorded runs
+// are added in batches until the 95% confidence interval of the mean is within the
+// target of the mean, or the run limit is reached.
+//
+// Defaults can be overridden by environment variables:
+// : ROCWMMA_BENCH_MIN_RUNS    (default 5) minimum and batch size of recorded runs
+// : ROCWMMA_BENCH_MAX_RUNS    (default 200) recorded run limit
+// : ROCWMMA_BENCH_TARGET_CI   (default 0.01) relative 95% confidence interval target
+// : ROCWMMA_BENCH_FLUSH_BYTES (default 2x L2, at least 512MB on gfx94x with MALL)
+// : ROCWMMA_BENCH_LOCK_CLOCKS (default 0) when 1, requests the stable performance level
+//   through rocm-smi for the harness lifetime. This usually requires elevated permissions;
+//   on failure the clocks are left unchanged.
+class BenchmarkHarness
+{
+public:
+    enum class CacheState : uint32_t
+    {
+        Warm = 0u,
+        Cold
+    };
+
+    BenchmarkHarness()
+        : mMinRuns(envValue("ROCWMMA_BENCH_MIN_RUNS", 5u))
+        , mMaxRuns(envValue("ROCWMMA_BENCH_MAX_RUNS", 200u))
+        , mMaxWarmups(20u)
+        , mTargetCi(envValue("ROCWMMA_BENCH_TARGET_CI", 0.01))
+        , mFlushBuffer(nullptr)
+        , mFlushBytes(0u)
+        , mSmiDevice(std::numeric_limits<uint32_t>::max())
+    {
+        mMinRuns = std::max(mMinRuns, 2u);
+        mMaxRuns = std::max(mMaxRuns, mMinRuns);
+
+        hipDevice_t     handle;
+        hipDeviceProp_t props;
+        CHECK_HIP_ERROR(hipGetDevice(&handle));
+        CHECK_HIP_ERROR(hipGetDeviceProperties(&props, handle));
+
+        // MI300 memory side last level cache (MALL) sits behind L2
+        std::string deviceName(props.gcnArchName);
+        size_t      flushBytes = 2ull * static_cast<size_t>(props.l2CacheSize);
+        if(deviceName.find("gfx94") != std::string::npos)
+        {
+            flushBytes = std::max(flushBytes, size_t(512ull << 20));
+        }
+        mFlushBytes = envValue("ROCWMMA_BENCH_FLUSH_BYTES", flushBytes);
+
+        if(envValue("ROCWMMA_BENCH_LOCK_CLOCKS", 0u) != 0u)
+        {
+            lockClocks(props);
+        }
+    }
+
+    ~BenchmarkHarness()
+    {
+        if(mFlushBuffer)
+        {
+            CHECK_HIP_ERROR(hipFree(mFlushBuffer));
+        }
+        unlockClocks();
+    }
+
+    template <typename KernelT>
+    BenchmarkStats run(KernelT&& kernel, CacheState cacheState = CacheState::Warm)
+    {
+        warmup(kernel, cacheState);
+
+        std::vector<double> samplesMs;
+        BenchmarkStats      stats = {};
+        while(samplesMs.size() < mMaxRuns)
+        {
+            auto batch = std::min<size_t>(mMinRuns, mMaxRuns - samplesMs.size());
+            timeRuns(kernel, cacheState, batch, samplesMs);
+
+            stats = calculateStats(samplesMs);
+            if(stats.mCi95Ms <= mTargetCi * stats.mMeanMs)
+            {
+                stats.mConverged = true;
+                break;
+            }
+        }
+        return stats;
+    }
+
+    // Column names matching printStats()
+    static char const* statsHeader()
+    {
+        return "runs, minMs, medianMs, p99Ms, stddevMs, ci95Ms";
+    }
+
+    static std::ostream& printStats(std::ostream& stream, BenchmarkStats const& stats)
+    {
+        return stream << stats.mRuns << (stats.mConverged ? "" : "*") << ", " << stats.mMinMs
+                      << ", " << stats.mMedianMs << ", " << stats.mP99Ms << ", "
+                      << stats.mStdDevMs << ", " << stats.mCi95Ms;
+    }
+
+    static BenchmarkStats calculateStats(std::vector<double> samplesMs)
+    {
+        BenchmarkStats stats = {};
+        stats.mRuns          = static_cast<uint32_t>(samplesMs.size());
+        if(samplesMs.empty())
+        {
+            return stats;
+        }
+
+        std::sort(samplesMs.begin(), samplesMs.end());
+        auto count = samplesMs.size();
+
+        double sum = 0.0;
+        for(auto s : samplesMs)
+        {
+            sum += s;
+        }
+        stats.mMeanMs = sum / static_cast<double>(count);
+
+        double sumSq = 0.0;
+        for(auto s : samplesMs)
+        {
+            sumSq += (s - stats.mMeanMs) * (s - stats.mMeanMs);
+        }
+
+        // Sample standard deviation, nearest-rank percentile
+        auto rank99     = static_cast<size_t>(std::ceil(0.99 * static_cast<double>(count)));
+        stats.mMinMs    = samplesMs.front();
+        stats.mMedianMs = (count % 2u)
+                              ? samplesMs[count / 2u]
+                              : 0.5 * (samplesMs[count / 2u - 1u] + samplesMs[count / 2u]);
+        stats.mP99Ms    = samplesMs[std::max<size_t>(rank99, 1u) - 1u];
+        stats.mStdDevMs = count > 1u ? std::sqrt(sumSq / static_cast<double>(count - 1u)) : 0.0;
+        stats.mCi95Ms   = 1.96 * stats.mStdDevMs / std::sqrt(static_cast<double>(count));
+        return stats;
+    }
+
+private:
+    template <typename KernelT>
+    void warmup(KernelT& kernel, CacheState cacheState)
+    {
+        std::vector<double> samplesMs;
+        auto                lastMs = 0.0;
+        for(uint32_t i = 0; i < mMaxWarmups; ++i)
+        {
+            samplesMs.clear();
+            timeRuns(kernel, cacheState, 1u, samplesMs);
+            if(i > 0u && std::abs(samplesMs[0] - lastMs) <= 0.02 * lastMs)
+            {
+                break;
+            }
+            lastMs = samplesMs[0];
+        }
+    }
+
+    template <typename KernelT>
+    void timeRuns(KernelT&             kernel,
+                  CacheState           cacheState,
+                  size_t               runs,
+                  std::vector<double>& samplesMs)
+    {
+        std::vector<hipEvent_t> events(2u * runs);
+        for(auto& event : events)
+        {
+            CHECK_HIP_ERROR(hipEventCreate(&event));
+        }
+
+        for(size_t i = 0; i < runs; ++i)
+        {
+            if(cacheState == CacheState::Cold)
+            {
+                flushCache();
+            }
+            CHECK_HIP_ERROR(hipEventRecord(events[2u * i]));
+            kernel();
+            CHECK_HIP_ERROR(hipEventRecord(events[2u * i + 1u]));
+        }
+        CHECK_HIP_ERROR(hipEventSynchronize(events.back()));
+
+        for(size_t i = 0; i < runs; ++i)
+        {
+            auto elapsedMs = 0.0f;
+            CHECK_HIP_ERROR(hipEventElapsedTime(&elapsedMs, events[2u * i], events[2u * i + 1u]));
+            samplesMs.push_back(static_cast<double>(elapsedMs));
+        }
+
+        for(auto& event : events)
+        {
+            CHECK_HIP_ERROR(hipEventDestroy(event));
+        }
+    }
+
+    // Overwrites the scratch buffer to evict kernel data from L2 and MALL
+    void flushCache()
+    {
+        if(!mFlushBuffer)
+        {
+            CHECK_HIP_ERROR(hipMalloc(&mFlushBuffer, mFlushBytes));
+        }
+        CHECK_HIP_ERROR(hipMemsetAsync(mFlushBuffer, ++mFlushValue, mFlushBytes));
+    }
+
+    void lockClocks(hipDeviceProp_t const& props)
+    {
+        if(rsmi_init(0) != RSMI_STATUS_SUCCESS)
+        {
+            std::cerr << "Benchmark: rocm-smi unavailable, clocks not locked" << std::endl;
+            return;
+        }
+
+        uint64_t hipPCIID = 0;
+        hipPCIID |= props.pciDeviceID & 0xFF;
+        hipPCIID |= ((props.pciBusID & 0xFF) << 8);
+        hipPCIID |= (props.pciDomainID) << 16;
+
+        uint32_t smiCount = 0;
+        rsmi_num_monitor_devices(&smiCount);
+        for(uint32_t smiIndex = 0; smiIndex < smiCount; smiIndex++)
+        {
+            uint64_t rsmiPCIID = 0;
+            if(rsmi_dev_pci_id_get(smiIndex, &rsmiPCIID) == RSMI_STATUS_SUCCESS
+               && rsmiPCIID == hipPCIID)
+            {
+                if(rsmi_dev_perf_level_set_v1(smiIndex, RSMI_DEV_PERF_LEVEL_STABLE_STD)
+                   == RSMI_STATUS_SUCCESS)
+                {
+                    mSmiDevice = smiIndex;
+                    return;
+                }
+                break;
+            }
+        }
+
+        std::cerr << "Benchmark: unable to set stable performance level, clocks not locked"
+                  << std::endl;
+        rsmi_shut_down();
+    }
+
+    void unlockClocks()
+    {
+        if(mSmiDevice != std::numeric_limits<uint32_t>::max())
+        {
+            rsmi_dev_perf_level_set_v1(mSmiDevice, RSMI_DEV_PERF_LEVEL_AUTO);
+            rsmi_shut_down();
+            mSmiDevice = std::numeric_limits<uint32_t>::max();
+        }
+    }
+
+    template <typename T>
+    static T envValue(char const* name, T defaultValue)
+    {
+        auto value = std::getenv(name);
+        if(value == nullptr || *value == '\0')
+        {
+            return defaultValue;
+        }
+        if constexpr(std::is_floating_point_v<T>)
+        {
+            return static_cast<T>(std::strtod(value, nullptr));
+        }
+        else
+        {
+            return static_cast<T>(std::strtoull(value, nullptr, 10));
+        }
+    }
+
+    uint32_t mMinRuns, mMaxRuns, mMaxWarmups;
+    double   mTargetCi;
+    void*    mFlushBuffer;
+    size_t   mFlushBytes;
+    int      mFlushValue = 0;
+    uint32_t mSmiDevice;
+};
+
+#endif // ROCWMMA_SAMPLES_BENCHMARK_HARNESS_HPP
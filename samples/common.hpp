@@ -29,6 +29,7 @@
 
 #include <iostream>
 #include <mutex>
+#include <vector>
 
 // Helper macro for HIP errors
 #ifndef CHECK_HIP_ERROR
@@ -60,6 +61,8 @@
 #endif
 
 #include <rocwmma/internal/type_traits.hpp>
+#include <rocwmma/rocwmma_dispatch.hpp>
+#include <rocwmma/rocwmma_profile.hpp>
 
 // HIP Host functions to determine the gfx architecture
 bool isGfx9()
@@ -125,11 +128,64 @@ bool isF64Supported()
             || (deviceName.find("gfx942") != std::string::npos));
 }
 
+// HIP Host function to find if the device supports f8 / bf8
+bool isF8Supported()
+{
+    hipDevice_t     mHandle;
+    hipDeviceProp_t mProps;
+
+    CHECK_HIP_ERROR(hipGetDevice(&mHandle));
+    CHECK_HIP_ERROR(hipGetDeviceProperties(&mProps, mHandle));
+
+    std::string deviceName(mProps.gcnArchName);
+
+    return ((deviceName.find("gfx940") != std::string::npos)
+            || (deviceName.find("gfx941") != std::string::npos)
+            || (deviceName.find("gfx942") != std::string::npos) || isGfx12());
+}
+
+// HIP Host function to find if the device supports 2:4 structured sparse smfmac
+bool isSparseSupported()
+{
+    hipDevice_t     mHandle;
+    hipDeviceProp_t mProps;
+
+    CHECK_HIP_ERROR(hipGetDevice(&mHandle));
+    CHECK_HIP_ERROR(hipGetDeviceProperties(&mProps, mHandle));
+
+    std::string deviceName(mProps.gcnArchName);
+
+    return ((deviceName.find("gfx940") != std::string::npos)
+            || (deviceName.find("gfx941") != std::string::npos)
+            || (deviceName.find("gfx942") != std::string::npos));
+}
+
 bool isF32Supported()
 {
     return isGfx9();
 }
 
+// HIP Host function to find if the device supports cooperative launch, required by
+// kernels using rocwmma::synchronize_grid
+bool isCooperativeLaunchSupported()
+{
+    hipDevice_t mHandle;
+    int         mCooperative = 0;
+
+    CHECK_HIP_ERROR(hipGetDevice(&mHandle));
+    CHECK_HIP_ERROR(
+        hipDeviceGetAttribute(&mCooperative, hipDeviceAttributeCooperativeLaunch, mHandle));
+
+    return mCooperative != 0;
+}
+
+// HIP Host function to retrieve the arch ID of the device, one of the
+// rocwmma::Constants::AMDGCN_ARCH_ID values
+uint32_t getGcnArchId()
+{
+    return rocwmma::get_device_arch_id();
+}
+
 inline double calculateGFlops(uint32_t m, uint32_t n, uint32_t k)
 {
     return 2.0 * static_cast<double>(m) * static_cast<double>(n) * static_cast<double>(k) * 1.0e-9;
@@ -223,20 +279,21 @@ __host__ static inline void fillRand(DataT* mat, uint32_t m, uint32_t n)
     }
 }
 
-// Host GEMM validation
+// Host GEMM validation. C may be held in another datatype (InputTC) than D.
 template <typename InputT,
           typename OutputT,
           typename ComputeT,
           typename LayoutA,
           typename LayoutB,
           typename LayoutC,
-          typename LayoutD = LayoutC>
+          typename LayoutD = LayoutC,
+          typename InputTC = OutputT>
 __host__ void gemm_cpu_h(uint32_t       m,
                          uint32_t       n,
                          uint32_t       k,
                          InputT const*  a,
                          InputT const*  b,
-                         OutputT const* c,
+                         InputTC const* c,
                          OutputT*       d,
                          uint32_t       lda,
                          uint32_t       ldb,
@@ -345,4 +402,50 @@ __host__ std::pair<bool, double>
     return std::make_pair(retval, max_relative_error);
 }
 
+// Host helpers for kernels instrumented with rocwmma::profile::stamp_ring.
+// Stamps are only recorded when building with -DROCWMMA_PROFILE_STAMPS=1.
+inline rocwmma::profile::stamp_buffer allocPhaseStamps(uint32_t waveCount, uint32_t capacity)
+{
+    rocwmma::profile::stamp_buffer buffer = {};
+    buffer.capacity                       = capacity;
+    buffer.waveCount                      = waveCount;
+
+    auto recordCount = static_cast<size_t>(waveCount) * capacity;
+    CHECK_HIP_ERROR(
+        hipMalloc(&buffer.records, recordCount * sizeof(rocwmma::profile::stamp_record)));
+    CHECK_HIP_ERROR(hipMalloc(&buffer.counts, waveCount * sizeof(uint32_t)));
+    CHECK_HIP_ERROR(hipMemset(buffer.counts, 0, waveCount * sizeof(uint32_t)));
+
+    return buffer;
+}
+
+// Prints the phase breakdown of all stamps since the last report, then clears the rings
+inline void reportPhaseStamps(rocwmma::profile::stamp_buffer const& buffer)
+{
+    auto recordCount = static_cast<size_t>(buffer.waveCount) * buffer.capacity;
+
+    std::vector<rocwmma::profile::stamp_record> records(recordCount);
+    std::vector<uint32_t>                       counts(buffer.waveCount);
+    CHECK_HIP_ERROR(hipMemcpy(records.data(),
+                              buffer.records,
+                              recordCount * sizeof(rocwmma::profile::stamp_record),
+                              hipMemcpyDeviceToHost));
+    CHECK_HIP_ERROR(hipMemcpy(counts.data(),
+                              buffer.counts,
+                              buffer.waveCount * sizeof(uint32_t),
+                              hipMemcpyDeviceToHost));
+
+    auto summary = rocwmma::profile::decode_stamps(
+        records.data(), counts.data(), buffer.capacity, buffer.waveCount);
+    rocwmma::profile::print_phase_summary(std::cout, summary);
+
+    CHECK_HIP_ERROR(hipMemset(buffer.counts, 0, buffer.waveCount * sizeof(uint32_t)));
+}
+
+inline void freePhaseStamps(rocwmma::profile::stamp_buffer const& buffer)
+{
+    CHECK_HIP_ERROR(hipFree(buffer.records));
+    CHECK_HIP_ERROR(hipFree(buffer.counts));
+}
+
 #endif // ROCWMMA_SAMPLES_COMMON_HPP
@@ -24,6 +24,7 @@
  *
  *******************************************************************************/
 
+#include <chrono>
 #include <cstdlib>
 #include <iostream>
 #include <string>
@@ -35,6 +36,12 @@
 #include <rocwmma/rocwmma.hpp>
 
 #include "common.hpp"
+#include "hiprtc_kernel_cache.hpp"
+
+// Preprocessed rocWMMA headers of each target, generated with -DROCWMMA_BUILD_RTC_BUNDLE=ON
+#if ROCWMMA_RTC_BUNDLE
+#include "rocwmma_rtc_bundle.hpp"
+#endif // ROCWMMA_RTC_BUNDLE
 
 using rocwmma::bfloat16_t;
 using rocwmma::float16_t;
@@ -84,10 +91,6 @@ using InputT   = bfloat16_t;
 using OutputT  = float32_t;
 using ComputeT = float32_t;
 
-constexpr int ROCWMMA_M = 16;
-constexpr int ROCWMMA_N = 16;
-constexpr int ROCWMMA_K = 16;
-
 // The following device kernel is a naive implementation
 // of blocked GEMM. Each wave will compute one BLOCK_M x BLOCK_N
 // output block of the M x N x K GEMM, generalized as:
@@ -102,7 +105,9 @@ constexpr int ROCWMMA_K = 16;
 //
 // Note: This is a simplified implementation to demonstrate API usage in
 // context of wave-level GEMM computation, and is not optimized.
-extern "C"
+// Note: Block sizes are template arguments, specialized at runtime
+// through the hipRTC name expression.
+template <int ROCWMMA_M, int ROCWMMA_N, int ROCWMMA_K>
 __global__ void gemm_rocwmma_d(uint32_t         m,
                                uint32_t         n,
                                uint32_t         k,
@@ -172,9 +177,171 @@ __global__ void gemm_rocwmma_d(uint32_t         m,
         rocwmma::store_matrix_sync(d + (cRow * ldd + cCol), fragC, ldd, rocwmma::mem_row_major);
     }
 }
+
+// Shape-specialized JIT variant of the above kernel.
+// Problem dimensions, leading dimensions, thread block size and the
+// alpha / beta cases are baked in as compile-time constants with -D
+// options, so the compiler can fold address arithmetic, fully resolve the
+// K loop trip count and strip bounds checks when the grid tiles exactly.
+// Each distinct shape compiles to a distinct hipRTC cache entry.
+#if defined(JIT_M)
+
+// Scale classes, to skip work for alpha / beta == 0 or 1
+constexpr int JIT_SCALE_ZERO = 0;
+constexpr int JIT_SCALE_ONE  = 1;
+constexpr int JIT_SCALE_ANY  = 2;
+
+template <int ScaleClass>
+__device__ inline ComputeT jitScale(ComputeT scale, ComputeT value)
+{
+    if constexpr(ScaleClass == JIT_SCALE_ZERO)
+    {
+        return static_cast<ComputeT>(0);
+    }
+    else if constexpr(ScaleClass == JIT_SCALE_ONE)
+    {
+        return value;
+    }
+    else
+    {
+        return scale * value;
+    }
+}
+
+template <int ROCWMMA_M, int ROCWMMA_N, int ROCWMMA_K>
+__global__ void __launch_bounds__(JIT_TBLOCK_X * JIT_TBLOCK_Y)
+    gemm_rocwmma_shape_d(InputT const* a,
+                         InputT const* b,
+                         OutputT const* c,
+                         OutputT*       d,
+                         ComputeT       alpha,
+                         ComputeT       beta)
+{
+    constexpr uint32_t m   = JIT_M;
+    constexpr uint32_t n   = JIT_N;
+    constexpr uint32_t k   = JIT_K;
+    constexpr uint32_t lda = JIT_LDA;
+    constexpr uint32_t ldb = JIT_LDB;
+    constexpr uint32_t ldc = JIT_LDC;
+    constexpr uint32_t ldd = JIT_LDD;
+
+    constexpr uint32_t WAVES_X = JIT_TBLOCK_X / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    constexpr bool     EXACT_TILING
+        = (m % (ROCWMMA_M * WAVES_X) == 0u) && (n % (ROCWMMA_N * JIT_TBLOCK_Y) == 0u);
+
+    static_assert(k % ROCWMMA_K == 0u, "K must be a multiple of ROCWMMA_K");
+
+    // Tile using a 2D grid
+    auto majorWarp = (blockIdx.x * blockDim.x + threadIdx.x) / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    auto minorWarp = (blockIdx.y * blockDim.y + threadIdx.y);
+
+    // Target C block
+    auto cRow = majorWarp * ROCWMMA_M;
+    auto cCol = minorWarp * ROCWMMA_N;
+
+    // Bounds check is only required when the grid overhangs the problem
+    if constexpr(!EXACT_TILING)
+    {
+        if(cRow >= m || cCol >= n)
+        {
+            return;
+        }
+    }
+
+    auto fragAcc
+        = rocwmma::fragment<rocwmma::accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, ComputeT>();
+    rocwmma::fill_fragment(fragAcc, 0.0f);
+
+    // fragAcc = A x B, not required for alpha == 0
+    if constexpr(JIT_ALPHA_CLASS != JIT_SCALE_ZERO)
+    {
+        auto fragA = rocwmma::fragment<rocwmma::matrix_a,
+                                       ROCWMMA_M,
+                                       ROCWMMA_N,
+                                       ROCWMMA_K,
+                                       InputT,
+                                       rocwmma::row_major>();
+        auto fragB = rocwmma::fragment<rocwmma::matrix_b,
+                                       ROCWMMA_M,
+                                       ROCWMMA_N,
+                                       ROCWMMA_K,
+                                       InputT,
+                                       rocwmma::col_major>();
+
+        for(uint32_t i = 0; i < k; i += ROCWMMA_K)
+        {
+            rocwmma::load_matrix_sync(fragA, a + (cRow * lda + i), lda);
+            rocwmma::load_matrix_sync(fragB, b + (i + cCol * ldb), ldb);
+            rocwmma::mma_sync(fragAcc, fragA, fragB, fragAcc);
+        }
+    }
+
+    auto fragD
+        = rocwmma::fragment<rocwmma::accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, OutputT>();
+
+    // Fetch C matrix, not required for beta == 0
+    if constexpr(JIT_BETA_CLASS != JIT_SCALE_ZERO)
+    {
+        rocwmma::load_matrix_sync(fragD, c + (cRow * ldc + cCol), ldc, rocwmma::mem_row_major);
+    }
+
+    // D = alpha * A x B + beta * C
+    for(int i = 0; i < fragD.num_elements; ++i)
+    {
+        auto result = jitScale<JIT_ALPHA_CLASS>(alpha, fragAcc.x[i]);
+        if constexpr(JIT_BETA_CLASS != JIT_SCALE_ZERO)
+        {
+            result += jitScale<JIT_BETA_CLASS>(beta, fragD.x[i]);
+        }
+        fragD.x[i] = result;
+    }
+
+    // Store to D
+    rocwmma::store_matrix_sync(d + (cRow * ldd + cCol), fragD, ldd, rocwmma::mem_row_major);
+}
+
+#endif // defined(JIT_M)
+
 )";
 
-char const* src = source.c_str();
+// Launches a module kernel with packed arguments and returns the elapsed time in ms
+float launchModuleKernel(
+    hipFunction_t func, dim3 gridDim, dim3 blockDim, void* args, std::size_t argsSize)
+{
+    void* config[] = {HIP_LAUNCH_PARAM_BUFFER_POINTER,
+                      args,
+                      HIP_LAUNCH_PARAM_BUFFER_SIZE,
+                      &argsSize,
+                      HIP_LAUNCH_PARAM_END};
+
+    hipEvent_t startEvent, stopEvent;
+    CHECK_HIP_ERROR(hipEventCreate(&startEvent));
+    CHECK_HIP_ERROR(hipEventCreate(&stopEvent));
+
+    CHECK_HIP_ERROR(hipEventRecord(startEvent));
+
+    CHECK_HIP_ERROR(hipModuleLaunchKernel(func,
+                                          gridDim.x,
+                                          gridDim.y,
+                                          gridDim.z,
+                                          blockDim.x,
+                                          blockDim.y,
+                                          blockDim.z,
+                                          0,
+                                          nullptr,
+                                          nullptr,
+                                          (void**)&config));
+
+    CHECK_HIP_ERROR(hipEventRecord(stopEvent));
+
+    auto elapsedTimeMs = 0.0f;
+    CHECK_HIP_ERROR(hipEventSynchronize(stopEvent));
+    CHECK_HIP_ERROR(hipEventElapsedTime(&elapsedTimeMs, startEvent, stopEvent));
+    CHECK_HIP_ERROR(hipEventDestroy(startEvent));
+    CHECK_HIP_ERROR(hipEventDestroy(stopEvent));
+
+    return elapsedTimeMs;
+}
 
 int main()
 {
@@ -192,41 +359,50 @@ int main()
     ComputeT alpha = 2.1f;
     ComputeT beta  = 2.1f;
 
-    hiprtcProgram prog;
-    CHECK_HIPRTC_ERROR(hiprtcCreateProgram(&prog, src, nullptr, 0, nullptr, nullptr));
-    hiprtcResult result;
-    hiprtcResult logResult;
-    const char*  opts[] = {"-D__HIP_PLATFORM_AMD__", "--std=c++17", rocWMMAIncludePath.c_str()};
-
-    result = hiprtcCompileProgram(prog, sizeof(opts) / sizeof(opts[0]), opts);
-    if(result != HIPRTC_SUCCESS)
+    // Compile options and kernel instantiation participate in the cache key
+    std::vector<std::string> options = {"-D__HIP_PLATFORM_AMD__", "--std=c++17"};
+
+    // rocWMMA includes resolve to the embedded bundle of the device when there is one,
+    // otherwise to the include tree on disk
+    std::vector<HiprtcKernelCache::Header> headers;
+#if ROCWMMA_RTC_BUNDLE
+    hipDevice_t     device;
+    hipDeviceProp_t props;
+    CHECK_HIP_ERROR(hipGetDevice(&device));
+    CHECK_HIP_ERROR(hipGetDeviceProperties(&props, device));
+    if(auto bundle = rocwmma_rtc_bundle::find(props.gcnArchName); bundle != nullptr)
     {
-        std::cout << "HipRTC compile failed." << std::endl;
-        std::cout << result << std::endl;
-        std::string s_error = hiprtcGetErrorString(result);
-        std::cout << s_error << std::endl;
-        std::size_t log_size;
-        CHECK_HIPRTC_ERROR(hiprtcGetProgramLogSize(prog, &log_size));
-        std::cout << "Log Size: " << log_size << std::endl;
-        std::string log;
-
-        log.reserve(log_size);
-        CHECK_HIPRTC_ERROR(hiprtcGetProgramLog(prog, &log[0]));
-
-        std::cout << log.c_str() << std::endl;
-        exit(EXIT_FAILURE);
+        for(auto entry : rocwmma_rtc_bundle::entries)
+        {
+            headers.push_back({entry, bundle->mSource});
+        }
     }
+#endif // ROCWMMA_RTC_BUNDLE
 
-    std::size_t code_size;
-    CHECK_HIPRTC_ERROR(hiprtcGetCodeSize(prog, &code_size));
-    std::vector<char> code(code_size);
-
-    CHECK_HIPRTC_ERROR(hiprtcGetCode(prog, code.data()));
-
-    hipModule_t   module;
-    hipFunction_t func;
-    CHECK_HIP_ERROR(hipModuleLoadData(&module, code.data()));
-    CHECK_HIP_ERROR(hipModuleGetFunction(&func, module, "gemm_rocwmma_d"));
+    if(headers.empty())
+    {
+        options.push_back(rocWMMAIncludePath);
+    }
+    std::cout << "rocWMMA headers: "
+              << (headers.empty() ? rocWMMAIncludePath.substr(2) : "embedded bundle") << std::endl;
+    std::string nameExpression = "gemm_rocwmma_d<" + std::to_string(ROCWMMA_M) + ", "
+                                 + std::to_string(ROCWMMA_N) + ", " + std::to_string(ROCWMMA_K)
+                                 + ">";
+
+    // Compiled code objects are re-used from memory, or from disk across runs
+    HiprtcKernelCache kernelCache;
+    std::cout << "hipRTC cache dir: "
+              << (kernelCache.cacheDir().empty() ? "<disabled>" : kernelCache.cacheDir().string())
+              << std::endl;
+
+    auto jitStart = std::chrono::steady_clock::now();
+    auto jit      = kernelCache.getFunction(source, nameExpression, options, headers);
+    auto jitEnd   = std::chrono::steady_clock::now();
+    auto func     = jit.mFunction;
+
+    std::cout << "Kernel " << nameExpression << ": " << HiprtcKernelCache::originString(jit.mOrigin)
+              << " in " << std::chrono::duration<double, std::milli>(jitEnd - jitStart).count()
+              << " ms" << std::endl;
 
     // Bounds check
     if((m < (ROCWMMA_M * T_BLOCK_X / WAVE_SIZE) || n < (ROCWMMA_N * T_BLOCK_Y) || k < ROCWMMA_K)
@@ -295,41 +471,9 @@ int main()
         ComputeT       _beta;
     } args{m, n, k, d_a, d_b, d_c, d_d, lda, ldb, ldc, ldd, alpha, beta};
 
-    std::size_t args_size = sizeof(args);
-
-    void* config[] = {HIP_LAUNCH_PARAM_BUFFER_POINTER,
-                      &args,
-                      HIP_LAUNCH_PARAM_BUFFER_SIZE,
-                      &args_size,
-                      HIP_LAUNCH_PARAM_END};
-
     std::cout << "Launching GEMM kernel..." << std::endl;
 
-    hipEvent_t startEvent, stopEvent;
-    CHECK_HIP_ERROR(hipEventCreate(&startEvent));
-    CHECK_HIP_ERROR(hipEventCreate(&stopEvent));
-
-    CHECK_HIP_ERROR(hipEventRecord(startEvent));
-
-    CHECK_HIP_ERROR(hipModuleLaunchKernel(func,
-                                          gridDim.x,
-                                          gridDim.y,
-                                          gridDim.z,
-                                          blockDim.x,
-                                          blockDim.y,
-                                          blockDim.z,
-                                          0,
-                                          nullptr,
-                                          nullptr,
-                                          (void**)&config));
-
-    CHECK_HIP_ERROR(hipEventRecord(stopEvent));
-
-    auto elapsedTimeMs = 0.0f;
-    CHECK_HIP_ERROR(hipEventSynchronize(stopEvent));
-    CHECK_HIP_ERROR(hipEventElapsedTime(&elapsedTimeMs, startEvent, stopEvent));
-    CHECK_HIP_ERROR(hipEventDestroy(startEvent));
-    CHECK_HIP_ERROR(hipEventDestroy(stopEvent));
+    auto elapsedTimeMs = launchModuleKernel(func, gridDim, blockDim, &args, sizeof(args));
 
     // GEMM flops converge to 2*mnk
     auto gFlops       = calculateGFlops(m, n, k);
@@ -351,9 +495,6 @@ int main()
 
     std::cout << "Validating result with reference..." << std::endl;
 
-    // Bring kernel result back to host
-    CHECK_HIP_ERROR(hipMemcpy(matrixD.data(), d_d, bytesD, hipMemcpyDeviceToHost));
-
     // Setup and run reference computation
     std::vector<OutputT> matrixD_ref(m * n, std::numeric_limits<OutputT>::signaling_NaN());
     gemm_cpu_h<InputT, OutputT, ComputeT, row_major, col_major, row_major>(m,
@@ -370,18 +511,93 @@ int main()
                                                                            alpha,
                                                                            beta);
 
-    auto res = compareEqual<OutputT>(matrixD.data(), matrixD_ref.data(), m * n);
+    auto validate = [&]() {
+        // Bring kernel result back to host
+        CHECK_HIP_ERROR(hipMemcpy(matrixD.data(), d_d, bytesD, hipMemcpyDeviceToHost));
 
-    if(std::get<0>(res) == false)
-    {
-        std::cout << "FAILED!\n";
-    }
-    else
+        auto res = compareEqual<OutputT>(matrixD.data(), matrixD_ref.data(), m * n);
+
+        if(std::get<0>(res) == false)
+        {
+            std::cout << "FAILED!\n";
+        }
+        else
+        {
+            std::cout << "PASSED!\n";
+        }
+
+        std::cout << "Max relative error: " << std::get<1>(res) << std::endl;
+    };
+
+    validate();
+
+#endif // !NDEBUG
+
+    /// Shape-specialized JIT
+    // Problem and leading dimensions, thread block size and alpha / beta cases
+    // are baked into the kernel as constants. Each shape is its own cache entry,
+    // so the JIT cost is paid once per shape across process restarts.
+    auto scaleClass = [](ComputeT scale) {
+        return scale == static_cast<ComputeT>(0) ? 0 : (scale == static_cast<ComputeT>(1) ? 1 : 2);
+    };
+
+    auto shapeOptions = options;
+    shapeOptions.insert(shapeOptions.end(),
+                        {"-DJIT_M=" + std::to_string(m),
+                         "-DJIT_N=" + std::to_string(n),
+                         "-DJIT_K=" + std::to_string(k),
+                         "-DJIT_LDA=" + std::to_string(lda),
+                         "-DJIT_LDB=" + std::to_string(ldb),
+                         "-DJIT_LDC=" + std::to_string(ldc),
+                         "-DJIT_LDD=" + std::to_string(ldd),
+                         "-DJIT_TBLOCK_X=" + std::to_string(T_BLOCK_X),
+                         "-DJIT_TBLOCK_Y=" + std::to_string(T_BLOCK_Y),
+                         "-DJIT_ALPHA_CLASS=" + std::to_string(scaleClass(alpha)),
+                         "-DJIT_BETA_CLASS=" + std::to_string(scaleClass(beta))});
+
+    std::string shapeNameExpression = "gemm_rocwmma_shape_d<" + std::to_string(ROCWMMA_M) + ", "
+                                      + std::to_string(ROCWMMA_N) + ", "
+                                      + std::to_string(ROCWMMA_K) + ">";
+
+    jitStart       = std::chrono::steady_clock::now();
+    auto shapeJit  = kernelCache.getFunction(source, shapeNameExpression, shapeOptions, headers);
+    jitEnd         = std::chrono::steady_clock::now();
+    auto shapeFunc = shapeJit.mFunction;
+
+    std::cout << "Kernel " << shapeNameExpression << ": "
+              << HiprtcKernelCache::originString(shapeJit.mOrigin) << " in "
+              << std::chrono::duration<double, std::milli>(jitEnd - jitStart).count() << " ms"
+              << std::endl;
+
+    struct
     {
-        std::cout << "PASSED!\n";
-    }
+        hipDeviceptr_t _d_a;
+        hipDeviceptr_t _d_b;
+        hipDeviceptr_t _d_c;
+        hipDeviceptr_t _d_d;
+        ComputeT       _alpha;
+        ComputeT       _beta;
+    } shapeArgs{d_a, d_b, d_c, d_d, alpha, beta};
 
-    std::cout << "Max relative error: " << std::get<1>(res) << std::endl;
+    // Fill output with NaN to catch contamination
+    CHECK_HIP_ERROR(hipMemset(d_d, 0xFF, bytesD));
+
+    std::cout << "Launching shape-specialized GEMM kernel..." << std::endl;
+
+    auto shapeElapsedTimeMs
+        = launchModuleKernel(shapeFunc, gridDim, blockDim, &shapeArgs, sizeof(shapeArgs));
+    auto shapeTFlopsPerSec
+        = calculateTFlopsPerSec(m, n, k, static_cast<double>(shapeElapsedTimeMs));
+
+    std::cout << ROCWMMA_M << ", " << ROCWMMA_N << ", " << ROCWMMA_K << ", " << m << ", " << n
+              << ", " << k << ", " << alpha << ", " << lda << ", " << ldb << ", " << beta << ", "
+              << ldc << ", " << ldd << ", " << shapeElapsedTimeMs << ", " << gFlops << ", "
+              << shapeTFlopsPerSec << std::endl;
+
+#if !NDEBUG
+
+    std::cout << "Validating shape-specialized result with reference..." << std::endl;
+    validate();
 
 #endif // !NDEBUG
 
@@ -393,8 +609,5 @@ int main()
 
     std::cout << "Finished!" << std::endl;
 
-    CHECK_HIP_ERROR(hipModuleUnload(module));
-    CHECK_HIPRTC_ERROR(hiprtcDestroyProgram(&prog));
-
     return 0;
 }
@@ -0,0 +1,391 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef ROCWMMA_SAMPLES_HIPRTC_KERNEL_CACHE_HPP
+#define ROCWMMA_SAMPLES_HIPRTC_KERNEL_CACHE_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <hip/hip_runtime.h>
+#include <hip/hiprtc.h>
+
+#include <rocwmma/rocwmma-version.hpp>
+
+#include "common.hpp"
+
+// JIT kernel cache for hipRTC compiled code objects.
+//
+// Compiled code objects are keyed by a hash of:
+// : the kernel source
+// : the kernel name expression (carries template arguments, e.g. "kernel<16, 16, 16>")
+// : the compile options (carries runtime defined macros)
+// : the names and sources of in-memory headers, e.g. a preprocessed rocWMMA bundle
+// : the device architecture (full gcnArchName, including target features)
+// : the hipRTC compiler version and the rocWMMA header version
+//
+// Lookups are resolved in order from:
+// 1. In-memory cache of loaded modules (lifetime of the cache object)
+// 2. On-disk cache of code objects (persistent across process restarts)
+// 3. hipRTC compilation, after which both caches are populated
+//
+// The on-disk cache directory is selected by:
+// 1. ROCWMMA_HIPRTC_CACHE_DIR environment variable (empty value disables disk caching)
+// 2. $XDG_CACHE_HOME/rocwmma/hiprtc
+// 3. $HOME/.cache/rocwmma/hiprtc
+//
+// Note: Headers included from disk are not hashed. Their changes are covered by the rocWMMA
+// version in the key; when developing against modified headers, clear the cache directory.
+class HiprtcKernelCache
+{
+public:
+    enum class Origin : uint32_t
+    {
+        Memory = 0u,
+        Disk,
+        Compiled
+    };
+
+    struct Result
+    {
+        hipFunction_t mFunction;
+        Origin        mOrigin;
+    };
+
+    // In-memory header, resolving #include <mName> of the kernel source
+    struct Header
+    {
+        char const* mName;
+        char const* mSource;
+    };
+
+    HiprtcKernelCache()
+        : HiprtcKernelCache(defaultCacheDir())
+    {
+    }
+
+    explicit HiprtcKernelCache(std::filesystem::path const& cacheDir)
+        : mCacheDir(cacheDir)
+    {
+        hipDevice_t     handle;
+        hipDeviceProp_t props;
+        CHECK_HIP_ERROR(hipGetDevice(&handle));
+        CHECK_HIP_ERROR(hipGetDeviceProperties(&props, handle));
+        mArch = props.gcnArchName;
+
+        int major, minor;
+        CHECK_HIPRTC_ERROR(hiprtcVersion(&major, &minor));
+        mCompilerVersion = std::to_string(major) + "." + std::to_string(minor);
+
+        if(!mCacheDir.empty())
+        {
+            std::error_code ec;
+            std::filesystem::create_directories(mCacheDir, ec);
+            if(ec)
+            {
+                std::cerr << "hipRTC cache: disk cache disabled, cannot create " << mCacheDir
+                          << ": " << ec.message() << std::endl;
+                mCacheDir.clear();
+            }
+        }
+    }
+
+    ~HiprtcKernelCache()
+    {
+        for(auto& entry : mModules)
+        {
+            CHECK_HIP_ERROR(hipModuleUnload(entry.second.mModule));
+        }
+    }
+
+    HiprtcKernelCache(HiprtcKernelCache const&)            = delete;
+    HiprtcKernelCache& operator=(HiprtcKernelCache const&) = delete;
+
+    // Returns the function for nameExpression compiled from source with options.
+    // nameExpression is either an extern "C" kernel name, or a template kernel
+    // instantiation such as "gemm_rocwmma_d<16, 16, 16>".
+    Result getFunction(std::string const&              source,
+                       std::string const&              nameExpression,
+                       std::vector<std::string> const& options = {},
+                       std::vector<Header> const&      headers = {})
+    {
+        auto key = hashKey(source, nameExpression, options, headers);
+
+        // 1. In-memory
+        auto found = mModules.find(key);
+        if(found != mModules.end())
+        {
+            return {found->second.mFunction, Origin::Memory};
+        }
+
+        // 2. On-disk, otherwise 3. compile and persist
+        std::string       loweredName;
+        std::vector<char> code;
+        auto              origin = Origin::Disk;
+        if(!readCodeObject(key, loweredName, code))
+        {
+            compile(source, nameExpression, options, headers, loweredName, code);
+            writeCodeObject(key, loweredName, code);
+            origin = Origin::Compiled;
+        }
+
+        Entry entry;
+        CHECK_HIP_ERROR(hipModuleLoadData(&entry.mModule, code.data()));
+        CHECK_HIP_ERROR(hipModuleGetFunction(&entry.mFunction, entry.mModule, loweredName.c_str()));
+        mModules.emplace(key, entry);
+
+        return {entry.mFunction, origin};
+    }
+
+    std::filesystem::path const& cacheDir() const
+    {
+        return mCacheDir;
+    }
+
+    static char const* originString(Origin origin)
+    {
+        switch(origin)
+        {
+        case Origin::Memory:
+            return "memory cache";
+        case Origin::Disk:
+            return "disk cache";
+        default:
+            return "compiled";
+        }
+    }
+
+    static std::filesystem::path defaultCacheDir()
+    {
+        if(auto dir = std::getenv("ROCWMMA_HIPRTC_CACHE_DIR"); dir != nullptr)
+        {
+            return std::filesystem::path(dir);
+        }
+        if(auto dir = std::getenv("XDG_CACHE_HOME"); dir != nullptr && *dir != '\0')
+        {
+            return std::filesystem::path(dir) / "rocwmma" / "hiprtc";
+        }
+        if(auto dir = std::getenv("HOME"); dir != nullptr && *dir != '\0')
+        {
+            return std::filesystem::path(dir) / ".cache" / "rocwmma" / "hiprtc";
+        }
+        return {};
+    }
+
+private:
+    struct Entry
+    {
+        hipModule_t   mModule;
+        hipFunction_t mFunction;
+    };
+
+    // Bump when the on-disk layout changes
+    static constexpr char const* Magic = "rocwmma-hiprtc-cache-v1";
+
+    // 64-bit FNV-1a, fields separated by null chars so that
+    // adjacent fields cannot alias each other.
+    uint64_t hashKey(std::string const&              source,
+                     std::string const&              nameExpression,
+                     std::vector<std::string> const& options,
+                     std::vector<Header> const&      headers) const
+    {
+        uint64_t hash    = 0xcbf29ce484222325ull;
+        auto     combine = [&hash](std::string_view field) {
+            for(auto c : field)
+            {
+                hash = (hash ^ static_cast<uint8_t>(c)) * 0x100000001b3ull;
+            }
+            hash = hash * 0x100000001b3ull; // Null separator
+        };
+
+        combine(Magic);
+        combine(source);
+        combine(nameExpression);
+        for(auto const& opt : options)
+        {
+            combine(opt);
+        }
+        for(auto const& header : headers)
+        {
+            combine(header.mName);
+            combine(header.mSource);
+        }
+        combine(mArch);
+        combine(mCompilerVersion);
+        combine(rocwmma_get_version());
+        return hash;
+    }
+
+    std::filesystem::path cachePath(uint64_t key) const
+    {
+        std::stringstream ss;
+        ss << std::hex << std::setw(16) << std::setfill('0') << key << ".co";
+        return mCacheDir / ss.str();
+    }
+
+    // File layout:
+    // <Magic>\n<loweredName>\n<codeSize>\n<code bytes>
+    bool readCodeObject(uint64_t key, std::string& loweredName, std::vector<char>& code) const
+    {
+        if(mCacheDir.empty())
+        {
+            return false;
+        }
+
+        std::ifstream file(cachePath(key), std::ios::binary);
+        if(!file)
+        {
+            return false;
+        }
+
+        std::string magic, sizeStr;
+        if(!std::getline(file, magic) || magic != Magic || !std::getline(file, loweredName)
+           || !std::getline(file, sizeStr))
+        {
+            return false;
+        }
+
+        auto size = std::strtoull(sizeStr.c_str(), nullptr, 10);
+        if(size == 0u)
+        {
+            return false;
+        }
+
+        code.resize(size);
+        file.read(code.data(), size);
+
+        // Treat truncated entries as a miss; they will be rewritten
+        return static_cast<std::size_t>(file.gcount()) == size;
+    }
+
+    // Writes to a temporary file then renames, so that concurrent processes
+    // never observe a partially written code object.
+    void writeCodeObject(uint64_t                 key,
+                         std::string const&       loweredName,
+                         std::vector<char> const& code) const
+    {
+        if(mCacheDir.empty())
+        {
+            return;
+        }
+
+        auto path = cachePath(key);
+        auto tmp  = path;
+        tmp += ".tmp" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+
+        {
+            std::ofstream file(tmp, std::ios::binary | std::ios::trunc);
+            file << Magic << '\n' << loweredName << '\n' << code.size() << '\n';
+            file.write(code.data(), code.size());
+            if(!file)
+            {
+                std::cerr << "hipRTC cache: failed to write " << tmp << std::endl;
+                return;
+            }
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(tmp, path, ec);
+        if(ec)
+        {
+            std::filesystem::remove(tmp, ec);
+        }
+    }
+
+    void compile(std::string const&              source,
+                 std::string const&              nameExpression,
+                 std::vector<std::string> const& options,
+                 std::vector<Header> const&      headers,
+                 std::string&                    loweredName,
+                 std::vector<char>&              code) const
+    {
+        std::vector<char const*> headerSources, headerNames;
+        for(auto const& header : headers)
+        {
+            headerSources.push_back(header.mSource);
+            headerNames.push_back(header.mName);
+        }
+
+        hiprtcProgram prog;
+        CHECK_HIPRTC_ERROR(hiprtcCreateProgram(&prog,
+                                               source.c_str(),
+                                               nullptr,
+                                               static_cast<int>(headers.size()),
+                                               headerSources.data(),
+                                               headerNames.data()));
+        CHECK_HIPRTC_ERROR(hiprtcAddNameExpression(prog, nameExpression.c_str()));
+
+        std::vector<char const*> opts;
+        for(auto const& opt : options)
+        {
+            opts.push_back(opt.c_str());
+        }
+
+        auto result = hiprtcCompileProgram(prog, static_cast<int>(opts.size()), opts.data());
+        if(result != HIPRTC_SUCCESS)
+        {
+            std::cout << "HipRTC compile failed." << std::endl;
+            std::cout << result << std::endl;
+            std::cout << hiprtcGetErrorString(result) << std::endl;
+
+            std::size_t logSize;
+            CHECK_HIPRTC_ERROR(hiprtcGetProgramLogSize(prog, &logSize));
+            std::cout << "Log Size: " << logSize << std::endl;
+
+            std::string log(logSize, '\0');
+            CHECK_HIPRTC_ERROR(hiprtcGetProgramLog(prog, &log[0]));
+            std::cout << log.c_str() << std::endl;
+            exit(EXIT_FAILURE);
+        }
+
+        char const* lowered;
+        CHECK_HIPRTC_ERROR(hiprtcGetLoweredName(prog, nameExpression.c_str(), &lowered));
+        loweredName = lowered;
+
+        std::size_t codeSize;
+        CHECK_HIPRTC_ERROR(hiprtcGetCodeSize(prog, &codeSize));
+        code.resize(codeSize);
+        CHECK_HIPRTC_ERROR(hiprtcGetCode(prog, code.data()));
+
+        CHECK_HIPRTC_ERROR(hiprtcDestroyProgram(&prog));
+    }
+
+    std::filesystem::path               mCacheDir;
+    std::string                         mArch;
+    std::string                         mCompilerVersion;
+    std::unordered_map<uint64_t, Entry> mModules;
+};
+
+#endif // ROCWMMA_SAMPLES_HIPRTC_KERNEL_CACHE_HPP
@@ -0,0 +1,150 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef ROCWMMA_SAMPLES_MAPPED_FILE_HPP
+#define ROCWMMA_SAMPLES_MAPPED_FILE_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <hip/hip_runtime.h>
+
+#include "common.hpp"
+
+// Read-only memory mapping of a host file, registered with HIP.
+//
+// Async copies out of the mapping DMA straight from the page cache, so file
+// backed matrices feed the GEMM pipelines without a staging copy into pinned
+// buffers. The mapping is sequential by default; prefetch() reads ahead the
+// pages of the next panels so that the page faults of the file overlap the
+// copies and kernels of the current ones, and a sweep can start before the
+// whole file is read.
+//
+// Note: Whether registration populates the whole mapping up front is up to the
+// driver. Prefetch keeps file reads ahead of the copies either way.
+class MappedFile
+{
+public:
+    explicit MappedFile(char const* path)
+    {
+        mFd = open(path, O_RDONLY);
+        if(mFd < 0)
+        {
+            std::cerr << "Cannot open " << path << std::endl;
+            exit(EXIT_FAILURE);
+        }
+
+        struct stat info;
+        if(fstat(mFd, &info) != 0 || info.st_size == 0)
+        {
+            std::cerr << "Cannot map empty file " << path << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        mBytes = static_cast<size_t>(info.st_size);
+
+        mData = mmap(nullptr, mBytes, PROT_READ, MAP_SHARED, mFd, 0);
+        if(mData == MAP_FAILED)
+        {
+            std::cerr << "Cannot map " << path << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        madvise(mData, mBytes, MADV_SEQUENTIAL);
+
+        CHECK_HIP_ERROR(hipHostRegister(mData, mBytes, hipHostRegisterReadOnly));
+    }
+
+    ~MappedFile()
+    {
+        CHECK_HIP_ERROR(hipHostUnregister(mData));
+        munmap(mData, mBytes);
+        close(mFd);
+    }
+
+    MappedFile(MappedFile const&)            = delete;
+    MappedFile& operator=(MappedFile const&) = delete;
+
+    template <typename DataT>
+    DataT const* data() const
+    {
+        return reinterpret_cast<DataT const*>(mData);
+    }
+
+    size_t size() const
+    {
+        return mBytes;
+    }
+
+    // Start reading the pages covering [offset, offset + bytes) in the background
+    void prefetch(size_t offset, size_t bytes) const
+    {
+        auto pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        auto begin    = offset / pageSize * pageSize;
+        auto end      = std::min(offset + bytes, mBytes);
+        if(begin < end)
+        {
+            madvise(reinterpret_cast<char*>(mData) + begin, end - begin, MADV_WILLNEED);
+        }
+    }
+
+    // Write a host buffer out as the contents of a file
+    static void write(char const* path, void const* data, size_t bytes)
+    {
+        auto fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if(fd < 0)
+        {
+            std::cerr << "Cannot create " << path << std::endl;
+            exit(EXIT_FAILURE);
+        }
+
+        auto bytePtr = reinterpret_cast<char const*>(data);
+        while(bytes > 0u)
+        {
+            auto written = ::write(fd, bytePtr, bytes);
+            if(written <= 0)
+            {
+                std::cerr << "Cannot write " << path << std::endl;
+                exit(EXIT_FAILURE);
+            }
+            bytePtr += written;
+            bytes -= static_cast<size_t>(written);
+        }
+        close(fd);
+    }
+
+private:
+    int    mFd;
+    void*  mData;
+    size_t mBytes;
+};
+
+#endif // ROCWMMA_SAMPLES_MAPPED_FILE_HPP
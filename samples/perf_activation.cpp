@@ -0,0 +1,297 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <type_traits>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_runtime.h>
+
+#include <rocwmma/rocwmma.hpp>
+#include <rocwmma/rocwmma_epilogue.hpp>
+
+#include "benchmark_harness.hpp"
+#include "common.hpp"
+
+using rocwmma::accumulator;
+using rocwmma::float32_t;
+using rocwmma::row_major;
+
+namespace epilogue = rocwmma::epilogue;
+
+/* Motivation
+*
+* GEMM epilogues evaluate their activation once per output element. Through libm, tanhf
+* and expf range-reduce, handle denormals and refine to 0.5 ulp, and the IEEE division of
+* the sigmoid adds a scale / fma / fixup sequence. Activation-heavy epilogues, e.g. GeGLU
+* and SwiGLU gates, or attention scores of small head dims, become VALU bound.
+*
+* The Fast activations of the epilogue API are built on the hardware approximations
+* v_exp_f32 and v_rcp_f32:
+*
+*   sigmoid(x) = rcp(1 + exp2(-x * log2(e)))
+*   tanh(x)    = 2 * sigmoid(2x) - 1
+*   silu(x)    = x * sigmoid(x)
+*   gelu(x)    = x * sigmoid(2 * sqrt(2 / pi) * (x + 0.044715 * x^3))
+*
+* The gelu form is the tanh approximation, as 0.5 * (1 + tanh(u)) = sigmoid(2u), and keeps
+* its relative accuracy for negative x where 1 + tanh(u) cancels.
+*
+* This sample applies each activation to fragments of a large float32_t matrix, once
+* (memory bound) and repeatedly in registers (VALU bound), reporting activations per second
+* and the maximum errors of a single application against a float64 host reference.
+*/
+
+// Matrix of inputs, swept over [-8, 8)
+constexpr uint32_t M          = 8192u;
+constexpr uint32_t N          = 8192u;
+constexpr double   SWEEP_MIN  = -8.0;
+constexpr double   SWEEP_SPAN = 16.0;
+constexpr uint32_t SWEEP_STEP = 4096u;
+
+// Block sizes
+constexpr uint32_t ROCWMMA_M = 16u;
+constexpr uint32_t ROCWMMA_N = 16u;
+
+// Repeated applications for the VALU bound case
+constexpr uint32_t REPEATS = 64u;
+
+// Waves per workgroup, each activating one block
+const int WAVES = 4;
+
+// Device warp size
+const uint32_t WAVE_SIZE = getWarpSize();
+
+// Thread block
+// : T_BLOCK_X must be multiple of WAVE_SIZE.
+const int T_BLOCK_X = WAVES * WAVE_SIZE;
+
+using FragAcc = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, 1, float32_t, row_major>;
+
+// libm baselines of the activations without a precise epilogue functor
+struct LibmSigmoid
+{
+    template <typename T>
+    __device__ static inline T exec(T x)
+    {
+        return 1.0f / (1.0f + expf(-x));
+    }
+};
+
+struct LibmTanh
+{
+    template <typename T>
+    __device__ static inline T exec(T x)
+    {
+        return tanhf(x);
+    }
+};
+
+template <typename ActivationT>
+__host__ char const* activationString()
+{
+    if constexpr(std::is_same_v<ActivationT, LibmSigmoid>)
+    {
+        return "sigmoid (libm)";
+    }
+    else if constexpr(std::is_same_v<ActivationT, epilogue::FastSigmoid>)
+    {
+        return "sigmoid (fast)";
+    }
+    else if constexpr(std::is_same_v<ActivationT, LibmTanh>)
+    {
+        return "tanh (libm)";
+    }
+    else if constexpr(std::is_same_v<ActivationT, epilogue::FastTanh>)
+    {
+        return "tanh (fast)";
+    }
+    else if constexpr(std::is_same_v<ActivationT, epilogue::Gelu>)
+    {
+        return "gelu";
+    }
+    else if constexpr(std::is_same_v<ActivationT, epilogue::FastGelu>)
+    {
+        return "gelu (fast)";
+    }
+    else if constexpr(std::is_same_v<ActivationT, epilogue::Silu>)
+    {
+        return "silu";
+    }
+    else
+    {
+        return "silu (fast)";
+    }
+}
+
+// float64 host reference of the activation
+template <typename ActivationT>
+__host__ double activationRef(double x)
+{
+    if constexpr(std::is_same_v<ActivationT, LibmSigmoid>
+                 || std::is_same_v<ActivationT, epilogue::FastSigmoid>)
+    {
+        return 1.0 / (1.0 + std::exp(-x));
+    }
+    else if constexpr(std::is_same_v<ActivationT, LibmTanh>
+                      || std::is_same_v<ActivationT, epilogue::FastTanh>)
+    {
+        return std::tanh(x);
+    }
+    else if constexpr(std::is_same_v<ActivationT, epilogue::Gelu>
+                      || std::is_same_v<ActivationT, epilogue::FastGelu>)
+    {
+        return 0.5 * x * (1.0 + std::tanh(0.7978845608028654 * (x + 0.044715 * x * x * x)));
+    }
+    else
+    {
+        return x / (1.0 + std::exp(-x));
+    }
+}
+
+// Each wave loads one block, activates it Repeats times in registers and stores it.
+// : in, out are in row-major format (M x N)
+template <typename ActivationT, uint32_t Repeats>
+__global__ void __launch_bounds__(WAVES * rocwmma::Constants::AMDGCN_WAVE_SIZE)
+    activation_d(float32_t const* in, float32_t* out, uint32_t m, uint32_t n)
+{
+    auto waveId
+        = (blockIdx.x * blockDim.x + threadIdx.x) / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    auto blocksN = n / ROCWMMA_N;
+    auto row     = (waveId / blocksN) * ROCWMMA_M;
+    auto col     = (waveId % blocksN) * ROCWMMA_N;
+
+    if(row >= m)
+    {
+        return;
+    }
+
+    FragAcc frag;
+    rocwmma::load_matrix_sync(frag, in + row * n + col, n);
+
+#pragma unroll
+    for(uint32_t i = 0; i < Repeats; i++)
+    {
+        rocwmma::apply_epilogue(frag, frag, epilogue::Activation<ActivationT>());
+    }
+
+    rocwmma::store_matrix_sync(out + row * n + col, frag, n);
+}
+
+template <typename ActivationT, uint32_t Repeats>
+__host__ void activation_run(float32_t const* d_in, float32_t* d_out, BenchmarkHarness& harness)
+{
+    auto gridDim  = dim3(rocwmma::ceilDiv(M / ROCWMMA_M * (N / ROCWMMA_N), WAVES));
+    auto blockDim = dim3(T_BLOCK_X);
+
+    auto kernel = [&]() {
+        hipExtLaunchKernelGGL(activation_d<ActivationT, Repeats>,
+                              gridDim,
+                              blockDim,
+                              0, // sharedMemBytes
+                              0, // stream
+                              nullptr, // Event start
+                              nullptr, // event stop
+                              0, // flags
+                              d_in,
+                              d_out,
+                              M,
+                              N);
+    };
+
+    auto stats            = harness.run(kernel);
+    auto gActivationsPerS = static_cast<double>(M) * N * Repeats / stats.mMedianMs * 1.0e-6;
+
+    std::cout << activationString<ActivationT>() << ", " << Repeats << ", " << stats.mMedianMs
+              << ", " << gActivationsPerS << ", ";
+}
+
+template <typename ActivationT>
+__host__ void activation_test(std::vector<float32_t> const& in,
+                              float32_t const*              d_in,
+                              float32_t*                    d_out,
+                              BenchmarkHarness&             harness)
+{
+    // Errors of a single application
+    activation_run<ActivationT, 1u>(d_in, d_out, harness);
+
+    std::vector<float32_t> out(in.size());
+    CHECK_HIP_ERROR(
+        hipMemcpy(out.data(), d_out, out.size() * sizeof(float32_t), hipMemcpyDeviceToHost));
+
+    auto maxAbsError = 0.0;
+    auto maxRelError = 0.0;
+    for(size_t i = 0; i < in.size(); i++)
+    {
+        auto ref    = activationRef<ActivationT>(static_cast<double>(in[i]));
+        auto error  = std::abs(static_cast<double>(out[i]) - ref);
+        maxAbsError = std::max(maxAbsError, error);
+        maxRelError = std::max(maxRelError, ref != 0.0 ? error / std::abs(ref) : error);
+    }
+
+    std::cout << maxAbsError << ", " << maxRelError << std::endl;
+
+    activation_run<ActivationT, REPEATS>(d_in, d_out, harness);
+    std::cout << "-, -" << std::endl;
+}
+
+int main()
+{
+    const size_t size  = static_cast<size_t>(M) * N;
+    const size_t bytes = size * sizeof(float32_t);
+
+    std::vector<float32_t> in(size);
+    for(size_t i = 0; i < size; i++)
+    {
+        in[i] = static_cast<float32_t>(SWEEP_MIN + SWEEP_SPAN * (i % SWEEP_STEP) / SWEEP_STEP);
+    }
+
+    float32_t *d_in, *d_out;
+    CHECK_HIP_ERROR(hipMalloc(&d_in, bytes));
+    CHECK_HIP_ERROR(hipMalloc(&d_out, bytes));
+    CHECK_HIP_ERROR(hipMemcpy(d_in, in.data(), bytes, hipMemcpyHostToDevice));
+
+    BenchmarkHarness harness;
+
+    std::cout << "Activation, Repeats, elapsedMs, GActivations/s, MaxAbsError, MaxRelError"
+              << std::endl;
+
+    activation_test<LibmSigmoid>(in, d_in, d_out, harness);
+    activation_test<epilogue::FastSigmoid>(in, d_in, d_out, harness);
+    activation_test<LibmTanh>(in, d_in, d_out, harness);
+    activation_test<epilogue::FastTanh>(in, d_in, d_out, harness);
+    activation_test<epilogue::Gelu>(in, d_in, d_out, harness);
+    activation_test<epilogue::FastGelu>(in, d_in, d_out, harness);
+    activation_test<epilogue::Silu>(in, d_in, d_out, harness);
+    activation_test<epilogue::FastSilu>(in, d_in, d_out, harness);
+
+    CHECK_HIP_ERROR(hipFree(d_in));
+    CHECK_HIP_ERROR(hipFree(d_out));
+    return 0;
+}
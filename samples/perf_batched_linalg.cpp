@@ -0,0 +1,714 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <type_traits>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_fp16.h>
+#include <hip/hip_runtime.h>
+
+#include <rocwmma/rocwmma.hpp>
+
+#include "benchmark_harness.hpp"
+#include "common.hpp"
+
+using rocwmma::accumulator;
+using rocwmma::col_major;
+using rocwmma::float32_t;
+using rocwmma::float64_t;
+using rocwmma::matrix_a;
+using rocwmma::matrix_b;
+using rocwmma::row_major;
+
+/* Motivation
+*
+* Solvers and simulations factor very many small dense matrices at once, each
+* too small to fill a device: a per-matrix library call is launch bound, and a
+* thread per matrix runs out of registers beyond a few rows.
+*
+* This sample assigns one workgroup to each n x n matrix of a batch and keeps
+* the matrix in LDS for the whole factorization. The drivers are blocked and
+* right-looking over NB x NB blocks, NB being the fragment size:
+*
+* - POTRF: Cholesky A = L x L^T of a symmetric positive definite matrix.
+* - GETRF: LU A = L x U without pivoting, L with a unit diagonal.
+* - TRSM:  X = L^-1 x B, for a lower triangular L and an n x n B.
+*
+* For each block column k:
+*
+* 1. The NB x NB diagonal block is factored (or solved, for TRSM) by the
+*    unblocked algorithm, with the workgroup sharing each rank 1 update.
+* 2. The panel below (and for GETRF, right of) the diagonal block is solved
+*    against it by substitution, a thread per row or column.
+* 3. The trailing matrix receives the rank NB update, e.g. for POTRF:
+*
+*        A(i, j) -= L(i, k) x L(j, k)^T,  k < j <= i
+*
+*    Each wave computes the update of one NB x NB block at a time with
+*    mma_sync, the blocks being distributed round robin over the waves.
+*
+* Step 3 holds O(n^3) of the work, such that the blocked drivers run mostly on
+* the matrix cores. Each driver is compared against its Unblocked variant: the
+* same kernel running the scalar algorithm of step 1 over the whole matrix.
+*
+* Note: n must be a multiple of NB, and the matrix must fit in the LDS of a
+* workgroup: n <= 128 for fp32 and n <= 64 for fp64 with 64KB of LDS.
+* Note: GETRF does not pivot. It is stable for diagonally dominant matrices
+* such as the inputs of this sample, but not in general.
+*/
+
+// Block size of the blocked drivers
+// : ROCWMMA_M = ROCWMMA_N = ROCWMMA_K, such that the fragments tile the matrix
+// in square blocks.
+const int ROCWMMA_M = 16;
+const int ROCWMMA_N = 16;
+const int ROCWMMA_K = 16;
+const int NB        = ROCWMMA_M;
+
+// Device warp size
+const uint32_t WAVE_SIZE = getWarpSize();
+
+// Thread block
+// : T_BLOCK_X must be multiple of WAVE_SIZE.
+// Note: One workgroup per matrix of the batch.
+const int T_BLOCK_X = 4 * WAVE_SIZE;
+
+// Elements per batch, such that all sizes move a similar amount of data
+const uint32_t BATCH_ELEMENTS = 1u << 24;
+
+// Matrices of each batch that are validated
+const uint32_t VALIDATION_SAMPLES = 16u;
+
+enum class Routine : uint32_t
+{
+    Potrf,
+    Getrf,
+    Trsm
+};
+
+inline char const* routineString(Routine routine)
+{
+    switch(routine)
+    {
+    case Routine::Potrf:
+        return "POTRF";
+    case Routine::Getrf:
+        return "GETRF";
+    case Routine::Trsm:
+    default:
+        return "TRSM";
+    }
+}
+
+///
+/// Workgroup building blocks. All threads of the workgroup must call them,
+/// except for mmaUpdate which is called by one wave.
+///
+
+// Copies the n x n matrix src to dst
+template <typename DataT>
+__device__ inline void copyMatrix(DataT* dst, DataT const* src, uint32_t n)
+{
+    for(uint32_t i = threadIdx.x; i < n * n; i += blockDim.x)
+    {
+        dst[i] = src[i];
+    }
+}
+
+// Unblocked Cholesky of the size x size block at a, in place.
+// The lower triangle receives L. The upper triangle is not referenced.
+template <typename DataT>
+__device__ inline void potrfUnblocked(DataT* a, uint32_t lda, uint32_t size)
+{
+    for(uint32_t k = 0; k < size; k++)
+    {
+        if(threadIdx.x == 0)
+        {
+            a[k * lda + k] = sqrt(a[k * lda + k]);
+        }
+        __syncthreads();
+
+        auto diag = a[k * lda + k];
+        for(uint32_t i = k + 1u + threadIdx.x; i < size; i += blockDim.x)
+        {
+            a[i * lda + k] /= diag;
+        }
+        __syncthreads();
+
+        // Rank 1 update of the trailing lower triangle
+        auto trailing = size - k - 1u;
+        for(uint32_t idx = threadIdx.x; idx < trailing * trailing; idx += blockDim.x)
+        {
+            auto i = k + 1u + idx / trailing;
+            auto j = k + 1u + idx % trailing;
+            if(j <= i)
+            {
+                a[i * lda + j] -= a[i * lda + k] * a[j * lda + k];
+            }
+        }
+        __syncthreads();
+    }
+}
+
+// Unblocked LU without pivoting of the size x size block at a, in place.
+// The strict lower triangle receives L, the upper triangle U.
+template <typename DataT>
+__device__ inline void getrfUnblocked(DataT* a, uint32_t lda, uint32_t size)
+{
+    for(uint32_t k = 0; k < size; k++)
+    {
+        auto diag = a[k * lda + k];
+        for(uint32_t i = k + 1u + threadIdx.x; i < size; i += blockDim.x)
+        {
+            a[i * lda + k] /= diag;
+        }
+        __syncthreads();
+
+        // Rank 1 update of the trailing matrix
+        auto trailing = size - k - 1u;
+        for(uint32_t idx = threadIdx.x; idx < trailing * trailing; idx += blockDim.x)
+        {
+            auto i = k + 1u + idx / trailing;
+            auto j = k + 1u + idx % trailing;
+            a[i * lda + j] -= a[i * lda + k] * a[k * lda + j];
+        }
+        __syncthreads();
+    }
+}
+
+// Forward substitution L x X = B of the size x cols block at b, in place, for the
+// size x size lower triangle at l. Unit ignores the diagonal of l.
+// One thread per column of B. Does not synchronize.
+template <bool Unit, typename DataT>
+__device__ inline void trsmLeftLower(
+    DataT const* l, uint32_t ldl, DataT* b, uint32_t ldb, uint32_t size, uint32_t cols)
+{
+    for(uint32_t c = threadIdx.x; c < cols; c += blockDim.x)
+    {
+        for(uint32_t r = 0; r < size; r++)
+        {
+            auto x = b[r * ldb + c];
+            for(uint32_t p = 0; p < r; p++)
+            {
+                x -= l[r * ldl + p] * b[p * ldb + c];
+            }
+            b[r * ldb + c] = Unit ? x : x / l[r * ldl + r];
+        }
+    }
+}
+
+// Substitution X x U = B of the rows x NB block at b, in place, for the NB x NB upper
+// triangle at u, or the transpose of its lower triangle when Transpose.
+// One thread per row of B. Does not synchronize.
+template <bool Transpose, typename DataT>
+__device__ inline void
+    trsmRightUpper(DataT const* u, uint32_t ldu, DataT* b, uint32_t ldb, uint32_t rows)
+{
+    for(uint32_t r = threadIdx.x; r < rows; r += blockDim.x)
+    {
+        for(uint32_t c = 0; c < NB; c++)
+        {
+            auto x = b[r * ldb + c];
+            for(uint32_t p = 0; p < c; p++)
+            {
+                x -= b[r * ldb + p] * (Transpose ? u[c * ldu + p] : u[p * ldu + c]);
+            }
+            b[r * ldb + c] = x / u[c * ldu + c];
+        }
+    }
+}
+
+// C -= A x B on NB x NB blocks, by the calling wave.
+// A and C are row major, B is LayoutB.
+template <typename LayoutB, typename DataT>
+__device__ inline void mmaUpdate(DataT*       c,
+                                 uint32_t     ldc,
+                                 DataT const* a,
+                                 uint32_t     lda,
+                                 DataT const* b,
+                                 uint32_t     ldb)
+{
+    auto fragA = rocwmma::fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, DataT, row_major>();
+    auto fragB = rocwmma::fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, DataT, LayoutB>();
+    auto fragC = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, DataT>();
+
+    rocwmma::load_matrix_sync(fragA, a, lda);
+    rocwmma::load_matrix_sync(fragB, b, ldb);
+    rocwmma::load_matrix_sync(fragC, c, ldc, rocwmma::mem_row_major);
+
+    // Accumulate -A x B into C
+    for(int i = 0; i < fragA.num_elements; i++)
+    {
+        fragA.x[i] = -fragA.x[i];
+    }
+    rocwmma::mma_sync(fragC, fragA, fragB, fragC);
+
+    rocwmma::store_matrix_sync(c, fragC, ldc, rocwmma::mem_row_major);
+}
+
+// Round robin owner of the blocks of the trailing update
+__device__ inline bool ownsBlock(uint32_t& blockCount)
+{
+    auto waveCount = blockDim.x / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    auto waveIdx   = threadIdx.x / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    return (blockCount++ % waveCount) == waveIdx;
+}
+
+///
+/// Batched kernels: matrix blockIdx.x of the batch, n x n row major matrices
+/// stored contiguously. The matrix is held in n * n elements of dynamic LDS.
+///
+
+// L of A = L x L^T. The upper triangle of L is zeroed.
+template <typename DataT, bool Blocked>
+__global__ void potrf_batched_d(uint32_t n, DataT const* a, DataT* l)
+{
+    HIP_DYNAMIC_SHARED(void*, localMemPtr);
+    auto lds         = reinterpret_cast<DataT*>(localMemPtr);
+    auto batchOffset = static_cast<uint64_t>(blockIdx.x) * n * n;
+
+    copyMatrix(lds, a + batchOffset, n);
+    __syncthreads();
+
+    if constexpr(Blocked)
+    {
+        auto blocks = n / NB;
+        for(uint32_t kb = 0; kb < blocks; kb++)
+        {
+            auto k0   = kb * NB;
+            auto diag = lds + k0 * n + k0;
+
+            // L(k, k), then L(i, k) = A(i, k) x L(k, k)^-T
+            potrfUnblocked(diag, n, NB);
+            trsmRightUpper<true>(diag, n, diag + NB * n, n, n - k0 - NB);
+            __syncthreads();
+
+            // A(i, j) -= L(i, k) x L(j, k)^T over the lower triangle of blocks
+            auto blockCount = 0u;
+            for(uint32_t bi = kb + 1u; bi < blocks; bi++)
+            {
+                for(uint32_t bj = kb + 1u; bj <= bi; bj++)
+                {
+                    if(ownsBlock(blockCount))
+                    {
+                        mmaUpdate<col_major>(lds + (bi * n + bj) * NB,
+                                             n,
+                                             lds + bi * NB * n + k0,
+                                             n,
+                                             lds + bj * NB * n + k0,
+                                             n);
+                    }
+                }
+            }
+            __syncthreads();
+        }
+    }
+    else
+    {
+        potrfUnblocked(lds, n, n);
+    }
+
+    for(uint32_t i = threadIdx.x; i < n * n; i += blockDim.x)
+    {
+        l[batchOffset + i] = (i % n > i / n) ? static_cast<DataT>(0) : lds[i];
+    }
+}
+
+// L and U of A = L x U, packed in place of A.
+template <typename DataT, bool Blocked>
+__global__ void getrf_batched_d(uint32_t n, DataT const* a, DataT* lu)
+{
+    HIP_DYNAMIC_SHARED(void*, localMemPtr);
+    auto lds         = reinterpret_cast<DataT*>(localMemPtr);
+    auto batchOffset = static_cast<uint64_t>(blockIdx.x) * n * n;
+
+    copyMatrix(lds, a + batchOffset, n);
+    __syncthreads();
+
+    if constexpr(Blocked)
+    {
+        auto blocks = n / NB;
+        for(uint32_t kb = 0; kb < blocks; kb++)
+        {
+            auto k0   = kb * NB;
+            auto diag = lds + k0 * n + k0;
+
+            // L(k, k) and U(k, k), then L(i, k) = A(i, k) x U(k, k)^-1
+            // and U(k, j) = L(k, k)^-1 x A(k, j)
+            getrfUnblocked(diag, n, NB);
+            trsmRightUpper<false>(diag, n, diag + NB * n, n, n - k0 - NB);
+            trsmLeftLower<true>(diag, n, diag + NB, n, NB, n - k0 - NB);
+            __syncthreads();
+
+            // A(i, j) -= L(i, k) x U(k, j) over the trailing blocks
+            auto blockCount = 0u;
+            for(uint32_t bi = kb + 1u; bi < blocks; bi++)
+            {
+                for(uint32_t bj = kb + 1u; bj < blocks; bj++)
+                {
+                    if(ownsBlock(blockCount))
+                    {
+                        mmaUpdate<row_major>(lds + (bi * n + bj) * NB,
+                                             n,
+                                             lds + bi * NB * n + k0,
+                                             n,
+                                             lds + k0 * n + bj * NB,
+                                             n);
+                    }
+                }
+            }
+            __syncthreads();
+        }
+    }
+    else
+    {
+        getrfUnblocked(lds, n, n);
+    }
+
+    copyMatrix(lu + batchOffset, lds, n);
+}
+
+// X = L^-1 x B. B is held in LDS, L is read from global memory.
+template <typename DataT, bool Blocked>
+__global__ void trsm_batched_d(uint32_t n, DataT const* l, DataT const* b, DataT* x)
+{
+    HIP_DYNAMIC_SHARED(void*, localMemPtr);
+    auto lds         = reinterpret_cast<DataT*>(localMemPtr);
+    auto batchOffset = static_cast<uint64_t>(blockIdx.x) * n * n;
+
+    l += batchOffset;
+    copyMatrix(lds, b + batchOffset, n);
+    __syncthreads();
+
+    if constexpr(Blocked)
+    {
+        auto blocks = n / NB;
+        for(uint32_t kb = 0; kb < blocks; kb++)
+        {
+            auto k0 = kb * NB;
+
+            // X(k) = L(k, k)^-1 x B(k)
+            trsmLeftLower<false>(l + k0 * n + k0, n, lds + k0 * n, n, NB, n);
+            __syncthreads();
+
+            // B(i) -= L(i, k) x X(k) over the blocks of the rows below
+            auto blockCount = 0u;
+            for(uint32_t bi = kb + 1u; bi < blocks; bi++)
+            {
+                for(uint32_t bj = 0u; bj < blocks; bj++)
+                {
+                    if(ownsBlock(blockCount))
+                    {
+                        mmaUpdate<row_major>(lds + (bi * n + bj) * NB,
+                                             n,
+                                             l + bi * NB * n + k0,
+                                             n,
+                                             lds + k0 * n + bj * NB,
+                                             n);
+                    }
+                }
+            }
+            __syncthreads();
+        }
+    }
+    else
+    {
+        trsmLeftLower<false>(l, n, lds, n, n, n);
+        __syncthreads();
+    }
+
+    copyMatrix(x + batchOffset, lds, n);
+}
+
+// Normwise backward error of the sampled matrices of the batch:
+//
+//     max |P - R| / (n * eps * max |R|)
+//
+// where product(b, P) computes P from the results of matrix b, and R is the
+// reference it should reproduce. Errors of O(1) are at the rounding of DataT.
+template <typename DataT, typename ProductT>
+double backwardError(uint32_t n, uint32_t batch, std::vector<DataT> const& ref, ProductT&& product)
+{
+    auto stride   = std::max(batch / VALIDATION_SAMPLES, 1u);
+    auto eps      = static_cast<double>(std::numeric_limits<DataT>::epsilon());
+    auto maxError = 0.0;
+
+    std::vector<double> p(n * n);
+    for(uint32_t b = 0; b < batch; b += stride)
+    {
+        product(b, p.data());
+
+        auto refB   = ref.data() + static_cast<uint64_t>(b) * n * n;
+        auto refMax = 0.0;
+        auto errMax = 0.0;
+        for(uint32_t i = 0; i < n * n; i++)
+        {
+            refMax = std::max(refMax, std::abs(static_cast<double>(refB[i])));
+            errMax = std::max(errMax, std::abs(p[i] - static_cast<double>(refB[i])));
+        }
+        maxError = std::max(maxError, errMax / (n * eps * refMax));
+    }
+    return maxError;
+}
+
+template <typename DataT>
+__host__ void linalg_test(uint32_t n)
+{
+    // Bounds check
+    if(n < NB || n % NB || n * n * sizeof(DataT) > 65536u)
+    {
+        std::cout << "Unsupported size!\n";
+        return;
+    }
+
+    auto batch    = BATCH_ELEMENTS / (n * n);
+    auto elements = static_cast<size_t>(batch) * n * n;
+    auto ldsBytes = n * n * sizeof(DataT);
+
+    // Symmetric, strictly diagonally dominant A with a positive diagonal: positive
+    // definite for POTRF, and safe to factor without pivoting for GETRF.
+    std::vector<DataT> matrixA(elements);
+    std::vector<DataT> matrixB(elements);
+    for(uint32_t b = 0; b < batch; b++)
+    {
+        auto matA = matrixA.data() + static_cast<uint64_t>(b) * n * n;
+        for(uint32_t i = 0; i < n; i++)
+        {
+            for(uint32_t j = 0; j < i; j++)
+            {
+                auto value = static_cast<DataT>(2.0 * rand() / RAND_MAX - 1.0);
+                matA[i * n + j] = matA[j * n + i] = value;
+            }
+            matA[i * n + i] = static_cast<DataT>(n + 1.0 * rand() / RAND_MAX);
+        }
+    }
+    fillRand(matrixB.data(), batch * n, n);
+
+    // Allocate and copy device memory
+    DataT* d_a;
+    DataT* d_b;
+    DataT* d_l;
+    DataT* d_lu;
+    DataT* d_x;
+
+    const size_t bytes = elements * sizeof(DataT);
+
+    CHECK_HIP_ERROR(hipMalloc(&d_a, bytes));
+    CHECK_HIP_ERROR(hipMalloc(&d_b, bytes));
+    CHECK_HIP_ERROR(hipMalloc(&d_l, bytes));
+    CHECK_HIP_ERROR(hipMalloc(&d_lu, bytes));
+    CHECK_HIP_ERROR(hipMalloc(&d_x, bytes));
+
+    CHECK_HIP_ERROR(hipMemcpy(d_a, matrixA.data(), bytes, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_b, matrixB.data(), bytes, hipMemcpyHostToDevice));
+
+    auto gridDim  = dim3(batch);
+    auto blockDim = dim3(T_BLOCK_X);
+
+    auto potrfKernel = [&](auto blocked) {
+        hipExtLaunchKernelGGL(potrf_batched_d<DataT, decltype(blocked)::value>,
+                              gridDim,
+                              blockDim,
+                              ldsBytes,
+                              0,
+                              nullptr,
+                              nullptr,
+                              0,
+                              n,
+                              d_a,
+                              d_l);
+    };
+
+    auto getrfKernel = [&](auto blocked) {
+        hipExtLaunchKernelGGL(getrf_batched_d<DataT, decltype(blocked)::value>,
+                              gridDim,
+                              blockDim,
+                              ldsBytes,
+                              0,
+                              nullptr,
+                              nullptr,
+                              0,
+                              n,
+                              d_a,
+                              d_lu);
+    };
+
+    // Solves against the L of the last POTRF run
+    auto trsmKernel = [&](auto blocked) {
+        hipExtLaunchKernelGGL(trsm_batched_d<DataT, decltype(blocked)::value>,
+                              gridDim,
+                              blockDim,
+                              ldsBytes,
+                              0,
+                              nullptr,
+                              nullptr,
+                              0,
+                              n,
+                              d_l,
+                              d_b,
+                              d_x);
+    };
+
+    // Products of the results, in double
+    std::vector<DataT> matrixL(elements);
+    std::vector<DataT> matrixLU(elements);
+    std::vector<DataT> matrixX(elements);
+
+    auto validate = [&](Routine routine) {
+        switch(routine)
+        {
+        case Routine::Potrf:
+            CHECK_HIP_ERROR(hipMemcpy(matrixL.data(), d_l, bytes, hipMemcpyDeviceToHost));
+            return backwardError(n, batch, matrixA, [&](uint32_t b, double* p) {
+                auto matL = matrixL.data() + static_cast<uint64_t>(b) * n * n;
+                for(uint32_t i = 0; i < n; i++)
+                {
+                    for(uint32_t j = 0; j < n; j++)
+                    {
+                        auto sum = 0.0;
+                        for(uint32_t k = 0; k <= std::min(i, j); k++)
+                        {
+                            sum += static_cast<double>(matL[i * n + k]) * matL[j * n + k];
+                        }
+                        p[i * n + j] = sum;
+                    }
+                }
+            });
+        case Routine::Getrf:
+            CHECK_HIP_ERROR(hipMemcpy(matrixLU.data(), d_lu, bytes, hipMemcpyDeviceToHost));
+            return backwardError(n, batch, matrixA, [&](uint32_t b, double* p) {
+                auto matLU = matrixLU.data() + static_cast<uint64_t>(b) * n * n;
+                for(uint32_t i = 0; i < n; i++)
+                {
+                    for(uint32_t j = 0; j < n; j++)
+                    {
+                        // Unit diagonal of L
+                        auto sum = (i <= j) ? static_cast<double>(matLU[i * n + j]) : 0.0;
+                        for(uint32_t k = 0; k < std::min(i, j + 1u); k++)
+                        {
+                            sum += static_cast<double>(matLU[i * n + k]) * matLU[k * n + j];
+                        }
+                        p[i * n + j] = sum;
+                    }
+                }
+            });
+        case Routine::Trsm:
+        default:
+            CHECK_HIP_ERROR(hipMemcpy(matrixL.data(), d_l, bytes, hipMemcpyDeviceToHost));
+            CHECK_HIP_ERROR(hipMemcpy(matrixX.data(), d_x, bytes, hipMemcpyDeviceToHost));
+            return backwardError(n, batch, matrixB, [&](uint32_t b, double* p) {
+                auto offset = static_cast<uint64_t>(b) * n * n;
+                auto matL   = matrixL.data() + offset;
+                auto matX   = matrixX.data() + offset;
+                for(uint32_t i = 0; i < n; i++)
+                {
+                    for(uint32_t j = 0; j < n; j++)
+                    {
+                        auto sum = 0.0;
+                        for(uint32_t k = 0; k <= i; k++)
+                        {
+                            sum += static_cast<double>(matL[i * n + k]) * matX[k * n + j];
+                        }
+                        p[i * n + j] = sum;
+                    }
+                }
+            });
+        }
+    };
+
+    // Runs are timed individually, with warm and cold caches
+    BenchmarkHarness harness;
+
+    auto echo = [&](Routine routine, bool blocked, auto&& kernel) {
+        // Flops per matrix: n^3 / 3 for POTRF, 2n^3 / 3 for GETRF and n^3 for TRSM
+        auto flops = static_cast<double>(n) * n * n * batch;
+        flops *= (routine == Routine::Potrf) ? 1.0 / 3.0
+                                             : ((routine == Routine::Getrf) ? 2.0 / 3.0 : 1.0);
+
+        for(auto cacheState :
+            {BenchmarkHarness::CacheState::Warm, BenchmarkHarness::CacheState::Cold})
+        {
+            auto stats = harness.run(kernel, cacheState);
+
+            std::cout << routineString(routine) << ", " << (blocked ? "Blocked" : "Unblocked")
+                      << ", " << rocwmma::dataTypeToString<DataT>() << ", " << n << ", "
+                      << batch << ", "
+                      << (cacheState == BenchmarkHarness::CacheState::Warm ? "warm" : "cold")
+                      << ", " << stats.mMedianMs << ", "
+                      << flops / (stats.mMedianMs * 1.0e6) << ", " << validate(routine)
+                      << ", ";
+            BenchmarkHarness::printStats(std::cout, stats) << std::endl;
+        }
+    };
+
+    // TRSM of each variant solves against the L of the POTRF run before it
+    echo(Routine::Potrf, false, [&]() { potrfKernel(std::false_type{}); });
+    echo(Routine::Getrf, false, [&]() { getrfKernel(std::false_type{}); });
+    echo(Routine::Trsm, false, [&]() { trsmKernel(std::false_type{}); });
+
+    echo(Routine::Potrf, true, [&]() { potrfKernel(std::true_type{}); });
+    echo(Routine::Getrf, true, [&]() { getrfKernel(std::true_type{}); });
+    echo(Routine::Trsm, true, [&]() { trsmKernel(std::true_type{}); });
+
+    // Release device memory
+    CHECK_HIP_ERROR(hipFree(d_a));
+    CHECK_HIP_ERROR(hipFree(d_b));
+    CHECK_HIP_ERROR(hipFree(d_l));
+    CHECK_HIP_ERROR(hipFree(d_lu));
+    CHECK_HIP_ERROR(hipFree(d_x));
+}
+
+int main()
+{
+    // fp32 and fp64 mma are supported on gfx9 only, fp64 on gfx90a and later
+    if(!isGfx9())
+    {
+        std::cout << "Batched linear algebra not supported on this device" << std::endl;
+        return 0;
+    }
+
+    std::cout << "Routine, Variant, DataType, N, Batch, Cache, elapsedMs, GFlops/s, "
+              << "BackwardError, " << BenchmarkHarness::statsHeader() << std::endl;
+
+    for(auto n : {16u, 32u, 64u, 128u})
+    {
+        linalg_test<float32_t>(n);
+    }
+
+    if(isF64Supported())
+    {
+        for(auto n : {16u, 32u, 64u})
+        {
+            linalg_test<float64_t>(n);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,530 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <complex>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_runtime.h>
+
+#include <rocwmma/rocwmma.hpp>
+
+#include "benchmark_harness.hpp"
+#include "common.hpp"
+
+/* Motivation
+*
+* rocWMMA fragments hold real data only. A complex GEMM D = alpha * (A x B) + beta * C
+* decomposes into real GEMMs of the real and imaginary planes:
+*
+* 4M: Re(AB) = Ar Br - Ai Bi
+*     Im(AB) = Ar Bi + Ai Br                      (4 real mma per block)
+*
+* 3M (Gauss): T1 = Ar Br, T2 = Ai Bi, T3 = (Ar + Ai)(Br + Bi)
+*     Re(AB) = T1 - T2
+*     Im(AB) = T3 - T1 - T2                       (3 real mma per block)
+*
+* Instead of four separate real GEMM launches, each workgroup here stages its A and B
+* tiles into LDS once per K step as real planes: re, im and, for 3M, re + im. All waves
+* of the workgroup load their fragments from the shared planes. Both methods keep three
+* accumulators, so the planes are combined element-wise in registers.
+*
+* 3M saves a quarter of the mma at the cost of accuracy: the imaginary part is a
+* difference of products, and its error grows with |Ar + Ai| |Br + Bi| rather than with
+* |A| |B|.
+*
+* Complex data is accepted in two storage formats:
+* : interleaved, (re, im) pairs as in std::complex
+* : planar, the whole re plane followed by the whole im plane
+* Staging and the epilogue read and write element-wise, such that the format only
+* affects address calculation.
+*/
+
+using rocwmma::accumulator;
+using rocwmma::col_major;
+using rocwmma::float32_t;
+using rocwmma::float64_t;
+using rocwmma::matrix_a;
+using rocwmma::matrix_b;
+using rocwmma::row_major;
+
+// Supports ROCWMMA_M/N square sizes of
+// : 16 x 16
+const int ROCWMMA_M = 16;
+const int ROCWMMA_N = 16;
+
+// Supports ROCWMMA_K sizes as
+// : multiples of 4.
+const int ROCWMMA_K = 16;
+
+// Device warp size
+const uint32_t WAVE_SIZE = getWarpSize();
+
+// Thread block
+// : WAVES_X x WAVES_Y waves, each computing one BLOCK_M x BLOCK_N output block
+const int WAVES_X   = 2;
+const int WAVES_Y   = 2;
+const int T_BLOCK_X = WAVES_X * WAVE_SIZE;
+const int T_BLOCK_Y = WAVES_Y;
+
+// Macro tile of the workgroup
+const int MACRO_M = WAVES_X * ROCWMMA_M;
+const int MACRO_N = WAVES_Y * ROCWMMA_N;
+
+// Complex storage of interleaved (re, im) pairs
+struct interleaved
+{
+    template <typename DataT>
+    __device__ __host__ static inline DataT& re(DataT* data, size_t idx, size_t planeSize)
+    {
+        return data[2u * idx];
+    }
+
+    template <typename DataT>
+    __device__ __host__ static inline DataT& im(DataT* data, size_t idx, size_t planeSize)
+    {
+        return data[2u * idx + 1u];
+    }
+};
+
+// Complex storage of a re plane followed by an im plane
+struct planar
+{
+    template <typename DataT>
+    __device__ __host__ static inline DataT& re(DataT* data, size_t idx, size_t planeSize)
+    {
+        return data[idx];
+    }
+
+    template <typename DataT>
+    __device__ __host__ static inline DataT& im(DataT* data, size_t idx, size_t planeSize)
+    {
+        return data[planeSize + idx];
+    }
+};
+
+// In this simplified example, we assume:
+// : A is in row-major format     (M x K)
+// : B is in col-major format     (K x N)
+// : C, D are in row-major format (M x N)
+// : M, N and K are multiples of the macro tile and ROCWMMA_K
+// : Planar plane sizes are M x lda, N x ldb, M x ldc and M x ldd
+template <typename DataT, typename StorageT, bool Gauss>
+__global__ void cgemm_rocwmma_d(uint32_t     m,
+                                uint32_t     n,
+                                uint32_t     k,
+                                DataT const* a,
+                                DataT const* b,
+                                DataT const* c,
+                                DataT*       d,
+                                uint32_t     lda,
+                                uint32_t     ldb,
+                                uint32_t     ldc,
+                                uint32_t     ldd,
+                                DataT        alphaRe,
+                                DataT        alphaIm,
+                                DataT        betaRe,
+                                DataT        betaIm)
+{
+    constexpr uint32_t WaveSize        = rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    constexpr uint32_t Planes          = Gauss ? 3u : 2u;
+    constexpr uint32_t PlaneSizeA      = MACRO_M * ROCWMMA_K;
+    constexpr uint32_t PlaneSizeB      = MACRO_N * ROCWMMA_K;
+    constexpr uint32_t TileSize        = ROCWMMA_M * ROCWMMA_N;
+    constexpr uint32_t ElementsPerLane = TileSize / WaveSize;
+
+    // Staged planes: re, im and for 3M, re + im.
+    __shared__ DataT sA[Planes][PlaneSizeA];
+    __shared__ DataT sB[Planes][PlaneSizeB];
+
+    // Per-wave re and im output tiles for the epilogue
+    __shared__ DataT sD[WAVES_X * WAVES_Y][2u][TileSize];
+
+    using FragA   = rocwmma::fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, DataT, row_major>;
+    using FragB   = rocwmma::fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, DataT, col_major>;
+    using FragAcc = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, DataT>;
+
+    FragA   fragA[Planes];
+    FragB   fragB[Planes];
+    FragAcc fragAcc[3];
+
+    // 3M: T1, T2, T3
+    // 4M: Ar Br, Ai Bi, Ar Bi + Ai Br
+    for(auto& acc : fragAcc)
+    {
+        rocwmma::fill_fragment(acc, static_cast<DataT>(0));
+    }
+
+    auto tid       = threadIdx.y * blockDim.x + threadIdx.x;
+    auto blockSize = blockDim.x * blockDim.y;
+    auto waveX     = threadIdx.x / WaveSize;
+    auto waveY     = threadIdx.y;
+    auto lane      = threadIdx.x % WaveSize;
+
+    // Macro tile and wave block origins
+    auto blockRow = blockIdx.x * MACRO_M;
+    auto blockCol = blockIdx.y * MACRO_N;
+    auto waveRow  = waveX * ROCWMMA_M;
+    auto waveCol  = waveY * ROCWMMA_N;
+
+    auto planeA = static_cast<size_t>(m) * lda;
+    auto planeB = static_cast<size_t>(n) * ldb;
+
+    for(uint32_t kk = 0; kk < k; kk += ROCWMMA_K)
+    {
+        // Stage the A tile, row major
+        for(uint32_t i = tid; i < PlaneSizeA; i += blockSize)
+        {
+            auto idx = static_cast<size_t>(blockRow + i / ROCWMMA_K) * lda + kk + i % ROCWMMA_K;
+            auto re  = StorageT::re(a, idx, planeA);
+            auto im  = StorageT::im(a, idx, planeA);
+
+            sA[0][i] = re;
+            sA[1][i] = im;
+            if constexpr(Gauss)
+            {
+                sA[2][i] = re + im;
+            }
+        }
+
+        // Stage the B tile, col major
+        for(uint32_t i = tid; i < PlaneSizeB; i += blockSize)
+        {
+            auto idx = static_cast<size_t>(blockCol + i / ROCWMMA_K) * ldb + kk + i % ROCWMMA_K;
+            auto re  = StorageT::re(b, idx, planeB);
+            auto im  = StorageT::im(b, idx, planeB);
+
+            sB[0][i] = re;
+            sB[1][i] = im;
+            if constexpr(Gauss)
+            {
+                sB[2][i] = re + im;
+            }
+        }
+
+        rocwmma::synchronize_workgroup();
+
+        // Each wave loads its fragments from the shared planes
+        for(uint32_t p = 0; p < Planes; p++)
+        {
+            rocwmma::load_matrix_sync(fragA[p], sA[p] + waveRow * ROCWMMA_K, ROCWMMA_K);
+            rocwmma::load_matrix_sync(fragB[p], sB[p] + waveCol * ROCWMMA_K, ROCWMMA_K);
+        }
+
+        if constexpr(Gauss)
+        {
+            rocwmma::mma_sync(fragAcc[0], fragA[0], fragB[0], fragAcc[0]);
+            rocwmma::mma_sync(fragAcc[1], fragA[1], fragB[1], fragAcc[1]);
+            rocwmma::mma_sync(fragAcc[2], fragA[2], fragB[2], fragAcc[2]);
+        }
+        else
+        {
+            rocwmma::mma_sync(fragAcc[0], fragA[0], fragB[0], fragAcc[0]);
+            rocwmma::mma_sync(fragAcc[1], fragA[1], fragB[1], fragAcc[1]);
+            rocwmma::mma_sync(fragAcc[2], fragA[0], fragB[1], fragAcc[2]);
+            rocwmma::mma_sync(fragAcc[2], fragA[1], fragB[0], fragAcc[2]);
+        }
+
+        // Planes are overwritten in the next K step
+        rocwmma::synchronize_workgroup();
+    }
+
+    // Combine planes: fragAcc[0] = Re(AB), fragAcc[2] = Im(AB)
+    for(int i = 0; i < fragAcc[0].num_elements; ++i)
+    {
+        auto t1 = fragAcc[0].x[i];
+        auto t2 = fragAcc[1].x[i];
+
+        fragAcc[0].x[i] = t1 - t2;
+        if constexpr(Gauss)
+        {
+            fragAcc[2].x[i] = fragAcc[2].x[i] - t1 - t2;
+        }
+    }
+
+    // Gather the complex result element-wise through LDS
+    auto sTile = sD[waveY * WAVES_X + waveX];
+    rocwmma::store_matrix_sync(sTile[0], fragAcc[0], ROCWMMA_N, rocwmma::mem_row_major);
+    rocwmma::store_matrix_sync(sTile[1], fragAcc[2], ROCWMMA_N, rocwmma::mem_row_major);
+    rocwmma::synchronize_workgroup();
+
+    // D = alpha * AB + beta * C
+    auto planeC = static_cast<size_t>(m) * ldc;
+    auto planeD = static_cast<size_t>(m) * ldd;
+
+#pragma unroll
+    for(uint32_t e = 0; e < ElementsPerLane; e++)
+    {
+        auto idx = lane + e * WaveSize;
+        auto row = blockRow + waveRow + idx / ROCWMMA_N;
+        auto col = blockCol + waveCol + idx % ROCWMMA_N;
+
+        auto abRe = sTile[0][idx];
+        auto abIm = sTile[1][idx];
+
+        auto cIdx = static_cast<size_t>(row) * ldc + col;
+        auto cRe  = StorageT::re(c, cIdx, planeC);
+        auto cIm  = StorageT::im(c, cIdx, planeC);
+
+        auto dIdx = static_cast<size_t>(row) * ldd + col;
+        StorageT::re(d, dIdx, planeD)
+            = alphaRe * abRe - alphaIm * abIm + betaRe * cRe - betaIm * cIm;
+        StorageT::im(d, dIdx, planeD)
+            = alphaRe * abIm + alphaIm * abRe + betaRe * cIm + betaIm * cRe;
+    }
+}
+
+// Host complex GEMM reference in float64_t
+__host__ void cgemm_cpu_h(uint32_t                                 m,
+                          uint32_t                                 n,
+                          uint32_t                                 k,
+                          std::vector<std::complex<double>> const& a,
+                          std::vector<std::complex<double>> const& b,
+                          std::vector<std::complex<double>> const& c,
+                          std::vector<std::complex<double>>&       d,
+                          std::complex<double>                     alpha,
+                          std::complex<double>                     beta)
+{
+#pragma omp parallel for
+    for(int i = 0; i < m; ++i)
+    {
+        for(int j = 0; j < n; ++j)
+        {
+            std::complex<double> accum = 0.0;
+            for(int h = 0; h < k; ++h)
+            {
+                accum += a[i * k + h] * b[j * k + h];
+            }
+            d[i * n + j] = alpha * accum + beta * c[i * n + j];
+        }
+    }
+}
+
+// Packs complex values into the storage format.
+// Planar storage is ordered as all re values, then all im values.
+template <typename DataT, typename StorageT>
+__host__ std::vector<DataT> packComplex(std::vector<std::complex<double>> const& values)
+{
+    auto result = std::vector<DataT>(2u * values.size());
+    for(size_t i = 0; i < values.size(); ++i)
+    {
+        StorageT::re(result.data(), i, values.size()) = static_cast<DataT>(values[i].real());
+        StorageT::im(result.data(), i, values.size()) = static_cast<DataT>(values[i].imag());
+    }
+    return result;
+}
+
+template <typename DataT, typename StorageT>
+__host__ std::vector<std::complex<double>> unpackComplex(std::vector<DataT> const& values)
+{
+    auto size   = values.size() / 2u;
+    auto result = std::vector<std::complex<double>>(size);
+    for(size_t i = 0; i < size; ++i)
+    {
+        result[i] = {static_cast<double>(StorageT::re(values.data(), i, size)),
+                     static_cast<double>(StorageT::im(values.data(), i, size))};
+    }
+    return result;
+}
+
+template <typename DataT, typename StorageT>
+__host__ void cgemm_test(char const*                              typeName,
+                         char const*                              storageName,
+                         uint32_t                                 m,
+                         uint32_t                                 n,
+                         uint32_t                                 k,
+                         std::vector<std::complex<double>> const& matrixA,
+                         std::vector<std::complex<double>> const& matrixB,
+                         std::vector<std::complex<double>> const& matrixC,
+                         std::vector<std::complex<double>> const& matrixD_ref,
+                         std::complex<double>                     alpha,
+                         std::complex<double>                     beta)
+{
+    // A row major, B col major, C / D row major
+    int lda = k;
+    int ldb = k;
+    int ldc = n;
+    int ldd = ldc;
+
+    auto packedA = packComplex<DataT, StorageT>(matrixA);
+    auto packedB = packComplex<DataT, StorageT>(matrixB);
+    auto packedC = packComplex<DataT, StorageT>(matrixC);
+    auto packedD = std::vector<DataT>(packedC.size());
+
+    // Allocate and copy device memory
+    DataT* d_a;
+    DataT* d_b;
+    DataT* d_c;
+    DataT* d_d;
+
+    const size_t bytesA = packedA.size() * sizeof(DataT);
+    const size_t bytesB = packedB.size() * sizeof(DataT);
+    const size_t bytesC = packedC.size() * sizeof(DataT);
+    const size_t bytesD = packedD.size() * sizeof(DataT);
+
+    CHECK_HIP_ERROR(hipMalloc(&d_a, bytesA));
+    CHECK_HIP_ERROR(hipMalloc(&d_b, bytesB));
+    CHECK_HIP_ERROR(hipMalloc(&d_c, bytesC));
+    CHECK_HIP_ERROR(hipMalloc(&d_d, bytesD));
+
+    CHECK_HIP_ERROR(hipMemcpy(d_a, packedA.data(), bytesA, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_b, packedB.data(), bytesB, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_c, packedC.data(), bytesC, hipMemcpyHostToDevice));
+
+    auto blockDim = dim3(T_BLOCK_X, T_BLOCK_Y);
+    auto gridDim  = dim3(m / MACRO_M, n / MACRO_N);
+
+    auto cgemmKernel = [&](auto gauss) {
+        return [=]() {
+            hipExtLaunchKernelGGL((cgemm_rocwmma_d<DataT, StorageT, decltype(gauss)::value>),
+                                  gridDim,
+                                  blockDim,
+                                  0, // sharedMemBytes
+                                  0, // stream
+                                  nullptr, // Event start
+                                  nullptr, // event stop
+                                  0, // flags
+                                  m,
+                                  n,
+                                  k,
+                                  d_a,
+                                  d_b,
+                                  d_c,
+                                  d_d,
+                                  lda,
+                                  ldb,
+                                  ldc,
+                                  ldd,
+                                  static_cast<DataT>(alpha.real()),
+                                  static_cast<DataT>(alpha.imag()),
+                                  static_cast<DataT>(beta.real()),
+                                  static_cast<DataT>(beta.imag()));
+        };
+    };
+
+    // Runs are timed individually, with warm caches
+    BenchmarkHarness harness;
+
+    // Echo performance. Complex GEMM flops converge to 8*mnk.
+    auto echo = [&](const char* methodName, auto&& kernel) {
+        // Fill outputs with NaN to catch contamination
+        CHECK_HIP_ERROR(hipMemset(d_d, 0xFF, bytesD));
+
+        auto stats = harness.run(kernel);
+
+        std::cout << typeName << ", " << storageName << ", " << methodName << ", " << m << ", "
+                  << n << ", " << k << ", " << stats.mMedianMs << ", "
+                  << 4.0 * calculateTFlopsPerSec(m, n, k, stats.mMedianMs) << ", ";
+        BenchmarkHarness::printStats(std::cout, stats) << std::endl;
+
+#if !NDEBUG
+        // Bring kernel result back to host, compare re and im parts
+        CHECK_HIP_ERROR(hipMemcpy(packedD.data(), d_d, bytesD, hipMemcpyDeviceToHost));
+        auto result = packComplex<DataT, interleaved>(unpackComplex<DataT, StorageT>(packedD));
+        auto ref    = packComplex<DataT, interleaved>(matrixD_ref);
+
+        // 3M trades accuracy for speed, allow for its cancellation
+        auto res = compareEqual<DataT>(result.data(), ref.data(), result.size(), 100.0);
+
+        std::cout << (std::get<0>(res) ? "PASSED" : "FAILED")
+                  << ", Max relative error: " << std::get<1>(res) << std::endl;
+#endif // !NDEBUG
+    };
+
+    echo("4M", cgemmKernel(std::false_type{}));
+    echo("3M", cgemmKernel(std::true_type{}));
+
+    // Release device memory
+    CHECK_HIP_ERROR(hipFree(d_a));
+    CHECK_HIP_ERROR(hipFree(d_b));
+    CHECK_HIP_ERROR(hipFree(d_c));
+    CHECK_HIP_ERROR(hipFree(d_d));
+}
+
+template <typename DataT>
+__host__ void cgemm_test(char const* typeName, uint32_t m, uint32_t n, uint32_t k)
+{
+    // Bounds check
+    if(m % MACRO_M || n % MACRO_N || k % ROCWMMA_K)
+    {
+        std::cout << "Unsupported size!\n";
+        return;
+    }
+
+    // Random complex values, exactly representable in DataT
+    auto gen  = std::mt19937(5489u);
+    auto dist = std::uniform_real_distribution<double>(-1.0, 1.0);
+    auto randComplex = [&]() {
+        return std::complex<double>(static_cast<DataT>(dist(gen)), static_cast<DataT>(dist(gen)));
+    };
+
+    auto alpha = std::complex<double>(1.0, -0.5);
+    auto beta  = std::complex<double>(0.5, 0.25);
+
+    std::vector<std::complex<double>> matrixA(static_cast<size_t>(m) * k);
+    std::vector<std::complex<double>> matrixB(static_cast<size_t>(k) * n);
+    std::vector<std::complex<double>> matrixC(static_cast<size_t>(m) * n);
+    std::vector<std::complex<double>> matrixD_ref(static_cast<size_t>(m) * n);
+
+    for(auto* matrix : {&matrixA, &matrixB, &matrixC})
+    {
+        for(auto& value : *matrix)
+        {
+            value = randComplex();
+        }
+    }
+
+#if !NDEBUG
+    cgemm_cpu_h(m, n, k, matrixA, matrixB, matrixC, matrixD_ref, alpha, beta);
+#endif // !NDEBUG
+
+    cgemm_test<DataT, interleaved>(
+        typeName, "interleaved", m, n, k, matrixA, matrixB, matrixC, matrixD_ref, alpha, beta);
+    cgemm_test<DataT, planar>(
+        typeName, "planar", m, n, k, matrixA, matrixB, matrixC, matrixD_ref, alpha, beta);
+}
+
+int main()
+{
+    std::cout << "Type, Storage, Method, MatM, MatN, MatK, elapsedMs, TFlops/s, "
+              << BenchmarkHarness::statsHeader() << std::endl;
+
+    for(uint32_t size : {256u, 1024u, 2048u})
+    {
+        if(isF32Supported())
+        {
+            cgemm_test<float32_t>("cgemm", size, size, size);
+        }
+        if(isF64Supported())
+        {
+            cgemm_test<float64_t>("zgemm", size, size, size);
+        }
+    }
+
+    std::cout << "Finished!" << std::endl;
+    return 0;
+}
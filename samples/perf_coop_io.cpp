@@ -0,0 +1,187 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_fp16.h>
+#include <hip/hip_runtime.h>
+
+#include <rocwmma/rocwmma.hpp>
+#include <rocwmma/rocwmma_coop.hpp>
+
+#include "benchmark_harness.hpp"
+#include "common.hpp"
+
+using namespace rocwmma;
+
+/* Motivation
+*
+* Cooperative loads and stores split the IOs of a fragment amongst the waves of a
+* workgroup. The split is selected at compile time from the BlockDim, BlockK, data type
+* and WaveCount: the vector width (MaxVW) and the number of participating waves are
+* chosen to minimize the IOs per wave. Wave counts that are not powers of 2, such as
+* the 3, 6 or 12 waves of 192, 384 or 768 thread workgroups, split the IOs amongst the
+* largest wave count that evenly divides them.
+*
+* This sample sweeps WaveCount for each data type, BlockDim and BlockK. Each workgroup
+* cooperatively copies TILES_PER_WG tiles from global memory to global memory with
+* load_matrix_coop_sync and store_matrix_coop_sync, and reports the bandwidth with
+* the selected MaxVW and participating waves. Debug builds validate the copy.
+*/
+
+// Tiles per launch, and tiles copied by each workgroup
+constexpr uint32_t TILE_COUNT   = 16384u;
+constexpr uint32_t TILES_PER_WG = 8u;
+
+template <typename DataT, uint32_t BlockDim, uint32_t BlockK>
+using CoopFrag = fragment<matrix_a, BlockDim, 1, BlockK, DataT, row_major>;
+
+// Each workgroup of WaveCount waves copies TILES_PER_WG consecutive BlockDim x BlockK tiles
+// in row major format (ld = BlockK).
+template <typename DataT, uint32_t BlockDim, uint32_t BlockK, uint32_t WaveCount>
+ROCWMMA_KERNEL void __launch_bounds__(1024) coop_copy_d(DataT const* in, DataT* out)
+{
+    if constexpr(!ROCWMMA_ARCH_HOST)
+    {
+        constexpr uint32_t TileSize  = BlockDim * BlockK;
+        auto               waveIndex = threadIdx.x / Constants::AMDGCN_WAVE_SIZE;
+
+        auto frag = CoopFrag<DataT, BlockDim, BlockK>{};
+        for(uint32_t t = 0; t < TILES_PER_WG; t++)
+        {
+            auto tileOffset = (static_cast<size_t>(blockIdx.x) * TILES_PER_WG + t) * TileSize;
+            load_matrix_coop_sync<WaveCount>(frag, in + tileOffset, BlockK, waveIndex);
+            store_matrix_coop_sync<WaveCount>(out + tileOffset, frag, BlockK, waveIndex);
+        }
+    }
+}
+
+template <typename DataT, uint32_t BlockDim, uint32_t BlockK, uint32_t WaveCount>
+__host__ void coop_io_test(DataT const* d_input, DataT* d_output, std::vector<DataT> const& input)
+{
+    constexpr uint32_t TileSize = BlockDim * BlockK;
+    const size_t       size     = static_cast<size_t>(TILE_COUNT) * TileSize;
+    const size_t       bytes    = size * sizeof(DataT);
+
+    // Selected split of the cooperative IO
+    using IOConfig = GetCoopIOConfig_t<CoopFrag<DataT, BlockDim, BlockK>, WaveCount>;
+    constexpr uint32_t MaxVW = IOConfig::IOLayout::MaxVW;
+    constexpr uint32_t SplitWaves
+        = detail::coopSplitWaves(IOConfig::IOTraits::IOCount, WaveCount);
+
+    auto gridDim  = dim3(TILE_COUNT / TILES_PER_WG);
+    auto blockDim = dim3(WaveCount * getWarpSize());
+
+    auto kernel = [&]() {
+        hipExtLaunchKernelGGL(coop_copy_d<DataT, BlockDim, BlockK, WaveCount>,
+                              gridDim,
+                              blockDim,
+                              0, // sharedMemBytes
+                              0, // stream
+                              nullptr, // Event start
+                              nullptr, // event stop
+                              0, // flags
+                              d_input,
+                              d_output);
+    };
+
+    // Runs are timed individually, with warm and cold caches
+    BenchmarkHarness harness;
+
+    for(auto cacheState : {BenchmarkHarness::CacheState::Warm, BenchmarkHarness::CacheState::Cold})
+    {
+        auto stats = harness.run(kernel, cacheState);
+
+        // Read and write of every tile
+        auto gBytesPerSec = 2.0 * bytes / stats.mMedianMs * 1.0e-6;
+
+        std::cout << dataTypeToString<DataT>() << ", " << BlockDim << ", " << BlockK << ", "
+                  << WaveCount << ", " << MaxVW << ", " << SplitWaves << ", "
+                  << (cacheState == BenchmarkHarness::CacheState::Warm ? "warm" : "cold")
+                  << ", " << stats.mMedianMs << ", " << gBytesPerSec << ", ";
+        BenchmarkHarness::printStats(std::cout, stats) << std::endl;
+    }
+
+#if !NDEBUG
+    std::vector<DataT> output(size);
+    CHECK_HIP_ERROR(hipMemcpy(output.data(), d_output, bytes, hipMemcpyDeviceToHost));
+
+    auto res = compareEqual(output.data(), input.data(), size);
+    if(!std::get<0>(res))
+    {
+        std::cout << "Validation FAILED, max relative error: " << std::get<1>(res) << std::endl;
+    }
+#endif // !NDEBUG
+
+    // Clear the output for the next wave count
+    CHECK_HIP_ERROR(hipMemset(d_output, 0, bytes));
+}
+
+template <typename DataT, uint32_t BlockDim, uint32_t BlockK, uint32_t... WaveCounts>
+__host__ void coop_io_test_wave_counts(std::integer_sequence<uint32_t, WaveCounts...>)
+{
+    constexpr uint32_t TileSize = BlockDim * BlockK;
+    const size_t       size     = static_cast<size_t>(TILE_COUNT) * TileSize;
+    const size_t       bytes    = size * sizeof(DataT);
+
+    std::vector<DataT> input(size);
+    fillRand(input.data(), TILE_COUNT * BlockDim, BlockK);
+
+    DataT *d_input, *d_output;
+    CHECK_HIP_ERROR(hipMalloc(&d_input, bytes));
+    CHECK_HIP_ERROR(hipMalloc(&d_output, bytes));
+    CHECK_HIP_ERROR(hipMemcpy(d_input, input.data(), bytes, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemset(d_output, 0, bytes));
+
+    (coop_io_test<DataT, BlockDim, BlockK, WaveCounts>(d_input, d_output, input), ...);
+
+    CHECK_HIP_ERROR(hipFree(d_input));
+    CHECK_HIP_ERROR(hipFree(d_output));
+}
+
+template <typename DataT>
+__host__ void coop_io_test_block_dims()
+{
+    // Powers of 2, and the 3, 6 and 12 waves of 192, 384 and 768 thread workgroups
+    using WaveCounts = std::integer_sequence<uint32_t, 1u, 2u, 3u, 4u, 6u, 8u, 12u>;
+
+    coop_io_test_wave_counts<DataT, 64u, 16u>(WaveCounts{});
+    coop_io_test_wave_counts<DataT, 64u, 32u>(WaveCounts{});
+    coop_io_test_wave_counts<DataT, 128u, 16u>(WaveCounts{});
+    coop_io_test_wave_counts<DataT, 128u, 32u>(WaveCounts{});
+}
+
+int main()
+{
+    std::cout << "DataT, BlockDim, BlockK, WaveCount, MaxVW, SplitWaves, Cache, elapsedMs, "
+              << "Bandwidth(GB/s), " << BenchmarkHarness::statsHeader() << std::endl;
+
+    coop_io_test_block_dims<float16_t>();
+    coop_io_test_block_dims<float32_t>();
+    return 0;
+}
@@ -0,0 +1,1401 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <cmath>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_fp16.h>
+#include <hip/hip_runtime.h>
+
+#include <rocwmma/rocwmma.hpp>
+#include <rocwmma/rocwmma_epilogue.hpp>
+#include <rocwmma/rocwmma_pipeline.hpp>
+#include <rocwmma/rocwmma_tile.hpp>
+
+#include "benchmark_harness.hpp"
+#include "common.hpp"
+
+/* Motivation
+*
+* The GEMM, attention and feed-forward samples each time one kernel in isolation, with
+* its inputs either hot in L2 (warm) or flushed (cold). In a model, the kernels of a layer
+* run back to back: each one reads what the previous one just wrote, partially from L2,
+* and launch gaps between short kernels add up. This sample times a full pre-norm LLaMA
+* style decoder layer for a prefill batch of T = batch x seqLen tokens:
+*
+*   Xn = RMSNorm(X)                               (T x D)
+*   QKV = Xn x Wqkv                               (T x (H + 2 Hkv) HEAD_DIM)
+*   O   = causal softmax(Q x K^T / sqrt(HEAD_DIM)) x V, per head, K / V heads
+*         shared by H / Hkv query heads (grouped query attention)
+*   H1  = O x Wo + X                              (T x D)
+*   Hn  = RMSNorm(H1)
+*   G   = silu(Hn x W1) * (Hn x W3)               (T x F)
+*   Y   = G x W2 + H1                             (T x D)
+*
+* with D = H x HEAD_DIM. Activations are row major [token][feature], and weights row
+* major [in][out].
+*
+* Two compositions of the layer are timed:
+*
+*   Unfused: plain rocWMMA GEMMs with separate elementwise kernels, and attention as a
+*            score GEMM, a row softmax and a probability x V GEMM through a T x T score
+*            matrix per head. 13 kernels.
+*
+*   Fused:   the fused variants of the other samples. The residual adds are GEMM
+*            epilogues (epilogue::LinearCombination), the gate and up projections are one
+*            dual GEMM over the packed W13 with the epilogue::GatedLinearUnit stage as in
+*            perf_hgemm_swiglu, and attention is the online softmax flash attention of
+*            perf_flash_attention. 7 kernels.
+*
+* For each composition, every kernel is first timed in isolation with warm caches, then
+* the whole layer is timed back to back with warm and cold caches. The difference between
+* the layer time and the sum of its kernels is the inter-kernel effect: negative when a
+* kernel benefits from the outputs of the previous one still being in L2, positive with
+* launch gaps and cache thrashing. Results report the layer latency and tokens/s.
+*
+* The decode phase (one token per sequence) is bound by the weight and KV cache reads of
+* GEMVs and paged attention instead, see perf_hgemv_decode and perf_paged_attention.
+*/
+
+using namespace rocwmma;
+
+///
+/// Types and Data Layouts
+///
+
+using InputT   = float16_t;
+using OutputT  = float16_t;
+using ComputeT = float32_t;
+
+using DataLayoutA = row_major;
+using DataLayoutB = row_major;
+using DataLayoutC = row_major;
+
+///
+/// Parameter configuration
+///
+
+// Validated defaults of rocwmma::warp_tile_config for InputT and the target being compiled.
+// The host selects the same ones at runtime with get_warp_tile_params.
+using WarpTileConfig = warp_tile_config_t<InputT>;
+
+enum kernelParams : uint32_t
+{
+    ROCWMMA_M = WarpTileConfig::block_m,
+    ROCWMMA_N = WarpTileConfig::block_n,
+    ROCWMMA_K = WarpTileConfig::block_k,
+    BLOCKS_X  = WarpTileConfig::blocks_x,
+    BLOCKS_Y  = WarpTileConfig::blocks_y,
+    TBLOCK_X  = WarpTileConfig::tblock_x,
+    TBLOCK_Y  = WarpTileConfig::tblock_y,
+    WARP_SIZE = WarpTileConfig::wave_size
+};
+
+using DataLayoutLds = WarpTileConfig::lds_layout;
+
+// Warp tile: computed by each warp
+constexpr uint32_t WARP_TILE_X = BLOCKS_X * ROCWMMA_M;
+constexpr uint32_t WARP_TILE_Y = BLOCKS_Y * ROCWMMA_N;
+
+// Macro Tile: computed by each thread block (workgroup)
+constexpr uint32_t WARPS_X      = TBLOCK_X / WARP_SIZE;
+constexpr uint32_t WARPS_Y      = TBLOCK_Y;
+constexpr uint32_t MACRO_TILE_X = WARPS_X * WARP_TILE_X;
+constexpr uint32_t MACRO_TILE_Y = WARPS_Y * WARP_TILE_Y;
+
+// Attention geometry, with 16 x 16 x 16 blocks on all targets
+constexpr uint32_t HEAD_DIM    = 128u;
+constexpr uint32_t BLOCK_KV    = 32u;
+constexpr uint32_t ATTN_BLOCK  = 16u;
+constexpr uint32_t ATTN_WAVES  = 4u;
+constexpr uint32_t ATTN_TBLOCK = ATTN_WAVES * WARP_SIZE;
+constexpr uint32_t LDS_PADDING = 8u;
+
+// Elementwise and row kernels
+constexpr uint32_t ELEMENTWISE_TBLOCK = 256u;
+
+// RMSNorm epsilon
+constexpr ComputeT RMS_EPS = 1.0e-5f;
+
+// Mfma frags
+using MfmaFragA   = fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, InputT, DataLayoutA>;
+using MfmaFragB   = fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, InputT, DataLayoutB>;
+using MfmaFragD   = fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, OutputT, DataLayoutC>;
+using MfmaFragAcc = fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, ComputeT>;
+
+// Warp tile of mfma frags
+using MfmaTileA   = fragment_array<MfmaFragA, BLOCKS_X, 1u>;
+using MfmaTileB   = fragment_array<MfmaFragB, 1u, BLOCKS_Y>;
+using MfmaTileD   = fragment_array<MfmaFragD, BLOCKS_X, BLOCKS_Y>;
+using MfmaTileAcc = fragment_array<MfmaFragAcc, BLOCKS_X, BLOCKS_Y>;
+
+// Global read (macro tile). The B macro tile holds BSets sets of MACRO_TILE_Y columns:
+// 1 for a plain GEMM, 2 for the gate and up columns of W13.
+using GRBuffA = fragment<matrix_a, MACRO_TILE_X, ROCWMMA_N, ROCWMMA_K, InputT, DataLayoutA>;
+
+template <uint32_t BSets>
+using GRBuffB = fragment<matrix_b, ROCWMMA_M, BSets * MACRO_TILE_Y, ROCWMMA_K, InputT, DataLayoutB>;
+
+// Double buffered LDS staging of the global buffers (macro tile)
+template <uint32_t BSets>
+using LdsPipeline
+    = lds_pipeline<2u, WARPS_X * WARPS_Y, GRBuffA, GRBuffB<BSets>, DataLayoutLds, lds_access>;
+
+// Attention frags
+using FragQ    = fragment<matrix_a, ATTN_BLOCK, ATTN_BLOCK, ATTN_BLOCK, InputT, row_major>;
+using FragP    = FragQ;
+using FragK    = fragment<matrix_b, ATTN_BLOCK, ATTN_BLOCK, ATTN_BLOCK, InputT, col_major>;
+using FragV    = fragment<matrix_b, ATTN_BLOCK, ATTN_BLOCK, ATTN_BLOCK, InputT, row_major>;
+using FragSAcc = fragment<accumulator, ATTN_BLOCK, ATTN_BLOCK, ATTN_BLOCK, ComputeT>;
+using FragSOut = fragment<accumulator, ATTN_BLOCK, ATTN_BLOCK, ATTN_BLOCK, OutputT>;
+
+constexpr uint32_t Q_BLOCKS = HEAD_DIM / ATTN_BLOCK; // Q fragments along HEAD_DIM
+constexpr uint32_t S_BLOCKS = BLOCK_KV / ATTN_BLOCK; // Score fragments along keys
+constexpr uint32_t O_BLOCKS = HEAD_DIM / ATTN_BLOCK; // Output fragments along HEAD_DIM
+
+// Attention Lds: double buffered K and V blocks, and one P block per wave
+constexpr uint32_t LDS_LD      = HEAD_DIM + LDS_PADDING;
+constexpr uint32_t LDS_KV_SIZE = BLOCK_KV * LDS_LD;
+constexpr uint32_t LDS_P_SIZE  = ATTN_BLOCK * BLOCK_KV;
+constexpr uint32_t ATTN_LDS_USAGE
+    = sizeof(InputT) * (4u * LDS_KV_SIZE + ATTN_WAVES * LDS_P_SIZE);
+
+// K / V global reads in 16 byte chunks
+constexpr uint32_t CHUNK_SIZE        = sizeof(uint4) / sizeof(InputT);
+constexpr uint32_t CHUNKS_PER_ROW    = HEAD_DIM / CHUNK_SIZE;
+constexpr uint32_t CHUNKS_PER_THREAD = BLOCK_KV * CHUNKS_PER_ROW / ATTN_TBLOCK;
+
+static_assert(BLOCK_KV * CHUNKS_PER_ROW % ATTN_TBLOCK == 0,
+              "K / V blocks must be evenly divided among threads");
+static_assert(LDS_LD % CHUNK_SIZE == 0, "Lds rows must be aligned to chunk size");
+
+///
+/// GEMM kernels
+///
+
+// Computes one macro tile of D = A x B (BSets = 1), or of D = silu(A x B1) * (A x B3) over the
+// packed W13 (BSets = 2), where tileCoord is the 2D index of the macro tile in D.
+// With Residual, D = A x B + R, where R has the layout and leading dimension of D.
+// Matrix sizes must be multiples of the macro tile size.
+template <uint32_t BSets, bool Residual>
+ROCWMMA_DEVICE static inline void gemmMacroTile(Coord2d const& tileCoord,
+                                                uint32_t       k,
+                                                InputT const*  a,
+                                                InputT const*  b,
+                                                OutputT const* r,
+                                                OutputT*       d,
+                                                uint32_t       lda,
+                                                uint32_t       ldb,
+                                                uint32_t       ldd,
+                                                InputT*        ldsPtr)
+{
+    static_assert(BSets == 1u || BSets == 2u, "Plain or gated GEMM only");
+    static_assert(!(Residual && BSets == 2u), "Residual of the gated GEMM is not supported");
+
+    using Pipeline = LdsPipeline<BSets>;
+
+    // Tile Sizes
+    constexpr auto warpTileSize  = make_coord2d(WARP_TILE_X, WARP_TILE_Y);
+    constexpr auto macroTileSize = make_coord2d(MACRO_TILE_X, MACRO_TILE_Y);
+
+    // Local warp coordinate relative to current threadblock (wg).
+    auto localWarpCoord  = make_coord2d(threadIdx.x / WARP_SIZE, threadIdx.y);
+    auto localWarpOffset = localWarpCoord * warpTileSize;
+
+    // Global matrix coordinates for D
+    auto macroTileCoord = tileCoord * macroTileSize;
+    auto warpTileCoord  = macroTileCoord + localWarpOffset;
+
+    ///
+    /// 1D global read coordinate setup
+    /// The B macro tile of tile column j starts at column BSets * j * MACRO_TILE_Y
+    ///
+    using GRBuffAMap1d = GetDataLayout_t<GRBuffA>;
+    using GRBuffBMap1d = GetDataLayout_t<GRBuffB<BSets>>;
+
+    auto globalReadOffsetA
+        = GRBuffAMap1d::fromMatrixCoord(make_coord2d(get<0>(macroTileCoord), 0u), lda);
+    auto globalReadOffsetB
+        = GRBuffBMap1d::fromMatrixCoord(make_coord2d(0u, BSets * get<1>(macroTileCoord)), ldb);
+
+    auto kStepOffsetA = GRBuffAMap1d::fromMatrixCoord(make_coord2d(0u, ROCWMMA_K), lda);
+    auto kStepOffsetB = GRBuffBMap1d::fromMatrixCoord(make_coord2d(ROCWMMA_K, 0u), ldb);
+
+    // Warps cooperate in row major order
+    const auto warpIndex = get<0>(localWarpCoord) * WARPS_Y + get<1>(localWarpCoord);
+
+    Pipeline pipeline(ldsPtr, warpIndex);
+
+    ///
+    /// Perform initial global pre-fetch and write to local
+    ///
+    pipeline.global_read(a + globalReadOffsetA, lda, b + globalReadOffsetB, ldb);
+    globalReadOffsetA += kStepOffsetA;
+    globalReadOffsetB += kStepOffsetB;
+    pipeline.local_write();
+
+    ///
+    /// Initialize accumulation frags: gate (or plain GEMM) and up
+    ///
+    MfmaTileAcc fragsAcc[BSets];
+#pragma unroll
+    for(uint32_t s = 0u; s < BSets; s++)
+    {
+        fill_fragment(fragsAcc[s], 0.0f);
+    }
+
+    synchronize_workgroup();
+
+    // Local reads A once per K step, and multiplies it into each set of B
+    auto localReadMma = [&]() {
+        MfmaTileA fragsA;
+        pipeline.local_read_a(fragsA, get<0>(localWarpOffset));
+
+#pragma unroll
+        for(uint32_t s = 0u; s < BSets; s++)
+        {
+            MfmaTileB fragsB;
+            pipeline.local_read_b(fragsB, s * MACRO_TILE_Y + get<1>(localWarpOffset));
+            mma_sync(fragsAcc[s], fragsA, fragsB, fragsAcc[s]);
+        }
+    };
+
+    auto kSteps = k / ROCWMMA_K;
+    for(uint32_t step = 1u; step < kSteps; step++)
+    {
+        // Prefetch next round of global frags, then accumulate the read stage
+        pipeline.global_read(a + globalReadOffsetA, lda, b + globalReadOffsetB, ldb);
+        globalReadOffsetA += kStepOffsetA;
+        globalReadOffsetB += kStepOffsetB;
+
+        localReadMma();
+
+        // Write prefetch to the write stage
+        pipeline.local_write();
+
+        // Make sure that all waves have finished reading / writing to lds for this step.
+        synchronize_workgroup();
+
+        pipeline.advance();
+    }
+
+    // Tail A * B
+    localReadMma();
+
+    ///
+    /// D = acc, D = acc + R, or D = silu(gate) * up
+    ///
+    using MfmaFragDMap1d = GetDataLayout_t<MfmaFragD>;
+    auto warpTileOffsetD = MfmaFragDMap1d::fromMatrixCoord(warpTileCoord, ldd);
+
+    MfmaTileD fragsR;
+    if constexpr(Residual)
+    {
+        load_matrix_sync(fragsR, r + warpTileOffsetD, ldd);
+    }
+
+    MfmaTileD fragsD;
+#pragma unroll
+    for(uint32_t i = 0u; i < BLOCKS_X; i++)
+    {
+#pragma unroll
+        for(uint32_t j = 0u; j < BLOCKS_Y; j++)
+        {
+            if constexpr(BSets == 2u)
+            {
+                apply_epilogue(fragsD(i, j),
+                               fragsAcc[0](i, j),
+                               epilogue::GatedLinearUnit<epilogue::Silu, MfmaFragAcc>(
+                                   fragsAcc[1](i, j)));
+            }
+            else if constexpr(Residual)
+            {
+                apply_epilogue(fragsD(i, j),
+                               fragsAcc[0](i, j),
+                               epilogue::LinearCombination(1.0f, 1.0f, fragsR(i, j)));
+            }
+            else
+            {
+                apply_epilogue(fragsD(i, j), fragsAcc[0](i, j));
+            }
+        }
+    }
+
+    store_matrix_sync(d + warpTileOffsetD, fragsD, ldd);
+}
+
+template <uint32_t BSets, bool Residual>
+ROCWMMA_KERNEL void __launch_bounds__(256) gemm_rocwmma_d(uint32_t       k,
+                                                          InputT const*  a,
+                                                          InputT const*  b,
+                                                          OutputT const* r,
+                                                          OutputT*       d,
+                                                          uint32_t       lda,
+                                                          uint32_t       ldb,
+                                                          uint32_t       ldd)
+{
+    if constexpr(!ROCWMMA_ARCH_HOST)
+    {
+        HIP_DYNAMIC_SHARED(void*, localMemPtr);
+        gemmMacroTile<BSets, Residual>(make_coord2d(blockIdx.x, blockIdx.y),
+                                       k,
+                                       a,
+                                       b,
+                                       r,
+                                       d,
+                                       lda,
+                                       ldb,
+                                       ldd,
+                                       reinterpret_cast<InputT*>(localMemPtr));
+    }
+}
+
+///
+/// Flash attention kernel
+///
+
+// Global read of one K and V block of BLOCK_KV rows into registers.
+// Rows of K and V are ld elements apart, within the packed QKV rows.
+ROCWMMA_DEVICE static inline void globalReadKV(uint4 (&buffK)[CHUNKS_PER_THREAD],
+                                               uint4 (&buffV)[CHUNKS_PER_THREAD],
+                                               InputT const* k,
+                                               InputT const* v,
+                                               uint32_t      ld)
+{
+#pragma unroll
+    for(uint32_t i = 0; i < CHUNKS_PER_THREAD; i++)
+    {
+        auto chunk  = threadIdx.x + i * ATTN_TBLOCK;
+        auto offset = (chunk / CHUNKS_PER_ROW) * ld + (chunk % CHUNKS_PER_ROW) * CHUNK_SIZE;
+        buffK[i]    = *reinterpret_cast<uint4 const*>(k + offset);
+        buffV[i]    = *reinterpret_cast<uint4 const*>(v + offset);
+    }
+}
+
+// Local write of one K and V block into padded Lds rows.
+ROCWMMA_DEVICE static inline void localWriteKV(InputT*     ldsK,
+                                               InputT*     ldsV,
+                                               uint4 const (&buffK)[CHUNKS_PER_THREAD],
+                                               uint4 const (&buffV)[CHUNKS_PER_THREAD])
+{
+#pragma unroll
+    for(uint32_t i = 0; i < CHUNKS_PER_THREAD; i++)
+    {
+        auto chunk  = threadIdx.x + i * ATTN_TBLOCK;
+        auto offset = (chunk / CHUNKS_PER_ROW) * LDS_LD + (chunk % CHUNKS_PER_ROW) * CHUNK_SIZE;
+        *reinterpret_cast<uint4*>(ldsK + offset) = buffK[i];
+        *reinterpret_cast<uint4*>(ldsV + offset) = buffV[i];
+    }
+}
+
+// Online softmax update for one block of scores, as in perf_flash_attention.
+// On return, fragsS holds the un-normalized probabilities P = exp2(S * scaleLog2 - m).
+// The running max, running sum and partial output are rescaled to the new max.
+ROCWMMA_DEVICE static inline void onlineSoftmax(FragSAcc (&fragsS)[S_BLOCKS],
+                                                FragSAcc& fragMax,
+                                                FragSAcc& fragSum,
+                                                FragSAcc (&fragsO)[O_BLOCKS],
+                                                ComputeT  scaleLog2)
+{
+    // Row max of the score block
+    FragSAcc fragBlockMax;
+#pragma unroll
+    for(uint32_t i = 0; i < FragSAcc::num_elements; i++)
+    {
+        auto value = fragsS[0].x[i];
+#pragma unroll
+        for(uint32_t j = 1; j < S_BLOCKS; j++)
+        {
+            value = fmaxf(value, fragsS[j].x[i]);
+        }
+        fragBlockMax.x[i] = value * scaleLog2;
+    }
+    fragBlockMax = reduce_rows<reduce::Max>(fragBlockMax);
+
+    // Causal rows always see their own key first, so the new max is finite
+    FragSAcc fragCorrection;
+#pragma unroll
+    for(uint32_t i = 0; i < FragSAcc::num_elements; i++)
+    {
+        auto newMax         = fmaxf(fragMax.x[i], fragBlockMax.x[i]);
+        fragCorrection.x[i] = exp2f(fragMax.x[i] - newMax);
+        fragMax.x[i]        = newMax;
+    }
+
+    // Probabilities and their row sum
+    FragSAcc fragBlockSum;
+    fill_fragment(fragBlockSum, static_cast<ComputeT>(0));
+#pragma unroll
+    for(uint32_t j = 0; j < S_BLOCKS; j++)
+    {
+#pragma unroll
+        for(uint32_t i = 0; i < FragSAcc::num_elements; i++)
+        {
+            auto p         = exp2f(fragsS[j].x[i] * scaleLog2 - fragMax.x[i]);
+            fragsS[j].x[i] = p;
+            fragBlockSum.x[i] += p;
+        }
+    }
+    fragBlockSum = reduce_rows<reduce::Sum>(fragBlockSum);
+
+    // Rescale previous results
+#pragma unroll
+    for(uint32_t i = 0; i < FragSAcc::num_elements; i++)
+    {
+        fragSum.x[i] = fragSum.x[i] * fragCorrection.x[i] + fragBlockSum.x[i];
+    }
+
+#pragma unroll
+    for(uint32_t j = 0; j < O_BLOCKS; j++)
+    {
+#pragma unroll
+        for(uint32_t i = 0; i < FragSAcc::num_elements; i++)
+        {
+            fragsO[j].x[i] *= fragCorrection.x[i];
+        }
+    }
+}
+
+/// Causal attention of ATTN_WAVES * ATTN_BLOCK query rows of one head of one sequence.
+/// Q, K and V are read in place from the packed QKV rows [token][(H + 2 Hkv) x HEAD_DIM],
+/// and O is written to [token][H x HEAD_DIM].
+/// Grid: (seqLen / (ATTN_WAVES * ATTN_BLOCK), H, batch), Block: (ATTN_TBLOCK)
+ROCWMMA_KERNEL void __launch_bounds__(256) flash_attention_d(uint32_t      seqLen,
+                                                             uint32_t      heads,
+                                                             uint32_t      kvHeads,
+                                                             InputT const* qkv,
+                                                             OutputT*      o,
+                                                             ComputeT      scaleLog2)
+{
+    if constexpr(!ROCWMMA_ARCH_HOST)
+    {
+        auto ldqkv = (heads + 2u * kvHeads) * HEAD_DIM;
+        auto ldo   = heads * HEAD_DIM;
+        auto head  = blockIdx.y;
+        auto kvHd  = head / (heads / kvHeads);
+
+        // Causal tiles are dispatched longest first
+        auto qTile     = gridDim.x - 1u - blockIdx.x;
+        auto qRowBegin = qTile * ATTN_WAVES * ATTN_BLOCK;
+        auto waveIndex = threadIdx.x / WARP_SIZE;
+        auto qRow      = qRowBegin + waveIndex * ATTN_BLOCK;
+        auto qRowLast  = qRow + ATTN_BLOCK - 1u;
+
+        auto seqOffset = static_cast<uint64_t>(blockIdx.z) * seqLen;
+        auto q         = qkv + seqOffset * ldqkv + head * HEAD_DIM;
+        auto k         = qkv + seqOffset * ldqkv + (heads + kvHd) * HEAD_DIM;
+        auto v         = qkv + seqOffset * ldqkv + (heads + kvHeads + kvHd) * HEAD_DIM;
+        o += seqOffset * ldo + head * HEAD_DIM;
+
+        // Lds buffers
+        HIP_DYNAMIC_SHARED(void*, localMemPtr);
+        auto* ldsK = reinterpret_cast<InputT*>(localMemPtr);
+        auto* ldsV = ldsK + 2u * LDS_KV_SIZE;
+        auto* ldsP = ldsV + 2u * LDS_KV_SIZE + waveIndex * LDS_P_SIZE;
+
+        // Q block stays resident for the whole sweep over the keys
+        FragQ fragsQ[Q_BLOCKS];
+#pragma unroll
+        for(uint32_t i = 0; i < Q_BLOCKS; i++)
+        {
+            load_matrix_sync(fragsQ[i], q + qRow * ldqkv + i * ATTN_BLOCK, ldqkv);
+        }
+
+        FragSAcc fragsO[O_BLOCKS];
+#pragma unroll
+        for(uint32_t i = 0; i < O_BLOCKS; i++)
+        {
+            fill_fragment(fragsO[i], static_cast<ComputeT>(0));
+        }
+
+        FragSAcc fragMax, fragSum;
+        fill_fragment(fragMax, -std::numeric_limits<ComputeT>::infinity());
+        fill_fragment(fragSum, static_cast<ComputeT>(0));
+
+        // Key blocks up to the last row of the workgroup
+        auto kvEnd = ceilDiv(qRowBegin + ATTN_WAVES * ATTN_BLOCK, BLOCK_KV);
+
+        // Prefetch the first K / V block
+        uint4 buffK[CHUNKS_PER_THREAD];
+        uint4 buffV[CHUNKS_PER_THREAD];
+        globalReadKV(buffK, buffV, k, v, ldqkv);
+        localWriteKV(ldsK, ldsV, buffK, buffV);
+
+        synchronize_workgroup();
+
+        for(uint32_t kvBlock = 0u; kvBlock < kvEnd; kvBlock++)
+        {
+            auto  current = kvBlock % 2u;
+            auto* ldsKCur = ldsK + current * LDS_KV_SIZE;
+            auto* ldsVCur = ldsV + current * LDS_KV_SIZE;
+            bool  hasNext = kvBlock + 1u < kvEnd;
+
+            // Prefetch next K / V block into registers
+            if(hasNext)
+            {
+                auto nextOffset = (kvBlock + 1u) * BLOCK_KV * ldqkv;
+                globalReadKV(buffK, buffV, k + nextOffset, v + nextOffset, ldqkv);
+            }
+
+            // Waves share the K / V blocks, so fully masked waves only skip the products
+            auto kvCol      = kvBlock * BLOCK_KV;
+            auto kvColLast  = kvCol + BLOCK_KV - 1u;
+            bool waveMasked = kvCol > qRowLast;
+            bool boundary   = kvColLast > qRow;
+
+            if(!waveMasked)
+            {
+                // S = Q x K^T
+                FragSAcc fragsS[S_BLOCKS];
+#pragma unroll
+                for(uint32_t j = 0; j < S_BLOCKS; j++)
+                {
+                    fill_fragment(fragsS[j], static_cast<ComputeT>(0));
+                }
+
+#pragma unroll
+                for(uint32_t i = 0; i < Q_BLOCKS; i++)
+                {
+#pragma unroll
+                    for(uint32_t j = 0; j < S_BLOCKS; j++)
+                    {
+                        FragK fragK;
+                        load_matrix_sync(
+                            fragK, ldsKCur + j * ATTN_BLOCK * LDS_LD + i * ATTN_BLOCK, LDS_LD);
+                        mma_sync(fragsS[j], fragsQ[i], fragK, fragsS[j]);
+                    }
+                }
+
+                // Element masks only on blocks crossing the diagonal
+                if(boundary)
+                {
+#pragma unroll
+                    for(uint32_t j = 0; j < S_BLOCKS; j++)
+                    {
+                        auto blockCoord = make_coord2d(qRow, kvCol + j * ATTN_BLOCK);
+                        apply_epilogue(fragsS[j],
+                                       fragsS[j],
+                                       epilogue::AttentionMask<FragSAcc>(blockCoord, true));
+                    }
+                }
+
+                onlineSoftmax(fragsS, fragMax, fragSum, fragsO, scaleLog2);
+
+                // Stage P in the private Lds region of this wave
+#pragma unroll
+                for(uint32_t j = 0; j < S_BLOCKS; j++)
+                {
+                    FragSOut fragP;
+                    apply_epilogue(fragP, fragsS[j]);
+                    store_matrix_sync(ldsP + j * ATTN_BLOCK, fragP, BLOCK_KV, mem_row_major);
+                }
+            }
+
+            synchronize_workgroup();
+
+            if(!waveMasked)
+            {
+                // O += P x V
+#pragma unroll
+                for(uint32_t i = 0; i < S_BLOCKS; i++)
+                {
+                    FragP fragP;
+                    load_matrix_sync(fragP, ldsP + i * ATTN_BLOCK, BLOCK_KV);
+#pragma unroll
+                    for(uint32_t j = 0; j < O_BLOCKS; j++)
+                    {
+                        FragV fragV;
+                        load_matrix_sync(
+                            fragV, ldsVCur + i * ATTN_BLOCK * LDS_LD + j * ATTN_BLOCK, LDS_LD);
+                        mma_sync(fragsO[j], fragP, fragV, fragsO[j]);
+                    }
+                }
+            }
+
+            // The other buffer was last read in the previous iteration
+            if(hasNext)
+            {
+                localWriteKV(ldsK + (1u - current) * LDS_KV_SIZE,
+                             ldsV + (1u - current) * LDS_KV_SIZE,
+                             buffK,
+                             buffV);
+            }
+
+            synchronize_workgroup();
+        }
+
+        // O = O / l
+        FragSAcc fragInvSum;
+#pragma unroll
+        for(uint32_t i = 0; i < FragSAcc::num_elements; i++)
+        {
+            fragInvSum.x[i] = static_cast<ComputeT>(1) / fragSum.x[i];
+        }
+
+#pragma unroll
+        for(uint32_t j = 0; j < O_BLOCKS; j++)
+        {
+            FragSOut fragOut;
+            apply_epilogue(fragOut, fragsO[j], epilogue::Scale(fragInvSum));
+            store_matrix_sync(o + qRow * ldo + j * ATTN_BLOCK, fragOut, ldo, mem_row_major);
+        }
+    }
+}
+
+///
+/// Unfused attention kernels
+///
+
+// Batched D = alpha * A x B over the (sequence, head) pairs of the layer, one wave per
+// ATTN_BLOCK x ATTN_BLOCK output block. blockIdx.z indexes sequence * heads + head, and
+// B is shared by groups of B_GROUP heads, as K and V in grouped query attention.
+// Each operand is offset by seqStride per sequence and headStride per head.
+// A and D are row major.
+template <typename LayoutB>
+ROCWMMA_KERNEL void attention_gemm_d(uint32_t      m,
+                                     uint32_t      n,
+                                     uint32_t      k,
+                                     uint32_t      heads,
+                                     uint32_t      groupB,
+                                     InputT const* a,
+                                     InputT const* b,
+                                     OutputT*      d,
+                                     uint32_t      lda,
+                                     uint32_t      ldb,
+                                     uint32_t      ldd,
+                                     uint64_t      seqStrideA,
+                                     uint64_t      headStrideA,
+                                     uint64_t      seqStrideB,
+                                     uint64_t      headStrideB,
+                                     uint64_t      seqStrideD,
+                                     uint64_t      headStrideD,
+                                     ComputeT      alpha)
+{
+    if constexpr(!ROCWMMA_ARCH_HOST)
+    {
+        auto cRow = (blockIdx.x * blockDim.x + threadIdx.x) / WARP_SIZE * ATTN_BLOCK;
+        auto cCol = (blockIdx.y * blockDim.y + threadIdx.y) * ATTN_BLOCK;
+
+        if(cRow < m && cCol < n)
+        {
+            auto seq  = blockIdx.z / heads;
+            auto head = blockIdx.z % heads;
+
+            a += seq * seqStrideA + head * headStrideA;
+            b += seq * seqStrideB + (head / groupB) * headStrideB;
+            d += seq * seqStrideD + head * headStrideD;
+
+            FragSAcc fragAcc;
+            fill_fragment(fragAcc, static_cast<ComputeT>(0));
+
+            using FragB = fragment<matrix_b, ATTN_BLOCK, ATTN_BLOCK, ATTN_BLOCK, InputT, LayoutB>;
+
+            for(uint32_t i = 0; i < k; i += ATTN_BLOCK)
+            {
+                auto offsetB = std::is_same_v<LayoutB, row_major> ? (i * ldb + cCol)
+                                                                  : (cCol * ldb + i);
+                FragQ fragA;
+                FragB fragB;
+                load_matrix_sync(fragA, a + (cRow * lda + i), lda);
+                load_matrix_sync(fragB, b + offsetB, ldb);
+                mma_sync(fragAcc, fragA, fragB, fragAcc);
+            }
+
+            FragSOut fragD;
+            apply_epilogue(fragD, fragAcc, epilogue::TensorScale(alpha));
+            store_matrix_sync(d + (cRow * ldd + cCol), fragD, ldd, mem_row_major);
+        }
+    }
+}
+
+// In-place causal row softmax of the seqLen x seqLen score matrices, one wave per row.
+// Scores past the diagonal are set to a probability of 0.
+ROCWMMA_KERNEL void causal_softmax_rows_d(uint32_t seqLen, OutputT* s)
+{
+    if constexpr(!ROCWMMA_ARCH_HOST)
+    {
+        auto row  = blockIdx.x * (blockDim.x / WARP_SIZE) + threadIdx.x / WARP_SIZE;
+        auto lane = threadIdx.x % WARP_SIZE;
+        auto n    = row % seqLen + 1u;
+
+        s += static_cast<uint64_t>(row) * seqLen;
+
+        auto rowMax = -std::numeric_limits<ComputeT>::infinity();
+        for(uint32_t i = lane; i < n; i += WARP_SIZE)
+        {
+            rowMax = fmaxf(rowMax, static_cast<ComputeT>(s[i]));
+        }
+        for(uint32_t offset = WARP_SIZE / 2u; offset > 0u; offset /= 2u)
+        {
+            rowMax = fmaxf(rowMax, __shfl_xor(rowMax, offset));
+        }
+
+        auto rowSum = static_cast<ComputeT>(0);
+        for(uint32_t i = lane; i < n; i += WARP_SIZE)
+        {
+            rowSum += expf(static_cast<ComputeT>(s[i]) - rowMax);
+        }
+        for(uint32_t offset = WARP_SIZE / 2u; offset > 0u; offset /= 2u)
+        {
+            rowSum += __shfl_xor(rowSum, offset);
+        }
+
+        for(uint32_t i = lane; i < seqLen; i += WARP_SIZE)
+        {
+            auto p = i < n ? expf(static_cast<ComputeT>(s[i]) - rowMax) / rowSum
+                           : static_cast<ComputeT>(0);
+            s[i]   = static_cast<OutputT>(p);
+        }
+    }
+}
+
+///
+/// Elementwise and row kernels
+///
+
+// Y = X / rms(X) * gamma over the rows of a row major m x n matrix, one wave per row
+ROCWMMA_KERNEL void __launch_bounds__(ELEMENTWISE_TBLOCK) rmsnorm_d(
+    uint32_t m, uint32_t n, InputT const* x, InputT const* gamma, OutputT* y)
+{
+    if constexpr(!ROCWMMA_ARCH_HOST)
+    {
+        auto row  = blockIdx.x * (blockDim.x / WARP_SIZE) + threadIdx.x / WARP_SIZE;
+        auto lane = threadIdx.x % WARP_SIZE;
+
+        if(row >= m)
+        {
+            return;
+        }
+
+        x += static_cast<uint64_t>(row) * n;
+        y += static_cast<uint64_t>(row) * n;
+
+        auto sumSq = static_cast<ComputeT>(0);
+        for(uint32_t i = lane; i < n; i += WARP_SIZE)
+        {
+            auto value = static_cast<ComputeT>(x[i]);
+            sumSq += value * value;
+        }
+        for(uint32_t offset = WARP_SIZE / 2u; offset > 0u; offset /= 2u)
+        {
+            sumSq += __shfl_xor(sumSq, offset);
+        }
+
+        auto invRms = rsqrtf(sumSq / static_cast<ComputeT>(n) + RMS_EPS);
+        for(uint32_t i = lane; i < n; i += WARP_SIZE)
+        {
+            y[i] = static_cast<OutputT>(static_cast<ComputeT>(x[i]) * invRms
+                                        * static_cast<ComputeT>(gamma[i]));
+        }
+    }
+}
+
+// Unfused residual: y = a + b, elementwise over size elements
+ROCWMMA_KERNEL void __launch_bounds__(ELEMENTWISE_TBLOCK)
+    residual_add_d(uint64_t size, OutputT const* a, OutputT const* b, OutputT* y)
+{
+    auto idx = static_cast<uint64_t>(blockIdx.x) * ELEMENTWISE_TBLOCK + threadIdx.x;
+    if(idx < size)
+    {
+        y[idx]
+            = static_cast<OutputT>(static_cast<ComputeT>(a[idx]) + static_cast<ComputeT>(b[idx]));
+    }
+}
+
+// Unfused gate: g = silu(gate) * up, elementwise over size elements
+ROCWMMA_KERNEL void __launch_bounds__(ELEMENTWISE_TBLOCK)
+    swiglu_gate_d(uint64_t size, OutputT const* gate, OutputT const* up, OutputT* g)
+{
+    auto idx = static_cast<uint64_t>(blockIdx.x) * ELEMENTWISE_TBLOCK + threadIdx.x;
+    if(idx < size)
+    {
+        auto gateC = epilogue::Silu::exec(static_cast<ComputeT>(gate[idx]));
+        g[idx]     = static_cast<OutputT>(gateC * static_cast<ComputeT>(up[idx]));
+    }
+}
+
+///
+/// Device initialization
+///
+
+// Fills data with offset + scale * u, where u is a hash of the index and seed in [-1, 1]
+// in steps of 1 / 8. Layer weights are too large to fill on the host in reasonable time.
+ROCWMMA_KERNEL void __launch_bounds__(ELEMENTWISE_TBLOCK)
+    fill_rand_d(uint64_t size, uint32_t seed, ComputeT scale, ComputeT offset, InputT* data)
+{
+    auto idx = static_cast<uint64_t>(blockIdx.x) * ELEMENTWISE_TBLOCK + threadIdx.x;
+    if(idx < size)
+    {
+        auto hash = static_cast<uint32_t>(idx) * 0x9E3779B1u ^ seed;
+        hash ^= hash >> 16u;
+        hash *= 0x85EBCA6Bu;
+        hash ^= hash >> 13u;
+
+        auto u    = static_cast<ComputeT>(static_cast<int32_t>(hash % 17u) - 8) / 8.0f;
+        data[idx] = static_cast<InputT>(offset + scale * u);
+    }
+}
+
+// Packs W1 and W3 (row major, d x h) into W13 (row major, d x 2h), alternating tileWidth
+// columns of each, one element of W1 and W3 per thread
+ROCWMMA_KERNEL void __launch_bounds__(ELEMENTWISE_TBLOCK) pack_gate_up_d(
+    uint32_t d, uint32_t h, uint32_t tileWidth, InputT const* w1, InputT const* w3, InputT* w13)
+{
+    auto idx = static_cast<uint64_t>(blockIdx.x) * ELEMENTWISE_TBLOCK + threadIdx.x;
+    if(idx < static_cast<uint64_t>(d) * h)
+    {
+        auto row       = idx / h;
+        auto col       = idx % h;
+        auto packedCol = (col / tileWidth) * 2u * tileWidth + col % tileWidth;
+
+        w13[row * 2u * h + packedCol]             = w1[idx];
+        w13[row * 2u * h + packedCol + tileWidth] = w3[idx];
+    }
+}
+
+///
+/// Layer
+///
+
+// Decoder layer geometry
+struct LayerConfig
+{
+    char const* mName;
+    uint32_t    mModelDim; // D = mHeads x HEAD_DIM
+    uint32_t    mHeads;
+    uint32_t    mKvHeads;
+    uint32_t    mFfnDim; // F
+};
+
+// One kernel launch of a layer composition
+struct LayerStage
+{
+    char const*           mName;
+    std::function<void()> mLaunch;
+};
+
+ROCWMMA_HOST void layer_test(LayerConfig const& config, uint32_t batch, uint32_t seqLen)
+{
+    // Runtime checks for host parameters, selected with the same config as the device
+    auto     params       = get_warp_tile_params<InputT>(getGcnArchId());
+    uint32_t hTBLOCK_X    = params.tblock_x;
+    uint32_t hTBLOCK_Y    = params.tblock_y;
+    uint32_t hROCWMMA_K   = params.block_k;
+    uint32_t hWARP_TILE_X = params.blocks_x * params.block_m;
+    uint32_t hWARP_TILE_Y = params.blocks_y * params.block_n;
+
+    // Runtime warp calculation (host code needs to query warpsize dynamically)
+    auto warpSize = getWarpSize();
+    auto macroTileSize
+        = make_coord2d(hTBLOCK_X / warpSize * hWARP_TILE_X, hTBLOCK_Y * hWARP_TILE_Y);
+
+    if(warpSize != params.wave_size)
+    {
+        std::cout << "Unsupported wave size!\n";
+        return;
+    }
+
+    uint32_t tokens  = batch * seqLen;
+    uint32_t d       = config.mModelDim;
+    uint32_t f       = config.mFfnDim;
+    uint32_t heads   = config.mHeads;
+    uint32_t kvHeads = config.mKvHeads;
+    uint32_t qkvDim  = (heads + 2u * kvHeads) * HEAD_DIM;
+
+    // Bounds check: whole macro tiles and attention tiles only
+    auto macroX = get<0>(macroTileSize);
+    auto macroY = get<1>(macroTileSize);
+    if(d != heads * HEAD_DIM || heads % kvHeads || tokens % macroX || d % macroY
+       || qkvDim % macroY || f % macroY || d % hROCWMMA_K || f % hROCWMMA_K
+       || seqLen % (ATTN_WAVES * ATTN_BLOCK))
+    {
+        std::cout << "Unsupported layer size!\n";
+        return;
+    }
+
+    auto scale     = static_cast<ComputeT>(1.0 / std::sqrt(static_cast<double>(HEAD_DIM)));
+    auto scaleLog2 = static_cast<ComputeT>(scale * M_LOG2E);
+
+    std::cout << "Initializing device data..." << std::endl;
+
+    // Weights
+    InputT* d_gammaAttn;
+    InputT* d_gammaFfn;
+    InputT* d_wqkv;
+    InputT* d_wo;
+    InputT* d_w1;
+    InputT* d_w3;
+    InputT* d_w13;
+    InputT* d_w2;
+
+    // Activations. The unfused path additionally writes the per head score matrices,
+    // the gate and up projections and the GEMM outputs before the residual adds.
+    InputT*  d_x;
+    OutputT* d_xn;
+    OutputT* d_qkv;
+    OutputT* d_o;
+    OutputT* d_h1;
+    OutputT* d_hn;
+    OutputT* d_g;
+    OutputT* d_y;
+    OutputT* d_s;
+    OutputT* d_gate;
+    OutputT* d_up;
+    OutputT* d_t;
+
+    const uint64_t elementsX   = static_cast<uint64_t>(tokens) * d;
+    const uint64_t elementsQKV = static_cast<uint64_t>(tokens) * qkvDim;
+    const uint64_t elementsG   = static_cast<uint64_t>(tokens) * f;
+    const uint64_t elementsS   = static_cast<uint64_t>(batch) * heads * seqLen * seqLen;
+
+    CHECK_HIP_ERROR(hipMalloc(&d_gammaAttn, d * sizeof(InputT)));
+    CHECK_HIP_ERROR(hipMalloc(&d_gammaFfn, d * sizeof(InputT)));
+    CHECK_HIP_ERROR(hipMalloc(&d_wqkv, static_cast<uint64_t>(d) * qkvDim * sizeof(InputT)));
+    CHECK_HIP_ERROR(hipMalloc(&d_wo, static_cast<uint64_t>(d) * d * sizeof(InputT)));
+    CHECK_HIP_ERROR(hipMalloc(&d_w1, static_cast<uint64_t>(d) * f * sizeof(InputT)));
+    CHECK_HIP_ERROR(hipMalloc(&d_w3, static_cast<uint64_t>(d) * f * sizeof(InputT)));
+    CHECK_HIP_ERROR(hipMalloc(&d_w13, 2ull * d * f * sizeof(InputT)));
+    CHECK_HIP_ERROR(hipMalloc(&d_w2, static_cast<uint64_t>(f) * d * sizeof(InputT)));
+
+    CHECK_HIP_ERROR(hipMalloc(&d_x, elementsX * sizeof(InputT)));
+    CHECK_HIP_ERROR(hipMalloc(&d_xn, elementsX * sizeof(OutputT)));
+    CHECK_HIP_ERROR(hipMalloc(&d_qkv, elementsQKV * sizeof(OutputT)));
+    CHECK_HIP_ERROR(hipMalloc(&d_o, elementsX * sizeof(OutputT)));
+    CHECK_HIP_ERROR(hipMalloc(&d_h1, elementsX * sizeof(OutputT)));
+    CHECK_HIP_ERROR(hipMalloc(&d_hn, elementsX * sizeof(OutputT)));
+    CHECK_HIP_ERROR(hipMalloc(&d_g, elementsG * sizeof(OutputT)));
+    CHECK_HIP_ERROR(hipMalloc(&d_y, elementsX * sizeof(OutputT)));
+    CHECK_HIP_ERROR(hipMalloc(&d_s, elementsS * sizeof(OutputT)));
+    CHECK_HIP_ERROR(hipMalloc(&d_gate, elementsG * sizeof(OutputT)));
+    CHECK_HIP_ERROR(hipMalloc(&d_up, elementsG * sizeof(OutputT)));
+    CHECK_HIP_ERROR(hipMalloc(&d_t, elementsX * sizeof(OutputT)));
+
+    auto elementwiseGrid = [](uint64_t size) {
+        return dim3(static_cast<uint32_t>(ceilDiv(size, uint64_t(ELEMENTWISE_TBLOCK))));
+    };
+
+    // Weights are scaled by a power of two close to 1 / sqrt(K), such that the
+    // activations keep unit range through the layer
+    auto fillRandDevice
+        = [&](InputT* data, uint64_t size, uint32_t seed, ComputeT fillScale, ComputeT offset) {
+              hipLaunchKernelGGL(fill_rand_d,
+                                 elementwiseGrid(size),
+                                 dim3(ELEMENTWISE_TBLOCK),
+                                 0, // sharedMemBytes
+                                 0, // stream
+                                 size,
+                                 seed,
+                                 fillScale,
+                                 offset,
+                                 data);
+          };
+
+    auto weightScale = [](uint32_t k) {
+        return std::exp2(-std::round(0.5 * std::log2(static_cast<double>(k))));
+    };
+
+    fillRandDevice(d_x, elementsX, 1u, 1.0f, 0.0f);
+    fillRandDevice(d_gammaAttn, d, 2u, 0.125f, 1.0f);
+    fillRandDevice(d_gammaFfn, d, 3u, 0.125f, 1.0f);
+    fillRandDevice(d_wqkv, static_cast<uint64_t>(d) * qkvDim, 4u, weightScale(d), 0.0f);
+    fillRandDevice(d_wo, static_cast<uint64_t>(d) * d, 5u, weightScale(d), 0.0f);
+    fillRandDevice(d_w1, static_cast<uint64_t>(d) * f, 6u, weightScale(d), 0.0f);
+    fillRandDevice(d_w3, static_cast<uint64_t>(d) * f, 7u, weightScale(d), 0.0f);
+    fillRandDevice(d_w2, static_cast<uint64_t>(f) * d, 8u, weightScale(f), 0.0f);
+
+    hipLaunchKernelGGL(pack_gate_up_d,
+                       elementwiseGrid(static_cast<uint64_t>(d) * f),
+                       dim3(ELEMENTWISE_TBLOCK),
+                       0, // sharedMemBytes
+                       0, // stream
+                       d,
+                       f,
+                       macroY,
+                       d_w1,
+                       d_w3,
+                       d_w13);
+    CHECK_HIP_ERROR(hipDeviceSynchronize());
+
+    ///
+    /// Kernel launches
+    ///
+
+    auto gemmBlockDim = dim3(hTBLOCK_X, hTBLOCK_Y);
+
+    // LDS stages of A and BSets sets of B
+    auto ldsusage = [&](uint32_t bSets) {
+        return 2u * sizeof(InputT) * (macroX + bSets * macroY) * hROCWMMA_K;
+    };
+
+    // D (tokens x n) = A (tokens x k) x B (k x n), optionally + R
+    auto gemm = [&](uint32_t n, uint32_t k, InputT const* a, InputT const* b, OutputT* out) {
+        hipExtLaunchKernelGGL((gemm_rocwmma_d<1u, false>),
+                              dim3(tokens / macroX, n / macroY),
+                              gemmBlockDim,
+                              ldsusage(1u),
+                              0,
+                              nullptr,
+                              nullptr,
+                              0,
+                              k,
+                              a,
+                              b,
+                              nullptr,
+                              out,
+                              k,
+                              n,
+                              n);
+    };
+
+    auto gemmResidual = [&](uint32_t       n,
+                            uint32_t       k,
+                            InputT const*  a,
+                            InputT const*  b,
+                            OutputT const* r,
+                            OutputT*       out) {
+        hipExtLaunchKernelGGL((gemm_rocwmma_d<1u, true>),
+                              dim3(tokens / macroX, n / macroY),
+                              gemmBlockDim,
+                              ldsusage(1u),
+                              0,
+                              nullptr,
+                              nullptr,
+                              0,
+                              k,
+                              a,
+                              b,
+                              r,
+                              out,
+                              k,
+                              n,
+                              n);
+    };
+
+    auto gemmSwiglu = [&](InputT const* a, OutputT* g) {
+        hipExtLaunchKernelGGL((gemm_rocwmma_d<2u, false>),
+                              dim3(tokens / macroX, f / macroY),
+                              gemmBlockDim,
+                              ldsusage(2u),
+                              0,
+                              nullptr,
+                              nullptr,
+                              0,
+                              d,
+                              a,
+                              d_w13,
+                              nullptr,
+                              g,
+                              d,
+                              2u * f,
+                              f);
+    };
+
+    auto rmsnorm = [&](InputT const* x, InputT const* gamma, OutputT* y) {
+        auto rowsPerBlock = ELEMENTWISE_TBLOCK / warpSize;
+        hipExtLaunchKernelGGL(rmsnorm_d,
+                              dim3(ceilDiv(tokens, rowsPerBlock)),
+                              dim3(ELEMENTWISE_TBLOCK),
+                              0,
+                              0,
+                              nullptr,
+                              nullptr,
+                              0,
+                              tokens,
+                              d,
+                              x,
+                              gamma,
+                              y);
+    };
+
+    auto residualAdd = [&](OutputT const* a, OutputT const* b, OutputT* y) {
+        hipExtLaunchKernelGGL(residual_add_d,
+                              elementwiseGrid(elementsX),
+                              dim3(ELEMENTWISE_TBLOCK),
+                              0,
+                              0,
+                              nullptr,
+                              nullptr,
+                              0,
+                              elementsX,
+                              a,
+                              b,
+                              y);
+    };
+
+    auto flashAttention = [&]() {
+        hipExtLaunchKernelGGL(flash_attention_d,
+                              dim3(seqLen / (ATTN_WAVES * ATTN_BLOCK), heads, batch),
+                              dim3(ATTN_WAVES * warpSize),
+                              ATTN_LDS_USAGE,
+                              0,
+                              nullptr,
+                              nullptr,
+                              0,
+                              seqLen,
+                              heads,
+                              kvHeads,
+                              d_qkv,
+                              d_o,
+                              scaleLog2);
+    };
+
+    // Unfused attention tiles: 4 x 4 waves of ATTN_BLOCK x ATTN_BLOCK outputs
+    auto attnBlockDim = dim3(4u * warpSize, 4u);
+    auto attnGridDim  = [&](uint32_t m, uint32_t n) {
+        return dim3(ceilDiv(m, 4u * ATTN_BLOCK), ceilDiv(n, 4u * ATTN_BLOCK), batch * heads);
+    };
+
+    // S = scale * Q x K^T, per (sequence, head)
+    auto attentionScores = [&]() {
+        uint64_t seqStrideQKV = static_cast<uint64_t>(seqLen) * qkvDim;
+        uint64_t strideS      = static_cast<uint64_t>(seqLen) * seqLen;
+        hipExtLaunchKernelGGL((attention_gemm_d<col_major>),
+                              attnGridDim(seqLen, seqLen),
+                              attnBlockDim,
+                              0,
+                              0,
+                              nullptr,
+                              nullptr,
+                              0,
+                              seqLen,
+                              seqLen,
+                              HEAD_DIM,
+                              heads,
+                              heads / kvHeads,
+                              d_qkv,
+                              d_qkv + heads * HEAD_DIM,
+                              d_s,
+                              qkvDim,
+                              qkvDim,
+                              seqLen,
+                              seqStrideQKV,
+                              uint64_t(HEAD_DIM),
+                              seqStrideQKV,
+                              uint64_t(HEAD_DIM),
+                              heads * strideS,
+                              strideS,
+                              scale);
+    };
+
+    auto attentionSoftmax = [&]() {
+        auto rowsPerBlock = ELEMENTWISE_TBLOCK / warpSize;
+        hipExtLaunchKernelGGL(causal_softmax_rows_d,
+                              dim3(batch * heads * seqLen / rowsPerBlock),
+                              dim3(ELEMENTWISE_TBLOCK),
+                              0,
+                              0,
+                              nullptr,
+                              nullptr,
+                              0,
+                              seqLen,
+                              d_s);
+    };
+
+    // O = P x V, per (sequence, head)
+    auto attentionValues = [&]() {
+        uint64_t seqStrideQKV = static_cast<uint64_t>(seqLen) * qkvDim;
+        uint64_t strideS      = static_cast<uint64_t>(seqLen) * seqLen;
+        hipExtLaunchKernelGGL((attention_gemm_d<row_major>),
+                              attnGridDim(seqLen, HEAD_DIM),
+                              attnBlockDim,
+                              0,
+                              0,
+                              nullptr,
+                              nullptr,
+                              0,
+                              seqLen,
+                              HEAD_DIM,
+                              seqLen,
+                              heads,
+                              heads / kvHeads,
+                              d_s,
+                              d_qkv + (heads + kvHeads) * HEAD_DIM,
+                              d_o,
+                              seqLen,
+                              qkvDim,
+                              d,
+                              heads * strideS,
+                              strideS,
+                              seqStrideQKV,
+                              uint64_t(HEAD_DIM),
+                              static_cast<uint64_t>(seqLen) * d,
+                              uint64_t(HEAD_DIM),
+                              1.0f);
+    };
+
+    std::vector<LayerStage> unfusedStages = {
+        {"RMSNorm", [&]() { rmsnorm(d_x, d_gammaAttn, d_xn); }},
+        {"QKV", [&]() { gemm(qkvDim, d, d_xn, d_wqkv, d_qkv); }},
+        {"Scores", attentionScores},
+        {"Softmax", attentionSoftmax},
+        {"PxV", attentionValues},
+        {"OutProj", [&]() { gemm(d, d, d_o, d_wo, d_t); }},
+        {"Residual", [&]() { residualAdd(d_t, d_x, d_h1); }},
+        {"RMSNorm", [&]() { rmsnorm(d_h1, d_gammaFfn, d_hn); }},
+        {"Gate", [&]() { gemm(f, d, d_hn, d_w1, d_gate); }},
+        {"Up", [&]() { gemm(f, d, d_hn, d_w3, d_up); }},
+        {"SwiGLU", [&]() {
+             hipExtLaunchKernelGGL(swiglu_gate_d,
+                                   elementwiseGrid(elementsG),
+                                   dim3(ELEMENTWISE_TBLOCK),
+                                   0,
+                                   0,
+                                   nullptr,
+                                   nullptr,
+                                   0,
+                                   elementsG,
+                                   d_gate,
+                                   d_up,
+                                   d_g);
+         }},
+        {"Down", [&]() { gemm(d, f, d_g, d_w2, d_t); }},
+        {"Residual", [&]() { residualAdd(d_t, d_h1, d_y); }}};
+
+    std::vector<LayerStage> fusedStages = {
+        {"RMSNorm", [&]() { rmsnorm(d_x, d_gammaAttn, d_xn); }},
+        {"QKV", [&]() { gemm(qkvDim, d, d_xn, d_wqkv, d_qkv); }},
+        {"FlashAttention", flashAttention},
+        {"OutProj+Residual", [&]() { gemmResidual(d, d, d_o, d_wo, d_x, d_h1); }},
+        {"RMSNorm", [&]() { rmsnorm(d_h1, d_gammaFfn, d_hn); }},
+        {"GateUp+SwiGLU", [&]() { gemmSwiglu(d_hn, d_g); }},
+        {"Down+Residual", [&]() { gemmResidual(d, f, d_g, d_w2, d_h1, d_y); }}};
+
+    // Runs are timed individually, with warm and cold caches
+    BenchmarkHarness harness;
+
+    // Useful flops of the layer: projections, and the causal half of the attention products
+    uint64_t attendedPairs = static_cast<uint64_t>(batch) * seqLen * (seqLen + 1u) / 2u;
+
+    auto gFlops = calculateGFlops(tokens, qkvDim, d) + calculateGFlops(tokens, d, d)
+                  + 3.0 * calculateGFlops(tokens, f, d)
+                  + 4.0 * HEAD_DIM * heads * static_cast<double>(attendedPairs) * 1.0e-9;
+
+    auto echo = [&](char const* pathName, std::vector<LayerStage> const& stages) {
+        // Each kernel in isolation, warm
+        auto kernelsMs = 0.0;
+        for(auto const& stage : stages)
+        {
+            auto stats = harness.run(stage.mLaunch, BenchmarkHarness::CacheState::Warm);
+            kernelsMs += stats.mMedianMs;
+
+            std::cout << "  " << pathName << " " << stage.mName << ": " << stats.mMedianMs
+                      << " ms" << std::endl;
+        }
+
+        // The whole layer back to back
+        auto layer = [&]() {
+            for(auto const& stage : stages)
+            {
+                stage.mLaunch();
+            }
+        };
+
+        for(auto cacheState :
+            {BenchmarkHarness::CacheState::Warm, BenchmarkHarness::CacheState::Cold})
+        {
+            auto stats        = harness.run(layer, cacheState);
+            auto tokensPerSec = tokens / (stats.mMedianMs * 1.0e-3);
+            auto tFlopsPerSec = gFlops / stats.mMedianMs;
+
+            std::cout << pathName << ", " << config.mName << ", " << batch << ", " << seqLen
+                      << ", " << tokens << ", " << stages.size() << ", "
+                      << (cacheState == BenchmarkHarness::CacheState::Warm ? "warm" : "cold")
+                      << ", " << stats.mMedianMs << ", " << kernelsMs << ", "
+                      << stats.mMedianMs - kernelsMs << ", " << tokensPerSec << ", " << gFlops
+                      << ", " << tFlopsPerSec << ", ";
+            BenchmarkHarness::printStats(std::cout, stats) << std::endl;
+        }
+    };
+
+    std::cout << "Path, Model, Batch, SeqLen, Tokens, Kernels, Cache, layerMs, kernelsMs, "
+              << "interKernelMs, Tokens/s, Problem Size(GFlops), TFlops/s, "
+              << BenchmarkHarness::statsHeader() << std::endl;
+
+    echo("Unfused", unfusedStages);
+
+#if !NDEBUG
+    std::vector<OutputT> matrixY(elementsX);
+    CHECK_HIP_ERROR(
+        hipMemcpy(matrixY.data(), d_y, elementsX * sizeof(OutputT), hipMemcpyDeviceToHost));
+
+    // Fill outputs with NaN to catch contamination
+    CHECK_HIP_ERROR(hipMemset(d_h1, 0xFF, elementsX * sizeof(OutputT)));
+    CHECK_HIP_ERROR(hipMemset(d_y, 0xFF, elementsX * sizeof(OutputT)));
+#endif // !NDEBUG
+
+    echo("Fused", fusedStages);
+
+#if !NDEBUG
+
+    // The kernels of both paths are validated against host references in their own samples.
+    // Here the fused layer output is compared with the unfused one, which rounds the
+    // probabilities, the gate and up projections and the pre-residual outputs to half.
+    std::cout << "Validating fused layer with unfused layer..." << std::endl;
+
+    std::vector<OutputT> matrixY_fused(elementsX);
+    CHECK_HIP_ERROR(hipMemcpy(
+        matrixY_fused.data(), d_y, elementsX * sizeof(OutputT), hipMemcpyDeviceToHost));
+
+    auto res = compareEqual(matrixY_fused.data(), matrixY.data(), elementsX, 50.0);
+
+    std::cout << (std::get<0>(res) ? "PASSED" : "FAILED") << std::endl;
+    std::cout << "Max relative error: " << std::get<1>(res) << std::endl;
+
+#endif // !NDEBUG
+
+    // Release device memory
+    for(auto* ptr : {d_gammaAttn, d_gammaFfn, d_wqkv, d_wo, d_w1, d_w3, d_w13, d_w2, d_x})
+    {
+        CHECK_HIP_ERROR(hipFree(ptr));
+    }
+    for(auto* ptr : {d_xn, d_qkv, d_o, d_h1, d_hn, d_g, d_y, d_s, d_gate, d_up, d_t})
+    {
+        CHECK_HIP_ERROR(hipFree(ptr));
+    }
+
+    std::cout << "Finished!" << std::endl;
+}
+
+int main()
+{
+    // LLaMA-7B (multi-head attention) and LLaMA-3-8B (grouped query attention) layers
+    LayerConfig llama7b   = {"llama-7b", 4096u, 32u, 32u, 11008u};
+    LayerConfig llama3_8b = {"llama3-8b", 4096u, 32u, 8u, 14336u};
+
+    // Prefill batches of 2048 to 8192 tokens
+    for(auto const& config : {llama7b, llama3_8b})
+    {
+        layer_test(config, 1u, 2048u);
+        layer_test(config, 4u, 1024u);
+        layer_test(config, 16u, 512u);
+    }
+
+    return 0;
+}
@@ -32,9 +32,13 @@
 
 #include <rocwmma/rocwmma.hpp>
 #include <rocwmma/rocwmma_coop.hpp>
+#include <rocwmma/rocwmma_epilogue.hpp>
+#include <rocwmma/rocwmma_tile.hpp>
 #include <rocwmma/rocwmma_transforms.hpp>
 
+#include "benchmark_harness.hpp"
 #include "common.hpp"
+#include "perf_golden.hpp"
 
 /* Motivation
 *
@@ -240,6 +244,20 @@ using MfmaFragC   = fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, Outpu
 using MfmaFragD   = MfmaFragC;
 using MfmaFragAcc = fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, ComputeT>;
 
+// C frags in any datatype and data layout
+template <typename DataTC, typename LayoutC>
+using MfmaFragCT = fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, DataTC, LayoutC>;
+
+// Warp tile of mfma frags
+using MfmaTileA   = fragment_array<MfmaFragA, BLOCKS_X, 1u>;
+using MfmaTileB   = fragment_array<MfmaFragB, 1u, BLOCKS_Y>;
+using MfmaTileC   = fragment_array<MfmaFragC, BLOCKS_X, BLOCKS_Y>;
+using MfmaTileD   = MfmaTileC;
+using MfmaTileAcc = fragment_array<MfmaFragAcc, BLOCKS_X, BLOCKS_Y>;
+
+template <typename DataTC, typename LayoutC>
+using MfmaTileCT = fragment_array<MfmaFragCT<DataTC, LayoutC>, BLOCKS_X, BLOCKS_Y>;
+
 // Global read (macro tile)
 using GRBuffA = fragment<matrix_a, MACRO_TILE_X, ROCWMMA_N, ROCWMMA_K, InputT, DataLayoutA>;
 using GRBuffB = fragment<matrix_b, ROCWMMA_M, MACRO_TILE_Y, ROCWMMA_K, InputT, DataLayoutB>;
@@ -309,7 +327,7 @@ ROCWMMA_DEVICE static inline void
 
 // Local A reads for warp tile gemm, non-cooperative
 ROCWMMA_DEVICE static inline void
-    localReadA(MfmaFragA (&fragsA)[BLOCKS_X], InputT const* ldsAddrA, uint32_t ldsld)
+    localReadA(MfmaTileA& fragsA, InputT const* ldsAddrA, uint32_t ldsld)
 {
     using FragShape = GetIOShape_t<LRFragA>;
     using Mapper1d  = GetDataLayout_t<LRFragA>;
@@ -322,7 +340,7 @@ ROCWMMA_DEVICE static inline void
     {
         LRFragA tmp;
         load_matrix_sync(tmp, ldsAddrA, ldsld);
-        fragsA[i] = applyDataLayout<DataLayoutA>(tmp);
+        fragsA(i, 0u) = applyDataLayout<DataLayoutA>(tmp);
 
         ldsAddrA += blockStep;
     }
@@ -330,7 +348,7 @@ ROCWMMA_DEVICE static inline void
 
 // Local B reads for warp tile gemm, non-cooperative
 ROCWMMA_DEVICE static inline void
-    localReadB(MfmaFragB (&fragsB)[BLOCKS_Y], InputT const* ldsAddrB, uint32_t ldsld)
+    localReadB(MfmaTileB& fragsB, InputT const* ldsAddrB, uint32_t ldsld)
 {
     using FragShape = GetIOShape_t<LRFragB>;
     using Mapper1d  = GetDataLayout_t<LRFragB>;
@@ -345,114 +363,52 @@ ROCWMMA_DEVICE static inline void
         load_matrix_sync(tmp, ldsAddrB, ldsld);
 
         // Transform back to MFMA tile
-        fragsB[i] = applyDataLayout<DataLayoutB>(applyTranspose(tmp));
+        fragsB(0u, i) = applyDataLayout<DataLayoutB>(applyTranspose(tmp));
 
         ldsAddrB += blockStep;
     }
 }
 
-// Global C reads for warp tile gemm, non-cooperative
-ROCWMMA_DEVICE static inline void
-    globalReadC(MfmaFragC (&fragC)[BLOCKS_X][BLOCKS_Y], OutputT const* gAddrC, uint32_t ldc)
-{
-    using FragShape = GetIOShape_t<MfmaFragC>;
-    using Mapper1d  = GetDataLayout_t<MfmaFragC>;
-
-    // Iterative offsets for each C block in the wave tile
-    auto blockStepX = Mapper1d::fromMatrixCoord(make_coord2d(FragShape::BlockHeight, 0u), ldc);
-    auto blockStepY = Mapper1d::fromMatrixCoord(make_coord2d(0u, FragShape::BlockWidth), ldc);
-
-#pragma unroll
-    for(int i = 0; i < BLOCKS_X; i++)
-    {
-        auto offsetY = 0u;
-#pragma unroll
-        for(int j = 0; j < BLOCKS_Y; j++)
-        {
-            load_matrix_sync(fragC[i][j], gAddrC + offsetY, ldc);
-            offsetY += blockStepY;
-        }
-        gAddrC += blockStepX;
-    }
-}
-
-// Global D reads for warp tile gemm, non-cooperative
-ROCWMMA_DEVICE static inline void
-    globalWriteD(OutputT* gAddrD, MfmaFragD const (&fragsD)[BLOCKS_X][BLOCKS_Y], uint32_t ldd)
-{
-    using FragShape = GetIOShape_t<MfmaFragD>;
-    using Mapper1d  = GetDataLayout_t<MfmaFragD>;
-
-    // Iterative offsets for each D block in the warp tile
-    auto blockStepX = Mapper1d::fromMatrixCoord(make_coord2d(FragShape::BlockHeight, 0u), ldd);
-    auto blockStepY = Mapper1d::fromMatrixCoord(make_coord2d(0u, FragShape::BlockWidth), ldd);
-
-#pragma unroll
-    for(int i = 0; i < BLOCKS_X; i++)
-    {
-        auto offsetY = 0u;
-#pragma unroll
-        for(int j = 0; j < BLOCKS_Y; j++)
-        {
-            store_matrix_sync(gAddrD + offsetY, fragsD[i][j], ldd);
-            offsetY += blockStepY;
-        }
-        gAddrD += blockStepX;
-    }
-}
-
-// Broadcast value to fragments in warp tile
-template <typename FragT>
-ROCWMMA_DEVICE static inline void fill(FragT (&frags)[BLOCKS_X][BLOCKS_Y],
-                                       GetDataType_t<FragT> value)
-{
-#pragma unroll
-    for(int i = 0; i < BLOCKS_X; i++)
-    {
-#pragma unroll
-        for(int j = 0; j < BLOCKS_Y; j++)
-        {
-            fill_fragment(frags[i][j], value);
-        }
-    }
-}
-
-// Performs warp tile mfma
-ROCWMMA_DEVICE static inline void mfma(MfmaFragAcc (&fragsAccOut)[BLOCKS_X][BLOCKS_Y],
-                                       MfmaFragA const (&fragsA)[BLOCKS_X],
-                                       MfmaFragB const (&fragsB)[BLOCKS_Y],
-                                       MfmaFragAcc const (&fragsAccIn)[BLOCKS_X][BLOCKS_Y])
-{
-#pragma unroll
-    for(int i = 0; i < BLOCKS_X; i++)
-    {
-#pragma unroll
-        for(int j = 0; j < BLOCKS_Y; j++)
-        {
-            mma_sync(fragsAccOut[i][j], fragsA[i], fragsB[j], fragsAccIn[i][j]);
-        }
-    }
-}
-
 // Uniform multiply - add (FMA)
-// Performs D = alpha * acc + beta * C, where alpha, beta are uniform scalars
-ROCWMMA_DEVICE static inline void uniformFma(MfmaFragD (&fragsD)[BLOCKS_X][BLOCKS_Y],
-                                             ComputeT alpha,
-                                             MfmaFragAcc const (&fragsAcc)[BLOCKS_X][BLOCKS_Y],
-                                             ComputeT beta,
-                                             MfmaFragC const (&fragsC)[BLOCKS_X][BLOCKS_Y])
+// Performs D = alpha * acc + beta * C, where alpha, beta are uniform scalars.
+// The case lc of alpha and beta is uniform: unless it is linear_full, fragsC is not read
+// and need not be loaded. C may be held in another datatype and data layout than D:
+// it is converted to ComputeT in registers. Accumulator register order doesn't depend
+// on the data layout.
+template <typename DataTC, typename LayoutC>
+ROCWMMA_DEVICE static inline void uniformFma(MfmaTileD&                         fragsD,
+                                             linear_combination_t               lc,
+                                             ComputeT                           alpha,
+                                             MfmaTileAcc const&                 fragsAcc,
+                                             ComputeT                           beta,
+                                             MfmaTileCT<DataTC, LayoutC> const& fragsC)
 {
+    detail::checkCoIndexed<MfmaFragD, MfmaFragCT<DataTC, LayoutC>>();
+
 #pragma unroll
     for(int i = 0; i < BLOCKS_X; i++)
     {
 #pragma unroll
         for(int j = 0; j < BLOCKS_Y; j++)
         {
-            for(int k = 0; k < fragsD[i][j].num_elements; k++)
+            if(lc == linear_identity)
+            {
+                rocwmma::apply_epilogue(fragsD(i, j), fragsAcc(i, j));
+            }
+            else if(lc == linear_scale)
             {
-                // Perform computation in ComputeT and cast back to OutputT
-                fragsD[i][j].x[k] = static_cast<OutputT>(
-                    alpha * fragsAcc[i][j].x[k] + beta * static_cast<ComputeT>(fragsC[i][j].x[k]));
+                rocwmma::apply_epilogue(
+                    fragsD(i, j), fragsAcc(i, j), rocwmma::epilogue::TensorScale(alpha));
+            }
+            else
+            {
+                auto c = Convert<DataTC, ComputeT>::exec(fragsC(i, j).mAccess);
+                for(int k = 0; k < fragsD(i, j).num_elements; k++)
+                {
+                    // Perform computation in ComputeT and cast back to OutputT
+                    fragsD(i, j).x[k]
+                        = static_cast<OutputT>(alpha * fragsAcc(i, j).x[k] + beta * c.data[k]);
+                }
             }
         }
     }
@@ -581,8 +537,8 @@ ROCWMMA_KERNEL void __launch_bounds__(256) gemm_rocwmma_d(uint32_t       m,
     ///
     /// Initialize accumulation frags
     ///
-    MfmaFragAcc fragsAcc[BLOCKS_X][BLOCKS_Y];
-    fill(fragsAcc, 0.0f);
+    MfmaTileAcc fragsAcc;
+    fill_fragment(fragsAcc, 0.0f);
 
     ///
     /// Synchronize warps and memory
@@ -594,8 +550,8 @@ ROCWMMA_KERNEL void __launch_bounds__(256) gemm_rocwmma_d(uint32_t       m,
     ///
     for(auto currentK = ROCWMMA_K; currentK < k; currentK += ROCWMMA_K)
     {
-        MfmaFragA fragsA[BLOCKS_X];
-        MfmaFragB fragsB[BLOCKS_Y];
+        MfmaTileA fragsA;
+        MfmaTileB fragsB;
 
         // Local read mfma frags from first LDS buffer
         localReadA(fragsA, ldsPtrLo + ldsReadOffsetA, ldsld);
@@ -610,7 +566,7 @@ ROCWMMA_KERNEL void __launch_bounds__(256) gemm_rocwmma_d(uint32_t       m,
         globalReadOffsetB += kStepOffsetB;
 
         // accum(A * B)
-        mfma(fragsAcc, fragsA, fragsB, fragsAcc);
+        mma_sync(fragsAcc, fragsA, fragsB, fragsAcc);
 
         // Write prefetch to second LDS buffer
         localWriteCoopA<warpCount>(ldsPtrHi + ldsWriteOffsetA, grBuffA, ldsld, warpIndex);
@@ -631,26 +587,32 @@ ROCWMMA_KERNEL void __launch_bounds__(256) gemm_rocwmma_d(uint32_t       m,
     using MfmaFragCMap1d = GetDataLayout_t<MfmaFragC>;
     using MfmaFragDMap1d = GetDataLayout_t<MfmaFragD>;
 
-    MfmaFragC fragsC[BLOCKS_X][BLOCKS_Y];
-    globalReadC(fragsC, c + MfmaFragCMap1d::fromMatrixCoord(warpTileCoord, ldc), ldc);
+    MfmaTileC fragsC;
+
+    // C is only read when beta != 0
+    auto linearCase = get_linear_combination(alpha, beta);
+    if(linearCase == linear_full)
+    {
+        load_matrix_sync(fragsC, c + MfmaFragCMap1d::fromMatrixCoord(warpTileCoord, ldc), ldc);
+    }
 
     ///
     /// Clean up tail A * B
     ///
-    MfmaFragA fragsA[BLOCKS_X];
-    MfmaFragB fragsB[BLOCKS_Y];
+    MfmaTileA fragsA;
+    MfmaTileB fragsB;
 
     // Local read mfma frags
     localReadA(fragsA, ldsPtrLo + ldsReadOffsetA, ldsld);
     localReadB(fragsB, ldsPtrLo + ldsReadOffsetB, ldsld);
-    mfma(fragsAcc, fragsA, fragsB, fragsAcc);
+    mma_sync(fragsAcc, fragsA, fragsB, fragsAcc);
 
     ///
     /// D = alpha * accum + beta * C
     ///
-    MfmaFragD fragsD[BLOCKS_X][BLOCKS_Y];
-    uniformFma(fragsD, alpha, fragsAcc, beta, fragsC);
-    globalWriteD(d + MfmaFragDMap1d::fromMatrixCoord(warpTileCoord, ldd), fragsD, ldd);
+    MfmaTileD fragsD;
+    uniformFma(fragsD, linearCase, alpha, fragsAcc, beta, fragsC);
+    store_matrix_sync(d + MfmaFragDMap1d::fromMatrixCoord(warpTileCoord, ldd), fragsD, ldd);
 }
 
 ROCWMMA_HOST void gemm_test(uint32_t m, uint32_t n, uint32_t k, ComputeT alpha, ComputeT beta)
@@ -765,37 +727,10 @@ ROCWMMA_HOST void gemm_test(uint32_t m, uint32_t n, uint32_t k, ComputeT alpha,
                               beta);
     };
 
-    constexpr uint32_t warmups    = 2u;
-    constexpr uint32_t recordRuns = 5u;
-
-    // Warm-up runs, not recorded
-    for(uint32_t i = 0; i < warmups; ++i)
-    {
-        rocwmmaKernel();
-    }
-
-    // Actual recorded runs
-    hipEvent_t startEvent, stopEvent;
-    CHECK_HIP_ERROR(hipEventCreate(&startEvent));
-    CHECK_HIP_ERROR(hipEventCreate(&stopEvent));
-
-    CHECK_HIP_ERROR(hipEventRecord(startEvent));
-    for(uint32_t i = 0; i < recordRuns; ++i)
-    {
-        rocwmmaKernel();
-    }
-    CHECK_HIP_ERROR(hipEventRecord(stopEvent));
-    CHECK_HIP_ERROR(hipEventSynchronize(stopEvent));
-
-    auto elapsedTimeMs = 0.0f;
-    CHECK_HIP_ERROR(hipEventElapsedTime(&elapsedTimeMs, startEvent, stopEvent));
+    // Runs are timed individually, with warm and cold caches
+    BenchmarkHarness harness;
 
     auto gFlops = calculateGFlops(m, n, k);
-    auto tFlopsPerSec
-        = calculateTFlopsPerSec(m, n, k, static_cast<double>(elapsedTimeMs), recordRuns);
-
-    CHECK_HIP_ERROR(hipEventDestroy(startEvent));
-    CHECK_HIP_ERROR(hipEventDestroy(stopEvent));
 
     // Echo performance
     std::cout << "TBlockX, TBlockY, "
@@ -804,13 +739,28 @@ ROCWMMA_HOST void gemm_test(uint32_t m, uint32_t n, uint32_t k, ComputeT alpha,
               << "MatM, MatN, MatK, "
               << "alpha, lda, ldb, "
               << "beta, ldc, ldd, "
-              << "elapsedMs, Problem Size(GFlops), TFlops/s" << std::endl;
+              << "Cache, elapsedMs, Problem Size(GFlops), TFlops/s, "
+              << BenchmarkHarness::statsHeader() << std::endl;
 
-    std::cout << TBLOCK_X << ", " << TBLOCK_Y << ", " << BLOCKS_X << ", " << BLOCKS_Y << ", "
-              << ROCWMMA_M << ", " << ROCWMMA_N << ", " << ROCWMMA_K << ", " << m << ", " << n
-              << ", " << k << ", " << alpha << ", " << lda << ", " << ldb << ", " << beta << ", "
-              << ldc << ", " << ldd << ", " << elapsedTimeMs << ", " << gFlops << ", "
-              << tFlopsPerSec << std::endl;
+    for(auto cacheState : {BenchmarkHarness::CacheState::Warm, BenchmarkHarness::CacheState::Cold})
+    {
+        auto stats        = harness.run(rocwmmaKernel, cacheState);
+        auto tFlopsPerSec = calculateTFlopsPerSec(m, n, k, stats.mMedianMs);
+
+        std::cout << TBLOCK_X << ", " << TBLOCK_Y << ", " << BLOCKS_X << ", " << BLOCKS_Y << ", "
+                  << ROCWMMA_M << ", " << ROCWMMA_N << ", " << ROCWMMA_K << ", " << m << ", " << n
+                  << ", " << k << ", " << alpha << ", " << lda << ", " << ldb << ", " << beta
+                  << ", " << ldc << ", " << ldd << ", "
+                  << (cacheState == BenchmarkHarness::CacheState::Warm ? "warm" : "cold") << ", "
+                  << stats.mMedianMs << ", " << gFlops << ", " << tFlopsPerSec << ", ";
+        BenchmarkHarness::printStats(std::cout, stats) << std::endl;
+
+        if(cacheState == BenchmarkHarness::CacheState::Warm)
+        {
+            PerfGolden::instance().check(
+                "perf_dgemm", "rocwmma", TBLOCK_X, TBLOCK_Y, m, n, k, stats);
+        }
+    }
 
 #if !NDEBUG
 
@@ -875,5 +825,5 @@ int main()
         gemm_test(7168, 7168, 7168, 2, 2);
     }
 
-    return 0;
+    return PerfGolden::instance().status();
 }
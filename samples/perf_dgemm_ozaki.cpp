@@ -0,0 +1,549 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_runtime.h>
+
+#include <rocwmma/rocwmma.hpp>
+
+#include "benchmark_harness.hpp"
+#include "common.hpp"
+
+/* Motivation
+*
+* fp64 MFMA throughput is a fraction of int8 MFMA throughput. The Ozaki scheme
+* computes a DGEMM exactly in pieces on the int8 units:
+*
+* 1) Split: each row of A (and column of B) is scaled by a power of two 2^e,
+*    such that all of its elements lie in (-1, 1), then sliced into S int8 pieces
+*    of 7 bits each:
+*
+*       A(i, k) = 2^e(i) * sum_p A_p(i, k) * 2^(-7 (p + 1)),    |A_p| <= 127
+*
+* 2) Multiply: every slice product A_p x B_q is exact in int32 while
+*    K * 127 * 127 < 2^31, i.e. K <= 131072.
+*
+* 3) Accumulate: products are weighted by 2^(-7 (p + q + 2)) and summed in fp64.
+*    Products with p + q >= S are below the precision of the slices and are skipped,
+*    leaving S (S + 1) / 2 int8 GEMMs. Small weights are accumulated first.
+*
+* 4) Reconstruct: D(i, j) = alpha * 2^(e(i) + f(j)) * accum(i, j) + beta * C(i, j).
+*
+* Each slice carries 7 bits relative to the largest element of its row or column, so
+* the number of slices trades accuracy for speed: about 7 S bits of the row maximum are
+* kept. Rows with a wide exponent range lose the low bits of their small elements first.
+*
+* This sample times the split and the GEMM of each slice count together, and reports
+* the error relative to a long double reference on sampled rows, next to a native fp64
+* mma kernel of the same tiling. perf_dgemm is the tuned native fp64 reference.
+*/
+
+using rocwmma::accumulator;
+using rocwmma::col_major;
+using rocwmma::float64_t;
+using rocwmma::matrix_a;
+using rocwmma::matrix_b;
+using rocwmma::row_major;
+
+// Block sizes of the int8 and native fp64 mma
+const int ROCWMMA_M     = 16;
+const int ROCWMMA_N     = 16;
+const int ROCWMMA_K_I8  = 32;
+const int ROCWMMA_K_F64 = 16;
+
+// Device warp size
+const uint32_t WAVE_SIZE = getWarpSize();
+
+// Thread block
+// : T_BLOCK_X must be multiple of WAVE_SIZE.
+// Note: Each wave will compute one BLOCK_M x BLOCK_N output block
+// Note: Workgroup will compute
+//  T_BLOCK_X / WAVE_SIZE x T_BLOCK_Y output blocks
+const int T_BLOCK_X       = 4 * WAVE_SIZE;
+const int T_BLOCK_Y       = 4;
+const int WAVES_PER_BLOCK = 16;
+
+// Bits per int8 slice, keeping the sign
+const int SLICE_BITS = 7;
+
+// Split threads per row
+const int SPLIT_BLOCK = 256;
+
+// Scales each row of x by the power of two of its largest element and slices the
+// result into Slices int8 pieces. Slice p of row r is at slices[(p * rows + r) * k].
+// Column major B is split as the rows of B^T.
+template <uint32_t Slices>
+__global__ void ozaki_split_d(uint32_t         rows,
+                              uint32_t         k,
+                              float64_t const* x,
+                              uint32_t         ldx,
+                              int8_t*          slices,
+                              int32_t*         exps)
+{
+    __shared__ int32_t sExp;
+
+    auto        row  = blockIdx.x;
+    auto const* xRow = x + static_cast<size_t>(row) * ldx;
+
+    if(threadIdx.x == 0)
+    {
+        sExp = INT_MIN;
+    }
+    __syncthreads();
+
+    // x = m * 2^e, 0.5 <= |m| < 1
+    auto rowExp = INT_MIN;
+    for(uint32_t i = threadIdx.x; i < k; i += blockDim.x)
+    {
+        int32_t e;
+        if(xRow[i] != 0.0)
+        {
+            frexp(xRow[i], &e);
+            rowExp = max(rowExp, e);
+        }
+    }
+    atomicMax(&sExp, rowExp);
+    __syncthreads();
+
+    // All zero rows have all zero slices
+    rowExp = (sExp == INT_MIN) ? 0 : sExp;
+    if(threadIdx.x == 0)
+    {
+        exps[row] = rowExp;
+    }
+
+    for(uint32_t i = threadIdx.x; i < k; i += blockDim.x)
+    {
+        // |r| < 1, each step moves the next 7 bits above the binary point
+        auto r = ldexp(xRow[i], -rowExp);
+
+#pragma unroll
+        for(uint32_t p = 0; p < Slices; p++)
+        {
+            r *= static_cast<float64_t>(1 << SLICE_BITS);
+            auto q = trunc(r);
+            r -= q;
+            slices[(static_cast<size_t>(p) * rows + row) * k + i] = static_cast<int8_t>(q);
+        }
+    }
+}
+
+// Each wave computes one BLOCK_M x BLOCK_N output block from the int8 slices.
+// Slice products are accumulated in int32 fragments, then gathered into fp64
+// through a per-wave LDS tile, each lane owning the elements lane + i * WAVE_SIZE.
+//
+// In this simplified example, we assume:
+// : A is in row-major format     (M x K)
+// : B is in col-major format     (K x N)
+// : C, D are in row-major format (M x N)
+// : M and N are multiples of the workgroup tile, so all waves are active
+template <uint32_t Slices>
+__global__ void dgemm_ozaki_d(uint32_t         m,
+                              uint32_t         n,
+                              uint32_t         k,
+                              int8_t const*    aSlices,
+                              int32_t const*   aExps,
+                              int8_t const*    bSlices,
+                              int32_t const*   bExps,
+                              float64_t const* c,
+                              float64_t*       d,
+                              uint32_t         ldc,
+                              uint32_t         ldd,
+                              float64_t        alpha,
+                              float64_t        beta)
+{
+    constexpr uint32_t WaveSize        = rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    constexpr uint32_t TileSize        = ROCWMMA_M * ROCWMMA_N;
+    constexpr uint32_t ElementsPerLane = TileSize / WaveSize;
+
+    __shared__ int32_t sTiles[WAVES_PER_BLOCK][TileSize];
+
+    // Create frags
+    auto fragA
+        = rocwmma::fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K_I8, int8_t, row_major>();
+    auto fragB
+        = rocwmma::fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K_I8, int8_t, col_major>();
+    auto fragAcc = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K_I8, int32_t>();
+
+    // Tile using a 2D grid
+    auto majorWarp = (blockIdx.x * blockDim.x + threadIdx.x) / WaveSize;
+    auto minorWarp = (blockIdx.y * blockDim.y + threadIdx.y);
+    auto waveIndex = threadIdx.x / WaveSize + threadIdx.y * (blockDim.x / WaveSize);
+    auto lane      = threadIdx.x % WaveSize;
+    auto sTile     = sTiles[waveIndex];
+
+    // Target C block
+    auto cRow = majorWarp * ROCWMMA_M;
+    auto cCol = minorWarp * ROCWMMA_N;
+
+    float64_t accum[ElementsPerLane] = {};
+
+    // Anti-diagonals of the slice products, smallest weights first
+    for(int32_t diag = Slices - 1; diag >= 0; diag--)
+    {
+        auto weight = ldexp(1.0, -SLICE_BITS * (diag + 2));
+
+        for(int32_t p = 0; p <= diag; p++)
+        {
+            auto q      = diag - p;
+            auto aSlice = aSlices + (static_cast<size_t>(p) * m + cRow) * k;
+            auto bSlice = bSlices + (static_cast<size_t>(q) * n + cCol) * k;
+
+            // fragAcc = A_p x B_q, exact in int32
+            rocwmma::fill_fragment(fragAcc, 0);
+            for(int i = 0; i < k; i += ROCWMMA_K_I8)
+            {
+                rocwmma::load_matrix_sync(fragA, aSlice + i, k);
+                rocwmma::load_matrix_sync(fragB, bSlice + i, k);
+                rocwmma::mma_sync(fragAcc, fragA, fragB, fragAcc);
+            }
+
+            // Gather the product into fp64
+            rocwmma::store_matrix_sync(sTile, fragAcc, ROCWMMA_N, rocwmma::mem_row_major);
+            rocwmma::synchronize_workgroup();
+
+#pragma unroll
+            for(uint32_t e = 0; e < ElementsPerLane; e++)
+            {
+                accum[e] += weight * static_cast<float64_t>(sTile[lane + e * WaveSize]);
+            }
+            rocwmma::synchronize_workgroup();
+        }
+    }
+
+    // D = alpha * 2^(e + f) * accum + beta * C
+#pragma unroll
+    for(uint32_t e = 0; e < ElementsPerLane; e++)
+    {
+        auto idx = lane + e * WaveSize;
+        auto row = cRow + idx / ROCWMMA_N;
+        auto col = cCol + idx % ROCWMMA_N;
+
+        auto value = ldexp(accum[e], aExps[row] + bExps[col]);
+        d[row * ldd + col] = alpha * value + beta * c[row * ldc + col];
+    }
+}
+
+// Native fp64 mma baseline of the same tiling
+__global__ void dgemm_native_d(uint32_t         m,
+                               uint32_t         n,
+                               uint32_t         k,
+                               float64_t const* a,
+                               float64_t const* b,
+                               float64_t const* c,
+                               float64_t*       d,
+                               uint32_t         lda,
+                               uint32_t         ldb,
+                               uint32_t         ldc,
+                               uint32_t         ldd,
+                               float64_t        alpha,
+                               float64_t        beta)
+{
+    // Create frags
+    auto fragA
+        = rocwmma::fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K_F64, float64_t, row_major>();
+    auto fragB
+        = rocwmma::fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K_F64, float64_t, col_major>();
+    auto fragC = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K_F64, float64_t>();
+    auto fragAcc
+        = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K_F64, float64_t>();
+
+    rocwmma::fill_fragment(fragAcc, 0.0);
+
+    // Tile using a 2D grid
+    auto majorWarp = (blockIdx.x * blockDim.x + threadIdx.x) / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    auto minorWarp = (blockIdx.y * blockDim.y + threadIdx.y);
+
+    // Target C block
+    auto cRow = majorWarp * ROCWMMA_M;
+    auto cCol = minorWarp * ROCWMMA_N;
+
+    // fragAcc = A x B
+    for(int i = 0; i < k; i += ROCWMMA_K_F64)
+    {
+        rocwmma::load_matrix_sync(fragA, a + (cRow * lda + i), lda);
+        rocwmma::load_matrix_sync(fragB, b + (i + cCol * ldb), ldb);
+        rocwmma::mma_sync(fragAcc, fragA, fragB, fragAcc);
+    }
+
+    // D = alpha * A x B + beta * C
+    rocwmma::load_matrix_sync(fragC, c + (cRow * ldc + cCol), ldc, rocwmma::mem_row_major);
+    for(int i = 0; i < fragC.num_elements; ++i)
+    {
+        fragC.x[i] = alpha * fragAcc.x[i] + beta * fragC.x[i];
+    }
+    rocwmma::store_matrix_sync(d + (cRow * ldd + cCol), fragC, ldd, rocwmma::mem_row_major);
+}
+
+// Host matrix data initialization with full fp64 mantissas
+__host__ static inline void fillRandF64(float64_t* mat, size_t size, uint32_t seed)
+{
+    auto gen  = std::mt19937_64(seed);
+    auto dist = std::uniform_real_distribution<float64_t>(-1.0, 1.0);
+    for(size_t i = 0; i < size; ++i)
+    {
+        mat[i] = dist(gen);
+    }
+}
+
+// Long double reference on every rowStride-th row.
+// Returns the max error relative to the componentwise bound |alpha| |A| |B| + |beta| |C|.
+__host__ double sampledError(uint32_t                      m,
+                             uint32_t                      n,
+                             uint32_t                      k,
+                             std::vector<float64_t> const& a,
+                             std::vector<float64_t> const& b,
+                             std::vector<float64_t> const& c,
+                             std::vector<float64_t> const& d,
+                             float64_t                     alpha,
+                             float64_t                     beta,
+                             uint32_t                      rowStride)
+{
+    double maxError = 0.0;
+
+#pragma omp parallel for reduction(max : maxError)
+    for(int i = 0; i < m; i += rowStride)
+    {
+        for(int j = 0; j < n; ++j)
+        {
+            long double accum = 0.0L, bound = 0.0L;
+            for(int h = 0; h < k; ++h)
+            {
+                auto prod = static_cast<long double>(a[i * k + h]) * b[j * k + h];
+                accum += prod;
+                bound += std::fabs(prod);
+            }
+            auto ref = alpha * accum + beta * static_cast<long double>(c[i * n + j]);
+            bound    = std::fabs(alpha) * bound + std::fabs(beta * c[i * n + j]);
+
+            auto error = std::fabs(static_cast<long double>(d[i * n + j]) - ref)
+                         / std::max(bound, std::numeric_limits<long double>::min());
+            maxError = std::max(maxError, static_cast<double>(error));
+        }
+    }
+    return maxError;
+}
+
+__host__ void dgemm_ozaki_test(uint32_t m, uint32_t n, uint32_t k, float64_t alpha, float64_t beta)
+{
+    // Bounds check
+    auto tileM = ROCWMMA_M * T_BLOCK_X / WAVE_SIZE;
+    auto tileN = ROCWMMA_N * T_BLOCK_Y;
+    if(m % tileM || n % tileN || k % ROCWMMA_K_I8 || k > (1u << 17))
+    {
+        std::cout << "Unsupported size!\n";
+        return;
+    }
+
+    // A row major, B col major, C / D row major
+    int lda = k;
+    int ldb = k;
+    int ldc = n;
+    int ldd = ldc;
+
+    std::vector<float64_t> matrixA(static_cast<size_t>(m) * k);
+    std::vector<float64_t> matrixB(static_cast<size_t>(k) * n);
+    std::vector<float64_t> matrixC(static_cast<size_t>(m) * n);
+    std::vector<float64_t> matrixD(static_cast<size_t>(m) * n);
+
+    fillRandF64(matrixA.data(), matrixA.size(), 1u);
+    fillRandF64(matrixB.data(), matrixB.size(), 2u);
+    fillRandF64(matrixC.data(), matrixC.size(), 3u);
+
+    // Allocate and copy device memory. Slices are sized for the largest slice count.
+    constexpr uint32_t MaxSlices = 8u;
+
+    float64_t* d_a;
+    float64_t* d_b;
+    float64_t* d_c;
+    float64_t* d_d;
+    int8_t*    d_aSlices;
+    int8_t*    d_bSlices;
+    int32_t*   d_aExps;
+    int32_t*   d_bExps;
+
+    const size_t bytesA = matrixA.size() * sizeof(float64_t);
+    const size_t bytesB = matrixB.size() * sizeof(float64_t);
+    const size_t bytesC = matrixC.size() * sizeof(float64_t);
+    const size_t bytesD = matrixD.size() * sizeof(float64_t);
+
+    CHECK_HIP_ERROR(hipMalloc(&d_a, bytesA));
+    CHECK_HIP_ERROR(hipMalloc(&d_b, bytesB));
+    CHECK_HIP_ERROR(hipMalloc(&d_c, bytesC));
+    CHECK_HIP_ERROR(hipMalloc(&d_d, bytesD));
+    CHECK_HIP_ERROR(hipMalloc(&d_aSlices, MaxSlices * matrixA.size()));
+    CHECK_HIP_ERROR(hipMalloc(&d_bSlices, MaxSlices * matrixB.size()));
+    CHECK_HIP_ERROR(hipMalloc(&d_aExps, m * sizeof(int32_t)));
+    CHECK_HIP_ERROR(hipMalloc(&d_bExps, n * sizeof(int32_t)));
+
+    CHECK_HIP_ERROR(hipMemcpy(d_a, matrixA.data(), bytesA, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_b, matrixB.data(), bytesB, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_c, matrixC.data(), bytesC, hipMemcpyHostToDevice));
+
+    auto blockDim = dim3(T_BLOCK_X, T_BLOCK_Y);
+    auto gridDim  = dim3(m / tileM, n / tileN);
+
+    auto nativeKernel = [&]() {
+        hipExtLaunchKernelGGL(dgemm_native_d,
+                              gridDim,
+                              blockDim,
+                              0, // sharedMemBytes
+                              0, // stream
+                              nullptr, // Event start
+                              nullptr, // event stop
+                              0, // flags
+                              m,
+                              n,
+                              k,
+                              d_a,
+                              d_b,
+                              d_c,
+                              d_d,
+                              lda,
+                              ldb,
+                              ldc,
+                              ldd,
+                              alpha,
+                              beta);
+    };
+
+    // Split of A and B, then the slice GEMMs
+    auto ozakiKernel = [&](auto slices) {
+        constexpr uint32_t Slices = decltype(slices)::value;
+        return [=]() {
+            hipLaunchKernelGGL((ozaki_split_d<Slices>),
+                               dim3(m),
+                               dim3(SPLIT_BLOCK),
+                               0, // sharedMemBytes
+                               0, // stream
+                               m,
+                               k,
+                               d_a,
+                               lda,
+                               d_aSlices,
+                               d_aExps);
+            hipLaunchKernelGGL((ozaki_split_d<Slices>),
+                               dim3(n),
+                               dim3(SPLIT_BLOCK),
+                               0, // sharedMemBytes
+                               0, // stream
+                               n,
+                               k,
+                               d_b,
+                               ldb,
+                               d_bSlices,
+                               d_bExps);
+            hipExtLaunchKernelGGL(dgemm_ozaki_d<Slices>,
+                                  gridDim,
+                                  blockDim,
+                                  0, // sharedMemBytes
+                                  0, // stream
+                                  nullptr, // Event start
+                                  nullptr, // event stop
+                                  0, // flags
+                                  m,
+                                  n,
+                                  k,
+                                  d_aSlices,
+                                  d_aExps,
+                                  d_bSlices,
+                                  d_bExps,
+                                  d_c,
+                                  d_d,
+                                  ldc,
+                                  ldd,
+                                  alpha,
+                                  beta);
+        };
+    };
+
+    // Runs are timed individually, with warm caches
+    BenchmarkHarness harness;
+
+    // Reference on up to 32 sampled rows
+    auto rowStride = std::max(m / 32u, 1u);
+
+    // Echo performance and accuracy
+    auto echo = [&](const char* kernelName, uint32_t slices, auto&& kernel) {
+        // Fill outputs with NaN to catch contamination
+        CHECK_HIP_ERROR(hipMemset(d_d, 0xFF, bytesD));
+
+        auto stats = harness.run(kernel);
+
+        CHECK_HIP_ERROR(hipMemcpy(matrixD.data(), d_d, bytesD, hipMemcpyDeviceToHost));
+        auto error = sampledError(
+            m, n, k, matrixA, matrixB, matrixC, matrixD, alpha, beta, rowStride);
+
+        std::cout << kernelName << ", " << slices << ", " << m << ", " << n << ", " << k << ", "
+                  << stats.mMedianMs << ", " << calculateTFlopsPerSec(m, n, k, stats.mMedianMs)
+                  << ", " << error << ", ";
+        BenchmarkHarness::printStats(std::cout, stats) << std::endl;
+    };
+
+    if(isF64Supported())
+    {
+        echo("Native", 0u, nativeKernel);
+    }
+
+    echo("Ozaki", 3u, ozakiKernel(std::integral_constant<uint32_t, 3u>{}));
+    echo("Ozaki", 4u, ozakiKernel(std::integral_constant<uint32_t, 4u>{}));
+    echo("Ozaki", 5u, ozakiKernel(std::integral_constant<uint32_t, 5u>{}));
+    echo("Ozaki", 6u, ozakiKernel(std::integral_constant<uint32_t, 6u>{}));
+    echo("Ozaki", 7u, ozakiKernel(std::integral_constant<uint32_t, 7u>{}));
+    echo("Ozaki", MaxSlices, ozakiKernel(std::integral_constant<uint32_t, MaxSlices>{}));
+
+    // Release device memory
+    CHECK_HIP_ERROR(hipFree(d_a));
+    CHECK_HIP_ERROR(hipFree(d_b));
+    CHECK_HIP_ERROR(hipFree(d_c));
+    CHECK_HIP_ERROR(hipFree(d_d));
+    CHECK_HIP_ERROR(hipFree(d_aSlices));
+    CHECK_HIP_ERROR(hipFree(d_bSlices));
+    CHECK_HIP_ERROR(hipFree(d_aExps));
+    CHECK_HIP_ERROR(hipFree(d_bExps));
+}
+
+int main()
+{
+    // Ozaki slices run on the int8 mma of gfx9, gfx11 and gfx12.
+    // The native fp64 baseline is skipped where fp64 mma is not supported.
+    std::cout << "Kernel, Slices, MatM, MatN, MatK, elapsedMs, TFlops/s, MaxError, "
+              << BenchmarkHarness::statsHeader() << std::endl;
+
+    for(uint32_t size : {1024u, 2048u, 4096u})
+    {
+        dgemm_ozaki_test(size, size, size, 1.0, 1.0);
+    }
+
+    std::cout << "Finished!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,862 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_runtime.h>
+
+#include <rocwmma/rocwmma.hpp>
+#include <rocwmma/rocwmma_coop.hpp>
+#include <rocwmma/rocwmma_tile.hpp>
+#include <rocwmma/rocwmma_transforms.hpp>
+
+#include "benchmark_harness.hpp"
+#include "common.hpp"
+
+/* Motivation
+*
+* Strassen-Winograd trades one of eight quadrant products for extra quadrant
+* additions. Split each operand into 2 x 2 quadrants:
+*
+*   S1 = A21 + A22          T1 = B12 - B11
+*   S2 = S1 - A11           T2 = B22 - T1
+*   S3 = A11 - A21          T3 = B22 - B12
+*   S4 = A12 - S2           T4 = T2 - B21
+*
+*   M1 = A11 B11    M2 = A12 B21    M3 = S4 B22    M4 = A22 T4
+*   M5 = S1 T1      M6 = S2 T2      M7 = S3 T3
+*
+*   D11 = M1 + M2
+*   D12 = M1 + M6 + M5 + M3
+*   D21 = M1 + M6 + M7 - M4
+*   D22 = M1 + M6 + M7 + M5
+*
+* One level costs 7/8 of the multiplies, two levels 49/64. For very large square
+* GEMMs the quadrant products are still large enough to run at full rate, so the
+* savings show up directly in the run time.
+*
+* The classic formulation materializes S, T and the partial sums of D as temporaries,
+* which costs memory and bandwidth of the same order as the multiplies saved. Here
+* every product is a rocWMMA sub-GEMM that reads its operands straight from A and B:
+*
+* - Each operand of a product is a list of (quadrant, sign) terms. Expanded, every
+*   operand is a signed sum of at most 4 quadrants per level, e.g.
+*   S4 = A11 + A12 - A21 - A22.
+*
+* - The global read stage of the sub-GEMM loads every term of the K step with the same
+*   cooperative fragment and sums them in registers before the LDS write. All terms
+*   share the fragment layout, so element i of every load is the same matrix coordinate.
+*   The rest of the pipeline is the LDS prefetch loop of perf_dgemm.
+*
+* - The result of a product is added into each output quadrant it contributes to,
+*   with its sign. The first product is M1 (M1 x M1 for two levels), which contributes
+*   to every output quadrant, so it also applies beta * C. Products run in order on one
+*   stream, so the read-modify-write of D is deterministic.
+*
+* Two levels are the tensor product of the one level tables: 49 products of operands
+* with up to 16 terms each.
+*
+* Strassen-type algorithms only satisfy a norm-wise error bound, which grows with the
+* number of levels. The benchmark reports the throughput counted in classic GEMM flops
+* (2 MNK), next to the error relative to a long double reference on sampled rows,
+* measured against |alpha| |A| |B| + |beta| |C|. Level 0 is a single product without
+* extra terms: the perf_dgemm kernel.
+*/
+
+using namespace rocwmma;
+
+///
+/// Parameter configuration
+///
+
+using DataLayoutA   = col_major;
+using DataLayoutB   = row_major;
+using DataLayoutC   = row_major;
+using DataLayoutLds = col_major;
+
+// Block sizes
+constexpr uint32_t ROCWMMA_M = 16u;
+constexpr uint32_t ROCWMMA_N = 16u;
+constexpr uint32_t ROCWMMA_K = 16u;
+
+// Warp size
+constexpr uint32_t WARP_SIZE = Constants::AMDGCN_WAVE_SIZE;
+
+// Warp tile: computed by each warp
+constexpr uint32_t BLOCKS_X    = 2u;
+constexpr uint32_t BLOCKS_Y    = 2u;
+constexpr uint32_t WARP_TILE_X = BLOCKS_X * ROCWMMA_M;
+constexpr uint32_t WARP_TILE_Y = BLOCKS_Y * ROCWMMA_N;
+
+// Macro Tile: computed by each thread block (workgroup)
+// Note: TBLOCK_X must be multiple of WARP_SIZE.
+constexpr uint32_t TBLOCK_X     = 128u;
+constexpr uint32_t TBLOCK_Y     = 2u;
+constexpr uint32_t WARPS_X      = TBLOCK_X / WARP_SIZE;
+constexpr uint32_t WARPS_Y      = TBLOCK_Y;
+constexpr uint32_t MACRO_TILE_X = WARPS_X * WARP_TILE_X;
+constexpr uint32_t MACRO_TILE_Y = WARPS_Y * WARP_TILE_Y;
+
+// Strassen-Winograd recursion
+constexpr uint32_t MAX_LEVELS = 2u;
+constexpr uint32_t MAX_TERMS  = 16u; // 4 ^ MAX_LEVELS
+
+///
+/// Fragment types
+///
+
+// Mfma frags
+template <typename DataT>
+using MfmaFragA = fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, DataT, DataLayoutA>;
+template <typename DataT>
+using MfmaFragB = fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, DataT, DataLayoutB>;
+template <typename DataT>
+using MfmaFragC = fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, DataT, DataLayoutC>;
+template <typename DataT>
+using MfmaFragAcc = fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, DataT>;
+
+// Warp tile of mfma frags
+template <typename DataT>
+using MfmaTileA = fragment_array<MfmaFragA<DataT>, BLOCKS_X, 1u>;
+template <typename DataT>
+using MfmaTileB = fragment_array<MfmaFragB<DataT>, 1u, BLOCKS_Y>;
+template <typename DataT>
+using MfmaTileC = fragment_array<MfmaFragC<DataT>, BLOCKS_X, BLOCKS_Y>;
+template <typename DataT>
+using MfmaTileAcc = fragment_array<MfmaFragAcc<DataT>, BLOCKS_X, BLOCKS_Y>;
+
+// Global read (macro tile)
+template <typename DataT>
+using GRBuffA = fragment<matrix_a, MACRO_TILE_X, ROCWMMA_N, ROCWMMA_K, DataT, DataLayoutA>;
+template <typename DataT>
+using GRBuffB = fragment<matrix_b, ROCWMMA_M, MACRO_TILE_Y, ROCWMMA_K, DataT, DataLayoutB>;
+
+// Local write of global buffers (macro tile)
+// - Must match Lds data layout.
+// - Lds has transposed B frags.
+template <typename DataT>
+using LWBuffA = ApplyDataLayout_t<GRBuffA<DataT>, DataLayoutLds>;
+template <typename DataT>
+using LWBuffB = ApplyDataLayout_t<ApplyTranspose_t<GRBuffB<DataT>>, DataLayoutLds>;
+
+// Local read (mfma frags)
+// - Must match Lds data layout.
+// - Lds has transposed B frags.
+template <typename DataT>
+using LRFragA = ApplyDataLayout_t<MfmaFragA<DataT>, DataLayoutLds>;
+template <typename DataT>
+using LRFragB = ApplyDataLayout_t<ApplyTranspose_t<MfmaFragB<DataT>>, DataLayoutLds>;
+
+///
+/// Product description
+///
+
+// Signed quadrant terms of one operand, or the output quadrants of one product.
+// Offsets are in elements from the matrix base, at the quadrant size of the recursion level.
+struct StrassenTerms
+{
+    uint32_t count;
+    int32_t  signs[MAX_TERMS];
+    uint64_t offsets[MAX_TERMS];
+};
+
+// D(d terms) += alpha * sum(A terms) x sum(B terms)
+struct StrassenProduct
+{
+    StrassenTerms a;
+    StrassenTerms b;
+    StrassenTerms d;
+};
+
+///
+/// Wrapper functions: repeat mfma tile operations across entire warp tile.
+///
+
+// Fused global read in cooperative mode (macro tile)
+// Loads every term of the operand at the current K step and sums them in registers,
+// so that the quadrant sums of the operand are never written to memory.
+template <uint32_t WaveCount, typename GRBuffT, typename DataT>
+ROCWMMA_DEVICE static inline void globalReadFusedCoop(GRBuffT&             grBuff,
+                                                      DataT const*         gAddr,
+                                                      StrassenTerms const& terms,
+                                                      uint32_t             ld,
+                                                      uint32_t             waveIndex)
+{
+    load_matrix_coop_sync<WaveCount>(grBuff, gAddr + terms.offsets[0], ld, waveIndex);
+    if(terms.signs[0] < 0)
+    {
+        for(int i = 0; i < grBuff.num_elements; i++)
+        {
+            grBuff.x[i] = -grBuff.x[i];
+        }
+    }
+
+    for(uint32_t t = 1u; t < terms.count; t++)
+    {
+        GRBuffT tmp;
+        load_matrix_coop_sync<WaveCount>(tmp, gAddr + terms.offsets[t], ld, waveIndex);
+
+        auto sign = static_cast<DataT>(terms.signs[t]);
+        for(int i = 0; i < grBuff.num_elements; i++)
+        {
+            grBuff.x[i] += sign * tmp.x[i];
+        }
+    }
+}
+
+// Local A writes in cooperative mode (macro tile)
+template <uint32_t WaveCountA, typename DataT>
+ROCWMMA_DEVICE static inline void localWriteCoopA(DataT*                ldsAddr,
+                                                  GRBuffA<DataT> const& grBuffA,
+                                                  uint32_t              ldsld,
+                                                  uint32_t              waveIndexA)
+{
+    // No transpose, but apply the lds data layout
+    store_matrix_coop_sync<WaveCountA>(
+        ldsAddr, applyDataLayout<DataLayoutLds, WaveCountA>(grBuffA), ldsld, waveIndexA);
+}
+
+// Local B writes in cooperative mode (macro tile)
+template <uint32_t WaveCountB, typename DataT>
+ROCWMMA_DEVICE static inline void localWriteCoopB(DataT*                ldsAddr,
+                                                  GRBuffB<DataT> const& grBuffB,
+                                                  uint32_t              ldsld,
+                                                  uint32_t              waveIndexB)
+{
+    // Transpose B and then apply lds data layout
+    auto lwBuffB = applyDataLayout<DataLayoutLds, WaveCountB>(applyTranspose(grBuffB));
+    store_matrix_coop_sync<WaveCountB>(ldsAddr, lwBuffB, ldsld, waveIndexB);
+}
+
+// Local A reads for warp tile gemm, non-cooperative
+template <typename DataT>
+ROCWMMA_DEVICE static inline void
+    localReadA(MfmaTileA<DataT>& fragsA, DataT const* ldsAddrA, uint32_t ldsld)
+{
+    using FragShape = GetIOShape_t<LRFragA<DataT>>;
+    using Mapper1d  = GetDataLayout_t<LRFragA<DataT>>;
+
+    // Each A block is stacked vertically in LDS
+    auto blockStep = Mapper1d::fromMatrixCoord(make_coord2d(FragShape::BlockHeight, 0u), ldsld);
+
+#pragma unroll
+    for(int i = 0; i < BLOCKS_X; i++)
+    {
+        LRFragA<DataT> tmp;
+        load_matrix_sync(tmp, ldsAddrA, ldsld);
+        fragsA(i, 0u) = applyDataLayout<DataLayoutA>(tmp);
+
+        ldsAddrA += blockStep;
+    }
+}
+
+// Local B reads for warp tile gemm, non-cooperative
+template <typename DataT>
+ROCWMMA_DEVICE static inline void
+    localReadB(MfmaTileB<DataT>& fragsB, DataT const* ldsAddrB, uint32_t ldsld)
+{
+    using FragShape = GetIOShape_t<LRFragB<DataT>>;
+    using Mapper1d  = GetDataLayout_t<LRFragB<DataT>>;
+
+    // Each B block is stacked vertically in LDS
+    auto blockStep = Mapper1d::fromMatrixCoord(make_coord2d(FragShape::BlockHeight, 0u), ldsld);
+
+#pragma unroll
+    for(int i = 0; i < BLOCKS_Y; i++)
+    {
+        LRFragB<DataT> tmp;
+        load_matrix_sync(tmp, ldsAddrB, ldsld);
+
+        // Transform back to MFMA tile
+        fragsB(0u, i) = applyDataLayout<DataLayoutB>(applyTranspose(tmp));
+
+        ldsAddrB += blockStep;
+    }
+}
+
+// Uniform multiply - add (FMA)
+// Performs D = alpha * acc + beta * C, where alpha, beta are uniform scalars
+template <typename DataT>
+ROCWMMA_DEVICE static inline void uniformFma(MfmaTileC<DataT>&         fragsD,
+                                             DataT                     alpha,
+                                             MfmaTileAcc<DataT> const& fragsAcc,
+                                             DataT                     beta,
+                                             MfmaTileC<DataT> const&   fragsC)
+{
+#pragma unroll
+    for(int i = 0; i < BLOCKS_X; i++)
+    {
+#pragma unroll
+        for(int j = 0; j < BLOCKS_Y; j++)
+        {
+            for(int k = 0; k < fragsD(i, j).num_elements; k++)
+            {
+                fragsD(i, j).x[k] = alpha * fragsAcc(i, j).x[k] + beta * fragsC(i, j).x[k];
+            }
+        }
+    }
+}
+
+// One Strassen-Winograd product: an m x n x k sub-GEMM over quadrant sums of A and B,
+// added into the output quadrants of D with their signs.
+// The first product passes c = C and the user beta; later products pass c = D, beta = 1.
+// C and D must share the layout and leading dimension: output offsets are computed for D.
+template <typename DataT>
+ROCWMMA_KERNEL void __launch_bounds__(256) strassen_gemm_d(uint32_t        m,
+                                                           uint32_t        n,
+                                                           uint32_t        k,
+                                                           DataT const*    a,
+                                                           DataT const*    b,
+                                                           DataT const*    c,
+                                                           DataT*          d,
+                                                           uint32_t        lda,
+                                                           uint32_t        ldb,
+                                                           uint32_t        ldc,
+                                                           uint32_t        ldd,
+                                                           DataT           alpha,
+                                                           DataT           beta,
+                                                           StrassenProduct product)
+{
+    ///
+    /// 2D matrix coordinate setup
+    ///
+
+    // Tile Sizes
+    constexpr auto warpTileSize  = make_coord2d(WARP_TILE_X, WARP_TILE_Y);
+    constexpr auto macroTileSize = make_coord2d(MACRO_TILE_X, MACRO_TILE_Y);
+
+    // Local warp coordinate relative to current threadblock (wg).
+    constexpr auto warpDims        = make_coord2d(WARPS_X, WARPS_Y);
+    auto           localWarpCoord  = make_coord2d(threadIdx.x / WARP_SIZE, threadIdx.y);
+    auto           localWarpOffset = localWarpCoord * warpTileSize;
+
+    // Sub-GEMM matrix coordinates for C/D, relative to each output quadrant
+    auto macroTileCoord = make_coord2d(blockIdx.x, blockIdx.y) * macroTileSize;
+    auto warpTileCoord  = macroTileCoord + localWarpOffset;
+
+    // Bounds check
+    auto warpTileBound = warpTileCoord + warpTileSize;
+    if(get<0>(warpTileBound) > m || get<1>(warpTileBound) > n)
+    {
+        return;
+    }
+
+    ///
+    /// 1D global read coordinate setup
+    ///
+    using GRBuffAMap1d = GetDataLayout_t<GRBuffA<DataT>>;
+    using GRBuffBMap1d = GetDataLayout_t<GRBuffB<DataT>>;
+
+    // Initial global read address offsets, relative to each operand quadrant
+    auto globalReadOffsetA
+        = GRBuffAMap1d::fromMatrixCoord(make_coord2d(get<0>(macroTileCoord), 0u), lda);
+    auto globalReadOffsetB
+        = GRBuffBMap1d::fromMatrixCoord(make_coord2d(0u, get<1>(macroTileCoord)), ldb);
+
+    // Incremental global read address offsets
+    auto kStepOffsetA = GRBuffAMap1d::fromMatrixCoord(make_coord2d(0u, ROCWMMA_K), lda);
+    auto kStepOffsetB = GRBuffBMap1d::fromMatrixCoord(make_coord2d(ROCWMMA_K, 0u), ldb);
+
+    ///
+    /// Cooperative config for global read A / B
+    ///
+    constexpr auto warpCount = get<0>(warpDims) * get<1>(warpDims);
+    const auto warpIndex = get<0>(localWarpCoord) * get<1>(warpDims) + get<1>(localWarpCoord);
+
+    ///
+    /// Perform initial global pre-fetch
+    ///
+
+    GRBuffA<DataT> grBuffA;
+    GRBuffB<DataT> grBuffB;
+
+    globalReadFusedCoop<warpCount>(grBuffA, a + globalReadOffsetA, product.a, lda, warpIndex);
+    globalReadFusedCoop<warpCount>(grBuffB, b + globalReadOffsetB, product.b, ldb, warpIndex);
+
+    globalReadOffsetA += kStepOffsetA;
+    globalReadOffsetB += kStepOffsetB;
+
+    ///
+    /// Setup LDS addressing
+    /// This kernel will use 2 separate LDS blocks for pipelining
+    /// the input prefetching during the accumulation loop
+    ///
+
+    HIP_DYNAMIC_SHARED(void*, localMemPtr);
+    using LWBuffAShape = GetIOShape_t<LWBuffA<DataT>>;
+    using LWBuffBShape = GetIOShape_t<LWBuffB<DataT>>;
+    using LWBuffAMap1d = GetDataLayout_t<LWBuffA<DataT>>;
+    using LWBuffBMap1d = GetDataLayout_t<LWBuffB<DataT>>;
+
+    constexpr uint32_t ldsWidth  = ROCWMMA_K;
+    constexpr uint32_t ldsHeight = LWBuffAShape::BlockHeight + LWBuffBShape::BlockHeight;
+    constexpr uint32_t sizeLds   = ldsHeight * ldsWidth;
+    constexpr uint32_t ldsld     = std::is_same_v<DataLayoutLds, row_major> ? ldsWidth : ldsHeight;
+
+    auto* ldsPtrLo = reinterpret_cast<DataT*>(localMemPtr);
+    auto* ldsPtrHi = ldsPtrLo + sizeLds;
+
+    // Local write offsets to start of A / B data
+    auto ldsWriteOffsetA = 0u;
+    auto ldsWriteOffsetB
+        = LWBuffAMap1d::fromMatrixCoord(make_coord2d(LWBuffAShape::BlockHeight, 0u), ldsld);
+
+    // Local read offsets for mfma frags
+    auto ldsReadOffsetA
+        = ldsWriteOffsetA
+          + LWBuffAMap1d::fromMatrixCoord(make_coord2d(get<0>(localWarpOffset), 0u), ldsld);
+    auto ldsReadOffsetB
+        = ldsWriteOffsetB
+          + LWBuffBMap1d::fromMatrixCoord(make_coord2d(get<1>(localWarpOffset), 0u), ldsld);
+
+    ///
+    /// Write prefetch to local
+    ///
+    localWriteCoopA<warpCount>(ldsPtrLo + ldsWriteOffsetA, grBuffA, ldsld, warpIndex);
+    localWriteCoopB<warpCount>(ldsPtrLo + ldsWriteOffsetB, grBuffB, ldsld, warpIndex);
+
+    ///
+    /// Initialize accumulation frags
+    ///
+    MfmaTileAcc<DataT> fragsAcc;
+    fill_fragment(fragsAcc, static_cast<DataT>(0));
+
+    ///
+    /// Synchronize warps and memory
+    ///
+    synchronize_workgroup();
+
+    ///
+    /// Accumulate A * B for all mfma frags in warp tile
+    ///
+    for(auto currentK = ROCWMMA_K; currentK < k; currentK += ROCWMMA_K)
+    {
+        MfmaTileA<DataT> fragsA;
+        MfmaTileB<DataT> fragsB;
+
+        // Local read mfma frags from first LDS buffer
+        localReadA(fragsA, ldsPtrLo + ldsReadOffsetA, ldsld);
+        localReadB(fragsB, ldsPtrLo + ldsReadOffsetB, ldsld);
+
+        // Prefetch next round of fused global frags
+        globalReadFusedCoop<warpCount>(
+            grBuffA, a + globalReadOffsetA, product.a, lda, warpIndex);
+        globalReadFusedCoop<warpCount>(
+            grBuffB, b + globalReadOffsetB, product.b, ldb, warpIndex);
+
+        // Advance offsets to next k step
+        globalReadOffsetA += kStepOffsetA;
+        globalReadOffsetB += kStepOffsetB;
+
+        // accum(A * B)
+        mma_sync(fragsAcc, fragsA, fragsB, fragsAcc);
+
+        // Write prefetch to second LDS buffer
+        localWriteCoopA<warpCount>(ldsPtrHi + ldsWriteOffsetA, grBuffA, ldsld, warpIndex);
+        localWriteCoopB<warpCount>(ldsPtrHi + ldsWriteOffsetB, grBuffB, ldsld, warpIndex);
+
+        // Make sure that all waves have finished reading / writing to lds for currentK.
+        synchronize_workgroup();
+
+        // Swap Lds buffers
+        auto* tmp = ldsPtrLo;
+        ldsPtrLo  = ldsPtrHi;
+        ldsPtrHi  = tmp;
+    }
+
+    ///
+    /// Clean up tail A * B
+    ///
+    MfmaTileA<DataT> fragsA;
+    MfmaTileB<DataT> fragsB;
+
+    // Local read mfma frags
+    localReadA(fragsA, ldsPtrLo + ldsReadOffsetA, ldsld);
+    localReadB(fragsB, ldsPtrLo + ldsReadOffsetB, ldsld);
+    mma_sync(fragsAcc, fragsA, fragsB, fragsAcc);
+
+    ///
+    /// D(quadrant) = sign * alpha * accum + beta * C(quadrant), for each output quadrant
+    ///
+    using MfmaFragCMap1d = GetDataLayout_t<MfmaFragC<DataT>>;
+
+    auto warpOffsetC = MfmaFragCMap1d::fromMatrixCoord(warpTileCoord, ldc);
+    auto warpOffsetD = MfmaFragCMap1d::fromMatrixCoord(warpTileCoord, ldd);
+
+    for(uint32_t t = 0u; t < product.d.count; t++)
+    {
+        MfmaTileC<DataT> fragsC;
+        load_matrix_sync(fragsC, c + product.d.offsets[t] + warpOffsetC, ldc);
+
+        MfmaTileC<DataT> fragsD;
+        uniformFma(fragsD, static_cast<DataT>(product.d.signs[t]) * alpha, fragsAcc, beta, fragsC);
+        store_matrix_sync(d + product.d.offsets[t] + warpOffsetD, fragsD, ldd);
+    }
+}
+
+///
+/// Host product tables
+///
+
+// Signed quadrant (row, col) at the quadrant size of the recursion level
+struct QuadrantTerm
+{
+    uint32_t row;
+    uint32_t col;
+    int32_t  sign;
+};
+
+struct ProductTable
+{
+    std::vector<QuadrantTerm> a;
+    std::vector<QuadrantTerm> b;
+    std::vector<QuadrantTerm> d;
+};
+
+// One level of Strassen-Winograd, with S, T and the D updates expanded to quadrants.
+// M1 comes first and contributes to every output quadrant.
+ROCWMMA_HOST std::vector<ProductTable> winogradLevel()
+{
+    return {
+        // M1 = A11 B11
+        {{{0, 0, 1}}, {{0, 0, 1}}, {{0, 0, 1}, {0, 1, 1}, {1, 0, 1}, {1, 1, 1}}},
+        // M2 = A12 B21
+        {{{0, 1, 1}}, {{1, 0, 1}}, {{0, 0, 1}}},
+        // M3 = S4 B22
+        {{{0, 0, 1}, {0, 1, 1}, {1, 0, -1}, {1, 1, -1}}, {{1, 1, 1}}, {{0, 1, 1}}},
+        // M4 = A22 T4
+        {{{1, 1, 1}}, {{0, 0, 1}, {0, 1, -1}, {1, 0, -1}, {1, 1, 1}}, {{1, 0, -1}}},
+        // M5 = S1 T1
+        {{{1, 0, 1}, {1, 1, 1}}, {{0, 0, -1}, {0, 1, 1}}, {{0, 1, 1}, {1, 1, 1}}},
+        // M6 = S2 T2
+        {{{0, 0, -1}, {1, 0, 1}, {1, 1, 1}},
+         {{0, 0, 1}, {0, 1, -1}, {1, 1, 1}},
+         {{0, 1, 1}, {1, 0, 1}, {1, 1, 1}}},
+        // M7 = S3 T3
+        {{{0, 0, 1}, {1, 0, -1}}, {{0, 1, -1}, {1, 1, 1}}, {{1, 0, 1}, {1, 1, 1}}},
+    };
+}
+
+// Recursion of the level table: quadrants of quadrants, with the signs multiplied.
+ROCWMMA_HOST std::vector<ProductTable> winogradProducts(uint32_t levels)
+{
+    auto combine = [](std::vector<QuadrantTerm> const& outer,
+                      std::vector<QuadrantTerm> const& inner) {
+        std::vector<QuadrantTerm> result;
+        for(auto const& o : outer)
+        {
+            for(auto const& i : inner)
+            {
+                result.push_back({o.row * 2u + i.row, o.col * 2u + i.col, o.sign * i.sign});
+            }
+        }
+        return result;
+    };
+
+    // Level 0: the plain GEMM
+    std::vector<ProductTable> products = {{{{0, 0, 1}}, {{0, 0, 1}}, {{0, 0, 1}}}};
+
+    for(uint32_t l = 0u; l < levels; l++)
+    {
+        std::vector<ProductTable> next;
+        for(auto const& outer : products)
+        {
+            for(auto const& inner : winogradLevel())
+            {
+                next.push_back({combine(outer.a, inner.a),
+                                combine(outer.b, inner.b),
+                                combine(outer.d, inner.d)});
+            }
+        }
+        products = std::move(next);
+    }
+    return products;
+}
+
+template <typename DataLayoutT>
+ROCWMMA_HOST uint64_t quadrantOffset(QuadrantTerm const& term,
+                                     uint32_t            quadrantRows,
+                                     uint32_t            quadrantCols,
+                                     uint32_t            ld)
+{
+    uint64_t row = static_cast<uint64_t>(term.row) * quadrantRows;
+    uint64_t col = static_cast<uint64_t>(term.col) * quadrantCols;
+    return std::is_same_v<DataLayoutT, row_major> ? row * ld + col : col * ld + row;
+}
+
+template <typename DataLayoutT>
+ROCWMMA_HOST StrassenTerms toStrassenTerms(std::vector<QuadrantTerm> const& terms,
+                                           uint32_t                         quadrantRows,
+                                           uint32_t                         quadrantCols,
+                                           uint32_t                         ld)
+{
+    StrassenTerms result = {};
+    result.count         = static_cast<uint32_t>(terms.size());
+    for(uint32_t t = 0u; t < result.count; t++)
+    {
+        result.signs[t] = terms[t].sign;
+        result.offsets[t]
+            = quadrantOffset<DataLayoutT>(terms[t], quadrantRows, quadrantCols, ld);
+    }
+    return result;
+}
+
+// Host matrix data initialization with full mantissas
+template <typename DataT>
+__host__ static inline void fillRandUniform(DataT* mat, size_t size, uint32_t seed)
+{
+    auto gen  = std::mt19937_64(seed);
+    auto dist = std::uniform_real_distribution<DataT>(-1.0, 1.0);
+    for(size_t i = 0; i < size; ++i)
+    {
+        mat[i] = dist(gen);
+    }
+}
+
+// Long double reference on every rowStride-th row.
+// Returns the max error relative to the componentwise bound |alpha| |A| |B| + |beta| |C|.
+template <typename DataT>
+__host__ double sampledError(uint32_t                  m,
+                             uint32_t                  n,
+                             uint32_t                  k,
+                             std::vector<DataT> const& a,
+                             std::vector<DataT> const& b,
+                             std::vector<DataT> const& c,
+                             std::vector<DataT> const& d,
+                             uint32_t                  lda,
+                             uint32_t                  ldb,
+                             uint32_t                  ldc,
+                             uint32_t                  ldd,
+                             DataT                     alpha,
+                             DataT                     beta,
+                             uint32_t                  rowStride)
+{
+    double maxError = 0.0;
+
+#pragma omp parallel for reduction(max : maxError)
+    for(int i = 0; i < m; i += rowStride)
+    {
+        for(int j = 0; j < n; ++j)
+        {
+            // A col major, B row major, C / D row major
+            long double accum = 0.0L, bound = 0.0L;
+            for(int h = 0; h < k; ++h)
+            {
+                auto prod = static_cast<long double>(a[i + static_cast<size_t>(h) * lda])
+                            * b[static_cast<size_t>(h) * ldb + j];
+                accum += prod;
+                bound += std::fabs(prod);
+            }
+            auto cij   = static_cast<long double>(c[static_cast<size_t>(i) * ldc + j]);
+            auto ref   = alpha * accum + beta * cij;
+            bound      = std::fabs(alpha) * bound + std::fabs(beta * cij);
+            auto error = std::fabs(d[static_cast<size_t>(i) * ldd + j] - ref)
+                         / std::max(bound, std::numeric_limits<long double>::min());
+            maxError = std::max(maxError, static_cast<double>(error));
+        }
+    }
+    return maxError;
+}
+
+template <typename DataT>
+ROCWMMA_HOST void strassen_test(uint32_t m, uint32_t n, uint32_t k, DataT alpha, DataT beta)
+{
+    // Runtime warp calculation (host code needs to query warpsize dynamically)
+    auto warpSize = getWarpSize();
+    auto macroTileSize
+        = rocwmma::make_coord2d(TBLOCK_X / warpSize * WARP_TILE_X, TBLOCK_Y * WARP_TILE_Y);
+
+    // Device check for supported block and wave sizes
+    if(!isGfx9() || WARP_SIZE != Constants::AMDGCN_WAVE_SIZE_64)
+    {
+        std::cout << "Unsupported architecture!\n";
+        return;
+    }
+
+    // Bounds check: the quadrants of the deepest level must be whole macro tiles
+    constexpr uint32_t maxSplit = 1u << MAX_LEVELS;
+    if((m % (maxSplit * get<0>(macroTileSize))) || (n % (maxSplit * get<1>(macroTileSize)))
+       || (k % (maxSplit * ROCWMMA_K)))
+    {
+        std::cout << "Unsupported matrix size!\n";
+        return;
+    }
+
+    // Layouts leading dims
+    uint32_t lda = std::is_same_v<DataLayoutA, row_major> ? k : m;
+    uint32_t ldb = std::is_same_v<DataLayoutB, row_major> ? n : k;
+    uint32_t ldc = std::is_same_v<DataLayoutC, row_major> ? n : m;
+    uint32_t ldd = ldc;
+
+    // Initialize input matrices
+    std::vector<DataT> matrixA(static_cast<size_t>(m) * k);
+    std::vector<DataT> matrixB(static_cast<size_t>(k) * n);
+    std::vector<DataT> matrixC(static_cast<size_t>(m) * n);
+    std::vector<DataT> matrixD(static_cast<size_t>(m) * n);
+
+    fillRandUniform(matrixA.data(), matrixA.size(), 1u);
+    fillRandUniform(matrixB.data(), matrixB.size(), 2u);
+    fillRandUniform(matrixC.data(), matrixC.size(), 3u);
+
+    // Allocate and copy device memory
+    DataT* d_a;
+    DataT* d_b;
+    DataT* d_c;
+    DataT* d_d;
+
+    const size_t bytesA = matrixA.size() * sizeof(DataT);
+    const size_t bytesB = matrixB.size() * sizeof(DataT);
+    const size_t bytesC = matrixC.size() * sizeof(DataT);
+    const size_t bytesD = matrixD.size() * sizeof(DataT);
+
+    CHECK_HIP_ERROR(hipMalloc(&d_a, bytesA));
+    CHECK_HIP_ERROR(hipMalloc(&d_b, bytesB));
+    CHECK_HIP_ERROR(hipMalloc(&d_c, bytesC));
+    CHECK_HIP_ERROR(hipMalloc(&d_d, bytesD));
+
+    CHECK_HIP_ERROR(hipMemcpy(d_a, matrixA.data(), bytesA, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_b, matrixB.data(), bytesB, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_c, matrixC.data(), bytesC, hipMemcpyHostToDevice));
+
+    // Uses 2 lds blocks for prefetch loop (A and B)
+    int ldsusage = 2u * sizeof(DataT) * (get<0>(macroTileSize) + get<1>(macroTileSize)) * ROCWMMA_K;
+
+    // Runs are timed individually, with warm caches
+    BenchmarkHarness harness;
+
+    // Reference on up to 8 sampled rows
+    auto rowStride = std::max(m / 8u, 1u);
+
+    for(uint32_t levels = 0u; levels <= MAX_LEVELS; levels++)
+    {
+        // Sub-GEMM size of each product
+        uint32_t subM = m >> levels;
+        uint32_t subN = n >> levels;
+        uint32_t subK = k >> levels;
+
+        std::vector<StrassenProduct> products;
+        for(auto const& table : winogradProducts(levels))
+        {
+            products.push_back({toStrassenTerms<DataLayoutA>(table.a, subM, subK, lda),
+                                toStrassenTerms<DataLayoutB>(table.b, subK, subN, ldb),
+                                toStrassenTerms<DataLayoutC>(table.d, subM, subN, ldd)});
+        }
+
+        auto blockDim = dim3(TBLOCK_X, TBLOCK_Y);
+        auto gridDim  = dim3(subM / get<0>(macroTileSize), subN / get<1>(macroTileSize));
+
+        auto strassenKernel = [&]() {
+            for(uint32_t p = 0u; p < products.size(); p++)
+            {
+                // The first product applies beta * C, the rest accumulate into D
+                bool first = (p == 0u);
+                hipExtLaunchKernelGGL(strassen_gemm_d<DataT>,
+                                      gridDim,
+                                      blockDim,
+                                      ldsusage,
+                                      0, // stream
+                                      nullptr, // Event start
+                                      nullptr, // event stop
+                                      0, // flags
+                                      subM,
+                                      subN,
+                                      subK,
+                                      d_a,
+                                      d_b,
+                                      first ? d_c : d_d,
+                                      d_d,
+                                      lda,
+                                      ldb,
+                                      first ? ldc : ldd,
+                                      ldd,
+                                      alpha,
+                                      first ? beta : static_cast<DataT>(1),
+                                      products[p]);
+            }
+        };
+
+        // Fill outputs with NaN to catch contamination
+        CHECK_HIP_ERROR(hipMemset(d_d, 0xFF, bytesD));
+
+        auto stats = harness.run(strassenKernel);
+
+        CHECK_HIP_ERROR(hipMemcpy(matrixD.data(), d_d, bytesD, hipMemcpyDeviceToHost));
+        auto error = sampledError(m,
+                                  n,
+                                  k,
+                                  matrixA,
+                                  matrixB,
+                                  matrixC,
+                                  matrixD,
+                                  lda,
+                                  ldb,
+                                  ldc,
+                                  ldd,
+                                  alpha,
+                                  beta,
+                                  rowStride);
+
+        std::cout << dataTypeToString<DataT>() << ", " << levels << ", " << products.size()
+                  << ", " << m << ", " << n << ", " << k << ", " << stats.mMedianMs << ", "
+                  << calculateTFlopsPerSec(m, n, k, stats.mMedianMs) << ", " << error << ", ";
+        BenchmarkHarness::printStats(std::cout, stats) << std::endl;
+    }
+
+    // Release device memory
+    CHECK_HIP_ERROR(hipFree(d_a));
+    CHECK_HIP_ERROR(hipFree(d_b));
+    CHECK_HIP_ERROR(hipFree(d_c));
+    CHECK_HIP_ERROR(hipFree(d_d));
+}
+
+int main()
+{
+    // Effective TFlops/s count 2 MNK flops for every level, so that levels compare directly.
+    // Level 0 is the plain GEMM.
+    std::cout << "DataT, Levels, Products, MatM, MatN, MatK, elapsedMs, TFlops/s, MaxError, "
+              << BenchmarkHarness::statsHeader() << std::endl;
+
+    for(uint32_t size : {8192u, 16384u})
+    {
+        if(isF64Supported())
+        {
+            strassen_test<float64_t>(size, size, size, 1.0, 1.0);
+        }
+
+        if(isF32Supported())
+        {
+            strassen_test<float32_t>(size, size, size, 1.0f, 1.0f);
+        }
+    }
+
+    std::cout << "Finished!" << std::endl;
+    return 0;
+}
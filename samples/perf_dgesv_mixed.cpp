@@ -0,0 +1,858 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_runtime.h>
+
+#include <rocwmma/rocwmma.hpp>
+
+#include "benchmark_harness.hpp"
+#include "common.hpp"
+
+using rocwmma::accumulator;
+using rocwmma::bfloat16_t;
+using rocwmma::col_major;
+using rocwmma::float16_t;
+using rocwmma::float32_t;
+using rocwmma::float64_t;
+using rocwmma::matrix_a;
+using rocwmma::matrix_b;
+
+/* Motivation
+*
+* A dense solve A x = b in fp64 spends O(n^3) of its work in the LU factorization,
+* and only O(n^2) in the triangular solves. The factorization can instead run in
+* a lower precision with a much higher MMA throughput, and the solution recovered
+* to full fp64 accuracy by iterative refinement:
+*
+*     A = L x U                      (low precision factorization)
+*     x = 0
+*     repeat:
+*         r = b - A x               (fp64 residual)
+*         x = x + U^-1 x L^-1 x r   (correction, with the low precision factors)
+*
+* Refinement converges for matrices whose condition number is well below the
+* inverse of the factorization precision, each iteration costing O(n^2).
+*
+* This sample factors a column major n x n matrix by a blocked right-looking LU
+* over NB wide panels. For each panel k:
+*
+* 1. The NB x NB diagonal block is factored by a single workgroup in LDS.
+* 2. The L panel below and the U panel right of the diagonal block are solved
+*    against it by substitution, a thread per row or column. Both panels are
+*    written out in the compute precision, L negated.
+* 3. The trailing matrix receives the rank NB update with mma_sync:
+*
+*        A(i, j) += (-L(i, k)) x U(k, j)
+*
+*    reading the compute precision panels and accumulating into the factors.
+*
+* Step 3 holds O(n^3) of the work. The compute precisions are:
+*
+* - f64:    fp64 panels and factors, the fp64 baseline (no refinement needed).
+* - f32:    fp32 panels and factors (gfx9).
+* - bf16x3: fp32 factors, fp32 panels split into hi + lo bfloat16_t parts for
+*           three bfloat16_t MMAs each, emulating fp32 without fast fp32 MMA.
+* - f16 / bf16: half precision panels, fp32 factors and accumulation.
+*
+* The residual and the solution stay in fp64. The corrections are solved with
+* the factors in the factor precision, by a workgroup per block of TRSV_NB rows:
+* each block applies the products of the blocks it depends on as their
+* workgroups raise a flag, then the inverse of its diagonal block, which is
+* computed once after the factorization. The substitution has no grid wide
+* barrier, nor a kernel launch per block.
+*
+* Refinement stops once the normwise backward error
+*
+*     |b - A x| / (|A| x |x|)  <=  sqrt(n) x eps(fp64)
+*
+* in the infinity norm, as the LAPACK dsgesv mixed precision solver. The check
+* reads the residual back to the host, and is part of the timed solve.
+*
+* Note: n must be a multiple of NB and of TRSV_NB x RESIDUAL_SPLITS. The
+* triangular solves rely on workgroups being dispatched in order, such that
+* the blocks each one waits on make progress.
+* Note: The factorization does not pivot. It is
+* stable for diagonally dominant matrices such as the inputs of this sample,
+* but not in general.
+*/
+
+// Fragment block size
+const int ROCWMMA_M = 16;
+const int ROCWMMA_N = 16;
+const int ROCWMMA_K = 16;
+
+// Panel width of the factorization, and tile of a workgroup in the trailing update
+// : NB must be a multiple of 2 x ROCWMMA_M / N and of ROCWMMA_K.
+const int NB = 64;
+
+// Trailing update: 2 x 2 waves per workgroup, each computing a 2 x 2 grid of blocks
+const int WAVES_X = 2;
+const int WAVES_Y = 2;
+const int BLOCKS  = 2;
+
+// Threads of the diagonal block, panel and residual kernels
+const int T_BLOCK = 256;
+
+// Column slices of the residual, each summed by a separate workgroup
+const int RESIDUAL_SPLITS = 16;
+
+// Rows per workgroup of the triangular solves, and their threads
+// : T_TRSV must be a multiple of TRSV_NB, and TRSV_NB of T_TRSV / TRSV_NB.
+const int TRSV_NB = 32;
+const int T_TRSV  = 256;
+
+// Refinement iteration limit
+const int ITER_MAX = 30;
+
+// Device warp size
+const uint32_t WAVE_SIZE = getWarpSize();
+
+// Factors and trailing matrix precision of each compute precision
+template <typename ComputeT>
+using FactorType
+    = std::conditional_t<std::is_same<ComputeT, float64_t>::value, float64_t, float32_t>;
+
+// Panel precision, in which the trailing update reads L and U
+template <typename ComputeT, bool Split>
+using PanelType = std::conditional_t<Split, float32_t, ComputeT>;
+
+template <typename ComputeT, bool Split>
+inline char const* computeString()
+{
+    return Split ? "bf16x3" : rocwmma::dataTypeToString<ComputeT>();
+}
+
+// Converts the fp64 matrix to the factor precision
+template <typename FactorT>
+__global__ void convert_d(uint32_t n, float64_t const* a, FactorT* w)
+{
+    auto count = static_cast<uint64_t>(n) * n;
+    for(auto i = static_cast<uint64_t>(blockIdx.x) * blockDim.x + threadIdx.x; i < count;
+        i += static_cast<uint64_t>(gridDim.x) * blockDim.x)
+    {
+        w[i] = static_cast<FactorT>(a[i]);
+    }
+}
+
+// Unblocked LU without pivoting of the NB x NB diagonal block at (k0, k0), in LDS.
+// The strict lower triangle receives L, the upper triangle U.
+template <typename FactorT>
+__global__ void lu_diag_d(uint32_t n, uint32_t k0, FactorT* w)
+{
+    __shared__ FactorT lds[NB * NB];
+
+    auto diag = w + static_cast<uint64_t>(k0) * n + k0;
+    for(uint32_t i = threadIdx.x; i < NB * NB; i += blockDim.x)
+    {
+        lds[i] = diag[static_cast<uint64_t>(i / NB) * n + i % NB];
+    }
+    __syncthreads();
+
+    for(uint32_t k = 0; k < NB; k++)
+    {
+        auto pivot = lds[k * NB + k];
+        for(uint32_t i = k + 1u + threadIdx.x; i < NB; i += blockDim.x)
+        {
+            lds[k * NB + i] /= pivot;
+        }
+        __syncthreads();
+
+        // Rank 1 update of the trailing block
+        auto trailing = NB - k - 1u;
+        for(uint32_t idx = threadIdx.x; idx < trailing * trailing; idx += blockDim.x)
+        {
+            auto i = k + 1u + idx % trailing;
+            auto j = k + 1u + idx / trailing;
+            lds[j * NB + i] -= lds[k * NB + i] * lds[j * NB + k];
+        }
+        __syncthreads();
+    }
+
+    for(uint32_t i = threadIdx.x; i < NB * NB; i += blockDim.x)
+    {
+        diag[static_cast<uint64_t>(i / NB) * n + i % NB] = lds[i];
+    }
+}
+
+// Panels of the factored diagonal block at (k0, k0), for the rows and columns past it:
+// blockIdx.y = 0: L(i, k) = A(i, k) x U(k, k)^-1, a thread per row i.
+// blockIdx.y = 1: U(k, j) = L(k, k)^-1 x A(k, j), a thread per column j.
+// The factors are updated in place. The compute precision panels receive -L in lp
+// (n x NB, ld n) and U in up (NB x n, ld NB), both column major.
+template <typename FactorT, typename PanelT>
+__global__ void lu_panel_d(uint32_t n, uint32_t k0, FactorT* w, PanelT* lp, PanelT* up)
+{
+    __shared__ FactorT lds[NB * NB];
+
+    auto diag = w + static_cast<uint64_t>(k0) * n + k0;
+    for(uint32_t i = threadIdx.x; i < NB * NB; i += blockDim.x)
+    {
+        lds[i] = diag[static_cast<uint64_t>(i / NB) * n + i % NB];
+    }
+    __syncthreads();
+
+    auto idx = k0 + NB + blockIdx.x * blockDim.x + threadIdx.x;
+    if(idx >= n)
+    {
+        return;
+    }
+
+    if(blockIdx.y == 0u)
+    {
+        // Substitution X x U(k, k) = A(i, k) along the row
+        auto row = w + idx;
+        for(uint32_t c = 0; c < NB; c++)
+        {
+            auto x = row[static_cast<uint64_t>(k0 + c) * n];
+            for(uint32_t p = 0; p < c; p++)
+            {
+                x -= row[static_cast<uint64_t>(k0 + p) * n] * lds[c * NB + p];
+            }
+            x /= lds[c * NB + c];
+
+            row[static_cast<uint64_t>(k0 + c) * n] = x;
+            lp[static_cast<uint64_t>(c) * n + idx] = static_cast<PanelT>(-x);
+        }
+    }
+    else
+    {
+        // Substitution L(k, k) x X = A(k, j) down the column, unit diagonal
+        auto col = w + static_cast<uint64_t>(idx) * n + k0;
+        for(uint32_t r = 0; r < NB; r++)
+        {
+            auto x = col[r];
+            for(uint32_t p = 0; p < r; p++)
+            {
+                x -= lds[p * NB + r] * col[p];
+            }
+
+            col[r]                                  = x;
+            up[static_cast<uint64_t>(idx) * NB + r] = static_cast<PanelT>(x);
+        }
+    }
+}
+
+// Rank NB update of the trailing matrix past (k0 + NB, k0 + NB):
+// A(i, j) += (-L(i, k)) x U(k, j), with an NB x NB tile per workgroup.
+template <typename ComputeT, bool Split>
+__global__ void lu_update_d(uint32_t                          n,
+                            uint32_t                          k0,
+                            FactorType<ComputeT>*             w,
+                            PanelType<ComputeT, Split> const* lp,
+                            PanelType<ComputeT, Split> const* up)
+{
+    using FragA = rocwmma::fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, ComputeT, col_major>;
+    using FragB = rocwmma::fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, ComputeT, col_major>;
+    using FragC = rocwmma::
+        fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, FactorType<ComputeT>, col_major>;
+
+    // Origin of the 2 x 2 blocks of the wave
+    auto waveX = threadIdx.x / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    auto waveY = threadIdx.y;
+    auto row0  = k0 + NB + blockIdx.x * NB + waveX * BLOCKS * ROCWMMA_M;
+    auto col0  = k0 + NB + blockIdx.y * NB + waveY * BLOCKS * ROCWMMA_N;
+
+    FragC fragC[BLOCKS][BLOCKS];
+    for(int i = 0; i < BLOCKS; i++)
+    {
+        for(int j = 0; j < BLOCKS; j++)
+        {
+            auto offset = static_cast<uint64_t>(col0 + j * ROCWMMA_N) * n + row0 + i * ROCWMMA_M;
+            rocwmma::load_matrix_sync(fragC[i][j], w + offset, n);
+        }
+    }
+
+    for(uint32_t k = 0; k < NB; k += ROCWMMA_K)
+    {
+        FragA fragA[BLOCKS];
+        FragB fragB[BLOCKS];
+
+        if constexpr(Split)
+        {
+            FragA fragALo[BLOCKS];
+            FragB fragBLo[BLOCKS];
+            for(int i = 0; i < BLOCKS; i++)
+            {
+                auto panelA = lp + static_cast<uint64_t>(k) * n + row0 + i * ROCWMMA_M;
+                auto panelB = up + static_cast<uint64_t>(col0 + i * ROCWMMA_N) * NB + k;
+                rocwmma::load_matrix_split_sync(fragA[i], fragALo[i], panelA, n);
+                rocwmma::load_matrix_split_sync(fragB[i], fragBLo[i], panelB, NB);
+            }
+
+            for(int i = 0; i < BLOCKS; i++)
+            {
+                for(int j = 0; j < BLOCKS; j++)
+                {
+                    rocwmma::mma_sync_split(
+                        fragC[i][j], fragA[i], fragALo[i], fragB[j], fragBLo[j], fragC[i][j]);
+                }
+            }
+        }
+        else
+        {
+            for(int i = 0; i < BLOCKS; i++)
+            {
+                rocwmma::load_matrix_sync(
+                    fragA[i], lp + static_cast<uint64_t>(k) * n + row0 + i * ROCWMMA_M, n);
+                rocwmma::load_matrix_sync(
+                    fragB[i], up + static_cast<uint64_t>(col0 + i * ROCWMMA_N) * NB + k, NB);
+            }
+
+            for(int i = 0; i < BLOCKS; i++)
+            {
+                for(int j = 0; j < BLOCKS; j++)
+                {
+                    rocwmma::mma_sync(fragC[i][j], fragA[i], fragB[j], fragC[i][j]);
+                }
+            }
+        }
+    }
+
+    for(int i = 0; i < BLOCKS; i++)
+    {
+        for(int j = 0; j < BLOCKS; j++)
+        {
+            auto offset = static_cast<uint64_t>(col0 + j * ROCWMMA_N) * n + row0 + i * ROCWMMA_M;
+            rocwmma::store_matrix_sync(w + offset, fragC[i][j], n);
+        }
+    }
+}
+
+// r -= A x in fp64, for r preset to b. Each thread sums its row of the column major A
+// over a slice of n / RESIDUAL_SPLITS columns, and adds it to r atomically.
+__global__ void residual_d(uint32_t n, float64_t const* a, float64_t const* x, float64_t* r)
+{
+    auto row   = blockIdx.x * blockDim.x + threadIdx.x;
+    auto slice = n / RESIDUAL_SPLITS;
+    if(row < n)
+    {
+        auto sum = 0.0;
+        for(uint32_t j = blockIdx.y * slice; j < (blockIdx.y + 1u) * slice; j++)
+        {
+            sum += a[static_cast<uint64_t>(j) * n + row] * x[j];
+        }
+        atomicAdd(r + row, -sum);
+    }
+}
+
+// Inverses of the TRSV_NB x TRSV_NB diagonal blocks of the factors, such that the
+// triangular solves apply them as products: blockIdx.y = 0 inverts the unit lower L,
+// blockIdx.y = 1 the upper U, of diagonal block blockIdx.x. A thread per column of the
+// inverse solves it by substitution. The inverses are column major with ld TRSV_NB.
+template <typename FactorT>
+__global__ void trtri_d(uint32_t n, FactorT const* lu, FactorT* inv)
+{
+    __shared__ FactorT lds[TRSV_NB * TRSV_NB];
+    __shared__ FactorT res[TRSV_NB * TRSV_NB];
+
+    auto j0 = blockIdx.x * TRSV_NB;
+    for(uint32_t i = threadIdx.x; i < TRSV_NB * TRSV_NB; i += blockDim.x)
+    {
+        lds[i] = lu[static_cast<uint64_t>(j0 + i / TRSV_NB) * n + j0 + i % TRSV_NB];
+    }
+    __syncthreads();
+
+    auto c = static_cast<int>(threadIdx.x);
+    if(c < TRSV_NB)
+    {
+        auto col = res + c * TRSV_NB;
+        if(blockIdx.y == 0u)
+        {
+            for(int r = 0; r < TRSV_NB; r++)
+            {
+                auto x = static_cast<FactorT>(r == c ? 1.0 : 0.0);
+                for(int p = 0; p < r; p++)
+                {
+                    x -= lds[p * TRSV_NB + r] * col[p];
+                }
+                col[r] = x;
+            }
+        }
+        else
+        {
+            for(int r = TRSV_NB - 1; r >= 0; r--)
+            {
+                auto x = static_cast<FactorT>(r == c ? 1.0 : 0.0);
+                for(int p = r + 1; p < TRSV_NB; p++)
+                {
+                    x -= lds[p * TRSV_NB + r] * col[p];
+                }
+                col[r] = x / lds[r * TRSV_NB + r];
+            }
+        }
+    }
+    __syncthreads();
+
+    auto out = inv + (2u * blockIdx.x + blockIdx.y) * TRSV_NB * TRSV_NB;
+    for(uint32_t i = threadIdx.x; i < TRSV_NB * TRSV_NB; i += blockDim.x)
+    {
+        out[i] = res[i];
+    }
+}
+
+// Substitution of the TRSV_NB rows of block b: y(b) = T(b, b)^-1 x (s - sum T(b, j) x y(j)),
+// over the blocks j that b depends on, in the order given. Each block j is read once its
+// flag reaches epoch, and the flag of b is raised once y(b) is written. Threads hold a row
+// of the block and a group of its columns, the groups being reduced in LDS.
+template <typename FactorT, typename RhsT, typename DependsT>
+__device__ inline void trsvBlock(uint32_t       n,
+                                 uint32_t       b,
+                                 FactorT const* t,
+                                 FactorT const* tInv,
+                                 RhsT const*    s,
+                                 FactorT*       y,
+                                 uint32_t*      flags,
+                                 uint32_t       epoch,
+                                 DependsT&&     depends)
+{
+    __shared__ FactorT partial[T_TRSV];
+    __shared__ FactorT rhs[TRSV_NB];
+
+    constexpr uint32_t Cols = TRSV_NB / (T_TRSV / TRSV_NB);
+
+    auto row   = threadIdx.x % TRSV_NB;
+    auto group = threadIdx.x / TRSV_NB;
+    auto i     = b * TRSV_NB + row;
+
+    // Products of the finished blocks, as their flags are raised
+    auto sum = static_cast<FactorT>(0);
+    depends([&](uint32_t j) {
+        rocwmma::wait_workgroup_flag(flags + j, epoch);
+        for(uint32_t q = 0; q < Cols; q++)
+        {
+            auto c = j * TRSV_NB + group * Cols + q;
+            sum += t[static_cast<uint64_t>(c) * n + i] * y[c];
+        }
+    });
+
+    partial[threadIdx.x] = sum;
+    __syncthreads();
+
+    if(threadIdx.x < TRSV_NB)
+    {
+        auto value = static_cast<FactorT>(s[i]);
+        for(uint32_t g = 0; g < T_TRSV / TRSV_NB; g++)
+        {
+            value -= partial[g * TRSV_NB + row];
+        }
+        rhs[row] = value;
+    }
+    __syncthreads();
+
+    // y(b) = T(b, b)^-1 x rhs
+    sum = static_cast<FactorT>(0);
+    for(uint32_t q = 0; q < Cols; q++)
+    {
+        auto c = group * Cols + q;
+        sum += tInv[c * TRSV_NB + row] * rhs[c];
+    }
+
+    partial[threadIdx.x] = sum;
+    __syncthreads();
+
+    if(threadIdx.x < TRSV_NB)
+    {
+        auto value = static_cast<FactorT>(0);
+        for(uint32_t g = 0; g < T_TRSV / TRSV_NB; g++)
+        {
+            value += partial[g * TRSV_NB + row];
+        }
+        y[i] = value;
+    }
+
+    rocwmma::signal_workgroup_flag(flags + b, epoch);
+}
+
+// Forward substitution L y = r in the factor precision, a workgroup per block of
+// TRSV_NB rows. Block b depends on the blocks above it, which are dispatched before it.
+template <typename FactorT>
+__global__ void trsv_lower_d(uint32_t         n,
+                             FactorT const*   lu,
+                             FactorT const*   inv,
+                             float64_t const* r,
+                             FactorT*         y,
+                             uint32_t*        flags,
+                             uint32_t         epoch)
+{
+    auto b = blockIdx.x;
+    trsvBlock(n, b, lu, inv + 2u * b * TRSV_NB * TRSV_NB, r, y, flags, epoch, [b](auto&& f) {
+        for(uint32_t j = 0; j < b; j++)
+        {
+            f(j);
+        }
+    });
+}
+
+// Backward substitution U d = y and x += d, a workgroup per block of TRSV_NB rows.
+// Workgroups run from the last block up, such that block b depends on the blocks
+// below it, which are dispatched before it.
+template <typename FactorT>
+__global__ void trsv_upper_d(uint32_t       n,
+                             FactorT const* lu,
+                             FactorT const* inv,
+                             FactorT const* y,
+                             FactorT*       d,
+                             float64_t*     x,
+                             uint32_t*      flags,
+                             uint32_t       epoch)
+{
+    auto blocks = n / TRSV_NB;
+    auto b      = blocks - 1u - blockIdx.x;
+
+    trsvBlock(n,
+              b,
+              lu,
+              inv + (2u * b + 1u) * TRSV_NB * TRSV_NB,
+              y,
+              d,
+              flags,
+              epoch,
+              [b, blocks](auto&& f) {
+                  for(uint32_t j = blocks - 1u; j > b; j--)
+                  {
+                      f(j);
+                  }
+              });
+
+    if(threadIdx.x < TRSV_NB)
+    {
+        x[b * TRSV_NB + threadIdx.x] += static_cast<float64_t>(d[b * TRSV_NB + threadIdx.x]);
+    }
+}
+
+// Infinity norm of a vector
+inline float64_t normInf(std::vector<float64_t> const& v)
+{
+    auto norm = 0.0;
+    for(auto value : v)
+    {
+        norm = std::max(norm, std::abs(value));
+    }
+    return norm;
+}
+
+template <typename ComputeT, bool Split = false>
+__host__ void dgesv_test(uint32_t n)
+{
+    using FactorT = FactorType<ComputeT>;
+    using PanelT  = PanelType<ComputeT, Split>;
+
+    // Bounds check
+    if(n < NB || n % NB || n % (TRSV_NB * RESIDUAL_SPLITS))
+    {
+        std::cout << "Unsupported size!\n";
+        return;
+    }
+
+    // Strictly diagonally dominant A with a positive diagonal: safe to factor without
+    // pivoting, and well conditioned for the refinement to converge.
+    auto elements = static_cast<size_t>(n) * n;
+    auto gen      = std::mt19937(5489u);
+    auto dist     = std::uniform_real_distribution<float64_t>(-1.0, 1.0);
+
+    std::vector<float64_t> matrixA(elements);
+    std::vector<float64_t> vectorB(n);
+    for(uint32_t j = 0; j < n; j++)
+    {
+        for(uint32_t i = 0; i < n; i++)
+        {
+            matrixA[static_cast<size_t>(j) * n + i] = (i == j) ? n + 1.0 + dist(gen) : dist(gen);
+        }
+        vectorB[j] = dist(gen);
+    }
+
+    auto normA = 0.0;
+    for(uint32_t i = 0; i < n; i++)
+    {
+        auto sum = 0.0;
+        for(uint32_t j = 0; j < n; j++)
+        {
+            sum += std::abs(matrixA[static_cast<size_t>(j) * n + i]);
+        }
+        normA = std::max(normA, sum);
+    }
+
+    // Allocate and copy device memory
+    float64_t* d_a;
+    float64_t* d_b;
+    float64_t* d_x;
+    float64_t* d_r;
+    FactorT*   d_w;
+    FactorT*   d_inv;
+    FactorT*   d_y;
+    FactorT*   d_d;
+    PanelT*    d_lp;
+    PanelT*    d_up;
+    uint32_t*  d_flags;
+
+    auto blocksTrsv = n / TRSV_NB;
+
+    CHECK_HIP_ERROR(hipMalloc(&d_a, elements * sizeof(float64_t)));
+    CHECK_HIP_ERROR(hipMalloc(&d_b, n * sizeof(float64_t)));
+    CHECK_HIP_ERROR(hipMalloc(&d_x, n * sizeof(float64_t)));
+    CHECK_HIP_ERROR(hipMalloc(&d_r, n * sizeof(float64_t)));
+    CHECK_HIP_ERROR(hipMalloc(&d_w, elements * sizeof(FactorT)));
+    CHECK_HIP_ERROR(hipMalloc(&d_inv, 2u * n * TRSV_NB * sizeof(FactorT)));
+    CHECK_HIP_ERROR(hipMalloc(&d_y, n * sizeof(FactorT)));
+    CHECK_HIP_ERROR(hipMalloc(&d_d, n * sizeof(FactorT)));
+    CHECK_HIP_ERROR(hipMalloc(&d_lp, static_cast<size_t>(n) * NB * sizeof(PanelT)));
+    CHECK_HIP_ERROR(hipMalloc(&d_up, static_cast<size_t>(n) * NB * sizeof(PanelT)));
+    CHECK_HIP_ERROR(hipMalloc(&d_flags, 2u * blocksTrsv * sizeof(uint32_t)));
+
+    CHECK_HIP_ERROR(
+        hipMemcpy(d_a, matrixA.data(), elements * sizeof(float64_t), hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(
+        hipMemcpy(d_b, vectorB.data(), n * sizeof(float64_t), hipMemcpyHostToDevice));
+
+    // Flags of the triangular solves are raised to the epoch of each solve, and
+    // never need to be reset.
+    CHECK_HIP_ERROR(hipMemset(d_flags, 0, 2u * blocksTrsv * sizeof(uint32_t)));
+    auto epoch = 0u;
+
+    auto factorize = [&]() {
+        hipExtLaunchKernelGGL(convert_d<FactorT>,
+                              dim3(rocwmma::ceilDiv(elements, size_t(T_BLOCK * 16))),
+                              dim3(T_BLOCK),
+                              0, // sharedMemBytes
+                              0, // stream
+                              nullptr, // Event start
+                              nullptr, // event stop
+                              0, // flags
+                              n,
+                              d_a,
+                              d_w);
+
+        for(uint32_t k0 = 0; k0 < n; k0 += NB)
+        {
+            hipExtLaunchKernelGGL(lu_diag_d<FactorT>,
+                                  dim3(1),
+                                  dim3(T_BLOCK),
+                                  0, // sharedMemBytes
+                                  0, // stream
+                                  nullptr, // Event start
+                                  nullptr, // event stop
+                                  0, // flags
+                                  n,
+                                  k0,
+                                  d_w);
+
+            auto rest = n - k0 - NB;
+            if(rest == 0u)
+            {
+                break;
+            }
+
+            hipExtLaunchKernelGGL(lu_panel_d<FactorT, PanelT>,
+                                  dim3(rocwmma::ceilDiv(rest, uint32_t(T_BLOCK)), 2),
+                                  dim3(T_BLOCK),
+                                  0, // sharedMemBytes
+                                  0, // stream
+                                  nullptr, // Event start
+                                  nullptr, // event stop
+                                  0, // flags
+                                  n,
+                                  k0,
+                                  d_w,
+                                  d_lp,
+                                  d_up);
+
+            hipExtLaunchKernelGGL(lu_update_d<ComputeT, Split>,
+                                  dim3(rest / NB, rest / NB),
+                                  dim3(WAVES_X * WAVE_SIZE, WAVES_Y),
+                                  0, // sharedMemBytes
+                                  0, // stream
+                                  nullptr, // Event start
+                                  nullptr, // event stop
+                                  0, // flags
+                                  n,
+                                  k0,
+                                  d_w,
+                                  d_lp,
+                                  d_up);
+        }
+
+        hipExtLaunchKernelGGL(trtri_d<FactorT>,
+                              dim3(blocksTrsv, 2),
+                              dim3(T_BLOCK),
+                              0, // sharedMemBytes
+                              0, // stream
+                              nullptr, // Event start
+                              nullptr, // event stop
+                              0, // flags
+                              n,
+                              d_w,
+                              d_inv);
+    };
+
+    // Refinement from x = 0, such that the first correction is the direct solve.
+    // Returns the corrections applied and the final backward error.
+    std::vector<float64_t> vectorR(n);
+    std::vector<float64_t> vectorX(n);
+    auto                   eps = std::numeric_limits<float64_t>::epsilon();
+
+    auto refine = [&]() {
+        CHECK_HIP_ERROR(hipMemset(d_x, 0, n * sizeof(float64_t)));
+
+        for(int iter = 0;; iter++)
+        {
+            CHECK_HIP_ERROR(
+                hipMemcpy(d_r, d_b, n * sizeof(float64_t), hipMemcpyDeviceToDevice));
+
+            hipExtLaunchKernelGGL(residual_d,
+                                  dim3(rocwmma::ceilDiv(n, uint32_t(T_BLOCK)), RESIDUAL_SPLITS),
+                                  dim3(T_BLOCK),
+                                  0, // sharedMemBytes
+                                  0, // stream
+                                  nullptr, // Event start
+                                  nullptr, // event stop
+                                  0, // flags
+                                  n,
+                                  d_a,
+                                  d_x,
+                                  d_r);
+
+            CHECK_HIP_ERROR(
+                hipMemcpy(vectorR.data(), d_r, n * sizeof(float64_t), hipMemcpyDeviceToHost));
+            CHECK_HIP_ERROR(
+                hipMemcpy(vectorX.data(), d_x, n * sizeof(float64_t), hipMemcpyDeviceToHost));
+
+            auto backwardError = normInf(vectorR) / (normA * normInf(vectorX));
+            if((iter > 0 && backwardError <= std::sqrt(static_cast<float64_t>(n)) * eps)
+               || iter == ITER_MAX)
+            {
+                return std::make_pair(iter, backwardError);
+            }
+
+            // x += U^-1 x L^-1 x r
+            epoch++;
+            hipExtLaunchKernelGGL(trsv_lower_d<FactorT>,
+                                  dim3(blocksTrsv),
+                                  dim3(T_TRSV),
+                                  0, // sharedMemBytes
+                                  0, // stream
+                                  nullptr, // Event start
+                                  nullptr, // event stop
+                                  0, // flags
+                                  n,
+                                  d_w,
+                                  d_inv,
+                                  d_r,
+                                  d_y,
+                                  d_flags,
+                                  epoch);
+
+            hipExtLaunchKernelGGL(trsv_upper_d<FactorT>,
+                                  dim3(blocksTrsv),
+                                  dim3(T_TRSV),
+                                  0, // sharedMemBytes
+                                  0, // stream
+                                  nullptr, // Event start
+                                  nullptr, // event stop
+                                  0, // flags
+                                  n,
+                                  d_w,
+                                  d_inv,
+                                  d_y,
+                                  d_d,
+                                  d_x,
+                                  d_flags + blocksTrsv,
+                                  epoch);
+        }
+    };
+
+    auto result = std::make_pair(0, 0.0);
+    auto solve  = [&]() {
+        factorize();
+        result = refine();
+    };
+
+    // Runs are timed individually, with warm and cold caches
+    BenchmarkHarness harness;
+
+    // Flops of the factorization, which dominate the solve
+    auto flops = 2.0 / 3.0 * n * n * n;
+
+    for(auto cacheState : {BenchmarkHarness::CacheState::Warm, BenchmarkHarness::CacheState::Cold})
+    {
+        auto stats = harness.run(solve, cacheState);
+
+        std::cout << computeString<ComputeT, Split>() << ", " << n << ", "
+                  << (cacheState == BenchmarkHarness::CacheState::Warm ? "warm" : "cold") << ", "
+                  << stats.mMedianMs << ", " << flops / (stats.mMedianMs * 1.0e6) << ", "
+                  << result.first << ", " << result.second / eps << ", "
+                  << (result.first < ITER_MAX ? "converged" : "diverged") << ", ";
+        BenchmarkHarness::printStats(std::cout, stats) << std::endl;
+    }
+
+    // Release device memory
+    CHECK_HIP_ERROR(hipFree(d_a));
+    CHECK_HIP_ERROR(hipFree(d_b));
+    CHECK_HIP_ERROR(hipFree(d_x));
+    CHECK_HIP_ERROR(hipFree(d_r));
+    CHECK_HIP_ERROR(hipFree(d_w));
+    CHECK_HIP_ERROR(hipFree(d_inv));
+    CHECK_HIP_ERROR(hipFree(d_y));
+    CHECK_HIP_ERROR(hipFree(d_d));
+    CHECK_HIP_ERROR(hipFree(d_lp));
+    CHECK_HIP_ERROR(hipFree(d_up));
+    CHECK_HIP_ERROR(hipFree(d_flags));
+}
+
+int main()
+{
+    std::cout << "Compute, N, Cache, elapsedMs, GFlops/s, Corrections, BackwardError/eps, "
+              << "Status, " << BenchmarkHarness::statsHeader() << std::endl;
+
+    for(auto n : {1024u, 2048u, 4096u})
+    {
+        // fp64 baseline: factors in fp64, converges with the direct solve
+        if(isF64Supported())
+        {
+            dgesv_test<float64_t>(n);
+        }
+
+        // fp32 mma is supported on gfx9 only
+        if(isF32Supported())
+        {
+            dgesv_test<float32_t>(n);
+        }
+
+        dgesv_test<bfloat16_t, true>(n);
+        dgesv_test<bfloat16_t>(n);
+        dgesv_test<float16_t>(n);
+    }
+
+    return 0;
+}
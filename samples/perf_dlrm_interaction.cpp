@@ -0,0 +1,283 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <iostream>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_fp16.h>
+#include <hip/hip_runtime.h>
+
+#include <rocwmma/rocwmma.hpp>
+#include <rocwmma/rocwmma_dlrm.hpp>
+
+#include "benchmark_harness.hpp"
+#include "common.hpp"
+
+using rocwmma::float16_t;
+using rocwmma::float32_t;
+
+/* Motivation
+*
+* The dot interaction layer of DLRM computes, for every sample, the pairwise
+* dot products of its feature vectors. The feature count and the embedding
+* dimension come from the model configuration, e.g. 27 x 128 for the MLPerf
+* DLRM, and rarely line up with the MMA block sizes.
+*
+* simple_dlrm and the dlrm tests hardwire the tile size to the problem, and
+* the dlrm tests stage the full m x m product through a global scratch
+* buffer. The rocwmma::dlrm module instead:
+* - Assigns one wave per sample, over the lower triangular tiles of X x X^T
+*   only, and scatters the strictly lower triangle straight from LDS.
+* - Gathers the symmetric gradient tiles for the backward pass from the
+*   upstream gradient in LDS, without a separate reconstruction kernel.
+* - Bounds the loads and stores of the edge tiles, so neither the feature
+*   count nor the embedding dimension needs padding.
+*
+* This sample runs both passes over feature counts and embedding dimensions
+* that are not multiples of the block size, and validates them against the
+* host reference in debug builds.
+*/
+
+// Host forwards DLRM reference
+void dlrmDotFwdCPU(
+    float16_t const* input, float16_t* output, uint32_t m, uint32_t k, uint32_t batchSize)
+{
+    auto inputSize  = static_cast<size_t>(m) * k;
+    auto outputSize = static_cast<size_t>(rocwmma::dlrm::output_size(m, k));
+
+#pragma omp parallel for
+    for(int b = 0; b < static_cast<int>(batchSize); b++)
+    {
+        auto x   = input + b * inputSize;
+        auto out = output + b * outputSize;
+
+        // Copy bottom MLP to output
+        for(uint32_t h = 0; h < k; h++)
+        {
+            out[h] = x[h];
+        }
+
+        // Strictly lower triangle of X x X^T, row by row
+        auto outputIdx = k;
+        for(uint32_t i = 0; i < m; i++)
+        {
+            for(uint32_t j = 0; j < i; j++)
+            {
+                float32_t accum = 0.0f;
+                for(uint32_t h = 0; h < k; h++)
+                {
+                    accum += static_cast<float32_t>(x[i * k + h])
+                             * static_cast<float32_t>(x[j * k + h]);
+                }
+                out[outputIdx++] = static_cast<float16_t>(accum);
+            }
+        }
+    }
+}
+
+// Host backwards DLRM reference
+void dlrmDotBwdCPU(float16_t const* input,
+                   float16_t const* upstreamGrad,
+                   float16_t*       inputGrad,
+                   float16_t*       bottomMlpGrad,
+                   uint32_t         m,
+                   uint32_t         k,
+                   uint32_t         batchSize)
+{
+    auto inputSize  = static_cast<size_t>(m) * k;
+    auto outputSize = static_cast<size_t>(rocwmma::dlrm::output_size(m, k));
+
+#pragma omp parallel for
+    for(int b = 0; b < static_cast<int>(batchSize); b++)
+    {
+        auto x  = input + b * inputSize;
+        auto dy = upstreamGrad + b * outputSize;
+        auto dx = inputGrad + b * inputSize;
+
+        // Copy bottom MLP grad
+        for(uint32_t h = 0; h < k; h++)
+        {
+            bottomMlpGrad[b * k + h] = dy[h];
+        }
+
+        // Remake the symmetric gradient, zero on the diagonal
+        std::vector<float32_t> s(static_cast<size_t>(m) * m, 0.0f);
+        auto                   trilIdx = k;
+        for(uint32_t i = 0; i < m; i++)
+        {
+            for(uint32_t j = 0; j < i; j++)
+            {
+                s[i * m + j] = s[j * m + i] = static_cast<float32_t>(dy[trilIdx++]);
+            }
+        }
+
+        // Reverse bmm
+        for(uint32_t i = 0; i < m; i++)
+        {
+            for(uint32_t j = 0; j < k; j++)
+            {
+                float32_t accum = 0.0f;
+                for(uint32_t h = 0; h < m; h++)
+                {
+                    accum += s[i * m + h] * static_cast<float32_t>(x[h * k + j]);
+                }
+                dx[i * k + j] = static_cast<float16_t>(accum);
+            }
+        }
+    }
+}
+
+__host__ void dlrm_interaction_test(uint32_t m, uint32_t k, uint32_t b)
+{
+    auto outputSize = rocwmma::dlrm::output_size(m, k);
+
+    // Allocate and initialize host data
+    std::vector<float16_t> input(static_cast<size_t>(m) * k * b);
+    std::vector<float16_t> output(static_cast<size_t>(outputSize) * b);
+    std::vector<float16_t> upstreamGrad(output.size());
+    std::vector<float16_t> inputGrad(input.size());
+    std::vector<float16_t> bottomMlpGrad(static_cast<size_t>(k) * b);
+
+    fill<float16_t>(input.data(), m, k, b);
+    fill<float16_t>(upstreamGrad.data(), 1, outputSize, b);
+
+    // Allocate and copy device memory
+    float16_t *d_input, *d_output, *d_upstreamGrad, *d_inputGrad, *d_bottomMlpGrad;
+
+    const size_t inputBytes         = input.size() * sizeof(float16_t);
+    const size_t outputBytes        = output.size() * sizeof(float16_t);
+    const size_t bottomMlpGradBytes = bottomMlpGrad.size() * sizeof(float16_t);
+
+    CHECK_HIP_ERROR(hipMalloc(&d_input, inputBytes));
+    CHECK_HIP_ERROR(hipMalloc(&d_output, outputBytes));
+    CHECK_HIP_ERROR(hipMalloc(&d_upstreamGrad, outputBytes));
+    CHECK_HIP_ERROR(hipMalloc(&d_inputGrad, inputBytes));
+    CHECK_HIP_ERROR(hipMalloc(&d_bottomMlpGrad, bottomMlpGradBytes));
+
+    CHECK_HIP_ERROR(hipMemcpy(d_input, input.data(), inputBytes, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(
+        hipMemcpy(d_upstreamGrad, upstreamGrad.data(), outputBytes, hipMemcpyHostToDevice));
+
+    // Fill outputs with NaN to catch contamination
+    CHECK_HIP_ERROR(hipMemset(d_output, 0xFF, outputBytes));
+    CHECK_HIP_ERROR(hipMemset(d_inputGrad, 0xFF, inputBytes));
+    CHECK_HIP_ERROR(hipMemset(d_bottomMlpGrad, 0xFF, bottomMlpGradBytes));
+
+    auto fwdKernel = [d_input, d_output, m, k, b]() {
+        CHECK_HIP_ERROR(rocwmma::dlrm::dot_interaction_fwd(d_input, d_output, m, k, b));
+    };
+
+    auto bwdKernel = [d_input, d_upstreamGrad, d_inputGrad, d_bottomMlpGrad, m, k, b]() {
+        CHECK_HIP_ERROR(rocwmma::dlrm::dot_interaction_bwd(
+            d_input, d_upstreamGrad, d_inputGrad, d_bottomMlpGrad, m, k, b));
+    };
+
+    // Runs are timed individually, with warm and cold caches
+    BenchmarkHarness harness;
+
+    // Echo performance. Forward computes the lower triangle only, backward the full product.
+    auto echo = [&](const char* passName, auto&& kernel, double flops) {
+        for(auto cacheState :
+            {BenchmarkHarness::CacheState::Warm, BenchmarkHarness::CacheState::Cold})
+        {
+            auto stats = harness.run(kernel, cacheState);
+
+            std::cout << passName << ", " << m << ", " << k << ", " << b << ", "
+                      << (cacheState == BenchmarkHarness::CacheState::Warm ? "warm" : "cold")
+                      << ", " << stats.mMedianMs << ", " << flops * 1.0e-9 << ", "
+                      << flops / stats.mMedianMs * 1.0e-9 << ", ";
+            BenchmarkHarness::printStats(std::cout, stats) << std::endl;
+        }
+    };
+
+    auto fwdFlops = 2.0 * static_cast<double>(rocwmma::dlrm::interaction_count(m)) * k * b;
+    auto bwdFlops = 2.0 * static_cast<double>(m) * m * k * b;
+
+    echo("Forward", fwdKernel, fwdFlops);
+    echo("Backward", bwdKernel, bwdFlops);
+
+#if !NDEBUG
+
+    std::cout << "Validating result with reference..." << std::endl;
+
+    CHECK_HIP_ERROR(hipMemcpy(output.data(), d_output, outputBytes, hipMemcpyDeviceToHost));
+    CHECK_HIP_ERROR(hipMemcpy(inputGrad.data(), d_inputGrad, inputBytes, hipMemcpyDeviceToHost));
+    CHECK_HIP_ERROR(hipMemcpy(
+        bottomMlpGrad.data(), d_bottomMlpGrad, bottomMlpGradBytes, hipMemcpyDeviceToHost));
+
+    std::vector<float16_t> outputRef(output.size());
+    std::vector<float16_t> inputGradRef(inputGrad.size());
+    std::vector<float16_t> bottomMlpGradRef(bottomMlpGrad.size());
+
+    dlrmDotFwdCPU(input.data(), outputRef.data(), m, k, b);
+    dlrmDotBwdCPU(input.data(),
+                  upstreamGrad.data(),
+                  inputGradRef.data(),
+                  bottomMlpGradRef.data(),
+                  m,
+                  k,
+                  b);
+
+    auto report = [](const char* name, std::pair<bool, double> res) {
+        std::cout << name << (std::get<0>(res) ? ": PASSED\n" : ": FAILED\n");
+        std::cout << "Max relative error: " << std::get<1>(res) << std::endl;
+    };
+
+    report("Forward output",
+           compareEqual<float16_t>(output.data(), outputRef.data(), output.size(), 1.0));
+    report("Backward input grad",
+           compareEqual<float16_t>(inputGrad.data(), inputGradRef.data(), inputGrad.size(), 1.0));
+    report("Backward bottom MLP grad",
+           compareEqual<float16_t>(
+               bottomMlpGrad.data(), bottomMlpGradRef.data(), bottomMlpGrad.size(), 1.0));
+
+#endif // !NDEBUG
+
+    // Release device memory
+    CHECK_HIP_ERROR(hipFree(d_input));
+    CHECK_HIP_ERROR(hipFree(d_output));
+    CHECK_HIP_ERROR(hipFree(d_upstreamGrad));
+    CHECK_HIP_ERROR(hipFree(d_inputGrad));
+    CHECK_HIP_ERROR(hipFree(d_bottomMlpGrad));
+}
+
+int main()
+{
+    std::cout << "Pass, NumFeatures, EmbeddingDim, Batch, "
+              << "Cache, elapsedMs, Problem Size(GFlops), TFlops/s, "
+              << BenchmarkHarness::statsHeader() << std::endl;
+
+    // (numFeatures, embeddingDim): MLPerf DLRM, and ragged edges on both dims
+    const uint32_t shapes[][2] = {{27u, 128u}, {32u, 128u}, {33u, 64u}, {100u, 37u}, {65u, 96u}};
+
+    const uint32_t batch = 2048u;
+    for(auto const& shape : shapes)
+    {
+        dlrm_interaction_test(shape[0], shape[1], batch);
+    }
+    return 0;
+}
@@ -0,0 +1,605 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <complex>
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_runtime.h>
+
+#include <rocwmma/rocwmma.hpp>
+#include <rocwmma/rocwmma_transforms.hpp>
+
+#include "benchmark_harness.hpp"
+#include "common.hpp"
+
+/* Motivation
+*
+* A DFT of size N = R x M splits into R-point DFTs down the columns of the R x M view
+* of the signal, a twiddle multiply, and M-point DFTs along its rows (decimation in
+* frequency):
+*
+*   Y(k1, n2)      = sum_n1 F_R(k1, n1) x(n1 * M + n2)      (F_R = DFT matrix of size R)
+*   Y(k1, n2)     *= W_N^(k1 n2)                            (W_N = exp(-2 pi i / N))
+*   X(k1 + R k2)   = sum_n2 Y(k1, n2) W_M^(n2 k2)           (M-point DFT of row k1)
+*
+* The first step is a GEMM of the constant F_16 (16 x 16) with the R x M view, in place,
+* and rows of Y are contiguous sub-signals of the next stage. Radix-16 stages therefore
+* run as 16 x 16 x 16 fragment GEMMs on the MFMA / WMMA units, with the twiddles applied
+* to the accumulators before they are written back. Complex products take four real mma
+* on re and im planes (4M, see perf_cgemm_3m).
+*
+* Sizes 64 - 4096 are N = r x 16^p for r in {1, 2, 4, 8}. The leading radix-r stage is a
+* per-thread butterfly, and the last radix-16 stage of 16-point sub-signals is a GEMM
+* over consecutive sub-signals as the columns of B. Signals shorter than 256 points are
+* packed several per workgroup, such that each stage holds whole 16 x 16 blocks.
+*
+* The whole signal stays in LDS across stages. Frequencies come out in digit reversed
+* order, which is undone by the store to global memory.
+*
+* A 2D FFT is a row pass and a column pass of the same kernel, through strided signals.
+*/
+
+using rocwmma::accumulator;
+using rocwmma::bfloat16_t;
+using rocwmma::col_major;
+using rocwmma::float16_t;
+using rocwmma::float32_t;
+using rocwmma::float64_t;
+using rocwmma::matrix_a;
+using rocwmma::matrix_b;
+using rocwmma::row_major;
+
+// DFT block size of the GEMM stages
+const int RADIX = 16;
+
+// Device warp size
+const uint32_t WAVE_SIZE = getWarpSize();
+
+// Thread block
+// : WAVES waves sharing one LDS signal buffer
+const int WAVES     = 4;
+const int T_BLOCK_X = WAVES * WAVE_SIZE;
+
+// Leading radix of N = r x 16^p
+__host__ __device__ constexpr uint32_t firstRadix(uint32_t n)
+{
+    while(n % RADIX == 0u)
+    {
+        n /= RADIX;
+    }
+    return n;
+}
+
+// Signals per workgroup, such that every GEMM stage holds whole 16 x 16 blocks
+__host__ __device__ constexpr uint32_t signalsPerBlock(uint32_t n)
+{
+    return n < RADIX * RADIX ? RADIX * RADIX / n : 1u;
+}
+
+// Strided planar signals: element j of signal s of batch b is at
+// b * batchDist + s * dist + j * stride, in the re plane and planeSize further in the im plane.
+struct FftLayout
+{
+    uint32_t stride;
+    uint32_t dist;
+    uint32_t batchDist;
+    size_t   planeSize;
+};
+
+// Forward FFT of length N, of signals x (InputT) into X (OutputT). Each workgroup transforms
+// signalsPerBlock(N) consecutive signals of the batch blockIdx.y.
+// Twiddles are the planar cos and sin of -2 pi j / N, for j in [0, N).
+template <uint32_t N, typename InputT, typename OutputT>
+__global__ void __launch_bounds__(256) fft_rocwmma_d(InputT const*    x,
+                                                     OutputT*         X,
+                                                     float32_t const* twiddles,
+                                                     FftLayout        inLayout,
+                                                     FftLayout        outLayout)
+{
+    constexpr uint32_t WaveSize = rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    constexpr uint32_t Signals  = signalsPerBlock(N);
+    constexpr uint32_t Total    = Signals * N;
+    constexpr uint32_t TileSize = RADIX * RADIX;
+    constexpr uint32_t Tiles    = Total / TileSize;
+    constexpr uint32_t R0       = firstRadix(N);
+
+    static_assert(N >= 64u && N <= 4096u && (N & (N - 1u)) == 0u,
+                  "Sizes are powers of 2 in [64, 4096]");
+
+    // Signal planes, and the re, im and -im planes of F_16
+    __shared__ InputT sRe[Total];
+    __shared__ InputT sIm[Total];
+    __shared__ InputT sDft[3][TileSize];
+
+    using FragA    = rocwmma::fragment<matrix_a, RADIX, RADIX, RADIX, InputT, row_major>;
+    using FragB    = rocwmma::fragment<matrix_b, RADIX, RADIX, RADIX, InputT, row_major>;
+    using FragBCol = rocwmma::fragment<matrix_b, RADIX, RADIX, RADIX, InputT, col_major>;
+    using FragAcc  = rocwmma::fragment<accumulator, RADIX, RADIX, RADIX, float32_t>;
+    using FragOut  = rocwmma::fragment<accumulator, RADIX, RADIX, RADIX, InputT>;
+    using Coords   = rocwmma::fragment_coords<FragAcc>;
+
+    auto tid       = threadIdx.x;
+    auto blockSize = blockDim.x;
+    auto wave      = threadIdx.x / WaveSize;
+    auto waves     = blockDim.x / WaveSize;
+
+    auto const* cosTable = twiddles;
+    auto const* sinTable = twiddles + N;
+
+    // Element j of the signals of this workgroup
+    auto offset = [](FftLayout const& layout, uint32_t j) {
+        auto signal = blockIdx.x * Signals + j / N;
+        return static_cast<size_t>(blockIdx.y) * layout.batchDist
+               + static_cast<size_t>(signal) * layout.dist
+               + static_cast<size_t>(j % N) * layout.stride;
+    };
+
+    // F_16(k, n) = W_16^(k n)
+    for(uint32_t i = tid; i < TileSize; i += blockSize)
+    {
+        auto t     = (i / RADIX) * (i % RADIX) % RADIX * (N / RADIX);
+        sDft[0][i] = static_cast<InputT>(cosTable[t]);
+        sDft[1][i] = static_cast<InputT>(sinTable[t]);
+        sDft[2][i] = static_cast<InputT>(-sinTable[t]);
+    }
+
+    for(uint32_t j = tid; j < Total; j += blockSize)
+    {
+        auto idx = offset(inLayout, j);
+        sRe[j]   = x[idx];
+        sIm[j]   = x[inLayout.planeSize + idx];
+    }
+
+    rocwmma::synchronize_workgroup();
+
+    // Leading radix-r stage: one r-point butterfly per column n2 of the r x (N / r) view
+    if constexpr(R0 > 1u)
+    {
+        constexpr uint32_t M = N / R0;
+        for(uint32_t w = tid; w < Total / R0; w += blockSize)
+        {
+            auto base = (w / M) * N + w % M;
+            auto n2   = w % M;
+
+            float32_t re[R0], im[R0];
+#pragma unroll
+            for(uint32_t n1 = 0; n1 < R0; n1++)
+            {
+                re[n1] = static_cast<float32_t>(sRe[base + n1 * M]);
+                im[n1] = static_cast<float32_t>(sIm[base + n1 * M]);
+            }
+
+#pragma unroll
+            for(uint32_t k1 = 0; k1 < R0; k1++)
+            {
+                auto yRe = 0.0f;
+                auto yIm = 0.0f;
+#pragma unroll
+                for(uint32_t n1 = 0; n1 < R0; n1++)
+                {
+                    auto t = (k1 * n1 % R0) * M;
+                    yRe += re[n1] * cosTable[t] - im[n1] * sinTable[t];
+                    yIm += re[n1] * sinTable[t] + im[n1] * cosTable[t];
+                }
+
+                // W_N^(k1 n2), with k1 n2 < N
+                auto t             = k1 * n2;
+                sRe[base + k1 * M] = static_cast<InputT>(yRe * cosTable[t] - yIm * sinTable[t]);
+                sIm[base + k1 * M] = static_cast<InputT>(yRe * sinTable[t] + yIm * cosTable[t]);
+            }
+        }
+
+        rocwmma::synchronize_workgroup();
+    }
+
+    FragA fragDft[3];
+    for(uint32_t p = 0; p < 3u; p++)
+    {
+        rocwmma::load_matrix_sync(fragDft[p], sDft[p], RADIX);
+    }
+
+    // Yr = Fr Xr - Fi Xi, Yi = Fr Xi + Fi Xr
+    auto dft = [&](FragAcc& yRe, FragAcc& yIm, auto const& xRe, auto const& xIm) {
+        rocwmma::fill_fragment(yRe, 0.0f);
+        rocwmma::fill_fragment(yIm, 0.0f);
+        rocwmma::mma_sync(yRe, fragDft[0], xRe, yRe);
+        rocwmma::mma_sync(yRe, fragDft[2], xIm, yRe);
+        rocwmma::mma_sync(yIm, fragDft[0], xIm, yIm);
+        rocwmma::mma_sync(yIm, fragDft[1], xRe, yIm);
+    };
+
+    auto convert = [](FragOut& out, FragAcc const& acc) {
+        for(uint32_t i = 0; i < FragAcc::num_elements; i++)
+        {
+            out.x[i] = static_cast<InputT>(acc.x[i]);
+        }
+    };
+
+    auto xRe  = FragB();
+    auto xIm  = FragB();
+    auto yRe  = FragAcc();
+    auto yIm  = FragAcc();
+    auto outT = FragOut();
+
+    // Radix-16 stages on sub-signals of size S, as 16 x (S / 16) views of ld M.
+    // Waves own disjoint blocks of each stage, which are transformed in place.
+    for(uint32_t S = N / R0; S > RADIX; S /= RADIX)
+    {
+        auto M            = S / RADIX;
+        auto blocksPerSeg = M / RADIX;
+        for(uint32_t b = wave; b < Tiles; b += waves)
+        {
+            auto col   = (b % blocksPerSeg) * RADIX;
+            auto start = (b / blocksPerSeg) * S + col;
+
+            rocwmma::load_matrix_sync(xRe, sRe + start, M);
+            rocwmma::load_matrix_sync(xIm, sIm + start, M);
+            dft(yRe, yIm, xRe, xIm);
+
+            // Y(k1, n2) *= W_S^(k1 n2)
+            for(uint32_t i = 0; i < FragAcc::num_elements; i++)
+            {
+                auto t   = (Coords::row(i) * (col + Coords::col(i)) % S) * (N / S);
+                auto re  = yRe.x[i];
+                auto im  = yIm.x[i];
+                yRe.x[i] = re * cosTable[t] - im * sinTable[t];
+                yIm.x[i] = re * sinTable[t] + im * cosTable[t];
+            }
+
+            convert(outT, yRe);
+            rocwmma::store_matrix_sync(sRe + start, outT, M, rocwmma::mem_row_major);
+            convert(outT, yIm);
+            rocwmma::store_matrix_sync(sIm + start, outT, M, rocwmma::mem_row_major);
+        }
+
+        rocwmma::synchronize_workgroup();
+    }
+
+    // Last stage of 16-point sub-signals, as the columns of B, without twiddles
+    auto xReCol = FragBCol();
+    auto xImCol = FragBCol();
+    for(uint32_t b = wave; b < Tiles; b += waves)
+    {
+        auto start = b * TileSize;
+
+        rocwmma::load_matrix_sync(xReCol, sRe + start, RADIX);
+        rocwmma::load_matrix_sync(xImCol, sIm + start, RADIX);
+        dft(yRe, yIm, xReCol, xImCol);
+
+        convert(outT, yRe);
+        rocwmma::store_matrix_sync(sRe + start, outT, RADIX, rocwmma::mem_col_major);
+        convert(outT, yIm);
+        rocwmma::store_matrix_sync(sIm + start, outT, RADIX, rocwmma::mem_col_major);
+    }
+
+    rocwmma::synchronize_workgroup();
+
+    // Frequency f = k1 + R0 (k2 + 16 (k3 + ...)) is at k1 (N / R0) + k2 (N / (16 R0)) + ...
+    for(uint32_t j = tid; j < Total; j += blockSize)
+    {
+        auto f   = j % N;
+        auto pos = (j / N) * N;
+        auto S   = N / R0;
+        if constexpr(R0 > 1u)
+        {
+            pos += (f % R0) * S;
+            f /= R0;
+        }
+        for(; S > 1u; S /= RADIX)
+        {
+            pos += (f % RADIX) * (S / RADIX);
+            f /= RADIX;
+        }
+
+        auto idx                     = offset(outLayout, j);
+        X[idx]                       = static_cast<OutputT>(sRe[pos]);
+        X[outLayout.planeSize + idx] = static_cast<OutputT>(sIm[pos]);
+    }
+}
+
+// Host radix-2 FFT reference in float64_t, in place
+__host__ void fft_cpu_h(std::complex<double>* data, uint32_t n, uint32_t stride)
+{
+    // Bit reversal
+    for(uint32_t i = 1, j = 0; i < n; i++)
+    {
+        auto bit = n >> 1;
+        for(; j & bit; bit >>= 1)
+        {
+            j ^= bit;
+        }
+        j ^= bit;
+        if(i < j)
+        {
+            std::swap(data[i * stride], data[j * stride]);
+        }
+    }
+
+    for(uint32_t len = 2; len <= n; len <<= 1)
+    {
+        auto w = std::polar(1.0, -2.0 * M_PI / static_cast<double>(len));
+        for(uint32_t i = 0; i < n; i += len)
+        {
+            auto wk = std::complex<double>(1.0, 0.0);
+            for(uint32_t k = 0; k < len / 2; k++)
+            {
+                auto u = data[(i + k) * stride];
+                auto v = data[(i + k + len / 2) * stride] * wk;
+
+                data[(i + k) * stride]           = u + v;
+                data[(i + k + len / 2) * stride] = u - v;
+                wk *= w;
+            }
+        }
+    }
+}
+
+// Planar cos and sin of -2 pi j / n
+__host__ std::vector<float32_t> twiddleTable(uint32_t n)
+{
+    auto table = std::vector<float32_t>(2u * n);
+    for(uint32_t j = 0; j < n; j++)
+    {
+        auto angle   = -2.0 * M_PI * static_cast<double>(j) / static_cast<double>(n);
+        table[j]     = static_cast<float32_t>(std::cos(angle));
+        table[n + j] = static_cast<float32_t>(std::sin(angle));
+    }
+    return table;
+}
+
+// Calls func with the compile-time size n
+template <typename FuncT>
+__host__ void dispatchSize(uint32_t n, FuncT&& func)
+{
+    switch(n)
+    {
+    case 64u:
+        return func(std::integral_constant<uint32_t, 64u>{});
+    case 128u:
+        return func(std::integral_constant<uint32_t, 128u>{});
+    case 256u:
+        return func(std::integral_constant<uint32_t, 256u>{});
+    case 512u:
+        return func(std::integral_constant<uint32_t, 512u>{});
+    case 1024u:
+        return func(std::integral_constant<uint32_t, 1024u>{});
+    case 2048u:
+        return func(std::integral_constant<uint32_t, 2048u>{});
+    case 4096u:
+        return func(std::integral_constant<uint32_t, 4096u>{});
+    default:
+        std::cout << "Unsupported size!\n";
+    }
+}
+
+// Launches the FFT of signals of length n, in batches of signals.
+template <typename InputT, typename OutputT>
+__host__ void launchFft(uint32_t         n,
+                        uint32_t         signals,
+                        uint32_t         batches,
+                        InputT const*    x,
+                        OutputT*         X,
+                        float32_t const* twiddles,
+                        FftLayout        inLayout,
+                        FftLayout        outLayout)
+{
+    dispatchSize(n, [&](auto size) {
+        constexpr uint32_t N = decltype(size)::value;
+        hipExtLaunchKernelGGL((fft_rocwmma_d<N, InputT, OutputT>),
+                              dim3(signals / signalsPerBlock(N), batches),
+                              dim3(T_BLOCK_X),
+                              0, // sharedMemBytes
+                              0, // stream
+                              nullptr, // Event start
+                              nullptr, // event stop
+                              0, // flags
+                              x,
+                              X,
+                              twiddles,
+                              inLayout,
+                              outLayout);
+    });
+}
+
+// Batched 1D FFTs of length n1 (n0 == 1), or batched 2D FFTs of n0 x n1 row-major images.
+template <typename InputT>
+__host__ void fft_test(char const* typeName, uint32_t n0, uint32_t n1, uint32_t batch)
+{
+    auto is2d      = n0 > 1u;
+    auto imageSize = static_cast<size_t>(n0) * n1;
+    auto planeSize = imageSize * batch;
+
+    // Bounds check
+    auto supported = [](uint32_t n) { return n >= 64u && n <= 4096u && (n & (n - 1u)) == 0u; };
+    if(!supported(n1) || (is2d && !supported(n0)) || (!is2d && batch % signalsPerBlock(n1)))
+    {
+        std::cout << "Unsupported size!\n";
+        return;
+    }
+
+    // Random complex values in [-1, 1], exactly representable in InputT
+    auto gen  = std::mt19937(5489u);
+    auto dist = std::uniform_real_distribution<float32_t>(-1.0f, 1.0f);
+
+    auto signal = std::vector<InputT>(2u * planeSize);
+    for(auto& value : signal)
+    {
+        value = static_cast<InputT>(dist(gen));
+    }
+
+    auto result = std::vector<float32_t>(2u * planeSize);
+
+    // Allocate and copy device memory
+    InputT*    d_x;
+    InputT*    d_tmp;
+    float32_t* d_X;
+    float32_t* d_twiddles0;
+    float32_t* d_twiddles1;
+
+    auto twiddles0 = twiddleTable(n0);
+    auto twiddles1 = twiddleTable(n1);
+
+    const size_t bytesX   = signal.size() * sizeof(InputT);
+    const size_t bytesOut = result.size() * sizeof(float32_t);
+
+    CHECK_HIP_ERROR(hipMalloc(&d_x, bytesX));
+    CHECK_HIP_ERROR(hipMalloc(&d_tmp, bytesX));
+    CHECK_HIP_ERROR(hipMalloc(&d_X, bytesOut));
+    CHECK_HIP_ERROR(hipMalloc(&d_twiddles0, twiddles0.size() * sizeof(float32_t)));
+    CHECK_HIP_ERROR(hipMalloc(&d_twiddles1, twiddles1.size() * sizeof(float32_t)));
+
+    CHECK_HIP_ERROR(hipMemcpy(d_x, signal.data(), bytesX, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_twiddles0,
+                              twiddles0.data(),
+                              twiddles0.size() * sizeof(float32_t),
+                              hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_twiddles1,
+                              twiddles1.data(),
+                              twiddles1.size() * sizeof(float32_t),
+                              hipMemcpyHostToDevice));
+
+    auto fftKernel = [&]() {
+        if(is2d)
+        {
+            // Rows: n0 signals of n1 points per image, then columns: n1 signals of n0 points
+            auto rows = FftLayout{1u, n1, static_cast<uint32_t>(imageSize), planeSize};
+            auto cols = FftLayout{n1, 1u, static_cast<uint32_t>(imageSize), planeSize};
+            launchFft(n1, n0, batch, d_x, d_tmp, d_twiddles1, rows, rows);
+            launchFft(n0, n1, batch, d_tmp, d_X, d_twiddles0, cols, cols);
+        }
+        else
+        {
+            auto layout = FftLayout{1u, n1, 0u, planeSize};
+            launchFft(n1, batch, 1u, d_x, d_X, d_twiddles1, layout, layout);
+        }
+    };
+
+    // Runs are timed individually, with warm caches
+    BenchmarkHarness harness;
+
+    // Fill outputs with NaN to catch contamination
+    CHECK_HIP_ERROR(hipMemset(d_X, 0xFF, bytesOut));
+
+    auto stats = harness.run(fftKernel);
+
+    // FFT flops by convention: 5 N log2(N) per transform
+    auto points = static_cast<double>(imageSize);
+    auto gFlops = 5.0 * points * std::log2(points) * batch * 1.0e-9;
+
+    std::cout << typeName << ", " << (is2d ? "2D" : "1D") << ", " << n0 << ", " << n1 << ", "
+              << batch << ", " << stats.mMedianMs << ", " << gFlops / stats.mMedianMs << ", ";
+    BenchmarkHarness::printStats(std::cout, stats) << std::endl;
+
+#if !NDEBUG
+    // Bring kernel result back to host
+    CHECK_HIP_ERROR(hipMemcpy(result.data(), d_X, bytesOut, hipMemcpyDeviceToHost));
+
+    auto ref = std::vector<std::complex<double>>(planeSize);
+    for(size_t i = 0; i < planeSize; i++)
+    {
+        ref[i] = {static_cast<double>(static_cast<float32_t>(signal[i])),
+                  static_cast<double>(static_cast<float32_t>(signal[planeSize + i]))};
+    }
+
+#pragma omp parallel for
+    for(int b = 0; b < batch; b++)
+    {
+        auto* image = ref.data() + b * imageSize;
+        for(uint32_t r = 0; r < n0; r++)
+        {
+            fft_cpu_h(image + r * n1, n1, 1u);
+        }
+        if(is2d)
+        {
+            for(uint32_t c = 0; c < n1; c++)
+            {
+                fft_cpu_h(image + c, n0, n1);
+            }
+        }
+    }
+
+    // Error relative to the norm of the spectrum, which grows with sqrt(N)
+    auto errSq = 0.0;
+    auto refSq = 0.0;
+    for(size_t i = 0; i < planeSize; i++)
+    {
+        auto value = std::complex<double>(result[i], result[planeSize + i]);
+        errSq += std::norm(value - ref[i]);
+        refSq += std::norm(ref[i]);
+    }
+
+    auto error     = std::sqrt(errSq / refSq);
+    auto eps       = static_cast<float32_t>(std::numeric_limits<InputT>::epsilon());
+    auto tolerance = 10.0 * static_cast<double>(eps);
+
+    std::cout << (error <= tolerance ? "PASSED" : "FAILED")
+              << ", Relative error: " << error << std::endl;
+#endif // !NDEBUG
+
+    // Release device memory
+    CHECK_HIP_ERROR(hipFree(d_x));
+    CHECK_HIP_ERROR(hipFree(d_tmp));
+    CHECK_HIP_ERROR(hipFree(d_X));
+    CHECK_HIP_ERROR(hipFree(d_twiddles0));
+    CHECK_HIP_ERROR(hipFree(d_twiddles1));
+}
+
+template <typename InputT>
+__host__ void fft_tests(char const* typeName)
+{
+    // Batched 1D FFTs of 2^24 points in total
+    for(uint32_t n : {64u, 128u, 256u, 512u, 1024u, 2048u, 4096u})
+    {
+        fft_test<InputT>(typeName, 1u, n, (1u << 24) / n);
+    }
+
+    // Batched 2D FFTs
+    fft_test<InputT>(typeName, 256u, 256u, 64u);
+    fft_test<InputT>(typeName, 1024u, 1024u, 4u);
+    fft_test<InputT>(typeName, 64u, 4096u, 16u);
+}
+
+int main()
+{
+    std::cout << "Type, Dims, N0, N1, Batch, elapsedMs, GFlops/s, "
+              << BenchmarkHarness::statsHeader() << std::endl;
+
+    fft_tests<float16_t>("hfft");
+    fft_tests<bfloat16_t>("bf16fft");
+    if(isF32Supported())
+    {
+        fft_tests<float32_t>("sfft");
+    }
+
+    std::cout << "Finished!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,1729 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <type_traits>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_fp16.h>
+#include <hip/hip_runtime.h>
+
+#include <rocwmma/rocwmma.hpp>
+#include <rocwmma/rocwmma_epilogue.hpp>
+#include <rocwmma/rocwmma_transforms.hpp>
+
+#include "benchmark_harness.hpp"
+#include "common.hpp"
+
+/* Motivation
+*
+* Scaled dot-product attention over a batch of heads is:
+*
+* O = softmax(scale * Q x K^T) x V, where
+*
+* Q, K, V = input tiles of S x D (S = sequence length, D = head dimension)
+* O = final output tile, S x D
+* scale = 1 / sqrt(D)
+*
+* The unfused formulation runs two GEMMs and a softmax kernel, and the full
+* S x S score matrix is written to and read back from global memory twice.
+* For long sequences this score traffic dominates, even though every score
+* is consumed exactly once.
+*
+* The fused kernel in this sample never materializes the score matrix in global
+* memory. Each wave owns a block of ROCWMMA_M query rows and marches through the
+* keys in blocks of BLOCK_KV, keeping its output tile O in accumulator registers.
+* The softmax is computed online: a running row max m and a running row sum l are
+* carried across key blocks, and the partial output is rescaled whenever the row
+* max grows:
+*
+*   S_j   = scale * Q x K_j^T
+*   m_new = max(m, rowmax(S_j))
+*   P_j   = exp(S_j - m_new)
+*   l     = l * exp(m - m_new) + rowsum(P_j)
+*   O     = O * exp(m - m_new) + P_j x V_j
+*   m     = m_new
+*
+* and finally O = O / l. Row max and row sum are computed with the fragment
+* reductions reduce_rows<reduce::Max> and reduce_rows<reduce::Sum>, which leave
+* the result broadcast across each row so that it is co-indexed with the score
+* and output accumulators.
+*
+* Key and value blocks are shared by all waves in the workgroup and are staged
+* through double buffered LDS: while the current block is consumed from LDS, the
+* next block is prefetched from global memory into registers and written to the
+* other LDS buffer afterwards. The probability block P_j of each wave is converted
+* to fp16 and staged through a small private LDS region, so it can be re-loaded
+* in the matrix_a layout for the P_j x V_j product.
+*
+* Exponentials are evaluated in base 2, with log2(e) folded into the scale.
+*
+* Masked attention
+*
+* With a causal mask, query row r only attends to keys c <= r. A sliding window
+* additionally limits it to keys r - c < window. Instead of computing the full
+* score matrix and discarding masked scores, each workgroup only visits the key
+* blocks that intersect its allowed region:
+*
+*   kvBegin = max(0, rowBegin - window + 1) / BLOCK_KV
+*   kvEnd   = ceil(rowEnd / BLOCK_KV)
+*
+* Key blocks fully inside the allowed region of a wave are used as is. Only the
+* blocks crossing the diagonal or the window edge apply the element mask with
+* the epilogue::AttentionMask stage, and waves whose rows are fully masked for a
+* block skip its products. The online softmax tolerates rows that have not seen
+* any unmasked score yet.
+*
+* The work of a causal query tile grows with its row, so the triangular workload
+* is balanced by dispatching the query tiles in reverse: the longest tiles start
+* first and the short ones fill the tail of the grid.
+*
+* Variable length batches
+*
+* Serving batches hold sequences of different lengths. Rather than padding them
+* all to the longest, the sequences are packed back to back and described by
+* cumulative offsets cuSeqLens (cu_seqlens): sequence i occupies the rows
+* [cuSeqLens[i], cuSeqLens[i + 1]). A prefix sum of the query tile count of each
+* sequence is computed on the device, and each workgroup finds its (sequence,
+* query tile) pair with a binary search, as in the grouped GEMM sample:
+*
+*   Sequences:     S0 (3 tiles)   S1 (1 tile)   S2 (2 tiles)
+*   Tile offsets:  [0, 3, 4, 6]
+*   Workgroups:    | 0  1  2 | 3 | 4  5 |
+*
+* Sequence lengths need not be multiples of the tile sizes. At the ragged end of
+* a sequence, query and output fragments use load_matrix_bounded_sync and
+* store_matrix_bounded_sync, key and value rows are zero-filled, and the scores
+* of keys past the sequence are masked with epilogue::AttentionMask.
+*
+* Grouped-query attention
+*
+* In grouped-query attention (GQA) each group of consecutive query heads shares
+* a single K / V head, and multi-query attention (MQA) is the case of a single
+* K / V head for all query heads. A per-head kernel stages the same K / V blocks
+* once for every query head of the group. The grouped kernel instead computes
+* HEADS query heads of a group per workgroup: each K / V block is staged in LDS
+* once, and every wave runs the products of all HEADS query heads against it,
+* dividing the K / V traffic by HEADS:
+*
+*   for each K / V block j (LDS):
+*     for each query head h:
+*       S_hj = scale * Q_h x K_j^T; online softmax of m_h, l_h and O_h
+*       O_h += P_hj x V_j
+*
+* Each wave holds the Q block, output tile, running max and running sum of every
+* head in registers, so HEADS is limited to a few heads. Larger groups are split
+* across several workgroups, and the P staging region of each wave is re-used by
+* the heads in turn.
+*
+* Flow per workgroup:
+*
+*       Start
+*         |
+*   Load Q fragments (registers)
+*         |
+*   Global read K_0, V_0; Local write buffer0
+*         |
+*   loop -->  Global read K_j+1, V_j+1 (prefetch)
+*   |         |
+*   |    S_j = scale * Q x K_j^T (LDS)
+*   |         |
+*   |    Online softmax update of m, l and O
+*   |         |
+*   |    Local write P_j; O += P_j x V_j (LDS)
+*   |         |
+*   |    Local write K_j+1, V_j+1 to other buffer
+*   |         |
+*   end_loop <-
+*         |
+*   O = O / l; Write O
+*         |
+*         v
+*        End
+*
+* Lds Mapping
+*
+* K and V blocks are stored row major (BLOCK_KV rows of D elements), with
+* LDS_PADDING extra elements per row to reduce bank conflicts. K fragments are
+* read as col_major matrix_b (K^T), and V fragments as row_major matrix_b.
+*
+* | K_buffer0 | K_buffer1 | V_buffer0 | V_buffer1 | P_wave0 | ... | P_waveN-1 |
+*/
+
+using namespace rocwmma;
+
+///
+/// Parameter configuration
+///
+
+namespace gfx9Params
+{
+    enum kernelParams : uint32_t
+    {
+        ROCWMMA_M = 16u,
+        ROCWMMA_N = 16u,
+        ROCWMMA_K = 16u,
+        WAVES     = 4u,
+        WARP_SIZE = Constants::AMDGCN_WAVE_SIZE_64
+    };
+}
+
+namespace gfx11Params
+{
+    enum kernelParams : uint32_t
+    {
+        ROCWMMA_M = 16u,
+        ROCWMMA_N = 16u,
+        ROCWMMA_K = 16u,
+        WAVES     = 4u,
+        WARP_SIZE = Constants::AMDGCN_WAVE_SIZE_32
+    };
+}
+
+#if(ROCWMMA_ARCH_GFX9)
+using namespace gfx9Params;
+#else
+using namespace gfx11Params;
+#endif // defined(ROCWMMA_ARCH_GFX9)
+
+// Attention geometry
+constexpr uint32_t HEAD_DIM    = 64u;
+constexpr uint32_t BLOCK_KV    = 64u;
+constexpr uint32_t LDS_PADDING = 8u;
+constexpr uint32_t TBLOCK_X    = WAVES * WARP_SIZE;
+
+///
+/// Types and Data Layouts
+///
+
+using InputT   = float16_t;
+using OutputT  = float16_t;
+using ComputeT = float32_t;
+
+///
+/// Fragment types
+///
+
+// Q and P are matrix_a (rows x reduction dim)
+// K^T and V are matrix_b (reduction dim x cols)
+using FragQ   = fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, InputT, row_major>;
+using FragP   = FragQ;
+using FragK   = fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, InputT, col_major>;
+using FragV   = fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, InputT, row_major>;
+using FragAcc = fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, ComputeT>;
+using FragOut = fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, OutputT>;
+
+// Fragment counts of each wave
+constexpr uint32_t Q_BLOCKS = HEAD_DIM / ROCWMMA_K; // Q fragments along D
+constexpr uint32_t S_BLOCKS = BLOCK_KV / ROCWMMA_N; // Score fragments along keys
+constexpr uint32_t P_BLOCKS = BLOCK_KV / ROCWMMA_K; // P fragments along keys
+constexpr uint32_t O_BLOCKS = HEAD_DIM / ROCWMMA_N; // Output fragments along D
+
+// Lds geometry (elements)
+constexpr uint32_t LDS_LD      = HEAD_DIM + LDS_PADDING;
+constexpr uint32_t LDS_KV_SIZE = BLOCK_KV * LDS_LD;
+constexpr uint32_t LDS_P_SIZE  = ROCWMMA_M * BLOCK_KV;
+constexpr uint32_t LDS_USAGE   = sizeof(InputT) * (4u * LDS_KV_SIZE + WAVES * LDS_P_SIZE);
+
+// Global K / V blocks are moved in 16 byte chunks
+constexpr uint32_t CHUNK_SIZE        = sizeof(uint4) / sizeof(InputT);
+constexpr uint32_t CHUNKS_PER_ROW    = HEAD_DIM / CHUNK_SIZE;
+constexpr uint32_t CHUNKS_PER_THREAD = BLOCK_KV * CHUNKS_PER_ROW / TBLOCK_X;
+
+static_assert(BLOCK_KV * CHUNKS_PER_ROW % TBLOCK_X == 0,
+              "K / V blocks must be evenly divided amongst threads");
+static_assert(LDS_LD % CHUNK_SIZE == 0, "Lds rows must be aligned to chunk size");
+
+///
+/// Wrapper functions
+///
+
+// Global read of one K and V block into registers.
+// K and V blocks are contiguous in global memory (BLOCK_KV full rows).
+// Rows at or past validRows (the ragged end of a sequence) are not read and are zero-filled.
+ROCWMMA_DEVICE static inline void globalReadKV(uint4 (&buffK)[CHUNKS_PER_THREAD],
+                                               uint4 (&buffV)[CHUNKS_PER_THREAD],
+                                               InputT const* k,
+                                               InputT const* v,
+                                               uint32_t      validRows)
+{
+    auto chunksK = reinterpret_cast<uint4 const*>(k);
+    auto chunksV = reinterpret_cast<uint4 const*>(v);
+
+#pragma unroll
+    for(uint32_t i = 0; i < CHUNKS_PER_THREAD; i++)
+    {
+        auto chunk = threadIdx.x + i * TBLOCK_X;
+        bool valid = chunk / CHUNKS_PER_ROW < validRows;
+        buffK[i]   = valid ? chunksK[chunk] : make_uint4(0u, 0u, 0u, 0u);
+        buffV[i]   = valid ? chunksV[chunk] : make_uint4(0u, 0u, 0u, 0u);
+    }
+}
+
+// Local write of one K and V block into padded Lds rows.
+ROCWMMA_DEVICE static inline void localWriteKV(InputT*     ldsK,
+                                               InputT*     ldsV,
+                                               uint4 const (&buffK)[CHUNKS_PER_THREAD],
+                                               uint4 const (&buffV)[CHUNKS_PER_THREAD])
+{
+#pragma unroll
+    for(uint32_t i = 0; i < CHUNKS_PER_THREAD; i++)
+    {
+        auto chunk  = threadIdx.x + i * TBLOCK_X;
+        auto offset = (chunk / CHUNKS_PER_ROW) * LDS_LD + (chunk % CHUNKS_PER_ROW) * CHUNK_SIZE;
+        *reinterpret_cast<uint4*>(ldsK + offset) = buffK[i];
+        *reinterpret_cast<uint4*>(ldsV + offset) = buffV[i];
+    }
+}
+
+// Online softmax update for one block of scores.
+// On return, fragsS holds the un-normalized probabilities P = exp2(S * scaleLog2 - m).
+// The running max, running sum and partial output are rescaled to the new max.
+// All accumulators have the same geometry, so elements of the same index are in the same row.
+ROCWMMA_DEVICE static inline void onlineSoftmax(FragAcc (&fragsS)[S_BLOCKS],
+                                                FragAcc& fragMax,
+                                                FragAcc& fragSum,
+                                                FragAcc (&fragsO)[O_BLOCKS],
+                                                ComputeT scaleLog2)
+{
+    // Row max of the score block
+    FragAcc fragBlockMax;
+#pragma unroll
+    for(uint32_t i = 0; i < FragAcc::num_elements; i++)
+    {
+        auto value = fragsS[0].x[i];
+#pragma unroll
+        for(uint32_t j = 1; j < S_BLOCKS; j++)
+        {
+            value = fmaxf(value, fragsS[j].x[i]);
+        }
+        fragBlockMax.x[i] = value * scaleLog2;
+    }
+    fragBlockMax = reduce_rows<reduce::Max>(fragBlockMax);
+
+    // New running max and the correction factor of previous results.
+    // Rows that are fully masked so far have a max of -inf, so exponents are taken
+    // relative to 0 instead to yield probabilities of 0 rather than NaN.
+    FragAcc fragCorrection, fragExpMax;
+#pragma unroll
+    for(uint32_t i = 0; i < FragAcc::num_elements; i++)
+    {
+        auto newMax         = fmaxf(fragMax.x[i], fragBlockMax.x[i]);
+        bool unseen         = newMax == -std::numeric_limits<ComputeT>::infinity();
+        fragExpMax.x[i]     = unseen ? static_cast<ComputeT>(0) : newMax;
+        fragCorrection.x[i] = exp2f(fragMax.x[i] - fragExpMax.x[i]);
+        fragMax.x[i]        = newMax;
+    }
+
+    // Probabilities and their row sum
+    FragAcc fragBlockSum;
+    fill_fragment(fragBlockSum, static_cast<ComputeT>(0));
+#pragma unroll
+    for(uint32_t j = 0; j < S_BLOCKS; j++)
+    {
+#pragma unroll
+        for(uint32_t i = 0; i < FragAcc::num_elements; i++)
+        {
+            auto p         = exp2f(fragsS[j].x[i] * scaleLog2 - fragExpMax.x[i]);
+            fragsS[j].x[i] = p;
+            fragBlockSum.x[i] += p;
+        }
+    }
+    fragBlockSum = reduce_rows<reduce::Sum>(fragBlockSum);
+
+    // Rescale previous results
+#pragma unroll
+    for(uint32_t i = 0; i < FragAcc::num_elements; i++)
+    {
+        fragSum.x[i] = fragSum.x[i] * fragCorrection.x[i] + fragBlockSum.x[i];
+    }
+
+#pragma unroll
+    for(uint32_t j = 0; j < O_BLOCKS; j++)
+    {
+#pragma unroll
+        for(uint32_t i = 0; i < FragAcc::num_elements; i++)
+        {
+            fragsO[j].x[i] *= fragCorrection.x[i];
+        }
+    }
+}
+
+///
+/// Fused attention kernels
+///
+
+// Attention of one workgroup tile of WAVES * ROCWMMA_M query rows of a sequence, for HEADS
+// query heads sharing the same K / V head (grouped-query attention).
+// q and o point to the first row of the sequence of the first query head, packed
+// [seqLen][HEAD_DIM] row major, and the following heads are qHeadStride elements apart.
+// k and v point to the first row of the sequence of the shared K / V head.
+// Each K / V block is staged in Lds once and consumed by the products of all HEADS query
+// heads, so K / V traffic is divided by HEADS. Every wave keeps the Q block, output tile,
+// running max and running sum of each head in registers, which bounds HEADS in practice.
+// seqLen need not be a multiple of the tile sizes: query and output rows past the sequence
+// are predicated, key and value rows past it are zero-filled and their scores masked.
+// When causal, query rows only attend to keys up to their own position, and a window > 0
+// further limits them to the previous window keys.
+template <uint32_t HEADS>
+ROCWMMA_DEVICE static inline void attentionTile(uint32_t      seqLen,
+                                                uint32_t      qRowBegin,
+                                                InputT const* q,
+                                                InputT const* k,
+                                                InputT const* v,
+                                                OutputT*      o,
+                                                uint64_t      qHeadStride,
+                                                ComputeT      scaleLog2,
+                                                bool          causal,
+                                                uint32_t      window)
+{
+    auto waveIndex = threadIdx.x / WARP_SIZE;
+    auto qRow      = qRowBegin + waveIndex * ROCWMMA_M;
+    auto qRowLast  = qRow + ROCWMMA_M - 1u;
+
+    // Waves past the end of the sequence still take part in the Lds staging
+    bool waveActive = qRow < seqLen;
+
+    q += qRow * HEAD_DIM;
+    o += qRow * HEAD_DIM;
+
+    // Lds buffers
+    HIP_DYNAMIC_SHARED(void*, localMemPtr);
+    auto* ldsK = reinterpret_cast<InputT*>(localMemPtr);
+    auto* ldsV = ldsK + 2u * LDS_KV_SIZE;
+    auto* ldsP = ldsV + 2u * LDS_KV_SIZE + waveIndex * LDS_P_SIZE;
+
+    // Q blocks stay resident for the whole sweep over the keys
+    FragQ fragsQ[HEADS][Q_BLOCKS];
+    if(waveActive)
+    {
+#pragma unroll
+        for(uint32_t h = 0; h < HEADS; h++)
+        {
+#pragma unroll
+            for(uint32_t i = 0; i < Q_BLOCKS; i++)
+            {
+                load_matrix_bounded_sync(fragsQ[h][i],
+                                         q + h * qHeadStride + i * ROCWMMA_K,
+                                         HEAD_DIM,
+                                         seqLen - qRow,
+                                         ROCWMMA_K);
+            }
+        }
+    }
+
+    FragAcc fragsO[HEADS][O_BLOCKS];
+    FragAcc fragMax[HEADS], fragSum[HEADS];
+#pragma unroll
+    for(uint32_t h = 0; h < HEADS; h++)
+    {
+#pragma unroll
+        for(uint32_t i = 0; i < O_BLOCKS; i++)
+        {
+            fill_fragment(fragsO[h][i], static_cast<ComputeT>(0));
+        }
+
+        fill_fragment(fragMax[h], -std::numeric_limits<ComputeT>::infinity());
+        fill_fragment(fragSum[h], static_cast<ComputeT>(0));
+    }
+
+    // Key blocks intersecting the allowed region of the workgroup rows.
+    // Fully masked blocks are never visited.
+    auto kvBegin = 0u;
+    auto kvEnd   = ceilDiv(seqLen, BLOCK_KV);
+    if(causal)
+    {
+        auto qRowEnd = min(qRowBegin + WAVES * ROCWMMA_M, seqLen);
+        kvEnd        = ceilDiv(qRowEnd, BLOCK_KV);
+        kvBegin
+            = (window > 0u && qRowBegin + 1u > window) ? (qRowBegin + 1u - window) / BLOCK_KV : 0u;
+    }
+
+    // Prefetch the first K / V block
+    uint4 buffK[CHUNKS_PER_THREAD];
+    uint4 buffV[CHUNKS_PER_THREAD];
+    auto  beginOffset = kvBegin * BLOCK_KV * HEAD_DIM;
+    globalReadKV(buffK, buffV, k + beginOffset, v + beginOffset, seqLen - kvBegin * BLOCK_KV);
+    localWriteKV(ldsK, ldsV, buffK, buffV);
+
+    synchronize_workgroup();
+
+    for(uint32_t kvBlock = kvBegin; kvBlock < kvEnd; kvBlock++)
+    {
+        auto  current = (kvBlock - kvBegin) % 2u;
+        auto* ldsKCur = ldsK + current * LDS_KV_SIZE;
+        auto* ldsVCur = ldsV + current * LDS_KV_SIZE;
+        bool  hasNext = kvBlock + 1u < kvEnd;
+
+        // Prefetch next K / V block into registers
+        if(hasNext)
+        {
+            auto nextRow = (kvBlock + 1u) * BLOCK_KV;
+            globalReadKV(
+                buffK, buffV, k + nextRow * HEAD_DIM, v + nextRow * HEAD_DIM, seqLen - nextRow);
+        }
+
+        // Position of the key block relative to the mask of this wave's rows.
+        // Waves share the K / V blocks, so fully masked waves only skip the products.
+        auto kvCol      = kvBlock * BLOCK_KV;
+        auto kvColLast  = kvCol + BLOCK_KV - 1u;
+        bool waveMasked = !waveActive
+                          || (causal
+                              && (kvCol > qRowLast || (window > 0u && qRow >= kvColLast + window)));
+        bool boundary   = kvColLast >= seqLen
+                        || (causal
+                            && (kvColLast > qRow || (window > 0u && qRowLast >= kvCol + window)));
+
+        // All heads consume the same K / V block from Lds
+#pragma unroll
+        for(uint32_t h = 0; h < HEADS; h++)
+        {
+            if(!waveMasked)
+            {
+                // S = Q x K^T
+                FragAcc fragsS[S_BLOCKS];
+#pragma unroll
+                for(uint32_t j = 0; j < S_BLOCKS; j++)
+                {
+                    fill_fragment(fragsS[j], static_cast<ComputeT>(0));
+                }
+
+#pragma unroll
+                for(uint32_t i = 0; i < Q_BLOCKS; i++)
+                {
+#pragma unroll
+                    for(uint32_t j = 0; j < S_BLOCKS; j++)
+                    {
+                        FragK fragK;
+                        load_matrix_sync(
+                            fragK, ldsKCur + j * ROCWMMA_N * LDS_LD + i * ROCWMMA_K, LDS_LD);
+                        mma_sync(fragsS[j], fragsQ[h][i], fragK, fragsS[j]);
+                    }
+                }
+
+                // Element masks only on blocks crossing the diagonal, the window edge or the
+                // end of the sequence
+                if(boundary)
+                {
+#pragma unroll
+                    for(uint32_t j = 0; j < S_BLOCKS; j++)
+                    {
+                        auto blockCoord = make_coord2d(qRow, kvCol + j * ROCWMMA_N);
+                        apply_epilogue(
+                            fragsS[j],
+                            fragsS[j],
+                            epilogue::AttentionMask<FragAcc>(blockCoord, causal, window, seqLen));
+                    }
+                }
+
+                onlineSoftmax(fragsS, fragMax[h], fragSum[h], fragsO[h], scaleLog2);
+
+                // Stage P in the private Lds region of this wave
+#pragma unroll
+                for(uint32_t j = 0; j < S_BLOCKS; j++)
+                {
+                    FragOut fragP;
+                    apply_epilogue(fragP, fragsS[j]);
+                    store_matrix_sync(ldsP + j * ROCWMMA_N, fragP, BLOCK_KV, mem_row_major);
+                }
+            }
+
+            synchronize_workgroup();
+
+            if(!waveMasked)
+            {
+                // O += P x V
+#pragma unroll
+                for(uint32_t i = 0; i < P_BLOCKS; i++)
+                {
+                    FragP fragP;
+                    load_matrix_sync(fragP, ldsP + i * ROCWMMA_K, BLOCK_KV);
+#pragma unroll
+                    for(uint32_t j = 0; j < O_BLOCKS; j++)
+                    {
+                        FragV fragV;
+                        load_matrix_sync(
+                            fragV, ldsVCur + i * ROCWMMA_K * LDS_LD + j * ROCWMMA_N, LDS_LD);
+                        mma_sync(fragsO[h][j], fragP, fragV, fragsO[h][j]);
+                    }
+                }
+            }
+
+            // The P region of this wave is re-used by the next head
+            if(h + 1u < HEADS)
+            {
+                synchronize_workgroup();
+            }
+        }
+
+        // The other buffer was last read in the previous iteration
+        if(hasNext)
+        {
+            localWriteKV(ldsK + (1u - current) * LDS_KV_SIZE,
+                         ldsV + (1u - current) * LDS_KV_SIZE,
+                         buffK,
+                         buffV);
+        }
+
+        synchronize_workgroup();
+    }
+
+    if(waveActive)
+    {
+#pragma unroll
+        for(uint32_t h = 0; h < HEADS; h++)
+        {
+            // O = O / l
+            FragAcc fragInvSum;
+#pragma unroll
+            for(uint32_t i = 0; i < FragAcc::num_elements; i++)
+            {
+                fragInvSum.x[i] = static_cast<ComputeT>(1) / fragSum[h].x[i];
+            }
+
+#pragma unroll
+            for(uint32_t j = 0; j < O_BLOCKS; j++)
+            {
+                FragOut fragOut;
+                apply_epilogue(fragOut, fragsO[h][j], epilogue::Scale(fragInvSum));
+                store_matrix_bounded_sync(o + h * qHeadStride + j * ROCWMMA_N,
+                                          fragOut,
+                                          HEAD_DIM,
+                                          seqLen - qRow,
+                                          ROCWMMA_N,
+                                          mem_row_major);
+            }
+        }
+    }
+}
+
+/// Q, K, V and O are packed [batch][seqLen][HEAD_DIM] row major.
+/// Grid: (seqLen / (WAVES * ROCWMMA_M), batch), Block: (TBLOCK_X)
+__global__ void __launch_bounds__(256) flash_attention_d(uint32_t      seqLen,
+                                                         InputT const* q,
+                                                         InputT const* k,
+                                                         InputT const* v,
+                                                         OutputT*      o,
+                                                         ComputeT      scaleLog2,
+                                                         bool          causal,
+                                                         uint32_t      window)
+{
+    if constexpr(!ROCWMMA_ARCH_HOST)
+    {
+        // Causal tiles are dispatched longest first
+        auto qTile       = causal ? gridDim.x - 1u - blockIdx.x : blockIdx.x;
+        auto batchOffset = static_cast<uint64_t>(blockIdx.y) * seqLen * HEAD_DIM;
+
+        attentionTile<1u>(seqLen,
+                          qTile * WAVES * ROCWMMA_M,
+                          q + batchOffset,
+                          k + batchOffset,
+                          v + batchOffset,
+                          o + batchOffset,
+                          0u,
+                          scaleLog2,
+                          causal,
+                          window);
+    }
+}
+
+/// Grouped-query attention: groupSize consecutive query heads share each K / V head.
+/// Q and O are packed [batch][kvHeads * groupSize][seqLen][HEAD_DIM] and K and V
+/// [batch][kvHeads][seqLen][HEAD_DIM] row major. Multi-query attention is kvHeads = 1.
+/// Each workgroup computes HEADS query heads of a group, which must divide groupSize.
+/// HEADS = 1 is the per-head kernel, which reloads each K / V block for every query head.
+/// Grid: (seqLen / (WAVES * ROCWMMA_M), kvHeads * groupSize / HEADS, batch), Block: (TBLOCK_X)
+template <uint32_t HEADS>
+__global__ void __launch_bounds__(256) flash_attention_gqa_d(uint32_t      seqLen,
+                                                             uint32_t      groupSize,
+                                                             InputT const* q,
+                                                             InputT const* k,
+                                                             InputT const* v,
+                                                             OutputT*      o,
+                                                             ComputeT      scaleLog2,
+                                                             bool          causal)
+{
+    if constexpr(!ROCWMMA_ARCH_HOST)
+    {
+        // Causal tiles are dispatched longest first
+        auto qTile  = causal ? gridDim.x - 1u - blockIdx.x : blockIdx.x;
+        auto qHead  = blockIdx.y * HEADS;
+        auto kvHead = blockIdx.z * (gridDim.y * HEADS / groupSize) + qHead / groupSize;
+
+        auto headSize = static_cast<uint64_t>(seqLen) * HEAD_DIM;
+        auto qOffset  = (static_cast<uint64_t>(blockIdx.z) * gridDim.y * HEADS + qHead) * headSize;
+        auto kvOffset = static_cast<uint64_t>(kvHead) * headSize;
+
+        attentionTile<HEADS>(seqLen,
+                             qTile * WAVES * ROCWMMA_M,
+                             q + qOffset,
+                             k + kvOffset,
+                             v + kvOffset,
+                             o + qOffset,
+                             headSize,
+                             scaleLog2,
+                             causal,
+                             0u);
+    }
+}
+
+// Exclusive prefix sum of the query tile counts of the sequences.
+// cuSeqLens holds the batch + 1 cumulative sequence offsets (cu_seqlens), and
+// qTileOffsets receives batch + 1 entries; the last entry is the total tile count.
+// The batch is expected to be small, so a single thread suffices.
+__global__ void varlen_tile_offsets_d(uint32_t const* cuSeqLens,
+                                      uint32_t        batch,
+                                      uint32_t*       qTileOffsets)
+{
+    if(blockIdx.x == 0 && threadIdx.x == 0)
+    {
+        uint32_t offset = 0u;
+        for(uint32_t i = 0; i < batch; ++i)
+        {
+            qTileOffsets[i] = offset;
+            offset += ceilDiv(cuSeqLens[i + 1u] - cuSeqLens[i], WAVES * ROCWMMA_M);
+        }
+        qTileOffsets[batch] = offset;
+    }
+}
+
+// Finds the sequence of the given tile index in the prefix sum:
+// largest i such that qTileOffsets[i] <= tileIndex.
+ROCWMMA_DEVICE static inline uint32_t
+    findSequence(uint32_t const* qTileOffsets, uint32_t batch, uint32_t tileIndex)
+{
+    uint32_t lo = 0u;
+    uint32_t hi = batch;
+    while(hi - lo > 1u)
+    {
+        auto mid = (lo + hi) / 2u;
+        if(qTileOffsets[mid] <= tileIndex)
+        {
+            lo = mid;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/// Variable length (ragged) batch of sequences, without padding.
+/// Q, K, V and O are packed [totalTokens][HEAD_DIM] row major, and sequence i
+/// occupies rows [cuSeqLens[i], cuSeqLens[i + 1]).
+/// Grid: (maxTiles), Block: (TBLOCK_X), where maxTiles is any upper bound of the
+/// total tile count, e.g. ceil(totalTokens / (WAVES * ROCWMMA_M)) + batch.
+/// Workgroups are mapped to (sequence, query tile) pairs by searching qTileOffsets,
+/// and workgroups past the total tile count exit.
+__global__ void __launch_bounds__(256) flash_attention_varlen_d(uint32_t const* cuSeqLens,
+                                                                uint32_t const* qTileOffsets,
+                                                                uint32_t        batch,
+                                                                InputT const*   q,
+                                                                InputT const*   k,
+                                                                InputT const*   v,
+                                                                OutputT*        o,
+                                                                ComputeT        scaleLog2,
+                                                                bool            causal,
+                                                                uint32_t        window)
+{
+    if constexpr(!ROCWMMA_ARCH_HOST)
+    {
+        auto totalTiles = qTileOffsets[batch];
+
+        // Causal tiles are dispatched longest first: tile indices are reversed so that
+        // the last tile of each sequence comes before its first.
+        auto tileIndex = blockIdx.x;
+        if(tileIndex >= totalTiles)
+        {
+            return;
+        }
+        tileIndex = causal ? totalTiles - 1u - tileIndex : tileIndex;
+
+        auto sequence = findSequence(qTileOffsets, batch, tileIndex);
+        auto qTile    = tileIndex - qTileOffsets[sequence];
+        auto rowBegin = static_cast<uint64_t>(cuSeqLens[sequence]) * HEAD_DIM;
+
+        attentionTile<1u>(cuSeqLens[sequence + 1u] - cuSeqLens[sequence],
+                          qTile * WAVES * ROCWMMA_M,
+                          q + rowBegin,
+                          k + rowBegin,
+                          v + rowBegin,
+                          o + rowBegin,
+                          0u,
+                          scaleLog2,
+                          causal,
+                          window);
+    }
+}
+
+///
+/// Unfused attention kernels
+///
+
+// Batched D = alpha * A x B, one wave per ROCWMMA_M x ROCWMMA_N output block.
+// A and D are row major, batches are indexed by blockIdx.z.
+template <typename LayoutB>
+__global__ void gemm_batched_d(uint32_t      m,
+                               uint32_t      n,
+                               uint32_t      k,
+                               InputT const* a,
+                               InputT const* b,
+                               OutputT*      d,
+                               uint32_t      lda,
+                               uint32_t      ldb,
+                               uint32_t      ldd,
+                               uint64_t      strideA,
+                               uint64_t      strideB,
+                               uint64_t      strideD,
+                               ComputeT      alpha)
+{
+    if constexpr(!ROCWMMA_ARCH_HOST)
+    {
+        using FragA = fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, InputT, row_major>;
+        using FragB = fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, InputT, LayoutB>;
+
+        auto cRow = (blockIdx.x * blockDim.x + threadIdx.x) / WARP_SIZE * ROCWMMA_M;
+        auto cCol = (blockIdx.y * blockDim.y + threadIdx.y) * ROCWMMA_N;
+
+        if(cRow < m && cCol < n)
+        {
+            a += blockIdx.z * strideA;
+            b += blockIdx.z * strideB;
+            d += blockIdx.z * strideD;
+
+            FragAcc fragAcc;
+            fill_fragment(fragAcc, static_cast<ComputeT>(0));
+
+            for(uint32_t i = 0; i < k; i += ROCWMMA_K)
+            {
+                auto offsetB = std::is_same_v<LayoutB, row_major> ? (i * ldb + cCol)
+                                                                  : (cCol * ldb + i);
+                FragA fragA;
+                FragB fragB;
+                load_matrix_sync(fragA, a + (cRow * lda + i), lda);
+                load_matrix_sync(fragB, b + offsetB, ldb);
+                mma_sync(fragAcc, fragA, fragB, fragAcc);
+            }
+
+            FragOut fragD;
+#pragma unroll
+            for(uint32_t i = 0; i < fragD.num_elements; i++)
+            {
+                fragD.x[i] = static_cast<OutputT>(alpha * fragAcc.x[i]);
+            }
+            store_matrix_sync(d + (cRow * ldd + cCol), fragD, ldd, mem_row_major);
+        }
+    }
+}
+
+// In-place row softmax, one wave per row.
+__global__ void softmax_rows_d(uint32_t n, OutputT* s, uint32_t lds)
+{
+    if constexpr(!ROCWMMA_ARCH_HOST)
+    {
+        auto row  = blockIdx.x * (blockDim.x / WARP_SIZE) + threadIdx.x / WARP_SIZE;
+        auto lane = threadIdx.x % WARP_SIZE;
+
+        s += static_cast<uint64_t>(row) * lds;
+
+        auto rowMax = -std::numeric_limits<ComputeT>::infinity();
+        for(uint32_t i = lane; i < n; i += WARP_SIZE)
+        {
+            rowMax = fmaxf(rowMax, static_cast<ComputeT>(s[i]));
+        }
+        for(uint32_t offset = WARP_SIZE / 2u; offset > 0u; offset /= 2u)
+        {
+            rowMax = fmaxf(rowMax, __shfl_xor(rowMax, offset));
+        }
+
+        auto rowSum = static_cast<ComputeT>(0);
+        for(uint32_t i = lane; i < n; i += WARP_SIZE)
+        {
+            rowSum += expf(static_cast<ComputeT>(s[i]) - rowMax);
+        }
+        for(uint32_t offset = WARP_SIZE / 2u; offset > 0u; offset /= 2u)
+        {
+            rowSum += __shfl_xor(rowSum, offset);
+        }
+
+        for(uint32_t i = lane; i < n; i += WARP_SIZE)
+        {
+            s[i] = static_cast<OutputT>(expf(static_cast<ComputeT>(s[i]) - rowMax) / rowSum);
+        }
+    }
+}
+
+///
+/// Host reference
+///
+
+__host__ static inline void fillRandNormalized(InputT* mat, uint32_t size)
+{
+    // Small values in [-1, 1] keep the scores in a realistic range
+#pragma omp parallel for
+    for(int i = 0; i < size; ++i)
+    {
+        mat[i] = static_cast<InputT>(static_cast<float>(rand() % 17 - 8) / 8.0f);
+    }
+}
+
+// Keys attended to by a query row: all of them, or when causal, those up to the
+// query position and within the window (window = 0 is unbounded).
+__host__ static inline bool
+    attends_h(uint32_t queryPos, uint32_t keyPos, bool causal, uint32_t window)
+{
+    return !causal || (keyPos <= queryPos && (window == 0u || queryPos - keyPos < window));
+}
+
+// Sequence i occupies rows [cuSeqLens[i], cuSeqLens[i + 1]) of Q, K, V and O.
+__host__ void attention_cpu_h(uint32_t const* cuSeqLens,
+                              uint32_t        batch,
+                              InputT const*   q,
+                              InputT const*   k,
+                              InputT const*   v,
+                              OutputT*        o,
+                              ComputeT        scale,
+                              bool            causal,
+                              uint32_t        window)
+{
+#pragma omp parallel for
+    for(int row = 0; row < cuSeqLens[batch]; ++row)
+    {
+        auto sequence = std::upper_bound(cuSeqLens, cuSeqLens + batch + 1, row) - cuSeqLens - 1;
+        auto seqBegin = cuSeqLens[sequence];
+        auto seqLen   = cuSeqLens[sequence + 1] - seqBegin;
+
+        auto batchOffset = static_cast<uint64_t>(seqBegin) * HEAD_DIM;
+        auto qRow        = q + static_cast<uint64_t>(row) * HEAD_DIM;
+        auto queryPos    = static_cast<uint32_t>(row) - seqBegin;
+
+        // Masked scores have a probability of 0
+        std::vector<ComputeT> scores(seqLen, -std::numeric_limits<ComputeT>::infinity());
+        auto                  rowMax = -std::numeric_limits<ComputeT>::infinity();
+        for(uint32_t j = 0; j < seqLen; ++j)
+        {
+            if(!attends_h(queryPos, j, causal, window))
+            {
+                continue;
+            }
+
+            auto kRow = k + batchOffset + j * HEAD_DIM;
+            auto acc  = static_cast<ComputeT>(0);
+            for(uint32_t d = 0; d < HEAD_DIM; ++d)
+            {
+                acc += static_cast<ComputeT>(qRow[d]) * static_cast<ComputeT>(kRow[d]);
+            }
+            scores[j] = acc * scale;
+            rowMax    = std::max(rowMax, scores[j]);
+        }
+
+        auto rowSum = static_cast<ComputeT>(0);
+        for(auto& s : scores)
+        {
+            s = std::exp(s - rowMax);
+            rowSum += s;
+        }
+
+        for(uint32_t d = 0; d < HEAD_DIM; ++d)
+        {
+            auto acc = static_cast<ComputeT>(0);
+            for(uint32_t j = 0; j < seqLen; ++j)
+            {
+                acc += scores[j] * static_cast<ComputeT>(v[batchOffset + j * HEAD_DIM + d]);
+            }
+            o[static_cast<uint64_t>(row) * HEAD_DIM + d] = static_cast<OutputT>(acc / rowSum);
+        }
+    }
+}
+
+ROCWMMA_HOST void attention_test(uint32_t batch, uint32_t seqLen, bool causal, uint32_t window)
+{
+    // Runtime checks for host parameters
+    uint32_t hWAVES     = isGfx9() ? gfx9Params::WAVES : gfx11Params::WAVES;
+    uint32_t hROCWMMA_M = isGfx9() ? gfx9Params::ROCWMMA_M : gfx11Params::ROCWMMA_M;
+    uint32_t hROCWMMA_N = isGfx9() ? gfx9Params::ROCWMMA_N : gfx11Params::ROCWMMA_N;
+    uint32_t hROCWMMA_K = isGfx9() ? gfx9Params::ROCWMMA_K : gfx11Params::ROCWMMA_K;
+
+    // Runtime warp calculation (host code needs to query warpsize dynamically)
+    auto warpSize = getWarpSize();
+
+    if((isGfx11() || isGfx12()) && getWarpSize() != Constants::AMDGCN_WAVE_SIZE_32)
+    {
+        std::cout << "Unsupported wave size!\n";
+        return;
+    }
+
+    if(isGfx9() && getWarpSize() != Constants::AMDGCN_WAVE_SIZE_64)
+    {
+        std::cout << "Unsupported wave size!\n";
+        return;
+    }
+
+    // Bounds check
+    if(seqLen % BLOCK_KV || seqLen % (hWAVES * hROCWMMA_M))
+    {
+        std::cout << "Unsupported sequence length!\n";
+        return;
+    }
+
+    auto scale     = static_cast<ComputeT>(1.0 / std::sqrt(static_cast<double>(HEAD_DIM)));
+    auto scaleLog2 = static_cast<ComputeT>(scale * M_LOG2E);
+
+    std::cout << "Initializing host data..." << std::endl;
+
+    const size_t elementsQKV = static_cast<size_t>(batch) * seqLen * HEAD_DIM;
+    const size_t elementsS   = static_cast<size_t>(batch) * seqLen * seqLen;
+
+    std::vector<InputT> matrixQ(elementsQKV);
+    std::vector<InputT> matrixK(elementsQKV);
+    std::vector<InputT> matrixV(elementsQKV);
+
+    // Fill outputs with NaN to catch contamination
+    std::vector<OutputT> matrixO(elementsQKV, std::numeric_limits<OutputT>::signaling_NaN());
+
+    fillRandNormalized(matrixQ.data(), elementsQKV);
+    fillRandNormalized(matrixK.data(), elementsQKV);
+    fillRandNormalized(matrixV.data(), elementsQKV);
+
+    std::cout << "Initializing device data..." << std::endl;
+
+    InputT*  d_q;
+    InputT*  d_k;
+    InputT*  d_v;
+    OutputT* d_o;
+    OutputT* d_s;
+
+    const size_t bytesQKV = elementsQKV * sizeof(InputT);
+    const size_t bytesS   = elementsS * sizeof(OutputT);
+
+    CHECK_HIP_ERROR(hipMalloc(&d_q, bytesQKV));
+    CHECK_HIP_ERROR(hipMalloc(&d_k, bytesQKV));
+    CHECK_HIP_ERROR(hipMalloc(&d_v, bytesQKV));
+    CHECK_HIP_ERROR(hipMalloc(&d_o, bytesQKV));
+    CHECK_HIP_ERROR(hipMalloc(&d_s, bytesS));
+
+    CHECK_HIP_ERROR(hipMemcpy(d_q, matrixQ.data(), bytesQKV, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_k, matrixK.data(), bytesQKV, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_v, matrixV.data(), bytesQKV, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_o, matrixO.data(), bytesQKV, hipMemcpyHostToDevice));
+
+    // Fused kernel: one wave per ROCWMMA_M query rows
+    auto fusedBlockDim = dim3(hWAVES * warpSize);
+    auto fusedGridDim  = dim3(seqLen / (hWAVES * hROCWMMA_M), batch);
+
+    auto fusedKernel = [&]() {
+        hipExtLaunchKernelGGL(flash_attention_d,
+                              fusedGridDim,
+                              fusedBlockDim,
+                              LDS_USAGE,
+                              0,
+                              nullptr,
+                              nullptr,
+                              0,
+                              seqLen,
+                              d_q,
+                              d_k,
+                              d_v,
+                              d_o,
+                              scaleLog2,
+                              causal,
+                              window);
+    };
+
+    // Unfused kernels: S = scale * Q x K^T, P = softmax(S), O = P x V
+    // The score matrix round-trips through global memory.
+    auto gemmBlockDim = dim3(4u * warpSize, 4u);
+    auto gemmGridDim  = [&](uint32_t m, uint32_t n) {
+        return dim3(rocwmma::ceilDiv(m, hROCWMMA_M * gemmBlockDim.x / warpSize),
+                    rocwmma::ceilDiv(n, hROCWMMA_N * gemmBlockDim.y),
+                    batch);
+    };
+    auto softmaxBlockDim = dim3(4u * warpSize);
+    auto softmaxGridDim  = dim3(batch * seqLen / 4u);
+
+    const uint64_t strideQKV = static_cast<uint64_t>(seqLen) * HEAD_DIM;
+    const uint64_t strideS   = static_cast<uint64_t>(seqLen) * seqLen;
+
+    auto unfusedKernel = [&]() {
+        hipExtLaunchKernelGGL(gemm_batched_d<col_major>,
+                              gemmGridDim(seqLen, seqLen),
+                              gemmBlockDim,
+                              0,
+                              0,
+                              nullptr,
+                              nullptr,
+                              0,
+                              seqLen,
+                              seqLen,
+                              HEAD_DIM,
+                              d_q,
+                              d_k,
+                              d_s,
+                              HEAD_DIM,
+                              HEAD_DIM,
+                              seqLen,
+                              strideQKV,
+                              strideQKV,
+                              strideS,
+                              scale);
+        hipExtLaunchKernelGGL(softmax_rows_d,
+                              softmaxGridDim,
+                              softmaxBlockDim,
+                              0,
+                              0,
+                              nullptr,
+                              nullptr,
+                              0,
+                              seqLen,
+                              d_s,
+                              seqLen);
+        hipExtLaunchKernelGGL(gemm_batched_d<row_major>,
+                              gemmGridDim(seqLen, HEAD_DIM),
+                              gemmBlockDim,
+                              0,
+                              0,
+                              nullptr,
+                              nullptr,
+                              0,
+                              seqLen,
+                              HEAD_DIM,
+                              seqLen,
+                              d_s,
+                              d_v,
+                              d_o,
+                              seqLen,
+                              HEAD_DIM,
+                              HEAD_DIM,
+                              strideS,
+                              strideQKV,
+                              strideQKV,
+                              static_cast<ComputeT>(1));
+    };
+
+    // Runs are timed individually, with warm and cold caches
+    BenchmarkHarness harness;
+
+    // Only the unmasked (query, key) pairs of each head count as useful work
+    uint32_t attendedPairs = 0u;
+    for(uint32_t i = 0; i < seqLen; ++i)
+    {
+        for(uint32_t j = 0; j < seqLen; ++j)
+        {
+            attendedPairs += attends_h(i, j, causal, window) ? 1u : 0u;
+        }
+    }
+
+    // Echo performance
+    // Two GEMMs of attendedPairs x HEAD_DIM per head
+    auto echo = [&](const char* kernelName, auto&& kernel) {
+        auto gFlops = calculateGFlops(batch, attendedPairs, 2u * HEAD_DIM);
+
+        for(auto cacheState :
+            {BenchmarkHarness::CacheState::Warm, BenchmarkHarness::CacheState::Cold})
+        {
+            auto stats        = harness.run(kernel, cacheState);
+            auto tFlopsPerSec = calculateTFlopsPerSec(
+                batch, attendedPairs, 2u * HEAD_DIM, stats.mMedianMs);
+
+            std::cout << kernelName << ", " << hWAVES << ", " << hROCWMMA_M << ", "
+                      << hROCWMMA_N << ", " << hROCWMMA_K << ", " << batch << ", " << seqLen
+                      << ", " << HEAD_DIM << ", " << BLOCK_KV << ", " << causal << ", "
+                      << window << ", "
+                      << (cacheState == BenchmarkHarness::CacheState::Warm ? "warm" : "cold")
+                      << ", " << stats.mMedianMs << ", " << gFlops << ", " << tFlopsPerSec
+                      << ", ";
+            BenchmarkHarness::printStats(std::cout, stats) << std::endl;
+        }
+    };
+
+#if !NDEBUG
+
+    // Setup and run reference computation
+    std::vector<OutputT> matrixO_ref(elementsQKV, std::numeric_limits<OutputT>::signaling_NaN());
+    bool                 refComputed = false;
+
+    auto validate = [&]() {
+        std::cout << "Validating result with reference..." << std::endl;
+
+        if(!refComputed)
+        {
+            if(static_cast<uint64_t>(batch) * seqLen * seqLen > (64ull * 2048ull * 2048ull))
+            {
+                std::cout << "Please wait. Large sizes can take a while!" << std::endl;
+            }
+
+            std::vector<uint32_t> cuSeqLens(batch + 1u);
+            for(uint32_t i = 0; i <= batch; ++i)
+            {
+                cuSeqLens[i] = i * seqLen;
+            }
+
+            attention_cpu_h(cuSeqLens.data(),
+                            batch,
+                            matrixQ.data(),
+                            matrixK.data(),
+                            matrixV.data(),
+                            matrixO_ref.data(),
+                            scale,
+                            causal,
+                            window);
+            refComputed = true;
+        }
+
+        // Bring kernel result back to host
+        CHECK_HIP_ERROR(hipMemcpy(matrixO.data(), d_o, bytesQKV, hipMemcpyDeviceToHost));
+
+        // Probabilities are rounded to fp16 before the second product
+        auto res = compareEqual(matrixO.data(), matrixO_ref.data(), elementsQKV, 50.0);
+
+        if(std::get<0>(res) == false)
+        {
+            std::cout << "FAILED\n";
+        }
+        else
+        {
+            std::cout << "PASSED\n";
+        }
+
+        std::cout << "Max relative error: " << std::get<1>(res) << std::endl;
+    };
+
+#endif // !NDEBUG
+
+    std::cout << "Kernel, "
+              << "Waves, "
+              << "BlkM, BlkN, BlkK, "
+              << "Batch, SeqLen, HeadDim, BlockKV, Causal, Window, "
+              << "Cache, elapsedMs, Problem Size(GFlops), TFlops/s, "
+              << BenchmarkHarness::statsHeader() << std::endl;
+
+    echo("Fused", fusedKernel);
+
+#if !NDEBUG
+    validate();
+#endif // !NDEBUG
+
+    // The unfused kernels are the unmasked baseline only
+    if(!causal)
+    {
+        // Fill outputs with NaN to catch contamination
+        CHECK_HIP_ERROR(hipMemset(d_o, 0xFF, bytesQKV));
+
+        echo("Unfused", unfusedKernel);
+
+#if !NDEBUG
+        validate();
+#endif // !NDEBUG
+    }
+
+    // Release device memory
+    CHECK_HIP_ERROR(hipFree(d_q));
+    CHECK_HIP_ERROR(hipFree(d_k));
+    CHECK_HIP_ERROR(hipFree(d_v));
+    CHECK_HIP_ERROR(hipFree(d_o));
+    CHECK_HIP_ERROR(hipFree(d_s));
+
+    std::cout << "Finished!" << std::endl;
+}
+
+// Grouped-query attention of qHeads query heads over kvHeads shared K / V heads, compared
+// with the per-head kernel that reloads the K / V blocks for every query head.
+ROCWMMA_HOST void attention_gqa_test(
+    uint32_t batch, uint32_t qHeads, uint32_t kvHeads, uint32_t seqLen, bool causal)
+{
+    // Runtime checks for host parameters
+    uint32_t hWAVES     = isGfx9() ? gfx9Params::WAVES : gfx11Params::WAVES;
+    uint32_t hROCWMMA_M = isGfx9() ? gfx9Params::ROCWMMA_M : gfx11Params::ROCWMMA_M;
+    uint32_t hROCWMMA_N = isGfx9() ? gfx9Params::ROCWMMA_N : gfx11Params::ROCWMMA_N;
+    uint32_t hROCWMMA_K = isGfx9() ? gfx9Params::ROCWMMA_K : gfx11Params::ROCWMMA_K;
+
+    // Runtime warp calculation (host code needs to query warpsize dynamically)
+    auto warpSize = getWarpSize();
+
+    if((isGfx11() || isGfx12()) && getWarpSize() != Constants::AMDGCN_WAVE_SIZE_32)
+    {
+        std::cout << "Unsupported wave size!\n";
+        return;
+    }
+
+    if(isGfx9() && getWarpSize() != Constants::AMDGCN_WAVE_SIZE_64)
+    {
+        std::cout << "Unsupported wave size!\n";
+        return;
+    }
+
+    // Bounds check
+    if(seqLen % BLOCK_KV || seqLen % (hWAVES * hROCWMMA_M) || kvHeads == 0u
+       || qHeads % kvHeads)
+    {
+        std::cout << "Unsupported sequence length or head counts!\n";
+        return;
+    }
+
+    auto groupSize = qHeads / kvHeads;
+    auto scale     = static_cast<ComputeT>(1.0 / std::sqrt(static_cast<double>(HEAD_DIM)));
+    auto scaleLog2 = static_cast<ComputeT>(scale * M_LOG2E);
+
+    std::cout << "Initializing host data..." << std::endl;
+
+    const size_t headSize   = static_cast<size_t>(seqLen) * HEAD_DIM;
+    const size_t elementsQO = static_cast<size_t>(batch) * qHeads * headSize;
+    const size_t elementsKV = static_cast<size_t>(batch) * kvHeads * headSize;
+
+    std::vector<InputT> matrixQ(elementsQO);
+    std::vector<InputT> matrixK(elementsKV);
+    std::vector<InputT> matrixV(elementsKV);
+
+    // Fill outputs with NaN to catch contamination
+    std::vector<OutputT> matrixO(elementsQO, std::numeric_limits<OutputT>::signaling_NaN());
+
+    fillRandNormalized(matrixQ.data(), elementsQO);
+    fillRandNormalized(matrixK.data(), elementsKV);
+    fillRandNormalized(matrixV.data(), elementsKV);
+
+    std::cout << "Initializing device data..." << std::endl;
+
+    InputT*  d_q;
+    InputT*  d_k;
+    InputT*  d_v;
+    OutputT* d_o;
+
+    const size_t bytesQO = elementsQO * sizeof(InputT);
+    const size_t bytesKV = elementsKV * sizeof(InputT);
+
+    CHECK_HIP_ERROR(hipMalloc(&d_q, bytesQO));
+    CHECK_HIP_ERROR(hipMalloc(&d_k, bytesKV));
+    CHECK_HIP_ERROR(hipMalloc(&d_v, bytesKV));
+    CHECK_HIP_ERROR(hipMalloc(&d_o, bytesQO));
+
+    CHECK_HIP_ERROR(hipMemcpy(d_q, matrixQ.data(), bytesQO, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_k, matrixK.data(), bytesKV, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_v, matrixV.data(), bytesKV, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_o, matrixO.data(), bytesQO, hipMemcpyHostToDevice));
+
+    // Each workgroup covers heads query heads of a group for one query tile
+    auto qTiles   = seqLen / (hWAVES * hROCWMMA_M);
+    auto blockDim = dim3(hWAVES * warpSize);
+
+    auto gqaKernel = [&](auto heads) {
+        return [&, heads]() {
+            hipExtLaunchKernelGGL(flash_attention_gqa_d<decltype(heads)::value>,
+                                  dim3(qTiles, qHeads / heads, batch),
+                                  blockDim,
+                                  LDS_USAGE,
+                                  0,
+                                  nullptr,
+                                  nullptr,
+                                  0,
+                                  seqLen,
+                                  groupSize,
+                                  d_q,
+                                  d_k,
+                                  d_v,
+                                  d_o,
+                                  scaleLog2,
+                                  causal);
+        };
+    };
+
+    // K / V blocks staged by each workgroup over its sweep of the keys
+    uint64_t kvBlocksPerHead = 0u;
+    for(uint32_t i = 0; i < qTiles; ++i)
+    {
+        auto qRowEnd = (i + 1u) * hWAVES * hROCWMMA_M;
+        kvBlocksPerHead += causal ? rocwmma::ceilDiv(qRowEnd, BLOCK_KV) : seqLen / BLOCK_KV;
+    }
+
+    // Runs are timed individually, with warm and cold caches
+    BenchmarkHarness harness;
+
+    // Only the unmasked (query, key) pairs of each head count as useful work
+    uint32_t attendedPairs = 0u;
+    for(uint32_t i = 0; i < seqLen; ++i)
+    {
+        for(uint32_t j = 0; j < seqLen; ++j)
+        {
+            attendedPairs += attends_h(i, j, causal, 0u) ? 1u : 0u;
+        }
+    }
+
+    // Echo performance
+    // Two GEMMs of attendedPairs x HEAD_DIM per query head
+    auto echo = [&](const char* kernelName, uint32_t heads, auto&& kernel) {
+        auto gFlops  = calculateGFlops(batch * qHeads, attendedPairs, 2u * HEAD_DIM);
+        auto kvBytes = static_cast<double>(batch) * (qHeads / heads) * kvBlocksPerHead * 2u
+                       * BLOCK_KV * HEAD_DIM * sizeof(InputT);
+
+        for(auto cacheState :
+            {BenchmarkHarness::CacheState::Warm, BenchmarkHarness::CacheState::Cold})
+        {
+            auto stats        = harness.run(kernel, cacheState);
+            auto tFlopsPerSec = calculateTFlopsPerSec(
+                batch * qHeads, attendedPairs, 2u * HEAD_DIM, stats.mMedianMs);
+
+            std::cout << kernelName << ", " << hWAVES << ", " << hROCWMMA_M << ", "
+                      << hROCWMMA_N << ", " << hROCWMMA_K << ", " << batch << ", " << qHeads
+                      << ", " << kvHeads << ", " << heads << ", " << seqLen << ", " << HEAD_DIM
+                      << ", " << BLOCK_KV << ", " << causal << ", "
+                      << (cacheState == BenchmarkHarness::CacheState::Warm ? "warm" : "cold")
+                      << ", " << kvBytes * 1.0e-6 << ", " << stats.mMedianMs << ", " << gFlops
+                      << ", " << tFlopsPerSec << ", ";
+            BenchmarkHarness::printStats(std::cout, stats) << std::endl;
+        }
+    };
+
+#if !NDEBUG
+
+    // Setup and run reference computation
+    std::vector<OutputT> matrixO_ref(elementsQO, std::numeric_limits<OutputT>::signaling_NaN());
+    bool                 refComputed = false;
+
+    auto validate = [&]() {
+        std::cout << "Validating result with reference..." << std::endl;
+
+        if(!refComputed)
+        {
+            if(static_cast<uint64_t>(batch) * qHeads * seqLen * seqLen
+               > (64ull * 2048ull * 2048ull))
+            {
+                std::cout << "Please wait. Large sizes can take a while!" << std::endl;
+            }
+
+            // Each query head against the K / V head of its group
+            uint32_t cuSeqLens[] = {0u, seqLen};
+            for(uint32_t b = 0; b < batch; ++b)
+            {
+                for(uint32_t h = 0; h < qHeads; ++h)
+                {
+                    auto qOffset  = (static_cast<size_t>(b) * qHeads + h) * headSize;
+                    auto kvOffset = (static_cast<size_t>(b) * kvHeads + h / groupSize) * headSize;
+                    attention_cpu_h(cuSeqLens,
+                                    1u,
+                                    matrixQ.data() + qOffset,
+                                    matrixK.data() + kvOffset,
+                                    matrixV.data() + kvOffset,
+                                    matrixO_ref.data() + qOffset,
+                                    scale,
+                                    causal,
+                                    0u);
+                }
+            }
+            refComputed = true;
+        }
+
+        // Bring kernel result back to host
+        CHECK_HIP_ERROR(hipMemcpy(matrixO.data(), d_o, bytesQO, hipMemcpyDeviceToHost));
+
+        // Probabilities are rounded to fp16 before the second product
+        auto res = compareEqual(matrixO.data(), matrixO_ref.data(), elementsQO, 50.0);
+
+        if(std::get<0>(res) == false)
+        {
+            std::cout << "FAILED\n";
+        }
+        else
+        {
+            std::cout << "PASSED\n";
+        }
+
+        std::cout << "Max relative error: " << std::get<1>(res) << std::endl;
+    };
+
+#endif // !NDEBUG
+
+    std::cout << "Kernel, "
+              << "Waves, "
+              << "BlkM, BlkN, BlkK, "
+              << "Batch, QHeads, KvHeads, HeadsPerBlock, SeqLen, HeadDim, BlockKV, Causal, "
+              << "Cache, KV Traffic(MB), elapsedMs, Problem Size(GFlops), TFlops/s, "
+              << BenchmarkHarness::statsHeader() << std::endl;
+
+    // Per-head baseline: every query head reloads the K / V blocks of its group
+    echo("PerHead", 1u, gqaKernel(std::integral_constant<uint32_t, 1u>{}));
+
+#if !NDEBUG
+    validate();
+#endif // !NDEBUG
+
+    // Fill outputs with NaN to catch contamination
+    CHECK_HIP_ERROR(hipMemset(d_o, 0xFF, bytesQO));
+
+    // Grouped: the query heads of a workgroup share each K / V block.
+    // The heads per workgroup are bounded by the registers held per head.
+    if(groupSize % 4u == 0u)
+    {
+        echo("Grouped", 4u, gqaKernel(std::integral_constant<uint32_t, 4u>{}));
+    }
+    else if(groupSize % 2u == 0u)
+    {
+        echo("Grouped", 2u, gqaKernel(std::integral_constant<uint32_t, 2u>{}));
+    }
+    else
+    {
+        echo("Grouped", 1u, gqaKernel(std::integral_constant<uint32_t, 1u>{}));
+    }
+
+#if !NDEBUG
+    validate();
+#endif // !NDEBUG
+
+    // Release device memory
+    CHECK_HIP_ERROR(hipFree(d_q));
+    CHECK_HIP_ERROR(hipFree(d_k));
+    CHECK_HIP_ERROR(hipFree(d_v));
+    CHECK_HIP_ERROR(hipFree(d_o));
+
+    std::cout << "Finished!" << std::endl;
+}
+
+// Ragged batch of sequences with random lengths in [minSeqLen, maxSeqLen], packed
+// without padding and described by cu_seqlens style cumulative offsets.
+ROCWMMA_HOST void
+    attention_varlen_test(uint32_t batch, uint32_t minSeqLen, uint32_t maxSeqLen, bool causal)
+{
+    // Runtime checks for host parameters
+    uint32_t hWAVES     = isGfx9() ? gfx9Params::WAVES : gfx11Params::WAVES;
+    uint32_t hROCWMMA_M = isGfx9() ? gfx9Params::ROCWMMA_M : gfx11Params::ROCWMMA_M;
+    uint32_t hROCWMMA_N = isGfx9() ? gfx9Params::ROCWMMA_N : gfx11Params::ROCWMMA_N;
+    uint32_t hROCWMMA_K = isGfx9() ? gfx9Params::ROCWMMA_K : gfx11Params::ROCWMMA_K;
+
+    // Runtime warp calculation (host code needs to query warpsize dynamically)
+    auto warpSize = getWarpSize();
+
+    if((isGfx11() || isGfx12()) && getWarpSize() != Constants::AMDGCN_WAVE_SIZE_32)
+    {
+        std::cout << "Unsupported wave size!\n";
+        return;
+    }
+
+    if(isGfx9() && getWarpSize() != Constants::AMDGCN_WAVE_SIZE_64)
+    {
+        std::cout << "Unsupported wave size!\n";
+        return;
+    }
+
+    auto scale     = static_cast<ComputeT>(1.0 / std::sqrt(static_cast<double>(HEAD_DIM)));
+    auto scaleLog2 = static_cast<ComputeT>(scale * M_LOG2E);
+
+    std::cout << "Initializing host data..." << std::endl;
+
+    // Sequence lengths need not be multiples of the tile sizes
+    std::vector<uint32_t> cuSeqLens(batch + 1u, 0u);
+    for(uint32_t i = 0; i < batch; ++i)
+    {
+        cuSeqLens[i + 1u] = cuSeqLens[i] + minSeqLen + rand() % (maxSeqLen - minSeqLen + 1u);
+    }
+
+    const uint32_t totalTokens = cuSeqLens[batch];
+    const size_t   elementsQKV = static_cast<size_t>(totalTokens) * HEAD_DIM;
+
+    std::vector<InputT> matrixQ(elementsQKV);
+    std::vector<InputT> matrixK(elementsQKV);
+    std::vector<InputT> matrixV(elementsQKV);
+
+    // Fill outputs with NaN to catch contamination
+    std::vector<OutputT> matrixO(elementsQKV, std::numeric_limits<OutputT>::signaling_NaN());
+
+    fillRandNormalized(matrixQ.data(), elementsQKV);
+    fillRandNormalized(matrixK.data(), elementsQKV);
+    fillRandNormalized(matrixV.data(), elementsQKV);
+
+    std::cout << "Initializing device data..." << std::endl;
+
+    InputT*   d_q;
+    InputT*   d_k;
+    InputT*   d_v;
+    OutputT*  d_o;
+    uint32_t* d_cuSeqLens;
+    uint32_t* d_qTileOffsets;
+
+    const size_t bytesQKV     = elementsQKV * sizeof(InputT);
+    const size_t bytesOffsets = (batch + 1u) * sizeof(uint32_t);
+
+    CHECK_HIP_ERROR(hipMalloc(&d_q, bytesQKV));
+    CHECK_HIP_ERROR(hipMalloc(&d_k, bytesQKV));
+    CHECK_HIP_ERROR(hipMalloc(&d_v, bytesQKV));
+    CHECK_HIP_ERROR(hipMalloc(&d_o, bytesQKV));
+    CHECK_HIP_ERROR(hipMalloc(&d_cuSeqLens, bytesOffsets));
+    CHECK_HIP_ERROR(hipMalloc(&d_qTileOffsets, bytesOffsets));
+
+    CHECK_HIP_ERROR(hipMemcpy(d_q, matrixQ.data(), bytesQKV, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_k, matrixK.data(), bytesQKV, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_v, matrixV.data(), bytesQKV, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_o, matrixO.data(), bytesQKV, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(
+        hipMemcpy(d_cuSeqLens, cuSeqLens.data(), bytesOffsets, hipMemcpyHostToDevice));
+
+    // The tile map is built on the device from the sequence offsets, so the grid only
+    // needs an upper bound of the tile count: each sequence adds at most one partial tile.
+    auto tileRows = hWAVES * hROCWMMA_M;
+    auto maxTiles = rocwmma::ceilDiv(totalTokens, tileRows) + batch;
+
+    auto varlenKernel = [&]() {
+        hipExtLaunchKernelGGL(varlen_tile_offsets_d,
+                              dim3(1),
+                              dim3(1),
+                              0,
+                              0,
+                              nullptr,
+                              nullptr,
+                              0,
+                              d_cuSeqLens,
+                              batch,
+                              d_qTileOffsets);
+        hipExtLaunchKernelGGL(flash_attention_varlen_d,
+                              dim3(maxTiles),
+                              dim3(hWAVES * warpSize),
+                              LDS_USAGE,
+                              0,
+                              nullptr,
+                              nullptr,
+                              0,
+                              d_cuSeqLens,
+                              d_qTileOffsets,
+                              batch,
+                              d_q,
+                              d_k,
+                              d_v,
+                              d_o,
+                              scaleLog2,
+                              causal,
+                              0u);
+    };
+
+    // Only the unmasked (query, key) pairs count as useful work.
+    // Padding every sequence to maxSeqLen would compute batch * maxSeqLen^2 pairs instead.
+    uint64_t attendedPairs = 0u;
+    for(uint32_t i = 0; i < batch; ++i)
+    {
+        uint64_t seqLen = cuSeqLens[i + 1u] - cuSeqLens[i];
+        attendedPairs += causal ? seqLen * (seqLen + 1u) / 2u : seqLen * seqLen;
+    }
+    uint64_t paddedLen   = maxSeqLen;
+    uint64_t paddedPairs
+        = batch * (causal ? paddedLen * (paddedLen + 1u) / 2u : paddedLen * paddedLen);
+
+    std::cout << "Tokens: " << totalTokens << ", padded tokens: " << batch * maxSeqLen
+              << ", padded work avoided: "
+              << 100.0 * (1.0 - static_cast<double>(attendedPairs) / paddedPairs) << "%"
+              << std::endl;
+
+    // Runs are timed individually, with warm and cold caches
+    BenchmarkHarness harness;
+
+    // Echo performance
+    // Two GEMMs of attendedPairs x HEAD_DIM over the batch
+    auto gFlops = 4.0 * HEAD_DIM * static_cast<double>(attendedPairs) * 1.0e-9;
+
+    std::cout << "Kernel, "
+              << "Waves, "
+              << "BlkM, BlkN, BlkK, "
+              << "Batch, Tokens, HeadDim, BlockKV, Causal, "
+              << "Cache, elapsedMs, Problem Size(GFlops), TFlops/s, "
+              << BenchmarkHarness::statsHeader() << std::endl;
+
+    for(auto cacheState : {BenchmarkHarness::CacheState::Warm, BenchmarkHarness::CacheState::Cold})
+    {
+        auto stats        = harness.run(varlenKernel, cacheState);
+        auto tFlopsPerSec = gFlops / stats.mMedianMs;
+
+        std::cout << "FusedVarlen, " << hWAVES << ", " << hROCWMMA_M << ", " << hROCWMMA_N
+                  << ", " << hROCWMMA_K << ", " << batch << ", " << totalTokens << ", "
+                  << HEAD_DIM << ", " << BLOCK_KV << ", " << causal << ", "
+                  << (cacheState == BenchmarkHarness::CacheState::Warm ? "warm" : "cold")
+                  << ", " << stats.mMedianMs << ", " << gFlops << ", " << tFlopsPerSec << ", ";
+        BenchmarkHarness::printStats(std::cout, stats) << std::endl;
+    }
+
+#if !NDEBUG
+
+    std::cout << "Validating result with reference..." << std::endl;
+
+    std::vector<OutputT> matrixO_ref(elementsQKV, std::numeric_limits<OutputT>::signaling_NaN());
+    attention_cpu_h(cuSeqLens.data(),
+                    batch,
+                    matrixQ.data(),
+                    matrixK.data(),
+                    matrixV.data(),
+                    matrixO_ref.data(),
+                    scale,
+                    causal,
+                    0u);
+
+    // Bring kernel result back to host
+    CHECK_HIP_ERROR(hipMemcpy(matrixO.data(), d_o, bytesQKV, hipMemcpyDeviceToHost));
+
+    // Probabilities are rounded to fp16 before the second product
+    auto res = compareEqual(matrixO.data(), matrixO_ref.data(), elementsQKV, 50.0);
+
+    if(std::get<0>(res) == false)
+    {
+        std::cout << "FAILED\n";
+    }
+    else
+    {
+        std::cout << "PASSED\n";
+    }
+
+    std::cout << "Max relative error: " << std::get<1>(res) << std::endl;
+
+#endif // !NDEBUG
+
+    // Release device memory
+    CHECK_HIP_ERROR(hipFree(d_q));
+    CHECK_HIP_ERROR(hipFree(d_k));
+    CHECK_HIP_ERROR(hipFree(d_v));
+    CHECK_HIP_ERROR(hipFree(d_o));
+    CHECK_HIP_ERROR(hipFree(d_cuSeqLens));
+    CHECK_HIP_ERROR(hipFree(d_qTileOffsets));
+
+    std::cout << "Finished!" << std::endl;
+}
+
+int main()
+{
+    // Batch of 16 heads, head dimension HEAD_DIM
+    attention_test(16, 2048, false, 0u);
+
+    // Causal, and causal with a sliding window of 256 keys
+    attention_test(16, 2048, true, 0u);
+    attention_test(16, 2048, true, 256u);
+
+    // Ragged batch of 32 sequences of 128 to 2048 tokens, dense and causal
+    attention_varlen_test(32, 128, 2048, false);
+    attention_varlen_test(32, 128, 2048, true);
+
+    // Grouped-query attention of 32 query heads over 8 K / V heads, and multi-query
+    // attention over a single K / V head
+    attention_gqa_test(4, 32, 8, 1024, false);
+    attention_gqa_test(4, 32, 8, 1024, true);
+    attention_gqa_test(4, 32, 1, 1024, true);
+    return 0;
+}
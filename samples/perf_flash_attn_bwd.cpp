@@ -0,0 +1,998 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <cmath>
+#include <iostream>
+#include <tuple>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_fp16.h>
+#include <hip/hip_runtime.h>
+
+#include <rocwmma/rocwmma.hpp>
+#include <rocwmma/rocwmma_epilogue.hpp>
+
+#include "benchmark_harness.hpp"
+#include "common.hpp"
+
+/* Motivation
+*
+* The backward pass of scaled dot-product attention O = softmax(scale * Q x K^T) x V
+* computes the input gradients from the output gradient dO:
+*
+* P     = softmax(scale * Q x K^T)
+* dV    = P^T x dO
+* dP    = dO x V^T
+* dS    = P * (dP - Delta), Delta = rowsum(dO * O)
+* dQ    = scale * dS x K
+* dK    = scale * dS^T x Q
+*
+* Q, K, V, O, dO = tiles of S x D (S = sequence length, D = head dimension)
+*
+* Storing P from the forward pass costs S x S elements per head, which dominates the
+* activation memory of long sequence training. Instead, the forward pass only needs to save
+* the log-sum-exp of each score row, L = m + log2(l) in base 2, from the running max m and
+* running sum l of its online softmax (see perf_flash_attention). In this sample, the
+* forward pass and L are computed on the host. The backward pass recomputes each block of
+* P from L exactly:
+*
+*   P_ij = exp2(scale * log2(e) * S_ij - L_i)
+*
+* so the saved statistics are O(S) per head, as is Delta which is computed by a small
+* pre-pass. No S x S matrix is ever stored.
+*
+* dK and dV are reductions over the queries, and dQ is a reduction over the keys. The
+* dK / dV kernel assigns ROCWMMA_M keys to each wave, which sweeps over all query
+* blocks keeping its dK and dV blocks in accumulator registers. dQ is then produced in
+* one of two modes:
+*
+* - Atomic: the dK / dV kernel also computes the dQ partial of each (query, key) block
+*   pair and adds it to an fp32 workspace with atomics. Fastest, but the order of the
+*   additions, hence the rounding, changes from run to run.
+*
+* - Deterministic: a second kernel assigns ROCWMMA_M queries to each wave, which sweeps
+*   over the key blocks recomputing P and dS, and accumulates dQ in registers in a fixed
+*   order. Results are bitwise reproducible, at the cost of computing the scores and dP
+*   a second time.
+*
+* Blocks of P and dS are converted to fp16 and staged through a small private LDS region
+* of each wave, to be re-loaded as matrix_a fragments of P^T, dS^T and dS. The row
+* statistics L and Delta are loaded into accumulator fragments broadcast across the
+* columns, as col major matrices with a leading dimension of 0.
+*
+* With a causal mask, fully masked blocks are never visited and only the diagonal blocks
+* are masked with epilogue::AttentionMask.
+*/
+
+using namespace rocwmma;
+
+///
+/// Parameter configuration
+///
+
+namespace gfx9Params
+{
+    enum kernelParams : uint32_t
+    {
+        ROCWMMA_M = 16u,
+        ROCWMMA_N = 16u,
+        ROCWMMA_K = 16u,
+        WAVES     = 4u,
+        WARP_SIZE = Constants::AMDGCN_WAVE_SIZE_64
+    };
+}
+
+namespace gfx11Params
+{
+    enum kernelParams : uint32_t
+    {
+        ROCWMMA_M = 16u,
+        ROCWMMA_N = 16u,
+        ROCWMMA_K = 16u,
+        WAVES     = 4u,
+        WARP_SIZE = Constants::AMDGCN_WAVE_SIZE_32
+    };
+}
+
+#if(ROCWMMA_ARCH_GFX9)
+using namespace gfx9Params;
+#else
+using namespace gfx11Params;
+#endif // defined(ROCWMMA_ARCH_GFX9)
+
+// Query and key blocks are square, so that a block of P is also a matrix_a block of P^T
+static_assert(ROCWMMA_M == ROCWMMA_N && ROCWMMA_N == ROCWMMA_K, "Blocks must be square");
+
+// Attention geometry
+constexpr uint32_t HEAD_DIM = 64u;
+constexpr uint32_t TBLOCK_X = WAVES * WARP_SIZE;
+
+///
+/// Types and Data Layouts
+///
+
+using InputT   = float16_t;
+using OutputT  = float16_t;
+using ComputeT = float32_t;
+
+///
+/// Fragment types
+///
+
+// Blocks of Q, K, V and dO rows are read as:
+// FragA  : rows x D, e.g. Q for S = Q x K^T
+// FragBT : D x rows, e.g. K^T for S = Q x K^T
+// FragB  : rows x D as the reduction dim, e.g. dO for dV = P^T x dO
+// Staged P and dS blocks are read as FragA (dS) or FragAT (P^T, dS^T).
+using FragA   = fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, InputT, row_major>;
+using FragAT  = fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, InputT, col_major>;
+using FragB   = fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, InputT, row_major>;
+using FragBT  = fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, InputT, col_major>;
+using FragAcc = fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, ComputeT>;
+using FragOut = fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, OutputT>;
+
+// Fragment counts of each wave
+constexpr uint32_t D_BLOCKS = HEAD_DIM / ROCWMMA_K; // Input fragments along D
+constexpr uint32_t O_BLOCKS = HEAD_DIM / ROCWMMA_N; // Output fragments along D
+
+// Lds geometry: per wave, the P and dS blocks, and the fp32 dQ block of the atomics
+constexpr uint32_t LDS_BLOCK_SIZE = ROCWMMA_M * ROCWMMA_N;
+constexpr uint32_t LDS_USAGE
+    = WAVES * LDS_BLOCK_SIZE * (2u * sizeof(InputT) + sizeof(ComputeT));
+
+///
+/// Wrapper functions
+///
+
+// Unscaled scores of one block: S = A x B^T over the head dimension.
+// E.g. S = Q x K^T, or dP = dO x V^T.
+ROCWMMA_DEVICE static inline void scoreBlock(FragAcc& fragS,
+                                             FragA const (&fragsA)[D_BLOCKS],
+                                             FragBT const (&fragsBT)[D_BLOCKS])
+{
+    fill_fragment(fragS, static_cast<ComputeT>(0));
+#pragma unroll
+    for(uint32_t i = 0; i < D_BLOCKS; i++)
+    {
+        mma_sync(fragS, fragsA[i], fragsBT[i], fragS);
+    }
+}
+
+// Loads a row statistic of ROCWMMA_M rows broadcast across the columns of the block:
+// a col major matrix with a leading dimension of 0 repeats the vector in every column.
+ROCWMMA_DEVICE static inline void loadRowStat(FragAcc& frag, ComputeT const* stat)
+{
+    load_matrix_sync(frag, stat, 0u, mem_col_major);
+}
+
+// Recomputes P = exp2(S * scaleLog2 - L) from the saved log-sum-exp L of each row,
+// and the score gradient dS = P * (dP - Delta).
+// Masked scores of -inf have P and dS of 0.
+ROCWMMA_DEVICE static inline void softmaxGrad(FragAcc&       fragP,
+                                              FragAcc&       fragDS,
+                                              FragAcc const& fragS,
+                                              FragAcc const& fragDP,
+                                              FragAcc const& fragL,
+                                              FragAcc const& fragDelta,
+                                              ComputeT       scaleLog2)
+{
+#pragma unroll
+    for(uint32_t i = 0; i < FragAcc::num_elements; i++)
+    {
+        auto p      = exp2f(fragS.x[i] * scaleLog2 - fragL.x[i]);
+        fragP.x[i]  = p;
+        fragDS.x[i] = p * (fragDP.x[i] - fragDelta.x[i]);
+    }
+}
+
+// Stores a block to the private Lds region of the wave in InputT, row major, to be
+// re-loaded as a matrix_a block of itself (FragA) or of its transpose (FragAT).
+ROCWMMA_DEVICE static inline void stageBlock(InputT* lds, FragAcc const& frag)
+{
+    FragOut fragOut;
+    apply_epilogue(fragOut, frag);
+    store_matrix_sync(lds, fragOut, ROCWMMA_N, mem_row_major);
+}
+
+// Atomically adds a block to the fp32 workspace, through the private Lds region of the wave.
+ROCWMMA_DEVICE static inline void
+    globalAtomicAddBlock(ComputeT* dst, uint32_t ld, FragAcc const& frag, ComputeT* lds)
+{
+    store_matrix_sync(lds, frag, ROCWMMA_N, mem_row_major);
+
+    for(uint32_t e = threadIdx.x % WARP_SIZE; e < LDS_BLOCK_SIZE; e += WARP_SIZE)
+    {
+        atomicAdd(dst + (e / ROCWMMA_N) * ld + e % ROCWMMA_N, lds[e]);
+    }
+}
+
+///
+/// Backward kernels
+///
+/// Q, K, V, O, dO and the gradients are packed [batch][seqLen][HEAD_DIM] row major.
+/// The row statistics L and Delta are packed [batch][seqLen].
+///
+
+// Delta = rowsum(dO * O), one thread per row.
+__global__ void attention_bwd_delta_d(
+    uint32_t rows, OutputT const* o, InputT const* dO, ComputeT* delta)
+{
+    auto row = blockIdx.x * blockDim.x + threadIdx.x;
+    if(row < rows)
+    {
+        auto offset = static_cast<uint64_t>(row) * HEAD_DIM;
+        auto acc    = static_cast<ComputeT>(0);
+        for(uint32_t d = 0; d < HEAD_DIM; d++)
+        {
+            acc += static_cast<ComputeT>(dO[offset + d]) * static_cast<ComputeT>(o[offset + d]);
+        }
+        delta[row] = acc;
+    }
+}
+
+/// dK and dV, and in atomic mode dQ.
+/// Grid: (seqLen / (WAVES * ROCWMMA_M), batch), Block: (TBLOCK_X)
+/// Each wave owns ROCWMMA_M keys and sweeps over the query blocks.
+/// If dQAcc is not null, dQ partials are atomically added to it (fp32, zero initialized).
+__global__ void __launch_bounds__(256) flash_attention_bwd_dkdv_d(uint32_t        seqLen,
+                                                                  InputT const*   q,
+                                                                  InputT const*   k,
+                                                                  InputT const*   v,
+                                                                  InputT const*   dO,
+                                                                  ComputeT const* lse,
+                                                                  ComputeT const* delta,
+                                                                  OutputT*        dK,
+                                                                  OutputT*        dV,
+                                                                  ComputeT*       dQAcc,
+                                                                  ComputeT        scaleLog2,
+                                                                  ComputeT        scale,
+                                                                  bool            causal)
+{
+    if constexpr(!ROCWMMA_ARCH_HOST)
+    {
+        auto waveIndex  = threadIdx.x / WARP_SIZE;
+        auto headRow    = blockIdx.y * seqLen;
+        auto headOffset = static_cast<uint64_t>(headRow) * HEAD_DIM;
+        auto kRow       = (blockIdx.x * WAVES + waveIndex) * ROCWMMA_M;
+        auto kRowOffset = headOffset + kRow * HEAD_DIM;
+
+        q += headOffset;
+        dO += headOffset;
+        lse += headRow;
+        delta += headRow;
+
+        // Lds staging of this wave
+        HIP_DYNAMIC_SHARED(void*, localMemPtr);
+        auto* ldsP  = reinterpret_cast<InputT*>(localMemPtr) + waveIndex * 2u * LDS_BLOCK_SIZE;
+        auto* ldsDS = ldsP + LDS_BLOCK_SIZE;
+        auto* ldsDQ = reinterpret_cast<ComputeT*>(reinterpret_cast<InputT*>(localMemPtr)
+                                                  + WAVES * 2u * LDS_BLOCK_SIZE)
+                      + waveIndex * LDS_BLOCK_SIZE;
+
+        // K and V blocks stay resident for the whole sweep over the queries
+        FragBT fragsKT[D_BLOCKS];
+        FragBT fragsVT[D_BLOCKS];
+#pragma unroll
+        for(uint32_t i = 0; i < D_BLOCKS; i++)
+        {
+            load_matrix_sync(fragsKT[i], k + kRowOffset + i * ROCWMMA_K, HEAD_DIM);
+            load_matrix_sync(fragsVT[i], v + kRowOffset + i * ROCWMMA_K, HEAD_DIM);
+        }
+
+        FragB fragsK[O_BLOCKS];
+        if(dQAcc != nullptr)
+        {
+#pragma unroll
+            for(uint32_t j = 0; j < O_BLOCKS; j++)
+            {
+                load_matrix_sync(fragsK[j], k + kRowOffset + j * ROCWMMA_N, HEAD_DIM);
+            }
+        }
+
+        FragAcc fragsDK[O_BLOCKS];
+        FragAcc fragsDV[O_BLOCKS];
+#pragma unroll
+        for(uint32_t j = 0; j < O_BLOCKS; j++)
+        {
+            fill_fragment(fragsDK[j], static_cast<ComputeT>(0));
+            fill_fragment(fragsDV[j], static_cast<ComputeT>(0));
+        }
+
+        // Causal: the queries before the keys of this wave are fully masked
+        for(uint32_t qRow = causal ? kRow : 0u; qRow < seqLen; qRow += ROCWMMA_M)
+        {
+            auto qRowOffset = qRow * HEAD_DIM;
+
+            FragA fragsQ[D_BLOCKS];
+            FragA fragsDO[D_BLOCKS];
+#pragma unroll
+            for(uint32_t i = 0; i < D_BLOCKS; i++)
+            {
+                load_matrix_sync(fragsQ[i], q + qRowOffset + i * ROCWMMA_K, HEAD_DIM);
+                load_matrix_sync(fragsDO[i], dO + qRowOffset + i * ROCWMMA_K, HEAD_DIM);
+            }
+
+            // S = Q x K^T, dP = dO x V^T
+            FragAcc fragS, fragDP;
+            scoreBlock(fragS, fragsQ, fragsKT);
+            scoreBlock(fragDP, fragsDO, fragsVT);
+
+            // Only the diagonal block is partially masked
+            if(causal && qRow == kRow)
+            {
+                apply_epilogue(fragS,
+                               fragS,
+                               epilogue::AttentionMask<FragAcc>(make_coord2d(qRow, kRow), true));
+            }
+
+            FragAcc fragL, fragDelta, fragP, fragDS;
+            loadRowStat(fragL, lse + qRow);
+            loadRowStat(fragDelta, delta + qRow);
+            softmaxGrad(fragP, fragDS, fragS, fragDP, fragL, fragDelta, scaleLog2);
+
+            stageBlock(ldsP, fragP);
+            stageBlock(ldsDS, fragDS);
+
+            // dV += P^T x dO, dK += dS^T x Q
+            FragAT fragPT, fragDST;
+            load_matrix_sync(fragPT, ldsP, ROCWMMA_N);
+            load_matrix_sync(fragDST, ldsDS, ROCWMMA_N);
+#pragma unroll
+            for(uint32_t j = 0; j < O_BLOCKS; j++)
+            {
+                FragB fragDO, fragQ;
+                load_matrix_sync(fragDO, dO + qRowOffset + j * ROCWMMA_N, HEAD_DIM);
+                load_matrix_sync(fragQ, q + qRowOffset + j * ROCWMMA_N, HEAD_DIM);
+                mma_sync(fragsDV[j], fragPT, fragDO, fragsDV[j]);
+                mma_sync(fragsDK[j], fragDST, fragQ, fragsDK[j]);
+            }
+
+            // Atomic mode: dQ += scale * dS x K
+            if(dQAcc != nullptr)
+            {
+                FragA fragDSA;
+                load_matrix_sync(fragDSA, ldsDS, ROCWMMA_N);
+#pragma unroll
+                for(uint32_t j = 0; j < O_BLOCKS; j++)
+                {
+                    FragAcc fragDQ;
+                    fill_fragment(fragDQ, static_cast<ComputeT>(0));
+                    mma_sync(fragDQ, fragDSA, fragsK[j], fragDQ);
+                    apply_epilogue(fragDQ, fragDQ, epilogue::TensorScale<ComputeT>(scale));
+                    globalAtomicAddBlock(
+                        dQAcc + headOffset + qRowOffset + j * ROCWMMA_N, HEAD_DIM, fragDQ, ldsDQ);
+                }
+            }
+        }
+
+        // dK = scale * dS^T x Q
+#pragma unroll
+        for(uint32_t j = 0; j < O_BLOCKS; j++)
+        {
+            FragOut fragOut;
+            apply_epilogue(fragOut, fragsDK[j], epilogue::TensorScale<ComputeT>(scale));
+            store_matrix_sync(dK + kRowOffset + j * ROCWMMA_N, fragOut, HEAD_DIM, mem_row_major);
+
+            apply_epilogue(fragOut, fragsDV[j]);
+            store_matrix_sync(dV + kRowOffset + j * ROCWMMA_N, fragOut, HEAD_DIM, mem_row_major);
+        }
+    }
+}
+
+/// Deterministic dQ.
+/// Grid: (seqLen / (WAVES * ROCWMMA_M), batch), Block: (TBLOCK_X)
+/// Each wave owns ROCWMMA_M queries and sweeps over the key blocks in order.
+__global__ void __launch_bounds__(256) flash_attention_bwd_dq_d(uint32_t        seqLen,
+                                                                InputT const*   q,
+                                                                InputT const*   k,
+                                                                InputT const*   v,
+                                                                InputT const*   dO,
+                                                                ComputeT const* lse,
+                                                                ComputeT const* delta,
+                                                                OutputT*        dQ,
+                                                                ComputeT        scaleLog2,
+                                                                ComputeT        scale,
+                                                                bool            causal)
+{
+    if constexpr(!ROCWMMA_ARCH_HOST)
+    {
+        // Causal tiles are dispatched longest first
+        auto qTile      = causal ? gridDim.x - 1u - blockIdx.x : blockIdx.x;
+        auto waveIndex  = threadIdx.x / WARP_SIZE;
+        auto headRow    = blockIdx.y * seqLen;
+        auto headOffset = static_cast<uint64_t>(headRow) * HEAD_DIM;
+        auto qRow       = (qTile * WAVES + waveIndex) * ROCWMMA_M;
+        auto qRowOffset = headOffset + qRow * HEAD_DIM;
+
+        k += headOffset;
+        v += headOffset;
+
+        // Lds staging of this wave
+        HIP_DYNAMIC_SHARED(void*, localMemPtr);
+        auto* ldsDS = reinterpret_cast<InputT*>(localMemPtr) + waveIndex * 2u * LDS_BLOCK_SIZE;
+
+        // Q and dO blocks, and their row statistics, stay resident for the whole sweep
+        FragA fragsQ[D_BLOCKS];
+        FragA fragsDO[D_BLOCKS];
+#pragma unroll
+        for(uint32_t i = 0; i < D_BLOCKS; i++)
+        {
+            load_matrix_sync(fragsQ[i], q + qRowOffset + i * ROCWMMA_K, HEAD_DIM);
+            load_matrix_sync(fragsDO[i], dO + qRowOffset + i * ROCWMMA_K, HEAD_DIM);
+        }
+
+        FragAcc fragL, fragDelta;
+        loadRowStat(fragL, lse + headRow + qRow);
+        loadRowStat(fragDelta, delta + headRow + qRow);
+
+        FragAcc fragsDQ[O_BLOCKS];
+#pragma unroll
+        for(uint32_t j = 0; j < O_BLOCKS; j++)
+        {
+            fill_fragment(fragsDQ[j], static_cast<ComputeT>(0));
+        }
+
+        // Causal: the keys after the queries of this wave are fully masked
+        auto kEnd = causal ? qRow + ROCWMMA_M : seqLen;
+        for(uint32_t kRow = 0; kRow < kEnd; kRow += ROCWMMA_N)
+        {
+            auto kRowOffset = kRow * HEAD_DIM;
+
+            FragBT fragsKT[D_BLOCKS];
+            FragBT fragsVT[D_BLOCKS];
+#pragma unroll
+            for(uint32_t i = 0; i < D_BLOCKS; i++)
+            {
+                load_matrix_sync(fragsKT[i], k + kRowOffset + i * ROCWMMA_K, HEAD_DIM);
+                load_matrix_sync(fragsVT[i], v + kRowOffset + i * ROCWMMA_K, HEAD_DIM);
+            }
+
+            // S = Q x K^T, dP = dO x V^T
+            FragAcc fragS, fragDP;
+            scoreBlock(fragS, fragsQ, fragsKT);
+            scoreBlock(fragDP, fragsDO, fragsVT);
+
+            // Only the diagonal block is partially masked
+            if(causal && kRow == qRow)
+            {
+                apply_epilogue(fragS,
+                               fragS,
+                               epilogue::AttentionMask<FragAcc>(make_coord2d(qRow, kRow), true));
+            }
+
+            FragAcc fragP, fragDS;
+            softmaxGrad(fragP, fragDS, fragS, fragDP, fragL, fragDelta, scaleLog2);
+            stageBlock(ldsDS, fragDS);
+
+            // dQ += dS x K
+            FragA fragDSA;
+            load_matrix_sync(fragDSA, ldsDS, ROCWMMA_N);
+#pragma unroll
+            for(uint32_t j = 0; j < O_BLOCKS; j++)
+            {
+                FragB fragK;
+                load_matrix_sync(fragK, k + kRowOffset + j * ROCWMMA_N, HEAD_DIM);
+                mma_sync(fragsDQ[j], fragDSA, fragK, fragsDQ[j]);
+            }
+        }
+
+        // dQ = scale * dS x K
+#pragma unroll
+        for(uint32_t j = 0; j < O_BLOCKS; j++)
+        {
+            FragOut fragOut;
+            apply_epilogue(fragOut, fragsDQ[j], epilogue::TensorScale<ComputeT>(scale));
+            store_matrix_sync(dQ + qRowOffset + j * ROCWMMA_N, fragOut, HEAD_DIM, mem_row_major);
+        }
+    }
+}
+
+// Conversion of the atomic mode dQ workspace to the output type.
+__global__ void convert_dq_d(uint32_t size, ComputeT const* dQAcc, OutputT* dQ)
+{
+    auto i = blockIdx.x * blockDim.x + threadIdx.x;
+    if(i < size)
+    {
+        dQ[i] = static_cast<OutputT>(dQAcc[i]);
+    }
+}
+
+///
+/// Host reference
+///
+
+__host__ static inline void fillRandNormalized(InputT* mat, uint32_t size)
+{
+    // Small values in [-1, 1] keep the scores in a realistic range
+#pragma omp parallel for
+    for(int i = 0; i < size; ++i)
+    {
+        mat[i] = static_cast<InputT>(static_cast<float>(rand() % 17 - 8) / 8.0f);
+    }
+}
+
+// Forward pass, saving the base 2 log-sum-exp L of each row of scores:
+// P = exp2(S * scaleLog2 - L).
+__host__ void attention_fwd_cpu_h(uint32_t      batch,
+                                  uint32_t      seqLen,
+                                  InputT const* q,
+                                  InputT const* k,
+                                  InputT const* v,
+                                  OutputT*      o,
+                                  ComputeT*     lse,
+                                  ComputeT      scaleLog2,
+                                  bool          causal)
+{
+#pragma omp parallel for
+    for(int row = 0; row < batch * seqLen; ++row)
+    {
+        auto headOffset = static_cast<uint64_t>(row / seqLen) * seqLen * HEAD_DIM;
+        auto qRow       = q + static_cast<uint64_t>(row) * HEAD_DIM;
+        auto keys       = causal ? row % seqLen + 1u : seqLen;
+
+        std::vector<ComputeT> scores(keys);
+        auto                  rowMax = -std::numeric_limits<ComputeT>::infinity();
+        for(uint32_t j = 0; j < keys; ++j)
+        {
+            auto kRow = k + headOffset + j * HEAD_DIM;
+            auto acc  = static_cast<ComputeT>(0);
+            for(uint32_t d = 0; d < HEAD_DIM; ++d)
+            {
+                acc += static_cast<ComputeT>(qRow[d]) * static_cast<ComputeT>(kRow[d]);
+            }
+            scores[j] = acc * scaleLog2;
+            rowMax    = std::max(rowMax, scores[j]);
+        }
+
+        auto rowSum = static_cast<ComputeT>(0);
+        for(auto& s : scores)
+        {
+            s = std::exp2(s - rowMax);
+            rowSum += s;
+        }
+        lse[row] = rowMax + std::log2(rowSum);
+
+        for(uint32_t d = 0; d < HEAD_DIM; ++d)
+        {
+            auto acc = static_cast<ComputeT>(0);
+            for(uint32_t j = 0; j < keys; ++j)
+            {
+                acc += scores[j] * static_cast<ComputeT>(v[headOffset + j * HEAD_DIM + d]);
+            }
+            o[static_cast<uint64_t>(row) * HEAD_DIM + d] = static_cast<OutputT>(acc / rowSum);
+        }
+    }
+}
+
+// Backward pass, materializing P and dS of one head at a time.
+__host__ void attention_bwd_cpu_h(uint32_t        batch,
+                                  uint32_t        seqLen,
+                                  InputT const*   q,
+                                  InputT const*   k,
+                                  InputT const*   v,
+                                  OutputT const*  o,
+                                  InputT const*   dO,
+                                  ComputeT const* lse,
+                                  OutputT*        dQ,
+                                  OutputT*        dK,
+                                  OutputT*        dV,
+                                  ComputeT        scaleLog2,
+                                  ComputeT        scale,
+                                  bool            causal)
+{
+    auto toFloat = [](auto value) { return static_cast<ComputeT>(value); };
+
+    std::vector<ComputeT> matP(static_cast<size_t>(seqLen) * seqLen);
+    std::vector<ComputeT> matDS(static_cast<size_t>(seqLen) * seqLen);
+
+    for(uint32_t head = 0; head < batch; ++head)
+    {
+        auto offset = static_cast<uint64_t>(head) * seqLen * HEAD_DIM;
+
+        // P and dS rows, and dQ = scale * dS x K
+#pragma omp parallel for
+        for(int i = 0; i < seqLen; ++i)
+        {
+            auto row   = offset + static_cast<uint64_t>(i) * HEAD_DIM;
+            auto delta = static_cast<ComputeT>(0);
+            for(uint32_t d = 0; d < HEAD_DIM; ++d)
+            {
+                delta += toFloat(dO[row + d]) * toFloat(o[row + d]);
+            }
+
+            for(uint32_t j = 0; j < seqLen; ++j)
+            {
+                auto col = offset + static_cast<uint64_t>(j) * HEAD_DIM;
+                auto s   = static_cast<ComputeT>(0);
+                auto dp  = static_cast<ComputeT>(0);
+                for(uint32_t d = 0; d < HEAD_DIM; ++d)
+                {
+                    s += toFloat(q[row + d]) * toFloat(k[col + d]);
+                    dp += toFloat(dO[row + d]) * toFloat(v[col + d]);
+                }
+
+                auto p = (causal && j > i)
+                             ? static_cast<ComputeT>(0)
+                             : std::exp2(s * scaleLog2 - lse[head * seqLen + i]);
+                matP[static_cast<size_t>(i) * seqLen + j]  = p;
+                matDS[static_cast<size_t>(i) * seqLen + j] = p * (dp - delta);
+            }
+
+            for(uint32_t d = 0; d < HEAD_DIM; ++d)
+            {
+                auto acc = static_cast<ComputeT>(0);
+                for(uint32_t j = 0; j < seqLen; ++j)
+                {
+                    acc += matDS[static_cast<size_t>(i) * seqLen + j]
+                           * toFloat(k[offset + static_cast<uint64_t>(j) * HEAD_DIM + d]);
+                }
+                dQ[row + d] = static_cast<OutputT>(scale * acc);
+            }
+        }
+
+        // dK = scale * dS^T x Q, dV = P^T x dO
+#pragma omp parallel for
+        for(int j = 0; j < seqLen; ++j)
+        {
+            auto col = offset + static_cast<uint64_t>(j) * HEAD_DIM;
+            for(uint32_t d = 0; d < HEAD_DIM; ++d)
+            {
+                auto accK = static_cast<ComputeT>(0);
+                auto accV = static_cast<ComputeT>(0);
+                for(uint32_t i = 0; i < seqLen; ++i)
+                {
+                    auto row = offset + static_cast<uint64_t>(i) * HEAD_DIM;
+                    accK += matDS[static_cast<size_t>(i) * seqLen + j] * toFloat(q[row + d]);
+                    accV += matP[static_cast<size_t>(i) * seqLen + j] * toFloat(dO[row + d]);
+                }
+                dK[col + d] = static_cast<OutputT>(scale * accK);
+                dV[col + d] = static_cast<OutputT>(accV);
+            }
+        }
+    }
+}
+
+ROCWMMA_HOST void attention_bwd_test(uint32_t batch, uint32_t seqLen, bool causal)
+{
+    // Runtime checks for host parameters
+    uint32_t hWAVES     = isGfx9() ? gfx9Params::WAVES : gfx11Params::WAVES;
+    uint32_t hROCWMMA_M = isGfx9() ? gfx9Params::ROCWMMA_M : gfx11Params::ROCWMMA_M;
+    uint32_t hROCWMMA_N = isGfx9() ? gfx9Params::ROCWMMA_N : gfx11Params::ROCWMMA_N;
+    uint32_t hROCWMMA_K = isGfx9() ? gfx9Params::ROCWMMA_K : gfx11Params::ROCWMMA_K;
+
+    // Runtime warp calculation (host code needs to query warpsize dynamically)
+    auto warpSize = getWarpSize();
+
+    if((isGfx11() || isGfx12()) && getWarpSize() != Constants::AMDGCN_WAVE_SIZE_32)
+    {
+        std::cout << "Unsupported wave size!\n";
+        return;
+    }
+
+    if(isGfx9() && getWarpSize() != Constants::AMDGCN_WAVE_SIZE_64)
+    {
+        std::cout << "Unsupported wave size!\n";
+        return;
+    }
+
+    // Bounds check
+    if(seqLen % (hWAVES * hROCWMMA_M))
+    {
+        std::cout << "Unsupported sequence length!\n";
+        return;
+    }
+
+    auto scale     = static_cast<ComputeT>(1.0 / std::sqrt(static_cast<double>(HEAD_DIM)));
+    auto scaleLog2 = static_cast<ComputeT>(scale * M_LOG2E);
+
+    std::cout << "Initializing host data..." << std::endl;
+
+    const uint32_t rows        = batch * seqLen;
+    const size_t   elementsQKV = static_cast<size_t>(rows) * HEAD_DIM;
+
+    std::vector<InputT> matrixQ(elementsQKV);
+    std::vector<InputT> matrixK(elementsQKV);
+    std::vector<InputT> matrixV(elementsQKV);
+    std::vector<InputT> matrixDO(elementsQKV);
+
+    fillRandNormalized(matrixQ.data(), elementsQKV);
+    fillRandNormalized(matrixK.data(), elementsQKV);
+    fillRandNormalized(matrixV.data(), elementsQKV);
+    fillRandNormalized(matrixDO.data(), elementsQKV);
+
+    // Output and row statistics saved by the forward pass
+    std::vector<OutputT>  matrixO(elementsQKV);
+    std::vector<ComputeT> vectorL(rows);
+    attention_fwd_cpu_h(batch,
+                        seqLen,
+                        matrixQ.data(),
+                        matrixK.data(),
+                        matrixV.data(),
+                        matrixO.data(),
+                        vectorL.data(),
+                        scaleLog2,
+                        causal);
+
+    std::cout << "Initializing device data..." << std::endl;
+
+    InputT*   d_q;
+    InputT*   d_k;
+    InputT*   d_v;
+    OutputT*  d_o;
+    InputT*   d_dO;
+    ComputeT* d_lse;
+    ComputeT* d_delta;
+    OutputT*  d_dQ;
+    OutputT*  d_dK;
+    OutputT*  d_dV;
+    ComputeT* d_dQAcc;
+
+    const size_t bytesQKV   = elementsQKV * sizeof(InputT);
+    const size_t bytesStats = rows * sizeof(ComputeT);
+    const size_t bytesDQAcc = elementsQKV * sizeof(ComputeT);
+
+    CHECK_HIP_ERROR(hipMalloc(&d_q, bytesQKV));
+    CHECK_HIP_ERROR(hipMalloc(&d_k, bytesQKV));
+    CHECK_HIP_ERROR(hipMalloc(&d_v, bytesQKV));
+    CHECK_HIP_ERROR(hipMalloc(&d_o, bytesQKV));
+    CHECK_HIP_ERROR(hipMalloc(&d_dO, bytesQKV));
+    CHECK_HIP_ERROR(hipMalloc(&d_lse, bytesStats));
+    CHECK_HIP_ERROR(hipMalloc(&d_delta, bytesStats));
+    CHECK_HIP_ERROR(hipMalloc(&d_dQ, bytesQKV));
+    CHECK_HIP_ERROR(hipMalloc(&d_dK, bytesQKV));
+    CHECK_HIP_ERROR(hipMalloc(&d_dV, bytesQKV));
+    CHECK_HIP_ERROR(hipMalloc(&d_dQAcc, bytesDQAcc));
+
+    CHECK_HIP_ERROR(hipMemcpy(d_q, matrixQ.data(), bytesQKV, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_k, matrixK.data(), bytesQKV, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_v, matrixV.data(), bytesQKV, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_o, matrixO.data(), bytesQKV, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_dO, matrixDO.data(), bytesQKV, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_lse, vectorL.data(), bytesStats, hipMemcpyHostToDevice));
+
+    auto bwdBlockDim         = dim3(hWAVES * warpSize);
+    auto bwdGridDim          = dim3(seqLen / (hWAVES * hROCWMMA_M), batch);
+    auto elementwiseBlockDim = dim3(256u);
+
+    auto launchDelta = [&]() {
+        hipExtLaunchKernelGGL(attention_bwd_delta_d,
+                              dim3(rocwmma::ceilDiv(rows, elementwiseBlockDim.x)),
+                              elementwiseBlockDim,
+                              0,
+                              0,
+                              nullptr,
+                              nullptr,
+                              0,
+                              rows,
+                              d_o,
+                              d_dO,
+                              d_delta);
+    };
+
+    auto launchDKDV = [&](ComputeT* dQAcc) {
+        hipExtLaunchKernelGGL(flash_attention_bwd_dkdv_d,
+                              bwdGridDim,
+                              bwdBlockDim,
+                              LDS_USAGE,
+                              0,
+                              nullptr,
+                              nullptr,
+                              0,
+                              seqLen,
+                              d_q,
+                              d_k,
+                              d_v,
+                              d_dO,
+                              d_lse,
+                              d_delta,
+                              d_dK,
+                              d_dV,
+                              dQAcc,
+                              scaleLog2,
+                              scale,
+                              causal);
+    };
+
+    // Deterministic: dK / dV kernel, then dQ kernel
+    auto deterministicKernel = [&]() {
+        launchDelta();
+        launchDKDV(nullptr);
+        hipExtLaunchKernelGGL(flash_attention_bwd_dq_d,
+                              bwdGridDim,
+                              bwdBlockDim,
+                              LDS_USAGE,
+                              0,
+                              nullptr,
+                              nullptr,
+                              0,
+                              seqLen,
+                              d_q,
+                              d_k,
+                              d_v,
+                              d_dO,
+                              d_lse,
+                              d_delta,
+                              d_dQ,
+                              scaleLog2,
+                              scale,
+                              causal);
+    };
+
+    // Atomic: dK / dV kernel accumulating dQ into the fp32 workspace
+    auto atomicKernel = [&]() {
+        launchDelta();
+        CHECK_HIP_ERROR(hipMemsetAsync(d_dQAcc, 0, bytesDQAcc));
+        launchDKDV(d_dQAcc);
+        hipExtLaunchKernelGGL(convert_dq_d,
+                              dim3(rocwmma::ceilDiv(elementsQKV, elementwiseBlockDim.x)),
+                              elementwiseBlockDim,
+                              0,
+                              0,
+                              nullptr,
+                              nullptr,
+                              0,
+                              static_cast<uint32_t>(elementsQKV),
+                              d_dQAcc,
+                              d_dQ);
+    };
+
+    // Saved activations per head: the row statistics L and Delta, instead of P
+    std::cout << "Saved activations per head: " << 2u * seqLen * sizeof(ComputeT)
+              << " bytes of row statistics, instead of "
+              << static_cast<uint64_t>(seqLen) * seqLen * sizeof(OutputT) << " bytes of P"
+              << std::endl;
+
+    // Only the unmasked (query, key) pairs count as useful work
+    uint32_t attendedPairs = causal ? seqLen * (seqLen + 1u) / 2u : seqLen * seqLen;
+
+    // Runs are timed individually, with warm and cold caches
+    BenchmarkHarness harness;
+
+    // Echo performance
+    // Five GEMMs of attendedPairs x HEAD_DIM per head: S, dP, dV, dK and dQ
+    auto echo = [&](const char* kernelName, auto&& kernel) {
+        auto gFlops = calculateGFlops(batch, attendedPairs, 5u * HEAD_DIM);
+
+        for(auto cacheState :
+            {BenchmarkHarness::CacheState::Warm, BenchmarkHarness::CacheState::Cold})
+        {
+            auto stats        = harness.run(kernel, cacheState);
+            auto tFlopsPerSec = calculateTFlopsPerSec(
+                batch, attendedPairs, 5u * HEAD_DIM, stats.mMedianMs);
+
+            std::cout << kernelName << ", " << hWAVES << ", " << hROCWMMA_M << ", "
+                      << hROCWMMA_N << ", " << hROCWMMA_K << ", " << batch << ", " << seqLen
+                      << ", " << HEAD_DIM << ", " << causal << ", "
+                      << (cacheState == BenchmarkHarness::CacheState::Warm ? "warm" : "cold")
+                      << ", " << stats.mMedianMs << ", " << gFlops << ", " << tFlopsPerSec
+                      << ", ";
+            BenchmarkHarness::printStats(std::cout, stats) << std::endl;
+        }
+    };
+
+#if !NDEBUG
+
+    // Setup and run reference computation
+    std::vector<OutputT> matrixDQ(elementsQKV);
+    std::vector<OutputT> matrixDK(elementsQKV);
+    std::vector<OutputT> matrixDV(elementsQKV);
+    std::vector<OutputT> matrixDQ_ref(elementsQKV);
+    std::vector<OutputT> matrixDK_ref(elementsQKV);
+    std::vector<OutputT> matrixDV_ref(elementsQKV);
+    bool                 refComputed = false;
+
+    auto validate = [&]() {
+        std::cout << "Validating result with reference..." << std::endl;
+
+        if(!refComputed)
+        {
+            std::cout << "Please wait. Large sizes can take a while!" << std::endl;
+
+            attention_bwd_cpu_h(batch,
+                                seqLen,
+                                matrixQ.data(),
+                                matrixK.data(),
+                                matrixV.data(),
+                                matrixO.data(),
+                                matrixDO.data(),
+                                vectorL.data(),
+                                matrixDQ_ref.data(),
+                                matrixDK_ref.data(),
+                                matrixDV_ref.data(),
+                                scaleLog2,
+                                scale,
+                                causal);
+            refComputed = true;
+        }
+
+        // Bring kernel results back to host
+        CHECK_HIP_ERROR(hipMemcpy(matrixDQ.data(), d_dQ, bytesQKV, hipMemcpyDeviceToHost));
+        CHECK_HIP_ERROR(hipMemcpy(matrixDK.data(), d_dK, bytesQKV, hipMemcpyDeviceToHost));
+        CHECK_HIP_ERROR(hipMemcpy(matrixDV.data(), d_dV, bytesQKV, hipMemcpyDeviceToHost));
+
+        // P and dS are rounded to fp16 before the gradient products
+        for(auto& [name, result, reference] :
+            {std::make_tuple("dQ", matrixDQ.data(), matrixDQ_ref.data()),
+             std::make_tuple("dK", matrixDK.data(), matrixDK_ref.data()),
+             std::make_tuple("dV", matrixDV.data(), matrixDV_ref.data())})
+        {
+            auto res = compareEqual(result, reference, elementsQKV, 50.0);
+
+            std::cout << name << ": " << (std::get<0>(res) ? "PASSED" : "FAILED")
+                      << ", max relative error: " << std::get<1>(res) << std::endl;
+        }
+    };
+
+#endif // !NDEBUG
+
+    std::cout << "Kernel, "
+              << "Waves, "
+              << "BlkM, BlkN, BlkK, "
+              << "Batch, SeqLen, HeadDim, Causal, "
+              << "Cache, elapsedMs, Problem Size(GFlops), TFlops/s, "
+              << BenchmarkHarness::statsHeader() << std::endl;
+
+    echo("Deterministic", deterministicKernel);
+
+#if !NDEBUG
+    validate();
+#endif // !NDEBUG
+
+    // Fill outputs with NaN to catch contamination
+    CHECK_HIP_ERROR(hipMemset(d_dQ, 0xFF, bytesQKV));
+    CHECK_HIP_ERROR(hipMemset(d_dK, 0xFF, bytesQKV));
+    CHECK_HIP_ERROR(hipMemset(d_dV, 0xFF, bytesQKV));
+
+    echo("Atomic", atomicKernel);
+
+#if !NDEBUG
+    validate();
+#endif // !NDEBUG
+
+    // Release device memory
+    CHECK_HIP_ERROR(hipFree(d_q));
+    CHECK_HIP_ERROR(hipFree(d_k));
+    CHECK_HIP_ERROR(hipFree(d_v));
+    CHECK_HIP_ERROR(hipFree(d_o));
+    CHECK_HIP_ERROR(hipFree(d_dO));
+    CHECK_HIP_ERROR(hipFree(d_lse));
+    CHECK_HIP_ERROR(hipFree(d_delta));
+    CHECK_HIP_ERROR(hipFree(d_dQ));
+    CHECK_HIP_ERROR(hipFree(d_dK));
+    CHECK_HIP_ERROR(hipFree(d_dV));
+    CHECK_HIP_ERROR(hipFree(d_dQAcc));
+
+    std::cout << "Finished!" << std::endl;
+}
+
+int main()
+{
+    // Batch of 16 heads, head dimension HEAD_DIM, without and with a causal mask
+    attention_bwd_test(16, 2048, false);
+    attention_bwd_test(16, 2048, true);
+    return 0;
+}
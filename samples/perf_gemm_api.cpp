@@ -0,0 +1,424 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <iostream>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_fp16.h>
+#include <hip/hip_runtime.h>
+
+#include <rocwmma/rocwmma.hpp>
+#include <rocwmma/rocwmma_gemm.hpp>
+
+#include "benchmark_harness.hpp"
+#include "common.hpp"
+
+using rocwmma::float16_t;
+using rocwmma::float32_t;
+using rocwmma::operation_t;
+
+/* Motivation
+*
+* The GEMM samples each hard code a kernel for one data layout, with sizes
+* that are multiples of the macro tile. Applications that need a GEMM end up
+* copying one of them and adapting it, each copy missing some of the
+* optimizations of the others.
+*
+* The rocwmma_gemm API instead computes D = alpha * op(A) x op(B) + beta * C
+* from the host, with a handle owning the stream and workspace:
+* - Kernels hold the validated warp tile of each target being compiled.
+* - Edge tiles are bounded, so sizes and leading dimensions are unpadded.
+* - Deep K over few macro tiles is split over the CUs through the workspace.
+* - Strided batched and grouped GEMMs each run in a single launch.
+*
+* This sample runs each entry point over aligned, ragged and split-K shapes
+* and all transpositions, and validates them against the host reference in
+* debug builds.
+*/
+
+// Column major BLAS convention: a transposed operand is the row major view of the stored matrix
+template <typename LayoutA, typename LayoutB>
+void gemmCPU(uint32_t         m,
+             uint32_t         n,
+             uint32_t         k,
+             float16_t const* a,
+             uint32_t         lda,
+             float16_t const* b,
+             uint32_t         ldb,
+             float16_t const* c,
+             float16_t*       d,
+             uint32_t         ldcd,
+             float32_t        alpha,
+             float32_t        beta)
+{
+    gemm_cpu_h<float16_t, float16_t, float32_t, LayoutA, LayoutB, rocwmma::col_major>(
+        m, n, k, a, b, c, d, lda, ldb, ldcd, ldcd, alpha, beta);
+}
+
+void gemmCPU(operation_t      opA,
+             operation_t      opB,
+             uint32_t         m,
+             uint32_t         n,
+             uint32_t         k,
+             float16_t const* a,
+             uint32_t         lda,
+             float16_t const* b,
+             uint32_t         ldb,
+             float16_t const* c,
+             float16_t*       d,
+             uint32_t         ldcd,
+             float32_t        alpha,
+             float32_t        beta)
+{
+    using rocwmma::col_major;
+    using rocwmma::row_major;
+
+    bool transA = opA == rocwmma::operation_transpose;
+    bool transB = opB == rocwmma::operation_transpose;
+    if(!transA && !transB)
+    {
+        gemmCPU<col_major, col_major>(m, n, k, a, lda, b, ldb, c, d, ldcd, alpha, beta);
+    }
+    else if(!transA && transB)
+    {
+        gemmCPU<col_major, row_major>(m, n, k, a, lda, b, ldb, c, d, ldcd, alpha, beta);
+    }
+    else if(transA && !transB)
+    {
+        gemmCPU<row_major, col_major>(m, n, k, a, lda, b, ldb, c, d, ldcd, alpha, beta);
+    }
+    else
+    {
+        gemmCPU<row_major, row_major>(m, n, k, a, lda, b, ldb, c, d, ldcd, alpha, beta);
+    }
+}
+
+char const* opsName(operation_t opA, operation_t opB)
+{
+    static char const* names[] = {"NN", "NT", "TN", "TT"};
+    return names[opA * 2u + opB];
+}
+
+// Runs the GEMM, or batchCount strided GEMMs of the same size. The leading dimensions are
+// padded by ldPad elements, to exercise unaligned leading dimensions.
+__host__ void gemm_api_test(rocwmma::gemm_handle_t handle,
+                            operation_t            opA,
+                            operation_t            opB,
+                            uint32_t               m,
+                            uint32_t               n,
+                            uint32_t               k,
+                            uint32_t               batchCount,
+                            uint32_t               ldPad)
+{
+    auto transA = opA == rocwmma::operation_transpose;
+    auto transB = opB == rocwmma::operation_transpose;
+
+    // Stored matrices are col major: rows x cols with ld >= rows
+    uint32_t lda  = (transA ? k : m) + ldPad;
+    uint32_t ldb  = (transB ? n : k) + ldPad;
+    uint32_t ldcd = m + ldPad;
+
+    uint64_t strideA  = static_cast<uint64_t>(lda) * (transA ? m : k);
+    uint64_t strideB  = static_cast<uint64_t>(ldb) * (transB ? k : n);
+    uint64_t strideCD = static_cast<uint64_t>(ldcd) * n;
+
+    float32_t alpha = 2.1f;
+    float32_t beta  = 2.0f;
+
+    // Initialize host data
+    std::vector<float16_t> matrixA(strideA * batchCount);
+    std::vector<float16_t> matrixB(strideB * batchCount);
+    std::vector<float16_t> matrixC(strideCD * batchCount);
+    std::vector<float16_t> matrixD(matrixC.size());
+
+    fill<float16_t>(matrixA.data(), 1u, strideA, batchCount);
+    fill<float16_t>(matrixB.data(), 1u, strideB, batchCount);
+    fill<float16_t>(matrixC.data(), 1u, strideCD, batchCount);
+
+    // Allocate and copy device memory
+    float16_t *d_a, *d_b, *d_c, *d_d;
+
+    const size_t bytesA  = matrixA.size() * sizeof(float16_t);
+    const size_t bytesB  = matrixB.size() * sizeof(float16_t);
+    const size_t bytesCD = matrixC.size() * sizeof(float16_t);
+
+    CHECK_HIP_ERROR(hipMalloc(&d_a, bytesA));
+    CHECK_HIP_ERROR(hipMalloc(&d_b, bytesB));
+    CHECK_HIP_ERROR(hipMalloc(&d_c, bytesCD));
+    CHECK_HIP_ERROR(hipMalloc(&d_d, bytesCD));
+
+    CHECK_HIP_ERROR(hipMemcpy(d_a, matrixA.data(), bytesA, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_b, matrixB.data(), bytesB, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_c, matrixC.data(), bytesCD, hipMemcpyHostToDevice));
+
+    // Start the output from C: the padding of the leading dimension is never written
+    CHECK_HIP_ERROR(hipMemcpy(d_d, d_c, bytesCD, hipMemcpyDeviceToDevice));
+
+    auto kernel = [&]() {
+        if(batchCount == 1u)
+        {
+            CHECK_HIP_ERROR(rocwmma::gemm(
+                handle, opA, opB, m, n, k, alpha, d_a, lda, d_b, ldb, beta, d_c, ldcd, d_d, ldcd));
+        }
+        else
+        {
+            CHECK_HIP_ERROR(rocwmma::gemm_strided_batched(handle,
+                                                          opA,
+                                                          opB,
+                                                          m,
+                                                          n,
+                                                          k,
+                                                          alpha,
+                                                          d_a,
+                                                          lda,
+                                                          strideA,
+                                                          d_b,
+                                                          ldb,
+                                                          strideB,
+                                                          beta,
+                                                          d_c,
+                                                          ldcd,
+                                                          strideCD,
+                                                          d_d,
+                                                          ldcd,
+                                                          strideCD,
+                                                          batchCount));
+        }
+    };
+
+    size_t workspaceBytes = 0u;
+    CHECK_HIP_ERROR(rocwmma::gemm_get_workspace_size<float16_t>(
+        handle, m, n, k, batchCount, &workspaceBytes));
+
+    BenchmarkHarness harness;
+    auto             stats = harness.run(kernel);
+    auto             flops = calculateGFlops(m, n, k) * batchCount;
+
+    std::cout << (batchCount == 1u ? "gemm" : "gemm_strided_batched") << ", "
+              << opsName(opA, opB) << ", " << m << ", " << n << ", " << k << ", " << batchCount
+              << ", " << workspaceBytes << ", " << stats.mMedianMs << ", " << flops << ", "
+              << flops / stats.mMedianMs * 1.0e-3 << ", ";
+    BenchmarkHarness::printStats(std::cout, stats) << std::endl;
+
+#if !NDEBUG
+
+    CHECK_HIP_ERROR(hipMemcpy(matrixD.data(), d_d, bytesCD, hipMemcpyDeviceToHost));
+
+    std::vector<float16_t> matrixRef(matrixC);
+    for(uint32_t i = 0u; i < batchCount; i++)
+    {
+        gemmCPU(opA,
+                opB,
+                m,
+                n,
+                k,
+                matrixA.data() + i * strideA,
+                lda,
+                matrixB.data() + i * strideB,
+                ldb,
+                matrixC.data() + i * strideCD,
+                matrixRef.data() + i * strideCD,
+                ldcd,
+                alpha,
+                beta);
+    }
+
+    auto res = compareEqual<float16_t>(matrixD.data(), matrixRef.data(), matrixD.size());
+    std::cout << "Validation: " << (std::get<0>(res) ? "PASSED" : "FAILED")
+              << ", max relative error: " << std::get<1>(res) << std::endl;
+
+#endif // !NDEBUG
+
+    // Release device memory
+    CHECK_HIP_ERROR(hipFree(d_a));
+    CHECK_HIP_ERROR(hipFree(d_b));
+    CHECK_HIP_ERROR(hipFree(d_c));
+    CHECK_HIP_ERROR(hipFree(d_d));
+}
+
+// Runs a group of GEMMs of the same N and K over a distribution of M, e.g. the tokens routed
+// to each expert of a Mixture of Experts layer
+__host__ void gemm_grouped_api_test(rocwmma::gemm_handle_t       handle,
+                                    std::vector<uint32_t> const& groupM,
+                                    uint32_t                     n,
+                                    uint32_t                     k)
+{
+    using Problem = rocwmma::gemm_grouped_problem<float16_t, float16_t>;
+
+    auto opA = rocwmma::operation_transpose;
+    auto opB = rocwmma::operation_none;
+
+    auto groupCount = static_cast<uint32_t>(groupM.size());
+
+    // Each problem at its own offset of one allocation per operand
+    std::vector<uint64_t> offsetsA(groupCount + 1u, 0u);
+    std::vector<uint64_t> offsetsCD(groupCount + 1u, 0u);
+    for(uint32_t i = 0u; i < groupCount; i++)
+    {
+        offsetsA[i + 1u]  = offsetsA[i] + static_cast<uint64_t>(groupM[i]) * k;
+        offsetsCD[i + 1u] = offsetsCD[i] + static_cast<uint64_t>(groupM[i]) * n;
+    }
+    auto sizeB = static_cast<uint64_t>(k) * n * groupCount;
+
+    float32_t alpha = 1.0f;
+    float32_t beta  = 0.0f;
+
+    std::vector<float16_t> matrixA(offsetsA[groupCount]);
+    std::vector<float16_t> matrixB(sizeB);
+    std::vector<float16_t> matrixD(offsetsCD[groupCount]);
+
+    fill<float16_t>(matrixA.data(), 1u, matrixA.size(), 1u);
+    fill<float16_t>(matrixB.data(), 1u, matrixB.size(), 1u);
+
+    float16_t *d_a, *d_b, *d_d;
+
+    const size_t bytesA = matrixA.size() * sizeof(float16_t);
+    const size_t bytesB = matrixB.size() * sizeof(float16_t);
+    const size_t bytesD = matrixD.size() * sizeof(float16_t);
+
+    CHECK_HIP_ERROR(hipMalloc(&d_a, bytesA));
+    CHECK_HIP_ERROR(hipMalloc(&d_b, bytesB));
+    CHECK_HIP_ERROR(hipMalloc(&d_d, bytesD));
+
+    CHECK_HIP_ERROR(hipMemcpy(d_a, matrixA.data(), bytesA, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_b, matrixB.data(), bytesB, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemset(d_d, 0xFF, bytesD));
+
+    // A of each expert is its row major tokens x k activations, B its k x n weights.
+    // C is not read with beta 0.
+    std::vector<Problem> problems(groupCount);
+    for(uint32_t i = 0u; i < groupCount; i++)
+    {
+        auto m      = groupM[i];
+        problems[i] = {m,
+                       n,
+                       k,
+                       d_a + offsetsA[i],
+                       k,
+                       d_b + static_cast<uint64_t>(i) * k * n,
+                       k,
+                       nullptr,
+                       std::max(m, 1u),
+                       d_d + offsetsCD[i],
+                       std::max(m, 1u),
+                       alpha,
+                       beta};
+    }
+
+    auto kernel = [&]() {
+        CHECK_HIP_ERROR(rocwmma::gemm_grouped(handle, opA, opB, problems.data(), groupCount));
+    };
+
+    BenchmarkHarness harness;
+    auto             stats = harness.run(kernel);
+
+    double   flops  = 0.0;
+    uint32_t totalM = 0u;
+    for(auto m : groupM)
+    {
+        flops += calculateGFlops(m, n, k);
+        totalM += m;
+    }
+
+    std::cout << "gemm_grouped, " << opsName(opA, opB) << ", " << totalM << ", " << n << ", "
+              << k << ", " << groupCount << ", "
+              << rocwmma::gemm_grouped_workspace_size<float16_t, float16_t>(groupCount) << ", "
+              << stats.mMedianMs << ", " << flops << ", " << flops / stats.mMedianMs * 1.0e-3
+              << ", ";
+    BenchmarkHarness::printStats(std::cout, stats) << std::endl;
+
+#if !NDEBUG
+
+    CHECK_HIP_ERROR(hipMemcpy(matrixD.data(), d_d, bytesD, hipMemcpyDeviceToHost));
+
+    std::vector<float16_t> matrixRef(matrixD.size());
+    for(uint32_t i = 0u; i < groupCount; i++)
+    {
+        auto m = groupM[i];
+        gemmCPU(opA,
+                opB,
+                m,
+                n,
+                k,
+                matrixA.data() + offsetsA[i],
+                k,
+                matrixB.data() + static_cast<uint64_t>(i) * k * n,
+                k,
+                matrixRef.data() + offsetsCD[i],
+                matrixRef.data() + offsetsCD[i],
+                std::max(m, 1u),
+                alpha,
+                beta);
+    }
+
+    auto res = compareEqual<float16_t>(matrixD.data(), matrixRef.data(), matrixD.size());
+    std::cout << "Validation: " << (std::get<0>(res) ? "PASSED" : "FAILED")
+              << ", max relative error: " << std::get<1>(res) << std::endl;
+
+#endif // !NDEBUG
+
+    CHECK_HIP_ERROR(hipFree(d_a));
+    CHECK_HIP_ERROR(hipFree(d_b));
+    CHECK_HIP_ERROR(hipFree(d_d));
+}
+
+int main()
+{
+    rocwmma::gemm_handle_t handle;
+    CHECK_HIP_ERROR(rocwmma::gemm_create_handle(&handle));
+
+    std::cout << "Api, Ops, MatM, MatN, MatK, Batch, Workspace(B), elapsedMs, "
+              << "Problem Size(GFlops), TFlops/s, " << BenchmarkHarness::statsHeader()
+              << std::endl;
+
+    auto none      = rocwmma::operation_none;
+    auto transpose = rocwmma::operation_transpose;
+
+    // Aligned and ragged shapes, over all transpositions
+    for(auto opA : {none, transpose})
+    {
+        for(auto opB : {none, transpose})
+        {
+            gemm_api_test(handle, opA, opB, 2048u, 2048u, 2048u, 1u, 0u);
+            gemm_api_test(handle, opA, opB, 1000u, 1030u, 520u, 1u, 3u);
+        }
+    }
+
+    // Few macro tiles over deep K: split-K through the workspace
+    gemm_api_test(handle, none, transpose, 256u, 256u, 16384u, 1u, 0u);
+    gemm_api_test(handle, none, transpose, 100u, 72u, 8200u, 1u, 1u);
+
+    // Strided batched, e.g. attention heads
+    gemm_api_test(handle, transpose, none, 384u, 384u, 64u, 32u, 0u);
+    gemm_api_test(handle, none, none, 129u, 65u, 1000u, 8u, 2u);
+
+    // Grouped, tokens per expert of a Mixture of Experts layer, including an idle expert
+    gemm_grouped_api_test(handle, {512u, 37u, 1024u, 0u, 256u, 700u, 64u, 1u}, 1024u, 512u);
+
+    CHECK_HIP_ERROR(rocwmma::gemm_destroy_handle(handle));
+    return 0;
+}
@@ -0,0 +1,216 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef ROCWMMA_SAMPLES_PERF_GOLDEN_HPP
+#define ROCWMMA_SAMPLES_PERF_GOLDEN_HPP
+
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include <hip/hip_runtime.h>
+
+#include "benchmark_harness.hpp"
+#include "common.hpp"
+
+// Golden throughput check of the perf samples in the perf regression suite.
+//
+// The <sample>_perf_regression targets compile a perf sample with ROCWMMA_PERF_GOLDEN_DIR,
+// the golden directory of the perf regression tests. Each warm run is then compared with the
+// latest record of the same sample, kernel, thread block and shape in <dir>/gfx<arch>.json,
+// the rocwmma-bench-1 JSON lines of the tests with suite "samples":
+// : Runs fail when their throughput, the golden median time over the current median time,
+//   drops more than ROCWMMA_PERF_TOLERANCE percent (default 5) below the golden.
+// : Runs without a golden record fail.
+// : Devices without a golden file are skipped, with exit code 77.
+//
+// With ROCWMMA_BENCH_OUTPUT set, warm runs are also appended to that file as records, to
+// collect the goldens on reference hardware.
+class PerfGolden
+{
+public:
+    static PerfGolden& instance()
+    {
+        static PerfGolden sInstance;
+        return sInstance;
+    }
+
+    void check(char const*           sample,
+               char const*           kernel,
+               uint32_t              tblockX,
+               uint32_t              tblockY,
+               uint32_t              m,
+               uint32_t              n,
+               uint32_t              k,
+               BenchmarkStats const& stats)
+    {
+        auto record = toJson(sample, kernel, tblockX, tblockY, m, n, k, stats);
+        if(auto output = std::getenv("ROCWMMA_BENCH_OUTPUT"); output != nullptr && *output != '\0')
+        {
+            std::ofstream(output, std::ios::app) << record << std::endl;
+        }
+
+#ifdef ROCWMMA_PERF_GOLDEN_DIR
+        if(mStatus == NoGolden || stats.mMedianMs <= 0.0)
+        {
+            return;
+        }
+
+        std::ifstream file(std::string(ROCWMMA_PERF_GOLDEN_DIR) + "/" + mArch + ".json");
+        if(!file.is_open())
+        {
+            std::cout << "No perf golden for " << mArch << " in " << ROCWMMA_PERF_GOLDEN_DIR
+                      << ", skipped" << std::endl;
+            mStatus = NoGolden;
+            return;
+        }
+
+        // Latest golden wins when the file holds repeated measurements
+        double      goldenMs = 0.0;
+        std::string line;
+        while(std::getline(file, line))
+        {
+            if(field(line, "suite") == "samples" && field(line, "arch") == mArch
+               && field(line, "problem_type") == sample && field(line, "kernel_config") == kernel
+               && field(line, "tblock_x") == std::to_string(tblockX)
+               && field(line, "tblock_y") == std::to_string(tblockY)
+               && field(line, "m") == std::to_string(m) && field(line, "n") == std::to_string(n)
+               && field(line, "k") == std::to_string(k))
+            {
+                goldenMs = std::strtod(field(line, "median_ms").c_str(), nullptr);
+            }
+        }
+
+        auto description = std::string(sample) + ", " + kernel + ", " + std::to_string(m) + "x"
+                           + std::to_string(n) + "x" + std::to_string(k);
+        if(goldenMs <= 0.0)
+        {
+            std::cout << "UNTRACKED: " << description << std::endl;
+            mStatus = Failed;
+            return;
+        }
+
+        auto tolerancePct  = envValue("ROCWMMA_PERF_TOLERANCE", 5.0);
+        auto throughputPct = goldenMs / stats.mMedianMs * 100.0;
+        if(throughputPct < 100.0 - tolerancePct)
+        {
+            std::cout << "PERF REGRESSION: " << description << ", median(ms) golden: " << goldenMs
+                      << ", current: " << stats.mMedianMs << " (" << std::fixed
+                      << std::setprecision(2) << throughputPct << "% of golden)"
+                      << std::defaultfloat << std::setprecision(6) << std::endl;
+            mStatus = Failed;
+        }
+#endif // ROCWMMA_PERF_GOLDEN_DIR
+    }
+
+    // Exit code of the sample: 0 when all runs passed, 1 on regressions and untracked runs,
+    // 77 when the device has no golden file
+    int status() const
+    {
+        return mStatus;
+    }
+
+private:
+    enum : int
+    {
+        Passed   = 0,
+        Failed   = 1,
+        NoGolden = 77
+    };
+
+    PerfGolden()
+        : mStatus(Passed)
+    {
+        hipDevice_t     handle;
+        hipDeviceProp_t props;
+        CHECK_HIP_ERROR(hipGetDevice(&handle));
+        CHECK_HIP_ERROR(hipGetDeviceProperties(&props, handle));
+
+        // Target features such as :xnack- are not part of the golden file name
+        mArch = std::string(props.gcnArchName);
+        mArch = mArch.substr(0, mArch.find(':'));
+    }
+
+    std::string toJson(char const*           sample,
+                       char const*           kernel,
+                       uint32_t              tblockX,
+                       uint32_t              tblockY,
+                       uint32_t              m,
+                       uint32_t              n,
+                       uint32_t              k,
+                       BenchmarkStats const& stats) const
+    {
+        // The sample harness measures p99 rather than p95, and has no roofline
+        std::stringstream ss;
+        ss << "{\"schema\": \"rocwmma-bench-1\", \"suite\": \"samples\", \"arch\": \"" << mArch
+           << "\", \"problem_type\": \"" << sample << "\", \"kernel_config\": \"" << kernel
+           << "\", \"tblock_x\": " << tblockX << ", \"tblock_y\": " << tblockY
+           << ", \"m\": " << m << ", \"n\": " << n << ", \"k\": " << k
+           << ", \"batch\": 1, \"runs\": " << stats.mRuns << ", \"mean_ms\": " << stats.mMeanMs
+           << ", \"median_ms\": " << stats.mMedianMs << ", \"p95_ms\": 0, \"stddev_ms\": "
+           << stats.mStdDevMs << ", \"gflops\": " << calculateGFlops(m, n, k)
+           << ", \"tflops_per_sec\": " << calculateTFlopsPerSec(m, n, k, stats.mMedianMs)
+           << ", \"efficiency_pct\": 0, \"roof_tflops_per_sec\": 0, \"bound\": \"\""
+           << ", \"result\": \"PASSED\"}";
+        return ss.str();
+    }
+
+    // Value of a field of a JSON lines record written by toJson() or the test suites
+    static std::string field(std::string const& line, std::string const& name)
+    {
+        auto pos = line.find("\"" + name + "\":");
+        if(pos == std::string::npos)
+        {
+            return "";
+        }
+
+        pos = line.find_first_not_of(' ', pos + name.size() + 3);
+        if(pos == std::string::npos)
+        {
+            return "";
+        }
+        if(line[pos] == '"')
+        {
+            return line.substr(pos + 1, line.find('"', pos + 1) - pos - 1);
+        }
+        return line.substr(pos, line.find_first_of(",} ", pos) - pos);
+    }
+
+    static double envValue(char const* name, double defaultValue)
+    {
+        auto value = std::getenv(name);
+        return (value == nullptr || *value == '\0') ? defaultValue : std::strtod(value, nullptr);
+    }
+
+    int         mStatus;
+    std::string mArch;
+};
+
+#endif // ROCWMMA_SAMPLES_PERF_GOLDEN_HPP
@@ -0,0 +1,524 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <iostream>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_fp16.h>
+#include <hip/hip_runtime.h>
+
+#if ROCWMMA_BENCHMARK_WITH_MIOPEN
+#include <miopen/miopen.h>
+#endif // ROCWMMA_BENCHMARK_WITH_MIOPEN
+
+#include <rocwmma/rocwmma.hpp>
+
+#include "benchmark_harness.hpp"
+#include "common.hpp"
+
+using rocwmma::accumulator;
+using rocwmma::col_major;
+using rocwmma::float16_t;
+using rocwmma::float32_t;
+using rocwmma::matrix_a;
+using rocwmma::matrix_b;
+using rocwmma::row_major;
+
+/* Motivation
+*
+* A forward 2D convolution is the GEMM D = A x B of:
+* - A (M x K): the im2col matrix, one row of R x S x C filter taps per output pixel
+* - B (K x N): the filters, K = R x S x C, N = K filters
+* - D (M x N): the output, M = N x P x Q output pixels
+*
+* Materializing the im2col matrix replicates every input pixel up to R x S times
+* in memory before the GEMM reads it back. In the implicit GEMM formulation,
+* rocwmma::load_matrix_im2col_sync gathers A fragments directly from the NHWC
+* input through their im2col addresses, zero-filling the padding:
+*
+*     A(row, col) = input[n][p * strideH + r * dilationH - padH]
+*                           [q * strideW + s * dilationW - padW][c]
+*
+*     row = (n * P + p) * Q + q,  col = (r * S + s) * C + c
+*
+* In NHWC, consecutive columns of A are consecutive channels of one input pixel,
+* so A fragments are loaded with vectors whenever C is a multiple of the vector
+* width. The KRSC filters are the col_major B with ldb = R x S x C, and the NPQK
+* output is the row_major D with ldd = K, so neither needs to be transformed.
+*
+* The benchmark runs the convolution layers of ResNet-50, and reports for each the
+* bytes of im2col matrix that were not materialized, against the input size.
+* When built with ROCWMMA_BENCHMARK_WITH_MIOPEN, the same layers are
+* also run with MIOpen on NHWC tensors for comparison.
+*
+* Note: Filter counts must be multiples of WAVE_TILE_N. Output pixel counts and filter
+* taps are unrestricted, the edges are bounded.
+*/
+
+// Supports ROCWMMA_M/N square sizes of
+// : 16 x 16
+// : 32 x 32 ( only MI )
+const int ROCWMMA_M = 16;
+const int ROCWMMA_N = 16;
+
+// Supports ROCWMMA_K sizes as
+// : multiples of 16.
+const int ROCWMMA_K = 16;
+
+// Each wave computes BLOCKS_X x BLOCKS_Y fragments of output, reusing each
+// A fragment across BLOCKS_Y and each B fragment across BLOCKS_X.
+const int BLOCKS_X    = 2;
+const int BLOCKS_Y    = 2;
+const int WAVE_TILE_M = BLOCKS_X * ROCWMMA_M;
+const int WAVE_TILE_N = BLOCKS_Y * ROCWMMA_N;
+
+// Device warp size
+const uint32_t WAVE_SIZE = getWarpSize();
+
+// Thread block
+// : T_BLOCK_X must be multiple of WAVE_SIZE.
+const int T_BLOCK_X = 4 * WAVE_SIZE;
+const int T_BLOCK_Y = 4;
+
+// Batch size of the ResNet-50 layers
+const uint32_t BATCH = 32u;
+
+using FragA = rocwmma::fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, row_major>;
+using FragB = rocwmma::fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, col_major>;
+using FragD
+    = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, row_major>;
+using FragAcc = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float32_t>;
+
+#if ROCWMMA_BENCHMARK_WITH_MIOPEN
+
+#ifndef CHECK_MIOPEN_ERROR
+#define CHECK_MIOPEN_ERROR(status)                   \
+    if(status != miopenStatusSuccess)                \
+    {                                                \
+        fprintf(stderr,                              \
+                "MIOpen error: '%s'(%d) at %s:%d\n", \
+                miopenGetErrorString(status),        \
+                status,                              \
+                __FILE__,                            \
+                __LINE__);                           \
+        exit(EXIT_FAILURE);                          \
+    }
+#endif
+
+#endif // ROCWMMA_BENCHMARK_WITH_MIOPEN
+
+// Register blocked implicit GEMM convolution. Each wave computes a
+// WAVE_TILE_M x WAVE_TILE_N tile of the output.
+//
+// : Input is in NHWC format
+// : Filters are in KRSC format    (col-major B, K x N)
+// : Output is in NPQK format      (row-major D, M x N)
+__global__ void hconv2d_d(rocwmma::conv2d_nhwc conv,
+                          float16_t const*     input,
+                          float16_t const*     filter,
+                          float16_t*           output)
+{
+    // Implicit GEMM sizes
+    auto m   = conv.n * conv.p * conv.q;
+    auto n   = conv.k;
+    auto k   = conv.r * conv.s * conv.c;
+    auto ldb = k;
+    auto ldd = n;
+
+    // Tile using a 2D grid
+    auto majorWarp = (blockIdx.x * blockDim.x + threadIdx.x) / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    auto minorWarp = (blockIdx.y * blockDim.y + threadIdx.y);
+
+    // Target tile
+    auto cRow = majorWarp * WAVE_TILE_M;
+    auto cCol = minorWarp * WAVE_TILE_N;
+
+    // Bounds check
+    if(cRow < m && cCol < n)
+    {
+        FragAcc fragsAcc[BLOCKS_X][BLOCKS_Y];
+        for(int i = 0; i < BLOCKS_X; ++i)
+        {
+            for(int j = 0; j < BLOCKS_Y; ++j)
+            {
+                rocwmma::fill_fragment(fragsAcc[i][j], 0.0f);
+            }
+        }
+
+        // fragsAcc = im2col(input) x filter
+        for(uint32_t h = 0; h < k; h += ROCWMMA_K)
+        {
+            FragA fragsA[BLOCKS_X];
+            FragB fragsB[BLOCKS_Y];
+
+            // Out of range rows and filter taps are zero-filled
+            for(int i = 0; i < BLOCKS_X; ++i)
+            {
+                rocwmma::load_matrix_im2col_sync(fragsA[i], input, conv, cRow + i * ROCWMMA_M, h);
+            }
+            for(int j = 0; j < BLOCKS_Y; ++j)
+            {
+                rocwmma::load_matrix_bounded_sync(
+                    fragsB[j], filter + (h + (cCol + j * ROCWMMA_N) * ldb), ldb, k - h, ROCWMMA_N);
+            }
+
+            for(int i = 0; i < BLOCKS_X; ++i)
+            {
+                for(int j = 0; j < BLOCKS_Y; ++j)
+                {
+                    rocwmma::mma_sync(fragsAcc[i][j], fragsA[i], fragsB[j], fragsAcc[i][j]);
+                }
+            }
+        }
+
+        for(int i = 0; i < BLOCKS_X; ++i)
+        {
+            auto row = cRow + i * ROCWMMA_M;
+            if(row >= m)
+            {
+                break;
+            }
+
+            for(int j = 0; j < BLOCKS_Y; ++j)
+            {
+                auto  col = cCol + j * ROCWMMA_N;
+                FragD fragD;
+                for(int e = 0; e < fragD.num_elements; ++e)
+                {
+                    fragD.x[e] = static_cast<float16_t>(fragsAcc[i][j].x[e]);
+                }
+                auto offset = static_cast<uint64_t>(row) * ldd + col;
+                rocwmma::store_matrix_bounded_sync(output + offset, fragD, ldd, m - row, n - col);
+            }
+        }
+    }
+}
+
+#if !NDEBUG
+
+// Direct convolution reference, accumulating in float32_t
+__host__ void conv2d_cpu_h(rocwmma::conv2d_nhwc const& conv,
+                           float16_t const*            input,
+                           float16_t const*            filter,
+                           float16_t*                  output)
+{
+    auto m = conv.n * conv.p * conv.q;
+
+#pragma omp parallel for
+    for(uint32_t row = 0; row < m; ++row)
+    {
+        auto q = row % conv.q;
+        auto p = (row / conv.q) % conv.p;
+        auto n = row / (conv.q * conv.p);
+
+        for(uint32_t f = 0; f < conv.k; ++f)
+        {
+            float32_t accum = 0.0f;
+            for(uint32_t r = 0; r < conv.r; ++r)
+            {
+                auto h = static_cast<int32_t>(p * conv.strideH + r * conv.dilationH)
+                         - static_cast<int32_t>(conv.padH);
+                if(h < 0 || h >= static_cast<int32_t>(conv.h))
+                {
+                    continue;
+                }
+
+                for(uint32_t s = 0; s < conv.s; ++s)
+                {
+                    auto w = static_cast<int32_t>(q * conv.strideW + s * conv.dilationW)
+                             - static_cast<int32_t>(conv.padW);
+                    if(w < 0 || w >= static_cast<int32_t>(conv.w))
+                    {
+                        continue;
+                    }
+
+                    auto inputPixel = input + ((uint64_t(n) * conv.h + h) * conv.w + w) * conv.c;
+                    auto filterTap = filter + ((uint64_t(f) * conv.r + r) * conv.s + s) * conv.c;
+                    for(uint32_t c = 0; c < conv.c; ++c)
+                    {
+                        accum += static_cast<float32_t>(inputPixel[c])
+                                 * static_cast<float32_t>(filterTap[c]);
+                    }
+                }
+            }
+            output[uint64_t(row) * conv.k + f] = static_cast<float16_t>(accum);
+        }
+    }
+}
+
+#endif // !NDEBUG
+
+__host__ void conv2d_test(char const* layerName, rocwmma::conv2d_nhwc const& conv)
+{
+    // Implicit GEMM sizes
+    auto m = conv.n * conv.p * conv.q;
+    auto n = conv.k;
+    auto k = conv.r * conv.s * conv.c;
+
+    if(n % WAVE_TILE_N != 0)
+    {
+        std::cout << layerName << " skipped: filter count must be a multiple of " << WAVE_TILE_N
+                  << std::endl;
+        return;
+    }
+
+    auto inputSize  = static_cast<size_t>(conv.n) * conv.h * conv.w * conv.c;
+    auto filterSize = static_cast<size_t>(n) * k;
+    auto outputSize = static_cast<size_t>(m) * n;
+
+    // Initialize input data
+    std::vector<float16_t> input(inputSize);
+    std::vector<float16_t> filter(filterSize);
+    std::vector<float16_t> output(outputSize);
+
+    fillRand(input.data(), conv.n * conv.h * conv.w, conv.c);
+    fillRand(filter.data(), n, k);
+
+    // Allocate and copy device memory
+    float16_t* d_input;
+    float16_t* d_filter;
+    float16_t* d_output;
+
+    const size_t bytesInput  = input.size() * sizeof(float16_t);
+    const size_t bytesFilter = filter.size() * sizeof(float16_t);
+    const size_t bytesOutput = output.size() * sizeof(float16_t);
+
+    CHECK_HIP_ERROR(hipMalloc(&d_input, bytesInput));
+    CHECK_HIP_ERROR(hipMalloc(&d_filter, bytesFilter));
+    CHECK_HIP_ERROR(hipMalloc(&d_output, bytesOutput));
+
+    CHECK_HIP_ERROR(hipMemcpy(d_input, input.data(), bytesInput, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_filter, filter.data(), bytesFilter, hipMemcpyHostToDevice));
+
+    auto blockDim = dim3(T_BLOCK_X, T_BLOCK_Y);
+    auto gridDim  = dim3(rocwmma::ceilDiv(m, WAVE_TILE_M * T_BLOCK_X / WAVE_SIZE),
+                        rocwmma::ceilDiv(n, WAVE_TILE_N * T_BLOCK_Y));
+
+    auto rocwmmaKernel = [&]() {
+        hipExtLaunchKernelGGL(hconv2d_d,
+                              gridDim,
+                              blockDim,
+                              0, // sharedMemBytes
+                              0, // stream
+                              nullptr, // Event start
+                              nullptr, // event stop
+                              0, // flags
+                              conv,
+                              d_input,
+                              d_filter,
+                              d_output);
+    };
+
+    // Bytes of the im2col matrix against the input it replicates
+    auto im2colBytes = static_cast<double>(m) * k * sizeof(float16_t);
+    auto im2colRatio = im2colBytes / static_cast<double>(bytesInput);
+
+    // Runs are timed individually, with warm and cold caches
+    BenchmarkHarness harness;
+
+    // Echo performance
+    auto echo = [&](const char* kernelName, auto&& kernel) {
+        auto gFlops = calculateGFlops(m, n, k);
+
+        for(auto cacheState :
+            {BenchmarkHarness::CacheState::Warm, BenchmarkHarness::CacheState::Cold})
+        {
+            auto stats        = harness.run(kernel, cacheState);
+            auto tFlopsPerSec = calculateTFlopsPerSec(m, n, k, stats.mMedianMs);
+
+            std::cout << layerName << ", " << kernelName << ", " << conv.n << ", " << conv.h
+                      << ", " << conv.w << ", " << conv.c << ", " << conv.k << ", " << conv.r
+                      << ", " << conv.s << ", " << conv.padH << ", " << conv.strideH << ", "
+                      << conv.p << ", " << conv.q << ", " << m << ", " << n << ", " << k << ", "
+                      << im2colBytes * 1.0e-6 << ", " << im2colRatio << ", "
+                      << (cacheState == BenchmarkHarness::CacheState::Warm ? "warm" : "cold")
+                      << ", " << stats.mMedianMs << ", " << gFlops << ", " << tFlopsPerSec
+                      << ", ";
+            BenchmarkHarness::printStats(std::cout, stats) << std::endl;
+        }
+    };
+
+#if !NDEBUG
+
+    // Setup and run reference computation
+    std::vector<float16_t> output_ref(outputSize, std::numeric_limits<float16_t>::signaling_NaN());
+    bool                   refComputed = false;
+
+    auto validate = [&]() {
+        std::cout << "Validating result with reference..." << std::endl;
+
+        if(!refComputed)
+        {
+            conv2d_cpu_h(conv, input.data(), filter.data(), output_ref.data());
+            refComputed = true;
+        }
+
+        // Bring kernel result back to host
+        CHECK_HIP_ERROR(hipMemcpy(output.data(), d_output, bytesOutput, hipMemcpyDeviceToHost));
+
+        auto res = compareEqual(output.data(), output_ref.data(), outputSize);
+
+        if(std::get<0>(res) == false)
+        {
+            std::cout << "FAILED\n";
+        }
+        else
+        {
+            std::cout << "PASSED\n";
+        }
+
+        std::cout << "Max relative error: " << std::get<1>(res) << std::endl;
+    };
+
+#endif // !NDEBUG
+
+    echo("rocWMMA", rocwmmaKernel);
+
+#if !NDEBUG
+    validate();
+#endif // !NDEBUG
+
+#if ROCWMMA_BENCHMARK_WITH_MIOPEN
+
+    // NHWC tensors are described in NCHW dimension order, with NHWC strides
+    miopenHandle_t                handle;
+    miopenTensorDescriptor_t      inputDesc, filterDesc, outputDesc;
+    miopenConvolutionDescriptor_t convDesc;
+
+    CHECK_MIOPEN_ERROR(miopenCreate(&handle));
+    CHECK_MIOPEN_ERROR(miopenCreateTensorDescriptor(&inputDesc));
+    CHECK_MIOPEN_ERROR(miopenCreateTensorDescriptor(&filterDesc));
+    CHECK_MIOPEN_ERROR(miopenCreateTensorDescriptor(&outputDesc));
+    CHECK_MIOPEN_ERROR(miopenCreateConvolutionDescriptor(&convDesc));
+
+    auto describeNhwc = [](miopenTensorDescriptor_t desc, int n, int c, int h, int w) {
+        int dims[]    = {n, c, h, w};
+        int strides[] = {h * w * c, 1, w * c, c};
+        CHECK_MIOPEN_ERROR(miopenSetTensorDescriptor(desc, miopenHalf, 4, dims, strides));
+    };
+
+    describeNhwc(inputDesc, conv.n, conv.c, conv.h, conv.w);
+    describeNhwc(filterDesc, conv.k, conv.c, conv.r, conv.s);
+    describeNhwc(outputDesc, conv.n, conv.k, conv.p, conv.q);
+    CHECK_MIOPEN_ERROR(miopenInitConvolutionDescriptor(convDesc,
+                                                       miopenConvolution,
+                                                       conv.padH,
+                                                       conv.padW,
+                                                       conv.strideH,
+                                                       conv.strideW,
+                                                       conv.dilationH,
+                                                       conv.dilationW));
+
+    size_t workspaceBytes = 0u;
+    void*  d_workspace    = nullptr;
+    CHECK_MIOPEN_ERROR(miopenConvolutionForwardGetWorkSpaceSize(
+        handle, filterDesc, inputDesc, convDesc, outputDesc, &workspaceBytes));
+    if(workspaceBytes > 0u)
+    {
+        CHECK_HIP_ERROR(hipMalloc(&d_workspace, workspaceBytes));
+    }
+
+    int                  algoCount = 0;
+    miopenConvAlgoPerf_t perf;
+    CHECK_MIOPEN_ERROR(miopenFindConvolutionForwardAlgorithm(handle,
+                                                             inputDesc,
+                                                             d_input,
+                                                             filterDesc,
+                                                             d_filter,
+                                                             convDesc,
+                                                             outputDesc,
+                                                             d_output,
+                                                             1,
+                                                             &algoCount,
+                                                             &perf,
+                                                             d_workspace,
+                                                             workspaceBytes,
+                                                             false));
+
+    auto miopenKernel = [&]() {
+        float32_t alpha = 1.0f;
+        float32_t beta  = 0.0f;
+        CHECK_MIOPEN_ERROR(miopenConvolutionForward(handle,
+                                                    &alpha,
+                                                    inputDesc,
+                                                    d_input,
+                                                    filterDesc,
+                                                    d_filter,
+                                                    convDesc,
+                                                    perf.fwd_algo,
+                                                    &beta,
+                                                    outputDesc,
+                                                    d_output,
+                                                    d_workspace,
+                                                    workspaceBytes));
+    };
+
+    echo("MIOpen", miopenKernel);
+
+    if(d_workspace != nullptr)
+    {
+        CHECK_HIP_ERROR(hipFree(d_workspace));
+    }
+    CHECK_MIOPEN_ERROR(miopenDestroyConvolutionDescriptor(convDesc));
+    CHECK_MIOPEN_ERROR(miopenDestroyTensorDescriptor(outputDesc));
+    CHECK_MIOPEN_ERROR(miopenDestroyTensorDescriptor(filterDesc));
+    CHECK_MIOPEN_ERROR(miopenDestroyTensorDescriptor(inputDesc));
+    CHECK_MIOPEN_ERROR(miopenDestroy(handle));
+
+#endif // ROCWMMA_BENCHMARK_WITH_MIOPEN
+
+    // Release device memory
+    CHECK_HIP_ERROR(hipFree(d_input));
+    CHECK_HIP_ERROR(hipFree(d_filter));
+    CHECK_HIP_ERROR(hipFree(d_output));
+}
+
+int main()
+{
+    std::cout << "Layer, Kernel, N, H, W, C, K, R, S, Pad, Stride, P, Q, "
+              << "MatM, MatN, MatK, im2col(MB), im2col/Input, "
+              << "Cache, elapsedMs, Problem Size(GFlops), TFlops/s, "
+              << BenchmarkHarness::statsHeader() << std::endl;
+
+    // Distinct convolution layers of ResNet-50
+    // : make_conv2d_nhwc(n, h, w, c, k, r, s, padH, padW, strideH, strideW)
+    conv2d_test("conv1", rocwmma::make_conv2d_nhwc(BATCH, 224, 224, 3, 64, 7, 7, 3, 3, 2, 2));
+    conv2d_test("conv2_1x1a", rocwmma::make_conv2d_nhwc(BATCH, 56, 56, 64, 64, 1, 1));
+    conv2d_test("conv2_3x3", rocwmma::make_conv2d_nhwc(BATCH, 56, 56, 64, 64, 3, 3, 1, 1));
+    conv2d_test("conv2_1x1b", rocwmma::make_conv2d_nhwc(BATCH, 56, 56, 64, 256, 1, 1));
+    conv2d_test("conv3_1x1a", rocwmma::make_conv2d_nhwc(BATCH, 28, 28, 512, 128, 1, 1));
+    conv2d_test("conv3_3x3", rocwmma::make_conv2d_nhwc(BATCH, 28, 28, 128, 128, 3, 3, 1, 1));
+    conv2d_test("conv3_down",
+                rocwmma::make_conv2d_nhwc(BATCH, 56, 56, 256, 512, 1, 1, 0, 0, 2, 2));
+    conv2d_test("conv4_1x1a", rocwmma::make_conv2d_nhwc(BATCH, 14, 14, 1024, 256, 1, 1));
+    conv2d_test("conv4_3x3", rocwmma::make_conv2d_nhwc(BATCH, 14, 14, 256, 256, 3, 3, 1, 1));
+    conv2d_test("conv5_1x1a", rocwmma::make_conv2d_nhwc(BATCH, 7, 7, 2048, 512, 1, 1));
+    conv2d_test("conv5_3x3", rocwmma::make_conv2d_nhwc(BATCH, 7, 7, 512, 512, 3, 3, 1, 1));
+
+    std::cout << "Finished!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,878 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <algorithm>
+#include <iostream>
+#include <tuple>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_fp16.h>
+#include <hip/hip_runtime.h>
+
+#if ROCWMMA_BENCHMARK_WITH_MIOPEN
+#include <miopen/miopen.h>
+#endif // ROCWMMA_BENCHMARK_WITH_MIOPEN
+
+#include <rocwmma/rocwmma.hpp>
+
+#include "benchmark_harness.hpp"
+#include "common.hpp"
+
+using rocwmma::accumulator;
+using rocwmma::col_major;
+using rocwmma::float16_t;
+using rocwmma::float32_t;
+using rocwmma::matrix_a;
+using rocwmma::matrix_b;
+using rocwmma::row_major;
+
+/* Motivation
+*
+* Training a convolution layer needs two more implicit GEMMs besides the forward
+* pass of perf_hconv2d, given the NPQK output gradient dY:
+*
+* dgrad, the NHWC input gradient, is the transposed convolution:
+* - A (M x K): dY gathered per input pixel and filter tap, M = N x H x W, K = R x S x K
+* - B (K x N): the filters reordered to RSKC, row_major with ldb = C, N = C
+* - D (M x N): dX, row_major with ldd = C
+*
+*     A(row, col) = dY[n][(h + padH - r * dilationH) / strideH]
+*                        [(w + padW - s * dilationW) / strideW][k]
+*
+* where both divisions are exact, and 0 otherwise. rocwmma::load_matrix_im2col_sync
+* with a rocwmma::conv2d_nhwc_dgrad gathers A without materializing either the
+* zero-inserted dY of a strided layer or its im2col matrix. The filters are reordered
+* once per step, as they are a small fraction of the traffic.
+*
+* wgrad, the KRSC filter gradient, reduces over every output pixel of the batch:
+* - A (M x K): dY transposed, col_major with lda = K, M = K filters
+* - B (K x N): the im2col matrix of the input, K = N x P x Q, N = R x S x C
+* - D (M x N): dW, row_major with ldd = R x S x C
+*
+* Here the im2col matrix is the B operand, gathered by the row_major matrix_b overload
+* of rocwmma::load_matrix_im2col_sync through the same Im2colLoad policy. M and N are
+* small against K, so only a few tiles would run: the K range is split so that the
+* grid fills the device, each split writing a float32_t partial dW. The partials are
+* then summed in a fixed order, such that the result is deterministic.
+*
+* The benchmark runs the convolution layers of ResNet-50. When built with
+* ROCWMMA_BENCHMARK_WITH_MIOPEN, the same passes are also run with MIOpen on NHWC
+* tensors for comparison.
+*
+* Note: dgrad needs input channel counts that are multiples of WAVE_TILE_N, which
+* excludes the first layer, whose input gradient is not needed in training. wgrad
+* sizes are unrestricted, the edges are bounded.
+*/
+
+// Supports ROCWMMA_M/N square sizes of
+// : 16 x 16
+// : 32 x 32 ( only MI )
+const int ROCWMMA_M = 16;
+const int ROCWMMA_N = 16;
+
+// Supports ROCWMMA_K sizes as
+// : multiples of 16.
+const int ROCWMMA_K = 16;
+
+// Each wave computes BLOCKS_X x BLOCKS_Y fragments of output, reusing each
+// A fragment across BLOCKS_Y and each B fragment across BLOCKS_X.
+const int BLOCKS_X    = 2;
+const int BLOCKS_Y    = 2;
+const int WAVE_TILE_M = BLOCKS_X * ROCWMMA_M;
+const int WAVE_TILE_N = BLOCKS_Y * ROCWMMA_N;
+
+// Device warp size
+const uint32_t WAVE_SIZE = getWarpSize();
+
+// Thread block
+// : T_BLOCK_X must be multiple of WAVE_SIZE.
+const int T_BLOCK_X = 4 * WAVE_SIZE;
+const int T_BLOCK_Y = 4;
+
+// Threads per block of the element-wise kernels
+const int ELEMENT_BLOCK = 256;
+
+// Batch size of the ResNet-50 layers
+const uint32_t BATCH = 32u;
+
+using FragA  = rocwmma::fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, row_major>;
+using FragAT = rocwmma::fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, col_major>;
+using FragB  = rocwmma::fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, row_major>;
+using FragD
+    = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, row_major>;
+using FragAcc = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float32_t>;
+
+#if ROCWMMA_BENCHMARK_WITH_MIOPEN
+
+#ifndef CHECK_MIOPEN_ERROR
+#define CHECK_MIOPEN_ERROR(status)                   \
+    if(status != miopenStatusSuccess)                \
+    {                                                \
+        fprintf(stderr,                              \
+                "MIOpen error: '%s'(%d) at %s:%d\n", \
+                miopenGetErrorString(status),        \
+                status,                              \
+                __FILE__,                            \
+                __LINE__);                           \
+        exit(EXIT_FAILURE);                          \
+    }
+#endif
+
+#endif // ROCWMMA_BENCHMARK_WITH_MIOPEN
+
+// Reorders the KRSC filters to RSKC, the row_major B of dgrad
+__global__ void reorder_filter_d(rocwmma::conv2d_nhwc conv,
+                                 float16_t const*     filter,
+                                 float16_t*           filterRskc)
+{
+    auto idx  = static_cast<uint64_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+    auto size = static_cast<uint64_t>(conv.k) * conv.r * conv.s * conv.c;
+    if(idx < size)
+    {
+        auto c  = idx % conv.c;
+        auto k  = (idx / conv.c) % conv.k;
+        auto rs = idx / (static_cast<uint64_t>(conv.c) * conv.k);
+
+        filterRskc[idx] = filter[(k * conv.r * conv.s + rs) * conv.c + c];
+    }
+}
+
+// Register blocked implicit GEMM of the input gradient. Each wave computes a
+// WAVE_TILE_M x WAVE_TILE_N tile of dX.
+//
+// : Output gradient is in NPQK format   (gathered row-major A, M x K)
+// : Filters are in RSKC format          (row-major B, K x N)
+// : Input gradient is in NHWC format    (row-major D, M x N)
+__global__ void hconv2d_dgrad_d(rocwmma::conv2d_nhwc_dgrad dgrad,
+                                float16_t const*           gradOutput,
+                                float16_t const*           filterRskc,
+                                float16_t*                 gradInput)
+{
+    auto const& conv = dgrad.conv;
+
+    // Implicit GEMM sizes
+    auto m   = conv.n * conv.h * conv.w;
+    auto n   = conv.c;
+    auto k   = conv.r * conv.s * conv.k;
+    auto ldb = n;
+    auto ldd = n;
+
+    // Tile using a 2D grid
+    auto majorWarp = (blockIdx.x * blockDim.x + threadIdx.x) / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    auto minorWarp = (blockIdx.y * blockDim.y + threadIdx.y);
+
+    // Target tile
+    auto cRow = majorWarp * WAVE_TILE_M;
+    auto cCol = minorWarp * WAVE_TILE_N;
+
+    // Bounds check
+    if(cRow < m && cCol < n)
+    {
+        FragAcc fragsAcc[BLOCKS_X][BLOCKS_Y];
+        for(int i = 0; i < BLOCKS_X; ++i)
+        {
+            for(int j = 0; j < BLOCKS_Y; ++j)
+            {
+                rocwmma::fill_fragment(fragsAcc[i][j], 0.0f);
+            }
+        }
+
+        // fragsAcc = gather(gradOutput) x filterRskc
+        for(uint32_t h = 0; h < k; h += ROCWMMA_K)
+        {
+            FragA fragsA[BLOCKS_X];
+            FragB fragsB[BLOCKS_Y];
+
+            // Out of range rows, filter taps and non-contributing pixels are zero-filled
+            for(int i = 0; i < BLOCKS_X; ++i)
+            {
+                rocwmma::load_matrix_im2col_sync(
+                    fragsA[i], gradOutput, dgrad, cRow + i * ROCWMMA_M, h);
+            }
+            for(int j = 0; j < BLOCKS_Y; ++j)
+            {
+                auto offset = static_cast<uint64_t>(h) * ldb + cCol + j * ROCWMMA_N;
+                rocwmma::load_matrix_bounded_sync(
+                    fragsB[j], filterRskc + offset, ldb, k - h, ROCWMMA_N);
+            }
+
+            for(int i = 0; i < BLOCKS_X; ++i)
+            {
+                for(int j = 0; j < BLOCKS_Y; ++j)
+                {
+                    rocwmma::mma_sync(fragsAcc[i][j], fragsA[i], fragsB[j], fragsAcc[i][j]);
+                }
+            }
+        }
+
+        for(int i = 0; i < BLOCKS_X; ++i)
+        {
+            auto row = cRow + i * ROCWMMA_M;
+            if(row >= m)
+            {
+                break;
+            }
+
+            for(int j = 0; j < BLOCKS_Y; ++j)
+            {
+                auto  col = cCol + j * ROCWMMA_N;
+                FragD fragD;
+                for(int e = 0; e < fragD.num_elements; ++e)
+                {
+                    fragD.x[e] = static_cast<float16_t>(fragsAcc[i][j].x[e]);
+                }
+                auto offset = static_cast<uint64_t>(row) * ldd + col;
+                rocwmma::store_matrix_bounded_sync(
+                    gradInput + offset, fragD, ldd, m - row, n - col);
+            }
+        }
+    }
+}
+
+// Register blocked, split-K implicit GEMM of the filter gradient. Each wave
+// computes a WAVE_TILE_M x WAVE_TILE_N tile of the partial dW of split blockIdx.z,
+// reducing over kPerSplit output pixels.
+//
+// : Output gradient is in NPQK format   (col-major A, M x K)
+// : Input is in NHWC format             (gathered row-major B, K x N)
+// : Partials are [splits][K][RSC]       (row-major D, M x N)
+__global__ void hconv2d_wgrad_d(rocwmma::conv2d_nhwc conv,
+                                float16_t const*     gradOutput,
+                                float16_t const*     input,
+                                float32_t*           partials,
+                                uint32_t             kPerSplit)
+{
+    // Implicit GEMM sizes
+    auto m   = conv.k;
+    auto n   = conv.r * conv.s * conv.c;
+    auto k   = conv.n * conv.p * conv.q;
+    auto lda = m;
+    auto ldd = n;
+
+    // Tile using a 2D grid
+    auto majorWarp = (blockIdx.x * blockDim.x + threadIdx.x) / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    auto minorWarp = (blockIdx.y * blockDim.y + threadIdx.y);
+
+    // Target tile and K range of the split
+    auto cRow   = majorWarp * WAVE_TILE_M;
+    auto cCol   = minorWarp * WAVE_TILE_N;
+    auto kBegin = blockIdx.z * kPerSplit;
+    auto kEnd   = std::min(kBegin + kPerSplit, k);
+
+    // Bounds check
+    if(cRow < m && cCol < n)
+    {
+        FragAcc fragsAcc[BLOCKS_X][BLOCKS_Y];
+        for(int i = 0; i < BLOCKS_X; ++i)
+        {
+            for(int j = 0; j < BLOCKS_Y; ++j)
+            {
+                rocwmma::fill_fragment(fragsAcc[i][j], 0.0f);
+            }
+        }
+
+        // fragsAcc = gradOutput^T x im2col(input), over the split
+        for(uint32_t h = kBegin; h < kEnd; h += ROCWMMA_K)
+        {
+            FragAT fragsA[BLOCKS_X];
+            FragB  fragsB[BLOCKS_Y];
+
+            // Split ranges are multiples of ROCWMMA_K: only the last one is ragged
+            for(int i = 0; i < BLOCKS_X; ++i)
+            {
+                auto row    = cRow + i * ROCWMMA_M;
+                auto offset = static_cast<uint64_t>(h) * lda + row;
+                rocwmma::load_matrix_bounded_sync(
+                    fragsA[i], gradOutput + offset, lda, m - std::min(row, m), kEnd - h);
+            }
+            for(int j = 0; j < BLOCKS_Y; ++j)
+            {
+                rocwmma::load_matrix_im2col_sync(fragsB[j], input, conv, h, cCol + j * ROCWMMA_N);
+            }
+
+            for(int i = 0; i < BLOCKS_X; ++i)
+            {
+                for(int j = 0; j < BLOCKS_Y; ++j)
+                {
+                    rocwmma::mma_sync(fragsAcc[i][j], fragsA[i], fragsB[j], fragsAcc[i][j]);
+                }
+            }
+        }
+
+        auto partial = partials + static_cast<uint64_t>(blockIdx.z) * m * n;
+        for(int i = 0; i < BLOCKS_X; ++i)
+        {
+            auto row = cRow + i * ROCWMMA_M;
+            if(row >= m)
+            {
+                break;
+            }
+
+            for(int j = 0; j < BLOCKS_Y; ++j)
+            {
+                auto col    = cCol + j * ROCWMMA_N;
+                auto offset = static_cast<uint64_t>(row) * ldd + col;
+                rocwmma::store_matrix_bounded_sync(partial + offset,
+                                                   fragsAcc[i][j],
+                                                   ldd,
+                                                   m - row,
+                                                   n - col,
+                                                   rocwmma::mem_row_major);
+            }
+        }
+    }
+}
+
+// Sums the split partials of each dW element in split order, such that the
+// filter gradient does not depend on scheduling.
+__global__ void reduce_splits_d(float32_t const* partials,
+                                uint32_t         splits,
+                                uint64_t         size,
+                                float16_t*       gradFilter)
+{
+    auto idx = static_cast<uint64_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+    if(idx < size)
+    {
+        float32_t accum = 0.0f;
+        for(uint32_t z = 0; z < splits; ++z)
+        {
+            accum += partials[z * size + idx];
+        }
+        gradFilter[idx] = static_cast<float16_t>(accum);
+    }
+}
+
+#if !NDEBUG
+
+// Direct input gradient reference, accumulating in float32_t
+__host__ void conv2d_dgrad_cpu_h(rocwmma::conv2d_nhwc const& conv,
+                                 float16_t const*            gradOutput,
+                                 float16_t const*            filter,
+                                 float16_t*                  gradInput)
+{
+    auto m = conv.n * conv.h * conv.w;
+
+#pragma omp parallel for
+    for(uint32_t row = 0; row < m; ++row)
+    {
+        auto w = row % conv.w;
+        auto h = (row / conv.w) % conv.h;
+        auto n = row / (conv.w * conv.h);
+
+        std::vector<float32_t> accum(conv.c, 0.0f);
+        for(uint32_t r = 0; r < conv.r; ++r)
+        {
+            auto ph = static_cast<int32_t>(h + conv.padH)
+                      - static_cast<int32_t>(r * conv.dilationH);
+            if(ph < 0 || ph % conv.strideH != 0 || ph / conv.strideH >= conv.p)
+            {
+                continue;
+            }
+
+            for(uint32_t s = 0; s < conv.s; ++s)
+            {
+                auto qw = static_cast<int32_t>(w + conv.padW)
+                          - static_cast<int32_t>(s * conv.dilationW);
+                if(qw < 0 || qw % conv.strideW != 0 || qw / conv.strideW >= conv.q)
+                {
+                    continue;
+                }
+
+                auto p = ph / conv.strideH;
+                auto q = qw / conv.strideW;
+                auto gradPixel = gradOutput + ((uint64_t(n) * conv.p + p) * conv.q + q) * conv.k;
+                for(uint32_t f = 0; f < conv.k; ++f)
+                {
+                    auto grad      = static_cast<float32_t>(gradPixel[f]);
+                    auto filterTap = filter + ((uint64_t(f) * conv.r + r) * conv.s + s) * conv.c;
+                    for(uint32_t c = 0; c < conv.c; ++c)
+                    {
+                        accum[c] += grad * static_cast<float32_t>(filterTap[c]);
+                    }
+                }
+            }
+        }
+
+        for(uint32_t c = 0; c < conv.c; ++c)
+        {
+            gradInput[uint64_t(row) * conv.c + c] = static_cast<float16_t>(accum[c]);
+        }
+    }
+}
+
+// Direct filter gradient reference, accumulating in float32_t
+__host__ void conv2d_wgrad_cpu_h(rocwmma::conv2d_nhwc const& conv,
+                                 float16_t const*            gradOutput,
+                                 float16_t const*            input,
+                                 float16_t*                  gradFilter)
+{
+    auto pixels = conv.n * conv.p * conv.q;
+    auto taps   = conv.r * conv.s * conv.c;
+
+#pragma omp parallel for
+    for(uint32_t f = 0; f < conv.k; ++f)
+    {
+        std::vector<float32_t> accum(taps, 0.0f);
+        for(uint32_t row = 0; row < pixels; ++row)
+        {
+            auto q = row % conv.q;
+            auto p = (row / conv.q) % conv.p;
+            auto n = row / (conv.q * conv.p);
+
+            auto grad = static_cast<float32_t>(gradOutput[uint64_t(row) * conv.k + f]);
+            for(uint32_t r = 0; r < conv.r; ++r)
+            {
+                auto h = static_cast<int32_t>(p * conv.strideH + r * conv.dilationH)
+                         - static_cast<int32_t>(conv.padH);
+                if(h < 0 || h >= static_cast<int32_t>(conv.h))
+                {
+                    continue;
+                }
+
+                for(uint32_t s = 0; s < conv.s; ++s)
+                {
+                    auto w = static_cast<int32_t>(q * conv.strideW + s * conv.dilationW)
+                             - static_cast<int32_t>(conv.padW);
+                    if(w < 0 || w >= static_cast<int32_t>(conv.w))
+                    {
+                        continue;
+                    }
+
+                    auto inputPixel = input + ((uint64_t(n) * conv.h + h) * conv.w + w) * conv.c;
+                    auto tap        = (r * conv.s + s) * conv.c;
+                    for(uint32_t c = 0; c < conv.c; ++c)
+                    {
+                        accum[tap + c] += grad * static_cast<float32_t>(inputPixel[c]);
+                    }
+                }
+            }
+        }
+
+        for(uint32_t t = 0; t < taps; ++t)
+        {
+            gradFilter[uint64_t(f) * taps + t] = static_cast<float16_t>(accum[t]);
+        }
+    }
+}
+
+#endif // !NDEBUG
+
+__host__ void conv2d_bwd_test(char const* layerName, rocwmma::conv2d_nhwc const& conv)
+{
+    // Implicit GEMM sizes of dgrad (D) and wgrad (W)
+    auto mD = conv.n * conv.h * conv.w;
+    auto nD = conv.c;
+    auto kD = conv.r * conv.s * conv.k;
+    auto mW = conv.k;
+    auto nW = conv.r * conv.s * conv.c;
+    auto kW = conv.n * conv.p * conv.q;
+
+    bool runDgrad = nD % WAVE_TILE_N == 0;
+
+    auto inputSize      = static_cast<size_t>(mD) * nD;
+    auto filterSize     = static_cast<size_t>(mW) * nW;
+    auto gradOutputSize = static_cast<size_t>(kW) * mW;
+
+    // Initialize input data
+    std::vector<float16_t> input(inputSize);
+    std::vector<float16_t> filter(filterSize);
+    std::vector<float16_t> gradOutput(gradOutputSize);
+    std::vector<float16_t> gradInput(inputSize);
+    std::vector<float16_t> gradFilter(filterSize);
+
+    fillRand(input.data(), mD, nD);
+    fillRand(filter.data(), mW, nW);
+    fillRand(gradOutput.data(), kW, mW);
+
+    // wgrad splits K so that the grid fills the device, evenly by ROCWMMA_K steps
+    auto wgradBlockDim = dim3(T_BLOCK_X, T_BLOCK_Y);
+    auto wgradGridDim  = dim3(rocwmma::ceilDiv(mW, WAVE_TILE_M * T_BLOCK_X / WAVE_SIZE),
+                             rocwmma::ceilDiv(nW, WAVE_TILE_N * T_BLOCK_Y));
+
+    auto occupancy = rocwmma::get_launch_occupancy(hconv2d_wgrad_d, T_BLOCK_X * T_BLOCK_Y);
+    uint32_t tiles  = wgradGridDim.x * wgradGridDim.y;
+    uint32_t kIters = rocwmma::ceilDiv(kW, ROCWMMA_K);
+    uint32_t splits = std::max(rocwmma::ceilDiv(occupancy.resident_blocks(), tiles), 1u);
+    splits          = std::min(splits, kIters);
+
+    uint32_t kPerSplit = rocwmma::ceilDiv(kIters, splits) * ROCWMMA_K;
+    splits             = rocwmma::ceilDiv(kW, kPerSplit);
+    wgradGridDim.z     = splits;
+
+    // Allocate and copy device memory
+    float16_t* d_input;
+    float16_t* d_filter;
+    float16_t* d_filterRskc;
+    float16_t* d_gradOutput;
+    float16_t* d_gradInput;
+    float16_t* d_gradFilter;
+    float32_t* d_partials;
+
+    const size_t bytesInput      = inputSize * sizeof(float16_t);
+    const size_t bytesFilter     = filterSize * sizeof(float16_t);
+    const size_t bytesGradOutput = gradOutputSize * sizeof(float16_t);
+    const size_t bytesPartials   = static_cast<size_t>(splits) * filterSize * sizeof(float32_t);
+
+    CHECK_HIP_ERROR(hipMalloc(&d_input, bytesInput));
+    CHECK_HIP_ERROR(hipMalloc(&d_filter, bytesFilter));
+    CHECK_HIP_ERROR(hipMalloc(&d_filterRskc, bytesFilter));
+    CHECK_HIP_ERROR(hipMalloc(&d_gradOutput, bytesGradOutput));
+    CHECK_HIP_ERROR(hipMalloc(&d_gradInput, bytesInput));
+    CHECK_HIP_ERROR(hipMalloc(&d_gradFilter, bytesFilter));
+    CHECK_HIP_ERROR(hipMalloc(&d_partials, bytesPartials));
+
+    CHECK_HIP_ERROR(hipMemcpy(d_input, input.data(), bytesInput, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_filter, filter.data(), bytesFilter, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(
+        hipMemcpy(d_gradOutput, gradOutput.data(), bytesGradOutput, hipMemcpyHostToDevice));
+
+    auto dgradBlockDim = dim3(T_BLOCK_X, T_BLOCK_Y);
+    auto dgradGridDim  = dim3(rocwmma::ceilDiv(mD, WAVE_TILE_M * T_BLOCK_X / WAVE_SIZE),
+                             rocwmma::ceilDiv(nD, WAVE_TILE_N * T_BLOCK_Y));
+    auto elementGridDim
+        = dim3(rocwmma::ceilDiv(static_cast<uint32_t>(filterSize), ELEMENT_BLOCK));
+
+    // Filters change every step: the reorder is timed with dgrad
+    auto dgradKernel = [&]() {
+        hipExtLaunchKernelGGL(reorder_filter_d,
+                              elementGridDim,
+                              dim3(ELEMENT_BLOCK),
+                              0, // sharedMemBytes
+                              0, // stream
+                              nullptr, // Event start
+                              nullptr, // event stop
+                              0, // flags
+                              conv,
+                              d_filter,
+                              d_filterRskc);
+        hipExtLaunchKernelGGL(hconv2d_dgrad_d,
+                              dgradGridDim,
+                              dgradBlockDim,
+                              0, // sharedMemBytes
+                              0, // stream
+                              nullptr, // Event start
+                              nullptr, // event stop
+                              0, // flags
+                              rocwmma::conv2d_nhwc_dgrad{conv},
+                              d_gradOutput,
+                              d_filterRskc,
+                              d_gradInput);
+    };
+
+    auto wgradKernel = [&]() {
+        hipExtLaunchKernelGGL(hconv2d_wgrad_d,
+                              wgradGridDim,
+                              wgradBlockDim,
+                              0, // sharedMemBytes
+                              0, // stream
+                              nullptr, // Event start
+                              nullptr, // event stop
+                              0, // flags
+                              conv,
+                              d_gradOutput,
+                              d_input,
+                              d_partials,
+                              kPerSplit);
+        hipExtLaunchKernelGGL(reduce_splits_d,
+                              elementGridDim,
+                              dim3(ELEMENT_BLOCK),
+                              0, // sharedMemBytes
+                              0, // stream
+                              nullptr, // Event start
+                              nullptr, // event stop
+                              0, // flags
+                              d_partials,
+                              splits,
+                              static_cast<uint64_t>(filterSize),
+                              d_gradFilter);
+    };
+
+    // Runs are timed individually, with warm and cold caches
+    BenchmarkHarness harness;
+
+    // Echo performance
+    auto echo = [&](const char* pass,
+                    const char* kernelName,
+                    uint32_t    m,
+                    uint32_t    n,
+                    uint32_t    k,
+                    uint32_t    splitCount,
+                    auto&&      kernel) {
+        auto gFlops = calculateGFlops(m, n, k);
+
+        for(auto cacheState :
+            {BenchmarkHarness::CacheState::Warm, BenchmarkHarness::CacheState::Cold})
+        {
+            auto stats        = harness.run(kernel, cacheState);
+            auto tFlopsPerSec = calculateTFlopsPerSec(m, n, k, stats.mMedianMs);
+
+            std::cout << layerName << ", " << pass << ", " << kernelName << ", " << conv.n << ", "
+                      << conv.h << ", " << conv.w << ", " << conv.c << ", " << conv.k << ", "
+                      << conv.r << ", " << conv.s << ", " << conv.padH << ", " << conv.strideH
+                      << ", " << conv.p << ", " << conv.q << ", " << m << ", " << n << ", " << k
+                      << ", " << splitCount << ", "
+                      << (cacheState == BenchmarkHarness::CacheState::Warm ? "warm" : "cold")
+                      << ", " << stats.mMedianMs << ", " << gFlops << ", " << tFlopsPerSec
+                      << ", ";
+            BenchmarkHarness::printStats(std::cout, stats) << std::endl;
+        }
+    };
+
+#if !NDEBUG
+
+    // Reference results are computed once per layer
+    std::vector<float16_t> gradInput_ref;
+    std::vector<float16_t> gradFilter_ref;
+
+    auto validate = [&](bool dgradPass) {
+        std::cout << "Validating result with reference..." << std::endl;
+
+        std::tuple<bool, double> res;
+        if(dgradPass)
+        {
+            if(gradInput_ref.empty())
+            {
+                gradInput_ref.resize(inputSize);
+                conv2d_dgrad_cpu_h(conv, gradOutput.data(), filter.data(), gradInput_ref.data());
+            }
+
+            // Bring kernel result back to host
+            CHECK_HIP_ERROR(
+                hipMemcpy(gradInput.data(), d_gradInput, bytesInput, hipMemcpyDeviceToHost));
+            res = compareEqual(gradInput.data(), gradInput_ref.data(), inputSize);
+        }
+        else
+        {
+            if(gradFilter_ref.empty())
+            {
+                gradFilter_ref.resize(filterSize);
+                conv2d_wgrad_cpu_h(conv, gradOutput.data(), input.data(), gradFilter_ref.data());
+            }
+
+            // Bring kernel result back to host
+            CHECK_HIP_ERROR(
+                hipMemcpy(gradFilter.data(), d_gradFilter, bytesFilter, hipMemcpyDeviceToHost));
+            res = compareEqual(gradFilter.data(), gradFilter_ref.data(), filterSize);
+        }
+
+        if(std::get<0>(res) == false)
+        {
+            std::cout << "FAILED\n";
+        }
+        else
+        {
+            std::cout << "PASSED\n";
+        }
+
+        std::cout << "Max relative error: " << std::get<1>(res) << std::endl;
+    };
+
+#endif // !NDEBUG
+
+    if(runDgrad)
+    {
+        echo("dgrad", "rocWMMA", mD, nD, kD, 1u, dgradKernel);
+#if !NDEBUG
+        validate(true);
+#endif // !NDEBUG
+    }
+    else
+    {
+        std::cout << layerName << " dgrad skipped: input channel count must be a multiple of "
+                  << WAVE_TILE_N << std::endl;
+    }
+
+    echo("wgrad", "rocWMMA", mW, nW, kW, splits, wgradKernel);
+#if !NDEBUG
+    validate(false);
+#endif // !NDEBUG
+
+#if ROCWMMA_BENCHMARK_WITH_MIOPEN
+
+    // NHWC tensors are described in NCHW dimension order, with NHWC strides
+    miopenHandle_t                handle;
+    miopenTensorDescriptor_t      inputDesc, filterDesc, outputDesc;
+    miopenConvolutionDescriptor_t convDesc;
+
+    CHECK_MIOPEN_ERROR(miopenCreate(&handle));
+    CHECK_MIOPEN_ERROR(miopenCreateTensorDescriptor(&inputDesc));
+    CHECK_MIOPEN_ERROR(miopenCreateTensorDescriptor(&filterDesc));
+    CHECK_MIOPEN_ERROR(miopenCreateTensorDescriptor(&outputDesc));
+    CHECK_MIOPEN_ERROR(miopenCreateConvolutionDescriptor(&convDesc));
+
+    auto describeNhwc = [](miopenTensorDescriptor_t desc, int n, int c, int h, int w) {
+        int dims[]    = {n, c, h, w};
+        int strides[] = {h * w * c, 1, w * c, c};
+        CHECK_MIOPEN_ERROR(miopenSetTensorDescriptor(desc, miopenHalf, 4, dims, strides));
+    };
+
+    describeNhwc(inputDesc, conv.n, conv.c, conv.h, conv.w);
+    describeNhwc(filterDesc, conv.k, conv.c, conv.r, conv.s);
+    describeNhwc(outputDesc, conv.n, conv.k, conv.p, conv.q);
+    CHECK_MIOPEN_ERROR(miopenInitConvolutionDescriptor(convDesc,
+                                                       miopenConvolution,
+                                                       conv.padH,
+                                                       conv.padW,
+                                                       conv.strideH,
+                                                       conv.strideW,
+                                                       conv.dilationH,
+                                                       conv.dilationW));
+
+    size_t dgradWorkspaceBytes = 0u;
+    size_t wgradWorkspaceBytes = 0u;
+    CHECK_MIOPEN_ERROR(miopenConvolutionBackwardDataGetWorkSpaceSize(
+        handle, outputDesc, filterDesc, convDesc, inputDesc, &dgradWorkspaceBytes));
+    CHECK_MIOPEN_ERROR(miopenConvolutionBackwardWeightsGetWorkSpaceSize(
+        handle, outputDesc, inputDesc, convDesc, filterDesc, &wgradWorkspaceBytes));
+
+    size_t workspaceBytes = std::max(dgradWorkspaceBytes, wgradWorkspaceBytes);
+    void*  d_workspace    = nullptr;
+    if(workspaceBytes > 0u)
+    {
+        CHECK_HIP_ERROR(hipMalloc(&d_workspace, workspaceBytes));
+    }
+
+    int                  algoCount = 0;
+    miopenConvAlgoPerf_t dgradPerf;
+    miopenConvAlgoPerf_t wgradPerf;
+    CHECK_MIOPEN_ERROR(miopenFindConvolutionBackwardDataAlgorithm(handle,
+                                                                  outputDesc,
+                                                                  d_gradOutput,
+                                                                  filterDesc,
+                                                                  d_filter,
+                                                                  convDesc,
+                                                                  inputDesc,
+                                                                  d_gradInput,
+                                                                  1,
+                                                                  &algoCount,
+                                                                  &dgradPerf,
+                                                                  d_workspace,
+                                                                  dgradWorkspaceBytes,
+                                                                  false));
+    CHECK_MIOPEN_ERROR(miopenFindConvolutionBackwardWeightsAlgorithm(handle,
+                                                                     outputDesc,
+                                                                     d_gradOutput,
+                                                                     inputDesc,
+                                                                     d_input,
+                                                                     convDesc,
+                                                                     filterDesc,
+                                                                     d_gradFilter,
+                                                                     1,
+                                                                     &algoCount,
+                                                                     &wgradPerf,
+                                                                     d_workspace,
+                                                                     wgradWorkspaceBytes,
+                                                                     false));
+
+    auto miopenDgrad = [&]() {
+        float32_t alpha = 1.0f;
+        float32_t beta  = 0.0f;
+        CHECK_MIOPEN_ERROR(miopenConvolutionBackwardData(handle,
+                                                         &alpha,
+                                                         outputDesc,
+                                                         d_gradOutput,
+                                                         filterDesc,
+                                                         d_filter,
+                                                         convDesc,
+                                                         dgradPerf.bwd_data_algo,
+                                                         &beta,
+                                                         inputDesc,
+                                                         d_gradInput,
+                                                         d_workspace,
+                                                         dgradWorkspaceBytes));
+    };
+
+    auto miopenWgrad = [&]() {
+        float32_t alpha = 1.0f;
+        float32_t beta  = 0.0f;
+        CHECK_MIOPEN_ERROR(miopenConvolutionBackwardWeights(handle,
+                                                            &alpha,
+                                                            outputDesc,
+                                                            d_gradOutput,
+                                                            inputDesc,
+                                                            d_input,
+                                                            convDesc,
+                                                            wgradPerf.bwd_weights_algo,
+                                                            &beta,
+                                                            filterDesc,
+                                                            d_gradFilter,
+                                                            d_workspace,
+                                                            wgradWorkspaceBytes));
+    };
+
+    echo("dgrad", "MIOpen", mD, nD, kD, 1u, miopenDgrad);
+    echo("wgrad", "MIOpen", mW, nW, kW, 1u, miopenWgrad);
+
+    if(d_workspace != nullptr)
+    {
+        CHECK_HIP_ERROR(hipFree(d_workspace));
+    }
+    CHECK_MIOPEN_ERROR(miopenDestroyConvolutionDescriptor(convDesc));
+    CHECK_MIOPEN_ERROR(miopenDestroyTensorDescriptor(outputDesc));
+    CHECK_MIOPEN_ERROR(miopenDestroyTensorDescriptor(filterDesc));
+    CHECK_MIOPEN_ERROR(miopenDestroyTensorDescriptor(inputDesc));
+    CHECK_MIOPEN_ERROR(miopenDestroy(handle));
+
+#endif // ROCWMMA_BENCHMARK_WITH_MIOPEN
+
+    // Release device memory
+    CHECK_HIP_ERROR(hipFree(d_input));
+    CHECK_HIP_ERROR(hipFree(d_filter));
+    CHECK_HIP_ERROR(hipFree(d_filterRskc));
+    CHECK_HIP_ERROR(hipFree(d_gradOutput));
+    CHECK_HIP_ERROR(hipFree(d_gradInput));
+    CHECK_HIP_ERROR(hipFree(d_gradFilter));
+    CHECK_HIP_ERROR(hipFree(d_partials));
+}
+
+int main()
+{
+    std::cout << "Layer, Pass, Kernel, N, H, W, C, K, R, S, Pad, Stride, P, Q, "
+              << "MatM, MatN, MatK, Splits, "
+              << "Cache, elapsedMs, Problem Size(GFlops), TFlops/s, "
+              << BenchmarkHarness::statsHeader() << std::endl;
+
+    // Distinct convolution layers of ResNet-50
+    // : make_conv2d_nhwc(n, h, w, c, k, r, s, padH, padW, strideH, strideW)
+    conv2d_bwd_test("conv1", rocwmma::make_conv2d_nhwc(BATCH, 224, 224, 3, 64, 7, 7, 3, 3, 2, 2));
+    conv2d_bwd_test("conv2_1x1a", rocwmma::make_conv2d_nhwc(BATCH, 56, 56, 64, 64, 1, 1));
+    conv2d_bwd_test("conv2_3x3", rocwmma::make_conv2d_nhwc(BATCH, 56, 56, 64, 64, 3, 3, 1, 1));
+    conv2d_bwd_test("conv2_1x1b", rocwmma::make_conv2d_nhwc(BATCH, 56, 56, 64, 256, 1, 1));
+    conv2d_bwd_test("conv3_1x1a", rocwmma::make_conv2d_nhwc(BATCH, 28, 28, 512, 128, 1, 1));
+    conv2d_bwd_test("conv3_3x3",
+                    rocwmma::make_conv2d_nhwc(BATCH, 28, 28, 128, 128, 3, 3, 1, 1));
+    conv2d_bwd_test("conv3_down",
+                    rocwmma::make_conv2d_nhwc(BATCH, 56, 56, 256, 512, 1, 1, 0, 0, 2, 2));
+    conv2d_bwd_test("conv4_1x1a", rocwmma::make_conv2d_nhwc(BATCH, 14, 14, 1024, 256, 1, 1));
+    conv2d_bwd_test("conv4_3x3",
+                    rocwmma::make_conv2d_nhwc(BATCH, 14, 14, 256, 256, 3, 3, 1, 1));
+    conv2d_bwd_test("conv5_1x1a", rocwmma::make_conv2d_nhwc(BATCH, 7, 7, 2048, 512, 1, 1));
+    conv2d_bwd_test("conv5_3x3", rocwmma::make_conv2d_nhwc(BATCH, 7, 7, 512, 512, 3, 3, 1, 1));
+
+    std::cout << "Finished!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,681 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <iostream>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_fp16.h>
+#include <hip/hip_runtime.h>
+
+#if ROCWMMA_BENCHMARK_WITH_MIOPEN
+#include <miopen/miopen.h>
+#endif // ROCWMMA_BENCHMARK_WITH_MIOPEN
+
+#include <rocwmma/rocwmma.hpp>
+#include <rocwmma/rocwmma_multiblock.hpp>
+
+#include "benchmark_harness.hpp"
+#include "common.hpp"
+
+using rocwmma::accumulator;
+using rocwmma::batched_4x4;
+using rocwmma::col_major;
+using rocwmma::float16_t;
+using rocwmma::float32_t;
+using rocwmma::matrix_a;
+using rocwmma::matrix_b;
+using rocwmma::row_major;
+
+/* Motivation
+*
+* A grouped 2D convolution splits its C channels and K filters into G groups, and
+* each group convolves its own C / G channels into its own K / G filters, e.g. the
+* 32 groups of the ResNeXt blocks, or the depthwise convolutions of MobileNet where
+* G = C. Group g is the implicit GEMM of perf_hconv2d over the channels of the group:
+* - A_g (M x K): the im2col matrix of channels [g * C / G, (g + 1) * C / G)
+* - B_g (K x N): the filters of the group, K = R x S x C / G, N = K / G
+* - D_g (M x N): the output channels of the group, M = N x P x Q output pixels
+*
+* The G GEMMs share M, but N and K are tiny: ResNeXt-50 groups are 4 to 32 filters
+* wide over 36 to 288 taps, and depthwise groups are one filter over 9 taps. As one
+* GEMM, the block-diagonal filters would be mostly zeros; as G launches, each would
+* be too small to fill the device. Instead, each kernel maps groups to waves in a
+* single launch:
+*
+* - 16 x 16: each wave computes one 16 x 16 block of D_g, with the group taken from
+*   the wave index like a grouped GEMM problem index. rocwmma::load_matrix_im2col_sync
+*   with a rocwmma::conv2d_nhwc_grouped gathers A_g from the channels of the group.
+*   Blocks of narrow groups are mostly padding in N and K.
+*
+* - 4 x 4 (gfx9): each wave computes 16 independent 4 x 4 problems with the batched_4x4
+*   fragments of rocwmma_multiblock.hpp: 4 output pixels x 4 filters of 16 neighbouring
+*   groups, which read neighbouring channels of the same input pixels. K steps by 4, so
+*   a depthwise 3 x 3 group pads 9 taps to 12 instead of 16, and 1 filter to 4 instead
+*   of 16. Each lane gathers the A row and B column it holds directly.
+*
+* The benchmark runs the grouped convolutions of ResNeXt-50 (32x4d) and the depthwise
+* convolutions of MobileNetV2. When built with ROCWMMA_BENCHMARK_WITH_MIOPEN, the
+* same layers are also run with MIOpen on NHWC tensors for comparison.
+*
+* Note: C and K must be multiples of G. Sizes are otherwise unrestricted, the edges
+* are bounded.
+*/
+
+// Supports ROCWMMA_M/N square sizes of
+// : 16 x 16
+// : 32 x 32 ( only MI )
+const int ROCWMMA_M = 16;
+const int ROCWMMA_N = 16;
+
+// Supports ROCWMMA_K sizes as
+// : multiples of 16.
+const int ROCWMMA_K = 16;
+
+// Batched problems are 4 x 4 x BATCH_K steps, 16 per wave
+const int BATCH_M        = 4;
+const int BATCH_N        = 4;
+const int BATCH_K        = 4;
+const int BATCH_PER_WAVE = 16;
+
+// Device warp size
+const uint32_t WAVE_SIZE = getWarpSize();
+
+// Thread block
+// : T_BLOCK_X must be multiple of WAVE_SIZE.
+const int T_BLOCK_X = 4 * WAVE_SIZE;
+const int T_BLOCK_Y = 4;
+
+// Batch size of the network layers
+const uint32_t BATCH = 32u;
+
+using FragA = rocwmma::fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, row_major>;
+using FragB = rocwmma::fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, col_major>;
+using FragD
+    = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, row_major>;
+using FragAcc = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float32_t>;
+
+using FragA4x4
+    = rocwmma::fragment<matrix_a, BATCH_M, BATCH_N, BATCH_K, float16_t, batched_4x4>;
+using FragB4x4
+    = rocwmma::fragment<matrix_b, BATCH_M, BATCH_N, BATCH_K, float16_t, batched_4x4>;
+using FragAcc4x4
+    = rocwmma::fragment<accumulator, BATCH_M, BATCH_N, BATCH_K, float32_t, batched_4x4>;
+
+#if ROCWMMA_BENCHMARK_WITH_MIOPEN
+
+#ifndef CHECK_MIOPEN_ERROR
+#define CHECK_MIOPEN_ERROR(status)                   \
+    if(status != miopenStatusSuccess)                \
+    {                                                \
+        fprintf(stderr,                              \
+                "MIOpen error: '%s'(%d) at %s:%d\n", \
+                miopenGetErrorString(status),        \
+                status,                              \
+                __FILE__,                            \
+                __LINE__);                           \
+        exit(EXIT_FAILURE);                          \
+    }
+#endif
+
+#endif // ROCWMMA_BENCHMARK_WITH_MIOPEN
+
+// Grouped implicit GEMM convolution with 16 x 16 blocks. Each wave computes
+// one ROCWMMA_M x ROCWMMA_N block of the output of one group: the major wave
+// index selects the output pixels, and the minor one the group and its filters.
+//
+// : Input is in NHWC format    (row-major A_g, gathered from the group channels)
+// : Filters are in KRSC format (col-major B_g, K x N, C / G channels per filter)
+// : Output is in NPQK format   (row-major D_g, M x N, at the group channels)
+__global__ void hconv2d_grouped_d(rocwmma::conv2d_nhwc_grouped grouped,
+                                  float16_t const*             input,
+                                  float16_t const*             filter,
+                                  float16_t*                   output)
+{
+    auto const& conv = grouped.conv;
+
+    // Implicit GEMM sizes of each group
+    auto m   = conv.n * conv.p * conv.q;
+    auto n   = conv.k / grouped.groups;
+    auto k   = conv.r * conv.s * (conv.c / grouped.groups);
+    auto ldb = k;
+    auto ldd = conv.k;
+
+    // Tile using a 2D grid
+    auto majorWarp = (blockIdx.x * blockDim.x + threadIdx.x) / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    auto minorWarp = (blockIdx.y * blockDim.y + threadIdx.y);
+
+    // Target group and block
+    auto tilesN = rocwmma::ceilDiv(n, ROCWMMA_N);
+    auto group  = minorWarp / tilesN;
+    auto cRow   = majorWarp * ROCWMMA_M;
+    auto cCol   = minorWarp % tilesN * ROCWMMA_N;
+
+    // Bounds check
+    if(cRow < m && group < grouped.groups)
+    {
+        auto groupInput  = input + group * (conv.c / grouped.groups);
+        auto groupFilter = filter + static_cast<uint64_t>(group) * n * k;
+        auto groupOutput = output + group * n;
+
+        FragA   fragA;
+        FragB   fragB;
+        FragAcc fragAcc;
+        rocwmma::fill_fragment(fragAcc, 0.0f);
+
+        // fragAcc = im2col(input_g) x filter_g
+        for(uint32_t h = 0; h < k; h += ROCWMMA_K)
+        {
+            // Out of range rows, filter taps and filters are zero-filled
+            rocwmma::load_matrix_im2col_sync(fragA, groupInput, grouped, cRow, h);
+            rocwmma::load_matrix_bounded_sync(
+                fragB, groupFilter + (h + static_cast<uint64_t>(cCol) * ldb), ldb, k - h, n - cCol);
+
+            rocwmma::mma_sync(fragAcc, fragA, fragB, fragAcc);
+        }
+
+        FragD fragD;
+        for(int e = 0; e < fragD.num_elements; ++e)
+        {
+            fragD.x[e] = static_cast<float16_t>(fragAcc.x[e]);
+        }
+        auto offset = static_cast<uint64_t>(cRow) * ldd + cCol;
+        rocwmma::store_matrix_bounded_sync(groupOutput + offset, fragD, ldd, m - cRow, n - cCol);
+    }
+}
+
+// Grouped implicit GEMM convolution with batched 4 x 4 blocks. Each wave computes
+// 16 problems of 4 output pixels x 4 filters of one group. Problems are numbered
+// with the group fastest, then the filter quad, then the pixel quad, such that
+// the problems of a wave read neighbouring channels of the same input pixels.
+// Lane l holds row l % 4 of A and column l % 4 of B and D of problem l / 4, and
+// gathers them directly from the input and filters.
+//
+// : Input is in NHWC format
+// : Filters are in KRSC format, C / G channels per filter
+// : Output is in NPQK format
+__global__ void hconv2d_grouped_4x4_d(rocwmma::conv2d_nhwc_grouped grouped,
+                                      float16_t const*             input,
+                                      float16_t const*             filter,
+                                      float16_t*                   output)
+{
+    auto const& conv = grouped.conv;
+
+    // Implicit GEMM sizes of each group
+    auto m  = conv.n * conv.p * conv.q;
+    auto cg = conv.c / grouped.groups;
+    auto n  = conv.k / grouped.groups;
+    auto k  = conv.r * conv.s * cg;
+
+    auto filterQuads = rocwmma::ceilDiv(n, BATCH_N);
+    auto problems    = rocwmma::ceilDiv(m, BATCH_M) * filterQuads * grouped.groups;
+
+    auto wave = (blockIdx.x * blockDim.x + threadIdx.x) / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    auto lane = threadIdx.x % rocwmma::Constants::AMDGCN_WAVE_SIZE;
+
+    // The whole wave takes part in mma_sync: only exit when all its problems are done
+    if(wave * BATCH_PER_WAVE >= problems)
+    {
+        return;
+    }
+
+    // Problem and data held by this lane
+    auto problem    = wave * BATCH_PER_WAVE + lane / BATCH_M;
+    auto group      = problem % grouped.groups;
+    auto filterQuad = problem / grouped.groups % filterQuads;
+    auto pixelQuad  = problem / grouped.groups / filterQuads;
+    auto row        = pixelQuad * BATCH_M + lane % BATCH_M;
+    auto col        = filterQuad * BATCH_N + lane % BATCH_N;
+    bool rowValid   = problem < problems && row < m;
+    bool colValid   = problem < problems && col < n;
+
+    // Output pixel of the A row, and its top left input pixel
+    auto q     = row % conv.q;
+    auto p     = (row / conv.q) % conv.p;
+    auto batch = row / (conv.q * conv.p);
+    auto h0    = static_cast<int32_t>(p * conv.strideH) - static_cast<int32_t>(conv.padH);
+    auto w0    = static_cast<int32_t>(q * conv.strideW) - static_cast<int32_t>(conv.padW);
+
+    auto groupInput = input + static_cast<uint64_t>(batch) * conv.h * conv.w * conv.c + group * cg;
+    auto filterTaps = filter + (static_cast<uint64_t>(group) * n + col) * k;
+
+    FragA4x4   fragA;
+    FragB4x4   fragB;
+    FragAcc4x4 fragAcc;
+    rocwmma::fill_fragment(fragAcc, 0.0f);
+
+    // fragAcc = im2col(input_g) x filter_g, 16 problems at once
+    for(uint32_t t = 0; t < k; t += BATCH_K)
+    {
+        for(int e = 0; e < BATCH_K; ++e)
+        {
+            auto tap = t + e;
+            auto c   = tap % cg;
+            auto s   = (tap / cg) % conv.s;
+            auto r   = tap / (cg * conv.s);
+            auto h   = h0 + static_cast<int32_t>(r * conv.dilationH);
+            auto w   = w0 + static_cast<int32_t>(s * conv.dilationW);
+
+            bool inBounds = rowValid && tap < k && h >= 0 && h < static_cast<int32_t>(conv.h)
+                            && w >= 0 && w < static_cast<int32_t>(conv.w);
+
+            fragA.x[e] = inBounds ? groupInput[(static_cast<uint64_t>(h) * conv.w + w) * conv.c + c]
+                                  : static_cast<float16_t>(0);
+            fragB.x[e] = colValid && tap < k ? filterTaps[tap] : static_cast<float16_t>(0);
+        }
+
+        rocwmma::mma_sync(fragAcc, fragA, fragB, fragAcc);
+    }
+
+    // Column col of the 4 output pixels of the problem
+    if(colValid)
+    {
+        for(int i = 0; i < BATCH_M; ++i)
+        {
+            auto outRow = pixelQuad * BATCH_M + i;
+            if(outRow < m)
+            {
+                output[static_cast<uint64_t>(outRow) * conv.k + group * n + col]
+                    = static_cast<float16_t>(fragAcc.x[i]);
+            }
+        }
+    }
+}
+
+#if !NDEBUG
+
+// Direct grouped convolution reference, accumulating in float32_t
+__host__ void conv2d_grouped_cpu_h(rocwmma::conv2d_nhwc_grouped const& grouped,
+                                   float16_t const*                    input,
+                                   float16_t const*                    filter,
+                                   float16_t*                          output)
+{
+    auto const& conv = grouped.conv;
+
+    auto m  = conv.n * conv.p * conv.q;
+    auto cg = conv.c / grouped.groups;
+    auto kg = conv.k / grouped.groups;
+
+#pragma omp parallel for
+    for(uint32_t row = 0; row < m; ++row)
+    {
+        auto q = row % conv.q;
+        auto p = (row / conv.q) % conv.p;
+        auto n = row / (conv.q * conv.p);
+
+        for(uint32_t f = 0; f < conv.k; ++f)
+        {
+            auto      group = f / kg;
+            float32_t accum = 0.0f;
+            for(uint32_t r = 0; r < conv.r; ++r)
+            {
+                auto h = static_cast<int32_t>(p * conv.strideH + r * conv.dilationH)
+                         - static_cast<int32_t>(conv.padH);
+                if(h < 0 || h >= static_cast<int32_t>(conv.h))
+                {
+                    continue;
+                }
+
+                for(uint32_t s = 0; s < conv.s; ++s)
+                {
+                    auto w = static_cast<int32_t>(q * conv.strideW + s * conv.dilationW)
+                             - static_cast<int32_t>(conv.padW);
+                    if(w < 0 || w >= static_cast<int32_t>(conv.w))
+                    {
+                        continue;
+                    }
+
+                    auto inputPixel = input + ((uint64_t(n) * conv.h + h) * conv.w + w) * conv.c
+                                      + group * cg;
+                    auto filterTap  = filter + ((uint64_t(f) * conv.r + r) * conv.s + s) * cg;
+                    for(uint32_t c = 0; c < cg; ++c)
+                    {
+                        accum += static_cast<float32_t>(inputPixel[c])
+                                 * static_cast<float32_t>(filterTap[c]);
+                    }
+                }
+            }
+            output[uint64_t(row) * conv.k + f] = static_cast<float16_t>(accum);
+        }
+    }
+}
+
+#endif // !NDEBUG
+
+__host__ void conv2d_grouped_test(char const*                         layerName,
+                                  rocwmma::conv2d_nhwc_grouped const& grouped)
+{
+    auto const& conv = grouped.conv;
+
+    if(conv.c % grouped.groups != 0 || conv.k % grouped.groups != 0)
+    {
+        std::cout << layerName << " skipped: channels and filters must be multiples of groups"
+                  << std::endl;
+        return;
+    }
+
+    // Implicit GEMM sizes of each group
+    auto m  = conv.n * conv.p * conv.q;
+    auto cg = conv.c / grouped.groups;
+    auto n  = conv.k / grouped.groups;
+    auto k  = conv.r * conv.s * cg;
+
+    auto inputSize  = static_cast<size_t>(conv.n) * conv.h * conv.w * conv.c;
+    auto filterSize = static_cast<size_t>(conv.k) * k;
+    auto outputSize = static_cast<size_t>(m) * conv.k;
+
+    // Initialize input data
+    std::vector<float16_t> input(inputSize);
+    std::vector<float16_t> filter(filterSize);
+    std::vector<float16_t> output(outputSize);
+
+    fillRand(input.data(), conv.n * conv.h * conv.w, conv.c);
+    fillRand(filter.data(), conv.k, k);
+
+    // Allocate and copy device memory
+    float16_t* d_input;
+    float16_t* d_filter;
+    float16_t* d_output;
+
+    const size_t bytesInput  = input.size() * sizeof(float16_t);
+    const size_t bytesFilter = filter.size() * sizeof(float16_t);
+    const size_t bytesOutput = output.size() * sizeof(float16_t);
+
+    CHECK_HIP_ERROR(hipMalloc(&d_input, bytesInput));
+    CHECK_HIP_ERROR(hipMalloc(&d_filter, bytesFilter));
+    CHECK_HIP_ERROR(hipMalloc(&d_output, bytesOutput));
+
+    CHECK_HIP_ERROR(hipMemcpy(d_input, input.data(), bytesInput, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_filter, filter.data(), bytesFilter, hipMemcpyHostToDevice));
+
+    auto blockDim = dim3(T_BLOCK_X, T_BLOCK_Y);
+    auto gridDim  = dim3(rocwmma::ceilDiv(m, ROCWMMA_M * T_BLOCK_X / WAVE_SIZE),
+                        rocwmma::ceilDiv(grouped.groups * rocwmma::ceilDiv(n, ROCWMMA_N),
+                                         T_BLOCK_Y));
+
+    auto rocwmmaKernel = [&]() {
+        hipExtLaunchKernelGGL(hconv2d_grouped_d,
+                              gridDim,
+                              blockDim,
+                              0, // sharedMemBytes
+                              0, // stream
+                              nullptr, // Event start
+                              nullptr, // event stop
+                              0, // flags
+                              grouped,
+                              d_input,
+                              d_filter,
+                              d_output);
+    };
+
+    auto problems4x4 = rocwmma::ceilDiv(m, BATCH_M) * rocwmma::ceilDiv(n, BATCH_N) * grouped.groups;
+    auto waves4x4    = rocwmma::ceilDiv(problems4x4, BATCH_PER_WAVE);
+    auto gridDim4x4  = dim3(rocwmma::ceilDiv(waves4x4, T_BLOCK_X / WAVE_SIZE));
+
+    auto rocwmmaKernel4x4 = [&]() {
+        hipExtLaunchKernelGGL(hconv2d_grouped_4x4_d,
+                              gridDim4x4,
+                              dim3(T_BLOCK_X),
+                              0, // sharedMemBytes
+                              0, // stream
+                              nullptr, // Event start
+                              nullptr, // event stop
+                              0, // flags
+                              grouped,
+                              d_input,
+                              d_filter,
+                              d_output);
+    };
+
+    // Runs are timed individually, with warm and cold caches
+    BenchmarkHarness harness;
+
+    // Echo performance
+    auto echo = [&](const char* kernelName, auto&& kernel) {
+        auto gFlops = calculateGFlops(m, conv.k, k);
+
+        for(auto cacheState :
+            {BenchmarkHarness::CacheState::Warm, BenchmarkHarness::CacheState::Cold})
+        {
+            auto stats        = harness.run(kernel, cacheState);
+            auto tFlopsPerSec = calculateTFlopsPerSec(m, conv.k, k, stats.mMedianMs);
+
+            std::cout << layerName << ", " << kernelName << ", " << conv.n << ", " << conv.h
+                      << ", " << conv.w << ", " << conv.c << ", " << conv.k << ", "
+                      << grouped.groups << ", " << conv.r << ", " << conv.s << ", " << conv.padH
+                      << ", " << conv.strideH << ", " << conv.p << ", " << conv.q << ", " << m
+                      << ", " << n << ", " << k << ", "
+                      << (cacheState == BenchmarkHarness::CacheState::Warm ? "warm" : "cold")
+                      << ", " << stats.mMedianMs << ", " << gFlops << ", " << tFlopsPerSec
+                      << ", ";
+            BenchmarkHarness::printStats(std::cout, stats) << std::endl;
+        }
+    };
+
+#if !NDEBUG
+
+    // Setup and run reference computation
+    std::vector<float16_t> output_ref(outputSize, std::numeric_limits<float16_t>::signaling_NaN());
+    bool                   refComputed = false;
+
+    auto validate = [&]() {
+        std::cout << "Validating result with reference..." << std::endl;
+
+        if(!refComputed)
+        {
+            conv2d_grouped_cpu_h(grouped, input.data(), filter.data(), output_ref.data());
+            refComputed = true;
+        }
+
+        // Bring kernel result back to host
+        CHECK_HIP_ERROR(hipMemcpy(output.data(), d_output, bytesOutput, hipMemcpyDeviceToHost));
+
+        auto res = compareEqual(output.data(), output_ref.data(), outputSize);
+
+        if(std::get<0>(res) == false)
+        {
+            std::cout << "FAILED\n";
+        }
+        else
+        {
+            std::cout << "PASSED\n";
+        }
+
+        std::cout << "Max relative error: " << std::get<1>(res) << std::endl;
+    };
+
+#endif // !NDEBUG
+
+    echo("rocWMMA 16x16", rocwmmaKernel);
+
+#if !NDEBUG
+    validate();
+#endif // !NDEBUG
+
+    // Multi-block 4 x 4 mfma are gfx9 only
+    if(isGfx9())
+    {
+        // Clear the previous result, such that validation sees this kernel's output only
+        CHECK_HIP_ERROR(hipMemset(d_output, 0xFF, bytesOutput));
+
+        echo("rocWMMA 4x4", rocwmmaKernel4x4);
+
+#if !NDEBUG
+        validate();
+#endif // !NDEBUG
+    }
+
+#if ROCWMMA_BENCHMARK_WITH_MIOPEN
+
+    // NHWC tensors are described in NCHW dimension order, with NHWC strides
+    miopenHandle_t                handle;
+    miopenTensorDescriptor_t      inputDesc, filterDesc, outputDesc;
+    miopenConvolutionDescriptor_t convDesc;
+
+    CHECK_MIOPEN_ERROR(miopenCreate(&handle));
+    CHECK_MIOPEN_ERROR(miopenCreateTensorDescriptor(&inputDesc));
+    CHECK_MIOPEN_ERROR(miopenCreateTensorDescriptor(&filterDesc));
+    CHECK_MIOPEN_ERROR(miopenCreateTensorDescriptor(&outputDesc));
+    CHECK_MIOPEN_ERROR(miopenCreateConvolutionDescriptor(&convDesc));
+
+    auto describeNhwc = [](miopenTensorDescriptor_t desc, int n, int c, int h, int w) {
+        int dims[]    = {n, c, h, w};
+        int strides[] = {h * w * c, 1, w * c, c};
+        CHECK_MIOPEN_ERROR(miopenSetTensorDescriptor(desc, miopenHalf, 4, dims, strides));
+    };
+
+    describeNhwc(inputDesc, conv.n, conv.c, conv.h, conv.w);
+    describeNhwc(filterDesc, conv.k, cg, conv.r, conv.s);
+    describeNhwc(outputDesc, conv.n, conv.k, conv.p, conv.q);
+    CHECK_MIOPEN_ERROR(miopenInitConvolutionDescriptor(convDesc,
+                                                       miopenConvolution,
+                                                       conv.padH,
+                                                       conv.padW,
+                                                       conv.strideH,
+                                                       conv.strideW,
+                                                       conv.dilationH,
+                                                       conv.dilationW));
+    CHECK_MIOPEN_ERROR(miopenSetConvolutionGroupCount(convDesc, grouped.groups));
+
+    size_t workspaceBytes = 0u;
+    void*  d_workspace    = nullptr;
+    CHECK_MIOPEN_ERROR(miopenConvolutionForwardGetWorkSpaceSize(
+        handle, filterDesc, inputDesc, convDesc, outputDesc, &workspaceBytes));
+    if(workspaceBytes > 0u)
+    {
+        CHECK_HIP_ERROR(hipMalloc(&d_workspace, workspaceBytes));
+    }
+
+    int                  algoCount = 0;
+    miopenConvAlgoPerf_t perf;
+    CHECK_MIOPEN_ERROR(miopenFindConvolutionForwardAlgorithm(handle,
+                                                             inputDesc,
+                                                             d_input,
+                                                             filterDesc,
+                                                             d_filter,
+                                                             convDesc,
+                                                             outputDesc,
+                                                             d_output,
+                                                             1,
+                                                             &algoCount,
+                                                             &perf,
+                                                             d_workspace,
+                                                             workspaceBytes,
+                                                             false));
+
+    auto miopenKernel = [&]() {
+        float32_t alpha = 1.0f;
+        float32_t beta  = 0.0f;
+        CHECK_MIOPEN_ERROR(miopenConvolutionForward(handle,
+                                                    &alpha,
+                                                    inputDesc,
+                                                    d_input,
+                                                    filterDesc,
+                                                    d_filter,
+                                                    convDesc,
+                                                    perf.fwd_algo,
+                                                    &beta,
+                                                    outputDesc,
+                                                    d_output,
+                                                    d_workspace,
+                                                    workspaceBytes));
+    };
+
+    echo("MIOpen", miopenKernel);
+
+    if(d_workspace != nullptr)
+    {
+        CHECK_HIP_ERROR(hipFree(d_workspace));
+    }
+    CHECK_MIOPEN_ERROR(miopenDestroyConvolutionDescriptor(convDesc));
+    CHECK_MIOPEN_ERROR(miopenDestroyTensorDescriptor(outputDesc));
+    CHECK_MIOPEN_ERROR(miopenDestroyTensorDescriptor(filterDesc));
+    CHECK_MIOPEN_ERROR(miopenDestroyTensorDescriptor(inputDesc));
+    CHECK_MIOPEN_ERROR(miopenDestroy(handle));
+
+#endif // ROCWMMA_BENCHMARK_WITH_MIOPEN
+
+    // Release device memory
+    CHECK_HIP_ERROR(hipFree(d_input));
+    CHECK_HIP_ERROR(hipFree(d_filter));
+    CHECK_HIP_ERROR(hipFree(d_output));
+}
+
+int main()
+{
+    std::cout << "Layer, Kernel, N, H, W, C, K, G, R, S, Pad, Stride, P, Q, "
+              << "MatM, GroupN, GroupK, "
+              << "Cache, elapsedMs, Problem Size(GFlops), TFlops/s, "
+              << BenchmarkHarness::statsHeader() << std::endl;
+
+    // : make_conv2d_nhwc(n, h, w, c, k, r, s, padH, padW, strideH, strideW)
+    auto grouped = [](rocwmma::conv2d_nhwc conv, uint32_t groups) {
+        return rocwmma::conv2d_nhwc_grouped{conv, groups};
+    };
+
+    // Grouped 3 x 3 convolutions of ResNeXt-50 (32x4d)
+    conv2d_grouped_test(
+        "resnext_conv2",
+        grouped(rocwmma::make_conv2d_nhwc(BATCH, 56, 56, 128, 128, 3, 3, 1, 1), 32));
+    conv2d_grouped_test(
+        "resnext_conv3_down",
+        grouped(rocwmma::make_conv2d_nhwc(BATCH, 56, 56, 256, 256, 3, 3, 1, 1, 2, 2), 32));
+    conv2d_grouped_test(
+        "resnext_conv3",
+        grouped(rocwmma::make_conv2d_nhwc(BATCH, 28, 28, 256, 256, 3, 3, 1, 1), 32));
+    conv2d_grouped_test(
+        "resnext_conv4",
+        grouped(rocwmma::make_conv2d_nhwc(BATCH, 14, 14, 512, 512, 3, 3, 1, 1), 32));
+    conv2d_grouped_test(
+        "resnext_conv5",
+        grouped(rocwmma::make_conv2d_nhwc(BATCH, 7, 7, 1024, 1024, 3, 3, 1, 1), 32));
+
+    // Depthwise 3 x 3 convolutions of MobileNetV2
+    conv2d_grouped_test(
+        "mobilenet_dw1",
+        grouped(rocwmma::make_conv2d_nhwc(BATCH, 112, 112, 32, 32, 3, 3, 1, 1), 32));
+    conv2d_grouped_test(
+        "mobilenet_dw2_down",
+        grouped(rocwmma::make_conv2d_nhwc(BATCH, 112, 112, 96, 96, 3, 3, 1, 1, 2, 2), 96));
+    conv2d_grouped_test(
+        "mobilenet_dw3",
+        grouped(rocwmma::make_conv2d_nhwc(BATCH, 56, 56, 144, 144, 3, 3, 1, 1), 144));
+    conv2d_grouped_test(
+        "mobilenet_dw4",
+        grouped(rocwmma::make_conv2d_nhwc(BATCH, 28, 28, 192, 192, 3, 3, 1, 1), 192));
+    conv2d_grouped_test(
+        "mobilenet_dw5",
+        grouped(rocwmma::make_conv2d_nhwc(BATCH, 14, 14, 384, 384, 3, 3, 1, 1), 384));
+    conv2d_grouped_test(
+        "mobilenet_dw6",
+        grouped(rocwmma::make_conv2d_nhwc(BATCH, 14, 14, 576, 576, 3, 3, 1, 1), 576));
+    conv2d_grouped_test(
+        "mobilenet_dw7",
+        grouped(rocwmma::make_conv2d_nhwc(BATCH, 7, 7, 960, 960, 3, 3, 1, 1), 960));
+
+    std::cout << "Finished!" << std::endl;
+    return 0;
+}
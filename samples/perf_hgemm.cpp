@@ -23,6 +23,7 @@
  * SOFTWARE.
  *
  *******************************************************************************/
+#include <algorithm>
 #include <iostream>
 #include <vector>
 
@@ -32,9 +33,15 @@
 
 #include <rocwmma/rocwmma.hpp>
 #include <rocwmma/rocwmma_coop.hpp>
+#include <rocwmma/rocwmma_epilogue.hpp>
+#include <rocwmma/rocwmma_pipeline.hpp>
+#include <rocwmma/rocwmma_profile.hpp>
+#include <rocwmma/rocwmma_tile.hpp>
 #include <rocwmma/rocwmma_transforms.hpp>
 
+#include "benchmark_harness.hpp"
 #include "common.hpp"
+#include "perf_golden.hpp"
 
 /* Motivation
 *
@@ -144,6 +151,12 @@
 *         v
 *        End
 *
+* The LDS buffers are managed by rocwmma::lds_pipeline, a ring of LDS_PIPELINE_DEPTH
+* stages. A depth of 2 follows the flow above. Deeper rings prefetch Depth - 1 K-steps
+* ahead, and let the local writes of one K-step overlap with the local reads of the next.
+* They also double buffer the A / B fragments in registers with rocwmma::fragment_pipeline:
+* the local reads of K-step + 1 are issued ahead of the mma of K-step.
+*
 * Lds Mapping
 * Buffer Width = LDS Width = BlockK
 * Matrix geometry for inputs A and B have a common dimension (BlockK).
@@ -188,16 +201,60 @@
 *
 * Depending on the locality of the block being processed, warps load the corresponding
 * A and B inputs from LDS buffer and use them for the accumulation of AxB calculations.
+*
+* Persistent kernel
+*
+* Launching one workgroup per macro tile pays the workgroup dispatch overhead for
+* every tile, and the last partial wave of workgroups leaves the GPU underutilized.
+* The persistent kernel variant launches only as many workgroups as can be resident
+* at once (CUs x occupancy). Each workgroup repeatedly dequeues the next macro tile
+* index from a global atomic counter until all tiles are consumed. Linear tile
+* indices are swizzled in bands of TILE_SWIZZLE tile rows, so that workgroups
+* running concurrently share A and B data in the L2 cache.
+*
+* Rasterization
+*
+* Mapping blockIdx.x / y straight to macro tiles makes each wave of resident workgroups
+* stream disjoint A / B panels through L2. The data-parallel kernel is also run with the
+* rocwmma::raster policies: grouped bands, Morton and Hilbert super-tiles, and an XCD-aware
+* distribution for chiplet GPUs whose XCDs each own an L2. Each run is preceded by the
+* modeled footprint of A / B panels per L2 for the first wave of resident workgroups.
+* Measure the L2 hit rate of each kernel with the profiler, e.g.:
+*     rocprofv3 --pmc TCC_HIT_sum TCC_MISS_sum -- ./perf_hgemm
+*
+* Wave specialized kernel
+*
+* In the kernels above, every warp carries both the global read buffers and the mma
+* accumulators, and the whole workgroup synchronizes at every K step. The wave specialized
+* variant appends PRODUCER_ROWS rows of producer warps to the workgroup. Producers only
+* stream global A / B into the LDS stages, and the original warps only read LDS and mma.
+* Producers and consumers synchronize per LDS stage with rocwmma::lds_stage_barrier, which
+* emulates named barriers with counters in LDS, so producers can run up to
+* LDS_PIPELINE_DEPTH K steps ahead of the consumers.
 */
 
 using namespace rocwmma;
 
+///
+/// Types and Data Layouts
+///
+
+using InputT   = float16_t;
+using OutputT  = float16_t;
+using ComputeT = float32_t;
+
+using DataLayoutA = col_major;
+using DataLayoutB = row_major;
+using DataLayoutC = row_major;
+
 ///
 /// Parameter configuration
 ///
 
-/* Depending on the GPU architecture this sample is run on, the following kernel parameters need to
-*  be modified in order to obtain high performance.
+/* The kernel parameters are the validated defaults of rocwmma::warp_tile_config for InputT and
+*  the GPU architecture being compiled. Each target of an --offload-arch fat binary is compiled
+*  with its own parameters, and the host selects the same ones at runtime with
+*  get_warp_tile_params. For float16_t:
 * _________________________________________________________________________________________
 *|         |           |           |           |          |          |          |          |
 *|         | ROCWMMA_M | ROCWMMA_N | ROCWMMA_K | BLOCKS_X | BLOCKS_Y | TBLOCK_X | TBLOCK_Y |
@@ -207,6 +264,7 @@ using namespace rocwmma;
 *|_________|___________|___________|___________|__________|__________|__________|__________|
 *|         |           |           |           |          |          |          |          |
 *|  GFX_11 |    16     |    16     |    16     |    4     |    2     |    64    |    4     |
+*|  GFX_12 |           |           |           |          |          |          |          |
 *|_________|___________|___________|___________|__________|__________|__________|__________|
 *
 * __________________________________________
@@ -218,57 +276,63 @@ using namespace rocwmma;
 *|_________|________________________________|
 *|         |                                |
 *|  GFX_11 | Constants::AMDGCN_WAVE_SIZE_32 |
+*|  GFX_12 |                                |
 *|_________|________________________________|
 */
 
-namespace gfx9Params
-{
-    enum kernelParams : uint32_t
-    {
-        ROCWMMA_M = 32u,
-        ROCWMMA_N = 32u,
-        ROCWMMA_K = 16u,
-        BLOCKS_X  = 2u,
-        BLOCKS_Y  = 2u,
-        TBLOCK_X  = 128u,
-        TBLOCK_Y  = 2u,
-        WARP_SIZE = Constants::AMDGCN_WAVE_SIZE_64
-    };
-}
+using WarpTileConfig = warp_tile_config_t<InputT>;
 
-namespace gfx11Params
-{
-    enum kernelParams : uint32_t
-    {
-        ROCWMMA_M = 16u,
-        ROCWMMA_N = 16u,
-        ROCWMMA_K = 16u,
-        BLOCKS_X  = 4u,
-        BLOCKS_Y  = 2u,
-        TBLOCK_X  = 64u,
-        TBLOCK_Y  = 4u,
-        WARP_SIZE = Constants::AMDGCN_WAVE_SIZE_32
-    };
-}
+// The perf_hgemm_large_tile build doubles the gfx9 warp tile to 4 x 4 blocks: 256 x 256 macro
+// tiles, whose 32 x 32 accumulators hold 256 registers per lane, the whole AGPR file. Its kernels
+// are compiled for one wave per SIMD, such that the accumulators stay in AGPRs without scratch.
+// The wave specialized kernel is skipped: its producer warps put two waves on some SIMDs.
+#if !defined(ROCWMMA_PERF_HGEMM_LARGE_TILE)
+#define ROCWMMA_PERF_HGEMM_LARGE_TILE 0
+#endif // !defined(ROCWMMA_PERF_HGEMM_LARGE_TILE)
 
-#if(ROCWMMA_ARCH_GFX9)
-using namespace gfx9Params;
+#if ROCWMMA_PERF_HGEMM_LARGE_TILE && ROCWMMA_ARCH_GFX9
+#define PERF_HGEMM_WAVES_PER_EU ROCWMMA_WAVES_PER_EU(1, 1)
 #else
-using namespace gfx11Params;
-#endif // defined(ROCWMMA_ARCH_GFX9)
+#define PERF_HGEMM_WAVES_PER_EU
+#endif
 
-///
-/// Types and Data Layouts
-///
+constexpr bool     LARGE_TILE        = ROCWMMA_PERF_HGEMM_LARGE_TILE && ROCWMMA_ARCH_GFX9;
+constexpr uint32_t LARGE_TILE_BLOCKS = 4u;
 
-using InputT   = float16_t;
-using OutputT  = float16_t;
-using ComputeT = float32_t;
-
-using DataLayoutA   = col_major;
-using DataLayoutB   = row_major;
-using DataLayoutC   = row_major;
-using DataLayoutLds = col_major;
+enum kernelParams : uint32_t
+{
+    ROCWMMA_M = WarpTileConfig::block_m,
+    ROCWMMA_N = WarpTileConfig::block_n,
+    ROCWMMA_K = WarpTileConfig::block_k,
+    BLOCKS_X  = LARGE_TILE ? LARGE_TILE_BLOCKS : WarpTileConfig::blocks_x,
+    BLOCKS_Y  = LARGE_TILE ? LARGE_TILE_BLOCKS : WarpTileConfig::blocks_y,
+    TBLOCK_X  = WarpTileConfig::tblock_x,
+    TBLOCK_Y  = WarpTileConfig::tblock_y,
+    WARP_SIZE = WarpTileConfig::wave_size
+};
+
+using DataLayoutLds = WarpTileConfig::lds_layout;
+
+// Access policy for LDS writes and reads. lds_access issues ds_read / ds_write of up to 128 bits.
+// An xor_swizzle policy also permutes LDS addresses to remove bank conflicts,
+// e.g. xor_swizzle<8u, 16u, 512u> for one ldsld column of float16_t.
+using LdsAccessPolicy = lds_access;
+
+// Number of LDS stages in the K loop: 2 double buffers, 3 or more also double buffers the
+// A / B fragments in registers, such that the local reads of a step overlap with the mma of
+// the previous one.
+constexpr uint32_t LDS_PIPELINE_DEPTH = 3u;
+
+// Instruction scheduling policy of each K step. A SchedInterleave policy pipelines mma with
+// local and global reads, e.g. SchedInterleave<4u, SchedGroup<SchedMask::Mma, 1>,
+// SchedGroup<SchedMask::DsRead, 2>, SchedGroup<SchedMask::VmemRead, 1>>.
+using KStepSchedPolicy = SchedNone;
+
+// K loop unrolling. K_UNROLL unrolls that many pairs of register double buffered K steps per
+// loop iteration (see fragment_pipeline). A non-zero STATIC_K compiles the kernels for that K
+// only, e.g. the head dimension of attention: the whole K loop is flattened without branches.
+constexpr uint32_t K_UNROLL = 1u;
+constexpr uint32_t STATIC_K = 0u;
 
 ///
 /// Fragment types
@@ -286,6 +350,22 @@ constexpr uint32_t WARPS_Y      = TBLOCK_Y;
 constexpr uint32_t MACRO_TILE_X = WARPS_X * WARP_TILE_X;
 constexpr uint32_t MACRO_TILE_Y = WARPS_Y * WARP_TILE_Y;
 
+// Persistent kernel: band height (in macro tiles) of the tile traversal order
+constexpr uint32_t TILE_SWIZZLE = 4u;
+
+using TileRaster = raster::grouped<TILE_SWIZZLE>;
+
+// Rasterization: log2 of the Morton / Hilbert super-tile side, and the XCDs sharing the
+// workgroups round-robin, each with a private L2 (MI300X: 8)
+constexpr uint32_t RASTER_ORDER = 3u;
+constexpr uint32_t XCD_COUNT    = 8u;
+
+// Wave specialized kernel: rows of producer warps appended below the TBLOCK_X x TBLOCK_Y
+// consumer warps. Producers stream global A / B into LDS, consumers read LDS and mma.
+constexpr uint32_t PRODUCER_ROWS  = 1u;
+constexpr uint32_t PRODUCER_WARPS = WARPS_X * PRODUCER_ROWS;
+constexpr uint32_t CONSUMER_WARPS = WARPS_X * WARPS_Y;
+
 // Mfma frags
 using MfmaFragA   = fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, InputT, DataLayoutA>;
 using MfmaFragB   = fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, InputT, DataLayoutB>;
@@ -293,433 +373,667 @@ using MfmaFragC   = fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, Outpu
 using MfmaFragD   = MfmaFragC;
 using MfmaFragAcc = fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, ComputeT>;
 
+// C frags in any datatype and data layout
+template <typename DataTC, typename LayoutC>
+using MfmaFragCT = fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, DataTC, LayoutC>;
+
+// Warp tile of mfma frags
+using MfmaTileA   = fragment_array<MfmaFragA, BLOCKS_X, 1u>;
+using MfmaTileB   = fragment_array<MfmaFragB, 1u, BLOCKS_Y>;
+using MfmaTileC   = fragment_array<MfmaFragC, BLOCKS_X, BLOCKS_Y>;
+using MfmaTileD   = MfmaTileC;
+using MfmaTileAcc = fragment_array<MfmaFragAcc, BLOCKS_X, BLOCKS_Y>;
+
+template <typename DataTC, typename LayoutC>
+using MfmaTileCT = fragment_array<MfmaFragCT<DataTC, LayoutC>, BLOCKS_X, BLOCKS_Y>;
+
 // Global read (macro tile)
 using GRBuffA = fragment<matrix_a, MACRO_TILE_X, ROCWMMA_N, ROCWMMA_K, InputT, DataLayoutA>;
 using GRBuffB = fragment<matrix_b, ROCWMMA_M, MACRO_TILE_Y, ROCWMMA_K, InputT, DataLayoutB>;
 
-// Local write of global buffers (macro tile)
-// - Must match Lds data layout.
-// - Lds has transposed B frags.
-using LWBuffA = ApplyDataLayout_t<GRBuffA, DataLayoutLds>;
-using LWBuffB = ApplyDataLayout_t<ApplyTranspose_t<GRBuffB>, DataLayoutLds>;
-
-// Local read (mfma frags)
-// - Must match Lds data layout.
-// - Lds has transposed B frags.
-using LRFragA = ApplyDataLayout_t<MfmaFragA, DataLayoutLds>;
-using LRFragB = ApplyDataLayout_t<ApplyTranspose_t<MfmaFragB>, DataLayoutLds>;
+// Multi-buffered LDS staging of the global buffers (macro tile)
+// - Lds has A frags followed by transposed B frags, in the Lds data layout.
+// - Global reads and local writes are cooperative across all warps.
+using LdsPipeline = lds_pipeline<LDS_PIPELINE_DEPTH,
+                                 WARPS_X * WARPS_Y,
+                                 GRBuffA,
+                                 GRBuffB,
+                                 DataLayoutLds,
+                                 LdsAccessPolicy>;
+
+// Wave specialized staging of the global buffers (macro tile)
+// - Global reads and local writes are cooperative across producer warps only.
+// - Producers and consumers synchronize per LDS stage, through counters after the stages.
+using WsLdsPipeline = lds_pipeline<LDS_PIPELINE_DEPTH,
+                                   PRODUCER_WARPS,
+                                   GRBuffA,
+                                   GRBuffB,
+                                   DataLayoutLds,
+                                   LdsAccessPolicy>;
+using WsStageBarrier = lds_stage_barrier<LDS_PIPELINE_DEPTH, PRODUCER_WARPS, CONSUMER_WARPS>;
 // #endif // (ROCWMMA_ARCH_GFX9 || ROCWMMA_ARCH_GFX11)
 
 ///
 /// Wrapper functions: repeat mfma tile operations across entire warp tile.
+/// Load, store, fill and mma of the warp tile are provided by fragment_array.
 ///
 
-// Cooperative global read / local write (Macro tile data movement)
-// Loads / stores a global data fragment cooperatively across warps. Each participating warp is
-// responsible for only a portion of the whole fragment.
-//
-// The cooperative operation is split into work items (SplitCount). Work items are consumed in
-// a round robin fashion by warps in the range of [0, WaveCount). The wave index determines the
-// order of the current wave in the collaboration pool.
-//
-// WaveCount, SplitCount and waveIndex parameters must match successive coop load / store calls
-// to ensure the entire fragment remains coherent.
-
-// Global A reads in cooperative mode (macro tile)
-template <uint32_t WaveCountA>
-ROCWMMA_DEVICE static inline void
-    globalReadCoopA(GRBuffA& grBuffA, InputT const* gAddrA, uint32_t lda, uint32_t waveIndexA)
+// Uniform multiply - add (FMA)
+// Performs D = alpha * acc + beta * C, where alpha, beta are uniform scalars.
+// The case lc of alpha and beta is uniform: unless it is linear_full, fragsC is not read
+// and need not be loaded. C may be held in another datatype and data layout than D:
+// LinearCombination converts it in registers.
+template <typename DataTC, typename LayoutC>
+ROCWMMA_DEVICE static inline void uniformFma(MfmaTileD&                         fragsD,
+                                             linear_combination_t               lc,
+                                             ComputeT                           alpha,
+                                             MfmaTileAcc const&                 fragsAcc,
+                                             ComputeT                           beta,
+                                             MfmaTileCT<DataTC, LayoutC> const& fragsC)
 {
-    load_matrix_coop_sync<WaveCountA>(grBuffA, gAddrA, lda, waveIndexA);
+    detail::checkCoIndexed<MfmaFragD, MfmaFragCT<DataTC, LayoutC>>();
+#pragma unroll
+    for(int i = 0; i < BLOCKS_X; i++)
+    {
+#pragma unroll
+        for(int j = 0; j < BLOCKS_Y; j++)
+        {
+            // Perform computation in ComputeT and cast back to OutputT
+            if(lc == linear_identity)
+            {
+                rocwmma::apply_epilogue(fragsD(i, j), fragsAcc(i, j));
+            }
+            else if(lc == linear_scale)
+            {
+                rocwmma::apply_epilogue(
+                    fragsD(i, j), fragsAcc(i, j), rocwmma::epilogue::TensorScale(alpha));
+            }
+            else
+            {
+                rocwmma::apply_epilogue(
+                    fragsD(i, j),
+                    fragsAcc(i, j),
+                    rocwmma::epilogue::LinearCombination(alpha, beta, fragsC(i, j)));
+            }
+        }
+    }
 }
 
-// Global B reads in cooperative mode (macro tile)
-template <uint32_t WaveCountB>
-ROCWMMA_DEVICE static inline void
-    globalReadCoopB(GRBuffB& grBuffB, InputT const* gAddrB, uint32_t ldb, uint32_t waveIndexB)
+// Computes one macro tile of D = alpha * (A x B) + beta * C, where
+// tileCoord is the 2D index of the macro tile in the global D matrix.
+ROCWMMA_DEVICE static inline void gemmMacroTile(Coord2d const& tileCoord,
+                                                uint32_t       m,
+                                                uint32_t       n,
+                                                uint32_t       k,
+                                                InputT const*  a,
+                                                InputT const*  b,
+                                                OutputT const* c,
+                                                OutputT*       d,
+                                                uint32_t       lda,
+                                                uint32_t       ldb,
+                                                uint32_t       ldc,
+                                                uint32_t       ldd,
+                                                ComputeT       alpha,
+                                                ComputeT       beta,
+                                                InputT*        ldsPtr)
 {
-    load_matrix_coop_sync<WaveCountB>(grBuffB, gAddrB, ldb, waveIndexB);
-}
+    ///
+    /// 2D matrix coordinate setup
+    ///
 
-// Local A writes in cooperative mode (macro tile)
-template <uint32_t WaveCountA>
-ROCWMMA_DEVICE static inline void
-    localWriteCoopA(InputT* ldsAddr, GRBuffA const& grBuffA, uint32_t ldsld, uint32_t waveIndexA)
-{
-    // No transpose, but apply the lds data layout
-    store_matrix_coop_sync<WaveCountA>(
-        ldsAddr, applyDataLayout<DataLayoutLds, WaveCountA>(grBuffA), ldsld, waveIndexA);
-}
+    // Tile Sizes
+    constexpr auto warpTileSize  = make_coord2d(WARP_TILE_X, WARP_TILE_Y);
+    constexpr auto macroTileSize = make_coord2d(MACRO_TILE_X, MACRO_TILE_Y);
 
-// Local B writes in cooperative mode (macro tile)
-template <uint32_t WaveCountB>
-ROCWMMA_DEVICE static inline void
-    localWriteCoopB(InputT* ldsAddr, GRBuffB const& grBuffB, uint32_t ldsld, uint32_t waveIndexB)
-{
-    // Transpose B and then apply lds data layout
-    store_matrix_coop_sync<WaveCountB>(
-        ldsAddr, applyDataLayout<DataLayoutLds, WaveCountB>(applyTranspose(grBuffB)), ldsld, waveIndexB);
-}
+    // Local warp coordinate relative to current threadblock (wg).
+    constexpr auto warpDims        = make_coord2d(WARPS_X, WARPS_Y);
+    auto           localWarpCoord  = make_coord2d(threadIdx.x / WARP_SIZE, threadIdx.y);
+    auto           localWarpOffset = localWarpCoord * warpTileSize;
 
-// Local A reads for warp tile gemm, non-cooperative
-ROCWMMA_DEVICE static inline void
-    localReadA(MfmaFragA (&fragsA)[BLOCKS_X], InputT const* ldsAddrA, uint32_t ldsld)
-{
-    using FragShape = GetIOShape_t<LRFragA>;
-    using Mapper1d  = GetDataLayout_t<LRFragA>;
+    // Global matrix coordinates for C/D
+    auto macroTileCoord = tileCoord * macroTileSize;
+    auto warpTileCoord  = macroTileCoord + localWarpOffset;
 
-    // Each A block is stacked vertically in LDS
-    auto blockStep = Mapper1d::fromMatrixCoord(make_coord2d(FragShape::BlockHeight, 0u), ldsld);
+    // Bounds check
+    auto warpTileBound = warpTileCoord + warpTileSize;
+    if(get<0>(warpTileBound) > m || get<1>(warpTileBound) > n)
+    {
+        return;
+    }
 
-#pragma unroll
-    for(int i = 0; i < BLOCKS_X; i++)
+    // Phase stamps, compiled out unless ROCWMMA_PROFILE_STAMPS is enabled
+    profile::stamp_ring stamps;
+
+    ///
+    /// 1D global read coordinate setup
+    ///
+    using GRBuffAMap1d = GetDataLayout_t<GRBuffA>;
+    using GRBuffBMap1d = GetDataLayout_t<GRBuffB>;
+
+    // Initial globa read address offsets
+    auto globalReadOffsetA
+        = GRBuffAMap1d::fromMatrixCoord(make_coord2d(get<0>(macroTileCoord), 0u), lda);
+    auto globalReadOffsetB
+        = GRBuffBMap1d::fromMatrixCoord(make_coord2d(0u, get<1>(macroTileCoord)), ldb);
+
+    // Incremental global read address offsets
+    auto kStepOffsetA = GRBuffAMap1d::fromMatrixCoord(make_coord2d(0u, ROCWMMA_K), lda);
+    auto kStepOffsetB = GRBuffBMap1d::fromMatrixCoord(make_coord2d(ROCWMMA_K, 0u), ldb);
+
+    ///
+    /// Cooperative config for global read A / B
+    ///
+
+    // WorkItems will be split up by minimum IOCount to perform either global read or local write.
+    // These are inputs to cooperative functions.
+    constexpr auto warpCount = get<0>(warpDims) * get<1>(warpDims);
+
+    // Scheduling warp order is analogous to row major priority.
+    // E.g. Wg = (128, 2) = 2x2 warps
+    // (0, 0)   (0, 1)   Share Schedule: w0 = (0, 0), w1 = (0, 1),
+    // (1, 0)   (1, 1)                   w2 = (1, 0), w3 = (1, 1), count = 4
+    const auto warpIndex = get<0>(localWarpCoord) * get<1>(warpDims) + get<1>(localWarpCoord);
+
+    ///
+    /// Setup LDS pipeline
+    /// This kernel will use LDS_PIPELINE_DEPTH separate LDS blocks for pipelining
+    /// the input prefetching during the accumulation loop
+    ///
+    static_assert(LdsPipeline::depth >= 2u, "Requires at least double buffering");
+    static_assert(warpCount == WARPS_X * WARPS_Y, "Pipeline and workgroup warp counts differ");
+
+    LdsPipeline pipeline(ldsPtr, warpIndex);
+
+    ///
+    /// Perform initial global pre-fetch and write to local
+    ///
+    static_assert(STATIC_K % ROCWMMA_K == 0u, "STATIC_K must be a multiple of BlockK");
+    auto kSteps        = STATIC_K > 0u ? STATIC_K / ROCWMMA_K : k / ROCWMMA_K;
+    auto prologueSteps = std::min(LdsPipeline::depth - 1u, kSteps);
+    for(uint32_t step = 0u; step < prologueSteps; step++)
     {
-        LRFragA tmp;
-        load_matrix_sync(tmp, ldsAddrA, ldsld);
-        fragsA[i] = applyDataLayout<DataLayoutA>(tmp);
+        stamps.stamp(profile::phase_global_read);
+        pipeline.global_read(a + globalReadOffsetA, lda, b + globalReadOffsetB, ldb);
+
+        globalReadOffsetA += kStepOffsetA;
+        globalReadOffsetB += kStepOffsetB;
 
-        ldsAddrA += blockStep;
+        stamps.stamp(profile::phase_local_write);
+        pipeline.local_write();
     }
-}
 
-// Local B reads for warp tile gemm, non-cooperative
-ROCWMMA_DEVICE static inline void
-    localReadB(MfmaFragB (&fragsB)[BLOCKS_Y], InputT const* ldsAddrB, uint32_t ldsld)
-{
-    using FragShape = GetIOShape_t<LRFragB>;
-    using Mapper1d  = GetDataLayout_t<LRFragB>;
+    ///
+    /// Initialize accumulation frags
+    ///
+    MfmaTileAcc fragsAcc;
+    fill_fragment(fragsAcc, 0.0f);
 
-    // Each B block is stacked vertically in LDS
-    auto blockStep = Mapper1d::fromMatrixCoord(make_coord2d(FragShape::BlockHeight, 0u), ldsld);
+    ///
+    /// Synchronize warps and memory
+    ///
+    synchronize_workgroup();
 
-#pragma unroll
-    for(int i = 0; i < BLOCKS_Y; i++)
+    ///
+    /// Accumulate A * B for all mfma frags in warp tile
+    ///
+    using MfmaFragCMap1d = GetDataLayout_t<MfmaFragC>;
+    using MfmaFragDMap1d = GetDataLayout_t<MfmaFragD>;
+    MfmaTileC fragsC;
+
+    // C is only read when beta != 0
+    auto linearCase = get_linear_combination(alpha, beta);
+
+    if constexpr(LdsPipeline::depth == 2u)
     {
-        LRFragB tmp;
-        load_matrix_sync(tmp, ldsAddrB, ldsld);
+        for(uint32_t step = prologueSteps; step < kSteps; step++)
+        {
+            MfmaTileA fragsA;
+            MfmaTileB fragsB;
 
-        // Transform back to MFMA tile
-        fragsB[i] = applyDataLayout<DataLayoutB>(applyTranspose(tmp));
+            // Local read mfma frags from the read stage
+            stamps.stamp(profile::phase_local_read);
+            pipeline.local_read_a(fragsA, get<0>(localWarpOffset));
+            pipeline.local_read_b(fragsB, get<1>(localWarpOffset));
 
-        ldsAddrB += blockStep;
-    }
-}
+            // Prefetch next round of global frags
+            stamps.stamp(profile::phase_global_read);
+            pipeline.global_read(a + globalReadOffsetA, lda, b + globalReadOffsetB, ldb);
 
-// Global C reads for warp tile gemm, non-cooperative
-ROCWMMA_DEVICE static inline void
-    globalReadC(MfmaFragC (&fragC)[BLOCKS_X][BLOCKS_Y], OutputT const* gAddrC, uint32_t ldc)
-{
-    using FragShape = GetIOShape_t<MfmaFragC>;
-    using Mapper1d  = GetDataLayout_t<MfmaFragC>;
+            // Advance offsets to next k step
+            globalReadOffsetA += kStepOffsetA;
+            globalReadOffsetB += kStepOffsetB;
 
-    // Iterative offsets for each C block in the wave tile
-    auto blockStepX = Mapper1d::fromMatrixCoord(make_coord2d(FragShape::BlockHeight, 0u), ldc);
-    auto blockStepY = Mapper1d::fromMatrixCoord(make_coord2d(0u, FragShape::BlockWidth), ldc);
+            // accum(A * B)
+            stamps.stamp(profile::phase_mma);
+            mma_sync(fragsAcc, fragsA, fragsB, fragsAcc);
 
-#pragma unroll
-    for(int i = 0; i < BLOCKS_X; i++)
-    {
-        auto offsetY = 0u;
-#pragma unroll
-        for(int j = 0; j < BLOCKS_Y; j++)
-        {
-            load_matrix_sync(fragC[i][j], gAddrC + offsetY, ldc);
-            offsetY += blockStepY;
-        }
-        gAddrC += blockStepX;
-    }
-}
+            // Write prefetch to the write stage
+            stamps.stamp(profile::phase_local_write);
+            pipeline.local_write();
 
-// Global D reads for warp tile gemm, non-cooperative
-ROCWMMA_DEVICE static inline void
-    globalWriteD(OutputT* gAddrD, MfmaFragD const (&fragsD)[BLOCKS_X][BLOCKS_Y], uint32_t ldd)
-{
-    using FragShape = GetIOShape_t<MfmaFragD>;
-    using Mapper1d  = GetDataLayout_t<MfmaFragD>;
+            // Shape the schedule of this step before the barrier closes the region
+            KStepSchedPolicy::exec();
 
-    // Iterative offsets for each D block in the warp tile
-    auto blockStepX = Mapper1d::fromMatrixCoord(make_coord2d(FragShape::BlockHeight, 0u), ldd);
-    auto blockStepY = Mapper1d::fromMatrixCoord(make_coord2d(0u, FragShape::BlockWidth), ldd);
+            // Make sure that all waves have finished reading / writing to lds for this step.
+            synchronize_workgroup();
 
-#pragma unroll
-    for(int i = 0; i < BLOCKS_X; i++)
-    {
-        auto offsetY = 0u;
-#pragma unroll
-        for(int j = 0; j < BLOCKS_Y; j++)
-        {
-            store_matrix_sync(gAddrD + offsetY, fragsD[i][j], ldd);
-            offsetY += blockStepY;
+            pipeline.advance();
         }
-        gAddrD += blockStepX;
-    }
-}
 
-// Broadcast value to fragments in warp tile
-template <typename FragT>
-ROCWMMA_DEVICE static inline void fill(FragT (&frags)[BLOCKS_X][BLOCKS_Y],
-                                       GetDataType_t<FragT> value)
-{
-#pragma unroll
-    for(int i = 0; i < BLOCKS_X; i++)
-    {
-#pragma unroll
-        for(int j = 0; j < BLOCKS_Y; j++)
+        ///
+        /// Start loading C
+        ///
+        stamps.stamp(profile::phase_epilogue);
+        if(linearCase == linear_full)
         {
-            fill_fragment(frags[i][j], value);
+            load_matrix_sync(fragsC, c + MfmaFragCMap1d::fromMatrixCoord(warpTileCoord, ldc), ldc);
         }
-    }
-}
 
-// Performs warp tile mfma
-ROCWMMA_DEVICE static inline void mfma(MfmaFragAcc (&fragsAccOut)[BLOCKS_X][BLOCKS_Y],
-                                       MfmaFragA const (&fragsA)[BLOCKS_X],
-                                       MfmaFragB const (&fragsB)[BLOCKS_Y],
-                                       MfmaFragAcc const (&fragsAccIn)[BLOCKS_X][BLOCKS_Y])
-{
-#pragma unroll
-    for(int i = 0; i < BLOCKS_X; i++)
-    {
-#pragma unroll
-        for(int j = 0; j < BLOCKS_Y; j++)
+        ///
+        /// Clean up tail A * B from the remaining stages
+        ///
+        for(uint32_t step = 0u; step < prologueSteps; step++)
         {
-            mma_sync(fragsAccOut[i][j], fragsA[i], fragsB[j], fragsAccIn[i][j]);
+            MfmaTileA fragsA;
+            MfmaTileB fragsB;
+
+            // Local read mfma frags
+            stamps.stamp(profile::phase_local_read);
+            pipeline.local_read_a(fragsA, get<0>(localWarpOffset));
+            pipeline.local_read_b(fragsB, get<1>(localWarpOffset));
+            stamps.stamp(profile::phase_mma);
+            mma_sync(fragsAcc, fragsA, fragsB, fragsAcc);
+
+            pipeline.advance();
         }
     }
-}
-
-// Uniform multiply - add (FMA)
-// Performs D = alpha * acc + beta * C, where alpha, beta are uniform scalars
-ROCWMMA_DEVICE static inline void uniformFma(MfmaFragD (&fragsD)[BLOCKS_X][BLOCKS_Y],
-                                             ComputeT alpha,
-                                             MfmaFragAcc const (&fragsAcc)[BLOCKS_X][BLOCKS_Y],
-                                             ComputeT beta,
-                                             MfmaFragC const (&fragsC)[BLOCKS_X][BLOCKS_Y])
-{
-#pragma unroll
-    for(int i = 0; i < BLOCKS_X; i++)
+    else
     {
-#pragma unroll
-        for(int j = 0; j < BLOCKS_Y; j++)
-        {
-            for(int k = 0; k < fragsD[i][j].num_elements; k++)
+        // The frags of each step are read one step ahead, from the stage written Depth - 2
+        // steps earlier. The barrier after each local write makes that stage visible, and
+        // the stage written next was last read before the previous barrier.
+        auto readStep = [&](MfmaTileA& fragsA, MfmaTileB& fragsB, uint32_t) {
+            // Local read mfma frags from the read stage
+            stamps.stamp(profile::phase_local_read);
+            pipeline.local_read_a(fragsA, get<0>(localWarpOffset));
+            pipeline.local_read_b(fragsB, get<1>(localWarpOffset));
+            pipeline.advance();
+        };
+
+        auto computeStep = [&](MfmaTileA const& fragsA, MfmaTileB const& fragsB, uint32_t step) {
+            auto prefetch = step + prologueSteps < kSteps;
+
+            // Prefetch next round of global frags
+            if(prefetch)
             {
-                // Perform computation in ComputeT and cast back to OutputT
-                fragsD[i][j].x[k] = static_cast<OutputT>(
-                    alpha * fragsAcc[i][j].x[k] + beta * static_cast<ComputeT>(fragsC[i][j].x[k]));
+                stamps.stamp(profile::phase_global_read);
+                pipeline.global_read(a + globalReadOffsetA, lda, b + globalReadOffsetB, ldb);
+
+                // Advance offsets to next k step
+                globalReadOffsetA += kStepOffsetA;
+                globalReadOffsetB += kStepOffsetB;
             }
+
+            // accum(A * B)
+            stamps.stamp(profile::phase_mma);
+            mma_sync(fragsAcc, fragsA, fragsB, fragsAcc);
+
+            if(prefetch)
+            {
+                // Write prefetch to the write stage
+                stamps.stamp(profile::phase_local_write);
+                pipeline.local_write();
+            }
+
+            // Shape the schedule of this step before the barrier closes the region
+            KStepSchedPolicy::exec();
+
+            // Publish the local writes of this step to the workgroup
+            if(prefetch)
+            {
+                synchronize_workgroup();
+            }
+        };
+
+        // With a static K, steps are constants and the prefetch predicates fold away
+        fragment_pipeline<MfmaTileA, MfmaTileB> frags;
+        if constexpr(STATIC_K > 0u)
+        {
+            frags.run<STATIC_K / ROCWMMA_K>(readStep, computeStep);
+        }
+        else
+        {
+            frags.run<K_UNROLL>(kSteps, readStep, computeStep);
         }
-    }
-}
 
-ROCWMMA_KERNEL void __launch_bounds__(256) gemm_rocwmma_d(uint32_t       m,
-                                                          uint32_t       n,
-                                                          uint32_t       k,
-                                                          InputT const*  a,
-                                                          InputT const*  b,
-                                                          OutputT const* c,
-                                                          OutputT*       d,
-                                                          uint32_t       lda,
-                                                          uint32_t       ldb,
-                                                          uint32_t       ldc,
-                                                          uint32_t       ldd,
-                                                          ComputeT       alpha,
-                                                          ComputeT       beta)
-{
-    if constexpr(!ROCWMMA_ARCH_HOST)
-    {
         ///
-        /// 2D matrix coordinate setup
+        /// Start loading C
         ///
+        stamps.stamp(profile::phase_epilogue);
+        if(linearCase == linear_full)
+        {
+            load_matrix_sync(fragsC, c + MfmaFragCMap1d::fromMatrixCoord(warpTileCoord, ldc), ldc);
+        }
+    }
 
-        // Tile Sizes
-        constexpr auto warpTileSize  = make_coord2d(WARP_TILE_X, WARP_TILE_Y);
-        constexpr auto macroTileSize = make_coord2d(MACRO_TILE_X, MACRO_TILE_Y);
+    ///
+    /// D = alpha * accum + beta * C
+    ///
+    stamps.stamp(profile::phase_epilogue);
+    MfmaTileD fragsD;
+    uniformFma(fragsD, linearCase, alpha, fragsAcc, beta, fragsC);
+    store_matrix_sync(d + MfmaFragDMap1d::fromMatrixCoord(warpTileCoord, ldd), fragsD, ldd);
+    stamps.flush();
+}
 
-        // Local warp coordinate relative to current threadblock (wg).
-        constexpr auto warpDims        = make_coord2d(WARPS_X, WARPS_Y);
-        auto           localWarpCoord  = make_coord2d(threadIdx.x / WARP_SIZE, threadIdx.y);
-        auto           localWarpOffset = localWarpCoord * warpTileSize;
+// Computes one macro tile of D = alpha * (A x B) + beta * C with specialized warps.
+// Warps in rows [0, TBLOCK_Y) are consumers, each computing its warp tile as in
+// gemmMacroTile. Warps in rows [TBLOCK_Y, TBLOCK_Y + PRODUCER_ROWS) are producers,
+// streaming the A / B macro tiles of every K step into the LDS stages.
+// Matrix sizes must be multiples of the macro tile size: every consumer must release
+// every stage, or producers would wait forever.
+ROCWMMA_DEVICE static inline void gemmMacroTileWs(Coord2d const& tileCoord,
+                                                  uint32_t       k,
+                                                  InputT const*  a,
+                                                  InputT const*  b,
+                                                  OutputT const* c,
+                                                  OutputT*       d,
+                                                  uint32_t       lda,
+                                                  uint32_t       ldb,
+                                                  uint32_t       ldc,
+                                                  uint32_t       ldd,
+                                                  ComputeT       alpha,
+                                                  ComputeT       beta,
+                                                  InputT*        ldsPtr,
+                                                  uint32_t*      ldsFlags)
+{
+    constexpr auto warpTileSize  = make_coord2d(WARP_TILE_X, WARP_TILE_Y);
+    constexpr auto macroTileSize = make_coord2d(MACRO_TILE_X, MACRO_TILE_Y);
 
-        // Global matrix coordinates for C/D
-        auto macroTileCoord = make_coord2d(blockIdx.x, blockIdx.y) * macroTileSize;
-        auto warpTileCoord  = macroTileCoord + localWarpOffset;
+    auto macroTileCoord = tileCoord * macroTileSize;
+    auto kSteps         = STATIC_K > 0u ? STATIC_K / ROCWMMA_K : k / ROCWMMA_K;
 
-        // Bounds check
-        auto warpTileBound = warpTileCoord + warpTileSize;
-        if(get<0>(warpTileBound) > m || get<1>(warpTileBound) > n)
-        {
-            return;
-        }
+    WsStageBarrier barrier(ldsFlags);
 
+    if(threadIdx.y >= TBLOCK_Y)
+    {
         ///
-        /// 1D global read coordinate setup
+        /// Producer: global read -> wait for a free stage -> local write -> publish
         ///
         using GRBuffAMap1d = GetDataLayout_t<GRBuffA>;
         using GRBuffBMap1d = GetDataLayout_t<GRBuffB>;
 
-        // Initial globa read address offsets
         auto globalReadOffsetA
             = GRBuffAMap1d::fromMatrixCoord(make_coord2d(get<0>(macroTileCoord), 0u), lda);
         auto globalReadOffsetB
             = GRBuffBMap1d::fromMatrixCoord(make_coord2d(0u, get<1>(macroTileCoord)), ldb);
-
-        // Incremental global read address offsets
         auto kStepOffsetA = GRBuffAMap1d::fromMatrixCoord(make_coord2d(0u, ROCWMMA_K), lda);
         auto kStepOffsetB = GRBuffBMap1d::fromMatrixCoord(make_coord2d(ROCWMMA_K, 0u), ldb);
 
-        ///
-        /// Cooperative config for global read A / B
-        ///
-
-        // WorkItems will be split up by minimum IOCount to perform either global read or local write.
-        // These are inputs to cooperative functions.
-        constexpr auto warpCount = get<0>(warpDims) * get<1>(warpDims);
+        auto producerIndex = (threadIdx.y - TBLOCK_Y) * WARPS_X + threadIdx.x / WARP_SIZE;
+        WsLdsPipeline pipeline(ldsPtr, producerIndex);
 
-        // Scheduling warp order is analogous to row major priority.
-        // E.g. Wg = (128, 2) = 2x2 warps
-        // (0, 0)   (0, 1)   Share Schedule: w0 = (0, 0), w1 = (0, 1),
-        // (1, 0)   (1, 1)                   w2 = (1, 0), w3 = (1, 1), count = 4
-        const auto warpIndex = get<0>(localWarpCoord) * get<1>(warpDims) + get<1>(localWarpCoord);
+        for(uint32_t step = 0u; step < kSteps; step++)
+        {
+            // Issue the global reads before waiting, to overlap with the consumers
+            pipeline.global_read(a + globalReadOffsetA, lda, b + globalReadOffsetB, ldb);
+            globalReadOffsetA += kStepOffsetA;
+            globalReadOffsetB += kStepOffsetB;
 
+            barrier.producer_acquire(step);
+            pipeline.local_write();
+            barrier.producer_commit(step);
+        }
+    }
+    else
+    {
         ///
-        /// Perform initial global pre-fetch
+        /// Consumer: wait for a full stage -> local read -> release -> mma
         ///
+        auto localWarpOffset = make_coord2d(threadIdx.x / WARP_SIZE, threadIdx.y) * warpTileSize;
+        auto warpTileCoord   = macroTileCoord + localWarpOffset;
 
-        GRBuffA grBuffA;
-        GRBuffB grBuffB;
+        // Only local reads are used, no global read buffers are live
+        WsLdsPipeline pipeline(ldsPtr, 0u);
 
-        globalReadCoopA<warpCount>(grBuffA, a + globalReadOffsetA, lda, warpIndex);
-        globalReadCoopB<warpCount>(grBuffB, b + globalReadOffsetB, ldb, warpIndex);
+        MfmaTileAcc fragsAcc;
+        fill_fragment(fragsAcc, 0.0f);
 
-        globalReadOffsetA += kStepOffsetA;
-        globalReadOffsetB += kStepOffsetB;
-
-        ///
-        /// Setup LDS addressing
-        /// This kernel will use 2 separate LDS blocks for pipelining
-        /// the input prefetching during the accumulation loop
-        ///
+        for(uint32_t step = 0u; step < kSteps; step++)
+        {
+            MfmaTileA fragsA;
+            MfmaTileB fragsB;
 
-        HIP_DYNAMIC_SHARED(void*, localMemPtr);
-        using LWBuffAShape = GetIOShape_t<LWBuffA>;
-        using LWBuffBShape = GetIOShape_t<LWBuffB>;
-        using LWBuffAMap1d = GetDataLayout_t<LWBuffA>;
-        using LWBuffBMap1d = GetDataLayout_t<LWBuffB>;
-
-        constexpr uint32_t ldsWidth  = ROCWMMA_K;
-        constexpr uint32_t ldsHeight = LWBuffAShape::BlockHeight + LWBuffBShape::BlockHeight;
-        constexpr uint32_t sizeLds   = ldsHeight * ldsWidth;
-        constexpr uint32_t ldsld = std::is_same_v<DataLayoutLds, row_major> ? ldsWidth : ldsHeight;
-
-        auto* ldsPtrLo = reinterpret_cast<InputT*>(localMemPtr);
-        auto* ldsPtrHi = ldsPtrLo + sizeLds;
-
-        // Local write offsets to start of A / B data
-        auto ldsWriteOffsetA = 0u;
-        auto ldsWriteOffsetB
-            = LWBuffAMap1d::fromMatrixCoord(make_coord2d(LWBuffAShape::BlockHeight, 0u), ldsld);
-
-        // Local read offsets for mfma frags
-        auto ldsReadOffsetA
-            = ldsWriteOffsetA
-              + LWBuffAMap1d::fromMatrixCoord(make_coord2d(get<0>(localWarpOffset), 0u), ldsld);
-        auto ldsReadOffsetB
-            = ldsWriteOffsetB
-              + LWBuffBMap1d::fromMatrixCoord(make_coord2d(get<1>(localWarpOffset), 0u), ldsld);
+            barrier.consumer_wait(step);
+            pipeline.local_read_a(fragsA, get<0>(localWarpOffset));
+            pipeline.local_read_b(fragsB, get<1>(localWarpOffset));
+            barrier.consumer_release(step);
 
-        ///
-        /// Write prefetch to local
-        ///
-        localWriteCoopA<warpCount>(ldsPtrLo + ldsWriteOffsetA, grBuffA, ldsld, warpIndex);
-        localWriteCoopB<warpCount>(ldsPtrLo + ldsWriteOffsetB, grBuffB, ldsld, warpIndex);
+            // accum(A * B)
+            mma_sync(fragsAcc, fragsA, fragsB, fragsAcc);
 
-        ///
-        /// Initialize accumulation frags
-        ///
-        MfmaFragAcc fragsAcc[BLOCKS_X][BLOCKS_Y];
-        fill(fragsAcc, 0.0f);
+            pipeline.advance();
+        }
 
         ///
-        /// Synchronize warps and memory
+        /// D = alpha * accum + beta * C
         ///
-        synchronize_workgroup();
+        using MfmaFragCMap1d = GetDataLayout_t<MfmaFragC>;
+        using MfmaFragDMap1d = GetDataLayout_t<MfmaFragD>;
 
-        ///
-        /// Accumulate A * B for all mfma frags in warp tile
-        ///
-        for(uint32_t currentK = ROCWMMA_K; currentK < k; currentK += ROCWMMA_K)
+        // C is only read when beta != 0
+        auto      linearCase = get_linear_combination(alpha, beta);
+        MfmaTileC fragsC;
+        if(linearCase == linear_full)
         {
-            MfmaFragA fragsA[BLOCKS_X];
-            MfmaFragB fragsB[BLOCKS_Y];
-
-            // Local read mfma frags from first LDS buffer
-            localReadA(fragsA, ldsPtrLo + ldsReadOffsetA, ldsld);
-            localReadB(fragsB, ldsPtrLo + ldsReadOffsetB, ldsld);
+            load_matrix_sync(fragsC, c + MfmaFragCMap1d::fromMatrixCoord(warpTileCoord, ldc), ldc);
+        }
 
-            // Prefetch next round of global frags
-            globalReadCoopA<warpCount>(grBuffA, a + globalReadOffsetA, lda, warpIndex);
-            globalReadCoopB<warpCount>(grBuffB, b + globalReadOffsetB, ldb, warpIndex);
+        MfmaTileD fragsD;
+        uniformFma(fragsD, linearCase, alpha, fragsAcc, beta, fragsC);
+        store_matrix_sync(d + MfmaFragDMap1d::fromMatrixCoord(warpTileCoord, ldd), fragsD, ldd);
+    }
+}
 
-            // Advance offsets to next k step
-            globalReadOffsetA += kStepOffsetA;
-            globalReadOffsetB += kStepOffsetB;
+// Data-parallel kernel: one workgroup per macro tile, in the order of RasterPolicy.
+template <typename RasterPolicy>
+ROCWMMA_KERNEL void __launch_bounds__(256) PERF_HGEMM_WAVES_PER_EU
+    gemm_rocwmma_d(uint32_t       m,
+                   uint32_t       n,
+                   uint32_t       k,
+                   InputT const*  a,
+                   InputT const*  b,
+                   OutputT const* c,
+                   OutputT*       d,
+                   uint32_t       lda,
+                   uint32_t       ldb,
+                   uint32_t       ldc,
+                   uint32_t       ldd,
+                   ComputeT       alpha,
+                   ComputeT       beta)
+{
+    if constexpr(!ROCWMMA_ARCH_HOST)
+    {
+        HIP_DYNAMIC_SHARED(void*, localMemPtr);
+        gemmMacroTile(raster_workgroup_coord<RasterPolicy>(),
+                      m,
+                      n,
+                      k,
+                      a,
+                      b,
+                      c,
+                      d,
+                      lda,
+                      ldb,
+                      ldc,
+                      ldd,
+                      alpha,
+                      beta,
+                      reinterpret_cast<InputT*>(localMemPtr));
+    }
+}
 
-            // accum(A * B)
-            mfma(fragsAcc, fragsA, fragsB, fragsAcc);
+// Persistent kernel: a fixed number of workgroups (CUs x occupancy) pull
+// macro tiles from a global atomic work queue until all tiles are consumed.
+// The tile counter must be zero before launch.
+// Matrix sizes must be multiples of the macro tile size, such that all warps
+// in the workgroup participate in every tile.
+ROCWMMA_KERNEL void __launch_bounds__(256) PERF_HGEMM_WAVES_PER_EU
+    gemm_rocwmma_persistent_d(uint32_t       m,
+                              uint32_t       n,
+                              uint32_t       k,
+                              InputT const*  a,
+                              InputT const*  b,
+                              OutputT const* c,
+                              OutputT*       d,
+                              uint32_t       lda,
+                              uint32_t       ldb,
+                              uint32_t       ldc,
+                              uint32_t       ldd,
+                              ComputeT       alpha,
+                              ComputeT       beta,
+                              uint32_t*      tileCounter)
+{
+    if constexpr(!ROCWMMA_ARCH_HOST)
+    {
+        HIP_DYNAMIC_SHARED(void*, localMemPtr);
+        __shared__ uint32_t tileIndex;
 
-            // Write prefetch to second LDS buffer
-            localWriteCoopA<warpCount>(ldsPtrHi + ldsWriteOffsetA, grBuffA, ldsld, warpIndex);
-            localWriteCoopB<warpCount>(ldsPtrHi + ldsWriteOffsetB, grBuffB, ldsld, warpIndex);
+        const auto tilesX    = m / MACRO_TILE_X;
+        const auto tilesY    = n / MACRO_TILE_Y;
+        const auto tileCount = tilesX * tilesY;
 
-            // Make sure that all waves have finished reading / writing to lds for currentK.
+        while(true)
+        {
+            // Dequeue the next tile and broadcast to the workgroup
+            if(threadIdx.x == 0 && threadIdx.y == 0)
+            {
+                tileIndex = atomicAdd(tileCounter, 1u);
+            }
             synchronize_workgroup();
 
-            // Swap Lds buffers
-            auto* tmp = ldsPtrLo;
-            ldsPtrLo  = ldsPtrHi;
-            ldsPtrHi  = tmp;
+            auto currentTile = tileIndex;
+            if(currentTile >= tileCount)
+            {
+                break;
+            }
+
+            gemmMacroTile(TileRaster::tile_coord(currentTile, tilesX, tilesY),
+                          m,
+                          n,
+                          k,
+                          a,
+                          b,
+                          c,
+                          d,
+                          lda,
+                          ldb,
+                          ldc,
+                          ldd,
+                          alpha,
+                          beta,
+                          reinterpret_cast<InputT*>(localMemPtr));
+
+            // Lds buffers and tile index are re-used by the next tile
+            synchronize_workgroup();
         }
+    }
+}
 
-        ///
-        /// Start loading C
-        ///
-        using MfmaFragCMap1d = GetDataLayout_t<MfmaFragC>;
-        using MfmaFragDMap1d = GetDataLayout_t<MfmaFragD>;
+// Wave specialized kernel: one workgroup per macro tile, with PRODUCER_ROWS extra
+// rows of producer warps. The stage counters follow the LDS stages.
+ROCWMMA_KERNEL void __launch_bounds__(512) gemm_rocwmma_ws_d(uint32_t       m,
+                                                             uint32_t       n,
+                                                             uint32_t       k,
+                                                             InputT const*  a,
+                                                             InputT const*  b,
+                                                             OutputT const* c,
+                                                             OutputT*       d,
+                                                             uint32_t       lda,
+                                                             uint32_t       ldb,
+                                                             uint32_t       ldc,
+                                                             uint32_t       ldd,
+                                                             ComputeT       alpha,
+                                                             ComputeT       beta)
+{
+    if constexpr(!ROCWMMA_ARCH_HOST && !LARGE_TILE)
+    {
+        HIP_DYNAMIC_SHARED(void*, localMemPtr);
+        auto* ldsPtr   = reinterpret_cast<InputT*>(localMemPtr);
+        auto* ldsFlags = reinterpret_cast<uint32_t*>(ldsPtr + WsLdsPipeline::depth
+                                                                  * WsLdsPipeline::stage_size);
 
-        MfmaFragC fragsC[BLOCKS_X][BLOCKS_Y];
-        globalReadC(fragsC, c + MfmaFragCMap1d::fromMatrixCoord(warpTileCoord, ldc), ldc);
+        if(threadIdx.x < WARP_SIZE && threadIdx.y == 0u)
+        {
+            WsStageBarrier(ldsFlags).reset();
+        }
+        synchronize_workgroup();
 
-        ///
-        /// Clean up tail A * B
-        ///
-        MfmaFragA fragsA[BLOCKS_X];
-        MfmaFragB fragsB[BLOCKS_Y];
+        gemmMacroTileWs(make_coord2d(blockIdx.x, blockIdx.y),
+                        k,
+                        a,
+                        b,
+                        c,
+                        d,
+                        lda,
+                        ldb,
+                        ldc,
+                        ldd,
+                        alpha,
+                        beta,
+                        ldsPtr,
+                        ldsFlags);
+    }
+}
 
-        // Local read mfma frags
-        localReadA(fragsA, ldsPtrLo + ldsReadOffsetA, ldsld);
-        localReadB(fragsB, ldsPtrLo + ldsReadOffsetB, ldsld);
-        mfma(fragsAcc, fragsA, fragsB, fragsAcc);
+// Modeled L2 footprint of a rasterization policy: the A row panels and B column panels read
+// by the first wave of resident workgroups, averaged over the L2 of each XCD. Workgroup
+// IDs are dispatched round-robin over the XCDs.
+template <typename RasterPolicy>
+ROCWMMA_HOST float64_t rasterFootprintMB(Coord2d  macroTileSize,
+                                         uint32_t tilesX,
+                                         uint32_t tilesY,
+                                         uint32_t k,
+                                         uint32_t workgroups)
+{
+    uint64_t panelBytes = 0u;
+    for(uint32_t x = 0; x < XCD_COUNT; x++)
+    {
+        std::vector<bool> rowsA(tilesX, false);
+        std::vector<bool> colsB(tilesY, false);
+        for(uint32_t i = x; i < std::min(workgroups, tilesX * tilesY); i += XCD_COUNT)
+        {
+            auto tileCoord           = RasterPolicy::tile_coord(i, tilesX, tilesY);
+            rowsA[get<0>(tileCoord)] = true;
+            colsB[get<1>(tileCoord)] = true;
+        }
 
-        ///
-        /// D = alpha * accum + beta * C
-        ///
-        MfmaFragD fragsD[BLOCKS_X][BLOCKS_Y];
-        uniformFma(fragsD, alpha, fragsAcc, beta, fragsC);
-        globalWriteD(d + MfmaFragDMap1d::fromMatrixCoord(warpTileCoord, ldd), fragsD, ldd);
+        panelBytes += std::count(rowsA.begin(), rowsA.end(), true) * get<0>(macroTileSize);
+        panelBytes += std::count(colsB.begin(), colsB.end(), true) * get<1>(macroTileSize);
     }
+
+    return static_cast<float64_t>(panelBytes) * k * sizeof(InputT) / XCD_COUNT / 1.0e6;
 }
 
 ROCWMMA_HOST void gemm_test(uint32_t m, uint32_t n, uint32_t k, ComputeT alpha, ComputeT beta)
 {
-    // Runtime checks for host parameters
-    uint32_t hTBLOCK_X    = isGfx9() ? gfx9Params::TBLOCK_X : gfx11Params::TBLOCK_X;
-    uint32_t hTBLOCK_Y    = isGfx9() ? gfx9Params::TBLOCK_Y : gfx11Params::TBLOCK_Y;
-    uint32_t hBLOCKS_X    = isGfx9() ? gfx9Params::BLOCKS_X : gfx11Params::BLOCKS_X;
-    uint32_t hBLOCKS_Y    = isGfx9() ? gfx9Params::BLOCKS_Y : gfx11Params::BLOCKS_Y;
-    uint32_t hROCWMMA_M   = isGfx9() ? gfx9Params::ROCWMMA_M : gfx11Params::ROCWMMA_M;
-    uint32_t hROCWMMA_N   = isGfx9() ? gfx9Params::ROCWMMA_N : gfx11Params::ROCWMMA_N;
-    uint32_t hROCWMMA_K   = isGfx9() ? gfx9Params::ROCWMMA_K : gfx11Params::ROCWMMA_K;
+    // Runtime checks for host parameters, selected with the same config as the device
+    auto     params       = get_warp_tile_params<InputT>(getGcnArchId());
+    uint32_t hTBLOCK_X    = params.tblock_x;
+    uint32_t hTBLOCK_Y    = params.tblock_y;
+    uint32_t hBLOCKS_X    = params.blocks_x;
+    uint32_t hBLOCKS_Y    = params.blocks_y;
+    uint32_t hROCWMMA_M   = params.block_m;
+    uint32_t hROCWMMA_N   = params.block_n;
+    uint32_t hROCWMMA_K   = params.block_k;
+
+    bool largeTile = ROCWMMA_PERF_HGEMM_LARGE_TILE && isGfx9();
+    if(largeTile)
+    {
+        hBLOCKS_X = LARGE_TILE_BLOCKS;
+        hBLOCKS_Y = LARGE_TILE_BLOCKS;
+    }
+
     uint32_t hWARP_TILE_X = hBLOCKS_X * hROCWMMA_M;
     uint32_t hWARP_TILE_Y = hBLOCKS_Y * hROCWMMA_N;
 
@@ -761,6 +1075,13 @@ ROCWMMA_HOST void gemm_test(uint32_t m, uint32_t n, uint32_t k, ComputeT alpha,
         return;
     }
 
+    // Kernels compiled for a static K only run that K
+    if(STATIC_K > 0u && k != STATIC_K)
+    {
+        std::cout << "Unsupported matrix size: kernels are compiled for K = " << STATIC_K << "\n";
+        return;
+    }
+
     // Layouts leading dims
     int lda = std::is_same_v<DataLayoutA, row_major> ? k : m;
     int ldb = std::is_same_v<DataLayoutB, row_major> ? n : k;
@@ -812,14 +1133,86 @@ ROCWMMA_HOST void gemm_test(uint32_t m, uint32_t n, uint32_t k, ComputeT alpha,
     std::cout << "gridDim (" << gridDim.x << " " << gridDim.y << ")"
               << " blockdim (" << blockDim.x << " " << blockDim.y << ")" << std::endl;
 
-    // Uses 2 lds blocks for prefetch loop (A and B)
-    int ldsusage
-        = 2u * sizeof(InputT) * (get<0>(macroTileSize) + get<1>(macroTileSize)) * hROCWMMA_K;
+    // Uses LDS_PIPELINE_DEPTH lds blocks for prefetch loop (A and B)
+    int ldsusage = LDS_PIPELINE_DEPTH * sizeof(InputT)
+                   * (get<0>(macroTileSize) + get<1>(macroTileSize)) * hROCWMMA_K;
 
     ////
-    auto rocwmmaKernel = [&]() {
-        hipExtLaunchKernelGGL(gemm_rocwmma_d,
+    auto rocwmmaKernel = [&](auto rasterPolicy) {
+        return [&]() {
+            hipExtLaunchKernelGGL((gemm_rocwmma_d<decltype(rasterPolicy)>),
+                                  gridDim,
+                                  blockDim,
+                                  ldsusage,
+                                  0,
+                                  nullptr,
+                                  nullptr,
+                                  0,
+                                  m,
+                                  n,
+                                  k,
+                                  d_a,
+                                  d_b,
+                                  d_c,
+                                  d_d,
+                                  lda,
+                                  ldb,
+                                  ldc,
+                                  ldd,
+                                  alpha,
+                                  beta);
+        };
+    };
+
+    // Persistent kernel requires whole macro tiles
+    bool runPersistent = (m % get<0>(macroTileSize) == 0) && (n % get<1>(macroTileSize) == 0);
+
+    // Persistent kernel launches one wave of workgroups: CUs x occupancy
+    auto occupancy
+        = get_launch_occupancy(gemm_rocwmma_persistent_d, hTBLOCK_X * hTBLOCK_Y, ldsusage);
+
+    auto persistentGridDim = dim3(std::min(occupancy.resident_blocks(), gridDim.x * gridDim.y));
+    std::cout << "Persistent occupancy: " << occupancy.waves_per_simd << "/"
+              << occupancy.max_waves_per_simd << " waves per SIMD, limited by "
+              << occupancy_limiter_name(occupancy.limiter) << std::endl;
+
+    // Wave specialized kernel adds PRODUCER_ROWS rows of producer warps, and the LDS stage
+    // counters after the LDS stages
+    auto wsBlockDim = dim3(hTBLOCK_X, hTBLOCK_Y + PRODUCER_ROWS);
+    int  wsLdsusage = ldsusage + WsStageBarrier::size_bytes;
+
+    auto rocwmmaWsKernel = [&]() {
+        hipExtLaunchKernelGGL(gemm_rocwmma_ws_d,
                               gridDim,
+                              wsBlockDim,
+                              wsLdsusage,
+                              0,
+                              nullptr,
+                              nullptr,
+                              0,
+                              m,
+                              n,
+                              k,
+                              d_a,
+                              d_b,
+                              d_c,
+                              d_d,
+                              lda,
+                              ldb,
+                              ldc,
+                              ldd,
+                              alpha,
+                              beta);
+    };
+
+    // Work queue counter
+    uint32_t* d_tileCounter;
+    CHECK_HIP_ERROR(hipMalloc(&d_tileCounter, sizeof(uint32_t)));
+
+    auto rocwmmaPersistentKernel = [&]() {
+        CHECK_HIP_ERROR(hipMemsetAsync(d_tileCounter, 0, sizeof(uint32_t)));
+        hipExtLaunchKernelGGL(gemm_rocwmma_persistent_d,
+                              persistentGridDim,
                               blockDim,
                               ldsusage,
                               0,
@@ -838,98 +1231,206 @@ ROCWMMA_HOST void gemm_test(uint32_t m, uint32_t n, uint32_t k, ComputeT alpha,
                               ldc,
                               ldd,
                               alpha,
-                              beta);
+                              beta,
+                              d_tileCounter);
     };
 
-    constexpr uint32_t warmups    = 2u;
-    constexpr uint32_t recordRuns = 5u;
+    // Runs are timed individually, with warm and cold caches
+    BenchmarkHarness harness;
 
-    // Warm-up runs, not recorded
-    for(uint32_t i = 0; i < warmups; ++i)
-    {
-        rocwmmaKernel();
-    }
+    // Echo performance
+    auto echo = [&](const char* kernelName, uint32_t workgroups, auto&& kernel) {
+        auto gFlops = calculateGFlops(m, n, k);
 
-    // Actual recorded runs
-    hipEvent_t startEvent, stopEvent;
-    CHECK_HIP_ERROR(hipEventCreate(&startEvent));
-    CHECK_HIP_ERROR(hipEventCreate(&stopEvent));
+        for(auto cacheState :
+            {BenchmarkHarness::CacheState::Warm, BenchmarkHarness::CacheState::Cold})
+        {
+            auto stats        = harness.run(kernel, cacheState);
+            auto tFlopsPerSec = calculateTFlopsPerSec(m, n, k, stats.mMedianMs);
+
+            std::cout << kernelName << ", " << workgroups << ", " << hTBLOCK_X << ", "
+                      << hTBLOCK_Y << ", " << hBLOCKS_X << ", " << hBLOCKS_Y << ", "
+                      << hROCWMMA_M << ", " << hROCWMMA_N << ", " << hROCWMMA_K << ", " << m
+                      << ", " << n << ", " << k << ", " << alpha << ", " << lda << ", " << ldb
+                      << ", " << beta << ", " << ldc << ", " << ldd << ", "
+                      << (cacheState == BenchmarkHarness::CacheState::Warm ? "warm" : "cold")
+                      << ", " << stats.mMedianMs << ", " << gFlops << ", " << tFlopsPerSec
+                      << ", ";
+            BenchmarkHarness::printStats(std::cout, stats) << std::endl;
+
+            if(cacheState == BenchmarkHarness::CacheState::Warm)
+            {
+                PerfGolden::instance().check(
+                    ROCWMMA_PERF_HGEMM_LARGE_TILE ? "perf_hgemm_large_tile" : "perf_hgemm",
+                    kernelName,
+                    hTBLOCK_X,
+                    hTBLOCK_Y,
+                    m,
+                    n,
+                    k,
+                    stats);
+            }
+        }
+    };
 
-    CHECK_HIP_ERROR(hipEventRecord(startEvent));
-    for(uint32_t i = 0; i < recordRuns; ++i)
-    {
-        rocwmmaKernel();
-    }
-    CHECK_HIP_ERROR(hipEventRecord(stopEvent));
-    CHECK_HIP_ERROR(hipEventSynchronize(stopEvent));
+#if !NDEBUG
+
+    // Setup and run reference computation
+    std::vector<OutputT> matrixD_ref(m * n, std::numeric_limits<OutputT>::signaling_NaN());
+    bool                 refComputed = false;
 
-    auto elapsedTimeMs = 0.0f;
-    CHECK_HIP_ERROR(hipEventElapsedTime(&elapsedTimeMs, startEvent, stopEvent));
+    auto validate = [&]() {
+        std::cout << "Validating result with reference..." << std::endl;
 
-    auto gFlops = calculateGFlops(m, n, k);
-    auto tFlopsPerSec
-        = calculateTFlopsPerSec(m, n, k, static_cast<double>(elapsedTimeMs), recordRuns);
+        if(!refComputed)
+        {
+            if((uint64_t)m * (uint64_t)n * (uint64_t)k > (2048ull * 2048ull * 2048ull))
+            {
+                std::cout << "Please wait. Large sizes can take a while!" << std::endl;
+            }
 
-    CHECK_HIP_ERROR(hipEventDestroy(startEvent));
-    CHECK_HIP_ERROR(hipEventDestroy(stopEvent));
+            gemm_cpu_h<InputT, OutputT, ComputeT, DataLayoutA, DataLayoutB, DataLayoutC>(
+                m,
+                n,
+                k,
+                matrixA.data(),
+                matrixB.data(),
+                matrixC.data(),
+                matrixD_ref.data(),
+                lda,
+                ldb,
+                ldc,
+                ldd,
+                alpha,
+                beta);
+            refComputed = true;
+        }
 
-    // Echo performance
-    std::cout << "TBlockX, TBlockY, "
+        // Bring kernel result back to host
+        CHECK_HIP_ERROR(hipMemcpy(matrixD.data(), d_d, bytesD, hipMemcpyDeviceToHost));
+
+        auto res = compareEqual(matrixD.data(), matrixD_ref.data(), m * n);
+
+        if(std::get<0>(res) == false)
+        {
+            std::cout << "FAILED\n";
+        }
+        else
+        {
+            std::cout << "PASSED\n";
+        }
+
+        std::cout << "Max relative error: " << std::get<1>(res) << std::endl;
+    };
+
+#endif // !NDEBUG
+
+    std::cout << "Kernel, Workgroups, "
+              << "TBlockX, TBlockY, "
               << "BlocksX, BlocksY, "
               << "BlkM, BlkN, BlkK, "
               << "MatM, MatN, MatK, "
               << "alpha, lda, ldb, "
               << "beta, ldc, ldd, "
-              << "elapsedMs, Problem Size(GFlops), TFlops/s" << std::endl;
+              << "Cache, elapsedMs, Problem Size(GFlops), TFlops/s, "
+              << BenchmarkHarness::statsHeader() << std::endl;
 
-    std::cout << hTBLOCK_X << ", " << hTBLOCK_Y << ", " << hBLOCKS_X << ", " << hBLOCKS_Y << ", "
-              << hROCWMMA_M << ", " << hROCWMMA_N << ", " << hROCWMMA_K << ", " << m << ", " << n
-              << ", " << k << ", " << alpha << ", " << lda << ", " << ldb << ", " << beta << ", "
-              << ldc << ", " << ldd << ", " << elapsedTimeMs << ", " << gFlops << ", "
-              << tFlopsPerSec << std::endl;
+#if ROCWMMA_PROFILE_STAMPS
+    // Stamp rings for every wave of the data parallel grid, which bounds the persistent grid
+    auto stampBuffer = allocPhaseStamps(
+        gridDim.x * gridDim.y * hTBLOCK_X / warpSize * hTBLOCK_Y, 1024u);
+    profile::set_stamp_buffer(stampBuffer);
+#endif // ROCWMMA_PROFILE_STAMPS
+
+    echo("DataParallel", gridDim.x * gridDim.y, rocwmmaKernel(raster::linear{}));
+
+#if ROCWMMA_PROFILE_STAMPS
+    reportPhaseStamps(stampBuffer);
+#endif // ROCWMMA_PROFILE_STAMPS
 
 #if !NDEBUG
+    validate();
+#endif // !NDEBUG
 
-    std::cout << "Validating result with reference..." << std::endl;
+    // Data-parallel kernel in each rasterization order, with the modeled L2 footprint of
+    // the first wave of resident workgroups
+    auto echoRaster = [&](const char* kernelName, auto rasterPolicy) {
+        auto footprint = rasterFootprintMB<decltype(rasterPolicy)>(
+            macroTileSize, gridDim.x, gridDim.y, k, persistentGridDim.x);
+        std::cout << kernelName << " modeled L2 footprint per XCD (MB): " << footprint
+                  << std::endl;
 
-    if((uint64_t)m * (uint64_t)n * (uint64_t)k > (2048ull * 2048ull * 2048ull))
-    {
-        std::cout << "Please wait. Large sizes can take a while!" << std::endl;
-    }
+        // Fill outputs with NaN to catch contamination
+        CHECK_HIP_ERROR(hipMemset(d_d, 0xFF, bytesD));
 
-    // Bring kernel result back to host
-    CHECK_HIP_ERROR(hipMemcpy(matrixD.data(), d_d, bytesD, hipMemcpyDeviceToHost));
+        echo(kernelName, gridDim.x * gridDim.y, rocwmmaKernel(rasterPolicy));
 
-    // Setup and run reference computation
-    std::vector<OutputT> matrixD_ref(m * n, std::numeric_limits<OutputT>::signaling_NaN());
-    gemm_cpu_h<InputT, OutputT, ComputeT, DataLayoutA, DataLayoutB, DataLayoutC>(m,
-                                                                                 n,
-                                                                                 k,
-                                                                                 matrixA.data(),
-                                                                                 matrixB.data(),
-                                                                                 matrixC.data(),
-                                                                                 matrixD_ref.data(),
-                                                                                 lda,
-                                                                                 ldb,
-                                                                                 ldc,
-                                                                                 ldd,
-                                                                                 alpha,
-                                                                                 beta);
-
-    auto res = compareEqual(matrixD.data(), matrixD_ref.data(), m * n);
-
-    if(std::get<0>(res) == false)
+#if !NDEBUG
+        validate();
+#endif // !NDEBUG
+    };
+
+    std::cout << "DataParallel modeled L2 footprint per XCD (MB): "
+              << rasterFootprintMB<raster::linear>(
+                     macroTileSize, gridDim.x, gridDim.y, k, persistentGridDim.x)
+              << std::endl;
+
+    echoRaster("DataParallelGrouped", raster::grouped<TILE_SWIZZLE>{});
+    echoRaster("DataParallelMorton", raster::morton<RASTER_ORDER>{});
+    echoRaster("DataParallelHilbert", raster::hilbert<RASTER_ORDER>{});
+    echoRaster("DataParallelXcd", raster::xcd<XCD_COUNT, raster::grouped<TILE_SWIZZLE>>{});
+
+    if(runPersistent)
     {
-        std::cout << "FAILED\n";
+        // Fill outputs with NaN to catch contamination
+        CHECK_HIP_ERROR(hipMemset(d_d, 0xFF, bytesD));
+
+        echo("Persistent", persistentGridDim.x, rocwmmaPersistentKernel);
+
+#if ROCWMMA_PROFILE_STAMPS
+        reportPhaseStamps(stampBuffer);
+#endif // ROCWMMA_PROFILE_STAMPS
+
+#if !NDEBUG
+        validate();
+#endif // !NDEBUG
     }
     else
     {
-        std::cout << "PASSED\n";
+        std::cout << "Persistent kernel skipped: matrix size must be a multiple of macro tile size"
+                  << std::endl;
     }
 
-    std::cout << "Max relative error: " << std::get<1>(res) << std::endl;
+    // Wave specialized kernel also requires whole macro tiles
+    if(largeTile)
+    {
+        std::cout << "WaveSpecialized kernel skipped: large tiles need one wave per SIMD"
+                  << std::endl;
+    }
+    else if(runPersistent)
+    {
+        // Fill outputs with NaN to catch contamination
+        CHECK_HIP_ERROR(hipMemset(d_d, 0xFF, bytesD));
 
+        echo("WaveSpecialized", gridDim.x * gridDim.y, rocwmmaWsKernel);
+
+#if !NDEBUG
+        validate();
 #endif // !NDEBUG
+    }
+    else
+    {
+        std::cout << "WaveSpecialized kernel skipped: matrix size must be a multiple of macro "
+                     "tile size"
+                  << std::endl;
+    }
+
+    CHECK_HIP_ERROR(hipFree(d_tileCounter));
+
+#if ROCWMMA_PROFILE_STAMPS
+    profile::set_stamp_buffer(profile::stamp_buffer{});
+    freePhaseStamps(stampBuffer);
+#endif // ROCWMMA_PROFILE_STAMPS
 
     // Release device memory
     CHECK_HIP_ERROR(hipFree(d_a));
@@ -943,5 +1444,11 @@ ROCWMMA_HOST void gemm_test(uint32_t m, uint32_t n, uint32_t k, ComputeT alpha,
 int main()
 {
     gemm_test(7168, 7168, 7168, 2, 2);
-    return 0;
+
+#if NDEBUG
+    // Large square problem, where the A / B panels of a linear raster overflow L2
+    gemm_test(16384, 16384, 16384, 2, 2);
+#endif // NDEBUG
+
+    return PerfGolden::instance().status();
 }
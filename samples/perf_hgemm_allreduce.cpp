@@ -0,0 +1,713 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_fp16.h>
+#include <hip/hip_runtime.h>
+
+#include <rocwmma/rocwmma.hpp>
+#include <rocwmma/rocwmma_epilogue.hpp>
+
+#include "common.hpp"
+
+using rocwmma::accumulator;
+using rocwmma::col_major;
+using rocwmma::float16_t;
+using rocwmma::float32_t;
+using rocwmma::float64_t;
+using rocwmma::matrix_a;
+using rocwmma::matrix_b;
+using rocwmma::row_major;
+
+/* Motivation
+*
+* A row-parallel tensor parallel layer splits K across the G GPUs of a node.
+* Each device holds A[:, Kg] and B[Kg, :] and computes a partial product
+* Pg = A[:, Kg] x B[Kg, :] of the full M x N output:
+*
+*     D = alpha * (P0 + P1 + ... + PG-1) + beta * C, on every device
+*
+* Frameworks commonly run the GEMM, then an all-reduce of the partials. The
+* interconnect idles during the GEMM, and the CUs idle during the all-reduce.
+*
+* This sample fuses the communication into the GEMM epilogue with the
+* rocwmma::epilogue::PeerStore policy. Each wave stores its partial tile
+* directly into slot g of the staging buffer of every peer over
+* peer-to-peer (XGMI on MI300X), then sets a per-tile flag on each peer:
+*
+*      GPU g, wave tile t:  mma_sync ... | store Pg(t) -> staging[g] of each peer
+*                                        | flag[g][t] = epoch on each peer
+*
+* A reduce kernel follows the GEMM on each device. Each wave waits for the
+* flags of its tile from all G slots, sums the staged partials and applies
+* the alpha / beta epilogue. Its GEMM has completed by then, so tiles that
+* peers have already published are reduced while the slower peers are still
+* computing the remaining tiles. Peer GEMMs never wait, which guarantees the
+* reduce kernels make progress.
+*
+* The benchmark runs 1, 2, 4 and 8 GPUs, as available, and for each count
+* reports:
+* - Compute: the partial GEMM alone, without the all-reduce
+* - Serial:  the partial GEMM, then peer copies of the partials, then the
+*            reduction, separated by host synchronization
+* - Fused:   the PeerStore epilogue with flag-based reduction
+*
+* Note: Staging buffers are reused by the next invocation, so invocations
+* are separated by a host synchronization of the group. Double buffering the
+* staging slots by epoch would remove this.
+* Note: Staging buffers and flags are written by peers and read by spinning
+* waves, so they are allocated fine-grained.
+* Note: Timing uses the host clock, because no single device event covers
+* work on all devices.
+*/
+
+// Supports ROCWMMA_M/N square sizes of
+// : 16 x 16
+// : 32 x 32 ( only MI )
+const int ROCWMMA_M = 16;
+const int ROCWMMA_N = 16;
+
+// Supports ROCWMMA_K sizes as
+// : multiples of 16.
+const int ROCWMMA_K = 16;
+
+// Each wave computes BLOCKS_X x BLOCKS_Y fragments of output, reusing each
+// A fragment across BLOCKS_Y and each B fragment across BLOCKS_X.
+const int BLOCKS_X    = 2;
+const int BLOCKS_Y    = 2;
+const int WAVE_TILE_M = BLOCKS_X * ROCWMMA_M;
+const int WAVE_TILE_N = BLOCKS_Y * ROCWMMA_N;
+
+// Device warp size
+const uint32_t WAVE_SIZE = getWarpSize();
+
+// Thread block
+// : T_BLOCK_X must be multiple of WAVE_SIZE.
+const int T_BLOCK_X = 4 * WAVE_SIZE;
+const int T_BLOCK_Y = 4;
+
+// Upper bound on the scaling benchmark
+const int MAX_GPUS = 8;
+
+// Benchmark runs
+const uint32_t WARMUP_RUNS = 2u;
+const uint32_t TIMED_RUNS  = 10u;
+
+// Partials are staged in the accumulator type
+using PartialT   = float32_t;
+using PeerStoreT = rocwmma::epilogue::PeerStore<PartialT, MAX_GPUS>;
+
+using FragA = rocwmma::fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, row_major>;
+using FragB = rocwmma::fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, col_major>;
+using FragC = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t>;
+using FragAcc = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, PartialT>;
+
+// Register blocked partial GEMM over one K slice, Pg = A[:, Kg] x B[Kg, :].
+// Each wave computes a WAVE_TILE_M x WAVE_TILE_N tile, stores it to slot rank
+// of every peer's staging buffer and signals flag [rank][tile] of each peer.
+//
+// : A is in row-major format     (M x K)
+// : B is in col-major format     (K x N)
+// : Staging slots are in row-major format (M x N)
+__global__ void hgemm_partial_d(uint32_t         m,
+                                uint32_t         n,
+                                uint32_t         k,
+                                float16_t const* a,
+                                float16_t const* b,
+                                uint32_t         lda,
+                                uint32_t         ldb,
+                                PeerStoreT       peers,
+                                uint32_t         rank,
+                                uint32_t         epoch)
+{
+    // Tile using a 2D grid
+    auto majorWarp = (blockIdx.x * blockDim.x + threadIdx.x) / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    auto minorWarp = (blockIdx.y * blockDim.y + threadIdx.y);
+
+    // Target tile
+    auto cRow = majorWarp * WAVE_TILE_M;
+    auto cCol = minorWarp * WAVE_TILE_N;
+
+    // Bounds check
+    if(cRow < m && cCol < n)
+    {
+        FragAcc fragsAcc[BLOCKS_X][BLOCKS_Y];
+        for(int i = 0; i < BLOCKS_X; ++i)
+        {
+            for(int j = 0; j < BLOCKS_Y; ++j)
+            {
+                rocwmma::fill_fragment(fragsAcc[i][j], 0.0f);
+            }
+        }
+
+        // fragsAcc = A x B
+        for(int h = 0; h < k; h += ROCWMMA_K)
+        {
+            FragA fragsA[BLOCKS_X];
+            FragB fragsB[BLOCKS_Y];
+
+            for(int i = 0; i < BLOCKS_X; ++i)
+            {
+                rocwmma::load_matrix_sync(fragsA[i], a + ((cRow + i * ROCWMMA_M) * lda + h), lda);
+            }
+            for(int j = 0; j < BLOCKS_Y; ++j)
+            {
+                rocwmma::load_matrix_sync(fragsB[j], b + (h + (cCol + j * ROCWMMA_N) * ldb), ldb);
+            }
+
+            for(int i = 0; i < BLOCKS_X; ++i)
+            {
+                for(int j = 0; j < BLOCKS_Y; ++j)
+                {
+                    rocwmma::mma_sync(fragsAcc[i][j], fragsA[i], fragsB[j], fragsAcc[i][j]);
+                }
+            }
+        }
+
+        // Write the partial tile straight into the peers' staging slot of this rank
+        auto slotOffset = static_cast<uint64_t>(rank) * m * n;
+        for(int i = 0; i < BLOCKS_X; ++i)
+        {
+            for(int j = 0; j < BLOCKS_Y; ++j)
+            {
+                auto offset = slotOffset + static_cast<uint64_t>(cRow + i * ROCWMMA_M) * n
+                              + (cCol + j * ROCWMMA_N);
+                peers.store(fragsAcc[i][j], offset, n, rocwmma::mem_row_major);
+            }
+        }
+
+        auto tiles   = (m / WAVE_TILE_M) * (n / WAVE_TILE_N);
+        auto tileIdx = (cRow / WAVE_TILE_M) * (n / WAVE_TILE_N) + cCol / WAVE_TILE_N;
+        peers.signal(rank * tiles + tileIdx, epoch);
+    }
+}
+
+// Reduces the staged partials of peerCount ranks tile by tile, as their flags
+// arrive, and computes D = alpha * sum(Pg) + beta * C.
+//
+// : C, D are in row-major format (M x N)
+__global__ void hgemm_reduce_d(uint32_t         m,
+                               uint32_t         n,
+                               PartialT const*  staging,
+                               uint32_t const*  flags,
+                               float16_t const* c,
+                               float16_t*       d,
+                               uint32_t         ldc,
+                               uint32_t         ldd,
+                               float32_t        alpha,
+                               float32_t        beta,
+                               uint32_t         peerCount,
+                               uint32_t         epoch)
+{
+    // Tile using a 2D grid
+    auto majorWarp = (blockIdx.x * blockDim.x + threadIdx.x) / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    auto minorWarp = (blockIdx.y * blockDim.y + threadIdx.y);
+
+    // Target tile
+    auto cRow = majorWarp * WAVE_TILE_M;
+    auto cCol = minorWarp * WAVE_TILE_N;
+
+    // Bounds check
+    if(cRow < m && cCol < n)
+    {
+        FragAcc fragsSum[BLOCKS_X][BLOCKS_Y];
+        for(int i = 0; i < BLOCKS_X; ++i)
+        {
+            for(int j = 0; j < BLOCKS_Y; ++j)
+            {
+                rocwmma::fill_fragment(fragsSum[i][j], 0.0f);
+            }
+        }
+
+        auto tiles   = (m / WAVE_TILE_M) * (n / WAVE_TILE_N);
+        auto tileIdx = (cRow / WAVE_TILE_M) * (n / WAVE_TILE_N) + cCol / WAVE_TILE_N;
+
+        for(uint32_t src = 0; src < peerCount; ++src)
+        {
+            PeerStoreT::wait(flags + src * tiles + tileIdx, epoch);
+
+            auto slotOffset = static_cast<uint64_t>(src) * m * n;
+            for(int i = 0; i < BLOCKS_X; ++i)
+            {
+                for(int j = 0; j < BLOCKS_Y; ++j)
+                {
+                    auto offset = slotOffset + static_cast<uint64_t>(cRow + i * ROCWMMA_M) * n
+                                  + (cCol + j * ROCWMMA_N);
+
+                    FragAcc fragP;
+                    rocwmma::load_matrix_sync(fragP, staging + offset, n, rocwmma::mem_row_major);
+                    for(int e = 0; e < fragP.num_elements; ++e)
+                    {
+                        fragsSum[i][j].x[e] += fragP.x[e];
+                    }
+                }
+            }
+        }
+
+        // D = alpha * sum(Pg) + beta * C
+        for(int i = 0; i < BLOCKS_X; ++i)
+        {
+            for(int j = 0; j < BLOCKS_Y; ++j)
+            {
+                auto  offsetRow = cRow + i * ROCWMMA_M;
+                auto  offsetCol = cCol + j * ROCWMMA_N;
+                FragC fragC, fragD;
+
+                rocwmma::load_matrix_sync(
+                    fragC, c + (offsetRow * ldc + offsetCol), ldc, rocwmma::mem_row_major);
+                rocwmma::apply_epilogue(
+                    fragD,
+                    fragsSum[i][j],
+                    rocwmma::epilogue::LinearCombination<float32_t, FragC>(alpha, beta, fragC));
+                rocwmma::store_matrix_sync(
+                    d + (offsetRow * ldd + offsetCol), fragD, ldd, rocwmma::mem_row_major);
+            }
+        }
+    }
+}
+
+// Per device resources. Every device holds full copies of A, B and C, and
+// indexes its K slice in place. Staging holds MAX_GPUS partial slots and
+// flags holds one flag per wave tile per slot.
+struct DeviceContext
+{
+    int                      mDevice;
+    hipStream_t              mComputeStream;
+    std::vector<hipStream_t> mCopyStreams; // One per peer
+
+    float16_t* mA;
+    float16_t* mB;
+    float16_t* mC;
+    float16_t* mD;
+    PartialT*  mStaging;
+    uint32_t*  mFlags;
+};
+
+enum class PipelineMode
+{
+    Compute,
+    Serial,
+    Fused
+};
+
+inline char const* pipelineModeString(PipelineMode mode)
+{
+    switch(mode)
+    {
+    case PipelineMode::Compute:
+        return "Compute";
+    case PipelineMode::Serial:
+        return "Serial";
+    case PipelineMode::Fused:
+    default:
+        return "Fused";
+    }
+}
+
+inline bool enablePeerAccess(int gpus)
+{
+    for(int dev = 0; dev < gpus; ++dev)
+    {
+        for(int peer = 0; peer < gpus; ++peer)
+        {
+            if(dev == peer)
+            {
+                continue;
+            }
+
+            int canAccess = 0;
+            CHECK_HIP_ERROR(hipDeviceCanAccessPeer(&canAccess, dev, peer));
+            if(!canAccess)
+            {
+                return false;
+            }
+
+            CHECK_HIP_ERROR(hipSetDevice(dev));
+            auto status = hipDeviceEnablePeerAccess(peer, 0);
+            if(status == hipErrorPeerAccessAlreadyEnabled)
+            {
+                // Clear the sticky error
+                (void)hipGetLastError();
+            }
+            else
+            {
+                CHECK_HIP_ERROR(status);
+            }
+        }
+    }
+    return true;
+}
+
+__host__ void synchronizeAll(std::vector<DeviceContext>& contexts, int gpus)
+{
+    for(int dev = 0; dev < gpus; ++dev)
+    {
+        CHECK_HIP_ERROR(hipSetDevice(contexts[dev].mDevice));
+        CHECK_HIP_ERROR(hipDeviceSynchronize());
+    }
+}
+
+// Runs the row-parallel GEMM and all-reduce of D on the first gpus devices
+__host__ void runTensorParallel(std::vector<DeviceContext>& contexts,
+                                int                         gpus,
+                                PipelineMode                mode,
+                                uint32_t                    epoch,
+                                uint32_t                    m,
+                                uint32_t                    n,
+                                uint32_t                    k,
+                                float32_t                   alpha,
+                                float32_t                   beta)
+{
+    auto kSlice    = k / static_cast<uint32_t>(gpus);
+    auto lda       = k;
+    auto ldb       = k;
+    auto ldc       = n;
+    auto ldd       = n;
+    auto tiles     = (m / WAVE_TILE_M) * (n / WAVE_TILE_N);
+    auto slotBytes = static_cast<size_t>(m) * n * sizeof(PartialT);
+    auto flagBytes = tiles * sizeof(uint32_t);
+
+    auto blockDim = dim3(T_BLOCK_X, T_BLOCK_Y);
+    auto gridDim  = dim3(rocwmma::ceilDiv(m, WAVE_TILE_M * T_BLOCK_X / WAVE_SIZE),
+                        rocwmma::ceilDiv(n, WAVE_TILE_N * T_BLOCK_Y));
+
+    // Partial GEMMs. Fused mode publishes to every peer, otherwise only locally.
+    for(int dev = 0; dev < gpus; ++dev)
+    {
+        auto& ctx  = contexts[dev];
+        auto  rank = static_cast<uint32_t>(dev);
+        CHECK_HIP_ERROR(hipSetDevice(ctx.mDevice));
+
+        PeerStoreT peers;
+        peers.mPeerCount = (mode == PipelineMode::Fused) ? gpus : 1u;
+        for(uint32_t i = 0; i < peers.mPeerCount; ++i)
+        {
+            auto& dst         = (mode == PipelineMode::Fused) ? contexts[i] : ctx;
+            peers.mBuffers[i] = dst.mStaging;
+            peers.mFlags[i]   = dst.mFlags;
+        }
+
+        hipExtLaunchKernelGGL(hgemm_partial_d,
+                              gridDim,
+                              blockDim,
+                              0, // sharedMemBytes
+                              ctx.mComputeStream, // stream
+                              nullptr, // Event start
+                              nullptr, // event stop
+                              0, // flags
+                              m,
+                              n,
+                              kSlice,
+                              ctx.mA + rank * kSlice,
+                              ctx.mB + rank * kSlice,
+                              lda,
+                              ldb,
+                              peers,
+                              rank,
+                              epoch);
+    }
+
+    if(mode == PipelineMode::Compute)
+    {
+        return;
+    }
+
+    // Host orchestrated all-reduce: gather every partial slot and its flags into each peer
+    if(mode == PipelineMode::Serial)
+    {
+        synchronizeAll(contexts, gpus);
+        for(int dev = 0; dev < gpus; ++dev)
+        {
+            auto& ctx  = contexts[dev];
+            auto  rank = static_cast<uint32_t>(dev);
+            CHECK_HIP_ERROR(hipSetDevice(ctx.mDevice));
+
+            for(int peer = 0; peer < gpus; ++peer)
+            {
+                if(peer == dev)
+                {
+                    continue;
+                }
+
+                auto& dst        = contexts[peer];
+                auto  copyStream = ctx.mCopyStreams[peer];
+                auto  slotOffset = static_cast<size_t>(rank) * m * n;
+                auto  flagOffset = rank * tiles;
+                CHECK_HIP_ERROR(hipMemcpyPeerAsync(dst.mStaging + slotOffset,
+                                                   dst.mDevice,
+                                                   ctx.mStaging + slotOffset,
+                                                   ctx.mDevice,
+                                                   slotBytes,
+                                                   copyStream));
+                CHECK_HIP_ERROR(hipMemcpyPeerAsync(dst.mFlags + flagOffset,
+                                                   dst.mDevice,
+                                                   ctx.mFlags + flagOffset,
+                                                   ctx.mDevice,
+                                                   flagBytes,
+                                                   copyStream));
+            }
+        }
+        synchronizeAll(contexts, gpus);
+    }
+
+    for(int dev = 0; dev < gpus; ++dev)
+    {
+        auto& ctx = contexts[dev];
+        CHECK_HIP_ERROR(hipSetDevice(ctx.mDevice));
+
+        hipExtLaunchKernelGGL(hgemm_reduce_d,
+                              gridDim,
+                              blockDim,
+                              0, // sharedMemBytes
+                              ctx.mComputeStream, // stream
+                              nullptr, // Event start
+                              nullptr, // event stop
+                              0, // flags
+                              m,
+                              n,
+                              ctx.mStaging,
+                              ctx.mFlags,
+                              ctx.mC,
+                              ctx.mD,
+                              ldc,
+                              ldd,
+                              alpha,
+                              beta,
+                              static_cast<uint32_t>(gpus),
+                              epoch);
+    }
+}
+
+__host__ void gemm_test(uint32_t m, uint32_t n, uint32_t k, float32_t alpha, float32_t beta)
+{
+    int deviceCount = 0;
+    CHECK_HIP_ERROR(hipGetDeviceCount(&deviceCount));
+    auto maxGpus = std::min(deviceCount, MAX_GPUS);
+
+    // Bounds check
+    if((m % WAVE_TILE_M) || (n % WAVE_TILE_N) || (k % ROCWMMA_K))
+    {
+        std::cout << "Unsupported size!\n";
+        return;
+    }
+
+    std::cout << "Initializing host data..." << std::endl;
+
+    // Initialize input matrices
+    std::vector<float16_t> matrixA(m * k);
+    std::vector<float16_t> matrixB(k * n);
+    std::vector<float16_t> matrixC(m * n);
+
+    fillRand(matrixA.data(), m, k);
+    fillRand(matrixB.data(), k, n);
+    fillRand(matrixC.data(), m, n);
+
+    std::cout << "Initializing device data on " << maxGpus << " device(s)..." << std::endl;
+
+    const size_t bytesA       = matrixA.size() * sizeof(float16_t);
+    const size_t bytesB       = matrixB.size() * sizeof(float16_t);
+    const size_t bytesC       = matrixC.size() * sizeof(float16_t);
+    const size_t bytesD       = matrixC.size() * sizeof(float16_t);
+    const size_t tiles        = (m / WAVE_TILE_M) * (n / WAVE_TILE_N);
+    const size_t bytesStaging = static_cast<size_t>(maxGpus) * m * n * sizeof(PartialT);
+    const size_t bytesFlags   = maxGpus * tiles * sizeof(uint32_t);
+
+    std::vector<DeviceContext> contexts(maxGpus);
+    for(int dev = 0; dev < maxGpus; ++dev)
+    {
+        auto& ctx   = contexts[dev];
+        ctx.mDevice = dev;
+        CHECK_HIP_ERROR(hipSetDevice(dev));
+
+        CHECK_HIP_ERROR(hipStreamCreateWithFlags(&ctx.mComputeStream, hipStreamNonBlocking));
+        ctx.mCopyStreams.resize(maxGpus);
+        for(auto& stream : ctx.mCopyStreams)
+        {
+            CHECK_HIP_ERROR(hipStreamCreateWithFlags(&stream, hipStreamNonBlocking));
+        }
+
+        CHECK_HIP_ERROR(hipMalloc(&ctx.mA, bytesA));
+        CHECK_HIP_ERROR(hipMalloc(&ctx.mB, bytesB));
+        CHECK_HIP_ERROR(hipMalloc(&ctx.mC, bytesC));
+        CHECK_HIP_ERROR(hipMalloc(&ctx.mD, bytesD));
+        CHECK_HIP_ERROR(
+            hipExtMallocWithFlags((void**)&ctx.mStaging, bytesStaging, hipDeviceMallocFinegrained));
+        CHECK_HIP_ERROR(
+            hipExtMallocWithFlags((void**)&ctx.mFlags, bytesFlags, hipDeviceMallocFinegrained));
+
+        CHECK_HIP_ERROR(hipMemcpy(ctx.mA, matrixA.data(), bytesA, hipMemcpyHostToDevice));
+        CHECK_HIP_ERROR(hipMemcpy(ctx.mB, matrixB.data(), bytesB, hipMemcpyHostToDevice));
+        CHECK_HIP_ERROR(hipMemcpy(ctx.mC, matrixC.data(), bytesC, hipMemcpyHostToDevice));
+        CHECK_HIP_ERROR(hipMemset(ctx.mFlags, 0, bytesFlags));
+    }
+
+    std::cout << "GPUs, Mode, "
+              << "MatM, MatN, MatK, "
+              << "SliceK, "
+              << "elapsedMs(median), Problem Size(GFlops), TFlops/s, "
+              << "Speedup, Scaling Efficiency(%)" << std::endl;
+
+    // Flags only ever compare against the latest epoch, so they are never reset
+    uint32_t epoch = 0u;
+    auto     run   = [&](int gpus, PipelineMode mode) {
+        runTensorParallel(contexts, gpus, mode, ++epoch, m, n, k, alpha, beta);
+        synchronizeAll(contexts, gpus);
+    };
+
+    // Speedup is relative to the single device run of the same mode
+    auto gFlops       = calculateGFlops(m, n, k);
+    auto baselineMs   = std::vector<double>(3u, 0.0);
+    auto validateGpus = 0;
+
+    for(int gpus = 1; gpus <= maxGpus; gpus *= 2)
+    {
+        // Every slice must be a whole number of blocks
+        if(k % (gpus * ROCWMMA_K))
+        {
+            std::cout << gpus << " GPUs skipped: K is not divisible into slices" << std::endl;
+            break;
+        }
+
+        if(!enablePeerAccess(gpus))
+        {
+            std::cout << gpus << " GPUs skipped: peer access unavailable" << std::endl;
+            break;
+        }
+
+        for(auto mode : {PipelineMode::Compute, PipelineMode::Serial, PipelineMode::Fused})
+        {
+            for(uint32_t i = 0; i < WARMUP_RUNS; ++i)
+            {
+                run(gpus, mode);
+            }
+
+            std::vector<double> runTimesMs(TIMED_RUNS);
+            for(auto& runTimeMs : runTimesMs)
+            {
+                auto start = std::chrono::steady_clock::now();
+                run(gpus, mode);
+                auto stop = std::chrono::steady_clock::now();
+
+                runTimeMs = std::chrono::duration<double, std::milli>(stop - start).count();
+            }
+            std::sort(runTimesMs.begin(), runTimesMs.end());
+
+            auto elapsedMs    = runTimesMs[runTimesMs.size() / 2u];
+            auto tFlopsPerSec = gFlops / elapsedMs;
+            auto modeIdx      = static_cast<uint32_t>(mode);
+            if(gpus == 1)
+            {
+                baselineMs[modeIdx] = elapsedMs;
+            }
+
+            auto speedup = baselineMs[modeIdx] / elapsedMs;
+
+            std::cout << gpus << ", " << pipelineModeString(mode) << ", " << m << ", " << n << ", "
+                      << k << ", " << k / gpus << ", " << elapsedMs << ", " << gFlops << ", "
+                      << tFlopsPerSec << ", " << speedup << ", " << speedup / gpus * 100.0
+                      << std::endl;
+        }
+
+        validateGpus = gpus;
+    }
+
+#if !NDEBUG
+
+    std::cout << "Validating result with reference..." << std::endl;
+
+    // All-reduce D on every device, then check every copy
+    for(int dev = 0; dev < validateGpus; ++dev)
+    {
+        CHECK_HIP_ERROR(hipSetDevice(dev));
+        CHECK_HIP_ERROR(hipMemset(contexts[dev].mD, 0xFF, bytesD));
+    }
+    synchronizeAll(contexts, validateGpus);
+    run(validateGpus, PipelineMode::Fused);
+
+    int lda = k;
+    int ldb = k;
+    int ldc = n;
+    int ldd = ldc;
+
+    // Setup and run reference computation
+    std::vector<float16_t> matrixD_ref(m * n, std::numeric_limits<float16_t>::signaling_NaN());
+    gemm_cpu_h<float16_t, float16_t, float32_t, row_major, col_major, row_major>(m,
+                                                                                 n,
+                                                                                 k,
+                                                                                 matrixA.data(),
+                                                                                 matrixB.data(),
+                                                                                 matrixC.data(),
+                                                                                 matrixD_ref.data(),
+                                                                                 lda,
+                                                                                 ldb,
+                                                                                 ldc,
+                                                                                 ldd,
+                                                                                 alpha,
+                                                                                 beta);
+
+    std::vector<float16_t> matrixD(m * n);
+    for(int dev = 0; dev < validateGpus; ++dev)
+    {
+        CHECK_HIP_ERROR(hipSetDevice(dev));
+        CHECK_HIP_ERROR(hipMemcpy(matrixD.data(), contexts[dev].mD, bytesD, hipMemcpyDeviceToHost));
+
+        auto res = compareEqual<float16_t>(matrixD.data(), matrixD_ref.data(), m * n);
+
+        std::cout << "Device " << dev << ": " << (std::get<0>(res) ? "PASSED" : "FAILED")
+                  << ", max relative error: " << std::get<1>(res) << std::endl;
+    }
+
+#endif // !NDEBUG
+
+    // Release device resources
+    for(auto& ctx : contexts)
+    {
+        CHECK_HIP_ERROR(hipSetDevice(ctx.mDevice));
+        CHECK_HIP_ERROR(hipFree(ctx.mA));
+        CHECK_HIP_ERROR(hipFree(ctx.mB));
+        CHECK_HIP_ERROR(hipFree(ctx.mC));
+        CHECK_HIP_ERROR(hipFree(ctx.mD));
+        CHECK_HIP_ERROR(hipFree(ctx.mStaging));
+        CHECK_HIP_ERROR(hipFree(ctx.mFlags));
+        for(auto& stream : ctx.mCopyStreams)
+        {
+            CHECK_HIP_ERROR(hipStreamDestroy(stream));
+        }
+        CHECK_HIP_ERROR(hipStreamDestroy(ctx.mComputeStream));
+    }
+
+    std::cout << "Finished!" << std::endl;
+}
+
+int main()
+{
+    gemm_test(4096, 4096, 8192, 2.1f, 2.1f);
+    return 0;
+}
@@ -0,0 +1,656 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <iostream>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_fp16.h>
+#include <hip/hip_runtime.h>
+
+#include <rocwmma/rocwmma.hpp>
+#include <rocwmma/rocwmma_epilogue.hpp>
+#include <rocwmma/rocwmma_pipeline.hpp>
+#include <rocwmma/rocwmma_tile.hpp>
+
+#include "benchmark_harness.hpp"
+#include "common.hpp"
+
+/* Motivation
+*
+* The backward pass of a linear layer Y = X x W + b computes three gradients from the
+* output gradient dY:
+*
+* dX = dY x W^T    (dgrad, M x Din)
+* dW = X^T x dY    (wgrad, Din x Dout)
+* db = colsum(dY)  (bias gradient, Dout)
+*
+* X  = input tokens of M x Din, row major (M = token count)
+* W  = weights of Din x Dout, row major
+* dY = output gradient of M x Dout, row major
+*
+* Transposed operands are never materialized. A row major matrix read as its transpose is
+* the col major matrix of the same memory, so each GEMM only selects the DataLayout tags of
+* its fragments:
+*
+*   dgrad: A = dY (row_major, ld = Dout), B = W^T (col_major, ld = Dout)
+*   wgrad: A = X^T (col_major, ld = Din), B = dY  (row_major, ld = Dout)
+*
+* The unfused bias gradient is a separate column sum kernel, which reads dY from memory a
+* second time after wgrad. In the fused wgrad kernel, dY is the B operand streamed along the
+* token dimension K, and the column sum is accumulated from the same B fragments:
+*
+*   db tile += ones x dY tile
+*
+* is a single extra mma per B fragment, computed by the warps in the first row of the grid,
+* which own all columns of dW between them. Every row of the db accumulator holds the column
+* sums, and the first row is stored. dY is read from memory once for both dW and db.
+*
+* Flow of the fused wgrad per workgroup:
+*
+*       Start
+*         |
+*   Pre-Fetch Global X^T, dY for K0; store LDS stage 0
+*         |
+*   loop --> Local read X^T, dY frags
+*   |         |
+*   |    Fetch Global X^T, dY for K + 1; accum dW += X^T x dY
+*   |         |
+*   |    (first grid row) accum db += ones x dY
+*   |         |
+*   |    Store LDS stage K + 1
+*   |         |
+*   end_loop <-
+*         |
+*   Write dW (and db)
+*         |
+*         v
+*        End
+*/
+
+using namespace rocwmma;
+
+///
+/// Types
+///
+
+using InputT   = float16_t;
+using OutputT  = float16_t;
+using ComputeT = float32_t;
+
+using DataLayoutD = row_major;
+
+///
+/// Parameter configuration
+///
+
+// Validated defaults of rocwmma::warp_tile_config for InputT and the target being compiled.
+// The host selects the same ones at runtime with get_warp_tile_params.
+using WarpTileConfig = warp_tile_config_t<InputT>;
+
+enum kernelParams : uint32_t
+{
+    ROCWMMA_M = WarpTileConfig::block_m,
+    ROCWMMA_N = WarpTileConfig::block_n,
+    ROCWMMA_K = WarpTileConfig::block_k,
+    BLOCKS_X  = WarpTileConfig::blocks_x,
+    BLOCKS_Y  = WarpTileConfig::blocks_y,
+    TBLOCK_X  = WarpTileConfig::tblock_x,
+    TBLOCK_Y  = WarpTileConfig::tblock_y,
+    WARP_SIZE = WarpTileConfig::wave_size
+};
+
+using DataLayoutLds = WarpTileConfig::lds_layout;
+
+// Warp tile: computed by each warp
+constexpr uint32_t WARP_TILE_X = BLOCKS_X * ROCWMMA_M;
+constexpr uint32_t WARP_TILE_Y = BLOCKS_Y * ROCWMMA_N;
+
+// Macro Tile: computed by each thread block (workgroup)
+constexpr uint32_t WARPS_X      = TBLOCK_X / WARP_SIZE;
+constexpr uint32_t WARPS_Y      = TBLOCK_Y;
+constexpr uint32_t MACRO_TILE_X = WARPS_X * WARP_TILE_X;
+constexpr uint32_t MACRO_TILE_Y = WARPS_Y * WARP_TILE_Y;
+
+// Unfused column sum kernel
+constexpr uint32_t COLSUM_TBLOCK = 256u;
+
+// Mfma frags, in the data layouts of the operands
+template <typename DataLayoutA>
+using MfmaFragA = fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, InputT, DataLayoutA>;
+template <typename DataLayoutB>
+using MfmaFragB = fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, InputT, DataLayoutB>;
+
+using MfmaFragD   = fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, OutputT, DataLayoutD>;
+using MfmaFragAcc = fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, ComputeT>;
+
+// Warp tile of mfma frags
+template <typename DataLayoutA>
+using MfmaTileA = fragment_array<MfmaFragA<DataLayoutA>, BLOCKS_X, 1u>;
+template <typename DataLayoutB>
+using MfmaTileB = fragment_array<MfmaFragB<DataLayoutB>, 1u, BLOCKS_Y>;
+
+using MfmaTileD   = fragment_array<MfmaFragD, BLOCKS_X, BLOCKS_Y>;
+using MfmaTileAcc = fragment_array<MfmaFragAcc, BLOCKS_X, BLOCKS_Y>;
+using MfmaTileDb  = fragment_array<MfmaFragAcc, 1u, BLOCKS_Y>;
+
+// Global read (macro tile)
+template <typename DataLayoutA>
+using GRBuffA = fragment<matrix_a, MACRO_TILE_X, ROCWMMA_N, ROCWMMA_K, InputT, DataLayoutA>;
+template <typename DataLayoutB>
+using GRBuffB = fragment<matrix_b, ROCWMMA_M, MACRO_TILE_Y, ROCWMMA_K, InputT, DataLayoutB>;
+
+// Double buffered LDS staging of the global buffers (macro tile)
+template <typename DataLayoutA, typename DataLayoutB>
+using LdsPipeline = lds_pipeline<2u,
+                                 WARPS_X * WARPS_Y,
+                                 GRBuffA<DataLayoutA>,
+                                 GRBuffB<DataLayoutB>,
+                                 DataLayoutLds,
+                                 lds_access>;
+
+// Computes one macro tile of D = A x B, where tileCoord is the 2D index of the macro tile in
+// D and the layouts of A and B select their transposition. With BiasGrad, also computes
+// db = colsum(B) over K into db, from the first row of macro tiles.
+// Matrix sizes must be multiples of the macro tile size.
+template <typename DataLayoutA, typename DataLayoutB, bool BiasGrad>
+ROCWMMA_DEVICE static inline void gemmBackwardMacroTile(Coord2d const& tileCoord,
+                                                        uint32_t       k,
+                                                        InputT const*  a,
+                                                        InputT const*  b,
+                                                        OutputT*       d,
+                                                        ComputeT*      db,
+                                                        uint32_t       lda,
+                                                        uint32_t       ldb,
+                                                        uint32_t       ldd,
+                                                        InputT*        ldsPtr)
+{
+    using Pipeline = LdsPipeline<DataLayoutA, DataLayoutB>;
+    using TileA    = MfmaTileA<DataLayoutA>;
+    using TileB    = MfmaTileB<DataLayoutB>;
+
+    // Tile Sizes
+    constexpr auto warpTileSize  = make_coord2d(WARP_TILE_X, WARP_TILE_Y);
+    constexpr auto macroTileSize = make_coord2d(MACRO_TILE_X, MACRO_TILE_Y);
+
+    // Local warp coordinate relative to current threadblock (wg).
+    auto localWarpCoord  = make_coord2d(threadIdx.x / WARP_SIZE, threadIdx.y);
+    auto localWarpOffset = localWarpCoord * warpTileSize;
+
+    // Global matrix coordinates for D
+    auto macroTileCoord = tileCoord * macroTileSize;
+    auto warpTileCoord  = macroTileCoord + localWarpOffset;
+
+    // The first row of warps in the grid covers every column of D once
+    const bool reduceBias = BiasGrad && get<0>(warpTileCoord) == 0u;
+
+    ///
+    /// 1D global read coordinate setup
+    ///
+    using GRBuffAMap1d = GetDataLayout_t<GRBuffA<DataLayoutA>>;
+    using GRBuffBMap1d = GetDataLayout_t<GRBuffB<DataLayoutB>>;
+
+    auto globalReadOffsetA
+        = GRBuffAMap1d::fromMatrixCoord(make_coord2d(get<0>(macroTileCoord), 0u), lda);
+    auto globalReadOffsetB
+        = GRBuffBMap1d::fromMatrixCoord(make_coord2d(0u, get<1>(macroTileCoord)), ldb);
+
+    auto kStepOffsetA = GRBuffAMap1d::fromMatrixCoord(make_coord2d(0u, ROCWMMA_K), lda);
+    auto kStepOffsetB = GRBuffBMap1d::fromMatrixCoord(make_coord2d(ROCWMMA_K, 0u), ldb);
+
+    // Warps cooperate in row major order
+    const auto warpIndex = get<0>(localWarpCoord) * WARPS_Y + get<1>(localWarpCoord);
+
+    Pipeline pipeline(ldsPtr, warpIndex);
+
+    ///
+    /// Perform initial global pre-fetch and write to local
+    ///
+    pipeline.global_read(a + globalReadOffsetA, lda, b + globalReadOffsetB, ldb);
+    globalReadOffsetA += kStepOffsetA;
+    globalReadOffsetB += kStepOffsetB;
+    pipeline.local_write();
+
+    ///
+    /// Initialize accumulation frags
+    ///
+    MfmaTileAcc fragsAcc;
+    fill_fragment(fragsAcc, 0.0f);
+
+    // Column sums of B, and the ones that multiply B into them
+    MfmaTileDb           fragsDb;
+    MfmaFragA<col_major> fragOnes;
+    if constexpr(BiasGrad)
+    {
+        fill_fragment(fragsDb, 0.0f);
+        fill_fragment(fragOnes, static_cast<InputT>(1.0f));
+    }
+
+    synchronize_workgroup();
+
+    auto localReadMma = [&]() {
+        TileA fragsA;
+        TileB fragsB;
+        pipeline.local_read_a(fragsA, get<0>(localWarpOffset));
+        pipeline.local_read_b(fragsB, get<1>(localWarpOffset));
+
+        mma_sync(fragsAcc, fragsA, fragsB, fragsAcc);
+
+        if constexpr(BiasGrad)
+        {
+            if(reduceBias)
+            {
+#pragma unroll
+                for(uint32_t j = 0u; j < BLOCKS_Y; j++)
+                {
+                    mma_sync(fragsDb(0u, j), fragOnes, fragsB(0u, j), fragsDb(0u, j));
+                }
+            }
+        }
+    };
+
+    auto kSteps = k / ROCWMMA_K;
+    for(uint32_t step = 1u; step < kSteps; step++)
+    {
+        // Prefetch next round of global frags, then accumulate the read stage
+        pipeline.global_read(a + globalReadOffsetA, lda, b + globalReadOffsetB, ldb);
+        globalReadOffsetA += kStepOffsetA;
+        globalReadOffsetB += kStepOffsetB;
+
+        localReadMma();
+
+        // Write prefetch to the write stage
+        pipeline.local_write();
+
+        // Make sure that all waves have finished reading / writing to lds for this step.
+        synchronize_workgroup();
+
+        pipeline.advance();
+    }
+
+    // Tail A * B
+    localReadMma();
+
+    ///
+    /// D = acc
+    ///
+    MfmaTileD fragsD;
+#pragma unroll
+    for(uint32_t i = 0u; i < BLOCKS_X; i++)
+    {
+#pragma unroll
+        for(uint32_t j = 0u; j < BLOCKS_Y; j++)
+        {
+            apply_epilogue(fragsD(i, j), fragsAcc(i, j));
+        }
+    }
+
+    using MfmaFragDMap1d = GetDataLayout_t<MfmaFragD>;
+    store_matrix_sync(d + MfmaFragDMap1d::fromMatrixCoord(warpTileCoord, ldd), fragsD, ldd);
+
+    ///
+    /// db = first row of the column sums
+    ///
+    if constexpr(BiasGrad)
+    {
+        if(reduceBias)
+        {
+#pragma unroll
+            for(uint32_t j = 0u; j < BLOCKS_Y; j++)
+            {
+                store_matrix_bounded_sync(db + get<1>(warpTileCoord) + j * ROCWMMA_N,
+                                          fragsDb(0u, j),
+                                          ROCWMMA_N,
+                                          1u,
+                                          ROCWMMA_N,
+                                          mem_row_major);
+            }
+        }
+    }
+}
+
+template <typename DataLayoutA, typename DataLayoutB, bool BiasGrad>
+ROCWMMA_KERNEL void __launch_bounds__(256) gemm_backward_rocwmma_d(uint32_t      k,
+                                                                   InputT const* a,
+                                                                   InputT const* b,
+                                                                   OutputT*      d,
+                                                                   ComputeT*     db,
+                                                                   uint32_t      lda,
+                                                                   uint32_t      ldb,
+                                                                   uint32_t      ldd)
+{
+    if constexpr(!ROCWMMA_ARCH_HOST)
+    {
+        HIP_DYNAMIC_SHARED(void*, localMemPtr);
+        gemmBackwardMacroTile<DataLayoutA, DataLayoutB, BiasGrad>(
+            make_coord2d(blockIdx.x, blockIdx.y),
+            k,
+            a,
+            b,
+            d,
+            db,
+            lda,
+            ldb,
+            ldd,
+            reinterpret_cast<InputT*>(localMemPtr));
+    }
+}
+
+// Unfused bias gradient: db = colsum(dY) of the m x n row major dY.
+// Each thread sums one column, such that each row is read coalesced.
+ROCWMMA_KERNEL void __launch_bounds__(COLSUM_TBLOCK)
+    colsum_d(uint32_t m, uint32_t n, InputT const* dy, uint32_t lddy, ComputeT* db)
+{
+    auto col = blockIdx.x * COLSUM_TBLOCK + threadIdx.x;
+    if(col < n)
+    {
+        ComputeT sum = 0.0f;
+        for(uint32_t row = 0u; row < m; row++)
+        {
+            sum += static_cast<ComputeT>(dy[row * lddy + col]);
+        }
+        db[col] = sum;
+    }
+}
+
+ROCWMMA_HOST void backward_test(uint32_t m, uint32_t din, uint32_t dout)
+{
+    // Runtime checks for host parameters, selected with the same config as the device
+    auto     params       = get_warp_tile_params<InputT>(getGcnArchId());
+    uint32_t hTBLOCK_X    = params.tblock_x;
+    uint32_t hTBLOCK_Y    = params.tblock_y;
+    uint32_t hROCWMMA_K   = params.block_k;
+    uint32_t hWARP_TILE_X = params.blocks_x * params.block_m;
+    uint32_t hWARP_TILE_Y = params.blocks_y * params.block_n;
+
+    // Runtime warp calculation (host code needs to query warpsize dynamically)
+    auto warpSize = getWarpSize();
+    auto macroTileSize
+        = make_coord2d(hTBLOCK_X / warpSize * hWARP_TILE_X, hTBLOCK_Y * hWARP_TILE_Y);
+
+    if(warpSize != params.wave_size)
+    {
+        std::cout << "Unsupported wave size!\n";
+        return;
+    }
+
+    // Bounds check: whole macro tiles in each GEMM. M is the K of wgrad, Dout the K of dgrad.
+    auto wholeTiles = [&](uint32_t rows, uint32_t cols, uint32_t depth) {
+        return rows % get<0>(macroTileSize) == 0 && cols % get<1>(macroTileSize) == 0
+               && depth % hROCWMMA_K == 0;
+    };
+
+    if(!wholeTiles(m, din, dout) || !wholeTiles(din, dout, m))
+    {
+        std::cout << "Unsupported matrix size!\n";
+        return;
+    }
+
+    std::cout << "Initializing host data..." << std::endl;
+
+    // All matrices are row major
+    std::vector<InputT> matrixX(m * din);
+    std::vector<InputT> matrixW(din * dout);
+    std::vector<InputT> matrixDy(m * dout);
+
+    // Fill outputs with NaN to catch contamination
+    std::vector<OutputT>  matrixDx(m * din, std::numeric_limits<OutputT>::signaling_NaN());
+    std::vector<OutputT>  matrixDw(din * dout, std::numeric_limits<OutputT>::signaling_NaN());
+    std::vector<ComputeT> vectorDb(dout, std::numeric_limits<ComputeT>::signaling_NaN());
+
+    fillRand(matrixX.data(), m, din);
+    fillRand(matrixW.data(), din, dout);
+    fillRand(matrixDy.data(), m, dout);
+
+    std::cout << "Initializing device data..." << std::endl;
+
+    InputT*   d_x;
+    InputT*   d_w;
+    InputT*   d_dy;
+    OutputT*  d_dx;
+    OutputT*  d_dw;
+    ComputeT* d_db;
+
+    const size_t bytesX  = matrixX.size() * sizeof(InputT);
+    const size_t bytesW  = matrixW.size() * sizeof(InputT);
+    const size_t bytesDy = matrixDy.size() * sizeof(InputT);
+    const size_t bytesDx = matrixDx.size() * sizeof(OutputT);
+    const size_t bytesDw = matrixDw.size() * sizeof(OutputT);
+    const size_t bytesDb = vectorDb.size() * sizeof(ComputeT);
+
+    CHECK_HIP_ERROR(hipMalloc(&d_x, bytesX));
+    CHECK_HIP_ERROR(hipMalloc(&d_w, bytesW));
+    CHECK_HIP_ERROR(hipMalloc(&d_dy, bytesDy));
+    CHECK_HIP_ERROR(hipMalloc(&d_dx, bytesDx));
+    CHECK_HIP_ERROR(hipMalloc(&d_dw, bytesDw));
+    CHECK_HIP_ERROR(hipMalloc(&d_db, bytesDb));
+
+    CHECK_HIP_ERROR(hipMemcpy(d_x, matrixX.data(), bytesX, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_w, matrixW.data(), bytesW, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_dy, matrixDy.data(), bytesDy, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_dx, matrixDx.data(), bytesDx, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_dw, matrixDw.data(), bytesDw, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_db, vectorDb.data(), bytesDb, hipMemcpyHostToDevice));
+
+    auto blockDim = dim3(hTBLOCK_X, hTBLOCK_Y);
+    auto gridDim  = [&](uint32_t rows, uint32_t cols) {
+        return dim3(rows / get<0>(macroTileSize), cols / get<1>(macroTileSize));
+    };
+
+    // LDS stages of A and B
+    uint32_t ldsusage = 2u * sizeof(InputT) * (get<0>(macroTileSize) + get<1>(macroTileSize))
+                        * hROCWMMA_K;
+
+    // dX = dY x W^T: A = dY row major, B = W^T col major
+    auto dgradKernel = [&]() {
+        hipExtLaunchKernelGGL((gemm_backward_rocwmma_d<row_major, col_major, false>),
+                              gridDim(m, din),
+                              blockDim,
+                              ldsusage,
+                              0,
+                              nullptr,
+                              nullptr,
+                              0,
+                              dout,
+                              d_dy,
+                              d_w,
+                              d_dx,
+                              nullptr,
+                              dout,
+                              dout,
+                              din);
+    };
+
+    // dW = X^T x dY: A = X^T col major, B = dY row major
+    auto wgradKernel = [&](auto biasGrad) {
+        constexpr bool BiasGrad = decltype(biasGrad)::value;
+        hipExtLaunchKernelGGL((gemm_backward_rocwmma_d<col_major, row_major, BiasGrad>),
+                              gridDim(din, dout),
+                              blockDim,
+                              ldsusage,
+                              0,
+                              nullptr,
+                              nullptr,
+                              0,
+                              m,
+                              d_x,
+                              d_dy,
+                              d_dw,
+                              d_db,
+                              din,
+                              dout,
+                              dout);
+    };
+
+    auto unfusedKernel = [&]() {
+        wgradKernel(std::false_type{});
+        hipExtLaunchKernelGGL(colsum_d,
+                              dim3(ceilDiv(dout, COLSUM_TBLOCK)),
+                              dim3(COLSUM_TBLOCK),
+                              0,
+                              0,
+                              nullptr,
+                              nullptr,
+                              0,
+                              m,
+                              dout,
+                              d_dy,
+                              dout,
+                              d_db);
+    };
+
+    auto fusedKernel = [&]() { wgradKernel(std::true_type{}); };
+
+    // Runs are timed individually, with warm and cold caches
+    BenchmarkHarness harness;
+
+    auto echo = [&](const char* kernelName,
+                    uint32_t    gm,
+                    uint32_t    gn,
+                    uint32_t    gk,
+                    auto&&      kernel) {
+        auto gFlops = calculateGFlops(gm, gn, gk);
+
+        for(auto cacheState :
+            {BenchmarkHarness::CacheState::Warm, BenchmarkHarness::CacheState::Cold})
+        {
+            auto stats        = harness.run(kernel, cacheState);
+            auto tFlopsPerSec = calculateTFlopsPerSec(gm, gn, gk, stats.mMedianMs);
+
+            std::cout << kernelName << ", " << hTBLOCK_X << ", " << hTBLOCK_Y << ", "
+                      << params.blocks_x << ", " << params.blocks_y << ", " << params.block_m
+                      << ", " << params.block_n << ", " << hROCWMMA_K << ", " << gm << ", "
+                      << gn << ", " << gk << ", "
+                      << (cacheState == BenchmarkHarness::CacheState::Warm ? "warm" : "cold")
+                      << ", " << stats.mMedianMs << ", " << gFlops << ", " << tFlopsPerSec
+                      << ", ";
+            BenchmarkHarness::printStats(std::cout, stats) << std::endl;
+        }
+    };
+
+#if !NDEBUG
+
+    // Reference gradients, with the transposed operands selected by layout
+    std::vector<OutputT>  matrixDx_ref(m * din);
+    std::vector<OutputT>  matrixDw_ref(din * dout);
+    std::vector<ComputeT> vectorDb_ref(dout, 0.0f);
+
+    gemm_cpu_h<InputT, OutputT, ComputeT, row_major, col_major, DataLayoutD>(m,
+                                                                             din,
+                                                                             dout,
+                                                                             matrixDy.data(),
+                                                                             matrixW.data(),
+                                                                             matrixDx_ref.data(),
+                                                                             matrixDx_ref.data(),
+                                                                             dout,
+                                                                             dout,
+                                                                             din,
+                                                                             din,
+                                                                             1.0f,
+                                                                             0.0f);
+
+    gemm_cpu_h<InputT, OutputT, ComputeT, col_major, row_major, DataLayoutD>(din,
+                                                                             dout,
+                                                                             m,
+                                                                             matrixX.data(),
+                                                                             matrixDy.data(),
+                                                                             matrixDw_ref.data(),
+                                                                             matrixDw_ref.data(),
+                                                                             din,
+                                                                             dout,
+                                                                             dout,
+                                                                             dout,
+                                                                             1.0f,
+                                                                             0.0f);
+
+    for(uint32_t row = 0u; row < m; row++)
+    {
+        for(uint32_t col = 0u; col < dout; col++)
+        {
+            vectorDb_ref[col] += static_cast<ComputeT>(matrixDy[row * dout + col]);
+        }
+    }
+
+    auto validate = [&](const char* name, auto* dPtr, auto& result, auto const& reference) {
+        CHECK_HIP_ERROR(hipMemcpy(result.data(),
+                                  dPtr,
+                                  result.size() * sizeof(result[0]),
+                                  hipMemcpyDeviceToHost));
+
+        auto res = compareEqual(result.data(), reference.data(), result.size());
+
+        std::cout << name << ": " << (std::get<0>(res) ? "PASSED" : "FAILED") << std::endl;
+        std::cout << "Max relative error: " << std::get<1>(res) << std::endl;
+    };
+
+#endif // !NDEBUG
+
+    std::cout << "Kernel, TBlockX, TBlockY, BlocksX, BlocksY, BlkM, BlkN, BlkK, "
+              << "MatM, MatN, MatK, Cache, elapsedMs, Problem Size(GFlops), TFlops/s, "
+              << BenchmarkHarness::statsHeader() << std::endl;
+
+    echo("Dgrad", m, din, dout, dgradKernel);
+
+#if !NDEBUG
+    validate("dX", d_dx, matrixDx, matrixDx_ref);
+#endif // !NDEBUG
+
+    echo("WgradColsum", din, dout, m, unfusedKernel);
+
+#if !NDEBUG
+    validate("dW", d_dw, matrixDw, matrixDw_ref);
+    validate("db", d_db, vectorDb, vectorDb_ref);
+#endif // !NDEBUG
+
+    // Fill outputs with NaN to catch contamination
+    CHECK_HIP_ERROR(hipMemset(d_dw, 0xFF, bytesDw));
+    CHECK_HIP_ERROR(hipMemset(d_db, 0xFF, bytesDb));
+
+    echo("WgradFusedBias", din, dout, m, fusedKernel);
+
+#if !NDEBUG
+    validate("dW", d_dw, matrixDw, matrixDw_ref);
+    validate("db", d_db, vectorDb, vectorDb_ref);
+#endif // !NDEBUG
+
+    // Release device memory
+    CHECK_HIP_ERROR(hipFree(d_x));
+    CHECK_HIP_ERROR(hipFree(d_w));
+    CHECK_HIP_ERROR(hipFree(d_dy));
+    CHECK_HIP_ERROR(hipFree(d_dx));
+    CHECK_HIP_ERROR(hipFree(d_dw));
+    CHECK_HIP_ERROR(hipFree(d_db));
+
+    std::cout << "Finished!" << std::endl;
+}
+
+int main()
+{
+    // Tokens x model dimension of a transformer projection, square and up projection
+    backward_test(8192, 4096, 4096);
+    backward_test(8192, 4096, 11008);
+
+    return 0;
+}
@@ -0,0 +1,673 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_fp16.h>
+#include <hip/hip_runtime.h>
+
+#include <rocwmma/rocwmma.hpp>
+#include <rocwmma/rocwmma_coop.hpp>
+#include <rocwmma/rocwmma_epilogue.hpp>
+#include <rocwmma/rocwmma_pipeline.hpp>
+#include <rocwmma/rocwmma_tile.hpp>
+
+#include "benchmark_harness.hpp"
+#include "common.hpp"
+
+/* Motivation
+*
+* Pruned weights and structured-sparse attention masks produce matrices whose zeros come in
+* whole blocks. Stored densely, a GEMM on such a matrix spends most of its K loop multiplying
+* zero blocks. This sample computes
+*
+* D = alpha * (A x B) + beta * C
+*
+* where A is block-sparse and stored in the Block Sparse Row (BSR) format, and B, C and D
+* are dense. Work then scales with the number of nonzero blocks of A instead of M x K.
+*
+* The kernel is the data-parallel perf_hgemm kernel: each workgroup computes one macro tile
+* of D, staging the A and B inputs of each K step through a rocwmma::lds_pipeline. The only
+* difference is the K loop: instead of stepping through every BlockK step of K, the
+* workgroup steps through the nonzero K blocks listed for its row of A.
+*
+* BSR block size
+*
+* All waves of the workgroup share the A macro tile of a K step in LDS, so they must all
+* visit the same K blocks. The BSR block is therefore one macro tile high and one BlockK
+* step wide (MACRO_TILE_X x ROCWMMA_K). A block row of A is the row panel of one
+* workgroup, and its nonzero K blocks are the K steps of that workgroup.
+*
+* BSR layout of A (MACRO_TILE_X x ROCWMMA_K blocks):
+*
+*             K blocks:   0    1    2    3
+*                       ____ ____ ____ ____
+*   Block row 0        | A0 |    | A1 |    |    rowPtr = [0, 2, 2, 5]
+*                      |____|____|____|____|    colIdx = [0, 2,  0, 1, 3]
+*   Block row 1        |    |    |    |    |    values = [A0, A1, A2, A3, A4]
+*                      |____|____|____|____|
+*   Block row 2        | A2 | A3 |    | A4 |
+*                      |____|____|____|____|
+*
+* - rowPtr[i] .. rowPtr[i + 1] are the nonzero blocks of block row i
+* - colIdx[j] is the K block index of nonzero block j
+* - values[j] is nonzero block j, stored col-major with a leading dimension of MACRO_TILE_X
+*
+* The nonzero blocks of a workgroup are contiguous in values, so the global reads of A
+* stream one dense panel. Block rows without any nonzero block compute D = beta * C.
+*
+* The same kernel is run on a fully dense BSR matrix as the baseline, such that the speedup
+* of the sparse kernel only comes from the skipped blocks.
+*/
+
+using namespace rocwmma;
+
+///
+/// Parameter configuration
+///
+
+/* Depending on the GPU architecture this sample is run on, the following kernel parameters need to
+*  be modified in order to obtain high performance.
+* _________________________________________________________________________________________
+*|         |           |           |           |          |          |          |          |
+*|         | ROCWMMA_M | ROCWMMA_N | ROCWMMA_K | BLOCKS_X | BLOCKS_Y | TBLOCK_X | TBLOCK_Y |
+*|_________|___________|___________|___________|__________|__________|__________|__________|
+*|         |           |           |           |          |          |          |          |
+*|  GFX_9  |    32     |    32     |    16     |    2     |    2     |   128    |    2     |
+*|_________|___________|___________|___________|__________|__________|__________|__________|
+*|         |           |           |           |          |          |          |          |
+*|  GFX_11 |    16     |    16     |    16     |    4     |    2     |    64    |    4     |
+*|_________|___________|___________|___________|__________|__________|__________|__________|
+*/
+
+namespace gfx9Params
+{
+    enum kernelParams : uint32_t
+    {
+        ROCWMMA_M = 32u,
+        ROCWMMA_N = 32u,
+        ROCWMMA_K = 16u,
+        BLOCKS_X  = 2u,
+        BLOCKS_Y  = 2u,
+        TBLOCK_X  = 128u,
+        TBLOCK_Y  = 2u,
+        WARP_SIZE = Constants::AMDGCN_WAVE_SIZE_64
+    };
+}
+
+namespace gfx11Params
+{
+    enum kernelParams : uint32_t
+    {
+        ROCWMMA_M = 16u,
+        ROCWMMA_N = 16u,
+        ROCWMMA_K = 16u,
+        BLOCKS_X  = 4u,
+        BLOCKS_Y  = 2u,
+        TBLOCK_X  = 64u,
+        TBLOCK_Y  = 4u,
+        WARP_SIZE = Constants::AMDGCN_WAVE_SIZE_32
+    };
+}
+
+#if(ROCWMMA_ARCH_GFX9)
+using namespace gfx9Params;
+#else
+using namespace gfx11Params;
+#endif // defined(ROCWMMA_ARCH_GFX9)
+
+///
+/// Types and Data Layouts
+///
+
+using InputT   = float16_t;
+using OutputT  = float16_t;
+using ComputeT = float32_t;
+
+// BSR blocks of A are col-major
+using DataLayoutA   = col_major;
+using DataLayoutB   = row_major;
+using DataLayoutC   = row_major;
+using DataLayoutLds = col_major;
+
+// Number of LDS stages in the K loop
+constexpr uint32_t LDS_PIPELINE_DEPTH = 2u;
+
+///
+/// Fragment types
+///
+
+// Warp tile: computed by each warp
+constexpr uint32_t WARP_TILE_X = BLOCKS_X * ROCWMMA_M;
+constexpr uint32_t WARP_TILE_Y = BLOCKS_Y * ROCWMMA_N;
+
+// Macro Tile: computed by each thread block (workgroup)
+// Note: TBLOCK_X must be multiple of WARP_SIZE.
+constexpr uint32_t WARPS_X      = TBLOCK_X / WARP_SIZE;
+constexpr uint32_t WARPS_Y      = TBLOCK_Y;
+constexpr uint32_t MACRO_TILE_X = WARPS_X * WARP_TILE_X;
+constexpr uint32_t MACRO_TILE_Y = WARPS_Y * WARP_TILE_Y;
+
+// Mfma frags
+using MfmaFragA   = fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, InputT, DataLayoutA>;
+using MfmaFragB   = fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, InputT, DataLayoutB>;
+using MfmaFragC   = fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, OutputT, DataLayoutC>;
+using MfmaFragD   = MfmaFragC;
+using MfmaFragAcc = fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, ComputeT>;
+
+// Warp tile of mfma frags
+using MfmaTileA   = fragment_array<MfmaFragA, BLOCKS_X, 1u>;
+using MfmaTileB   = fragment_array<MfmaFragB, 1u, BLOCKS_Y>;
+using MfmaTileC   = fragment_array<MfmaFragC, BLOCKS_X, BLOCKS_Y>;
+using MfmaTileD   = MfmaTileC;
+using MfmaTileAcc = fragment_array<MfmaFragAcc, BLOCKS_X, BLOCKS_Y>;
+
+// Global read (macro tile). The A macro tile of a K step is one BSR block.
+using GRBuffA = fragment<matrix_a, MACRO_TILE_X, ROCWMMA_N, ROCWMMA_K, InputT, DataLayoutA>;
+using GRBuffB = fragment<matrix_b, ROCWMMA_M, MACRO_TILE_Y, ROCWMMA_K, InputT, DataLayoutB>;
+
+// Multi-buffered LDS staging of the global buffers (macro tile)
+using LdsPipeline = lds_pipeline<LDS_PIPELINE_DEPTH,
+                                 WARPS_X * WARPS_Y,
+                                 GRBuffA,
+                                 GRBuffB,
+                                 DataLayoutLds>;
+
+// Computes one macro tile of D = alpha * (A x B) + beta * C, where A is in BSR format with
+// MACRO_TILE_X x ROCWMMA_K blocks. Only the nonzero K blocks of the block row are visited.
+ROCWMMA_KERNEL void __launch_bounds__(256) gemm_bsr_rocwmma_d(uint32_t        m,
+                                                              uint32_t        n,
+                                                              uint32_t const* bsrRowPtr,
+                                                              uint32_t const* bsrColIdx,
+                                                              InputT const*   bsrValues,
+                                                              InputT const*   b,
+                                                              OutputT const*  c,
+                                                              OutputT*        d,
+                                                              uint32_t        ldb,
+                                                              uint32_t        ldc,
+                                                              uint32_t        ldd,
+                                                              ComputeT        alpha,
+                                                              ComputeT        beta)
+{
+    if constexpr(!ROCWMMA_ARCH_HOST)
+    {
+        HIP_DYNAMIC_SHARED(void*, localMemPtr);
+
+        ///
+        /// 2D matrix coordinate setup
+        ///
+        constexpr auto warpTileSize  = make_coord2d(WARP_TILE_X, WARP_TILE_Y);
+        constexpr auto macroTileSize = make_coord2d(MACRO_TILE_X, MACRO_TILE_Y);
+        constexpr auto warpDims      = make_coord2d(WARPS_X, WARPS_Y);
+
+        auto localWarpCoord  = make_coord2d(threadIdx.x / WARP_SIZE, threadIdx.y);
+        auto localWarpOffset = localWarpCoord * warpTileSize;
+        auto macroTileCoord  = make_coord2d(blockIdx.x, blockIdx.y) * macroTileSize;
+        auto warpTileCoord   = macroTileCoord + localWarpOffset;
+
+        // Bounds check
+        auto warpTileBound = warpTileCoord + warpTileSize;
+        if(get<0>(warpTileBound) > m || get<1>(warpTileBound) > n)
+        {
+            return;
+        }
+
+        ///
+        /// Nonzero K blocks of this block row. Uniform across the workgroup.
+        ///
+        auto blockBegin = bsrRowPtr[blockIdx.x];
+        auto kSteps     = bsrRowPtr[blockIdx.x + 1u] - blockBegin;
+
+        // Global read addresses of the nonzero block j of the block row
+        using GRBuffBMap1d = GetDataLayout_t<GRBuffB>;
+
+        constexpr uint32_t bsrBlockSize = MACRO_TILE_X * ROCWMMA_K;
+        auto               readA        = [&](uint32_t j) {
+            return bsrValues + static_cast<size_t>(blockBegin + j) * bsrBlockSize;
+        };
+        auto readB = [&](uint32_t j) {
+            auto kRow = bsrColIdx[blockBegin + j] * ROCWMMA_K;
+            return b
+                   + GRBuffBMap1d::fromMatrixCoord(make_coord2d(kRow, get<1>(macroTileCoord)), ldb);
+        };
+
+        ///
+        /// Setup LDS pipeline
+        ///
+        constexpr auto warpCount = get<0>(warpDims) * get<1>(warpDims);
+        const auto warpIndex = get<0>(localWarpCoord) * get<1>(warpDims) + get<1>(localWarpCoord);
+
+        static_assert(LdsPipeline::depth >= 2u, "Requires at least double buffering");
+        static_assert(warpCount == WARPS_X * WARPS_Y, "Pipeline and workgroup warp counts differ");
+
+        LdsPipeline pipeline(reinterpret_cast<InputT*>(localMemPtr), warpIndex);
+
+        ///
+        /// Perform initial global pre-fetch and write to local.
+        /// Empty block rows skip the K loop entirely.
+        ///
+        auto prologueSteps = std::min(LdsPipeline::depth - 1u, kSteps);
+        for(uint32_t step = 0u; step < prologueSteps; step++)
+        {
+            pipeline.global_read(readA(step), MACRO_TILE_X, readB(step), ldb);
+            pipeline.local_write();
+        }
+
+        MfmaTileAcc fragsAcc;
+        fill_fragment(fragsAcc, 0.0f);
+
+        synchronize_workgroup();
+
+        ///
+        /// Accumulate A * B over the nonzero K blocks
+        ///
+        for(uint32_t step = prologueSteps; step < kSteps; step++)
+        {
+            MfmaTileA fragsA;
+            MfmaTileB fragsB;
+
+            pipeline.local_read_a(fragsA, get<0>(localWarpOffset));
+            pipeline.local_read_b(fragsB, get<1>(localWarpOffset));
+
+            // With a spare stage, the stage written below is not read until after the next barrier.
+            if constexpr(LdsPipeline::depth >= 3u)
+            {
+                synchronize_workgroup();
+            }
+
+            // Prefetch the next nonzero block
+            pipeline.global_read(readA(step), MACRO_TILE_X, readB(step), ldb);
+
+            mma_sync(fragsAcc, fragsA, fragsB, fragsAcc);
+
+            pipeline.local_write();
+
+            if constexpr(LdsPipeline::depth == 2u)
+            {
+                synchronize_workgroup();
+            }
+
+            pipeline.advance();
+        }
+
+        // Local writes of the last steps are not yet visible to the workgroup
+        if constexpr(LdsPipeline::depth >= 3u)
+        {
+            synchronize_workgroup();
+        }
+
+        ///
+        /// Clean up tail A * B from the remaining stages
+        ///
+        for(uint32_t step = 0u; step < prologueSteps; step++)
+        {
+            MfmaTileA fragsA;
+            MfmaTileB fragsB;
+
+            pipeline.local_read_a(fragsA, get<0>(localWarpOffset));
+            pipeline.local_read_b(fragsB, get<1>(localWarpOffset));
+            mma_sync(fragsAcc, fragsA, fragsB, fragsAcc);
+
+            pipeline.advance();
+        }
+
+        ///
+        /// D = alpha * accum + beta * C
+        ///
+        using MfmaFragCMap1d = GetDataLayout_t<MfmaFragC>;
+        using MfmaFragDMap1d = GetDataLayout_t<MfmaFragD>;
+
+        MfmaTileC fragsC;
+        load_matrix_sync(fragsC, c + MfmaFragCMap1d::fromMatrixCoord(warpTileCoord, ldc), ldc);
+
+        MfmaTileD fragsD;
+#pragma unroll
+        for(int i = 0; i < BLOCKS_X; i++)
+        {
+#pragma unroll
+            for(int j = 0; j < BLOCKS_Y; j++)
+            {
+                apply_epilogue(fragsD(i, j),
+                               fragsAcc(i, j),
+                               epilogue::LinearCombination(alpha, beta, fragsC(i, j)));
+            }
+        }
+        store_matrix_sync(d + MfmaFragDMap1d::fromMatrixCoord(warpTileCoord, ldd), fragsD, ldd);
+    }
+}
+
+// Block sparse A in BSR format
+struct BsrMatrix
+{
+    std::vector<uint32_t> rowPtr;
+    std::vector<uint32_t> colIdx;
+    std::vector<InputT>   values;
+};
+
+// Packs the nonzero blocks of the col-major m x k matrix A, given the mask of nonzero blocks
+// of each block row (blockRows x kBlocks, row-major).
+ROCWMMA_HOST BsrMatrix packBsr(std::vector<InputT> const& matrixA,
+                               std::vector<bool> const&   blockMask,
+                               uint32_t                   m,
+                               uint32_t                   k,
+                               uint32_t                   blockM,
+                               uint32_t                   blockK)
+{
+    auto blockRows = m / blockM;
+    auto kBlocks   = k / blockK;
+
+    BsrMatrix bsr;
+    bsr.rowPtr.push_back(0u);
+    for(uint32_t i = 0; i < blockRows; i++)
+    {
+        for(uint32_t kb = 0; kb < kBlocks; kb++)
+        {
+            if(!blockMask[i * kBlocks + kb])
+            {
+                continue;
+            }
+
+            bsr.colIdx.push_back(kb);
+            for(uint32_t col = 0; col < blockK; col++)
+            {
+                for(uint32_t row = 0; row < blockM; row++)
+                {
+                    bsr.values.push_back(
+                        matrixA[size_t(kb * blockK + col) * m + i * blockM + row]);
+                }
+            }
+        }
+        bsr.rowPtr.push_back(bsr.colIdx.size());
+    }
+    return bsr;
+}
+
+ROCWMMA_HOST void bsr_gemm_test(
+    uint32_t m, uint32_t n, uint32_t k, uint32_t densityPct, ComputeT alpha, ComputeT beta)
+{
+    // Runtime checks for host parameters
+    uint32_t hTBLOCK_X    = isGfx9() ? gfx9Params::TBLOCK_X : gfx11Params::TBLOCK_X;
+    uint32_t hTBLOCK_Y    = isGfx9() ? gfx9Params::TBLOCK_Y : gfx11Params::TBLOCK_Y;
+    uint32_t hBLOCKS_X    = isGfx9() ? gfx9Params::BLOCKS_X : gfx11Params::BLOCKS_X;
+    uint32_t hBLOCKS_Y    = isGfx9() ? gfx9Params::BLOCKS_Y : gfx11Params::BLOCKS_Y;
+    uint32_t hROCWMMA_M   = isGfx9() ? gfx9Params::ROCWMMA_M : gfx11Params::ROCWMMA_M;
+    uint32_t hROCWMMA_N   = isGfx9() ? gfx9Params::ROCWMMA_N : gfx11Params::ROCWMMA_N;
+    uint32_t hROCWMMA_K   = isGfx9() ? gfx9Params::ROCWMMA_K : gfx11Params::ROCWMMA_K;
+    uint32_t hWARP_TILE_X = hBLOCKS_X * hROCWMMA_M;
+    uint32_t hWARP_TILE_Y = hBLOCKS_Y * hROCWMMA_N;
+
+    // Runtime warp calculation (host code needs to query warpsize dynamically)
+    auto warpSize = getWarpSize();
+    auto macroTileSize
+        = rocwmma::make_coord2d(hTBLOCK_X / warpSize * hWARP_TILE_X, hTBLOCK_Y * hWARP_TILE_Y);
+
+    if((isGfx11() || isGfx12()) && getWarpSize() != Constants::AMDGCN_WAVE_SIZE_32)
+    {
+        std::cout << "Unsupported wave size!\n";
+        return;
+    }
+
+    if(isGfx9() && getWarpSize() != Constants::AMDGCN_WAVE_SIZE_64)
+    {
+        std::cout << "Unsupported wave size!\n";
+        return;
+    }
+
+    // BSR blocks and workgroups cover whole macro tiles
+    if(m % get<0>(macroTileSize) || n % get<1>(macroTileSize) || k % hROCWMMA_K)
+    {
+        std::cout << "Unsupported matrix size!\n";
+        return;
+    }
+
+    int ldb = std::is_same_v<DataLayoutB, row_major> ? n : k;
+    int ldc = std::is_same_v<DataLayoutC, row_major> ? n : m;
+    int ldd = ldc;
+
+    std::cout << "Initializing host data..." << std::endl;
+
+    // Nonzero block pattern: every block row keeps about densityPct of its K blocks,
+    // and every 8th block row is empty.
+    auto blockRows = m / get<0>(macroTileSize);
+    auto kBlocks   = k / hROCWMMA_K;
+
+    std::vector<bool> sparseMask(blockRows * kBlocks);
+    std::vector<bool> denseMask(blockRows * kBlocks, true);
+    for(uint32_t i = 0; i < blockRows; i++)
+    {
+        for(uint32_t kb = 0; kb < kBlocks; kb++)
+        {
+            auto hash                    = (i * 2654435761u) ^ (kb * 40503u);
+            sparseMask[i * kBlocks + kb] = (i % 8u != 7u) && ((hash >> 7) % 100u < densityPct);
+        }
+    }
+
+    // Initialize input matrices. Pruned blocks of A are zero, for the reference.
+    std::vector<InputT>  matrixA(size_t(m) * k);
+    std::vector<InputT>  matrixB(size_t(k) * n);
+    std::vector<OutputT> matrixC(size_t(m) * n);
+
+    // Fill outputs with NaN to catch contamination
+    std::vector<OutputT> matrixD(size_t(m) * n, std::numeric_limits<OutputT>::signaling_NaN());
+
+    fillRand(matrixA.data(), m, k);
+    fillRand(matrixB.data(), k, n);
+    fillRand(matrixC.data(), m, n);
+
+    for(uint32_t col = 0; col < k; col++)
+    {
+        for(uint32_t row = 0; row < m; row++)
+        {
+            if(!sparseMask[row / get<0>(macroTileSize) * kBlocks + col / hROCWMMA_K])
+            {
+                matrixA[size_t(col) * m + row] = static_cast<InputT>(0);
+            }
+        }
+    }
+
+    auto sparseA = packBsr(matrixA, sparseMask, m, k, get<0>(macroTileSize), hROCWMMA_K);
+    auto denseA  = packBsr(matrixA, denseMask, m, k, get<0>(macroTileSize), hROCWMMA_K);
+
+    std::cout << "Initializing device data..." << std::endl;
+
+    // Allocate and copy device memory
+    auto toDevice = [](auto const& vec) {
+        using T  = typename std::decay_t<decltype(vec)>::value_type;
+        T* d_ptr = nullptr;
+        CHECK_HIP_ERROR(hipMalloc(&d_ptr, std::max<size_t>(vec.size(), 1u) * sizeof(T)));
+        CHECK_HIP_ERROR(
+            hipMemcpy(d_ptr, vec.data(), vec.size() * sizeof(T), hipMemcpyHostToDevice));
+        return d_ptr;
+    };
+
+    auto* d_sparseRowPtr = toDevice(sparseA.rowPtr);
+    auto* d_sparseColIdx = toDevice(sparseA.colIdx);
+    auto* d_sparseValues = toDevice(sparseA.values);
+    auto* d_denseRowPtr  = toDevice(denseA.rowPtr);
+    auto* d_denseColIdx  = toDevice(denseA.colIdx);
+    auto* d_denseValues  = toDevice(denseA.values);
+    auto* d_b            = toDevice(matrixB);
+    auto* d_c            = toDevice(matrixC);
+    auto* d_d            = toDevice(matrixD);
+
+    const size_t bytesD = matrixD.size() * sizeof(OutputT);
+
+    auto blockDim = dim3(hTBLOCK_X, hTBLOCK_Y);
+    auto gridDim  = dim3(m / get<0>(macroTileSize), n / get<1>(macroTileSize));
+
+    // Uses LDS_PIPELINE_DEPTH lds blocks for prefetch loop (A and B)
+    int ldsusage = LDS_PIPELINE_DEPTH * sizeof(InputT)
+                   * (get<0>(macroTileSize) + get<1>(macroTileSize)) * hROCWMMA_K;
+
+    auto bsrKernel = [&](uint32_t const* rowPtr, uint32_t const* colIdx, InputT const* values) {
+        return [=]() {
+            hipExtLaunchKernelGGL(gemm_bsr_rocwmma_d,
+                                  gridDim,
+                                  blockDim,
+                                  ldsusage,
+                                  0,
+                                  nullptr,
+                                  nullptr,
+                                  0,
+                                  m,
+                                  n,
+                                  rowPtr,
+                                  colIdx,
+                                  values,
+                                  d_b,
+                                  d_c,
+                                  d_d,
+                                  ldb,
+                                  ldc,
+                                  ldd,
+                                  alpha,
+                                  beta);
+        };
+    };
+
+    std::cout << "Launching BSR GEMM kernels..." << std::endl;
+    std::cout << "gridDim (" << gridDim.x << " " << gridDim.y << ")"
+              << " blockdim (" << blockDim.x << " " << blockDim.y << ")" << std::endl;
+
+    // Runs are timed individually, with warm and cold caches
+    BenchmarkHarness harness;
+
+    // Useful flops only count the nonzero blocks of A.
+    // Returns the warm median time.
+    auto echo = [&](const char* kernelName, BsrMatrix const& bsr, auto&& kernel) {
+        auto nnzBlocks = static_cast<uint32_t>(bsr.colIdx.size());
+        auto gFlops    = calculateGFlops(nnzBlocks * get<0>(macroTileSize), n, hROCWMMA_K);
+        auto density   = 100.0 * nnzBlocks / (blockRows * kBlocks);
+        auto warmMs    = 0.0;
+
+        for(auto cacheState :
+            {BenchmarkHarness::CacheState::Warm, BenchmarkHarness::CacheState::Cold})
+        {
+            auto stats        = harness.run(kernel, cacheState);
+            auto tFlopsPerSec = gFlops / stats.mMedianMs;
+
+            std::cout << kernelName << ", " << get<0>(macroTileSize) << ", " << hROCWMMA_K
+                      << ", " << m << ", " << n << ", " << k << ", " << nnzBlocks << ", "
+                      << density << ", "
+                      << (cacheState == BenchmarkHarness::CacheState::Warm ? "warm" : "cold")
+                      << ", " << stats.mMedianMs << ", " << gFlops << ", " << tFlopsPerSec
+                      << ", ";
+            BenchmarkHarness::printStats(std::cout, stats) << std::endl;
+
+            if(cacheState == BenchmarkHarness::CacheState::Warm)
+            {
+                warmMs = stats.mMedianMs;
+            }
+        }
+        return warmMs;
+    };
+
+#if !NDEBUG
+
+    // Both kernels compute the same product, since pruned blocks of A are zero
+    std::vector<OutputT> matrixD_ref(size_t(m) * n, std::numeric_limits<OutputT>::signaling_NaN());
+    gemm_cpu_h<InputT, OutputT, ComputeT, DataLayoutA, DataLayoutB, DataLayoutC>(m,
+                                                                                 n,
+                                                                                 k,
+                                                                                 matrixA.data(),
+                                                                                 matrixB.data(),
+                                                                                 matrixC.data(),
+                                                                                 matrixD_ref.data(),
+                                                                                 m,
+                                                                                 ldb,
+                                                                                 ldc,
+                                                                                 ldd,
+                                                                                 alpha,
+                                                                                 beta);
+
+    auto validate = [&]() {
+        std::cout << "Validating result with reference..." << std::endl;
+
+        // Bring kernel result back to host
+        CHECK_HIP_ERROR(hipMemcpy(matrixD.data(), d_d, bytesD, hipMemcpyDeviceToHost));
+
+        auto res = compareEqual(matrixD.data(), matrixD_ref.data(), matrixD.size());
+
+        if(std::get<0>(res) == false)
+        {
+            std::cout << "FAILED\n";
+        }
+        else
+        {
+            std::cout << "PASSED\n";
+        }
+
+        std::cout << "Max relative error: " << std::get<1>(res) << std::endl;
+    };
+
+#endif // !NDEBUG
+
+    std::cout << "Kernel, BsrBlkM, BsrBlkK, MatM, MatN, MatK, NnzBlocks, Density(%), "
+              << "Cache, elapsedMs, Problem Size(GFlops), TFlops/s, "
+              << BenchmarkHarness::statsHeader() << std::endl;
+
+    auto denseMs = echo("Dense", denseA, bsrKernel(d_denseRowPtr, d_denseColIdx, d_denseValues));
+
+#if !NDEBUG
+    validate();
+#endif // !NDEBUG
+
+    // Fill outputs with NaN to catch contamination
+    CHECK_HIP_ERROR(hipMemset(d_d, 0xFF, bytesD));
+    auto sparseMs
+        = echo("BlockSparse", sparseA, bsrKernel(d_sparseRowPtr, d_sparseColIdx, d_sparseValues));
+
+#if !NDEBUG
+    validate();
+#endif // !NDEBUG
+
+    std::cout << "Block sparse speedup over dense (warm): " << denseMs / sparseMs << "x"
+              << std::endl;
+
+    // Release device memory
+    CHECK_HIP_ERROR(hipFree(d_sparseRowPtr));
+    CHECK_HIP_ERROR(hipFree(d_sparseColIdx));
+    CHECK_HIP_ERROR(hipFree(d_sparseValues));
+    CHECK_HIP_ERROR(hipFree(d_denseRowPtr));
+    CHECK_HIP_ERROR(hipFree(d_denseColIdx));
+    CHECK_HIP_ERROR(hipFree(d_denseValues));
+    CHECK_HIP_ERROR(hipFree(d_b));
+    CHECK_HIP_ERROR(hipFree(d_c));
+    CHECK_HIP_ERROR(hipFree(d_d));
+
+    std::cout << "Finished!" << std::endl;
+}
+
+int main()
+{
+    // Block densities of 25% and 10%
+    bsr_gemm_test(4096, 4096, 4096, 25, 2, 2);
+    bsr_gemm_test(4096, 4096, 4096, 10, 2, 2);
+    return 0;
+}
@@ -0,0 +1,599 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_fp16.h>
+#include <hip/hip_runtime.h>
+
+#include <rocwmma/rocwmma.hpp>
+
+#include "common.hpp"
+
+using rocwmma::accumulator;
+using rocwmma::col_major;
+using rocwmma::float16_t;
+using rocwmma::float32_t;
+using rocwmma::float64_t;
+using rocwmma::get_launch_occupancy;
+using rocwmma::matrix_a;
+using rocwmma::matrix_b;
+using rocwmma::occupancy_limiter_name;
+using rocwmma::row_major;
+
+/* Motivation
+*
+* Inference servers rarely run one large GEMM at a time. Many requests of
+* different shapes are in flight on separate streams, and the hardware
+* schedulers pack their workgroups onto whichever CUs have room. Whether a
+* kernel configuration co-schedules well then matters as much as its
+* standalone throughput: a workgroup that reserves most of the LDS of a CU
+* leaves no room for the workgroups of other streams, so concurrent kernels
+* queue behind each other instead of overlapping.
+*
+* This sample launches STREAM_COUNTS streams concurrently. Each stream runs
+* KERNELS_PER_STREAM GEMMs back-to-back, cycling through a mix of small and
+* medium SHAPES, offset per stream so that different shapes overlap:
+*
+*     stream 0  | s0 | s1 |  s2  |    s3    | s0 | ...
+*     stream 1  | s1 |  s2  |    s3    | s0 | s1 | ...
+*     stream 2  |  s2  |    s3    | s0 | s1 |  s2  | ...
+*
+* The same register blocked kernel is run with several LDS reservations. The
+* kernel itself does not touch the reserved LDS, so every configuration does
+* identical work and only its residency (reported as occupancy) differs, as
+* it would for an LDS staged kernel of that footprint.
+*
+* For each configuration and stream count the benchmark reports:
+* - TFlops/s: aggregate throughput of all streams, from the first launch to
+*   the completion of the last stream
+* - Speedup: aggregate throughput relative to a single stream
+* - Slowdown p50 / p95 / p99: distribution of per-kernel latency, each kernel
+*   normalized by the median latency of its shape on a single stream
+* - Fairness: Jain's index of the per-stream throughputs, from 1 / streams
+*   (one stream got everything) to 1 (all streams progressed equally)
+*
+* Note: Per-kernel latency is measured by events around each launch, so it
+* includes time spent waiting for CUs held by other streams, but not time
+* queued behind earlier kernels of the same stream.
+*/
+
+// Supports ROCWMMA_M/N square sizes of
+// : 16 x 16
+// : 32 x 32 ( only MI )
+const int ROCWMMA_M = 16;
+const int ROCWMMA_N = 16;
+
+// Supports ROCWMMA_K sizes as
+// : multiples of 16.
+const int ROCWMMA_K = 16;
+
+// Each wave computes BLOCKS_X x BLOCKS_Y fragments of output, reusing each
+// A fragment across BLOCKS_Y and each B fragment across BLOCKS_X.
+const int BLOCKS_X    = 2;
+const int BLOCKS_Y    = 2;
+const int WAVE_TILE_M = BLOCKS_X * ROCWMMA_M;
+const int WAVE_TILE_N = BLOCKS_Y * ROCWMMA_N;
+
+// Device warp size
+const uint32_t WAVE_SIZE = getWarpSize();
+
+// Thread block
+// : T_BLOCK_X must be multiple of WAVE_SIZE.
+// Small blocks so that the small shapes still fill the device.
+const int T_BLOCK_X = 2 * WAVE_SIZE;
+const int T_BLOCK_Y = 2;
+
+// LDS reserved per workgroup by each configuration
+const uint32_t LDS_RESERVATIONS[] = {0u, 16u * 1024u, 32u * 1024u, 64u * 1024u};
+
+// Concurrent streams of the sweep
+const uint32_t STREAM_COUNTS[] = {1u, 2u, 4u, 8u, 16u};
+const uint32_t MAX_STREAMS     = 16u;
+
+// GEMMs enqueued on each stream per run
+const uint32_t KERNELS_PER_STREAM = 32u;
+
+// Benchmark runs
+const uint32_t WARMUP_RUNS = 2u;
+const uint32_t TIMED_RUNS  = 5u;
+
+// Mixed sizes of the workload. Dimensions are multiples of the wave tiles.
+struct GemmShape
+{
+    uint32_t mM;
+    uint32_t mN;
+    uint32_t mK;
+};
+
+const GemmShape SHAPES[] = {
+    {256u, 256u, 256u},
+    {512u, 512u, 512u},
+    {1024u, 512u, 256u},
+    {1024u, 1024u, 1024u},
+    {2048u, 256u, 512u},
+};
+const uint32_t NUM_SHAPES = sizeof(SHAPES) / sizeof(SHAPES[0]);
+
+// Register blocked GEMM, each wave computing a WAVE_TILE_M x WAVE_TILE_N
+// output tile of D = alpha * (A x B) + beta * C.
+//
+// : A is in row-major format     (M x K)
+// : B is in col-major format     (K x N)
+// : C, D are in row-major format (M x N)
+__global__ void __launch_bounds__(256) hgemm_rocwmma_d(uint32_t         m,
+                                                       uint32_t         n,
+                                                       uint32_t         k,
+                                                       float16_t const* a,
+                                                       float16_t const* b,
+                                                       float16_t const* c,
+                                                       float16_t*       d,
+                                                       uint32_t         lda,
+                                                       uint32_t         ldb,
+                                                       uint32_t         ldc,
+                                                       uint32_t         ldd,
+                                                       float32_t        alpha,
+                                                       float32_t        beta)
+{
+    using FragA
+        = rocwmma::fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, row_major>;
+    using FragB
+        = rocwmma::fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, col_major>;
+    using FragC   = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t>;
+    using FragAcc = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float32_t>;
+
+    // Tile using a 2D grid
+    auto majorWarp = (blockIdx.x * blockDim.x + threadIdx.x) / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    auto minorWarp = (blockIdx.y * blockDim.y + threadIdx.y);
+
+    // Target C tile
+    auto cRow = majorWarp * WAVE_TILE_M;
+    auto cCol = minorWarp * WAVE_TILE_N;
+
+    // Bounds check
+    if(cRow < m && cCol < n)
+    {
+        FragAcc fragsAcc[BLOCKS_X][BLOCKS_Y];
+        for(int i = 0; i < BLOCKS_X; ++i)
+        {
+            for(int j = 0; j < BLOCKS_Y; ++j)
+            {
+                rocwmma::fill_fragment(fragsAcc[i][j], 0.0f);
+            }
+        }
+
+        // fragsAcc = A x B
+        for(int h = 0; h < k; h += ROCWMMA_K)
+        {
+            FragA fragsA[BLOCKS_X];
+            FragB fragsB[BLOCKS_Y];
+
+            for(int i = 0; i < BLOCKS_X; ++i)
+            {
+                rocwmma::load_matrix_sync(fragsA[i], a + ((cRow + i * ROCWMMA_M) * lda + h), lda);
+            }
+            for(int j = 0; j < BLOCKS_Y; ++j)
+            {
+                rocwmma::load_matrix_sync(fragsB[j], b + (h + (cCol + j * ROCWMMA_N) * ldb), ldb);
+            }
+
+            for(int i = 0; i < BLOCKS_X; ++i)
+            {
+                for(int j = 0; j < BLOCKS_Y; ++j)
+                {
+                    rocwmma::mma_sync(fragsAcc[i][j], fragsA[i], fragsB[j], fragsAcc[i][j]);
+                }
+            }
+        }
+
+        // D = alpha * A x B + beta * C
+        for(int i = 0; i < BLOCKS_X; ++i)
+        {
+            for(int j = 0; j < BLOCKS_Y; ++j)
+            {
+                auto  offsetRow = cRow + i * ROCWMMA_M;
+                auto  offsetCol = cCol + j * ROCWMMA_N;
+                FragC fragC;
+
+                rocwmma::load_matrix_sync(
+                    fragC, c + (offsetRow * ldc + offsetCol), ldc, rocwmma::mem_row_major);
+
+                for(int e = 0; e < fragC.num_elements; ++e)
+                {
+                    fragC.x[e] = alpha * fragsAcc[i][j].x[e] + beta * fragC.x[e];
+                }
+
+                rocwmma::store_matrix_sync(
+                    d + (offsetRow * ldd + offsetCol), fragC, ldd, rocwmma::mem_row_major);
+            }
+        }
+    }
+}
+
+// Per stream resources. Each stream has its own buffers, sized for the
+// largest shape, so that concurrent kernels never share outputs.
+struct StreamContext
+{
+    hipStream_t             mStream;
+    std::vector<hipEvent_t> mStartEvents; // One per kernel
+    std::vector<hipEvent_t> mStopEvents; // One per kernel
+
+    float16_t* mA;
+    float16_t* mB;
+    float16_t* mC;
+    float16_t* mD;
+};
+
+// Measurements of one run
+struct ConcurrentRun
+{
+    double              mElapsedMs; // First launch to last completion
+    std::vector<double> mStreamMs; // First launch to completion of each stream
+    std::vector<double> mKernelMs; // [stream][kernel], flattened
+};
+
+inline GemmShape const& kernelShape(uint32_t stream, uint32_t kernel)
+{
+    return SHAPES[(kernel + stream) % NUM_SHAPES];
+}
+
+// Enqueue one run of the mixed workload on the first numStreams streams.
+// The enqueue loop is kernel-major so that all streams start together.
+__host__ void enqueueConcurrent(std::vector<StreamContext>& contexts,
+                                uint32_t                    numStreams,
+                                uint32_t                    ldsBytes,
+                                hipEvent_t                  runStart,
+                                float32_t                   alpha,
+                                float32_t                   beta)
+{
+    // All streams wait on a common start, so that their times share an origin
+    CHECK_HIP_ERROR(hipEventRecord(runStart, contexts[0].mStream));
+    for(uint32_t s = 1; s < numStreams; ++s)
+    {
+        CHECK_HIP_ERROR(hipStreamWaitEvent(contexts[s].mStream, runStart, 0));
+    }
+
+    auto blockDim = dim3(T_BLOCK_X, T_BLOCK_Y);
+    for(uint32_t i = 0; i < KERNELS_PER_STREAM; ++i)
+    {
+        for(uint32_t s = 0; s < numStreams; ++s)
+        {
+            auto& ctx   = contexts[s];
+            auto& shape = kernelShape(s, i);
+
+            auto gridDim = dim3(rocwmma::ceilDiv(shape.mM, WAVE_TILE_M * T_BLOCK_X / WAVE_SIZE),
+                                rocwmma::ceilDiv(shape.mN, WAVE_TILE_N * T_BLOCK_Y));
+
+            hipExtLaunchKernelGGL(hgemm_rocwmma_d,
+                                  gridDim,
+                                  blockDim,
+                                  ldsBytes, // sharedMemBytes
+                                  ctx.mStream, // stream
+                                  ctx.mStartEvents[i], // Event start
+                                  ctx.mStopEvents[i], // event stop
+                                  0, // flags
+                                  shape.mM,
+                                  shape.mN,
+                                  shape.mK,
+                                  ctx.mA,
+                                  ctx.mB,
+                                  ctx.mC,
+                                  ctx.mD,
+                                  shape.mK, // lda
+                                  shape.mK, // ldb
+                                  shape.mN, // ldc
+                                  shape.mN, // ldd
+                                  alpha,
+                                  beta);
+        }
+    }
+}
+
+__host__ ConcurrentRun collectRun(std::vector<StreamContext> const& contexts,
+                                  uint32_t                          numStreams,
+                                  hipEvent_t                        runStart)
+{
+    ConcurrentRun run;
+    run.mElapsedMs = 0.0;
+    run.mStreamMs.resize(numStreams);
+    run.mKernelMs.resize(numStreams * KERNELS_PER_STREAM);
+
+    for(uint32_t s = 0; s < numStreams; ++s)
+    {
+        auto& ctx = contexts[s];
+        CHECK_HIP_ERROR(hipStreamSynchronize(ctx.mStream));
+
+        float streamMs = 0.0f;
+        CHECK_HIP_ERROR(
+            hipEventElapsedTime(&streamMs, runStart, ctx.mStopEvents[KERNELS_PER_STREAM - 1u]));
+        run.mStreamMs[s] = streamMs;
+        run.mElapsedMs   = std::max(run.mElapsedMs, run.mStreamMs[s]);
+
+        for(uint32_t i = 0; i < KERNELS_PER_STREAM; ++i)
+        {
+            float kernelMs = 0.0f;
+            CHECK_HIP_ERROR(
+                hipEventElapsedTime(&kernelMs, ctx.mStartEvents[i], ctx.mStopEvents[i]));
+            run.mKernelMs[s * KERNELS_PER_STREAM + i] = kernelMs;
+        }
+    }
+    return run;
+}
+
+// Nearest-rank percentile of sorted samples
+inline double percentile(std::vector<double> const& sorted, double p)
+{
+    auto rank = static_cast<size_t>(std::ceil(p * static_cast<double>(sorted.size())));
+    return sorted[std::max<size_t>(rank, 1u) - 1u];
+}
+
+inline double median(std::vector<double> samples)
+{
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2u];
+}
+
+// Jain's fairness index: (sum x)^2 / (n * sum x^2)
+inline double jainFairness(std::vector<double> const& throughputs)
+{
+    double sum   = 0.0;
+    double sumSq = 0.0;
+    for(auto x : throughputs)
+    {
+        sum += x;
+        sumSq += x * x;
+    }
+    return sumSq > 0.0 ? sum * sum / (static_cast<double>(throughputs.size()) * sumSq) : 0.0;
+}
+
+__host__ void concurrent_test(float32_t alpha, float32_t beta)
+{
+    // Buffers are sized for the largest dimensions of any shape
+    uint32_t maxM = 0u, maxN = 0u, maxK = 0u;
+    for(auto const& shape : SHAPES)
+    {
+        maxM = std::max(maxM, shape.mM);
+        maxN = std::max(maxN, shape.mN);
+        maxK = std::max(maxK, shape.mK);
+    }
+
+    std::cout << "Initializing host data..." << std::endl;
+
+    // Initialize input matrices
+    std::vector<float16_t> matrixA(maxM * maxK);
+    std::vector<float16_t> matrixB(maxK * maxN);
+    std::vector<float16_t> matrixC(maxM * maxN);
+
+    fillRand(matrixA.data(), maxM, maxK);
+    fillRand(matrixB.data(), maxK, maxN);
+    fillRand(matrixC.data(), maxM, maxN);
+
+    std::cout << "Initializing device data for " << MAX_STREAMS << " streams..." << std::endl;
+
+    const size_t bytesA = matrixA.size() * sizeof(float16_t);
+    const size_t bytesB = matrixB.size() * sizeof(float16_t);
+    const size_t bytesC = matrixC.size() * sizeof(float16_t);
+    const size_t bytesD = matrixC.size() * sizeof(float16_t);
+
+    std::vector<StreamContext> contexts(MAX_STREAMS);
+    for(auto& ctx : contexts)
+    {
+        CHECK_HIP_ERROR(hipStreamCreateWithFlags(&ctx.mStream, hipStreamNonBlocking));
+        ctx.mStartEvents.resize(KERNELS_PER_STREAM);
+        ctx.mStopEvents.resize(KERNELS_PER_STREAM);
+        for(auto& event : ctx.mStartEvents)
+        {
+            CHECK_HIP_ERROR(hipEventCreate(&event));
+        }
+        for(auto& event : ctx.mStopEvents)
+        {
+            CHECK_HIP_ERROR(hipEventCreate(&event));
+        }
+
+        CHECK_HIP_ERROR(hipMalloc(&ctx.mA, bytesA));
+        CHECK_HIP_ERROR(hipMalloc(&ctx.mB, bytesB));
+        CHECK_HIP_ERROR(hipMalloc(&ctx.mC, bytesC));
+        CHECK_HIP_ERROR(hipMalloc(&ctx.mD, bytesD));
+
+        CHECK_HIP_ERROR(hipMemcpy(ctx.mA, matrixA.data(), bytesA, hipMemcpyHostToDevice));
+        CHECK_HIP_ERROR(hipMemcpy(ctx.mB, matrixB.data(), bytesB, hipMemcpyHostToDevice));
+        CHECK_HIP_ERROR(hipMemcpy(ctx.mC, matrixC.data(), bytesC, hipMemcpyHostToDevice));
+    }
+
+    hipEvent_t runStart;
+    CHECK_HIP_ERROR(hipEventCreate(&runStart));
+
+    // Work per stream is the same for every stream count
+    std::vector<double> streamGFlops(MAX_STREAMS, 0.0);
+    for(uint32_t s = 0; s < MAX_STREAMS; ++s)
+    {
+        for(uint32_t i = 0; i < KERNELS_PER_STREAM; ++i)
+        {
+            auto& shape = kernelShape(s, i);
+            streamGFlops[s] += calculateGFlops(shape.mM, shape.mN, shape.mK);
+        }
+    }
+
+    std::cout << "LDS(KB), Occupancy(waves/SIMD), Occupancy Limiter, "
+              << "Streams, Kernels, "
+              << "elapsedMs(median), Problem Size(GFlops), TFlops/s, Speedup, "
+              << "Slowdown p50, Slowdown p95, Slowdown p99, Fairness" << std::endl;
+
+    for(auto ldsBytes : LDS_RESERVATIONS)
+    {
+        auto occupancy = get_launch_occupancy(hgemm_rocwmma_d, T_BLOCK_X * T_BLOCK_Y, ldsBytes);
+
+        // Median latency of each shape on a single stream, the slowdown baseline
+        std::vector<double> isolatedMs(NUM_SHAPES, 0.0);
+        auto                baselineTFlops = 0.0;
+
+        for(auto numStreams : STREAM_COUNTS)
+        {
+            for(uint32_t r = 0; r < WARMUP_RUNS; ++r)
+            {
+                enqueueConcurrent(contexts, numStreams, ldsBytes, runStart, alpha, beta);
+            }
+            CHECK_HIP_ERROR(hipDeviceSynchronize());
+
+            std::vector<ConcurrentRun> runs;
+            for(uint32_t r = 0; r < TIMED_RUNS; ++r)
+            {
+                enqueueConcurrent(contexts, numStreams, ldsBytes, runStart, alpha, beta);
+                runs.push_back(collectRun(contexts, numStreams, runStart));
+            }
+
+            // Throughput and fairness of the median run
+            std::sort(runs.begin(), runs.end(), [](auto const& lhs, auto const& rhs) {
+                return lhs.mElapsedMs < rhs.mElapsedMs;
+            });
+            auto const& medianRun = runs[runs.size() / 2u];
+
+            auto                gFlops = 0.0;
+            std::vector<double> streamThroughputs(numStreams);
+            for(uint32_t s = 0; s < numStreams; ++s)
+            {
+                gFlops += streamGFlops[s];
+                streamThroughputs[s] = streamGFlops[s] / medianRun.mStreamMs[s];
+            }
+
+            auto tFlopsPerSec = gFlops / medianRun.mElapsedMs;
+            if(numStreams == 1u)
+            {
+                baselineTFlops = tFlopsPerSec;
+
+                std::vector<std::vector<double>> shapeMs(NUM_SHAPES);
+                for(auto const& run : runs)
+                {
+                    for(uint32_t i = 0; i < KERNELS_PER_STREAM; ++i)
+                    {
+                        shapeMs[i % NUM_SHAPES].push_back(run.mKernelMs[i]);
+                    }
+                }
+                for(uint32_t i = 0; i < NUM_SHAPES; ++i)
+                {
+                    isolatedMs[i] = median(shapeMs[i]);
+                }
+            }
+
+            // Latency distribution over all kernels of all runs
+            std::vector<double> slowdowns;
+            for(auto const& run : runs)
+            {
+                for(uint32_t s = 0; s < numStreams; ++s)
+                {
+                    for(uint32_t i = 0; i < KERNELS_PER_STREAM; ++i)
+                    {
+                        auto shape = (i + s) % NUM_SHAPES;
+                        slowdowns.push_back(run.mKernelMs[s * KERNELS_PER_STREAM + i]
+                                            / isolatedMs[shape]);
+                    }
+                }
+            }
+            std::sort(slowdowns.begin(), slowdowns.end());
+
+            std::cout << ldsBytes / 1024u << ", " << occupancy.waves_per_simd << ", "
+                      << occupancy_limiter_name(occupancy.limiter) << ", " << numStreams << ", "
+                      << numStreams * KERNELS_PER_STREAM << ", " << medianRun.mElapsedMs << ", "
+                      << gFlops << ", " << tFlopsPerSec << ", " << tFlopsPerSec / baselineTFlops
+                      << ", " << percentile(slowdowns, 0.5) << ", "
+                      << percentile(slowdowns, 0.95) << ", " << percentile(slowdowns, 0.99)
+                      << ", " << jainFairness(streamThroughputs) << std::endl;
+        }
+    }
+
+#if !NDEBUG
+
+    std::cout << "Validating result with reference..." << std::endl;
+
+    // Every stream's D holds the last shape it ran in the final run
+    std::vector<float16_t> matrixD(maxM * maxN);
+    std::vector<float16_t> matrixD_ref(maxM * maxN);
+    for(uint32_t s = 0; s < MAX_STREAMS; ++s)
+    {
+        auto& shape = kernelShape(s, KERNELS_PER_STREAM - 1u);
+        auto  m     = shape.mM;
+        auto  n     = shape.mN;
+        auto  k     = shape.mK;
+
+        std::fill(matrixD_ref.begin(),
+                  matrixD_ref.end(),
+                  std::numeric_limits<float16_t>::signaling_NaN());
+        gemm_cpu_h<float16_t, float16_t, float32_t, row_major, col_major, row_major>(
+            m,
+            n,
+            k,
+            matrixA.data(),
+            matrixB.data(),
+            matrixC.data(),
+            matrixD_ref.data(),
+            k,
+            k,
+            n,
+            n,
+            alpha,
+            beta);
+
+        CHECK_HIP_ERROR(
+            hipMemcpy(matrixD.data(), contexts[s].mD, bytesD, hipMemcpyDeviceToHost));
+
+        auto res = compareEqual<float16_t>(matrixD.data(), matrixD_ref.data(), m * n);
+
+        std::cout << "Stream " << s << ": " << (std::get<0>(res) ? "PASSED" : "FAILED")
+                  << ", max relative error: " << std::get<1>(res) << std::endl;
+    }
+
+#endif // !NDEBUG
+
+    // Release device resources
+    CHECK_HIP_ERROR(hipEventDestroy(runStart));
+    for(auto& ctx : contexts)
+    {
+        CHECK_HIP_ERROR(hipFree(ctx.mA));
+        CHECK_HIP_ERROR(hipFree(ctx.mB));
+        CHECK_HIP_ERROR(hipFree(ctx.mC));
+        CHECK_HIP_ERROR(hipFree(ctx.mD));
+        for(auto& event : ctx.mStartEvents)
+        {
+            CHECK_HIP_ERROR(hipEventDestroy(event));
+        }
+        for(auto& event : ctx.mStopEvents)
+        {
+            CHECK_HIP_ERROR(hipEventDestroy(event));
+        }
+        CHECK_HIP_ERROR(hipStreamDestroy(ctx.mStream));
+    }
+
+    std::cout << "Finished!" << std::endl;
+}
+
+int main()
+{
+    concurrent_test(2.1f, 2.1f);
+    return 0;
+}
@@ -0,0 +1,738 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_fp16.h>
+#include <hip/hip_runtime.h>
+
+#include <rocwmma/rocwmma.hpp>
+#include <rocwmma/rocwmma_epilogue.hpp>
+#include <rocwmma/rocwmma_pipeline.hpp>
+#include <rocwmma/rocwmma_tile.hpp>
+#include <rocwmma/rocwmma_transforms.hpp>
+
+#include "benchmark_harness.hpp"
+#include "common.hpp"
+
+/* Motivation
+*
+* Int8 and FP8 inference pipelines quantize the output of a GEMM per token (row) before the
+* next GEMM:
+*
+* scale[row] = amax(D[row]) / max(QuantT)
+* Q[row]     = round(D[row] / scale[row])
+*
+* The unfused formulation writes D in float16_t, reads it back to reduce the row amax, and
+* reads it again to quantize. In this sample, the row amax is reduced in the GEMM epilogue:
+*
+*   1. Each warp reduces the amax of its rows over its warp tile in registers, with
+*      rocwmma::reduce_rows.
+*   2. The warps of a workgroup sharing rows combine their amax through LDS, such that every
+*      warp holds the row amax over the N_TILES macro tiles of the workgroup.
+*
+* When the workgroup spans the whole of N (e.g. the narrow outputs of decode projections),
+* the accumulators are quantized in registers with the rocwmma::epilogue::DynamicQuantize
+* stage and Q and the scales are written directly, in a single pass.
+*
+* When N spans several workgroups, the row amax is not known until all of them finish, and
+* quantization takes two phases:
+*
+*   1. The GEMM writes D in float16_t, and the row amax of each workgroup as partials.
+*   2. A quantize pass reduces the partials of each row and quantizes the row of D.
+*
+* which reads D once instead of twice.
+*
+* Flow of the epilogue per workgroup:
+*
+*   Warp tile row amax (registers) -> Workgroup row amax (LDS)
+*         |
+*         +-- N within workgroup: Q = DynamicQuantize(acc), write Q and scales
+*         |
+*         +-- N across workgroups: write D and the amax partials; quantize pass
+*/
+
+using namespace rocwmma;
+
+///
+/// Types and Data Layouts
+///
+
+using InputT   = float16_t;
+using OutputT  = float16_t;
+using QuantT   = int8_t;
+using ComputeT = float32_t;
+
+using DataLayoutA = col_major;
+using DataLayoutB = row_major;
+using DataLayoutC = row_major;
+
+///
+/// Parameter configuration
+///
+
+// Validated defaults of rocwmma::warp_tile_config for InputT and the target being compiled.
+// The host selects the same ones at runtime with get_warp_tile_params.
+using WarpTileConfig = warp_tile_config_t<InputT>;
+
+enum kernelParams : uint32_t
+{
+    ROCWMMA_M = WarpTileConfig::block_m,
+    ROCWMMA_N = WarpTileConfig::block_n,
+    ROCWMMA_K = WarpTileConfig::block_k,
+    BLOCKS_X  = WarpTileConfig::blocks_x,
+    BLOCKS_Y  = WarpTileConfig::blocks_y,
+    TBLOCK_X  = WarpTileConfig::tblock_x,
+    TBLOCK_Y  = WarpTileConfig::tblock_y,
+    WARP_SIZE = WarpTileConfig::wave_size
+};
+
+using DataLayoutLds = WarpTileConfig::lds_layout;
+
+// Warp tile: computed by each warp
+constexpr uint32_t WARP_TILE_X = BLOCKS_X * ROCWMMA_M;
+constexpr uint32_t WARP_TILE_Y = BLOCKS_Y * ROCWMMA_N;
+
+// Macro Tile: computed by each thread block (workgroup)
+constexpr uint32_t WARPS_X      = TBLOCK_X / WARP_SIZE;
+constexpr uint32_t WARPS_Y      = TBLOCK_Y;
+constexpr uint32_t MACRO_TILE_X = WARPS_X * WARP_TILE_X;
+constexpr uint32_t MACRO_TILE_Y = WARPS_Y * WARP_TILE_Y;
+
+// Macro tiles along N per workgroup. The A fragments of each K step are shared by all of them.
+constexpr uint32_t N_TILES = 2u;
+
+// Quantize and row amax passes
+constexpr uint32_t PASS_BLOCK = 256u;
+
+// Mfma frags
+using MfmaFragA   = fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, InputT, DataLayoutA>;
+using MfmaFragB   = fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, InputT, DataLayoutB>;
+using MfmaFragD   = fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, OutputT, DataLayoutC>;
+using MfmaFragQ   = fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, QuantT, DataLayoutC>;
+using MfmaFragAcc = fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, ComputeT>;
+
+// Warp tile of mfma frags
+using MfmaTileA   = fragment_array<MfmaFragA, BLOCKS_X, 1u>;
+using MfmaTileB   = fragment_array<MfmaFragB, 1u, BLOCKS_Y>;
+using MfmaTileD   = fragment_array<MfmaFragD, BLOCKS_X, BLOCKS_Y>;
+using MfmaTileQ   = fragment_array<MfmaFragQ, BLOCKS_X, BLOCKS_Y>;
+using MfmaTileAcc = fragment_array<MfmaFragAcc, BLOCKS_X, BLOCKS_Y>;
+
+// Global read (macro tile). B holds the N_TILES macro tiles of the workgroup.
+using GRBuffA = fragment<matrix_a, MACRO_TILE_X, ROCWMMA_N, ROCWMMA_K, InputT, DataLayoutA>;
+using GRBuffB
+    = fragment<matrix_b, ROCWMMA_M, N_TILES * MACRO_TILE_Y, ROCWMMA_K, InputT, DataLayoutB>;
+
+// Double buffered LDS staging of the global buffers (macro tile)
+using LdsPipeline
+    = lds_pipeline<2u, WARPS_X * WARPS_Y, GRBuffA, GRBuffB, DataLayoutLds, lds_access>;
+
+// Row amax exchange: one vector of MACRO_TILE_X rows per warp column, after the K loop
+constexpr uint32_t LDS_AMAX_BYTES = WARPS_Y * MACRO_TILE_X * sizeof(ComputeT);
+static_assert(LDS_AMAX_BYTES <= LdsPipeline::size_bytes, "Row amax must fit the LDS stages");
+
+// Computes the N_TILES macro tiles of D = A x B of the workgroup at blockIdx, and its row amax.
+// With Quantize, each workgroup must span the whole of N: Q and the dequantization scales
+// are written. Otherwise D is written, and the row amax to amaxPartials[blockIdx.y * m + row].
+// Matrix sizes must be multiples of the workgroup tile size.
+template <bool Quantize>
+ROCWMMA_KERNEL void __launch_bounds__(256) gemm_dynquant_rocwmma_d(uint32_t      m,
+                                                                   uint32_t      k,
+                                                                   InputT const* a,
+                                                                   InputT const* b,
+                                                                   OutputT*      d,
+                                                                   QuantT*       q,
+                                                                   ComputeT*     scales,
+                                                                   ComputeT*     amaxPartials,
+                                                                   uint32_t      lda,
+                                                                   uint32_t      ldb,
+                                                                   uint32_t      ldd)
+{
+    if constexpr(!ROCWMMA_ARCH_HOST)
+    {
+        HIP_DYNAMIC_SHARED(void*, localMemPtr);
+
+        // Tile Sizes
+        constexpr auto warpTileSize  = make_coord2d(WARP_TILE_X, WARP_TILE_Y);
+        constexpr auto macroTileSize = make_coord2d(MACRO_TILE_X, N_TILES * MACRO_TILE_Y);
+
+        // Local warp coordinate relative to current threadblock (wg).
+        auto localWarpCoord  = make_coord2d(threadIdx.x / WARP_SIZE, threadIdx.y);
+        auto localWarpOffset = localWarpCoord * warpTileSize;
+
+        // Global matrix coordinates of the first macro tile of the workgroup
+        auto macroTileCoord = make_coord2d(blockIdx.x, blockIdx.y) * macroTileSize;
+        auto warpTileCoord  = macroTileCoord + localWarpOffset;
+
+        ///
+        /// 1D global read coordinate setup
+        ///
+        using GRBuffAMap1d = GetDataLayout_t<GRBuffA>;
+        using GRBuffBMap1d = GetDataLayout_t<GRBuffB>;
+
+        auto globalReadOffsetA
+            = GRBuffAMap1d::fromMatrixCoord(make_coord2d(get<0>(macroTileCoord), 0u), lda);
+        auto globalReadOffsetB
+            = GRBuffBMap1d::fromMatrixCoord(make_coord2d(0u, get<1>(macroTileCoord)), ldb);
+
+        auto kStepOffsetA = GRBuffAMap1d::fromMatrixCoord(make_coord2d(0u, ROCWMMA_K), lda);
+        auto kStepOffsetB = GRBuffBMap1d::fromMatrixCoord(make_coord2d(ROCWMMA_K, 0u), ldb);
+
+        // Warps cooperate in row major order
+        const auto warpIndex = get<0>(localWarpCoord) * WARPS_Y + get<1>(localWarpCoord);
+
+        LdsPipeline pipeline(reinterpret_cast<InputT*>(localMemPtr), warpIndex);
+
+        ///
+        /// Perform initial global pre-fetch and write to local
+        ///
+        pipeline.global_read(a + globalReadOffsetA, lda, b + globalReadOffsetB, ldb);
+        globalReadOffsetA += kStepOffsetA;
+        globalReadOffsetB += kStepOffsetB;
+        pipeline.local_write();
+
+        MfmaTileAcc fragsAcc[N_TILES];
+#pragma unroll
+        for(uint32_t t = 0u; t < N_TILES; t++)
+        {
+            fill_fragment(fragsAcc[t], 0.0f);
+        }
+
+        synchronize_workgroup();
+
+        // Local reads A once per K step, and multiplies it into each macro tile of B
+        auto localReadMma = [&]() {
+            MfmaTileA fragsA;
+            pipeline.local_read_a(fragsA, get<0>(localWarpOffset));
+
+#pragma unroll
+            for(uint32_t t = 0u; t < N_TILES; t++)
+            {
+                MfmaTileB fragsB;
+                pipeline.local_read_b(fragsB, t * MACRO_TILE_Y + get<1>(localWarpOffset));
+                mma_sync(fragsAcc[t], fragsA, fragsB, fragsAcc[t]);
+            }
+        };
+
+        auto kSteps = k / ROCWMMA_K;
+        for(uint32_t step = 1u; step < kSteps; step++)
+        {
+            // Prefetch next round of global frags, then accumulate the read stage
+            pipeline.global_read(a + globalReadOffsetA, lda, b + globalReadOffsetB, ldb);
+            globalReadOffsetA += kStepOffsetA;
+            globalReadOffsetB += kStepOffsetB;
+
+            localReadMma();
+
+            // Write prefetch to the write stage
+            pipeline.local_write();
+
+            // Make sure that all waves have finished reading / writing to lds for this step.
+            synchronize_workgroup();
+
+            pipeline.advance();
+        }
+
+        // Tail A * B
+        localReadMma();
+
+        ///
+        /// Row amax of the warp tile, over its blocks of all macro tiles
+        ///
+        MfmaFragAcc fragsAmax[BLOCKS_X];
+#pragma unroll
+        for(uint32_t i = 0u; i < BLOCKS_X; i++)
+        {
+            fill_fragment(fragsAmax[i], 0.0f);
+#pragma unroll
+            for(uint32_t t = 0u; t < N_TILES; t++)
+            {
+#pragma unroll
+                for(uint32_t j = 0u; j < BLOCKS_Y; j++)
+                {
+#pragma unroll
+                    for(uint32_t e = 0u; e < MfmaFragAcc::num_elements; e++)
+                    {
+                        fragsAmax[i].x[e] = fmaxf(fragsAmax[i].x[e], fabsf(fragsAcc[t](i, j).x[e]));
+                    }
+                }
+            }
+            fragsAmax[i] = reduce_rows<reduce::Max>(fragsAmax[i]);
+        }
+
+        ///
+        /// Workgroup row amax: combine the warps sharing rows through LDS.
+        /// The LDS stages are free once all warps have passed the barrier.
+        ///
+        auto ldsAmax = reinterpret_cast<ComputeT*>(localMemPtr);
+        auto ldsRow  = get<1>(localWarpCoord) * MACRO_TILE_X + get<0>(localWarpOffset);
+
+        synchronize_workgroup();
+#pragma unroll
+        for(uint32_t i = 0u; i < BLOCKS_X; i++)
+        {
+            store_col_vector_sync(ldsAmax + ldsRow + i * ROCWMMA_M, fragsAmax[i]);
+        }
+        synchronize_workgroup();
+
+#pragma unroll
+        for(uint32_t i = 0u; i < BLOCKS_X; i++)
+        {
+            for(uint32_t w = 0u; w < WARPS_Y; w++)
+            {
+                MfmaFragAcc fragPeer;
+                load_col_vector_sync(
+                    fragPeer, ldsAmax + w * MACRO_TILE_X + get<0>(localWarpOffset) + i * ROCWMMA_M);
+#pragma unroll
+                for(uint32_t e = 0u; e < MfmaFragAcc::num_elements; e++)
+                {
+                    fragsAmax[i].x[e] = fmaxf(fragsAmax[i].x[e], fragPeer.x[e]);
+                }
+            }
+        }
+
+        // The first warp column writes the row vectors
+        bool writeRows = get<1>(localWarpCoord) == 0u;
+
+        ///
+        /// Single pass: Q = quantize(acc) with the row amax, and the dequantization scales
+        ///
+        if constexpr(Quantize)
+        {
+            using MfmaFragQMap1d = GetDataLayout_t<MfmaFragQ>;
+
+#pragma unroll
+            for(uint32_t t = 0u; t < N_TILES; t++)
+            {
+                MfmaTileQ fragsQ;
+#pragma unroll
+                for(uint32_t i = 0u; i < BLOCKS_X; i++)
+                {
+#pragma unroll
+                    for(uint32_t j = 0u; j < BLOCKS_Y; j++)
+                    {
+                        apply_epilogue(
+                            fragsQ(i, j),
+                            fragsAcc[t](i, j),
+                            epilogue::DynamicQuantize<MfmaFragAcc, QuantT>(fragsAmax[i]));
+                    }
+                }
+
+                auto tileCoord = warpTileCoord + make_coord2d(0u, t * MACRO_TILE_Y);
+                store_matrix_sync(q + MfmaFragQMap1d::fromMatrixCoord(tileCoord, ldd), fragsQ, ldd);
+            }
+
+            if(writeRows)
+            {
+                constexpr auto quantMax = static_cast<ComputeT>(numeric_limits<QuantT>::max());
+#pragma unroll
+                for(uint32_t i = 0u; i < BLOCKS_X; i++)
+                {
+                    MfmaFragAcc fragScale;
+                    apply_epilogue(fragScale, fragsAmax[i], epilogue::TensorScale(1.0f / quantMax));
+                    store_col_vector_sync(
+                        scales + get<0>(warpTileCoord) + i * ROCWMMA_M, fragScale);
+                }
+            }
+        }
+        ///
+        /// Two phases: D and the row amax partials of the workgroup
+        ///
+        else
+        {
+            using MfmaFragDMap1d = GetDataLayout_t<MfmaFragD>;
+
+#pragma unroll
+            for(uint32_t t = 0u; t < N_TILES; t++)
+            {
+                MfmaTileD fragsD;
+#pragma unroll
+                for(uint32_t i = 0u; i < BLOCKS_X; i++)
+                {
+#pragma unroll
+                    for(uint32_t j = 0u; j < BLOCKS_Y; j++)
+                    {
+                        apply_epilogue(fragsD(i, j), fragsAcc[t](i, j));
+                    }
+                }
+
+                auto tileCoord = warpTileCoord + make_coord2d(0u, t * MACRO_TILE_Y);
+                store_matrix_sync(d + MfmaFragDMap1d::fromMatrixCoord(tileCoord, ldd), fragsD, ldd);
+            }
+
+            if(writeRows)
+            {
+                auto partials = amaxPartials + blockIdx.y * m + get<0>(warpTileCoord);
+#pragma unroll
+                for(uint32_t i = 0u; i < BLOCKS_X; i++)
+                {
+                    store_col_vector_sync(partials + i * ROCWMMA_M, fragsAmax[i]);
+                }
+            }
+        }
+    }
+}
+
+// Row amax of the m x n row major D, as a single partial: one thread per row.
+// Only used by the unfused path.
+ROCWMMA_KERNEL void __launch_bounds__(PASS_BLOCK)
+    row_amax_d(uint32_t m, uint32_t n, OutputT const* d, ComputeT* amax)
+{
+    auto row = blockIdx.x * PASS_BLOCK + threadIdx.x;
+    if(row < m)
+    {
+        auto rowAmax = 0.0f;
+        for(uint32_t col = 0u; col < n; col++)
+        {
+            rowAmax = fmaxf(rowAmax, fabsf(static_cast<ComputeT>(d[row * n + col])));
+        }
+        amax[row] = rowAmax;
+    }
+}
+
+// Quantizes each row of the m x n row major D with the amax reduced over its partials.
+// One workgroup per row.
+ROCWMMA_KERNEL void __launch_bounds__(PASS_BLOCK) quantize_rows_d(uint32_t        m,
+                                                                  uint32_t        n,
+                                                                  uint32_t        partialCount,
+                                                                  OutputT const*  d,
+                                                                  ComputeT const* amaxPartials,
+                                                                  QuantT*         q,
+                                                                  ComputeT*       scales)
+{
+    auto row = blockIdx.x;
+
+    auto rowAmax = 0.0f;
+    for(uint32_t p = 0u; p < partialCount; p++)
+    {
+        rowAmax = fmaxf(rowAmax, amaxPartials[p * m + row]);
+    }
+
+    constexpr auto quantMax = static_cast<ComputeT>(numeric_limits<QuantT>::max());
+    auto           invScale = rowAmax > 0.0f ? quantMax / rowAmax : 0.0f;
+
+    for(uint32_t col = threadIdx.x; col < n; col += PASS_BLOCK)
+    {
+        auto scaled = rintf(static_cast<ComputeT>(d[row * n + col]) * invScale);
+        q[row * n + col] = static_cast<QuantT>(fminf(fmaxf(scaled, -quantMax), quantMax));
+    }
+
+    if(threadIdx.x == 0u)
+    {
+        scales[row] = rowAmax / quantMax;
+    }
+}
+
+ROCWMMA_HOST void dynquant_test(uint32_t m, uint32_t n, uint32_t k)
+{
+    // Runtime checks for host parameters, selected with the same config as the device
+    auto     params       = get_warp_tile_params<InputT>(getGcnArchId());
+    uint32_t hTBLOCK_X    = params.tblock_x;
+    uint32_t hTBLOCK_Y    = params.tblock_y;
+    uint32_t hROCWMMA_K   = params.block_k;
+    uint32_t hWARP_TILE_X = params.blocks_x * params.block_m;
+    uint32_t hWARP_TILE_Y = params.blocks_y * params.block_n;
+
+    // Runtime warp calculation (host code needs to query warpsize dynamically)
+    auto warpSize = getWarpSize();
+    auto macroTileSize
+        = make_coord2d(hTBLOCK_X / warpSize * hWARP_TILE_X, hTBLOCK_Y * hWARP_TILE_Y);
+
+    if(warpSize != params.wave_size)
+    {
+        std::cout << "Unsupported wave size!\n";
+        return;
+    }
+
+    // Each workgroup computes N_TILES macro tiles along N
+    auto wgTileN = N_TILES * get<1>(macroTileSize);
+    if(m % get<0>(macroTileSize) || n % wgTileN || k % hROCWMMA_K)
+    {
+        std::cout << "Unsupported matrix size!\n";
+        return;
+    }
+
+    // Single pass when one workgroup spans N
+    bool singlePass = (n == wgTileN);
+
+    // A is col major (M x K), B is row major (K x N), D and Q are row major (M x N)
+    uint32_t lda = m;
+    uint32_t ldb = n;
+    uint32_t ldd = n;
+
+    std::cout << "Initializing host data..." << std::endl;
+
+    std::vector<InputT> matrixA(m * k);
+    std::vector<InputT> matrixB(k * n);
+
+    fillRand(matrixA.data(), m, k);
+    fillRand(matrixB.data(), k, n);
+
+    std::cout << "Initializing device data..." << std::endl;
+
+    InputT*   d_a;
+    InputT*   d_b;
+    OutputT*  d_d;
+    QuantT*   d_q;
+    ComputeT* d_scales;
+    ComputeT* d_amaxPartials;
+
+    auto gridDim      = dim3(m / get<0>(macroTileSize), n / wgTileN);
+    auto partialCount = gridDim.y;
+
+    const size_t bytesA        = matrixA.size() * sizeof(InputT);
+    const size_t bytesB        = matrixB.size() * sizeof(InputT);
+    const size_t bytesD        = m * n * sizeof(OutputT);
+    const size_t bytesQ        = m * n * sizeof(QuantT);
+    const size_t bytesScales   = m * sizeof(ComputeT);
+    const size_t bytesPartials = partialCount * m * sizeof(ComputeT);
+
+    CHECK_HIP_ERROR(hipMalloc(&d_a, bytesA));
+    CHECK_HIP_ERROR(hipMalloc(&d_b, bytesB));
+    CHECK_HIP_ERROR(hipMalloc(&d_d, bytesD));
+    CHECK_HIP_ERROR(hipMalloc(&d_q, bytesQ));
+    CHECK_HIP_ERROR(hipMalloc(&d_scales, bytesScales));
+    CHECK_HIP_ERROR(hipMalloc(&d_amaxPartials, bytesPartials));
+
+    CHECK_HIP_ERROR(hipMemcpy(d_a, matrixA.data(), bytesA, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_b, matrixB.data(), bytesB, hipMemcpyHostToDevice));
+
+    auto blockDim = dim3(hTBLOCK_X, hTBLOCK_Y);
+
+    // LDS stages of A and the N_TILES macro tiles of B. The row amax exchange reuses them.
+    uint32_t ldsusage = 2u * sizeof(InputT) * (get<0>(macroTileSize) + wgTileN) * hROCWMMA_K;
+
+    std::cout << "gridDim (" << gridDim.x << " " << gridDim.y << ")"
+              << " blockdim (" << blockDim.x << " " << blockDim.y << ")" << std::endl;
+
+    auto gemmKernel = [&](auto quantize) {
+        hipExtLaunchKernelGGL((gemm_dynquant_rocwmma_d<decltype(quantize)::value>),
+                              gridDim,
+                              blockDim,
+                              ldsusage,
+                              0,
+                              nullptr,
+                              nullptr,
+                              0,
+                              m,
+                              k,
+                              d_a,
+                              d_b,
+                              d_d,
+                              d_q,
+                              d_scales,
+                              d_amaxPartials,
+                              lda,
+                              ldb,
+                              ldd);
+    };
+
+    auto quantizeKernel = [&](uint32_t count) {
+        hipExtLaunchKernelGGL(quantize_rows_d,
+                              dim3(m),
+                              dim3(PASS_BLOCK),
+                              0,
+                              0,
+                              nullptr,
+                              nullptr,
+                              0,
+                              m,
+                              n,
+                              count,
+                              d_d,
+                              d_amaxPartials,
+                              d_q,
+                              d_scales);
+    };
+
+    // GEMM, row amax pass and quantize pass, each reading D
+    auto unfusedKernel = [&]() {
+        gemmKernel(std::false_type{});
+        hipExtLaunchKernelGGL(row_amax_d,
+                              dim3(ceilDiv(m, PASS_BLOCK)),
+                              dim3(PASS_BLOCK),
+                              0,
+                              0,
+                              nullptr,
+                              nullptr,
+                              0,
+                              m,
+                              n,
+                              d_d,
+                              d_amaxPartials);
+        quantizeKernel(1u);
+    };
+
+    // Epilogue row amax: single pass, or the quantize pass over the partials
+    auto fusedKernel = [&]() {
+        if(singlePass)
+        {
+            gemmKernel(std::true_type{});
+        }
+        else
+        {
+            gemmKernel(std::false_type{});
+            quantizeKernel(partialCount);
+        }
+    };
+
+    // Runs are timed individually, with warm and cold caches
+    BenchmarkHarness harness;
+
+    auto echo = [&](const char* kernelName, auto&& kernel) {
+        auto gFlops = calculateGFlops(m, n, k);
+
+        for(auto cacheState :
+            {BenchmarkHarness::CacheState::Warm, BenchmarkHarness::CacheState::Cold})
+        {
+            auto stats        = harness.run(kernel, cacheState);
+            auto tFlopsPerSec = calculateTFlopsPerSec(m, n, k, stats.mMedianMs);
+
+            std::cout << kernelName << ", " << hTBLOCK_X << ", " << hTBLOCK_Y << ", "
+                      << params.blocks_x << ", " << params.blocks_y << ", " << params.block_m
+                      << ", " << params.block_n << ", " << hROCWMMA_K << ", " << m << ", " << n
+                      << ", " << k << ", "
+                      << (cacheState == BenchmarkHarness::CacheState::Warm ? "warm" : "cold")
+                      << ", " << stats.mMedianMs << ", " << gFlops << ", " << tFlopsPerSec
+                      << ", ";
+            BenchmarkHarness::printStats(std::cout, stats) << std::endl;
+        }
+    };
+
+#if !NDEBUG
+
+    // Reference D in ComputeT, then the row scales and Q
+    std::vector<ComputeT> matrixD_ref(m * n, 0.0f);
+    std::vector<ComputeT> vectorScales_ref(m);
+    std::vector<QuantT>   matrixQ_ref(m * n);
+
+    gemm_cpu_h<InputT, ComputeT, ComputeT, DataLayoutA, DataLayoutB, DataLayoutC>(
+        m,
+        n,
+        k,
+        matrixA.data(),
+        matrixB.data(),
+        matrixD_ref.data(),
+        matrixD_ref.data(),
+        lda,
+        ldb,
+        ldd,
+        ldd,
+        1.0f,
+        0.0f);
+
+    auto quantMax = static_cast<ComputeT>(std::numeric_limits<QuantT>::max());
+    for(uint32_t row = 0u; row < m; row++)
+    {
+        auto rowAmax = 0.0f;
+        for(uint32_t col = 0u; col < n; col++)
+        {
+            rowAmax = std::max(rowAmax, std::abs(matrixD_ref[row * n + col]));
+        }
+
+        auto invScale = rowAmax > 0.0f ? quantMax / rowAmax : 0.0f;
+        for(uint32_t col = 0u; col < n; col++)
+        {
+            auto scaled = std::rint(matrixD_ref[row * n + col] * invScale);
+            matrixQ_ref[row * n + col]
+                = static_cast<QuantT>(std::min(std::max(scaled, -quantMax), quantMax));
+        }
+        vectorScales_ref[row] = rowAmax / quantMax;
+    }
+
+    auto validate = [&]() {
+        std::vector<QuantT>   matrixQ(m * n);
+        std::vector<ComputeT> vectorScales(m);
+        CHECK_HIP_ERROR(hipMemcpy(matrixQ.data(), d_q, bytesQ, hipMemcpyDeviceToHost));
+        CHECK_HIP_ERROR(
+            hipMemcpy(vectorScales.data(), d_scales, bytesScales, hipMemcpyDeviceToHost));
+
+        // The two phase and unfused paths quantize D in OutputT, which may move values
+        // across a rounding boundary: allow 1 step of QuantT.
+        auto maxStepError = 0;
+        for(uint32_t i = 0u; i < m * n; i++)
+        {
+            maxStepError = std::max(maxStepError, std::abs(matrixQ[i] - matrixQ_ref[i]));
+        }
+
+        // Scales differ by the rounding of the amax to OutputT, at most
+        auto tolerance = 1.0e-3 / std::numeric_limits<ComputeT>::epsilon();
+        auto res = compareEqual(vectorScales.data(), vectorScales_ref.data(), m, tolerance);
+
+        std::cout << "Q: " << (maxStepError <= 1 ? "PASSED" : "FAILED")
+                  << ", max step error: " << maxStepError << std::endl;
+        std::cout << "Scales: " << (std::get<0>(res) ? "PASSED" : "FAILED")
+                  << ", max relative error: " << std::get<1>(res) << std::endl;
+    };
+
+#endif // !NDEBUG
+
+    std::cout << "Kernel, TBlockX, TBlockY, BlocksX, BlocksY, BlkM, BlkN, BlkK, "
+              << "MatM, MatN, MatK, Cache, elapsedMs, Problem Size(GFlops), TFlops/s, "
+              << BenchmarkHarness::statsHeader() << std::endl;
+
+    echo("Unfused", unfusedKernel);
+
+#if !NDEBUG
+    validate();
+#endif // !NDEBUG
+
+    // Poison the outputs to catch results left over from the unfused run
+    CHECK_HIP_ERROR(hipMemset(d_q, 0x7F, bytesQ));
+    CHECK_HIP_ERROR(hipMemset(d_scales, 0xFF, bytesScales));
+
+    echo(singlePass ? "FusedSinglePass" : "FusedTwoPhase", fusedKernel);
+
+#if !NDEBUG
+    validate();
+#endif // !NDEBUG
+
+    // Release device memory
+    CHECK_HIP_ERROR(hipFree(d_a));
+    CHECK_HIP_ERROR(hipFree(d_b));
+    CHECK_HIP_ERROR(hipFree(d_d));
+    CHECK_HIP_ERROR(hipFree(d_q));
+    CHECK_HIP_ERROR(hipFree(d_scales));
+    CHECK_HIP_ERROR(hipFree(d_amaxPartials));
+
+    std::cout << "Finished!" << std::endl;
+}
+
+int main()
+{
+    // Narrow output spanned by one workgroup: single pass
+    dynquant_test(4096, N_TILES * MACRO_TILE_Y, 4096);
+
+    // Transformer projections: two phases
+    dynquant_test(4096, 4096, 4096);
+    dynquant_test(4096, 11008, 4096);
+
+    return 0;
+}
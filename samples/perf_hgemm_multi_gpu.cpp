@@ -0,0 +1,602 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_fp16.h>
+#include <hip/hip_runtime.h>
+
+#include <rocwmma/rocwmma.hpp>
+
+#include "common.hpp"
+
+using rocwmma::accumulator;
+using rocwmma::col_major;
+using rocwmma::float16_t;
+using rocwmma::float32_t;
+using rocwmma::float64_t;
+using rocwmma::matrix_a;
+using rocwmma::matrix_b;
+using rocwmma::row_major;
+
+/* Motivation
+*
+* Tensor parallel GEMM splits the weights of a layer across the GPUs of a node.
+* With a column-parallel split, each of G devices holds the full activations A
+* and owns N / G columns of the weights B, so it computes a vertical slice of D:
+*
+*            GPU0  GPU1  GPU2  GPU3
+*           |<---->|<---->|<---->|<---->|
+*     D  =  |  D0  |  D1  |  D2  |  D3  |   Dg = alpha * (A x Bg) + beta * Cg
+*
+* Consumers of D need every slice, so the slices are all-gathered into a full
+* copy of D on each device. Done naively, the all-gather starts only after the
+* GEMM finishes and the interconnect idles while the CUs work, then the CUs
+* idle while the interconnect works.
+*
+* This sample pipelines the two: each device splits its slice into NUM_CHUNKS
+* row chunks. As soon as the GEMM of a chunk completes, the chunk is copied to
+* every peer over peer-to-peer (XGMI on MI300X) while the GEMM of the next
+* chunk runs:
+*
+*     compute  | gemm c0 | gemm c1 | gemm c2 | gemm c3 |
+*     peer 1             | copy c0 | copy c1 | copy c2 | copy c3 |
+*     peer 2             | copy c0 | copy c1 | copy c2 | copy c3 |
+*
+* Each device has one compute stream and one copy stream per peer, so that
+* copies to different peers use their links concurrently. Events recorded on
+* the compute stream after each chunk gate the copies of that chunk.
+*
+* The benchmark runs 1, 2, 4 and 8 GPUs, as available, and for each count reports:
+* - Compute: the chunked GEMM alone, without the all-gather
+* - Serial:  a single chunk, so the all-gather follows the GEMM
+* - Overlap: NUM_CHUNKS chunks with the all-gather pipelined
+*
+* Note: All participating devices must have peer access to each other.
+* Note: Timing uses the host clock, because no single device event covers
+* work on all devices.
+*/
+
+// Supports ROCWMMA_M/N square sizes of
+// : 16 x 16
+// : 32 x 32 ( only MI )
+const int ROCWMMA_M = 16;
+const int ROCWMMA_N = 16;
+
+// Supports ROCWMMA_K sizes as
+// : multiples of 16.
+const int ROCWMMA_K = 16;
+
+// Each wave computes BLOCKS_X x BLOCKS_Y fragments of output, reusing each
+// A fragment across BLOCKS_Y and each B fragment across BLOCKS_X.
+const int BLOCKS_X    = 2;
+const int BLOCKS_Y    = 2;
+const int WAVE_TILE_M = BLOCKS_X * ROCWMMA_M;
+const int WAVE_TILE_N = BLOCKS_Y * ROCWMMA_N;
+
+// Device warp size
+const uint32_t WAVE_SIZE = getWarpSize();
+
+// Thread block
+// : T_BLOCK_X must be multiple of WAVE_SIZE.
+const int T_BLOCK_X = 4 * WAVE_SIZE;
+const int T_BLOCK_Y = 4;
+
+// Pipeline depth of the all-gather
+const uint32_t NUM_CHUNKS = 4u;
+
+// Upper bound on the scaling benchmark
+const int MAX_GPUS = 8;
+
+// Benchmark runs
+const uint32_t WARMUP_RUNS = 2u;
+const uint32_t TIMED_RUNS  = 10u;
+
+// Register blocked GEMM, each wave computing a WAVE_TILE_M x WAVE_TILE_N
+// output tile of D = alpha * (A x B) + beta * C.
+//
+// : A is in row-major format     (M x K)
+// : B is in col-major format     (K x N)
+// : C, D are in row-major format (M x N)
+//
+// Pointers and leading dimensions describe the sub-matrices of one chunk.
+__global__ void hgemm_rocwmma_d(uint32_t         m,
+                                uint32_t         n,
+                                uint32_t         k,
+                                float16_t const* a,
+                                float16_t const* b,
+                                float16_t const* c,
+                                float16_t*       d,
+                                uint32_t         lda,
+                                uint32_t         ldb,
+                                uint32_t         ldc,
+                                uint32_t         ldd,
+                                float32_t        alpha,
+                                float32_t        beta)
+{
+    using FragA
+        = rocwmma::fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, row_major>;
+    using FragB
+        = rocwmma::fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, col_major>;
+    using FragC   = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t>;
+    using FragAcc = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float32_t>;
+
+    // Tile using a 2D grid
+    auto majorWarp = (blockIdx.x * blockDim.x + threadIdx.x) / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    auto minorWarp = (blockIdx.y * blockDim.y + threadIdx.y);
+
+    // Target C tile
+    auto cRow = majorWarp * WAVE_TILE_M;
+    auto cCol = minorWarp * WAVE_TILE_N;
+
+    // Bounds check
+    if(cRow < m && cCol < n)
+    {
+        FragAcc fragsAcc[BLOCKS_X][BLOCKS_Y];
+        for(int i = 0; i < BLOCKS_X; ++i)
+        {
+            for(int j = 0; j < BLOCKS_Y; ++j)
+            {
+                rocwmma::fill_fragment(fragsAcc[i][j], 0.0f);
+            }
+        }
+
+        // fragsAcc = A x B
+        for(int h = 0; h < k; h += ROCWMMA_K)
+        {
+            FragA fragsA[BLOCKS_X];
+            FragB fragsB[BLOCKS_Y];
+
+            for(int i = 0; i < BLOCKS_X; ++i)
+            {
+                rocwmma::load_matrix_sync(fragsA[i], a + ((cRow + i * ROCWMMA_M) * lda + h), lda);
+            }
+            for(int j = 0; j < BLOCKS_Y; ++j)
+            {
+                rocwmma::load_matrix_sync(fragsB[j], b + (h + (cCol + j * ROCWMMA_N) * ldb), ldb);
+            }
+
+            for(int i = 0; i < BLOCKS_X; ++i)
+            {
+                for(int j = 0; j < BLOCKS_Y; ++j)
+                {
+                    rocwmma::mma_sync(fragsAcc[i][j], fragsA[i], fragsB[j], fragsAcc[i][j]);
+                }
+            }
+        }
+
+        // D = alpha * A x B + beta * C
+        for(int i = 0; i < BLOCKS_X; ++i)
+        {
+            for(int j = 0; j < BLOCKS_Y; ++j)
+            {
+                auto  offsetRow = cRow + i * ROCWMMA_M;
+                auto  offsetCol = cCol + j * ROCWMMA_N;
+                FragC fragC;
+
+                rocwmma::load_matrix_sync(
+                    fragC, c + (offsetRow * ldc + offsetCol), ldc, rocwmma::mem_row_major);
+
+                for(int e = 0; e < fragC.num_elements; ++e)
+                {
+                    fragC.x[e] = alpha * fragsAcc[i][j].x[e] + beta * fragC.x[e];
+                }
+
+                rocwmma::store_matrix_sync(
+                    d + (offsetRow * ldd + offsetCol), fragC, ldd, rocwmma::mem_row_major);
+            }
+        }
+    }
+}
+
+// Per device resources. Every device holds full copies of A, B, C and D so
+// that any slice can be computed locally and any slice can be gathered.
+struct DeviceContext
+{
+    int                      mDevice;
+    hipStream_t              mComputeStream;
+    std::vector<hipStream_t> mCopyStreams; // One per peer
+    std::vector<hipEvent_t>  mChunkEvents;
+
+    float16_t* mA;
+    float16_t* mB;
+    float16_t* mC;
+    float16_t* mD;
+};
+
+enum class PipelineMode
+{
+    Compute,
+    Serial,
+    Overlap
+};
+
+inline char const* pipelineModeString(PipelineMode mode)
+{
+    switch(mode)
+    {
+    case PipelineMode::Compute:
+        return "Compute";
+    case PipelineMode::Serial:
+        return "Serial";
+    case PipelineMode::Overlap:
+    default:
+        return "Overlap";
+    }
+}
+
+inline bool enablePeerAccess(int gpus)
+{
+    for(int dev = 0; dev < gpus; ++dev)
+    {
+        for(int peer = 0; peer < gpus; ++peer)
+        {
+            if(dev == peer)
+            {
+                continue;
+            }
+
+            int canAccess = 0;
+            CHECK_HIP_ERROR(hipDeviceCanAccessPeer(&canAccess, dev, peer));
+            if(!canAccess)
+            {
+                return false;
+            }
+
+            CHECK_HIP_ERROR(hipSetDevice(dev));
+            auto status = hipDeviceEnablePeerAccess(peer, 0);
+            if(status == hipErrorPeerAccessAlreadyEnabled)
+            {
+                // Clear the sticky error
+                (void)hipGetLastError();
+            }
+            else
+            {
+                CHECK_HIP_ERROR(status);
+            }
+        }
+    }
+    return true;
+}
+
+// Enqueue the tensor parallel GEMM and all-gather of D on the first gpus devices.
+// The enqueue loop is chunk-major so that all devices start computing together.
+__host__ void enqueueTensorParallel(std::vector<DeviceContext>& contexts,
+                                    int                         gpus,
+                                    PipelineMode                mode,
+                                    uint32_t                    m,
+                                    uint32_t                    n,
+                                    uint32_t                    k,
+                                    float32_t                   alpha,
+                                    float32_t                   beta)
+{
+    auto chunks  = (mode == PipelineMode::Serial) ? 1u : NUM_CHUNKS;
+    auto nSlice  = n / static_cast<uint32_t>(gpus);
+    auto mChunk  = m / chunks;
+    auto lda     = k;
+    auto ldb     = k;
+    auto ldc     = n;
+    auto ldd     = n;
+    auto rowSize = nSlice * sizeof(float16_t);
+    auto pitch   = ldd * sizeof(float16_t);
+
+    auto blockDim = dim3(T_BLOCK_X, T_BLOCK_Y);
+    auto gridDim  = dim3(rocwmma::ceilDiv(mChunk, WAVE_TILE_M * T_BLOCK_X / WAVE_SIZE),
+                        rocwmma::ceilDiv(nSlice, WAVE_TILE_N * T_BLOCK_Y));
+
+    for(uint32_t chunk = 0; chunk < chunks; ++chunk)
+    {
+        for(int dev = 0; dev < gpus; ++dev)
+        {
+            auto& ctx = contexts[dev];
+            CHECK_HIP_ERROR(hipSetDevice(ctx.mDevice));
+
+            auto rowOffset = chunk * mChunk;
+            auto colOffset = static_cast<uint32_t>(dev) * nSlice;
+
+            hipExtLaunchKernelGGL(hgemm_rocwmma_d,
+                                  gridDim,
+                                  blockDim,
+                                  0, // sharedMemBytes
+                                  ctx.mComputeStream, // stream
+                                  nullptr, // Event start
+                                  nullptr, // event stop
+                                  0, // flags
+                                  mChunk,
+                                  nSlice,
+                                  k,
+                                  ctx.mA + rowOffset * lda,
+                                  ctx.mB + colOffset * ldb,
+                                  ctx.mC + (rowOffset * ldc + colOffset),
+                                  ctx.mD + (rowOffset * ldd + colOffset),
+                                  lda,
+                                  ldb,
+                                  ldc,
+                                  ldd,
+                                  alpha,
+                                  beta);
+
+            if(mode == PipelineMode::Compute)
+            {
+                continue;
+            }
+
+            // Gather this chunk of the slice into the same location of every peer's D
+            CHECK_HIP_ERROR(hipEventRecord(ctx.mChunkEvents[chunk], ctx.mComputeStream));
+            auto chunkOffset = rowOffset * ldd + colOffset;
+            for(int peer = 0; peer < gpus; ++peer)
+            {
+                if(peer == dev)
+                {
+                    continue;
+                }
+
+                auto copyStream = ctx.mCopyStreams[peer];
+                CHECK_HIP_ERROR(hipStreamWaitEvent(copyStream, ctx.mChunkEvents[chunk], 0));
+                CHECK_HIP_ERROR(hipMemcpy2DAsync(contexts[peer].mD + chunkOffset,
+                                                 pitch,
+                                                 ctx.mD + chunkOffset,
+                                                 pitch,
+                                                 rowSize,
+                                                 mChunk,
+                                                 hipMemcpyDeviceToDevice,
+                                                 copyStream));
+            }
+        }
+    }
+}
+
+__host__ void synchronizeAll(std::vector<DeviceContext>& contexts, int gpus)
+{
+    for(int dev = 0; dev < gpus; ++dev)
+    {
+        CHECK_HIP_ERROR(hipSetDevice(contexts[dev].mDevice));
+        CHECK_HIP_ERROR(hipDeviceSynchronize());
+    }
+}
+
+// Median host elapsed time of the pipeline, over all participating devices
+__host__ double timeTensorParallel(std::vector<DeviceContext>& contexts,
+                                   int                         gpus,
+                                   PipelineMode                mode,
+                                   uint32_t                    m,
+                                   uint32_t                    n,
+                                   uint32_t                    k,
+                                   float32_t                   alpha,
+                                   float32_t                   beta)
+{
+    for(uint32_t i = 0; i < WARMUP_RUNS; ++i)
+    {
+        enqueueTensorParallel(contexts, gpus, mode, m, n, k, alpha, beta);
+    }
+    synchronizeAll(contexts, gpus);
+
+    std::vector<double> runTimesMs(TIMED_RUNS);
+    for(auto& runTimeMs : runTimesMs)
+    {
+        auto start = std::chrono::steady_clock::now();
+        enqueueTensorParallel(contexts, gpus, mode, m, n, k, alpha, beta);
+        synchronizeAll(contexts, gpus);
+        auto stop = std::chrono::steady_clock::now();
+
+        runTimeMs = std::chrono::duration<double, std::milli>(stop - start).count();
+    }
+
+    std::sort(runTimesMs.begin(), runTimesMs.end());
+    return runTimesMs[runTimesMs.size() / 2u];
+}
+
+__host__ void gemm_test(uint32_t m, uint32_t n, uint32_t k, float32_t alpha, float32_t beta)
+{
+    int deviceCount = 0;
+    CHECK_HIP_ERROR(hipGetDeviceCount(&deviceCount));
+    auto maxGpus = std::min(deviceCount, MAX_GPUS);
+
+    // Bounds check: every chunk must be a whole number of wave tiles
+    if((m % (NUM_CHUNKS * WAVE_TILE_M)) || (n % WAVE_TILE_N) || (k % ROCWMMA_K))
+    {
+        std::cout << "Unsupported size!\n";
+        return;
+    }
+
+    std::cout << "Initializing host data..." << std::endl;
+
+    // Initialize input matrices
+    std::vector<float16_t> matrixA(m * k);
+    std::vector<float16_t> matrixB(k * n);
+    std::vector<float16_t> matrixC(m * n);
+
+    fillRand(matrixA.data(), m, k);
+    fillRand(matrixB.data(), k, n);
+    fillRand(matrixC.data(), m, n);
+
+    std::cout << "Initializing device data on " << maxGpus << " device(s)..." << std::endl;
+
+    const size_t bytesA = matrixA.size() * sizeof(float16_t);
+    const size_t bytesB = matrixB.size() * sizeof(float16_t);
+    const size_t bytesC = matrixC.size() * sizeof(float16_t);
+    const size_t bytesD = matrixC.size() * sizeof(float16_t);
+
+    std::vector<DeviceContext> contexts(maxGpus);
+    for(int dev = 0; dev < maxGpus; ++dev)
+    {
+        auto& ctx   = contexts[dev];
+        ctx.mDevice = dev;
+        CHECK_HIP_ERROR(hipSetDevice(dev));
+
+        CHECK_HIP_ERROR(hipStreamCreateWithFlags(&ctx.mComputeStream, hipStreamNonBlocking));
+        ctx.mCopyStreams.resize(maxGpus);
+        for(auto& stream : ctx.mCopyStreams)
+        {
+            CHECK_HIP_ERROR(hipStreamCreateWithFlags(&stream, hipStreamNonBlocking));
+        }
+        ctx.mChunkEvents.resize(NUM_CHUNKS);
+        for(auto& event : ctx.mChunkEvents)
+        {
+            CHECK_HIP_ERROR(hipEventCreateWithFlags(&event, hipEventDisableTiming));
+        }
+
+        CHECK_HIP_ERROR(hipMalloc(&ctx.mA, bytesA));
+        CHECK_HIP_ERROR(hipMalloc(&ctx.mB, bytesB));
+        CHECK_HIP_ERROR(hipMalloc(&ctx.mC, bytesC));
+        CHECK_HIP_ERROR(hipMalloc(&ctx.mD, bytesD));
+
+        CHECK_HIP_ERROR(hipMemcpy(ctx.mA, matrixA.data(), bytesA, hipMemcpyHostToDevice));
+        CHECK_HIP_ERROR(hipMemcpy(ctx.mB, matrixB.data(), bytesB, hipMemcpyHostToDevice));
+        CHECK_HIP_ERROR(hipMemcpy(ctx.mC, matrixC.data(), bytesC, hipMemcpyHostToDevice));
+    }
+
+    std::cout << "GPUs, Mode, Chunks, "
+              << "MatM, MatN, MatK, "
+              << "SliceN, "
+              << "elapsedMs(median), Problem Size(GFlops), TFlops/s, "
+              << "Speedup, Scaling Efficiency(%)" << std::endl;
+
+    auto gFlops       = calculateGFlops(m, n, k);
+    auto baselineMs   = 0.0;
+    auto validateGpus = 0;
+
+    for(int gpus = 1; gpus <= maxGpus; gpus *= 2)
+    {
+        // Every slice must be a whole number of wave tiles
+        if(n % (gpus * WAVE_TILE_N))
+        {
+            std::cout << gpus << " GPUs skipped: N is not divisible into slices" << std::endl;
+            break;
+        }
+
+        if(!enablePeerAccess(gpus))
+        {
+            std::cout << gpus << " GPUs skipped: peer access unavailable" << std::endl;
+            break;
+        }
+
+        for(auto mode : {PipelineMode::Compute, PipelineMode::Serial, PipelineMode::Overlap})
+        {
+            // The all-gather is a no-op on one device
+            if(gpus == 1 && mode != PipelineMode::Compute)
+            {
+                continue;
+            }
+
+            auto elapsedMs    = timeTensorParallel(contexts, gpus, mode, m, n, k, alpha, beta);
+            auto tFlopsPerSec = gFlops / elapsedMs;
+            if(gpus == 1)
+            {
+                baselineMs = elapsedMs;
+            }
+
+            auto speedup = baselineMs / elapsedMs;
+            auto chunks  = (mode == PipelineMode::Serial) ? 1u : NUM_CHUNKS;
+
+            std::cout << gpus << ", " << pipelineModeString(mode) << ", " << chunks << ", " << m
+                      << ", " << n << ", " << k << ", " << n / gpus << ", " << elapsedMs << ", "
+                      << gFlops << ", " << tFlopsPerSec << ", " << speedup << ", "
+                      << speedup / gpus * 100.0 << std::endl;
+        }
+
+        validateGpus = gpus;
+    }
+
+#if !NDEBUG
+
+    std::cout << "Validating result with reference..." << std::endl;
+
+    // Gather D on every device, then check every copy
+    for(int dev = 0; dev < validateGpus; ++dev)
+    {
+        CHECK_HIP_ERROR(hipSetDevice(dev));
+        CHECK_HIP_ERROR(hipMemset(contexts[dev].mD, 0xFF, bytesD));
+    }
+    synchronizeAll(contexts, validateGpus);
+    enqueueTensorParallel(contexts, validateGpus, PipelineMode::Overlap, m, n, k, alpha, beta);
+    synchronizeAll(contexts, validateGpus);
+
+    int lda = k;
+    int ldb = k;
+    int ldc = n;
+    int ldd = ldc;
+
+    // Setup and run reference computation
+    std::vector<float16_t> matrixD_ref(m * n, std::numeric_limits<float16_t>::signaling_NaN());
+    gemm_cpu_h<float16_t, float16_t, float32_t, row_major, col_major, row_major>(m,
+                                                                                 n,
+                                                                                 k,
+                                                                                 matrixA.data(),
+                                                                                 matrixB.data(),
+                                                                                 matrixC.data(),
+                                                                                 matrixD_ref.data(),
+                                                                                 lda,
+                                                                                 ldb,
+                                                                                 ldc,
+                                                                                 ldd,
+                                                                                 alpha,
+                                                                                 beta);
+
+    std::vector<float16_t> matrixD(m * n);
+    for(int dev = 0; dev < validateGpus; ++dev)
+    {
+        CHECK_HIP_ERROR(hipSetDevice(dev));
+        CHECK_HIP_ERROR(hipMemcpy(matrixD.data(), contexts[dev].mD, bytesD, hipMemcpyDeviceToHost));
+
+        auto res = compareEqual<float16_t>(matrixD.data(), matrixD_ref.data(), m * n);
+
+        std::cout << "Device " << dev << ": " << (std::get<0>(res) ? "PASSED" : "FAILED")
+                  << ", max relative error: " << std::get<1>(res) << std::endl;
+    }
+
+#endif // !NDEBUG
+
+    // Release device resources
+    for(auto& ctx : contexts)
+    {
+        CHECK_HIP_ERROR(hipSetDevice(ctx.mDevice));
+        CHECK_HIP_ERROR(hipFree(ctx.mA));
+        CHECK_HIP_ERROR(hipFree(ctx.mB));
+        CHECK_HIP_ERROR(hipFree(ctx.mC));
+        CHECK_HIP_ERROR(hipFree(ctx.mD));
+        for(auto& event : ctx.mChunkEvents)
+        {
+            CHECK_HIP_ERROR(hipEventDestroy(event));
+        }
+        for(auto& stream : ctx.mCopyStreams)
+        {
+            CHECK_HIP_ERROR(hipStreamDestroy(stream));
+        }
+        CHECK_HIP_ERROR(hipStreamDestroy(ctx.mComputeStream));
+    }
+
+    std::cout << "Finished!" << std::endl;
+}
+
+int main()
+{
+    gemm_test(8192, 8192, 8192, 2.1f, 2.1f);
+    return 0;
+}
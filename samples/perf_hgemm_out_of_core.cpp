@@ -0,0 +1,602 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_fp16.h>
+#include <hip/hip_runtime.h>
+
+#include <rocwmma/rocwmma.hpp>
+
+#include "common.hpp"
+#include "mapped_file.hpp"
+
+using rocwmma::accumulator;
+using rocwmma::col_major;
+using rocwmma::float16_t;
+using rocwmma::float32_t;
+using rocwmma::matrix_a;
+using rocwmma::matrix_b;
+using rocwmma::row_major;
+
+/* Motivation
+*
+* A GEMM whose operands exceed device memory cannot be uploaded up front. It
+* can still run on the device if D is tiled into PANEL_M x PANEL_N panels and
+* the K dimension into PANEL_K chunks, so that only one panel of A, B and D is
+* resident at a time:
+*
+*              K chunks                          D panels
+*          |<-PANEL_K->|                    |<-PANEL_N->|
+*     A  = | A00 | A01 | ...       D  =     | D00 | D01 | ...
+*          | A10 | A11 | ...                | D10 | D11 | ...
+*
+*     Dij  = alpha * (sum over c of Aic x Bcj) + beta * Cij
+*
+* All host matrices live in pinned memory, so that the panels are copied by DMA
+* at full link bandwidth with hipMemcpy2DAsync straight out of the big strided
+* matrices, without staging. Each D panel is:
+* - seeded with its C panel
+* - accumulated in fp32 one K chunk at a time: the first chunk applies beta,
+*   the following ones accumulate into the panel in place
+* - copied back to the host after the last K chunk
+*
+* Panels are dealt round-robin to NUM_STREAMS streams, each owning its own
+* device buffers. The copies of one stream then overlap the kernels of another,
+* and uploads overlap downloads on the separate DMA engines:
+*
+*     stream 0  | H2D p0 | gemm p0 | D2H p0 | H2D p3 | gemm p3 | ...
+*     stream 1           | H2D p1 | gemm p1 | D2H p1 | H2D p4 | ...
+*     stream 2                    | H2D p2 | gemm p2 | D2H p2 | ...
+*
+* Every D panel reads PANEL_M + PANEL_N rows of length K from the host, so the
+* flops per byte uploaded are PANEL_M * PANEL_N / (PANEL_M + PANEL_N). At the
+* default 2048 x 2048 panels that is 1024 flops per byte: enough to keep the
+* CUs busy behind PCIe, whereas small panels are bound by the link.
+*
+* The benchmark reports for each mode:
+* - Transfer: the copies alone, on NUM_STREAMS streams, the bound of the driver
+* - Serial:   one stream, so copies and kernels alternate
+* - Overlap:  NUM_STREAMS streams, copies overlapped with kernels
+* - Mapped:   as Overlap, with A and B copied straight out of memory mapped
+*             files registered with HIP, as matrices stored on NVMe would be.
+*             The panels of each file are read ahead with madvise on first use,
+*             in the order the copies consume them, so that the sweep starts
+*             before the files are read in full.
+*
+* Note: M, N and K must be multiples of the panel sizes.
+* Note: Device memory use is NUM_STREAMS panels of A, B and D, whatever the
+* problem size.
+*/
+
+// Supports ROCWMMA_M/N square sizes of
+// : 16 x 16
+// : 32 x 32 ( only MI )
+const int ROCWMMA_M = 16;
+const int ROCWMMA_N = 16;
+
+// Supports ROCWMMA_K sizes as
+// : multiples of 16.
+const int ROCWMMA_K = 16;
+
+// Each wave computes BLOCKS_X x BLOCKS_Y fragments of output, reusing each
+// A fragment across BLOCKS_Y and each B fragment across BLOCKS_X.
+const int BLOCKS_X    = 2;
+const int BLOCKS_Y    = 2;
+const int WAVE_TILE_M = BLOCKS_X * ROCWMMA_M;
+const int WAVE_TILE_N = BLOCKS_Y * ROCWMMA_N;
+
+// Device warp size
+const uint32_t WAVE_SIZE = getWarpSize();
+
+// Thread block
+// : T_BLOCK_X must be multiple of WAVE_SIZE.
+const int T_BLOCK_X = 4 * WAVE_SIZE;
+const int T_BLOCK_Y = 4;
+
+// Device resident panel sizes
+const uint32_t PANEL_M = 2048u;
+const uint32_t PANEL_N = 2048u;
+const uint32_t PANEL_K = 2048u;
+
+// Panels in flight
+const uint32_t NUM_STREAMS = 3u;
+
+// Benchmark runs
+const uint32_t WARMUP_RUNS = 1u;
+const uint32_t TIMED_RUNS  = 5u;
+
+// Validation samples of D
+const uint32_t NUM_SAMPLES = 4096u;
+
+// Register blocked GEMM, each wave computing a WAVE_TILE_M x WAVE_TILE_N
+// output tile of D = alpha * (A x B) + beta * C.
+//
+// : A is in row-major format     (M x K)
+// : B is in col-major format     (K x N)
+// : C, D are in row-major format (M x N)
+//
+// C and D may alias, in which case D is accumulated in place.
+__global__ void hgemm_rocwmma_d(uint32_t         m,
+                                uint32_t         n,
+                                uint32_t         k,
+                                float16_t const* a,
+                                float16_t const* b,
+                                float32_t const* c,
+                                float32_t*       d,
+                                uint32_t         lda,
+                                uint32_t         ldb,
+                                uint32_t         ldc,
+                                uint32_t         ldd,
+                                float32_t        alpha,
+                                float32_t        beta)
+{
+    using FragA
+        = rocwmma::fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, row_major>;
+    using FragB
+        = rocwmma::fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, col_major>;
+    using FragAcc = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float32_t>;
+
+    // Tile using a 2D grid
+    auto majorWarp = (blockIdx.x * blockDim.x + threadIdx.x) / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    auto minorWarp = (blockIdx.y * blockDim.y + threadIdx.y);
+
+    // Target C tile
+    auto cRow = majorWarp * WAVE_TILE_M;
+    auto cCol = minorWarp * WAVE_TILE_N;
+
+    // Bounds check
+    if(cRow < m && cCol < n)
+    {
+        FragAcc fragsAcc[BLOCKS_X][BLOCKS_Y];
+        for(int i = 0; i < BLOCKS_X; ++i)
+        {
+            for(int j = 0; j < BLOCKS_Y; ++j)
+            {
+                rocwmma::fill_fragment(fragsAcc[i][j], 0.0f);
+            }
+        }
+
+        // fragsAcc = A x B
+        for(int h = 0; h < k; h += ROCWMMA_K)
+        {
+            FragA fragsA[BLOCKS_X];
+            FragB fragsB[BLOCKS_Y];
+
+            for(int i = 0; i < BLOCKS_X; ++i)
+            {
+                rocwmma::load_matrix_sync(fragsA[i], a + ((cRow + i * ROCWMMA_M) * lda + h), lda);
+            }
+            for(int j = 0; j < BLOCKS_Y; ++j)
+            {
+                rocwmma::load_matrix_sync(fragsB[j], b + (h + (cCol + j * ROCWMMA_N) * ldb), ldb);
+            }
+
+            for(int i = 0; i < BLOCKS_X; ++i)
+            {
+                for(int j = 0; j < BLOCKS_Y; ++j)
+                {
+                    rocwmma::mma_sync(fragsAcc[i][j], fragsA[i], fragsB[j], fragsAcc[i][j]);
+                }
+            }
+        }
+
+        // D = alpha * A x B + beta * C
+        for(int i = 0; i < BLOCKS_X; ++i)
+        {
+            for(int j = 0; j < BLOCKS_Y; ++j)
+            {
+                auto    offsetRow = cRow + i * ROCWMMA_M;
+                auto    offsetCol = cCol + j * ROCWMMA_N;
+                FragAcc fragC;
+
+                rocwmma::load_matrix_sync(
+                    fragC, c + (offsetRow * ldc + offsetCol), ldc, rocwmma::mem_row_major);
+
+                for(int e = 0; e < fragC.num_elements; ++e)
+                {
+                    fragC.x[e] = alpha * fragsAcc[i][j].x[e] + beta * fragC.x[e];
+                }
+
+                rocwmma::store_matrix_sync(
+                    d + (offsetRow * ldd + offsetCol), fragC, ldd, rocwmma::mem_row_major);
+            }
+        }
+    }
+}
+
+// Per stream resources, holding one panel in flight
+struct StreamContext
+{
+    hipStream_t mStream;
+
+    float16_t* mA; // PANEL_M x PANEL_K, row-major
+    float16_t* mB; // PANEL_K x PANEL_N, col-major
+    float32_t* mD; // PANEL_M x PANEL_N, row-major
+};
+
+// Host matrices, either pinned or file backed
+struct HostMatrices
+{
+    float16_t const* mA;
+    float16_t const* mB;
+    float32_t const* mC;
+    float32_t*       mD;
+
+    // Mappings backing A and B, if any
+    MappedFile const* mFileA;
+    MappedFile const* mFileB;
+};
+
+enum class PipelineMode
+{
+    Transfer,
+    Serial,
+    Overlap,
+    Mapped
+};
+
+inline char const* pipelineModeString(PipelineMode mode)
+{
+    switch(mode)
+    {
+    case PipelineMode::Transfer:
+        return "Transfer";
+    case PipelineMode::Serial:
+        return "Serial";
+    case PipelineMode::Overlap:
+        return "Overlap";
+    case PipelineMode::Mapped:
+    default:
+        return "Mapped";
+    }
+}
+
+// Bytes moved over the link by one out-of-core GEMM
+inline double calculateTransferBytes(uint32_t m, uint32_t n, uint32_t k)
+{
+    auto panels  = static_cast<double>(m / PANEL_M) * static_cast<double>(n / PANEL_N);
+    auto bytesAB = panels * (PANEL_M + PANEL_N) * static_cast<double>(k) * sizeof(float16_t);
+    auto bytesCD = 2.0 * static_cast<double>(m) * static_cast<double>(n) * sizeof(float32_t);
+    return bytesAB + bytesCD;
+}
+
+// Enqueue the out-of-core GEMM, dealing the D panels round-robin to the streams.
+__host__ void enqueueOutOfCore(std::vector<StreamContext>& contexts,
+                               uint32_t                    streams,
+                               PipelineMode                mode,
+                               HostMatrices const&         host,
+                               uint32_t                    m,
+                               uint32_t                    n,
+                               uint32_t                    k,
+                               float32_t                   alpha,
+                               float32_t                   beta)
+{
+    auto panelsN = n / PANEL_N;
+    auto panels  = (m / PANEL_M) * panelsN;
+    auto chunks  = k / PANEL_K;
+
+    // Host pitches
+    auto pitchAB = k * sizeof(float16_t);
+    auto pitchCD = n * sizeof(float32_t);
+
+    // Device panel pitches
+    auto rowSizeAB = PANEL_K * sizeof(float16_t);
+    auto rowSizeCD = PANEL_N * sizeof(float32_t);
+
+    auto blockDim = dim3(T_BLOCK_X, T_BLOCK_Y);
+    auto gridDim  = dim3(rocwmma::ceilDiv(PANEL_M, WAVE_TILE_M * T_BLOCK_X / WAVE_SIZE),
+                        rocwmma::ceilDiv(PANEL_N, WAVE_TILE_N * T_BLOCK_Y));
+
+    for(uint32_t panel = 0; panel < panels; ++panel)
+    {
+        auto& ctx       = contexts[panel % streams];
+        auto  rowOffset = (panel / panelsN) * PANEL_M;
+        auto  colOffset = (panel % panelsN) * PANEL_N;
+
+        // Read ahead file backed panels of A and B on their first use
+        if(host.mFileA != nullptr && colOffset == 0u)
+        {
+            host.mFileA->prefetch(rowOffset * pitchAB, PANEL_M * pitchAB);
+        }
+        if(host.mFileB != nullptr && rowOffset == 0u)
+        {
+            host.mFileB->prefetch(colOffset * pitchAB, PANEL_N * pitchAB);
+        }
+
+        // Seed the D panel with C
+        CHECK_HIP_ERROR(hipMemcpy2DAsync(ctx.mD,
+                                         rowSizeCD,
+                                         host.mC + (rowOffset * n + colOffset),
+                                         pitchCD,
+                                         rowSizeCD,
+                                         PANEL_M,
+                                         hipMemcpyHostToDevice,
+                                         ctx.mStream));
+
+        for(uint32_t chunk = 0; chunk < chunks; ++chunk)
+        {
+            auto kOffset = chunk * PANEL_K;
+
+            // A rows and B columns are both contiguous along K
+            CHECK_HIP_ERROR(hipMemcpy2DAsync(ctx.mA,
+                                             rowSizeAB,
+                                             host.mA + (rowOffset * k + kOffset),
+                                             pitchAB,
+                                             rowSizeAB,
+                                             PANEL_M,
+                                             hipMemcpyHostToDevice,
+                                             ctx.mStream));
+            CHECK_HIP_ERROR(hipMemcpy2DAsync(ctx.mB,
+                                             rowSizeAB,
+                                             host.mB + (colOffset * k + kOffset),
+                                             pitchAB,
+                                             rowSizeAB,
+                                             PANEL_N,
+                                             hipMemcpyHostToDevice,
+                                             ctx.mStream));
+
+            if(mode == PipelineMode::Transfer)
+            {
+                continue;
+            }
+
+            // Only the first chunk scales C, the others accumulate
+            hipExtLaunchKernelGGL(hgemm_rocwmma_d,
+                                  gridDim,
+                                  blockDim,
+                                  0, // sharedMemBytes
+                                  ctx.mStream, // stream
+                                  nullptr, // Event start
+                                  nullptr, // event stop
+                                  0, // flags
+                                  PANEL_M,
+                                  PANEL_N,
+                                  PANEL_K,
+                                  ctx.mA,
+                                  ctx.mB,
+                                  ctx.mD,
+                                  ctx.mD,
+                                  PANEL_K,
+                                  PANEL_K,
+                                  PANEL_N,
+                                  PANEL_N,
+                                  alpha,
+                                  chunk == 0u ? beta : 1.0f);
+        }
+
+        CHECK_HIP_ERROR(hipMemcpy2DAsync(host.mD + (rowOffset * n + colOffset),
+                                         pitchCD,
+                                         ctx.mD,
+                                         rowSizeCD,
+                                         rowSizeCD,
+                                         PANEL_M,
+                                         hipMemcpyDeviceToHost,
+                                         ctx.mStream));
+    }
+}
+
+// Median host elapsed time of the pipeline
+__host__ double timeOutOfCore(std::vector<StreamContext>& contexts,
+                              uint32_t                    streams,
+                              PipelineMode                mode,
+                              HostMatrices const&         host,
+                              uint32_t                    m,
+                              uint32_t                    n,
+                              uint32_t                    k,
+                              float32_t                   alpha,
+                              float32_t                   beta)
+{
+    for(uint32_t i = 0; i < WARMUP_RUNS; ++i)
+    {
+        enqueueOutOfCore(contexts, streams, mode, host, m, n, k, alpha, beta);
+    }
+    CHECK_HIP_ERROR(hipDeviceSynchronize());
+
+    std::vector<double> runTimesMs(TIMED_RUNS);
+    for(auto& runTimeMs : runTimesMs)
+    {
+        auto start = std::chrono::steady_clock::now();
+        enqueueOutOfCore(contexts, streams, mode, host, m, n, k, alpha, beta);
+        CHECK_HIP_ERROR(hipDeviceSynchronize());
+        auto stop = std::chrono::steady_clock::now();
+
+        runTimeMs = std::chrono::duration<double, std::milli>(stop - start).count();
+    }
+
+    std::sort(runTimesMs.begin(), runTimesMs.end());
+    return runTimesMs[runTimesMs.size() / 2u];
+}
+
+__host__ void gemm_test(uint32_t m, uint32_t n, uint32_t k, float32_t alpha, float32_t beta)
+{
+    // Bounds check: panels must tile the problem, and wave tiles the panels
+    if((m % PANEL_M) || (n % PANEL_N) || (k % PANEL_K) || (PANEL_M % WAVE_TILE_M)
+       || (PANEL_N % WAVE_TILE_N) || (PANEL_K % ROCWMMA_K))
+    {
+        std::cout << "Unsupported size!\n";
+        return;
+    }
+
+    std::cout << "Initializing pinned host data..." << std::endl;
+
+    const size_t bytesA     = static_cast<size_t>(m) * k * sizeof(float16_t);
+    const size_t bytesB     = static_cast<size_t>(k) * n * sizeof(float16_t);
+    const size_t elementsCD = static_cast<size_t>(m) * n;
+
+    float16_t* matrixA;
+    float16_t* matrixB;
+    float32_t* matrixC;
+    float32_t* matrixD;
+    CHECK_HIP_ERROR(hipHostMalloc(&matrixA, bytesA));
+    CHECK_HIP_ERROR(hipHostMalloc(&matrixB, bytesB));
+    CHECK_HIP_ERROR(hipHostMalloc(&matrixC, elementsCD * sizeof(float32_t)));
+    CHECK_HIP_ERROR(hipHostMalloc(&matrixD, elementsCD * sizeof(float32_t)));
+
+    fillRand(matrixA, m, k);
+    fillRand(matrixB, k, n);
+    fillRand(matrixC, m, n);
+
+    auto tempDir = std::filesystem::temp_directory_path();
+    auto pathA   = (tempDir / "rocwmma_out_of_core_a.bin").string();
+    auto pathB   = (tempDir / "rocwmma_out_of_core_b.bin").string();
+
+    std::cout << "Writing A and B to files in " << tempDir << "..." << std::endl;
+
+    MappedFile::write(pathA.c_str(), matrixA, bytesA);
+    MappedFile::write(pathB.c_str(), matrixB, bytesB);
+
+    // The mappings keep the files alive until they are released
+    MappedFile fileA(pathA.c_str());
+    MappedFile fileB(pathB.c_str());
+    std::filesystem::remove(pathA);
+    std::filesystem::remove(pathB);
+
+    HostMatrices pinned = {matrixA, matrixB, matrixC, matrixD, nullptr, nullptr};
+    HostMatrices mapped
+        = {fileA.data<float16_t>(), fileB.data<float16_t>(), matrixC, matrixD, &fileA, &fileB};
+
+    std::cout << "Initializing device data on " << NUM_STREAMS << " stream(s)..." << std::endl;
+
+    std::vector<StreamContext> contexts(NUM_STREAMS);
+    for(auto& ctx : contexts)
+    {
+        CHECK_HIP_ERROR(hipStreamCreateWithFlags(&ctx.mStream, hipStreamNonBlocking));
+        CHECK_HIP_ERROR(hipMalloc(&ctx.mA, PANEL_M * PANEL_K * sizeof(float16_t)));
+        CHECK_HIP_ERROR(hipMalloc(&ctx.mB, PANEL_K * PANEL_N * sizeof(float16_t)));
+        CHECK_HIP_ERROR(hipMalloc(&ctx.mD, PANEL_M * PANEL_N * sizeof(float32_t)));
+    }
+
+    std::cout << "Mode, Streams, "
+              << "MatM, MatN, MatK, "
+              << "PanelM, PanelN, PanelK, "
+              << "elapsedMs(median), Problem Size(GFlops), TFlops/s, "
+              << "Link(GB/s), Transfer Bound(%)" << std::endl;
+
+    auto gFlops        = calculateGFlops(m, n, k);
+    auto transferBytes = calculateTransferBytes(m, n, k);
+    auto transferMs    = 0.0;
+
+    for(auto mode :
+        {PipelineMode::Transfer, PipelineMode::Serial, PipelineMode::Overlap, PipelineMode::Mapped})
+    {
+        auto const& host = (mode == PipelineMode::Mapped) ? mapped : pinned;
+
+        auto streams      = (mode == PipelineMode::Serial) ? 1u : NUM_STREAMS;
+        auto elapsedMs    = timeOutOfCore(contexts, streams, mode, host, m, n, k, alpha, beta);
+        auto tFlopsPerSec = (mode == PipelineMode::Transfer) ? 0.0 : gFlops / elapsedMs;
+        auto gBytesPerSec = transferBytes / elapsedMs * 1.0e-6;
+        if(mode == PipelineMode::Transfer)
+        {
+            transferMs = elapsedMs;
+        }
+
+        std::cout << pipelineModeString(mode) << ", " << streams << ", " << m << ", " << n << ", "
+                  << k << ", " << PANEL_M << ", " << PANEL_N << ", " << PANEL_K << ", "
+                  << elapsedMs << ", " << gFlops << ", " << tFlopsPerSec << ", " << gBytesPerSec
+                  << ", " << transferMs / elapsedMs * 100.0 << std::endl;
+    }
+
+#if !NDEBUG
+
+    std::cout << "Validating " << NUM_SAMPLES << " samples of the result with reference..."
+              << std::endl;
+
+    // A full host reference is out of reach at out-of-core sizes,
+    // so check a random sample of D against double precision dot products.
+    std::vector<size_t>    sampleIndices(NUM_SAMPLES);
+    std::vector<float32_t> samplesD(NUM_SAMPLES);
+    std::vector<float32_t> samplesRef(NUM_SAMPLES);
+
+#pragma omp parallel for
+    for(int s = 0; s < NUM_SAMPLES; ++s)
+    {
+        auto index = (static_cast<size_t>(s) * 2654435761u) % elementsCD;
+        auto row   = index / n;
+        auto col   = index % n;
+
+        auto accum = 0.0;
+        for(size_t h = 0; h < k; ++h)
+        {
+            accum += static_cast<double>(static_cast<float32_t>(matrixA[row * k + h]))
+                     * static_cast<double>(static_cast<float32_t>(matrixB[col * k + h]));
+        }
+
+        sampleIndices[s] = index;
+        samplesRef[s]    = static_cast<float32_t>(alpha * accum + beta * matrixC[index]);
+    }
+
+    for(auto mode : {PipelineMode::Overlap, PipelineMode::Mapped})
+    {
+        auto const& host = (mode == PipelineMode::Mapped) ? mapped : pinned;
+
+        std::fill(matrixD, matrixD + elementsCD, std::numeric_limits<float32_t>::signaling_NaN());
+        enqueueOutOfCore(contexts, NUM_STREAMS, mode, host, m, n, k, alpha, beta);
+        CHECK_HIP_ERROR(hipDeviceSynchronize());
+
+        for(uint32_t s = 0; s < NUM_SAMPLES; ++s)
+        {
+            samplesD[s] = matrixD[sampleIndices[s]];
+        }
+
+        // fp32 accumulation error grows with the square root of K
+        auto res = compareEqual<float32_t>(samplesD.data(),
+                                           samplesRef.data(),
+                                           NUM_SAMPLES,
+                                           10.0 * std::sqrt(static_cast<double>(k)));
+
+        std::cout << pipelineModeString(mode) << ": " << (std::get<0>(res) ? "PASSED" : "FAILED")
+                  << ", max relative error: " << std::get<1>(res) << std::endl;
+    }
+
+#endif // !NDEBUG
+
+    // Release resources
+    for(auto& ctx : contexts)
+    {
+        CHECK_HIP_ERROR(hipFree(ctx.mA));
+        CHECK_HIP_ERROR(hipFree(ctx.mB));
+        CHECK_HIP_ERROR(hipFree(ctx.mD));
+        CHECK_HIP_ERROR(hipStreamDestroy(ctx.mStream));
+    }
+    CHECK_HIP_ERROR(hipHostFree(matrixA));
+    CHECK_HIP_ERROR(hipHostFree(matrixB));
+    CHECK_HIP_ERROR(hipHostFree(matrixC));
+    CHECK_HIP_ERROR(hipHostFree(matrixD));
+
+    std::cout << "Finished!" << std::endl;
+}
+
+int main()
+{
+    gemm_test(8192, 8192, 8192, 2.1f, 2.1f);
+    return 0;
+}
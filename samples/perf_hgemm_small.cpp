@@ -0,0 +1,549 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_fp16.h>
+#include <hip/hip_runtime.h>
+
+#include <rocwmma/rocwmma.hpp>
+
+#include "common.hpp"
+
+using rocwmma::accumulator;
+using rocwmma::col_major;
+using rocwmma::float16_t;
+using rocwmma::float32_t;
+using rocwmma::matrix_a;
+using rocwmma::matrix_b;
+using rocwmma::row_major;
+
+/* Motivation
+*
+* Online inference runs thousands of tiny GEMMs, where M, N and K are at most
+* a few hundred. Such a GEMM is a handful of MFMA / WMMA blocks: it finishes in
+* a few microseconds, so the time to launch it and to ramp up its first wave of
+* workgroups matters more than the peak throughput of the kernel.
+*
+* This sample times small SHAPES in microseconds, in four modes:
+* - Kernel: device execution time only, from events around each launch
+* - Sync:   host latency of one launch followed by a stream synchronize, as seen
+*           by a caller waiting for each result
+* - Stream: average time per kernel of LAUNCHES_PER_BATCH back-to-back launches
+*           on one stream, where launch overheads overlap with execution
+* - Graph:  the same batch captured once into a hipGraph and replayed, which
+*           removes most of the per-launch host overhead
+*
+* Every mode is also measured with an empty kernel of the same launch
+* configuration. The empty kernel does no work, so its time is the floor of
+* launch and dispatch overheads that no GEMM kernel can beat in that mode.
+* Results are reported as p50 / p99 over SAMPLES, next to the floor and the
+* time over the floor, which is the part a faster kernel could still save.
+*
+* Each shape is run by the same kernel with two launch configurations:
+* - 1 WG: a single workgroup whose waves stride over all output blocks, so
+*         there is no workgroup dispatch ramp at all
+* - Grid: one output block per wave, over as many workgroups as needed, which
+*         needs the least time per wave but the most workgroups to dispatch
+*/
+
+// Supports ROCWMMA_M/N square sizes of
+// : 16 x 16
+// : 32 x 32 ( only MI )
+const int ROCWMMA_M = 16;
+const int ROCWMMA_N = 16;
+
+// Supports ROCWMMA_K sizes as
+// : multiples of 16.
+const int ROCWMMA_K = 16;
+
+// Device warp size
+const uint32_t WAVE_SIZE = getWarpSize();
+
+// Thread block: 4 waves
+const int T_BLOCK_X    = 4 * WAVE_SIZE;
+const int WAVES_PER_WG = T_BLOCK_X / WAVE_SIZE;
+
+// Timed samples of each mode. Stream and graph samples are batches of launches.
+const uint32_t SAMPLES            = 200u;
+const uint32_t WARMUP_SAMPLES     = 20u;
+const uint32_t LAUNCHES_PER_BATCH = 50u;
+
+// Small problem sizes. Dimensions are multiples of the block sizes.
+struct GemmShape
+{
+    uint32_t mM;
+    uint32_t mN;
+    uint32_t mK;
+};
+
+const GemmShape SHAPES[] = {
+    {16u, 16u, 16u},
+    {32u, 32u, 32u},
+    {64u, 64u, 64u},
+    {128u, 128u, 128u},
+    {256u, 256u, 256u},
+    {16u, 256u, 256u}, // Single token decode
+    {256u, 16u, 256u},
+    {64u, 256u, 128u},
+};
+
+// GEMM over ROCWMMA_M x ROCWMMA_N output blocks of D = alpha * (A x B) + beta * C.
+// Each wave strides over the output blocks by the total number of waves, so that
+// the same kernel runs on a single workgroup or one block per wave.
+//
+// : A is in row-major format     (M x K)
+// : B is in col-major format     (K x N)
+// : C, D are in row-major format (M x N)
+__global__ void __launch_bounds__(256) hgemm_rocwmma_small(uint32_t         m,
+                                                           uint32_t         n,
+                                                           uint32_t         k,
+                                                           float16_t const* a,
+                                                           float16_t const* b,
+                                                           float16_t const* c,
+                                                           float16_t*       d,
+                                                           uint32_t         lda,
+                                                           uint32_t         ldb,
+                                                           uint32_t         ldc,
+                                                           uint32_t         ldd,
+                                                           float32_t        alpha,
+                                                           float32_t        beta)
+{
+    using FragA
+        = rocwmma::fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, row_major>;
+    using FragB
+        = rocwmma::fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, col_major>;
+    using FragC   = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t>;
+    using FragAcc = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float32_t>;
+
+    auto wave  = (blockIdx.x * blockDim.x + threadIdx.x) / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    auto waves = gridDim.x * blockDim.x / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+
+    auto blocksN = n / ROCWMMA_N;
+    auto blocks  = (m / ROCWMMA_M) * blocksN;
+
+    for(auto block = wave; block < blocks; block += waves)
+    {
+        auto cRow = (block / blocksN) * ROCWMMA_M;
+        auto cCol = (block % blocksN) * ROCWMMA_N;
+
+        FragA   fragA;
+        FragB   fragB;
+        FragC   fragC;
+        FragAcc fragAcc;
+
+        rocwmma::fill_fragment(fragAcc, 0.0f);
+
+        // fragAcc = A x B
+        for(uint32_t h = 0; h < k; h += ROCWMMA_K)
+        {
+            rocwmma::load_matrix_sync(fragA, a + (cRow * lda + h), lda);
+            rocwmma::load_matrix_sync(fragB, b + (h + cCol * ldb), ldb);
+            rocwmma::mma_sync(fragAcc, fragA, fragB, fragAcc);
+        }
+
+        // D = alpha * A x B + beta * C
+        rocwmma::load_matrix_sync(fragC, c + (cRow * ldc + cCol), ldc, rocwmma::mem_row_major);
+
+        for(int i = 0; i < fragC.num_elements; ++i)
+        {
+            fragC.x[i] = alpha * fragAcc.x[i] + beta * fragC.x[i];
+        }
+
+        rocwmma::store_matrix_sync(d + (cRow * ldd + cCol), fragC, ldd, rocwmma::mem_row_major);
+    }
+}
+
+// Launch overhead floor, with the same signature and launch configuration
+// as the GEMM kernel but no work.
+__global__ void __launch_bounds__(256) empty_kernel(uint32_t,
+                                                    uint32_t,
+                                                    uint32_t,
+                                                    float16_t const*,
+                                                    float16_t const*,
+                                                    float16_t const*,
+                                                    float16_t*,
+                                                    uint32_t,
+                                                    uint32_t,
+                                                    uint32_t,
+                                                    uint32_t,
+                                                    float32_t,
+                                                    float32_t)
+{
+}
+
+using KernelFn = decltype(&hgemm_rocwmma_small);
+
+struct LaunchConfig
+{
+    KernelFn   mKernel;
+    dim3       mGridDim;
+    GemmShape  mShape;
+    float16_t* mA;
+    float16_t* mB;
+    float16_t* mC;
+    float16_t* mD;
+    float32_t  mAlpha;
+    float32_t  mBeta;
+};
+
+// Launches through hipExtLaunchKernelGGL when given events, to time the
+// device execution of this launch only.
+__host__ void launch(LaunchConfig const& config,
+                     hipStream_t         stream,
+                     hipEvent_t          start = nullptr,
+                     hipEvent_t          stop  = nullptr)
+{
+    auto& shape = config.mShape;
+    if(start != nullptr)
+    {
+        hipExtLaunchKernelGGL(config.mKernel,
+                              config.mGridDim,
+                              dim3(T_BLOCK_X),
+                              0, // sharedMemBytes
+                              stream, // stream
+                              start, // Event start
+                              stop, // event stop
+                              0, // flags
+                              shape.mM,
+                              shape.mN,
+                              shape.mK,
+                              config.mA,
+                              config.mB,
+                              config.mC,
+                              config.mD,
+                              shape.mK, // lda
+                              shape.mK, // ldb
+                              shape.mN, // ldc
+                              shape.mN, // ldd
+                              config.mAlpha,
+                              config.mBeta);
+    }
+    else
+    {
+        hipLaunchKernelGGL(config.mKernel,
+                           config.mGridDim,
+                           dim3(T_BLOCK_X),
+                           0, // sharedMemBytes
+                           stream, // stream
+                           shape.mM,
+                           shape.mN,
+                           shape.mK,
+                           config.mA,
+                           config.mB,
+                           config.mC,
+                           config.mD,
+                           shape.mK, // lda
+                           shape.mK, // ldb
+                           shape.mN, // ldc
+                           shape.mN, // ldd
+                           config.mAlpha,
+                           config.mBeta);
+    }
+}
+
+enum LatencyMode : uint32_t
+{
+    Kernel = 0u,
+    Sync,
+    Stream,
+    Graph,
+    NumModes
+};
+
+const char* const MODE_NAMES[NumModes] = {"Kernel", "Sync", "Stream", "Graph"};
+
+// Sorted latency samples in microseconds, per mode
+struct LatencySamples
+{
+    std::vector<double> mUs[NumModes];
+};
+
+// Nearest-rank percentile of sorted samples
+inline double percentile(std::vector<double> const& sorted, double p)
+{
+    auto rank = static_cast<size_t>(std::ceil(p * static_cast<double>(sorted.size())));
+    return sorted[std::max<size_t>(rank, 1u) - 1u];
+}
+
+__host__ LatencySamples measure(LaunchConfig const& config, hipStream_t stream)
+{
+    LatencySamples result;
+
+    // Kernel: events around each launch
+    {
+        std::vector<hipEvent_t> events(2u * SAMPLES);
+        for(auto& event : events)
+        {
+            CHECK_HIP_ERROR(hipEventCreate(&event));
+        }
+
+        for(uint32_t i = 0; i < WARMUP_SAMPLES; ++i)
+        {
+            launch(config, stream);
+        }
+        for(uint32_t i = 0; i < SAMPLES; ++i)
+        {
+            launch(config, stream, events[2u * i], events[2u * i + 1u]);
+        }
+        CHECK_HIP_ERROR(hipStreamSynchronize(stream));
+
+        for(uint32_t i = 0; i < SAMPLES; ++i)
+        {
+            float elapsedMs = 0.0f;
+            CHECK_HIP_ERROR(hipEventElapsedTime(&elapsedMs, events[2u * i], events[2u * i + 1u]));
+            result.mUs[Kernel].push_back(1.0e3 * elapsedMs);
+        }
+
+        for(auto& event : events)
+        {
+            CHECK_HIP_ERROR(hipEventDestroy(event));
+        }
+    }
+
+    // Sync: host clock around each launch and synchronize
+    for(uint32_t i = 0; i < WARMUP_SAMPLES + SAMPLES; ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+        launch(config, stream);
+        CHECK_HIP_ERROR(hipStreamSynchronize(stream));
+        auto stop = std::chrono::steady_clock::now();
+
+        if(i >= WARMUP_SAMPLES)
+        {
+            result.mUs[Sync].push_back(
+                std::chrono::duration<double, std::micro>(stop - start).count());
+        }
+    }
+
+    // Stream and graph: events around each batch
+    hipEvent_t startEvent, stopEvent;
+    CHECK_HIP_ERROR(hipEventCreate(&startEvent));
+    CHECK_HIP_ERROR(hipEventCreate(&stopEvent));
+
+    auto timeBatches = [&](auto&& enqueueBatch, std::vector<double>& samples) {
+        for(uint32_t i = 0; i < WARMUP_SAMPLES + SAMPLES; ++i)
+        {
+            CHECK_HIP_ERROR(hipEventRecord(startEvent, stream));
+            enqueueBatch();
+            CHECK_HIP_ERROR(hipEventRecord(stopEvent, stream));
+            CHECK_HIP_ERROR(hipEventSynchronize(stopEvent));
+
+            float elapsedMs = 0.0f;
+            CHECK_HIP_ERROR(hipEventElapsedTime(&elapsedMs, startEvent, stopEvent));
+            if(i >= WARMUP_SAMPLES)
+            {
+                samples.push_back(1.0e3 * elapsedMs / LAUNCHES_PER_BATCH);
+            }
+        }
+    };
+
+    timeBatches(
+        [&]() {
+            for(uint32_t j = 0; j < LAUNCHES_PER_BATCH; ++j)
+            {
+                launch(config, stream);
+            }
+        },
+        result.mUs[Stream]);
+
+    // Capture the batch once, and replay it
+    hipGraph_t     graph;
+    hipGraphExec_t graphExec;
+    CHECK_HIP_ERROR(hipStreamBeginCapture(stream, hipStreamCaptureModeThreadLocal));
+    for(uint32_t j = 0; j < LAUNCHES_PER_BATCH; ++j)
+    {
+        launch(config, stream);
+    }
+    CHECK_HIP_ERROR(hipStreamEndCapture(stream, &graph));
+    CHECK_HIP_ERROR(hipGraphInstantiate(&graphExec, graph, nullptr, nullptr, 0));
+
+    timeBatches([&]() { CHECK_HIP_ERROR(hipGraphLaunch(graphExec, stream)); },
+                result.mUs[Graph]);
+
+    CHECK_HIP_ERROR(hipGraphExecDestroy(graphExec));
+    CHECK_HIP_ERROR(hipGraphDestroy(graph));
+    CHECK_HIP_ERROR(hipEventDestroy(startEvent));
+    CHECK_HIP_ERROR(hipEventDestroy(stopEvent));
+
+    for(auto& samples : result.mUs)
+    {
+        std::sort(samples.begin(), samples.end());
+    }
+    return result;
+}
+
+__host__ void small_test(float32_t alpha, float32_t beta)
+{
+    // Buffers are sized for the largest dimensions of any shape
+    uint32_t maxM = 0u, maxN = 0u, maxK = 0u;
+    for(auto const& shape : SHAPES)
+    {
+        maxM = std::max(maxM, shape.mM);
+        maxN = std::max(maxN, shape.mN);
+        maxK = std::max(maxK, shape.mK);
+    }
+
+    std::cout << "Initializing host data..." << std::endl;
+
+    // Initialize input matrices
+    std::vector<float16_t> matrixA(maxM * maxK);
+    std::vector<float16_t> matrixB(maxK * maxN);
+    std::vector<float16_t> matrixC(maxM * maxN);
+    std::vector<float16_t> matrixD(maxM * maxN);
+
+    fillRand(matrixA.data(), maxM, maxK);
+    fillRand(matrixB.data(), maxK, maxN);
+    fillRand(matrixC.data(), maxM, maxN);
+
+    std::cout << "Initializing device data..." << std::endl;
+
+    float16_t* d_a;
+    float16_t* d_b;
+    float16_t* d_c;
+    float16_t* d_d;
+
+    const size_t bytesA = matrixA.size() * sizeof(float16_t);
+    const size_t bytesB = matrixB.size() * sizeof(float16_t);
+    const size_t bytesC = matrixC.size() * sizeof(float16_t);
+    const size_t bytesD = matrixD.size() * sizeof(float16_t);
+
+    CHECK_HIP_ERROR(hipMalloc(&d_a, bytesA));
+    CHECK_HIP_ERROR(hipMalloc(&d_b, bytesB));
+    CHECK_HIP_ERROR(hipMalloc(&d_c, bytesC));
+    CHECK_HIP_ERROR(hipMalloc(&d_d, bytesD));
+
+    CHECK_HIP_ERROR(hipMemcpy(d_a, matrixA.data(), bytesA, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_b, matrixB.data(), bytesB, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_c, matrixC.data(), bytesC, hipMemcpyHostToDevice));
+
+    hipStream_t stream;
+    CHECK_HIP_ERROR(hipStreamCreateWithFlags(&stream, hipStreamNonBlocking));
+
+    std::cout << "Launch, MatM, MatN, MatK, Workgroups, Mode, "
+              << "p50(us), p99(us), Floor p50(us), Over floor(us), TFlops/s(p50)" << std::endl;
+
+    for(auto const& shape : SHAPES)
+    {
+        auto blocks = (shape.mM / ROCWMMA_M) * (shape.mN / ROCWMMA_N);
+
+        struct
+        {
+            char const* mName;
+            uint32_t    mWorkgroups;
+        } const launches[] = {{"1 WG", 1u}, {"Grid", rocwmma::ceilDiv(blocks, WAVES_PER_WG)}};
+
+        for(auto const& l : launches)
+        {
+            LaunchConfig config = {
+                hgemm_rocwmma_small, dim3(l.mWorkgroups), shape, d_a, d_b, d_c, d_d, alpha, beta};
+
+            // Same launch without work
+            LaunchConfig floorConfig = config;
+            floorConfig.mKernel      = empty_kernel;
+
+            auto samples      = measure(config, stream);
+            auto floorSamples = measure(floorConfig, stream);
+
+            auto gFlops = calculateGFlops(shape.mM, shape.mN, shape.mK);
+            for(uint32_t mode = 0; mode < NumModes; ++mode)
+            {
+                auto p50      = percentile(samples.mUs[mode], 0.5);
+                auto p99      = percentile(samples.mUs[mode], 0.99);
+                auto floorP50 = percentile(floorSamples.mUs[mode], 0.5);
+
+                std::cout << l.mName << ", " << shape.mM << ", " << shape.mN << ", "
+                          << shape.mK << ", " << l.mWorkgroups << ", " << MODE_NAMES[mode]
+                          << ", " << p50 << ", " << p99 << ", " << floorP50 << ", "
+                          << std::max(p50 - floorP50, 0.0) << ", " << gFlops / p50 * 1.0e-3
+                          << std::endl;
+            }
+        }
+    }
+
+#if !NDEBUG
+
+    std::cout << "Validating result with reference..." << std::endl;
+
+    // D holds the result of the last shape
+    auto& shape = SHAPES[sizeof(SHAPES) / sizeof(SHAPES[0]) - 1u];
+    auto  m     = shape.mM;
+    auto  n     = shape.mN;
+    auto  k     = shape.mK;
+
+    std::vector<float16_t> matrixD_ref(m * n, std::numeric_limits<float16_t>::signaling_NaN());
+    gemm_cpu_h<float16_t, float16_t, float32_t, row_major, col_major, row_major>(
+        m,
+        n,
+        k,
+        matrixA.data(),
+        matrixB.data(),
+        matrixC.data(),
+        matrixD_ref.data(),
+        k,
+        k,
+        n,
+        n,
+        alpha,
+        beta);
+
+    CHECK_HIP_ERROR(hipMemcpy(matrixD.data(), d_d, bytesD, hipMemcpyDeviceToHost));
+
+    auto res = compareEqual<float16_t>(matrixD.data(), matrixD_ref.data(), m * n);
+
+    if(std::get<0>(res) == false)
+    {
+        std::cout << "FAILED\n";
+    }
+    else
+    {
+        std::cout << "PASSED\n";
+    }
+
+    std::cout << "Max relative error: " << std::get<1>(res) << std::endl;
+
+#endif // !NDEBUG
+
+    // Release device resources
+    CHECK_HIP_ERROR(hipStreamDestroy(stream));
+    CHECK_HIP_ERROR(hipFree(d_a));
+    CHECK_HIP_ERROR(hipFree(d_b));
+    CHECK_HIP_ERROR(hipFree(d_c));
+    CHECK_HIP_ERROR(hipFree(d_d));
+
+    std::cout << "Finished!" << std::endl;
+}
+
+int main()
+{
+    small_test(2.1f, 2.1f);
+    return 0;
+}
@@ -0,0 +1,1189 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_fp16.h>
+#include <hip/hip_runtime.h>
+
+#include <rocwmma/rocwmma.hpp>
+#include <rocwmma/rocwmma_coop.hpp>
+#include <rocwmma/rocwmma_tile.hpp>
+#include <rocwmma/rocwmma_transforms.hpp>
+
+#include "benchmark_harness.hpp"
+#include "common.hpp"
+
+/* Motivation
+*
+* The perf_hgemm sample assigns one workgroup to each macro tile of the output
+* and each workgroup walks the entire K dimension. When M x N is small relative
+* to K, the number of macro tiles may be much smaller than the number of CUs
+* available and most of the GPU sits idle.
+*
+* E.g. M = N = 1024 with a 128 x 128 macro tile gives 64 tiles, on a GPU
+* with 304 CUs.
+*
+* This sample partitions the K loop across workgroups so that all CUs may
+* participate. The unit of work is one K iteration, or one BlockK step of
+* one macro tile:
+*
+* itersPerTile = K / BlockK
+* totalIters   = tilesX * tilesY * itersPerTile
+*
+* Workgroups are assigned contiguous ranges of [itersPerWg] iterations:
+*
+* - DataParallel: itersPerWg = itersPerTile, one workgroup per macro tile
+* - SplitK:       itersPerWg = itersPerTile / SplitCount, SplitCount workgroups
+*                 per macro tile
+* - StreamK:      itersPerWg = ceil(totalIters / (CUs * occupancy)), a single
+*                 wave of persistent workgroups. Iteration ranges may span the
+*                 end of one macro tile and the beginning of the next.
+*
+*  Global iteration space, tiles T0..T3, Stream-K with 3 workgroups:
+*
+*  |<--- T0 --->|<--- T1 --->|<--- T2 --->|<--- T3 --->|
+*  |<----- WG0 ----->|<----- WG1 ----->|<----- WG2 --->|
+*
+* Each workgroup accumulates partial A x B results of each macro tile segment
+* it visits, and reduces them into a ComputeT workspace in one of two modes:
+*
+* - Atomic:  partials are atomically added to the workspace. Because the order
+*            of the additions is not fixed, results may differ in the last bits
+*            from run to run.
+* - Ordered: tiles computed by a single workgroup are stored to the workspace.
+*            Each workgroup sharing a tile stores its partial to the slot of
+*            the tile given by its order among them, and bumps a per-tile
+*            counter. The last workgroup to arrive sums the slots in slot order
+*            and stores the workspace. The sum is the same whatever the arrival
+*            order, so results are bitwise reproducible from run to run.
+*
+* A final epilogue kernel computes D = alpha * workspace + beta * C.
+*
+* - StreamKFused: the StreamK decomposition as a single cooperative launch. The workspace
+*                 zeroing (Atomic), the tile loop and the epilogue are phases of the same
+*                 persistent kernel, separated by rocwmma::synchronize_grid barriers.
+*
+*       Start
+*         |
+*   Zero workspace (Atomic)
+*         |
+*   [StreamKFused: synchronize_grid]
+*         |
+*   Loop: tile segments in [itersBegin, itersEnd)
+*   ^         |
+*   |    Prefetch / LDS pipeline over [kBegin, kEnd) of the tile
+*   |         |
+*   |    Atomic:  atomic add partial accum to workspace
+*   |    Ordered: store whole tile to workspace, or partial accum to its slot;
+*   |             last arrival sums the slots in order to workspace
+*   |         |
+*   end_loop <-
+*         |
+*   [StreamKFused: synchronize_grid]
+*         |
+*   Epilogue: D = alpha * workspace + beta * C
+*         |
+*        End
+*/
+
+using namespace rocwmma;
+
+///
+/// Types and Data Layouts
+///
+
+using InputT   = float16_t;
+using OutputT  = float16_t;
+using ComputeT = float32_t;
+
+using DataLayoutA = col_major;
+using DataLayoutB = row_major;
+using DataLayoutC = row_major;
+
+///
+/// Parameter configuration
+///
+
+/* The kernel parameters are the validated defaults of rocwmma::warp_tile_config for InputT and
+*  the GPU architecture being compiled. Each target of an --offload-arch fat binary is compiled
+*  with its own parameters, and the host selects the same ones at runtime with
+*  get_warp_tile_params. For float16_t:
+* _________________________________________________________________________________________
+*|         |           |           |           |          |          |          |          |
+*|         | ROCWMMA_M | ROCWMMA_N | ROCWMMA_K | BLOCKS_X | BLOCKS_Y | TBLOCK_X | TBLOCK_Y |
+*|_________|___________|___________|___________|__________|__________|__________|__________|
+*|         |           |           |           |          |          |          |          |
+*|  GFX_9  |    32     |    32     |    16     |    2     |    2     |   128    |    2     |
+*|_________|___________|___________|___________|__________|__________|__________|__________|
+*|         |           |           |           |          |          |          |          |
+*|  GFX_11 |    16     |    16     |    16     |    4     |    2     |    64    |    4     |
+*|  GFX_12 |           |           |           |          |          |          |          |
+*|_________|___________|___________|___________|__________|__________|__________|__________|
+*
+* __________________________________________
+*|         |                                |
+*|         |           WARP_SIZE            |
+*|_________|________________________________|
+*|         |                                |
+*|  GFX_9  | Constants::AMDGCN_WAVE_SIZE_64 |
+*|_________|________________________________|
+*|         |                                |
+*|  GFX_11 | Constants::AMDGCN_WAVE_SIZE_32 |
+*|  GFX_12 |                                |
+*|_________|________________________________|
+*/
+
+using WarpTileConfig = warp_tile_config_t<InputT>;
+
+enum kernelParams : uint32_t
+{
+    ROCWMMA_M = WarpTileConfig::block_m,
+    ROCWMMA_N = WarpTileConfig::block_n,
+    ROCWMMA_K = WarpTileConfig::block_k,
+    BLOCKS_X  = WarpTileConfig::blocks_x,
+    BLOCKS_Y  = WarpTileConfig::blocks_y,
+    TBLOCK_X  = WarpTileConfig::tblock_x,
+    TBLOCK_Y  = WarpTileConfig::tblock_y,
+    WARP_SIZE = WarpTileConfig::wave_size
+};
+
+using DataLayoutLds = WarpTileConfig::lds_layout;
+
+///
+/// Fragment types
+///
+
+// #if (ROCWMMA_ARCH_GFX9 || ROCWMMA_ARCH_GFX11)
+// Warp tile: computed by each warp
+constexpr uint32_t WARP_TILE_X = BLOCKS_X * ROCWMMA_M;
+constexpr uint32_t WARP_TILE_Y = BLOCKS_Y * ROCWMMA_N;
+
+// Macro Tile: computed by each thread block (workgroup)
+// Note: TBLOCK_X must be multiple of WARP_SIZE.
+constexpr uint32_t WARPS_X      = TBLOCK_X / WARP_SIZE;
+constexpr uint32_t WARPS_Y      = TBLOCK_Y;
+constexpr uint32_t MACRO_TILE_X = WARPS_X * WARP_TILE_X;
+constexpr uint32_t MACRO_TILE_Y = WARPS_Y * WARP_TILE_Y;
+
+// Mfma frags
+using MfmaFragA   = fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, InputT, DataLayoutA>;
+using MfmaFragB   = fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, InputT, DataLayoutB>;
+using MfmaFragC   = fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, OutputT, DataLayoutC>;
+using MfmaFragD   = MfmaFragC;
+using MfmaFragAcc = fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, ComputeT>;
+
+// Warp tile of mfma frags
+using MfmaTileA   = fragment_array<MfmaFragA, BLOCKS_X, 1u>;
+using MfmaTileB   = fragment_array<MfmaFragB, 1u, BLOCKS_Y>;
+using MfmaTileC   = fragment_array<MfmaFragC, BLOCKS_X, BLOCKS_Y>;
+using MfmaTileD   = MfmaTileC;
+using MfmaTileAcc = fragment_array<MfmaFragAcc, BLOCKS_X, BLOCKS_Y>;
+
+// Workspace layout of the ordered reduction stores, the same as C
+constexpr layout_t LayoutW = std::is_same_v<DataLayoutC, row_major> ? mem_row_major : mem_col_major;
+
+// Global read (macro tile)
+using GRBuffA = fragment<matrix_a, MACRO_TILE_X, ROCWMMA_N, ROCWMMA_K, InputT, DataLayoutA>;
+using GRBuffB = fragment<matrix_b, ROCWMMA_M, MACRO_TILE_Y, ROCWMMA_K, InputT, DataLayoutB>;
+
+// Local write of global buffers (macro tile)
+// - Must match Lds data layout.
+// - Lds has transposed B frags.
+using LWBuffA = ApplyDataLayout_t<GRBuffA, DataLayoutLds>;
+using LWBuffB = ApplyDataLayout_t<ApplyTranspose_t<GRBuffB>, DataLayoutLds>;
+
+// Local read (mfma frags)
+// - Must match Lds data layout.
+// - Lds has transposed B frags.
+using LRFragA = ApplyDataLayout_t<MfmaFragA, DataLayoutLds>;
+using LRFragB = ApplyDataLayout_t<ApplyTranspose_t<MfmaFragB>, DataLayoutLds>;
+// #endif // (ROCWMMA_ARCH_GFX9 || ROCWMMA_ARCH_GFX11)
+
+///
+/// Wrapper functions: repeat mfma tile operations across entire warp tile.
+///
+
+// Cooperative global read / local write (Macro tile data movement)
+// Loads / stores a global data fragment cooperatively across warps. Each participating warp is
+// responsible for only a portion of the whole fragment.
+//
+// The cooperative operation is split into work items (SplitCount). Work items are consumed in
+// a round robin fashion by warps in the range of [0, WaveCount). The wave index determines the
+// order of the current wave in the collaboration pool.
+//
+// WaveCount, SplitCount and waveIndex parameters must match successive coop load / store calls
+// to ensure the entire fragment remains coherent.
+
+// Global A reads in cooperative mode (macro tile)
+template <uint32_t WaveCountA>
+ROCWMMA_DEVICE static inline void
+    globalReadCoopA(GRBuffA& grBuffA, InputT const* gAddrA, uint32_t lda, uint32_t waveIndexA)
+{
+    load_matrix_coop_sync<WaveCountA>(grBuffA, gAddrA, lda, waveIndexA);
+}
+
+// Global B reads in cooperative mode (macro tile)
+template <uint32_t WaveCountB>
+ROCWMMA_DEVICE static inline void
+    globalReadCoopB(GRBuffB& grBuffB, InputT const* gAddrB, uint32_t ldb, uint32_t waveIndexB)
+{
+    load_matrix_coop_sync<WaveCountB>(grBuffB, gAddrB, ldb, waveIndexB);
+}
+
+// Local A writes in cooperative mode (macro tile)
+template <uint32_t WaveCountA>
+ROCWMMA_DEVICE static inline void
+    localWriteCoopA(InputT* ldsAddr, GRBuffA const& grBuffA, uint32_t ldsld, uint32_t waveIndexA)
+{
+    // No transpose, but apply the lds data layout
+    store_matrix_coop_sync<WaveCountA>(
+        ldsAddr, applyDataLayout<DataLayoutLds, WaveCountA>(grBuffA), ldsld, waveIndexA);
+}
+
+// Local B writes in cooperative mode (macro tile)
+template <uint32_t WaveCountB>
+ROCWMMA_DEVICE static inline void
+    localWriteCoopB(InputT* ldsAddr, GRBuffB const& grBuffB, uint32_t ldsld, uint32_t waveIndexB)
+{
+    // Transpose B and then apply lds data layout
+    store_matrix_coop_sync<WaveCountB>(
+        ldsAddr, applyDataLayout<DataLayoutLds, WaveCountB>(applyTranspose(grBuffB)), ldsld, waveIndexB);
+}
+
+// Local A reads for warp tile gemm, non-cooperative
+ROCWMMA_DEVICE static inline void
+    localReadA(MfmaTileA& fragsA, InputT const* ldsAddrA, uint32_t ldsld)
+{
+    using FragShape = GetIOShape_t<LRFragA>;
+    using Mapper1d  = GetDataLayout_t<LRFragA>;
+
+    // Each A block is stacked vertically in LDS
+    auto blockStep = Mapper1d::fromMatrixCoord(make_coord2d(FragShape::BlockHeight, 0u), ldsld);
+
+#pragma unroll
+    for(int i = 0; i < BLOCKS_X; i++)
+    {
+        LRFragA tmp;
+        load_matrix_sync(tmp, ldsAddrA, ldsld);
+        fragsA(i, 0u) = applyDataLayout<DataLayoutA>(tmp);
+
+        ldsAddrA += blockStep;
+    }
+}
+
+// Local B reads for warp tile gemm, non-cooperative
+ROCWMMA_DEVICE static inline void
+    localReadB(MfmaTileB& fragsB, InputT const* ldsAddrB, uint32_t ldsld)
+{
+    using FragShape = GetIOShape_t<LRFragB>;
+    using Mapper1d  = GetDataLayout_t<LRFragB>;
+
+    // Each B block is stacked vertically in LDS
+    auto blockStep = Mapper1d::fromMatrixCoord(make_coord2d(FragShape::BlockHeight, 0u), ldsld);
+
+#pragma unroll
+    for(int i = 0; i < BLOCKS_Y; i++)
+    {
+        LRFragB tmp;
+        load_matrix_sync(tmp, ldsAddrB, ldsld);
+
+        // Transform back to MFMA tile
+        fragsB(0u, i) = applyDataLayout<DataLayoutB>(applyTranspose(tmp));
+
+        ldsAddrB += blockStep;
+    }
+}
+
+// Atomic add of warp tile accumulation into the workspace, non-cooperative
+// Each accumulator block is staged through LDS in a known layout, so that
+// each element's matrix coordinate can be recovered for the atomic update.
+ROCWMMA_DEVICE static inline void
+    globalAtomicAddW(ComputeT*          gAddrW,
+                     MfmaTileAcc const& fragsAcc,
+                     uint32_t           ldw,
+                     ComputeT*          ldsAddr)
+{
+    using FragShape = GetIOShape_t<MfmaFragAcc>;
+    using Mapper1d  = GetDataLayout_t<MfmaFragC>;
+
+    constexpr uint32_t blockHeight = FragShape::BlockHeight;
+    constexpr uint32_t blockWidth  = FragShape::BlockWidth;
+    constexpr uint32_t blockSize   = blockHeight * blockWidth;
+
+    const auto laneId = threadIdx.x % WARP_SIZE;
+
+#pragma unroll
+    for(int i = 0; i < BLOCKS_X; i++)
+    {
+#pragma unroll
+        for(int j = 0; j < BLOCKS_Y; j++)
+        {
+            // Staging area is private to the current warp
+            store_matrix_sync(ldsAddr, fragsAcc(i, j), blockWidth, mem_row_major);
+
+            for(uint32_t e = laneId; e < blockSize; e += WARP_SIZE)
+            {
+                auto coord = make_coord2d(i * blockHeight + e / blockWidth,
+                                          j * blockWidth + e % blockWidth);
+                atomicAdd(gAddrW + Mapper1d::fromMatrixCoord(coord, ldw), ldsAddr[e]);
+            }
+        }
+    }
+}
+
+// Ordered reduction of a warp tile partial of a macro tile shared by slotCount workgroups.
+// The partial is stored to its slot, a row major macro tile at slots + slot * slotSize. The
+// last workgroup to arrive sums the slots in slot order, its own from registers, and stores
+// the sum to the workspace. The tile counter is reset for the next launch.
+ROCWMMA_DEVICE static inline void globalOrderedReduceW(ComputeT*          gAddrW,
+                                                       MfmaTileAcc const& fragsAcc,
+                                                       uint32_t           ldw,
+                                                       ComputeT*          slots,
+                                                       uint32_t           slot,
+                                                       uint32_t           slotCount,
+                                                       Coord2d const&     localWarpOffset,
+                                                       uint32_t*          tileCounter)
+{
+    constexpr uint32_t slotSize = MACRO_TILE_X * MACRO_TILE_Y;
+
+    auto slotOffset = get<0>(localWarpOffset) * MACRO_TILE_Y + get<1>(localWarpOffset);
+
+    store_matrix_sync(slots + slot * slotSize + slotOffset, fragsAcc, MACRO_TILE_Y, mem_row_major);
+
+    // Release the partial, and acquire those of the earlier arrivals
+    if(arrive_workgroup_counter(tileCounter) != slotCount - 1u)
+    {
+        return;
+    }
+
+    MfmaTileAcc fragsSum;
+    fill_fragment(fragsSum, 0.0f);
+
+    for(uint32_t s = 0u; s < slotCount; s++)
+    {
+        MfmaTileAcc fragsSlot;
+        if(s == slot)
+        {
+            fragsSlot = fragsAcc;
+        }
+        else
+        {
+            load_matrix_sync(
+                fragsSlot, slots + s * slotSize + slotOffset, MACRO_TILE_Y, mem_row_major);
+        }
+
+#pragma unroll
+        for(int i = 0; i < BLOCKS_X; i++)
+        {
+#pragma unroll
+            for(int j = 0; j < BLOCKS_Y; j++)
+            {
+#pragma unroll
+                for(uint32_t e = 0u; e < MfmaFragAcc::num_elements; e++)
+                {
+                    fragsSum(i, j).x[e] += fragsSlot(i, j).x[e];
+                }
+            }
+        }
+    }
+
+    store_matrix_sync(gAddrW, fragsSum, ldw, LayoutW);
+
+    if(threadIdx.x == 0 && threadIdx.y == 0)
+    {
+        *tileCounter = 0u;
+    }
+}
+
+// Accumulate A * B for the warp tile over K iterations [kIterBegin, kIterEnd)
+// of the current macro tile. This is the same prefetch and LDS double-buffered
+// pipeline as the perf_hgemm sample, bounded to a range of K steps.
+ROCWMMA_DEVICE static inline void accumKRange(MfmaTileAcc&  fragsAcc,
+                                              InputT const* a,
+                                              InputT const* b,
+                                              uint32_t      lda,
+                                              uint32_t      ldb,
+                                              Coord2d const& macroTileCoord,
+                                              Coord2d const& localWarpOffset,
+                                              uint32_t      warpIndex,
+                                              uint32_t      kIterBegin,
+                                              uint32_t      kIterEnd,
+                                              InputT*       ldsPtr)
+{
+    constexpr auto warpCount = WARPS_X * WARPS_Y;
+
+    ///
+    /// 1D global read coordinate setup
+    ///
+    using GRBuffAMap1d = GetDataLayout_t<GRBuffA>;
+    using GRBuffBMap1d = GetDataLayout_t<GRBuffB>;
+
+    // Initial global read address offsets at the beginning of the K range
+    auto globalReadOffsetA = GRBuffAMap1d::fromMatrixCoord(
+        make_coord2d(get<0>(macroTileCoord), kIterBegin * ROCWMMA_K), lda);
+    auto globalReadOffsetB = GRBuffBMap1d::fromMatrixCoord(
+        make_coord2d(kIterBegin * ROCWMMA_K, get<1>(macroTileCoord)), ldb);
+
+    // Incremental global read address offsets
+    auto kStepOffsetA = GRBuffAMap1d::fromMatrixCoord(make_coord2d(0u, ROCWMMA_K), lda);
+    auto kStepOffsetB = GRBuffBMap1d::fromMatrixCoord(make_coord2d(ROCWMMA_K, 0u), ldb);
+
+    ///
+    /// Perform initial global pre-fetch
+    ///
+    GRBuffA grBuffA;
+    GRBuffB grBuffB;
+
+    globalReadCoopA<warpCount>(grBuffA, a + globalReadOffsetA, lda, warpIndex);
+    globalReadCoopB<warpCount>(grBuffB, b + globalReadOffsetB, ldb, warpIndex);
+
+    globalReadOffsetA += kStepOffsetA;
+    globalReadOffsetB += kStepOffsetB;
+
+    ///
+    /// Setup LDS addressing
+    ///
+    using LWBuffAShape = GetIOShape_t<LWBuffA>;
+    using LWBuffBShape = GetIOShape_t<LWBuffB>;
+    using LWBuffAMap1d = GetDataLayout_t<LWBuffA>;
+    using LWBuffBMap1d = GetDataLayout_t<LWBuffB>;
+
+    constexpr uint32_t ldsWidth  = ROCWMMA_K;
+    constexpr uint32_t ldsHeight = LWBuffAShape::BlockHeight + LWBuffBShape::BlockHeight;
+    constexpr uint32_t sizeLds   = ldsHeight * ldsWidth;
+    constexpr uint32_t ldsld = std::is_same_v<DataLayoutLds, row_major> ? ldsWidth : ldsHeight;
+
+    auto* ldsPtrLo = ldsPtr;
+    auto* ldsPtrHi = ldsPtrLo + sizeLds;
+
+    // Local write offsets to start of A / B data
+    auto ldsWriteOffsetA = 0u;
+    auto ldsWriteOffsetB
+        = LWBuffAMap1d::fromMatrixCoord(make_coord2d(LWBuffAShape::BlockHeight, 0u), ldsld);
+
+    // Local read offsets for mfma frags
+    auto ldsReadOffsetA
+        = ldsWriteOffsetA
+          + LWBuffAMap1d::fromMatrixCoord(make_coord2d(get<0>(localWarpOffset), 0u), ldsld);
+    auto ldsReadOffsetB
+        = ldsWriteOffsetB
+          + LWBuffBMap1d::fromMatrixCoord(make_coord2d(get<1>(localWarpOffset), 0u), ldsld);
+
+    ///
+    /// Write prefetch to local
+    ///
+    localWriteCoopA<warpCount>(ldsPtrLo + ldsWriteOffsetA, grBuffA, ldsld, warpIndex);
+    localWriteCoopB<warpCount>(ldsPtrLo + ldsWriteOffsetB, grBuffB, ldsld, warpIndex);
+
+    ///
+    /// Synchronize warps and memory
+    ///
+    synchronize_workgroup();
+
+    ///
+    /// Accumulate A * B for all mfma frags in warp tile
+    ///
+    for(uint32_t kIter = kIterBegin + 1u; kIter < kIterEnd; kIter++)
+    {
+        MfmaTileA fragsA;
+        MfmaTileB fragsB;
+
+        // Local read mfma frags from first LDS buffer
+        localReadA(fragsA, ldsPtrLo + ldsReadOffsetA, ldsld);
+        localReadB(fragsB, ldsPtrLo + ldsReadOffsetB, ldsld);
+
+        // Prefetch next round of global frags
+        globalReadCoopA<warpCount>(grBuffA, a + globalReadOffsetA, lda, warpIndex);
+        globalReadCoopB<warpCount>(grBuffB, b + globalReadOffsetB, ldb, warpIndex);
+
+        // Advance offsets to next k step
+        globalReadOffsetA += kStepOffsetA;
+        globalReadOffsetB += kStepOffsetB;
+
+        // accum(A * B)
+        mma_sync(fragsAcc, fragsA, fragsB, fragsAcc);
+
+        // Write prefetch to second LDS buffer
+        localWriteCoopA<warpCount>(ldsPtrHi + ldsWriteOffsetA, grBuffA, ldsld, warpIndex);
+        localWriteCoopB<warpCount>(ldsPtrHi + ldsWriteOffsetB, grBuffB, ldsld, warpIndex);
+
+        // Make sure that all waves have finished reading / writing to lds for current K.
+        synchronize_workgroup();
+
+        // Swap Lds buffers
+        auto* tmp = ldsPtrLo;
+        ldsPtrLo  = ldsPtrHi;
+        ldsPtrHi  = tmp;
+    }
+
+    ///
+    /// Clean up tail A * B
+    ///
+    MfmaTileA fragsA;
+    MfmaTileB fragsB;
+
+    localReadA(fragsA, ldsPtrLo + ldsReadOffsetA, ldsld);
+    localReadB(fragsB, ldsPtrLo + ldsReadOffsetB, ldsld);
+    mma_sync(fragsAcc, fragsA, fragsB, fragsAcc);
+
+    // Lds is re-used after the tail: wait for all waves.
+    synchronize_workgroup();
+}
+
+// Reduction modes of the tile segment partials
+enum struct ReductionMode : uint32_t
+{
+    Atomic,
+    Ordered
+};
+
+inline const char* toString(ReductionMode mode)
+{
+    switch(mode)
+    {
+    case ReductionMode::Atomic:
+        return "Atomic";
+    case ReductionMode::Ordered:
+        return "Ordered";
+    default:
+        return "Unknown";
+    }
+}
+
+// Slots per macro tile of the ordered reduction: the most workgroups whose iteration ranges
+// overlap the K iterations of one tile.
+ROCWMMA_HOST_DEVICE constexpr inline uint32_t slotsPerTile(uint32_t itersPerTile,
+                                                           uint32_t itersPerWg)
+{
+    return (itersPerTile - 1u) / itersPerWg + 2u;
+}
+
+// Work decomposition kernel.
+// Each workgroup handles K iterations [wgIndex * itersPerWg, (wgIndex + 1) * itersPerWg)
+// of the global iteration space, which may span multiple macro tiles.
+// The Ordered reduction uses slotsPerTile slots of partials per macro tile, and one zeroed
+// counter per macro tile.
+// The Fused variant zeroes the workspace (Atomic) and applies the epilogue in the same launch,
+// separating the phases with grid barriers. It must be launched cooperatively, with a zeroed
+// barrier word.
+template <ReductionMode Reduction, bool Fused>
+ROCWMMA_KERNEL void __launch_bounds__(256) gemm_rocwmma_streamk_d(uint32_t       m,
+                                                                  uint32_t       n,
+                                                                  uint32_t       k,
+                                                                  InputT const*  a,
+                                                                  InputT const*  b,
+                                                                  OutputT const* c,
+                                                                  OutputT*       d,
+                                                                  ComputeT*      w,
+                                                                  ComputeT*      partials,
+                                                                  uint32_t*      tileCounters,
+                                                                  uint32_t*      gridBarrier,
+                                                                  uint32_t       lda,
+                                                                  uint32_t       ldb,
+                                                                  uint32_t       ldw,
+                                                                  ComputeT       alpha,
+                                                                  ComputeT       beta,
+                                                                  uint32_t       itersPerWg)
+{
+    if constexpr(!ROCWMMA_ARCH_HOST)
+    {
+        ///
+        /// 2D matrix coordinate setup
+        ///
+
+        // Tile Sizes
+        constexpr auto warpTileSize  = make_coord2d(WARP_TILE_X, WARP_TILE_Y);
+        constexpr auto macroTileSize = make_coord2d(MACRO_TILE_X, MACRO_TILE_Y);
+
+        // Local warp coordinate relative to current threadblock (wg).
+        constexpr auto warpDims        = make_coord2d(WARPS_X, WARPS_Y);
+        auto           localWarpCoord  = make_coord2d(threadIdx.x / WARP_SIZE, threadIdx.y);
+        auto           localWarpOffset = localWarpCoord * warpTileSize;
+
+        // Scheduling warp order is analogous to row major priority.
+        const auto warpIndex = get<0>(localWarpCoord) * get<1>(warpDims) + get<1>(localWarpCoord);
+
+        ///
+        /// Iteration space setup
+        ///
+        const auto tilesY       = n / MACRO_TILE_Y;
+        const auto itersPerTile = k / ROCWMMA_K;
+        const auto totalIters   = (m / MACRO_TILE_X) * tilesY * itersPerTile;
+
+        const auto itersBegin = blockIdx.x * itersPerWg;
+        const auto itersEnd   = std::min(itersBegin + itersPerWg, totalIters);
+
+        // Grid-stride indexing of the element-wise phases
+        const auto wgSize      = blockDim.x * blockDim.y;
+        const auto gridThreads = gridDim.x * wgSize;
+        const auto threadIndex = blockIdx.x * wgSize + threadIdx.y * blockDim.x + threadIdx.x;
+
+        if constexpr(Fused && Reduction == ReductionMode::Atomic)
+        {
+            for(auto i = threadIndex; i < m * n; i += gridThreads)
+            {
+                w[i] = 0.0f;
+            }
+
+            // Workspace must be zero everywhere before any partial is added
+            synchronize_grid(gridBarrier);
+        }
+
+        ///
+        /// Setup LDS addressing
+        /// The LDS pipeline buffers are re-used to stage partial results.
+        ///
+        HIP_DYNAMIC_SHARED(void*, localMemPtr);
+        auto* ldsPtr = reinterpret_cast<InputT*>(localMemPtr);
+        auto* ldsPtrW
+            = reinterpret_cast<ComputeT*>(localMemPtr) + warpIndex * ROCWMMA_M * ROCWMMA_N;
+
+        using MfmaFragCMap1d = GetDataLayout_t<MfmaFragC>;
+
+        ///
+        /// Visit each macro tile segment in the iteration range
+        ///
+        for(auto iter = itersBegin; iter < itersEnd;)
+        {
+            auto tileIndex  = iter / itersPerTile;
+            auto kIterBegin = iter % itersPerTile;
+            auto kIterEnd   = std::min(itersPerTile, kIterBegin + (itersEnd - iter));
+
+            // Global matrix coordinates for the current macro tile
+            auto macroTileCoord
+                = make_coord2d(tileIndex / tilesY, tileIndex % tilesY) * macroTileSize;
+            auto warpTileCoord = macroTileCoord + localWarpOffset;
+
+            ///
+            /// Initialize accumulation frags
+            ///
+            MfmaTileAcc fragsAcc;
+            fill_fragment(fragsAcc, 0.0f);
+
+            accumKRange(fragsAcc,
+                        a,
+                        b,
+                        lda,
+                        ldb,
+                        macroTileCoord,
+                        localWarpOffset,
+                        warpIndex,
+                        kIterBegin,
+                        kIterEnd,
+                        ldsPtr);
+
+            ///
+            /// Reduce partial result into the workspace
+            ///
+            auto gAddrW = w + MfmaFragCMap1d::fromMatrixCoord(warpTileCoord, ldw);
+            if constexpr(Reduction == ReductionMode::Atomic)
+            {
+                globalAtomicAddW(gAddrW, fragsAcc, ldw, ldsPtrW);
+            }
+            else
+            {
+                // Workgroups whose iteration ranges overlap the tile, in slot order
+                auto tileIterBegin = tileIndex * itersPerTile;
+                auto wgFirst       = tileIterBegin / itersPerWg;
+                auto wgLast        = (tileIterBegin + itersPerTile - 1u) / itersPerWg;
+
+                if(wgFirst == wgLast)
+                {
+                    store_matrix_sync(gAddrW, fragsAcc, ldw, LayoutW);
+                }
+                else
+                {
+                    auto slots = slotsPerTile(itersPerTile, itersPerWg);
+                    globalOrderedReduceW(gAddrW,
+                                         fragsAcc,
+                                         ldw,
+                                         partials + tileIndex * slots * MACRO_TILE_X * MACRO_TILE_Y,
+                                         blockIdx.x - wgFirst,
+                                         wgLast - wgFirst + 1u,
+                                         localWarpOffset,
+                                         tileCounters + tileIndex);
+                }
+            }
+
+            // Make sure all waves are done with the staging area before next tile segment.
+            synchronize_workgroup();
+
+            iter += kIterEnd - kIterBegin;
+        }
+
+        if constexpr(Fused)
+        {
+            // Every tile must be reduced before the epilogue reads the workspace
+            synchronize_grid(gridBarrier);
+
+            for(auto i = threadIndex; i < m * n; i += gridThreads)
+            {
+                d[i] = static_cast<OutputT>(alpha * w[i] + beta * static_cast<ComputeT>(c[i]));
+            }
+        }
+    }
+}
+
+// Epilogue kernel, element-wise:
+// D = alpha * workspace + beta * C
+// Workspace, C and D share the same layout and leading dimension.
+ROCWMMA_KERNEL void gemm_epilogue_d(uint32_t        size,
+                                    ComputeT const* w,
+                                    OutputT const*  c,
+                                    OutputT*        d,
+                                    ComputeT        alpha,
+                                    ComputeT        beta)
+{
+    auto idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if(idx < size)
+    {
+        // Perform computation in ComputeT and cast back to OutputT
+        d[idx] = static_cast<OutputT>(alpha * w[idx] + beta * static_cast<ComputeT>(c[idx]));
+    }
+}
+
+// Work decomposition modes of the K loop
+enum struct WorkDecomposition : uint32_t
+{
+    DataParallel,
+    SplitK,
+    StreamK,
+    StreamKFused
+};
+
+inline const char* toString(WorkDecomposition mode)
+{
+    switch(mode)
+    {
+    case WorkDecomposition::DataParallel:
+        return "DataParallel";
+    case WorkDecomposition::SplitK:
+        return "SplitK";
+    case WorkDecomposition::StreamK:
+        return "StreamK";
+    case WorkDecomposition::StreamKFused:
+        return "StreamKFused";
+    default:
+        return "Unknown";
+    }
+}
+
+ROCWMMA_HOST void gemm_test(uint32_t m, uint32_t n, uint32_t k, ComputeT alpha, ComputeT beta)
+{
+    // Runtime checks for host parameters
+    auto     params       = get_warp_tile_params<InputT>(getGcnArchId());
+    uint32_t hTBLOCK_X    = params.tblock_x;
+    uint32_t hTBLOCK_Y    = params.tblock_y;
+    uint32_t hBLOCKS_X    = params.blocks_x;
+    uint32_t hBLOCKS_Y    = params.blocks_y;
+    uint32_t hROCWMMA_M   = params.block_m;
+    uint32_t hROCWMMA_N   = params.block_n;
+    uint32_t hROCWMMA_K   = params.block_k;
+    uint32_t hWARP_TILE_X = hBLOCKS_X * hROCWMMA_M;
+    uint32_t hWARP_TILE_Y = hBLOCKS_Y * hROCWMMA_N;
+
+    // Runtime warp calculation (host code needs to query warpsize dynamically)
+    auto warpSize = getWarpSize();
+    auto warps    = hTBLOCK_X / warpSize * hTBLOCK_Y;
+    auto macroTileSize
+        = rocwmma::make_coord2d(hTBLOCK_X / warpSize * hWARP_TILE_X, hTBLOCK_Y * hWARP_TILE_Y);
+
+    // Device check for supported block and wave sizes
+    if((isGfx11() || isGfx12()) && (hROCWMMA_M != 16 || hROCWMMA_N != 16))
+    {
+        std::cout << "Unsupported block size!\n";
+        return;
+    }
+
+    if(isGfx9() && (hROCWMMA_M != hROCWMMA_N) || (hROCWMMA_M != 16 && hROCWMMA_M != 32))
+    {
+        std::cout << "Unsupported block size!\n";
+        return;
+    }
+
+    if((isGfx11() || isGfx12()) && getWarpSize() != Constants::AMDGCN_WAVE_SIZE_32)
+    {
+        std::cout << "Unsupported wave size!\n";
+        return;
+    }
+
+    if(isGfx9() && getWarpSize() != Constants::AMDGCN_WAVE_SIZE_64)
+    {
+        std::cout << "Unsupported wave size!\n";
+        return;
+    }
+
+    // Bounds check: iteration space is in whole macro tiles
+    if((m % get<0>(macroTileSize) || n % get<1>(macroTileSize) || k % hROCWMMA_K)
+       || (k < hROCWMMA_K))
+    {
+        std::cout << "Unsupported matrix size!\n";
+        return;
+    }
+
+    // Layouts leading dims
+    int lda = std::is_same_v<DataLayoutA, row_major> ? k : m;
+    int ldb = std::is_same_v<DataLayoutB, row_major> ? n : k;
+    int ldc = std::is_same_v<DataLayoutC, row_major> ? n : m;
+    int ldd = ldc;
+    int ldw = ldc;
+
+    std::cout << "Initializing host data..." << std::endl;
+
+    // Initialize input matrices
+    std::vector<InputT>  matrixA(m * k);
+    std::vector<InputT>  matrixB(k * n);
+    std::vector<OutputT> matrixC(m * n);
+
+    // Fill outputs with NaN to catch contamination
+    std::vector<OutputT> matrixD(m * n, std::numeric_limits<OutputT>::signaling_NaN());
+
+    fillRand(matrixA.data(), m, k);
+    fillRand(matrixB.data(), k, n);
+    fillRand(matrixC.data(), m, n);
+
+    std::cout << "Initializing device data..." << std::endl;
+
+    // Allocate and copy device memory
+    InputT*   d_a;
+    InputT*   d_b;
+    OutputT*  d_c;
+    OutputT*  d_d;
+    ComputeT* d_w;
+
+    const size_t bytesA = matrixA.size() * sizeof(InputT);
+    const size_t bytesB = matrixB.size() * sizeof(InputT);
+    const size_t bytesC = matrixC.size() * sizeof(OutputT);
+    const size_t bytesD = matrixD.size() * sizeof(OutputT);
+    const size_t bytesW = matrixD.size() * sizeof(ComputeT);
+
+    CHECK_HIP_ERROR(hipMalloc(&d_a, bytesA));
+    CHECK_HIP_ERROR(hipMalloc(&d_b, bytesB));
+    CHECK_HIP_ERROR(hipMalloc(&d_c, bytesC));
+    CHECK_HIP_ERROR(hipMalloc(&d_d, bytesD));
+    CHECK_HIP_ERROR(hipMalloc(&d_w, bytesW));
+
+    CHECK_HIP_ERROR(hipMemcpy(d_a, matrixA.data(), bytesA, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_b, matrixB.data(), bytesB, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_c, matrixC.data(), bytesC, hipMemcpyHostToDevice));
+
+#if !NDEBUG
+    // Setup and run reference computation
+    std::cout << "Computing reference..." << std::endl;
+    std::vector<OutputT> matrixD_ref(m * n, std::numeric_limits<OutputT>::signaling_NaN());
+    gemm_cpu_h<InputT, OutputT, ComputeT, DataLayoutA, DataLayoutB, DataLayoutC>(m,
+                                                                                 n,
+                                                                                 k,
+                                                                                 matrixA.data(),
+                                                                                 matrixB.data(),
+                                                                                 matrixC.data(),
+                                                                                 matrixD_ref.data(),
+                                                                                 lda,
+                                                                                 ldb,
+                                                                                 ldc,
+                                                                                 ldd,
+                                                                                 alpha,
+                                                                                 beta);
+#endif // !NDEBUG
+
+    auto blockDim = dim3(hTBLOCK_X, hTBLOCK_Y);
+
+    // Uses 2 lds blocks for prefetch loop (A and B), re-used to stage partial results.
+    int ldsusage = std::max(
+        2u * sizeof(InputT) * (get<0>(macroTileSize) + get<1>(macroTileSize)) * hROCWMMA_K,
+        warps * sizeof(ComputeT) * hROCWMMA_M * hROCWMMA_N);
+
+    // Iteration space
+    uint32_t tiles        = m / get<0>(macroTileSize) * (n / get<1>(macroTileSize));
+    uint32_t itersPerTile = k / hROCWMMA_K;
+    uint32_t totalIters   = tiles * itersPerTile;
+
+    // Persistent workgroup count for Stream-K
+    auto occupancy = get_launch_occupancy(
+        gemm_rocwmma_streamk_d<ReductionMode::Atomic, false>, hTBLOCK_X * hTBLOCK_Y, ldsusage);
+    uint32_t persistentWgs = occupancy.resident_blocks();
+    std::cout << "Stream-K occupancy: " << occupancy.waves_per_simd << "/"
+              << occupancy.max_waves_per_simd << " waves per SIMD, limited by "
+              << occupancy_limiter_name(occupancy.limiter) << std::endl;
+
+    // Smallest split count to fill the device, evenly dividing K iterations.
+    uint32_t splitCount = std::max(rocwmma::ceilDiv(persistentWgs, tiles), 1u);
+    while(itersPerTile % splitCount)
+    {
+        splitCount++;
+    }
+
+    std::cout << "TBlockX, TBlockY, "
+              << "BlocksX, BlocksY, "
+              << "BlkM, BlkN, BlkK, "
+              << "MatM, MatN, MatK, "
+              << "alpha, lda, ldb, "
+              << "beta, ldc, ldd, "
+              << "Mode, Reduction, Workgroups, ItersPerWg, "
+              << "Cache, elapsedMs, Problem Size(GFlops), TFlops/s, "
+              << BenchmarkHarness::statsHeader() << std::endl;
+
+    // Runs are timed individually, with warm and cold caches
+    BenchmarkHarness harness;
+
+    // Ordered reduction tile counters, reset by the last workgroup of each tile
+    uint32_t* d_tileCounters;
+    CHECK_HIP_ERROR(hipMalloc(&d_tileCounters, tiles * sizeof(uint32_t)));
+    CHECK_HIP_ERROR(hipMemset(d_tileCounters, 0, tiles * sizeof(uint32_t)));
+
+    // Grid barrier of the fused kernel, which leaves it ready for the next launch
+    uint32_t* d_gridBarrier;
+    CHECK_HIP_ERROR(hipMalloc(&d_gridBarrier, sizeof(uint32_t)));
+    CHECK_HIP_ERROR(hipMemset(d_gridBarrier, 0, sizeof(uint32_t)));
+
+    // The fused kernel needs all of its workgroups resident at once
+    bool cooperative = isCooperativeLaunchSupported();
+    if(!cooperative)
+    {
+        std::cout << "Cooperative launch unsupported, skipping StreamKFused" << std::endl;
+    }
+
+    for(auto mode : {WorkDecomposition::DataParallel,
+                     WorkDecomposition::SplitK,
+                     WorkDecomposition::StreamK,
+                     WorkDecomposition::StreamKFused})
+    {
+        if(mode == WorkDecomposition::StreamKFused && !cooperative)
+        {
+            continue;
+        }
+
+        for(auto reduction : {ReductionMode::Atomic, ReductionMode::Ordered})
+        {
+            uint32_t itersPerWg = itersPerTile;
+            if(mode == WorkDecomposition::SplitK)
+            {
+                itersPerWg = itersPerTile / splitCount;
+            }
+            else if(mode == WorkDecomposition::StreamK
+                    || mode == WorkDecomposition::StreamKFused)
+            {
+                itersPerWg = rocwmma::ceilDiv(totalIters, persistentWgs);
+            }
+
+            auto gridDim = dim3(rocwmma::ceilDiv(totalIters, itersPerWg));
+
+            // Ordered reduction partials: a macro tile per slot
+            ComputeT*    d_partials    = nullptr;
+            const size_t bytesPartials = static_cast<size_t>(tiles)
+                                         * slotsPerTile(itersPerTile, itersPerWg)
+                                         * get<0>(macroTileSize) * get<1>(macroTileSize)
+                                         * sizeof(ComputeT);
+            if(reduction == ReductionMode::Ordered)
+            {
+                CHECK_HIP_ERROR(hipMalloc(&d_partials, bytesPartials));
+            }
+
+            auto epilogueBlockDim = dim3(256u);
+            auto epilogueGridDim  = dim3(rocwmma::ceilDiv(m * n, epilogueBlockDim.x));
+
+            auto streamKKernel = [&](auto reductionMode) {
+                hipExtLaunchKernelGGL(
+                    (gemm_rocwmma_streamk_d<decltype(reductionMode)::value, false>),
+                    gridDim,
+                    blockDim,
+                    ldsusage,
+                    0,
+                    nullptr,
+                    nullptr,
+                    0,
+                    m,
+                    n,
+                    k,
+                    d_a,
+                    d_b,
+                    d_c,
+                    d_d,
+                    d_w,
+                    d_partials,
+                    d_tileCounters,
+                    d_gridBarrier,
+                    lda,
+                    ldb,
+                    ldw,
+                    alpha,
+                    beta,
+                    itersPerWg);
+            };
+
+            // Cooperative launch arguments must match the kernel parameter types exactly
+            auto fusedKernel = [&](auto reductionMode) {
+                OutputT const* c      = d_c;
+                uint32_t       uLda   = lda;
+                uint32_t       uLdb   = ldb;
+                uint32_t       uLdw   = ldw;
+                void*          args[] = {&m,
+                                         &n,
+                                         &k,
+                                         &d_a,
+                                         &d_b,
+                                         &c,
+                                         &d_d,
+                                         &d_w,
+                                         &d_partials,
+                                         &d_tileCounters,
+                                         &d_gridBarrier,
+                                         &uLda,
+                                         &uLdb,
+                                         &uLdw,
+                                         &alpha,
+                                         &beta,
+                                         &itersPerWg};
+                CHECK_HIP_ERROR(hipLaunchCooperativeKernel(
+                    reinterpret_cast<void const*>(
+                        gemm_rocwmma_streamk_d<decltype(reductionMode)::value, true>),
+                    gridDim,
+                    blockDim,
+                    args,
+                    ldsusage,
+                    nullptr));
+            };
+
+            // The ordered reduction stores every workspace element once, without zeroing
+            auto rocwmmaKernel = [&]() {
+                if(mode == WorkDecomposition::StreamKFused)
+                {
+                    if(reduction == ReductionMode::Atomic)
+                    {
+                        fusedKernel(
+                            std::integral_constant<ReductionMode, ReductionMode::Atomic>{});
+                    }
+                    else
+                    {
+                        fusedKernel(
+                            std::integral_constant<ReductionMode, ReductionMode::Ordered>{});
+                    }
+                    return;
+                }
+
+                if(reduction == ReductionMode::Atomic)
+                {
+                    CHECK_HIP_ERROR(hipMemsetAsync(d_w, 0, bytesW));
+                    streamKKernel(std::integral_constant<ReductionMode, ReductionMode::Atomic>{});
+                }
+                else
+                {
+                    streamKKernel(std::integral_constant<ReductionMode, ReductionMode::Ordered>{});
+                }
+                hipExtLaunchKernelGGL(gemm_epilogue_d,
+                                      epilogueGridDim,
+                                      epilogueBlockDim,
+                                      0,
+                                      0,
+                                      nullptr,
+                                      nullptr,
+                                      0,
+                                      m * n,
+                                      d_w,
+                                      d_c,
+                                      d_d,
+                                      alpha,
+                                      beta);
+            };
+
+            auto gFlops = calculateGFlops(m, n, k);
+
+            // Echo performance
+            for(auto cacheState :
+                {BenchmarkHarness::CacheState::Warm, BenchmarkHarness::CacheState::Cold})
+            {
+                auto stats        = harness.run(rocwmmaKernel, cacheState);
+                auto tFlopsPerSec = calculateTFlopsPerSec(m, n, k, stats.mMedianMs);
+
+                std::cout << hTBLOCK_X << ", " << hTBLOCK_Y << ", " << hBLOCKS_X << ", "
+                          << hBLOCKS_Y << ", " << hROCWMMA_M << ", " << hROCWMMA_N << ", "
+                          << hROCWMMA_K << ", " << m << ", " << n << ", " << k << ", " << alpha
+                          << ", " << lda << ", " << ldb << ", " << beta << ", " << ldc << ", "
+                          << ldd << ", " << toString(mode) << ", " << toString(reduction) << ", "
+                          << gridDim.x << ", " << itersPerWg << ", "
+                          << (cacheState == BenchmarkHarness::CacheState::Warm ? "warm" : "cold")
+                          << ", " << stats.mMedianMs << ", " << gFlops << ", " << tFlopsPerSec
+                          << ", ";
+                BenchmarkHarness::printStats(std::cout, stats) << std::endl;
+            }
+
+    #if !NDEBUG
+
+            // Bring kernel result back to host
+            CHECK_HIP_ERROR(hipMemcpy(matrixD.data(), d_d, bytesD, hipMemcpyDeviceToHost));
+
+            auto res = compareEqual(matrixD.data(), matrixD_ref.data(), m * n);
+
+            if(std::get<0>(res) == false)
+            {
+                std::cout << "FAILED\n";
+            }
+            else
+            {
+                std::cout << "PASSED\n";
+            }
+
+            std::cout << "Max relative error: " << std::get<1>(res) << std::endl;
+
+            // Run again and compare the bits of the two results
+            std::vector<OutputT> matrixD_rerun(m * n);
+            rocwmmaKernel();
+            CHECK_HIP_ERROR(hipMemcpy(matrixD_rerun.data(), d_d, bytesD, hipMemcpyDeviceToHost));
+
+            auto reproducible = std::memcmp(matrixD.data(), matrixD_rerun.data(), bytesD) == 0;
+            std::cout << "Bitwise reproducible: " << (reproducible ? "YES" : "NO") << std::endl;
+
+    #endif // !NDEBUG
+
+            if(d_partials)
+            {
+                CHECK_HIP_ERROR(hipFree(d_partials));
+            }
+        }
+    }
+
+    // Release device memory
+    CHECK_HIP_ERROR(hipFree(d_a));
+    CHECK_HIP_ERROR(hipFree(d_b));
+    CHECK_HIP_ERROR(hipFree(d_c));
+    CHECK_HIP_ERROR(hipFree(d_d));
+    CHECK_HIP_ERROR(hipFree(d_w));
+    CHECK_HIP_ERROR(hipFree(d_tileCounters));
+    CHECK_HIP_ERROR(hipFree(d_gridBarrier));
+
+    std::cout << "Finished!" << std::endl;
+}
+
+int main()
+{
+    // Small M x N relative to K
+    gemm_test(1024, 1024, 16384, 2, 2);
+    return 0;
+}
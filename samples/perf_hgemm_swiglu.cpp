@@ -0,0 +1,638 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_fp16.h>
+#include <hip/hip_runtime.h>
+
+#include <rocwmma/rocwmma.hpp>
+#include <rocwmma/rocwmma_epilogue.hpp>
+#include <rocwmma/rocwmma_pipeline.hpp>
+#include <rocwmma/rocwmma_tile.hpp>
+
+#include "benchmark_harness.hpp"
+#include "common.hpp"
+
+/* Motivation
+*
+* The feed-forward block of LLaMA-style transformers is a gated linear unit (SwiGLU):
+*
+* Y = (silu(X x W1) * (X x W3)) x W2, where
+*
+* X  = input tokens of M x D (M = token count, D = model dimension)
+* W1 = gate projection of D x H
+* W3 = up projection of D x H
+* W2 = down projection of H x D
+*
+* The unfused formulation runs the gate and up GEMMs separately, writes both M x H
+* results to global memory, and reads them back in an elementwise silu(gate) * up kernel.
+* It reads X twice, and writes and reads the two intermediates that are each consumed once.
+*
+* The fused kernel in this sample computes G = silu(X x W1) * (X x W3) in a single GEMM:
+*
+*   1. W1 and W3 are packed offline into one D x 2H weight W13, whose columns alternate
+*      between MACRO_TILE_Y columns of W1 and the same MACRO_TILE_Y columns of W3, like the
+*      merged gate_up projection of inference runtimes.
+*   2. Each workgroup stages the A macro tile and the 2 x MACRO_TILE_Y wide B macro tile of
+*      W13 through one rocwmma::lds_pipeline. The A fragments of each warp are read from LDS
+*      once per K step and multiplied into both the gate and the up accumulators.
+*   3. The epilogue computes silu(gate) * up in registers with the
+*      rocwmma::epilogue::GatedLinearUnit stage, and only G is written to global memory.
+*
+* The down projection Y = G x W2 is a plain GEMM and is not part of this sample.
+*
+* Packed layout of W13 (row major, D x 2H), T = MACRO_TILE_Y:
+*
+*   |<-- T -->|<-- T -->|<-- T -->|<-- T -->|
+*    _______________________________________
+*   |         |         |         |         |
+*   | W1 cols | W3 cols | W1 cols | W3 cols |  ...
+*   | [0, T)  | [0, T)  | [T, 2T) | [T, 2T) |
+*   |_________|_________|_________|_________|
+*
+* Flow per workgroup:
+*
+*       Start
+*         |
+*   Pre-Fetch Global A, W13 for K0; store LDS stage 0
+*         |
+*   loop --> Local read A (once), B gate, B up
+*   |         |
+*   |    Fetch Global A, W13 for K + 1; accum gate += A x B gate, up += A x B up
+*   |         |
+*   |    Store LDS stage K + 1
+*   |         |
+*   end_loop <-
+*         |
+*   G = silu(gate) * up (registers), write G
+*         |
+*         v
+*        End
+*
+* The fused kernel holds twice the accumulators of a GEMM of the same macro tile, so it
+* uses the same warp tile config and trades occupancy for the saved memory traffic.
+*/
+
+using namespace rocwmma;
+
+///
+/// Types and Data Layouts
+///
+
+using InputT   = float16_t;
+using OutputT  = float16_t;
+using ComputeT = float32_t;
+
+using DataLayoutA = col_major;
+using DataLayoutB = row_major;
+using DataLayoutC = row_major;
+
+///
+/// Parameter configuration
+///
+
+// Validated defaults of rocwmma::warp_tile_config for InputT and the target being compiled.
+// The host selects the same ones at runtime with get_warp_tile_params.
+using WarpTileConfig = warp_tile_config_t<InputT>;
+
+enum kernelParams : uint32_t
+{
+    ROCWMMA_M = WarpTileConfig::block_m,
+    ROCWMMA_N = WarpTileConfig::block_n,
+    ROCWMMA_K = WarpTileConfig::block_k,
+    BLOCKS_X  = WarpTileConfig::blocks_x,
+    BLOCKS_Y  = WarpTileConfig::blocks_y,
+    TBLOCK_X  = WarpTileConfig::tblock_x,
+    TBLOCK_Y  = WarpTileConfig::tblock_y,
+    WARP_SIZE = WarpTileConfig::wave_size
+};
+
+using DataLayoutLds = WarpTileConfig::lds_layout;
+
+// Warp tile: computed by each warp
+constexpr uint32_t WARP_TILE_X = BLOCKS_X * ROCWMMA_M;
+constexpr uint32_t WARP_TILE_Y = BLOCKS_Y * ROCWMMA_N;
+
+// Macro Tile: computed by each thread block (workgroup)
+constexpr uint32_t WARPS_X      = TBLOCK_X / WARP_SIZE;
+constexpr uint32_t WARPS_Y      = TBLOCK_Y;
+constexpr uint32_t MACRO_TILE_X = WARPS_X * WARP_TILE_X;
+constexpr uint32_t MACRO_TILE_Y = WARPS_Y * WARP_TILE_Y;
+
+// Elementwise gate kernel of the unfused path
+constexpr uint32_t GATE_TBLOCK = 256u;
+
+// Mfma frags
+using MfmaFragA   = fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, InputT, DataLayoutA>;
+using MfmaFragB   = fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, InputT, DataLayoutB>;
+using MfmaFragD   = fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, OutputT, DataLayoutC>;
+using MfmaFragAcc = fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, ComputeT>;
+
+// Warp tile of mfma frags
+using MfmaTileA   = fragment_array<MfmaFragA, BLOCKS_X, 1u>;
+using MfmaTileB   = fragment_array<MfmaFragB, 1u, BLOCKS_Y>;
+using MfmaTileD   = fragment_array<MfmaFragD, BLOCKS_X, BLOCKS_Y>;
+using MfmaTileAcc = fragment_array<MfmaFragAcc, BLOCKS_X, BLOCKS_Y>;
+
+// Global read (macro tile). The B macro tile holds BSets sets of MACRO_TILE_Y columns:
+// 1 for a plain GEMM, 2 for the gate and up columns of W13.
+using GRBuffA = fragment<matrix_a, MACRO_TILE_X, ROCWMMA_N, ROCWMMA_K, InputT, DataLayoutA>;
+
+template <uint32_t BSets>
+using GRBuffB = fragment<matrix_b, ROCWMMA_M, BSets * MACRO_TILE_Y, ROCWMMA_K, InputT, DataLayoutB>;
+
+// Double buffered LDS staging of the global buffers (macro tile)
+template <uint32_t BSets>
+using LdsPipeline
+    = lds_pipeline<2u, WARPS_X * WARPS_Y, GRBuffA, GRBuffB<BSets>, DataLayoutLds, lds_access>;
+
+// Computes one macro tile of D = A x B (BSets = 1), or of D = silu(A x B1) * (A x B3) over the
+// packed W13 (BSets = 2), where tileCoord is the 2D index of the macro tile in D.
+// Matrix sizes must be multiples of the macro tile size.
+template <uint32_t BSets>
+ROCWMMA_DEVICE static inline void gemmGluMacroTile(Coord2d const& tileCoord,
+                                                   uint32_t       k,
+                                                   InputT const*  a,
+                                                   InputT const*  b,
+                                                   OutputT*       d,
+                                                   uint32_t       lda,
+                                                   uint32_t       ldb,
+                                                   uint32_t       ldd,
+                                                   InputT*        ldsPtr)
+{
+    static_assert(BSets == 1u || BSets == 2u, "Plain or gated GEMM only");
+
+    using Pipeline = LdsPipeline<BSets>;
+
+    // Tile Sizes
+    constexpr auto warpTileSize  = make_coord2d(WARP_TILE_X, WARP_TILE_Y);
+    constexpr auto macroTileSize = make_coord2d(MACRO_TILE_X, MACRO_TILE_Y);
+
+    // Local warp coordinate relative to current threadblock (wg).
+    auto localWarpCoord  = make_coord2d(threadIdx.x / WARP_SIZE, threadIdx.y);
+    auto localWarpOffset = localWarpCoord * warpTileSize;
+
+    // Global matrix coordinates for D
+    auto macroTileCoord = tileCoord * macroTileSize;
+    auto warpTileCoord  = macroTileCoord + localWarpOffset;
+
+    ///
+    /// 1D global read coordinate setup
+    /// The B macro tile of tile column j starts at column BSets * j * MACRO_TILE_Y
+    ///
+    using GRBuffAMap1d = GetDataLayout_t<GRBuffA>;
+    using GRBuffBMap1d = GetDataLayout_t<GRBuffB<BSets>>;
+
+    auto globalReadOffsetA
+        = GRBuffAMap1d::fromMatrixCoord(make_coord2d(get<0>(macroTileCoord), 0u), lda);
+    auto globalReadOffsetB
+        = GRBuffBMap1d::fromMatrixCoord(make_coord2d(0u, BSets * get<1>(macroTileCoord)), ldb);
+
+    auto kStepOffsetA = GRBuffAMap1d::fromMatrixCoord(make_coord2d(0u, ROCWMMA_K), lda);
+    auto kStepOffsetB = GRBuffBMap1d::fromMatrixCoord(make_coord2d(ROCWMMA_K, 0u), ldb);
+
+    // Warps cooperate in row major order
+    const auto warpIndex = get<0>(localWarpCoord) * WARPS_Y + get<1>(localWarpCoord);
+
+    Pipeline pipeline(ldsPtr, warpIndex);
+
+    ///
+    /// Perform initial global pre-fetch and write to local
+    ///
+    pipeline.global_read(a + globalReadOffsetA, lda, b + globalReadOffsetB, ldb);
+    globalReadOffsetA += kStepOffsetA;
+    globalReadOffsetB += kStepOffsetB;
+    pipeline.local_write();
+
+    ///
+    /// Initialize accumulation frags: gate (or plain GEMM) and up
+    ///
+    MfmaTileAcc fragsAcc[BSets];
+#pragma unroll
+    for(uint32_t s = 0u; s < BSets; s++)
+    {
+        fill_fragment(fragsAcc[s], 0.0f);
+    }
+
+    synchronize_workgroup();
+
+    // Local reads A once per K step, and multiplies it into each set of B
+    auto localReadMma = [&]() {
+        MfmaTileA fragsA;
+        pipeline.local_read_a(fragsA, get<0>(localWarpOffset));
+
+#pragma unroll
+        for(uint32_t s = 0u; s < BSets; s++)
+        {
+            MfmaTileB fragsB;
+            pipeline.local_read_b(fragsB, s * MACRO_TILE_Y + get<1>(localWarpOffset));
+            mma_sync(fragsAcc[s], fragsA, fragsB, fragsAcc[s]);
+        }
+    };
+
+    auto kSteps = k / ROCWMMA_K;
+    for(uint32_t step = 1u; step < kSteps; step++)
+    {
+        // Prefetch next round of global frags, then accumulate the read stage
+        pipeline.global_read(a + globalReadOffsetA, lda, b + globalReadOffsetB, ldb);
+        globalReadOffsetA += kStepOffsetA;
+        globalReadOffsetB += kStepOffsetB;
+
+        localReadMma();
+
+        // Write prefetch to the write stage
+        pipeline.local_write();
+
+        // Make sure that all waves have finished reading / writing to lds for this step.
+        synchronize_workgroup();
+
+        pipeline.advance();
+    }
+
+    // Tail A * B
+    localReadMma();
+
+    ///
+    /// D = acc, or D = silu(gate) * up
+    ///
+    MfmaTileD fragsD;
+#pragma unroll
+    for(uint32_t i = 0u; i < BLOCKS_X; i++)
+    {
+#pragma unroll
+        for(uint32_t j = 0u; j < BLOCKS_Y; j++)
+        {
+            if constexpr(BSets == 1u)
+            {
+                apply_epilogue(fragsD(i, j), fragsAcc[0](i, j));
+            }
+            else
+            {
+                apply_epilogue(fragsD(i, j),
+                               fragsAcc[0](i, j),
+                               epilogue::GatedLinearUnit<epilogue::Silu, MfmaFragAcc>(
+                                   fragsAcc[1](i, j)));
+            }
+        }
+    }
+
+    using MfmaFragDMap1d = GetDataLayout_t<MfmaFragD>;
+    store_matrix_sync(d + MfmaFragDMap1d::fromMatrixCoord(warpTileCoord, ldd), fragsD, ldd);
+}
+
+template <uint32_t BSets>
+ROCWMMA_KERNEL void __launch_bounds__(256) gemm_glu_rocwmma_d(uint32_t      k,
+                                                              InputT const* a,
+                                                              InputT const* b,
+                                                              OutputT*      d,
+                                                              uint32_t      lda,
+                                                              uint32_t      ldb,
+                                                              uint32_t      ldd)
+{
+    if constexpr(!ROCWMMA_ARCH_HOST)
+    {
+        HIP_DYNAMIC_SHARED(void*, localMemPtr);
+        gemmGluMacroTile<BSets>(make_coord2d(blockIdx.x, blockIdx.y),
+                                k,
+                                a,
+                                b,
+                                d,
+                                lda,
+                                ldb,
+                                ldd,
+                                reinterpret_cast<InputT*>(localMemPtr));
+    }
+}
+
+// Unfused gate: g = silu(gate) * up, elementwise over size elements
+ROCWMMA_KERNEL void __launch_bounds__(GATE_TBLOCK)
+    swiglu_gate_d(uint32_t size, OutputT const* gate, OutputT const* up, OutputT* g)
+{
+    auto idx = blockIdx.x * GATE_TBLOCK + threadIdx.x;
+    if(idx < size)
+    {
+        auto gateC = epilogue::Silu::exec(static_cast<ComputeT>(gate[idx]));
+        g[idx]     = static_cast<OutputT>(gateC * static_cast<ComputeT>(up[idx]));
+    }
+}
+
+// Packs W1 and W3 (row major, d x h) into W13 (row major, d x 2h), alternating tileWidth
+// columns of each
+template <typename DataT>
+ROCWMMA_HOST void packGateUp(uint32_t     d,
+                             uint32_t     h,
+                             uint32_t     tileWidth,
+                             DataT const* w1,
+                             DataT const* w3,
+                             DataT*       w13)
+{
+    for(uint32_t row = 0u; row < d; row++)
+    {
+        for(uint32_t col = 0u; col < h; col++)
+        {
+            auto packedCol = (col / tileWidth) * 2u * tileWidth + col % tileWidth;
+
+            w13[row * 2u * h + packedCol]             = w1[row * h + col];
+            w13[row * 2u * h + packedCol + tileWidth] = w3[row * h + col];
+        }
+    }
+}
+
+ROCWMMA_HOST void swiglu_test(uint32_t m, uint32_t h, uint32_t k)
+{
+    // Runtime checks for host parameters, selected with the same config as the device
+    auto     params       = get_warp_tile_params<InputT>(getGcnArchId());
+    uint32_t hTBLOCK_X    = params.tblock_x;
+    uint32_t hTBLOCK_Y    = params.tblock_y;
+    uint32_t hROCWMMA_K   = params.block_k;
+    uint32_t hWARP_TILE_X = params.blocks_x * params.block_m;
+    uint32_t hWARP_TILE_Y = params.blocks_y * params.block_n;
+
+    // Runtime warp calculation (host code needs to query warpsize dynamically)
+    auto warpSize = getWarpSize();
+    auto macroTileSize
+        = make_coord2d(hTBLOCK_X / warpSize * hWARP_TILE_X, hTBLOCK_Y * hWARP_TILE_Y);
+
+    if(warpSize != params.wave_size)
+    {
+        std::cout << "Unsupported wave size!\n";
+        return;
+    }
+
+    // Bounds check: whole macro tiles only
+    if(m % get<0>(macroTileSize) || h % get<1>(macroTileSize) || k % hROCWMMA_K)
+    {
+        std::cout << "Unsupported matrix size!\n";
+        return;
+    }
+
+    // X is col major (M x K), W1, W3 are row major (K x H), and W13 row major (K x 2H)
+    uint32_t lda   = m;
+    uint32_t ldb   = h;
+    uint32_t ldb13 = 2u * h;
+    uint32_t ldd   = h;
+
+    std::cout << "Initializing host data..." << std::endl;
+
+    std::vector<InputT> matrixX(m * k);
+    std::vector<InputT> matrixW1(k * h);
+    std::vector<InputT> matrixW3(k * h);
+    std::vector<InputT> matrixW13(k * 2u * h);
+
+    // Fill outputs with NaN to catch contamination
+    std::vector<OutputT> matrixG(m * h, std::numeric_limits<OutputT>::signaling_NaN());
+
+    fillRand(matrixX.data(), m, k);
+    fillRand(matrixW1.data(), k, h);
+    fillRand(matrixW3.data(), k, h);
+
+    // Scale the weights by a power of two, such that silu(gate) * up stays in half range
+    for(auto* w : {&matrixW1, &matrixW3})
+    {
+        for(auto& v : *w)
+        {
+            v = static_cast<InputT>(static_cast<float32_t>(v) / 1024.0f);
+        }
+    }
+
+    packGateUp(k, h, get<1>(macroTileSize), matrixW1.data(), matrixW3.data(), matrixW13.data());
+
+    std::cout << "Initializing device data..." << std::endl;
+
+    InputT*  d_x;
+    InputT*  d_w1;
+    InputT*  d_w3;
+    InputT*  d_w13;
+    OutputT* d_gate;
+    OutputT* d_up;
+    OutputT* d_g;
+
+    const size_t bytesX   = matrixX.size() * sizeof(InputT);
+    const size_t bytesW   = matrixW1.size() * sizeof(InputT);
+    const size_t bytesW13 = matrixW13.size() * sizeof(InputT);
+    const size_t bytesG   = matrixG.size() * sizeof(OutputT);
+
+    CHECK_HIP_ERROR(hipMalloc(&d_x, bytesX));
+    CHECK_HIP_ERROR(hipMalloc(&d_w1, bytesW));
+    CHECK_HIP_ERROR(hipMalloc(&d_w3, bytesW));
+    CHECK_HIP_ERROR(hipMalloc(&d_w13, bytesW13));
+    CHECK_HIP_ERROR(hipMalloc(&d_gate, bytesG));
+    CHECK_HIP_ERROR(hipMalloc(&d_up, bytesG));
+    CHECK_HIP_ERROR(hipMalloc(&d_g, bytesG));
+
+    CHECK_HIP_ERROR(hipMemcpy(d_x, matrixX.data(), bytesX, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_w1, matrixW1.data(), bytesW, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_w3, matrixW3.data(), bytesW, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_w13, matrixW13.data(), bytesW13, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_g, matrixG.data(), bytesG, hipMemcpyHostToDevice));
+
+    auto blockDim = dim3(hTBLOCK_X, hTBLOCK_Y);
+    auto gridDim  = dim3(m / get<0>(macroTileSize), h / get<1>(macroTileSize));
+
+    // LDS stages of A and BSets sets of B
+    auto ldsusage = [&](uint32_t bSets) {
+        return 2u * sizeof(InputT) * (get<0>(macroTileSize) + bSets * get<1>(macroTileSize))
+               * hROCWMMA_K;
+    };
+
+    std::cout << "gridDim (" << gridDim.x << " " << gridDim.y << ")"
+              << " blockdim (" << blockDim.x << " " << blockDim.y << ")" << std::endl;
+
+    auto gemmKernel = [&](InputT const* b, OutputT* d) {
+        hipExtLaunchKernelGGL((gemm_glu_rocwmma_d<1u>),
+                              gridDim,
+                              blockDim,
+                              ldsusage(1u),
+                              0,
+                              nullptr,
+                              nullptr,
+                              0,
+                              k,
+                              d_x,
+                              b,
+                              d,
+                              lda,
+                              ldb,
+                              ldd);
+    };
+
+    // Gate GEMM, up GEMM and elementwise gate
+    auto unfusedKernel = [&]() {
+        gemmKernel(d_w1, d_gate);
+        gemmKernel(d_w3, d_up);
+        hipExtLaunchKernelGGL(swiglu_gate_d,
+                              dim3(ceilDiv(m * h, GATE_TBLOCK)),
+                              dim3(GATE_TBLOCK),
+                              0,
+                              0,
+                              nullptr,
+                              nullptr,
+                              0,
+                              m * h,
+                              d_gate,
+                              d_up,
+                              d_g);
+    };
+
+    auto fusedKernel = [&]() {
+        hipExtLaunchKernelGGL((gemm_glu_rocwmma_d<2u>),
+                              gridDim,
+                              blockDim,
+                              ldsusage(2u),
+                              0,
+                              nullptr,
+                              nullptr,
+                              0,
+                              k,
+                              d_x,
+                              d_w13,
+                              d_g,
+                              lda,
+                              ldb13,
+                              ldd);
+    };
+
+    // Runs are timed individually, with warm and cold caches
+    BenchmarkHarness harness;
+
+    // Both paths compute the 2 GEMMs of M x H x K
+    auto echo = [&](const char* kernelName, auto&& kernel) {
+        auto gFlops = 2.0 * calculateGFlops(m, h, k);
+
+        for(auto cacheState :
+            {BenchmarkHarness::CacheState::Warm, BenchmarkHarness::CacheState::Cold})
+        {
+            auto stats        = harness.run(kernel, cacheState);
+            auto tFlopsPerSec = gFlops / stats.mMedianMs;
+
+            std::cout << kernelName << ", " << hTBLOCK_X << ", " << hTBLOCK_Y << ", "
+                      << params.blocks_x << ", " << params.blocks_y << ", " << params.block_m
+                      << ", " << params.block_n << ", " << hROCWMMA_K << ", " << m << ", " << h
+                      << ", " << k << ", "
+                      << (cacheState == BenchmarkHarness::CacheState::Warm ? "warm" : "cold")
+                      << ", " << stats.mMedianMs << ", " << gFlops << ", " << tFlopsPerSec
+                      << ", ";
+            BenchmarkHarness::printStats(std::cout, stats) << std::endl;
+        }
+    };
+
+#if !NDEBUG
+
+    // Reference gate and up projections in ComputeT, then G in OutputT
+    std::vector<OutputT> matrixG_ref(m * h);
+    {
+        std::vector<ComputeT> gate(m * h, 0.0f);
+        std::vector<ComputeT> up(m * h, 0.0f);
+
+        gemm_cpu_h<InputT, ComputeT, ComputeT, DataLayoutA, DataLayoutB, DataLayoutC>(
+            m,
+            h,
+            k,
+            matrixX.data(),
+            matrixW1.data(),
+            gate.data(),
+            gate.data(),
+            lda,
+            ldb,
+            ldd,
+            ldd,
+            1.0f,
+            0.0f);
+        gemm_cpu_h<InputT, ComputeT, ComputeT, DataLayoutA, DataLayoutB, DataLayoutC>(
+            m,
+            h,
+            k,
+            matrixX.data(),
+            matrixW3.data(),
+            up.data(),
+            up.data(),
+            lda,
+            ldb,
+            ldd,
+            ldd,
+            1.0f,
+            0.0f);
+
+        for(uint32_t i = 0u; i < m * h; i++)
+        {
+            matrixG_ref[i]
+                = static_cast<OutputT>(gate[i] / (1.0f + std::exp(-gate[i])) * up[i]);
+        }
+    }
+
+    auto validate = [&]() {
+        CHECK_HIP_ERROR(hipMemcpy(matrixG.data(), d_g, bytesG, hipMemcpyDeviceToHost));
+
+        auto res = compareEqual(matrixG.data(), matrixG_ref.data(), m * h);
+
+        std::cout << (std::get<0>(res) ? "PASSED" : "FAILED") << std::endl;
+        std::cout << "Max relative error: " << std::get<1>(res) << std::endl;
+    };
+
+#endif // !NDEBUG
+
+    std::cout << "Kernel, TBlockX, TBlockY, BlocksX, BlocksY, BlkM, BlkN, BlkK, "
+              << "MatM, MatH, MatK, Cache, elapsedMs, Problem Size(GFlops), TFlops/s, "
+              << BenchmarkHarness::statsHeader() << std::endl;
+
+    echo("Unfused", unfusedKernel);
+
+#if !NDEBUG
+    validate();
+#endif // !NDEBUG
+
+    // Fill outputs with NaN to catch contamination
+    CHECK_HIP_ERROR(hipMemset(d_g, 0xFF, bytesG));
+
+    echo("FusedSwiGLU", fusedKernel);
+
+#if !NDEBUG
+    validate();
+#endif // !NDEBUG
+
+    // Release device memory
+    CHECK_HIP_ERROR(hipFree(d_x));
+    CHECK_HIP_ERROR(hipFree(d_w1));
+    CHECK_HIP_ERROR(hipFree(d_w3));
+    CHECK_HIP_ERROR(hipFree(d_w13));
+    CHECK_HIP_ERROR(hipFree(d_gate));
+    CHECK_HIP_ERROR(hipFree(d_up));
+    CHECK_HIP_ERROR(hipFree(d_g));
+
+    std::cout << "Finished!" << std::endl;
+}
+
+int main()
+{
+    // LLaMA-7B feed-forward gate and up projections (H = 11008), prefill and decode-batch tokens
+    swiglu_test(4096, 11008, 4096);
+    swiglu_test(256, 11008, 4096);
+
+    return 0;
+}
@@ -0,0 +1,782 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_fp16.h>
+#include <hip/hip_runtime.h>
+
+#if ROCWMMA_BENCHMARK_WITH_HIPBLASLT
+#include <hipblaslt/hipblaslt.h>
+#endif // ROCWMMA_BENCHMARK_WITH_HIPBLASLT
+
+#include <rocwmma/rocwmma.hpp>
+#include <rocwmma/rocwmma_coop.hpp>
+#include <rocwmma/rocwmma_dispatch.hpp>
+#include <rocwmma/rocwmma_epilogue.hpp>
+#include <rocwmma/rocwmma_pipeline.hpp>
+
+#include "benchmark_harness.hpp"
+#include "common.hpp"
+
+/* Motivation
+*
+* perf_hgemm is tuned primarily for gfx9 wave64 targets, with a single gfx11 configuration
+* and a fixed __launch_bounds__(256). This sample is the wave32 counterpart, for the WMMA
+* targets gfx1100, gfx1101, gfx1102, gfx1200 and gfx1201 only. It follows the same
+* LDS pipelined macro tile structure as perf_hgemm, with two differences:
+*
+* 1) Per-target tuning
+*    Each target has its own warp tile, workgroup and LDS pipeline depth (see the table below),
+*    and launch bounds derived from its workgroup size. The host selects the kernel
+*    instantiation of the device arch through rocwmma::arch_dispatch.
+*
+* 2) Padded accumulators
+*    The WMMA instructions accumulate in 32b elements. With 16b accumulation (ComputeT =
+*    float16_t), mma_sync pads the packed fragment into 32b elements before the WMMA
+*    instructions and unpads it after, on every call. Here each wave keeps its accumulators
+*    in the padded layout for the whole K loop in rocwmma::native_accumulator, and unpads
+*    them once with from_native before the epilogue. With 32b accumulation the padding is
+*    a no-op, and both ComputeT variants are benchmarked.
+*
+* When built with ROCWMMA_BENCHMARK_WITH_HIPBLASLT, the same problems are also run with
+* hipBLASLt for comparison.
+*/
+
+using namespace rocwmma;
+
+///
+/// Parameter configuration
+///
+
+/* Starting points from the Wg_Autotune search space, per target.
+* ____________________________________________________________________________
+*|          |           |          |          |          |          |          |
+*|          | ROCWMMA_K | BLOCKS_X | BLOCKS_Y | TBLOCK_X | TBLOCK_Y | LDS      |
+*|          |           |          |          |          |          | DEPTH    |
+*|__________|___________|__________|__________|__________|__________|__________|
+*|          |           |          |          |          |          |          |
+*|  gfx1100 |    32     |    4     |    4     |    64    |    4     |    2     |
+*|__________|___________|__________|__________|__________|__________|__________|
+*|          |           |          |          |          |          |          |
+*|  gfx1101 |    32     |    4     |    2     |    64    |    2     |    2     |
+*|  gfx1102 |           |          |          |          |          |          |
+*|__________|___________|__________|__________|__________|__________|__________|
+*|          |           |          |          |          |          |          |
+*|  gfx1200 |    32     |    4     |    2     |    64    |    4     |    3     |
+*|  gfx1201 |           |          |          |          |          |          |
+*|__________|___________|__________|__________|__________|__________|__________|
+*
+* ROCWMMA_M = ROCWMMA_N = 16 and WARP_SIZE = 32 on all targets.
+*/
+
+template <uint32_t BlockK,
+          uint32_t BlocksX,
+          uint32_t BlocksY,
+          uint32_t TBlockX,
+          uint32_t TBlockY,
+          uint32_t LdsPipelineDepth>
+struct Wave32Params
+{
+    enum kernelParams : uint32_t
+    {
+        ROCWMMA_M          = 16u,
+        ROCWMMA_N          = 16u,
+        ROCWMMA_K          = BlockK,
+        BLOCKS_X           = BlocksX,
+        BLOCKS_Y           = BlocksY,
+        TBLOCK_X           = TBlockX,
+        TBLOCK_Y           = TBlockY,
+        LDS_PIPELINE_DEPTH = LdsPipelineDepth,
+        WARP_SIZE          = Constants::AMDGCN_WAVE_SIZE_32,
+
+        // Warp tile: computed by each warp
+        WARP_TILE_X = BLOCKS_X * ROCWMMA_M,
+        WARP_TILE_Y = BLOCKS_Y * ROCWMMA_N,
+
+        // Macro Tile: computed by each thread block (workgroup)
+        WARPS_X      = TBLOCK_X / WARP_SIZE,
+        WARPS_Y      = TBLOCK_Y,
+        MACRO_TILE_X = WARPS_X * WARP_TILE_X,
+        MACRO_TILE_Y = WARPS_Y * WARP_TILE_Y
+    };
+
+    static_assert(TBLOCK_X % WARP_SIZE == 0u, "TBLOCK_X must be a multiple of WARP_SIZE");
+};
+
+using gfx1100Params = Wave32Params<32u, 4u, 4u, 64u, 4u, 2u>;
+using gfx1101Params = Wave32Params<32u, 4u, 2u, 64u, 2u, 2u>;
+using gfx1102Params = gfx1101Params;
+using gfx1200Params = Wave32Params<32u, 4u, 2u, 64u, 4u, 3u>;
+using gfx1201Params = gfx1200Params;
+
+///
+/// Types and Data Layouts
+///
+
+using InputT  = float16_t;
+using OutputT = float16_t;
+
+using DataLayoutA   = col_major;
+using DataLayoutB   = row_major;
+using DataLayoutC   = row_major;
+using DataLayoutLds = col_major;
+
+template <typename Params, typename ComputeT>
+struct Wave32Gemm
+{
+    // Mma frags
+    using FragA = fragment<matrix_a,
+                           Params::ROCWMMA_M,
+                           Params::ROCWMMA_N,
+                           Params::ROCWMMA_K,
+                           InputT,
+                           DataLayoutA>;
+    using FragB = fragment<matrix_b,
+                           Params::ROCWMMA_M,
+                           Params::ROCWMMA_N,
+                           Params::ROCWMMA_K,
+                           InputT,
+                           DataLayoutB>;
+    using FragC = fragment<accumulator,
+                           Params::ROCWMMA_M,
+                           Params::ROCWMMA_N,
+                           Params::ROCWMMA_K,
+                           OutputT,
+                           DataLayoutC>;
+    using FragD = FragC;
+    using FragAcc
+        = fragment<accumulator, Params::ROCWMMA_M, Params::ROCWMMA_N, Params::ROCWMMA_K, ComputeT>;
+
+    // Global read (macro tile)
+    using GRBuffA = fragment<matrix_a,
+                             Params::MACRO_TILE_X,
+                             Params::ROCWMMA_N,
+                             Params::ROCWMMA_K,
+                             InputT,
+                             DataLayoutA>;
+    using GRBuffB = fragment<matrix_b,
+                             Params::ROCWMMA_M,
+                             Params::MACRO_TILE_Y,
+                             Params::ROCWMMA_K,
+                             InputT,
+                             DataLayoutB>;
+
+    using LdsPipeline = lds_pipeline<Params::LDS_PIPELINE_DEPTH,
+                                     Params::WARPS_X * Params::WARPS_Y,
+                                     GRBuffA,
+                                     GRBuffB,
+                                     DataLayoutLds>;
+
+    // Accumulator in the padded WMMA register layout
+    using AccumT = native_accumulator<Params::ROCWMMA_M,
+                                      Params::ROCWMMA_N,
+                                      Params::ROCWMMA_K,
+                                      InputT,
+                                      ComputeT>;
+
+    constexpr static uint32_t BlocksX = Params::BLOCKS_X;
+    constexpr static uint32_t BlocksY = Params::BLOCKS_Y;
+
+    // accum(A * B) over the warp tile, in the padded accumulator layout
+    ROCWMMA_DEVICE static inline void mma(AccumT (&accums)[BlocksX][BlocksY],
+                                          FragA const (&fragsA)[BlocksX],
+                                          FragB const (&fragsB)[BlocksY])
+    {
+#pragma unroll
+        for(int i = 0; i < BlocksX; i++)
+        {
+#pragma unroll
+            for(int j = 0; j < BlocksY; j++)
+            {
+                mma_sync(accums[i][j], fragsA[i], fragsB[j]);
+            }
+        }
+    }
+
+    // Computes the macro tile of D = alpha * (A x B) + beta * C at blockIdx
+    ROCWMMA_DEVICE static inline void gemmMacroTile(uint32_t       m,
+                                                    uint32_t       n,
+                                                    uint32_t       k,
+                                                    InputT const*  a,
+                                                    InputT const*  b,
+                                                    OutputT const* c,
+                                                    OutputT*       d,
+                                                    uint32_t       lda,
+                                                    uint32_t       ldb,
+                                                    uint32_t       ldc,
+                                                    uint32_t       ldd,
+                                                    ComputeT       alpha,
+                                                    ComputeT       beta,
+                                                    InputT*        ldsPtr)
+    {
+        ///
+        /// 2D matrix coordinate setup
+        ///
+        constexpr auto warpTileSize  = make_coord2d(Params::WARP_TILE_X, Params::WARP_TILE_Y);
+        constexpr auto macroTileSize = make_coord2d(Params::MACRO_TILE_X, Params::MACRO_TILE_Y);
+
+        auto localWarpCoord  = make_coord2d(threadIdx.x / Params::WARP_SIZE, threadIdx.y);
+        auto localWarpOffset = localWarpCoord * warpTileSize;
+
+        auto macroTileCoord = make_coord2d(blockIdx.x, blockIdx.y) * macroTileSize;
+        auto warpTileCoord  = macroTileCoord + localWarpOffset;
+
+        // Bounds check
+        auto warpTileBound = warpTileCoord + warpTileSize;
+        if(get<0>(warpTileBound) > m || get<1>(warpTileBound) > n)
+        {
+            return;
+        }
+
+        ///
+        /// 1D global read coordinate setup
+        ///
+        using GRBuffAMap1d = GetDataLayout_t<GRBuffA>;
+        using GRBuffBMap1d = GetDataLayout_t<GRBuffB>;
+
+        auto globalReadOffsetA
+            = GRBuffAMap1d::fromMatrixCoord(make_coord2d(get<0>(macroTileCoord), 0u), lda);
+        auto globalReadOffsetB
+            = GRBuffBMap1d::fromMatrixCoord(make_coord2d(0u, get<1>(macroTileCoord)), ldb);
+
+        auto kStepOffsetA
+            = GRBuffAMap1d::fromMatrixCoord(make_coord2d(0u, Params::ROCWMMA_K), lda);
+        auto kStepOffsetB
+            = GRBuffBMap1d::fromMatrixCoord(make_coord2d(Params::ROCWMMA_K, 0u), ldb);
+
+        ///
+        /// Setup LDS pipeline, warps scheduled in row major order
+        ///
+        const auto warpIndex = get<0>(localWarpCoord) * Params::WARPS_Y + get<1>(localWarpCoord);
+
+        LdsPipeline pipeline(ldsPtr, warpIndex);
+
+        auto kSteps        = k / Params::ROCWMMA_K;
+        auto prologueSteps = std::min(LdsPipeline::depth - 1u, kSteps);
+        for(uint32_t step = 0u; step < prologueSteps; step++)
+        {
+            pipeline.global_read(a + globalReadOffsetA, lda, b + globalReadOffsetB, ldb);
+            globalReadOffsetA += kStepOffsetA;
+            globalReadOffsetB += kStepOffsetB;
+            pipeline.local_write();
+        }
+
+        ///
+        /// Padded accumulators are initialized once, and unpadded after the K loop.
+        ///
+        AccumT accums[BlocksX][BlocksY];
+        {
+            FragAcc fragZero;
+            fill_fragment(fragZero, static_cast<ComputeT>(0));
+#pragma unroll
+            for(int i = 0; i < BlocksX; i++)
+            {
+#pragma unroll
+                for(int j = 0; j < BlocksY; j++)
+                {
+                    to_native(accums[i][j], fragZero);
+                }
+            }
+        }
+
+        synchronize_workgroup();
+
+        for(uint32_t step = prologueSteps; step < kSteps; step++)
+        {
+            FragA fragsA[BlocksX];
+            FragB fragsB[BlocksY];
+
+            pipeline.local_read_a(fragsA, get<0>(localWarpOffset));
+            pipeline.local_read_b(fragsB, get<1>(localWarpOffset));
+
+            if constexpr(LdsPipeline::depth >= 3u)
+            {
+                synchronize_workgroup();
+            }
+
+            pipeline.global_read(a + globalReadOffsetA, lda, b + globalReadOffsetB, ldb);
+            globalReadOffsetA += kStepOffsetA;
+            globalReadOffsetB += kStepOffsetB;
+
+            mma(accums, fragsA, fragsB);
+
+            pipeline.local_write();
+
+            if constexpr(LdsPipeline::depth == 2u)
+            {
+                synchronize_workgroup();
+            }
+
+            pipeline.advance();
+        }
+
+        ///
+        /// Start loading C
+        ///
+        using FragCMap1d = GetDataLayout_t<FragC>;
+        using FragDMap1d = GetDataLayout_t<FragD>;
+
+        auto blockStepX = FragCMap1d::fromMatrixCoord(make_coord2d(Params::ROCWMMA_M, 0u), ldc);
+        auto blockStepY = FragCMap1d::fromMatrixCoord(make_coord2d(0u, Params::ROCWMMA_N), ldc);
+
+        FragC fragsC[BlocksX][BlocksY];
+        auto  gAddrC = c + FragCMap1d::fromMatrixCoord(warpTileCoord, ldc);
+#pragma unroll
+        for(int i = 0; i < BlocksX; i++)
+        {
+#pragma unroll
+            for(int j = 0; j < BlocksY; j++)
+            {
+                load_matrix_sync(fragsC[i][j], gAddrC + i * blockStepX + j * blockStepY, ldc);
+            }
+        }
+
+        if constexpr(LdsPipeline::depth >= 3u)
+        {
+            synchronize_workgroup();
+        }
+
+        ///
+        /// Clean up tail A * B from the remaining stages
+        ///
+        for(uint32_t step = 0u; step < prologueSteps; step++)
+        {
+            FragA fragsA[BlocksX];
+            FragB fragsB[BlocksY];
+
+            pipeline.local_read_a(fragsA, get<0>(localWarpOffset));
+            pipeline.local_read_b(fragsB, get<1>(localWarpOffset));
+            mma(accums, fragsA, fragsB);
+
+            pipeline.advance();
+        }
+
+        ///
+        /// Unpad once, then D = alpha * accum + beta * C
+        ///
+        auto gAddrD = d + FragDMap1d::fromMatrixCoord(warpTileCoord, ldd);
+#pragma unroll
+        for(int i = 0; i < BlocksX; i++)
+        {
+#pragma unroll
+            for(int j = 0; j < BlocksY; j++)
+            {
+                FragAcc fragAcc;
+                FragD   fragD;
+                from_native(fragAcc, accums[i][j]);
+                apply_epilogue(
+                    fragD, fragAcc, epilogue::LinearCombination(alpha, beta, fragsC[i][j]));
+                store_matrix_sync(gAddrD + i * blockStepX + j * blockStepY, fragD, ldd);
+            }
+        }
+    }
+};
+
+// Wave32 kernel: one workgroup per macro tile.
+// The body is empty on wave64 targets, and on the host.
+template <typename Params, typename ComputeT>
+ROCWMMA_KERNEL void __launch_bounds__(Params::TBLOCK_X* Params::TBLOCK_Y)
+    gemm_wave32_d(uint32_t       m,
+                  uint32_t       n,
+                  uint32_t       k,
+                  InputT const*  a,
+                  InputT const*  b,
+                  OutputT const* c,
+                  OutputT*       d,
+                  uint32_t       lda,
+                  uint32_t       ldb,
+                  uint32_t       ldc,
+                  uint32_t       ldd,
+                  ComputeT       alpha,
+                  ComputeT       beta)
+{
+#if ROCWMMA_ARCH_GFX11 || ROCWMMA_ARCH_GFX12
+    HIP_DYNAMIC_SHARED(void*, localMemPtr);
+    Wave32Gemm<Params, ComputeT>::gemmMacroTile(m,
+                                                n,
+                                                k,
+                                                a,
+                                                b,
+                                                c,
+                                                d,
+                                                lda,
+                                                ldb,
+                                                ldc,
+                                                ldd,
+                                                alpha,
+                                                beta,
+                                                reinterpret_cast<InputT*>(localMemPtr));
+#endif // ROCWMMA_ARCH_GFX11 || ROCWMMA_ARCH_GFX12
+}
+
+#if ROCWMMA_BENCHMARK_WITH_HIPBLASLT
+
+#ifndef CHECK_HIPBLASLT_ERROR
+#define CHECK_HIPBLASLT_ERROR(status)                   \
+    if(status != HIPBLAS_STATUS_SUCCESS)                \
+    {                                                   \
+        fprintf(stderr,                                 \
+                "hipBLASLt error: '%s'(%d) at %s:%d\n", \
+                hipblasStatusToString(status),          \
+                status,                                 \
+                __FILE__,                               \
+                __LINE__);                              \
+        exit(EXIT_FAILURE);                             \
+    }
+#endif
+
+// hipBLASLt scale / compute types of ComputeT
+template <typename ComputeT>
+struct HipblasLtTypes;
+
+template <>
+struct HipblasLtTypes<float32_t>
+{
+    constexpr static hipDataType          ScaleType   = HIP_R_32F;
+    constexpr static hipblasComputeType_t ComputeType = HIPBLAS_COMPUTE_32F;
+};
+
+template <>
+struct HipblasLtTypes<float16_t>
+{
+    constexpr static hipDataType          ScaleType   = HIP_R_16F;
+    constexpr static hipblasComputeType_t ComputeType = HIPBLAS_COMPUTE_16F;
+};
+
+#endif // ROCWMMA_BENCHMARK_WITH_HIPBLASLT
+
+template <typename Params, typename ComputeT>
+ROCWMMA_HOST void gemm_test(
+    char const* arch, uint32_t m, uint32_t n, uint32_t k, ComputeT alpha, ComputeT beta)
+{
+    constexpr char const* computeName
+        = std::is_same_v<ComputeT, float16_t> ? "f16 accum" : "f32 accum";
+
+    if(getWarpSize() != Params::WARP_SIZE)
+    {
+        std::cout << "Unsupported wave size!\n";
+        return;
+    }
+
+    // Bounds check
+    if(m % Params::MACRO_TILE_X || n % Params::MACRO_TILE_Y || k % Params::ROCWMMA_K)
+    {
+        std::cout << "Unsupported matrix size!\n";
+        return;
+    }
+
+    // Layouts leading dims
+    int lda = std::is_same_v<DataLayoutA, row_major> ? k : m;
+    int ldb = std::is_same_v<DataLayoutB, row_major> ? n : k;
+    int ldc = std::is_same_v<DataLayoutC, row_major> ? n : m;
+    int ldd = ldc;
+
+    // Initialize input matrices
+    std::vector<InputT>  matrixA(m * k);
+    std::vector<InputT>  matrixB(k * n);
+    std::vector<OutputT> matrixC(m * n);
+
+    // Fill outputs with NaN to catch contamination
+    std::vector<OutputT> matrixD(m * n, std::numeric_limits<OutputT>::signaling_NaN());
+
+    fillRand(matrixA.data(), m, k);
+    fillRand(matrixB.data(), k, n);
+    fillRand(matrixC.data(), m, n);
+
+    // Allocate and copy device memory
+    InputT*  d_a;
+    InputT*  d_b;
+    OutputT* d_c;
+    OutputT* d_d;
+
+    const size_t bytesA = matrixA.size() * sizeof(InputT);
+    const size_t bytesB = matrixB.size() * sizeof(InputT);
+    const size_t bytesC = matrixC.size() * sizeof(OutputT);
+    const size_t bytesD = matrixD.size() * sizeof(OutputT);
+
+    CHECK_HIP_ERROR(hipMalloc(&d_a, bytesA));
+    CHECK_HIP_ERROR(hipMalloc(&d_b, bytesB));
+    CHECK_HIP_ERROR(hipMalloc(&d_c, bytesC));
+    CHECK_HIP_ERROR(hipMalloc(&d_d, bytesD));
+
+    CHECK_HIP_ERROR(hipMemcpy(d_a, matrixA.data(), bytesA, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_b, matrixB.data(), bytesB, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_c, matrixC.data(), bytesC, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_d, matrixD.data(), bytesD, hipMemcpyHostToDevice));
+
+    using LdsPipeline = typename Wave32Gemm<Params, ComputeT>::LdsPipeline;
+
+    auto blockDim = dim3(Params::TBLOCK_X, Params::TBLOCK_Y);
+    auto gridDim  = dim3(m / Params::MACRO_TILE_X, n / Params::MACRO_TILE_Y);
+
+    auto rocwmmaKernel = [&]() {
+        hipExtLaunchKernelGGL(gemm_wave32_d<Params, ComputeT>,
+                              gridDim,
+                              blockDim,
+                              LdsPipeline::size_bytes,
+                              0,
+                              nullptr,
+                              nullptr,
+                              0,
+                              m,
+                              n,
+                              k,
+                              d_a,
+                              d_b,
+                              d_c,
+                              d_d,
+                              lda,
+                              ldb,
+                              ldc,
+                              ldd,
+                              alpha,
+                              beta);
+    };
+
+    // Runs are timed individually, with warm and cold caches
+    BenchmarkHarness harness;
+
+    // Echo performance
+    auto echo = [&](const char* kernelName, auto&& kernel) {
+        auto gFlops = calculateGFlops(m, n, k);
+
+        for(auto cacheState :
+            {BenchmarkHarness::CacheState::Warm, BenchmarkHarness::CacheState::Cold})
+        {
+            auto stats        = harness.run(kernel, cacheState);
+            auto tFlopsPerSec = calculateTFlopsPerSec(m, n, k, stats.mMedianMs);
+
+            std::cout << arch << ", " << kernelName << ", " << computeName << ", "
+                      << Params::TBLOCK_X << ", " << Params::TBLOCK_Y << ", " << Params::BLOCKS_X
+                      << ", " << Params::BLOCKS_Y << ", " << Params::ROCWMMA_K << ", "
+                      << Params::LDS_PIPELINE_DEPTH << ", " << m << ", " << n << ", " << k
+                      << ", "
+                      << (cacheState == BenchmarkHarness::CacheState::Warm ? "warm" : "cold")
+                      << ", " << stats.mMedianMs << ", " << gFlops << ", " << tFlopsPerSec
+                      << ", ";
+            BenchmarkHarness::printStats(std::cout, stats) << std::endl;
+        }
+    };
+
+#if !NDEBUG
+
+    // Setup and run reference computation
+    std::vector<OutputT> matrixD_ref(m * n, std::numeric_limits<OutputT>::signaling_NaN());
+    bool                 refComputed = false;
+
+    auto validate = [&]() {
+        if(!refComputed)
+        {
+            gemm_cpu_h<InputT, OutputT, ComputeT, DataLayoutA, DataLayoutB, DataLayoutC>(
+                m,
+                n,
+                k,
+                matrixA.data(),
+                matrixB.data(),
+                matrixC.data(),
+                matrixD_ref.data(),
+                lda,
+                ldb,
+                ldc,
+                ldd,
+                alpha,
+                beta);
+            refComputed = true;
+        }
+
+        // Bring kernel result back to host
+        CHECK_HIP_ERROR(hipMemcpy(matrixD.data(), d_d, bytesD, hipMemcpyDeviceToHost));
+
+        // 16b accumulation rounds in a different order than the host reference
+        auto tolerance = std::is_same_v<ComputeT, float16_t> ? 100.0 : 10.0;
+        auto res       = compareEqual(matrixD.data(), matrixD_ref.data(), m * n, tolerance);
+
+        std::cout << (std::get<0>(res) ? "PASSED" : "FAILED")
+                  << ", Max relative error: " << std::get<1>(res) << std::endl;
+    };
+
+#endif // !NDEBUG
+
+    echo("rocWMMA", rocwmmaKernel);
+
+#if !NDEBUG
+    validate();
+#endif // !NDEBUG
+
+#if ROCWMMA_BENCHMARK_WITH_HIPBLASLT
+
+    // hipBLASLt is column major. The row major D = A x B is the column major
+    // D^T = B^T x A^T, where the row major B is B^T, and the col major A is transposed.
+    using LtTypes = HipblasLtTypes<ComputeT>;
+
+    hipblasLtHandle_t       handle;
+    hipblasLtMatmulDesc_t   matmulDesc;
+    hipblasLtMatrixLayout_t layoutBt, layoutA, layoutC, layoutD;
+
+    hipblasOperation_t opN = HIPBLAS_OP_N;
+    hipblasOperation_t opT = HIPBLAS_OP_T;
+
+    CHECK_HIPBLASLT_ERROR(hipblasLtCreate(&handle));
+    CHECK_HIPBLASLT_ERROR(
+        hipblasLtMatmulDescCreate(&matmulDesc, LtTypes::ComputeType, LtTypes::ScaleType));
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatmulDescSetAttribute(
+        matmulDesc, HIPBLASLT_MATMUL_DESC_TRANSA, &opN, sizeof(opN)));
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatmulDescSetAttribute(
+        matmulDesc, HIPBLASLT_MATMUL_DESC_TRANSB, &opT, sizeof(opT)));
+
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatrixLayoutCreate(&layoutBt, HIP_R_16F, n, k, ldb));
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatrixLayoutCreate(&layoutA, HIP_R_16F, m, k, lda));
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatrixLayoutCreate(&layoutC, HIP_R_16F, n, m, ldc));
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatrixLayoutCreate(&layoutD, HIP_R_16F, n, m, ldd));
+
+    uint64_t workspaceBytes = 32ull * 1024ull * 1024ull;
+    void*    d_workspace    = nullptr;
+    CHECK_HIP_ERROR(hipMalloc(&d_workspace, workspaceBytes));
+
+    hipblasLtMatmulPreference_t preference;
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatmulPreferenceCreate(&preference));
+    CHECK_HIPBLASLT_ERROR(
+        hipblasLtMatmulPreferenceSetAttribute(preference,
+                                              HIPBLASLT_MATMUL_PREF_MAX_WORKSPACE_BYTES,
+                                              &workspaceBytes,
+                                              sizeof(workspaceBytes)));
+
+    int                              algoCount = 0;
+    hipblasLtMatmulHeuristicResult_t heuristic;
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatmulAlgoGetHeuristic(handle,
+                                                          matmulDesc,
+                                                          layoutBt,
+                                                          layoutA,
+                                                          layoutC,
+                                                          layoutD,
+                                                          preference,
+                                                          1,
+                                                          &heuristic,
+                                                          &algoCount));
+
+    if(algoCount > 0)
+    {
+        auto hipblasltKernel = [&]() {
+            CHECK_HIPBLASLT_ERROR(hipblasLtMatmul(handle,
+                                                  matmulDesc,
+                                                  &alpha,
+                                                  d_b,
+                                                  layoutBt,
+                                                  d_a,
+                                                  layoutA,
+                                                  &beta,
+                                                  d_c,
+                                                  layoutC,
+                                                  d_d,
+                                                  layoutD,
+                                                  &heuristic.algo,
+                                                  d_workspace,
+                                                  workspaceBytes,
+                                                  0));
+        };
+
+        // Fill outputs with NaN to catch contamination
+        CHECK_HIP_ERROR(hipMemset(d_d, 0xFF, bytesD));
+
+        echo("hipBLASLt", hipblasltKernel);
+
+#if !NDEBUG
+        validate();
+#endif // !NDEBUG
+    }
+    else
+    {
+        std::cout << "hipBLASLt skipped: no algorithm found" << std::endl;
+    }
+
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatmulPreferenceDestroy(preference));
+    CHECK_HIP_ERROR(hipFree(d_workspace));
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatrixLayoutDestroy(layoutD));
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatrixLayoutDestroy(layoutC));
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatrixLayoutDestroy(layoutA));
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatrixLayoutDestroy(layoutBt));
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatmulDescDestroy(matmulDesc));
+    CHECK_HIPBLASLT_ERROR(hipblasLtDestroy(handle));
+
+#endif // ROCWMMA_BENCHMARK_WITH_HIPBLASLT
+
+    // Release device memory
+    CHECK_HIP_ERROR(hipFree(d_a));
+    CHECK_HIP_ERROR(hipFree(d_b));
+    CHECK_HIP_ERROR(hipFree(d_c));
+    CHECK_HIP_ERROR(hipFree(d_d));
+}
+
+template <typename Params>
+ROCWMMA_HOST void gemm_tests(char const* arch)
+{
+    // Square, then LLM projection shapes
+    uint32_t const sizes[][3] = {{2048, 2048, 2048},
+                                 {4096, 4096, 4096},
+                                 {8192, 8192, 8192},
+                                 {4096, 11008, 4096},
+                                 {4096, 4096, 11008}};
+
+    for(auto const& size : sizes)
+    {
+        gemm_test<Params, float32_t>(arch, size[0], size[1], size[2], 2.0f, 2.0f);
+        gemm_test<Params, float16_t>(
+            arch, size[0], size[1], size[2], float16_t(2.0f), float16_t(2.0f));
+    }
+}
+
+int main()
+{
+    // Each target runs the kernels instantiated with its own tuning
+    using GemmTestsT = std::pair<void (*)(char const*), char const*>;
+
+    arch_dispatch<GemmTestsT> dispatch;
+    dispatch.add(Constants::AMDGCN_ARCH_ID_GFX1100, {&gemm_tests<gfx1100Params>, "gfx1100"})
+        .add(Constants::AMDGCN_ARCH_ID_GFX1101, {&gemm_tests<gfx1101Params>, "gfx1101"})
+        .add(Constants::AMDGCN_ARCH_ID_GFX1102, {&gemm_tests<gfx1102Params>, "gfx1102"})
+        .add(Constants::AMDGCN_ARCH_ID_GFX1200, {&gemm_tests<gfx1200Params>, "gfx1200"})
+        .add(Constants::AMDGCN_ARCH_ID_GFX1201, {&gemm_tests<gfx1201Params>, "gfx1201"});
+
+    std::cout << "Arch, Kernel, Compute, TBlockX, TBlockY, BlocksX, BlocksY, BlkK, LdsDepth, "
+              << "MatM, MatN, MatK, Cache, elapsedMs, Problem Size(GFlops), TFlops/s, "
+              << BenchmarkHarness::statsHeader() << std::endl;
+
+    if(auto gemmTests = dispatch.resolve_device())
+    {
+        gemmTests->first(gemmTests->second);
+    }
+    else
+    {
+        std::cout << "perf_hgemm_wave32 requires a gfx11 or gfx12 target" << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,576 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <iostream>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_fp16.h>
+#include <hip/hip_runtime.h>
+
+#include <rocwmma/rocwmma.hpp>
+#include <rocwmma/rocwmma_elementwise.hpp>
+#include <rocwmma/rocwmma_epilogue.hpp>
+
+#include "benchmark_harness.hpp"
+#include "common.hpp"
+
+using rocwmma::accumulator;
+using rocwmma::col_major;
+using rocwmma::float16_t;
+using rocwmma::float32_t;
+using rocwmma::matrix_a;
+using rocwmma::matrix_b;
+using rocwmma::row_major;
+
+/* Motivation
+*
+* Beam search and speculative decoding multiply each weight matrix by a handful
+* of vectors at once: the beams, or the draft tokens being verified. Multi-head
+* attention over a KV cache, and mixture of experts layers, do so for a batch of
+* independent matrices. Each step is then a strided batch of small N GEMMs,
+*
+*   D[i] = act(alpha * (A[i] x B[i]) + beta * C[i] + bias[i]), N in [1, 16]
+*
+* bound by the bandwidth of streaming each A[i] from HBM.
+*
+* simple_sgemv computes one vector per launch and stores the result directly.
+* Multiplying N vectors one launch at a time reads A N times, and a separate
+* bias / activation pass reads and writes D once more.
+*
+* This sample extends the split-K kernel of perf_hgemv_decode:
+* - The batch index is blockIdx.y. A, B, C, bias and D of batch i are located at
+*   their base pointer + i * stride. A stride of 0 shares the matrix between
+*   batches, e.g. the weights of requests decoded together.
+* - The N right-hand sides are the columns of the B fragment. Each fragment of A
+*   loaded from HBM is multiplied by all of them with a single mma_sync, so A is
+*   read once whatever N.
+* - After the LDS reduction of the split-K partials, the first wave applies
+*   the bias and activation with apply_epilogue before the bounded store of the
+*   N valid columns. The bias is per row of D (the output features), broadcast
+*   with load_col_vector_sync.
+*
+* The benchmark runs KV cache attention scores, mixture of experts and shared
+* weight projections for N in {1, 2, 4, 8, 16}, against a baseline launching
+* the same kernel once per vector.
+*
+* Note: M must be a multiple of ROCWMMA_M and K a multiple of ROCWMMA_K.
+*/
+
+// Supports ROCWMMA_M/N square sizes of
+// : 16 x 16
+// : 32 x 32 ( only MI )
+const int ROCWMMA_M = 16;
+const int ROCWMMA_N = 16;
+
+// Supports ROCWMMA_K sizes as
+// : multiples of 16.
+// 32 gives each lane of a 64 wide wave 8 contiguous elements of A
+const int ROCWMMA_K = 32;
+
+// Fragments of A in flight per wave
+const int UNROLL_K = 2;
+
+// Waves per workgroup, each reducing a K slice of the same output rows
+const int WAVES_K = 8;
+
+// Device warp size
+const uint32_t WAVE_SIZE = getWarpSize();
+
+// Thread block
+// : T_BLOCK_X must be multiple of WAVE_SIZE.
+const int T_BLOCK_X = WAVES_K * WAVE_SIZE;
+const int T_BLOCK_Y = 1;
+
+using FragA   = rocwmma::fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, row_major>;
+using FragB   = rocwmma::fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, col_major>;
+using FragC   = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t>;
+using FragAcc = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float32_t>;
+
+// Strided batched split-K small N GEMM with fused bias and activation.
+// Each workgroup computes ROCWMMA_M rows of D[blockIdx.y], with its waves
+// interleaved over K.
+//
+// : A is in row-major format     (M x K)
+// : B is in col-major format     (K x N)
+// : C, D are in col-major format (M x N)
+// : bias is a per-row vector     (M)
+template <typename ActivationT>
+__global__ void __launch_bounds__(WAVES_K * rocwmma::Constants::AMDGCN_WAVE_SIZE)
+    hgemv_batched_d(uint32_t         m,
+                    uint32_t         n,
+                    uint32_t         k,
+                    float16_t const* a,
+                    float16_t const* b,
+                    float16_t const* c,
+                    float32_t const* bias,
+                    float16_t*       d,
+                    uint32_t         lda,
+                    uint32_t         ldb,
+                    uint32_t         ldc,
+                    uint32_t         ldd,
+                    uint64_t         strideA,
+                    uint64_t         strideB,
+                    uint64_t         strideC,
+                    uint64_t         strideBias,
+                    uint64_t         strideD,
+                    float32_t        alpha,
+                    float32_t        beta)
+{
+    // Partial accumulators of all waves but the first
+    __shared__ float32_t partials[(WAVES_K - 1) * ROCWMMA_M * ROCWMMA_N];
+
+    auto batch = blockIdx.y;
+    a += batch * strideA;
+    b += batch * strideB;
+    c += batch * strideC;
+    bias += batch * strideBias;
+    d += batch * strideD;
+
+    auto waveK = threadIdx.x / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    auto cRow  = blockIdx.x * ROCWMMA_M;
+
+    // Interleave the waves over K, UNROLL_K fragments at a time
+    const uint32_t kStep = WAVES_K * ROCWMMA_K;
+
+    FragAcc fragAcc;
+    rocwmma::fill_fragment(fragAcc, 0.0f);
+
+    for(uint32_t h = waveK * ROCWMMA_K; h < k; h += UNROLL_K * kStep)
+    {
+        FragA fragsA[UNROLL_K];
+        FragB fragsB[UNROLL_K];
+
+        // Issue all loads of A before the first mma
+        for(int u = 0; u < UNROLL_K; ++u)
+        {
+            auto kOffset = h + u * kStep;
+            if(kOffset < k)
+            {
+                rocwmma::load_matrix_sync(fragsA[u], a + (cRow * lda + kOffset), lda);
+            }
+        }
+
+        // All N right-hand sides, zero-filling the unused columns
+        for(int u = 0; u < UNROLL_K; ++u)
+        {
+            auto kOffset = h + u * kStep;
+            if(kOffset < k)
+            {
+                rocwmma::load_matrix_bounded_sync(fragsB[u], b + kOffset, ldb, ROCWMMA_K, n);
+            }
+        }
+
+        for(int u = 0; u < UNROLL_K; ++u)
+        {
+            if(h + u * kStep < k)
+            {
+                rocwmma::mma_sync(fragAcc, fragsA[u], fragsB[u], fragAcc);
+            }
+        }
+    }
+
+    // Reduce the partials of all waves into the first
+    if(waveK > 0)
+    {
+        rocwmma::store_matrix_sync(partials + (waveK - 1) * ROCWMMA_M * ROCWMMA_N,
+                                   fragAcc,
+                                   ROCWMMA_M,
+                                   rocwmma::mem_col_major);
+    }
+
+    rocwmma::synchronize_workgroup();
+
+    if(waveK == 0)
+    {
+        for(int w = 0; w < WAVES_K - 1; ++w)
+        {
+            FragAcc fragP;
+            rocwmma::load_matrix_sync(
+                fragP, partials + w * ROCWMMA_M * ROCWMMA_N, ROCWMMA_M, rocwmma::mem_col_major);
+            fragAcc += fragP;
+        }
+
+        // Fetch epilogue inputs, on the n valid columns
+        FragC   fragC;
+        FragAcc fragBias;
+        rocwmma::load_matrix_bounded_sync(
+            fragC, c + cRow, ldc, ROCWMMA_M, n, rocwmma::mem_col_major);
+        rocwmma::load_col_vector_sync(fragBias, bias + cRow);
+
+        // D = act(alpha * A x B + beta * C + bias)
+        rocwmma::apply_epilogue(fragC,
+                                fragAcc,
+                                rocwmma::epilogue::LinearCombination(alpha, beta, fragC),
+                                rocwmma::epilogue::BiasAdd(fragBias),
+                                rocwmma::epilogue::Activation<ActivationT>());
+
+        rocwmma::store_matrix_bounded_sync(
+            d + cRow, fragC, ldd, ROCWMMA_M, n, rocwmma::mem_col_major);
+    }
+}
+
+// Host activation matching the device functors
+template <typename ActivationT>
+__host__ float32_t activation_h(float32_t x)
+{
+    if constexpr(std::is_same_v<ActivationT, rocwmma::epilogue::Relu>)
+    {
+        return std::max(x, 0.0f);
+    }
+    else if constexpr(std::is_same_v<ActivationT, rocwmma::epilogue::Silu>)
+    {
+        return x / (1.0f + std::exp(-x));
+    }
+    else if constexpr(std::is_same_v<ActivationT, rocwmma::epilogue::Gelu>)
+    {
+        return 0.5f * x * (1.0f + std::tanh(0.7978845608028654f * (x + 0.044715f * x * x * x)));
+    }
+    else
+    {
+        return x;
+    }
+}
+
+// Host reference of all batches
+template <typename ActivationT>
+__host__ void hgemv_batched_cpu_h(uint32_t         m,
+                                  uint32_t         n,
+                                  uint32_t         k,
+                                  uint32_t         batchCount,
+                                  float16_t const* a,
+                                  float16_t const* b,
+                                  float16_t const* c,
+                                  float32_t const* bias,
+                                  float16_t*       d,
+                                  uint32_t         lda,
+                                  uint32_t         ldb,
+                                  uint32_t         ldc,
+                                  uint32_t         ldd,
+                                  uint64_t         strideA,
+                                  uint64_t         strideB,
+                                  uint64_t         strideC,
+                                  uint64_t         strideBias,
+                                  uint64_t         strideD,
+                                  float32_t        alpha,
+                                  float32_t        beta)
+{
+    for(uint32_t batch = 0; batch < batchCount; ++batch)
+    {
+        auto aBatch    = a + batch * strideA;
+        auto bBatch    = b + batch * strideB;
+        auto cBatch    = c + batch * strideC;
+        auto biasBatch = bias + batch * strideBias;
+        auto dBatch    = d + batch * strideD;
+
+#pragma omp parallel for
+        for(int i = 0; i < m; ++i)
+        {
+            for(int j = 0; j < n; ++j)
+            {
+                float32_t accum = 0.0f;
+                for(int h = 0; h < k; ++h)
+                {
+                    accum += static_cast<float32_t>(aBatch[i * lda + h])
+                             * static_cast<float32_t>(bBatch[j * ldb + h]);
+                }
+
+                auto value = alpha * accum + beta * static_cast<float32_t>(cBatch[j * ldc + i])
+                             + biasBatch[i];
+                dBatch[j * ldd + i] = static_cast<float16_t>(activation_h<ActivationT>(value));
+            }
+        }
+    }
+}
+
+__host__ double peakBandwidthGBs()
+{
+    hipDevice_t     handle;
+    hipDeviceProp_t props;
+    CHECK_HIP_ERROR(hipGetDevice(&handle));
+    CHECK_HIP_ERROR(hipGetDeviceProperties(&props, handle));
+
+    // Double data rate, memoryClockRate in kHz and memoryBusWidth in bits
+    return 2.0 * static_cast<double>(props.memoryClockRate) * 1.0e3
+           * static_cast<double>(props.memoryBusWidth) / 8.0 * 1.0e-9;
+}
+
+template <typename ActivationT>
+__host__ void hgemv_batched_test(char const* caseName,
+                                 uint32_t    m,
+                                 uint32_t    n,
+                                 uint32_t    k,
+                                 uint32_t    batchCount,
+                                 bool        sharedA,
+                                 float32_t   alpha,
+                                 float32_t   beta)
+{
+    // Bounds check
+    if(m % ROCWMMA_M || k % ROCWMMA_K || n == 0 || n > ROCWMMA_N || batchCount == 0)
+    {
+        std::cout << "Unsupported size!\n";
+        return;
+    }
+
+    uint32_t lda = k;
+    uint32_t ldb = k;
+    uint32_t ldc = m;
+    uint32_t ldd = ldc;
+
+    // Packed batches, or a single A shared by all of them
+    uint64_t strideA    = sharedA ? 0u : uint64_t(m) * k;
+    uint64_t strideB    = uint64_t(k) * n;
+    uint64_t strideC    = uint64_t(m) * n;
+    uint64_t strideBias = m;
+    uint64_t strideD    = uint64_t(m) * n;
+
+    uint32_t aCount = sharedA ? 1u : batchCount;
+
+    // Initialize input matrices
+    std::vector<float16_t> matrixA(uint64_t(m) * k * aCount);
+    std::vector<float16_t> matrixB(strideB * batchCount);
+    std::vector<float16_t> matrixC(strideC * batchCount);
+    std::vector<float32_t> vectorBias(strideBias * batchCount);
+    std::vector<float16_t> matrixD(strideD * batchCount);
+
+    fillRand(matrixA.data(), m, k * aCount);
+    fillRand(matrixB.data(), k, n * batchCount);
+    fillRand(matrixC.data(), m, n * batchCount);
+    fillRand(vectorBias.data(), m, batchCount);
+
+    // Allocate and copy device memory
+    float16_t* d_a;
+    float16_t* d_b;
+    float16_t* d_c;
+    float32_t* d_bias;
+    float16_t* d_d;
+
+    const size_t bytesA    = matrixA.size() * sizeof(float16_t);
+    const size_t bytesB    = matrixB.size() * sizeof(float16_t);
+    const size_t bytesC    = matrixC.size() * sizeof(float16_t);
+    const size_t bytesBias = vectorBias.size() * sizeof(float32_t);
+    const size_t bytesD    = matrixD.size() * sizeof(float16_t);
+
+    CHECK_HIP_ERROR(hipMalloc(&d_a, bytesA));
+    CHECK_HIP_ERROR(hipMalloc(&d_b, bytesB));
+    CHECK_HIP_ERROR(hipMalloc(&d_c, bytesC));
+    CHECK_HIP_ERROR(hipMalloc(&d_bias, bytesBias));
+    CHECK_HIP_ERROR(hipMalloc(&d_d, bytesD));
+
+    CHECK_HIP_ERROR(hipMemcpy(d_a, matrixA.data(), bytesA, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_b, matrixB.data(), bytesB, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_c, matrixC.data(), bytesC, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_bias, vectorBias.data(), bytesBias, hipMemcpyHostToDevice));
+
+    auto gridDim  = dim3(m / ROCWMMA_M, batchCount);
+    auto blockDim = dim3(T_BLOCK_X, T_BLOCK_Y);
+
+    // All N right-hand sides of all batches in a single launch
+    auto batchedKernel = [&]() {
+        hipExtLaunchKernelGGL(hgemv_batched_d<ActivationT>,
+                              gridDim,
+                              blockDim,
+                              0, // sharedMemBytes
+                              0, // stream
+                              nullptr, // Event start
+                              nullptr, // event stop
+                              0, // flags
+                              m,
+                              n,
+                              k,
+                              d_a,
+                              d_b,
+                              d_c,
+                              d_bias,
+                              d_d,
+                              lda,
+                              ldb,
+                              ldc,
+                              ldd,
+                              strideA,
+                              strideB,
+                              strideC,
+                              strideBias,
+                              strideD,
+                              alpha,
+                              beta);
+    };
+
+    // Baseline: one launch per right-hand side, reading A n times
+    auto perVectorKernel = [&]() {
+        for(uint32_t j = 0; j < n; ++j)
+        {
+            hipExtLaunchKernelGGL(hgemv_batched_d<ActivationT>,
+                                  gridDim,
+                                  blockDim,
+                                  0, // sharedMemBytes
+                                  0, // stream
+                                  nullptr, // Event start
+                                  nullptr, // event stop
+                                  0, // flags
+                                  m,
+                                  1u,
+                                  k,
+                                  d_a,
+                                  d_b + j * ldb,
+                                  d_c + j * ldc,
+                                  d_bias,
+                                  d_d + j * ldd,
+                                  lda,
+                                  ldb,
+                                  ldc,
+                                  ldd,
+                                  strideA,
+                                  strideB,
+                                  strideC,
+                                  strideBias,
+                                  strideD,
+                                  alpha,
+                                  beta);
+        }
+    };
+
+    // Runs are timed individually, with warm and cold caches
+    BenchmarkHarness harness;
+
+    // Minimum traffic: all inputs read once, D written once
+    auto bytesMoved = static_cast<double>(bytesA + bytesB + bytesC + bytesBias + bytesD);
+    auto peakGBs    = peakBandwidthGBs();
+
+    // Echo performance
+    auto echo = [&](const char* kernelName, auto&& kernel) {
+        for(auto cacheState :
+            {BenchmarkHarness::CacheState::Warm, BenchmarkHarness::CacheState::Cold})
+        {
+            auto stats  = harness.run(kernel, cacheState);
+            auto gBytes = bytesMoved / stats.mMedianMs * 1.0e-6;
+
+            std::cout << caseName << ", " << kernelName << ", " << batchCount << ", " << m << ", "
+                      << n << ", " << k << ", "
+                      << (cacheState == BenchmarkHarness::CacheState::Warm ? "warm" : "cold")
+                      << ", " << stats.mMedianMs << ", " << gBytes << ", "
+                      << 100.0 * gBytes / peakGBs << ", "
+                      << calculateTFlopsPerSec(m, n, k, stats.mMedianMs) * batchCount << ", ";
+            BenchmarkHarness::printStats(std::cout, stats) << std::endl;
+        }
+    };
+
+#if !NDEBUG
+
+    // Setup and run reference computation
+    std::vector<float16_t> matrixD_ref(matrixD.size(),
+                                       std::numeric_limits<float16_t>::signaling_NaN());
+    hgemv_batched_cpu_h<ActivationT>(m,
+                                     n,
+                                     k,
+                                     batchCount,
+                                     matrixA.data(),
+                                     matrixB.data(),
+                                     matrixC.data(),
+                                     vectorBias.data(),
+                                     matrixD_ref.data(),
+                                     lda,
+                                     ldb,
+                                     ldc,
+                                     ldd,
+                                     strideA,
+                                     strideB,
+                                     strideC,
+                                     strideBias,
+                                     strideD,
+                                     alpha,
+                                     beta);
+
+    auto validate = [&]() {
+        std::cout << "Validating result with reference..." << std::endl;
+
+        // Bring kernel result back to host
+        CHECK_HIP_ERROR(hipMemcpy(matrixD.data(), d_d, bytesD, hipMemcpyDeviceToHost));
+
+        auto res = compareEqual(matrixD.data(), matrixD_ref.data(), matrixD.size());
+
+        if(std::get<0>(res) == false)
+        {
+            std::cout << "FAILED\n";
+        }
+        else
+        {
+            std::cout << "PASSED\n";
+        }
+
+        std::cout << "Max relative error: " << std::get<1>(res) << std::endl;
+    };
+
+#endif // !NDEBUG
+
+    echo("Batched", batchedKernel);
+
+#if !NDEBUG
+    validate();
+#endif // !NDEBUG
+
+    // Fill outputs with NaN to catch contamination
+    CHECK_HIP_ERROR(hipMemset(d_d, 0xFF, bytesD));
+
+    echo("PerVector", perVectorKernel);
+
+#if !NDEBUG
+    validate();
+#endif // !NDEBUG
+
+    // Release device memory
+    CHECK_HIP_ERROR(hipFree(d_a));
+    CHECK_HIP_ERROR(hipFree(d_b));
+    CHECK_HIP_ERROR(hipFree(d_c));
+    CHECK_HIP_ERROR(hipFree(d_bias));
+    CHECK_HIP_ERROR(hipFree(d_d));
+}
+
+int main()
+{
+    std::cout << "Case, Kernel, Batches, MatM, MatN, MatK, "
+              << "Cache, elapsedMs, GB/s, %Peak, TFlops/s, " << BenchmarkHarness::statsHeader()
+              << std::endl;
+
+    for(uint32_t n : {1u, 2u, 4u, 8u, 16u})
+    {
+        // Llama-2 7B attention scores of n beams against a 4096 token KV cache:
+        // one K matrix (tokens x head dim) per head
+        hgemv_batched_test<rocwmma::epilogue::Identity>(
+            "llama2-7b_attn_scores", 4096u, n, 128u, 32u, false, 0.08838834764831845f, 0.0f);
+
+        // Mixtral 8x7B expert up projections, n tokens routed to each of the 8 experts
+        hgemv_batched_test<rocwmma::epilogue::Silu>(
+            "mixtral-8x7b_expert_up", 14336u, n, 4096u, 8u, false, 1.0f, 0.0f);
+
+        // Llama-2 7B output projection shared by 4 requests with n draft tokens each
+        hgemv_batched_test<rocwmma::epilogue::Gelu>(
+            "llama2-7b_o_shared", 4096u, n, 4096u, 4u, true, 1.0f, 1.0f);
+    }
+
+    std::cout << "Finished!" << std::endl;
+    return 0;
+}
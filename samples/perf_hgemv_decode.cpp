@@ -0,0 +1,496 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <iostream>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_fp16.h>
+#include <hip/hip_runtime.h>
+
+#include <rocwmma/rocwmma.hpp>
+#include <rocwmma/rocwmma_elementwise.hpp>
+
+#include "benchmark_harness.hpp"
+#include "common.hpp"
+
+using rocwmma::accumulator;
+using rocwmma::col_major;
+using rocwmma::float16_t;
+using rocwmma::float32_t;
+using rocwmma::matrix_a;
+using rocwmma::matrix_b;
+using rocwmma::row_major;
+
+/* Motivation
+*
+* The token generation step of LLM inference multiplies every weight matrix
+* A (M x K) by the activations of the N tokens in flight, D = A x B with
+* N in [1, 16]. Each weight is read once per step and used N times, so the
+* step is bound by the bandwidth of streaming A from HBM, not by MMA throughput.
+*
+* Assigning one wave per ROCWMMA_M rows of output over the full K, as
+* simple_sgemv and simple_dgemv do, launches only M / ROCWMMA_M waves. For the
+* usual M of 4096 to 28672 these are too few to saturate HBM, and each runs a
+* long serial chain of small loads.
+*
+* This sample instead:
+* - Splits K across the WAVES_K waves of each workgroup. The waves of a
+*   workgroup interleave over K in ROCWMMA_K steps, such that together they
+*   stream contiguous rows of A.
+* - Loads A with ROCWMMA_K = 32, which gives each lane 16 byte vector loads,
+*   and keeps UNROLL_K fragments of A in flight per wave.
+* - Loads the N columns of B bounded, zero-filling the unused columns of the
+*   fragment. B is small and served from cache.
+* - Reduces the partial accumulators of the waves through LDS, then applies
+*   the alpha / beta epilogue in the first wave.
+*
+* The reduction over K within each wave is done by the MMA itself. The MMA
+* blocks are mostly padding for small N, which costs no bandwidth.
+*
+* The benchmark runs the linear layers of the Llama-2 7B and Llama-3 8B
+* decoders for N in {1, 2, 4, 8, 16}, and reports the achieved bandwidth
+* against the theoretical peak of the device. The simple_sgemv style kernel
+* is run alongside for comparison.
+*
+* Note: M must be a multiple of ROCWMMA_M and K a multiple of ROCWMMA_K.
+*/
+
+// Supports ROCWMMA_M/N square sizes of
+// : 16 x 16
+// : 32 x 32 ( only MI )
+const int ROCWMMA_M = 16;
+const int ROCWMMA_N = 16;
+
+// Supports ROCWMMA_K sizes as
+// : multiples of 16.
+// 32 gives each lane of a 64 wide wave 8 contiguous elements of A
+const int ROCWMMA_K = 32;
+
+// Fragments of A in flight per wave
+const int UNROLL_K = 2;
+
+// Waves per workgroup, each reducing a K slice of the same output rows
+const int WAVES_K = 8;
+
+// Device warp size
+const uint32_t WAVE_SIZE = getWarpSize();
+
+// Thread block
+// : T_BLOCK_X must be multiple of WAVE_SIZE.
+const int T_BLOCK_X = WAVES_K * WAVE_SIZE;
+const int T_BLOCK_Y = 1;
+
+using FragA   = rocwmma::fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, row_major>;
+using FragB   = rocwmma::fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, col_major>;
+using FragC   = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t>;
+using FragAcc = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float32_t>;
+
+// Split-K small N GEMM. Each workgroup computes ROCWMMA_M rows of D,
+// with its waves interleaved over K.
+//
+// : A is in row-major format     (M x K)
+// : B is in col-major format     (K x N)
+// : C, D are in col-major format (M x N)
+__global__ void __launch_bounds__(WAVES_K * rocwmma::Constants::AMDGCN_WAVE_SIZE)
+    hgemv_decode_d(uint32_t         m,
+                   uint32_t         n,
+                   uint32_t         k,
+                   float16_t const* a,
+                   float16_t const* b,
+                   float16_t const* c,
+                   float16_t*       d,
+                   uint32_t         lda,
+                   uint32_t         ldb,
+                   uint32_t         ldc,
+                   uint32_t         ldd,
+                   float32_t        alpha,
+                   float32_t        beta)
+{
+    // Partial accumulators of all waves but the first
+    __shared__ float32_t partials[(WAVES_K - 1) * ROCWMMA_M * ROCWMMA_N];
+
+    auto waveK = threadIdx.x / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    auto cRow  = blockIdx.x * ROCWMMA_M;
+
+    // Interleave the waves over K, UNROLL_K fragments at a time
+    const uint32_t kStep = WAVES_K * ROCWMMA_K;
+
+    FragAcc fragAcc;
+    rocwmma::fill_fragment(fragAcc, 0.0f);
+
+    for(uint32_t h = waveK * ROCWMMA_K; h < k; h += UNROLL_K * kStep)
+    {
+        FragA fragsA[UNROLL_K];
+        FragB fragsB[UNROLL_K];
+
+        // Issue all loads of A before the first mma
+        for(int u = 0; u < UNROLL_K; ++u)
+        {
+            auto kOffset = h + u * kStep;
+            if(kOffset < k)
+            {
+                rocwmma::load_matrix_sync(fragsA[u], a + (cRow * lda + kOffset), lda);
+            }
+        }
+        for(int u = 0; u < UNROLL_K; ++u)
+        {
+            auto kOffset = h + u * kStep;
+            if(kOffset < k)
+            {
+                rocwmma::load_matrix_bounded_sync(fragsB[u], b + kOffset, ldb, ROCWMMA_K, n);
+            }
+        }
+
+        for(int u = 0; u < UNROLL_K; ++u)
+        {
+            if(h + u * kStep < k)
+            {
+                rocwmma::mma_sync(fragAcc, fragsA[u], fragsB[u], fragAcc);
+            }
+        }
+    }
+
+    // Reduce the partials of all waves into the first
+    if(waveK > 0)
+    {
+        rocwmma::store_matrix_sync(partials + (waveK - 1) * ROCWMMA_M * ROCWMMA_N,
+                                   fragAcc,
+                                   ROCWMMA_M,
+                                   rocwmma::mem_col_major);
+    }
+
+    rocwmma::synchronize_workgroup();
+
+    if(waveK == 0)
+    {
+        for(int w = 0; w < WAVES_K - 1; ++w)
+        {
+            FragAcc fragP;
+            rocwmma::load_matrix_sync(
+                fragP, partials + w * ROCWMMA_M * ROCWMMA_N, ROCWMMA_M, rocwmma::mem_col_major);
+            fragAcc += fragP;
+        }
+
+        // D = alpha * A x B + beta * C, on the n valid columns
+        FragC fragC;
+        rocwmma::load_matrix_bounded_sync(
+            fragC, c + cRow, ldc, ROCWMMA_M, n, rocwmma::mem_col_major);
+
+        for(int i = 0; i < fragC.num_elements; ++i)
+        {
+            fragC.x[i] = static_cast<float16_t>(alpha * fragAcc.x[i]
+                                                + beta * static_cast<float32_t>(fragC.x[i]));
+        }
+
+        rocwmma::store_matrix_bounded_sync(
+            d + cRow, fragC, ldd, ROCWMMA_M, n, rocwmma::mem_col_major);
+    }
+}
+
+// The simple_sgemv style baseline: one wave per ROCWMMA_M rows of D over the
+// full K, with ROCWMMA_K = 16.
+__global__ void hgemv_simple_d(uint32_t         m,
+                               uint32_t         n,
+                               uint32_t         k,
+                               float16_t const* a,
+                               float16_t const* b,
+                               float16_t const* c,
+                               float16_t*       d,
+                               uint32_t         lda,
+                               uint32_t         ldb,
+                               uint32_t         ldc,
+                               uint32_t         ldd,
+                               float32_t        alpha,
+                               float32_t        beta)
+{
+    using FragASimple = rocwmma::fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, 16, float16_t, row_major>;
+    using FragBSimple = rocwmma::fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, 16, float16_t, col_major>;
+    using FragCSimple = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, 16, float16_t>;
+    using FragAccSimple = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, 16, float32_t>;
+
+    auto majorWarp = (blockIdx.x * blockDim.x + threadIdx.x) / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    auto cRow      = majorWarp * ROCWMMA_M;
+
+    if(cRow < m)
+    {
+        FragAccSimple fragAcc;
+        rocwmma::fill_fragment(fragAcc, 0.0f);
+
+        for(uint32_t h = 0; h < k; h += 16)
+        {
+            FragASimple fragA;
+            FragBSimple fragB;
+            rocwmma::load_matrix_sync(fragA, a + (cRow * lda + h), lda);
+            rocwmma::load_matrix_bounded_sync(fragB, b + h, ldb, 16, n);
+            rocwmma::mma_sync(fragAcc, fragA, fragB, fragAcc);
+        }
+
+        FragCSimple fragC;
+        rocwmma::load_matrix_bounded_sync(
+            fragC, c + cRow, ldc, ROCWMMA_M, n, rocwmma::mem_col_major);
+
+        for(int i = 0; i < fragC.num_elements; ++i)
+        {
+            fragC.x[i] = static_cast<float16_t>(alpha * fragAcc.x[i]
+                                                + beta * static_cast<float32_t>(fragC.x[i]));
+        }
+
+        rocwmma::store_matrix_bounded_sync(
+            d + cRow, fragC, ldd, ROCWMMA_M, n, rocwmma::mem_col_major);
+    }
+}
+
+__host__ double peakBandwidthGBs()
+{
+    hipDevice_t     handle;
+    hipDeviceProp_t props;
+    CHECK_HIP_ERROR(hipGetDevice(&handle));
+    CHECK_HIP_ERROR(hipGetDeviceProperties(&props, handle));
+
+    // Double data rate, memoryClockRate in kHz and memoryBusWidth in bits
+    return 2.0 * static_cast<double>(props.memoryClockRate) * 1.0e3
+           * static_cast<double>(props.memoryBusWidth) / 8.0 * 1.0e-9;
+}
+
+__host__ void hgemv_decode_test(
+    char const* layerName, uint32_t m, uint32_t n, uint32_t k, float32_t alpha, float32_t beta)
+{
+    // Bounds check
+    if(m % ROCWMMA_M || k % ROCWMMA_K || n == 0 || n > ROCWMMA_N)
+    {
+        std::cout << "Unsupported size!\n";
+        return;
+    }
+
+    uint32_t lda = k;
+    uint32_t ldb = k;
+    uint32_t ldc = m;
+    uint32_t ldd = ldc;
+
+    // Initialize input matrices
+    std::vector<float16_t> matrixA(static_cast<size_t>(m) * k);
+    std::vector<float16_t> matrixB(static_cast<size_t>(k) * n);
+    std::vector<float16_t> matrixC(static_cast<size_t>(m) * n);
+    std::vector<float16_t> matrixD(static_cast<size_t>(m) * n);
+
+    fillRand(matrixA.data(), m, k);
+    fillRand(matrixB.data(), k, n);
+    fillRand(matrixC.data(), m, n);
+
+    // Allocate and copy device memory
+    float16_t* d_a;
+    float16_t* d_b;
+    float16_t* d_c;
+    float16_t* d_d;
+
+    const size_t bytesA = matrixA.size() * sizeof(float16_t);
+    const size_t bytesB = matrixB.size() * sizeof(float16_t);
+    const size_t bytesC = matrixC.size() * sizeof(float16_t);
+    const size_t bytesD = matrixD.size() * sizeof(float16_t);
+
+    CHECK_HIP_ERROR(hipMalloc(&d_a, bytesA));
+    CHECK_HIP_ERROR(hipMalloc(&d_b, bytesB));
+    CHECK_HIP_ERROR(hipMalloc(&d_c, bytesC));
+    CHECK_HIP_ERROR(hipMalloc(&d_d, bytesD));
+
+    CHECK_HIP_ERROR(hipMemcpy(d_a, matrixA.data(), bytesA, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_b, matrixB.data(), bytesB, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_c, matrixC.data(), bytesC, hipMemcpyHostToDevice));
+
+    auto decodeKernel = [&]() {
+        hipExtLaunchKernelGGL(hgemv_decode_d,
+                              dim3(m / ROCWMMA_M),
+                              dim3(T_BLOCK_X, T_BLOCK_Y),
+                              0, // sharedMemBytes
+                              0, // stream
+                              nullptr, // Event start
+                              nullptr, // event stop
+                              0, // flags
+                              m,
+                              n,
+                              k,
+                              d_a,
+                              d_b,
+                              d_c,
+                              d_d,
+                              lda,
+                              ldb,
+                              ldc,
+                              ldd,
+                              alpha,
+                              beta);
+    };
+
+    // Baseline uses 4 waves per workgroup, one per ROCWMMA_M rows
+    auto simpleBlockDim = dim3(4 * WAVE_SIZE);
+    auto simpleGridDim  = dim3(rocwmma::ceilDiv(m, ROCWMMA_M * 4));
+    auto simpleKernel   = [&]() {
+        hipExtLaunchKernelGGL(hgemv_simple_d,
+                              simpleGridDim,
+                              simpleBlockDim,
+                              0, // sharedMemBytes
+                              0, // stream
+                              nullptr, // Event start
+                              nullptr, // event stop
+                              0, // flags
+                              m,
+                              n,
+                              k,
+                              d_a,
+                              d_b,
+                              d_c,
+                              d_d,
+                              lda,
+                              ldb,
+                              ldc,
+                              ldd,
+                              alpha,
+                              beta);
+    };
+
+    // Runs are timed individually, with warm and cold caches
+    BenchmarkHarness harness;
+
+    // Minimum traffic: A, B and C read once, D written once
+    auto bytesMoved = static_cast<double>(bytesA + bytesB + bytesC + bytesD);
+    auto peakGBs    = peakBandwidthGBs();
+
+    // Echo performance
+    auto echo = [&](const char* kernelName, auto&& kernel) {
+        for(auto cacheState :
+            {BenchmarkHarness::CacheState::Warm, BenchmarkHarness::CacheState::Cold})
+        {
+            auto stats  = harness.run(kernel, cacheState);
+            auto gBytes = bytesMoved / stats.mMedianMs * 1.0e-6;
+
+            std::cout << layerName << ", " << kernelName << ", " << m << ", " << n << ", " << k
+                      << ", "
+                      << (cacheState == BenchmarkHarness::CacheState::Warm ? "warm" : "cold")
+                      << ", " << stats.mMedianMs << ", " << gBytes << ", "
+                      << 100.0 * gBytes / peakGBs << ", "
+                      << calculateTFlopsPerSec(m, n, k, stats.mMedianMs) << ", ";
+            BenchmarkHarness::printStats(std::cout, stats) << std::endl;
+        }
+    };
+
+#if !NDEBUG
+
+    // Setup and run reference computation
+    std::vector<float16_t> matrixD_ref(m * n, std::numeric_limits<float16_t>::signaling_NaN());
+    gemm_cpu_h<float16_t, float16_t, float32_t, row_major, col_major, col_major>(
+        m,
+        n,
+        k,
+        matrixA.data(),
+        matrixB.data(),
+        matrixC.data(),
+        matrixD_ref.data(),
+        lda,
+        ldb,
+        ldc,
+        ldd,
+        alpha,
+        beta);
+
+    auto validate = [&]() {
+        std::cout << "Validating result with reference..." << std::endl;
+
+        // Bring kernel result back to host
+        CHECK_HIP_ERROR(hipMemcpy(matrixD.data(), d_d, bytesD, hipMemcpyDeviceToHost));
+
+        auto res = compareEqual(matrixD.data(), matrixD_ref.data(), m * n);
+
+        if(std::get<0>(res) == false)
+        {
+            std::cout << "FAILED\n";
+        }
+        else
+        {
+            std::cout << "PASSED\n";
+        }
+
+        std::cout << "Max relative error: " << std::get<1>(res) << std::endl;
+    };
+
+#endif // !NDEBUG
+
+    echo("SplitK", decodeKernel);
+
+#if !NDEBUG
+    validate();
+#endif // !NDEBUG
+
+    // Fill outputs with NaN to catch contamination
+    CHECK_HIP_ERROR(hipMemset(d_d, 0xFF, bytesD));
+
+    echo("Simple", simpleKernel);
+
+#if !NDEBUG
+    validate();
+#endif // !NDEBUG
+
+    // Release device memory
+    CHECK_HIP_ERROR(hipFree(d_a));
+    CHECK_HIP_ERROR(hipFree(d_b));
+    CHECK_HIP_ERROR(hipFree(d_c));
+    CHECK_HIP_ERROR(hipFree(d_d));
+}
+
+int main()
+{
+    std::cout << "Layer, Kernel, MatM, MatN, MatK, "
+              << "Cache, elapsedMs, GB/s, %Peak, TFlops/s, " << BenchmarkHarness::statsHeader()
+              << std::endl;
+
+    // Linear layers of the decoder blocks: (layer name, M, K)
+    struct DecodeLayer
+    {
+        char const* mName;
+        uint32_t    mM, mK;
+    };
+
+    const DecodeLayer layers[] = {
+        {"llama2-7b_qkv", 3u * 4096u, 4096u},
+        {"llama2-7b_o", 4096u, 4096u},
+        {"llama2-7b_gate_up", 2u * 11008u, 4096u},
+        {"llama2-7b_down", 4096u, 11008u},
+        {"llama3-8b_qkv", 6144u, 4096u},
+        {"llama3-8b_gate_up", 2u * 14336u, 4096u},
+        {"llama3-8b_down", 4096u, 14336u},
+    };
+
+    for(auto const& layer : layers)
+    {
+        for(uint32_t n : {1u, 2u, 4u, 8u, 16u})
+        {
+            hgemv_decode_test(layer.mName, layer.mM, n, layer.mK, 1.0f, 0.0f);
+        }
+    }
+
+    std::cout << "Finished!" << std::endl;
+    return 0;
+}
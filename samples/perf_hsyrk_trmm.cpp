@@ -0,0 +1,747 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_fp16.h>
+#include <hip/hip_runtime.h>
+
+#include <rocwmma/rocwmma.hpp>
+#include <rocwmma/rocwmma_epilogue.hpp>
+
+#include "benchmark_harness.hpp"
+#include "common.hpp"
+
+using rocwmma::accumulator;
+using rocwmma::col_major;
+using rocwmma::float16_t;
+using rocwmma::float32_t;
+using rocwmma::matrix_a;
+using rocwmma::matrix_b;
+using rocwmma::row_major;
+
+/* Motivation
+*
+* Gram matrices and covariances, C = A x A^T, are symmetric: only one triangle
+* needs to be computed. Products with a triangular matrix, D = L x B, have
+* zero blocks in half of their K range. A dense GEMM spends half of its work on
+* either.
+*
+* This sample has two triangle-aware drivers:
+*
+* - SYRK-style, D = alpha * A x A^T + beta * C, on the lower or upper triangle.
+*   The grid launches only the T * (T + 1) / 2 macro tiles of the triangle, with
+*   the 1D workgroup index decoded into the (row, col) of the macro tile:
+*
+*       tileIdx = row * (row + 1) / 2 + col,  col <= row
+*
+*   Wave tiles of the diagonal macro tiles that lie fully outside the triangle
+*   exit early, and fragments crossing the diagonal are masked on store with
+*   row and column index fragments. The other triangle of D is not written.
+*
+* - TRMM-style, D = alpha * A x B, with A (M x M) lower or upper triangular.
+*   Each wave tile runs its K loop only over the blocks of A that intersect
+*   the triangle: [0, row + WAVE_TILE_M) for lower, [row, M) for upper.
+*
+* Each driver is compared against its Full mode: the same kernel over the
+* dense problem.
+*
+* Note: SYRK requires N to be a multiple of WAVE_TILE_M and K of ROCWMMA_K.
+* TRMM requires M to be a multiple of WAVE_TILE_M and N of WAVE_TILE_N.
+* Note: TRMM reads A densely within the K range, so the blocks of A that
+* straddle the diagonal must hold zeros outside the triangle.
+*/
+
+// Supports ROCWMMA_M/N square sizes of
+// : 16 x 16
+// : 32 x 32 ( only MI )
+const int ROCWMMA_M = 16;
+const int ROCWMMA_N = 16;
+
+// Supports ROCWMMA_K sizes as
+// : multiples of 16.
+const int ROCWMMA_K = 16;
+
+// Each wave computes BLOCKS_X x BLOCKS_Y fragments of output, reusing each
+// A fragment across BLOCKS_Y and each B fragment across BLOCKS_X.
+// Square wave tiles align the diagonal to whole fragments.
+const int BLOCKS_X    = 2;
+const int BLOCKS_Y    = 2;
+const int WAVE_TILE_M = BLOCKS_X * ROCWMMA_M;
+const int WAVE_TILE_N = BLOCKS_Y * ROCWMMA_N;
+
+// Device warp size
+const uint32_t WAVE_SIZE = getWarpSize();
+
+// Thread block
+// : T_BLOCK_X must be multiple of WAVE_SIZE.
+// Square macro tiles of MACRO_TILE x MACRO_TILE
+const int T_BLOCK_X  = 4 * WAVE_SIZE;
+const int T_BLOCK_Y  = 4;
+const int MACRO_TILE = 4 * WAVE_TILE_M;
+
+using FragA   = rocwmma::fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, row_major>;
+using FragB   = rocwmma::fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, col_major>;
+using FragC   = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t>;
+using FragAcc = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float32_t>;
+
+enum class Triangle : uint32_t
+{
+    Full,
+    Lower,
+    Upper
+};
+
+inline char const* triangleString(Triangle tri)
+{
+    switch(tri)
+    {
+    case Triangle::Lower:
+        return "Lower";
+    case Triangle::Upper:
+        return "Upper";
+    case Triangle::Full:
+    default:
+        return "Full";
+    }
+}
+
+// Fragment row and column indices, broadcast by load_col_vector_sync and load_row_vector_sync
+__constant__ float32_t FRAG_INDICES[ROCWMMA_M] = {0.0f,
+                                                   1.0f,
+                                                   2.0f,
+                                                   3.0f,
+                                                   4.0f,
+                                                   5.0f,
+                                                   6.0f,
+                                                   7.0f,
+                                                   8.0f,
+                                                   9.0f,
+                                                   10.0f,
+                                                   11.0f,
+                                                   12.0f,
+                                                   13.0f,
+                                                   14.0f,
+                                                   15.0f};
+
+// Number of macro tiles launched over a tiles x tiles output
+__host__ __device__ inline uint32_t macroTileCount(Triangle tri, uint32_t tiles)
+{
+    return tri == Triangle::Full ? tiles * tiles : tiles * (tiles + 1u) / 2u;
+}
+
+// Decodes the linear macro tile index into its row and column, enumerating
+// only the tiles of the triangle.
+template <Triangle Tri>
+__device__ inline void
+    macroTileCoord(uint32_t tileIdx, uint32_t tiles, uint32_t& tileRow, uint32_t& tileCol)
+{
+    if constexpr(Tri == Triangle::Full)
+    {
+        tileRow = tileIdx / tiles;
+        tileCol = tileIdx % tiles;
+    }
+    else
+    {
+        // Largest row with row * (row + 1) / 2 <= tileIdx
+        auto row = static_cast<uint32_t>((sqrtf(8.0f * tileIdx + 1.0f) - 1.0f) * 0.5f);
+        while(row * (row + 1u) / 2u > tileIdx)
+        {
+            --row;
+        }
+        while((row + 1u) * (row + 2u) / 2u <= tileIdx)
+        {
+            ++row;
+        }
+        auto col = tileIdx - row * (row + 1u) / 2u;
+
+        // Upper tiles are the transpose of the lower
+        tileRow = Tri == Triangle::Lower ? row : col;
+        tileCol = Tri == Triangle::Lower ? col : row;
+    }
+}
+
+// Whether the block of rows x cols at (row, col) has any element in the triangle
+template <Triangle Tri>
+__device__ inline bool
+    intersectsTriangle(uint32_t row, uint32_t col, uint32_t rows, uint32_t cols)
+{
+    if constexpr(Tri == Triangle::Lower)
+    {
+        return row + rows > col;
+    }
+    else if constexpr(Tri == Triangle::Upper)
+    {
+        return col + cols > row;
+    }
+    return true;
+}
+
+// Whether the block of rows x cols at (row, col) lies fully in the triangle
+template <Triangle Tri>
+__device__ inline bool
+    withinTriangle(uint32_t row, uint32_t col, uint32_t rows, uint32_t cols)
+{
+    if constexpr(Tri == Triangle::Lower)
+    {
+        return row >= col + cols - 1u;
+    }
+    else if constexpr(Tri == Triangle::Upper)
+    {
+        return col >= row + rows - 1u;
+    }
+    return true;
+}
+
+// SYRK-style D = alpha * A x A^T + beta * C, on the triangle Tri of D.
+// The grid enumerates only the macro tiles intersecting the triangle.
+//
+// : A is in row-major format     (N x K)
+// : A^T is read as col-major B   (K x N) with ldb = lda
+// : C, D are in row-major format (N x N)
+template <Triangle Tri>
+__global__ void hsyrk_d(uint32_t         n,
+                        uint32_t         k,
+                        float16_t const* a,
+                        float16_t const* c,
+                        float16_t*       d,
+                        uint32_t         lda,
+                        uint32_t         ldc,
+                        uint32_t         ldd,
+                        float32_t        alpha,
+                        float32_t        beta)
+{
+    uint32_t tileRow, tileCol;
+    macroTileCoord<Tri>(blockIdx.x, rocwmma::ceilDiv(n, MACRO_TILE), tileRow, tileCol);
+
+    // Target wave tile
+    auto cRow = tileRow * MACRO_TILE
+                + (threadIdx.x / rocwmma::Constants::AMDGCN_WAVE_SIZE) * WAVE_TILE_M;
+    auto cCol = tileCol * MACRO_TILE + threadIdx.y * WAVE_TILE_N;
+
+    // Bounds check, and skip wave tiles outside of the triangle
+    if(cRow >= n || cCol >= n || !intersectsTriangle<Tri>(cRow, cCol, WAVE_TILE_M, WAVE_TILE_N))
+    {
+        return;
+    }
+
+    FragAcc fragsAcc[BLOCKS_X][BLOCKS_Y];
+    for(int i = 0; i < BLOCKS_X; ++i)
+    {
+        for(int j = 0; j < BLOCKS_Y; ++j)
+        {
+            rocwmma::fill_fragment(fragsAcc[i][j], 0.0f);
+        }
+    }
+
+    // fragsAcc = A x A^T
+    for(uint32_t h = 0; h < k; h += ROCWMMA_K)
+    {
+        FragA fragsA[BLOCKS_X];
+        FragB fragsB[BLOCKS_Y];
+
+        for(int i = 0; i < BLOCKS_X; ++i)
+        {
+            rocwmma::load_matrix_sync(fragsA[i], a + ((cRow + i * ROCWMMA_M) * lda + h), lda);
+        }
+        for(int j = 0; j < BLOCKS_Y; ++j)
+        {
+            rocwmma::load_matrix_sync(fragsB[j], a + ((cCol + j * ROCWMMA_N) * lda + h), lda);
+        }
+
+        for(int i = 0; i < BLOCKS_X; ++i)
+        {
+            for(int j = 0; j < BLOCKS_Y; ++j)
+            {
+                rocwmma::mma_sync(fragsAcc[i][j], fragsA[i], fragsB[j], fragsAcc[i][j]);
+            }
+        }
+    }
+
+    // Row and column of each fragment element, for the diagonal fragments
+    FragAcc fragRows, fragCols;
+    rocwmma::load_col_vector_sync(fragRows, FRAG_INDICES);
+    rocwmma::load_row_vector_sync(fragCols, FRAG_INDICES);
+
+    for(int i = 0; i < BLOCKS_X; ++i)
+    {
+        for(int j = 0; j < BLOCKS_Y; ++j)
+        {
+            auto row = cRow + i * ROCWMMA_M;
+            auto col = cCol + j * ROCWMMA_N;
+            if(!intersectsTriangle<Tri>(row, col, ROCWMMA_M, ROCWMMA_N))
+            {
+                continue;
+            }
+
+            // D = alpha * A x A^T + beta * C
+            FragC fragC;
+            rocwmma::load_matrix_sync(fragC, c + (row * ldc + col), ldc, rocwmma::mem_row_major);
+            for(int e = 0; e < fragC.num_elements; ++e)
+            {
+                fragC.x[e] = static_cast<float16_t>(
+                    alpha * fragsAcc[i][j].x[e] + beta * static_cast<float32_t>(fragC.x[e]));
+            }
+
+            // Fragments crossing the diagonal keep the elements of D outside of the triangle
+            if(!withinTriangle<Tri>(row, col, ROCWMMA_M, ROCWMMA_N))
+            {
+                FragC fragD;
+                rocwmma::load_matrix_sync(
+                    fragD, d + (row * ldd + col), ldd, rocwmma::mem_row_major);
+                for(int e = 0; e < fragC.num_elements; ++e)
+                {
+                    bool keep = (Tri == Triangle::Lower) ? (fragRows.x[e] >= fragCols.x[e])
+                                                         : (fragRows.x[e] <= fragCols.x[e]);
+                    fragC.x[e] = keep ? fragC.x[e] : fragD.x[e];
+                }
+            }
+
+            rocwmma::store_matrix_sync(d + (row * ldd + col), fragC, ldd, rocwmma::mem_row_major);
+        }
+    }
+}
+
+// TRMM-style D = alpha * A x B, with A triangular on Tri. Each wave tile
+// skips the blocks of K in which its rows of A are zero.
+//
+// : A is in row-major format     (M x M)
+// : B is in col-major format     (M x N)
+// : D is in row-major format     (M x N)
+template <Triangle Tri>
+__global__ void htrmm_d(uint32_t         m,
+                        uint32_t         n,
+                        float16_t const* a,
+                        float16_t const* b,
+                        float16_t*       d,
+                        uint32_t         lda,
+                        uint32_t         ldb,
+                        uint32_t         ldd,
+                        float32_t        alpha)
+{
+    // Tile using a 2D grid
+    auto majorWarp = (blockIdx.x * blockDim.x + threadIdx.x) / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    auto minorWarp = (blockIdx.y * blockDim.y + threadIdx.y);
+
+    // Target tile
+    auto cRow = majorWarp * WAVE_TILE_M;
+    auto cCol = minorWarp * WAVE_TILE_N;
+
+    // Bounds check
+    if(cRow >= m || cCol >= n)
+    {
+        return;
+    }
+
+    // Blocks of K intersecting rows [cRow, cRow + WAVE_TILE_M) of the triangle
+    uint32_t kBegin = (Tri == Triangle::Upper) ? cRow : 0u;
+    uint32_t kEnd   = (Tri == Triangle::Lower) ? cRow + WAVE_TILE_M : m;
+
+    FragAcc fragsAcc[BLOCKS_X][BLOCKS_Y];
+    for(int i = 0; i < BLOCKS_X; ++i)
+    {
+        for(int j = 0; j < BLOCKS_Y; ++j)
+        {
+            rocwmma::fill_fragment(fragsAcc[i][j], 0.0f);
+        }
+    }
+
+    // fragsAcc = A x B
+    for(uint32_t h = kBegin; h < kEnd; h += ROCWMMA_K)
+    {
+        FragA fragsA[BLOCKS_X];
+        FragB fragsB[BLOCKS_Y];
+
+        for(int i = 0; i < BLOCKS_X; ++i)
+        {
+            rocwmma::load_matrix_sync(fragsA[i], a + ((cRow + i * ROCWMMA_M) * lda + h), lda);
+        }
+        for(int j = 0; j < BLOCKS_Y; ++j)
+        {
+            rocwmma::load_matrix_sync(fragsB[j], b + (h + (cCol + j * ROCWMMA_N) * ldb), ldb);
+        }
+
+        for(int i = 0; i < BLOCKS_X; ++i)
+        {
+            for(int j = 0; j < BLOCKS_Y; ++j)
+            {
+                rocwmma::mma_sync(fragsAcc[i][j], fragsA[i], fragsB[j], fragsAcc[i][j]);
+            }
+        }
+    }
+
+    for(int i = 0; i < BLOCKS_X; ++i)
+    {
+        for(int j = 0; j < BLOCKS_Y; ++j)
+        {
+            FragC fragD;
+            for(int e = 0; e < fragD.num_elements; ++e)
+            {
+                fragD.x[e] = static_cast<float16_t>(alpha * fragsAcc[i][j].x[e]);
+            }
+
+            auto offset = (cRow + i * ROCWMMA_M) * ldd + (cCol + j * ROCWMMA_N);
+            rocwmma::store_matrix_sync(d + offset, fragD, ldd, rocwmma::mem_row_major);
+        }
+    }
+}
+
+// Echoes one benchmark row per cache state. Useful flops exclude the other
+// triangle, elapsed times are compared against the Full mode.
+template <typename KernelT>
+__host__ double echo(BenchmarkHarness& harness,
+                     char const*       driverName,
+                     Triangle          tri,
+                     uint32_t          m,
+                     uint32_t          n,
+                     uint32_t          k,
+                     uint32_t          workgroups,
+                     double            usefulGFlops,
+                     double            fullMedianMs,
+                     KernelT&&         kernel)
+{
+    double warmMedianMs = 0.0;
+    for(auto cacheState : {BenchmarkHarness::CacheState::Warm, BenchmarkHarness::CacheState::Cold})
+    {
+        auto stats        = harness.run(kernel, cacheState);
+        auto tFlopsPerSec = usefulGFlops / stats.mMedianMs;
+        if(cacheState == BenchmarkHarness::CacheState::Warm)
+        {
+            warmMedianMs = stats.mMedianMs;
+        }
+
+        std::cout << driverName << ", " << triangleString(tri) << ", " << workgroups << ", " << m
+                  << ", " << n << ", " << k << ", "
+                  << (cacheState == BenchmarkHarness::CacheState::Warm ? "warm" : "cold") << ", "
+                  << stats.mMedianMs << ", " << usefulGFlops << ", " << tFlopsPerSec << ", "
+                  << (fullMedianMs > 0.0 && cacheState == BenchmarkHarness::CacheState::Warm
+                          ? fullMedianMs / stats.mMedianMs
+                          : 1.0)
+                  << ", ";
+        BenchmarkHarness::printStats(std::cout, stats) << std::endl;
+    }
+    return warmMedianMs;
+}
+
+#if !NDEBUG
+
+__host__ void validate(std::vector<float16_t> const& result, std::vector<float16_t> const& ref)
+{
+    std::cout << "Validating result with reference..." << std::endl;
+
+    auto res = compareEqual(result.data(), ref.data(), result.size());
+
+    if(std::get<0>(res) == false)
+    {
+        std::cout << "FAILED\n";
+    }
+    else
+    {
+        std::cout << "PASSED\n";
+    }
+
+    std::cout << "Max relative error: " << std::get<1>(res) << std::endl;
+}
+
+#endif // !NDEBUG
+
+__host__ void syrk_test(uint32_t n, uint32_t k, float32_t alpha, float32_t beta)
+{
+    // Bounds check
+    if(n % WAVE_TILE_M || k % ROCWMMA_K)
+    {
+        std::cout << "Unsupported size!\n";
+        return;
+    }
+
+    uint32_t lda = k;
+    uint32_t ldc = n;
+    uint32_t ldd = n;
+
+    // Initialize input matrices
+    std::vector<float16_t> matrixA(static_cast<size_t>(n) * k);
+    std::vector<float16_t> matrixC(static_cast<size_t>(n) * n);
+    std::vector<float16_t> matrixD(static_cast<size_t>(n) * n);
+
+    fillRand(matrixA.data(), n, k);
+    fillRand(matrixC.data(), n, n);
+
+    // Allocate and copy device memory
+    float16_t* d_a;
+    float16_t* d_c;
+    float16_t* d_d;
+
+    const size_t bytesA = matrixA.size() * sizeof(float16_t);
+    const size_t bytesC = matrixC.size() * sizeof(float16_t);
+    const size_t bytesD = matrixD.size() * sizeof(float16_t);
+
+    CHECK_HIP_ERROR(hipMalloc(&d_a, bytesA));
+    CHECK_HIP_ERROR(hipMalloc(&d_c, bytesC));
+    CHECK_HIP_ERROR(hipMalloc(&d_d, bytesD));
+
+    CHECK_HIP_ERROR(hipMemcpy(d_a, matrixA.data(), bytesA, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_c, matrixC.data(), bytesC, hipMemcpyHostToDevice));
+
+#if !NDEBUG
+    // Dense A x A^T reference, with A^T as the col-major view of A
+    std::vector<float16_t> matrixD_full(matrixD.size());
+    gemm_cpu_h<float16_t, float16_t, float32_t, row_major, col_major, row_major>(
+        n,
+        n,
+        k,
+        matrixA.data(),
+        matrixA.data(),
+        matrixC.data(),
+        matrixD_full.data(),
+        lda,
+        lda,
+        ldc,
+        ldd,
+        alpha,
+        beta);
+#endif // !NDEBUG
+
+    BenchmarkHarness harness;
+    auto             tiles        = rocwmma::ceilDiv(n, MACRO_TILE);
+    double           fullMedianMs = 0.0;
+
+    auto run = [&](auto kernelFunc, Triangle tri) {
+        auto workgroups = macroTileCount(tri, tiles);
+        auto kernel     = [&]() {
+            hipExtLaunchKernelGGL(kernelFunc,
+                                  dim3(workgroups),
+                                  dim3(T_BLOCK_X, T_BLOCK_Y),
+                                  0, // sharedMemBytes
+                                  0, // stream
+                                  nullptr, // Event start
+                                  nullptr, // event stop
+                                  0, // flags
+                                  n,
+                                  k,
+                                  d_a,
+                                  d_c,
+                                  d_d,
+                                  lda,
+                                  ldc,
+                                  ldd,
+                                  alpha,
+                                  beta);
+        };
+
+        // Elements outside of the triangle must remain zero
+        CHECK_HIP_ERROR(hipMemset(d_d, 0, bytesD));
+
+        auto usefulGFlops = tri == Triangle::Full
+                                ? calculateGFlops(n, n, k)
+                                : calculateGFlops(n, n, k) * (n + 1.0) / (2.0 * n);
+        auto medianMs
+            = echo(harness, "SYRK", tri, n, n, k, workgroups, usefulGFlops, fullMedianMs, kernel);
+        if(tri == Triangle::Full)
+        {
+            fullMedianMs = medianMs;
+        }
+
+#if !NDEBUG
+        std::vector<float16_t> matrixD_ref(matrixD_full);
+        for(uint32_t i = 0; tri != Triangle::Full && i < n; ++i)
+        {
+            for(uint32_t j = 0; j < n; ++j)
+            {
+                if((tri == Triangle::Lower) ? (i < j) : (i > j))
+                {
+                    matrixD_ref[i * ldd + j] = static_cast<float16_t>(0.0f);
+                }
+            }
+        }
+
+        CHECK_HIP_ERROR(hipMemcpy(matrixD.data(), d_d, bytesD, hipMemcpyDeviceToHost));
+        validate(matrixD, matrixD_ref);
+#endif // !NDEBUG
+    };
+
+    run(hsyrk_d<Triangle::Full>, Triangle::Full);
+    run(hsyrk_d<Triangle::Lower>, Triangle::Lower);
+    run(hsyrk_d<Triangle::Upper>, Triangle::Upper);
+
+    // Release device memory
+    CHECK_HIP_ERROR(hipFree(d_a));
+    CHECK_HIP_ERROR(hipFree(d_c));
+    CHECK_HIP_ERROR(hipFree(d_d));
+}
+
+__host__ void trmm_test(uint32_t m, uint32_t n, float32_t alpha, Triangle tri)
+{
+    // Bounds check
+    if(m % WAVE_TILE_M || n % WAVE_TILE_N)
+    {
+        std::cout << "Unsupported size!\n";
+        return;
+    }
+
+    uint32_t lda = m;
+    uint32_t ldb = m;
+    uint32_t ldd = n;
+
+    // Initialize input matrices, with A zero outside of the triangle
+    std::vector<float16_t> matrixA(static_cast<size_t>(m) * m);
+    std::vector<float16_t> matrixB(static_cast<size_t>(m) * n);
+    std::vector<float16_t> matrixD(static_cast<size_t>(m) * n);
+
+    fillRand(matrixA.data(), m, m);
+    fillRand(matrixB.data(), m, n);
+    for(uint32_t i = 0; i < m; ++i)
+    {
+        for(uint32_t j = 0; j < m; ++j)
+        {
+            if((tri == Triangle::Lower) ? (i < j) : (i > j))
+            {
+                matrixA[i * lda + j] = static_cast<float16_t>(0.0f);
+            }
+        }
+    }
+
+    // Allocate and copy device memory
+    float16_t* d_a;
+    float16_t* d_b;
+    float16_t* d_d;
+
+    const size_t bytesA = matrixA.size() * sizeof(float16_t);
+    const size_t bytesB = matrixB.size() * sizeof(float16_t);
+    const size_t bytesD = matrixD.size() * sizeof(float16_t);
+
+    CHECK_HIP_ERROR(hipMalloc(&d_a, bytesA));
+    CHECK_HIP_ERROR(hipMalloc(&d_b, bytesB));
+    CHECK_HIP_ERROR(hipMalloc(&d_d, bytesD));
+
+    CHECK_HIP_ERROR(hipMemcpy(d_a, matrixA.data(), bytesA, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_b, matrixB.data(), bytesB, hipMemcpyHostToDevice));
+
+#if !NDEBUG
+    std::vector<float16_t> matrixD_ref(matrixD.size());
+    gemm_cpu_h<float16_t, float16_t, float32_t, row_major, col_major, row_major>(
+        m,
+        n,
+        m,
+        matrixA.data(),
+        matrixB.data(),
+        matrixD_ref.data(),
+        matrixD_ref.data(),
+        lda,
+        ldb,
+        ldd,
+        ldd,
+        alpha,
+        0.0f);
+#endif // !NDEBUG
+
+    auto blockDim = dim3(T_BLOCK_X, T_BLOCK_Y);
+    auto gridDim  = dim3(rocwmma::ceilDiv(m, WAVE_TILE_M * T_BLOCK_X / WAVE_SIZE),
+                        rocwmma::ceilDiv(n, WAVE_TILE_N * T_BLOCK_Y));
+
+    BenchmarkHarness harness;
+    double           fullMedianMs = 0.0;
+
+    auto run = [&](auto kernelFunc, Triangle mode) {
+        auto kernel = [&]() {
+            hipExtLaunchKernelGGL(kernelFunc,
+                                  gridDim,
+                                  blockDim,
+                                  0, // sharedMemBytes
+                                  0, // stream
+                                  nullptr, // Event start
+                                  nullptr, // event stop
+                                  0, // flags
+                                  m,
+                                  n,
+                                  d_a,
+                                  d_b,
+                                  d_d,
+                                  lda,
+                                  ldb,
+                                  ldd,
+                                  alpha);
+        };
+
+        auto usefulGFlops = mode == Triangle::Full
+                                ? calculateGFlops(m, n, m)
+                                : calculateGFlops(m, n, m) * (m + 1.0) / (2.0 * m);
+        auto medianMs     = echo(harness,
+                             "TRMM",
+                             mode,
+                             m,
+                             n,
+                             m,
+                             gridDim.x * gridDim.y,
+                             usefulGFlops,
+                             fullMedianMs,
+                             kernel);
+        if(mode == Triangle::Full)
+        {
+            fullMedianMs = medianMs;
+        }
+
+#if !NDEBUG
+        CHECK_HIP_ERROR(hipMemcpy(matrixD.data(), d_d, bytesD, hipMemcpyDeviceToHost));
+        validate(matrixD, matrixD_ref);
+#endif // !NDEBUG
+    };
+
+    run(htrmm_d<Triangle::Full>, Triangle::Full);
+    if(tri == Triangle::Lower)
+    {
+        run(htrmm_d<Triangle::Lower>, Triangle::Lower);
+    }
+    else
+    {
+        run(htrmm_d<Triangle::Upper>, Triangle::Upper);
+    }
+
+    // Release device memory
+    CHECK_HIP_ERROR(hipFree(d_a));
+    CHECK_HIP_ERROR(hipFree(d_b));
+    CHECK_HIP_ERROR(hipFree(d_d));
+}
+
+int main()
+{
+    std::cout << "Driver, Triangle, Workgroups, MatM, MatN, MatK, "
+              << "Cache, elapsedMs, Useful Size(GFlops), TFlops/s, Speedup, "
+              << BenchmarkHarness::statsHeader() << std::endl;
+
+    // Gram matrices of wide and tall feature sets
+    syrk_test(4096, 4096, 1.0f, 0.0f);
+    syrk_test(8192, 1024, 1.0f, 1.0f);
+    syrk_test(2048, 16384, 1.0f / 16384.0f, 0.0f);
+
+    trmm_test(4096, 4096, 1.0f, Triangle::Lower);
+    trmm_test(8192, 2048, 1.0f, Triangle::Upper);
+
+    std::cout << "Finished!" << std::endl;
+    return 0;
+}
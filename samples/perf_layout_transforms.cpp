@@ -0,0 +1,296 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <iostream>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_fp16.h>
+#include <hip/hip_runtime.h>
+
+#include <rocwmma/rocwmma.hpp>
+#include <rocwmma/rocwmma_transforms.hpp>
+
+#include "benchmark_harness.hpp"
+#include "common.hpp"
+
+using namespace rocwmma;
+
+/* Motivation
+*
+* Kernels that mix row and col major fragments, e.g. to feed an operand loaded
+* in one layout into an mma expecting the other, must change the fragment data
+* layout. Without applyDataLayout, the conversion is a round trip through LDS:
+* store the fragment, transpose the tile in LDS, and load it back in the other
+* layout, with barriers in between.
+*
+* applyDataLayout converts between layouts in the register file only. The
+* AOS <-> SOA transforms exchange the fragment elements across lanes with DPP,
+* swizzle and permute ops, and every BlockDim (16 to 256) and vector width
+* (1 to 16) of the supported data types has a register-only path on both
+* wave32 and wave64 targets.
+*
+* This sample times a number of row -> col -> row round trips of a fragment per
+* wave, through the register file and through LDS, for each data type and
+* BlockDim. Debug builds validate the col major tiles and the round trip result
+* against the host.
+*/
+
+// Tile dimensions: BlockDim x BLOCK_K fragments of matrix_a
+constexpr uint32_t BLOCK_K = 16u;
+
+// Layout conversions per kernel, in row -> col -> row round trips (must be >= 1)
+constexpr uint32_t ROUND_TRIPS = 32u;
+
+// Tiles per launch, one per wave
+constexpr uint32_t TILE_COUNT = 8192u;
+
+template <typename DataT, uint32_t BlockDim>
+using FragRow = fragment<matrix_a, BlockDim, BlockDim, BLOCK_K, DataT, row_major>;
+
+template <typename DataT, uint32_t BlockDim>
+using FragCol = ApplyDataLayout_t<FragRow<DataT, BlockDim>, col_major>;
+
+// Register-only round trips. Each wave owns one tile:
+// : in and outRow tiles are in row-major format (ld = BLOCK_K)
+// : outCol tiles are in col-major format        (ld = BlockDim)
+template <typename DataT, uint32_t BlockDim>
+ROCWMMA_KERNEL void __launch_bounds__(Constants::AMDGCN_WAVE_SIZE)
+    layout_register_d(DataT const* in, DataT* outRow, DataT* outCol, uint32_t roundTrips)
+{
+    if constexpr(!ROCWMMA_ARCH_HOST)
+    {
+        constexpr uint32_t TileSize   = BlockDim * BLOCK_K;
+        auto               tileOffset = static_cast<size_t>(blockIdx.x) * TileSize;
+
+        auto fragRow = FragRow<DataT, BlockDim>{};
+        auto fragCol = FragCol<DataT, BlockDim>{};
+
+        load_matrix_sync(fragRow, in + tileOffset, BLOCK_K);
+        for(uint32_t i = 0; i < roundTrips; i++)
+        {
+            fragCol = applyDataLayout<col_major>(fragRow);
+            fragRow = applyDataLayout<row_major>(fragCol);
+        }
+
+        store_matrix_sync(outRow + tileOffset, fragRow, BLOCK_K);
+        store_matrix_sync(outCol + tileOffset, fragCol, BlockDim);
+    }
+}
+
+// LDS round trips, with the same tiles as above. The wave stores the fragment
+// in its own layout, transposes the tile element-wise in LDS, and loads the
+// fragment of the other layout.
+template <typename DataT, uint32_t BlockDim>
+ROCWMMA_KERNEL void __launch_bounds__(Constants::AMDGCN_WAVE_SIZE)
+    layout_lds_d(DataT const* in, DataT* outRow, DataT* outCol, uint32_t roundTrips)
+{
+    if constexpr(!ROCWMMA_ARCH_HOST)
+    {
+        constexpr uint32_t TileSize   = BlockDim * BLOCK_K;
+        auto               tileOffset = static_cast<size_t>(blockIdx.x) * TileSize;
+
+        HIP_DYNAMIC_SHARED(void*, localMemPtr);
+        auto ldsRow = reinterpret_cast<DataT*>(localMemPtr);
+        auto ldsCol = ldsRow + TileSize;
+
+        auto fragRow = FragRow<DataT, BlockDim>{};
+        auto fragCol = FragCol<DataT, BlockDim>{};
+
+        load_matrix_sync(fragRow, in + tileOffset, BLOCK_K);
+        for(uint32_t i = 0; i < roundTrips; i++)
+        {
+            // Row -> col
+            store_matrix_sync(ldsRow, fragRow, BLOCK_K);
+            synchronize_workgroup();
+            for(uint32_t e = threadIdx.x; e < TileSize; e += blockDim.x)
+            {
+                ldsCol[e] = ldsRow[(e % BlockDim) * BLOCK_K + e / BlockDim];
+            }
+            synchronize_workgroup();
+            load_matrix_sync(fragCol, ldsCol, BlockDim);
+
+            // Col -> row
+            store_matrix_sync(ldsCol, fragCol, BlockDim);
+            synchronize_workgroup();
+            for(uint32_t e = threadIdx.x; e < TileSize; e += blockDim.x)
+            {
+                ldsRow[e] = ldsCol[(e % BLOCK_K) * BlockDim + e / BLOCK_K];
+            }
+            synchronize_workgroup();
+            load_matrix_sync(fragRow, ldsRow, BLOCK_K);
+        }
+
+        store_matrix_sync(outRow + tileOffset, fragRow, BLOCK_K);
+        store_matrix_sync(outCol + tileOffset, fragCol, BlockDim);
+    }
+}
+
+template <typename DataT, uint32_t BlockDim>
+__host__ void layout_transforms_test()
+{
+    constexpr uint32_t TileSize = BlockDim * BLOCK_K;
+    const size_t       size     = static_cast<size_t>(TILE_COUNT) * TileSize;
+    const size_t       bytes    = size * sizeof(DataT);
+
+    // Allocate and initialize host data
+    std::vector<DataT> input(size);
+    std::vector<DataT> outputRow(size);
+    std::vector<DataT> outputCol(size);
+    fillRand(input.data(), TILE_COUNT * BlockDim, BLOCK_K);
+
+    // Allocate and copy device memory
+    DataT *d_input, *d_outputRow, *d_outputCol;
+    CHECK_HIP_ERROR(hipMalloc(&d_input, bytes));
+    CHECK_HIP_ERROR(hipMalloc(&d_outputRow, bytes));
+    CHECK_HIP_ERROR(hipMalloc(&d_outputCol, bytes));
+    CHECK_HIP_ERROR(hipMemcpy(d_input, input.data(), bytes, hipMemcpyHostToDevice));
+
+    auto gridDim  = dim3(TILE_COUNT);
+    auto blockDim = dim3(getWarpSize());
+
+    auto registerKernel = [&]() {
+        hipExtLaunchKernelGGL(layout_register_d<DataT, BlockDim>,
+                              gridDim,
+                              blockDim,
+                              0, // sharedMemBytes
+                              0, // stream
+                              nullptr, // Event start
+                              nullptr, // event stop
+                              0, // flags
+                              d_input,
+                              d_outputRow,
+                              d_outputCol,
+                              ROUND_TRIPS);
+    };
+
+    // Row and col major tile in LDS
+    auto ldsBytes  = 2u * TileSize * sizeof(DataT);
+    auto ldsKernel = [&]() {
+        hipExtLaunchKernelGGL(layout_lds_d<DataT, BlockDim>,
+                              gridDim,
+                              blockDim,
+                              ldsBytes,
+                              0, // stream
+                              nullptr, // Event start
+                              nullptr, // event stop
+                              0, // flags
+                              d_input,
+                              d_outputRow,
+                              d_outputCol,
+                              ROUND_TRIPS);
+    };
+
+    // Each round trip converts the fragment layout twice
+    auto conversions = 2.0 * ROUND_TRIPS * TILE_COUNT;
+
+    // Validate the last kernel run against the host
+    auto validate = [&](const char* pathName) {
+#if !NDEBUG
+        CHECK_HIP_ERROR(
+            hipMemcpy(outputRow.data(), d_outputRow, bytes, hipMemcpyDeviceToHost));
+        CHECK_HIP_ERROR(
+            hipMemcpy(outputCol.data(), d_outputCol, bytes, hipMemcpyDeviceToHost));
+
+        // Col major reference of each row major input tile
+        std::vector<DataT> inputCol(size);
+#pragma omp parallel for
+        for(int t = 0; t < static_cast<int>(TILE_COUNT); t++)
+        {
+            auto tile = static_cast<size_t>(t) * TileSize;
+            for(uint32_t i = 0; i < BlockDim; i++)
+            {
+                for(uint32_t j = 0; j < BLOCK_K; j++)
+                {
+                    inputCol[tile + j * BlockDim + i] = input[tile + i * BLOCK_K + j];
+                }
+            }
+        }
+
+        auto resCol = compareEqual(outputCol.data(), inputCol.data(), size);
+        auto resRow = compareEqual(outputRow.data(), input.data(), size);
+        if(!std::get<0>(resCol) || !std::get<0>(resRow))
+        {
+            std::cout << pathName << " validation FAILED, max relative error: "
+                      << std::max(std::get<1>(resCol), std::get<1>(resRow)) << std::endl;
+        }
+#endif // !NDEBUG
+    };
+
+    // Runs are timed individually, with warm and cold caches
+    BenchmarkHarness harness;
+
+    auto echo = [&](const char* pathName, auto&& kernel) {
+        for(auto cacheState :
+            {BenchmarkHarness::CacheState::Warm, BenchmarkHarness::CacheState::Cold})
+        {
+            auto stats = harness.run(kernel, cacheState);
+
+            std::cout << pathName << ", " << dataTypeToString<DataT>() << ", " << BlockDim
+                      << ", " << BLOCK_K << ", " << getWarpSize() << ", "
+                      << (cacheState == BenchmarkHarness::CacheState::Warm ? "warm" : "cold")
+                      << ", " << stats.mMedianMs << ", "
+                      << conversions / stats.mMedianMs * 1.0e-6 << ", ";
+            BenchmarkHarness::printStats(std::cout, stats) << std::endl;
+        }
+        validate(pathName);
+    };
+
+    echo("Register", registerKernel);
+    echo("LDS", ldsKernel);
+
+    // Release device memory
+    CHECK_HIP_ERROR(hipFree(d_input));
+    CHECK_HIP_ERROR(hipFree(d_outputRow));
+    CHECK_HIP_ERROR(hipFree(d_outputCol));
+}
+
+template <typename DataT>
+__host__ void layout_transforms_test_block_dims()
+{
+    layout_transforms_test<DataT, 16u>();
+    layout_transforms_test<DataT, 32u>();
+    layout_transforms_test<DataT, 64u>();
+    layout_transforms_test<DataT, 128u>();
+
+    // Two 256 x BLOCK_K double tiles exceed the LDS of the baseline
+    if constexpr(sizeof(DataT) < 8u)
+    {
+        layout_transforms_test<DataT, 256u>();
+    }
+}
+
+int main()
+{
+    std::cout << "Path, DataT, BlockDim, BlockK, WaveSize, Cache, elapsedMs, "
+              << "Conversions(G/s), " << BenchmarkHarness::statsHeader() << std::endl;
+
+    layout_transforms_test_block_dims<int8_t>();
+    layout_transforms_test_block_dims<float16_t>();
+    layout_transforms_test_block_dims<float32_t>();
+    layout_transforms_test_block_dims<float64_t>();
+    return 0;
+}
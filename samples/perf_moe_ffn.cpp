@@ -0,0 +1,896 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_fp16.h>
+#include <hip/hip_runtime.h>
+
+#include <rocwmma/rocwmma.hpp>
+#include <rocwmma/rocwmma_epilogue.hpp>
+#include <rocwmma/rocwmma_transforms.hpp>
+
+#include "benchmark_harness.hpp"
+#include "common.hpp"
+
+/* Motivation
+*
+* The sparse feed-forward block of a Mixture of Experts (MoE) transformer routes each token to
+* the TOP_K experts with the largest gating logits, and combines the SwiGLU outputs of the
+* chosen experts with their renormalized gating probabilities:
+*
+* Y[t] = sum_j w[t][j] * (silu(X[t] x W1[e]) * (X[t] x W3[e])) x W2[e], e = expert[t][j]
+*
+* Routing is data dependent. A common formulation copies the top-k experts to the host after
+* the gating GEMM, sorts the tokens by expert there, and copies the routing back before the
+* expert GEMMs can be launched. The stream drains at every MoE layer, and the device idles for
+* two copies and the host sort.
+*
+* The device-routed pipeline in this sample keeps every step on the stream:
+*
+*   1. moe_gate_topk_d   Gating GEMM X x Wg, top-k of each row with topk_rows, softmax over
+*                        the selected logits. Only TOP_K (expert, weight) pairs per token are
+*                        written.
+*   2. moe_count_d       Histogram of routed tokens per expert.
+*   3. moe_offsets_d     Prefix sum of the histogram, each expert padded to TILE_M rows, and one
+*                        tile descriptor (its expert) per workgroup tile of the grouped GEMMs.
+*   4. moe_permute_d     Routed row of every (token, slot) pair within its expert.
+*   5. moe_gate_up_d     Grouped gate and up GEMMs. A rows are gathered from X by token with
+*                        load_matrix_gather_sync, and silu(gate) * up is applied in registers
+*                        by the GatedLinearUnit epilogue.
+*   6. moe_down_d        Grouped down GEMM, scattering each routed row with
+*                        store_matrix_scatter_sync to the output slot of its (token, slot) pair.
+*   7. moe_combine_d     Weighted sum of the TOP_K slots of each token.
+*
+* The grouped GEMMs are launched with an upper bound of workgroup tiles, which the host knows
+* without the routing: at most ceil(tokens * TOP_K / TILE_M) + experts tiles hold routed rows.
+* Workgroups past the last tile read a -1 descriptor and exit.
+*
+* A token routes to distinct experts, so its TOP_K slots are distinct rows of the slot buffer
+* and the down GEMM needs no atomics. The combine then reduces the slots in a fixed order, and
+* the result does not depend on the routing order of the atomics of step 4.
+*
+* The host-routed baseline runs the same GEMM and combine kernels, with the routing of steps
+* 2 - 4 computed on the host between two blocking copies.
+*
+* In this simplified example, we assume:
+* : X is in row-major format                 (Tokens x H)
+* : Wg is col-major                          (H x EXPERT_COLS)
+* : W1, W3 of each expert are col-major      (H x F)
+* : W2 of each expert is col-major           (F x H)
+* : Y is in row-major format                 (Tokens x H)
+* : Tokens, H and F are multiples of the block sizes, and of TILE_N
+*/
+
+using rocwmma::accumulator;
+using rocwmma::col_major;
+using rocwmma::float16_t;
+using rocwmma::float32_t;
+using rocwmma::index_t;
+using rocwmma::matrix_a;
+using rocwmma::matrix_b;
+using rocwmma::row_major;
+
+namespace epilogue = rocwmma::epilogue;
+
+// Supports ROCWMMA_M/N square sizes of
+// : 16 x 16
+// : 32 x 32 ( only MI )
+const int ROCWMMA_M = 16;
+const int ROCWMMA_N = 16;
+
+// Supports ROCWMMA_K sizes as
+// : multiples of 16.
+const int ROCWMMA_K = 16;
+
+// Device warp size
+const uint32_t WAVE_SIZE = getWarpSize();
+
+// Thread block of the grouped GEMMs
+// : T_BLOCK_X is WAVES_X waves.
+// Note: Each wave will compute one BLOCK_M x BLOCK_N output block
+// Note: Workgroup will compute one tile of
+//  WAVES_X x T_BLOCK_Y output blocks
+const uint32_t WAVES_X   = 2;
+const int      T_BLOCK_X = WAVES_X * WAVE_SIZE;
+const int      T_BLOCK_Y = 2;
+
+// Workgroup tile size, independent of the wave size such that the kernels may use it.
+// Each expert is padded to TILE_M routed rows.
+const uint32_t TILE_M = ROCWMMA_M * WAVES_X;
+const uint32_t TILE_N = ROCWMMA_N * T_BLOCK_Y;
+
+// Routing of Qwen1.5-MoE-A2.7B: 60 experts, 4 per token
+const uint32_t EXPERT_COUNT = 60;
+const uint32_t TOP_K        = 4;
+
+// Gating columns, padded to the block size. Padding columns are masked out of the top-k.
+const uint32_t EXPERT_BLOCKS = rocwmma::ceilDiv(EXPERT_COUNT, uint32_t(ROCWMMA_N));
+const uint32_t EXPERT_COLS   = EXPERT_BLOCKS * ROCWMMA_N;
+
+// Threads of the routing and combine kernels
+const uint32_t ROUTE_THREADS = 256;
+
+using FragX = rocwmma::fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, row_major>;
+using FragW = rocwmma::fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, col_major>;
+using FragAcc = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float32_t>;
+using FragOut
+    = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, row_major>;
+using FragIdx = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, int32_t>;
+
+// Upper bound of the workgroup tiles holding routed rows, for any routing
+__host__ constexpr uint32_t maxRoutedTiles(uint32_t tokenCount)
+{
+    return (tokenCount * TOP_K + TILE_M - 1u) / TILE_M + EXPERT_COUNT;
+}
+
+// Step 1: gating GEMM and top-k, one wave per ROCWMMA_M tokens.
+// Expert j of token t is topkExperts[j * tokenCount + t], with its weight at the same index of
+// topkWeights.
+// expertMask holds 0 for the experts and -inf for the padding columns.
+__global__ void moe_gate_topk_d(uint32_t         tokenCount,
+                                uint32_t         hidden,
+                                float16_t const* x,
+                                float16_t const* wg,
+                                float32_t const* expertMask,
+                                int32_t*         topkExperts,
+                                float32_t*       topkWeights)
+{
+    auto fragX    = FragX();
+    auto fragW    = FragW();
+    auto fragAcc  = FragAcc();
+    auto fragMask = FragAcc();
+
+    FragAcc fragVals[TOP_K];
+    FragIdx fragIdx[TOP_K];
+    for(uint32_t j = 0; j < TOP_K; j++)
+    {
+        rocwmma::fill_fragment(fragVals[j], std::numeric_limits<float32_t>::lowest());
+        rocwmma::fill_fragment(fragIdx[j], -1);
+    }
+
+    auto row = blockIdx.x * ROCWMMA_M;
+
+    for(uint32_t b = 0; b < EXPERT_BLOCKS; b++)
+    {
+        auto col = b * ROCWMMA_N;
+
+        // fragAcc = X x Wg
+        rocwmma::fill_fragment(fragAcc, 0.0f);
+        for(uint32_t i = 0; i < hidden; i += ROCWMMA_K)
+        {
+            rocwmma::load_matrix_sync(fragX, x + (size_t(row) * hidden + i), hidden);
+            rocwmma::load_matrix_sync(fragW, wg + (size_t(col) * hidden + i), hidden);
+            rocwmma::mma_sync(fragAcc, fragX, fragW, fragAcc);
+        }
+
+        // Padding columns never rank
+        rocwmma::load_row_vector_sync(fragMask, expertMask + col);
+        for(int i = 0; i < fragAcc.num_elements; i++)
+        {
+            fragAcc.x[i] += fragMask.x[i];
+        }
+
+        rocwmma::topk_rows(fragAcc, col, fragVals, fragIdx);
+    }
+
+    // Softmax over the selected logits. Candidates are sorted, so the first one is the row max.
+    FragAcc fragSum;
+    rocwmma::fill_fragment(fragSum, 0.0f);
+    for(uint32_t j = 0; j < TOP_K; j++)
+    {
+        for(int i = 0; i < fragSum.num_elements; i++)
+        {
+            auto p           = expf(fragVals[j].x[i] - fragVals[0].x[i]);
+            fragVals[j].x[i] = p;
+            fragSum.x[i] += p;
+        }
+    }
+
+    for(uint32_t j = 0; j < TOP_K; j++)
+    {
+        for(int i = 0; i < fragSum.num_elements; i++)
+        {
+            fragVals[j].x[i] /= fragSum.x[i];
+        }
+
+        rocwmma::store_col_vector_sync(topkExperts + (j * tokenCount + row), fragIdx[j]);
+        rocwmma::store_col_vector_sync(topkWeights + (j * tokenCount + row), fragVals[j]);
+    }
+}
+
+// Step 2: routed tokens per expert. expertCounts is zeroed beforehand.
+__global__ void
+    moe_count_d(uint32_t pairCount, int32_t const* topkExperts, uint32_t* expertCounts)
+{
+    auto pair = blockIdx.x * blockDim.x + threadIdx.x;
+    if(pair < pairCount)
+    {
+        atomicAdd(expertCounts + topkExperts[pair], 1u);
+    }
+}
+
+// Step 3: routed row offsets of the experts, each padded to TILE_M rows, and the expert of every
+// workgroup tile. Tiles past the routed rows are marked -1. Resets the cursors of step 4.
+// The prefix sum over the experts is short, and is computed by a single thread.
+__global__ void moe_offsets_d(uint32_t        maxTiles,
+                              uint32_t const* expertCounts,
+                              uint32_t*       expertOffsets,
+                              uint32_t*       expertCursors,
+                              index_t*        tileExperts)
+{
+    if(threadIdx.x == 0)
+    {
+        uint32_t offset = 0u;
+        uint32_t tile   = 0u;
+        for(uint32_t e = 0; e < EXPERT_COUNT; e++)
+        {
+            auto tiles = (expertCounts[e] + TILE_M - 1u) / TILE_M;
+
+            expertOffsets[e] = offset;
+            expertCursors[e] = 0u;
+            for(uint32_t i = 0; i < tiles; i++)
+            {
+                tileExperts[tile++] = static_cast<index_t>(e);
+            }
+            offset += tiles * TILE_M;
+        }
+
+        for(; tile < maxTiles; tile++)
+        {
+            tileExperts[tile] = -1;
+        }
+    }
+}
+
+// Step 4: routed row of each (token, slot) pair. Rows of an expert are claimed in arbitrary
+// order, which only permutes the rows of its GEMM. routedTokens and routedSlots are set to -1
+// beforehand, such that padding rows are zero-filled on load and are never stored.
+__global__ void moe_permute_d(uint32_t        tokenCount,
+                              int32_t const*  topkExperts,
+                              uint32_t const* expertOffsets,
+                              uint32_t*       expertCursors,
+                              index_t*        routedTokens,
+                              index_t*        routedSlots)
+{
+    auto pair = blockIdx.x * blockDim.x + threadIdx.x;
+    if(pair < tokenCount * TOP_K)
+    {
+        auto slot   = pair / tokenCount;
+        auto token  = pair % tokenCount;
+        auto expert = topkExperts[pair];
+        auto row    = expertOffsets[expert] + atomicAdd(expertCursors + expert, 1u);
+
+        routedTokens[row] = static_cast<index_t>(token);
+        routedSlots[row]  = static_cast<index_t>(token * TOP_K + slot);
+    }
+}
+
+// Step 5: grouped gate and up GEMMs, H[row] = silu(X[token] x W1[e]) * (X[token] x W3[e])
+// for the routed rows of each tile. H is in routed order (routed rows x F).
+__global__ void moe_gate_up_d(uint32_t         hidden,
+                              uint32_t         ffn,
+                              float16_t const* x,
+                              float16_t const* w1,
+                              float16_t const* w3,
+                              float16_t*       h,
+                              index_t const*   routedTokens,
+                              index_t const*   tileExperts)
+{
+    auto expert = tileExperts[blockIdx.x];
+
+    // Tiles past the routed rows of all experts
+    if(expert < 0)
+    {
+        return;
+    }
+
+    auto fragX    = FragX();
+    auto fragGate = FragW();
+    auto fragUp   = FragW();
+    auto accGate  = FragAcc();
+    auto accUp    = FragAcc();
+    auto fragH    = FragOut();
+
+    // Target routed row and output column of the warp block
+    auto wave = threadIdx.x / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    auto row  = blockIdx.x * TILE_M + wave * ROCWMMA_M;
+    auto col = (blockIdx.y * blockDim.y + threadIdx.y) * ROCWMMA_N;
+
+    auto* w1Expert = w1 + size_t(expert) * hidden * ffn;
+    auto* w3Expert = w3 + size_t(expert) * hidden * ffn;
+    auto* tokens   = routedTokens + row;
+
+    rocwmma::fill_fragment(accGate, 0.0f);
+    rocwmma::fill_fragment(accUp, 0.0f);
+
+    for(uint32_t i = 0; i < hidden; i += ROCWMMA_K)
+    {
+        // Gather the token rows of A once for both projections
+        rocwmma::load_matrix_gather_sync(fragX, x + i, tokens, hidden);
+        rocwmma::load_matrix_sync(fragGate, w1Expert + (i + size_t(col) * hidden), hidden);
+        rocwmma::load_matrix_sync(fragUp, w3Expert + (i + size_t(col) * hidden), hidden);
+
+        rocwmma::mma_sync(accGate, fragX, fragGate, accGate);
+        rocwmma::mma_sync(accUp, fragX, fragUp, accUp);
+    }
+
+    rocwmma::apply_epilogue(
+        fragH, accGate, epilogue::GatedLinearUnit<epilogue::Silu, FragAcc>(accUp));
+    rocwmma::store_matrix_sync(h + (size_t(row) * ffn + col), fragH, ffn);
+}
+
+// Step 6: grouped down GEMM, YSlots[slot] = H[row] x W2[e], scattered from routed order to the
+// output slot of each routed row.
+__global__ void moe_down_d(uint32_t         hidden,
+                           uint32_t         ffn,
+                           float16_t const* h,
+                           float16_t const* w2,
+                           float16_t*       ySlots,
+                           index_t const*   routedSlots,
+                           index_t const*   tileExperts)
+{
+    auto expert = tileExperts[blockIdx.x];
+
+    // Tiles past the routed rows of all experts
+    if(expert < 0)
+    {
+        return;
+    }
+
+    auto fragH   = FragX();
+    auto fragW   = FragW();
+    auto fragAcc = FragAcc();
+    auto fragY   = FragOut();
+
+    // Target routed row and output column of the warp block
+    auto wave = threadIdx.x / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    auto row  = blockIdx.x * TILE_M + wave * ROCWMMA_M;
+    auto col = (blockIdx.y * blockDim.y + threadIdx.y) * ROCWMMA_N;
+
+    auto* w2Expert = w2 + size_t(expert) * ffn * hidden;
+
+    rocwmma::fill_fragment(fragAcc, 0.0f);
+
+    for(uint32_t i = 0; i < ffn; i += ROCWMMA_K)
+    {
+        rocwmma::load_matrix_sync(fragH, h + (size_t(row) * ffn + i), ffn);
+        rocwmma::load_matrix_sync(fragW, w2Expert + (i + size_t(col) * ffn), ffn);
+        rocwmma::mma_sync(fragAcc, fragH, fragW, fragAcc);
+    }
+
+    // Slots of a token are distinct rows: no atomics required
+    rocwmma::apply_epilogue(fragY, fragAcc);
+    rocwmma::store_matrix_scatter_sync(ySlots + col, fragY, routedSlots + row, hidden);
+}
+
+// Step 7: Y[t] = sum_j w[t][j] * YSlots[t * TOP_K + j], one workgroup row per token
+__global__ void moe_combine_d(uint32_t         tokenCount,
+                              uint32_t         hidden,
+                              float16_t const* ySlots,
+                              float32_t const* topkWeights,
+                              float16_t*       y)
+{
+    auto token = blockIdx.y;
+    auto col   = blockIdx.x * blockDim.x + threadIdx.x;
+    if(col < hidden)
+    {
+        float32_t acc = 0.0f;
+        for(uint32_t j = 0; j < TOP_K; j++)
+        {
+            acc += topkWeights[j * tokenCount + token]
+                   * static_cast<float32_t>(ySlots[(size_t(token) * TOP_K + j) * hidden + col]);
+        }
+        y[size_t(token) * hidden + col] = static_cast<float16_t>(acc);
+    }
+}
+
+// Routing of the host-routed baseline, as steps 2 - 4 with a stable order.
+// Fills the tile descriptors and routed rows of maxTiles tiles.
+__host__ void moe_route_h(uint32_t                    tokenCount,
+                          std::vector<int32_t> const& topkExperts,
+                          std::vector<index_t>&       routedTokens,
+                          std::vector<index_t>&       routedSlots,
+                          std::vector<index_t>&       tileExperts)
+{
+    auto maxTiles = maxRoutedTiles(tokenCount);
+
+    routedTokens.assign(size_t(maxTiles) * TILE_M, -1);
+    routedSlots.assign(size_t(maxTiles) * TILE_M, -1);
+    tileExperts.assign(maxTiles, -1);
+
+    uint32_t row  = 0u;
+    uint32_t tile = 0u;
+    for(uint32_t e = 0; e < EXPERT_COUNT; e++)
+    {
+        auto begin = row;
+        for(uint32_t pair = 0; pair < tokenCount * TOP_K; pair++)
+        {
+            if(topkExperts[pair] == static_cast<int32_t>(e))
+            {
+                auto slot  = pair / tokenCount;
+                auto token = pair % tokenCount;
+
+                routedTokens[row] = static_cast<index_t>(token);
+                routedSlots[row]  = static_cast<index_t>(token * TOP_K + slot);
+                row++;
+            }
+        }
+
+        for(; tile * TILE_M < row; tile++)
+        {
+            tileExperts[tile] = static_cast<index_t>(e);
+        }
+        row = begin + rocwmma::ceilDiv(row - begin, TILE_M) * TILE_M;
+    }
+}
+
+// Small uniform values in [-scale, scale], which keep the fp16 intermediates in range
+__host__ static void fillUniform(std::vector<float16_t>& data, float32_t scale, uint32_t seed)
+{
+    std::mt19937                              gen(seed);
+    std::uniform_real_distribution<float32_t> dist(-scale, scale);
+    for(auto& v : data)
+    {
+        v = static_cast<float16_t>(dist(gen));
+    }
+}
+
+__host__ void moe_ffn_test(uint32_t tokenCount, uint32_t hidden, uint32_t ffn)
+{
+    // Bounds check
+    if(tokenCount % ROCWMMA_M || hidden % TILE_N || ffn % TILE_N || hidden % ROCWMMA_K
+       || ffn % ROCWMMA_K)
+    {
+        std::cout << "Unsupported size!\n";
+        return;
+    }
+
+    std::cout << "Initializing host data..." << std::endl;
+
+    auto pairCount = tokenCount * TOP_K;
+    auto maxTiles  = maxRoutedTiles(tokenCount);
+    auto maxRows   = maxTiles * TILE_M;
+
+    // Weights of the experts scaled by their fan-in, with unit activations
+    std::vector<float16_t> matrixX(size_t(tokenCount) * hidden);
+    std::vector<float16_t> matrixWg(size_t(EXPERT_COLS) * hidden, static_cast<float16_t>(0.0f));
+    std::vector<float16_t> matrixW1(size_t(EXPERT_COUNT) * hidden * ffn);
+    std::vector<float16_t> matrixW3(size_t(EXPERT_COUNT) * hidden * ffn);
+    std::vector<float16_t> matrixW2(size_t(EXPERT_COUNT) * ffn * hidden);
+    std::vector<float16_t> matrixY(size_t(tokenCount) * hidden);
+
+    fillUniform(matrixX, 1.0f, 1u);
+    fillUniform(matrixW1, 1.0f / std::sqrt(float32_t(hidden)), 2u);
+    fillUniform(matrixW3, 1.0f / std::sqrt(float32_t(hidden)), 3u);
+    fillUniform(matrixW2, 1.0f / std::sqrt(float32_t(ffn)), 4u);
+    {
+        // Padding columns of Wg stay zero
+        std::vector<float16_t> gate(size_t(EXPERT_COUNT) * hidden);
+        fillUniform(gate, 1.0f, 5u);
+        std::copy(gate.begin(), gate.end(), matrixWg.begin());
+    }
+
+    std::vector<float32_t> expertMask(EXPERT_COLS, 0.0f);
+    std::fill(expertMask.begin() + EXPERT_COUNT,
+              expertMask.end(),
+              -std::numeric_limits<float32_t>::infinity());
+
+    std::cout << "Initializing device data..." << std::endl;
+
+    // Allocate and copy device memory
+    float16_t* d_x;
+    float16_t* d_wg;
+    float16_t* d_w1;
+    float16_t* d_w3;
+    float16_t* d_w2;
+    float16_t* d_h;
+    float16_t* d_ySlots;
+    float16_t* d_y;
+    float32_t* d_expertMask;
+    int32_t*   d_topkExperts;
+    float32_t* d_topkWeights;
+    uint32_t*  d_expertCounts;
+    uint32_t*  d_expertOffsets;
+    uint32_t*  d_expertCursors;
+    index_t*   d_tileExperts;
+    index_t*   d_routedTokens;
+    index_t*   d_routedSlots;
+
+    const size_t bytesX      = matrixX.size() * sizeof(float16_t);
+    const size_t bytesWg     = matrixWg.size() * sizeof(float16_t);
+    const size_t bytesW      = matrixW1.size() * sizeof(float16_t);
+    const size_t bytesH      = size_t(maxRows) * ffn * sizeof(float16_t);
+    const size_t bytesYSlots = size_t(pairCount) * hidden * sizeof(float16_t);
+    const size_t bytesY      = matrixY.size() * sizeof(float16_t);
+    const size_t bytesMask   = expertMask.size() * sizeof(float32_t);
+    const size_t bytesTopk   = pairCount * sizeof(int32_t);
+    const size_t bytesCounts = EXPERT_COUNT * sizeof(uint32_t);
+    const size_t bytesTiles  = maxTiles * sizeof(index_t);
+    const size_t bytesRouted = maxRows * sizeof(index_t);
+
+    CHECK_HIP_ERROR(hipMalloc(&d_x, bytesX));
+    CHECK_HIP_ERROR(hipMalloc(&d_wg, bytesWg));
+    CHECK_HIP_ERROR(hipMalloc(&d_w1, bytesW));
+    CHECK_HIP_ERROR(hipMalloc(&d_w3, bytesW));
+    CHECK_HIP_ERROR(hipMalloc(&d_w2, bytesW));
+    CHECK_HIP_ERROR(hipMalloc(&d_h, bytesH));
+    CHECK_HIP_ERROR(hipMalloc(&d_ySlots, bytesYSlots));
+    CHECK_HIP_ERROR(hipMalloc(&d_y, bytesY));
+    CHECK_HIP_ERROR(hipMalloc(&d_expertMask, bytesMask));
+    CHECK_HIP_ERROR(hipMalloc(&d_topkExperts, bytesTopk));
+    CHECK_HIP_ERROR(hipMalloc(&d_topkWeights, pairCount * sizeof(float32_t)));
+    CHECK_HIP_ERROR(hipMalloc(&d_expertCounts, bytesCounts));
+    CHECK_HIP_ERROR(hipMalloc(&d_expertOffsets, bytesCounts));
+    CHECK_HIP_ERROR(hipMalloc(&d_expertCursors, bytesCounts));
+    CHECK_HIP_ERROR(hipMalloc(&d_tileExperts, bytesTiles));
+    CHECK_HIP_ERROR(hipMalloc(&d_routedTokens, bytesRouted));
+    CHECK_HIP_ERROR(hipMalloc(&d_routedSlots, bytesRouted));
+
+    CHECK_HIP_ERROR(hipMemcpy(d_x, matrixX.data(), bytesX, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_wg, matrixWg.data(), bytesWg, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_w1, matrixW1.data(), bytesW, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_w3, matrixW3.data(), bytesW, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_w2, matrixW2.data(), bytesW, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_expertMask, expertMask.data(), bytesMask, hipMemcpyHostToDevice));
+
+    auto gemmBlockDim = dim3(T_BLOCK_X, T_BLOCK_Y);
+    auto pairGridDim  = dim3(rocwmma::ceilDiv(pairCount, ROUTE_THREADS));
+
+    auto gateTopk = [&]() {
+        hipExtLaunchKernelGGL(moe_gate_topk_d,
+                              dim3(tokenCount / ROCWMMA_M),
+                              dim3(WAVE_SIZE),
+                              0, // sharedMemBytes
+                              0, // stream
+                              nullptr, // Event start
+                              nullptr, // event stop
+                              0, // flags
+                              tokenCount,
+                              hidden,
+                              d_x,
+                              d_wg,
+                              d_expertMask,
+                              d_topkExperts,
+                              d_topkWeights);
+    };
+
+    auto expertFfn = [&]() {
+        hipExtLaunchKernelGGL(moe_gate_up_d,
+                              dim3(maxTiles, ffn / TILE_N),
+                              gemmBlockDim,
+                              0, // sharedMemBytes
+                              0, // stream
+                              nullptr, // Event start
+                              nullptr, // event stop
+                              0, // flags
+                              hidden,
+                              ffn,
+                              d_x,
+                              d_w1,
+                              d_w3,
+                              d_h,
+                              d_routedTokens,
+                              d_tileExperts);
+
+        hipExtLaunchKernelGGL(moe_down_d,
+                              dim3(maxTiles, hidden / TILE_N),
+                              gemmBlockDim,
+                              0, // sharedMemBytes
+                              0, // stream
+                              nullptr, // Event start
+                              nullptr, // event stop
+                              0, // flags
+                              hidden,
+                              ffn,
+                              d_h,
+                              d_w2,
+                              d_ySlots,
+                              d_routedSlots,
+                              d_tileExperts);
+
+        hipExtLaunchKernelGGL(moe_combine_d,
+                              dim3(rocwmma::ceilDiv(hidden, ROUTE_THREADS), tokenCount),
+                              dim3(ROUTE_THREADS),
+                              0, // sharedMemBytes
+                              0, // stream
+                              nullptr, // Event start
+                              nullptr, // event stop
+                              0, // flags
+                              tokenCount,
+                              hidden,
+                              d_ySlots,
+                              d_topkWeights,
+                              d_y);
+    };
+
+    // Routing copied to the host and back between the gating and expert kernels
+    std::vector<int32_t> topkExperts(pairCount);
+    std::vector<index_t> routedTokens;
+    std::vector<index_t> routedSlots;
+    std::vector<index_t> tileExperts;
+
+    auto hostRoutedKernel = [&]() {
+        gateTopk();
+
+        CHECK_HIP_ERROR(
+            hipMemcpy(topkExperts.data(), d_topkExperts, bytesTopk, hipMemcpyDeviceToHost));
+        moe_route_h(tokenCount, topkExperts, routedTokens, routedSlots, tileExperts);
+        CHECK_HIP_ERROR(
+            hipMemcpy(d_routedTokens, routedTokens.data(), bytesRouted, hipMemcpyHostToDevice));
+        CHECK_HIP_ERROR(
+            hipMemcpy(d_routedSlots, routedSlots.data(), bytesRouted, hipMemcpyHostToDevice));
+        CHECK_HIP_ERROR(
+            hipMemcpy(d_tileExperts, tileExperts.data(), bytesTiles, hipMemcpyHostToDevice));
+
+        expertFfn();
+    };
+
+    // Every step on the stream, without host synchronization
+    auto deviceRoutedKernel = [&]() {
+        CHECK_HIP_ERROR(hipMemsetAsync(d_expertCounts, 0, bytesCounts));
+        CHECK_HIP_ERROR(hipMemsetAsync(d_routedTokens, 0xFF, bytesRouted));
+        CHECK_HIP_ERROR(hipMemsetAsync(d_routedSlots, 0xFF, bytesRouted));
+
+        gateTopk();
+
+        hipExtLaunchKernelGGL(moe_count_d,
+                              pairGridDim,
+                              dim3(ROUTE_THREADS),
+                              0, // sharedMemBytes
+                              0, // stream
+                              nullptr, // Event start
+                              nullptr, // event stop
+                              0, // flags
+                              pairCount,
+                              d_topkExperts,
+                              d_expertCounts);
+
+        hipExtLaunchKernelGGL(moe_offsets_d,
+                              dim3(1),
+                              dim3(WAVE_SIZE),
+                              0, // sharedMemBytes
+                              0, // stream
+                              nullptr, // Event start
+                              nullptr, // event stop
+                              0, // flags
+                              maxTiles,
+                              d_expertCounts,
+                              d_expertOffsets,
+                              d_expertCursors,
+                              d_tileExperts);
+
+        hipExtLaunchKernelGGL(moe_permute_d,
+                              pairGridDim,
+                              dim3(ROUTE_THREADS),
+                              0, // sharedMemBytes
+                              0, // stream
+                              nullptr, // Event start
+                              nullptr, // event stop
+                              0, // flags
+                              tokenCount,
+                              d_topkExperts,
+                              d_expertOffsets,
+                              d_expertCursors,
+                              d_routedTokens,
+                              d_routedSlots);
+
+        expertFfn();
+    };
+
+#if !NDEBUG
+
+    // Reference gating logits
+    std::vector<float32_t> logits(size_t(tokenCount) * EXPERT_COUNT);
+    for(uint32_t t = 0; t < tokenCount; t++)
+    {
+        for(uint32_t e = 0; e < EXPERT_COUNT; e++)
+        {
+            float32_t acc = 0.0f;
+            for(uint32_t i = 0; i < hidden; i++)
+            {
+                acc += static_cast<float32_t>(matrixX[size_t(t) * hidden + i])
+                       * static_cast<float32_t>(matrixWg[size_t(e) * hidden + i]);
+            }
+            logits[size_t(t) * EXPERT_COUNT + e] = acc;
+        }
+    }
+
+    auto validate = [&]() {
+        std::vector<float32_t> topkWeights(pairCount);
+        CHECK_HIP_ERROR(
+            hipMemcpy(topkExperts.data(), d_topkExperts, bytesTopk, hipMemcpyDeviceToHost));
+        CHECK_HIP_ERROR(hipMemcpy(topkWeights.data(),
+                                  d_topkWeights,
+                                  pairCount * sizeof(float32_t),
+                                  hipMemcpyDeviceToHost));
+        CHECK_HIP_ERROR(hipMemcpy(matrixY.data(), d_y, bytesY, hipMemcpyDeviceToHost));
+
+        // Selected experts are distinct, and rank within the top-k of the reference logits up to
+        // the rounding of the accumulation order
+        bool routingValid = true;
+        for(uint32_t t = 0; t < tokenCount; t++)
+        {
+            auto* row = logits.data() + size_t(t) * EXPERT_COUNT;
+
+            std::vector<float32_t> sorted(row, row + EXPERT_COUNT);
+            std::nth_element(
+                sorted.begin(), sorted.begin() + (TOP_K - 1), sorted.end(), std::greater<>());
+            auto threshold = sorted[TOP_K - 1] - 1.0e-3f * std::abs(sorted[TOP_K - 1]) - 1.0e-3f;
+
+            for(uint32_t j = 0; j < TOP_K; j++)
+            {
+                auto e = topkExperts[j * tokenCount + t];
+                routingValid &= (e >= 0 && e < static_cast<int32_t>(EXPERT_COUNT)
+                                 && row[e] >= threshold);
+                for(uint32_t i = 0; i < j; i++)
+                {
+                    routingValid &= (topkExperts[i * tokenCount + t] != e);
+                }
+            }
+        }
+
+        // Reference expert FFN with the selected experts and weights, rounding the intermediates
+        // to fp16 as the kernels do
+        std::vector<float16_t> matrixY_ref(matrixY.size());
+        std::vector<float16_t> hRow(ffn);
+        std::vector<float32_t> yRow(hidden);
+        for(uint32_t t = 0; t < tokenCount; t++)
+        {
+            auto* xRow = matrixX.data() + size_t(t) * hidden;
+            std::fill(yRow.begin(), yRow.end(), 0.0f);
+
+            for(uint32_t j = 0; j < TOP_K; j++)
+            {
+                auto e = topkExperts[j * tokenCount + t];
+                if(e < 0 || e >= static_cast<int32_t>(EXPERT_COUNT))
+                {
+                    continue;
+                }
+
+                auto* w1Expert = matrixW1.data() + size_t(e) * hidden * ffn;
+                auto* w3Expert = matrixW3.data() + size_t(e) * hidden * ffn;
+                auto* w2Expert = matrixW2.data() + size_t(e) * ffn * hidden;
+
+                for(uint32_t c = 0; c < ffn; c++)
+                {
+                    float32_t gate = 0.0f;
+                    float32_t up   = 0.0f;
+                    for(uint32_t i = 0; i < hidden; i++)
+                    {
+                        auto xi = static_cast<float32_t>(xRow[i]);
+                        gate += xi * static_cast<float32_t>(w1Expert[size_t(c) * hidden + i]);
+                        up += xi * static_cast<float32_t>(w3Expert[size_t(c) * hidden + i]);
+                    }
+                    hRow[c] = static_cast<float16_t>(gate / (1.0f + std::exp(-gate)) * up);
+                }
+
+                for(uint32_t c = 0; c < hidden; c++)
+                {
+                    float32_t acc = 0.0f;
+                    for(uint32_t i = 0; i < ffn; i++)
+                    {
+                        acc += static_cast<float32_t>(hRow[i])
+                               * static_cast<float32_t>(w2Expert[size_t(c) * ffn + i]);
+                    }
+                    yRow[c] += topkWeights[j * tokenCount + t]
+                               * static_cast<float32_t>(static_cast<float16_t>(acc));
+                }
+            }
+
+            for(uint32_t c = 0; c < hidden; c++)
+            {
+                matrixY_ref[size_t(t) * hidden + c] = static_cast<float16_t>(yRow[c]);
+            }
+        }
+
+        auto res = compareEqual(matrixY.data(), matrixY_ref.data(), matrixY.size(), 100.0);
+
+        std::cout << (routingValid && std::get<0>(res) ? "PASSED" : "FAILED") << std::endl;
+        std::cout << "Max relative error: " << std::get<1>(res) << std::endl;
+    };
+
+#endif // !NDEBUG
+
+    // Runs are timed individually, with warm and cold caches
+    BenchmarkHarness harness;
+
+    // Gating GEMM, and the 3 expert GEMMs of the routed tokens. Padding rows are excluded.
+    auto gFlops = calculateGFlops(tokenCount, EXPERT_COUNT, hidden)
+                  + 3.0 * calculateGFlops(pairCount, ffn, hidden);
+
+    auto echo = [&](const char* kernelName, auto&& kernel) {
+        for(auto cacheState :
+            {BenchmarkHarness::CacheState::Warm, BenchmarkHarness::CacheState::Cold})
+        {
+            auto stats        = harness.run(kernel, cacheState);
+            auto tFlopsPerSec = gFlops / stats.mMedianMs;
+
+            std::cout << kernelName << ", " << ROCWMMA_M << ", " << ROCWMMA_N << ", " << ROCWMMA_K
+                      << ", " << EXPERT_COUNT << ", " << TOP_K << ", " << tokenCount << ", "
+                      << hidden << ", " << ffn << ", "
+                      << (cacheState == BenchmarkHarness::CacheState::Warm ? "warm" : "cold")
+                      << ", " << stats.mMedianMs << ", " << gFlops << ", " << tFlopsPerSec
+                      << ", ";
+            BenchmarkHarness::printStats(std::cout, stats) << std::endl;
+        }
+    };
+
+    std::cout << "Routing, BlkM, BlkN, BlkK, Experts, TopK, Tokens, MatH, MatF, "
+              << "Cache, elapsedMs, Problem Size(GFlops), TFlops/s, "
+              << BenchmarkHarness::statsHeader() << std::endl;
+
+    echo("Host", hostRoutedKernel);
+
+#if !NDEBUG
+    validate();
+#endif // !NDEBUG
+
+    // Fill outputs with NaN to catch contamination
+    CHECK_HIP_ERROR(hipMemset(d_y, 0xFF, bytesY));
+
+    echo("Device", deviceRoutedKernel);
+
+#if !NDEBUG
+    validate();
+#endif // !NDEBUG
+
+    // Release device memory
+    CHECK_HIP_ERROR(hipFree(d_x));
+    CHECK_HIP_ERROR(hipFree(d_wg));
+    CHECK_HIP_ERROR(hipFree(d_w1));
+    CHECK_HIP_ERROR(hipFree(d_w3));
+    CHECK_HIP_ERROR(hipFree(d_w2));
+    CHECK_HIP_ERROR(hipFree(d_h));
+    CHECK_HIP_ERROR(hipFree(d_ySlots));
+    CHECK_HIP_ERROR(hipFree(d_y));
+    CHECK_HIP_ERROR(hipFree(d_expertMask));
+    CHECK_HIP_ERROR(hipFree(d_topkExperts));
+    CHECK_HIP_ERROR(hipFree(d_topkWeights));
+    CHECK_HIP_ERROR(hipFree(d_expertCounts));
+    CHECK_HIP_ERROR(hipFree(d_expertOffsets));
+    CHECK_HIP_ERROR(hipFree(d_expertCursors));
+    CHECK_HIP_ERROR(hipFree(d_tileExperts));
+    CHECK_HIP_ERROR(hipFree(d_routedTokens));
+    CHECK_HIP_ERROR(hipFree(d_routedSlots));
+
+    std::cout << "Finished!" << std::endl;
+}
+
+int main()
+{
+    // Qwen1.5-MoE-A2.7B expert layer (H = 2048, F = 1408), decode and prefill token counts
+    moe_ffn_test(16, 2048, 1408);
+    moe_ffn_test(64, 2048, 1408);
+    moe_ffn_test(256, 2048, 1408);
+
+    return 0;
+}
@@ -0,0 +1,764 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_fp16.h>
+#include <hip/hip_runtime.h>
+
+#include <rocwmma/rocwmma.hpp>
+#include <rocwmma/rocwmma_epilogue.hpp>
+#include <rocwmma/rocwmma_transforms.hpp>
+
+#include "benchmark_harness.hpp"
+#include "common.hpp"
+
+using rocwmma::accumulator;
+using rocwmma::col_major;
+using rocwmma::float16_t;
+using rocwmma::float32_t;
+using rocwmma::float64_t;
+using rocwmma::float8_t;
+using rocwmma::index_t;
+using rocwmma::matrix_a;
+using rocwmma::matrix_b;
+using rocwmma::row_major;
+
+/* Motivation
+*
+* The decode step of LLM serving attends one new query token per sequence to
+* all of the cached keys and values of that sequence:
+*
+* O = softmax(scale * q x K^T) x V, per query head
+*
+* Serving engines store the KV cache in fixed size pages of PAGE_SIZE tokens,
+* allocated from a shared pool as sequences grow. The pages of a sequence are
+* listed in its block table, and are scattered across the pool.
+*
+* The step is bound by the bandwidth of streaming K and V, which are read once.
+* This sample:
+* - Reads K and V in place from the page pool with load_matrix_paged_sync, which
+*   looks up the page of each token block in the block table. The K^T blocks are
+*   col_major matrix_b fragments (tokens are columns), and the V blocks are
+*   row_major matrix_b fragments (tokens are rows).
+* - Packs the GROUP_SIZE query heads sharing a KV head (grouped query attention)
+*   into the rows of the Q fragments, such that K and V are read once per group.
+* - Splits the sequence into chunks of chunkTokens tokens (split-K over the
+*   sequence length), one wave per chunk, such that long sequences and small
+*   batches still fill the device. Each chunk folds its token blocks with
+*   online_softmax_rows, and writes an un-normalized partial output with its row
+*   max and row sum.
+* - Handles sequences of different lengths in one launch: chunks past the end
+*   of their sequence exit, and the tokens of the last block past the end of the
+*   sequence are masked out of the softmax.
+* - Merges the partial outputs of the chunks of each sequence in a reduction
+*   kernel, rescaling each by exp(max_chunk - max).
+*
+* Quantized KV cache
+*
+* The size of the KV cache caps the batch size, and its bandwidth the step time.
+* The cache may instead hold float8_t or int8_t K and V, with one float32_t scale
+* per KV head and page (per-head scales are the case of equal page scales):
+* - K and V blocks are read with load_matrix_paged_dequant_sync, converting the
+*   quantized elements to float16_t fragments in registers after the load.
+* - The token blocks of ROCWMMA_N tokens lie within one page, so the scale of a
+*   block is a scalar. The K scale is folded into the softmax scale of the block,
+*   and the V scale into P before it is staged, at no cost to mma_sync.
+* The K / V traffic, and the cache footprint, halve against float16_t. The cache
+* is quantized on the host here; when written by the QKV projection, the same
+* page scales apply with the TensorScale and Saturate epilogue stages ahead of
+* store_matrix_paged_sync.
+*
+* The benchmark runs batches of long and mixed length sequences with and without
+* split-K, and reports the achieved bandwidth of reading K and V against the
+* theoretical peak of the device.
+*
+* Note: chunkTokens must be a multiple of ROCWMMA_N.
+*/
+
+// Supports ROCWMMA_M/N/K sizes of 16. Q x K^T blocks are ROCWMMA_N tokens
+// wide, and P x V blocks are ROCWMMA_K tokens deep.
+const int ROCWMMA_M = 16;
+const int ROCWMMA_N = 16;
+const int ROCWMMA_K = 16;
+
+// Llama-3 8B attention geometry
+const int HEAD_DIM     = 128;
+const int NUM_Q_HEADS  = 32;
+const int NUM_KV_HEADS = 8;
+const int GROUP_SIZE   = NUM_Q_HEADS / NUM_KV_HEADS;
+
+// Tokens per page of the KV cache
+// : multiples of 16, such that each token block has a single page scale
+const int PAGE_SIZE = 16;
+
+// Tokens per split-K chunk
+const int CHUNK_TOKENS = 256;
+
+// Device warp size
+const uint32_t WAVE_SIZE = getWarpSize();
+
+// Thread block
+// : One wave per chunk
+const int T_BLOCK_X = WAVE_SIZE;
+
+using FragQ   = rocwmma::fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, row_major>;
+using FragK   = rocwmma::fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, col_major>;
+using FragV   = rocwmma::fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, row_major>;
+using FragP   = rocwmma::fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, row_major>;
+using FragAcc = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float32_t>;
+using FragOut = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t>;
+
+static_assert(PAGE_SIZE % ROCWMMA_N == 0 && PAGE_SIZE % ROCWMMA_K == 0,
+              "Token blocks must lie within one page");
+
+// K or V block of a token block from its page, dequantized when the cache is quantized
+template <typename FragT, typename CacheT>
+__device__ static inline void loadCacheBlock(FragT&         frag,
+                                             CacheT const*  pages,
+                                             index_t const* table,
+                                             uint32_t       row,
+                                             uint32_t       col)
+{
+    if constexpr(std::is_same<CacheT, float16_t>::value)
+    {
+        rocwmma::load_matrix_paged_sync(frag, pages, table, PAGE_SIZE, HEAD_DIM, row, col);
+    }
+    else
+    {
+        rocwmma::load_matrix_paged_dequant_sync(frag, pages, table, PAGE_SIZE, HEAD_DIM, row, col);
+    }
+}
+
+// Split-K paged decode attention. Each wave computes the partial attention of
+// the GROUP_SIZE query heads of one KV head over one chunk of a sequence.
+//
+// : q is in row-major format             (batch x NUM_Q_HEADS x HEAD_DIM)
+// : kCache, vCache are in row-major pages (NUM_KV_HEADS x numPages x PAGE_SIZE x HEAD_DIM)
+//   of CacheT, float16_t or quantized float8_t / int8_t
+// : kScales, vScales are the dequantization scales of each page (NUM_KV_HEADS x numPages),
+//   unused for float16_t
+// : blockTables lists the pages of each sequence (batch x maxPages), -1 past the end
+// : partialO is in row-major format      (batch x NUM_KV_HEADS x maxSplits x ROCWMMA_M x HEAD_DIM)
+// : partialMax, partialSum are vectors   (batch x NUM_KV_HEADS x maxSplits x ROCWMMA_M)
+template <typename CacheT>
+__global__ void __launch_bounds__(rocwmma::Constants::AMDGCN_WAVE_SIZE)
+    paged_attention_d(uint32_t         numPages,
+                      uint32_t         maxPages,
+                      uint32_t         maxSplits,
+                      uint32_t         chunkTokens,
+                      float16_t const* q,
+                      CacheT const*    kCache,
+                      CacheT const*    vCache,
+                      float32_t const* kScales,
+                      float32_t const* vScales,
+                      index_t const*   blockTables,
+                      int32_t const*   seqLens,
+                      float32_t*       partialO,
+                      float32_t*       partialMax,
+                      float32_t*       partialSum,
+                      float32_t        scale)
+{
+    // Probabilities P, staged to the matrix_a layout
+    __shared__ float16_t ldsP[ROCWMMA_M * ROCWMMA_N];
+
+    // Softmax mask of the last token block
+    __shared__ float32_t ldsMask[ROCWMMA_N];
+
+    auto split  = blockIdx.x;
+    auto kvHead = blockIdx.y;
+    auto seq    = blockIdx.z;
+
+    uint32_t seqLen     = seqLens[seq];
+    uint32_t tokenBegin = split * chunkTokens;
+    if(tokenBegin >= seqLen)
+    {
+        return;
+    }
+    uint32_t tokenEnd = min(tokenBegin + chunkTokens, seqLen);
+
+    // Pages of the sequence and their scales, in the pool of the KV head
+    auto const* table       = blockTables + seq * maxPages;
+    auto        poolOffset  = static_cast<size_t>(kvHead) * numPages * PAGE_SIZE * HEAD_DIM;
+    auto const* kPages      = kCache + poolOffset;
+    auto const* vPages      = vCache + poolOffset;
+    auto const* kPageScales = kScales + kvHead * numPages;
+    auto const* vPageScales = vScales + kvHead * numPages;
+
+    // Query heads of the group, zero padded to ROCWMMA_M rows
+    FragQ fragsQ[HEAD_DIM / ROCWMMA_K];
+    auto const* qGroup = q + (seq * NUM_Q_HEADS + kvHead * GROUP_SIZE) * HEAD_DIM;
+    for(int i = 0; i < HEAD_DIM / ROCWMMA_K; ++i)
+    {
+        rocwmma::load_matrix_bounded_sync(
+            fragsQ[i], qGroup + i * ROCWMMA_K, HEAD_DIM, GROUP_SIZE, ROCWMMA_K);
+    }
+
+    FragAcc fragsO[HEAD_DIM / ROCWMMA_N];
+    for(int j = 0; j < HEAD_DIM / ROCWMMA_N; ++j)
+    {
+        rocwmma::fill_fragment(fragsO[j], 0.0f);
+    }
+
+    FragAcc fragMax, fragSum;
+    rocwmma::fill_fragment(fragMax, std::numeric_limits<float32_t>::lowest());
+    rocwmma::fill_fragment(fragSum, 0.0f);
+
+    for(uint32_t t = tokenBegin; t < tokenEnd; t += ROCWMMA_N)
+    {
+        // Scales of the page of the token block
+        auto blockScale = scale;
+        auto vScale     = 1.0f;
+        if constexpr(!std::is_same<CacheT, float16_t>::value)
+        {
+            auto page = table[t / PAGE_SIZE];
+            blockScale *= kPageScales[page];
+            vScale = vPageScales[page];
+        }
+
+        // S = Q x K^T, reading the K^T block from its page
+        FragAcc fragS;
+        rocwmma::fill_fragment(fragS, 0.0f);
+        for(int i = 0; i < HEAD_DIM / ROCWMMA_K; ++i)
+        {
+            FragK fragK;
+            loadCacheBlock(fragK, kPages, table, i * ROCWMMA_K, t);
+            rocwmma::mma_sync(fragS, fragsQ[i], fragK, fragS);
+        }
+
+        // Mask the tokens past the end of the sequence
+        if(t + ROCWMMA_N > seqLen)
+        {
+            if(threadIdx.x < ROCWMMA_N)
+            {
+                ldsMask[threadIdx.x] = (t + threadIdx.x < seqLen) ? 0.0f : -INFINITY;
+            }
+            rocwmma::synchronize_workgroup();
+
+            FragAcc fragMask;
+            rocwmma::load_row_vector_sync(fragMask, ldsMask);
+            for(int i = 0; i < fragS.num_elements; ++i)
+            {
+                fragS.x[i] += fragMask.x[i];
+            }
+        }
+
+        // P = exp(scale * S - max), O = O * exp(oldMax - max)
+        // The K scale of the block is folded into the softmax scale.
+        auto correction = rocwmma::online_softmax_rows(fragS, fragMax, fragSum, blockScale);
+        for(int j = 0; j < HEAD_DIM / ROCWMMA_N; ++j)
+        {
+            for(int i = 0; i < fragsO[j].num_elements; ++i)
+            {
+                fragsO[j].x[i] *= correction.x[i];
+            }
+        }
+
+        // The V scale of the block is folded into P, after its row sum
+        if constexpr(!std::is_same<CacheT, float16_t>::value)
+        {
+            for(int i = 0; i < fragS.num_elements; ++i)
+            {
+                fragS.x[i] *= vScale;
+            }
+        }
+
+        // Stage P through LDS to the matrix_a layout
+        FragOut fragP16;
+        FragP   fragP;
+        rocwmma::apply_epilogue(fragP16, fragS);
+        rocwmma::store_matrix_sync(ldsP, fragP16, ROCWMMA_N, rocwmma::mem_row_major);
+        rocwmma::synchronize_workgroup();
+        rocwmma::load_matrix_sync(fragP, ldsP, ROCWMMA_N);
+
+        // O += P x V, reading the V block from its page
+        for(int j = 0; j < HEAD_DIM / ROCWMMA_N; ++j)
+        {
+            FragV fragV;
+            loadCacheBlock(fragV, vPages, table, t, j * ROCWMMA_N);
+            rocwmma::mma_sync(fragsO[j], fragP, fragV, fragsO[j]);
+        }
+
+        // P and the mask are overwritten by the next block
+        rocwmma::synchronize_workgroup();
+    }
+
+    // Un-normalized partial output of the chunk, with its row statistics
+    auto slot = (seq * NUM_KV_HEADS + kvHead) * maxSplits + split;
+    for(int j = 0; j < HEAD_DIM / ROCWMMA_N; ++j)
+    {
+        rocwmma::store_matrix_sync(partialO + (slot * ROCWMMA_M * HEAD_DIM + j * ROCWMMA_N),
+                                   fragsO[j],
+                                   HEAD_DIM,
+                                   rocwmma::mem_row_major);
+    }
+    rocwmma::store_col_vector_sync(partialMax + slot * ROCWMMA_M, fragMax);
+    rocwmma::store_col_vector_sync(partialSum + slot * ROCWMMA_M, fragSum);
+}
+
+// Merges the partial outputs of the chunks of each sequence. One workgroup per
+// query head and sequence, one thread per element of the head dimension.
+//
+// : o is in row-major format (batch x NUM_Q_HEADS x HEAD_DIM)
+__global__ void __launch_bounds__(HEAD_DIM) paged_attention_reduce_d(uint32_t         maxSplits,
+                                                                     uint32_t         chunkTokens,
+                                                                     int32_t const*   seqLens,
+                                                                     float32_t const* partialO,
+                                                                     float32_t const* partialMax,
+                                                                     float32_t const* partialSum,
+                                                                     float16_t*       o)
+{
+    auto qHead = blockIdx.x;
+    auto seq   = blockIdx.y;
+    auto col   = threadIdx.x;
+
+    // Row of the query head in the fragments of its KV head
+    auto kvHead = qHead / GROUP_SIZE;
+    auto row    = qHead % GROUP_SIZE;
+
+    auto splits = rocwmma::ceilDiv(static_cast<uint32_t>(seqLens[seq]), chunkTokens);
+    auto first  = (seq * NUM_KV_HEADS + kvHead) * maxSplits;
+
+    auto max = std::numeric_limits<float32_t>::lowest();
+    for(uint32_t s = 0; s < splits; ++s)
+    {
+        max = fmaxf(max, partialMax[(first + s) * ROCWMMA_M + row]);
+    }
+
+    auto sum   = 0.0f;
+    auto accum = 0.0f;
+    for(uint32_t s = 0; s < splits; ++s)
+    {
+        auto slot  = first + s;
+        auto scale = __expf(partialMax[slot * ROCWMMA_M + row] - max);
+        sum += partialSum[slot * ROCWMMA_M + row] * scale;
+        accum += partialO[(slot * ROCWMMA_M + row) * HEAD_DIM + col] * scale;
+    }
+
+    o[(seq * NUM_Q_HEADS + qHead) * HEAD_DIM + col] = static_cast<float16_t>(accum / sum);
+}
+
+// Host reference of the decode attention, reading K and V through the block tables
+// and dequantizing them with the scales of their pages
+template <typename CacheT>
+__host__ void paged_attention_cpu_h(uint32_t                      numPages,
+                                    uint32_t                      maxPages,
+                                    std::vector<float16_t> const& q,
+                                    std::vector<CacheT> const&    kCache,
+                                    std::vector<CacheT> const&    vCache,
+                                    std::vector<float32_t> const& kScales,
+                                    std::vector<float32_t> const& vScales,
+                                    std::vector<index_t> const&   blockTables,
+                                    std::vector<int32_t> const&   seqLens,
+                                    std::vector<float16_t>&       o,
+                                    float32_t                     scale)
+{
+    auto batch = static_cast<int>(seqLens.size());
+
+#pragma omp parallel for collapse(2)
+    for(int seq = 0; seq < batch; ++seq)
+    {
+        for(int qHead = 0; qHead < NUM_Q_HEADS; ++qHead)
+        {
+            auto kvHead = qHead / GROUP_SIZE;
+            auto seqLen = seqLens[seq];
+
+            // Token t of the sequence in the pool of the KV head, and the scale index of its page
+            auto pageIndex = [&](int t) {
+                return static_cast<size_t>(kvHead) * numPages
+                       + blockTables[seq * maxPages + t / PAGE_SIZE];
+            };
+            auto tokenOffset = [&](int t) {
+                return (pageIndex(t) * PAGE_SIZE + t % PAGE_SIZE) * HEAD_DIM;
+            };
+
+            auto const*            qRow = q.data() + (seq * NUM_Q_HEADS + qHead) * HEAD_DIM;
+            std::vector<float64_t> s(seqLen);
+            for(int t = 0; t < seqLen; ++t)
+            {
+                auto const* kRow = kCache.data() + tokenOffset(t);
+                auto        dot  = 0.0;
+                for(int d = 0; d < HEAD_DIM; ++d)
+                {
+                    dot += static_cast<float64_t>(qRow[d])
+                           * static_cast<float64_t>(static_cast<float32_t>(kRow[d]));
+                }
+                s[t] = static_cast<float64_t>(scale) * kScales[pageIndex(t)] * dot;
+            }
+
+            auto max = *std::max_element(s.begin(), s.end());
+            auto sum = 0.0;
+            for(auto& value : s)
+            {
+                value = std::exp(value - max);
+                sum += value;
+            }
+
+            for(int d = 0; d < HEAD_DIM; ++d)
+            {
+                auto accum = 0.0;
+                for(int t = 0; t < seqLen; ++t)
+                {
+                    accum += s[t] * vScales[pageIndex(t)]
+                             * static_cast<float64_t>(
+                                 static_cast<float32_t>(vCache[tokenOffset(t) + d]));
+                }
+                o[(seq * NUM_Q_HEADS + qHead) * HEAD_DIM + d]
+                    = static_cast<float16_t>(accum / sum);
+            }
+        }
+    }
+}
+
+__host__ double peakBandwidthGBs()
+{
+    hipDevice_t     handle;
+    hipDeviceProp_t props;
+    CHECK_HIP_ERROR(hipGetDevice(&handle));
+    CHECK_HIP_ERROR(hipGetDeviceProperties(&props, handle));
+
+    // Double data rate, memoryClockRate in kHz and memoryBusWidth in bits
+    return 2.0 * static_cast<double>(props.memoryClockRate) * 1.0e3
+           * static_cast<double>(props.memoryBusWidth) / 8.0 * 1.0e-9;
+}
+
+// Symmetric quantization of each page of values to CacheT, with a scale of
+// amax / max(CacheT) per page. float16_t pages are converted with a scale of 1.
+template <typename CacheT>
+__host__ void quantizePages(std::vector<float32_t> const& values,
+                            std::vector<CacheT>&          cache,
+                            std::vector<float32_t>&       scales)
+{
+    const size_t pageElements = PAGE_SIZE * HEAD_DIM;
+
+#pragma omp parallel for
+    for(int page = 0; page < static_cast<int>(scales.size()); ++page)
+    {
+        auto const* pageValues = values.data() + page * pageElements;
+        auto*       pageCache  = cache.data() + page * pageElements;
+
+        auto scale = 1.0f;
+        if constexpr(!std::is_same<CacheT, float16_t>::value)
+        {
+            auto maxQ = static_cast<float32_t>(std::numeric_limits<CacheT>::max());
+            auto amax = 0.0f;
+            for(size_t i = 0; i < pageElements; ++i)
+            {
+                amax = std::max(amax, std::abs(pageValues[i]));
+            }
+            scale = amax > 0.0f ? amax / maxQ : 1.0f;
+        }
+
+        for(size_t i = 0; i < pageElements; ++i)
+        {
+            auto value = pageValues[i] / scale;
+            if constexpr(std::is_integral<CacheT>::value)
+            {
+                value = std::nearbyint(value);
+            }
+            pageCache[i] = static_cast<CacheT>(value);
+        }
+        scales[page] = scale;
+    }
+}
+
+template <typename CacheT>
+__host__ void paged_attention_test(char const* batchName, std::vector<int32_t> const& seqLens)
+{
+    auto batch  = static_cast<uint32_t>(seqLens.size());
+    auto maxLen = static_cast<uint32_t>(*std::max_element(seqLens.begin(), seqLens.end()));
+    auto tokens = std::accumulate(seqLens.begin(), seqLens.end(), size_t(0));
+
+    // Pages of each sequence, allocated in shuffled order from the pool
+    uint32_t maxPages = rocwmma::ceilDiv(maxLen, PAGE_SIZE);
+    uint32_t numPages = 0;
+    for(auto seqLen : seqLens)
+    {
+        numPages += rocwmma::ceilDiv(static_cast<uint32_t>(seqLen), PAGE_SIZE);
+    }
+
+    std::vector<index_t> pageOrder(numPages);
+    std::iota(pageOrder.begin(), pageOrder.end(), 0);
+    std::shuffle(pageOrder.begin(), pageOrder.end(), std::mt19937(batch));
+
+    std::vector<index_t> blockTables(batch * maxPages, -1);
+    for(uint32_t seq = 0, next = 0; seq < batch; ++seq)
+    {
+        for(uint32_t p = 0; p < rocwmma::ceilDiv(static_cast<uint32_t>(seqLens[seq]), PAGE_SIZE);
+            ++p)
+        {
+            blockTables[seq * maxPages + p] = pageOrder[next++];
+        }
+    }
+
+    float32_t scale = 1.0f / std::sqrt(static_cast<float32_t>(HEAD_DIM));
+
+    // Initialize inputs in [-1, 1]
+    auto poolSize = static_cast<size_t>(NUM_KV_HEADS) * numPages * PAGE_SIZE * HEAD_DIM;
+    std::vector<float16_t> q(batch * NUM_Q_HEADS * HEAD_DIM);
+    std::vector<CacheT>    kCache(poolSize);
+    std::vector<CacheT>    vCache(poolSize);
+    std::vector<float32_t> kScales(NUM_KV_HEADS * numPages);
+    std::vector<float32_t> vScales(NUM_KV_HEADS * numPages);
+    std::vector<float16_t> o(batch * NUM_Q_HEADS * HEAD_DIM);
+
+    auto randValue = []() {
+        return static_cast<float16_t>(2.0f * static_cast<float32_t>(rand()) / RAND_MAX - 1.0f);
+    };
+    std::generate(q.begin(), q.end(), randValue);
+
+    // K and V are quantized to the cache type, page by page
+    std::vector<float32_t> values(poolSize);
+    std::generate(values.begin(), values.end(), randValue);
+    quantizePages(values, kCache, kScales);
+    std::generate(values.begin(), values.end(), randValue);
+    quantizePages(values, vCache, vScales);
+
+    // Allocate and copy device memory. Partial buffers are sized for the smallest chunks.
+    auto maxSplits = rocwmma::ceilDiv(maxLen, static_cast<uint32_t>(CHUNK_TOKENS));
+    auto slots     = static_cast<size_t>(batch) * NUM_KV_HEADS * maxSplits;
+
+    float16_t* d_q;
+    CacheT*    d_kCache;
+    CacheT*    d_vCache;
+    float32_t* d_kScales;
+    float32_t* d_vScales;
+    index_t*   d_blockTables;
+    int32_t*   d_seqLens;
+    float32_t* d_partialO;
+    float32_t* d_partialMax;
+    float32_t* d_partialSum;
+    float16_t* d_o;
+
+    const size_t bytesQ      = q.size() * sizeof(float16_t);
+    const size_t bytesCache  = poolSize * sizeof(CacheT);
+    const size_t bytesScales = kScales.size() * sizeof(float32_t);
+    const size_t bytesTables = blockTables.size() * sizeof(index_t);
+    const size_t bytesLens   = seqLens.size() * sizeof(int32_t);
+    const size_t bytesO      = o.size() * sizeof(float16_t);
+
+    CHECK_HIP_ERROR(hipMalloc(&d_q, bytesQ));
+    CHECK_HIP_ERROR(hipMalloc(&d_kCache, bytesCache));
+    CHECK_HIP_ERROR(hipMalloc(&d_vCache, bytesCache));
+    CHECK_HIP_ERROR(hipMalloc(&d_kScales, bytesScales));
+    CHECK_HIP_ERROR(hipMalloc(&d_vScales, bytesScales));
+    CHECK_HIP_ERROR(hipMalloc(&d_blockTables, bytesTables));
+    CHECK_HIP_ERROR(hipMalloc(&d_seqLens, bytesLens));
+    CHECK_HIP_ERROR(hipMalloc(&d_partialO, slots * ROCWMMA_M * HEAD_DIM * sizeof(float32_t)));
+    CHECK_HIP_ERROR(hipMalloc(&d_partialMax, slots * ROCWMMA_M * sizeof(float32_t)));
+    CHECK_HIP_ERROR(hipMalloc(&d_partialSum, slots * ROCWMMA_M * sizeof(float32_t)));
+    CHECK_HIP_ERROR(hipMalloc(&d_o, bytesO));
+
+    CHECK_HIP_ERROR(hipMemcpy(d_q, q.data(), bytesQ, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_kCache, kCache.data(), bytesCache, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_vCache, vCache.data(), bytesCache, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_kScales, kScales.data(), bytesScales, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_vScales, vScales.data(), bytesScales, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(
+        hipMemcpy(d_blockTables, blockTables.data(), bytesTables, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_seqLens, seqLens.data(), bytesLens, hipMemcpyHostToDevice));
+
+    // Attention and reduction of one decode step, for the given chunk size
+    auto attention = [&](uint32_t chunkTokens) {
+        auto splits = rocwmma::ceilDiv(maxLen, chunkTokens);
+        hipExtLaunchKernelGGL(paged_attention_d<CacheT>,
+                              dim3(splits, NUM_KV_HEADS, batch),
+                              dim3(T_BLOCK_X),
+                              0, // sharedMemBytes
+                              0, // stream
+                              nullptr, // Event start
+                              nullptr, // event stop
+                              0, // flags
+                              numPages,
+                              maxPages,
+                              splits,
+                              chunkTokens,
+                              d_q,
+                              d_kCache,
+                              d_vCache,
+                              d_kScales,
+                              d_vScales,
+                              d_blockTables,
+                              d_seqLens,
+                              d_partialO,
+                              d_partialMax,
+                              d_partialSum,
+                              scale);
+        hipExtLaunchKernelGGL(paged_attention_reduce_d,
+                              dim3(NUM_Q_HEADS, batch),
+                              dim3(HEAD_DIM),
+                              0, // sharedMemBytes
+                              0, // stream
+                              nullptr, // Event start
+                              nullptr, // event stop
+                              0, // flags
+                              splits,
+                              chunkTokens,
+                              d_seqLens,
+                              d_partialO,
+                              d_partialMax,
+                              d_partialSum,
+                              d_o);
+    };
+
+    // Without split-K, one chunk spans the longest sequence
+    auto noSplitTokens = maxPages * PAGE_SIZE;
+    auto splitKernel   = [&]() { attention(CHUNK_TOKENS); };
+    auto noSplitKernel = [&]() { attention(noSplitTokens); };
+
+    // Runs are timed individually, with warm and cold caches
+    BenchmarkHarness harness;
+
+    // Minimum traffic: K and V of every cached token read once
+    auto bytesMoved = 2.0 * static_cast<double>(tokens) * NUM_KV_HEADS * HEAD_DIM
+                      * sizeof(CacheT);
+    auto peakGBs    = peakBandwidthGBs();
+
+    // Echo performance
+    auto echo = [&](const char* kernelName, auto&& kernel) {
+        for(auto cacheState :
+            {BenchmarkHarness::CacheState::Warm, BenchmarkHarness::CacheState::Cold})
+        {
+            auto stats  = harness.run(kernel, cacheState);
+            auto gBytes = bytesMoved / stats.mMedianMs * 1.0e-6;
+
+            std::cout << batchName << ", " << kernelName << ", "
+                      << rocwmma::dataTypeToString<CacheT>() << ", " << batch << ", " << maxLen
+                      << ", " << tokens << ", "
+                      << (cacheState == BenchmarkHarness::CacheState::Warm ? "warm" : "cold")
+                      << ", " << stats.mMedianMs << ", " << gBytes << ", "
+                      << 100.0 * gBytes / peakGBs << ", ";
+            BenchmarkHarness::printStats(std::cout, stats) << std::endl;
+        }
+    };
+
+#if !NDEBUG
+
+    // Setup and run reference computation
+    std::vector<float16_t> o_ref(o.size(), std::numeric_limits<float16_t>::signaling_NaN());
+    paged_attention_cpu_h(numPages,
+                          maxPages,
+                          q,
+                          kCache,
+                          vCache,
+                          kScales,
+                          vScales,
+                          blockTables,
+                          seqLens,
+                          o_ref,
+                          scale);
+
+    auto validate = [&]() {
+        std::cout << "Validating result with reference..." << std::endl;
+
+        // Bring kernel result back to host
+        CHECK_HIP_ERROR(hipMemcpy(o.data(), d_o, bytesO, hipMemcpyDeviceToHost));
+
+        auto res = compareEqual(o.data(), o_ref.data(), o.size());
+
+        if(std::get<0>(res) == false)
+        {
+            std::cout << "FAILED\n";
+        }
+        else
+        {
+            std::cout << "PASSED\n";
+        }
+
+        std::cout << "Max relative error: " << std::get<1>(res) << std::endl;
+    };
+
+#endif // !NDEBUG
+
+    echo("SplitK", splitKernel);
+
+#if !NDEBUG
+    validate();
+#endif // !NDEBUG
+
+    // Fill outputs with NaN to catch contamination
+    CHECK_HIP_ERROR(hipMemset(d_o, 0xFF, bytesO));
+
+    echo("NoSplit", noSplitKernel);
+
+#if !NDEBUG
+    validate();
+#endif // !NDEBUG
+
+    // Release device memory
+    CHECK_HIP_ERROR(hipFree(d_q));
+    CHECK_HIP_ERROR(hipFree(d_kCache));
+    CHECK_HIP_ERROR(hipFree(d_vCache));
+    CHECK_HIP_ERROR(hipFree(d_kScales));
+    CHECK_HIP_ERROR(hipFree(d_vScales));
+    CHECK_HIP_ERROR(hipFree(d_blockTables));
+    CHECK_HIP_ERROR(hipFree(d_seqLens));
+    CHECK_HIP_ERROR(hipFree(d_partialO));
+    CHECK_HIP_ERROR(hipFree(d_partialMax));
+    CHECK_HIP_ERROR(hipFree(d_partialSum));
+    CHECK_HIP_ERROR(hipFree(d_o));
+}
+
+int main()
+{
+    std::cout << "Batch, Kernel, KvCache, Sequences, MaxLen, Tokens, "
+              << "Cache, elapsedMs, GB/s, %Peak, " << BenchmarkHarness::statsHeader()
+              << std::endl;
+
+    // Uniformly distributed lengths in [1, maxLen]
+    auto mixedLens = [](uint32_t batch, uint32_t maxLen) {
+        std::mt19937         gen(maxLen);
+        std::vector<int32_t> lens(batch);
+        std::generate(lens.begin(), lens.end(), [&]() {
+            return static_cast<int32_t>(gen() % maxLen + 1u);
+        });
+        return lens;
+    };
+
+    // Single long sequences, and batches of mixed lengths
+    paged_attention_test<float16_t>("single_32k", {32768});
+    paged_attention_test<float16_t>("batch4_8k", {8192, 8192, 8192, 8192});
+    paged_attention_test<float16_t>("mixed16_4k", mixedLens(16u, 4096u));
+    paged_attention_test<float16_t>("mixed64_2k", mixedLens(64u, 2048u));
+    paged_attention_test<float16_t>("mixed256_1k", mixedLens(256u, 1024u));
+
+    // Quantized KV caches with per-page scales, at half the K / V traffic
+    paged_attention_test<float8_t>("batch4_8k", {8192, 8192, 8192, 8192});
+    paged_attention_test<float8_t>("mixed64_2k", mixedLens(64u, 2048u));
+    paged_attention_test<int8_t>("batch4_8k", {8192, 8192, 8192, 8192});
+    paged_attention_test<int8_t>("mixed64_2k", mixedLens(64u, 2048u));
+
+    std::cout << "Finished!" << std::endl;
+    return 0;
+}
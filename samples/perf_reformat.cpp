@@ -0,0 +1,205 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include <hip/hip_fp16.h>
+#include <hip/hip_runtime.h>
+
+#include <rocwmma/rocwmma.hpp>
+#include <rocwmma/rocwmma_reformat.hpp>
+
+#include "benchmark_harness.hpp"
+#include "common.hpp"
+
+using namespace rocwmma;
+
+/* Motivation
+*
+* Layout conversions, such as transposing weights or activations between row major and
+* col major, are pure data movement and should run at the memory bandwidth of the device.
+* Elementwise transposes read or write one side with a stride per element, and reach a
+* fraction of it.
+*
+* reformat_matrix converts through fragments: each wave loads a tile of blocks vectorized
+* along the source layout, changes the layout of the fragments in registers with
+* applyDataLayout, and stores them vectorized along the destination layout.
+*
+* This sample reports the bandwidth of the conversions of each element size, and of a
+* batch of small matrices, as a fraction of the peak memory bandwidth of the device.
+* The row major to row major copy is the baseline of the same kernel without a layout
+* change. Debug builds validate each conversion.
+*/
+
+// Bytes of each source matrix, and rows of the large matrices
+constexpr size_t   MATRIX_BYTES = 256ull << 20;
+constexpr uint32_t MATRIX_ROWS  = 8192u;
+
+// Peak memory bandwidth in GB/s, from the memory clock and bus width (double data rate)
+__host__ double peakBandwidth()
+{
+    hipDevice_t     handle;
+    hipDeviceProp_t props;
+    CHECK_HIP_ERROR(hipGetDevice(&handle));
+    CHECK_HIP_ERROR(hipGetDeviceProperties(&props, handle));
+    return 2.0 * props.memoryClockRate * 1.0e3 * (props.memoryBusWidth / 8.0) * 1.0e-9;
+}
+
+__host__ char const* layoutString(layout_t layout)
+{
+    return layout == mem_row_major ? "R" : "C";
+}
+
+// Host reference of one conversion, on the bits of the elements
+template <typename DataT>
+__host__ bool validateReformat(std::vector<DataT> const& src,
+                               std::vector<DataT> const& dst,
+                               layout_t                  srcLayout,
+                               layout_t                  dstLayout,
+                               uint32_t                  rows,
+                               uint32_t                  cols,
+                               uint32_t                  batchCount)
+{
+    auto index = [rows, cols](layout_t layout, uint32_t row, uint32_t col) {
+        return layout == mem_row_major ? static_cast<size_t>(row) * cols + col
+                                       : static_cast<size_t>(col) * rows + row;
+    };
+
+    auto matrixSize = static_cast<size_t>(rows) * cols;
+    for(uint32_t b = 0; b < batchCount; b++)
+    {
+        for(uint32_t row = 0; row < rows; row++)
+        {
+            for(uint32_t col = 0; col < cols; col++)
+            {
+                auto s = b * matrixSize + index(srcLayout, row, col);
+                auto d = b * matrixSize + index(dstLayout, row, col);
+                if(std::memcmp(&src[s], &dst[d], sizeof(DataT)) != 0)
+                {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+template <typename DataT>
+__host__ void reformat_test(
+    layout_t srcLayout, layout_t dstLayout, uint32_t rows, uint32_t cols, uint32_t batchCount)
+{
+    const size_t size  = static_cast<size_t>(rows) * cols * batchCount;
+    const size_t bytes = size * sizeof(DataT);
+
+    std::vector<DataT> src(size);
+    fillRand(src.data(), rows * batchCount, cols);
+
+    DataT *d_src, *d_dst;
+    CHECK_HIP_ERROR(hipMalloc(&d_src, bytes));
+    CHECK_HIP_ERROR(hipMalloc(&d_dst, bytes));
+    CHECK_HIP_ERROR(hipMemcpy(d_src, src.data(), bytes, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemset(d_dst, 0, bytes));
+
+    // Packed matrices
+    auto lds    = srcLayout == mem_row_major ? cols : rows;
+    auto ldd    = dstLayout == mem_row_major ? cols : rows;
+    auto stride = static_cast<uint64_t>(rows) * cols;
+
+    auto kernel = [&]() {
+        CHECK_HIP_ERROR(reformat_matrix(srcLayout,
+                                        d_src,
+                                        lds,
+                                        stride,
+                                        dstLayout,
+                                        d_dst,
+                                        ldd,
+                                        stride,
+                                        rows,
+                                        cols,
+                                        batchCount));
+    };
+
+    static const double peakGBytesPerSec = peakBandwidth();
+
+    // Runs are timed individually, with warm and cold caches
+    BenchmarkHarness harness;
+
+    for(auto cacheState : {BenchmarkHarness::CacheState::Warm, BenchmarkHarness::CacheState::Cold})
+    {
+        auto stats = harness.run(kernel, cacheState);
+
+        // Read and write of every element
+        auto gBytesPerSec = 2.0 * bytes / stats.mMedianMs * 1.0e-6;
+
+        std::cout << dataTypeToString<DataT>() << ", " << layoutString(srcLayout) << ", "
+                  << layoutString(dstLayout) << ", " << rows << ", " << cols << ", "
+                  << batchCount << ", "
+                  << (cacheState == BenchmarkHarness::CacheState::Warm ? "warm" : "cold")
+                  << ", " << stats.mMedianMs << ", " << gBytesPerSec << ", "
+                  << 100.0 * gBytesPerSec / peakGBytesPerSec << ", ";
+        BenchmarkHarness::printStats(std::cout, stats) << std::endl;
+    }
+
+#if !NDEBUG
+    std::vector<DataT> dst(size);
+    CHECK_HIP_ERROR(hipMemcpy(dst.data(), d_dst, bytes, hipMemcpyDeviceToHost));
+
+    if(!validateReformat(src, dst, srcLayout, dstLayout, rows, cols, batchCount))
+    {
+        std::cout << "Validation FAILED" << std::endl;
+    }
+#endif // !NDEBUG
+
+    CHECK_HIP_ERROR(hipFree(d_src));
+    CHECK_HIP_ERROR(hipFree(d_dst));
+}
+
+template <typename DataT>
+__host__ void reformat_test_layouts()
+{
+    auto cols = static_cast<uint32_t>(MATRIX_BYTES / sizeof(DataT) / MATRIX_ROWS);
+
+    reformat_test<DataT>(mem_row_major, mem_row_major, MATRIX_ROWS, cols, 1u);
+    reformat_test<DataT>(mem_row_major, mem_col_major, MATRIX_ROWS, cols, 1u);
+    reformat_test<DataT>(mem_col_major, mem_row_major, MATRIX_ROWS, cols, 1u);
+
+    // Batch of small matrices with edge tiles
+    auto batchCount = static_cast<uint32_t>(MATRIX_BYTES / sizeof(DataT) / (200u * 328u));
+    reformat_test<DataT>(mem_row_major, mem_col_major, 200u, 328u, batchCount);
+}
+
+int main()
+{
+    std::cout << "DataT, Src, Dst, Rows, Cols, Batch, Cache, elapsedMs, Bandwidth(GB/s), "
+              << "PeakPct, " << BenchmarkHarness::statsHeader() << std::endl;
+
+    reformat_test_layouts<int8_t>();
+    reformat_test_layouts<float16_t>();
+    reformat_test_layouts<float32_t>();
+    reformat_test_layouts<float64_t>();
+    return 0;
+}
@@ -0,0 +1,670 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_fp16.h>
+#include <hip/hip_runtime.h>
+
+#include <rocwmma/rocwmma.hpp>
+#include <rocwmma/rocwmma_coop.hpp>
+#include <rocwmma/rocwmma_tile.hpp>
+#include <rocwmma/rocwmma_transforms.hpp>
+
+#include "benchmark_harness.hpp"
+#include "common.hpp"
+
+/* Motivation
+*
+* Many callers hold A and B in float32_t, but want the mma throughput of a 16-bit type.
+* The usual approach runs a conversion kernel first, which writes a converted copy of each
+* operand to global memory and reads it back:
+*
+*   A, B (fp32) -> convert -> A', B' (fp16 / bf16) -> GEMM -> D
+*
+* This sample is the LDS pipelined GEMM of perf_sgemm, with the conversion fused into the
+* global to LDS staging. Global reads of A and B use load_matrix_coop_convert_sync, which
+* reads float32_t data with the layout of StageT fragments, and converts each vector to
+* StageT in registers with the packed conversion instructions of the target:
+*
+*   Global A, B (fp32) -> GR buffers (StageT, registers) -> LDS (StageT) -> mma (StageT)
+*
+* The converted operands only ever exist in registers and LDS, so compared to a separate
+* conversion pass, the GEMM saves a full write and read of A' and B' in global memory.
+* Staging in StageT also halves the LDS footprint and LDS traffic of perf_sgemm.
+*
+* Products accumulate in float32_t. The benchmark runs the kernel for float16_t and
+* bfloat16_t staging. Validation compares with a host GEMM of the inputs rounded to StageT.
+*
+* Note: load_matrix_coop_convert_sync also converts float32_t to float8_t and bfloat8_t,
+* for targets with float8_t mma.
+*/
+
+using namespace rocwmma;
+
+///
+/// Parameter configuration
+///
+
+// Types
+using InputT   = float32_t;
+using OutputT  = float32_t;
+using ComputeT = float32_t;
+
+using DataLayoutA   = col_major;
+using DataLayoutB   = row_major;
+using DataLayoutC   = row_major;
+using DataLayoutLds = col_major;
+
+// Block sizes
+constexpr uint32_t ROCWMMA_M = 32u;
+constexpr uint32_t ROCWMMA_N = 32u;
+constexpr uint32_t ROCWMMA_K = 16u;
+
+// Warp size
+constexpr uint32_t WARP_SIZE = Constants::AMDGCN_WAVE_SIZE;
+
+// Warp tile: computed by each warp
+constexpr uint32_t BLOCKS_X    = 2u;
+constexpr uint32_t BLOCKS_Y    = 2u;
+constexpr uint32_t WARP_TILE_X = BLOCKS_X * ROCWMMA_M;
+constexpr uint32_t WARP_TILE_Y = BLOCKS_Y * ROCWMMA_N;
+
+// Macro Tile: computed by each thread block (workgroup)
+// Note: TBLOCK_X must be multiple of WARP_SIZE.
+constexpr uint32_t TBLOCK_X     = 128u;
+constexpr uint32_t TBLOCK_Y     = 2u;
+constexpr uint32_t WARPS_X      = TBLOCK_X / WARP_SIZE;
+constexpr uint32_t WARPS_Y      = TBLOCK_Y;
+constexpr uint32_t MACRO_TILE_X = WARPS_X * WARP_TILE_X;
+constexpr uint32_t MACRO_TILE_Y = WARPS_Y * WARP_TILE_Y;
+
+///
+/// Fragment types, for operands staged and multiplied in StageT
+///
+
+// Mfma frags
+template <typename StageT>
+using MfmaFragA = fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, StageT, DataLayoutA>;
+template <typename StageT>
+using MfmaFragB   = fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, StageT, DataLayoutB>;
+using MfmaFragC   = fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, OutputT, DataLayoutC>;
+using MfmaFragD   = MfmaFragC;
+using MfmaFragAcc = fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, ComputeT>;
+
+// Warp tile of mfma frags
+template <typename StageT>
+using MfmaTileA = fragment_array<MfmaFragA<StageT>, BLOCKS_X, 1u>;
+template <typename StageT>
+using MfmaTileB   = fragment_array<MfmaFragB<StageT>, 1u, BLOCKS_Y>;
+using MfmaTileC   = fragment_array<MfmaFragC, BLOCKS_X, BLOCKS_Y>;
+using MfmaTileD   = MfmaTileC;
+using MfmaTileAcc = fragment_array<MfmaFragAcc, BLOCKS_X, BLOCKS_Y>;
+
+// Global read (macro tile), converted to StageT as it is read
+template <typename StageT>
+using GRBuffA = fragment<matrix_a, MACRO_TILE_X, ROCWMMA_N, ROCWMMA_K, StageT, DataLayoutA>;
+template <typename StageT>
+using GRBuffB = fragment<matrix_b, ROCWMMA_M, MACRO_TILE_Y, ROCWMMA_K, StageT, DataLayoutB>;
+
+// Local write of global buffers (macro tile)
+// - Must match Lds data layout.
+// - Lds has transposed B frags.
+template <typename StageT>
+using LWBuffA = ApplyDataLayout_t<GRBuffA<StageT>, DataLayoutLds>;
+template <typename StageT>
+using LWBuffB = ApplyDataLayout_t<ApplyTranspose_t<GRBuffB<StageT>>, DataLayoutLds>;
+
+// Local read (mfma frags)
+// - Must match Lds data layout.
+// - Lds has transposed B frags.
+template <typename StageT>
+using LRFragA = ApplyDataLayout_t<MfmaFragA<StageT>, DataLayoutLds>;
+template <typename StageT>
+using LRFragB = ApplyDataLayout_t<ApplyTranspose_t<MfmaFragB<StageT>>, DataLayoutLds>;
+
+///
+/// Wrapper functions: repeat mfma tile operations across entire warp tile.
+///
+
+// Global A reads in cooperative mode (macro tile), converted to StageT in registers
+template <uint32_t WaveCountA, typename StageT>
+ROCWMMA_DEVICE static inline void globalReadCoopA(GRBuffA<StageT>& grBuffA,
+                                                  InputT const*    gAddrA,
+                                                  uint32_t         lda,
+                                                  uint32_t         waveIndexA)
+{
+    load_matrix_coop_convert_sync<WaveCountA>(grBuffA, gAddrA, lda, waveIndexA);
+}
+
+// Global B reads in cooperative mode (macro tile), converted to StageT in registers
+template <uint32_t WaveCountB, typename StageT>
+ROCWMMA_DEVICE static inline void globalReadCoopB(GRBuffB<StageT>& grBuffB,
+                                                  InputT const*    gAddrB,
+                                                  uint32_t         ldb,
+                                                  uint32_t         waveIndexB)
+{
+    load_matrix_coop_convert_sync<WaveCountB>(grBuffB, gAddrB, ldb, waveIndexB);
+}
+
+// Local A writes in cooperative mode (macro tile)
+template <uint32_t WaveCountA, typename StageT>
+ROCWMMA_DEVICE static inline void localWriteCoopA(StageT*                ldsAddr,
+                                                  GRBuffA<StageT> const& grBuffA,
+                                                  uint32_t               ldsld,
+                                                  uint32_t               waveIndexA)
+{
+    // No transpose, but apply the lds data layout
+    store_matrix_coop_sync<WaveCountA>(
+        ldsAddr, applyDataLayout<DataLayoutLds, WaveCountA>(grBuffA), ldsld, waveIndexA);
+}
+
+// Local B writes in cooperative mode (macro tile)
+template <uint32_t WaveCountB, typename StageT>
+ROCWMMA_DEVICE static inline void localWriteCoopB(StageT*                ldsAddr,
+                                                  GRBuffB<StageT> const& grBuffB,
+                                                  uint32_t               ldsld,
+                                                  uint32_t               waveIndexB)
+{
+    // Transpose B and then apply lds data layout
+    store_matrix_coop_sync<WaveCountB>(ldsAddr,
+                                       applyDataLayout<DataLayoutLds, WaveCountB>(
+                                           applyTranspose(grBuffB)),
+                                       ldsld,
+                                       waveIndexB);
+}
+
+// Local A reads for warp tile gemm, non-cooperative
+template <typename StageT>
+ROCWMMA_DEVICE static inline void
+    localReadA(MfmaTileA<StageT>& fragsA, StageT const* ldsAddrA, uint32_t ldsld)
+{
+    using FragShape = GetIOShape_t<LRFragA<StageT>>;
+    using Mapper1d  = GetDataLayout_t<LRFragA<StageT>>;
+
+    // Each A block is stacked vertically in LDS
+    auto blockStep = Mapper1d::fromMatrixCoord(make_coord2d(FragShape::BlockHeight, 0u), ldsld);
+
+#pragma unroll
+    for(int i = 0; i < BLOCKS_X; i++)
+    {
+        LRFragA<StageT> tmp;
+        load_matrix_sync(tmp, ldsAddrA, ldsld);
+        fragsA(i, 0u) = applyDataLayout<DataLayoutA>(tmp);
+
+        ldsAddrA += blockStep;
+    }
+}
+
+// Local B reads for warp tile gemm, non-cooperative
+template <typename StageT>
+ROCWMMA_DEVICE static inline void
+    localReadB(MfmaTileB<StageT>& fragsB, StageT const* ldsAddrB, uint32_t ldsld)
+{
+    using FragShape = GetIOShape_t<LRFragB<StageT>>;
+    using Mapper1d  = GetDataLayout_t<LRFragB<StageT>>;
+
+    // Each B block is stacked vertically in LDS
+    auto blockStep = Mapper1d::fromMatrixCoord(make_coord2d(FragShape::BlockHeight, 0u), ldsld);
+
+#pragma unroll
+    for(int i = 0; i < BLOCKS_Y; i++)
+    {
+        LRFragB<StageT> tmp;
+        load_matrix_sync(tmp, ldsAddrB, ldsld);
+
+        // Transform back to MFMA tile
+        fragsB(0u, i) = applyDataLayout<DataLayoutB>(applyTranspose(tmp));
+
+        ldsAddrB += blockStep;
+    }
+}
+
+// Uniform multiply - add (FMA)
+// Performs D = alpha * acc + beta * C, where alpha, beta are uniform scalars
+ROCWMMA_DEVICE static inline void uniformFma(MfmaTileD&         fragsD,
+                                             ComputeT           alpha,
+                                             MfmaTileAcc const& fragsAcc,
+                                             ComputeT           beta,
+                                             MfmaTileC const&   fragsC)
+{
+#pragma unroll
+    for(int i = 0; i < BLOCKS_X; i++)
+    {
+#pragma unroll
+        for(int j = 0; j < BLOCKS_Y; j++)
+        {
+            for(int k = 0; k < fragsD(i, j).num_elements; k++)
+            {
+                fragsD(i, j).x[k] = alpha * fragsAcc(i, j).x[k] + beta * fragsC(i, j).x[k];
+            }
+        }
+    }
+}
+
+template <typename StageT>
+ROCWMMA_KERNEL void __launch_bounds__(256) gemm_rocwmma_d(uint32_t       m,
+                                                          uint32_t       n,
+                                                          uint32_t       k,
+                                                          InputT const*  a,
+                                                          InputT const*  b,
+                                                          OutputT const* c,
+                                                          OutputT*       d,
+                                                          uint32_t       lda,
+                                                          uint32_t       ldb,
+                                                          uint32_t       ldc,
+                                                          uint32_t       ldd,
+                                                          ComputeT       alpha,
+                                                          ComputeT       beta)
+{
+    ///
+    /// 2D matrix coordinate setup
+    ///
+
+    // Tile Sizes
+    constexpr auto warpTileSize  = make_coord2d(WARP_TILE_X, WARP_TILE_Y);
+    constexpr auto macroTileSize = make_coord2d(MACRO_TILE_X, MACRO_TILE_Y);
+
+    // Local warp coordinate relative to current threadblock (wg).
+    constexpr auto warpDims        = make_coord2d(WARPS_X, WARPS_Y);
+    auto           localWarpCoord  = make_coord2d(threadIdx.x / WARP_SIZE, threadIdx.y);
+    auto           localWarpOffset = localWarpCoord * warpTileSize;
+
+    // Global matrix coordinates for C/D
+    auto macroTileCoord = make_coord2d(blockIdx.x, blockIdx.y) * macroTileSize;
+    auto warpTileCoord  = macroTileCoord + localWarpOffset;
+
+    // Bounds check
+    auto warpTileBound = warpTileCoord + warpTileSize;
+    if(get<0>(warpTileBound) > m || get<1>(warpTileBound) > n)
+    {
+        return;
+    }
+
+    ///
+    /// 1D global read coordinate setup, in float32_t elements
+    ///
+    using GRBuffAMap1d = GetDataLayout_t<GRBuffA<StageT>>;
+    using GRBuffBMap1d = GetDataLayout_t<GRBuffB<StageT>>;
+
+    // Initial global read address offsets
+    auto globalReadOffsetA
+        = GRBuffAMap1d::fromMatrixCoord(make_coord2d(get<0>(macroTileCoord), 0u), lda);
+    auto globalReadOffsetB
+        = GRBuffBMap1d::fromMatrixCoord(make_coord2d(0u, get<1>(macroTileCoord)), ldb);
+
+    // Incremental global read address offsets
+    auto kStepOffsetA = GRBuffAMap1d::fromMatrixCoord(make_coord2d(0u, ROCWMMA_K), lda);
+    auto kStepOffsetB = GRBuffBMap1d::fromMatrixCoord(make_coord2d(ROCWMMA_K, 0u), ldb);
+
+    ///
+    /// Cooperative config for global read A / B
+    ///
+
+    // Scheduling warp order is analogous to row major priority.
+    constexpr auto warpCount = get<0>(warpDims) * get<1>(warpDims);
+    const auto warpIndex = get<0>(localWarpCoord) * get<1>(warpDims) + get<1>(localWarpCoord);
+
+    ///
+    /// Perform initial global pre-fetch
+    ///
+
+    GRBuffA<StageT> grBuffA;
+    GRBuffB<StageT> grBuffB;
+
+    globalReadCoopA<warpCount>(grBuffA, a + globalReadOffsetA, lda, warpIndex);
+    globalReadCoopB<warpCount>(grBuffB, b + globalReadOffsetB, ldb, warpIndex);
+
+    globalReadOffsetA += kStepOffsetA;
+    globalReadOffsetB += kStepOffsetB;
+
+    ///
+    /// Setup LDS addressing, in StageT elements
+    /// This kernel will use 2 separate LDS blocks for pipelining
+    /// the input prefetching during the accumulation loop
+    ///
+
+    HIP_DYNAMIC_SHARED(void*, localMemPtr);
+    using LWBuffAShape = GetIOShape_t<LWBuffA<StageT>>;
+    using LWBuffBShape = GetIOShape_t<LWBuffB<StageT>>;
+    using LWBuffAMap1d = GetDataLayout_t<LWBuffA<StageT>>;
+    using LWBuffBMap1d = GetDataLayout_t<LWBuffB<StageT>>;
+
+    constexpr uint32_t ldsWidth  = ROCWMMA_K;
+    constexpr uint32_t ldsHeight = LWBuffAShape::BlockHeight + LWBuffBShape::BlockHeight;
+    constexpr uint32_t sizeLds   = ldsHeight * ldsWidth;
+    constexpr uint32_t ldsld     = std::is_same_v<DataLayoutLds, row_major> ? ldsWidth : ldsHeight;
+
+    auto* ldsPtrLo = reinterpret_cast<StageT*>(localMemPtr);
+    auto* ldsPtrHi = ldsPtrLo + sizeLds;
+
+    // Local write offsets to start of A / B data
+    auto ldsWriteOffsetA = 0u;
+    auto ldsWriteOffsetB
+        = LWBuffAMap1d::fromMatrixCoord(make_coord2d(LWBuffAShape::BlockHeight, 0u), ldsld);
+
+    // Local read offsets for mfma frags
+    auto ldsReadOffsetA
+        = ldsWriteOffsetA
+          + LWBuffAMap1d::fromMatrixCoord(make_coord2d(get<0>(localWarpOffset), 0u), ldsld);
+    auto ldsReadOffsetB
+        = ldsWriteOffsetB
+          + LWBuffBMap1d::fromMatrixCoord(make_coord2d(get<1>(localWarpOffset), 0u), ldsld);
+
+    ///
+    /// Write prefetch to local
+    ///
+    localWriteCoopA<warpCount>(ldsPtrLo + ldsWriteOffsetA, grBuffA, ldsld, warpIndex);
+    localWriteCoopB<warpCount>(ldsPtrLo + ldsWriteOffsetB, grBuffB, ldsld, warpIndex);
+
+    ///
+    /// Initialize accumulation frags
+    ///
+    MfmaTileAcc fragsAcc;
+    fill_fragment(fragsAcc, 0.0f);
+
+    ///
+    /// Synchronize warps and memory
+    ///
+    synchronize_workgroup();
+
+    ///
+    /// Accumulate A * B for all mfma frags in warp tile
+    ///
+    for(auto currentK = ROCWMMA_K; currentK < k; currentK += ROCWMMA_K)
+    {
+        MfmaTileA<StageT> fragsA;
+        MfmaTileB<StageT> fragsB;
+
+        // Local read mfma frags from first LDS buffer
+        localReadA(fragsA, ldsPtrLo + ldsReadOffsetA, ldsld);
+        localReadB(fragsB, ldsPtrLo + ldsReadOffsetB, ldsld);
+
+        // Prefetch and convert next round of global frags
+        globalReadCoopA<warpCount>(grBuffA, a + globalReadOffsetA, lda, warpIndex);
+        globalReadCoopB<warpCount>(grBuffB, b + globalReadOffsetB, ldb, warpIndex);
+
+        // Advance offsets to next k step
+        globalReadOffsetA += kStepOffsetA;
+        globalReadOffsetB += kStepOffsetB;
+
+        // accum(A * B)
+        mma_sync(fragsAcc, fragsA, fragsB, fragsAcc);
+
+        // Write prefetch to second LDS buffer
+        localWriteCoopA<warpCount>(ldsPtrHi + ldsWriteOffsetA, grBuffA, ldsld, warpIndex);
+        localWriteCoopB<warpCount>(ldsPtrHi + ldsWriteOffsetB, grBuffB, ldsld, warpIndex);
+
+        // Make sure that all waves have finished reading / writing to lds for currentK.
+        synchronize_workgroup();
+
+        // Swap Lds buffers
+        auto* tmp = ldsPtrLo;
+        ldsPtrLo  = ldsPtrHi;
+        ldsPtrHi  = tmp;
+    }
+
+    ///
+    /// Start loading C
+    ///
+    using MfmaFragCMap1d = GetDataLayout_t<MfmaFragC>;
+    using MfmaFragDMap1d = GetDataLayout_t<MfmaFragD>;
+
+    MfmaTileC fragsC;
+    load_matrix_sync(fragsC, c + MfmaFragCMap1d::fromMatrixCoord(warpTileCoord, ldc), ldc);
+
+    ///
+    /// Clean up tail A * B
+    ///
+    MfmaTileA<StageT> fragsA;
+    MfmaTileB<StageT> fragsB;
+
+    // Local read mfma frags
+    localReadA(fragsA, ldsPtrLo + ldsReadOffsetA, ldsld);
+    localReadB(fragsB, ldsPtrLo + ldsReadOffsetB, ldsld);
+    mma_sync(fragsAcc, fragsA, fragsB, fragsAcc);
+
+    ///
+    /// D = alpha * accum + beta * C
+    ///
+    MfmaTileD fragsD;
+    uniformFma(fragsD, alpha, fragsAcc, beta, fragsC);
+    store_matrix_sync(d + MfmaFragDMap1d::fromMatrixCoord(warpTileCoord, ldd), fragsD, ldd);
+}
+
+template <typename StageT>
+ROCWMMA_HOST void gemm_test(uint32_t m, uint32_t n, uint32_t k, ComputeT alpha, ComputeT beta)
+{
+    // Runtime warp calculation (host code needs to query warpsize dynamically)
+    auto warpSize = getWarpSize();
+    auto macroTileSize
+        = rocwmma::make_coord2d(TBLOCK_X / warpSize * WARP_TILE_X, TBLOCK_Y * WARP_TILE_Y);
+
+    // Device check for supported block and wave sizes
+    if(isGfx11())
+    {
+        std::cout << "Unsupported architecture!\n";
+        return;
+    }
+
+    if(isGfx9() && (ROCWMMA_M != ROCWMMA_N) || (ROCWMMA_M != 16 && ROCWMMA_M != 32))
+    {
+        std::cout << "Unsupported block size!\n";
+        return;
+    }
+
+    if(isGfx9() && WARP_SIZE != Constants::AMDGCN_WAVE_SIZE_64)
+    {
+        std::cout << "Unsupported wave size!\n";
+        return;
+    }
+
+    // Bounds check
+    if((m < get<0>(macroTileSize) || n < get<1>(macroTileSize) || k < ROCWMMA_K)
+       || (m % ROCWMMA_M || n % ROCWMMA_N || k % ROCWMMA_K))
+    {
+        std::cout << "Unsupported matrix size!\n";
+        return;
+    }
+
+    // Layouts leading dims
+    int lda = std::is_same_v<DataLayoutA, row_major> ? k : m;
+    int ldb = std::is_same_v<DataLayoutB, row_major> ? n : k;
+    int ldc = std::is_same_v<DataLayoutC, row_major> ? n : m;
+    int ldd = ldc;
+
+    std::cout << "Initializing host data..." << std::endl;
+
+    // Initialize input matrices
+    std::vector<InputT>  matrixA(m * k);
+    std::vector<InputT>  matrixB(k * n);
+    std::vector<OutputT> matrixC(m * n);
+    // Fill outputs with NaN to catch contamination
+    std::vector<OutputT> matrixD(m * n, std::numeric_limits<OutputT>::signaling_NaN());
+
+    fillRand(matrixA.data(), m, k);
+    fillRand(matrixB.data(), k, n);
+    fillRand(matrixC.data(), m, n);
+
+    std::cout << "Initializing device data..." << std::endl;
+
+    // Allocate and copy device memory
+    InputT*  d_a;
+    InputT*  d_b;
+    OutputT* d_c;
+    OutputT* d_d;
+
+    const size_t bytesA = matrixA.size() * sizeof(InputT);
+    const size_t bytesB = matrixB.size() * sizeof(InputT);
+    const size_t bytesC = matrixC.size() * sizeof(OutputT);
+    const size_t bytesD = matrixD.size() * sizeof(OutputT);
+
+    CHECK_HIP_ERROR(hipMalloc(&d_a, bytesA));
+    CHECK_HIP_ERROR(hipMalloc(&d_b, bytesB));
+    CHECK_HIP_ERROR(hipMalloc(&d_c, bytesC));
+    CHECK_HIP_ERROR(hipMalloc(&d_d, bytesD));
+
+    CHECK_HIP_ERROR(hipMemcpy(d_a, matrixA.data(), bytesA, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_b, matrixB.data(), bytesB, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_c, matrixC.data(), bytesC, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_d, matrixD.data(), bytesD, hipMemcpyHostToDevice));
+
+    auto blockDim = dim3(TBLOCK_X, TBLOCK_Y);
+    auto gridDim  = dim3(rocwmma::ceilDiv(m, get<0>(macroTileSize)),
+                        rocwmma::ceilDiv(n, get<1>(macroTileSize)));
+
+    std::cout << "Launching GEMM kernel with " << dataTypeToString<StageT>() << " staging..."
+              << std::endl;
+    std::cout << "gridDim (" << gridDim.x << " " << gridDim.y << ")"
+              << " blockdim (" << blockDim.x << " " << blockDim.y << ")" << std::endl;
+
+    // Uses 2 lds blocks for prefetch loop (A and B), in StageT
+    int ldsusage
+        = 2u * sizeof(StageT) * (get<0>(macroTileSize) + get<1>(macroTileSize)) * ROCWMMA_K;
+
+    auto rocwmmaKernel = [&]() {
+        hipExtLaunchKernelGGL(gemm_rocwmma_d<StageT>,
+                              gridDim,
+                              blockDim,
+                              ldsusage,
+                              0,
+                              nullptr,
+                              nullptr,
+                              0,
+                              m,
+                              n,
+                              k,
+                              d_a,
+                              d_b,
+                              d_c,
+                              d_d,
+                              lda,
+                              ldb,
+                              ldc,
+                              ldd,
+                              alpha,
+                              beta);
+    };
+
+    // Runs are timed individually, with warm and cold caches
+    BenchmarkHarness harness;
+
+    auto gFlops = calculateGFlops(m, n, k);
+
+    // Echo performance
+    std::cout << "StageT, TBlockX, TBlockY, "
+              << "BlocksX, BlocksY, "
+              << "BlkM, BlkN, BlkK, "
+              << "MatM, MatN, MatK, "
+              << "alpha, lda, ldb, "
+              << "beta, ldc, ldd, "
+              << "Cache, elapsedMs, Problem Size(GFlops), TFlops/s, "
+              << BenchmarkHarness::statsHeader() << std::endl;
+
+    for(auto cacheState : {BenchmarkHarness::CacheState::Warm, BenchmarkHarness::CacheState::Cold})
+    {
+        auto stats        = harness.run(rocwmmaKernel, cacheState);
+        auto tFlopsPerSec = calculateTFlopsPerSec(m, n, k, stats.mMedianMs);
+
+        std::cout << dataTypeToString<StageT>() << ", " << TBLOCK_X << ", " << TBLOCK_Y << ", "
+                  << BLOCKS_X << ", " << BLOCKS_Y << ", " << ROCWMMA_M << ", " << ROCWMMA_N
+                  << ", " << ROCWMMA_K << ", " << m << ", " << n << ", " << k << ", " << alpha
+                  << ", " << lda << ", " << ldb << ", " << beta << ", " << ldc << ", " << ldd
+                  << ", " << (cacheState == BenchmarkHarness::CacheState::Warm ? "warm" : "cold")
+                  << ", " << stats.mMedianMs << ", " << gFlops << ", " << tFlopsPerSec << ", ";
+        BenchmarkHarness::printStats(std::cout, stats) << std::endl;
+    }
+
+#if !NDEBUG
+
+    std::cout << "Validating result with reference..." << std::endl;
+
+    if((uint64_t)m * (uint64_t)n * (uint64_t)k > (2048ull * 2048ull * 2048ull))
+    {
+        std::cout << "Please wait. Large sizes can take a while!" << std::endl;
+    }
+
+    // Bring kernel result back to host
+    CHECK_HIP_ERROR(hipMemcpy(matrixD.data(), d_d, bytesD, hipMemcpyDeviceToHost));
+
+    // The reference multiplies the inputs rounded to StageT, as the kernel does
+    std::vector<StageT> matrixA_s(matrixA.size());
+    std::vector<StageT> matrixB_s(matrixB.size());
+    std::transform(matrixA.begin(), matrixA.end(), matrixA_s.begin(), [](InputT v) {
+        return static_cast<StageT>(v);
+    });
+    std::transform(matrixB.begin(), matrixB.end(), matrixB_s.begin(), [](InputT v) {
+        return static_cast<StageT>(v);
+    });
+
+    // Setup and run reference computation
+    std::vector<OutputT> matrixD_ref(m * n, std::numeric_limits<OutputT>::signaling_NaN());
+    gemm_cpu_h<StageT, OutputT, ComputeT, DataLayoutA, DataLayoutB, DataLayoutC>(m,
+                                                                                 n,
+                                                                                 k,
+                                                                                 matrixA_s.data(),
+                                                                                 matrixB_s.data(),
+                                                                                 matrixC.data(),
+                                                                                 matrixD_ref.data(),
+                                                                                 lda,
+                                                                                 ldb,
+                                                                                 ldc,
+                                                                                 ldd,
+                                                                                 alpha,
+                                                                                 beta);
+
+    auto res = compareEqual(matrixD.data(), matrixD_ref.data(), m * n);
+
+    if(std::get<0>(res) == false)
+    {
+        std::cout << "FAILED\n";
+    }
+    else
+    {
+        std::cout << "PASSED\n";
+    }
+
+    std::cout << "Max relative error: " << std::get<1>(res) << std::endl;
+
+#endif // !NDEBUG
+
+    // Release device memory
+    CHECK_HIP_ERROR(hipFree(d_a));
+    CHECK_HIP_ERROR(hipFree(d_b));
+    CHECK_HIP_ERROR(hipFree(d_c));
+    CHECK_HIP_ERROR(hipFree(d_d));
+
+    std::cout << "Finished!" << std::endl;
+}
+
+int main()
+{
+    gemm_test<float16_t>(7168, 7168, 7168, 2, 2);
+    gemm_test<bfloat16_t>(7168, 7168, 7168, 2, 2);
+    return 0;
+}
@@ -173,37 +173,40 @@ constexpr static const int T_BLOCK_X = 128;
 // In this simplified example, we assume:
 // : A is in row-major format            (M x K x B)
 // : transpose(A) is in col-major format (K x M x B)
-// : D is in row-major format            (M x M x B)
-// : No LDS required
+// : D is the strict lower triangle of A x transpose(A), packed by row
 //
-// This device kernel also handles concatenating the lower triangular
-// indexing of D to the bottom MLP output to create the interaction dot output.
+// The epilogue of this device kernel concatenates the bottom MLP output
+// and the lower triangular indexing of D to create the interaction dot output.
+// Each wave stages its accumulator block in LDS and scatters the strict lower
+// triangle straight to its packed output offset, so the full M x M product is
+// never written to global memory. Blocks above the diagonal are skipped.
 //
 // Note: This is a simplified implementation to demonstrate API usage in
 // context of wave-level BMM computation, and is not optimized.
 __global__ void dlrmDotFwd(const float16_t* __restrict input,
                            float16_t* __restrict output,
-                           float* acc,
-                           uint   m,
-                           uint   k,
-                           uint   b,
-                           uint   inputBatchOffset,
-                           uint   outputBatchOffset,
-                           uint   accBatchOffset)
+                           uint m,
+                           uint k,
+                           uint b,
+                           uint inputBatchOffset,
+                           uint outputBatchOffset)
 {
-    using MappingA   = rocwmma::MappingUtil<TILE_DIM, TILE_DIM, float16_t, row_major>;
-    using MappingB   = rocwmma::MappingUtil<TILE_DIM, TILE_DIM, float16_t, col_major>;
-    using MappingC   = rocwmma::MappingUtil<TILE_DIM, TILE_DIM, float16_t, row_major>;
-    using MappingAcc = rocwmma::MappingUtil<TILE_DIM, TILE_DIM, float, row_major>;
+    using MappingA = rocwmma::MappingUtil<TILE_DIM, TILE_DIM, float16_t, row_major>;
+    using MappingB = rocwmma::MappingUtil<TILE_DIM, TILE_DIM, float16_t, col_major>;
+    using MappingC = rocwmma::MappingUtil<TILE_DIM, TILE_DIM, float16_t, row_major>;
 
     using FragA   = rocwmma::fragment<matrix_a, TILE_DIM, TILE_DIM, TILE_DIM, float16_t, row_major>;
     using FragB   = rocwmma::fragment<matrix_b, TILE_DIM, TILE_DIM, TILE_DIM, float16_t, col_major>;
     using FragAcc = rocwmma::fragment<accumulator, TILE_DIM, TILE_DIM, TILE_DIM, float>;
 
+    // Accumulator staging, one block per wave
+    constexpr uint WAVES_PER_BLOCK = T_BLOCK_X / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    __shared__ float ldsAcc[WAVES_PER_BLOCK][TILE_DIM * TILE_DIM];
+
     // Copy bottom MLP to output
     // Threads with a global index < k are responsible for copying MLP data
     auto globalThreadCoord = blockIdx.x * blockDim.x + threadIdx.x;
-    auto count             = k >> Log2<T_BLOCK_X>::value;
+    auto count             = rocwmma::ceilDiv(k, T_BLOCK_X);
     if(blockIdx.x == 0 && blockIdx.y == 0)
     {
         for(int i = 0; i < count; i++)
@@ -218,8 +221,14 @@ __global__ void dlrmDotFwd(const float16_t* __restrict input,
 
     // Target output block
     auto matrixCoordC = MappingC::matrixCoord();
+    auto waveIdx      = threadIdx.x / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    auto ldsWaveAcc   = ldsAcc[waveIdx];
+
+    // Only blocks on or below the diagonal hold lower triangular elements
+    bool isLower = get<0>(matrixCoordC) < m && get<1>(matrixCoordC) < m
+                   && get<0>(matrixCoordC) >= get<1>(matrixCoordC);
 
-    if(get<0>(matrixCoordC) < m && get<1>(matrixCoordC) < m)
+    if(isLower)
     {
         // Initialize accumulator
         auto fragAcc = FragAcc();
@@ -241,8 +250,6 @@ __global__ void dlrmDotFwd(const float16_t* __restrict input,
         auto count = k / TILE_DIM;
         for(int i = 0; i < count; i++)
         {
-            rocwmma::synchronize_workgroup();
-
             auto fragA = FragA();
             auto fragB = FragB();
 
@@ -254,14 +261,17 @@ __global__ void dlrmDotFwd(const float16_t* __restrict input,
             addrA += incrA;
             addrB += incrB;
         }
-        rocwmma::synchronize_workgroup();
 
-        // Store fragAcc to global acc
-        auto* accWithOffset = acc + accBatchOffset * blockIdx.z;
-        auto* addrAcc       = MappingAcc::dataCoord(accWithOffset, matrixCoordC, m);
-        rocwmma::store_matrix_sync(addrAcc, fragAcc, m, rocwmma::mem_row_major);
+        // Stage fragAcc in LDS for the scatter
+        rocwmma::store_matrix_sync(ldsWaveAcc, fragAcc, TILE_DIM, rocwmma::mem_row_major);
+    }
+
+    // Wait for LDS write before accessing
+    rocwmma::synchronize_workgroup();
 
-        // Copy lower triangular from acc to output
+    if(isLower)
+    {
+        // Scatter the strict lower triangle from LDS to its packed output offset
         auto fragColIdx   = threadIdx.x % TILE_DIM;
         auto globalColIdx = get<1>(matrixCoordC) + fragColIdx;
         auto rowsPerStep  = rocwmma::Constants::AMDGCN_WAVE_SIZE / TILE_DIM;
@@ -277,59 +287,12 @@ __global__ void dlrmDotFwd(const float16_t* __restrict input,
             {
                 auto outputOffset = k + ((globalRowIdx * (globalRowIdx - 1)) >> 1);
                 output[outputBatchOffset * blockIdx.z + outputOffset + globalColIdx]
-                    = float16_t(acc[accBatchOffset * blockIdx.z + globalRowIdx * m + globalColIdx]);
+                    = float16_t(ldsWaveAcc[fragRowIdx * TILE_DIM + fragColIdx]);
             }
         }
     }
 }
 
-// The following device kernel is a navie implementation of
-// matrix reconstruction from a lower triangular indexing (tril) input.
-//
-// Note: This is a simplified implementation, and is not optimized
-__global__ void trilReconstruct(const float16_t* __restrict upstreamGrad,
-                                float16_t* __restrict acc,
-                                uint m,
-                                uint k,
-                                uint b,
-                                uint upstreamBatchOffset,
-                                uint accBatchOffset)
-{
-    auto blocksPerRow = (m + blockDim.x - 1) / blockDim.x;
-    int  globalRowIdx;
-    if(blockDim.x >= m)
-    {
-        globalRowIdx = blockIdx.x * (blockDim.x / m) + (threadIdx.x / m);
-    }
-    else
-    {
-        globalRowIdx = blockIdx.x / blocksPerRow;
-    }
-
-    auto globalColIdx = (blockIdx.x * blockDim.x + threadIdx.x) % m;
-    if(globalRowIdx < m && globalColIdx < m)
-    {
-        if(globalRowIdx == globalColIdx)
-        {
-            acc[accBatchOffset * blockIdx.z + globalRowIdx * m + globalColIdx] = 0.0;
-        }
-        else if(globalRowIdx > globalColIdx)
-        {
-            auto upstreamGradOffset = k + ((globalRowIdx * (globalRowIdx - 1)) >> 1);
-
-            // original tril copy
-            acc[accBatchOffset * blockIdx.z + globalRowIdx * m + globalColIdx]
-                = upstreamGrad[upstreamBatchOffset * blockIdx.z + upstreamGradOffset
-                               + globalColIdx];
-
-            // transposed tril copy
-            acc[accBatchOffset * blockIdx.z + globalColIdx * m + globalRowIdx]
-                = upstreamGrad[upstreamBatchOffset * blockIdx.z + upstreamGradOffset
-                               + globalColIdx];
-        }
-    }
-}
-
 // The following device kernel is a naive implementation
 // of the backwards-pass interaction dot layer in the DLRM
 // architecture. Each wave will compute one TILE_DIM x TILE_DIM
@@ -337,10 +300,14 @@ __global__ void trilReconstruct(const float16_t* __restrict upstreamGrad,
 // D[b] = reconstructedTril[b] x input[b] for B batches
 //
 // In this simplified example, we assume:
-// : reconstructedTril is in row-major format (M x K x B)
-// : input is in col-major format             (M x M x B)
+// : reconstructedTril is in row-major format (M x M x B)
+// : input is in row-major format             (M x K x B)
 // : D is in row-major format                 (M x K x B)
-// : No LDS required
+//
+// reconstructedTril is never materialized. Each wave gathers its
+// TILE_DIM x TILE_DIM block of matrix_a from the packed lower triangular
+// upstream gradient into LDS, mirroring the upper triangle and zeroing the
+// diagonal on the fly, then loads the fragment from LDS.
 //
 // This device kernel also handles copying the bottom MLP gradient.
 //
@@ -350,13 +317,11 @@ __global__ void dlrmDotBwd(const float16_t* __restrict input,
                            const float16_t* __restrict upstreamGrad,
                            float16_t* __restrict grad,
                            float16_t* __restrict bottomMlpGrad,
-                           float16_t* __restrict acc,
                            uint m,
                            uint k,
                            uint b,
                            uint inputBatchOffset,
-                           uint upstreamBatchOffset,
-                           uint accBatchOffset)
+                           uint upstreamBatchOffset)
 {
     using TileMapping = rocwmma::MappingUtil<TILE_DIM, TILE_DIM, float16_t, row_major>;
 
@@ -365,11 +330,14 @@ __global__ void dlrmDotBwd(const float16_t* __restrict input,
     using FragC   = rocwmma::fragment<accumulator, TILE_DIM, TILE_DIM, TILE_DIM, float16_t>;
     using FragAcc = rocwmma::fragment<accumulator, TILE_DIM, TILE_DIM, TILE_DIM, float>;
 
+    // Reconstructed tril staging, one block per wave
+    constexpr uint WAVES_PER_BLOCK = T_BLOCK_X / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    __shared__ float16_t ldsTril[WAVES_PER_BLOCK][TILE_DIM * TILE_DIM];
+
     // Copy bottom MLP grad
     // Threads with a global index < k are responsible for copying MLP data
     auto globalThreadCoord = blockIdx.x * blockDim.x + threadIdx.x;
-    auto count             = k >> Log2<T_BLOCK_X>::value;
-    count                  = (count > 1) ? count : 1;
+    auto count             = rocwmma::ceilDiv(k, T_BLOCK_X);
     if(blockIdx.x == 0 && blockIdx.y == 0)
     {
         for(int i = 0; i < count; i++)
@@ -385,43 +353,77 @@ __global__ void dlrmDotBwd(const float16_t* __restrict input,
 
     // Target accumulator block
     auto matrixCoordC = TileMapping::matrixCoord();
+    auto laneIdx      = threadIdx.x % rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    auto waveIdx      = threadIdx.x / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    auto ldsWaveTril  = ldsTril[waveIdx];
 
     // Target output gradient block to perform reverse bmm
-    if(get<0>(matrixCoordC) < m && get<1>(matrixCoordC) < k)
+    bool isActive = get<0>(matrixCoordC) < m && get<1>(matrixCoordC) < k;
+
+    // Initialize accumulator
+    auto fragAcc = FragAcc();
+    rocwmma::fill_fragment(fragAcc, static_cast<float>(0));
+
+    // Setup starting addresses
+    auto* upstreamWithOffset = upstreamGrad + upstreamBatchOffset * blockIdx.z;
+    auto* inputWithOffset    = input + inputBatchOffset * blockIdx.z;
+    auto* addrB
+        = TileMapping::dataCoord(inputWithOffset, make_coord2d(0, get<1>(matrixCoordC)), k);
+
+    // Setup address increments.
+    // A steps BlockK through m x m
+    // B steps BlockK through m x k
+    auto incrB = TileMapping::dataOffset(make_coord2d(TILE_DIM, 0), k);
+
+    // Loop count is uniform across the workgroup for the LDS barriers
+    count = m / TILE_DIM;
+    for(int i = 0; i < count; i++)
     {
-        // Initialize accumulator
-        auto fragAcc = FragAcc();
-        rocwmma::fill_fragment(fragAcc, static_cast<float>(0));
-
-        // Setup starting addresses
-        auto* accWithOffset   = acc + accBatchOffset * blockIdx.z;
-        auto* inputWithOffset = input + inputBatchOffset * blockIdx.z;
-        auto* addrA
-            = TileMapping::dataCoord(accWithOffset, make_coord2d(get<0>(matrixCoordC), 0), m);
-        auto* addrB
-            = TileMapping::dataCoord(inputWithOffset, make_coord2d(0, get<1>(matrixCoordC)), k);
+        if(isActive)
+        {
+            // Gather the reconstructed tril block from the packed upstream gradient
+            for(uint j = laneIdx; j < TILE_DIM * TILE_DIM;
+                j += rocwmma::Constants::AMDGCN_WAVE_SIZE)
+            {
+                auto globalRowIdx = get<0>(matrixCoordC) + j / TILE_DIM;
+                auto globalColIdx = i * TILE_DIM + j % TILE_DIM;
+                auto value        = static_cast<float16_t>(0);
+                if(globalRowIdx > globalColIdx)
+                {
+                    value = upstreamWithOffset[k + ((globalRowIdx * (globalRowIdx - 1)) >> 1)
+                                               + globalColIdx];
+                }
+                else if(globalRowIdx < globalColIdx)
+                {
+                    value = upstreamWithOffset[k + ((globalColIdx * (globalColIdx - 1)) >> 1)
+                                               + globalRowIdx];
+                }
+                ldsWaveTril[j] = value;
+            }
+        }
 
-        // Setup address increments.
-        // A steps BlockK through m x m
-        // B steps BlockK through m x k
-        auto incrA = TileMapping::dataOffset(make_coord2d(0, TILE_DIM), m);
-        auto incrB = TileMapping::dataOffset(make_coord2d(TILE_DIM, 0), k);
+        // Wait for LDS write before accessing
+        rocwmma::synchronize_workgroup();
 
-        auto count = m / TILE_DIM;
-        for(int i = 0; i < count; i++)
+        if(isActive)
         {
             auto fragA = FragA();
             auto fragB = FragB();
 
             // Load and multiply
-            rocwmma::load_matrix_sync(fragA, addrA, m);
+            rocwmma::load_matrix_sync(fragA, ldsWaveTril, TILE_DIM);
             rocwmma::load_matrix_sync(fragB, addrB, k);
             rocwmma::mma_sync(fragAcc, fragA, fragB, fragAcc);
 
-            addrA += incrA;
             addrB += incrB;
         }
 
+        // Wait for LDS read before the next write
+        rocwmma::synchronize_workgroup();
+    }
+
+    if(isActive)
+    {
         // Output address
         auto* gradWithOffset = grad + inputBatchOffset * blockIdx.z;
         auto* addrGrad       = TileMapping::dataCoord(gradWithOffset, matrixCoordC, k);
@@ -440,6 +442,191 @@ __global__ void dlrmDotBwd(const float16_t* __restrict input,
     }
 }
 
+// Feature row of one sample, as it would be read from the materialized input tensor:
+// : Feature 0 is the bottom MLP output of the sample.
+// : Feature f > 0 is the sum pooled bag of rows of embedding table f - 1. The bag of
+//   sample s lists its rows in indices[bagOffsets[(f - 1) * (b + 1) + s], ... + s + 1]).
+// Tables hold tableRows x k elements each, stored contiguously.
+__device__ inline float16_t pooledFeature(const float16_t* __restrict bottomMlp,
+                                          const float16_t* __restrict tables,
+                                          const uint* __restrict bagOffsets,
+                                          const uint* __restrict indices,
+                                          uint sample,
+                                          uint feature,
+                                          uint col,
+                                          uint k,
+                                          uint b,
+                                          uint tableRows)
+{
+    if(feature == 0)
+    {
+        return bottomMlp[sample * k + col];
+    }
+
+    auto  table     = feature - 1;
+    auto* tableData = tables + static_cast<uint64_t>(table) * tableRows * k;
+    auto* bag       = bagOffsets + table * (b + 1) + sample;
+
+    // Pool in fp32, rounding once as the materialized tensor would
+    auto pooled = 0.0f;
+    for(uint i = bag[0]; i < bag[1]; i++)
+    {
+        pooled += static_cast<float>(tableData[static_cast<uint64_t>(indices[i]) * k + col]);
+    }
+    return static_cast<float16_t>(pooled);
+}
+
+// Embedding bag gather of the unfused forward pass: materializes the
+// [b, m, k] input tensor read by dlrmDotFwd. One thread per element.
+__global__ void embeddingBagGather(const float16_t* __restrict bottomMlp,
+                                   const float16_t* __restrict tables,
+                                   const uint* __restrict bagOffsets,
+                                   const uint* __restrict indices,
+                                   float16_t* __restrict input,
+                                   uint m,
+                                   uint k,
+                                   uint b,
+                                   uint tableRows)
+{
+    auto idx = static_cast<uint64_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+    if(idx < static_cast<uint64_t>(b) * m * k)
+    {
+        auto sample  = static_cast<uint>(idx / (m * k));
+        auto feature = static_cast<uint>(idx % (m * k)) / k;
+        auto col     = static_cast<uint>(idx % k);
+        input[idx]   = pooledFeature(
+            bottomMlp, tables, bagOffsets, indices, sample, feature, col, k, b, tableRows);
+    }
+}
+
+// The following device kernel fuses the embedding bag gather into the
+// forward-pass interaction dot layer. Each workgroup computes the interaction
+// of one sample: D[b] = A[b] x transpose(A[b]), with the feature rows of A[b]
+// as in pooledFeature.
+//
+// The workgroup gathers and pools the M x K feature matrix of its sample into
+// LDS, copying the bottom MLP to the output on the way. Each wave then computes
+// TILE_DIM x TILE_DIM blocks of the lower triangle, with both the matrix_a and
+// matrix_b fragments loaded from LDS, and scatters the strict lower triangle as
+// dlrmDotFwd does. The concatenated [b, m, k] input tensor is never written to
+// global memory.
+//
+// Note: The feature matrix takes M x K half-precision elements of dynamic LDS.
+__global__ void dlrmDotFwdGather(const float16_t* __restrict bottomMlp,
+                                 const float16_t* __restrict tables,
+                                 const uint* __restrict bagOffsets,
+                                 const uint* __restrict indices,
+                                 float16_t* __restrict output,
+                                 uint m,
+                                 uint k,
+                                 uint b,
+                                 uint tableRows,
+                                 uint outputBatchOffset)
+{
+    using FragA   = rocwmma::fragment<matrix_a, TILE_DIM, TILE_DIM, TILE_DIM, float16_t, row_major>;
+    using FragB   = rocwmma::fragment<matrix_b, TILE_DIM, TILE_DIM, TILE_DIM, float16_t, col_major>;
+    using FragAcc = rocwmma::fragment<accumulator, TILE_DIM, TILE_DIM, TILE_DIM, float>;
+
+    // Accumulator staging, one block per wave
+    constexpr uint WAVES_PER_BLOCK = T_BLOCK_X / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    __shared__ float ldsAcc[WAVES_PER_BLOCK][TILE_DIM * TILE_DIM];
+
+    HIP_DYNAMIC_SHARED(void*, localMemPtr);
+    auto* ldsFeatures = reinterpret_cast<float16_t*>(localMemPtr);
+
+    auto  sample           = blockIdx.x;
+    auto* outputWithOffset = output + outputBatchOffset * sample;
+
+    // Gather the feature matrix, copying the bottom MLP to the output
+    for(uint i = threadIdx.x; i < m * k; i += blockDim.x)
+    {
+        auto value = pooledFeature(
+            bottomMlp, tables, bagOffsets, indices, sample, i / k, i % k, k, b, tableRows);
+        if(i < k)
+        {
+            outputWithOffset[i] = value;
+        }
+        ldsFeatures[i] = value;
+    }
+
+    // Wait for LDS write before accessing
+    rocwmma::synchronize_workgroup();
+
+    auto waveIdx    = threadIdx.x / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    auto ldsWaveAcc = ldsAcc[waveIdx];
+
+    // Blocks on or below the diagonal, round robin over the waves.
+    // Loop count is uniform across the workgroup for the LDS barriers.
+    auto blocks      = m / TILE_DIM;
+    auto lowerBlocks = blocks * (blocks + 1) / 2;
+    auto count       = rocwmma::ceilDiv(lowerBlocks, WAVES_PER_BLOCK);
+    for(uint i = 0; i < count; i++)
+    {
+        auto blockId  = i * WAVES_PER_BLOCK + waveIdx;
+        bool isActive = blockId < lowerBlocks;
+
+        // Block row and col of the packed lower triangle index
+        auto blockRow = 0u;
+        while((blockRow + 1) * (blockRow + 2) / 2 <= blockId)
+        {
+            blockRow++;
+        }
+        auto blockCol     = blockId - blockRow * (blockRow + 1) / 2;
+        auto matrixCoordC = make_coord2d(blockRow * TILE_DIM, blockCol * TILE_DIM);
+
+        if(isActive)
+        {
+            auto fragAcc = FragAcc();
+            rocwmma::fill_fragment(fragAcc, static_cast<float>(0));
+
+            // A steps through the rows of the block row, B through those of the block col
+            auto* addrA = ldsFeatures + get<0>(matrixCoordC) * k;
+            auto* addrB = ldsFeatures + get<1>(matrixCoordC) * k;
+            for(uint kk = 0; kk < k; kk += TILE_DIM)
+            {
+                auto fragA = FragA();
+                auto fragB = FragB();
+
+                rocwmma::load_matrix_sync(fragA, addrA + kk, k);
+                rocwmma::load_matrix_sync(fragB, addrB + kk, k);
+                rocwmma::mma_sync(fragAcc, fragA, fragB, fragAcc);
+            }
+
+            // Stage fragAcc in LDS for the scatter
+            rocwmma::store_matrix_sync(ldsWaveAcc, fragAcc, TILE_DIM, rocwmma::mem_row_major);
+        }
+
+        // Wait for LDS write before accessing
+        rocwmma::synchronize_workgroup();
+
+        if(isActive)
+        {
+            // Scatter the strict lower triangle from LDS to its packed output offset
+            auto fragColIdx   = threadIdx.x % TILE_DIM;
+            auto globalColIdx = get<1>(matrixCoordC) + fragColIdx;
+            auto rowsPerStep  = rocwmma::Constants::AMDGCN_WAVE_SIZE / TILE_DIM;
+
+            auto steps = (TILE_DIM * TILE_DIM) >> Log2<rocwmma::Constants::AMDGCN_WAVE_SIZE>::value;
+            for(int j = 0; j < steps; j++)
+            {
+                auto fragRowIdx
+                    = j * rowsPerStep
+                      + ((threadIdx.x & (rocwmma::Constants::AMDGCN_WAVE_SIZE - 1)) / TILE_DIM);
+                auto globalRowIdx = get<0>(matrixCoordC) + fragRowIdx;
+                if(globalRowIdx > globalColIdx)
+                {
+                    auto outputOffset = k + ((globalRowIdx * (globalRowIdx - 1)) >> 1);
+                    outputWithOffset[outputOffset + globalColIdx]
+                        = float16_t(ldsWaveAcc[fragRowIdx * TILE_DIM + fragColIdx]);
+                }
+            }
+        }
+
+        // Wait for LDS read before the next write
+        rocwmma::synchronize_workgroup();
+    }
+}
+
 __host__ void dlrm_test(uint32_t m, uint32_t k, uint32_t b, DlrmDirection_t passDirection)
 {
     // Allocate and initialize host matrices
@@ -464,13 +651,10 @@ __host__ void dlrm_test(uint32_t m, uint32_t k, uint32_t b, DlrmDirection_t pass
     }
 
     // Allocate and copy device memory
-    float16_t *d_input, *d_output, *d_upstreamGrad, *d_grad, *d_bottomMlpGrad, *d_accBwd;
-    float*     d_accFwd;
+    float16_t *d_input, *d_output, *d_upstreamGrad, *d_grad, *d_bottomMlpGrad;
 
     const size_t inputBytes         = h_input.size() * sizeof(float16_t);
     const size_t outputBytes        = h_output.size() * sizeof(float16_t);
-    const size_t accFwdBytes        = m * m * b * sizeof(float32_t);
-    const size_t accBwdBytes        = m * m * b * sizeof(float16_t);
     const size_t upstreamGradBytes  = h_upstreamGrad.size() * sizeof(float16_t);
     const size_t gradBytes          = h_grad.size() * sizeof(float16_t);
     const size_t bottomMlpGradBytes = h_bottomMlpGrad.size() * sizeof(float16_t);
@@ -480,7 +664,6 @@ __host__ void dlrm_test(uint32_t m, uint32_t k, uint32_t b, DlrmDirection_t pass
     if(passDirection == DlrmDirection_t::Forward)
     {
         CHECK_HIP_ERROR(hipMalloc(&d_output, outputBytes));
-        CHECK_HIP_ERROR(hipMalloc(&d_accFwd, accFwdBytes));
 
         CHECK_HIP_ERROR(hipMemcpy(d_input, h_input.data(), inputBytes, hipMemcpyHostToDevice));
     }
@@ -489,7 +672,6 @@ __host__ void dlrm_test(uint32_t m, uint32_t k, uint32_t b, DlrmDirection_t pass
         CHECK_HIP_ERROR(hipMalloc(&d_upstreamGrad, upstreamGradBytes));
         CHECK_HIP_ERROR(hipMalloc(&d_grad, gradBytes));
         CHECK_HIP_ERROR(hipMalloc(&d_bottomMlpGrad, bottomMlpGradBytes));
-        CHECK_HIP_ERROR(hipMalloc(&d_accBwd, accBwdBytes));
 
         CHECK_HIP_ERROR(hipMemcpy(d_input, h_input.data(), inputBytes, hipMemcpyHostToDevice));
         CHECK_HIP_ERROR(hipMemcpy(
@@ -500,7 +682,7 @@ __host__ void dlrm_test(uint32_t m, uint32_t k, uint32_t b, DlrmDirection_t pass
 
     if(passDirection == DlrmDirection_t::Forward)
     {
-        dlrmKernel = [d_input, d_output, d_accFwd, m, k, b]() {
+        dlrmKernel = [d_input, d_output, m, k, b]() {
             auto gridDim  = dim3(rocwmma::ceilDiv(m, TILE_DIM * T_BLOCK_X / WAVE_SIZE),
                                 rocwmma::ceilDiv(m, TILE_DIM),
                                 b);
@@ -508,7 +690,6 @@ __host__ void dlrm_test(uint32_t m, uint32_t k, uint32_t b, DlrmDirection_t pass
 
             uint inputBatchOffset  = m * k;
             uint outputBatchOffset = ((m * (m - 1)) / 2) + k;
-            uint accBatchOffset    = m * m;
 
             hipExtLaunchKernelGGL((dlrmDotFwd),
                                   gridDim,
@@ -520,48 +701,23 @@ __host__ void dlrm_test(uint32_t m, uint32_t k, uint32_t b, DlrmDirection_t pass
                                   0, // flags
                                   d_input,
                                   d_output,
-                                  d_accFwd,
                                   m,
                                   k,
                                   b,
                                   inputBatchOffset,
-                                  outputBatchOffset,
-                                  accBatchOffset);
+                                  outputBatchOffset);
         };
     }
     else
     {
-        dlrmKernel = [d_input, d_upstreamGrad, d_grad, d_bottomMlpGrad, d_accBwd, m, k, b]() {
-            auto gridDim  = dim3(rocwmma::ceilDiv(m * m, T_BLOCK_X), 1, b);
+        dlrmKernel = [d_input, d_upstreamGrad, d_grad, d_bottomMlpGrad, m, k, b]() {
+            auto gridDim  = dim3(rocwmma::ceilDiv(m, TILE_DIM * T_BLOCK_X / WAVE_SIZE),
+                                rocwmma::ceilDiv(k, TILE_DIM),
+                                b);
             auto blockDim = dim3(T_BLOCK_X);
 
             uint inputBatchOffset    = m * k;
             uint upstreamBatchOffset = ((m * (m - 1)) / 2) + k;
-            uint accBatchOffset      = m * m;
-
-            hipEvent_t syncEvent;
-            CHECK_HIP_ERROR(hipEventCreate(&syncEvent));
-            hipExtLaunchKernelGGL((trilReconstruct),
-                                  gridDim,
-                                  blockDim,
-                                  0, // sharedMemBytes
-                                  0, // stream
-                                  nullptr, // event start
-                                  nullptr, // event stop
-                                  0, // flags
-                                  d_upstreamGrad,
-                                  d_accBwd,
-                                  m,
-                                  k,
-                                  b,
-                                  upstreamBatchOffset,
-                                  accBatchOffset);
-            CHECK_HIP_ERROR(hipEventRecord(syncEvent));
-            CHECK_HIP_ERROR(hipEventSynchronize(syncEvent));
-
-            gridDim = dim3(rocwmma::ceilDiv(m, TILE_DIM * T_BLOCK_X / WAVE_SIZE),
-                           rocwmma::ceilDiv(k, TILE_DIM),
-                           b);
 
             hipExtLaunchKernelGGL((dlrmDotBwd),
                                   gridDim,
@@ -575,13 +731,11 @@ __host__ void dlrm_test(uint32_t m, uint32_t k, uint32_t b, DlrmDirection_t pass
                                   d_upstreamGrad,
                                   d_grad,
                                   d_bottomMlpGrad,
-                                  d_accBwd,
                                   m,
                                   k,
                                   b,
                                   inputBatchOffset,
-                                  upstreamBatchOffset,
-                                  accBatchOffset);
+                                  upstreamBatchOffset);
         };
     }
 
@@ -694,22 +848,235 @@ __host__ void dlrm_test(uint32_t m, uint32_t k, uint32_t b, DlrmDirection_t pass
     if(passDirection == DlrmDirection_t::Forward)
     {
         CHECK_HIP_ERROR(hipFree(d_output));
-        CHECK_HIP_ERROR(hipFree(d_accFwd));
     }
     else
     {
         CHECK_HIP_ERROR(hipFree(d_upstreamGrad));
         CHECK_HIP_ERROR(hipFree(d_grad));
         CHECK_HIP_ERROR(hipFree(d_bottomMlpGrad));
-        CHECK_HIP_ERROR(hipFree(d_accBwd));
     }
 
     std::cout << "Finished!" << std::endl;
 }
 
+// Forward pass from the embedding tables: the unfused gather and interaction
+// kernels against dlrmDotFwdGather. Each of the m - 1 tables has tableRows
+// rows, and each sample pools between 1 and maxBagSize rows per table.
+__host__ void dlrm_gather_test(
+    uint32_t m, uint32_t k, uint32_t b, uint32_t tableRows, uint32_t maxBagSize)
+{
+    // Allocate and initialize host data
+    std::vector<float16_t> h_bottomMlp(k * b);
+    std::vector<float16_t> h_tables(static_cast<size_t>(m - 1) * tableRows * k);
+    std::vector<uint>      h_bagOffsets((m - 1) * (b + 1));
+    std::vector<uint>      h_indices;
+
+    fill<float16_t>(h_bottomMlp.data(), 1, k, b);
+    fill<float16_t>(h_tables.data(), tableRows, k, m - 1);
+
+    for(uint32_t t = 0; t < m - 1; t++)
+    {
+        h_bagOffsets[t * (b + 1)] = h_indices.size();
+        for(uint32_t s = 0; s < b; s++)
+        {
+            auto bagSize = 1u + rand() % maxBagSize;
+            for(uint32_t i = 0; i < bagSize; i++)
+            {
+                h_indices.push_back(rand() % tableRows);
+            }
+            h_bagOffsets[t * (b + 1) + s + 1] = h_indices.size();
+        }
+    }
+
+    const size_t trilSize = ((m * (m - 1)) / 2) + k;
+    std::vector<float16_t> h_output(trilSize * b);
+
+    // Allocate and copy device memory
+    float16_t *d_bottomMlp, *d_tables, *d_input, *d_output;
+    uint *d_bagOffsets, *d_indices;
+
+    const size_t bottomMlpBytes  = h_bottomMlp.size() * sizeof(float16_t);
+    const size_t tablesBytes     = h_tables.size() * sizeof(float16_t);
+    const size_t bagOffsetsBytes = h_bagOffsets.size() * sizeof(uint);
+    const size_t indicesBytes    = h_indices.size() * sizeof(uint);
+    const size_t inputBytes      = static_cast<size_t>(m) * k * b * sizeof(float16_t);
+    const size_t outputBytes     = h_output.size() * sizeof(float16_t);
+
+    CHECK_HIP_ERROR(hipMalloc(&d_bottomMlp, bottomMlpBytes));
+    CHECK_HIP_ERROR(hipMalloc(&d_tables, tablesBytes));
+    CHECK_HIP_ERROR(hipMalloc(&d_bagOffsets, bagOffsetsBytes));
+    CHECK_HIP_ERROR(hipMalloc(&d_indices, indicesBytes));
+    CHECK_HIP_ERROR(hipMalloc(&d_input, inputBytes));
+    CHECK_HIP_ERROR(hipMalloc(&d_output, outputBytes));
+
+    CHECK_HIP_ERROR(
+        hipMemcpy(d_bottomMlp, h_bottomMlp.data(), bottomMlpBytes, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_tables, h_tables.data(), tablesBytes, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(
+        hipMemcpy(d_bagOffsets, h_bagOffsets.data(), bagOffsetsBytes, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_indices, h_indices.data(), indicesBytes, hipMemcpyHostToDevice));
+
+    uint inputBatchOffset  = m * k;
+    uint outputBatchOffset = trilSize;
+
+    // Gather to the [b, m, k] input tensor, then the interaction
+    auto unfusedKernel = [&]() {
+        hipExtLaunchKernelGGL((embeddingBagGather),
+                              dim3(rocwmma::ceilDiv(m * k * b, T_BLOCK_X)),
+                              dim3(T_BLOCK_X),
+                              0, // sharedMemBytes
+                              0, // stream
+                              nullptr, // event start
+                              nullptr, // event stop
+                              0, // flags
+                              d_bottomMlp,
+                              d_tables,
+                              d_bagOffsets,
+                              d_indices,
+                              d_input,
+                              m,
+                              k,
+                              b,
+                              tableRows);
+
+        hipExtLaunchKernelGGL((dlrmDotFwd),
+                              dim3(rocwmma::ceilDiv(m, TILE_DIM * T_BLOCK_X / WAVE_SIZE),
+                                   rocwmma::ceilDiv(m, TILE_DIM),
+                                   b),
+                              dim3(T_BLOCK_X),
+                              0, // sharedMemBytes
+                              0, // stream
+                              nullptr, // event start
+                              nullptr, // event stop
+                              0, // flags
+                              d_input,
+                              d_output,
+                              m,
+                              k,
+                              b,
+                              inputBatchOffset,
+                              outputBatchOffset);
+    };
+
+    // One workgroup per sample, gathering its feature matrix to LDS
+    auto fusedKernel = [&]() {
+        hipExtLaunchKernelGGL((dlrmDotFwdGather),
+                              dim3(b),
+                              dim3(T_BLOCK_X),
+                              m * k * sizeof(float16_t), // sharedMemBytes
+                              0, // stream
+                              nullptr, // event start
+                              nullptr, // event stop
+                              0, // flags
+                              d_bottomMlp,
+                              d_tables,
+                              d_bagOffsets,
+                              d_indices,
+                              d_output,
+                              m,
+                              k,
+                              b,
+                              tableRows,
+                              outputBatchOffset);
+    };
+
+#if !NDEBUG
+
+    // Materialize the pooled input on the host for the reference
+    std::vector<float16_t> h_inputRef(m * k * b);
+    for(uint32_t s = 0; s < b; s++)
+    {
+        for(uint32_t f = 0; f < m; f++)
+        {
+            for(uint32_t c = 0; c < k; c++)
+            {
+                auto pooled = 0.0f;
+                if(f == 0)
+                {
+                    pooled = static_cast<float>(h_bottomMlp[s * k + c]);
+                }
+                else
+                {
+                    auto* bag = h_bagOffsets.data() + (f - 1) * (b + 1) + s;
+                    for(uint32_t i = bag[0]; i < bag[1]; i++)
+                    {
+                        pooled += static_cast<float>(
+                            h_tables[(static_cast<size_t>(f - 1) * tableRows + h_indices[i]) * k
+                                     + c]);
+                    }
+                }
+                h_inputRef[(s * m + f) * k + c] = static_cast<float16_t>(pooled);
+            }
+        }
+    }
+
+    std::vector<float16_t> outputRef(h_output.size());
+    dlrmDotFwdCPU(h_inputRef.data(), outputRef.data(), m, k, b);
+
+#endif // !NDEBUG
+
+    std::cout << "Path, TileSize, MatM, MatK, Batches, TableRows, MaxBagSize, elapsedMs"
+              << std::endl;
+
+    auto echo = [&](const char* pathName, auto&& kernel) {
+        // Poison the output to catch results left over from the other path
+        CHECK_HIP_ERROR(hipMemset(d_output, 0xFF, outputBytes));
+
+        hipEvent_t startEvent, stopEvent;
+        CHECK_HIP_ERROR(hipEventCreate(&startEvent));
+        CHECK_HIP_ERROR(hipEventCreate(&stopEvent));
+
+        CHECK_HIP_ERROR(hipEventRecord(startEvent));
+        kernel();
+        CHECK_HIP_ERROR(hipEventRecord(stopEvent));
+        CHECK_HIP_ERROR(hipEventSynchronize(stopEvent));
+
+        auto timeMs = 0.0f;
+        CHECK_HIP_ERROR(hipEventElapsedTime(&timeMs, startEvent, stopEvent));
+        CHECK_HIP_ERROR(hipEventDestroy(startEvent));
+        CHECK_HIP_ERROR(hipEventDestroy(stopEvent));
+
+        std::cout << pathName << ", " << TILE_DIM << ", " << m << ", " << k << ", " << b << ", "
+                  << tableRows << ", " << maxBagSize << ", " << timeMs << std::endl;
+
+#if !NDEBUG
+
+        CHECK_HIP_ERROR(hipMemcpy(h_output.data(), d_output, outputBytes, hipMemcpyDeviceToHost));
+
+        auto res = compareEqual<float16_t>(h_output.data(), outputRef.data(), h_output.size(), 1.0);
+
+        if(std::get<0>(res) == false)
+        {
+            std::cout << "FAILED!\n";
+        }
+        else
+        {
+            std::cout << "PASSED!\n";
+        }
+
+        std::cout << "Max relative error: " << std::get<1>(res) << std::endl;
+
+#endif // !NDEBUG
+    };
+
+    echo("Unfused", unfusedKernel);
+    echo("FusedGather", fusedKernel);
+
+    // Release device memory
+    CHECK_HIP_ERROR(hipFree(d_bottomMlp));
+    CHECK_HIP_ERROR(hipFree(d_tables));
+    CHECK_HIP_ERROR(hipFree(d_bagOffsets));
+    CHECK_HIP_ERROR(hipFree(d_indices));
+    CHECK_HIP_ERROR(hipFree(d_input));
+    CHECK_HIP_ERROR(hipFree(d_output));
+
+    std::cout << "Finished!" << std::endl;
+}
+
 int main()
 {
     dlrm_test(32, 128, 64, DlrmDirection_t::Forward);
     dlrm_test(32, 128, 64, DlrmDirection_t::Backward);
+    dlrm_gather_test(32, 128, 64, 4096, 4);
     return 0;
 }
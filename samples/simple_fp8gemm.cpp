@@ -0,0 +1,517 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_fp16.h>
+#include <hip/hip_runtime.h>
+
+#include <rocwmma/rocwmma.hpp>
+#include <rocwmma/rocwmma_epilogue.hpp>
+#include <rocwmma/rocwmma_transforms.hpp>
+
+#include "common.hpp"
+
+using rocwmma::accumulator;
+using rocwmma::col_major;
+using rocwmma::float16_t;
+using rocwmma::float32_t;
+using rocwmma::float8_t;
+using rocwmma::matrix_a;
+using rocwmma::matrix_b;
+using rocwmma::row_major;
+
+// Supports ROCWMMA_M/N square sizes of
+// : 16 x 16
+const int ROCWMMA_M = 16;
+const int ROCWMMA_N = 16;
+
+// Supports ROCWMMA_K sizes as
+// : multiples of 32 for 16 x 16 float8_t blocks.
+const int ROCWMMA_K = 32;
+
+// Quantization block size of the per-block scales.
+// Each scale applies to a SCALE_BLOCK x SCALE_BLOCK block of A or B.
+const int SCALE_BLOCK = 128;
+
+// Device warp size
+const uint32_t WAVE_SIZE = getWarpSize();
+
+// Thread block
+// : T_BLOCK_X must be multiple of WAVE_SIZE.
+// Note: Each wave will compute one BLOCK_M x BLOCK_N output block
+// Note: Workgroup will compute
+//  T_BLOCK_X / WAVE_SIZE x T_BLOCK_Y output blocks
+const int T_BLOCK_X = 4 * WAVE_SIZE;
+const int T_BLOCK_Y = 4;
+
+// Granularity of the A and B dequantization scales
+enum class ScaleMode : uint32_t
+{
+    // scaleA and scaleB are single values
+    PerTensor,
+
+    // scaleA is [M / SCALE_BLOCK][K / SCALE_BLOCK] and
+    // scaleB is [N / SCALE_BLOCK][K / SCALE_BLOCK], both row-major
+    PerBlock
+};
+
+// The following device kernel is a naive implementation
+// of blocked, scaled FP8 GEMM. Each wave will compute one BLOCK_M x BLOCK_N
+// output block of the M x N x K GEMM, generalized as:
+// D = saturate(scaleD * (scaleA * A x scaleB * B))
+// amaxD = max(|scaleA * A x scaleB * B|)
+// DT = D^T
+//
+// In this simplified example, we assume:
+// : A is in row-major format     (M x K) float8_t
+// : B is in col-major format     (K x N) float8_t
+// : D is in row-major format     (M x N) OutputT
+// : DT is in row-major format    (N x M) OutputT, e.g. for the backward GEMM
+// : Multiplication is NOT in-place, output is written to D matrix
+// : No LDS required
+//
+// Per-tensor scales are uniform over K and are applied once in the epilogue.
+// Per-block scales change along K every SCALE_BLOCK elements. Each scale block
+// is accumulated separately and scaled before it is added to the result.
+// Each wave's output block lies inside one scale block of A rows and B columns,
+// so these scales are wave-uniform scalars.
+//
+// The unscaled output is tracked by the Amax epilogue stage. The output scale
+// (e.g. from the previous amax) and saturation are only meaningful for FP8 outputs.
+// D and DT are stored from the same output fragment, without a transpose kernel.
+//
+// Note: This is a simplified implementation to demonstrate API usage in
+// context of wave-level GEMM computation, and is not optimized.
+template <ScaleMode Mode, typename OutputT>
+__global__ void gemm_fp8_rocwmma_d(uint32_t         m,
+                                   uint32_t         n,
+                                   uint32_t         k,
+                                   float8_t const*  a,
+                                   float8_t const*  b,
+                                   OutputT*         d,
+                                   OutputT*         dT,
+                                   uint32_t         lda,
+                                   uint32_t         ldb,
+                                   uint32_t         ldd,
+                                   uint32_t         lddT,
+                                   float32_t const* scaleA,
+                                   float32_t const* scaleB,
+                                   float32_t        scaleD,
+                                   float32_t*       amaxD)
+{
+    using FragA = rocwmma::fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float8_t, row_major>;
+    using FragB = rocwmma::fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float8_t, col_major>;
+    using FragAcc = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float32_t>;
+    using FragD   = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, OutputT>;
+
+    // Tile using a 2D grid
+    auto majorWarp = (blockIdx.x * blockDim.x + threadIdx.x) / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    auto minorWarp = (blockIdx.y * blockDim.y + threadIdx.y);
+
+    // Target D block
+    auto cRow = majorWarp * ROCWMMA_M;
+    auto cCol = minorWarp * ROCWMMA_N;
+
+    // Bounds check
+    if(cRow < m && cCol < n)
+    {
+        auto fragA   = FragA();
+        auto fragB   = FragB();
+        auto fragAcc = FragAcc();
+        rocwmma::fill_fragment(fragAcc, 0.0f);
+
+        // Dequantization scale applied in the epilogue
+        auto scaleAB = 1.0f;
+
+        if constexpr(Mode == ScaleMode::PerTensor)
+        {
+            // fragAcc = A x B
+            for(int i = 0; i < k; i += ROCWMMA_K)
+            {
+                rocwmma::load_matrix_sync(fragA, a + (cRow * lda + i), lda);
+                rocwmma::load_matrix_sync(fragB, b + (i + cCol * ldb), ldb);
+                rocwmma::mma_sync(fragAcc, fragA, fragB, fragAcc);
+            }
+
+            scaleAB = scaleA[0] * scaleB[0];
+        }
+        else
+        {
+            auto kBlocks  = k / SCALE_BLOCK;
+            auto scalesA  = scaleA + (cRow / SCALE_BLOCK) * kBlocks;
+            auto scalesB  = scaleB + (cCol / SCALE_BLOCK) * kBlocks;
+            auto fragPart = FragAcc();
+
+            // fragAcc = sum(scaleA_kb * scaleB_kb * (A_kb x B_kb))
+            for(int kb = 0; kb < kBlocks; kb++)
+            {
+                rocwmma::fill_fragment(fragPart, 0.0f);
+                for(int i = kb * SCALE_BLOCK; i < (kb + 1) * SCALE_BLOCK; i += ROCWMMA_K)
+                {
+                    rocwmma::load_matrix_sync(fragA, a + (cRow * lda + i), lda);
+                    rocwmma::load_matrix_sync(fragB, b + (i + cCol * ldb), ldb);
+                    rocwmma::mma_sync(fragPart, fragA, fragB, fragPart);
+                }
+
+                auto blockScale = scalesA[kb] * scalesB[kb];
+                for(int j = 0; j < fragAcc.num_elements; ++j)
+                {
+                    fragAcc.x[j] += blockScale * fragPart.x[j];
+                }
+            }
+        }
+
+        // D = saturate(scaleD * (scaleAB * acc)), tracking amax of the unscaled output
+        auto fragAmax = FragAcc();
+        auto fragD    = FragD();
+        rocwmma::fill_fragment(fragAmax, 0.0f);
+        rocwmma::apply_epilogue(fragD,
+                                fragAcc,
+                                rocwmma::epilogue::TensorScale(scaleAB),
+                                rocwmma::epilogue::Amax(fragAmax),
+                                rocwmma::epilogue::TensorScale(scaleD),
+                                rocwmma::epilogue::Saturate<OutputT>());
+
+        // Store to D and DT
+        rocwmma::store_matrix_dual_sync(
+            d + (cRow * ldd + cCol), dT + (cCol * lddT + cRow), fragD, ldd, lddT);
+
+        // Combine the block amax into the tensor amax
+        rocwmma::atomic_amax_sync(amaxD, fragAmax);
+    }
+}
+
+// Host quantization of a row-major (rows x cols) matrix into float8_t.
+// Scales are computed as amax / max(float8_t) over the whole matrix (PerTensor), or
+// over each SCALE_BLOCK x SCALE_BLOCK block (PerBlock), stored row-major.
+// For col-major B, quantize the (N x K) transpose.
+template <ScaleMode Mode>
+__host__ void quantize_fp8_h(std::vector<float32_t> const& src,
+                             std::vector<float8_t>&        dst,
+                             std::vector<float32_t>&       scales,
+                             uint32_t                      rows,
+                             uint32_t                      cols)
+{
+    auto const fp8Max = static_cast<float32_t>(std::numeric_limits<float8_t>::max());
+
+    auto blockRows = Mode == ScaleMode::PerTensor ? rows : SCALE_BLOCK;
+    auto blockCols = Mode == ScaleMode::PerTensor ? cols : SCALE_BLOCK;
+    auto gridRows  = rows / blockRows;
+    auto gridCols  = cols / blockCols;
+
+    dst.resize(rows * cols);
+    scales.resize(gridRows * gridCols);
+
+#pragma omp parallel for
+    for(int blk = 0; blk < gridRows * gridCols; ++blk)
+    {
+        auto r0 = (blk / gridCols) * blockRows;
+        auto c0 = (blk % gridCols) * blockCols;
+
+        auto amax = 0.0f;
+        for(int i = r0; i < r0 + blockRows; ++i)
+        {
+            for(int j = c0; j < c0 + blockCols; ++j)
+            {
+                amax = std::max(amax, std::fabs(src[i * cols + j]));
+            }
+        }
+
+        auto scale  = amax > 0.0f ? amax / fp8Max : 1.0f;
+        scales[blk] = scale;
+
+        for(int i = r0; i < r0 + blockRows; ++i)
+        {
+            for(int j = c0; j < c0 + blockCols; ++j)
+            {
+                dst[i * cols + j] = static_cast<float8_t>(src[i * cols + j] / scale);
+            }
+        }
+    }
+}
+
+// Host reference of the dequantized GEMM
+// D = saturate(scaleD * (scaleA * A x scaleB * B)), amaxD = max(|scaleA * A x scaleB * B|)
+template <ScaleMode Mode, typename OutputT>
+__host__ float32_t gemm_fp8_cpu_h(uint32_t                      m,
+                                  uint32_t                      n,
+                                  uint32_t                      k,
+                                  std::vector<float8_t> const&  a,
+                                  std::vector<float8_t> const&  b,
+                                  std::vector<OutputT>&         d,
+                                  std::vector<float32_t> const& scaleA,
+                                  std::vector<float32_t> const& scaleB,
+                                  float32_t                     scaleD)
+{
+    auto kBlocks = Mode == ScaleMode::PerTensor ? 1u : k / SCALE_BLOCK;
+    auto mScale  = Mode == ScaleMode::PerTensor ? m : SCALE_BLOCK;
+    auto nScale  = Mode == ScaleMode::PerTensor ? n : SCALE_BLOCK;
+    auto kScale  = Mode == ScaleMode::PerTensor ? k : SCALE_BLOCK;
+    auto lowest  = static_cast<float32_t>(std::numeric_limits<OutputT>::lowest());
+    auto highest = static_cast<float32_t>(std::numeric_limits<OutputT>::max());
+    auto amax    = 0.0f;
+
+#pragma omp parallel for reduction(max : amax)
+    for(int i = 0; i < m; ++i)
+    {
+        for(int j = 0; j < n; ++j)
+        {
+            auto accum = 0.0;
+            for(int h = 0; h < k; ++h)
+            {
+                auto sa = scaleA[(i / mScale) * kBlocks + h / kScale];
+                auto sb = scaleB[(j / nScale) * kBlocks + h / kScale];
+                accum += static_cast<double>(static_cast<float32_t>(a[i * k + h]) * sa)
+                         * static_cast<double>(static_cast<float32_t>(b[j * k + h]) * sb);
+            }
+
+            auto value   = static_cast<float32_t>(accum);
+            amax         = std::max(amax, std::fabs(value));
+            value        = std::min(std::max(value * scaleD, lowest), highest);
+            d[i * n + j] = static_cast<OutputT>(value);
+        }
+    }
+
+    return amax;
+}
+
+template <ScaleMode Mode, typename OutputT>
+__host__ void gemm_test(uint32_t m, uint32_t n, uint32_t k, float32_t scaleD)
+{
+    // Bounds check
+    if((m < (ROCWMMA_M * T_BLOCK_X / WAVE_SIZE) || n < (ROCWMMA_N * T_BLOCK_Y) || k < ROCWMMA_K)
+       || (m % ROCWMMA_M || n % ROCWMMA_N || k % ROCWMMA_K))
+    {
+        std::cout << "Unsupported size!\n";
+        return;
+    }
+
+    if(Mode == ScaleMode::PerBlock && (m % SCALE_BLOCK || n % SCALE_BLOCK || k % SCALE_BLOCK))
+    {
+        std::cout << "Unsupported size for per-block scales!\n";
+        return;
+    }
+
+    int lda = k;
+    int ldb = k;
+    int ldd  = n;
+    int lddT = m;
+
+    std::cout << "Initializing host data..." << std::endl;
+
+    // Full precision inputs in [-2, 2]
+    std::vector<float32_t> matrixAF32(m * k);
+    std::vector<float32_t> matrixBF32(k * n);
+    for(auto& value : matrixAF32)
+    {
+        value = static_cast<float32_t>(rand() % 257 - 128) / 64.0f;
+    }
+    for(auto& value : matrixBF32)
+    {
+        value = static_cast<float32_t>(rand() % 257 - 128) / 64.0f;
+    }
+
+    // Quantize inputs. B is col-major, so its (N x K) transpose is row-major.
+    std::vector<float8_t>  matrixA, matrixB;
+    std::vector<float32_t> scaleA, scaleB;
+    quantize_fp8_h<Mode>(matrixAF32, matrixA, scaleA, m, k);
+    quantize_fp8_h<Mode>(matrixBF32, matrixB, scaleB, n, k);
+
+    // Fill outputs with NaN to catch contamination
+    std::vector<OutputT> matrixD(m * n, std::numeric_limits<OutputT>::signaling_NaN());
+    std::vector<OutputT> matrixDT(n * m, std::numeric_limits<OutputT>::signaling_NaN());
+
+    std::cout << "Initializing device data..." << std::endl;
+
+    // Allocate and copy device memory
+    float8_t*  d_a;
+    float8_t*  d_b;
+    OutputT*   d_d;
+    OutputT*   d_dT;
+    float32_t* d_scaleA;
+    float32_t* d_scaleB;
+    float32_t* d_amaxD;
+
+    const size_t bytesA      = matrixA.size() * sizeof(float8_t);
+    const size_t bytesB      = matrixB.size() * sizeof(float8_t);
+    const size_t bytesD      = matrixD.size() * sizeof(OutputT);
+    const size_t bytesScaleA = scaleA.size() * sizeof(float32_t);
+    const size_t bytesScaleB = scaleB.size() * sizeof(float32_t);
+
+    CHECK_HIP_ERROR(hipMalloc(&d_a, bytesA));
+    CHECK_HIP_ERROR(hipMalloc(&d_b, bytesB));
+    CHECK_HIP_ERROR(hipMalloc(&d_d, bytesD));
+    CHECK_HIP_ERROR(hipMalloc(&d_dT, bytesD));
+    CHECK_HIP_ERROR(hipMalloc(&d_scaleA, bytesScaleA));
+    CHECK_HIP_ERROR(hipMalloc(&d_scaleB, bytesScaleB));
+    CHECK_HIP_ERROR(hipMalloc(&d_amaxD, sizeof(float32_t)));
+
+    CHECK_HIP_ERROR(hipMemcpy(d_a, matrixA.data(), bytesA, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_b, matrixB.data(), bytesB, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_d, matrixD.data(), bytesD, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_dT, matrixDT.data(), bytesD, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_scaleA, scaleA.data(), bytesScaleA, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_scaleB, scaleB.data(), bytesScaleB, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemset(d_amaxD, 0, sizeof(float32_t)));
+
+    auto blockDim = dim3(T_BLOCK_X, T_BLOCK_Y);
+    auto gridDim  = dim3(rocwmma::ceilDiv(m, ROCWMMA_M * T_BLOCK_X / WAVE_SIZE),
+                        rocwmma::ceilDiv(n, ROCWMMA_N * T_BLOCK_Y));
+
+    std::cout << "Launching GEMM kernel..." << std::endl;
+
+    hipEvent_t startEvent, stopEvent;
+    CHECK_HIP_ERROR(hipEventCreate(&startEvent));
+    CHECK_HIP_ERROR(hipEventCreate(&stopEvent));
+
+    hipExtLaunchKernelGGL(gemm_fp8_rocwmma_d<Mode, OutputT>,
+                          gridDim,
+                          blockDim,
+                          0, // sharedMemBytes
+                          0, // stream
+                          startEvent, // Event start
+                          stopEvent, // event stop
+                          0, // flags
+                          m,
+                          n,
+                          k,
+                          d_a,
+                          d_b,
+                          d_d,
+                          d_dT,
+                          lda,
+                          ldb,
+                          ldd,
+                          lddT,
+                          d_scaleA,
+                          d_scaleB,
+                          scaleD,
+                          d_amaxD);
+
+    auto elapsedTimeMs = 0.0f;
+    CHECK_HIP_ERROR(hipEventSynchronize(stopEvent));
+    CHECK_HIP_ERROR(hipEventElapsedTime(&elapsedTimeMs, startEvent, stopEvent));
+    CHECK_HIP_ERROR(hipEventDestroy(startEvent));
+    CHECK_HIP_ERROR(hipEventDestroy(stopEvent));
+
+    auto amaxD = 0.0f;
+    CHECK_HIP_ERROR(hipMemcpy(&amaxD, d_amaxD, sizeof(float32_t), hipMemcpyDeviceToHost));
+
+    // GEMM flops converge to 2*mnk
+    auto gFlops       = calculateGFlops(m, n, k);
+    auto tFlopsPerSec = gFlops / static_cast<double>(elapsedTimeMs);
+
+    // Echo performance
+    std::cout << "ScaleMode, OutputT, "
+              << "BlkM, BlkN, BlkK, "
+              << "MatM, MatN, MatK, "
+              << "lda, ldb, ldd, scaleD, amaxD, "
+              << "elapsedMs, Problem Size(GFlops), TFlops/s" << std::endl;
+
+    std::cout << (Mode == ScaleMode::PerTensor ? "PerTensor" : "PerBlock") << ", "
+              << (std::is_same_v<OutputT, float8_t> ? "f8" : "f16") << ", " << ROCWMMA_M << ", "
+              << ROCWMMA_N << ", " << ROCWMMA_K << ", " << m << ", " << n << ", " << k << ", "
+              << lda << ", " << ldb << ", " << ldd << ", " << scaleD << ", " << amaxD << ", "
+              << elapsedTimeMs << ", " << gFlops << ", " << tFlopsPerSec << std::endl;
+
+#if !NDEBUG
+
+    std::cout << "Validating result with reference..." << std::endl;
+
+    // Bring kernel result back to host
+    CHECK_HIP_ERROR(hipMemcpy(matrixD.data(), d_d, bytesD, hipMemcpyDeviceToHost));
+    CHECK_HIP_ERROR(hipMemcpy(matrixDT.data(), d_dT, bytesD, hipMemcpyDeviceToHost));
+
+    // Setup and run reference computation
+    std::vector<OutputT> matrixD_ref(m * n, std::numeric_limits<OutputT>::signaling_NaN());
+    auto                 amaxD_ref = gemm_fp8_cpu_h<Mode, OutputT>(
+        m, n, k, matrixA, matrixB, matrixD_ref, scaleA, scaleB, scaleD);
+
+    auto res = compareEqual<OutputT>(matrixD.data(), matrixD_ref.data(), m * n);
+
+    // DT holds the same values as D, transposed
+    auto transposed = true;
+    for(int i = 0; i < m; ++i)
+    {
+        for(int j = 0; j < n; ++j)
+        {
+            transposed &= (static_cast<float32_t>(matrixDT[j * lddT + i])
+                           == static_cast<float32_t>(matrixD[i * ldd + j]));
+        }
+    }
+
+    if(std::get<0>(res) == false || !transposed)
+    {
+        std::cout << "FAILED!\n";
+    }
+    else
+    {
+        std::cout << "PASSED!\n";
+    }
+
+    std::cout << "Max relative error: " << std::get<1>(res) << std::endl;
+    std::cout << "DT is the transpose of D: " << (transposed ? "yes" : "no") << std::endl;
+    std::cout << "amaxD: " << amaxD << ", reference: " << amaxD_ref << std::endl;
+
+#endif // !NDEBUG
+
+    // Release device memory
+    CHECK_HIP_ERROR(hipFree(d_a));
+    CHECK_HIP_ERROR(hipFree(d_b));
+    CHECK_HIP_ERROR(hipFree(d_d));
+    CHECK_HIP_ERROR(hipFree(d_dT));
+    CHECK_HIP_ERROR(hipFree(d_scaleA));
+    CHECK_HIP_ERROR(hipFree(d_scaleB));
+    CHECK_HIP_ERROR(hipFree(d_amaxD));
+
+    std::cout << "Finished!" << std::endl;
+}
+
+int main()
+{
+    // Test for f8 device support
+    if(!isF8Supported())
+    {
+        std::cout << "f8 gemm not supported on this device" << std::endl;
+    }
+    else
+    {
+        // High precision outputs
+        gemm_test<ScaleMode::PerTensor, float16_t>(1024, 1024, 1024, 1.0f);
+        gemm_test<ScaleMode::PerBlock, float16_t>(1024, 1024, 1024, 1.0f);
+
+        // FP8 outputs. The output scale would usually be derived from the amax
+        // of a previous iteration, e.g. max(float8_t) / amaxD.
+        gemm_test<ScaleMode::PerTensor, float8_t>(1024, 1024, 1024, 0.25f);
+        gemm_test<ScaleMode::PerBlock, float8_t>(1024, 1024, 1024, 0.25f);
+    }
+
+    return 0;
+}
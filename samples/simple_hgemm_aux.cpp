@@ -0,0 +1,539 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_fp16.h>
+#include <hip/hip_runtime.h>
+
+#include <rocwmma/rocwmma.hpp>
+#include <rocwmma/rocwmma_epilogue.hpp>
+#include <rocwmma/rocwmma_transforms.hpp>
+
+#include "common.hpp"
+
+using rocwmma::accumulator;
+using rocwmma::bfloat16_t;
+using rocwmma::col_major;
+using rocwmma::float16_t;
+using rocwmma::float32_t;
+using rocwmma::matrix_a;
+using rocwmma::matrix_b;
+using rocwmma::row_major;
+
+// Supports ROCWMMA_M/N square sizes of
+// : 16 x 16
+// : 32 x 32 ( only MI )
+const int ROCWMMA_M = 16;
+const int ROCWMMA_N = 16;
+
+// Supports ROCWMMA_K sizes as
+// : multiples of 16.
+const int ROCWMMA_K = 16;
+
+// Device warp size
+const uint32_t WAVE_SIZE = getWarpSize();
+
+// Thread block
+// : T_BLOCK_X must be multiple of WAVE_SIZE.
+// Note: Each wave will compute one BLOCK_M x BLOCK_N output block
+// Note: Workgroup will compute
+//  T_BLOCK_X / WAVE_SIZE x T_BLOCK_Y output blocks
+const int T_BLOCK_X = 4 * WAVE_SIZE;
+const int T_BLOCK_Y = 4;
+
+// Element-wise passes of the unfused path
+const int PASS_BLOCK = 256;
+
+using FragAcc = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float32_t>;
+
+// The following device kernel is a naive implementation of blocked GEMM
+// with a fused epilogue taking auxiliary outputs. Each wave will compute one
+// BLOCK_M x BLOCK_N output block of the M x N x K GEMM:
+// P = A x B + bias[col]    (pre-activation, saved in bfloat16_t for the backward pass)
+// D = gelu(P)
+// amax = max(|D|)          (device scalar, e.g. the FP8 scale of the next layer)
+// rowSum[row] = sum(D[row]) (e.g. the mean of a following normalization)
+//
+// Un-fused, the save, amax and row sums are each an additional pass over the output.
+// Fused, they are taken in registers along the epilogue stage chain:
+// : Save copies the pre-activation into a bfloat16_t fragment, stored alongside D
+// : Amax and Accumulate record element-wise statistics of D, which are reduced per
+//   block with rocwmma::atomic_amax_sync and rocwmma::reduce_rows.
+// Row sums of each column block are stored to a partial vector, and merged with a
+// pass over M x N / BLOCK_N partials.
+//
+// In this simplified example, we assume:
+// : A is in row-major format        (M x K)
+// : B is in col-major format        (K x N)
+// : D, P are in row-major format    (M x N)
+// : No LDS required
+//
+// Note: This is a simplified implementation to demonstrate API usage in
+// context of wave-level GEMM computation, and is not optimized.
+__global__ void hgemm_aux_rocwmma_d(uint32_t         m,
+                                    uint32_t         n,
+                                    uint32_t         k,
+                                    float16_t const* a,
+                                    float16_t const* b,
+                                    float32_t const* bias,
+                                    float16_t*       d,
+                                    bfloat16_t*      p,
+                                    float32_t*       amax,
+                                    float32_t*       rowSumPartials,
+                                    uint32_t         lda,
+                                    uint32_t         ldb,
+                                    uint32_t         ldd)
+{
+    // Create frags
+    auto fragA
+        = rocwmma::fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, row_major>();
+    auto fragB
+        = rocwmma::fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, col_major>();
+    auto fragD    = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t>();
+    auto fragP    = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, bfloat16_t>();
+    auto fragAcc  = FragAcc();
+    auto fragBias = FragAcc();
+
+    // Auxiliary statistics
+    auto fragAmax   = FragAcc();
+    auto fragRowSum = FragAcc();
+
+    rocwmma::fill_fragment(fragAcc, 0.0f);
+    rocwmma::fill_fragment(fragAmax, 0.0f);
+    rocwmma::fill_fragment(fragRowSum, 0.0f);
+
+    // Tile using a 2D grid
+    auto majorWarp = (blockIdx.x * blockDim.x + threadIdx.x) / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    auto minorWarp = (blockIdx.y * blockDim.y + threadIdx.y);
+
+    // Target D block
+    auto cRow = majorWarp * ROCWMMA_M;
+    auto cCol = minorWarp * ROCWMMA_N;
+
+    // Bounds check
+    if(cRow < m && cCol < n)
+    {
+        // fragAcc = A x B
+        for(int i = 0; i < k; i += ROCWMMA_K)
+        {
+            rocwmma::load_matrix_sync(fragA, a + (cRow * lda + i), lda);
+            rocwmma::load_matrix_sync(fragB, b + (i + cCol * ldb), ldb);
+            rocwmma::mma_sync(fragAcc, fragA, fragB, fragAcc);
+        }
+
+        rocwmma::load_row_vector_sync(fragBias, bias + cCol);
+
+        // P = acc + bias, D = gelu(P), with the statistics of D
+        rocwmma::apply_epilogue(fragD,
+                                fragAcc,
+                                rocwmma::epilogue::BiasAdd(fragBias),
+                                rocwmma::epilogue::Save(fragP),
+                                rocwmma::epilogue::Activation<rocwmma::epilogue::Gelu>(),
+                                rocwmma::epilogue::Amax(fragAmax),
+                                rocwmma::epilogue::Accumulate(fragRowSum));
+
+        // Store D and the auxiliary P
+        rocwmma::store_matrix_sync(d + (cRow * ldd + cCol), fragD, ldd, rocwmma::mem_row_major);
+        rocwmma::store_matrix_sync(p + (cRow * ldd + cCol), fragP, ldd, rocwmma::mem_row_major);
+
+        // Reduce the statistics of the block
+        rocwmma::atomic_amax_sync(amax, fragAmax);
+
+        fragRowSum = rocwmma::reduce_rows<rocwmma::reduce::Sum>(fragRowSum);
+        rocwmma::store_col_vector_sync(rowSumPartials + (cCol / ROCWMMA_N) * m + cRow, fragRowSum);
+    }
+}
+
+// Merges the row sums of the column blocks: rowSum[row] = sum(partials[block * m + row])
+__global__ void row_sum_merge_d(uint32_t         m,
+                                uint32_t         blocks,
+                                float32_t const* partials,
+                                float32_t*       rowSum)
+{
+    auto row = blockIdx.x * PASS_BLOCK + threadIdx.x;
+    if(row < m)
+    {
+        auto sum = 0.0f;
+        for(uint32_t block = 0; block < blocks; block++)
+        {
+            sum += partials[block * m + row];
+        }
+        rowSum[row] = sum;
+    }
+}
+
+// Unfused: the same GEMM, storing P = A x B + bias in float32_t
+__global__ void hgemm_bias_rocwmma_d(uint32_t         m,
+                                     uint32_t         n,
+                                     uint32_t         k,
+                                     float16_t const* a,
+                                     float16_t const* b,
+                                     float32_t const* bias,
+                                     float32_t*       p,
+                                     uint32_t         lda,
+                                     uint32_t         ldb,
+                                     uint32_t         ldp)
+{
+    auto fragA
+        = rocwmma::fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, row_major>();
+    auto fragB
+        = rocwmma::fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, col_major>();
+    auto fragAcc  = FragAcc();
+    auto fragBias = FragAcc();
+
+    rocwmma::fill_fragment(fragAcc, 0.0f);
+
+    auto majorWarp = (blockIdx.x * blockDim.x + threadIdx.x) / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    auto minorWarp = (blockIdx.y * blockDim.y + threadIdx.y);
+
+    auto cRow = majorWarp * ROCWMMA_M;
+    auto cCol = minorWarp * ROCWMMA_N;
+
+    if(cRow < m && cCol < n)
+    {
+        for(int i = 0; i < k; i += ROCWMMA_K)
+        {
+            rocwmma::load_matrix_sync(fragA, a + (cRow * lda + i), lda);
+            rocwmma::load_matrix_sync(fragB, b + (i + cCol * ldb), ldb);
+            rocwmma::mma_sync(fragAcc, fragA, fragB, fragAcc);
+        }
+
+        rocwmma::load_row_vector_sync(fragBias, bias + cCol);
+        rocwmma::apply_epilogue(fragAcc, fragAcc, rocwmma::epilogue::BiasAdd(fragBias));
+        rocwmma::store_matrix_sync(p + (cRow * ldp + cCol), fragAcc, ldp, rocwmma::mem_row_major);
+    }
+}
+
+// Unfused pass 1: D = gelu(P), saving P in bfloat16_t
+__global__ void activation_d(uint32_t         size,
+                             float32_t const* pIn,
+                             float16_t*       d,
+                             bfloat16_t*      p)
+{
+    auto idx = blockIdx.x * PASS_BLOCK + threadIdx.x;
+    if(idx < size)
+    {
+        p[idx] = static_cast<bfloat16_t>(pIn[idx]);
+        d[idx] = static_cast<float16_t>(rocwmma::epilogue::Gelu::exec(pIn[idx]));
+    }
+}
+
+// Unfused pass 2: amax = max(|D|)
+__global__ void amax_d(uint32_t size, float16_t const* d, float32_t* amax)
+{
+    auto threadMax = 0.0f;
+    for(auto idx = blockIdx.x * PASS_BLOCK + threadIdx.x; idx < size;
+        idx += gridDim.x * PASS_BLOCK)
+    {
+        threadMax = fmaxf(threadMax, fabsf(static_cast<float32_t>(d[idx])));
+    }
+    atomicMax(reinterpret_cast<uint32_t*>(amax), __float_as_uint(threadMax));
+}
+
+// Unfused pass 3: rowSum[row] = sum(D[row])
+__global__ void row_sum_d(uint32_t m, uint32_t n, float16_t const* d, float32_t* rowSum)
+{
+    auto row = blockIdx.x * PASS_BLOCK + threadIdx.x;
+    if(row < m)
+    {
+        auto sum = 0.0f;
+        for(uint32_t col = 0; col < n; col++)
+        {
+            sum += static_cast<float32_t>(d[row * n + col]);
+        }
+        rowSum[row] = sum;
+    }
+}
+
+__host__ void gemm_test(uint32_t m, uint32_t n, uint32_t k)
+{
+    // Bounds check
+    if((m < (ROCWMMA_M * T_BLOCK_X / WAVE_SIZE) || n < (ROCWMMA_N * T_BLOCK_Y) || k < ROCWMMA_K)
+       || (m % ROCWMMA_M || n % ROCWMMA_N || k % ROCWMMA_K))
+    {
+        std::cout << "Unsupported size!\n";
+        return;
+    }
+
+    int lda = k;
+    int ldb = k;
+    int ldd = n;
+
+    auto columnBlocks = n / ROCWMMA_N;
+
+    std::cout << "Initializing host data..." << std::endl;
+
+    // Initialize input matrices
+    std::vector<float16_t> matrixA(m * k);
+    std::vector<float16_t> matrixB(k * n);
+    std::vector<float32_t> vectorBias(n);
+
+    fillRand(matrixA.data(), m, k);
+    fillRand(matrixB.data(), k, n);
+    fillRand(vectorBias.data(), 1, n);
+
+    std::cout << "Initializing device data..." << std::endl;
+
+    // Allocate and copy device memory
+    float16_t*  d_a;
+    float16_t*  d_b;
+    float32_t*  d_bias;
+    float16_t*  d_d;
+    bfloat16_t* d_p;
+    float32_t*  d_pIn;
+    float32_t*  d_amax;
+    float32_t*  d_rowSum;
+    float32_t*  d_rowSumPartials;
+
+    const size_t bytesA    = matrixA.size() * sizeof(float16_t);
+    const size_t bytesB    = matrixB.size() * sizeof(float16_t);
+    const size_t bytesBias = vectorBias.size() * sizeof(float32_t);
+    const size_t bytesD    = m * n * sizeof(float16_t);
+    const size_t bytesP    = m * n * sizeof(bfloat16_t);
+    const size_t bytesPIn  = m * n * sizeof(float32_t);
+
+    CHECK_HIP_ERROR(hipMalloc(&d_a, bytesA));
+    CHECK_HIP_ERROR(hipMalloc(&d_b, bytesB));
+    CHECK_HIP_ERROR(hipMalloc(&d_bias, bytesBias));
+    CHECK_HIP_ERROR(hipMalloc(&d_d, bytesD));
+    CHECK_HIP_ERROR(hipMalloc(&d_p, bytesP));
+    CHECK_HIP_ERROR(hipMalloc(&d_pIn, bytesPIn));
+    CHECK_HIP_ERROR(hipMalloc(&d_amax, sizeof(float32_t)));
+    CHECK_HIP_ERROR(hipMalloc(&d_rowSum, m * sizeof(float32_t)));
+    CHECK_HIP_ERROR(hipMalloc(&d_rowSumPartials, columnBlocks * m * sizeof(float32_t)));
+
+    CHECK_HIP_ERROR(hipMemcpy(d_a, matrixA.data(), bytesA, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_b, matrixB.data(), bytesB, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_bias, vectorBias.data(), bytesBias, hipMemcpyHostToDevice));
+
+    auto blockDim = dim3(T_BLOCK_X, T_BLOCK_Y);
+    auto gridDim  = dim3(rocwmma::ceilDiv(m, ROCWMMA_M * T_BLOCK_X / WAVE_SIZE),
+                        rocwmma::ceilDiv(n, ROCWMMA_N * T_BLOCK_Y));
+
+    auto passBlocks = [](uint32_t size) { return dim3(rocwmma::ceilDiv(size, PASS_BLOCK)); };
+
+    hipEvent_t startEvent, stopEvent;
+    CHECK_HIP_ERROR(hipEventCreate(&startEvent));
+    CHECK_HIP_ERROR(hipEventCreate(&stopEvent));
+
+    // Runs the kernels on the null stream, and returns the elapsed time
+    auto timed = [&](auto&& kernels) {
+        // The amax is combined into, and must start from 0
+        CHECK_HIP_ERROR(hipMemset(d_amax, 0, sizeof(float32_t)));
+        CHECK_HIP_ERROR(hipEventRecord(startEvent));
+        kernels();
+        CHECK_HIP_ERROR(hipEventRecord(stopEvent));
+        CHECK_HIP_ERROR(hipEventSynchronize(stopEvent));
+
+        auto elapsedTimeMs = 0.0f;
+        CHECK_HIP_ERROR(hipEventElapsedTime(&elapsedTimeMs, startEvent, stopEvent));
+        return elapsedTimeMs;
+    };
+
+    auto fusedKernels = [&]() {
+        hipLaunchKernelGGL(hgemm_aux_rocwmma_d,
+                           gridDim,
+                           blockDim,
+                           0,
+                           0,
+                           m,
+                           n,
+                           k,
+                           d_a,
+                           d_b,
+                           d_bias,
+                           d_d,
+                           d_p,
+                           d_amax,
+                           d_rowSumPartials,
+                           lda,
+                           ldb,
+                           ldd);
+        hipLaunchKernelGGL(row_sum_merge_d,
+                           passBlocks(m),
+                           dim3(PASS_BLOCK),
+                           0,
+                           0,
+                           m,
+                           columnBlocks,
+                           d_rowSumPartials,
+                           d_rowSum);
+    };
+
+    auto unfusedKernels = [&]() {
+        hipLaunchKernelGGL(hgemm_bias_rocwmma_d,
+                           gridDim,
+                           blockDim,
+                           0,
+                           0,
+                           m,
+                           n,
+                           k,
+                           d_a,
+                           d_b,
+                           d_bias,
+                           d_pIn,
+                           lda,
+                           ldb,
+                           ldd);
+        hipLaunchKernelGGL(
+            activation_d, passBlocks(m * n), dim3(PASS_BLOCK), 0, 0, m * n, d_pIn, d_d, d_p);
+        hipLaunchKernelGGL(amax_d, dim3(1024), dim3(PASS_BLOCK), 0, 0, m * n, d_d, d_amax);
+        hipLaunchKernelGGL(row_sum_d, passBlocks(m), dim3(PASS_BLOCK), 0, 0, m, n, d_d, d_rowSum);
+    };
+
+#if !NDEBUG
+
+    // Reference in float32_t: P, D = gelu(P) and the statistics of D
+    std::vector<float32_t> matrixP_ref(m * n, 0.0f);
+    gemm_cpu_h<float16_t, float32_t, float32_t, row_major, col_major, row_major>(
+        m,
+        n,
+        k,
+        matrixA.data(),
+        matrixB.data(),
+        matrixP_ref.data(),
+        matrixP_ref.data(),
+        lda,
+        ldb,
+        ldd,
+        ldd,
+        1.0f,
+        0.0f);
+
+    auto gelu = [](float32_t x) {
+        return 0.5f * x * (1.0f + std::tanh(0.7978845608028654f * (x + 0.044715f * x * x * x)));
+    };
+
+    // P and D are compared in float16_t, which is finer than bfloat16_t
+    std::vector<float16_t> matrixP16_ref(m * n);
+    std::vector<float16_t> matrixD_ref(m * n);
+    std::vector<float32_t> vectorRowSum_ref(m, 0.0f);
+    auto                   amax_ref = 0.0f;
+    for(uint32_t i = 0; i < m; i++)
+    {
+        for(uint32_t j = 0; j < n; j++)
+        {
+            auto pValue = matrixP_ref[i * n + j] + vectorBias[j];
+            auto dValue = gelu(pValue);
+
+            matrixP16_ref[i * n + j] = static_cast<float16_t>(pValue);
+            matrixD_ref[i * n + j]   = static_cast<float16_t>(dValue);
+            vectorRowSum_ref[i] += dValue;
+            amax_ref = std::max(amax_ref, std::abs(dValue));
+        }
+    }
+
+    auto validate = [&]() {
+        std::vector<float16_t>  matrixD(m * n);
+        std::vector<bfloat16_t> matrixP(m * n);
+        std::vector<float32_t>  vectorRowSum(m);
+        auto                    amax = 0.0f;
+
+        CHECK_HIP_ERROR(hipMemcpy(matrixD.data(), d_d, bytesD, hipMemcpyDeviceToHost));
+        CHECK_HIP_ERROR(hipMemcpy(matrixP.data(), d_p, bytesP, hipMemcpyDeviceToHost));
+        CHECK_HIP_ERROR(hipMemcpy(
+            vectorRowSum.data(), d_rowSum, m * sizeof(float32_t), hipMemcpyDeviceToHost));
+        CHECK_HIP_ERROR(hipMemcpy(&amax, d_amax, sizeof(float32_t), hipMemcpyDeviceToHost));
+
+        std::vector<float16_t> matrixP16(m * n);
+        for(uint32_t i = 0; i < m * n; i++)
+        {
+            matrixP16[i] = static_cast<float16_t>(static_cast<float32_t>(matrixP[i]));
+        }
+
+        // Statistics are reduced in a different order, and from float16_t D when unfused
+        auto tolerance = 1.0e-3 / std::numeric_limits<float32_t>::epsilon();
+
+        auto resD      = compareEqual(matrixD.data(), matrixD_ref.data(), m * n);
+        auto resP      = compareEqual(matrixP16.data(), matrixP16_ref.data(), m * n);
+        auto resRowSum = compareEqual(vectorRowSum.data(), vectorRowSum_ref.data(), m, tolerance);
+        auto resAmax   = compareEqual(&amax, &amax_ref, 1u, tolerance);
+
+        for(auto [name, res] : {std::make_pair("D", resD),
+                                std::make_pair("P", resP),
+                                std::make_pair("rowSum", resRowSum),
+                                std::make_pair("amax", resAmax)})
+        {
+            std::cout << name << ": " << (std::get<0>(res) ? "PASSED" : "FAILED")
+                      << ", max relative error: " << std::get<1>(res) << std::endl;
+        }
+    };
+
+#endif // !NDEBUG
+
+    std::cout << "Kernels, MatM, MatN, MatK, elapsedMs, Problem Size(GFlops), TFlops/s"
+              << std::endl;
+
+    auto gFlops = calculateGFlops(m, n, k);
+    auto echo   = [&](const char* name, float elapsedTimeMs) {
+        std::cout << name << ", " << m << ", " << n << ", " << k << ", " << elapsedTimeMs << ", "
+                  << gFlops << ", " << gFlops / static_cast<double>(elapsedTimeMs) << std::endl;
+    };
+
+    echo("Unfused", timed(unfusedKernels));
+
+#if !NDEBUG
+    validate();
+#endif // !NDEBUG
+
+    // Fill outputs with NaN to catch contamination
+    CHECK_HIP_ERROR(hipMemset(d_d, 0xFF, bytesD));
+    CHECK_HIP_ERROR(hipMemset(d_p, 0xFF, bytesP));
+    CHECK_HIP_ERROR(hipMemset(d_rowSum, 0xFF, m * sizeof(float32_t)));
+
+    echo("FusedAux", timed(fusedKernels));
+
+#if !NDEBUG
+    validate();
+#endif // !NDEBUG
+
+    CHECK_HIP_ERROR(hipEventDestroy(startEvent));
+    CHECK_HIP_ERROR(hipEventDestroy(stopEvent));
+
+    // Release device memory
+    CHECK_HIP_ERROR(hipFree(d_a));
+    CHECK_HIP_ERROR(hipFree(d_b));
+    CHECK_HIP_ERROR(hipFree(d_bias));
+    CHECK_HIP_ERROR(hipFree(d_d));
+    CHECK_HIP_ERROR(hipFree(d_p));
+    CHECK_HIP_ERROR(hipFree(d_pIn));
+    CHECK_HIP_ERROR(hipFree(d_amax));
+    CHECK_HIP_ERROR(hipFree(d_rowSum));
+    CHECK_HIP_ERROR(hipFree(d_rowSumPartials));
+
+    std::cout << "Finished!" << std::endl;
+}
+
+int main()
+{
+    gemm_test(256, 256, 256);
+    gemm_test(2048, 2048, 2048);
+    return 0;
+}
@@ -0,0 +1,516 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <iostream>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_fp16.h>
+#include <hip/hip_runtime.h>
+
+#include <rocwmma/rocwmma.hpp>
+
+#include "benchmark_harness.hpp"
+#include "common.hpp"
+
+using rocwmma::accumulator;
+using rocwmma::col_major;
+using rocwmma::float16_t;
+using rocwmma::float32_t;
+using rocwmma::float64_t;
+using rocwmma::matrix_a;
+using rocwmma::matrix_b;
+using rocwmma::row_major;
+
+// Supports ROCWMMA_M/N square sizes of
+// : 16 x 16
+// : 32 x 32 ( only MI )
+const int ROCWMMA_M = 16;
+const int ROCWMMA_N = 16;
+
+// Supports ROCWMMA_K sizes as
+// : multiples of 16.
+const int ROCWMMA_K = 16;
+
+// Device warp size
+const uint32_t WAVE_SIZE = getWarpSize();
+
+// Thread block
+// : T_BLOCK_X must be multiple of WAVE_SIZE.
+// Note: Each wave will compute one BLOCK_M x BLOCK_N output block
+// Note: Workgroup will compute
+//  T_BLOCK_X / WAVE_SIZE x T_BLOCK_Y output blocks
+const int T_BLOCK_X = 2 * WAVE_SIZE;
+const int T_BLOCK_Y = 2;
+
+// The following device kernels compute batches of independent GEMMs,
+// generalized as:
+// D[i] = alpha[i] * (A[i] x B[i]) + beta[i] * C[i], for i in [0, batchCount)
+//
+// Many small GEMMs (e.g. attention heads) are too small to fill the GPU when
+// launched one at a time, and each launch pays the dispatch overhead. Batched
+// kernels launch all problems at once by using the z dimension of the grid
+// as the batch index:
+//
+// : Strided batched: matrices of batch i are located at a base pointer + i * stride
+// : Batched:         matrices of batch i are located at a pointer array entry [i]
+//
+// In this simplified example, we assume:
+// : A is in row-major format     (M x K)
+// : B is in col-major format     (K x N)
+// : C, D are in row-major format (M x N)
+// : All batches have the same M, N, K and leading dimensions
+// : Alpha and beta are per-batch device arrays
+// : No LDS required
+//
+// Note: This is a simplified implementation to demonstrate API usage in
+// context of wave-level GEMM computation, and is not optimized.
+
+// Computes one BLOCK_M x BLOCK_N output block of a single GEMM.
+__device__ static inline void hgemmBlock(uint32_t         m,
+                                         uint32_t         n,
+                                         uint32_t         k,
+                                         float16_t const* a,
+                                         float16_t const* b,
+                                         float16_t const* c,
+                                         float16_t*       d,
+                                         uint32_t         lda,
+                                         uint32_t         ldb,
+                                         uint32_t         ldc,
+                                         uint32_t         ldd,
+                                         float32_t        alpha,
+                                         float32_t        beta)
+{
+    // Create frags
+    auto fragA
+        = rocwmma::fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, row_major>();
+    auto fragB
+        = rocwmma::fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, col_major>();
+    auto fragC   = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t>();
+    auto fragAcc = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float32_t>();
+
+    rocwmma::fill_fragment(fragAcc, 0.0f);
+
+    // Tile using a 2D grid
+    auto majorWarp = (blockIdx.x * blockDim.x + threadIdx.x) / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    auto minorWarp = (blockIdx.y * blockDim.y + threadIdx.y);
+
+    // Target C block
+    auto cRow = majorWarp * ROCWMMA_M;
+    auto cCol = minorWarp * ROCWMMA_N;
+
+    // Bounds check
+    if(cRow < m && cCol < n)
+    {
+        // fragAcc = A x B
+        for(int i = 0; i < k; i += ROCWMMA_K)
+        {
+            // Load the inputs
+            rocwmma::load_matrix_sync(fragA, a + (cRow * lda + i), lda);
+            rocwmma::load_matrix_sync(fragB, b + (i + cCol * ldb), ldb);
+
+            // Matrix multiply - accumulate using MFMA units
+            rocwmma::mma_sync(fragAcc, fragA, fragB, fragAcc);
+        }
+
+        // Fetch C matrix
+        rocwmma::load_matrix_sync(fragC, c + (cRow * ldc + cCol), ldc, rocwmma::mem_row_major);
+
+        // D = alpha * A x B + beta * C
+        for(int i = 0; i < fragC.num_elements; ++i)
+        {
+            fragC.x[i] = alpha * fragAcc.x[i] + beta * fragC.x[i];
+        }
+
+        // Store to D
+        rocwmma::store_matrix_sync(d + (cRow * ldd + cCol), fragC, ldd, rocwmma::mem_row_major);
+    }
+}
+
+// Single GEMM per launch
+__global__ void hgemm_rocwmma_d(uint32_t         m,
+                                uint32_t         n,
+                                uint32_t         k,
+                                float16_t const* a,
+                                float16_t const* b,
+                                float16_t const* c,
+                                float16_t*       d,
+                                uint32_t         lda,
+                                uint32_t         ldb,
+                                uint32_t         ldc,
+                                uint32_t         ldd,
+                                float32_t        alpha,
+                                float32_t        beta)
+{
+    hgemmBlock(m, n, k, a, b, c, d, lda, ldb, ldc, ldd, alpha, beta);
+}
+
+// Strided batched GEMM: batch index = blockIdx.z
+__global__ void hgemm_strided_batched_rocwmma_d(uint32_t         m,
+                                                uint32_t         n,
+                                                uint32_t         k,
+                                                float16_t const* a,
+                                                float16_t const* b,
+                                                float16_t const* c,
+                                                float16_t*       d,
+                                                uint32_t         lda,
+                                                uint32_t         ldb,
+                                                uint32_t         ldc,
+                                                uint32_t         ldd,
+                                                uint64_t         strideA,
+                                                uint64_t         strideB,
+                                                uint64_t         strideC,
+                                                uint64_t         strideD,
+                                                float32_t const* alpha,
+                                                float32_t const* beta)
+{
+    auto batch = blockIdx.z;
+    hgemmBlock(m,
+               n,
+               k,
+               a + batch * strideA,
+               b + batch * strideB,
+               c + batch * strideC,
+               d + batch * strideD,
+               lda,
+               ldb,
+               ldc,
+               ldd,
+               alpha[batch],
+               beta[batch]);
+}
+
+// Pointer-array batched GEMM: batch index = blockIdx.z
+__global__ void hgemm_batched_rocwmma_d(uint32_t                m,
+                                        uint32_t                n,
+                                        uint32_t                k,
+                                        float16_t const* const* a,
+                                        float16_t const* const* b,
+                                        float16_t const* const* c,
+                                        float16_t* const*       d,
+                                        uint32_t                lda,
+                                        uint32_t                ldb,
+                                        uint32_t                ldc,
+                                        uint32_t                ldd,
+                                        float32_t const*        alpha,
+                                        float32_t const*        beta)
+{
+    auto batch = blockIdx.z;
+    hgemmBlock(
+        m, n, k, a[batch], b[batch], c[batch], d[batch], lda, ldb, ldc, ldd, alpha[batch], beta[batch]);
+}
+
+__host__ void batched_gemm_test(uint32_t m, uint32_t n, uint32_t k, uint32_t batchCount)
+{
+    // Bounds check
+    if((m < (ROCWMMA_M * T_BLOCK_X / WAVE_SIZE) || n < (ROCWMMA_N * T_BLOCK_Y) || k < ROCWMMA_K)
+       || (m % ROCWMMA_M || n % ROCWMMA_N || k % ROCWMMA_K) || batchCount == 0u)
+    {
+        std::cout << "Unsupported size!\n";
+        return;
+    }
+
+    int lda = k;
+    int ldb = k;
+    int ldc = n;
+    int ldd = ldc;
+
+    // Packed batches
+    uint64_t strideA = uint64_t(m) * k;
+    uint64_t strideB = uint64_t(k) * n;
+    uint64_t strideC = uint64_t(m) * n;
+    uint64_t strideD = strideC;
+
+    std::cout << "Initializing host data..." << std::endl;
+
+    // Initialize input matrices
+    std::vector<float16_t> matrixA(strideA * batchCount);
+    std::vector<float16_t> matrixB(strideB * batchCount);
+    std::vector<float16_t> matrixC(strideC * batchCount);
+    // Fill outputs with NaN to catch contamination
+    std::vector<float16_t> matrixD(strideD * batchCount,
+                                   std::numeric_limits<float16_t>::signaling_NaN());
+
+    fillRand(matrixA.data(), m * batchCount, k);
+    fillRand(matrixB.data(), n * batchCount, k);
+    fillRand(matrixC.data(), m * batchCount, n);
+
+    // Per-batch scaling factors
+    std::vector<float32_t> alphas(batchCount);
+    std::vector<float32_t> betas(batchCount);
+    for(uint32_t i = 0; i < batchCount; ++i)
+    {
+        alphas[i] = 1.0f + static_cast<float32_t>(i % 4u) * 0.5f;
+        betas[i]  = static_cast<float32_t>(i % 3u) * 0.5f;
+    }
+
+    std::cout << "Initializing device data..." << std::endl;
+
+    // Allocate and copy device memory
+    float16_t* d_a;
+    float16_t* d_b;
+    float16_t* d_c;
+    float16_t* d_d;
+    float32_t* d_alphas;
+    float32_t* d_betas;
+
+    const size_t bytesA = matrixA.size() * sizeof(float16_t);
+    const size_t bytesB = matrixB.size() * sizeof(float16_t);
+    const size_t bytesC = matrixC.size() * sizeof(float16_t);
+    const size_t bytesD = matrixD.size() * sizeof(float16_t);
+    const size_t bytesS = batchCount * sizeof(float32_t);
+
+    CHECK_HIP_ERROR(hipMalloc(&d_a, bytesA));
+    CHECK_HIP_ERROR(hipMalloc(&d_b, bytesB));
+    CHECK_HIP_ERROR(hipMalloc(&d_c, bytesC));
+    CHECK_HIP_ERROR(hipMalloc(&d_d, bytesD));
+    CHECK_HIP_ERROR(hipMalloc(&d_alphas, bytesS));
+    CHECK_HIP_ERROR(hipMalloc(&d_betas, bytesS));
+
+    CHECK_HIP_ERROR(hipMemcpy(d_a, matrixA.data(), bytesA, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_b, matrixB.data(), bytesB, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_c, matrixC.data(), bytesC, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_alphas, alphas.data(), bytesS, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_betas, betas.data(), bytesS, hipMemcpyHostToDevice));
+
+    // Pointer arrays for the batched variant
+    std::vector<float16_t const*> ptrsA(batchCount);
+    std::vector<float16_t const*> ptrsB(batchCount);
+    std::vector<float16_t const*> ptrsC(batchCount);
+    std::vector<float16_t*>       ptrsD(batchCount);
+    for(uint32_t i = 0; i < batchCount; ++i)
+    {
+        ptrsA[i] = d_a + i * strideA;
+        ptrsB[i] = d_b + i * strideB;
+        ptrsC[i] = d_c + i * strideC;
+        ptrsD[i] = d_d + i * strideD;
+    }
+
+    float16_t const** d_ptrsA;
+    float16_t const** d_ptrsB;
+    float16_t const** d_ptrsC;
+    float16_t**       d_ptrsD;
+    const size_t      bytesP = batchCount * sizeof(void*);
+
+    CHECK_HIP_ERROR(hipMalloc(&d_ptrsA, bytesP));
+    CHECK_HIP_ERROR(hipMalloc(&d_ptrsB, bytesP));
+    CHECK_HIP_ERROR(hipMalloc(&d_ptrsC, bytesP));
+    CHECK_HIP_ERROR(hipMalloc(&d_ptrsD, bytesP));
+
+    CHECK_HIP_ERROR(hipMemcpy(d_ptrsA, ptrsA.data(), bytesP, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_ptrsB, ptrsB.data(), bytesP, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_ptrsC, ptrsC.data(), bytesP, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_ptrsD, ptrsD.data(), bytesP, hipMemcpyHostToDevice));
+
+    auto blockDim = dim3(T_BLOCK_X, T_BLOCK_Y);
+    auto gridDim  = dim3(rocwmma::ceilDiv(m, ROCWMMA_M * T_BLOCK_X / WAVE_SIZE),
+                        rocwmma::ceilDiv(n, ROCWMMA_N * T_BLOCK_Y));
+    auto batchedGridDim = dim3(gridDim.x, gridDim.y, batchCount);
+
+    // Baseline: one launch per batch
+    auto loopedKernel = [&]() {
+        for(uint32_t i = 0; i < batchCount; ++i)
+        {
+            hipExtLaunchKernelGGL(hgemm_rocwmma_d,
+                                  gridDim,
+                                  blockDim,
+                                  0, // sharedMemBytes
+                                  0, // stream
+                                  nullptr, // Event start
+                                  nullptr, // event stop
+                                  0, // flags
+                                  m,
+                                  n,
+                                  k,
+                                  d_a + i * strideA,
+                                  d_b + i * strideB,
+                                  d_c + i * strideC,
+                                  d_d + i * strideD,
+                                  lda,
+                                  ldb,
+                                  ldc,
+                                  ldd,
+                                  alphas[i],
+                                  betas[i]);
+        }
+    };
+
+    auto stridedBatchedKernel = [&]() {
+        hipExtLaunchKernelGGL(hgemm_strided_batched_rocwmma_d,
+                              batchedGridDim,
+                              blockDim,
+                              0, // sharedMemBytes
+                              0, // stream
+                              nullptr, // Event start
+                              nullptr, // event stop
+                              0, // flags
+                              m,
+                              n,
+                              k,
+                              d_a,
+                              d_b,
+                              d_c,
+                              d_d,
+                              lda,
+                              ldb,
+                              ldc,
+                              ldd,
+                              strideA,
+                              strideB,
+                              strideC,
+                              strideD,
+                              d_alphas,
+                              d_betas);
+    };
+
+    auto batchedKernel = [&]() {
+        hipExtLaunchKernelGGL(hgemm_batched_rocwmma_d,
+                              batchedGridDim,
+                              blockDim,
+                              0, // sharedMemBytes
+                              0, // stream
+                              nullptr, // Event start
+                              nullptr, // event stop
+                              0, // flags
+                              m,
+                              n,
+                              k,
+                              d_ptrsA,
+                              d_ptrsB,
+                              d_ptrsC,
+                              d_ptrsD,
+                              lda,
+                              ldb,
+                              ldc,
+                              ldd,
+                              d_alphas,
+                              d_betas);
+    };
+
+    // Runs are timed individually, with warm and cold caches
+    BenchmarkHarness harness;
+
+#if !NDEBUG
+
+    // Setup and run reference computation for each batch
+    std::vector<float16_t> matrixD_ref(strideD * batchCount,
+                                       std::numeric_limits<float16_t>::signaling_NaN());
+    for(uint32_t i = 0; i < batchCount; ++i)
+    {
+        gemm_cpu_h<float16_t, float16_t, float32_t, row_major, col_major, row_major>(
+            m,
+            n,
+            k,
+            matrixA.data() + i * strideA,
+            matrixB.data() + i * strideB,
+            matrixC.data() + i * strideC,
+            matrixD_ref.data() + i * strideD,
+            lda,
+            ldb,
+            ldc,
+            ldd,
+            alphas[i],
+            betas[i]);
+    }
+
+    auto validate = [&]() {
+        // Bring kernel result back to host
+        CHECK_HIP_ERROR(hipMemcpy(matrixD.data(), d_d, bytesD, hipMemcpyDeviceToHost));
+
+        auto res = compareEqual<float16_t>(matrixD.data(), matrixD_ref.data(), matrixD.size());
+
+        if(std::get<0>(res) == false)
+        {
+            std::cout << "FAILED!\n";
+        }
+        else
+        {
+            std::cout << "PASSED!\n";
+        }
+
+        std::cout << "Max relative error: " << std::get<1>(res) << std::endl;
+    };
+
+#endif // !NDEBUG
+
+    // Echo performance
+    std::cout << "Mode, BlkM, BlkN, BlkK, "
+              << "MatM, MatN, MatK, BatchCount, "
+              << "lda, ldb, ldc, ldd, "
+              << "Cache, elapsedMs, Problem Size(GFlops), TFlops/s, "
+              << BenchmarkHarness::statsHeader() << std::endl;
+
+    auto gFlops = calculateGFlops(m, n, k) * batchCount;
+
+    auto run = [&](const char* mode, auto&& kernel) {
+        // Fill outputs with NaN to catch contamination
+        CHECK_HIP_ERROR(hipMemset(d_d, 0xFF, bytesD));
+
+        for(auto cacheState :
+            {BenchmarkHarness::CacheState::Warm, BenchmarkHarness::CacheState::Cold})
+        {
+            auto stats        = harness.run(kernel, cacheState);
+            auto tFlopsPerSec = gFlops / stats.mMedianMs;
+
+            std::cout << mode << ", " << ROCWMMA_M << ", " << ROCWMMA_N << ", " << ROCWMMA_K
+                      << ", " << m << ", " << n << ", " << k << ", " << batchCount << ", " << lda
+                      << ", " << ldb << ", " << ldc << ", " << ldd << ", "
+                      << (cacheState == BenchmarkHarness::CacheState::Warm ? "warm" : "cold")
+                      << ", " << stats.mMedianMs << ", " << gFlops << ", " << tFlopsPerSec
+                      << ", ";
+            BenchmarkHarness::printStats(std::cout, stats) << std::endl;
+        }
+
+#if !NDEBUG
+        validate();
+#endif // !NDEBUG
+    };
+
+    run("Looped", loopedKernel);
+    run("StridedBatched", stridedBatchedKernel);
+    run("Batched", batchedKernel);
+
+    // Release device memory
+    CHECK_HIP_ERROR(hipFree(d_a));
+    CHECK_HIP_ERROR(hipFree(d_b));
+    CHECK_HIP_ERROR(hipFree(d_c));
+    CHECK_HIP_ERROR(hipFree(d_d));
+    CHECK_HIP_ERROR(hipFree(d_alphas));
+    CHECK_HIP_ERROR(hipFree(d_betas));
+    CHECK_HIP_ERROR(hipFree(d_ptrsA));
+    CHECK_HIP_ERROR(hipFree(d_ptrsB));
+    CHECK_HIP_ERROR(hipFree(d_ptrsC));
+    CHECK_HIP_ERROR(hipFree(d_ptrsD));
+
+    std::cout << "Finished!" << std::endl;
+}
+
+int main()
+{
+    // Attention-head sized problems
+    batched_gemm_test(64, 64, 64, 1024);
+    batched_gemm_test(128, 128, 64, 256);
+    return 0;
+}
@@ -0,0 +1,349 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_runtime.h>
+
+#include <rocwmma/rocwmma.hpp>
+
+#include "common.hpp"
+
+using rocwmma::accumulator;
+using rocwmma::col_major;
+using rocwmma::float16_t;
+using rocwmma::float32_t;
+using rocwmma::float64_t;
+using rocwmma::matrix_a;
+using rocwmma::matrix_b;
+using rocwmma::row_major;
+
+// Supports ROCWMMA_M/N square sizes of
+// : 16 x 16
+// : 32 x 32 ( only MI )
+const int ROCWMMA_M = 16;
+const int ROCWMMA_N = 16;
+
+// Supports ROCWMMA_K sizes as
+// : multiples of 16.
+const int ROCWMMA_K = 16;
+
+// K blocks accumulated in float16_t between folds into float32_t
+const uint32_t CHUNK_K = 8u;
+
+// Device warp size
+const uint32_t WAVE_SIZE = getWarpSize();
+
+// Thread block
+// : T_BLOCK_X must be multiple of WAVE_SIZE.
+// Note: Each wave will compute one BLOCK_M x BLOCK_N output block
+// Note: Workgroup will compute
+//  T_BLOCK_X / WAVE_SIZE x T_BLOCK_Y output blocks
+const int T_BLOCK_X = 4 * WAVE_SIZE;
+const int T_BLOCK_Y = 4;
+
+enum class Accumulation : uint32_t
+{
+    Float32,
+    Float16,
+    Chunked
+};
+
+__host__ char const* accumulationString(Accumulation mode)
+{
+    return mode == Accumulation::Float32   ? "float32"
+           : mode == Accumulation::Float16 ? "float16"
+                                           : "float16 chunks";
+}
+
+// The following device kernel is a naive implementation
+// of blocked GEMM on float16_t inputs, with float32_t outputs.
+// Each wave will compute one BLOCK_M x BLOCK_N output block of the
+// M x N x K GEMM, generalized as:
+// D = A x B
+//
+// The accumulation precision is selected by Mode:
+// : Float32 accumulates in float32_t
+// : Float16 accumulates in float16_t, rounding the running sum after each block of K
+// : Chunked accumulates CHUNK_K blocks of K in float16_t, then folds the chunk into a
+//   float32_t master accumulator. The float16_t rounding error only grows over a chunk.
+//
+// In this simplified example, we assume:
+// : A is in row-major format     (M x K)
+// : B is in col-major format     (K x N)
+// : D is in row-major format     (M x N)
+// : No LDS required
+//
+// Note: This is a simplified implementation to demonstrate API usage in
+// context of wave-level GEMM computation, and is not optimized.
+template <Accumulation Mode>
+__global__ void hgemm_chunked_d(uint32_t         m,
+                                uint32_t         n,
+                                uint32_t         k,
+                                float16_t const* a,
+                                float16_t const* b,
+                                float32_t*       d,
+                                uint32_t         lda,
+                                uint32_t         ldb,
+                                uint32_t         ldd)
+{
+    using FragA
+        = rocwmma::fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, row_major>;
+    using FragB
+        = rocwmma::fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, col_major>;
+    using FragD     = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float32_t>;
+    using FragAcc16 = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t>;
+    using ChunkedAcc = rocwmma::
+        chunked_accumulator<ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, float16_t, CHUNK_K>;
+
+    // Create frags
+    auto fragA = FragA();
+    auto fragB = FragB();
+    auto fragD = FragD();
+
+    rocwmma::fill_fragment(fragD, 0.0f);
+
+    // Tile using a 2D grid
+    auto majorWarp = (blockIdx.x * blockDim.x + threadIdx.x) / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    auto minorWarp = (blockIdx.y * blockDim.y + threadIdx.y);
+
+    // Target D block
+    auto cRow = majorWarp * ROCWMMA_M;
+    auto cCol = minorWarp * ROCWMMA_N;
+
+    // Bounds check
+    if(cRow < m && cCol < n)
+    {
+        if constexpr(Mode == Accumulation::Float32)
+        {
+            for(int i = 0; i < k; i += ROCWMMA_K)
+            {
+                rocwmma::load_matrix_sync(fragA, a + (cRow * lda + i), lda);
+                rocwmma::load_matrix_sync(fragB, b + (i + cCol * ldb), ldb);
+                rocwmma::mma_sync(fragD, fragA, fragB, fragD);
+            }
+        }
+        else if constexpr(Mode == Accumulation::Float16)
+        {
+            auto fragAcc = FragAcc16();
+            rocwmma::fill_fragment(fragAcc, static_cast<float16_t>(0));
+
+            for(int i = 0; i < k; i += ROCWMMA_K)
+            {
+                rocwmma::load_matrix_sync(fragA, a + (cRow * lda + i), lda);
+                rocwmma::load_matrix_sync(fragB, b + (i + cCol * ldb), ldb);
+                rocwmma::mma_sync(fragAcc, fragA, fragB, fragAcc);
+            }
+
+            for(int i = 0; i < fragD.num_elements; ++i)
+            {
+                fragD.x[i] = static_cast<float32_t>(fragAcc.x[i]);
+            }
+        }
+        else
+        {
+            // Master starts from D = 0, with an empty chunk
+            auto acc = ChunkedAcc();
+            rocwmma::to_chunked(acc, fragD);
+
+            // Chunks fold every CHUNK_K calls
+            for(int i = 0; i < k; i += ROCWMMA_K)
+            {
+                rocwmma::load_matrix_sync(fragA, a + (cRow * lda + i), lda);
+                rocwmma::load_matrix_sync(fragB, b + (i + cCol * ldb), ldb);
+                rocwmma::mma_sync(acc, fragA, fragB);
+            }
+
+            // Master plus the last partial chunk
+            rocwmma::from_chunked(fragD, acc);
+        }
+
+        // Store to D
+        rocwmma::store_matrix_sync(d + (cRow * ldd + cCol), fragD, ldd, rocwmma::mem_row_major);
+    }
+}
+
+// Host matrix data initialization with full float16_t mantissas.
+// Integer fills are summed exactly and would hide the rounding of the accumulation.
+__host__ static inline void fillRandF16(float16_t* mat, uint32_t m, uint32_t n)
+{
+    auto gen  = std::mt19937(5489u);
+    auto dist = std::uniform_real_distribution<float32_t>(-1.0f, 1.0f);
+    for(uint32_t i = 0; i < m * n; ++i)
+    {
+        mat[i] = static_cast<float16_t>(dist(gen));
+    }
+}
+
+// Normwise error: max |D - D_ref| / max |D_ref|
+__host__ double normwiseError(std::vector<float32_t> const& d, std::vector<float32_t> const& ref)
+{
+    auto maxError = 0.0;
+    auto maxRef   = 0.0;
+    for(size_t i = 0; i < d.size(); i++)
+    {
+        maxError = std::max(maxError, std::abs(static_cast<double>(d[i]) - ref[i]));
+        maxRef   = std::max(maxRef, std::abs(static_cast<double>(ref[i])));
+    }
+    return maxError / maxRef;
+}
+
+__host__ void gemm_test(uint32_t m, uint32_t n, uint32_t k)
+{
+    // Bounds check
+    if((m < (ROCWMMA_M * T_BLOCK_X / WAVE_SIZE) || n < (ROCWMMA_N * T_BLOCK_Y) || k < ROCWMMA_K)
+       || (m % ROCWMMA_M || n % ROCWMMA_N || k % ROCWMMA_K))
+    {
+        std::cout << "Unsupported size!\n";
+        return;
+    }
+
+    int lda = k;
+    int ldb = k;
+    int ldd = n;
+
+    // Initialize input matrices
+    std::vector<float16_t> matrixA(m * k);
+    std::vector<float16_t> matrixB(k * n);
+    std::vector<float32_t> matrixD(m * n);
+
+    fillRandF16(matrixA.data(), m, k);
+    fillRandF16(matrixB.data(), k, n);
+
+    // Allocate and copy device memory
+    float16_t* d_a;
+    float16_t* d_b;
+    float32_t* d_d;
+
+    const size_t bytesA = matrixA.size() * sizeof(float16_t);
+    const size_t bytesB = matrixB.size() * sizeof(float16_t);
+    const size_t bytesD = matrixD.size() * sizeof(float32_t);
+
+    CHECK_HIP_ERROR(hipMalloc(&d_a, bytesA));
+    CHECK_HIP_ERROR(hipMalloc(&d_b, bytesB));
+    CHECK_HIP_ERROR(hipMalloc(&d_d, bytesD));
+
+    CHECK_HIP_ERROR(hipMemcpy(d_a, matrixA.data(), bytesA, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_b, matrixB.data(), bytesB, hipMemcpyHostToDevice));
+
+    // Reference computation in float64_t
+    std::vector<float32_t> matrixD_ref(m * n);
+    gemm_cpu_h<float16_t, float32_t, float64_t, row_major, col_major, row_major>(
+        m,
+        n,
+        k,
+        matrixA.data(),
+        matrixB.data(),
+        matrixD_ref.data(),
+        matrixD_ref.data(),
+        lda,
+        ldb,
+        ldd,
+        ldd,
+        1.0,
+        0.0);
+
+    auto blockDim = dim3(T_BLOCK_X, T_BLOCK_Y);
+    auto gridDim  = dim3(rocwmma::ceilDiv(m, ROCWMMA_M * T_BLOCK_X / WAVE_SIZE),
+                        rocwmma::ceilDiv(n, ROCWMMA_N * T_BLOCK_Y));
+
+    auto runMode = [&](auto kernel, Accumulation mode) {
+        hipEvent_t startEvent, stopEvent;
+        CHECK_HIP_ERROR(hipEventCreate(&startEvent));
+        CHECK_HIP_ERROR(hipEventCreate(&stopEvent));
+
+        hipExtLaunchKernelGGL(kernel,
+                              gridDim,
+                              blockDim,
+                              0, // sharedMemBytes
+                              0, // stream
+                              startEvent, // Event start
+                              stopEvent, // event stop
+                              0, // flags
+                              m,
+                              n,
+                              k,
+                              d_a,
+                              d_b,
+                              d_d,
+                              lda,
+                              ldb,
+                              ldd);
+
+        auto elapsedTimeMs = 0.0f;
+        CHECK_HIP_ERROR(hipEventSynchronize(stopEvent));
+        CHECK_HIP_ERROR(hipEventElapsedTime(&elapsedTimeMs, startEvent, stopEvent));
+        CHECK_HIP_ERROR(hipEventDestroy(startEvent));
+        CHECK_HIP_ERROR(hipEventDestroy(stopEvent));
+
+        CHECK_HIP_ERROR(hipMemcpy(matrixD.data(), d_d, bytesD, hipMemcpyDeviceToHost));
+        auto error = normwiseError(matrixD, matrixD_ref);
+
+        std::cout << accumulationString(mode) << ", " << m << ", " << n << ", " << k << ", "
+                  << elapsedTimeMs << ", "
+                  << calculateTFlopsPerSec(m, n, k, static_cast<double>(elapsedTimeMs)) << ", "
+                  << error << std::endl;
+
+        return error;
+    };
+
+    auto errorF32     = runMode(hgemm_chunked_d<Accumulation::Float32>, Accumulation::Float32);
+    auto errorF16     = runMode(hgemm_chunked_d<Accumulation::Float16>, Accumulation::Float16);
+    auto errorChunked = runMode(hgemm_chunked_d<Accumulation::Chunked>, Accumulation::Chunked);
+
+    // Chunks bound the float16_t rounding error to CHUNK_K blocks of K
+    if(errorChunked >= errorF16)
+    {
+        std::cout << "FAILED! float16 chunks are no more accurate than float16 accumulation\n";
+    }
+    else
+    {
+        std::cout << "PASSED! float16 chunks are " << errorF16 / errorChunked
+                  << "x more accurate than float16 accumulation, at "
+                  << errorChunked / std::max(errorF32, 1.0e-12) << "x the float32 error\n";
+    }
+
+    // Release device memory
+    CHECK_HIP_ERROR(hipFree(d_a));
+    CHECK_HIP_ERROR(hipFree(d_b));
+    CHECK_HIP_ERROR(hipFree(d_d));
+}
+
+int main()
+{
+    std::cout << "Accumulation, MatM, MatN, MatK, elapsedMs, TFlops/s, NormwiseError"
+              << std::endl;
+
+    for(auto k : {1024u, 4096u, 16384u})
+    {
+        gemm_test(256, 256, k);
+    }
+    return 0;
+}
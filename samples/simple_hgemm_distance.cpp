@@ -0,0 +1,624 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_fp16.h>
+#include <hip/hip_runtime.h>
+
+#include <rocwmma/rocwmma.hpp>
+#include <rocwmma/rocwmma_epilogue.hpp>
+#include <rocwmma/rocwmma_transforms.hpp>
+
+#include "common.hpp"
+
+using rocwmma::accumulator;
+using rocwmma::col_major;
+using rocwmma::float16_t;
+using rocwmma::float32_t;
+using rocwmma::float64_t;
+using rocwmma::matrix_a;
+using rocwmma::matrix_b;
+using rocwmma::row_major;
+
+// Supports ROCWMMA_M/N square sizes of
+// : 16 x 16
+// : 32 x 32 ( only MI )
+const int ROCWMMA_M = 16;
+const int ROCWMMA_N = 16;
+
+// Supports ROCWMMA_K sizes as
+// : multiples of 16.
+const int ROCWMMA_K = 16;
+
+// Device warp size
+const uint32_t WAVE_SIZE = getWarpSize();
+
+// Thread block
+// : T_BLOCK_X is one wave
+// Note: Each wave will compute one BLOCK_M x (BLOCK_N * SLICE_BLOCKS) slice
+// Note: Workgroup will compute
+//  1 x T_BLOCK_Y slices
+const int T_BLOCK_X = WAVE_SIZE;
+const int T_BLOCK_Y = 4;
+
+// Column blocks of Y visited by each wave
+const uint32_t SLICE_BLOCKS = 8;
+
+// Threads merging the slices of one row
+const uint32_t MERGE_THREADS = 256;
+
+// Inserts a candidate into a sorted list of the K nearest, ranking equal distances by lower index
+template <uint32_t K>
+__device__ inline void
+    insertNearest(float32_t (&dist)[K], int32_t (&idx)[K], float32_t value, int32_t index)
+{
+    for(uint32_t j = 0; j < K; j++)
+    {
+        if(value < dist[j]
+           || (value == dist[j] && static_cast<uint32_t>(index) < static_cast<uint32_t>(idx[j])))
+        {
+            auto tmpValue = dist[j];
+            auto tmpIndex = idx[j];
+            dist[j]       = value;
+            idx[j]        = index;
+            value         = tmpValue;
+            index         = tmpIndex;
+        }
+    }
+}
+
+// Norm terms of the rows of a row-major matrix (rows x k):
+// |x|^2 for squared euclidean distances, 1 / |x| for cosine distances.
+template <typename MetricT>
+__global__ void
+    norms_d(uint32_t rows, uint32_t k, float16_t const* x, uint32_t ldx, float32_t* norms)
+{
+    auto row = blockIdx.x * blockDim.x + threadIdx.x;
+    if(row >= rows)
+    {
+        return;
+    }
+
+    auto sum = 0.0f;
+    for(uint32_t h = 0; h < k; h++)
+    {
+        auto value = static_cast<float32_t>(x[static_cast<size_t>(row) * ldx + h]);
+        sum += value * value;
+    }
+
+    norms[row] = std::is_same_v<MetricT, rocwmma::epilogue::Cosine> ? rsqrtf(sum) : sum;
+}
+
+// The following device kernel is a naive implementation of the blocked distance
+// GEMM of a k-NN search or k-means assignment step. Each wave will compute one
+// BLOCK_M x (BLOCK_N * SLICE_BLOCKS) slice of the M x N x K GEMM:
+// D = dist(X, Y)
+//
+// Where:
+// : X holds the query points as rows    (M x K)
+// : Y holds the reference points as columns, e.g. k-means centroids (K x N)
+// : dist(x, y) = |x|^2 + |y|^2 - 2 x.y, or 1 - x.y / (|x| |y|)
+//
+// The PairwiseDistance epilogue stage turns the accumulators of each column block
+// into distances from the precomputed norms, and the K nearest columns of each row
+// are kept in registers: argmax_rows of the negated distances for K == 1, as for
+// k-means assignment, and topk_rows otherwise. Each slice only writes K candidates
+// per row, which a merge kernel combines. Un-fused, the M x N distances are written
+// to memory, and re-read by the same merge kernel.
+//
+// In this simplified example, we assume:
+// : X is in row-major format        (M x K)
+// : Y is in col-major format        (K x N)
+// : D is in col-major format        (M x N), when un-fused
+// : Candidates are in col-major format, (M x K) per slice
+// : M, N are multiples of BLOCK_M and BLOCK_N * SLICE_BLOCKS.
+//
+// Note: This is a simplified implementation to demonstrate API usage in
+// context of wave-level GEMM computation, and is not optimized.
+template <typename MetricT, uint32_t TopK, bool FuseNearest>
+__global__ void hgemm_distance_d(uint32_t         m,
+                                 uint32_t         n,
+                                 uint32_t         k,
+                                 float16_t const* x,
+                                 float16_t const* y,
+                                 float32_t const* rowNorms,
+                                 float32_t const* colNorms,
+                                 float32_t*       d,
+                                 float32_t*       candDist,
+                                 int32_t*         candIdx,
+                                 uint32_t         ldx,
+                                 uint32_t         ldy)
+{
+    using FragX
+        = rocwmma::fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, row_major>;
+    using FragY
+        = rocwmma::fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, col_major>;
+    using FragAcc = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float32_t>;
+    using FragIdx = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, int32_t>;
+
+    // Tile using a 2D grid
+    auto majorWarp = (blockIdx.x * blockDim.x + threadIdx.x) / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    auto minorWarp = (blockIdx.y * blockDim.y + threadIdx.y);
+
+    // Target block rows and column slice
+    auto cRow  = majorWarp * ROCWMMA_M;
+    auto slice = minorWarp;
+
+    if(cRow >= m || slice * SLICE_BLOCKS * ROCWMMA_N >= n)
+    {
+        return;
+    }
+
+    // Create frags
+    auto fragX       = FragX();
+    auto fragY       = FragY();
+    auto fragAcc     = FragAcc();
+    auto fragDist    = FragAcc();
+    auto fragRowNorm = FragAcc();
+    auto fragColNorm = FragAcc();
+
+    // Running K nearest of the slice, as the largest negated distances
+    FragAcc fragVals[TopK];
+    FragIdx fragIdx[TopK];
+
+    if constexpr(FuseNearest)
+    {
+        for(uint32_t j = 0; j < TopK; j++)
+        {
+            rocwmma::fill_fragment(fragVals[j], std::numeric_limits<float32_t>::lowest());
+            rocwmma::fill_fragment(fragIdx[j], -1);
+        }
+    }
+
+    rocwmma::load_col_vector_sync(fragRowNorm, rowNorms + cRow);
+
+    for(uint32_t b = 0; b < SLICE_BLOCKS; b++)
+    {
+        auto cCol = (slice * SLICE_BLOCKS + b) * ROCWMMA_N;
+
+        // fragAcc = X x Y
+        rocwmma::fill_fragment(fragAcc, 0.0f);
+        for(int i = 0; i < k; i += ROCWMMA_K)
+        {
+            // Load the inputs
+            rocwmma::load_matrix_sync(fragX, x + (cRow * ldx + i), ldx);
+            rocwmma::load_matrix_sync(fragY, y + (i + cCol * ldy), ldy);
+
+            // Matrix multiply - accumulate using MFMA units
+            rocwmma::mma_sync(fragAcc, fragX, fragY, fragAcc);
+        }
+
+        rocwmma::load_row_vector_sync(fragColNorm, colNorms + cCol);
+        auto distance = rocwmma::epilogue::PairwiseDistance(MetricT{}, fragRowNorm, fragColNorm);
+
+        if constexpr(FuseNearest)
+        {
+            // The nearest columns have the largest negated distances
+            rocwmma::apply_epilogue(
+                fragDist, fragAcc, distance, rocwmma::epilogue::TensorScale(-1.0f));
+
+            if constexpr(TopK == 1u)
+            {
+                rocwmma::argmax_rows(fragDist, cCol, fragVals[0], fragIdx[0]);
+            }
+            else
+            {
+                rocwmma::topk_rows(fragDist, cCol, fragVals, fragIdx);
+            }
+        }
+        else
+        {
+            // Store to D
+            rocwmma::apply_epilogue(fragDist, fragAcc, distance);
+            rocwmma::store_matrix_sync(d + (cRow + cCol * m), fragDist, m, rocwmma::mem_col_major);
+        }
+    }
+
+    if constexpr(FuseNearest)
+    {
+        // Store the candidate distances and columns of the slice as column vectors
+        for(uint32_t j = 0; j < TopK; j++)
+        {
+            for(uint32_t i = 0; i < FragAcc::num_elements; i++)
+            {
+                fragVals[j].x[i] = -fragVals[j].x[i];
+            }
+
+            auto offset = (slice * TopK + j) * m + cRow;
+            rocwmma::store_col_vector_sync(candDist + offset, fragVals[j]);
+            rocwmma::store_col_vector_sync(candIdx + offset, fragIdx[j]);
+        }
+    }
+}
+
+// Merges the candidates of one row into its K nearest columns, one workgroup per row.
+// Candidate c of the row is candDist[c * m + row], at column candIdx[c * m + row].
+// Without indices, each candidate is the distance of its own column.
+template <uint32_t TopK>
+__global__ void nearest_merge_d(uint32_t         m,
+                                uint32_t         candidates,
+                                float32_t const* candDist,
+                                int32_t const*   candIdx,
+                                float32_t*       nearestDist,
+                                int32_t*         nearestIdx)
+{
+    __shared__ float32_t ldsDist[MERGE_THREADS * TopK];
+    __shared__ int32_t   ldsIdx[MERGE_THREADS * TopK];
+
+    auto row = blockIdx.x;
+
+    float32_t dist[TopK];
+    int32_t   idx[TopK];
+    for(uint32_t j = 0; j < TopK; j++)
+    {
+        dist[j] = std::numeric_limits<float32_t>::max();
+        idx[j]  = -1;
+    }
+
+    // Strided candidates of each thread
+    for(uint32_t c = threadIdx.x; c < candidates; c += MERGE_THREADS)
+    {
+        auto value = candDist[static_cast<size_t>(c) * m + row];
+        auto index = candIdx != nullptr ? candIdx[static_cast<size_t>(c) * m + row]
+                                        : static_cast<int32_t>(c);
+        insertNearest(dist, idx, value, index);
+    }
+
+    for(uint32_t j = 0; j < TopK; j++)
+    {
+        ldsDist[threadIdx.x * TopK + j] = dist[j];
+        ldsIdx[threadIdx.x * TopK + j]  = idx[j];
+    }
+
+    __syncthreads();
+
+    // Merge the threads
+    if(threadIdx.x == 0)
+    {
+        for(uint32_t t = 1; t < MERGE_THREADS; t++)
+        {
+            for(uint32_t j = 0; j < TopK; j++)
+            {
+                insertNearest(dist, idx, ldsDist[t * TopK + j], ldsIdx[t * TopK + j]);
+            }
+        }
+
+        for(uint32_t j = 0; j < TopK; j++)
+        {
+            nearestDist[row * TopK + j] = dist[j];
+            nearestIdx[row * TopK + j]  = idx[j];
+        }
+    }
+}
+
+// Host reference of the distances of the rows of X to the columns of Y, row-major (M x N)
+template <typename MetricT>
+__host__ void distance_cpu_h(uint32_t         m,
+                             uint32_t         n,
+                             uint32_t         k,
+                             float16_t const* x,
+                             float16_t const* y,
+                             float64_t*       dist,
+                             uint32_t         ldx,
+                             uint32_t         ldy)
+{
+#pragma omp parallel for
+    for(int i = 0; i < m; ++i)
+    {
+        for(int j = 0; j < n; ++j)
+        {
+            auto dot   = 0.0;
+            auto normX = 0.0;
+            auto normY = 0.0;
+            for(int h = 0; h < k; ++h)
+            {
+                auto xh = static_cast<float64_t>(x[i * ldx + h]);
+                auto yh = static_cast<float64_t>(y[static_cast<size_t>(j) * ldy + h]);
+                dot += xh * yh;
+                normX += xh * xh;
+                normY += yh * yh;
+            }
+
+            dist[static_cast<size_t>(i) * n + j]
+                = std::is_same_v<MetricT, rocwmma::epilogue::Cosine>
+                      ? 1.0 - dot / std::sqrt(normX * normY)
+                      : std::max(normX + normY - 2.0 * dot, 0.0);
+        }
+    }
+}
+
+template <typename MetricT, uint32_t TopK>
+__host__ void gemm_test(char const* name, uint32_t m, uint32_t n, uint32_t k)
+{
+    // Bounds check
+    if((m < ROCWMMA_M || n < (ROCWMMA_N * SLICE_BLOCKS) || k < ROCWMMA_K)
+       || (m % ROCWMMA_M || n % (ROCWMMA_N * SLICE_BLOCKS) || k % ROCWMMA_K))
+    {
+        std::cout << "Unsupported size!\n";
+        return;
+    }
+
+    int      ldx    = k;
+    int      ldy    = k;
+    uint32_t slices = n / (ROCWMMA_N * SLICE_BLOCKS);
+
+    std::cout << "Initializing host data..." << std::endl;
+
+    // Initialize points with small integer coordinates
+    std::vector<float16_t> matrixX(m * k);
+    std::vector<float16_t> matrixY(static_cast<size_t>(k) * n);
+    fillRand(matrixX.data(), m, k);
+    fillRand(matrixY.data(), k, n);
+
+    std::vector<float32_t> nearestDist(m * TopK);
+    std::vector<int32_t>   nearestIdx(m * TopK);
+    std::vector<float32_t> nearestDistUnfused(m * TopK);
+    std::vector<int32_t>   nearestIdxUnfused(m * TopK);
+
+    std::cout << "Initializing device data..." << std::endl;
+
+    // Allocate and copy device memory
+    float16_t* d_x;
+    float16_t* d_y;
+    float32_t* d_rowNorms;
+    float32_t* d_colNorms;
+    float32_t* d_d;
+    float32_t* d_candDist;
+    int32_t*   d_candIdx;
+    float32_t* d_nearestDist;
+    int32_t*   d_nearestIdx;
+
+    const size_t bytesX       = matrixX.size() * sizeof(float16_t);
+    const size_t bytesY       = matrixY.size() * sizeof(float16_t);
+    const size_t bytesD       = static_cast<size_t>(m) * n * sizeof(float32_t);
+    const size_t bytesCand    = slices * TopK * m * sizeof(float32_t);
+    const size_t bytesNearest = m * TopK * sizeof(float32_t);
+
+    CHECK_HIP_ERROR(hipMalloc(&d_x, bytesX));
+    CHECK_HIP_ERROR(hipMalloc(&d_y, bytesY));
+    CHECK_HIP_ERROR(hipMalloc(&d_rowNorms, m * sizeof(float32_t)));
+    CHECK_HIP_ERROR(hipMalloc(&d_colNorms, n * sizeof(float32_t)));
+    CHECK_HIP_ERROR(hipMalloc(&d_d, bytesD));
+    CHECK_HIP_ERROR(hipMalloc(&d_candDist, bytesCand));
+    CHECK_HIP_ERROR(hipMalloc(&d_candIdx, bytesCand));
+    CHECK_HIP_ERROR(hipMalloc(&d_nearestDist, bytesNearest));
+    CHECK_HIP_ERROR(hipMalloc(&d_nearestIdx, bytesNearest));
+
+    CHECK_HIP_ERROR(hipMemcpy(d_x, matrixX.data(), bytesX, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_y, matrixY.data(), bytesY, hipMemcpyHostToDevice));
+
+    // Norms are computed once, e.g. per k-means iteration for the centroids
+    hipLaunchKernelGGL(norms_d<MetricT>,
+                       dim3(rocwmma::ceilDiv(m, MERGE_THREADS)),
+                       dim3(MERGE_THREADS),
+                       0, // sharedMemBytes
+                       0, // stream
+                       m,
+                       k,
+                       d_x,
+                       ldx,
+                       d_rowNorms);
+    hipLaunchKernelGGL(norms_d<MetricT>,
+                       dim3(rocwmma::ceilDiv(n, MERGE_THREADS)),
+                       dim3(MERGE_THREADS),
+                       0, // sharedMemBytes
+                       0, // stream
+                       n,
+                       k,
+                       d_y,
+                       ldy,
+                       d_colNorms);
+
+    auto blockDim = dim3(T_BLOCK_X, T_BLOCK_Y);
+    auto gridDim  = dim3(rocwmma::ceilDiv(m, ROCWMMA_M), rocwmma::ceilDiv(slices, T_BLOCK_Y));
+
+    hipEvent_t startEvent, stopEvent;
+    CHECK_HIP_ERROR(hipEventCreate(&startEvent));
+    CHECK_HIP_ERROR(hipEventCreate(&stopEvent));
+
+    std::cout << "Launching fused nearest distance GEMM and merge kernels..." << std::endl;
+
+    auto fusedTimeMs = 0.0f;
+    CHECK_HIP_ERROR(hipEventRecord(startEvent));
+    hipLaunchKernelGGL((hgemm_distance_d<MetricT, TopK, true>),
+                       gridDim,
+                       blockDim,
+                       0, // sharedMemBytes
+                       0, // stream
+                       m,
+                       n,
+                       k,
+                       d_x,
+                       d_y,
+                       d_rowNorms,
+                       d_colNorms,
+                       d_d,
+                       d_candDist,
+                       d_candIdx,
+                       ldx,
+                       ldy);
+    hipLaunchKernelGGL(nearest_merge_d<TopK>,
+                       dim3(m),
+                       dim3(MERGE_THREADS),
+                       0, // sharedMemBytes
+                       0, // stream
+                       m,
+                       slices * TopK,
+                       d_candDist,
+                       d_candIdx,
+                       d_nearestDist,
+                       d_nearestIdx);
+    CHECK_HIP_ERROR(hipEventRecord(stopEvent));
+    CHECK_HIP_ERROR(hipEventSynchronize(stopEvent));
+    CHECK_HIP_ERROR(hipEventElapsedTime(&fusedTimeMs, startEvent, stopEvent));
+    CHECK_HIP_ERROR(
+        hipMemcpy(nearestDist.data(), d_nearestDist, bytesNearest, hipMemcpyDeviceToHost));
+    CHECK_HIP_ERROR(
+        hipMemcpy(nearestIdx.data(), d_nearestIdx, bytesNearest, hipMemcpyDeviceToHost));
+
+    std::cout << "Launching un-fused distance GEMM and merge kernels..." << std::endl;
+
+    auto unfusedTimeMs = 0.0f;
+    CHECK_HIP_ERROR(hipEventRecord(startEvent));
+    hipLaunchKernelGGL((hgemm_distance_d<MetricT, TopK, false>),
+                       gridDim,
+                       blockDim,
+                       0, // sharedMemBytes
+                       0, // stream
+                       m,
+                       n,
+                       k,
+                       d_x,
+                       d_y,
+                       d_rowNorms,
+                       d_colNorms,
+                       d_d,
+                       d_candDist,
+                       d_candIdx,
+                       ldx,
+                       ldy);
+    hipLaunchKernelGGL(nearest_merge_d<TopK>,
+                       dim3(m),
+                       dim3(MERGE_THREADS),
+                       0, // sharedMemBytes
+                       0, // stream
+                       m,
+                       n,
+                       d_d,
+                       nullptr,
+                       d_nearestDist,
+                       d_nearestIdx);
+    CHECK_HIP_ERROR(hipEventRecord(stopEvent));
+    CHECK_HIP_ERROR(hipEventSynchronize(stopEvent));
+    CHECK_HIP_ERROR(hipEventElapsedTime(&unfusedTimeMs, startEvent, stopEvent));
+    CHECK_HIP_ERROR(
+        hipMemcpy(nearestDistUnfused.data(), d_nearestDist, bytesNearest, hipMemcpyDeviceToHost));
+    CHECK_HIP_ERROR(
+        hipMemcpy(nearestIdxUnfused.data(), d_nearestIdx, bytesNearest, hipMemcpyDeviceToHost));
+
+    CHECK_HIP_ERROR(hipEventDestroy(startEvent));
+    CHECK_HIP_ERROR(hipEventDestroy(stopEvent));
+
+    // GEMM flops converge to 2*mnk
+    auto gFlops       = calculateGFlops(m, n, k);
+    auto tFlopsPerSec = gFlops / static_cast<double>(fusedTimeMs);
+
+    // Echo performance
+    std::cout << "Search, BlkM, BlkN, BlkK, "
+              << "MatM, MatN, MatK, "
+              << "topK, fusedMs, unfusedMs, "
+              << "Problem Size(GFlops), TFlops/s" << std::endl;
+
+    std::cout << name << ", " << ROCWMMA_M << ", " << ROCWMMA_N << ", " << ROCWMMA_K << ", " << m
+              << ", " << n << ", " << k << ", " << TopK << ", " << fusedTimeMs << ", "
+              << unfusedTimeMs << ", " << gFlops << ", " << tFlopsPerSec << std::endl;
+
+#if !NDEBUG
+
+    std::cout << "Validating result with reference..." << std::endl;
+
+    std::vector<float64_t> dist_ref(static_cast<size_t>(m) * n);
+    distance_cpu_h<MetricT>(m, n, k, matrixX.data(), matrixY.data(), dist_ref.data(), ldx, ldy);
+
+    // Device distances are checked against the reference K nearest, and against the
+    // reference distances of the selected columns, at half precision tolerance.
+    // Near ties may select columns in either order.
+    auto validate = [&](std::vector<int32_t> const& idx, std::vector<float32_t> const& dist) {
+        std::vector<float16_t> nearest(m * TopK);
+        std::vector<float16_t> nearest_ref(m * TopK);
+        std::vector<float16_t> selected_ref(m * TopK);
+        std::vector<float64_t> row(TopK);
+
+        for(int i = 0; i < m; ++i)
+        {
+            auto const* p = dist_ref.data() + static_cast<size_t>(i) * n;
+            std::partial_sort_copy(p, p + n, row.begin(), row.end());
+
+            for(int j = 0; j < TopK; ++j)
+            {
+                auto index                 = idx[i * TopK + j];
+                nearest[i * TopK + j]      = static_cast<float16_t>(dist[i * TopK + j]);
+                nearest_ref[i * TopK + j]  = static_cast<float16_t>(row[j]);
+                selected_ref[i * TopK + j] = static_cast<float16_t>(
+                    index >= 0 && index < n ? p[index] : std::numeric_limits<float32_t>::max());
+            }
+        }
+
+        auto resNearest  = compareEqual<float16_t>(nearest.data(), nearest_ref.data(), m * TopK);
+        auto resSelected = compareEqual<float16_t>(nearest.data(), selected_ref.data(), m * TopK);
+        return std::make_pair(std::get<0>(resNearest) && std::get<0>(resSelected),
+                              std::max(std::get<1>(resNearest), std::get<1>(resSelected)));
+    };
+
+    auto res        = validate(nearestIdx, nearestDist);
+    auto resUnfused = validate(nearestIdxUnfused, nearestDistUnfused);
+
+    if(std::get<0>(res) == false || std::get<0>(resUnfused) == false)
+    {
+        std::cout << "FAILED!\n";
+    }
+    else
+    {
+        std::cout << "PASSED!\n";
+    }
+
+    std::cout << "Max relative error: " << std::get<1>(res) << std::endl;
+
+#endif // !NDEBUG
+
+    // Release device memory
+    CHECK_HIP_ERROR(hipFree(d_x));
+    CHECK_HIP_ERROR(hipFree(d_y));
+    CHECK_HIP_ERROR(hipFree(d_rowNorms));
+    CHECK_HIP_ERROR(hipFree(d_colNorms));
+    CHECK_HIP_ERROR(hipFree(d_d));
+    CHECK_HIP_ERROR(hipFree(d_candDist));
+    CHECK_HIP_ERROR(hipFree(d_candIdx));
+    CHECK_HIP_ERROR(hipFree(d_nearestDist));
+    CHECK_HIP_ERROR(hipFree(d_nearestIdx));
+
+    std::cout << "Finished!" << std::endl;
+}
+
+int main()
+{
+    using rocwmma::epilogue::Cosine;
+    using rocwmma::epilogue::SquaredEuclidean;
+
+    // k-means assignment of 65536 points to 1024 centroids of 128 dims
+    gemm_test<SquaredEuclidean, 1u>("kmeans", 65536, 1024, 128);
+
+    // 8 nearest neighbours of 1024 queries in 65536 points of 128 dims, by cosine distance
+    gemm_test<Cosine, 8u>("knn", 1024, 65536, 128);
+    return 0;
+}
@@ -0,0 +1,512 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <iostream>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_fp16.h>
+#include <hip/hip_runtime.h>
+
+#include <rocwmma/rocwmma.hpp>
+#include <rocwmma/rocwmma_epilogue.hpp>
+
+#include "common.hpp"
+
+using rocwmma::accumulator;
+using rocwmma::col_major;
+using rocwmma::float16_t;
+using rocwmma::float32_t;
+using rocwmma::matrix_a;
+using rocwmma::matrix_b;
+using rocwmma::row_major;
+
+// Supports ROCWMMA_M/N square sizes of
+// : 16 x 16
+// : 32 x 32 ( only MI )
+const int ROCWMMA_M = 16;
+const int ROCWMMA_N = 16;
+
+// Supports ROCWMMA_K sizes as
+// : multiples of 16.
+const int ROCWMMA_K = 16;
+
+// Device warp size
+const uint32_t WAVE_SIZE = getWarpSize();
+
+// Thread block
+// : T_BLOCK_X must be multiple of WAVE_SIZE.
+// Note: Each wave will compute one BLOCK_M x BLOCK_N output block
+// Note: Workgroup will compute
+//  T_BLOCK_X / WAVE_SIZE x T_BLOCK_Y output blocks
+const int T_BLOCK_X = 4 * WAVE_SIZE;
+const int T_BLOCK_Y = 4;
+
+// Element-wise passes of the unfused path
+const int PASS_BLOCK = 256;
+
+// Bit-packed mask words of each output block
+constexpr int MASK_WORDS = ROCWMMA_M * ROCWMMA_N / 32;
+
+// Dropout random stream: the offset would advance every training step
+constexpr uint64_t  DROPOUT_SEED   = 0x2545F4914F6CDD1Dull;
+constexpr uint64_t  DROPOUT_OFFSET = 0u;
+constexpr float32_t DROPOUT_P      = 0.1f;
+
+using FragAcc = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float32_t>;
+using FragOut = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t>;
+
+// Dropout decision of the element at (row, col), shared by the unfused passes and the host
+// reference. The Dropout epilogue stage draws the same numbers from the matrix coordinates.
+__host__ __device__ inline bool dropoutKeep(uint32_t row, uint32_t col)
+{
+    auto rand = rocwmma::detail::Philox4x32::generate(DROPOUT_SEED,
+                                                      {static_cast<uint32_t>(DROPOUT_OFFSET),
+                                                       static_cast<uint32_t>(DROPOUT_OFFSET >> 32u),
+                                                       row,
+                                                       col});
+    return rand.x >= static_cast<uint32_t>(DROPOUT_P * 4294967296.0f);
+}
+
+// The following device kernel is a naive implementation of blocked GEMM
+// with fused dropout. Each wave will compute one BLOCK_M x BLOCK_N output
+// block of the M x N x K GEMM:
+// D = dropout(A x B)
+//
+// The Dropout stage draws a Philox random number for each accumulator element,
+// keyed by the seed, the offset and the matrix coordinate of the element, and
+// records the kept elements as bits of a register. The bits of the block are
+// packed with one ballot per element and stored as a mask of 1 bit per element,
+// for the backward pass.
+//
+// In this simplified example, we assume:
+// : A is in row-major format        (M x K)
+// : B is in col-major format        (K x N)
+// : D is in row-major format        (M x N)
+// : The mask is stored per block, in row-major block order
+// : No LDS required
+//
+// Note: This is a simplified implementation to demonstrate API usage in
+// context of wave-level GEMM computation, and is not optimized.
+__global__ void hgemm_dropout_rocwmma_d(uint32_t         m,
+                                        uint32_t         n,
+                                        uint32_t         k,
+                                        float16_t const* a,
+                                        float16_t const* b,
+                                        float16_t*       d,
+                                        uint32_t*        mask,
+                                        uint32_t         lda,
+                                        uint32_t         ldb,
+                                        uint32_t         ldd)
+{
+    // Create frags
+    auto fragA
+        = rocwmma::fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, row_major>();
+    auto fragB
+        = rocwmma::fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, col_major>();
+    auto fragD   = FragOut();
+    auto fragAcc = FragAcc();
+
+    rocwmma::fill_fragment(fragAcc, 0.0f);
+
+    // Tile using a 2D grid
+    auto majorWarp = (blockIdx.x * blockDim.x + threadIdx.x) / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    auto minorWarp = (blockIdx.y * blockDim.y + threadIdx.y);
+
+    // Target D block
+    auto cRow = majorWarp * ROCWMMA_M;
+    auto cCol = minorWarp * ROCWMMA_N;
+
+    // Bounds check
+    if(cRow < m && cCol < n)
+    {
+        // fragAcc = A x B
+        for(int i = 0; i < k; i += ROCWMMA_K)
+        {
+            rocwmma::load_matrix_sync(fragA, a + (cRow * lda + i), lda);
+            rocwmma::load_matrix_sync(fragB, b + (i + cCol * ldb), ldb);
+            rocwmma::mma_sync(fragAcc, fragA, fragB, fragAcc);
+        }
+
+        // D = dropout(acc), recording the kept elements
+        uint32_t keepBits;
+        auto     dropout = rocwmma::epilogue::Dropout<FragAcc>(
+            DROPOUT_SEED, DROPOUT_OFFSET, DROPOUT_P, rocwmma::make_coord2d(cRow, cCol), &keepBits);
+        rocwmma::apply_epilogue(fragD, fragAcc, dropout);
+
+        // Store D and the mask bits of the block
+        auto block = (cRow / ROCWMMA_M) * (n / ROCWMMA_N) + cCol / ROCWMMA_N;
+        rocwmma::store_matrix_sync(d + (cRow * ldd + cCol), fragD, ldd, rocwmma::mem_row_major);
+        rocwmma::store_dropout_mask_sync<FragAcc>(mask + block * MASK_WORDS, keepBits);
+    }
+}
+
+// Backward of the fused dropout: dX = dY * mask / (1 - p), with the bit-packed mask
+__global__ void dropout_backward_rocwmma_d(uint32_t         m,
+                                           uint32_t         n,
+                                           float16_t const* dy,
+                                           uint32_t const*  mask,
+                                           float16_t*       dx,
+                                           uint32_t         ldd)
+{
+    auto fragDY = FragOut();
+    auto fragDX = FragOut();
+
+    auto majorWarp = (blockIdx.x * blockDim.x + threadIdx.x) / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    auto minorWarp = (blockIdx.y * blockDim.y + threadIdx.y);
+
+    auto cRow = majorWarp * ROCWMMA_M;
+    auto cCol = minorWarp * ROCWMMA_N;
+
+    if(cRow < m && cCol < n)
+    {
+        auto block    = (cRow / ROCWMMA_M) * (n / ROCWMMA_N) + cCol / ROCWMMA_N;
+        auto keepBits = rocwmma::load_dropout_mask_sync<FragAcc>(mask + block * MASK_WORDS);
+
+        rocwmma::load_matrix_sync(fragDY, dy + (cRow * ldd + cCol), ldd, rocwmma::mem_row_major);
+        rocwmma::apply_epilogue(
+            fragDX, fragDY, rocwmma::epilogue::DropoutMask(keepBits, DROPOUT_P));
+        rocwmma::store_matrix_sync(dx + (cRow * ldd + cCol), fragDX, ldd, rocwmma::mem_row_major);
+    }
+}
+
+// Unfused: the same GEMM, storing P = A x B in float32_t
+__global__ void hgemm_rocwmma_d(uint32_t         m,
+                                uint32_t         n,
+                                uint32_t         k,
+                                float16_t const* a,
+                                float16_t const* b,
+                                float32_t*       p,
+                                uint32_t         lda,
+                                uint32_t         ldb,
+                                uint32_t         ldp)
+{
+    auto fragA
+        = rocwmma::fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, row_major>();
+    auto fragB
+        = rocwmma::fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, col_major>();
+    auto fragAcc = FragAcc();
+
+    rocwmma::fill_fragment(fragAcc, 0.0f);
+
+    auto majorWarp = (blockIdx.x * blockDim.x + threadIdx.x) / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    auto minorWarp = (blockIdx.y * blockDim.y + threadIdx.y);
+
+    auto cRow = majorWarp * ROCWMMA_M;
+    auto cCol = minorWarp * ROCWMMA_N;
+
+    if(cRow < m && cCol < n)
+    {
+        for(int i = 0; i < k; i += ROCWMMA_K)
+        {
+            rocwmma::load_matrix_sync(fragA, a + (cRow * lda + i), lda);
+            rocwmma::load_matrix_sync(fragB, b + (i + cCol * ldb), ldb);
+            rocwmma::mma_sync(fragAcc, fragA, fragB, fragAcc);
+        }
+
+        rocwmma::store_matrix_sync(p + (cRow * ldp + cCol), fragAcc, ldp, rocwmma::mem_row_major);
+    }
+}
+
+// Unfused pass: D = dropout(P), with a byte per element mask
+__global__ void dropout_d(uint32_t         m,
+                          uint32_t         n,
+                          float32_t const* p,
+                          float16_t*       d,
+                          uint8_t*         mask)
+{
+    auto idx = blockIdx.x * PASS_BLOCK + threadIdx.x;
+    if(idx < m * n)
+    {
+        auto keep = dropoutKeep(idx / n, idx % n);
+        d[idx]    = keep ? static_cast<float16_t>(p[idx] * (1.0f / (1.0f - DROPOUT_P)))
+                         : static_cast<float16_t>(0.0f);
+        mask[idx] = keep;
+    }
+}
+
+// Unfused backward: dX = dY * mask / (1 - p), with the byte per element mask
+__global__ void
+    dropout_backward_d(uint32_t size, float16_t const* dy, uint8_t const* mask, float16_t* dx)
+{
+    auto idx = blockIdx.x * PASS_BLOCK + threadIdx.x;
+    if(idx < size)
+    {
+        dx[idx] = mask[idx] ? dy[idx] * static_cast<float16_t>(1.0f / (1.0f - DROPOUT_P))
+                            : static_cast<float16_t>(0.0f);
+    }
+}
+
+__host__ void gemm_test(uint32_t m, uint32_t n, uint32_t k)
+{
+    // Bounds check
+    if((m < (ROCWMMA_M * T_BLOCK_X / WAVE_SIZE) || n < (ROCWMMA_N * T_BLOCK_Y) || k < ROCWMMA_K)
+       || (m % ROCWMMA_M || n % ROCWMMA_N || k % ROCWMMA_K))
+    {
+        std::cout << "Unsupported size!\n";
+        return;
+    }
+
+    int lda = k;
+    int ldb = k;
+    int ldd = n;
+
+    std::cout << "Initializing host data..." << std::endl;
+
+    // Initialize input matrices
+    std::vector<float16_t> matrixA(m * k);
+    std::vector<float16_t> matrixB(k * n);
+    std::vector<float16_t> matrixDY(m * n);
+
+    fillRand(matrixA.data(), m, k);
+    fillRand(matrixB.data(), k, n);
+    fillRand(matrixDY.data(), m, n);
+
+    std::cout << "Initializing device data..." << std::endl;
+
+    // Allocate and copy device memory
+    float16_t* d_a;
+    float16_t* d_b;
+    float16_t* d_d;
+    float32_t* d_p;
+    float16_t* d_dy;
+    float16_t* d_dx;
+    uint32_t*  d_maskBits;
+    uint8_t*   d_maskBytes;
+
+    const size_t bytesA         = matrixA.size() * sizeof(float16_t);
+    const size_t bytesB         = matrixB.size() * sizeof(float16_t);
+    const size_t bytesD         = m * n * sizeof(float16_t);
+    const size_t bytesP         = m * n * sizeof(float32_t);
+    const size_t bytesMaskBits  = m * n / 8u;
+    const size_t bytesMaskBytes = m * n * sizeof(uint8_t);
+
+    CHECK_HIP_ERROR(hipMalloc(&d_a, bytesA));
+    CHECK_HIP_ERROR(hipMalloc(&d_b, bytesB));
+    CHECK_HIP_ERROR(hipMalloc(&d_d, bytesD));
+    CHECK_HIP_ERROR(hipMalloc(&d_p, bytesP));
+    CHECK_HIP_ERROR(hipMalloc(&d_dy, bytesD));
+    CHECK_HIP_ERROR(hipMalloc(&d_dx, bytesD));
+    CHECK_HIP_ERROR(hipMalloc(&d_maskBits, bytesMaskBits));
+    CHECK_HIP_ERROR(hipMalloc(&d_maskBytes, bytesMaskBytes));
+
+    CHECK_HIP_ERROR(hipMemcpy(d_a, matrixA.data(), bytesA, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_b, matrixB.data(), bytesB, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_dy, matrixDY.data(), bytesD, hipMemcpyHostToDevice));
+
+    auto blockDim = dim3(T_BLOCK_X, T_BLOCK_Y);
+    auto gridDim  = dim3(rocwmma::ceilDiv(m, ROCWMMA_M * T_BLOCK_X / WAVE_SIZE),
+                        rocwmma::ceilDiv(n, ROCWMMA_N * T_BLOCK_Y));
+
+    auto passBlocks = dim3(rocwmma::ceilDiv(m * n, PASS_BLOCK));
+
+    hipEvent_t startEvent, stopEvent;
+    CHECK_HIP_ERROR(hipEventCreate(&startEvent));
+    CHECK_HIP_ERROR(hipEventCreate(&stopEvent));
+
+    // Runs the kernels on the null stream, and returns the elapsed time
+    auto timed = [&](auto&& kernels) {
+        CHECK_HIP_ERROR(hipEventRecord(startEvent));
+        kernels();
+        CHECK_HIP_ERROR(hipEventRecord(stopEvent));
+        CHECK_HIP_ERROR(hipEventSynchronize(stopEvent));
+
+        auto elapsedTimeMs = 0.0f;
+        CHECK_HIP_ERROR(hipEventElapsedTime(&elapsedTimeMs, startEvent, stopEvent));
+        return elapsedTimeMs;
+    };
+
+    auto fusedForward = [&]() {
+        hipLaunchKernelGGL(hgemm_dropout_rocwmma_d,
+                           gridDim,
+                           blockDim,
+                           0,
+                           0,
+                           m,
+                           n,
+                           k,
+                           d_a,
+                           d_b,
+                           d_d,
+                           d_maskBits,
+                           lda,
+                           ldb,
+                           ldd);
+    };
+
+    auto fusedBackward = [&]() {
+        hipLaunchKernelGGL(dropout_backward_rocwmma_d,
+                           gridDim,
+                           blockDim,
+                           0,
+                           0,
+                           m,
+                           n,
+                           d_dy,
+                           d_maskBits,
+                           d_dx,
+                           ldd);
+    };
+
+    auto unfusedForward = [&]() {
+        hipLaunchKernelGGL(hgemm_rocwmma_d,
+                           gridDim,
+                           blockDim,
+                           0,
+                           0,
+                           m,
+                           n,
+                           k,
+                           d_a,
+                           d_b,
+                           d_p,
+                           lda,
+                           ldb,
+                           ldd);
+        hipLaunchKernelGGL(
+            dropout_d, passBlocks, dim3(PASS_BLOCK), 0, 0, m, n, d_p, d_d, d_maskBytes);
+    };
+
+    auto unfusedBackward = [&]() {
+        hipLaunchKernelGGL(dropout_backward_d,
+                           passBlocks,
+                           dim3(PASS_BLOCK),
+                           0,
+                           0,
+                           m * n,
+                           d_dy,
+                           d_maskBytes,
+                           d_dx);
+    };
+
+#if !NDEBUG
+
+    // Reference in float32_t: P = A x B, D = dropout(P) and dX = dropout'(dY)
+    std::vector<float32_t> matrixP_ref(m * n, 0.0f);
+    gemm_cpu_h<float16_t, float32_t, float32_t, row_major, col_major, row_major>(
+        m,
+        n,
+        k,
+        matrixA.data(),
+        matrixB.data(),
+        matrixP_ref.data(),
+        matrixP_ref.data(),
+        lda,
+        ldb,
+        ldd,
+        ldd,
+        1.0f,
+        0.0f);
+
+    auto                   scale = 1.0f / (1.0f - DROPOUT_P);
+    std::vector<float16_t> matrixD_ref(m * n);
+    std::vector<float16_t> matrixDX_ref(m * n);
+    auto                   kept = 0u;
+    for(uint32_t i = 0; i < m; i++)
+    {
+        for(uint32_t j = 0; j < n; j++)
+        {
+            auto keep = dropoutKeep(i, j);
+            auto p    = matrixP_ref[i * n + j];
+            auto dy   = static_cast<float32_t>(matrixDY[i * n + j]);
+
+            matrixD_ref[i * n + j]  = static_cast<float16_t>(keep ? p * scale : 0.0f);
+            matrixDX_ref[i * n + j] = static_cast<float16_t>(keep ? dy * scale : 0.0f);
+            kept += keep;
+        }
+    }
+
+    std::cout << "Kept fraction: " << static_cast<double>(kept) / (m * n)
+              << ", expected: " << 1.0f - DROPOUT_P << std::endl;
+
+    auto validate = [&]() {
+        std::vector<float16_t> matrixD(m * n);
+        std::vector<float16_t> matrixDX(m * n);
+
+        CHECK_HIP_ERROR(hipMemcpy(matrixD.data(), d_d, bytesD, hipMemcpyDeviceToHost));
+        CHECK_HIP_ERROR(hipMemcpy(matrixDX.data(), d_dx, bytesD, hipMemcpyDeviceToHost));
+
+        auto resD  = compareEqual(matrixD.data(), matrixD_ref.data(), m * n);
+        auto resDX = compareEqual(matrixDX.data(), matrixDX_ref.data(), m * n);
+
+        for(auto [name, res] : {std::make_pair("D", resD), std::make_pair("dX", resDX)})
+        {
+            std::cout << name << ": " << (std::get<0>(res) ? "PASSED" : "FAILED")
+                      << ", max relative error: " << std::get<1>(res) << std::endl;
+        }
+    };
+
+#endif // !NDEBUG
+
+    std::cout << "Kernels, MatM, MatN, MatK, MaskBytes, Forward elapsedMs, Backward elapsedMs, "
+              << "Problem Size(GFlops), TFlops/s" << std::endl;
+
+    auto gFlops = calculateGFlops(m, n, k);
+    auto echo   = [&](const char* name, size_t maskBytes, float forwardMs, float backwardMs) {
+        std::cout << name << ", " << m << ", " << n << ", " << k << ", " << maskBytes << ", "
+                  << forwardMs << ", " << backwardMs << ", " << gFlops << ", "
+                  << gFlops / static_cast<double>(forwardMs) << std::endl;
+    };
+
+    auto unfusedForwardMs = timed(unfusedForward);
+    echo("Unfused", bytesMaskBytes, unfusedForwardMs, timed(unfusedBackward));
+
+#if !NDEBUG
+    validate();
+#endif // !NDEBUG
+
+    // Fill outputs with NaN to catch contamination
+    CHECK_HIP_ERROR(hipMemset(d_d, 0xFF, bytesD));
+    CHECK_HIP_ERROR(hipMemset(d_dx, 0xFF, bytesD));
+
+    auto fusedForwardMs = timed(fusedForward);
+    echo("FusedDropout", bytesMaskBits, fusedForwardMs, timed(fusedBackward));
+
+#if !NDEBUG
+    validate();
+#endif // !NDEBUG
+
+    CHECK_HIP_ERROR(hipEventDestroy(startEvent));
+    CHECK_HIP_ERROR(hipEventDestroy(stopEvent));
+
+    // Release device memory
+    CHECK_HIP_ERROR(hipFree(d_a));
+    CHECK_HIP_ERROR(hipFree(d_b));
+    CHECK_HIP_ERROR(hipFree(d_d));
+    CHECK_HIP_ERROR(hipFree(d_p));
+    CHECK_HIP_ERROR(hipFree(d_dy));
+    CHECK_HIP_ERROR(hipFree(d_dx));
+    CHECK_HIP_ERROR(hipFree(d_maskBits));
+    CHECK_HIP_ERROR(hipFree(d_maskBytes));
+
+    std::cout << "Finished!" << std::endl;
+}
+
+int main()
+{
+    gemm_test(256, 256, 256);
+    gemm_test(2048, 2048, 2048);
+    return 0;
+}
@@ -0,0 +1,523 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <iostream>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_fp16.h>
+#include <hip/hip_runtime.h>
+
+#include <rocwmma/rocwmma.hpp>
+
+#include "benchmark_harness.hpp"
+#include "common.hpp"
+
+using rocwmma::accumulator;
+using rocwmma::col_major;
+using rocwmma::float16_t;
+using rocwmma::float32_t;
+using rocwmma::float64_t;
+using rocwmma::matrix_a;
+using rocwmma::matrix_b;
+using rocwmma::row_major;
+
+// Supports ROCWMMA_M/N square sizes of
+// : 16 x 16
+// : 32 x 32 ( only MI )
+const int ROCWMMA_M = 16;
+const int ROCWMMA_N = 16;
+
+// Supports ROCWMMA_K sizes as
+// : multiples of 16.
+const int ROCWMMA_K = 16;
+
+// Device warp size
+const uint32_t WAVE_SIZE = getWarpSize();
+
+// Thread block
+// : T_BLOCK_X must be multiple of WAVE_SIZE.
+// Note: Each wave will compute one BLOCK_M x BLOCK_N output block
+// Note: Workgroup will compute
+//  T_BLOCK_X / WAVE_SIZE x T_BLOCK_Y output blocks
+const int T_BLOCK_X = 2 * WAVE_SIZE;
+const int T_BLOCK_Y = 2;
+
+// The following device kernels compute the attention scores of a transformer,
+// as the tensor contraction (einsum "bshd,bthd->bhst"):
+// S[b, h, s, t] = alpha * sum_d (Q[b, s, h, d] * K[b, t, h, d]) + beta * C[b, h, s, t]
+//
+// Q and K are in the BSHD layout produced by the QKV projection, while the
+// scores are in the BHST layout. Each (b, h) pair is an independent GEMM of
+// (S x D) x (D x T), however the rows of one head are strided by H * D in
+// BSHD, which does not fit the fixed lda of a strided batched GEMM.
+//
+// : Permute + StridedBatched: Q and K are first permuted to BHSD, such that the
+//   heads are packed matrices of a strided batched GEMM. Each permute pass reads
+//   and writes the whole tensor.
+// : Contraction: the tensor_contraction of the einsum expression folds the b, h,
+//   s, t and d modes into the batch and GEMM coordinates. Fragments are loaded
+//   in place from BSHD through their tensor_view, and no permute pass is needed.
+//
+// In this simplified example, we assume:
+// : Q, K and C, S are packed BSHD, BTHD and BHST tensors
+// : S and T are multiples of the output block sizes, and D of ROCWMMA_K
+// : No LDS required
+//
+// Note: This is a simplified implementation to demonstrate API usage in
+// context of wave-level GEMM computation, and is not optimized.
+
+// Computes one BLOCK_M x BLOCK_N output block of batch blockIdx.z, addressing
+// every tensor through its matrix view.
+__global__ void hgemm_contraction_rocwmma_d(rocwmma::tensor_contraction contraction,
+                                            float16_t const*            a,
+                                            float16_t const*            b,
+                                            float16_t const*            c,
+                                            float16_t*                  d,
+                                            float32_t                   alpha,
+                                            float32_t                   beta)
+{
+    // Create frags. Q and K are contiguous along d, the K dimension of the GEMM.
+    auto fragA
+        = rocwmma::fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, row_major>();
+    auto fragB
+        = rocwmma::fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, col_major>();
+    auto fragC
+        = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, row_major>();
+    auto fragAcc = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float32_t>();
+
+    rocwmma::fill_fragment(fragAcc, 0.0f);
+
+    // Tile using a 2D grid, with one batch per grid z
+    auto majorWarp = (blockIdx.x * blockDim.x + threadIdx.x) / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    auto minorWarp = (blockIdx.y * blockDim.y + threadIdx.y);
+    auto batch     = blockIdx.z;
+
+    // Target C block
+    auto cRow = majorWarp * ROCWMMA_M;
+    auto cCol = minorWarp * ROCWMMA_N;
+
+    // Bounds check
+    if(cRow < contraction.m && cCol < contraction.n)
+    {
+        // fragAcc = A x B
+        for(int i = 0; i < contraction.k; i += ROCWMMA_K)
+        {
+            // Load the inputs in place through their tensor views
+            rocwmma::load_matrix_tensor_sync(fragA, a, contraction.a, cRow, i, batch);
+            rocwmma::load_matrix_tensor_sync(fragB, b, contraction.b, i, cCol, batch);
+
+            // Matrix multiply - accumulate using MFMA units
+            rocwmma::mma_sync(fragAcc, fragA, fragB, fragAcc);
+        }
+
+        // Fetch C matrix
+        rocwmma::load_matrix_tensor_sync(fragC, c, contraction.d, cRow, cCol, batch);
+
+        // D = alpha * A x B + beta * C
+        for(int i = 0; i < fragC.num_elements; ++i)
+        {
+            fragC.x[i] = alpha * fragAcc.x[i] + beta * fragC.x[i];
+        }
+
+        // Store to D
+        rocwmma::store_matrix_tensor_sync(d, fragC, contraction.d, cRow, cCol, batch);
+    }
+}
+
+// Strided batched GEMM of packed matrices: batch index = blockIdx.z
+__global__ void hgemm_strided_batched_rocwmma_d(uint32_t         m,
+                                                uint32_t         n,
+                                                uint32_t         k,
+                                                float16_t const* a,
+                                                float16_t const* b,
+                                                float16_t const* c,
+                                                float16_t*       d,
+                                                uint32_t         lda,
+                                                uint32_t         ldb,
+                                                uint32_t         ldc,
+                                                uint32_t         ldd,
+                                                uint64_t         strideA,
+                                                uint64_t         strideB,
+                                                uint64_t         strideC,
+                                                uint64_t         strideD,
+                                                float32_t        alpha,
+                                                float32_t        beta)
+{
+    // Create frags
+    auto fragA
+        = rocwmma::fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, row_major>();
+    auto fragB
+        = rocwmma::fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, col_major>();
+    auto fragC   = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t>();
+    auto fragAcc = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float32_t>();
+
+    rocwmma::fill_fragment(fragAcc, 0.0f);
+
+    // Tile using a 2D grid, with one batch per grid z
+    auto majorWarp = (blockIdx.x * blockDim.x + threadIdx.x) / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    auto minorWarp = (blockIdx.y * blockDim.y + threadIdx.y);
+    auto batch     = blockIdx.z;
+
+    a += batch * strideA;
+    b += batch * strideB;
+    c += batch * strideC;
+    d += batch * strideD;
+
+    // Target C block
+    auto cRow = majorWarp * ROCWMMA_M;
+    auto cCol = minorWarp * ROCWMMA_N;
+
+    // Bounds check
+    if(cRow < m && cCol < n)
+    {
+        // fragAcc = A x B
+        for(int i = 0; i < k; i += ROCWMMA_K)
+        {
+            // Load the inputs
+            rocwmma::load_matrix_sync(fragA, a + (cRow * lda + i), lda);
+            rocwmma::load_matrix_sync(fragB, b + (i + cCol * ldb), ldb);
+
+            // Matrix multiply - accumulate using MFMA units
+            rocwmma::mma_sync(fragAcc, fragA, fragB, fragAcc);
+        }
+
+        // Fetch C matrix
+        rocwmma::load_matrix_sync(fragC, c + (cRow * ldc + cCol), ldc, rocwmma::mem_row_major);
+
+        // D = alpha * A x B + beta * C
+        for(int i = 0; i < fragC.num_elements; ++i)
+        {
+            fragC.x[i] = alpha * fragAcc.x[i] + beta * fragC.x[i];
+        }
+
+        // Store to D
+        rocwmma::store_matrix_sync(d + (cRow * ldd + cCol), fragC, ldd, rocwmma::mem_row_major);
+    }
+}
+
+// Copies a packed [b, s, h, d] tensor to a packed [b, h, s, d] tensor
+__global__ void permute_bshd_to_bhsd(
+    float16_t const* in, float16_t* out, uint32_t b, uint32_t s, uint32_t h, uint32_t d)
+{
+    auto index = static_cast<uint64_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+    if(index >= uint64_t(b) * s * h * d)
+    {
+        return;
+    }
+
+    // Output coordinate, d fastest
+    auto di = index % d;
+    auto si = (index / d) % s;
+    auto hi = (index / (uint64_t(d) * s)) % h;
+    auto bi = index / (uint64_t(d) * s * h);
+
+    out[index] = in[((bi * s + si) * h + hi) * d + di];
+}
+
+// Host copy of permute_bshd_to_bhsd
+__host__ static void permute_bshd_to_bhsd_cpu(std::vector<float16_t> const& in,
+                                              std::vector<float16_t>&       out,
+                                              uint32_t                      b,
+                                              uint32_t                      s,
+                                              uint32_t                      h,
+                                              uint32_t                      d)
+{
+    for(uint32_t bi = 0; bi < b; ++bi)
+    {
+        for(uint32_t hi = 0; hi < h; ++hi)
+        {
+            for(uint32_t si = 0; si < s; ++si)
+            {
+                for(uint32_t di = 0; di < d; ++di)
+                {
+                    out[((uint64_t(bi) * h + hi) * s + si) * d + di]
+                        = in[((uint64_t(bi) * s + si) * h + hi) * d + di];
+                }
+            }
+        }
+    }
+}
+
+__host__ void contraction_test(
+    uint32_t batch, uint32_t heads, uint32_t seqQ, uint32_t seqK, uint32_t headDim)
+{
+    // Bounds check
+    if((seqQ < (ROCWMMA_M * T_BLOCK_X / WAVE_SIZE) || seqK < (ROCWMMA_N * T_BLOCK_Y)
+        || headDim < ROCWMMA_K)
+       || (seqQ % ROCWMMA_M || seqK % ROCWMMA_N || headDim % ROCWMMA_K))
+    {
+        std::cout << "Unsupported size!\n";
+        return;
+    }
+
+    // Tensor extents and packed strides, in einsum mode order
+    uint32_t extentsQ[] = {batch, seqQ, heads, headDim};
+    int64_t  stridesQ[] = {int64_t(seqQ) * heads * headDim, heads * headDim, headDim, 1};
+    uint32_t extentsK[] = {batch, seqK, heads, headDim};
+    int64_t  stridesK[] = {int64_t(seqK) * heads * headDim, heads * headDim, headDim, 1};
+    uint32_t extentsS[] = {batch, heads, seqQ, seqK};
+    int64_t  stridesS[] = {int64_t(heads) * seqQ * seqK, int64_t(seqQ) * seqK, seqK, 1};
+
+    auto contraction = rocwmma::make_tensor_contraction(
+        "bshd,bthd->bhst", extentsQ, stridesQ, extentsK, stridesK, extentsS, stridesS);
+
+    // GEMM view of the contraction: (S x D) x (D x T) for each of the b * h batches
+    auto m          = contraction.m;
+    auto n          = contraction.n;
+    auto k          = contraction.k;
+    auto batchCount = contraction.batch;
+
+    float32_t alpha = 0.125f;
+    float32_t beta  = 1.0f;
+
+    std::cout << "Initializing host data..." << std::endl;
+
+    // Initialize input tensors
+    std::vector<float16_t> tensorQ(uint64_t(batch) * seqQ * heads * headDim);
+    std::vector<float16_t> tensorK(uint64_t(batch) * seqK * heads * headDim);
+    std::vector<float16_t> tensorC(uint64_t(batchCount) * m * n);
+    // Fill outputs with NaN to catch contamination
+    std::vector<float16_t> tensorS(tensorC.size(), std::numeric_limits<float16_t>::signaling_NaN());
+
+    fillRand(tensorQ.data(), batch * seqQ, heads * headDim);
+    fillRand(tensorK.data(), batch * seqK, heads * headDim);
+    fillRand(tensorC.data(), batchCount * m, n);
+
+    std::cout << "Initializing device data..." << std::endl;
+
+    // Allocate and copy device memory
+    float16_t* d_q;
+    float16_t* d_k;
+    float16_t* d_qPermuted;
+    float16_t* d_kPermuted;
+    float16_t* d_c;
+    float16_t* d_s;
+
+    const size_t bytesQ = tensorQ.size() * sizeof(float16_t);
+    const size_t bytesK = tensorK.size() * sizeof(float16_t);
+    const size_t bytesC = tensorC.size() * sizeof(float16_t);
+    const size_t bytesS = tensorS.size() * sizeof(float16_t);
+
+    CHECK_HIP_ERROR(hipMalloc(&d_q, bytesQ));
+    CHECK_HIP_ERROR(hipMalloc(&d_k, bytesK));
+    CHECK_HIP_ERROR(hipMalloc(&d_qPermuted, bytesQ));
+    CHECK_HIP_ERROR(hipMalloc(&d_kPermuted, bytesK));
+    CHECK_HIP_ERROR(hipMalloc(&d_c, bytesC));
+    CHECK_HIP_ERROR(hipMalloc(&d_s, bytesS));
+
+    CHECK_HIP_ERROR(hipMemcpy(d_q, tensorQ.data(), bytesQ, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_k, tensorK.data(), bytesK, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_c, tensorC.data(), bytesC, hipMemcpyHostToDevice));
+
+    auto blockDim = dim3(T_BLOCK_X, T_BLOCK_Y);
+    auto gridDim  = dim3(rocwmma::ceilDiv(m, ROCWMMA_M * T_BLOCK_X / WAVE_SIZE),
+                        rocwmma::ceilDiv(n, ROCWMMA_N * T_BLOCK_Y),
+                        batchCount);
+
+    auto contractionKernel = [&]() {
+        hipExtLaunchKernelGGL(hgemm_contraction_rocwmma_d,
+                              gridDim,
+                              blockDim,
+                              0, // sharedMemBytes
+                              0, // stream
+                              nullptr, // Event start
+                              nullptr, // event stop
+                              0, // flags
+                              contraction,
+                              d_q,
+                              d_k,
+                              d_c,
+                              d_s,
+                              alpha,
+                              beta);
+    };
+
+    // Baseline: permute Q and K to BHSD, then strided batched GEMM over the heads
+    const uint32_t permuteBlock = 256u;
+    auto           permutedKernel = [&]() {
+        hipExtLaunchKernelGGL(permute_bshd_to_bhsd,
+                              dim3(rocwmma::ceilDiv(tensorQ.size(), permuteBlock)),
+                              dim3(permuteBlock),
+                              0, // sharedMemBytes
+                              0, // stream
+                              nullptr, // Event start
+                              nullptr, // event stop
+                              0, // flags
+                              d_q,
+                              d_qPermuted,
+                              batch,
+                              seqQ,
+                              heads,
+                              headDim);
+        hipExtLaunchKernelGGL(permute_bshd_to_bhsd,
+                              dim3(rocwmma::ceilDiv(tensorK.size(), permuteBlock)),
+                              dim3(permuteBlock),
+                              0, // sharedMemBytes
+                              0, // stream
+                              nullptr, // Event start
+                              nullptr, // event stop
+                              0, // flags
+                              d_k,
+                              d_kPermuted,
+                              batch,
+                              seqK,
+                              heads,
+                              headDim);
+        hipExtLaunchKernelGGL(hgemm_strided_batched_rocwmma_d,
+                              gridDim,
+                              blockDim,
+                              0, // sharedMemBytes
+                              0, // stream
+                              nullptr, // Event start
+                              nullptr, // event stop
+                              0, // flags
+                              m,
+                              n,
+                              k,
+                              d_qPermuted,
+                              d_kPermuted,
+                              d_c,
+                              d_s,
+                              k, // lda
+                              k, // ldb
+                              n, // ldc
+                              n, // ldd
+                              uint64_t(m) * k,
+                              uint64_t(k) * n,
+                              uint64_t(m) * n,
+                              uint64_t(m) * n,
+                              alpha,
+                              beta);
+    };
+
+    // Runs are timed individually, with warm and cold caches
+    BenchmarkHarness harness;
+
+#if !NDEBUG
+
+    // Setup and run reference computation for each head on the permuted inputs
+    std::vector<float16_t> hostQPermuted(tensorQ.size());
+    std::vector<float16_t> hostKPermuted(tensorK.size());
+    permute_bshd_to_bhsd_cpu(tensorQ, hostQPermuted, batch, seqQ, heads, headDim);
+    permute_bshd_to_bhsd_cpu(tensorK, hostKPermuted, batch, seqK, heads, headDim);
+
+    std::vector<float16_t> tensorS_ref(tensorS.size(),
+                                       std::numeric_limits<float16_t>::signaling_NaN());
+    for(uint32_t i = 0; i < batchCount; ++i)
+    {
+        gemm_cpu_h<float16_t, float16_t, float32_t, row_major, col_major, row_major>(
+            m,
+            n,
+            k,
+            hostQPermuted.data() + uint64_t(i) * m * k,
+            hostKPermuted.data() + uint64_t(i) * k * n,
+            tensorC.data() + uint64_t(i) * m * n,
+            tensorS_ref.data() + uint64_t(i) * m * n,
+            k,
+            k,
+            n,
+            n,
+            alpha,
+            beta);
+    }
+
+    auto validate = [&]() {
+        // Bring kernel result back to host
+        CHECK_HIP_ERROR(hipMemcpy(tensorS.data(), d_s, bytesS, hipMemcpyDeviceToHost));
+
+        auto res = compareEqual<float16_t>(tensorS.data(), tensorS_ref.data(), tensorS.size());
+
+        if(std::get<0>(res) == false)
+        {
+            std::cout << "FAILED!\n";
+        }
+        else
+        {
+            std::cout << "PASSED!\n";
+        }
+
+        std::cout << "Max relative error: " << std::get<1>(res) << std::endl;
+    };
+
+#endif // !NDEBUG
+
+    // Each permute pass reads and writes the whole tensor
+    std::cout << "Permute traffic avoided (MB): " << 2.0 * (bytesQ + bytesK) / 1.0e6 << std::endl;
+
+    // Echo performance
+    std::cout << "Mode, BlkM, BlkN, BlkK, "
+              << "Batch, Heads, SeqQ, SeqK, HeadDim, "
+              << "Cache, elapsedMs, Problem Size(GFlops), TFlops/s, "
+              << BenchmarkHarness::statsHeader() << std::endl;
+
+    auto gFlops = calculateGFlops(m, n, k) * batchCount;
+
+    auto run = [&](const char* mode, auto&& kernel) {
+        // Fill outputs with NaN to catch contamination
+        CHECK_HIP_ERROR(hipMemset(d_s, 0xFF, bytesS));
+
+        for(auto cacheState :
+            {BenchmarkHarness::CacheState::Warm, BenchmarkHarness::CacheState::Cold})
+        {
+            auto stats        = harness.run(kernel, cacheState);
+            auto tFlopsPerSec = gFlops / stats.mMedianMs;
+
+            std::cout << mode << ", " << ROCWMMA_M << ", " << ROCWMMA_N << ", " << ROCWMMA_K
+                      << ", " << batch << ", " << heads << ", " << seqQ << ", " << seqK << ", "
+                      << headDim << ", "
+                      << (cacheState == BenchmarkHarness::CacheState::Warm ? "warm" : "cold")
+                      << ", " << stats.mMedianMs << ", " << gFlops << ", " << tFlopsPerSec
+                      << ", ";
+            BenchmarkHarness::printStats(std::cout, stats) << std::endl;
+        }
+
+#if !NDEBUG
+        validate();
+#endif // !NDEBUG
+    };
+
+    run("Permute+StridedBatched", permutedKernel);
+    run("Contraction", contractionKernel);
+
+    // Release device memory
+    CHECK_HIP_ERROR(hipFree(d_q));
+    CHECK_HIP_ERROR(hipFree(d_k));
+    CHECK_HIP_ERROR(hipFree(d_qPermuted));
+    CHECK_HIP_ERROR(hipFree(d_kPermuted));
+    CHECK_HIP_ERROR(hipFree(d_c));
+    CHECK_HIP_ERROR(hipFree(d_s));
+
+    std::cout << "Finished!" << std::endl;
+}
+
+int main()
+{
+    // Attention scores of BSHD projections
+    contraction_test(4, 16, 512, 512, 64);
+    contraction_test(2, 32, 256, 1024, 128);
+    return 0;
+}
@@ -0,0 +1,399 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_fp16.h>
+#include <hip/hip_runtime.h>
+
+#include <rocwmma/rocwmma.hpp>
+#include <rocwmma/rocwmma_epilogue.hpp>
+
+#include "common.hpp"
+
+using rocwmma::accumulator;
+using rocwmma::bfloat16_t;
+using rocwmma::col_major;
+using rocwmma::float16_t;
+using rocwmma::float32_t;
+using rocwmma::float64_t;
+using rocwmma::matrix_a;
+using rocwmma::matrix_b;
+using rocwmma::row_major;
+
+// Supports ROCWMMA_M/N square sizes of
+// : 16 x 16
+// : 32 x 32 ( only MI )
+const int ROCWMMA_M = 16;
+const int ROCWMMA_N = 16;
+
+// Supports ROCWMMA_K sizes as
+// : multiples of 16.
+const int ROCWMMA_K = 16;
+
+// Device warp size
+const uint32_t WAVE_SIZE = getWarpSize();
+
+// Thread block
+// : T_BLOCK_X must be multiple of WAVE_SIZE.
+// Note: Each wave will compute one BLOCK_M x BLOCK_N output block
+// Note: Workgroup will compute
+//  T_BLOCK_X / WAVE_SIZE x T_BLOCK_Y output blocks
+const int T_BLOCK_X = 4 * WAVE_SIZE;
+const int T_BLOCK_Y = 4;
+
+// The following device kernel is a naive implementation of blocked GEMM
+// with a fused epilogue. Each wave will compute one BLOCK_M x BLOCK_N
+// output block of the M x N x K GEMM, generalized as:
+// D = gelu(scale[row] * (alpha * (A x B) + beta * C) + bias[col]) + R
+//
+// Where:
+// : scale is a per-row vector          (M)
+// : bias is a per-column vector        (N)
+// : R is a bfloat16_t residual input   (M x N)
+//
+// All of the element-wise operations are applied in registers in the
+// accumulator precision, before a single conversion to float16_t and
+// store of the output. Un-fused, each element-wise step would be an
+// additional read and write of the M x N output.
+//
+// R is held in its own precision and layout. Accumulator elements are in
+// the same register order in any data layout, so R is converted in registers
+// without a copy matching the type and layout of D.
+//
+// In this simplified example, we assume:
+// : A is in row-major format        (M x K)
+// : B is in col-major format        (K x N)
+// : C, D are in row-major format    (M x N)
+// : R is in col-major format        (M x N)
+// : Multiplication is NOT in-place, output is written to D matrix
+// : No LDS required
+//
+// Note: This is a simplified implementation to demonstrate API usage in
+// context of wave-level GEMM computation, and is not optimized.
+__global__ void hgemm_epilogue_rocwmma_d(uint32_t          m,
+                                         uint32_t          n,
+                                         uint32_t          k,
+                                         float16_t const*  a,
+                                         float16_t const*  b,
+                                         float16_t const*  c,
+                                         bfloat16_t const* r,
+                                         float32_t const*  scale,
+                                         float32_t const*  bias,
+                                         float16_t*        d,
+                                         uint32_t          lda,
+                                         uint32_t          ldb,
+                                         uint32_t          ldc,
+                                         uint32_t          ldr,
+                                         uint32_t          ldd,
+                                         float32_t         alpha,
+                                         float32_t         beta)
+{
+    // Create frags
+    auto fragA
+        = rocwmma::fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, row_major>();
+    auto fragB
+        = rocwmma::fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, col_major>();
+    auto fragC   = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t>();
+    auto fragR   = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, bfloat16_t>();
+    auto fragAcc = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float32_t>();
+
+    // Per-channel vectors, broadcast to line up with fragAcc
+    auto fragScale = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float32_t>();
+    auto fragBias  = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float32_t>();
+
+    rocwmma::fill_fragment(fragAcc, 0.0f);
+
+    // Tile using a 2D grid
+    auto majorWarp = (blockIdx.x * blockDim.x + threadIdx.x) / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    auto minorWarp = (blockIdx.y * blockDim.y + threadIdx.y);
+
+    // Target C block
+    auto cRow = majorWarp * ROCWMMA_M;
+    auto cCol = minorWarp * ROCWMMA_N;
+
+    // Bounds check
+    if(cRow < m && cCol < n)
+    {
+        // fragAcc = A x B
+        for(int i = 0; i < k; i += ROCWMMA_K)
+        {
+            // Load the inputs
+            rocwmma::load_matrix_sync(fragA, a + (cRow * lda + i), lda);
+            rocwmma::load_matrix_sync(fragB, b + (i + cCol * ldb), ldb);
+
+            // Matrix multiply - accumulate using MFMA units
+            rocwmma::mma_sync(fragAcc, fragA, fragB, fragAcc);
+        }
+
+        // Fetch epilogue inputs
+        rocwmma::load_matrix_sync(fragC, c + (cRow * ldc + cCol), ldc, rocwmma::mem_row_major);
+        rocwmma::load_matrix_sync(fragR, r + (cRow + cCol * ldr), ldr, rocwmma::mem_col_major);
+        // Scale and bias vectors are read once per wave, through the scalar cache
+        rocwmma::load_col_vector_uniform_sync(fragScale, scale + cRow);
+        rocwmma::load_row_vector_uniform_sync(fragBias, bias + cCol);
+
+        // D = gelu(scale * (alpha * A x B + beta * C) + bias) + R
+        rocwmma::apply_epilogue(
+            fragC,
+            fragAcc,
+            rocwmma::epilogue::LinearCombination(alpha, beta, fragC),
+            rocwmma::epilogue::Scale(fragScale),
+            rocwmma::epilogue::BiasAdd(fragBias),
+            rocwmma::epilogue::Activation<rocwmma::epilogue::Gelu>(),
+            rocwmma::epilogue::ResidualAdd(fragR));
+
+        // Store to D
+        rocwmma::store_matrix_sync(d + (cRow * ldd + cCol), fragC, ldd, rocwmma::mem_row_major);
+    }
+}
+
+// Host reference of the fused epilogue
+__host__ void epilogue_cpu_h(uint32_t          m,
+                             uint32_t          n,
+                             float32_t const*  gemmOut,
+                             bfloat16_t const* r,
+                             float32_t const*  scale,
+                             float32_t const*  bias,
+                             float16_t*        d,
+                             uint32_t          ld,
+                             uint32_t          ldr)
+{
+    auto gelu = [](float32_t x) {
+        return 0.5f * x * (1.0f + std::tanh(0.7978845608028654f * (x + 0.044715f * x * x * x)));
+    };
+
+#pragma omp parallel for
+    for(int i = 0; i < m; ++i)
+    {
+        for(int j = 0; j < n; ++j)
+        {
+            auto idx = i * ld + j;
+            d[idx]   = static_cast<float16_t>(gelu(scale[i] * gemmOut[idx] + bias[j])
+                                            + static_cast<float32_t>(r[i + j * ldr]));
+        }
+    }
+}
+
+__host__ void gemm_test(uint32_t m, uint32_t n, uint32_t k, float32_t alpha, float32_t beta)
+{
+    // Bounds check
+    if((m < (ROCWMMA_M * T_BLOCK_X / WAVE_SIZE) || n < (ROCWMMA_N * T_BLOCK_Y) || k < ROCWMMA_K)
+       || (m % ROCWMMA_M || n % ROCWMMA_N || k % ROCWMMA_K))
+    {
+        std::cout << "Unsupported size!\n";
+        return;
+    }
+
+    int lda = k;
+    int ldb = k;
+    int ldc = n;
+    int ldr = m;
+    int ldd = ldc;
+
+    std::cout << "Initializing host data..." << std::endl;
+
+    // Initialize input matrices
+    std::vector<float16_t>  matrixA(m * k);
+    std::vector<float16_t>  matrixB(k * n);
+    std::vector<float16_t>  matrixC(m * n);
+    std::vector<bfloat16_t> matrixR(m * n);
+    std::vector<float32_t>  vectorScale(m);
+    std::vector<float32_t>  vectorBias(n);
+    // Fill outputs with NaN to catch contamination
+    std::vector<float16_t> matrixD(m * n, std::numeric_limits<float16_t>::signaling_NaN());
+
+    fillRand(matrixA.data(), m, k);
+    fillRand(matrixB.data(), k, n);
+    fillRand(matrixC.data(), m, n);
+    fillRand(matrixR.data(), m, n);
+    fillRand(vectorScale.data(), m, 1);
+    fillRand(vectorBias.data(), 1, n);
+
+    std::cout << "Initializing device data..." << std::endl;
+
+    // Allocate and copy device memory
+    float16_t*  d_a;
+    float16_t*  d_b;
+    float16_t*  d_c;
+    bfloat16_t* d_r;
+    float32_t*  d_scale;
+    float32_t*  d_bias;
+    float16_t*  d_d;
+
+    const size_t bytesA     = matrixA.size() * sizeof(float16_t);
+    const size_t bytesB     = matrixB.size() * sizeof(float16_t);
+    const size_t bytesC     = matrixC.size() * sizeof(float16_t);
+    const size_t bytesR     = matrixR.size() * sizeof(bfloat16_t);
+    const size_t bytesScale = vectorScale.size() * sizeof(float32_t);
+    const size_t bytesBias  = vectorBias.size() * sizeof(float32_t);
+    const size_t bytesD     = matrixD.size() * sizeof(float16_t);
+
+    CHECK_HIP_ERROR(hipMalloc(&d_a, bytesA));
+    CHECK_HIP_ERROR(hipMalloc(&d_b, bytesB));
+    CHECK_HIP_ERROR(hipMalloc(&d_c, bytesC));
+    CHECK_HIP_ERROR(hipMalloc(&d_r, bytesR));
+    CHECK_HIP_ERROR(hipMalloc(&d_scale, bytesScale));
+    CHECK_HIP_ERROR(hipMalloc(&d_bias, bytesBias));
+    CHECK_HIP_ERROR(hipMalloc(&d_d, bytesD));
+
+    CHECK_HIP_ERROR(hipMemcpy(d_a, matrixA.data(), bytesA, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_b, matrixB.data(), bytesB, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_c, matrixC.data(), bytesC, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_r, matrixR.data(), bytesR, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_scale, vectorScale.data(), bytesScale, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_bias, vectorBias.data(), bytesBias, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_d, matrixD.data(), bytesD, hipMemcpyHostToDevice));
+
+    auto blockDim = dim3(T_BLOCK_X, T_BLOCK_Y);
+    auto gridDim  = dim3(rocwmma::ceilDiv(m, ROCWMMA_M * T_BLOCK_X / WAVE_SIZE),
+                        rocwmma::ceilDiv(n, ROCWMMA_N * T_BLOCK_Y));
+
+    std::cout << "Launching GEMM kernel..." << std::endl;
+
+    hipEvent_t startEvent, stopEvent;
+    CHECK_HIP_ERROR(hipEventCreate(&startEvent));
+    CHECK_HIP_ERROR(hipEventCreate(&stopEvent));
+
+    hipExtLaunchKernelGGL(hgemm_epilogue_rocwmma_d,
+                          gridDim,
+                          blockDim,
+                          0, // sharedMemBytes
+                          0, // stream
+                          startEvent, // Event start
+                          stopEvent, // event stop
+                          0, // flags
+                          m,
+                          n,
+                          k,
+                          d_a,
+                          d_b,
+                          d_c,
+                          d_r,
+                          d_scale,
+                          d_bias,
+                          d_d,
+                          lda,
+                          ldb,
+                          ldc,
+                          ldr,
+                          ldd,
+                          alpha,
+                          beta);
+
+    auto elapsedTimeMs = 0.0f;
+    CHECK_HIP_ERROR(hipEventSynchronize(stopEvent));
+    CHECK_HIP_ERROR(hipEventElapsedTime(&elapsedTimeMs, startEvent, stopEvent));
+    CHECK_HIP_ERROR(hipEventDestroy(startEvent));
+    CHECK_HIP_ERROR(hipEventDestroy(stopEvent));
+
+    // GEMM flops converge to 2*mnk
+    auto gFlops       = calculateGFlops(m, n, k);
+    auto tFlopsPerSec = gFlops / static_cast<double>(elapsedTimeMs);
+
+    // Echo performance
+    std::cout << "BlkM, BlkN, BlkK, "
+              << "MatM, MatN, MatK, "
+              << "alpha, lda, ldb, "
+              << "beta, ldc, ldd, "
+              << "elapsedMs, Problem Size(GFlops), TFlops/s" << std::endl;
+
+    std::cout << ROCWMMA_M << ", " << ROCWMMA_N << ", " << ROCWMMA_K << ", " << m << ", " << n
+              << ", " << k << ", " << alpha << ", " << lda << ", " << ldb << ", " << beta << ", "
+              << ldc << ", " << ldd << ", " << elapsedTimeMs << ", " << gFlops << ", "
+              << tFlopsPerSec << std::endl;
+
+#if !NDEBUG
+
+    std::cout << "Validating result with reference..." << std::endl;
+
+    // Bring kernel result back to host
+    CHECK_HIP_ERROR(hipMemcpy(matrixD.data(), d_d, bytesD, hipMemcpyDeviceToHost));
+
+    // Setup and run reference computation.
+    // The GEMM result is kept in float32_t as input to the epilogue, as on the device.
+    std::vector<float32_t> matrixC_ref(matrixC.begin(), matrixC.end());
+    std::vector<float32_t> matrixGemm_ref(m * n);
+    std::vector<float16_t> matrixD_ref(m * n, std::numeric_limits<float16_t>::signaling_NaN());
+    gemm_cpu_h<float16_t, float32_t, float32_t, row_major, col_major, row_major>(
+        m,
+        n,
+        k,
+        matrixA.data(),
+        matrixB.data(),
+        matrixC_ref.data(),
+        matrixGemm_ref.data(),
+        lda,
+        ldb,
+        ldc,
+        ldd,
+        alpha,
+        beta);
+    epilogue_cpu_h(m,
+                   n,
+                   matrixGemm_ref.data(),
+                   matrixR.data(),
+                   vectorScale.data(),
+                   vectorBias.data(),
+                   matrixD_ref.data(),
+                   ldd,
+                   ldr);
+
+    auto res = compareEqual<float16_t>(matrixD.data(), matrixD_ref.data(), m * n);
+
+    if(std::get<0>(res) == false)
+    {
+        std::cout << "FAILED!\n";
+    }
+    else
+    {
+        std::cout << "PASSED!\n";
+    }
+
+    std::cout << "Max relative error: " << std::get<1>(res) << std::endl;
+
+#endif // !NDEBUG
+
+    // Release device memory
+    CHECK_HIP_ERROR(hipFree(d_a));
+    CHECK_HIP_ERROR(hipFree(d_b));
+    CHECK_HIP_ERROR(hipFree(d_c));
+    CHECK_HIP_ERROR(hipFree(d_r));
+    CHECK_HIP_ERROR(hipFree(d_scale));
+    CHECK_HIP_ERROR(hipFree(d_bias));
+    CHECK_HIP_ERROR(hipFree(d_d));
+
+    std::cout << "Finished!" << std::endl;
+}
+
+int main()
+{
+    gemm_test(256, 256, 256, 2.1f, 2.1f);
+    return 0;
+}
@@ -0,0 +1,431 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_fp16.h>
+#include <hip/hip_runtime.h>
+
+#include <rocwmma/rocwmma.hpp>
+
+#include "benchmark_harness.hpp"
+#include "common.hpp"
+
+using rocwmma::accumulator;
+using rocwmma::col_major;
+using rocwmma::float16_t;
+using rocwmma::float32_t;
+using rocwmma::float64_t;
+using rocwmma::matrix_a;
+using rocwmma::matrix_b;
+using rocwmma::row_major;
+
+// Supports ROCWMMA_M/N square sizes of
+// : 16 x 16
+// : 32 x 32 ( only MI )
+const int ROCWMMA_M = 16;
+const int ROCWMMA_N = 16;
+
+// Supports ROCWMMA_K sizes as
+// : multiples of 16.
+const int ROCWMMA_K = 16;
+
+// Device warp size
+const uint32_t WAVE_SIZE = getWarpSize();
+
+// Thread block
+// : T_BLOCK_X must be multiple of WAVE_SIZE.
+// Note: Each wave will compute one BLOCK_M x BLOCK_N output block
+// Note: Workgroup will compute one tile of
+//  T_BLOCK_X / WAVE_SIZE x T_BLOCK_Y output blocks
+const int T_BLOCK_X = 2 * WAVE_SIZE;
+const int T_BLOCK_Y = 2;
+
+// Workgroup tile size
+const uint32_t TILE_M = ROCWMMA_M * T_BLOCK_X / WAVE_SIZE;
+const uint32_t TILE_N = ROCWMMA_N * T_BLOCK_Y;
+
+// Problem descriptor for one GEMM of the group:
+// D = alpha * (A x B) + beta * C
+struct GemmProblemDesc
+{
+    uint32_t         m, n, k;
+    float16_t const* a;
+    float16_t const* b;
+    float16_t const* c;
+    float16_t*       d;
+    uint32_t         lda, ldb, ldc, ldd;
+    float32_t        alpha, beta;
+};
+
+// The following device kernels compute a group of independent GEMMs with
+// different problem sizes in a single launch (e.g. Mixture of Experts, where
+// each expert receives a different number of tokens M).
+//
+// Each problem is partitioned into workgroup tiles of TILE_M x TILE_N. An
+// exclusive prefix sum of the tile count of each problem maps a global tile
+// index to its problem:
+//
+//  Problems:      P0 (3 tiles)   P1 (1 tile)   P2 (2 tiles)
+//  Tile offsets:  [0, 3, 4, 6]
+//  Global tiles:  | 0  1  2 | 3 | 4  5 |
+//
+// Both the prefix sum and the tile map are computed on the device from the
+// problem descriptors, so no host round-trip is required between the
+// descriptor update and the GEMM. The GEMM kernel uses a fixed size grid, and
+// workgroups stride over the global tile space until all tiles are done.
+//
+// In this simplified example, we assume:
+// : A is in row-major format     (M x K)
+// : B is in col-major format     (K x N)
+// : C, D are in row-major format (M x N)
+// : M, N and K of each problem are multiples of the block sizes
+// : No LDS required
+//
+// Note: This is a simplified implementation to demonstrate API usage in
+// context of wave-level GEMM computation, and is not optimized.
+
+// Exclusive prefix sum of tile counts.
+// tileOffsets must hold groupCount + 1 entries; the last entry is the total tile count.
+// The group count is expected to be small (e.g. number of experts), so a single thread suffices.
+__global__ void grouped_tile_offsets_d(GemmProblemDesc const* problems,
+                                       uint32_t               groupCount,
+                                       uint32_t*              tileOffsets)
+{
+    if(blockIdx.x == 0 && threadIdx.x == 0)
+    {
+        uint32_t offset = 0u;
+        for(uint32_t i = 0; i < groupCount; ++i)
+        {
+            tileOffsets[i] = offset;
+            offset += rocwmma::ceilDiv(problems[i].m, TILE_M)
+                      * rocwmma::ceilDiv(problems[i].n, TILE_N);
+        }
+        tileOffsets[groupCount] = offset;
+    }
+}
+
+// Finds the problem of the given global tile index in the prefix sum:
+// largest i such that tileOffsets[i] <= tileIndex.
+__device__ static inline uint32_t
+    findProblem(uint32_t const* tileOffsets, uint32_t groupCount, uint32_t tileIndex)
+{
+    uint32_t lo = 0u;
+    uint32_t hi = groupCount;
+    while(hi - lo > 1u)
+    {
+        auto mid = (lo + hi) / 2u;
+        if(tileOffsets[mid] <= tileIndex)
+        {
+            lo = mid;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+__global__ void hgemm_grouped_rocwmma_d(GemmProblemDesc const* problems,
+                                        uint32_t const*        tileOffsets,
+                                        uint32_t               groupCount)
+{
+    // Create frags
+    auto fragA
+        = rocwmma::fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, row_major>();
+    auto fragB
+        = rocwmma::fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, col_major>();
+    auto fragC   = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t>();
+    auto fragAcc = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float32_t>();
+
+    // Local warp block offset within the workgroup tile
+    auto localRow = threadIdx.x / rocwmma::Constants::AMDGCN_WAVE_SIZE * ROCWMMA_M;
+    auto localCol = threadIdx.y * ROCWMMA_N;
+
+    auto totalTiles = tileOffsets[groupCount];
+    for(auto tileIndex = blockIdx.x; tileIndex < totalTiles; tileIndex += gridDim.x)
+    {
+        // Map global tile to problem and local tile coordinate
+        auto  problemIndex = findProblem(tileOffsets, groupCount, tileIndex);
+        auto  localTile    = tileIndex - tileOffsets[problemIndex];
+        auto& p            = problems[problemIndex];
+
+        auto tilesN = rocwmma::ceilDiv(p.n, TILE_N);
+
+        // Target C block
+        auto cRow = localTile / tilesN * TILE_M + localRow;
+        auto cCol = localTile % tilesN * TILE_N + localCol;
+
+        // Bounds check
+        if(cRow < p.m && cCol < p.n)
+        {
+            rocwmma::fill_fragment(fragAcc, 0.0f);
+
+            // fragAcc = A x B
+            for(int i = 0; i < p.k; i += ROCWMMA_K)
+            {
+                // Load the inputs
+                rocwmma::load_matrix_sync(fragA, p.a + (cRow * p.lda + i), p.lda);
+                rocwmma::load_matrix_sync(fragB, p.b + (i + cCol * p.ldb), p.ldb);
+
+                // Matrix multiply - accumulate using MFMA units
+                rocwmma::mma_sync(fragAcc, fragA, fragB, fragAcc);
+            }
+
+            // Fetch C matrix
+            rocwmma::load_matrix_sync(
+                fragC, p.c + (cRow * p.ldc + cCol), p.ldc, rocwmma::mem_row_major);
+
+            // D = alpha * A x B + beta * C
+            for(int i = 0; i < fragC.num_elements; ++i)
+            {
+                fragC.x[i] = p.alpha * fragAcc.x[i] + p.beta * fragC.x[i];
+            }
+
+            // Store to D
+            rocwmma::store_matrix_sync(
+                p.d + (cRow * p.ldd + cCol), fragC, p.ldd, rocwmma::mem_row_major);
+        }
+    }
+}
+
+__host__ void grouped_gemm_test(std::vector<uint32_t> const& groupM, uint32_t n, uint32_t k)
+{
+    uint32_t groupCount = groupM.size();
+
+    // Bounds check
+    for(auto m : groupM)
+    {
+        if(m % ROCWMMA_M || n % ROCWMMA_N || k % ROCWMMA_K || k < ROCWMMA_K)
+        {
+            std::cout << "Unsupported size!\n";
+            return;
+        }
+    }
+
+    int lda = k;
+    int ldb = k;
+    int ldc = n;
+    int ldd = ldc;
+
+    // Matrix offsets of each problem in packed storage
+    std::vector<size_t> offsetsA(groupCount + 1, 0u);
+    std::vector<size_t> offsetsC(groupCount + 1, 0u);
+    for(uint32_t i = 0; i < groupCount; ++i)
+    {
+        offsetsA[i + 1] = offsetsA[i] + size_t(groupM[i]) * k;
+        offsetsC[i + 1] = offsetsC[i] + size_t(groupM[i]) * n;
+    }
+
+    auto totalM = std::accumulate(groupM.begin(), groupM.end(), 0u);
+
+    std::cout << "Initializing host data..." << std::endl;
+
+    // Each problem (expert) has its own B, A and C are packed by rows of M
+    std::vector<float16_t> matrixA(offsetsA[groupCount]);
+    std::vector<float16_t> matrixB(size_t(k) * n * groupCount);
+    std::vector<float16_t> matrixC(offsetsC[groupCount]);
+    // Fill outputs with NaN to catch contamination
+    std::vector<float16_t> matrixD(offsetsC[groupCount],
+                                   std::numeric_limits<float16_t>::signaling_NaN());
+
+    fillRand(matrixA.data(), totalM, k);
+    fillRand(matrixB.data(), n * groupCount, k);
+    fillRand(matrixC.data(), totalM, n);
+
+    std::cout << "Initializing device data..." << std::endl;
+
+    // Allocate and copy device memory
+    float16_t* d_a;
+    float16_t* d_b;
+    float16_t* d_c;
+    float16_t* d_d;
+
+    const size_t bytesA = matrixA.size() * sizeof(float16_t);
+    const size_t bytesB = matrixB.size() * sizeof(float16_t);
+    const size_t bytesC = matrixC.size() * sizeof(float16_t);
+    const size_t bytesD = matrixD.size() * sizeof(float16_t);
+
+    CHECK_HIP_ERROR(hipMalloc(&d_a, bytesA));
+    CHECK_HIP_ERROR(hipMalloc(&d_b, bytesB));
+    CHECK_HIP_ERROR(hipMalloc(&d_c, bytesC));
+    CHECK_HIP_ERROR(hipMalloc(&d_d, bytesD));
+
+    CHECK_HIP_ERROR(hipMemcpy(d_a, matrixA.data(), bytesA, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_b, matrixB.data(), bytesB, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_c, matrixC.data(), bytesC, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_d, matrixD.data(), bytesD, hipMemcpyHostToDevice));
+
+    // Problem descriptors
+    std::vector<GemmProblemDesc> problems(groupCount);
+    for(uint32_t i = 0; i < groupCount; ++i)
+    {
+        problems[i] = {groupM[i],
+                       n,
+                       k,
+                       d_a + offsetsA[i],
+                       d_b + size_t(k) * n * i,
+                       d_c + offsetsC[i],
+                       d_d + offsetsC[i],
+                       uint32_t(lda),
+                       uint32_t(ldb),
+                       uint32_t(ldc),
+                       uint32_t(ldd),
+                       1.0f + static_cast<float32_t>(i % 4u) * 0.5f,
+                       static_cast<float32_t>(i % 3u) * 0.5f};
+    }
+
+    GemmProblemDesc* d_problems;
+    uint32_t*        d_tileOffsets;
+    CHECK_HIP_ERROR(hipMalloc(&d_problems, groupCount * sizeof(GemmProblemDesc)));
+    CHECK_HIP_ERROR(hipMalloc(&d_tileOffsets, (groupCount + 1) * sizeof(uint32_t)));
+    CHECK_HIP_ERROR(hipMemcpy(d_problems,
+                              problems.data(),
+                              groupCount * sizeof(GemmProblemDesc),
+                              hipMemcpyHostToDevice));
+
+    // Fixed grid size: one wave of workgroups
+    auto occupancy = rocwmma::get_launch_occupancy(hgemm_grouped_rocwmma_d, T_BLOCK_X * T_BLOCK_Y);
+
+    auto blockDim = dim3(T_BLOCK_X, T_BLOCK_Y);
+    auto gridDim  = dim3(occupancy.resident_blocks());
+
+    auto groupedKernel = [&]() {
+        hipExtLaunchKernelGGL(grouped_tile_offsets_d,
+                              dim3(1),
+                              dim3(1),
+                              0, // sharedMemBytes
+                              0, // stream
+                              nullptr, // Event start
+                              nullptr, // event stop
+                              0, // flags
+                              d_problems,
+                              groupCount,
+                              d_tileOffsets);
+        hipExtLaunchKernelGGL(hgemm_grouped_rocwmma_d,
+                              gridDim,
+                              blockDim,
+                              0, // sharedMemBytes
+                              0, // stream
+                              nullptr, // Event start
+                              nullptr, // event stop
+                              0, // flags
+                              d_problems,
+                              d_tileOffsets,
+                              groupCount);
+    };
+
+    std::cout << "Launching grouped GEMM kernel..." << std::endl;
+
+    // Runs are timed individually, with warm and cold caches
+    BenchmarkHarness harness;
+
+    // GEMM flops converge to 2*mnk, summed over the group
+    auto gFlops = calculateGFlops(totalM, n, k);
+
+    // Echo performance
+    std::cout << "BlkM, BlkN, BlkK, "
+              << "GroupCount, TotalM, MatN, MatK, "
+              << "Workgroups, "
+              << "Cache, elapsedMs, Problem Size(GFlops), TFlops/s, "
+              << BenchmarkHarness::statsHeader() << std::endl;
+
+    for(auto cacheState : {BenchmarkHarness::CacheState::Warm, BenchmarkHarness::CacheState::Cold})
+    {
+        auto stats        = harness.run(groupedKernel, cacheState);
+        auto tFlopsPerSec = gFlops / stats.mMedianMs;
+
+        std::cout << ROCWMMA_M << ", " << ROCWMMA_N << ", " << ROCWMMA_K << ", " << groupCount
+                  << ", " << totalM << ", " << n << ", " << k << ", " << gridDim.x << ", "
+                  << (cacheState == BenchmarkHarness::CacheState::Warm ? "warm" : "cold") << ", "
+                  << stats.mMedianMs << ", " << gFlops << ", " << tFlopsPerSec << ", ";
+        BenchmarkHarness::printStats(std::cout, stats) << std::endl;
+    }
+
+#if !NDEBUG
+
+    std::cout << "Validating result with reference..." << std::endl;
+
+    // Bring kernel result back to host
+    CHECK_HIP_ERROR(hipMemcpy(matrixD.data(), d_d, bytesD, hipMemcpyDeviceToHost));
+
+    // Setup and run reference computation for each problem
+    std::vector<float16_t> matrixD_ref(offsetsC[groupCount],
+                                       std::numeric_limits<float16_t>::signaling_NaN());
+    for(uint32_t i = 0; i < groupCount; ++i)
+    {
+        gemm_cpu_h<float16_t, float16_t, float32_t, row_major, col_major, row_major>(
+            groupM[i],
+            n,
+            k,
+            matrixA.data() + offsetsA[i],
+            matrixB.data() + size_t(k) * n * i,
+            matrixC.data() + offsetsC[i],
+            matrixD_ref.data() + offsetsC[i],
+            lda,
+            ldb,
+            ldc,
+            ldd,
+            problems[i].alpha,
+            problems[i].beta);
+    }
+
+    auto res = compareEqual<float16_t>(matrixD.data(), matrixD_ref.data(), matrixD.size());
+
+    if(std::get<0>(res) == false)
+    {
+        std::cout << "FAILED!\n";
+    }
+    else
+    {
+        std::cout << "PASSED!\n";
+    }
+
+    std::cout << "Max relative error: " << std::get<1>(res) << std::endl;
+
+#endif // !NDEBUG
+
+    // Release device memory
+    CHECK_HIP_ERROR(hipFree(d_a));
+    CHECK_HIP_ERROR(hipFree(d_b));
+    CHECK_HIP_ERROR(hipFree(d_c));
+    CHECK_HIP_ERROR(hipFree(d_d));
+    CHECK_HIP_ERROR(hipFree(d_problems));
+    CHECK_HIP_ERROR(hipFree(d_tileOffsets));
+
+    std::cout << "Finished!" << std::endl;
+}
+
+int main()
+{
+    // Mixture of experts: tokens routed unevenly to 8 experts
+    grouped_gemm_test({256, 64, 512, 16, 128, 0, 320, 48}, 512, 256);
+    return 0;
+}
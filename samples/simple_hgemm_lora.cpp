@@ -0,0 +1,639 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_fp16.h>
+#include <hip/hip_runtime.h>
+
+#include <rocwmma/rocwmma.hpp>
+#include <rocwmma/rocwmma_epilogue.hpp>
+
+#include "common.hpp"
+
+using rocwmma::accumulator;
+using rocwmma::col_major;
+using rocwmma::float16_t;
+using rocwmma::float32_t;
+using rocwmma::matrix_a;
+using rocwmma::matrix_b;
+using rocwmma::row_major;
+
+// Supports ROCWMMA_M/N square sizes of
+// : 16 x 16
+// : 32 x 32 ( only MI )
+const int ROCWMMA_M = 16;
+const int ROCWMMA_N = 16;
+
+// Supports ROCWMMA_K sizes as
+// : multiples of 16.
+const int ROCWMMA_K = 16;
+
+// Device warp size
+const uint32_t WAVE_SIZE = getWarpSize();
+
+// Thread block
+// : T_BLOCK_X is one wave, such that all waves of the
+//   workgroup share the same BLOCK_M rows of X.
+// Note: Each wave will compute one BLOCK_M x BLOCK_N output block
+// Note: Workgroup will compute
+//  1 x T_BLOCK_Y output blocks
+const int T_BLOCK_X = WAVE_SIZE;
+const int T_BLOCK_Y = 4;
+
+// Maximum adapter rank: each wave of the workgroup projects one
+// BLOCK_N wide rank block of the low-rank path.
+const uint32_t MAX_RANK = ROCWMMA_N * T_BLOCK_Y;
+
+// Epilogue stage zeroing the rows of the low-rank projection that
+// select a different adapter. fragIds holds the broadcast adapter
+// index of each row.
+template <typename FragIds>
+struct AdapterMask
+{
+    __device__ AdapterMask(FragIds const& fragIds, int32_t adapter)
+        : mFragIds(fragIds)
+        , mAdapter(adapter)
+    {
+    }
+
+    template <typename T>
+    __device__ inline T operator()(T value, uint32_t idx) const
+    {
+        return mFragIds.x[idx] == mAdapter ? value : static_cast<T>(0);
+    }
+
+    FragIds const& mFragIds;
+    int32_t        mAdapter;
+};
+
+// The following device kernel is a naive implementation of blocked GEMM
+// with a fused LoRA adapter path. Each wave will compute one BLOCK_M x BLOCK_N
+// output block of the M x N x K GEMM, generalized as:
+// Y = X x W + scale * (X x A[adapter[row]]) x B[adapter[row]]
+//
+// Where:
+// : adapter is a per-row index     (M), selecting the LoRA adapter of each
+//                                       token, or -1 for the base model only
+// : A[i] is a down projection      (K x rank)
+// : B[i] is an up projection       (rank x N)
+//
+// The low-rank projection T = X x A of the first adapter in the block rows
+// shares the X fragments of the main GEMM loop, with each wave computing one
+// BLOCK_N wide rank block of T. Rows of other adapters are masked out of T,
+// which is staged in LDS and multiplied by B into the same accumulators as
+// X x W. Block rows spanning several requests re-project X for each further
+// adapter. Un-fused, T is written by a separate shrink kernel, and Y is read
+// and written again by a separate expand kernel.
+//
+// In this simplified example, we assume:
+// : X is in row-major format        (M x K)
+// : W is in col-major format        (K x N)
+// : A[i] is in col-major format     (K x rank), i.e. rank x K row-major
+// : B[i] is in col-major format     (rank x N), i.e. N x rank row-major
+// : Y is in row-major format        (M x N)
+// : rank is a multiple of BLOCK_N, up to MAX_RANK. Lower ranks are zero padded.
+// : M, N are multiples of the workgroup tile, such that all waves of the
+//   workgroup reach the workgroup barriers.
+//
+// Note: This is a simplified implementation to demonstrate API usage in
+// context of wave-level GEMM computation, and is not optimized.
+template <bool FuseLora>
+__global__ void hgemm_lora_rocwmma_d(uint32_t         m,
+                                     uint32_t         n,
+                                     uint32_t         k,
+                                     float16_t const* x,
+                                     float16_t const* w,
+                                     float16_t const* loraA,
+                                     float16_t const* loraB,
+                                     int32_t const*   adapterIds,
+                                     float16_t*       y,
+                                     uint32_t         ldx,
+                                     uint32_t         ldw,
+                                     uint32_t         ldy,
+                                     uint32_t         rank,
+                                     float32_t        loraScale)
+{
+    using FragX
+        = rocwmma::fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, row_major>;
+    using FragW
+        = rocwmma::fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, col_major>;
+    using FragAcc = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float32_t>;
+    using FragOut = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t>;
+    using FragIds = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, int32_t>;
+
+    // Low-rank projection of the block rows, BLOCK_M x rank
+    __shared__ float16_t ldsT[ROCWMMA_M * MAX_RANK];
+
+    // Create frags
+    auto fragX   = FragX();
+    auto fragW   = FragW();
+    auto fragAcc = FragAcc();
+    auto fragY   = FragOut();
+
+    // Low-rank path frags
+    auto fragLoraA = FragW();
+    auto fragLoraB = FragW();
+    auto fragT     = FragAcc();
+    auto fragT16   = FragOut();
+    auto fragTA    = FragX();
+    auto fragIds   = FragIds();
+
+    rocwmma::fill_fragment(fragAcc, 0.0f);
+    rocwmma::fill_fragment(fragT, 0.0f);
+
+    // Tile using a 2D grid
+    auto majorWarp = (blockIdx.x * blockDim.x + threadIdx.x) / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    auto minorWarp = (blockIdx.y * blockDim.y + threadIdx.y);
+
+    // Target Y block
+    auto cRow = majorWarp * ROCWMMA_M;
+    auto cCol = minorWarp * ROCWMMA_N;
+
+    // Rank block of T projected by this wave
+    auto rankBlock = threadIdx.y * ROCWMMA_N;
+    auto projects  = rankBlock < rank;
+
+    // First adapter selected in the block rows, projected alongside the main GEMM
+    int32_t first = -1;
+    if constexpr(FuseLora)
+    {
+        for(uint32_t r = 0; r < ROCWMMA_M && first < 0; r++)
+        {
+            first = adapterIds[cRow + r];
+        }
+    }
+
+    // fragAcc = X x W, fragT = X x A[first]
+    for(int i = 0; i < k; i += ROCWMMA_K)
+    {
+        // Load the inputs
+        rocwmma::load_matrix_sync(fragX, x + (cRow * ldx + i), ldx);
+        rocwmma::load_matrix_sync(fragW, w + (i + cCol * ldw), ldw);
+
+        // Matrix multiply - accumulate using MFMA units
+        rocwmma::mma_sync(fragAcc, fragX, fragW, fragAcc);
+
+        if constexpr(FuseLora)
+        {
+            // Low-rank projection reuses fragX
+            if(first >= 0 && projects)
+            {
+                rocwmma::load_matrix_sync(
+                    fragLoraA, loraA + (first * rank * k + rankBlock * k + i), k);
+                rocwmma::mma_sync(fragT, fragX, fragLoraA, fragT);
+            }
+        }
+    }
+
+    if constexpr(FuseLora)
+    {
+        rocwmma::load_col_vector_sync(fragIds, adapterIds + cRow);
+
+        // Merge each distinct adapter of the block rows. The loop is uniform
+        // across the workgroup, as all waves share the block rows.
+        for(uint32_t r = 0; r < ROCWMMA_M; r++)
+        {
+            auto adapter = adapterIds[cRow + r];
+
+            auto isNew = adapter >= 0;
+            for(uint32_t prev = 0; prev < r && isNew; prev++)
+            {
+                isNew = adapterIds[cRow + prev] != adapter;
+            }
+
+            if(!isNew)
+            {
+                continue;
+            }
+
+            // Further adapters re-project X
+            if(adapter != first && projects)
+            {
+                rocwmma::fill_fragment(fragT, 0.0f);
+                for(int i = 0; i < k; i += ROCWMMA_K)
+                {
+                    rocwmma::load_matrix_sync(fragX, x + (cRow * ldx + i), ldx);
+                    rocwmma::load_matrix_sync(
+                        fragLoraA, loraA + (adapter * rank * k + rankBlock * k + i), k);
+                    rocwmma::mma_sync(fragT, fragX, fragLoraA, fragT);
+                }
+            }
+
+            // T = scale * T of the adapter rows, staged in LDS as BLOCK_M x rank
+            if(projects)
+            {
+                rocwmma::apply_epilogue(fragT16,
+                                        fragT,
+                                        AdapterMask(fragIds, adapter),
+                                        rocwmma::epilogue::TensorScale(loraScale));
+                rocwmma::store_matrix_sync(ldsT + rankBlock, fragT16, rank, rocwmma::mem_row_major);
+            }
+            rocwmma::synchronize_workgroup();
+
+            // fragAcc += T x B[adapter]
+            for(uint32_t j = 0; j < rank; j += ROCWMMA_K)
+            {
+                rocwmma::load_matrix_sync(fragTA, ldsT + j, rank);
+                rocwmma::load_matrix_sync(
+                    fragLoraB, loraB + (adapter * n * rank + j + cCol * rank), rank);
+                rocwmma::mma_sync(fragAcc, fragTA, fragLoraB, fragAcc);
+            }
+
+            // T is overwritten by the next adapter
+            rocwmma::synchronize_workgroup();
+        }
+    }
+
+    // Convert and store to Y
+    rocwmma::apply_epilogue(fragY, fragAcc);
+    rocwmma::store_matrix_sync(y + (cRow * ldy + cCol), fragY, ldy, rocwmma::mem_row_major);
+}
+
+// Un-fused LoRA shrink: T = scale * X x A[adapter[row]], one thread per element of T
+__global__ void lora_shrink_d(uint32_t         k,
+                              float16_t const* x,
+                              float16_t const* loraA,
+                              int32_t const*   adapterIds,
+                              float16_t*       t,
+                              uint32_t         ldx,
+                              uint32_t         rank,
+                              float32_t        loraScale)
+{
+    auto row     = blockIdx.x;
+    auto col     = threadIdx.x;
+    auto adapter = adapterIds[row];
+
+    auto accum = 0.0f;
+    if(adapter >= 0)
+    {
+        auto a = loraA + (adapter * rank * k + col * k);
+        for(uint32_t i = 0; i < k; i++)
+        {
+            accum += static_cast<float32_t>(x[row * ldx + i]) * static_cast<float32_t>(a[i]);
+        }
+    }
+    t[row * rank + col] = static_cast<float16_t>(loraScale * accum);
+}
+
+// Un-fused LoRA expand: Y += T x B[adapter[row]], one thread per element of Y
+__global__ void lora_expand_d(uint32_t         n,
+                              float16_t const* t,
+                              float16_t const* loraB,
+                              int32_t const*   adapterIds,
+                              float16_t*       y,
+                              uint32_t         ldy,
+                              uint32_t         rank)
+{
+    auto col     = blockIdx.x * blockDim.x + threadIdx.x;
+    auto row     = blockIdx.y;
+    auto adapter = adapterIds[row];
+
+    if(col < n && adapter >= 0)
+    {
+        auto b     = loraB + (adapter * n * rank + col * rank);
+        auto accum = static_cast<float32_t>(y[row * ldy + col]);
+        for(uint32_t j = 0; j < rank; j++)
+        {
+            accum += static_cast<float32_t>(t[row * rank + j]) * static_cast<float32_t>(b[j]);
+        }
+        y[row * ldy + col] = static_cast<float16_t>(accum);
+    }
+}
+
+// Host reference of the LoRA GEMM. T is rounded to float16_t, as on the device.
+__host__ void lora_cpu_h(uint32_t         m,
+                         uint32_t         n,
+                         uint32_t         k,
+                         float16_t const* x,
+                         float16_t const* w,
+                         float16_t const* loraA,
+                         float16_t const* loraB,
+                         int32_t const*   adapterIds,
+                         float16_t*       y,
+                         uint32_t         ldx,
+                         uint32_t         ldw,
+                         uint32_t         ldy,
+                         uint32_t         rank,
+                         float32_t        loraScale)
+{
+#pragma omp parallel for
+    for(int i = 0; i < m; ++i)
+    {
+        auto                   adapter = adapterIds[i];
+        std::vector<float32_t> t(rank, 0.0f);
+        for(int r = 0; adapter >= 0 && r < rank; ++r)
+        {
+            auto accum = 0.0f;
+            for(int h = 0; h < k; ++h)
+            {
+                accum += static_cast<float32_t>(x[i * ldx + h])
+                         * static_cast<float32_t>(loraA[adapter * rank * k + r * k + h]);
+            }
+            t[r] = static_cast<float32_t>(static_cast<float16_t>(loraScale * accum));
+        }
+
+        for(int j = 0; j < n; ++j)
+        {
+            auto accum = 0.0f;
+            for(int h = 0; h < k; ++h)
+            {
+                accum += static_cast<float32_t>(x[i * ldx + h])
+                         * static_cast<float32_t>(w[j * ldw + h]);
+            }
+            for(int r = 0; adapter >= 0 && r < rank; ++r)
+            {
+                accum += t[r] * static_cast<float32_t>(loraB[adapter * n * rank + j * rank + r]);
+            }
+            y[i * ldy + j] = static_cast<float16_t>(accum);
+        }
+    }
+}
+
+__host__ void
+    gemm_test(uint32_t m, uint32_t n, uint32_t k, uint32_t adapterCount, uint32_t adapterRank)
+{
+    // Adapters are zero padded to a multiple of BLOCK_N ranks
+    uint32_t rank = rocwmma::ceilDiv(adapterRank, ROCWMMA_N) * ROCWMMA_N;
+
+    // Bounds check
+    if((m < ROCWMMA_M || n < (ROCWMMA_N * T_BLOCK_Y) || k < ROCWMMA_K)
+       || (m % ROCWMMA_M || n % (ROCWMMA_N * T_BLOCK_Y) || k % ROCWMMA_K) || rank > MAX_RANK)
+    {
+        std::cout << "Unsupported size!\n";
+        return;
+    }
+
+    int       ldx       = k;
+    int       ldw       = k;
+    int       ldy       = n;
+    float32_t loraScale = 2.0f / static_cast<float32_t>(adapterRank);
+
+    std::cout << "Initializing host data..." << std::endl;
+
+    // Initialize input matrices
+    std::vector<float16_t> matrixX(m * k);
+    std::vector<float16_t> matrixW(k * n);
+    std::vector<float16_t> loraA(adapterCount * rank * k, static_cast<float16_t>(0));
+    std::vector<float16_t> loraB(adapterCount * n * rank, static_cast<float16_t>(0));
+    std::vector<int32_t>   adapterIds(m);
+    // Fill outputs with NaN to catch contamination
+    std::vector<float16_t> matrixY(m * n, std::numeric_limits<float16_t>::signaling_NaN());
+    std::vector<float16_t> matrixYUnfused(m * n, std::numeric_limits<float16_t>::signaling_NaN());
+
+    fillRand(matrixX.data(), m, k);
+    fillRand(matrixW.data(), k, n);
+
+    // Adapter weights in [-0.5, 0.5], leaving the padded ranks at 0
+    auto randWeight = []() {
+        return static_cast<float16_t>(static_cast<float32_t>(rand()) / RAND_MAX - 0.5f);
+    };
+    for(int i = 0; i < adapterCount; ++i)
+    {
+        for(int r = 0; r < adapterRank; ++r)
+        {
+            for(int h = 0; h < k; ++h)
+            {
+                loraA[i * rank * k + r * k + h] = randWeight();
+            }
+            for(int j = 0; j < n; ++j)
+            {
+                loraB[i * n * rank + j * rank + r] = randWeight();
+            }
+        }
+    }
+
+    // Batched requests of 1 to 96 tokens, each selecting one adapter or
+    // the base model only (-1). Block rows may span several requests.
+    for(int i = 0; i < m;)
+    {
+        auto length  = std::min<int>(1 + rand() % 96, m - i);
+        auto adapter = static_cast<int32_t>(rand() % (adapterCount + 1)) - 1;
+        std::fill(adapterIds.begin() + i, adapterIds.begin() + i + length, adapter);
+        i += length;
+    }
+
+    std::cout << "Initializing device data..." << std::endl;
+
+    // Allocate and copy device memory
+    float16_t* d_x;
+    float16_t* d_w;
+    float16_t* d_loraA;
+    float16_t* d_loraB;
+    int32_t*   d_adapterIds;
+    float16_t* d_t;
+    float16_t* d_y;
+
+    const size_t bytesX     = matrixX.size() * sizeof(float16_t);
+    const size_t bytesW     = matrixW.size() * sizeof(float16_t);
+    const size_t bytesLoraA = loraA.size() * sizeof(float16_t);
+    const size_t bytesLoraB = loraB.size() * sizeof(float16_t);
+    const size_t bytesIds   = adapterIds.size() * sizeof(int32_t);
+    const size_t bytesT     = m * rank * sizeof(float16_t);
+    const size_t bytesY     = matrixY.size() * sizeof(float16_t);
+
+    CHECK_HIP_ERROR(hipMalloc(&d_x, bytesX));
+    CHECK_HIP_ERROR(hipMalloc(&d_w, bytesW));
+    CHECK_HIP_ERROR(hipMalloc(&d_loraA, bytesLoraA));
+    CHECK_HIP_ERROR(hipMalloc(&d_loraB, bytesLoraB));
+    CHECK_HIP_ERROR(hipMalloc(&d_adapterIds, bytesIds));
+    CHECK_HIP_ERROR(hipMalloc(&d_t, bytesT));
+    CHECK_HIP_ERROR(hipMalloc(&d_y, bytesY));
+
+    CHECK_HIP_ERROR(hipMemcpy(d_x, matrixX.data(), bytesX, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_w, matrixW.data(), bytesW, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_loraA, loraA.data(), bytesLoraA, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_loraB, loraB.data(), bytesLoraB, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_adapterIds, adapterIds.data(), bytesIds, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_y, matrixY.data(), bytesY, hipMemcpyHostToDevice));
+
+    auto blockDim = dim3(T_BLOCK_X, T_BLOCK_Y);
+    auto gridDim
+        = dim3(rocwmma::ceilDiv(m, ROCWMMA_M), rocwmma::ceilDiv(n, ROCWMMA_N * T_BLOCK_Y));
+
+    hipEvent_t startEvent, stopEvent;
+    CHECK_HIP_ERROR(hipEventCreate(&startEvent));
+    CHECK_HIP_ERROR(hipEventCreate(&stopEvent));
+
+    std::cout << "Launching fused LoRA GEMM kernel..." << std::endl;
+
+    auto fusedTimeMs = 0.0f;
+    hipExtLaunchKernelGGL(hgemm_lora_rocwmma_d<true>,
+                          gridDim,
+                          blockDim,
+                          0, // sharedMemBytes
+                          0, // stream
+                          startEvent, // Event start
+                          stopEvent, // event stop
+                          0, // flags
+                          m,
+                          n,
+                          k,
+                          d_x,
+                          d_w,
+                          d_loraA,
+                          d_loraB,
+                          d_adapterIds,
+                          d_y,
+                          ldx,
+                          ldw,
+                          ldy,
+                          rank,
+                          loraScale);
+    CHECK_HIP_ERROR(hipEventSynchronize(stopEvent));
+    CHECK_HIP_ERROR(hipEventElapsedTime(&fusedTimeMs, startEvent, stopEvent));
+    CHECK_HIP_ERROR(hipMemcpy(matrixY.data(), d_y, bytesY, hipMemcpyDeviceToHost));
+
+    std::cout << "Launching un-fused GEMM, shrink and expand kernels..." << std::endl;
+
+    auto unfusedTimeMs = 0.0f;
+    CHECK_HIP_ERROR(hipMemset(d_y, 0, bytesY));
+    CHECK_HIP_ERROR(hipEventRecord(startEvent));
+    hipLaunchKernelGGL(hgemm_lora_rocwmma_d<false>,
+                       gridDim,
+                       blockDim,
+                       0, // sharedMemBytes
+                       0, // stream
+                       m,
+                       n,
+                       k,
+                       d_x,
+                       d_w,
+                       d_loraA,
+                       d_loraB,
+                       d_adapterIds,
+                       d_y,
+                       ldx,
+                       ldw,
+                       ldy,
+                       rank,
+                       loraScale);
+    hipLaunchKernelGGL(lora_shrink_d,
+                       dim3(m),
+                       dim3(rank),
+                       0, // sharedMemBytes
+                       0, // stream
+                       k,
+                       d_x,
+                       d_loraA,
+                       d_adapterIds,
+                       d_t,
+                       ldx,
+                       rank,
+                       loraScale);
+    hipLaunchKernelGGL(lora_expand_d,
+                       dim3(rocwmma::ceilDiv(n, 256u), m),
+                       dim3(256u),
+                       0, // sharedMemBytes
+                       0, // stream
+                       n,
+                       d_t,
+                       d_loraB,
+                       d_adapterIds,
+                       d_y,
+                       ldy,
+                       rank);
+    CHECK_HIP_ERROR(hipEventRecord(stopEvent));
+    CHECK_HIP_ERROR(hipEventSynchronize(stopEvent));
+    CHECK_HIP_ERROR(hipEventElapsedTime(&unfusedTimeMs, startEvent, stopEvent));
+    CHECK_HIP_ERROR(hipMemcpy(matrixYUnfused.data(), d_y, bytesY, hipMemcpyDeviceToHost));
+
+    CHECK_HIP_ERROR(hipEventDestroy(startEvent));
+    CHECK_HIP_ERROR(hipEventDestroy(stopEvent));
+
+    // GEMM flops converge to 2*mnk, excluding the low-rank path
+    auto gFlops       = calculateGFlops(m, n, k);
+    auto tFlopsPerSec = gFlops / static_cast<double>(fusedTimeMs);
+
+    // Echo performance
+    std::cout << "BlkM, BlkN, BlkK, "
+              << "MatM, MatN, MatK, "
+              << "adapters, rank, "
+              << "fusedMs, unfusedMs, "
+              << "Problem Size(GFlops), TFlops/s" << std::endl;
+
+    std::cout << ROCWMMA_M << ", " << ROCWMMA_N << ", " << ROCWMMA_K << ", " << m << ", " << n
+              << ", " << k << ", " << adapterCount << ", " << adapterRank << ", " << fusedTimeMs
+              << ", " << unfusedTimeMs << ", " << gFlops << ", " << tFlopsPerSec << std::endl;
+
+#if !NDEBUG
+
+    std::cout << "Validating result with reference..." << std::endl;
+
+    std::vector<float16_t> matrixY_ref(m * n, std::numeric_limits<float16_t>::signaling_NaN());
+    lora_cpu_h(m,
+               n,
+               k,
+               matrixX.data(),
+               matrixW.data(),
+               loraA.data(),
+               loraB.data(),
+               adapterIds.data(),
+               matrixY_ref.data(),
+               ldx,
+               ldw,
+               ldy,
+               rank,
+               loraScale);
+
+    auto res        = compareEqual<float16_t>(matrixY.data(), matrixY_ref.data(), m * n);
+    auto resUnfused = compareEqual<float16_t>(matrixYUnfused.data(), matrixY_ref.data(), m * n);
+
+    if(std::get<0>(res) == false || std::get<0>(resUnfused) == false)
+    {
+        std::cout << "FAILED!\n";
+    }
+    else
+    {
+        std::cout << "PASSED!\n";
+    }
+
+    std::cout << "Max relative error: " << std::get<1>(res) << std::endl;
+
+#endif // !NDEBUG
+
+    // Release device memory
+    CHECK_HIP_ERROR(hipFree(d_x));
+    CHECK_HIP_ERROR(hipFree(d_w));
+    CHECK_HIP_ERROR(hipFree(d_loraA));
+    CHECK_HIP_ERROR(hipFree(d_loraB));
+    CHECK_HIP_ERROR(hipFree(d_adapterIds));
+    CHECK_HIP_ERROR(hipFree(d_t));
+    CHECK_HIP_ERROR(hipFree(d_y));
+
+    std::cout << "Finished!" << std::endl;
+}
+
+int main()
+{
+    // Low and high adapter ranks, rank 8 zero padded to 16
+    gemm_test(1024, 1024, 1024, 8, 8);
+    gemm_test(1024, 1024, 1024, 8, 64);
+    return 0;
+}
@@ -0,0 +1,353 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_fp16.h>
+#include <hip/hip_runtime.h>
+
+#include <rocwmma/rocwmma.hpp>
+
+#include "benchmark_harness.hpp"
+#include "common.hpp"
+
+using rocwmma::accumulator;
+using rocwmma::col_major;
+using rocwmma::float16_t;
+using rocwmma::float32_t;
+using rocwmma::index_t;
+using rocwmma::matrix_a;
+using rocwmma::matrix_b;
+using rocwmma::row_major;
+
+// Supports ROCWMMA_M/N square sizes of
+// : 16 x 16
+// : 32 x 32 ( only MI )
+const int ROCWMMA_M = 16;
+const int ROCWMMA_N = 16;
+
+// Supports ROCWMMA_K sizes as
+// : multiples of 16.
+const int ROCWMMA_K = 16;
+
+// Device warp size
+const uint32_t WAVE_SIZE = getWarpSize();
+
+// Thread block
+// : T_BLOCK_X must be multiple of WAVE_SIZE.
+// Note: Each wave will compute one BLOCK_M x BLOCK_N output block
+// Note: Workgroup will compute one tile of
+//  T_BLOCK_X / WAVE_SIZE x T_BLOCK_Y output blocks
+const int T_BLOCK_X = 2 * WAVE_SIZE;
+const int T_BLOCK_Y = 2;
+
+// Workgroup tile size
+const uint32_t TILE_M = ROCWMMA_M * T_BLOCK_X / WAVE_SIZE;
+const uint32_t TILE_N = ROCWMMA_N * T_BLOCK_Y;
+
+// The following device kernel computes the expert layer of a Mixture of Experts
+// (MoE) with top-1 routing, Y[t] = X[t] x W[expert(t)], in a single launch.
+//
+// Tokens are routed by a list of token indices sorted by expert. The list of
+// each expert is padded with -1 to a multiple of TILE_M, such that every
+// workgroup tile belongs to exactly one expert:
+//
+//  Routed tokens:   | 5  0  7 -1 | 2  3 -1 -1 | 1  4  6 -1 |
+//  Expert offsets:  [0, 4, 8, 12]
+//
+// Rather than permuting X into expert order, running the GEMM and permuting
+// the results back, the kernel gathers the rows of A straight from X with
+// load_matrix_gather_sync, and scatters the rows of D straight into Y with
+// store_matrix_scatter_sync. Padding rows are zero-filled on load and are
+// never stored.
+//
+// In this simplified example, we assume:
+// : X is in row-major format       (Tokens x K)
+// : W of each expert is col-major  (K x N)
+// : Y is in row-major format       (Tokens x N)
+// : N and K are multiples of the block sizes
+// : Routing is computed on the host
+// : No LDS required
+//
+// Note: This is a simplified implementation to demonstrate API usage in
+// context of wave-level GEMM computation, and is not optimized.
+
+// Finds the expert of the given routed row in the prefix sum:
+// largest i such that expertOffsets[i] <= row.
+__device__ static inline uint32_t
+    findExpert(uint32_t const* expertOffsets, uint32_t expertCount, uint32_t row)
+{
+    uint32_t lo = 0u;
+    uint32_t hi = expertCount;
+    while(hi - lo > 1u)
+    {
+        auto mid = (lo + hi) / 2u;
+        if(expertOffsets[mid] <= row)
+        {
+            lo = mid;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+__global__ void hgemm_moe_rocwmma_d(uint32_t         n,
+                                    uint32_t         k,
+                                    float16_t const* x,
+                                    float16_t const* w,
+                                    float16_t*       y,
+                                    index_t const*   routedTokens,
+                                    uint32_t const*  expertOffsets,
+                                    uint32_t         expertCount)
+{
+    // Create frags
+    auto fragA
+        = rocwmma::fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, row_major>();
+    auto fragB
+        = rocwmma::fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, col_major>();
+    auto fragAcc = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float32_t>();
+    auto fragD
+        = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, row_major>();
+
+    // Target routed row and output column of the warp block
+    auto row = (blockIdx.x * blockDim.x + threadIdx.x) / rocwmma::Constants::AMDGCN_WAVE_SIZE
+               * ROCWMMA_M;
+    auto col = (blockIdx.y * blockDim.y + threadIdx.y) * ROCWMMA_N;
+
+    // Bounds check
+    if(row < expertOffsets[expertCount] && col < n)
+    {
+        auto  expert  = findExpert(expertOffsets, expertCount, row);
+        auto* wExpert = w + size_t(expert) * k * n;
+        auto* tokens  = routedTokens + row;
+
+        rocwmma::fill_fragment(fragAcc, 0.0f);
+
+        // fragAcc = X[tokens] x W[expert]
+        for(int i = 0; i < k; i += ROCWMMA_K)
+        {
+            // Gather the token rows of A, load the expert weights of B
+            rocwmma::load_matrix_gather_sync(fragA, x + i, tokens, k);
+            rocwmma::load_matrix_sync(fragB, wExpert + (i + col * k), k);
+
+            // Matrix multiply - accumulate using MFMA units
+            rocwmma::mma_sync(fragAcc, fragA, fragB, fragAcc);
+        }
+
+        for(int i = 0; i < fragD.num_elements; ++i)
+        {
+            fragD.x[i] = static_cast<float16_t>(fragAcc.x[i]);
+        }
+
+        // Scatter the rows of D back to token order
+        rocwmma::store_matrix_scatter_sync(y + col, fragD, tokens, n);
+    }
+}
+
+__host__ void moe_test(uint32_t tokenCount, uint32_t expertCount, uint32_t n, uint32_t k)
+{
+    // Bounds check
+    if(n % ROCWMMA_N || k % ROCWMMA_K || k < ROCWMMA_K)
+    {
+        std::cout << "Unsupported size!\n";
+        return;
+    }
+
+    std::cout << "Initializing host data..." << std::endl;
+
+    // Top-1 routing with an uneven load across experts
+    std::vector<uint32_t> tokenExpert(tokenCount);
+    for(uint32_t t = 0; t < tokenCount; ++t)
+    {
+        tokenExpert[t] = (t * 7u + t / 5u) % expertCount;
+        tokenExpert[t] = std::min(tokenExpert[t], (t * 3u) % expertCount);
+    }
+
+    // Routed token list, sorted by expert and padded to TILE_M per expert
+    std::vector<uint32_t> expertOffsets(expertCount + 1, 0u);
+    std::vector<index_t>  routedTokens;
+    for(uint32_t e = 0; e < expertCount; ++e)
+    {
+        expertOffsets[e] = routedTokens.size();
+        for(uint32_t t = 0; t < tokenCount; ++t)
+        {
+            if(tokenExpert[t] == e)
+            {
+                routedTokens.push_back(static_cast<index_t>(t));
+            }
+        }
+        routedTokens.resize(rocwmma::ceilDiv(routedTokens.size(), TILE_M) * TILE_M, -1);
+    }
+    expertOffsets[expertCount] = routedTokens.size();
+
+    std::vector<float16_t> matrixX(size_t(tokenCount) * k);
+    std::vector<float16_t> matrixW(size_t(k) * n * expertCount);
+    // Fill outputs with NaN to catch contamination
+    std::vector<float16_t> matrixY(size_t(tokenCount) * n,
+                                   std::numeric_limits<float16_t>::signaling_NaN());
+
+    fillRand(matrixX.data(), tokenCount, k);
+    fillRand(matrixW.data(), n * expertCount, k);
+
+    std::cout << "Initializing device data..." << std::endl;
+
+    // Allocate and copy device memory
+    float16_t* d_x;
+    float16_t* d_w;
+    float16_t* d_y;
+    index_t*   d_routedTokens;
+    uint32_t*  d_expertOffsets;
+
+    const size_t bytesX       = matrixX.size() * sizeof(float16_t);
+    const size_t bytesW       = matrixW.size() * sizeof(float16_t);
+    const size_t bytesY       = matrixY.size() * sizeof(float16_t);
+    const size_t bytesRouted  = routedTokens.size() * sizeof(index_t);
+    const size_t bytesOffsets = expertOffsets.size() * sizeof(uint32_t);
+
+    CHECK_HIP_ERROR(hipMalloc(&d_x, bytesX));
+    CHECK_HIP_ERROR(hipMalloc(&d_w, bytesW));
+    CHECK_HIP_ERROR(hipMalloc(&d_y, bytesY));
+    CHECK_HIP_ERROR(hipMalloc(&d_routedTokens, bytesRouted));
+    CHECK_HIP_ERROR(hipMalloc(&d_expertOffsets, bytesOffsets));
+
+    CHECK_HIP_ERROR(hipMemcpy(d_x, matrixX.data(), bytesX, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_w, matrixW.data(), bytesW, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_y, matrixY.data(), bytesY, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(
+        hipMemcpy(d_routedTokens, routedTokens.data(), bytesRouted, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(
+        hipMemcpy(d_expertOffsets, expertOffsets.data(), bytesOffsets, hipMemcpyHostToDevice));
+
+    auto routedRows = expertOffsets[expertCount];
+    auto blockDim   = dim3(T_BLOCK_X, T_BLOCK_Y);
+    auto gridDim    = dim3(rocwmma::ceilDiv(routedRows, TILE_M), rocwmma::ceilDiv(n, TILE_N));
+
+    auto moeKernel = [&]() {
+        hipExtLaunchKernelGGL(hgemm_moe_rocwmma_d,
+                              gridDim,
+                              blockDim,
+                              0, // sharedMemBytes
+                              0, // stream
+                              nullptr, // Event start
+                              nullptr, // event stop
+                              0, // flags
+                              n,
+                              k,
+                              d_x,
+                              d_w,
+                              d_y,
+                              d_routedTokens,
+                              d_expertOffsets,
+                              expertCount);
+    };
+
+    std::cout << "Launching MoE GEMM kernel..." << std::endl;
+
+    // Runs are timed individually, with warm and cold caches
+    BenchmarkHarness harness;
+
+    // Useful flops exclude the padding rows
+    auto gFlops = calculateGFlops(tokenCount, n, k);
+
+    // Echo performance
+    std::cout << "BlkM, BlkN, BlkK, "
+              << "Experts, Tokens, RoutedRows, MatN, MatK, "
+              << "Cache, elapsedMs, Problem Size(GFlops), TFlops/s, "
+              << BenchmarkHarness::statsHeader() << std::endl;
+
+    for(auto cacheState : {BenchmarkHarness::CacheState::Warm, BenchmarkHarness::CacheState::Cold})
+    {
+        auto stats        = harness.run(moeKernel, cacheState);
+        auto tFlopsPerSec = gFlops / stats.mMedianMs;
+
+        std::cout << ROCWMMA_M << ", " << ROCWMMA_N << ", " << ROCWMMA_K << ", " << expertCount
+                  << ", " << tokenCount << ", " << routedRows << ", " << n << ", " << k << ", "
+                  << (cacheState == BenchmarkHarness::CacheState::Warm ? "warm" : "cold") << ", "
+                  << stats.mMedianMs << ", " << gFlops << ", " << tFlopsPerSec << ", ";
+        BenchmarkHarness::printStats(std::cout, stats) << std::endl;
+    }
+
+#if !NDEBUG
+
+    std::cout << "Validating result with reference..." << std::endl;
+
+    // Bring kernel result back to host
+    CHECK_HIP_ERROR(hipMemcpy(matrixY.data(), d_y, bytesY, hipMemcpyDeviceToHost));
+
+    // Reference computation of each token with its expert
+    std::vector<float16_t> matrixY_ref(matrixY.size());
+    for(uint32_t t = 0; t < tokenCount; ++t)
+    {
+        auto* wExpert = matrixW.data() + size_t(tokenExpert[t]) * k * n;
+        for(uint32_t j = 0; j < n; ++j)
+        {
+            float32_t acc = 0.0f;
+            for(uint32_t i = 0; i < k; ++i)
+            {
+                acc += static_cast<float32_t>(matrixX[size_t(t) * k + i])
+                       * static_cast<float32_t>(wExpert[size_t(j) * k + i]);
+            }
+            matrixY_ref[size_t(t) * n + j] = static_cast<float16_t>(acc);
+        }
+    }
+
+    auto res = compareEqual<float16_t>(matrixY.data(), matrixY_ref.data(), matrixY.size());
+
+    if(std::get<0>(res) == false)
+    {
+        std::cout << "FAILED!\n";
+    }
+    else
+    {
+        std::cout << "PASSED!\n";
+    }
+
+    std::cout << "Max relative error: " << std::get<1>(res) << std::endl;
+
+#endif // !NDEBUG
+
+    // Release device memory
+    CHECK_HIP_ERROR(hipFree(d_x));
+    CHECK_HIP_ERROR(hipFree(d_w));
+    CHECK_HIP_ERROR(hipFree(d_y));
+    CHECK_HIP_ERROR(hipFree(d_routedTokens));
+    CHECK_HIP_ERROR(hipFree(d_expertOffsets));
+
+    std::cout << "Finished!" << std::endl;
+}
+
+int main()
+{
+    // Mixture of experts: 4096 tokens routed unevenly to 8 experts
+    moe_test(4096, 8, 512, 256);
+    return 0;
+}
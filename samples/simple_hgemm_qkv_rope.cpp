@@ -0,0 +1,652 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_fp16.h>
+#include <hip/hip_runtime.h>
+
+#include <rocwmma/rocwmma.hpp>
+#include <rocwmma/rocwmma_epilogue.hpp>
+#include <rocwmma/rocwmma_transforms.hpp>
+
+#include "common.hpp"
+
+using rocwmma::accumulator;
+using rocwmma::col_major;
+using rocwmma::float16_t;
+using rocwmma::float32_t;
+using rocwmma::index_t;
+using rocwmma::matrix_a;
+using rocwmma::matrix_b;
+using rocwmma::row_major;
+
+/* Motivation
+*
+* The attention block of a decoder layer starts with the QKV projection of
+* the new tokens, followed by two memory bound passes over its output:
+* - Rotary position embedding (RoPE) of the Q and K heads, rotating each pair
+*   of head dimensions (d, d + HEAD_DIM / 2) by an angle depending on the
+*   position of the token and the dimension.
+* - Writing K and V into the slots of the paged KV cache, located through
+*   the block table of each sequence.
+*
+* This sample applies both in the epilogue of the projection GEMM. Each wave
+* computes all HEAD_DIM columns of one head for ROCWMMA_M tokens, such that
+* both halves of every RoPE pair are held in its accumulators:
+* - The RotaryEmbedding stage rotates the accumulators of the Q and K heads,
+*   taking the dimension of each element from fragment_coords and the
+*   position of its token from the positions vector.
+* - Q is stored to the attention input, and K and V are stored straight into
+*   the page pool with store_matrix_paged_sync.
+*
+* The un-fused path stores the QKV projection, then runs a RoPE kernel and a
+* cache write kernel, each reading the activations back from memory.
+*
+* The batch is a chunked prefill step: each sequence appends a chunk of new
+* tokens after the tokens already in its cache, so that chunks start part
+* way into a page.
+*
+* Note: chunks are multiples of ROCWMMA_M tokens, such that each block of
+* tokens belongs to one sequence.
+*/
+
+// Supports ROCWMMA_M/N square sizes of
+// : 16 x 16
+// : 32 x 32 ( only MI )
+const int ROCWMMA_M = 16;
+const int ROCWMMA_N = 16;
+
+// Supports ROCWMMA_K sizes as
+// : multiples of 16.
+const int ROCWMMA_K = 16;
+
+// Llama-3 8B attention geometry
+const int HIDDEN       = 4096;
+const int HEAD_DIM     = 128;
+const int NUM_Q_HEADS  = 32;
+const int NUM_KV_HEADS = 8;
+const int NUM_HEADS    = NUM_Q_HEADS + 2 * NUM_KV_HEADS;
+const int Q_DIM        = NUM_Q_HEADS * HEAD_DIM;
+const int QKV_DIM      = NUM_HEADS * HEAD_DIM;
+
+// RoPE base frequency
+const float32_t ROPE_THETA = 500000.0f;
+
+// Tokens per page of the KV cache
+const int PAGE_SIZE = 16;
+
+// Accumulator blocks of one head, and the offset of the paired block in the
+// other half of the head
+const int HEAD_BLOCKS = HEAD_DIM / ROCWMMA_N;
+const int HALF_BLOCKS = HEAD_BLOCKS / 2;
+
+// Device warp size
+const uint32_t WAVE_SIZE = getWarpSize();
+
+// Thread block
+// : T_BLOCK_X is one wave, such that all waves of the
+//   workgroup share the same ROCWMMA_M tokens of X.
+// Note: Each wave will compute one ROCWMMA_M x HEAD_DIM head block
+// Note: Workgroup will compute
+//  1 x T_BLOCK_Y heads
+const int T_BLOCK_X = WAVE_SIZE;
+const int T_BLOCK_Y = 4;
+
+using FragX   = rocwmma::fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, row_major>;
+using FragW   = rocwmma::fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, col_major>;
+using FragAcc = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float32_t>;
+using FragOut
+    = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, row_major>;
+using Rope = rocwmma::epilogue::RotaryEmbedding<FragAcc, FragAcc>;
+
+// RoPE angle of a pair of dimensions, as evaluated by the RotaryEmbedding stage
+__host__ __device__ inline float32_t rope_angle(index_t position, uint32_t pair)
+{
+    return static_cast<float32_t>(position)
+           * exp2f(-log2f(ROPE_THETA) / static_cast<float32_t>(HEAD_DIM / 2)
+                   * static_cast<float32_t>(pair));
+}
+
+// The following device kernel is a naive implementation of the QKV projection
+// GEMM of a decoder layer. Each wave will compute the ROCWMMA_M x HEAD_DIM
+// block of one head for ROCWMMA_M tokens:
+// QKV = X x Wqkv
+//
+// Fused, Q and K are rotated in registers by the RotaryEmbedding stage, Q is
+// stored to q, and K and V are stored into the page pools of their KV head
+// at the positions of the tokens. Un-fused, QKV is stored as is.
+//
+// In this simplified example, we assume:
+// : X is in row-major format             (tokens x HIDDEN)
+// : Wqkv is in col-major format          (HIDDEN x QKV_DIM), Q heads, then K and V heads
+// : positions holds the position of each token in its sequence (tokens)
+// : blockSeqs holds the sequence of each block of ROCWMMA_M tokens
+// : blockTables lists the pages of each sequence (batch x maxPages)
+// : q is in row-major format             (tokens x Q_DIM)
+// : kCache, vCache are in row-major pages (NUM_KV_HEADS x numPages x PAGE_SIZE x HEAD_DIM)
+// : qkv is in row-major format           (tokens x QKV_DIM)
+//
+// Note: This is a simplified implementation to demonstrate API usage in
+// context of wave-level GEMM computation, and is not optimized.
+template <bool Fused>
+__global__ void qkv_rope_rocwmma_d(uint32_t         numPages,
+                                   uint32_t         maxPages,
+                                   float16_t const* x,
+                                   float16_t const* wqkv,
+                                   index_t const*   positions,
+                                   int32_t const*   blockSeqs,
+                                   index_t const*   blockTables,
+                                   float16_t*       q,
+                                   float16_t*       kCache,
+                                   float16_t*       vCache,
+                                   float16_t*       qkv)
+{
+    auto fragX   = FragX();
+    auto fragW   = FragW();
+    auto fragOut = FragOut();
+
+    FragAcc fragAcc[HEAD_BLOCKS];
+    for(int j = 0; j < HEAD_BLOCKS; j++)
+    {
+        rocwmma::fill_fragment(fragAcc[j], 0.0f);
+    }
+
+    // Token block of the workgroup, head of the wave
+    auto tokenBlock = blockIdx.x;
+    auto head       = blockIdx.y * blockDim.y + threadIdx.y;
+    auto cRow       = tokenBlock * ROCWMMA_M;
+    auto cCol       = head * HEAD_DIM;
+
+    // fragAcc[j] = X x Wqkv, for each column block j of the head
+    for(int i = 0; i < HIDDEN; i += ROCWMMA_K)
+    {
+        rocwmma::load_matrix_sync(fragX, x + (cRow * HIDDEN + i), HIDDEN);
+        for(int j = 0; j < HEAD_BLOCKS; j++)
+        {
+            rocwmma::load_matrix_sync(
+                fragW, wqkv + (i + (cCol + j * ROCWMMA_N) * HIDDEN), HIDDEN);
+            rocwmma::mma_sync(fragAcc[j], fragX, fragW, fragAcc[j]);
+        }
+    }
+
+    if constexpr(!Fused)
+    {
+        for(int j = 0; j < HEAD_BLOCKS; j++)
+        {
+            rocwmma::apply_epilogue(fragOut, fragAcc[j]);
+            rocwmma::store_matrix_sync(
+                qkv + (cRow * QKV_DIM + cCol + j * ROCWMMA_N), fragOut, QKV_DIM);
+        }
+        return;
+    }
+
+    // Heads are uniform across the wave: Q, K, then V
+    auto isQ    = head < NUM_Q_HEADS;
+    auto isV    = head >= NUM_Q_HEADS + NUM_KV_HEADS;
+    auto kvHead = (head - NUM_Q_HEADS) % NUM_KV_HEADS;
+
+    // Page pool of the KV head, block table of the sequence and cache position of the first token
+    auto* cache = (isV ? vCache : kCache)
+                  + static_cast<size_t>(kvHead) * numPages * PAGE_SIZE * HEAD_DIM;
+    auto* table    = blockTables + blockSeqs[tokenBlock] * maxPages;
+    auto  cacheRow = static_cast<uint32_t>(positions[cRow]);
+
+    for(int j = 0; j < HEAD_BLOCKS; j++)
+    {
+        // Both halves of each pair are rotated from the unrotated accumulators
+        auto col = j * ROCWMMA_N;
+        if(isV)
+        {
+            rocwmma::apply_epilogue(fragOut, fragAcc[j]);
+        }
+        else
+        {
+            rocwmma::apply_epilogue(fragOut,
+                                    fragAcc[j],
+                                    Rope(fragAcc[(j + HALF_BLOCKS) % HEAD_BLOCKS],
+                                         rocwmma::make_coord2d(cRow, col),
+                                         HEAD_DIM,
+                                         ROPE_THETA,
+                                         positions));
+        }
+
+        // Tokens of the block occupy consecutive positions of the sequence
+        if(isQ)
+        {
+            rocwmma::store_matrix_sync(q + (cRow * Q_DIM + cCol + col), fragOut, Q_DIM);
+        }
+        else
+        {
+            rocwmma::store_matrix_paged_sync(
+                cache, fragOut, table, PAGE_SIZE, HEAD_DIM, cacheRow, col);
+        }
+    }
+}
+
+// Un-fused RoPE: rotates the Q and K heads of QKV, storing Q to q and K in
+// place. One thread per pair of dimensions.
+__global__ void rope_d(index_t const* positions, float16_t* qkv, float16_t* q)
+{
+    auto token = blockIdx.x;
+    auto head  = blockIdx.y;
+    auto pair  = threadIdx.x;
+
+    auto* row   = qkv + (token * QKV_DIM + head * HEAD_DIM);
+    auto  angle = rope_angle(positions[token], pair);
+    auto  x0    = static_cast<float32_t>(row[pair]);
+    auto  x1    = static_cast<float32_t>(row[pair + HEAD_DIM / 2]);
+
+    auto* out = head < NUM_Q_HEADS ? q + (token * Q_DIM + head * HEAD_DIM) : row;
+    out[pair] = static_cast<float16_t>(x0 * cosf(angle) - x1 * sinf(angle));
+    out[pair + HEAD_DIM / 2] = static_cast<float16_t>(x1 * cosf(angle) + x0 * sinf(angle));
+}
+
+// Un-fused cache write: copies the K and V heads of QKV into the slots of
+// their tokens. One thread per element.
+__global__ void cache_write_d(uint32_t         numPages,
+                              uint32_t         maxPages,
+                              index_t const*   positions,
+                              int32_t const*   blockSeqs,
+                              index_t const*   blockTables,
+                              float16_t const* qkv,
+                              float16_t*       kCache,
+                              float16_t*       vCache)
+{
+    auto token  = blockIdx.x;
+    auto head   = blockIdx.y;
+    auto d      = threadIdx.x;
+    auto kvHead = head % NUM_KV_HEADS;
+
+    auto position = positions[token];
+    auto page     = blockTables[blockSeqs[token / ROCWMMA_M] * maxPages + position / PAGE_SIZE];
+    auto slot     = (static_cast<size_t>(kvHead) * numPages + page) * PAGE_SIZE
+                + position % PAGE_SIZE;
+
+    auto* cache                = head < NUM_KV_HEADS ? kCache : vCache;
+    cache[slot * HEAD_DIM + d] = qkv[token * QKV_DIM + (NUM_Q_HEADS + head) * HEAD_DIM + d];
+}
+
+// Host reference of the fused QKV projection, rotating the float32 projection
+// and writing K and V through the block tables.
+__host__ void qkv_rope_cpu_h(uint32_t                      numPages,
+                             uint32_t                      maxPages,
+                             std::vector<float16_t> const& x,
+                             std::vector<float16_t> const& wqkv,
+                             std::vector<index_t> const&   positions,
+                             std::vector<int32_t> const&   blockSeqs,
+                             std::vector<index_t> const&   blockTables,
+                             std::vector<float16_t>&       q,
+                             std::vector<float16_t>&       kCache,
+                             std::vector<float16_t>&       vCache)
+{
+    auto tokens = static_cast<int>(positions.size());
+
+#pragma omp parallel for collapse(2)
+    for(int t = 0; t < tokens; ++t)
+    {
+        for(int head = 0; head < NUM_HEADS; ++head)
+        {
+            std::vector<float32_t> proj(HEAD_DIM);
+            for(int d = 0; d < HEAD_DIM; ++d)
+            {
+                auto accum = 0.0f;
+                for(int h = 0; h < HIDDEN; ++h)
+                {
+                    accum += static_cast<float32_t>(x[t * HIDDEN + h])
+                             * static_cast<float32_t>(wqkv[(head * HEAD_DIM + d) * HIDDEN + h]);
+                }
+                proj[d] = accum;
+            }
+
+            std::vector<float16_t> out(HEAD_DIM);
+            for(int d = 0; d < HEAD_DIM; ++d)
+            {
+                auto value = proj[d];
+                if(head < NUM_Q_HEADS + NUM_KV_HEADS)
+                {
+                    auto pair  = d % (HEAD_DIM / 2);
+                    auto angle = rope_angle(positions[t], pair);
+                    value      = d < HEAD_DIM / 2 ? proj[d] * std::cos(angle)
+                                                       - proj[d + HEAD_DIM / 2] * std::sin(angle)
+                                                 : proj[d] * std::cos(angle)
+                                                       + proj[pair] * std::sin(angle);
+                }
+                out[d] = static_cast<float16_t>(value);
+            }
+
+            if(head < NUM_Q_HEADS)
+            {
+                std::copy(out.begin(), out.end(), q.begin() + t * Q_DIM + head * HEAD_DIM);
+            }
+            else
+            {
+                auto  kvHead = (head - NUM_Q_HEADS) % NUM_KV_HEADS;
+                auto& cache  = head < NUM_Q_HEADS + NUM_KV_HEADS ? kCache : vCache;
+                auto  page
+                    = blockTables[blockSeqs[t / ROCWMMA_M] * maxPages + positions[t] / PAGE_SIZE];
+                auto slot = (static_cast<size_t>(kvHead) * numPages + page) * PAGE_SIZE
+                            + positions[t] % PAGE_SIZE;
+                std::copy(out.begin(), out.end(), cache.begin() + slot * HEAD_DIM);
+            }
+        }
+    }
+}
+
+__host__ void qkv_rope_test(std::vector<int32_t> const& contextLens,
+                            std::vector<int32_t> const& chunkLens)
+{
+    auto batch  = static_cast<uint32_t>(chunkLens.size());
+    auto tokens = std::accumulate(chunkLens.begin(), chunkLens.end(), 0u);
+
+    // Bounds check
+    for(auto chunkLen : chunkLens)
+    {
+        if(chunkLen < ROCWMMA_M || chunkLen % ROCWMMA_M)
+        {
+            std::cout << "Unsupported size!\n";
+            return;
+        }
+    }
+
+    // Pages of each sequence, cached and new tokens, allocated in shuffled order
+    // from the pool
+    uint32_t maxPages = 0;
+    uint32_t numPages = 0;
+    for(uint32_t seq = 0; seq < batch; ++seq)
+    {
+        auto pages = rocwmma::ceilDiv(static_cast<uint32_t>(contextLens[seq] + chunkLens[seq]),
+                                      static_cast<uint32_t>(PAGE_SIZE));
+        maxPages   = std::max(maxPages, pages);
+        numPages += pages;
+    }
+
+    std::vector<index_t> pageOrder(numPages);
+    std::iota(pageOrder.begin(), pageOrder.end(), 0);
+    std::shuffle(pageOrder.begin(), pageOrder.end(), std::mt19937(batch));
+
+    // Positions of the new tokens follow the cached tokens of their sequence
+    std::vector<index_t> blockTables(batch * maxPages, -1);
+    std::vector<index_t> positions(tokens);
+    std::vector<int32_t> blockSeqs(tokens / ROCWMMA_M);
+    for(uint32_t seq = 0, next = 0, t = 0; seq < batch; ++seq)
+    {
+        auto seqLen = static_cast<uint32_t>(contextLens[seq] + chunkLens[seq]);
+        for(uint32_t p = 0; p < rocwmma::ceilDiv(seqLen, static_cast<uint32_t>(PAGE_SIZE)); ++p)
+        {
+            blockTables[seq * maxPages + p] = pageOrder[next++];
+        }
+        for(int32_t i = 0; i < chunkLens[seq]; ++i, ++t)
+        {
+            positions[t]             = contextLens[seq] + i;
+            blockSeqs[t / ROCWMMA_M] = seq;
+        }
+    }
+
+    std::cout << "Initializing host data..." << std::endl;
+
+    // Initialize inputs in [-1, 1]. The caches hold the previous tokens of
+    // each sequence, which must be left untouched.
+    auto poolSize = static_cast<size_t>(NUM_KV_HEADS) * numPages * PAGE_SIZE * HEAD_DIM;
+    std::vector<float16_t> x(tokens * HIDDEN);
+    std::vector<float16_t> wqkv(static_cast<size_t>(QKV_DIM) * HIDDEN);
+    std::vector<float16_t> kCache(poolSize);
+    std::vector<float16_t> vCache(poolSize);
+    std::vector<float16_t> q(tokens * Q_DIM, std::numeric_limits<float16_t>::signaling_NaN());
+    std::vector<float16_t> qUnfused(q);
+
+    auto randValue = []() {
+        return static_cast<float16_t>(2.0f * static_cast<float32_t>(rand()) / RAND_MAX - 1.0f);
+    };
+    std::generate(x.begin(), x.end(), randValue);
+    std::generate(wqkv.begin(), wqkv.end(), randValue);
+    std::generate(kCache.begin(), kCache.end(), randValue);
+    std::generate(vCache.begin(), vCache.end(), randValue);
+
+    std::vector<float16_t> kCacheFused(poolSize), vCacheFused(poolSize);
+    std::vector<float16_t> kCacheUnfused(poolSize), vCacheUnfused(poolSize);
+
+    std::cout << "Initializing device data..." << std::endl;
+
+    // Allocate and copy device memory
+    float16_t* d_x;
+    float16_t* d_wqkv;
+    index_t*   d_positions;
+    int32_t*   d_blockSeqs;
+    index_t*   d_blockTables;
+    float16_t* d_q;
+    float16_t* d_kCache;
+    float16_t* d_vCache;
+    float16_t* d_qkv;
+
+    const size_t bytesX         = x.size() * sizeof(float16_t);
+    const size_t bytesW         = wqkv.size() * sizeof(float16_t);
+    const size_t bytesPositions = positions.size() * sizeof(index_t);
+    const size_t bytesBlockSeqs = blockSeqs.size() * sizeof(int32_t);
+    const size_t bytesTables    = blockTables.size() * sizeof(index_t);
+    const size_t bytesQ         = q.size() * sizeof(float16_t);
+    const size_t bytesCache     = poolSize * sizeof(float16_t);
+    const size_t bytesQkv       = static_cast<size_t>(tokens) * QKV_DIM * sizeof(float16_t);
+
+    CHECK_HIP_ERROR(hipMalloc(&d_x, bytesX));
+    CHECK_HIP_ERROR(hipMalloc(&d_wqkv, bytesW));
+    CHECK_HIP_ERROR(hipMalloc(&d_positions, bytesPositions));
+    CHECK_HIP_ERROR(hipMalloc(&d_blockSeqs, bytesBlockSeqs));
+    CHECK_HIP_ERROR(hipMalloc(&d_blockTables, bytesTables));
+    CHECK_HIP_ERROR(hipMalloc(&d_q, bytesQ));
+    CHECK_HIP_ERROR(hipMalloc(&d_kCache, bytesCache));
+    CHECK_HIP_ERROR(hipMalloc(&d_vCache, bytesCache));
+    CHECK_HIP_ERROR(hipMalloc(&d_qkv, bytesQkv));
+
+    CHECK_HIP_ERROR(hipMemcpy(d_x, x.data(), bytesX, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_wqkv, wqkv.data(), bytesW, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(
+        hipMemcpy(d_positions, positions.data(), bytesPositions, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(
+        hipMemcpy(d_blockSeqs, blockSeqs.data(), bytesBlockSeqs, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(
+        hipMemcpy(d_blockTables, blockTables.data(), bytesTables, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_q, q.data(), bytesQ, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_kCache, kCache.data(), bytesCache, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_vCache, vCache.data(), bytesCache, hipMemcpyHostToDevice));
+
+    auto blockDim = dim3(T_BLOCK_X, T_BLOCK_Y);
+    auto gridDim  = dim3(tokens / ROCWMMA_M, NUM_HEADS / T_BLOCK_Y);
+
+    hipEvent_t startEvent, stopEvent;
+    CHECK_HIP_ERROR(hipEventCreate(&startEvent));
+    CHECK_HIP_ERROR(hipEventCreate(&stopEvent));
+
+    std::cout << "Launching fused QKV, RoPE and cache write kernel..." << std::endl;
+
+    auto fusedTimeMs = 0.0f;
+    hipExtLaunchKernelGGL(qkv_rope_rocwmma_d<true>,
+                          gridDim,
+                          blockDim,
+                          0, // sharedMemBytes
+                          0, // stream
+                          startEvent, // Event start
+                          stopEvent, // event stop
+                          0, // flags
+                          numPages,
+                          maxPages,
+                          d_x,
+                          d_wqkv,
+                          d_positions,
+                          d_blockSeqs,
+                          d_blockTables,
+                          d_q,
+                          d_kCache,
+                          d_vCache,
+                          d_qkv);
+    CHECK_HIP_ERROR(hipEventSynchronize(stopEvent));
+    CHECK_HIP_ERROR(hipEventElapsedTime(&fusedTimeMs, startEvent, stopEvent));
+    CHECK_HIP_ERROR(hipMemcpy(q.data(), d_q, bytesQ, hipMemcpyDeviceToHost));
+    CHECK_HIP_ERROR(hipMemcpy(kCacheFused.data(), d_kCache, bytesCache, hipMemcpyDeviceToHost));
+    CHECK_HIP_ERROR(hipMemcpy(vCacheFused.data(), d_vCache, bytesCache, hipMemcpyDeviceToHost));
+
+    std::cout << "Launching un-fused QKV, RoPE and cache write kernels..." << std::endl;
+
+    // Restore the previous state of the outputs
+    CHECK_HIP_ERROR(hipMemcpy(d_q, qUnfused.data(), bytesQ, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_kCache, kCache.data(), bytesCache, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_vCache, vCache.data(), bytesCache, hipMemcpyHostToDevice));
+
+    auto unfusedTimeMs = 0.0f;
+    CHECK_HIP_ERROR(hipEventRecord(startEvent));
+    hipLaunchKernelGGL(qkv_rope_rocwmma_d<false>,
+                       gridDim,
+                       blockDim,
+                       0, // sharedMemBytes
+                       0, // stream
+                       numPages,
+                       maxPages,
+                       d_x,
+                       d_wqkv,
+                       d_positions,
+                       d_blockSeqs,
+                       d_blockTables,
+                       d_q,
+                       d_kCache,
+                       d_vCache,
+                       d_qkv);
+    hipLaunchKernelGGL(rope_d,
+                       dim3(tokens, NUM_Q_HEADS + NUM_KV_HEADS),
+                       dim3(HEAD_DIM / 2),
+                       0, // sharedMemBytes
+                       0, // stream
+                       d_positions,
+                       d_qkv,
+                       d_q);
+    hipLaunchKernelGGL(cache_write_d,
+                       dim3(tokens, 2 * NUM_KV_HEADS),
+                       dim3(HEAD_DIM),
+                       0, // sharedMemBytes
+                       0, // stream
+                       numPages,
+                       maxPages,
+                       d_positions,
+                       d_blockSeqs,
+                       d_blockTables,
+                       d_qkv,
+                       d_kCache,
+                       d_vCache);
+    CHECK_HIP_ERROR(hipEventRecord(stopEvent));
+    CHECK_HIP_ERROR(hipEventSynchronize(stopEvent));
+    CHECK_HIP_ERROR(hipEventElapsedTime(&unfusedTimeMs, startEvent, stopEvent));
+    CHECK_HIP_ERROR(hipMemcpy(qUnfused.data(), d_q, bytesQ, hipMemcpyDeviceToHost));
+    CHECK_HIP_ERROR(
+        hipMemcpy(kCacheUnfused.data(), d_kCache, bytesCache, hipMemcpyDeviceToHost));
+    CHECK_HIP_ERROR(
+        hipMemcpy(vCacheUnfused.data(), d_vCache, bytesCache, hipMemcpyDeviceToHost));
+
+    CHECK_HIP_ERROR(hipEventDestroy(startEvent));
+    CHECK_HIP_ERROR(hipEventDestroy(stopEvent));
+
+    // GEMM flops converge to 2*mnk
+    auto gFlops       = calculateGFlops(tokens, QKV_DIM, HIDDEN);
+    auto tFlopsPerSec = gFlops / static_cast<double>(fusedTimeMs);
+
+    // Echo performance
+    std::cout << "BlkM, BlkN, BlkK, "
+              << "Tokens, QkvDim, Hidden, "
+              << "Sequences, Pages, "
+              << "fusedMs, unfusedMs, "
+              << "Problem Size(GFlops), TFlops/s" << std::endl;
+
+    std::cout << ROCWMMA_M << ", " << ROCWMMA_N << ", " << ROCWMMA_K << ", " << tokens << ", "
+              << QKV_DIM << ", " << HIDDEN << ", " << batch << ", " << numPages << ", "
+              << fusedTimeMs << ", " << unfusedTimeMs << ", " << gFlops << ", " << tFlopsPerSec
+              << std::endl;
+
+#if !NDEBUG
+
+    std::cout << "Validating result with reference..." << std::endl;
+
+    std::vector<float16_t> qRef(tokens * Q_DIM);
+    std::vector<float16_t> kCacheRef(kCache), vCacheRef(vCache);
+    qkv_rope_cpu_h(numPages,
+                   maxPages,
+                   x,
+                   wqkv,
+                   positions,
+                   blockSeqs,
+                   blockTables,
+                   qRef,
+                   kCacheRef,
+                   vCacheRef);
+
+    auto resQ = compareEqual<float16_t>(q.data(), qRef.data(), q.size());
+    auto resK = compareEqual<float16_t>(kCacheFused.data(), kCacheRef.data(), poolSize);
+    auto resV = compareEqual<float16_t>(vCacheFused.data(), vCacheRef.data(), poolSize);
+
+    auto resQUnfused = compareEqual<float16_t>(qUnfused.data(), qRef.data(), q.size());
+    auto resKUnfused = compareEqual<float16_t>(kCacheUnfused.data(), kCacheRef.data(), poolSize);
+    auto resVUnfused = compareEqual<float16_t>(vCacheUnfused.data(), vCacheRef.data(), poolSize);
+
+    if(std::get<0>(resQ) == false || std::get<0>(resK) == false || std::get<0>(resV) == false
+       || std::get<0>(resQUnfused) == false || std::get<0>(resKUnfused) == false
+       || std::get<0>(resVUnfused) == false)
+    {
+        std::cout << "FAILED!\n";
+    }
+    else
+    {
+        std::cout << "PASSED!\n";
+    }
+
+    std::cout << "Max relative error (Q, K, V): " << std::get<1>(resQ) << ", "
+              << std::get<1>(resK) << ", " << std::get<1>(resV) << std::endl;
+
+#endif // !NDEBUG
+
+    // Release device memory
+    CHECK_HIP_ERROR(hipFree(d_x));
+    CHECK_HIP_ERROR(hipFree(d_wqkv));
+    CHECK_HIP_ERROR(hipFree(d_positions));
+    CHECK_HIP_ERROR(hipFree(d_blockSeqs));
+    CHECK_HIP_ERROR(hipFree(d_blockTables));
+    CHECK_HIP_ERROR(hipFree(d_q));
+    CHECK_HIP_ERROR(hipFree(d_kCache));
+    CHECK_HIP_ERROR(hipFree(d_vCache));
+    CHECK_HIP_ERROR(hipFree(d_qkv));
+
+    std::cout << "Finished!" << std::endl;
+}
+
+int main()
+{
+    // Prefill of new sequences, then chunks appended part way into a page
+    qkv_rope_test({0, 0}, {128, 128});
+    qkv_rope_test({0, 37, 250, 1001}, {64, 96, 48, 48});
+    return 0;
+}
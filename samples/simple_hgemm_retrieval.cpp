@@ -0,0 +1,590 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_fp16.h>
+#include <hip/hip_runtime.h>
+
+#include <rocwmma/rocwmma.hpp>
+#include <rocwmma/rocwmma_epilogue.hpp>
+#include <rocwmma/rocwmma_transforms.hpp>
+
+#include "common.hpp"
+
+using rocwmma::accumulator;
+using rocwmma::col_major;
+using rocwmma::float16_t;
+using rocwmma::float32_t;
+using rocwmma::float64_t;
+using rocwmma::matrix_a;
+using rocwmma::matrix_b;
+using rocwmma::row_major;
+
+// Supports ROCWMMA_M/N square sizes of
+// : 16 x 16
+// : 32 x 32 ( only MI )
+const int ROCWMMA_M = 16;
+const int ROCWMMA_N = 16;
+
+// Supports ROCWMMA_K sizes as
+// : multiples of 16.
+const int ROCWMMA_K = 16;
+
+// Device warp size
+const uint32_t WAVE_SIZE = getWarpSize();
+
+// Thread block
+// : T_BLOCK_X is one wave
+// Note: Each wave will compute one BLOCK_M x (BLOCK_N * SLICE_BLOCKS) corpus slice
+// Note: Workgroup will compute
+//  1 x T_BLOCK_Y corpus slices
+const int T_BLOCK_X = WAVE_SIZE;
+const int T_BLOCK_Y = 4;
+
+// Column blocks of the corpus visited by each wave
+const uint32_t SLICE_BLOCKS = 8;
+
+// Threads reducing one query row of the un-fused scores
+const uint32_t REDUCE_THREADS = 256;
+
+// The following device kernel is a naive implementation of the blocked scoring
+// GEMM of a retrieval step, with fused reduction epilogues. Each wave will
+// compute one BLOCK_M x (BLOCK_N * SLICE_BLOCKS) slice of the M x N x K GEMM:
+// S = Q x D
+//
+// Where:
+// : Q is the batch of query embeddings (M x K)
+// : D is the corpus of document embeddings (K x N)
+//
+// The accumulators of each column block are folded into the running argmax and
+// sum of each query row, and the max of each document column, such that the M x N
+// scores are never written. Waves covering the same rows or columns, in the same
+// or in different workgroups, merge their vectors with atomics:
+// : best[i]   = argmax_j S(i, j), as a packed (score, index) key
+// : rowSum[i] = sum_j S(i, j)
+// : docMax[j] = max_i S(i, j)
+// Un-fused, the scores are written to memory, and re-read by reduction kernels.
+//
+// In this simplified example, we assume:
+// : Q is in row-major format        (M x K)
+// : D is in col-major format        (K x N)
+// : S is in col-major format        (M x N), when un-fused
+// : M, N are multiples of BLOCK_M and BLOCK_N * SLICE_BLOCKS.
+//
+// Note: This is a simplified implementation to demonstrate API usage in
+// context of wave-level GEMM computation, and is not optimized.
+template <bool FuseReduce>
+__global__ void hgemm_retrieval_d(uint32_t         m,
+                                  uint32_t         n,
+                                  uint32_t         k,
+                                  float16_t const* q,
+                                  float16_t const* d,
+                                  float32_t*       s,
+                                  uint64_t*        bestKeys,
+                                  float32_t*       rowSum,
+                                  float32_t*       docMax,
+                                  uint32_t         ldq,
+                                  uint32_t         ldd)
+{
+    using FragQ
+        = rocwmma::fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, row_major>;
+    using FragD
+        = rocwmma::fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, col_major>;
+    using FragAcc = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float32_t>;
+    using FragIdx = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, int32_t>;
+
+    // Tile using a 2D grid
+    auto majorWarp = (blockIdx.x * blockDim.x + threadIdx.x) / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    auto minorWarp = (blockIdx.y * blockDim.y + threadIdx.y);
+
+    // Target block rows and corpus slice
+    auto cRow  = majorWarp * ROCWMMA_M;
+    auto slice = minorWarp;
+
+    if(cRow >= m || slice * SLICE_BLOCKS * ROCWMMA_N >= n)
+    {
+        return;
+    }
+
+    // Create frags
+    auto fragQ   = FragQ();
+    auto fragD   = FragD();
+    auto fragAcc = FragAcc();
+
+    // Running argmax and sum of each row of the slice
+    auto fragBest = FragAcc();
+    auto fragIdx  = FragIdx();
+    auto fragSum  = FragAcc();
+
+    if constexpr(FuseReduce)
+    {
+        rocwmma::fill_fragment(fragBest, std::numeric_limits<float32_t>::lowest());
+        rocwmma::fill_fragment(fragIdx, -1);
+        rocwmma::fill_fragment(fragSum, 0.0f);
+    }
+
+    for(uint32_t b = 0; b < SLICE_BLOCKS; b++)
+    {
+        auto cCol = (slice * SLICE_BLOCKS + b) * ROCWMMA_N;
+
+        // fragAcc = Q x D
+        rocwmma::fill_fragment(fragAcc, 0.0f);
+        for(int i = 0; i < k; i += ROCWMMA_K)
+        {
+            // Load the inputs
+            rocwmma::load_matrix_sync(fragQ, q + (cRow * ldq + i), ldq);
+            rocwmma::load_matrix_sync(fragD, d + (i + cCol * ldd), ldd);
+
+            // Matrix multiply - accumulate using MFMA units
+            rocwmma::mma_sync(fragAcc, fragQ, fragD, fragAcc);
+        }
+
+        if constexpr(FuseReduce)
+        {
+            // Row statistics stay in registers across the slice
+            rocwmma::argmax_rows(fragAcc, cCol, fragBest, fragIdx);
+            auto blockSum = rocwmma::reduce_rows<rocwmma::reduce::Sum>(fragAcc);
+            for(uint32_t i = 0; i < FragAcc::num_elements; i++)
+            {
+                fragSum.x[i] += blockSum.x[i];
+            }
+
+            // Each document column is complete for this row block
+            auto blockMax = rocwmma::reduce_cols<rocwmma::reduce::Max>(fragAcc);
+            rocwmma::atomic_reduce_row_vector_sync<rocwmma::reduce::Max>(docMax + cCol, blockMax);
+        }
+        else
+        {
+            // Store to S
+            rocwmma::store_matrix_sync(s + (cRow + cCol * m), fragAcc, m, rocwmma::mem_col_major);
+        }
+    }
+
+    if constexpr(FuseReduce)
+    {
+        // Merge the slice into the row vectors of all slices
+        rocwmma::atomic_argmax_col_vector_sync(bestKeys + cRow, fragBest, fragIdx);
+        rocwmma::atomic_reduce_col_vector_sync<rocwmma::reduce::Sum>(rowSum + cRow, fragSum);
+    }
+}
+
+// Reduces the un-fused scores of one query row, one workgroup per row.
+// Score j of the row is s[j * m + row].
+__global__ void rows_reduce_d(uint32_t         m,
+                              uint32_t         n,
+                              float32_t const* s,
+                              float32_t*       bestScore,
+                              int32_t*         bestIdx,
+                              float32_t*       rowSum)
+{
+    __shared__ float32_t ldsBest[REDUCE_THREADS];
+    __shared__ int32_t   ldsIdx[REDUCE_THREADS];
+    __shared__ float32_t ldsSum[REDUCE_THREADS];
+
+    auto row = blockIdx.x;
+
+    auto best  = std::numeric_limits<float32_t>::lowest();
+    auto index = -1;
+    auto sum   = 0.0f;
+
+    // Strided columns of each thread, in increasing order
+    for(uint32_t j = threadIdx.x; j < n; j += REDUCE_THREADS)
+    {
+        auto value = s[static_cast<size_t>(j) * m + row];
+        if(value > best)
+        {
+            best  = value;
+            index = static_cast<int32_t>(j);
+        }
+        sum += value;
+    }
+
+    ldsBest[threadIdx.x] = best;
+    ldsIdx[threadIdx.x]  = index;
+    ldsSum[threadIdx.x]  = sum;
+
+    __syncthreads();
+
+    // Merge the threads, keeping the lowest index on ties
+    if(threadIdx.x == 0)
+    {
+        for(uint32_t t = 1; t < REDUCE_THREADS; t++)
+        {
+            if(ldsBest[t] > best || (ldsBest[t] == best && ldsIdx[t] < index))
+            {
+                best  = ldsBest[t];
+                index = ldsIdx[t];
+            }
+            sum += ldsSum[t];
+        }
+
+        bestScore[row] = best;
+        bestIdx[row]   = index;
+        rowSum[row]    = sum;
+    }
+}
+
+// Reduces the un-fused scores of each document column, one thread per column.
+__global__ void cols_reduce_d(uint32_t m, uint32_t n, float32_t const* s, float32_t* docMax)
+{
+    auto col = blockIdx.x * blockDim.x + threadIdx.x;
+    if(col >= n)
+    {
+        return;
+    }
+
+    auto const* column = s + static_cast<size_t>(col) * m;
+    auto        max    = std::numeric_limits<float32_t>::lowest();
+    for(uint32_t i = 0; i < m; i++)
+    {
+        max = fmaxf(max, column[i]);
+    }
+    docMax[col] = max;
+}
+
+// Host reference of the scores Q x D, row-major (M x N)
+__host__ void scores_cpu_h(uint32_t         m,
+                           uint32_t         n,
+                           uint32_t         k,
+                           float16_t const* q,
+                           float16_t const* d,
+                           float64_t*       scores,
+                           uint32_t         ldq,
+                           uint32_t         ldd)
+{
+#pragma omp parallel for
+    for(int i = 0; i < m; ++i)
+    {
+        for(int j = 0; j < n; ++j)
+        {
+            auto accum = 0.0f;
+            for(int h = 0; h < k; ++h)
+            {
+                accum += static_cast<float32_t>(q[i * ldq + h])
+                         * static_cast<float32_t>(d[static_cast<size_t>(j) * ldd + h]);
+            }
+            scores[static_cast<size_t>(i) * n + j] = static_cast<float64_t>(accum);
+        }
+    }
+}
+
+__host__ void gemm_test(uint32_t m, uint32_t n, uint32_t k)
+{
+    // Bounds check
+    if((m < ROCWMMA_M || n < (ROCWMMA_N * SLICE_BLOCKS) || k < ROCWMMA_K)
+       || (m % ROCWMMA_M || n % (ROCWMMA_N * SLICE_BLOCKS) || k % ROCWMMA_K))
+    {
+        std::cout << "Unsupported size!\n";
+        return;
+    }
+
+    int      ldq    = k;
+    int      ldd    = k;
+    uint32_t slices = n / (ROCWMMA_N * SLICE_BLOCKS);
+
+    std::cout << "Initializing host data..." << std::endl;
+
+    // Initialize input matrices. Non-negative embeddings in [0, 0.5] and [0, 0.25]
+    // keep the row sums away from 0, for relative validation.
+    std::vector<float16_t> matrixQ(m * k);
+    std::vector<float16_t> matrixD(static_cast<size_t>(k) * n);
+
+    auto randValue = [](float32_t range) {
+        return static_cast<float16_t>(range * static_cast<float32_t>(rand()) / RAND_MAX);
+    };
+    std::generate(matrixQ.begin(), matrixQ.end(), [&]() { return randValue(0.5f); });
+    std::generate(matrixD.begin(), matrixD.end(), [&]() { return randValue(0.25f); });
+
+    std::vector<uint64_t>  bestKeys(m);
+    std::vector<float32_t> rowSum(m);
+    std::vector<float32_t> docMax(n);
+    std::vector<float32_t> bestScoreUnfused(m);
+    std::vector<int32_t>   bestIdxUnfused(m);
+    std::vector<float32_t> rowSumUnfused(m);
+    std::vector<float32_t> docMaxUnfused(n);
+
+    // Max vectors start at the identity of the max
+    std::vector<float32_t> docMaxInit(n, std::numeric_limits<float32_t>::lowest());
+
+    std::cout << "Initializing device data..." << std::endl;
+
+    // Allocate and copy device memory
+    float16_t* d_q;
+    float16_t* d_d;
+    float32_t* d_s;
+    uint64_t*  d_bestKeys;
+    float32_t* d_bestScore;
+    int32_t*   d_bestIdx;
+    float32_t* d_rowSum;
+    float32_t* d_docMax;
+
+    const size_t bytesQ    = matrixQ.size() * sizeof(float16_t);
+    const size_t bytesD    = matrixD.size() * sizeof(float16_t);
+    const size_t bytesS    = static_cast<size_t>(m) * n * sizeof(float32_t);
+    const size_t bytesKeys = m * sizeof(uint64_t);
+    const size_t bytesRows = m * sizeof(float32_t);
+    const size_t bytesDocs = n * sizeof(float32_t);
+
+    CHECK_HIP_ERROR(hipMalloc(&d_q, bytesQ));
+    CHECK_HIP_ERROR(hipMalloc(&d_d, bytesD));
+    CHECK_HIP_ERROR(hipMalloc(&d_s, bytesS));
+    CHECK_HIP_ERROR(hipMalloc(&d_bestKeys, bytesKeys));
+    CHECK_HIP_ERROR(hipMalloc(&d_bestScore, bytesRows));
+    CHECK_HIP_ERROR(hipMalloc(&d_bestIdx, bytesRows));
+    CHECK_HIP_ERROR(hipMalloc(&d_rowSum, bytesRows));
+    CHECK_HIP_ERROR(hipMalloc(&d_docMax, bytesDocs));
+
+    CHECK_HIP_ERROR(hipMemcpy(d_q, matrixQ.data(), bytesQ, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_d, matrixD.data(), bytesD, hipMemcpyHostToDevice));
+
+    // Atomic merge targets
+    CHECK_HIP_ERROR(hipMemset(d_bestKeys, 0, bytesKeys));
+    CHECK_HIP_ERROR(hipMemset(d_rowSum, 0, bytesRows));
+    CHECK_HIP_ERROR(hipMemcpy(d_docMax, docMaxInit.data(), bytesDocs, hipMemcpyHostToDevice));
+
+    auto blockDim = dim3(T_BLOCK_X, T_BLOCK_Y);
+    auto gridDim  = dim3(rocwmma::ceilDiv(m, ROCWMMA_M), rocwmma::ceilDiv(slices, T_BLOCK_Y));
+
+    hipEvent_t startEvent, stopEvent;
+    CHECK_HIP_ERROR(hipEventCreate(&startEvent));
+    CHECK_HIP_ERROR(hipEventCreate(&stopEvent));
+
+    std::cout << "Launching fused reduction GEMM kernel..." << std::endl;
+
+    auto fusedTimeMs = 0.0f;
+    CHECK_HIP_ERROR(hipEventRecord(startEvent));
+    hipLaunchKernelGGL(hgemm_retrieval_d<true>,
+                       gridDim,
+                       blockDim,
+                       0, // sharedMemBytes
+                       0, // stream
+                       m,
+                       n,
+                       k,
+                       d_q,
+                       d_d,
+                       d_s,
+                       d_bestKeys,
+                       d_rowSum,
+                       d_docMax,
+                       ldq,
+                       ldd);
+    CHECK_HIP_ERROR(hipEventRecord(stopEvent));
+    CHECK_HIP_ERROR(hipEventSynchronize(stopEvent));
+    CHECK_HIP_ERROR(hipEventElapsedTime(&fusedTimeMs, startEvent, stopEvent));
+    CHECK_HIP_ERROR(hipMemcpy(bestKeys.data(), d_bestKeys, bytesKeys, hipMemcpyDeviceToHost));
+    CHECK_HIP_ERROR(hipMemcpy(rowSum.data(), d_rowSum, bytesRows, hipMemcpyDeviceToHost));
+    CHECK_HIP_ERROR(hipMemcpy(docMax.data(), d_docMax, bytesDocs, hipMemcpyDeviceToHost));
+
+    std::cout << "Launching un-fused scores GEMM and reduction kernels..." << std::endl;
+
+    auto unfusedTimeMs = 0.0f;
+    CHECK_HIP_ERROR(hipEventRecord(startEvent));
+    hipLaunchKernelGGL(hgemm_retrieval_d<false>,
+                       gridDim,
+                       blockDim,
+                       0, // sharedMemBytes
+                       0, // stream
+                       m,
+                       n,
+                       k,
+                       d_q,
+                       d_d,
+                       d_s,
+                       d_bestKeys,
+                       d_rowSum,
+                       d_docMax,
+                       ldq,
+                       ldd);
+    hipLaunchKernelGGL(rows_reduce_d,
+                       dim3(m),
+                       dim3(REDUCE_THREADS),
+                       0, // sharedMemBytes
+                       0, // stream
+                       m,
+                       n,
+                       d_s,
+                       d_bestScore,
+                       d_bestIdx,
+                       d_rowSum);
+    hipLaunchKernelGGL(cols_reduce_d,
+                       dim3(rocwmma::ceilDiv(n, REDUCE_THREADS)),
+                       dim3(REDUCE_THREADS),
+                       0, // sharedMemBytes
+                       0, // stream
+                       m,
+                       n,
+                       d_s,
+                       d_docMax);
+    CHECK_HIP_ERROR(hipEventRecord(stopEvent));
+    CHECK_HIP_ERROR(hipEventSynchronize(stopEvent));
+    CHECK_HIP_ERROR(hipEventElapsedTime(&unfusedTimeMs, startEvent, stopEvent));
+    CHECK_HIP_ERROR(
+        hipMemcpy(bestScoreUnfused.data(), d_bestScore, bytesRows, hipMemcpyDeviceToHost));
+    CHECK_HIP_ERROR(hipMemcpy(bestIdxUnfused.data(), d_bestIdx, bytesRows, hipMemcpyDeviceToHost));
+    CHECK_HIP_ERROR(hipMemcpy(rowSumUnfused.data(), d_rowSum, bytesRows, hipMemcpyDeviceToHost));
+    CHECK_HIP_ERROR(hipMemcpy(docMaxUnfused.data(), d_docMax, bytesDocs, hipMemcpyDeviceToHost));
+
+    CHECK_HIP_ERROR(hipEventDestroy(startEvent));
+    CHECK_HIP_ERROR(hipEventDestroy(stopEvent));
+
+    // Decode the packed argmax keys
+    std::vector<float32_t> bestScore(m);
+    std::vector<int32_t>   bestIdx(m);
+    for(int i = 0; i < m; ++i)
+    {
+        bestScore[i] = rocwmma::argmax_key_value(bestKeys[i]);
+        bestIdx[i]   = rocwmma::argmax_key_index(bestKeys[i]);
+    }
+
+    // GEMM flops converge to 2*mnk
+    auto gFlops       = calculateGFlops(m, n, k);
+    auto tFlopsPerSec = gFlops / static_cast<double>(fusedTimeMs);
+
+    // Echo performance
+    std::cout << "BlkM, BlkN, BlkK, "
+              << "MatM, MatN, MatK, "
+              << "fusedMs, unfusedMs, "
+              << "Problem Size(GFlops), TFlops/s" << std::endl;
+
+    std::cout << ROCWMMA_M << ", " << ROCWMMA_N << ", " << ROCWMMA_K << ", " << m << ", " << n
+              << ", " << k << ", " << fusedTimeMs << ", " << unfusedTimeMs << ", " << gFlops
+              << ", " << tFlopsPerSec << std::endl;
+
+#if !NDEBUG
+
+    std::cout << "Validating result with reference..." << std::endl;
+
+    std::vector<float64_t> scores_ref(static_cast<size_t>(m) * n);
+    scores_cpu_h(m, n, k, matrixQ.data(), matrixD.data(), scores_ref.data(), ldq, ldd);
+
+    std::vector<float16_t> rowBest_ref(m);
+    std::vector<float16_t> rowMean_ref(m);
+    std::vector<float16_t> docMax_ref(n);
+
+    for(int i = 0; i < m; ++i)
+    {
+        auto const* p  = scores_ref.data() + static_cast<size_t>(i) * n;
+        rowBest_ref[i] = static_cast<float16_t>(*std::max_element(p, p + n));
+        rowMean_ref[i] = static_cast<float16_t>(std::accumulate(p, p + n, 0.0) / n);
+    }
+
+    for(int j = 0; j < n; ++j)
+    {
+        auto max = std::numeric_limits<float64_t>::lowest();
+        for(int i = 0; i < m; ++i)
+        {
+            max = std::max(max, scores_ref[static_cast<size_t>(i) * n + j]);
+        }
+        docMax_ref[j] = static_cast<float16_t>(max);
+    }
+
+    // Device statistics are checked against the reference at half precision tolerance,
+    // with the row sums as means, in the range of half precision.
+    // Near ties may select either document, so the selected documents are checked by
+    // their reference score.
+    auto validate = [&](std::vector<float32_t> const& best,
+                        std::vector<int32_t> const&   idx,
+                        std::vector<float32_t> const& sum,
+                        std::vector<float32_t> const& max) {
+        std::vector<float16_t> rowBest(m);
+        std::vector<float16_t> selected_ref(m);
+        std::vector<float16_t> rowMean(m);
+        std::vector<float16_t> docMaxOut(n);
+
+        for(int i = 0; i < m; ++i)
+        {
+            auto index = idx[i];
+            rowBest[i] = static_cast<float16_t>(best[i]);
+            rowMean[i] = static_cast<float16_t>(sum[i] / static_cast<float32_t>(n));
+            selected_ref[i]
+                = static_cast<float16_t>(index >= 0 && index < n
+                                             ? scores_ref[static_cast<size_t>(i) * n + index]
+                                             : -1.0);
+        }
+        std::transform(max.begin(), max.end(), docMaxOut.begin(), [](float32_t v) {
+            return static_cast<float16_t>(v);
+        });
+
+        auto results = {compareEqual<float16_t>(rowBest.data(), rowBest_ref.data(), m),
+                        compareEqual<float16_t>(selected_ref.data(), rowBest_ref.data(), m),
+                        compareEqual<float16_t>(rowMean.data(), rowMean_ref.data(), m),
+                        compareEqual<float16_t>(docMaxOut.data(), docMax_ref.data(), n)};
+
+        auto passed   = true;
+        auto maxError = 0.0;
+        for(auto const& res : results)
+        {
+            passed &= std::get<0>(res);
+            maxError = std::max(maxError, std::get<1>(res));
+        }
+        return std::make_pair(passed, maxError);
+    };
+
+    auto res        = validate(bestScore, bestIdx, rowSum, docMax);
+    auto resUnfused = validate(bestScoreUnfused, bestIdxUnfused, rowSumUnfused, docMaxUnfused);
+
+    if(std::get<0>(res) == false || std::get<0>(resUnfused) == false)
+    {
+        std::cout << "FAILED!\n";
+    }
+    else
+    {
+        std::cout << "PASSED!\n";
+    }
+
+    std::cout << "Max relative error: " << std::get<1>(res) << std::endl;
+
+#endif // !NDEBUG
+
+    // Release device memory
+    CHECK_HIP_ERROR(hipFree(d_q));
+    CHECK_HIP_ERROR(hipFree(d_d));
+    CHECK_HIP_ERROR(hipFree(d_s));
+    CHECK_HIP_ERROR(hipFree(d_bestKeys));
+    CHECK_HIP_ERROR(hipFree(d_bestScore));
+    CHECK_HIP_ERROR(hipFree(d_bestIdx));
+    CHECK_HIP_ERROR(hipFree(d_rowSum));
+    CHECK_HIP_ERROR(hipFree(d_docMax));
+
+    std::cout << "Finished!" << std::endl;
+}
+
+int main()
+{
+    // Batches of 16 and 128 queries, scored against 262144 document embeddings of 256 dims
+    gemm_test(16, 262144, 256);
+    gemm_test(128, 262144, 256);
+    return 0;
+}
@@ -0,0 +1,573 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_fp16.h>
+#include <hip/hip_runtime.h>
+
+#include <rocwmma/rocwmma.hpp>
+#include <rocwmma/rocwmma_epilogue.hpp>
+#include <rocwmma/rocwmma_prologue.hpp>
+
+#include "common.hpp"
+
+using rocwmma::accumulator;
+using rocwmma::col_major;
+using rocwmma::float16_t;
+using rocwmma::float32_t;
+using rocwmma::matrix_a;
+using rocwmma::matrix_b;
+using rocwmma::row_major;
+
+// Supports ROCWMMA_M/N square sizes of
+// : 16 x 16
+// : 32 x 32 ( only MI )
+const int ROCWMMA_M = 16;
+const int ROCWMMA_N = 16;
+
+// Supports ROCWMMA_K sizes as
+// : multiples of 16.
+const int ROCWMMA_K = 16;
+
+// Device warp size
+const uint32_t WAVE_SIZE = getWarpSize();
+
+// Thread block
+// : T_BLOCK_X is one wave, such that all waves of the
+//   workgroup share the same BLOCK_M rows of A.
+// Note: Each wave will compute one BLOCK_M x BLOCK_N output block
+// Note: Workgroup will compute
+//  1 x T_BLOCK_Y output blocks
+const int T_BLOCK_X = WAVE_SIZE;
+const int T_BLOCK_Y = 4;
+
+// Padding of the LDS rows of A, to offset the banks of consecutive rows
+const uint32_t LDS_PAD = 8u;
+
+// Epsilon of the RMSNorm
+const float32_t EPS = 1e-5f;
+
+// Source of the normalization of A
+enum struct NormMode
+{
+    // A is already normalized, e.g. by a separate RMSNorm kernel
+    None,
+
+    // Row statistics are computed by a light pre-pass kernel
+    PrePass,
+
+    // Row statistics are computed in the GEMM kernel, with the rows of A staged in LDS
+    Fused
+};
+
+// The following device kernel is a naive implementation of blocked GEMM
+// with a fused RMSNorm prologue on A. Each wave will compute one BLOCK_M x BLOCK_N
+// output block of the M x N x K GEMM, generalized as:
+// D = RMSNorm(A) x B = (rstd[row] * A * gamma[k]) x B
+//
+// Where:
+// : rstd is a per-row vector   (M), rstd = 1 / sqrt(mean(A[row]^2) + eps)
+// : gamma is a per-K vector    (K)
+//
+// The normalization is applied to A fragments in registers, between
+// load_matrix_sync and mma_sync. Normalized activations are never written out.
+// Un-fused, a separate RMSNorm kernel reads A, writes the normalized M x K
+// matrix, which the GEMM reads again.
+//
+// In this simplified example, we assume:
+// : A is in row-major format        (M x K)
+// : B is in col-major format        (K x N)
+// : D is in row-major format        (M x N)
+// : Fused mode stages BLOCK_M x K of A in LDS
+//
+// Note: This is a simplified implementation to demonstrate API usage in
+// context of wave-level GEMM computation, and is not optimized.
+template <NormMode Mode>
+__global__ void hgemm_rmsnorm_rocwmma_d(uint32_t         m,
+                                        uint32_t         n,
+                                        uint32_t         k,
+                                        float16_t const* a,
+                                        float16_t const* b,
+                                        float16_t const* gamma,
+                                        float16_t const* rstd,
+                                        float16_t*       d,
+                                        uint32_t         lda,
+                                        uint32_t         ldb,
+                                        uint32_t         ldd)
+{
+    using FragA
+        = rocwmma::fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, row_major>;
+    using FragB
+        = rocwmma::fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, col_major>;
+
+    // Create frags
+    auto fragA   = FragA();
+    auto fragB   = FragB();
+    auto fragAcc = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float32_t>();
+    auto fragD   = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t>();
+
+    // Per-row and per-K vectors, broadcast to line up with fragA
+    auto fragRstd  = FragA();
+    auto fragGamma = FragA();
+
+    rocwmma::fill_fragment(fragAcc, 0.0f);
+
+    // Tile using a 2D grid
+    auto majorWarp = (blockIdx.x * blockDim.x + threadIdx.x) / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    auto minorWarp = (blockIdx.y * blockDim.y + threadIdx.y);
+
+    // Target D block
+    auto cRow = majorWarp * ROCWMMA_M;
+    auto cCol = minorWarp * ROCWMMA_N;
+
+    // Source of the BLOCK_M rows of A
+    auto aRows  = a + cRow * lda;
+    auto ldRows = lda;
+
+    if constexpr(Mode == NormMode::Fused)
+    {
+        // The workgroup stages its BLOCK_M rows of A in LDS once, accumulating
+        // the row sums of squares on the way. All waves then read A from LDS.
+        HIP_DYNAMIC_SHARED(void*, localMemPtr);
+        __shared__ float32_t ldsSumSq[ROCWMMA_M];
+
+        auto ldl      = k + LDS_PAD;
+        auto ldsA     = reinterpret_cast<float16_t*>(localMemPtr);
+        auto ldsRstd  = ldsA + ROCWMMA_M * ldl;
+        auto tid      = threadIdx.y * blockDim.x + threadIdx.x;
+        auto nThreads = blockDim.x * blockDim.y;
+
+        if(tid < ROCWMMA_M)
+        {
+            ldsSumSq[tid] = 0.0f;
+        }
+        __syncthreads();
+
+        for(uint32_t row = 0; row < ROCWMMA_M; row++)
+        {
+            auto partial = 0.0f;
+            for(uint32_t col = tid; col < k; col += nThreads)
+            {
+                auto value            = aRows[row * lda + col];
+                ldsA[row * ldl + col] = value;
+                partial += static_cast<float32_t>(value) * static_cast<float32_t>(value);
+            }
+            atomicAdd(ldsSumSq + row, partial);
+        }
+        __syncthreads();
+
+        if(tid < ROCWMMA_M)
+        {
+            ldsRstd[tid] = static_cast<float16_t>(rsqrtf(ldsSumSq[tid] / k + EPS));
+        }
+        __syncthreads();
+
+        // Row statistics are constant over K
+        rocwmma::load_col_vector_sync(fragRstd, ldsRstd);
+
+        aRows  = ldsA;
+        ldRows = ldl;
+    }
+    else if constexpr(Mode == NormMode::PrePass)
+    {
+        // Row statistics are constant over K
+        rocwmma::load_col_vector_sync(fragRstd, rstd + cRow);
+    }
+
+    // Bounds check
+    if(cRow < m && cCol < n)
+    {
+        // fragAcc = RMSNorm(A) x B
+        for(int i = 0; i < k; i += ROCWMMA_K)
+        {
+            // Load the inputs
+            rocwmma::load_matrix_sync(fragA, aRows + i, ldRows);
+            rocwmma::load_matrix_sync(fragB, b + (i + cCol * ldb), ldb);
+
+            if constexpr(Mode != NormMode::None)
+            {
+                // A = rstd * A * gamma, in registers
+                rocwmma::load_row_vector_sync(fragGamma, gamma + i);
+                rocwmma::apply_prologue(fragA, rocwmma::prologue::RmsNorm(fragRstd, fragGamma));
+            }
+
+            // Matrix multiply - accumulate using MFMA units
+            rocwmma::mma_sync(fragAcc, fragA, fragB, fragAcc);
+        }
+
+        // Convert and store to D
+        rocwmma::apply_epilogue(fragD, fragAcc);
+        rocwmma::store_matrix_sync(d + (cRow * ldd + cCol), fragD, ldd, rocwmma::mem_row_major);
+    }
+}
+
+// RMSNorm over the rows of A, with one workgroup per row.
+// Normalize = false: light pre-pass writing only the M row statistics (rstd).
+// Normalize = true: separate RMSNorm kernel writing the normalized M x K matrix.
+template <bool Normalize>
+__global__ void rmsnorm_d(uint32_t         k,
+                          float16_t const* a,
+                          float16_t const* gamma,
+                          float16_t*       rstd,
+                          float16_t*       aNorm,
+                          uint32_t         lda)
+{
+    __shared__ float32_t sumSq;
+
+    auto row = blockIdx.x;
+
+    if(threadIdx.x == 0)
+    {
+        sumSq = 0.0f;
+    }
+    __syncthreads();
+
+    auto partial = 0.0f;
+    for(uint32_t col = threadIdx.x; col < k; col += blockDim.x)
+    {
+        auto value = static_cast<float32_t>(a[row * lda + col]);
+        partial += value * value;
+    }
+    atomicAdd(&sumSq, partial);
+    __syncthreads();
+
+    auto rowRstd = rsqrtf(sumSq / k + EPS);
+
+    if constexpr(Normalize)
+    {
+        for(uint32_t col = threadIdx.x; col < k; col += blockDim.x)
+        {
+            auto idx   = row * lda + col;
+            aNorm[idx] = static_cast<float16_t>(static_cast<float32_t>(a[idx]) * rowRstd
+                                                * static_cast<float32_t>(gamma[col]));
+        }
+    }
+    else if(threadIdx.x == 0)
+    {
+        rstd[row] = static_cast<float16_t>(rowRstd);
+    }
+}
+
+// Host reference of the RMSNorm
+__host__ void rmsnorm_cpu_h(uint32_t         m,
+                            uint32_t         k,
+                            float16_t const* a,
+                            float16_t const* gamma,
+                            float16_t*       aNorm,
+                            uint32_t         lda)
+{
+#pragma omp parallel for
+    for(int i = 0; i < m; ++i)
+    {
+        auto sumSq = 0.0f;
+        for(int j = 0; j < k; ++j)
+        {
+            auto value = static_cast<float32_t>(a[i * lda + j]);
+            sumSq += value * value;
+        }
+
+        auto rowRstd = 1.0f / std::sqrt(sumSq / k + EPS);
+        for(int j = 0; j < k; ++j)
+        {
+            auto idx   = i * lda + j;
+            aNorm[idx] = static_cast<float16_t>(static_cast<float32_t>(a[idx]) * rowRstd
+                                                * static_cast<float32_t>(gamma[j]));
+        }
+    }
+}
+
+__host__ void gemm_test(uint32_t m, uint32_t n, uint32_t k)
+{
+    // Bounds check
+    if((m < ROCWMMA_M || n < (ROCWMMA_N * T_BLOCK_Y) || k < ROCWMMA_K)
+       || (m % ROCWMMA_M || n % (ROCWMMA_N * T_BLOCK_Y) || k % ROCWMMA_K))
+    {
+        std::cout << "Unsupported size!\n";
+        return;
+    }
+
+    int lda = k;
+    int ldb = k;
+    int ldd = n;
+
+    std::cout << "Initializing host data..." << std::endl;
+
+    // Initialize input matrices
+    std::vector<float16_t> matrixA(m * k);
+    std::vector<float16_t> matrixB(k * n);
+    std::vector<float16_t> vectorGamma(k);
+    // Fill outputs with NaN to catch contamination
+    std::vector<float16_t> matrixD(m * n, std::numeric_limits<float16_t>::signaling_NaN());
+    std::vector<float16_t> matrixDPrePass(m * n, std::numeric_limits<float16_t>::signaling_NaN());
+    std::vector<float16_t> matrixDUnfused(m * n, std::numeric_limits<float16_t>::signaling_NaN());
+
+    fillRand(matrixA.data(), m, k);
+    fillRand(matrixB.data(), k, n);
+
+    // Gamma within [0.5, 1.5]
+    for(int j = 0; j < k; ++j)
+    {
+        vectorGamma[j] = static_cast<float16_t>(0.5f + static_cast<float32_t>(rand()) / RAND_MAX);
+    }
+
+    std::cout << "Initializing device data..." << std::endl;
+
+    // Allocate and copy device memory
+    float16_t* d_a;
+    float16_t* d_b;
+    float16_t* d_gamma;
+    float16_t* d_rstd;
+    float16_t* d_aNorm;
+    float16_t* d_d;
+
+    const size_t bytesA     = matrixA.size() * sizeof(float16_t);
+    const size_t bytesB     = matrixB.size() * sizeof(float16_t);
+    const size_t bytesGamma = vectorGamma.size() * sizeof(float16_t);
+    const size_t bytesRstd  = m * sizeof(float16_t);
+    const size_t bytesD     = matrixD.size() * sizeof(float16_t);
+
+    CHECK_HIP_ERROR(hipMalloc(&d_a, bytesA));
+    CHECK_HIP_ERROR(hipMalloc(&d_b, bytesB));
+    CHECK_HIP_ERROR(hipMalloc(&d_gamma, bytesGamma));
+    CHECK_HIP_ERROR(hipMalloc(&d_rstd, bytesRstd));
+    CHECK_HIP_ERROR(hipMalloc(&d_aNorm, bytesA));
+    CHECK_HIP_ERROR(hipMalloc(&d_d, bytesD));
+
+    CHECK_HIP_ERROR(hipMemcpy(d_a, matrixA.data(), bytesA, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_b, matrixB.data(), bytesB, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_gamma, vectorGamma.data(), bytesGamma, hipMemcpyHostToDevice));
+
+    auto blockDim = dim3(T_BLOCK_X, T_BLOCK_Y);
+    auto gridDim
+        = dim3(rocwmma::ceilDiv(m, ROCWMMA_M), rocwmma::ceilDiv(n, ROCWMMA_N * T_BLOCK_Y));
+
+    // Fused mode requires the BLOCK_M rows of A and their rstd in LDS
+    hipDevice_t     handle;
+    hipDeviceProp_t props;
+    CHECK_HIP_ERROR(hipGetDevice(&handle));
+    CHECK_HIP_ERROR(hipGetDeviceProperties(&props, handle));
+
+    const size_t ldsBytes  = (ROCWMMA_M * (k + LDS_PAD) + ROCWMMA_M) * sizeof(float16_t);
+    const bool   fusedFits = ldsBytes + ROCWMMA_M * sizeof(float32_t) <= props.sharedMemPerBlock;
+
+    hipEvent_t startEvent, stopEvent;
+    CHECK_HIP_ERROR(hipEventCreate(&startEvent));
+    CHECK_HIP_ERROR(hipEventCreate(&stopEvent));
+
+    auto fusedTimeMs = 0.0f;
+    if(fusedFits)
+    {
+        std::cout << "Launching fused RMSNorm GEMM kernel..." << std::endl;
+
+        CHECK_HIP_ERROR(hipMemcpy(d_d, matrixD.data(), bytesD, hipMemcpyHostToDevice));
+        hipExtLaunchKernelGGL(hgemm_rmsnorm_rocwmma_d<NormMode::Fused>,
+                              gridDim,
+                              blockDim,
+                              ldsBytes, // sharedMemBytes
+                              0, // stream
+                              startEvent, // Event start
+                              stopEvent, // event stop
+                              0, // flags
+                              m,
+                              n,
+                              k,
+                              d_a,
+                              d_b,
+                              d_gamma,
+                              nullptr,
+                              d_d,
+                              lda,
+                              ldb,
+                              ldd);
+        CHECK_HIP_ERROR(hipEventSynchronize(stopEvent));
+        CHECK_HIP_ERROR(hipEventElapsedTime(&fusedTimeMs, startEvent, stopEvent));
+        CHECK_HIP_ERROR(hipMemcpy(matrixD.data(), d_d, bytesD, hipMemcpyDeviceToHost));
+    }
+    else
+    {
+        std::cout << "Skipping fused RMSNorm GEMM kernel: rows of A exceed LDS" << std::endl;
+    }
+
+    std::cout << "Launching RMSNorm stats pre-pass and GEMM kernels..." << std::endl;
+
+    auto prePassTimeMs = 0.0f;
+    CHECK_HIP_ERROR(hipEventRecord(startEvent));
+    hipLaunchKernelGGL(rmsnorm_d<false>,
+                       dim3(m),
+                       dim3(256u),
+                       0, // sharedMemBytes
+                       0, // stream
+                       k,
+                       d_a,
+                       d_gamma,
+                       d_rstd,
+                       nullptr,
+                       lda);
+    hipLaunchKernelGGL(hgemm_rmsnorm_rocwmma_d<NormMode::PrePass>,
+                       gridDim,
+                       blockDim,
+                       0, // sharedMemBytes
+                       0, // stream
+                       m,
+                       n,
+                       k,
+                       d_a,
+                       d_b,
+                       d_gamma,
+                       d_rstd,
+                       d_d,
+                       lda,
+                       ldb,
+                       ldd);
+    CHECK_HIP_ERROR(hipEventRecord(stopEvent));
+    CHECK_HIP_ERROR(hipEventSynchronize(stopEvent));
+    CHECK_HIP_ERROR(hipEventElapsedTime(&prePassTimeMs, startEvent, stopEvent));
+    CHECK_HIP_ERROR(hipMemcpy(matrixDPrePass.data(), d_d, bytesD, hipMemcpyDeviceToHost));
+
+    std::cout << "Launching un-fused RMSNorm and GEMM kernels..." << std::endl;
+
+    auto unfusedTimeMs = 0.0f;
+    CHECK_HIP_ERROR(hipMemset(d_d, 0, bytesD));
+    CHECK_HIP_ERROR(hipEventRecord(startEvent));
+    hipLaunchKernelGGL(rmsnorm_d<true>,
+                       dim3(m),
+                       dim3(256u),
+                       0, // sharedMemBytes
+                       0, // stream
+                       k,
+                       d_a,
+                       d_gamma,
+                       nullptr,
+                       d_aNorm,
+                       lda);
+    hipLaunchKernelGGL(hgemm_rmsnorm_rocwmma_d<NormMode::None>,
+                       gridDim,
+                       blockDim,
+                       0, // sharedMemBytes
+                       0, // stream
+                       m,
+                       n,
+                       k,
+                       d_aNorm,
+                       d_b,
+                       nullptr,
+                       nullptr,
+                       d_d,
+                       lda,
+                       ldb,
+                       ldd);
+    CHECK_HIP_ERROR(hipEventRecord(stopEvent));
+    CHECK_HIP_ERROR(hipEventSynchronize(stopEvent));
+    CHECK_HIP_ERROR(hipEventElapsedTime(&unfusedTimeMs, startEvent, stopEvent));
+    CHECK_HIP_ERROR(hipMemcpy(matrixDUnfused.data(), d_d, bytesD, hipMemcpyDeviceToHost));
+
+    CHECK_HIP_ERROR(hipEventDestroy(startEvent));
+    CHECK_HIP_ERROR(hipEventDestroy(stopEvent));
+
+    // GEMM flops converge to 2*mnk
+    auto gFlops       = calculateGFlops(m, n, k);
+    auto tFlopsPerSec = gFlops / static_cast<double>(fusedFits ? fusedTimeMs : prePassTimeMs);
+
+    // Echo performance
+    std::cout << "BlkM, BlkN, BlkK, "
+              << "MatM, MatN, MatK, "
+              << "lda, ldb, ldd, "
+              << "fusedMs, prePassMs, unfusedMs, "
+              << "Problem Size(GFlops), TFlops/s" << std::endl;
+
+    std::cout << ROCWMMA_M << ", " << ROCWMMA_N << ", " << ROCWMMA_K << ", " << m << ", " << n
+              << ", " << k << ", " << lda << ", " << ldb << ", " << ldd << ", "
+              << (fusedFits ? std::to_string(fusedTimeMs) : std::string("n/a")) << ", "
+              << prePassTimeMs << ", " << unfusedTimeMs << ", " << gFlops << ", "
+              << tFlopsPerSec << std::endl;
+
+#if !NDEBUG
+
+    std::cout << "Validating result with reference..." << std::endl;
+
+    // Setup and run reference computation.
+    // A is normalized to float16_t, as by the un-fused RMSNorm kernel.
+    std::vector<float16_t> matrixANorm_ref(m * k);
+    std::vector<float32_t> matrixC_ref(m * n, 0.0f);
+    std::vector<float32_t> matrixGemm_ref(m * n);
+    rmsnorm_cpu_h(m, k, matrixA.data(), vectorGamma.data(), matrixANorm_ref.data(), lda);
+    gemm_cpu_h<float16_t, float32_t, float32_t, row_major, col_major, row_major>(
+        m,
+        n,
+        k,
+        matrixANorm_ref.data(),
+        matrixB.data(),
+        matrixC_ref.data(),
+        matrixGemm_ref.data(),
+        lda,
+        ldb,
+        ldd,
+        ldd,
+        1.0f,
+        0.0f);
+    std::vector<float16_t> matrixD_ref(matrixGemm_ref.begin(), matrixGemm_ref.end());
+
+    auto res = fusedFits ? compareEqual<float16_t>(matrixD.data(), matrixD_ref.data(), m * n)
+                         : std::make_pair(true, 0.0);
+    auto resPrePass = compareEqual<float16_t>(matrixDPrePass.data(), matrixD_ref.data(), m * n);
+    auto resUnfused = compareEqual<float16_t>(matrixDUnfused.data(), matrixD_ref.data(), m * n);
+
+    if(std::get<0>(res) == false || std::get<0>(resPrePass) == false
+       || std::get<0>(resUnfused) == false)
+    {
+        std::cout << "FAILED!\n";
+    }
+    else
+    {
+        std::cout << "PASSED!\n";
+    }
+
+    std::cout << "Max relative error: "
+              << std::max(std::get<1>(res), std::get<1>(resPrePass)) << std::endl;
+
+#endif // !NDEBUG
+
+    // Release device memory
+    CHECK_HIP_ERROR(hipFree(d_a));
+    CHECK_HIP_ERROR(hipFree(d_b));
+    CHECK_HIP_ERROR(hipFree(d_gamma));
+    CHECK_HIP_ERROR(hipFree(d_rstd));
+    CHECK_HIP_ERROR(hipFree(d_aNorm));
+    CHECK_HIP_ERROR(hipFree(d_d));
+
+    std::cout << "Finished!" << std::endl;
+}
+
+int main()
+{
+    gemm_test(1024, 1024, 1024);
+    return 0;
+}
@@ -0,0 +1,377 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_fp16.h>
+#include <hip/hip_runtime.h>
+
+#include <rocwmma/rocwmma.hpp>
+#include <rocwmma/rocwmma_sparse.hpp>
+
+#include "common.hpp"
+
+using rocwmma::accumulator;
+using rocwmma::col_major;
+using rocwmma::float16_t;
+using rocwmma::float32_t;
+using rocwmma::matrix_a;
+using rocwmma::matrix_b;
+using rocwmma::row_major;
+using rocwmma::sparse_2_4;
+
+// Supports ROCWMMA_M/N/K sizes of
+// : 16 x 16 x 32
+// : 32 x 32 x 16
+const int ROCWMMA_M = 16;
+const int ROCWMMA_N = 16;
+const int ROCWMMA_K = 32;
+
+// Compressed block sizes
+// : Each ROCWMMA_M x ROCWMMA_K block of A keeps half of its values,
+//   plus one index per lane.
+const int SPARSE_VALUES  = ROCWMMA_M * ROCWMMA_K / 2;
+const int SPARSE_INDICES = rocwmma::Constants::AMDGCN_WAVE_SIZE_64;
+
+// Device warp size
+const uint32_t WAVE_SIZE = getWarpSize();
+
+// Thread block
+// : T_BLOCK_X must be multiple of WAVE_SIZE.
+// Note: Each wave will compute one BLOCK_M x BLOCK_N output block
+// Note: Workgroup will compute
+//  T_BLOCK_X / WAVE_SIZE x T_BLOCK_Y output blocks
+const int T_BLOCK_X = 4 * WAVE_SIZE;
+const int T_BLOCK_Y = 4;
+
+// Prunes A to the 2:4 structured sparse pattern, by zeroing the two
+// smallest magnitudes of every group of four consecutive K elements.
+// : A is in row-major format (M x K)
+__host__ void prune_2_4_h(uint32_t m, uint32_t k, float16_t* a, uint32_t lda)
+{
+    for(uint32_t row = 0; row < m; row++)
+    {
+        for(uint32_t col = 0; col < k; col += 4)
+        {
+            auto group = a + (row * lda + col);
+            auto mag   = [group](int i) { return std::abs(static_cast<float32_t>(group[i])); };
+
+            // Order positions by magnitude
+            int order[4] = {0, 1, 2, 3};
+            std::sort(order, order + 4, [&mag](int l, int r) { return mag(l) < mag(r); });
+
+            group[order[0]] = static_cast<float16_t>(0.0f);
+            group[order[1]] = static_cast<float16_t>(0.0f);
+        }
+    }
+}
+
+// Compresses the pruned A into contiguous sparse blocks, ordered by
+// block row then block K, as consumed by the kernel below.
+__host__ void compress_2_4_h(uint32_t         m,
+                             uint32_t         k,
+                             float16_t const* a,
+                             uint32_t         lda,
+                             float16_t*       values,
+                             uint32_t*        indices)
+{
+    auto blocksK = k / ROCWMMA_K;
+    for(uint32_t blockRow = 0; blockRow < m / ROCWMMA_M; blockRow++)
+    {
+        for(uint32_t blockK = 0; blockK < blocksK; blockK++)
+        {
+            auto blockId = blockRow * blocksK + blockK;
+            rocwmma::compress_sparse_2_4<ROCWMMA_M, ROCWMMA_K, row_major>(
+                a + (blockRow * ROCWMMA_M * lda + blockK * ROCWMMA_K),
+                lda,
+                values + blockId * SPARSE_VALUES,
+                indices + blockId * SPARSE_INDICES);
+        }
+    }
+}
+
+// The following device kernel is a naive implementation
+// of blocked sparse GEMM. Each wave will compute one BLOCK_M x BLOCK_N
+// output block of the M x N x K GEMM, generalized as:
+// D = alpha * (A x B) + beta * C
+//
+// In this simplified example, we assume:
+// : A is 2:4 structured sparse, compressed into blocks by compress_2_4_h
+// : B is in col-major format     (K x N)
+// : C, D are in row-major format (M x N)
+// : Multiplication is NOT in-place, output is written to D matrix
+// : No LDS required
+//
+// Note: This is a simplified implementation to demonstrate API usage in
+// context of wave-level GEMM computation, and is not optimized.
+__global__ void hgemm_sparse_rocwmma_d(uint32_t         m,
+                                       uint32_t         n,
+                                       uint32_t         k,
+                                       float16_t const* aValues,
+                                       uint32_t const*  aIndices,
+                                       float16_t const* b,
+                                       float16_t const* c,
+                                       float16_t*       d,
+                                       uint32_t         ldb,
+                                       uint32_t         ldc,
+                                       uint32_t         ldd,
+                                       float32_t        alpha,
+                                       float32_t        beta)
+{
+    // Create frags
+    auto fragA
+        = rocwmma::fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, sparse_2_4>();
+    auto fragB
+        = rocwmma::fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, col_major>();
+    auto fragC   = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t>();
+    auto fragAcc = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float32_t>();
+
+    rocwmma::fill_fragment(fragAcc, 0.0f);
+
+    // Tile using a 2D grid
+    auto majorWarp = (blockIdx.x * blockDim.x + threadIdx.x) / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    auto minorWarp = (blockIdx.y * blockDim.y + threadIdx.y);
+
+    // Target C block
+    auto cRow = majorWarp * ROCWMMA_M;
+    auto cCol = minorWarp * ROCWMMA_N;
+
+    // Bounds check
+    if(cRow < m && cCol < n)
+    {
+        auto blocksK = k / ROCWMMA_K;
+        auto blockId = majorWarp * blocksK;
+
+        // fragAcc = A x B
+        for(int i = 0; i < k; i += ROCWMMA_K, blockId++)
+        {
+            // Load the inputs. A is read at half of its dense footprint.
+            rocwmma::load_matrix_sync(fragA,
+                                      aValues + blockId * SPARSE_VALUES,
+                                      aIndices + blockId * SPARSE_INDICES);
+            rocwmma::load_matrix_sync(fragB, b + (i + cCol * ldb), ldb);
+
+            // Matrix multiply - accumulate using sparse MFMA units
+            rocwmma::mma_sync(fragAcc, fragA, fragB, fragAcc);
+        }
+
+        // Fetch C matrix
+        rocwmma::load_matrix_sync(fragC, c + (cRow * ldc + cCol), ldc, rocwmma::mem_row_major);
+
+        // D = alpha * A x B + beta * C
+        for(int i = 0; i < fragC.num_elements; ++i)
+        {
+            fragC.x[i] = alpha * fragAcc.x[i] + beta * fragC.x[i];
+        }
+
+        // Store to D
+        rocwmma::store_matrix_sync(d + (cRow * ldd + cCol), fragC, ldd, rocwmma::mem_row_major);
+    }
+}
+
+__host__ void gemm_test(uint32_t m, uint32_t n, uint32_t k, float32_t alpha, float32_t beta)
+{
+    // Bounds check
+    if((m < (ROCWMMA_M * T_BLOCK_X / WAVE_SIZE) || n < (ROCWMMA_N * T_BLOCK_Y) || k < ROCWMMA_K)
+       || (m % ROCWMMA_M || n % ROCWMMA_N || k % ROCWMMA_K))
+    {
+        std::cout << "Unsupported size!\n";
+        return;
+    }
+
+    int lda = k;
+    int ldb = k;
+    int ldc = n;
+    int ldd = ldc;
+
+    auto numBlocksA = (m / ROCWMMA_M) * (k / ROCWMMA_K);
+
+    std::cout << "Initializing host data..." << std::endl;
+
+    // Initialize input matrices
+    std::vector<float16_t> matrixA(m * k);
+    std::vector<float16_t> matrixB(k * n);
+    std::vector<float16_t> matrixC(m * n);
+    // Fill outputs with NaN to catch contamination
+    std::vector<float16_t> matrixD(m * n, std::numeric_limits<float16_t>::signaling_NaN());
+
+    fillRand(matrixA.data(), m, k);
+    fillRand(matrixB.data(), k, n);
+    fillRand(matrixC.data(), m, n);
+
+    // Sparsify and compress A
+    std::vector<float16_t> valuesA(numBlocksA * SPARSE_VALUES);
+    std::vector<uint32_t>  indicesA(numBlocksA * SPARSE_INDICES);
+
+    prune_2_4_h(m, k, matrixA.data(), lda);
+    compress_2_4_h(m, k, matrixA.data(), lda, valuesA.data(), indicesA.data());
+
+    std::cout << "Initializing device data..." << std::endl;
+
+    // Allocate and copy device memory
+    float16_t* d_aValues;
+    uint32_t*  d_aIndices;
+    float16_t* d_b;
+    float16_t* d_c;
+    float16_t* d_d;
+
+    const size_t bytesAValues  = valuesA.size() * sizeof(float16_t);
+    const size_t bytesAIndices = indicesA.size() * sizeof(uint32_t);
+    const size_t bytesB        = matrixB.size() * sizeof(float16_t);
+    const size_t bytesC        = matrixC.size() * sizeof(float16_t);
+    const size_t bytesD        = matrixD.size() * sizeof(float16_t);
+
+    CHECK_HIP_ERROR(hipMalloc(&d_aValues, bytesAValues));
+    CHECK_HIP_ERROR(hipMalloc(&d_aIndices, bytesAIndices));
+    CHECK_HIP_ERROR(hipMalloc(&d_b, bytesB));
+    CHECK_HIP_ERROR(hipMalloc(&d_c, bytesC));
+    CHECK_HIP_ERROR(hipMalloc(&d_d, bytesD));
+
+    CHECK_HIP_ERROR(hipMemcpy(d_aValues, valuesA.data(), bytesAValues, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_aIndices, indicesA.data(), bytesAIndices, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_b, matrixB.data(), bytesB, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_c, matrixC.data(), bytesC, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_d, matrixD.data(), bytesD, hipMemcpyHostToDevice));
+
+    auto blockDim = dim3(T_BLOCK_X, T_BLOCK_Y);
+    auto gridDim  = dim3(rocwmma::ceilDiv(m, ROCWMMA_M * T_BLOCK_X / WAVE_SIZE),
+                        rocwmma::ceilDiv(n, ROCWMMA_N * T_BLOCK_Y));
+
+    std::cout << "Launching sparse GEMM kernel..." << std::endl;
+
+    hipEvent_t startEvent, stopEvent;
+    CHECK_HIP_ERROR(hipEventCreate(&startEvent));
+    CHECK_HIP_ERROR(hipEventCreate(&stopEvent));
+
+    hipExtLaunchKernelGGL(hgemm_sparse_rocwmma_d,
+                          gridDim,
+                          blockDim,
+                          0, // sharedMemBytes
+                          0, // stream
+                          startEvent, // Event start
+                          stopEvent, // event stop
+                          0, // flags
+                          m,
+                          n,
+                          k,
+                          d_aValues,
+                          d_aIndices,
+                          d_b,
+                          d_c,
+                          d_d,
+                          ldb,
+                          ldc,
+                          ldd,
+                          alpha,
+                          beta);
+
+    auto elapsedTimeMs = 0.0f;
+    CHECK_HIP_ERROR(hipEventSynchronize(stopEvent));
+    CHECK_HIP_ERROR(hipEventElapsedTime(&elapsedTimeMs, startEvent, stopEvent));
+    CHECK_HIP_ERROR(hipEventDestroy(startEvent));
+    CHECK_HIP_ERROR(hipEventDestroy(stopEvent));
+
+    // Report the dense equivalent flops, 2*mnk
+    auto gFlops       = calculateGFlops(m, n, k);
+    auto tFlopsPerSec = gFlops / static_cast<double>(elapsedTimeMs);
+
+    // Echo performance
+    std::cout << "BlkM, BlkN, BlkK, "
+              << "MatM, MatN, MatK, "
+              << "alpha, lda, ldb, "
+              << "beta, ldc, ldd, "
+              << "elapsedMs, Problem Size(GFlops), TFlops/s" << std::endl;
+
+    std::cout << ROCWMMA_M << ", " << ROCWMMA_N << ", " << ROCWMMA_K << ", " << m << ", " << n
+              << ", " << k << ", " << alpha << ", " << lda << ", " << ldb << ", " << beta << ", "
+              << ldc << ", " << ldd << ", " << elapsedTimeMs << ", " << gFlops << ", "
+              << tFlopsPerSec << std::endl;
+
+#if !NDEBUG
+
+    std::cout << "Validating result with reference..." << std::endl;
+
+    // Bring kernel result back to host
+    CHECK_HIP_ERROR(hipMemcpy(matrixD.data(), d_d, bytesD, hipMemcpyDeviceToHost));
+
+    // Setup and run reference computation on the pruned dense A
+    std::vector<float16_t> matrixD_ref(m * n, std::numeric_limits<float16_t>::signaling_NaN());
+    gemm_cpu_h<float16_t, float16_t, float32_t, row_major, col_major, row_major>(m,
+                                                                                 n,
+                                                                                 k,
+                                                                                 matrixA.data(),
+                                                                                 matrixB.data(),
+                                                                                 matrixC.data(),
+                                                                                 matrixD_ref.data(),
+                                                                                 lda,
+                                                                                 ldb,
+                                                                                 ldc,
+                                                                                 ldd,
+                                                                                 alpha,
+                                                                                 beta);
+
+    auto res = compareEqual<float16_t>(matrixD.data(), matrixD_ref.data(), m * n);
+
+    if(std::get<0>(res) == false)
+    {
+        std::cout << "FAILED!\n";
+    }
+    else
+    {
+        std::cout << "PASSED!\n";
+    }
+
+    std::cout << "Max relative error: " << std::get<1>(res) << std::endl;
+
+#endif // !NDEBUG
+
+    // Release device memory
+    CHECK_HIP_ERROR(hipFree(d_aValues));
+    CHECK_HIP_ERROR(hipFree(d_aIndices));
+    CHECK_HIP_ERROR(hipFree(d_b));
+    CHECK_HIP_ERROR(hipFree(d_c));
+    CHECK_HIP_ERROR(hipFree(d_d));
+
+    std::cout << "Finished!" << std::endl;
+}
+
+int main()
+{
+    // Test for smfmac device support
+    if(!isSparseSupported())
+    {
+        std::cout << "2:4 sparse gemm not supported on this device" << std::endl;
+    }
+    else
+    {
+        gemm_test(256, 256, 256, 2.1f, 2.1f);
+    }
+
+    return 0;
+}
@@ -0,0 +1,612 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_fp16.h>
+#include <hip/hip_runtime.h>
+
+#include <rocwmma/rocwmma.hpp>
+#include <rocwmma/rocwmma_epilogue.hpp>
+#include <rocwmma/rocwmma_transforms.hpp>
+
+#include "common.hpp"
+
+using rocwmma::accumulator;
+using rocwmma::col_major;
+using rocwmma::float16_t;
+using rocwmma::float32_t;
+using rocwmma::float64_t;
+using rocwmma::matrix_a;
+using rocwmma::matrix_b;
+using rocwmma::row_major;
+
+// Supports ROCWMMA_M/N square sizes of
+// : 16 x 16
+// : 32 x 32 ( only MI )
+const int ROCWMMA_M = 16;
+const int ROCWMMA_N = 16;
+
+// Supports ROCWMMA_K sizes as
+// : multiples of 16.
+const int ROCWMMA_K = 16;
+
+// Device warp size
+const uint32_t WAVE_SIZE = getWarpSize();
+
+// Thread block
+// : T_BLOCK_X is one wave
+// Note: Each wave will compute one BLOCK_M x (BLOCK_N * SLICE_BLOCKS) vocabulary slice
+// Note: Workgroup will compute
+//  1 x T_BLOCK_Y vocabulary slices
+const int T_BLOCK_X = WAVE_SIZE;
+const int T_BLOCK_Y = 4;
+
+// Column blocks of the vocabulary visited by each wave
+const uint32_t SLICE_BLOCKS = 8;
+
+// Candidates kept per row
+const uint32_t TOP_K = 8;
+
+// Threads merging the slices of one row
+const uint32_t MERGE_THREADS = 256;
+
+// Inserts a candidate into a sorted top K list, ranking equal values by lower index
+__device__ inline void
+    insertCandidate(float32_t (&vals)[TOP_K], int32_t (&idx)[TOP_K], float32_t value, int32_t index)
+{
+    for(uint32_t j = 0; j < TOP_K; j++)
+    {
+        if(value > vals[j]
+           || (value == vals[j] && static_cast<uint32_t>(index) < static_cast<uint32_t>(idx[j])))
+        {
+            auto tmpValue = vals[j];
+            auto tmpIndex = idx[j];
+            vals[j]       = value;
+            idx[j]        = index;
+            value         = tmpValue;
+            index         = tmpIndex;
+        }
+    }
+}
+
+// Combines the softmax statistics (max, sum) of two sets of columns
+__device__ inline void combineStats(float32_t& max, float32_t& sum, float32_t max1, float32_t sum1)
+{
+    auto newMax = fmaxf(max, max1);
+    sum         = sum * __expf(max - newMax) + sum1 * __expf(max1 - newMax);
+    max         = newMax;
+}
+
+// The following device kernel is a naive implementation of the blocked logits
+// GEMM of a decode step, with a fused top K sampling epilogue. Each wave will
+// compute one BLOCK_M x (BLOCK_N * SLICE_BLOCKS) slice of the M x N x K GEMM:
+// Z = X x W
+//
+// Where:
+// : X is the hidden state of the batch (M x K)
+// : W is the vocabulary projection     (K x N)
+//
+// The accumulators of each column block are folded into running top K lists and
+// softmax statistics (max, sum) of scale * Z per row, such that each slice only
+// writes K candidates and two statistics per row. A merge kernel then combines
+// the slices into the top K probabilities of each row. Un-fused, the M x N logits
+// are written to memory, and re-read by the same merge kernel.
+//
+// In this simplified example, we assume:
+// : X is in row-major format        (M x K)
+// : W is in col-major format        (K x N)
+// : Z is in col-major format        (M x N), when un-fused
+// : Candidates and statistics are in col-major format, (M x K) and (M x 1) per slice
+// : M, N are multiples of BLOCK_M and BLOCK_N * SLICE_BLOCKS.
+//
+// Note: This is a simplified implementation to demonstrate API usage in
+// context of wave-level GEMM computation, and is not optimized.
+template <bool FuseTopk>
+__global__ void hgemm_topk_d(uint32_t         m,
+                             uint32_t         n,
+                             uint32_t         k,
+                             float16_t const* x,
+                             float16_t const* w,
+                             float16_t*       z,
+                             float32_t*       candVals,
+                             int32_t*         candIdx,
+                             float32_t*       sliceMax,
+                             float32_t*       sliceSum,
+                             uint32_t         ldx,
+                             uint32_t         ldw,
+                             float32_t        scale)
+{
+    using FragX
+        = rocwmma::fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, row_major>;
+    using FragW
+        = rocwmma::fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, col_major>;
+    using FragAcc = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float32_t>;
+    using FragOut = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t>;
+    using FragIdx = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, int32_t>;
+
+    // Tile using a 2D grid
+    auto majorWarp = (blockIdx.x * blockDim.x + threadIdx.x) / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    auto minorWarp = (blockIdx.y * blockDim.y + threadIdx.y);
+
+    // Target block rows and vocabulary slice
+    auto cRow  = majorWarp * ROCWMMA_M;
+    auto slice = minorWarp;
+
+    if(cRow >= m || slice * SLICE_BLOCKS * ROCWMMA_N >= n)
+    {
+        return;
+    }
+
+    // Create frags
+    auto fragX   = FragX();
+    auto fragW   = FragW();
+    auto fragAcc = FragAcc();
+    auto fragZ   = FragOut();
+
+    // Running top K and softmax statistics of the slice
+    FragAcc fragVals[TOP_K];
+    FragIdx fragIdx[TOP_K];
+    auto    fragMax = FragAcc();
+    auto    fragSum = FragAcc();
+
+    if constexpr(FuseTopk)
+    {
+        for(uint32_t j = 0; j < TOP_K; j++)
+        {
+            rocwmma::fill_fragment(fragVals[j], std::numeric_limits<float32_t>::lowest());
+            rocwmma::fill_fragment(fragIdx[j], -1);
+        }
+        rocwmma::fill_fragment(fragMax, std::numeric_limits<float32_t>::lowest());
+        rocwmma::fill_fragment(fragSum, 0.0f);
+    }
+
+    for(uint32_t b = 0; b < SLICE_BLOCKS; b++)
+    {
+        auto cCol = (slice * SLICE_BLOCKS + b) * ROCWMMA_N;
+
+        // fragAcc = X x W
+        rocwmma::fill_fragment(fragAcc, 0.0f);
+        for(int i = 0; i < k; i += ROCWMMA_K)
+        {
+            // Load the inputs
+            rocwmma::load_matrix_sync(fragX, x + (cRow * ldx + i), ldx);
+            rocwmma::load_matrix_sync(fragW, w + (i + cCol * ldw), ldw);
+
+            // Matrix multiply - accumulate using MFMA units
+            rocwmma::mma_sync(fragAcc, fragX, fragW, fragAcc);
+        }
+
+        if constexpr(FuseTopk)
+        {
+            // Ranking the raw logits is the same as ranking the probabilities
+            rocwmma::topk_rows(fragAcc, cCol, fragVals, fragIdx);
+            rocwmma::online_softmax_rows(fragAcc, fragMax, fragSum, scale);
+        }
+        else
+        {
+            // Convert and store to Z
+            rocwmma::apply_epilogue(fragZ, fragAcc);
+            rocwmma::store_matrix_sync(z + (cRow + cCol * m), fragZ, m, rocwmma::mem_col_major);
+        }
+    }
+
+    if constexpr(FuseTopk)
+    {
+        // Store the candidates and statistics of the slice as column vectors
+        for(uint32_t j = 0; j < TOP_K; j++)
+        {
+            auto offset = (slice * TOP_K + j) * m + cRow;
+            rocwmma::store_col_vector_sync(candVals + offset, fragVals[j]);
+            rocwmma::store_col_vector_sync(candIdx + offset, fragIdx[j]);
+        }
+        rocwmma::store_col_vector_sync(sliceMax + (slice * m + cRow), fragMax);
+        rocwmma::store_col_vector_sync(sliceSum + (slice * m + cRow), fragSum);
+    }
+}
+
+// Merges the candidates of one row into its top K probabilities, one workgroup per row.
+// Candidate c of the row is candVals[c * m + row], at column candIdx[c * m + row].
+// Statistics of slice s are (sliceMax[s * m + row], sliceSum[s * m + row]).
+// Without indices or statistics, each candidate is the logit of its own column.
+template <typename ValT>
+__global__ void topk_merge_d(uint32_t         m,
+                             uint32_t         candidates,
+                             uint32_t         slices,
+                             ValT const*      candVals,
+                             int32_t const*   candIdx,
+                             float32_t const* sliceMax,
+                             float32_t const* sliceSum,
+                             int32_t*         topIdx,
+                             float32_t*       topProbs,
+                             float32_t        scale)
+{
+    __shared__ float32_t ldsVals[MERGE_THREADS * TOP_K];
+    __shared__ int32_t   ldsIdx[MERGE_THREADS * TOP_K];
+    __shared__ float32_t ldsMax[MERGE_THREADS];
+    __shared__ float32_t ldsSum[MERGE_THREADS];
+
+    auto row = blockIdx.x;
+
+    float32_t vals[TOP_K];
+    int32_t   idx[TOP_K];
+    for(uint32_t j = 0; j < TOP_K; j++)
+    {
+        vals[j] = std::numeric_limits<float32_t>::lowest();
+        idx[j]  = -1;
+    }
+
+    auto max = std::numeric_limits<float32_t>::lowest();
+    auto sum = 0.0f;
+
+    // Strided candidates and statistics of each thread
+    for(uint32_t c = threadIdx.x; c < candidates; c += MERGE_THREADS)
+    {
+        auto value = static_cast<float32_t>(candVals[c * m + row]);
+        auto index = candIdx != nullptr ? candIdx[c * m + row] : static_cast<int32_t>(c);
+        insertCandidate(vals, idx, value, index);
+    }
+
+    for(uint32_t s = threadIdx.x; s < slices; s += MERGE_THREADS)
+    {
+        if(sliceMax != nullptr)
+        {
+            combineStats(max, sum, sliceMax[s * m + row], sliceSum[s * m + row]);
+        }
+        else
+        {
+            combineStats(max, sum, scale * static_cast<float32_t>(candVals[s * m + row]), 1.0f);
+        }
+    }
+
+    for(uint32_t j = 0; j < TOP_K; j++)
+    {
+        ldsVals[threadIdx.x * TOP_K + j] = vals[j];
+        ldsIdx[threadIdx.x * TOP_K + j]  = idx[j];
+    }
+    ldsMax[threadIdx.x] = max;
+    ldsSum[threadIdx.x] = sum;
+
+    __syncthreads();
+
+    // Merge the threads
+    if(threadIdx.x == 0)
+    {
+        for(uint32_t t = 1; t < MERGE_THREADS; t++)
+        {
+            for(uint32_t j = 0; j < TOP_K; j++)
+            {
+                insertCandidate(vals, idx, ldsVals[t * TOP_K + j], ldsIdx[t * TOP_K + j]);
+            }
+            combineStats(max, sum, ldsMax[t], ldsSum[t]);
+        }
+
+        for(uint32_t j = 0; j < TOP_K; j++)
+        {
+            topIdx[row * TOP_K + j]   = idx[j];
+            topProbs[row * TOP_K + j] = __expf(scale * vals[j] - max) / sum;
+        }
+    }
+}
+
+// Host reference of the softmax probabilities of scale * (X x W), row-major (M x N)
+__host__ void softmax_cpu_h(uint32_t         m,
+                            uint32_t         n,
+                            uint32_t         k,
+                            float16_t const* x,
+                            float16_t const* w,
+                            float64_t*       probs,
+                            uint32_t         ldx,
+                            uint32_t         ldw,
+                            float32_t        scale)
+{
+#pragma omp parallel for
+    for(int i = 0; i < m; ++i)
+    {
+        auto* p = probs + static_cast<size_t>(i) * n;
+        for(int j = 0; j < n; ++j)
+        {
+            auto accum = 0.0f;
+            for(int h = 0; h < k; ++h)
+            {
+                accum += static_cast<float32_t>(x[i * ldx + h])
+                         * static_cast<float32_t>(w[static_cast<size_t>(j) * ldw + h]);
+            }
+            p[j] = static_cast<float64_t>(scale) * static_cast<float64_t>(accum);
+        }
+
+        auto max = *std::max_element(p, p + n);
+        auto sum = 0.0;
+        for(int j = 0; j < n; ++j)
+        {
+            p[j] = std::exp(p[j] - max);
+            sum += p[j];
+        }
+        for(int j = 0; j < n; ++j)
+        {
+            p[j] /= sum;
+        }
+    }
+}
+
+__host__ void gemm_test(uint32_t m, uint32_t n, uint32_t k, float32_t temperature)
+{
+    // Bounds check
+    if((m < ROCWMMA_M || n < (ROCWMMA_N * SLICE_BLOCKS) || k < ROCWMMA_K)
+       || (m % ROCWMMA_M || n % (ROCWMMA_N * SLICE_BLOCKS) || k % ROCWMMA_K))
+    {
+        std::cout << "Unsupported size!\n";
+        return;
+    }
+
+    int       ldx    = k;
+    int       ldw    = k;
+    uint32_t  slices = n / (ROCWMMA_N * SLICE_BLOCKS);
+    float32_t scale  = 1.0f / temperature;
+
+    std::cout << "Initializing host data..." << std::endl;
+
+    // Initialize input matrices. Inputs in [-0.5, 0.5] and [-0.25, 0.25]
+    // give logits of a few units, as in trained models.
+    std::vector<float16_t> matrixX(m * k);
+    std::vector<float16_t> matrixW(static_cast<size_t>(k) * n);
+
+    auto randValue = [](float32_t range) {
+        auto unit = 2.0f * static_cast<float32_t>(rand()) / RAND_MAX - 1.0f;
+        return static_cast<float16_t>(range * unit);
+    };
+    std::generate(matrixX.begin(), matrixX.end(), [&]() { return randValue(0.5f); });
+    std::generate(matrixW.begin(), matrixW.end(), [&]() { return randValue(0.25f); });
+
+    std::vector<int32_t>   topIdx(m * TOP_K);
+    std::vector<float32_t> topProbs(m * TOP_K);
+    std::vector<int32_t>   topIdxUnfused(m * TOP_K);
+    std::vector<float32_t> topProbsUnfused(m * TOP_K);
+
+    std::cout << "Initializing device data..." << std::endl;
+
+    // Allocate and copy device memory
+    float16_t* d_x;
+    float16_t* d_w;
+    float16_t* d_z;
+    float32_t* d_candVals;
+    int32_t*   d_candIdx;
+    float32_t* d_sliceMax;
+    float32_t* d_sliceSum;
+    int32_t*   d_topIdx;
+    float32_t* d_topProbs;
+
+    const size_t bytesX     = matrixX.size() * sizeof(float16_t);
+    const size_t bytesW     = matrixW.size() * sizeof(float16_t);
+    const size_t bytesZ     = static_cast<size_t>(m) * n * sizeof(float16_t);
+    const size_t bytesCand  = slices * TOP_K * m * sizeof(float32_t);
+    const size_t bytesStats = slices * m * sizeof(float32_t);
+    const size_t bytesTop   = m * TOP_K * sizeof(float32_t);
+
+    CHECK_HIP_ERROR(hipMalloc(&d_x, bytesX));
+    CHECK_HIP_ERROR(hipMalloc(&d_w, bytesW));
+    CHECK_HIP_ERROR(hipMalloc(&d_z, bytesZ));
+    CHECK_HIP_ERROR(hipMalloc(&d_candVals, bytesCand));
+    CHECK_HIP_ERROR(hipMalloc(&d_candIdx, bytesCand));
+    CHECK_HIP_ERROR(hipMalloc(&d_sliceMax, bytesStats));
+    CHECK_HIP_ERROR(hipMalloc(&d_sliceSum, bytesStats));
+    CHECK_HIP_ERROR(hipMalloc(&d_topIdx, bytesTop));
+    CHECK_HIP_ERROR(hipMalloc(&d_topProbs, bytesTop));
+
+    CHECK_HIP_ERROR(hipMemcpy(d_x, matrixX.data(), bytesX, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_w, matrixW.data(), bytesW, hipMemcpyHostToDevice));
+
+    auto blockDim = dim3(T_BLOCK_X, T_BLOCK_Y);
+    auto gridDim  = dim3(rocwmma::ceilDiv(m, ROCWMMA_M), rocwmma::ceilDiv(slices, T_BLOCK_Y));
+
+    hipEvent_t startEvent, stopEvent;
+    CHECK_HIP_ERROR(hipEventCreate(&startEvent));
+    CHECK_HIP_ERROR(hipEventCreate(&stopEvent));
+
+    std::cout << "Launching fused top K GEMM and merge kernels..." << std::endl;
+
+    auto fusedTimeMs = 0.0f;
+    CHECK_HIP_ERROR(hipEventRecord(startEvent));
+    hipLaunchKernelGGL(hgemm_topk_d<true>,
+                       gridDim,
+                       blockDim,
+                       0, // sharedMemBytes
+                       0, // stream
+                       m,
+                       n,
+                       k,
+                       d_x,
+                       d_w,
+                       d_z,
+                       d_candVals,
+                       d_candIdx,
+                       d_sliceMax,
+                       d_sliceSum,
+                       ldx,
+                       ldw,
+                       scale);
+    hipLaunchKernelGGL(topk_merge_d<float32_t>,
+                       dim3(m),
+                       dim3(MERGE_THREADS),
+                       0, // sharedMemBytes
+                       0, // stream
+                       m,
+                       slices * TOP_K,
+                       slices,
+                       d_candVals,
+                       d_candIdx,
+                       d_sliceMax,
+                       d_sliceSum,
+                       d_topIdx,
+                       d_topProbs,
+                       scale);
+    CHECK_HIP_ERROR(hipEventRecord(stopEvent));
+    CHECK_HIP_ERROR(hipEventSynchronize(stopEvent));
+    CHECK_HIP_ERROR(hipEventElapsedTime(&fusedTimeMs, startEvent, stopEvent));
+    CHECK_HIP_ERROR(hipMemcpy(topIdx.data(), d_topIdx, bytesTop, hipMemcpyDeviceToHost));
+    CHECK_HIP_ERROR(hipMemcpy(topProbs.data(), d_topProbs, bytesTop, hipMemcpyDeviceToHost));
+
+    std::cout << "Launching un-fused logits GEMM and merge kernels..." << std::endl;
+
+    auto unfusedTimeMs = 0.0f;
+    CHECK_HIP_ERROR(hipEventRecord(startEvent));
+    hipLaunchKernelGGL(hgemm_topk_d<false>,
+                       gridDim,
+                       blockDim,
+                       0, // sharedMemBytes
+                       0, // stream
+                       m,
+                       n,
+                       k,
+                       d_x,
+                       d_w,
+                       d_z,
+                       d_candVals,
+                       d_candIdx,
+                       d_sliceMax,
+                       d_sliceSum,
+                       ldx,
+                       ldw,
+                       scale);
+    hipLaunchKernelGGL(topk_merge_d<float16_t>,
+                       dim3(m),
+                       dim3(MERGE_THREADS),
+                       0, // sharedMemBytes
+                       0, // stream
+                       m,
+                       n,
+                       n,
+                       d_z,
+                       nullptr,
+                       nullptr,
+                       nullptr,
+                       d_topIdx,
+                       d_topProbs,
+                       scale);
+    CHECK_HIP_ERROR(hipEventRecord(stopEvent));
+    CHECK_HIP_ERROR(hipEventSynchronize(stopEvent));
+    CHECK_HIP_ERROR(hipEventElapsedTime(&unfusedTimeMs, startEvent, stopEvent));
+    CHECK_HIP_ERROR(hipMemcpy(topIdxUnfused.data(), d_topIdx, bytesTop, hipMemcpyDeviceToHost));
+    CHECK_HIP_ERROR(
+        hipMemcpy(topProbsUnfused.data(), d_topProbs, bytesTop, hipMemcpyDeviceToHost));
+
+    CHECK_HIP_ERROR(hipEventDestroy(startEvent));
+    CHECK_HIP_ERROR(hipEventDestroy(stopEvent));
+
+    // GEMM flops converge to 2*mnk
+    auto gFlops       = calculateGFlops(m, n, k);
+    auto tFlopsPerSec = gFlops / static_cast<double>(fusedTimeMs);
+
+    // Echo performance
+    std::cout << "BlkM, BlkN, BlkK, "
+              << "MatM, MatN, MatK, "
+              << "topK, fusedMs, unfusedMs, "
+              << "Problem Size(GFlops), TFlops/s" << std::endl;
+
+    std::cout << ROCWMMA_M << ", " << ROCWMMA_N << ", " << ROCWMMA_K << ", " << m << ", " << n
+              << ", " << k << ", " << TOP_K << ", " << fusedTimeMs << ", " << unfusedTimeMs << ", "
+              << gFlops << ", " << tFlopsPerSec << std::endl;
+
+#if !NDEBUG
+
+    std::cout << "Validating result with reference..." << std::endl;
+
+    std::vector<float64_t> probs_ref(static_cast<size_t>(m) * n);
+    softmax_cpu_h(m, n, k, matrixX.data(), matrixW.data(), probs_ref.data(), ldx, ldw, scale);
+
+    // Device probabilities are checked against the reference top K, and against the
+    // reference probabilities of the selected columns, at half precision tolerance.
+    // Near ties may select columns in either order.
+    auto validate = [&](std::vector<int32_t> const& idx, std::vector<float32_t> const& prob) {
+        std::vector<float16_t> top(m * TOP_K);
+        std::vector<float16_t> top_ref(m * TOP_K);
+        std::vector<float16_t> selected_ref(m * TOP_K);
+        std::vector<float64_t> row(n);
+
+        for(int i = 0; i < m; ++i)
+        {
+            auto const* p = probs_ref.data() + static_cast<size_t>(i) * n;
+            std::partial_sort_copy(p, p + n, row.begin(), row.begin() + TOP_K, std::greater<>());
+
+            for(int j = 0; j < TOP_K; ++j)
+            {
+                auto index             = idx[i * TOP_K + j];
+                top[i * TOP_K + j]     = static_cast<float16_t>(prob[i * TOP_K + j]);
+                top_ref[i * TOP_K + j] = static_cast<float16_t>(row[j]);
+                selected_ref[i * TOP_K + j]
+                    = static_cast<float16_t>(index >= 0 && index < n ? p[index] : -1.0);
+            }
+        }
+
+        auto resTop      = compareEqual<float16_t>(top.data(), top_ref.data(), m * TOP_K);
+        auto resSelected = compareEqual<float16_t>(top.data(), selected_ref.data(), m * TOP_K);
+        return std::make_pair(std::get<0>(resTop) && std::get<0>(resSelected),
+                              std::max(std::get<1>(resTop), std::get<1>(resSelected)));
+    };
+
+    auto res        = validate(topIdx, topProbs);
+    auto resUnfused = validate(topIdxUnfused, topProbsUnfused);
+
+    if(std::get<0>(res) == false || std::get<0>(resUnfused) == false)
+    {
+        std::cout << "FAILED!\n";
+    }
+    else
+    {
+        std::cout << "PASSED!\n";
+    }
+
+    std::cout << "Max relative error: " << std::get<1>(res) << std::endl;
+
+#endif // !NDEBUG
+
+    // Release device memory
+    CHECK_HIP_ERROR(hipFree(d_x));
+    CHECK_HIP_ERROR(hipFree(d_w));
+    CHECK_HIP_ERROR(hipFree(d_z));
+    CHECK_HIP_ERROR(hipFree(d_candVals));
+    CHECK_HIP_ERROR(hipFree(d_candIdx));
+    CHECK_HIP_ERROR(hipFree(d_sliceMax));
+    CHECK_HIP_ERROR(hipFree(d_sliceSum));
+    CHECK_HIP_ERROR(hipFree(d_topIdx));
+    CHECK_HIP_ERROR(hipFree(d_topProbs));
+
+    std::cout << "Finished!" << std::endl;
+}
+
+int main()
+{
+    // Decode steps of 16 and 64 sequences, projecting to a 151936 token vocabulary
+    gemm_test(16, 151936, 1024, 0.8f);
+    gemm_test(64, 151936, 1024, 0.8f);
+    return 0;
+}
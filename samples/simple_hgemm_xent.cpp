@@ -0,0 +1,736 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_fp16.h>
+#include <hip/hip_runtime.h>
+
+#include <rocwmma/rocwmma.hpp>
+#include <rocwmma/rocwmma_epilogue.hpp>
+#include <rocwmma/rocwmma_transforms.hpp>
+
+#include "common.hpp"
+
+using rocwmma::accumulator;
+using rocwmma::col_major;
+using rocwmma::float16_t;
+using rocwmma::float32_t;
+using rocwmma::float64_t;
+using rocwmma::matrix_a;
+using rocwmma::matrix_b;
+using rocwmma::row_major;
+
+// Supports ROCWMMA_M/N square sizes of
+// : 16 x 16
+// : 32 x 32 ( only MI )
+const int ROCWMMA_M = 16;
+const int ROCWMMA_N = 16;
+
+// Supports ROCWMMA_K sizes as
+// : multiples of 16.
+// Note: The backward pass multiplies by logit gradient blocks of BLOCK_M x BLOCK_N,
+// so ROCWMMA_K must equal ROCWMMA_M and ROCWMMA_N.
+const int ROCWMMA_K = 16;
+
+// Device warp size
+const uint32_t WAVE_SIZE = getWarpSize();
+
+// Thread block
+// : T_BLOCK_X is one wave
+// Note: In the forward pass, each wave will compute one BLOCK_M x (BLOCK_N * SLICE_BLOCKS)
+// vocabulary slice, and the workgroup 1 x T_BLOCK_Y slices.
+// Note: In the backward pass, the workgroup will compute one
+// (BLOCK_M * T_BLOCK_Y) x (BLOCK_N * SLICE_BLOCKS) slice, one BLOCK_M row block per wave.
+const int T_BLOCK_X = WAVE_SIZE;
+const int T_BLOCK_Y = 4;
+
+// Column blocks of the vocabulary visited by each wave
+const uint32_t SLICE_BLOCKS = 8;
+
+// Threads merging the slices of one row
+const uint32_t MERGE_THREADS = 256;
+
+// Lds staging of the logit gradients of a backward slice, row major
+const uint32_t LDS_LD = ROCWMMA_N * SLICE_BLOCKS;
+
+using FragX   = rocwmma::fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, row_major>;
+using FragXT  = rocwmma::fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, col_major>;
+using FragW   = rocwmma::fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, col_major>;
+using FragWT  = rocwmma::fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, row_major>;
+using FragDZ  = FragX;
+using FragDZB = FragWT;
+using FragAcc = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float32_t>;
+using FragOut = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t>;
+using FragIdx = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, int32_t>;
+
+// Combines the softmax statistics (max, sum) of two sets of columns
+__device__ inline void combineStats(float32_t& max, float32_t& sum, float32_t max1, float32_t sum1)
+{
+    auto newMax = fmaxf(max, max1);
+    sum         = sum * __expf(max - newMax) + sum1 * __expf(max1 - newMax);
+    max         = newMax;
+}
+
+// Logits block Z = X x W of the rows at cRow and the columns at cCol
+__device__ inline void logitsBlock(FragAcc&         fragAcc,
+                                   uint32_t         k,
+                                   float16_t const* x,
+                                   float16_t const* w,
+                                   uint32_t         cRow,
+                                   uint32_t         cCol,
+                                   uint32_t         ldx,
+                                   uint32_t         ldw)
+{
+    auto fragX = FragX();
+    auto fragW = FragW();
+
+    rocwmma::fill_fragment(fragAcc, 0.0f);
+    for(int i = 0; i < k; i += ROCWMMA_K)
+    {
+        // Load the inputs
+        rocwmma::load_matrix_sync(fragX, x + (cRow * ldx + i), ldx);
+        rocwmma::load_matrix_sync(fragW, w + (i + cCol * ldw), ldw);
+
+        // Matrix multiply - accumulate using MFMA units
+        rocwmma::mma_sync(fragAcc, fragX, fragW, fragAcc);
+    }
+}
+
+// Atomically adds scale * frag to the fp32 block at dst, row or col major
+__device__ inline void atomicAddBlock(
+    float32_t* dst, uint32_t ld, bool rowMajor, FragAcc const& frag, float32_t scale)
+{
+    for(uint32_t i = 0; i < FragAcc::num_elements; i++)
+    {
+        auto row    = rocwmma::fragment_coords<FragAcc>::row(i);
+        auto col    = rocwmma::fragment_coords<FragAcc>::col(i);
+        auto offset = rowMajor ? row * ld + col : col * ld + row;
+        atomicAdd(dst + offset, scale * frag.x[i]);
+    }
+}
+
+// The following device kernels are a naive implementation of the fused vocabulary
+// projection and softmax cross-entropy loss of LM training:
+//
+// Z = scale * (X x W)
+// loss_i = logsumexp_j(Z_ij) - Z_i,t(i)
+//
+// Where:
+// : X is the hidden state of the tokens       (M x K)
+// : W is the vocabulary projection             (K x N)
+// : t(i) is the target token of row i
+// : scale is 1 / temperature, or 1 for training
+//
+// The M x N logits are the largest activation of the model, yet each logit is only
+// used by the loss and by its own gradient. The forward kernel folds the accumulators
+// of each column block into the online softmax statistics (max, sum) of its rows, and
+// picks up the target logit of the rows whose target is in the block. Each slice only
+// writes three values per row, which a merge kernel combines into the log-sum-exp
+// and the loss of each row.
+//
+// The backward kernel recomputes each logits block from X and W, and turns it into
+// the logit gradient in registers with the saved log-sum-exp:
+//
+// dZ_ij = scale * (exp(Z_ij - lse_i) - [j == t(i)]) * gradScale
+//
+// The gradient block is staged in Lds in fp16, and multiplied straight away into the
+// gradients of the hidden state and of the projection:
+//
+// dX = dZ x W^T   (M x K), accumulated over the slices
+// dW = X^T x dZ   (K x N), accumulated over the row blocks
+//
+// Neither the logits nor their gradient are ever written to global memory. Recomputing
+// the logits costs one more GEMM of X x W in the backward pass, rather than the M x N
+// fp32 write and read of storing them.
+//
+// In this simplified example, we assume:
+// : X, dX are in row-major format         (M x K)
+// : W, dW are in col-major format         (K x N)
+// : Statistics are in col-major format, (M x 1) per slice
+// : M, N are multiples of BLOCK_M * T_BLOCK_Y and BLOCK_N * SLICE_BLOCKS.
+//
+// Note: dX and dW are accumulated with fp32 atomics, and must be zeroed beforehand.
+// Logit gradients are staged without gradScale, as fp16 would lose the small
+// probabilities of large vocabularies once scaled by 1 / M. It is applied to the
+// fp32 products instead.
+//
+// Note: This is a simplified implementation to demonstrate API usage in
+// context of wave-level GEMM computation, and is not optimized.
+__global__ void hgemm_xent_fwd_d(uint32_t         m,
+                                 uint32_t         n,
+                                 uint32_t         k,
+                                 float16_t const* x,
+                                 float16_t const* w,
+                                 int32_t const*   targets,
+                                 float32_t*       sliceMax,
+                                 float32_t*       sliceSum,
+                                 float32_t*       sliceTarget,
+                                 uint32_t         ldx,
+                                 uint32_t         ldw,
+                                 float32_t        scale)
+{
+    // Tile using a 2D grid
+    auto majorWarp = (blockIdx.x * blockDim.x + threadIdx.x) / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    auto minorWarp = (blockIdx.y * blockDim.y + threadIdx.y);
+
+    // Target block rows and vocabulary slice
+    auto cRow  = majorWarp * ROCWMMA_M;
+    auto slice = minorWarp;
+
+    if(cRow >= m || slice * SLICE_BLOCKS * ROCWMMA_N >= n)
+    {
+        return;
+    }
+
+    // Target token of each row, broadcast along the rows
+    auto fragTarget = FragIdx();
+    rocwmma::load_col_vector_sync(fragTarget, targets + cRow);
+
+    // Running softmax statistics and target logit of the slice
+    auto fragAcc         = FragAcc();
+    auto fragMax         = FragAcc();
+    auto fragSum         = FragAcc();
+    auto fragTargetLogit = FragAcc();
+    rocwmma::fill_fragment(fragMax, std::numeric_limits<float32_t>::lowest());
+    rocwmma::fill_fragment(fragSum, 0.0f);
+    rocwmma::fill_fragment(fragTargetLogit, 0.0f);
+
+    for(uint32_t b = 0; b < SLICE_BLOCKS; b++)
+    {
+        auto cCol = (slice * SLICE_BLOCKS + b) * ROCWMMA_N;
+
+        // fragAcc = X x W
+        logitsBlock(fragAcc, k, x, w, cRow, cCol, ldx, ldw);
+
+        // At most one element of each row is its target
+        for(uint32_t i = 0; i < FragAcc::num_elements; i++)
+        {
+            auto col = static_cast<int32_t>(cCol + rocwmma::fragment_coords<FragAcc>::col(i));
+            fragTargetLogit.x[i] += col == fragTarget.x[i] ? scale * fragAcc.x[i] : 0.0f;
+        }
+
+        rocwmma::online_softmax_rows(fragAcc, fragMax, fragSum, scale);
+    }
+
+    // Store the statistics of the slice as column vectors
+    fragTargetLogit = rocwmma::reduce_rows<rocwmma::reduce::Sum>(fragTargetLogit);
+    rocwmma::store_col_vector_sync(sliceMax + (slice * m + cRow), fragMax);
+    rocwmma::store_col_vector_sync(sliceSum + (slice * m + cRow), fragSum);
+    rocwmma::store_col_vector_sync(sliceTarget + (slice * m + cRow), fragTargetLogit);
+}
+
+// Merges the slices of one row into its log-sum-exp and loss, one workgroup per row.
+// Statistics of slice s are (sliceMax[s * m + row], sliceSum[s * m + row]), and
+// sliceTarget[s * m + row] is the target logit if it is in slice s, 0 otherwise.
+// The loss of the row, scaled by lossScale, is added to lossTotal.
+__global__ void xent_merge_d(uint32_t         m,
+                             uint32_t         slices,
+                             float32_t const* sliceMax,
+                             float32_t const* sliceSum,
+                             float32_t const* sliceTarget,
+                             float32_t*       lse,
+                             float32_t*       loss,
+                             float32_t*       lossTotal,
+                             float32_t        lossScale)
+{
+    __shared__ float32_t ldsMax[MERGE_THREADS];
+    __shared__ float32_t ldsSum[MERGE_THREADS];
+    __shared__ float32_t ldsTarget[MERGE_THREADS];
+
+    auto row = blockIdx.x;
+
+    auto max    = std::numeric_limits<float32_t>::lowest();
+    auto sum    = 0.0f;
+    auto target = 0.0f;
+
+    // Strided statistics of each thread
+    for(uint32_t s = threadIdx.x; s < slices; s += MERGE_THREADS)
+    {
+        combineStats(max, sum, sliceMax[s * m + row], sliceSum[s * m + row]);
+        target += sliceTarget[s * m + row];
+    }
+
+    ldsMax[threadIdx.x]    = max;
+    ldsSum[threadIdx.x]    = sum;
+    ldsTarget[threadIdx.x] = target;
+
+    __syncthreads();
+
+    // Merge the threads
+    if(threadIdx.x == 0)
+    {
+        for(uint32_t t = 1; t < MERGE_THREADS; t++)
+        {
+            combineStats(max, sum, ldsMax[t], ldsSum[t]);
+            target += ldsTarget[t];
+        }
+
+        auto rowLse = max + __logf(sum);
+        lse[row]    = rowLse;
+        loss[row]   = rowLse - target;
+        atomicAdd(lossTotal, lossScale * (rowLse - target));
+    }
+}
+
+// Backward pass of the fused loss, accumulating the gradients of X and W.
+// gradScale is the gradient of the loss total, e.g. 1 / M for the mean over tokens.
+__global__ void hgemm_xent_bwd_d(uint32_t         m,
+                                 uint32_t         n,
+                                 uint32_t         k,
+                                 float16_t const* x,
+                                 float16_t const* w,
+                                 int32_t const*   targets,
+                                 float32_t const* lse,
+                                 float32_t*       dx,
+                                 float32_t*       dw,
+                                 uint32_t         ldx,
+                                 uint32_t         ldw,
+                                 float32_t        scale,
+                                 float32_t        gradScale)
+{
+    __shared__ float16_t ldsDZ[T_BLOCK_Y * ROCWMMA_M * LDS_LD];
+
+    // Workgroup rows and vocabulary slice. Each wave takes one row block.
+    auto rowBase = blockIdx.x * T_BLOCK_Y * ROCWMMA_M;
+    auto cRow    = rowBase + threadIdx.y * ROCWMMA_M;
+    auto slice   = blockIdx.y;
+    auto colBase = slice * SLICE_BLOCKS * ROCWMMA_N;
+
+    auto fragTarget = FragIdx();
+    auto fragLse    = FragAcc();
+    rocwmma::load_col_vector_sync(fragTarget, targets + cRow);
+    rocwmma::load_col_vector_sync(fragLse, lse + cRow);
+
+    // Logit gradients of the wave rows, staged in fp16
+    auto fragAcc = FragAcc();
+    auto fragDZ  = FragOut();
+    for(uint32_t b = 0; b < SLICE_BLOCKS; b++)
+    {
+        auto cCol = colBase + b * ROCWMMA_N;
+
+        logitsBlock(fragAcc, k, x, w, cRow, cCol, ldx, ldw);
+
+        for(uint32_t i = 0; i < FragAcc::num_elements; i++)
+        {
+            auto col     = static_cast<int32_t>(cCol + rocwmma::fragment_coords<FragAcc>::col(i));
+            auto prob    = __expf(scale * fragAcc.x[i] - fragLse.x[i]);
+            auto onehot  = col == fragTarget.x[i] ? 1.0f : 0.0f;
+            fragAcc.x[i] = scale * (prob - onehot);
+        }
+
+        rocwmma::apply_epilogue(fragDZ, fragAcc);
+        rocwmma::store_matrix_sync(ldsDZ + (threadIdx.y * ROCWMMA_M * LDS_LD + b * ROCWMMA_N),
+                                   fragDZ,
+                                   LDS_LD,
+                                   rocwmma::mem_row_major);
+    }
+
+    // dW needs the gradients of all the workgroup rows
+    __syncthreads();
+
+    auto fragA    = FragDZ();
+    auto fragB    = FragWT();
+    auto fragXT   = FragXT();
+    auto fragDZB  = FragDZB();
+    auto fragGrad = FragAcc();
+
+    // dX = dZ x W^T of the wave rows, for each column block of X
+    for(uint32_t kb = 0; kb < k; kb += ROCWMMA_K)
+    {
+        rocwmma::fill_fragment(fragGrad, 0.0f);
+        for(uint32_t b = 0; b < SLICE_BLOCKS; b++)
+        {
+            auto cCol = colBase + b * ROCWMMA_N;
+            rocwmma::load_matrix_sync(
+                fragA, ldsDZ + (threadIdx.y * ROCWMMA_M * LDS_LD + b * ROCWMMA_N), LDS_LD);
+            rocwmma::load_matrix_sync(fragB, w + (cCol * ldw + kb), ldw);
+            rocwmma::mma_sync(fragGrad, fragA, fragB, fragGrad);
+        }
+        atomicAddBlock(dx + (cRow * ldx + kb), ldx, true, fragGrad, gradScale);
+    }
+
+    // dW = X^T x dZ of the workgroup rows. Waves split the row blocks of dW.
+    for(uint32_t kb = threadIdx.y * ROCWMMA_K; kb < k; kb += T_BLOCK_Y * ROCWMMA_K)
+    {
+        for(uint32_t b = 0; b < SLICE_BLOCKS; b++)
+        {
+            auto cCol = colBase + b * ROCWMMA_N;
+
+            rocwmma::fill_fragment(fragGrad, 0.0f);
+            for(uint32_t r = 0; r < T_BLOCK_Y; r++)
+            {
+                auto row = rowBase + r * ROCWMMA_M;
+                rocwmma::load_matrix_sync(fragXT, x + (row * ldx + kb), ldx);
+                rocwmma::load_matrix_sync(
+                    fragDZB, ldsDZ + (r * ROCWMMA_M * LDS_LD + b * ROCWMMA_N), LDS_LD);
+                rocwmma::mma_sync(fragGrad, fragXT, fragDZB, fragGrad);
+            }
+            atomicAddBlock(dw + (cCol * ldw + kb), ldw, false, fragGrad, gradScale);
+        }
+    }
+}
+
+// Host reference of the loss, log-sum-exp and gradients of the fused kernels
+__host__ void xent_cpu_h(uint32_t                      m,
+                         uint32_t                      n,
+                         uint32_t                      k,
+                         std::vector<float16_t> const& x,
+                         std::vector<float16_t> const& w,
+                         std::vector<int32_t> const&   targets,
+                         std::vector<float32_t>&       loss,
+                         std::vector<float32_t>&       dx,
+                         std::vector<float32_t>&       dw,
+                         uint32_t                      ldx,
+                         uint32_t                      ldw,
+                         float32_t                     scale,
+                         float32_t                     gradScale)
+{
+    // Logit gradients of all rows, row-major (M x N)
+    std::vector<float64_t> dz(static_cast<size_t>(m) * n);
+
+#pragma omp parallel for
+    for(int i = 0; i < m; ++i)
+    {
+        auto* g = dz.data() + static_cast<size_t>(i) * n;
+        for(int j = 0; j < n; ++j)
+        {
+            auto accum = 0.0f;
+            for(int h = 0; h < k; ++h)
+            {
+                accum += static_cast<float32_t>(x[i * ldx + h])
+                         * static_cast<float32_t>(w[static_cast<size_t>(j) * ldw + h]);
+            }
+            g[j] = static_cast<float64_t>(scale) * static_cast<float64_t>(accum);
+        }
+
+        auto max = *std::max_element(g, g + n);
+        auto sum = 0.0;
+        for(int j = 0; j < n; ++j)
+        {
+            sum += std::exp(g[j] - max);
+        }
+
+        auto lse = max + std::log(sum);
+        loss[i]  = static_cast<float32_t>(lse - g[targets[i]]);
+
+        for(int j = 0; j < n; ++j)
+        {
+            auto onehot = j == targets[i] ? 1.0 : 0.0;
+            g[j]        = static_cast<float64_t>(scale) * (std::exp(g[j] - lse) - onehot);
+        }
+    }
+
+#pragma omp parallel for
+    for(int i = 0; i < m; ++i)
+    {
+        for(int h = 0; h < k; ++h)
+        {
+            auto accum = 0.0;
+            for(int j = 0; j < n; ++j)
+            {
+                accum += dz[static_cast<size_t>(i) * n + j]
+                         * static_cast<float64_t>(w[static_cast<size_t>(j) * ldw + h]);
+            }
+            dx[i * ldx + h] = static_cast<float32_t>(gradScale * accum);
+        }
+    }
+
+#pragma omp parallel for
+    for(int j = 0; j < n; ++j)
+    {
+        for(int h = 0; h < k; ++h)
+        {
+            auto accum = 0.0;
+            for(int i = 0; i < m; ++i)
+            {
+                accum += static_cast<float64_t>(x[i * ldx + h])
+                         * dz[static_cast<size_t>(i) * n + j];
+            }
+            dw[static_cast<size_t>(j) * ldw + h] = static_cast<float32_t>(gradScale * accum);
+        }
+    }
+}
+
+__host__ void gemm_test(uint32_t m, uint32_t n, uint32_t k)
+{
+    // Bounds check
+    if((m < ROCWMMA_M * T_BLOCK_Y || n < (ROCWMMA_N * SLICE_BLOCKS) || k < ROCWMMA_K)
+       || (m % (ROCWMMA_M * T_BLOCK_Y) || n % (ROCWMMA_N * SLICE_BLOCKS) || k % ROCWMMA_K))
+    {
+        std::cout << "Unsupported size!\n";
+        return;
+    }
+
+    int       ldx       = k;
+    int       ldw       = k;
+    uint32_t  slices    = n / (ROCWMMA_N * SLICE_BLOCKS);
+    float32_t scale     = 1.0f;
+    float32_t gradScale = 1.0f / static_cast<float32_t>(m);
+
+    std::cout << "Initializing host data..." << std::endl;
+
+    // Initialize input matrices. Inputs in [-0.5, 0.5] and [-0.25, 0.25]
+    // give logits of a few units, as in trained models.
+    std::vector<float16_t> matrixX(m * k);
+    std::vector<float16_t> matrixW(static_cast<size_t>(k) * n);
+    std::vector<int32_t>   targets(m);
+
+    auto randValue = [](float32_t range) {
+        auto unit = 2.0f * static_cast<float32_t>(rand()) / RAND_MAX - 1.0f;
+        return static_cast<float16_t>(range * unit);
+    };
+    std::generate(matrixX.begin(), matrixX.end(), [&]() { return randValue(0.5f); });
+    std::generate(matrixW.begin(), matrixW.end(), [&]() { return randValue(0.25f); });
+    std::generate(targets.begin(), targets.end(), [&]() { return rand() % n; });
+
+    std::vector<float32_t> loss(m);
+    std::vector<float32_t> gradX(m * k);
+    std::vector<float32_t> gradW(static_cast<size_t>(k) * n);
+    float32_t              meanLoss;
+
+    std::cout << "Initializing device data..." << std::endl;
+
+    // Allocate and copy device memory
+    float16_t* d_x;
+    float16_t* d_w;
+    int32_t*   d_targets;
+    float32_t* d_sliceMax;
+    float32_t* d_sliceSum;
+    float32_t* d_sliceTarget;
+    float32_t* d_lse;
+    float32_t* d_loss;
+    float32_t* d_meanLoss;
+    float32_t* d_dx;
+    float32_t* d_dw;
+
+    const size_t bytesX       = matrixX.size() * sizeof(float16_t);
+    const size_t bytesW       = matrixW.size() * sizeof(float16_t);
+    const size_t bytesTargets = targets.size() * sizeof(int32_t);
+    const size_t bytesStats   = slices * m * sizeof(float32_t);
+    const size_t bytesRows    = m * sizeof(float32_t);
+    const size_t bytesDX      = gradX.size() * sizeof(float32_t);
+    const size_t bytesDW      = gradW.size() * sizeof(float32_t);
+
+    CHECK_HIP_ERROR(hipMalloc(&d_x, bytesX));
+    CHECK_HIP_ERROR(hipMalloc(&d_w, bytesW));
+    CHECK_HIP_ERROR(hipMalloc(&d_targets, bytesTargets));
+    CHECK_HIP_ERROR(hipMalloc(&d_sliceMax, bytesStats));
+    CHECK_HIP_ERROR(hipMalloc(&d_sliceSum, bytesStats));
+    CHECK_HIP_ERROR(hipMalloc(&d_sliceTarget, bytesStats));
+    CHECK_HIP_ERROR(hipMalloc(&d_lse, bytesRows));
+    CHECK_HIP_ERROR(hipMalloc(&d_loss, bytesRows));
+    CHECK_HIP_ERROR(hipMalloc(&d_meanLoss, sizeof(float32_t)));
+    CHECK_HIP_ERROR(hipMalloc(&d_dx, bytesDX));
+    CHECK_HIP_ERROR(hipMalloc(&d_dw, bytesDW));
+
+    CHECK_HIP_ERROR(hipMemcpy(d_x, matrixX.data(), bytesX, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_w, matrixW.data(), bytesW, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_targets, targets.data(), bytesTargets, hipMemcpyHostToDevice));
+
+    hipEvent_t startEvent, midEvent, stopEvent;
+    CHECK_HIP_ERROR(hipEventCreate(&startEvent));
+    CHECK_HIP_ERROR(hipEventCreate(&midEvent));
+    CHECK_HIP_ERROR(hipEventCreate(&stopEvent));
+
+    std::cout << "Launching fused cross-entropy forward and backward kernels..." << std::endl;
+
+    // Loss total and gradients are accumulated
+    CHECK_HIP_ERROR(hipMemset(d_meanLoss, 0, sizeof(float32_t)));
+    CHECK_HIP_ERROR(hipMemset(d_dx, 0, bytesDX));
+    CHECK_HIP_ERROR(hipMemset(d_dw, 0, bytesDW));
+
+    auto blockDim = dim3(T_BLOCK_X, T_BLOCK_Y);
+    auto fwdDim   = dim3(rocwmma::ceilDiv(m, ROCWMMA_M), rocwmma::ceilDiv(slices, T_BLOCK_Y));
+    auto bwdDim   = dim3(m / (ROCWMMA_M * T_BLOCK_Y), slices);
+
+    CHECK_HIP_ERROR(hipEventRecord(startEvent));
+    hipLaunchKernelGGL(hgemm_xent_fwd_d,
+                       fwdDim,
+                       blockDim,
+                       0, // sharedMemBytes
+                       0, // stream
+                       m,
+                       n,
+                       k,
+                       d_x,
+                       d_w,
+                       d_targets,
+                       d_sliceMax,
+                       d_sliceSum,
+                       d_sliceTarget,
+                       ldx,
+                       ldw,
+                       scale);
+    hipLaunchKernelGGL(xent_merge_d,
+                       dim3(m),
+                       dim3(MERGE_THREADS),
+                       0, // sharedMemBytes
+                       0, // stream
+                       m,
+                       slices,
+                       d_sliceMax,
+                       d_sliceSum,
+                       d_sliceTarget,
+                       d_lse,
+                       d_loss,
+                       d_meanLoss,
+                       gradScale);
+    CHECK_HIP_ERROR(hipEventRecord(midEvent));
+    hipLaunchKernelGGL(hgemm_xent_bwd_d,
+                       bwdDim,
+                       blockDim,
+                       0, // sharedMemBytes
+                       0, // stream
+                       m,
+                       n,
+                       k,
+                       d_x,
+                       d_w,
+                       d_targets,
+                       d_lse,
+                       d_dx,
+                       d_dw,
+                       ldx,
+                       ldw,
+                       scale,
+                       gradScale);
+    CHECK_HIP_ERROR(hipEventRecord(stopEvent));
+    CHECK_HIP_ERROR(hipEventSynchronize(stopEvent));
+
+    auto fwdTimeMs = 0.0f;
+    auto bwdTimeMs = 0.0f;
+    CHECK_HIP_ERROR(hipEventElapsedTime(&fwdTimeMs, startEvent, midEvent));
+    CHECK_HIP_ERROR(hipEventElapsedTime(&bwdTimeMs, midEvent, stopEvent));
+
+    CHECK_HIP_ERROR(hipEventDestroy(startEvent));
+    CHECK_HIP_ERROR(hipEventDestroy(midEvent));
+    CHECK_HIP_ERROR(hipEventDestroy(stopEvent));
+
+    CHECK_HIP_ERROR(hipMemcpy(loss.data(), d_loss, bytesRows, hipMemcpyDeviceToHost));
+    CHECK_HIP_ERROR(hipMemcpy(&meanLoss, d_meanLoss, sizeof(float32_t), hipMemcpyDeviceToHost));
+    CHECK_HIP_ERROR(hipMemcpy(gradX.data(), d_dx, bytesDX, hipMemcpyDeviceToHost));
+    CHECK_HIP_ERROR(hipMemcpy(gradW.data(), d_dw, bytesDW, hipMemcpyDeviceToHost));
+
+    // Forward is one GEMM, backward recomputes the logits and computes dX and dW
+    auto gFlops          = calculateGFlops(m, n, k);
+    auto fwdTFlopsPerSec = gFlops / static_cast<double>(fwdTimeMs);
+    auto bwdTFlopsPerSec = 3.0 * gFlops / static_cast<double>(bwdTimeMs);
+
+    // Logits are never stored, nor their gradient
+    auto logitsMB = static_cast<double>(m) * n * sizeof(float32_t) / (1024.0 * 1024.0);
+
+    // Echo performance
+    std::cout << "BlkM, BlkN, BlkK, "
+              << "MatM, MatN, MatK, "
+              << "meanLoss, fwdMs, bwdMs, fwdTFlops/s, bwdTFlops/s, "
+              << "Logits not stored(MB)" << std::endl;
+
+    std::cout << ROCWMMA_M << ", " << ROCWMMA_N << ", " << ROCWMMA_K << ", " << m << ", " << n
+              << ", " << k << ", " << meanLoss << ", " << fwdTimeMs << ", " << bwdTimeMs << ", "
+              << fwdTFlopsPerSec << ", " << bwdTFlopsPerSec << ", " << logitsMB << std::endl;
+
+#if !NDEBUG
+
+    std::cout << "Validating result with reference..." << std::endl;
+
+    std::vector<float32_t> loss_ref(m);
+    std::vector<float32_t> gradX_ref(gradX.size());
+    std::vector<float32_t> gradW_ref(gradW.size());
+    xent_cpu_h(m,
+               n,
+               k,
+               matrixX,
+               matrixW,
+               targets,
+               loss_ref,
+               gradX_ref,
+               gradW_ref,
+               ldx,
+               ldw,
+               scale,
+               gradScale);
+
+    // Gradient elements away from the targets are tiny, so gradients are checked
+    // relative to the largest reference magnitude of each matrix.
+    auto normError = [](std::vector<float32_t> const& a, std::vector<float32_t> const& b) {
+        auto maxDiff = 0.0;
+        auto maxRef  = 0.0;
+        for(size_t i = 0; i < a.size(); ++i)
+        {
+            maxDiff = std::max(maxDiff, std::fabs(static_cast<double>(a[i]) - b[i]));
+            maxRef  = std::max(maxRef, std::fabs(static_cast<double>(b[i])));
+        }
+        return maxDiff / std::max(maxRef, 1e-30);
+    };
+
+    // Losses sum exponentials over the whole vocabulary in fp32
+    auto resLoss   = compareEqual<float32_t>(loss.data(), loss_ref.data(), m, 1000.0);
+    auto errGradX  = normError(gradX, gradX_ref);
+    auto errGradW  = normError(gradW, gradW_ref);
+    auto tolerance = 1e-2;
+
+    if(std::get<0>(resLoss) == false || errGradX > tolerance || errGradW > tolerance)
+    {
+        std::cout << "FAILED!\n";
+    }
+    else
+    {
+        std::cout << "PASSED!\n";
+    }
+
+    std::cout << "Max relative error: " << std::get<1>(resLoss) << " (loss), " << errGradX
+              << " (dX), " << errGradW << " (dW)" << std::endl;
+
+#endif // !NDEBUG
+
+    // Release device memory
+    CHECK_HIP_ERROR(hipFree(d_x));
+    CHECK_HIP_ERROR(hipFree(d_w));
+    CHECK_HIP_ERROR(hipFree(d_targets));
+    CHECK_HIP_ERROR(hipFree(d_sliceMax));
+    CHECK_HIP_ERROR(hipFree(d_sliceSum));
+    CHECK_HIP_ERROR(hipFree(d_sliceTarget));
+    CHECK_HIP_ERROR(hipFree(d_lse));
+    CHECK_HIP_ERROR(hipFree(d_loss));
+    CHECK_HIP_ERROR(hipFree(d_meanLoss));
+    CHECK_HIP_ERROR(hipFree(d_dx));
+    CHECK_HIP_ERROR(hipFree(d_dw));
+
+    std::cout << "Finished!" << std::endl;
+}
+
+int main()
+{
+    // Training micro-batches of 64 and 256 tokens, projecting to 151936 and 32000 token
+    // vocabularies
+    gemm_test(64, 151936, 1024);
+    gemm_test(256, 32000, 1024);
+    return 0;
+}
@@ -0,0 +1,433 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_runtime.h>
+
+#include <rocwmma/rocwmma.hpp>
+#include <rocwmma/rocwmma_epilogue.hpp>
+
+#include "common.hpp"
+
+using rocwmma::accumulator;
+using rocwmma::col_major;
+using rocwmma::float16_t;
+using rocwmma::float32_t;
+using rocwmma::matrix_a;
+using rocwmma::matrix_b;
+using rocwmma::row_major;
+
+// Supports ROCWMMA_M/N square sizes of
+// : 16 x 16
+// : 32 x 32 ( only MI )
+const int ROCWMMA_M = 16;
+const int ROCWMMA_N = 16;
+
+// ROCWMMA_K equals ROCWMMA_N, such that each K step of the second layer
+// reads one output block of the first layer
+const int ROCWMMA_K = 16;
+
+// Device warp size
+const uint32_t WAVE_SIZE = getWarpSize();
+
+// Thread block
+// : T_BLOCK_X must be multiple of WAVE_SIZE.
+// Note: Each wave will compute one BLOCK_M x BLOCK_N output block
+// Note: Workgroup will compute
+//  T_BLOCK_X / WAVE_SIZE x T_BLOCK_Y output blocks
+const int T_BLOCK_X = 4 * WAVE_SIZE;
+const int T_BLOCK_Y = 4;
+
+// Skipping of all-zero blocks of A in the second layer
+enum class ZeroSkip : uint32_t
+{
+    // Every block is loaded and multiplied
+    None,
+
+    // Blocks of A are loaded, then tested with a ballot before loading B
+    Ballot,
+
+    // The skip map of the first layer is read before loading A
+    SkipMap
+};
+
+// The following device kernels are a naive implementation of a two
+// layer ReLU MLP on blocked GEMMs. Each wave will compute one
+// BLOCK_M x BLOCK_N output block of each layer:
+// H = relu(X x W1)     (M x N)
+// D = H x W2           (M x P)
+//
+// ReLU zeros whole blocks of H. The first layer records a skip map
+// entry per output block, 1 if the block holds a non-zero element.
+// The second layer then skips the mma_sync of zero blocks of H, and
+// the loads of the matching blocks of W2.
+//
+// In this simplified example, we assume:
+// : X, H, D are in row-major format  (M x K, M x N, M x P)
+// : W1, W2 are in col-major format   (K x N, N x P)
+// : The skip map is row-major        (M / BLOCK_M x N / BLOCK_N)
+// : No LDS required
+//
+// Note: This is a simplified implementation to demonstrate API usage in
+// context of wave-level GEMM computation, and is not optimized.
+__global__ void hgemm_relu_d(uint32_t         m,
+                             uint32_t         n,
+                             uint32_t         k,
+                             float16_t const* x,
+                             float16_t const* w1,
+                             float16_t*       h,
+                             uint32_t*        skipMap,
+                             uint32_t         ldx,
+                             uint32_t         ldw1,
+                             uint32_t         ldh)
+{
+    // Create frags
+    auto fragA
+        = rocwmma::fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, row_major>();
+    auto fragB
+        = rocwmma::fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, col_major>();
+    auto fragH   = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t>();
+    auto fragAcc = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float32_t>();
+
+    rocwmma::fill_fragment(fragAcc, 0.0f);
+
+    // Tile using a 2D grid
+    auto majorWarp = (blockIdx.x * blockDim.x + threadIdx.x) / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    auto minorWarp = (blockIdx.y * blockDim.y + threadIdx.y);
+
+    // Target H block
+    auto cRow = majorWarp * ROCWMMA_M;
+    auto cCol = minorWarp * ROCWMMA_N;
+
+    // Bounds check
+    if(cRow < m && cCol < n)
+    {
+        for(int i = 0; i < k; i += ROCWMMA_K)
+        {
+            rocwmma::load_matrix_sync(fragA, x + (cRow * ldx + i), ldx);
+            rocwmma::load_matrix_sync(fragB, w1 + (i + cCol * ldw1), ldw1);
+            rocwmma::mma_sync(fragAcc, fragA, fragB, fragAcc);
+        }
+
+        // H = relu(X x W1), in float16_t
+        rocwmma::apply_epilogue(
+            fragH, fragAcc, rocwmma::epilogue::Activation<rocwmma::epilogue::Relu>());
+
+        rocwmma::store_matrix_sync(h + (cRow * ldh + cCol), fragH, ldh, rocwmma::mem_row_major);
+
+        // Record whether the block of H holds a non-zero element
+        auto blockCols = n / ROCWMMA_N;
+        rocwmma::store_nonzero_flag_sync(
+            skipMap + (cRow / ROCWMMA_M) * blockCols + cCol / ROCWMMA_N, fragH);
+    }
+}
+
+template <ZeroSkip Mode>
+__global__ void hgemm_zero_skip_d(uint32_t         m,
+                                  uint32_t         p,
+                                  uint32_t         n,
+                                  float16_t const* h,
+                                  float16_t const* w2,
+                                  float32_t*       d,
+                                  uint32_t const*  skipMap,
+                                  uint32_t         ldh,
+                                  uint32_t         ldw2,
+                                  uint32_t         ldd)
+{
+    // Create frags
+    auto fragA
+        = rocwmma::fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, row_major>();
+    auto fragB
+        = rocwmma::fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float16_t, col_major>();
+    auto fragAcc = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float32_t>();
+
+    rocwmma::fill_fragment(fragAcc, 0.0f);
+
+    // Tile using a 2D grid
+    auto majorWarp = (blockIdx.x * blockDim.x + threadIdx.x) / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    auto minorWarp = (blockIdx.y * blockDim.y + threadIdx.y);
+
+    // Target D block
+    auto cRow = majorWarp * ROCWMMA_M;
+    auto cCol = minorWarp * ROCWMMA_N;
+
+    // Bounds check
+    if(cRow < m && cCol < p)
+    {
+        // Skip map row of the H blocks along K
+        auto blockFlags = skipMap + (cRow / ROCWMMA_M) * (n / ROCWMMA_K);
+
+        for(int i = 0; i < n; i += ROCWMMA_K)
+        {
+            // Wave-uniform tests: the skipped iterations are scalar branches
+            if constexpr(Mode == ZeroSkip::SkipMap)
+            {
+                if(!rocwmma::load_nonzero_flag_sync(blockFlags + i / ROCWMMA_K))
+                {
+                    continue;
+                }
+            }
+
+            rocwmma::load_matrix_sync(fragA, h + (cRow * ldh + i), ldh);
+
+            if constexpr(Mode == ZeroSkip::Ballot)
+            {
+                if(rocwmma::is_zero_sync(fragA))
+                {
+                    continue;
+                }
+            }
+
+            rocwmma::load_matrix_sync(fragB, w2 + (i + cCol * ldw2), ldw2);
+            rocwmma::mma_sync(fragAcc, fragA, fragB, fragAcc);
+        }
+
+        // Store to D
+        rocwmma::store_matrix_sync(d + (cRow * ldd + cCol), fragAcc, ldd, rocwmma::mem_row_major);
+    }
+}
+
+__host__ void mlp_test(uint32_t m, uint32_t n, uint32_t k, uint32_t p)
+{
+    // Bounds check
+    if((m < (ROCWMMA_M * T_BLOCK_X / WAVE_SIZE) || n < (ROCWMMA_N * T_BLOCK_Y)
+        || p < (ROCWMMA_N * T_BLOCK_Y) || k < ROCWMMA_K)
+       || (m % ROCWMMA_M || n % ROCWMMA_N || p % ROCWMMA_N || k % ROCWMMA_K))
+    {
+        std::cout << "Unsupported size!\n";
+        return;
+    }
+
+    int ldx  = k;
+    int ldw1 = k;
+    int ldh  = n;
+    int ldw2 = n;
+    int ldd  = p;
+
+    auto blockRows = m / ROCWMMA_M;
+    auto blockCols = n / ROCWMMA_N;
+
+    std::cout << "Initializing host data..." << std::endl;
+
+    std::vector<float16_t> matrixX(m * k);
+    std::vector<float16_t> matrixW1(k * n);
+    std::vector<float16_t> matrixW2(n * p);
+    std::vector<float32_t> matrixD(m * p);
+
+    // Small integers keep all sums exact, such that every mode matches the reference.
+    // Every 4th row block of X is zero, and 3 of 4 column blocks of W1 are non-positive:
+    // the ReLU output is zero in most blocks of H.
+    auto gen     = std::mt19937(5489u);
+    auto uniform = std::uniform_int_distribution<int32_t>(0, 2);
+    for(uint32_t i = 0; i < m; i++)
+    {
+        for(uint32_t j = 0; j < k; j++)
+        {
+            auto value           = (i / ROCWMMA_M) % 4u == 3u ? 0 : uniform(gen);
+            matrixX[i * ldx + j] = static_cast<float16_t>(value);
+        }
+    }
+    for(uint32_t j = 0; j < n; j++)
+    {
+        for(uint32_t i = 0; i < k; i++)
+        {
+            auto value             = uniform(gen);
+            matrixW1[i + j * ldw1] = static_cast<float16_t>((j / ROCWMMA_N) % 4u ? -value : value);
+        }
+    }
+    for(auto& w : matrixW2)
+    {
+        w = static_cast<float16_t>(uniform(gen) - 1);
+    }
+
+    std::cout << "Initializing device data..." << std::endl;
+
+    // Allocate and copy device memory
+    float16_t* d_x;
+    float16_t* d_w1;
+    float16_t* d_h;
+    float16_t* d_w2;
+    float32_t* d_d;
+    uint32_t*  d_skipMap;
+
+    const size_t bytesX       = matrixX.size() * sizeof(float16_t);
+    const size_t bytesW1      = matrixW1.size() * sizeof(float16_t);
+    const size_t bytesH       = m * n * sizeof(float16_t);
+    const size_t bytesW2      = matrixW2.size() * sizeof(float16_t);
+    const size_t bytesD       = matrixD.size() * sizeof(float32_t);
+    const size_t bytesSkipMap = blockRows * blockCols * sizeof(uint32_t);
+
+    CHECK_HIP_ERROR(hipMalloc(&d_x, bytesX));
+    CHECK_HIP_ERROR(hipMalloc(&d_w1, bytesW1));
+    CHECK_HIP_ERROR(hipMalloc(&d_h, bytesH));
+    CHECK_HIP_ERROR(hipMalloc(&d_w2, bytesW2));
+    CHECK_HIP_ERROR(hipMalloc(&d_d, bytesD));
+    CHECK_HIP_ERROR(hipMalloc(&d_skipMap, bytesSkipMap));
+
+    CHECK_HIP_ERROR(hipMemcpy(d_x, matrixX.data(), bytesX, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_w1, matrixW1.data(), bytesW1, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_w2, matrixW2.data(), bytesW2, hipMemcpyHostToDevice));
+
+    auto blockDim = dim3(T_BLOCK_X, T_BLOCK_Y);
+
+    std::cout << "Launching first layer..." << std::endl;
+
+    auto gridDimH = dim3(rocwmma::ceilDiv(m, ROCWMMA_M * T_BLOCK_X / WAVE_SIZE),
+                         rocwmma::ceilDiv(n, ROCWMMA_N * T_BLOCK_Y));
+
+    hipLaunchKernelGGL(hgemm_relu_d,
+                       gridDimH,
+                       blockDim,
+                       0, // sharedMemBytes
+                       0, // stream
+                       m,
+                       n,
+                       k,
+                       d_x,
+                       d_w1,
+                       d_h,
+                       d_skipMap,
+                       ldx,
+                       ldw1,
+                       ldh);
+
+    std::vector<uint32_t> skipMap(blockRows * blockCols);
+    CHECK_HIP_ERROR(hipMemcpy(skipMap.data(), d_skipMap, bytesSkipMap, hipMemcpyDeviceToHost));
+
+    auto zeroBlocks = 0u;
+    for(auto flag : skipMap)
+    {
+        zeroBlocks += (flag == 0u);
+    }
+    std::cout << "Zero blocks of H: " << zeroBlocks << " / " << skipMap.size() << std::endl;
+
+    // Reference computation. The first layer is exact in float32_t, then rounded to
+    // float16_t as on the device.
+    std::vector<float32_t> matrixH32(m * n);
+    std::vector<float16_t> matrixH(m * n);
+    std::vector<float32_t> matrixD_ref(m * p);
+    gemm_cpu_h<float16_t, float32_t, float32_t, row_major, col_major, row_major>(m,
+                                                                                 n,
+                                                                                 k,
+                                                                                 matrixX.data(),
+                                                                                 matrixW1.data(),
+                                                                                 matrixH32.data(),
+                                                                                 matrixH32.data(),
+                                                                                 ldx,
+                                                                                 ldw1,
+                                                                                 ldh,
+                                                                                 ldh,
+                                                                                 1.0f,
+                                                                                 0.0f);
+    for(uint32_t i = 0; i < matrixH.size(); i++)
+    {
+        matrixH[i] = static_cast<float16_t>(std::max(matrixH32[i], 0.0f));
+    }
+    gemm_cpu_h<float16_t, float32_t, float32_t, row_major, col_major, row_major>(m,
+                                                                                 p,
+                                                                                 n,
+                                                                                 matrixH.data(),
+                                                                                 matrixW2.data(),
+                                                                                 matrixD_ref.data(),
+                                                                                 matrixD_ref.data(),
+                                                                                 ldh,
+                                                                                 ldw2,
+                                                                                 ldd,
+                                                                                 ldd,
+                                                                                 1.0f,
+                                                                                 0.0f);
+
+    auto gridDimD = dim3(rocwmma::ceilDiv(m, ROCWMMA_M * T_BLOCK_X / WAVE_SIZE),
+                         rocwmma::ceilDiv(p, ROCWMMA_N * T_BLOCK_Y));
+
+    std::cout << "ZeroSkip, MatM, MatP, MatN, elapsedMs, Dense TFlops/s, Result" << std::endl;
+
+    auto runMode = [&](auto kernel, char const* name) {
+        hipEvent_t startEvent, stopEvent;
+        CHECK_HIP_ERROR(hipEventCreate(&startEvent));
+        CHECK_HIP_ERROR(hipEventCreate(&stopEvent));
+
+        CHECK_HIP_ERROR(hipMemset(d_d, 0, bytesD));
+
+        hipExtLaunchKernelGGL(kernel,
+                              gridDimD,
+                              blockDim,
+                              0, // sharedMemBytes
+                              0, // stream
+                              startEvent, // Event start
+                              stopEvent, // event stop
+                              0, // flags
+                              m,
+                              p,
+                              n,
+                              d_h,
+                              d_w2,
+                              d_d,
+                              d_skipMap,
+                              ldh,
+                              ldw2,
+                              ldd);
+
+        auto elapsedTimeMs = 0.0f;
+        CHECK_HIP_ERROR(hipEventSynchronize(stopEvent));
+        CHECK_HIP_ERROR(hipEventElapsedTime(&elapsedTimeMs, startEvent, stopEvent));
+        CHECK_HIP_ERROR(hipEventDestroy(startEvent));
+        CHECK_HIP_ERROR(hipEventDestroy(stopEvent));
+
+        CHECK_HIP_ERROR(hipMemcpy(matrixD.data(), d_d, bytesD, hipMemcpyDeviceToHost));
+        auto passed = (matrixD == matrixD_ref);
+
+        // Throughput is reported for the dense problem, for comparison between modes
+        std::cout << name << ", " << m << ", " << p << ", " << n << ", " << elapsedTimeMs << ", "
+                  << calculateTFlopsPerSec(m, p, n, static_cast<double>(elapsedTimeMs)) << ", "
+                  << (passed ? "PASSED" : "FAILED") << std::endl;
+    };
+
+    runMode(hgemm_zero_skip_d<ZeroSkip::None>, "None");
+    runMode(hgemm_zero_skip_d<ZeroSkip::Ballot>, "Ballot");
+    runMode(hgemm_zero_skip_d<ZeroSkip::SkipMap>, "SkipMap");
+
+    // Release device memory
+    CHECK_HIP_ERROR(hipFree(d_x));
+    CHECK_HIP_ERROR(hipFree(d_w1));
+    CHECK_HIP_ERROR(hipFree(d_h));
+    CHECK_HIP_ERROR(hipFree(d_w2));
+    CHECK_HIP_ERROR(hipFree(d_d));
+    CHECK_HIP_ERROR(hipFree(d_skipMap));
+
+    std::cout << "Finished!" << std::endl;
+}
+
+int main()
+{
+    mlp_test(1024, 1024, 1024, 1024);
+    return 0;
+}
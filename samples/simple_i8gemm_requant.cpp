@@ -0,0 +1,445 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_runtime.h>
+
+#include <rocwmma/rocwmma.hpp>
+#include <rocwmma/rocwmma_epilogue.hpp>
+
+#include "common.hpp"
+
+using rocwmma::accumulator;
+using rocwmma::col_major;
+using rocwmma::float32_t;
+using rocwmma::matrix_a;
+using rocwmma::matrix_b;
+using rocwmma::row_major;
+
+// Supports ROCWMMA_M/N square sizes of
+// : 16 x 16
+// : 32 x 32 ( only MI )
+const int ROCWMMA_M = 16;
+const int ROCWMMA_N = 16;
+
+// Supports ROCWMMA_K sizes as
+// : multiples of 32 for int8_t on all targets (gfx940+ i8 MFMA is K = 32).
+const int ROCWMMA_K = 32;
+
+// Device warp size
+const uint32_t WAVE_SIZE = getWarpSize();
+
+// Thread block
+// : T_BLOCK_X must be multiple of WAVE_SIZE.
+// Note: Each wave will compute one BLOCK_M x BLOCK_N output block
+// Note: Workgroup will compute
+//  T_BLOCK_X / WAVE_SIZE x T_BLOCK_Y output blocks
+const int T_BLOCK_X = 4 * WAVE_SIZE;
+const int T_BLOCK_Y = 4;
+
+// The following device kernel is a naive implementation of a blocked, quantized
+// int8_t GEMM with a fused requantization epilogue. Each wave will compute one
+// BLOCK_M x BLOCK_N output block of the M x N x K GEMM, generalized as:
+// D = saturate(round(scale[col] * (A x B + bias[col])) + zeroPoint[col])
+//
+// Where:
+// : A x B accumulates exactly in int32_t
+// : bias is a per-output-channel int32_t vector        (N)
+// : scale is a per-output-channel float32_t vector     (N)
+// : zeroPoint is a per-output-channel int32_t vector   (N)
+//
+// The bias is added in int32_t, the scale is applied in float32_t with
+// round to nearest even, and the output is saturated to the int8_t range.
+// The int8_t output is packed 4 elements per register by apply_epilogue,
+// and D is written with 1/4 of the bytes of an int32_t output. Un-fused,
+// an int32_t D would be written and read again by a requantization kernel.
+//
+// In this simplified example, we assume:
+// : A is in row-major format        (M x K)
+// : B is in col-major format        (K x N)
+// : D is in row-major format        (M x N)
+// : No LDS required
+//
+// Note: This is a simplified implementation to demonstrate API usage in
+// context of wave-level GEMM computation, and is not optimized.
+template <bool Fused>
+__global__ void i8gemm_requant_rocwmma_d(uint32_t         m,
+                                         uint32_t         n,
+                                         uint32_t         k,
+                                         int8_t const*    a,
+                                         int8_t const*    b,
+                                         int32_t const*   bias,
+                                         float32_t const* scale,
+                                         int32_t const*   zeroPoint,
+                                         int8_t*          d,
+                                         int32_t*         d32,
+                                         uint32_t         lda,
+                                         uint32_t         ldb,
+                                         uint32_t         ldd)
+{
+    // Create frags
+    auto fragA = rocwmma::fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, int8_t, row_major>();
+    auto fragB = rocwmma::fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, int8_t, col_major>();
+    auto fragAcc = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, int32_t>();
+    auto fragD   = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, int8_t>();
+
+    // Per-channel vectors, broadcast to line up with fragAcc
+    auto fragBias  = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, int32_t>();
+    auto fragScale = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float32_t>();
+    auto fragZp    = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, int32_t>();
+
+    rocwmma::fill_fragment(fragAcc, 0);
+
+    // Tile using a 2D grid
+    auto majorWarp = (blockIdx.x * blockDim.x + threadIdx.x) / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    auto minorWarp = (blockIdx.y * blockDim.y + threadIdx.y);
+
+    // Target D block
+    auto cRow = majorWarp * ROCWMMA_M;
+    auto cCol = minorWarp * ROCWMMA_N;
+
+    // Bounds check
+    if(cRow < m && cCol < n)
+    {
+        // fragAcc = A x B
+        for(int i = 0; i < k; i += ROCWMMA_K)
+        {
+            // Load the inputs
+            rocwmma::load_matrix_sync(fragA, a + (cRow * lda + i), lda);
+            rocwmma::load_matrix_sync(fragB, b + (i + cCol * ldb), ldb);
+
+            // Matrix multiply - accumulate using MFMA units
+            rocwmma::mma_sync(fragAcc, fragA, fragB, fragAcc);
+        }
+
+        if constexpr(Fused)
+        {
+            // Fetch epilogue inputs
+            rocwmma::load_row_vector_sync(fragBias, bias + cCol);
+            rocwmma::load_row_vector_sync(fragScale, scale + cCol);
+            rocwmma::load_row_vector_sync(fragZp, zeroPoint + cCol);
+
+            // D = saturate(round(scale * (A x B + bias)) + zeroPoint)
+            rocwmma::apply_epilogue(fragD,
+                                    fragAcc,
+                                    rocwmma::epilogue::BiasAdd(fragBias),
+                                    rocwmma::epilogue::Requantize(fragScale, fragZp));
+
+            // Store to D
+            rocwmma::store_matrix_sync(d + (cRow * ldd + cCol), fragD, ldd, rocwmma::mem_row_major);
+        }
+        else
+        {
+            // Store the int32_t accumulator for a separate requantization pass
+            rocwmma::store_matrix_sync(
+                d32 + (cRow * ldd + cCol), fragAcc, ldd, rocwmma::mem_row_major);
+        }
+    }
+}
+
+// Un-fused requantization pass over the int32_t GEMM output
+__global__ void requant_d(uint32_t         m,
+                          uint32_t         n,
+                          int32_t const*   d32,
+                          int32_t const*   bias,
+                          float32_t const* scale,
+                          int32_t const*   zeroPoint,
+                          int8_t*          d,
+                          uint32_t         ldd)
+{
+    auto col = blockIdx.x * blockDim.x + threadIdx.x;
+    auto row = blockIdx.y;
+
+    if(col < n && row < m)
+    {
+        auto idx = row * ldd + col;
+        auto q   = rintf(static_cast<float32_t>(d32[idx] + bias[col]) * scale[col])
+                 + static_cast<float32_t>(zeroPoint[col]);
+        d[idx]   = static_cast<int8_t>(fminf(fmaxf(q, -128.0f), 127.0f));
+    }
+}
+
+// Host reference of the requantization epilogue
+__host__ void requant_cpu_h(uint32_t         m,
+                            uint32_t         n,
+                            int32_t const*   gemmOut,
+                            int32_t const*   bias,
+                            float32_t const* scale,
+                            int32_t const*   zeroPoint,
+                            int8_t*          d,
+                            uint32_t         ld)
+{
+#pragma omp parallel for
+    for(int i = 0; i < m; ++i)
+    {
+        for(int j = 0; j < n; ++j)
+        {
+            auto idx = i * ld + j;
+
+            // std::nearbyint rounds to nearest even in the default rounding mode
+            auto q = std::nearbyint(static_cast<float32_t>(gemmOut[idx] + bias[j]) * scale[j])
+                     + static_cast<float32_t>(zeroPoint[j]);
+            d[idx] = static_cast<int8_t>(std::min(std::max(q, -128.0f), 127.0f));
+        }
+    }
+}
+
+__host__ void gemm_test(uint32_t m, uint32_t n, uint32_t k)
+{
+    // Bounds check
+    if((m < (ROCWMMA_M * T_BLOCK_X / WAVE_SIZE) || n < (ROCWMMA_N * T_BLOCK_Y) || k < ROCWMMA_K)
+       || (m % ROCWMMA_M || n % ROCWMMA_N || k % ROCWMMA_K))
+    {
+        std::cout << "Unsupported size!\n";
+        return;
+    }
+
+    int lda = k;
+    int ldb = k;
+    int ldd = n;
+
+    std::cout << "Initializing host data..." << std::endl;
+
+    // Initialize input matrices
+    std::vector<int8_t>    matrixA(m * k);
+    std::vector<int8_t>    matrixB(k * n);
+    std::vector<int32_t>   vectorBias(n);
+    std::vector<float32_t> vectorScale(n);
+    std::vector<int32_t>   vectorZp(n);
+    std::vector<int8_t>    matrixD(m * n);
+    std::vector<int8_t>    matrixDUnfused(m * n);
+
+    fillRand(matrixA.data(), m, k);
+    fillRand(matrixB.data(), k, n);
+    fillRand(vectorBias.data(), 1, n);
+
+    // Per-channel scales and zero points, such that some outputs saturate
+    for(int j = 0; j < n; ++j)
+    {
+        vectorScale[j] = 0.01f + 0.19f * static_cast<float32_t>(rand()) / RAND_MAX;
+        vectorZp[j]    = static_cast<int32_t>(rand() % 17) - 8;
+    }
+
+    std::cout << "Initializing device data..." << std::endl;
+
+    // Allocate and copy device memory
+    int8_t*    d_a;
+    int8_t*    d_b;
+    int32_t*   d_bias;
+    float32_t* d_scale;
+    int32_t*   d_zp;
+    int8_t*    d_d;
+    int32_t*   d_d32;
+
+    const size_t bytesA     = matrixA.size() * sizeof(int8_t);
+    const size_t bytesB     = matrixB.size() * sizeof(int8_t);
+    const size_t bytesBias  = vectorBias.size() * sizeof(int32_t);
+    const size_t bytesScale = vectorScale.size() * sizeof(float32_t);
+    const size_t bytesZp    = vectorZp.size() * sizeof(int32_t);
+    const size_t bytesD     = matrixD.size() * sizeof(int8_t);
+    const size_t bytesD32   = matrixD.size() * sizeof(int32_t);
+
+    CHECK_HIP_ERROR(hipMalloc(&d_a, bytesA));
+    CHECK_HIP_ERROR(hipMalloc(&d_b, bytesB));
+    CHECK_HIP_ERROR(hipMalloc(&d_bias, bytesBias));
+    CHECK_HIP_ERROR(hipMalloc(&d_scale, bytesScale));
+    CHECK_HIP_ERROR(hipMalloc(&d_zp, bytesZp));
+    CHECK_HIP_ERROR(hipMalloc(&d_d, bytesD));
+    CHECK_HIP_ERROR(hipMalloc(&d_d32, bytesD32));
+
+    CHECK_HIP_ERROR(hipMemcpy(d_a, matrixA.data(), bytesA, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_b, matrixB.data(), bytesB, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_bias, vectorBias.data(), bytesBias, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_scale, vectorScale.data(), bytesScale, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_zp, vectorZp.data(), bytesZp, hipMemcpyHostToDevice));
+
+    auto blockDim = dim3(T_BLOCK_X, T_BLOCK_Y);
+    auto gridDim  = dim3(rocwmma::ceilDiv(m, ROCWMMA_M * T_BLOCK_X / WAVE_SIZE),
+                        rocwmma::ceilDiv(n, ROCWMMA_N * T_BLOCK_Y));
+
+    hipEvent_t startEvent, stopEvent;
+    CHECK_HIP_ERROR(hipEventCreate(&startEvent));
+    CHECK_HIP_ERROR(hipEventCreate(&stopEvent));
+
+    std::cout << "Launching fused GEMM kernel..." << std::endl;
+
+    auto fusedTimeMs = 0.0f;
+    hipExtLaunchKernelGGL(i8gemm_requant_rocwmma_d<true>,
+                          gridDim,
+                          blockDim,
+                          0, // sharedMemBytes
+                          0, // stream
+                          startEvent, // Event start
+                          stopEvent, // event stop
+                          0, // flags
+                          m,
+                          n,
+                          k,
+                          d_a,
+                          d_b,
+                          d_bias,
+                          d_scale,
+                          d_zp,
+                          d_d,
+                          d_d32,
+                          lda,
+                          ldb,
+                          ldd);
+    CHECK_HIP_ERROR(hipEventSynchronize(stopEvent));
+    CHECK_HIP_ERROR(hipEventElapsedTime(&fusedTimeMs, startEvent, stopEvent));
+    CHECK_HIP_ERROR(hipMemcpy(matrixD.data(), d_d, bytesD, hipMemcpyDeviceToHost));
+
+    std::cout << "Launching un-fused GEMM and requantization kernels..." << std::endl;
+
+    auto unfusedTimeMs = 0.0f;
+    CHECK_HIP_ERROR(hipMemset(d_d, 0, bytesD));
+    CHECK_HIP_ERROR(hipEventRecord(startEvent));
+    hipLaunchKernelGGL(i8gemm_requant_rocwmma_d<false>,
+                       gridDim,
+                       blockDim,
+                       0, // sharedMemBytes
+                       0, // stream
+                       m,
+                       n,
+                       k,
+                       d_a,
+                       d_b,
+                       d_bias,
+                       d_scale,
+                       d_zp,
+                       d_d,
+                       d_d32,
+                       lda,
+                       ldb,
+                       ldd);
+    hipLaunchKernelGGL(requant_d,
+                       dim3(rocwmma::ceilDiv(n, 256u), m),
+                       dim3(256u),
+                       0, // sharedMemBytes
+                       0, // stream
+                       m,
+                       n,
+                       d_d32,
+                       d_bias,
+                       d_scale,
+                       d_zp,
+                       d_d,
+                       ldd);
+    CHECK_HIP_ERROR(hipEventRecord(stopEvent));
+    CHECK_HIP_ERROR(hipEventSynchronize(stopEvent));
+    CHECK_HIP_ERROR(hipEventElapsedTime(&unfusedTimeMs, startEvent, stopEvent));
+    CHECK_HIP_ERROR(hipMemcpy(matrixDUnfused.data(), d_d, bytesD, hipMemcpyDeviceToHost));
+
+    CHECK_HIP_ERROR(hipEventDestroy(startEvent));
+    CHECK_HIP_ERROR(hipEventDestroy(stopEvent));
+
+    // GEMM ops converge to 2*mnk
+    auto gOps       = calculateGFlops(m, n, k);
+    auto tOpsPerSec = gOps / static_cast<double>(fusedTimeMs);
+
+    // Echo performance
+    std::cout << "BlkM, BlkN, BlkK, "
+              << "MatM, MatN, MatK, "
+              << "lda, ldb, ldd, "
+              << "fusedMs, unfusedMs, "
+              << "fusedOutBytes, unfusedOutBytes, "
+              << "Problem Size(GOps), TOps/s" << std::endl;
+
+    std::cout << ROCWMMA_M << ", " << ROCWMMA_N << ", " << ROCWMMA_K << ", " << m << ", " << n
+              << ", " << k << ", " << lda << ", " << ldb << ", " << ldd << ", " << fusedTimeMs
+              << ", " << unfusedTimeMs << ", " << bytesD << ", " << (2u * bytesD32 + bytesD)
+              << ", " << gOps << ", " << tOpsPerSec << std::endl;
+
+#if !NDEBUG
+
+    std::cout << "Validating result with reference..." << std::endl;
+
+    // Setup and run reference computation.
+    // The GEMM result is exact in int32_t, as on the device.
+    std::vector<int32_t> matrixC_ref(m * n, 0);
+    std::vector<int32_t> matrixGemm_ref(m * n);
+    std::vector<int8_t>  matrixD_ref(m * n);
+    gemm_cpu_h<int8_t, int32_t, int32_t, row_major, col_major, row_major>(m,
+                                                                          n,
+                                                                          k,
+                                                                          matrixA.data(),
+                                                                          matrixB.data(),
+                                                                          matrixC_ref.data(),
+                                                                          matrixGemm_ref.data(),
+                                                                          lda,
+                                                                          ldb,
+                                                                          ldd,
+                                                                          ldd,
+                                                                          1,
+                                                                          0);
+    requant_cpu_h(m,
+                  n,
+                  matrixGemm_ref.data(),
+                  vectorBias.data(),
+                  vectorScale.data(),
+                  vectorZp.data(),
+                  matrixD_ref.data(),
+                  ldd);
+
+    // Requantized outputs are exact: int8_t epsilon is 0
+    auto res        = compareEqual<int8_t>(matrixD.data(), matrixD_ref.data(), m * n);
+    auto resUnfused = compareEqual<int8_t>(matrixDUnfused.data(), matrixD_ref.data(), m * n);
+
+    if(std::get<0>(res) == false || std::get<0>(resUnfused) == false)
+    {
+        std::cout << "FAILED!\n";
+    }
+    else
+    {
+        std::cout << "PASSED!\n";
+    }
+
+    std::cout << "Max relative error: " << std::get<1>(res) << std::endl;
+
+#endif // !NDEBUG
+
+    // Release device memory
+    CHECK_HIP_ERROR(hipFree(d_a));
+    CHECK_HIP_ERROR(hipFree(d_b));
+    CHECK_HIP_ERROR(hipFree(d_bias));
+    CHECK_HIP_ERROR(hipFree(d_scale));
+    CHECK_HIP_ERROR(hipFree(d_zp));
+    CHECK_HIP_ERROR(hipFree(d_d));
+    CHECK_HIP_ERROR(hipFree(d_d32));
+
+    std::cout << "Finished!" << std::endl;
+}
+
+int main()
+{
+    gemm_test(1024, 1024, 1024);
+    return 0;
+}
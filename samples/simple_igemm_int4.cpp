@@ -0,0 +1,276 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_runtime.h>
+
+#include <rocwmma/rocwmma.hpp>
+
+#include "common.hpp"
+
+using rocwmma::accumulator;
+using rocwmma::col_major;
+using rocwmma::int4x2_t;
+using rocwmma::matrix_a;
+using rocwmma::matrix_b;
+using rocwmma::row_major;
+
+// Supports ROCWMMA_M/N square sizes of
+// : 16 x 16
+const int ROCWMMA_M = 16;
+const int ROCWMMA_N = 16;
+
+// Supports ROCWMMA_K sizes as
+// : multiples of 32 (iu4 WMMA on gfx12 is K = 32).
+const int ROCWMMA_K = 32;
+
+// Device warp size
+const uint32_t WAVE_SIZE = getWarpSize();
+
+// Thread block
+// : T_BLOCK_X must be multiple of WAVE_SIZE.
+// Note: Each wave will compute one BLOCK_M x BLOCK_N output block
+// Note: Workgroup will compute
+//  T_BLOCK_X / WAVE_SIZE x T_BLOCK_Y output blocks
+const int T_BLOCK_X = 4 * WAVE_SIZE;
+const int T_BLOCK_Y = 4;
+
+// The following device kernel is a naive implementation
+// of blocked GEMM on quantized 4-bit integers, with int32_t outputs.
+// Each wave will compute one BLOCK_M x BLOCK_N output block of the
+// M x N x K GEMM, generalized as:
+// D = A x B
+//
+// A holds unsigned 4-bit activations, one per int8_t, and B holds signed
+// 4-bit weights packed two per byte. Both are held in int8_t fragments:
+// : Int4 = true accumulates with mma_sync_iu4, packing the fragments to nibbles
+// : Int4 = false accumulates with int8_t mma_sync
+//
+// In this simplified example, we assume:
+// : A is in row-major format     (M x K)
+// : B is in col-major format     (K x N)
+// : D is in row-major format     (M x N)
+// : No LDS required
+//
+// Note: This is a simplified implementation to demonstrate API usage in
+// context of wave-level GEMM computation, and is not optimized.
+template <bool Int4>
+__global__ void igemm_int4_d(uint32_t        m,
+                             uint32_t        n,
+                             uint32_t        k,
+                             int8_t const*   a,
+                             int4x2_t const* b,
+                             int32_t*        d,
+                             uint32_t        lda,
+                             uint32_t        ldb,
+                             uint32_t        ldd)
+{
+    using FragA = rocwmma::fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, int8_t, row_major>;
+    using FragB = rocwmma::fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, int8_t, col_major>;
+    using FragD = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, int32_t>;
+
+    // Create frags
+    auto fragA = FragA();
+    auto fragB = FragB();
+    auto fragD = FragD();
+
+    rocwmma::fill_fragment(fragD, 0);
+
+    // Tile using a 2D grid
+    auto majorWarp = (blockIdx.x * blockDim.x + threadIdx.x) / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    auto minorWarp = (blockIdx.y * blockDim.y + threadIdx.y);
+
+    // Target D block
+    auto cRow = majorWarp * ROCWMMA_M;
+    auto cCol = minorWarp * ROCWMMA_N;
+
+    // Bounds check
+    if(cRow < m && cCol < n)
+    {
+        for(int i = 0; i < k; i += ROCWMMA_K)
+        {
+            // B holds two elements per byte: the origin offset is halved
+            rocwmma::load_matrix_sync(fragA, a + (cRow * lda + i), lda);
+            rocwmma::load_matrix_dequant_sync(fragB, b + (i + cCol * ldb) / 2, ldb);
+
+            if constexpr(Int4)
+            {
+                // Unsigned A, signed B
+                rocwmma::mma_sync_iu4<false, true>(fragD, fragA, fragB, fragD);
+            }
+            else
+            {
+                rocwmma::mma_sync(fragD, fragA, fragB, fragD);
+            }
+        }
+
+        // Store to D
+        rocwmma::store_matrix_sync(d + (cRow * ldd + cCol), fragD, ldd, rocwmma::mem_row_major);
+    }
+}
+
+__host__ void gemm_test(uint32_t m, uint32_t n, uint32_t k)
+{
+    // Bounds check
+    if((m < (ROCWMMA_M * T_BLOCK_X / WAVE_SIZE) || n < (ROCWMMA_N * T_BLOCK_Y) || k < ROCWMMA_K)
+       || (m % ROCWMMA_M || n % ROCWMMA_N || k % ROCWMMA_K))
+    {
+        std::cout << "Unsupported size!\n";
+        return;
+    }
+
+    int lda = k;
+    int ldb = k;
+    int ldd = n;
+
+    std::cout << "Initializing host data..." << std::endl;
+
+    // Unsigned activations in [0, 15] and signed weights in [-8, 7]
+    std::vector<int8_t>   matrixA(m * k);
+    std::vector<int8_t>   matrixB(k * n);
+    std::vector<int4x2_t> matrixBPacked(k * n / 2);
+    std::vector<int32_t>  matrixD(m * n);
+
+    auto gen      = std::mt19937(5489u);
+    auto uniformA = std::uniform_int_distribution<int32_t>(0, 15);
+    auto uniformB = std::uniform_int_distribution<int32_t>(-8, 7);
+    for(auto& a : matrixA)
+    {
+        a = static_cast<int8_t>(uniformA(gen));
+    }
+    for(auto& b : matrixB)
+    {
+        b = static_cast<int8_t>(uniformB(gen));
+    }
+
+    // Pack B two per byte, the lower element index in the low nibble
+    for(uint32_t i = 0; i < matrixBPacked.size(); i++)
+    {
+        matrixBPacked[i].data = static_cast<uint8_t>((matrixB[2 * i] & 0xF)
+                                                     | ((matrixB[2 * i + 1] & 0xF) << 4));
+    }
+
+    std::cout << "Initializing device data..." << std::endl;
+
+    // Allocate and copy device memory
+    int8_t*   d_a;
+    int4x2_t* d_b;
+    int32_t*  d_d;
+
+    const size_t bytesA = matrixA.size() * sizeof(int8_t);
+    const size_t bytesB = matrixBPacked.size() * sizeof(int4x2_t);
+    const size_t bytesD = matrixD.size() * sizeof(int32_t);
+
+    CHECK_HIP_ERROR(hipMalloc(&d_a, bytesA));
+    CHECK_HIP_ERROR(hipMalloc(&d_b, bytesB));
+    CHECK_HIP_ERROR(hipMalloc(&d_d, bytesD));
+
+    CHECK_HIP_ERROR(hipMemcpy(d_a, matrixA.data(), bytesA, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_b, matrixBPacked.data(), bytesB, hipMemcpyHostToDevice));
+
+    // Reference computation on the unpacked B. Integer results are exact.
+    std::vector<int32_t> matrixD_ref(m * n);
+    gemm_cpu_h<int8_t, int32_t, int32_t, row_major, col_major, row_major>(m,
+                                                                           n,
+                                                                           k,
+                                                                           matrixA.data(),
+                                                                           matrixB.data(),
+                                                                           matrixD_ref.data(),
+                                                                           matrixD_ref.data(),
+                                                                           lda,
+                                                                           ldb,
+                                                                           ldd,
+                                                                           ldd,
+                                                                           1,
+                                                                           0);
+
+    auto blockDim = dim3(T_BLOCK_X, T_BLOCK_Y);
+    auto gridDim  = dim3(rocwmma::ceilDiv(m, ROCWMMA_M * T_BLOCK_X / WAVE_SIZE),
+                        rocwmma::ceilDiv(n, ROCWMMA_N * T_BLOCK_Y));
+
+    std::cout << "MMA, MatM, MatN, MatK, elapsedMs, TOps/s, Result" << std::endl;
+
+    auto runMode = [&](auto kernel, char const* name) {
+        hipEvent_t startEvent, stopEvent;
+        CHECK_HIP_ERROR(hipEventCreate(&startEvent));
+        CHECK_HIP_ERROR(hipEventCreate(&stopEvent));
+
+        hipExtLaunchKernelGGL(kernel,
+                              gridDim,
+                              blockDim,
+                              0, // sharedMemBytes
+                              0, // stream
+                              startEvent, // Event start
+                              stopEvent, // event stop
+                              0, // flags
+                              m,
+                              n,
+                              k,
+                              d_a,
+                              d_b,
+                              d_d,
+                              lda,
+                              ldb,
+                              ldd);
+
+        auto elapsedTimeMs = 0.0f;
+        CHECK_HIP_ERROR(hipEventSynchronize(stopEvent));
+        CHECK_HIP_ERROR(hipEventElapsedTime(&elapsedTimeMs, startEvent, stopEvent));
+        CHECK_HIP_ERROR(hipEventDestroy(startEvent));
+        CHECK_HIP_ERROR(hipEventDestroy(stopEvent));
+
+        CHECK_HIP_ERROR(hipMemcpy(matrixD.data(), d_d, bytesD, hipMemcpyDeviceToHost));
+        auto passed = (matrixD == matrixD_ref);
+
+        std::cout << name << ", " << m << ", " << n << ", " << k << ", " << elapsedTimeMs << ", "
+                  << calculateTFlopsPerSec(m, n, k, static_cast<double>(elapsedTimeMs)) << ", "
+                  << (passed ? "PASSED" : "FAILED") << std::endl;
+    };
+
+    runMode(igemm_int4_d<false>, "int8");
+    runMode(igemm_int4_d<true>, "iu4");
+
+    // Release device memory
+    CHECK_HIP_ERROR(hipFree(d_a));
+    CHECK_HIP_ERROR(hipFree(d_b));
+    CHECK_HIP_ERROR(hipFree(d_d));
+
+    std::cout << "Finished!" << std::endl;
+}
+
+int main()
+{
+    if(!(isGfx11() || isGfx12()))
+    {
+        std::cout << "iu4 WMMA requires gfx11 or gfx12. Results use int8_t mma_sync.\n";
+    }
+
+    gemm_test(1024, 1024, 4096);
+    return 0;
+}
@@ -0,0 +1,376 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <iostream>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_fp16.h>
+#include <hip/hip_runtime.h>
+
+#include <rocwmma/rocwmma.hpp>
+#include <rocwmma/rocwmma_multiblock.hpp>
+
+#include "common.hpp"
+
+using rocwmma::accumulator;
+using rocwmma::batched_4x4;
+using rocwmma::col_major;
+using rocwmma::float16_t;
+using rocwmma::float32_t;
+using rocwmma::matrix_a;
+using rocwmma::matrix_b;
+using rocwmma::panel_64x4;
+using rocwmma::row_major;
+
+// Batched problems are 4 x 4 x K, 16 per wave.
+// Panels are 64 x 4 x K, one per wave.
+// Each mma_sync chains ROCWMMA_K / 4 of the 4 x 4 x 4 mfma.
+const int BATCH_M   = 4;
+const int PANEL_M   = 64;
+const int ROCWMMA_N = 4;
+const int ROCWMMA_K = 16;
+
+// Problems of each wave of the batched kernel
+const int BATCH_PER_WAVE = 16;
+
+// Device warp size
+const uint32_t WAVE_SIZE = getWarpSize();
+
+// Thread block
+// : T_BLOCK_X must be multiple of WAVE_SIZE.
+const int T_BLOCK_X = 4 * WAVE_SIZE;
+
+// The following device kernel computes a batch of tiny GEMMs
+// D[i] = alpha * (A[i] x B[i]) + beta * C[i], with 16 problems per wave.
+// In this simplified example, we assume:
+// : A[i] is in row-major format     (4 x K), A[i + 1] at 4 * K elements from A[i]
+// : B[i] is in col-major format     (K x 4), B[i + 1] at 4 * K elements from B[i]
+// : C[i], D[i] are in row-major format (4 x 4), at 16 elements from each other
+// : batchCount is a multiple of 16
+//
+// With the 16 x 16 blocks of rocwmma.hpp, each problem would pad out a 16 x 16 block,
+// leaving 15 / 16 of the mfma idle.
+__global__ void batched_gemm_4x4_d(uint32_t         batchCount,
+                                   uint32_t         k,
+                                   float16_t const* a,
+                                   float16_t const* b,
+                                   float32_t const* c,
+                                   float32_t*       d,
+                                   float32_t        alpha,
+                                   float32_t        beta)
+{
+    // Create frags
+    auto fragA
+        = rocwmma::fragment<matrix_a, BATCH_M, ROCWMMA_N, ROCWMMA_K, float16_t, batched_4x4>();
+    auto fragB
+        = rocwmma::fragment<matrix_b, BATCH_M, ROCWMMA_N, ROCWMMA_K, float16_t, batched_4x4>();
+    auto fragC
+        = rocwmma::fragment<accumulator, BATCH_M, ROCWMMA_N, ROCWMMA_K, float32_t, batched_4x4>();
+    auto fragAcc
+        = rocwmma::fragment<accumulator, BATCH_M, ROCWMMA_N, ROCWMMA_K, float32_t, batched_4x4>();
+
+    rocwmma::fill_fragment(fragAcc, 0.0f);
+
+    // First problem of the wave
+    auto wave  = (blockIdx.x * blockDim.x + threadIdx.x) / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    auto batch = wave * BATCH_PER_WAVE;
+
+    // Bounds check
+    if(batch < batchCount)
+    {
+        auto strideAB = BATCH_M * k;
+        auto strideCD = BATCH_M * ROCWMMA_N;
+
+        // fragAcc = A x B
+        for(int i = 0; i < k; i += ROCWMMA_K)
+        {
+            rocwmma::load_matrix_sync(
+                fragA, a + (batch * strideAB + i), k, rocwmma::mem_row_major, strideAB);
+            rocwmma::load_matrix_sync(
+                fragB, b + (batch * strideAB + i), k, rocwmma::mem_col_major, strideAB);
+
+            // 16 problems at once
+            rocwmma::mma_sync(fragAcc, fragA, fragB, fragAcc);
+        }
+
+        // Fetch C matrices
+        rocwmma::load_matrix_sync(
+            fragC, c + batch * strideCD, ROCWMMA_N, rocwmma::mem_row_major, strideCD);
+
+        // D = alpha * A x B + beta * C
+        for(int i = 0; i < fragC.num_elements; ++i)
+        {
+            fragC.x[i] = alpha * fragAcc.x[i] + beta * fragC.x[i];
+        }
+
+        // Store to D
+        rocwmma::store_matrix_sync(
+            d + batch * strideCD, fragC, ROCWMMA_N, rocwmma::mem_row_major, strideCD);
+    }
+}
+
+// The following device kernel computes a tall and skinny GEMM
+// D = alpha * (A x B) + beta * C, with one 64 x 4 panel of D per wave.
+// In this simplified example, we assume:
+// : A is in row-major format     (M x K)
+// : B is in col-major format     (K x 4)
+// : C, D are in row-major format (M x 4)
+// : M is a multiple of 64
+//
+// The 4 columns of B are broadcast to the 16 blocks of the mfma, which each
+// compute 4 rows of the panel.
+__global__ void panel_gemm_64x4_d(uint32_t         m,
+                                  uint32_t         k,
+                                  float16_t const* a,
+                                  float16_t const* b,
+                                  float32_t const* c,
+                                  float32_t*       d,
+                                  float32_t        alpha,
+                                  float32_t        beta)
+{
+    // Create frags
+    auto fragA
+        = rocwmma::fragment<matrix_a, PANEL_M, ROCWMMA_N, ROCWMMA_K, float16_t, panel_64x4>();
+    auto fragB
+        = rocwmma::fragment<matrix_b, PANEL_M, ROCWMMA_N, ROCWMMA_K, float16_t, panel_64x4>();
+    auto fragC
+        = rocwmma::fragment<accumulator, PANEL_M, ROCWMMA_N, ROCWMMA_K, float32_t, panel_64x4>();
+    auto fragAcc
+        = rocwmma::fragment<accumulator, PANEL_M, ROCWMMA_N, ROCWMMA_K, float32_t, panel_64x4>();
+
+    rocwmma::fill_fragment(fragAcc, 0.0f);
+
+    // Target D panel
+    auto wave = (blockIdx.x * blockDim.x + threadIdx.x) / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    auto cRow = wave * PANEL_M;
+
+    // Bounds check
+    if(cRow < m)
+    {
+        // fragAcc = A x B
+        for(int i = 0; i < k; i += ROCWMMA_K)
+        {
+            rocwmma::load_matrix_sync(fragA, a + (cRow * k + i), k, rocwmma::mem_row_major);
+            rocwmma::load_matrix_sync(fragB, b + i, k, rocwmma::mem_col_major);
+
+            rocwmma::mma_sync(fragAcc, fragA, fragB, fragAcc);
+        }
+
+        // Fetch C matrix
+        rocwmma::load_matrix_sync(fragC, c + cRow * ROCWMMA_N, ROCWMMA_N, rocwmma::mem_row_major);
+
+        // D = alpha * A x B + beta * C
+        for(int i = 0; i < fragC.num_elements; ++i)
+        {
+            fragC.x[i] = alpha * fragAcc.x[i] + beta * fragC.x[i];
+        }
+
+        // Store to D
+        rocwmma::store_matrix_sync(d + cRow * ROCWMMA_N, fragC, ROCWMMA_N, rocwmma::mem_row_major);
+    }
+}
+
+// Launches the kernel over the given number of waves, returning the elapsed time in ms
+template <typename KernelT, typename... ArgsT>
+__host__ float32_t launch(KernelT kernel, uint32_t waveCount, ArgsT... args)
+{
+    auto blockDim = dim3(T_BLOCK_X);
+    auto gridDim  = dim3(rocwmma::ceilDiv(waveCount, T_BLOCK_X / WAVE_SIZE));
+
+    hipEvent_t startEvent, stopEvent;
+    CHECK_HIP_ERROR(hipEventCreate(&startEvent));
+    CHECK_HIP_ERROR(hipEventCreate(&stopEvent));
+
+    hipExtLaunchKernelGGL(kernel,
+                          gridDim,
+                          blockDim,
+                          0, // sharedMemBytes
+                          0, // stream
+                          startEvent, // Event start
+                          stopEvent, // event stop
+                          0, // flags
+                          args...);
+
+    auto elapsedTimeMs = 0.0f;
+    CHECK_HIP_ERROR(hipEventSynchronize(stopEvent));
+    CHECK_HIP_ERROR(hipEventElapsedTime(&elapsedTimeMs, startEvent, stopEvent));
+    CHECK_HIP_ERROR(hipEventDestroy(startEvent));
+    CHECK_HIP_ERROR(hipEventDestroy(stopEvent));
+
+    return elapsedTimeMs;
+}
+
+// Runs D = alpha * (A x B) + beta * C for batchCount problems of rows x 4 x k,
+// on the batched kernel for 4 rows and on the panel kernel for one panel of rows.
+__host__ void
+    multiblock_test(uint32_t rows, uint32_t k, uint32_t batchCount, float32_t alpha, float32_t beta)
+{
+    bool isBatched = (rows == BATCH_M);
+
+    // Bounds check
+    if(k % ROCWMMA_K || (isBatched ? batchCount % BATCH_PER_WAVE : rows % PANEL_M)
+       || (!isBatched && batchCount != 1))
+    {
+        std::cout << "Unsupported size!\n";
+        return;
+    }
+
+    auto sizeA = rows * k;
+    auto sizeB = k * ROCWMMA_N;
+    auto sizeC = rows * ROCWMMA_N;
+
+    // Initialize input matrices
+    std::vector<float16_t> matrixA(sizeA * batchCount);
+    std::vector<float16_t> matrixB(sizeB * batchCount);
+    std::vector<float32_t> matrixC(sizeC * batchCount);
+    // Fill outputs with NaN to catch contamination
+    std::vector<float32_t> matrixD(sizeC * batchCount,
+                                   std::numeric_limits<float32_t>::signaling_NaN());
+
+    fillRand(matrixA.data(), rows * batchCount, k);
+    fillRand(matrixB.data(), k, ROCWMMA_N * batchCount);
+    fillRand(matrixC.data(), rows * batchCount, ROCWMMA_N);
+
+    // Allocate and copy device memory
+    float16_t* d_a;
+    float16_t* d_b;
+    float32_t* d_c;
+    float32_t* d_d;
+
+    const size_t bytesA = matrixA.size() * sizeof(float16_t);
+    const size_t bytesB = matrixB.size() * sizeof(float16_t);
+    const size_t bytesC = matrixC.size() * sizeof(float32_t);
+    const size_t bytesD = matrixD.size() * sizeof(float32_t);
+
+    CHECK_HIP_ERROR(hipMalloc(&d_a, bytesA));
+    CHECK_HIP_ERROR(hipMalloc(&d_b, bytesB));
+    CHECK_HIP_ERROR(hipMalloc(&d_c, bytesC));
+    CHECK_HIP_ERROR(hipMalloc(&d_d, bytesD));
+
+    CHECK_HIP_ERROR(hipMemcpy(d_a, matrixA.data(), bytesA, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_b, matrixB.data(), bytesB, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_c, matrixC.data(), bytesC, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_d, matrixD.data(), bytesD, hipMemcpyHostToDevice));
+
+    float32_t elapsedTimeMs;
+    if(isBatched)
+    {
+        elapsedTimeMs = launch(batched_gemm_4x4_d,
+                               batchCount / BATCH_PER_WAVE,
+                               batchCount,
+                               k,
+                               d_a,
+                               d_b,
+                               d_c,
+                               d_d,
+                               alpha,
+                               beta);
+    }
+    else
+    {
+        elapsedTimeMs
+            = launch(panel_gemm_64x4_d, rows / PANEL_M, rows, k, d_a, d_b, d_c, d_d, alpha, beta);
+    }
+
+    auto gFlops       = calculateGFlops(rows, ROCWMMA_N, k) * batchCount;
+    auto tFlopsPerSec = gFlops / static_cast<double>(elapsedTimeMs);
+
+    // Echo performance
+    std::cout << (isBatched ? "batched_4x4" : "panel_64x4") << ", " << rows << ", " << ROCWMMA_N
+              << ", " << k << ", " << batchCount << ", " << elapsedTimeMs << ", " << gFlops
+              << ", " << tFlopsPerSec << std::endl;
+
+#if !NDEBUG
+
+    // Bring kernel result back to host
+    CHECK_HIP_ERROR(hipMemcpy(matrixD.data(), d_d, bytesD, hipMemcpyDeviceToHost));
+
+    // Setup and run reference computation, one problem at a time
+    std::vector<float32_t> matrixD_ref(sizeC * batchCount,
+                                       std::numeric_limits<float32_t>::signaling_NaN());
+    for(uint32_t i = 0; i < batchCount; i++)
+    {
+        gemm_cpu_h<float16_t, float32_t, float32_t, row_major, col_major, row_major>(
+            rows,
+            ROCWMMA_N,
+            k,
+            matrixA.data() + i * sizeA,
+            matrixB.data() + i * sizeB,
+            matrixC.data() + i * sizeC,
+            matrixD_ref.data() + i * sizeC,
+            k,
+            k,
+            ROCWMMA_N,
+            ROCWMMA_N,
+            alpha,
+            beta);
+    }
+
+    auto res = compareEqual<float32_t>(matrixD.data(), matrixD_ref.data(), sizeC * batchCount);
+
+    if(std::get<0>(res) == false)
+    {
+        std::cout << "FAILED!\n";
+    }
+    else
+    {
+        std::cout << "PASSED!\n";
+    }
+
+    std::cout << "Max relative error: " << std::get<1>(res) << std::endl;
+
+#endif // !NDEBUG
+
+    // Release device memory
+    CHECK_HIP_ERROR(hipFree(d_a));
+    CHECK_HIP_ERROR(hipFree(d_b));
+    CHECK_HIP_ERROR(hipFree(d_c));
+    CHECK_HIP_ERROR(hipFree(d_d));
+}
+
+int main()
+{
+    // Multi-block 4 x 4 mfma are gfx9 only
+    if(!isGfx9())
+    {
+        std::cout << "4x4 multi-block mfma not supported on this device" << std::endl;
+        return 0;
+    }
+
+    std::cout << "Layout, MatM, MatN, MatK, BatchCount, elapsedMs, Problem Size(GFlops), TFlops/s"
+              << std::endl;
+
+    // Batches of tiny problems
+    multiblock_test(BATCH_M, 16, 1 << 16, 2.1f, 2.1f);
+    multiblock_test(BATCH_M, 64, 1 << 16, 2.1f, 2.1f);
+
+    // Tall and skinny panels
+    multiblock_test(PANEL_M * 1024, 64, 1, 2.1f, 2.1f);
+    multiblock_test(PANEL_M * 1024, 256, 1, 2.1f, 2.1f);
+
+    return 0;
+}
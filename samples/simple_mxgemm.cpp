@@ -0,0 +1,480 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <hip/hip_ext.h>
+#include <hip/hip_runtime.h>
+
+#include <rocwmma/rocwmma.hpp>
+
+#include "common.hpp"
+
+using rocwmma::accumulator;
+using rocwmma::bfloat16_t;
+using rocwmma::bfloat8_ocp_t;
+using rocwmma::col_major;
+using rocwmma::e8m0_t;
+using rocwmma::float32_t;
+using rocwmma::float4_e2m1x2_t;
+using rocwmma::float6_e2m3x4_t;
+using rocwmma::float6_e3m2x4_t;
+using rocwmma::float8_ocp_t;
+using rocwmma::matrix_a;
+using rocwmma::matrix_b;
+using rocwmma::row_major;
+
+// Supports ROCWMMA_M/N square sizes of
+// : 16 x 16
+// : 32 x 32 ( only MI )
+const int ROCWMMA_M = 16;
+const int ROCWMMA_N = 16;
+
+// Supports ROCWMMA_K sizes as
+// : multiples of 32, the MX block size, so that each K step
+//   reads exactly one scale per row of A and column of B.
+const int ROCWMMA_K = 32;
+
+// Elements per MX scale, along K
+const int MX_BLOCK = 32;
+
+// Device warp size
+const uint32_t WAVE_SIZE = getWarpSize();
+
+// Thread block
+// : T_BLOCK_X must be multiple of WAVE_SIZE.
+// Note: Each wave will compute one BLOCK_M x BLOCK_N output block
+// Note: Workgroup will compute
+//  T_BLOCK_X / WAVE_SIZE x T_BLOCK_Y output blocks
+const int T_BLOCK_X = 4 * WAVE_SIZE;
+const int T_BLOCK_Y = 4;
+
+// Encoding of each OCP MX element format
+// : ExpBits / ManBits: exponent and mantissa field widths
+// : EMax: exponent of the largest normal, used to choose block scales
+// : MagCodes: count of finite magnitude encodings, excluding inf / NaN
+// : PackRatio: elements per storage element of QuantT
+template <typename QuantT>
+struct MxFormat;
+
+template <>
+struct MxFormat<float8_ocp_t>
+{
+    static constexpr int         ExpBits   = 4;
+    static constexpr int         ManBits   = 3;
+    static constexpr int         EMax      = 8;
+    static constexpr int         MagCodes  = 0x7F;
+    static constexpr int         PackRatio = 1;
+    static constexpr const char* Name      = "MXFP8 (E4M3)";
+};
+
+template <>
+struct MxFormat<bfloat8_ocp_t>
+{
+    static constexpr int         ExpBits   = 5;
+    static constexpr int         ManBits   = 2;
+    static constexpr int         EMax      = 15;
+    static constexpr int         MagCodes  = 0x7C;
+    static constexpr int         PackRatio = 1;
+    static constexpr const char* Name      = "MXFP8 (E5M2)";
+};
+
+template <>
+struct MxFormat<float6_e2m3x4_t>
+{
+    static constexpr int         ExpBits   = 2;
+    static constexpr int         ManBits   = 3;
+    static constexpr int         EMax      = 2;
+    static constexpr int         MagCodes  = 32;
+    static constexpr int         PackRatio = 4;
+    static constexpr const char* Name      = "MXFP6 (E2M3)";
+};
+
+template <>
+struct MxFormat<float6_e3m2x4_t>
+{
+    static constexpr int         ExpBits   = 3;
+    static constexpr int         ManBits   = 2;
+    static constexpr int         EMax      = 4;
+    static constexpr int         MagCodes  = 32;
+    static constexpr int         PackRatio = 4;
+    static constexpr const char* Name      = "MXFP6 (E3M2)";
+};
+
+template <>
+struct MxFormat<float4_e2m1x2_t>
+{
+    static constexpr int         ExpBits   = 2;
+    static constexpr int         ManBits   = 1;
+    static constexpr int         EMax      = 2;
+    static constexpr int         MagCodes  = 8;
+    static constexpr int         PackRatio = 2;
+    static constexpr const char* Name      = "MXFP4 (E2M1)";
+};
+
+// The following device kernel is a naive implementation of a blocked MX GEMM.
+// Each wave will compute one BLOCK_M x BLOCK_N output block of the M x N x K
+// GEMM, generalized as:
+// D = (scaleA * A) x (scaleB * B)
+//
+// Where:
+// : A and B hold MX elements of QuantT, packed for FP6 and FP4
+// : scaleA is an e8m0_t scale per row of A and block of 32 along K   (M x K / 32)
+// : scaleB is an e8m0_t scale per column of B and block of 32 along K (K / 32 x N)
+//
+// MX GEMM is emulated: load_matrix_mx_sync decodes the elements, applies their
+// block scales and converts them to bfloat16_t in registers, and mma_sync
+// accumulates in float32_t. The elements and scales of each MX format are exact
+// in bfloat16_t, so only the accumulation rounds. Global memory traffic is that
+// of the MX data, at 4.25 to 8.25 bits per element.
+//
+// In this simplified example, we assume:
+// : A is in row-major format        (M x K), with row-major scales
+// : B is in col-major format        (K x N), with col-major scales
+// : D is in row-major format        (M x N)
+// : No LDS required
+//
+// Note: This is a simplified implementation to demonstrate API usage in
+// context of wave-level GEMM computation, and is not optimized.
+template <typename QuantT>
+__global__ void mxgemm_rocwmma_d(uint32_t      m,
+                                 uint32_t      n,
+                                 uint32_t      k,
+                                 QuantT const* a,
+                                 e8m0_t const* scaleA,
+                                 QuantT const* b,
+                                 e8m0_t const* scaleB,
+                                 float32_t*    d,
+                                 uint32_t      lda,
+                                 uint32_t      ldb,
+                                 uint32_t      ldd,
+                                 uint32_t      lds)
+{
+    constexpr uint32_t PackRatio = MxFormat<QuantT>::PackRatio;
+
+    // Create frags
+    auto fragA
+        = rocwmma::fragment<matrix_a, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, bfloat16_t, row_major>();
+    auto fragB
+        = rocwmma::fragment<matrix_b, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, bfloat16_t, col_major>();
+    auto fragAcc = rocwmma::fragment<accumulator, ROCWMMA_M, ROCWMMA_N, ROCWMMA_K, float32_t>();
+
+    rocwmma::fill_fragment(fragAcc, 0.0f);
+
+    // Tile using a 2D grid
+    auto majorWarp = (blockIdx.x * blockDim.x + threadIdx.x) / rocwmma::Constants::AMDGCN_WAVE_SIZE;
+    auto minorWarp = (blockIdx.y * blockDim.y + threadIdx.y);
+
+    // Target D block
+    auto cRow = majorWarp * ROCWMMA_M;
+    auto cCol = minorWarp * ROCWMMA_N;
+
+    // Bounds check
+    if(cRow < m && cCol < n)
+    {
+        // fragAcc = (scaleA * A) x (scaleB * B)
+        for(int i = 0; i < k; i += ROCWMMA_K)
+        {
+            // Load and scale the inputs. Packed data is addressed in storage
+            // elements, and each K step has one scale block.
+            rocwmma::load_matrix_mx_sync(fragA,
+                                         a + (cRow * lda + i) / PackRatio,
+                                         scaleA + (cRow * lds + i / MX_BLOCK),
+                                         lda,
+                                         lds);
+            rocwmma::load_matrix_mx_sync(fragB,
+                                         b + (i + cCol * ldb) / PackRatio,
+                                         scaleB + (i / MX_BLOCK + cCol * lds),
+                                         ldb,
+                                         lds);
+
+            // Matrix multiply - accumulate using MFMA units
+            rocwmma::mma_sync(fragAcc, fragA, fragB, fragAcc);
+        }
+
+        // Store to D
+        rocwmma::store_matrix_sync(d + (cRow * ldd + cCol), fragAcc, ldd, rocwmma::mem_row_major);
+    }
+}
+
+// Host MX quantization of a float32_t matrix, in blocks of 32 along K.
+// Blocks are contiguous in memory: A is row-major and B is col-major.
+// Each block scale is 2^(floor(log2(amax)) - EMax) as in the OCP MX specification,
+// and elements round to the nearest encoding, saturating at the largest finite value.
+// The dequantized values are returned for the reference GEMM.
+template <typename QuantT>
+__host__ void quantizeMx(std::vector<float32_t> const& values,
+                         std::vector<uint8_t>&         packed,
+                         std::vector<e8m0_t>&          scales,
+                         std::vector<float32_t>&       dequant)
+{
+    using Format = MxFormat<QuantT>;
+
+    // Ascending finite magnitudes of the element format
+    std::vector<float32_t> magnitudes(Format::MagCodes);
+    for(int c = 0; c < Format::MagCodes; c++)
+    {
+        magnitudes[c] = rocwmma::detail::decodeMx<Format::ExpBits, Format::ManBits>(c);
+    }
+
+    auto elementBits = Format::ExpBits + Format::ManBits + 1;
+    auto signBit     = 1u << (elementBits - 1);
+
+    packed.assign(values.size() * elementBits / 8, 0u);
+    scales.resize(values.size() / MX_BLOCK);
+    dequant.resize(values.size());
+
+    for(size_t blk = 0; blk < scales.size(); blk++)
+    {
+        auto first = values.begin() + blk * MX_BLOCK;
+        auto amax  = 0.0f;
+        std::for_each(first, first + MX_BLOCK, [&amax](float32_t v) {
+            amax = std::max(amax, std::fabs(v));
+        });
+
+        // Zero blocks take the smallest scale
+        auto exp = amax > 0.0f ? std::ilogb(amax) - Format::EMax : -127;
+        exp      = std::min(std::max(exp, -127), 127);
+
+        scales[blk].data = static_cast<uint8_t>(exp + 127);
+        auto scale       = std::ldexp(1.0f, exp);
+
+        for(int i = 0; i < MX_BLOCK; i++)
+        {
+            auto idx = blk * MX_BLOCK + i;
+            auto x   = std::fabs(values[idx]) / scale;
+
+            // Nearest magnitude, saturating
+            auto upper = std::lower_bound(magnitudes.begin(), magnitudes.end(), x);
+            auto code  = static_cast<uint32_t>(upper - magnitudes.begin());
+            if(code == magnitudes.size() || (code > 0 && x - magnitudes[code - 1] < *upper - x))
+            {
+                code--;
+            }
+
+            dequant[idx] = std::copysign(magnitudes[code] * scale, values[idx]);
+            code |= std::signbit(values[idx]) ? signBit : 0u;
+
+            // Pack the element bits, lower element index first
+            auto bit = idx * elementBits;
+            for(int b = 0; b < elementBits; b++, bit++)
+            {
+                packed[bit / 8] |= static_cast<uint8_t>(((code >> b) & 1u) << (bit % 8));
+            }
+        }
+    }
+}
+
+template <typename QuantT>
+__host__ void mxgemm_test(uint32_t m, uint32_t n, uint32_t k)
+{
+    using Format = MxFormat<QuantT>;
+
+    // Bounds check
+    if((m < (ROCWMMA_M * T_BLOCK_X / WAVE_SIZE) || n < (ROCWMMA_N * T_BLOCK_Y) || k < ROCWMMA_K)
+       || (m % ROCWMMA_M || n % ROCWMMA_N || k % ROCWMMA_K))
+    {
+        std::cout << "Unsupported size!\n";
+        return;
+    }
+
+    int lda = k;
+    int ldb = k;
+    int ldd = n;
+    int lds = k / MX_BLOCK;
+
+    std::cout << Format::Name << ": Initializing host data..." << std::endl;
+
+    // Values over several binades, varying per block so that block scales differ
+    auto gen  = std::mt19937(5489u);
+    auto dist = std::uniform_real_distribution<float32_t>(-1.0f, 1.0f);
+    auto fill = [&gen, &dist](std::vector<float32_t>& values) {
+        for(size_t i = 0; i < values.size(); i++)
+        {
+            values[i] = std::ldexp(dist(gen), static_cast<int>(i / MX_BLOCK % 9) - 4);
+        }
+    };
+
+    // A is row-major and B is col-major, so both are contiguous in K
+    std::vector<float32_t> valuesA(m * k), valuesB(k * n), dequantA, dequantB;
+    std::vector<uint8_t>   matrixA, matrixB;
+    std::vector<e8m0_t>    scalesA, scalesB;
+    std::vector<float32_t> matrixD(m * n);
+
+    fill(valuesA);
+    fill(valuesB);
+    quantizeMx<QuantT>(valuesA, matrixA, scalesA, dequantA);
+    quantizeMx<QuantT>(valuesB, matrixB, scalesB, dequantB);
+
+    std::cout << Format::Name << ": Initializing device data..." << std::endl;
+
+    // Allocate and copy device memory
+    QuantT*    d_a;
+    QuantT*    d_b;
+    e8m0_t*    d_scaleA;
+    e8m0_t*    d_scaleB;
+    float32_t* d_d;
+
+    const size_t bytesA      = matrixA.size();
+    const size_t bytesB      = matrixB.size();
+    const size_t bytesScaleA = scalesA.size() * sizeof(e8m0_t);
+    const size_t bytesScaleB = scalesB.size() * sizeof(e8m0_t);
+    const size_t bytesD      = matrixD.size() * sizeof(float32_t);
+
+    CHECK_HIP_ERROR(hipMalloc(&d_a, bytesA));
+    CHECK_HIP_ERROR(hipMalloc(&d_b, bytesB));
+    CHECK_HIP_ERROR(hipMalloc(&d_scaleA, bytesScaleA));
+    CHECK_HIP_ERROR(hipMalloc(&d_scaleB, bytesScaleB));
+    CHECK_HIP_ERROR(hipMalloc(&d_d, bytesD));
+
+    CHECK_HIP_ERROR(hipMemcpy(d_a, matrixA.data(), bytesA, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_b, matrixB.data(), bytesB, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_scaleA, scalesA.data(), bytesScaleA, hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_scaleB, scalesB.data(), bytesScaleB, hipMemcpyHostToDevice));
+
+    auto blockDim = dim3(T_BLOCK_X, T_BLOCK_Y);
+    auto gridDim  = dim3(rocwmma::ceilDiv(m, ROCWMMA_M * T_BLOCK_X / WAVE_SIZE),
+                        rocwmma::ceilDiv(n, ROCWMMA_N * T_BLOCK_Y));
+
+    std::cout << Format::Name << ": Launching GEMM kernel..." << std::endl;
+
+    hipEvent_t startEvent, stopEvent;
+    CHECK_HIP_ERROR(hipEventCreate(&startEvent));
+    CHECK_HIP_ERROR(hipEventCreate(&stopEvent));
+
+    hipExtLaunchKernelGGL(mxgemm_rocwmma_d<QuantT>,
+                          gridDim,
+                          blockDim,
+                          0, // sharedMemBytes
+                          0, // stream
+                          startEvent, // Event start
+                          stopEvent, // event stop
+                          0, // flags
+                          m,
+                          n,
+                          k,
+                          d_a,
+                          d_scaleA,
+                          d_b,
+                          d_scaleB,
+                          d_d,
+                          lda,
+                          ldb,
+                          ldd,
+                          lds);
+
+    auto elapsedTimeMs = 0.0f;
+    CHECK_HIP_ERROR(hipEventSynchronize(stopEvent));
+    CHECK_HIP_ERROR(hipEventElapsedTime(&elapsedTimeMs, startEvent, stopEvent));
+    CHECK_HIP_ERROR(hipEventDestroy(startEvent));
+    CHECK_HIP_ERROR(hipEventDestroy(stopEvent));
+
+    // GEMM flops converge to 2*mnk
+    auto gFlops       = calculateGFlops(m, n, k);
+    auto tFlopsPerSec = gFlops / static_cast<double>(elapsedTimeMs);
+
+    // Input footprint of A and B with their scales, relative to bfloat16_t inputs
+    auto inputBytes = bytesA + bytesB + bytesScaleA + bytesScaleB;
+    auto bitsPerElt = 8.0 * inputBytes / (valuesA.size() + valuesB.size());
+
+    // Echo performance
+    std::cout << "Format, BlkM, BlkN, BlkK, "
+              << "MatM, MatN, MatK, "
+              << "lda, ldb, ldd, lds, "
+              << "inputBytes, bitsPerElt, vsBf16, "
+              << "elapsedMs, Problem Size(GFlops), TFlops/s" << std::endl;
+
+    std::cout << Format::Name << ", " << ROCWMMA_M << ", " << ROCWMMA_N << ", " << ROCWMMA_K
+              << ", " << m << ", " << n << ", " << k << ", " << lda << ", " << ldb << ", " << ldd
+              << ", " << lds << ", " << inputBytes << ", " << bitsPerElt << ", "
+              << 16.0 / bitsPerElt << "x, " << elapsedTimeMs << ", " << gFlops << ", "
+              << tFlopsPerSec << std::endl;
+
+#if !NDEBUG
+
+    std::cout << Format::Name << ": Validating result with reference..." << std::endl;
+
+    CHECK_HIP_ERROR(hipMemcpy(matrixD.data(), d_d, bytesD, hipMemcpyDeviceToHost));
+
+    // Reference GEMM on the dequantized values, which the device reproduces exactly
+    // in bfloat16_t before accumulating in float32_t.
+    std::vector<float32_t> matrixC_ref(m * n, 0.0f);
+    std::vector<float32_t> matrixD_ref(m * n);
+    gemm_cpu_h<float32_t, float32_t, float32_t, row_major, col_major, row_major>(
+        m,
+        n,
+        k,
+        dequantA.data(),
+        dequantB.data(),
+        matrixC_ref.data(),
+        matrixD_ref.data(),
+        lda,
+        ldb,
+        ldd,
+        ldd,
+        1.0f,
+        0.0f);
+
+    // The accumulation order differs from the reference, so allow k epsilons
+    auto res = compareEqual<float32_t>(
+        matrixD.data(), matrixD_ref.data(), m * n, static_cast<double>(k));
+
+    if(std::get<0>(res) == false)
+    {
+        std::cout << "FAILED!\n";
+    }
+    else
+    {
+        std::cout << "PASSED!\n";
+    }
+
+    std::cout << "Max relative error: " << std::get<1>(res) << std::endl;
+
+#endif // !NDEBUG
+
+    // Release device memory
+    CHECK_HIP_ERROR(hipFree(d_a));
+    CHECK_HIP_ERROR(hipFree(d_b));
+    CHECK_HIP_ERROR(hipFree(d_scaleA));
+    CHECK_HIP_ERROR(hipFree(d_scaleB));
+    CHECK_HIP_ERROR(hipFree(d_d));
+
+    std::cout << "Finished!" << std::endl;
+}
+
+int main()
+{
+    mxgemm_test<float8_ocp_t>(1024, 1024, 1024);
+    mxgemm_test<bfloat8_ocp_t>(1024, 1024, 1024);
+    mxgemm_test<float6_e2m3x4_t>(1024, 1024, 1024);
+    mxgemm_test<float6_e3m2x4_t>(1024, 1024, 1024);
+    mxgemm_test<float4_e2m1x2_t>(1024, 1024, 1024);
+    return 0;
+}
@@ -0,0 +1,249 @@
+#!/usr/bin/env python3
+###############################################################################
+#
+# MIT License
+#
+# Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+#
+###############################################################################
+
+# Instruction mix of the hot loops of each kernel in a HIP executable, and a regression gate
+# against a committed baseline.
+#
+# Disassembles the code object of each offload target with llvm-objdump, finds the loops of
+# each kernel from its backward branches and counts the instructions of its hot loop, the
+# innermost loop with the most MFMA / WMMA instructions (or the most instructions without
+# any), by class:
+#   mfma: v_mfma, v_smfmac, v_wmma, v_swmmac
+#   vmem: global_, buffer_, flat_, scratch_ (tbuffer_ included)
+#   ds:   ds_
+#   valu: other v_
+#   salu: other s_, excluding scalar memory and program control (s_waitcnt, s_branch, ...)
+#   smem: s_load, s_buffer_load, s_store, s_dcache
+#
+# Usage:
+#   IsaInstructionMix.py <executable> --output mix.json [--kernel-filter REGEX]
+#   IsaInstructionMix.py <executable> --baseline baseline.json [--tolerance 0.1]
+#
+# With --baseline, every kernel of the baseline is compared with its current hot loop. The
+# gate fails (exit code 1) if a class grows by more than the tolerance (relative, and at
+# least one instruction), the valu / mfma ratio grows by more than the tolerance or a
+# baseline kernel is missing. It also fails if the baseline does not exist, so that an
+# ungated target is not reported as passing. --update writes the current mix to the baseline
+# path instead.
+
+import argparse
+import json
+import os
+import re
+import subprocess
+import sys
+import tempfile
+
+sys.path.insert(
+    0, os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'resource_report'))
+from KernelResourceReport import code_objects, demangle, run, tool  # noqa: E402
+
+CLASSES = ['mfma', 'vmem', 'ds', 'valu', 'salu', 'smem']
+
+CONTROL = re.compile(r'^s_(waitcnt|cbranch|branch|nop|barrier|endpgm|sleep|setprio|sched|'
+                     r'trap|sendmsg|wait_|delay_alu|clause|code_end|setpc|swappc|getpc|'
+                     r'icache|inst_prefetch)')
+
+
+def classify(mnemonic):
+    if re.match(r'^v_(mfma|smfmac|wmma|swmmac)', mnemonic):
+        return 'mfma'
+    if re.match(r'^(global|buffer|tbuffer|flat|scratch)_', mnemonic):
+        return 'vmem'
+    if mnemonic.startswith('ds_'):
+        return 'ds'
+    if mnemonic.startswith('v_'):
+        return 'valu'
+    if re.match(r'^s_(load|buffer_load|store|buffer_store|dcache|scratch)', mnemonic):
+        return 'smem'
+    if mnemonic.startswith('s_') and not CONTROL.match(mnemonic):
+        return 'salu'
+    return None
+
+
+# Instruction lines end with a comment holding the byte address, e.g.
+#   s_cbranch_scc1 65494    // 000000001A3C: BF85FFD6
+INSTRUCTION = re.compile(r'^\s+([a-z_0-9]+)\b(.*?)//\s*([0-9A-Fa-f]+):')
+FUNCTION = re.compile(r'^[0-9A-Fa-f]+ <(.+)>:$')
+
+
+def parse_disassembly(text):
+    """Returns {function: [(address, mnemonic, operands)]}"""
+    functions = {}
+    current = None
+    for line in text.splitlines():
+        match = FUNCTION.match(line)
+        if match:
+            current = functions.setdefault(match.group(1), [])
+            continue
+        match = INSTRUCTION.match(line)
+        if match and current is not None:
+            current.append((int(match.group(3), 16), match.group(1), match.group(2).strip()))
+    return functions
+
+
+def branch_target(address, operands):
+    """Target address of a SOPP branch with a simm16 dword offset from the next instruction"""
+    match = re.match(r'^(-?\d+)', operands)
+    if not match:
+        return None
+    offset = int(match.group(1))
+    if offset > 32767:
+        offset -= 65536
+    return address + 4 + 4 * offset
+
+
+def loops(instructions):
+    """(start, end) address ranges of the innermost loops, closed by backward branches"""
+    ranges = []
+    for address, mnemonic, operands in instructions:
+        if mnemonic.startswith('s_cbranch') or mnemonic == 's_branch':
+            target = branch_target(address, operands)
+            if target is not None and target <= address:
+                ranges.append((target, address))
+
+    return [outer for outer in ranges
+            if not any(inner != outer and outer[0] <= inner[0] and inner[1] <= outer[1]
+                       for inner in ranges)]
+
+
+def mix(instructions, start=None, end=None):
+    counts = dict.fromkeys(CLASSES, 0)
+    total = 0
+    for address, mnemonic, _ in instructions:
+        if start is not None and not start <= address <= end:
+            continue
+        total += 1
+        kind = classify(mnemonic)
+        if kind:
+            counts[kind] += 1
+    counts['total'] = total
+    return counts
+
+
+def hot_loop(instructions):
+    candidates = [mix(instructions, start, end) for start, end in loops(instructions)]
+    if not candidates:
+        return None
+    return max(candidates, key=lambda counts: (counts['mfma'], counts['total']))
+
+
+def analyze(binary, llvmBin, kernelFilter):
+    objdump = tool(llvmBin, 'llvm-objdump')
+    if objdump is None:
+        raise RuntimeError('llvm-objdump not found')
+
+    result = {}
+    with tempfile.TemporaryDirectory() as workDir:
+        for arch, codeObject in code_objects(binary, llvmBin, workDir):
+            text = run([objdump, '-d', '--triple=amdgcn-amd-amdhsa', '--mcpu=' + arch,
+                        codeObject])
+            functions = parse_disassembly(text)
+            names = list(functions)
+            readable = demangle(names, tool(llvmBin, 'llvm-cxxfilt'))
+
+            kernels = result.setdefault(arch, {})
+            for name, demangled in zip(names, readable):
+                if kernelFilter and not re.search(kernelFilter, demangled):
+                    continue
+                loop = hot_loop(functions[name])
+                if loop is not None:
+                    kernels[name] = dict(name=demangled, loop=loop)
+    return result
+
+
+def ratio(counts):
+    return counts['valu'] / counts['mfma'] if counts['mfma'] else float(counts['valu'])
+
+
+def compare(baseline, current, tolerance):
+    failures = []
+    for arch, kernels in baseline.items():
+        for kernel, expected in kernels.items():
+            actual = current.get(arch, {}).get(kernel)
+            if actual is None:
+                failures.append('[{}] missing kernel {}'.format(arch, expected['name']))
+                continue
+
+            old, new = expected['loop'], actual['loop']
+            for kind in CLASSES:
+                limit = max(old[kind] * (1.0 + tolerance), old[kind] + 1)
+                if new[kind] > limit:
+                    failures.append('[{}] {}: {} {} -> {}'.format(
+                        arch, expected['name'], kind, old[kind], new[kind]))
+            if ratio(new) > ratio(old) * (1.0 + tolerance) and new['valu'] > old['valu']:
+                failures.append('[{}] {}: valu / mfma {:.2f} -> {:.2f}'.format(
+                    arch, expected['name'], ratio(old), ratio(new)))
+    return failures
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Hot loop instruction mix of HIP kernels')
+    parser.add_argument('binary', help='HIP executable or bundled object')
+    parser.add_argument('--output', help='path of the JSON instruction mix')
+    parser.add_argument('--baseline', help='path of the baseline JSON to compare with')
+    parser.add_argument('--update', action='store_true', help='write the baseline instead')
+    parser.add_argument('--tolerance', type=float, default=0.1,
+                        help='relative growth allowed per class and in valu / mfma')
+    parser.add_argument('--kernel-filter', default='',
+                        help='regex on the demangled names of the kernels to analyze')
+    parser.add_argument('--llvm-bin', default='', help='directory of the ROCm LLVM tools')
+    args = parser.parse_args()
+
+    if args.baseline and not args.update and not os.path.exists(args.baseline):
+        print('IsaInstructionMix: no baseline {}, generate it with the rocwmma_isa_mix_baselines '
+              'target'.format(args.baseline), file=sys.stderr)
+        return 1
+
+    current = analyze(args.binary, args.llvm_bin, args.kernel_filter)
+
+    output = args.baseline if args.update else args.output
+    if output:
+        os.makedirs(os.path.dirname(os.path.abspath(output)), exist_ok=True)
+        with open(output, 'w') as mixFile:
+            json.dump(current, mixFile, indent=2, sort_keys=True)
+            mixFile.write('\n')
+
+    for arch, kernels in sorted(current.items()):
+        for kernel in sorted(kernels.values(), key=lambda k: k['name']):
+            loop = kernel['loop']
+            print('[{}] {}: {}'.format(arch, kernel['name'][:96],
+                                       ', '.join('{} {}'.format(k, loop[k]) for k in CLASSES)))
+
+    if not args.baseline or args.update:
+        return 0
+
+    with open(args.baseline) as baselineFile:
+        failures = compare(json.load(baselineFile), current, args.tolerance)
+
+    for failure in failures:
+        print('  regression: ' + failure, file=sys.stderr)
+    return 1 if failures else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
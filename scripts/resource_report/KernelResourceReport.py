@@ -0,0 +1,299 @@
+#!/usr/bin/env python3
+###############################################################################
+#
+# MIT License
+#
+# Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+#
+###############################################################################
+
+# Per-kernel resource report of a HIP executable or code object bundle.
+#
+# Extracts the code object of each offload target from the .hip_fatbin section,
+# reads the AMDGPU metadata note of every kernel and writes one CSV row per
+# kernel and target with its VGPR, AGPR and SGPR counts, spills, scratch and LDS
+# sizes, and the theoretical occupancy in waves per SIMD with its limiting
+# resource. With llvm-objdump, it also counts the v_accvgpr_read / write / mov copies
+# between AGPRs and VGPRs of each kernel, which grow when accumulators do not stay in AGPRs.
+# Only uses the LLVM tools shipped with ROCm:
+#   llvm-objcopy, clang-offload-bundler, llvm-readelf and (optionally) llvm-objdump and
+#   llvm-cxxfilt
+#
+# Usage:
+#   KernelResourceReport.py <executable> --output report.csv [--llvm-bin /opt/rocm/llvm/bin]
+#                           [--fail-on-spill] [--fail-on-scratch]
+
+import argparse
+import csv
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+
+FIELDS = ['target', 'kernel', 'vgpr', 'agpr', 'sgpr', 'vgpr_spill', 'sgpr_spill',
+          'scratch_bytes', 'lds_bytes', 'wave_size', 'max_workgroup_size',
+          'occupancy', 'limiter', 'accvgpr_moves']
+
+# Register file and occupancy limits per SIMD:
+#   vgprs: VGPRs per lane of the (unified, on gfx90a / gfx94x) register file
+#   granule: VGPR allocation granule
+#   unified: arch VGPRs and AGPRs share the file, otherwise AGPRs have their own of equal size
+#   waves: maximum waves per SIMD
+#   sgprs: SGPRs per SIMD, if they limit occupancy
+#   simds: SIMDs sharing the LDS of a CU
+#   lds: LDS bytes per CU
+ARCH_LIMITS = {
+    'gfx908':  dict(vgprs=256,  granule=4,  unified=False, waves=10, sgprs=800, simds=4, lds=65536),
+    'gfx90a':  dict(vgprs=512,  granule=8,  unified=True,  waves=8,  sgprs=800, simds=4, lds=65536),
+    'gfx940':  dict(vgprs=512,  granule=8,  unified=True,  waves=8,  sgprs=800, simds=4, lds=65536),
+    'gfx941':  dict(vgprs=512,  granule=8,  unified=True,  waves=8,  sgprs=800, simds=4, lds=65536),
+    'gfx942':  dict(vgprs=512,  granule=8,  unified=True,  waves=8,  sgprs=800, simds=4, lds=65536),
+    'gfx1100': dict(vgprs=1536, granule=24, unified=False, waves=16, sgprs=0,   simds=2, lds=65536),
+    'gfx1101': dict(vgprs=1536, granule=24, unified=False, waves=16, sgprs=0,   simds=2, lds=65536),
+    'gfx1102': dict(vgprs=1024, granule=16, unified=False, waves=16, sgprs=0,   simds=2, lds=65536),
+    'gfx1200': dict(vgprs=1536, granule=24, unified=False, waves=16, sgprs=0,   simds=2, lds=65536),
+    'gfx1201': dict(vgprs=1536, granule=24, unified=False, waves=16, sgprs=0,   simds=2, lds=65536),
+}
+
+SGPR_GRANULE = 16
+
+
+def align(value, granule):
+    return (value + granule - 1) // granule * granule
+
+
+def occupancy(arch, kernel):
+    """Theoretical waves per SIMD and the resource limiting them.
+    LDS occupancy assumes workgroups of max_workgroup_size threads."""
+    limits = ARCH_LIMITS.get(arch)
+    if limits is None:
+        return 0, 'unknown arch'
+
+    vgpr = kernel['vgpr']
+    agpr = kernel['agpr']
+    if limits['unified']:
+        regs = align(vgpr, 4) + agpr if agpr > 0 else vgpr
+    else:
+        regs = max(vgpr, agpr)
+
+    bounds = [(limits['waves'], 'waves')]
+    if regs > 0:
+        bounds.append((limits['vgprs'] // align(regs, limits['granule']), 'vgpr'))
+    if limits['sgprs'] > 0 and kernel['sgpr'] > 0:
+        bounds.append((limits['sgprs'] // align(kernel['sgpr'], SGPR_GRANULE), 'sgpr'))
+    if kernel['lds_bytes'] > 0:
+        wavesPerGroup = max(1, -(-kernel['max_workgroup_size'] // max(1, kernel['wave_size'])))
+        groupsPerCu = limits['lds'] // kernel['lds_bytes']
+        bounds.append((groupsPerCu * wavesPerGroup // limits['simds'], 'lds'))
+
+    return min(bounds, key=lambda bound: bound[0])
+
+
+def run(args):
+    return subprocess.run(args, check=True, stdout=subprocess.PIPE,
+                          stderr=subprocess.PIPE, universal_newlines=True).stdout
+
+
+def tool(llvmBin, name):
+    path = os.path.join(llvmBin, name) if llvmBin else shutil.which(name)
+    return path if path and os.path.exists(path) else None
+
+
+def parse_metadata(notes):
+    """Parses the amdhsa.kernels list of the AMDGPU metadata YAML printed by llvm-readelf.
+    Only the scalar keys at the kernel level are kept."""
+    kernels = []
+    inKernels = False
+    itemIndent = None
+    for line in notes.splitlines():
+        stripped = line.strip()
+        if stripped.startswith('amdhsa.kernels:'):
+            inKernels = True
+            continue
+        if not inKernels or not stripped:
+            continue
+
+        indent = len(line) - len(line.lstrip())
+        if stripped.startswith('- .') and (itemIndent is None or indent == itemIndent):
+            itemIndent = indent
+            kernels.append({})
+            stripped = stripped[2:]
+            indent += 2
+        elif itemIndent is not None and indent <= itemIndent and not stripped.startswith('-'):
+            # Next top level key, e.g. amdhsa.target
+            inKernels = False
+            continue
+
+        match = re.match(r'^\.(\w+):\s*(.*)$', stripped)
+        if kernels and match and indent == itemIndent + 2:
+            kernels[-1][match.group(1)] = match.group(2).strip().strip("'\"")
+
+    return kernels
+
+
+# Function labels of the disassembly, e.g. 0000000000001900 <_Z6kernelv>:
+FUNCTION = re.compile(r'^[0-9A-Fa-f]+ <(.+)>:$')
+ACCVGPR_MOVE = re.compile(r'^\s+v_accvgpr_(read|write|mov)')
+
+
+def accvgpr_moves(disassembly):
+    """Returns {function: number of v_accvgpr_read / write / mov instructions}"""
+    moves = {}
+    current = None
+    for line in disassembly.splitlines():
+        match = FUNCTION.match(line)
+        if match:
+            current = match.group(1)
+            moves[current] = 0
+        elif current is not None and ACCVGPR_MOVE.match(line):
+            moves[current] += 1
+    return moves
+
+
+def to_row(arch, meta):
+    def value(key):
+        try:
+            return int(meta.get(key, 0))
+        except ValueError:
+            return 0
+
+    kernel = dict(target=arch,
+                  kernel=meta.get('name', ''),
+                  vgpr=value('vgpr_count'),
+                  agpr=value('agpr_count'),
+                  sgpr=value('sgpr_count'),
+                  vgpr_spill=value('vgpr_spill_count'),
+                  sgpr_spill=value('sgpr_spill_count'),
+                  scratch_bytes=value('private_segment_fixed_size'),
+                  lds_bytes=value('group_segment_fixed_size'),
+                  wave_size=value('wavefront_size'),
+                  max_workgroup_size=value('max_flat_workgroup_size'))
+    kernel['occupancy'], kernel['limiter'] = occupancy(arch, kernel)
+    kernel['accvgpr_moves'] = ''
+    return kernel
+
+
+def demangle(names, cxxfilt):
+    if not cxxfilt or not names:
+        return names
+    output = subprocess.run([cxxfilt], input='\n'.join(names), check=True,
+                            stdout=subprocess.PIPE, universal_newlines=True).stdout
+    demangled = output.splitlines()
+    return demangled if len(demangled) == len(names) else names
+
+
+def code_objects(binary, llvmBin, workDir):
+    """Yields (arch, code object path) for each amdgcn target bundled in the binary."""
+    bundle = binary
+    objcopy = tool(llvmBin, 'llvm-objcopy')
+    if objcopy:
+        fatbin = os.path.join(workDir, 'fatbin')
+        try:
+            run([objcopy, '--dump-section', '.hip_fatbin=' + fatbin, binary,
+                 os.path.join(workDir, 'stripped')])
+            bundle = fatbin
+        except subprocess.CalledProcessError:
+            # Not an executable with an embedded fat binary, e.g. a bundled object
+            pass
+
+    bundler = tool(llvmBin, 'clang-offload-bundler')
+    if bundler is None:
+        raise RuntimeError('clang-offload-bundler not found')
+
+    targets = run([bundler, '--list', '--type=o', '--input=' + bundle]).split()
+    for index, target in enumerate(t for t in targets if 'amdgcn' in t):
+        output = os.path.join(workDir, 'co{}.o'.format(index))
+        run([bundler, '--unbundle', '--type=o', '--input=' + bundle,
+             '--targets=' + target, '--output=' + output])
+
+        # Target IDs end with the processor and its features, e.g.
+        # hipv4-amdgcn-amd-amdhsa--gfx90a:xnack-
+        arch = target.split('--')[-1].split(':')[0]
+        yield arch, output
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Per-kernel VGPR / AGPR / SGPR / spill / LDS / occupancy report')
+    parser.add_argument('binary', help='HIP executable or bundled object')
+    parser.add_argument('--output', required=True, help='path of the CSV report')
+    parser.add_argument('--llvm-bin', default='', help='directory of the ROCm LLVM tools')
+    parser.add_argument('--fail-on-spill', action='store_true',
+                        help='exit with an error if any kernel spills registers')
+    parser.add_argument('--fail-on-scratch', action='store_true',
+                        help='exit with an error if any kernel uses scratch memory')
+    args = parser.parse_args()
+
+    readelf = tool(args.llvm_bin, 'llvm-readelf')
+    if readelf is None:
+        print('KernelResourceReport: llvm-readelf not found', file=sys.stderr)
+        return 1
+
+    objdump = tool(args.llvm_bin, 'llvm-objdump')
+
+    rows = []
+    with tempfile.TemporaryDirectory() as workDir:
+        for arch, codeObject in code_objects(args.binary, args.llvm_bin, workDir):
+            metadata = parse_metadata(run([readelf, '--notes', codeObject]))
+            kernels = [to_row(arch, meta) for meta in metadata]
+            if objdump:
+                moves = accvgpr_moves(run([objdump, '-d', '--triple=amdgcn-amd-amdhsa',
+                                           '--mcpu=' + arch, codeObject]))
+                for kernel in kernels:
+                    kernel['accvgpr_moves'] = moves.get(kernel['kernel'], '')
+            rows.extend(kernels)
+
+    names = demangle([row['kernel'] for row in rows], tool(args.llvm_bin, 'llvm-cxxfilt'))
+    for row, name in zip(rows, names):
+        row['kernel'] = name
+
+    rows.sort(key=lambda row: (row['target'], row['occupancy'], row['kernel']))
+
+    os.makedirs(os.path.dirname(os.path.abspath(args.output)), exist_ok=True)
+    with open(args.output, 'w', newline='') as report:
+        writer = csv.DictWriter(report, fieldnames=FIELDS)
+        writer.writeheader()
+        writer.writerows(rows)
+
+    spills = [row for row in rows if row['vgpr_spill'] > 0 or row['sgpr_spill'] > 0]
+    scratch = [row for row in rows if row['scratch_bytes'] > 0]
+    print('{}: {} kernels, {} spilling, {} using scratch, lowest occupancy {} -> {}'.format(
+        os.path.basename(args.binary), len(rows), len(spills), len(scratch),
+        min((row['occupancy'] for row in rows), default='n/a'), args.output))
+
+    for row in spills:
+        print('  spill: [{}] {} (vgpr {}, sgpr {})'.format(
+            row['target'], row['kernel'], row['vgpr_spill'], row['sgpr_spill']),
+            file=sys.stderr)
+
+    for row in scratch:
+        print('  scratch: [{}] {} ({} bytes)'.format(
+            row['target'], row['kernel'], row['scratch_bytes']), file=sys.stderr)
+
+    if args.fail_on_spill and spills:
+        return 1
+    return 1 if args.fail_on_scratch and scratch else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
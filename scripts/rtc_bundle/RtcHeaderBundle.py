@@ -0,0 +1,198 @@
+#!/usr/bin/env python3
+###############################################################################
+#
+# MIT License
+#
+# Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+#
+###############################################################################
+
+# Preprocessed rocWMMA header bundle for hipRTC.
+#
+# Preprocesses the rocWMMA API headers once per offload target, as hipRTC compiles them
+# (device only, with __HIPCC_RTC__ defined), and writes a C++ header that embeds each result
+# as a string. Programs passed to hiprtcCreateProgram with a bundle as the source of their
+# rocWMMA includes skip resolving and re-parsing the include tree from disk, and do not need
+# the headers installed.
+#
+# Each bundle is minimized: comments, line markers, blank lines and indentation are removed,
+# and preprocessor conditionals are resolved for the target. Macro definitions are kept,
+# except the predefined macros of the compiler, such that kernel sources may still use the
+# rocWMMA macros. Options that change the preprocessing (e.g. -DNDEBUG) are fixed at bundle
+# time, through --define.
+#
+# The generated header provides, in namespace rocwmma_rtc_bundle:
+#   entries[]: include names of the bundled headers, e.g. "rocwmma/rocwmma.hpp"
+#   find(gcnArchName): the bundle of a device, matched on the processor name, or nullptr
+# Every entry name maps to the full bundle, which is guarded against repeated inclusion.
+#
+# Usage:
+#   RtcHeaderBundle.py --compiler amdclang++ --include-dir library/include
+#                      --archs gfx90a gfx942 --output rocwmma_rtc_bundle.hpp
+#                      [--entries rocwmma/rocwmma.hpp ...] [--define NDEBUG ...]
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+
+DEFAULT_ENTRIES = ['rocwmma/rocwmma.hpp', 'rocwmma/rocwmma_coop.hpp',
+                   'rocwmma/rocwmma_transforms.hpp']
+
+# Raw string literals are split at line boundaries into chunks of at most this many bytes
+CHUNK_BYTES = 16384
+DELIMITER = 'rtc'
+
+DEFINE = re.compile(r'^#\s*define\s+([A-Za-z_][A-Za-z_0-9]*)')
+
+
+def preprocess(compiler, arch, includeDir, defines, source, flags):
+    command = [compiler, '-x', 'hip', '-std=c++17', '--cuda-device-only',
+               '--offload-arch=' + arch, '-nogpuinc', '-nogpulib', '-D__HIPCC_RTC__',
+               '-I', includeDir]
+    command += ['-D' + define for define in defines]
+    command += flags + ['-']
+    result = subprocess.run(command, input=source, stdout=subprocess.PIPE,
+                            stderr=subprocess.PIPE, universal_newlines=True)
+    if result.returncode != 0:
+        sys.stderr.write(result.stderr)
+        raise RuntimeError('RtcHeaderBundle: preprocessing for {} failed'.format(arch))
+    return result.stdout
+
+
+def minimize(text, predefined):
+    lines = []
+    for line in text.splitlines():
+        line = line.strip()
+        if not line:
+            continue
+
+        # hipRTC defines its own predefined macros, and the target ones at compile time
+        match = DEFINE.match(line)
+        if match and match.group(1) in predefined:
+            continue
+        lines.append(line)
+    return lines
+
+
+def bundle(compiler, arch, includeDir, entries, defines):
+    predefined = set()
+    for line in preprocess(compiler, arch, includeDir, defines, '', ['-E', '-dM']).splitlines():
+        match = DEFINE.match(line)
+        if match:
+            predefined.add(match.group(1))
+
+    source = ''.join('#include <{}>\n'.format(entry) for entry in entries)
+    lines = minimize(preprocess(compiler, arch, includeDir, defines, source,
+                                ['-E', '-P', '-dD']), predefined)
+    return ['#ifndef ROCWMMA_RTC_BUNDLE_INCLUDED',
+            '#define ROCWMMA_RTC_BUNDLE_INCLUDED'] + lines + ['#endif']
+
+
+def literal(lines):
+    chunks = []
+    chunk = []
+    size = 0
+    for line in lines:
+        if ')' + DELIMITER + '"' in line:
+            raise RuntimeError('RtcHeaderBundle: raw string delimiter found in the bundle')
+        if chunk and size + len(line) + 1 > CHUNK_BYTES:
+            chunks.append(chunk)
+            chunk = []
+            size = 0
+        chunk.append(line)
+        size += len(line) + 1
+    if chunk:
+        chunks.append(chunk)
+
+    return '\n'.join('R"{0}({1}\n){0}"'.format(DELIMITER, '\n'.join(c)) for c in chunks)
+
+
+def write(output, archs, entries, bundles):
+    with open(output, 'w') as header:
+        header.write('// Generated by scripts/rtc_bundle/RtcHeaderBundle.py, do not edit.\n')
+        header.write('#ifndef ROCWMMA_RTC_BUNDLE_HPP\n#define ROCWMMA_RTC_BUNDLE_HPP\n\n')
+        header.write('#include <cstddef>\n#include <cstring>\n\n')
+        header.write('namespace rocwmma_rtc_bundle\n{\n')
+        header.write('    struct bundle\n    {\n')
+        header.write('        char const* mArch;\n        char const* mSource;\n    };\n\n')
+
+        header.write('    // Include names resolved by each bundle\n')
+        header.write('    static constexpr char const* entries[] = {{{}}};\n'.format(
+            ', '.join('"{}"'.format(entry) for entry in entries)))
+        header.write('    static constexpr std::size_t entry_count = {};\n\n'.format(len(entries)))
+
+        for index, arch in enumerate(archs):
+            header.write('    static constexpr char const source{}[] =\n'.format(index))
+            header.write(literal(bundles[arch]) + ';\n\n')
+
+        header.write('    static constexpr bundle bundles[] = {{{}}};\n\n'.format(
+            ', '.join('{{"{}", source{}}}'.format(arch, index)
+                      for index, arch in enumerate(archs))))
+
+        header.write('    // Bundle of the device with gcnArchName, e.g. "gfx90a:sramecc+:xnack-",\n')
+        header.write('    // matched on the processor name. nullptr if it was not bundled.\n')
+        header.write('    inline bundle const* find(char const* gcnArchName)\n    {\n')
+        header.write('        auto length = std::strcspn(gcnArchName, ":");\n')
+        header.write('        for(auto const& entry : bundles)\n        {\n')
+        header.write('            if(std::strlen(entry.mArch) == length\n')
+        header.write('               && std::strncmp(entry.mArch, gcnArchName, length) == 0)\n')
+        header.write('            {\n                return &entry;\n            }\n        }\n')
+        header.write('        return nullptr;\n    }\n\n')
+        header.write('} // namespace rocwmma_rtc_bundle\n\n#endif // ROCWMMA_RTC_BUNDLE_HPP\n')
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Embed preprocessed rocWMMA headers of each target for hipRTC')
+    parser.add_argument('--compiler', required=True, help='HIP clang++ driver')
+    parser.add_argument('--include-dir', required=True, help='rocWMMA include directory')
+    parser.add_argument('--archs', nargs='+', required=True,
+                        help='offload targets, e.g. gfx90a:xnack- gfx942')
+    parser.add_argument('--entries', nargs='+', default=DEFAULT_ENTRIES,
+                        help='rocWMMA headers to bundle, as included by kernel sources')
+    parser.add_argument('--define', nargs='*', default=[],
+                        help='macros fixed in the bundle, e.g. NDEBUG')
+    parser.add_argument('--output', required=True, help='path of the generated header')
+    args = parser.parse_args()
+
+    # One bundle per processor: target features do not change the preprocessed headers
+    archs = []
+    for target in args.archs:
+        arch = target.split(':')[0]
+        if arch not in archs:
+            archs.append(arch)
+
+    bundles = {arch: bundle(args.compiler, arch, args.include_dir, args.entries, args.define)
+               for arch in archs}
+
+    os.makedirs(os.path.dirname(os.path.abspath(args.output)), exist_ok=True)
+    write(args.output, archs, args.entries, bundles)
+
+    print('{}: {} -> {}'.format(os.path.basename(args.output), ', '.join(
+        '{} {} KB'.format(arch, sum(len(l) + 1 for l in bundles[arch]) // 1024)
+        for arch in archs), args.output))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
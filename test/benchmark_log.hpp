@@ -0,0 +1,599 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef ROCWMMA_TEST_BENCHMARK_LOG_HPP
+#define ROCWMMA_TEST_BENCHMARK_LOG_HPP
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "counter_collector.hpp"
+#include "singleton.hpp"
+
+namespace rocwmma
+{
+    // Elapsed time statistics over the timed runs of one benchmark
+    struct TimingStats
+    {
+        double mMeanMs, mMedianMs, mP95Ms, mStdDevMs;
+    };
+
+    inline TimingStats calculateTimingStats(std::vector<double> samplesMs)
+    {
+        if(samplesMs.empty())
+        {
+            return {0.0, 0.0, 0.0, 0.0};
+        }
+
+        std::sort(samplesMs.begin(), samplesMs.end());
+        auto count = samplesMs.size();
+
+        double sum = 0.0;
+        for(auto s : samplesMs)
+        {
+            sum += s;
+        }
+        auto mean = sum / static_cast<double>(count);
+
+        double sumSq = 0.0;
+        for(auto s : samplesMs)
+        {
+            sumSq += (s - mean) * (s - mean);
+        }
+
+        // Nearest-rank percentile
+        auto rank95 = static_cast<size_t>(std::ceil(0.95 * static_cast<double>(count)));
+        auto median = (count % 2u) ? samplesMs[count / 2u]
+                                   : 0.5 * (samplesMs[count / 2u - 1u] + samplesMs[count / 2u]);
+
+        return {mean,
+                median,
+                samplesMs[std::max<size_t>(rank95, 1u) - 1u],
+                std::sqrt(sumSq / static_cast<double>(count))};
+    }
+
+    // One benchmarked run. Records are identified by (suite, arch, problem type, kernel config,
+    // thread block and shape); the remaining fields are measurements.
+    // Hardware counters are only present with -pc || --perf_counters.
+    struct BenchmarkRecord
+    {
+        std::string   mSuite;
+        uint32_t      mArch;
+        std::string   mProblemType;
+        std::string   mKernelConfig;
+        uint32_t      mTBlockX, mTBlockY;
+        uint32_t      mM, mN, mK, mBatch;
+        uint32_t      mRuns;
+        TimingStats   mTiming;
+        double        mGFlops;
+        double        mTFlopsPerSec;
+        int32_t       mEfficiency;
+        double        mRoofTFlopsPerSec;
+        std::string   mBound;
+        std::string   mResult;
+        CounterValues mCounters;
+    };
+
+    // Collects benchmark records and writes them with a stable schema, one record per run.
+    // Output is csv when the file name ends in .csv, otherwise JSON lines.
+    // A baseline in either format can be loaded back to flag median time regressions.
+    // Configured hardware counters follow the schema fields as "ctr_<name>" fields.
+    class BenchmarkLog : public LazySingleton<BenchmarkLog>
+    {
+    public:
+        static constexpr char const* SchemaVersion = "rocwmma-bench-1";
+
+        // Field order of the stable schema, shared by csv and JSON
+        static std::vector<std::string> const& fields()
+        {
+            static std::vector<std::string> const sFields = {"schema",
+                                                             "suite",
+                                                             "arch",
+                                                             "problem_type",
+                                                             "kernel_config",
+                                                             "tblock_x",
+                                                             "tblock_y",
+                                                             "m",
+                                                             "n",
+                                                             "k",
+                                                             "batch",
+                                                             "runs",
+                                                             "mean_ms",
+                                                             "median_ms",
+                                                             "p95_ms",
+                                                             "stddev_ms",
+                                                             "gflops",
+                                                             "tflops_per_sec",
+                                                             "efficiency_pct",
+                                                             "roof_tflops_per_sec",
+                                                             "bound",
+                                                             "result"};
+            return sFields;
+        }
+
+        static constexpr char const* CounterPrefix = "ctr_";
+
+        // Counter fields written after the schema fields, in this order
+        void setCounterNames(std::vector<std::string> const& names)
+        {
+            mCounterNames = names;
+        }
+
+        bool open(std::string const& fileName)
+        {
+            mCsv = fileName.size() >= 4 && fileName.compare(fileName.size() - 4, 4, ".csv") == 0;
+            mFile.open(fileName);
+            mHeaderWritten = false;
+            return mFile.is_open();
+        }
+
+        bool isOpen() const
+        {
+            return mFile.is_open();
+        }
+
+        void record(BenchmarkRecord const& record)
+        {
+            mRecords.push_back(record);
+            if(mFile.is_open())
+            {
+                write(mFile, record);
+                mFile.flush();
+            }
+        }
+
+        std::vector<BenchmarkRecord> const& records() const
+        {
+            return mRecords;
+        }
+
+        void clear()
+        {
+            mRecords.clear();
+        }
+
+        // Reads all records of a csv or JSON lines file.
+        // Returns false if the file can't be opened or a record is malformed.
+        static bool load(std::string const& fileName, std::vector<BenchmarkRecord>& records)
+        {
+            std::ifstream file(fileName);
+            if(!file.is_open())
+            {
+                return false;
+            }
+
+            std::vector<std::string> header;
+            std::string              line;
+            while(std::getline(file, line))
+            {
+                auto first = line.find_first_not_of(" \t\r");
+                if(first == std::string::npos || line[first] == '#')
+                {
+                    continue;
+                }
+
+                std::map<std::string, std::string> values;
+                if(line[first] == '{')
+                {
+                    if(!parseJson(line.substr(first), values))
+                    {
+                        return false;
+                    }
+                }
+                else if(header.empty())
+                {
+                    header = splitCsv(line);
+                    continue;
+                }
+                else
+                {
+                    auto row = splitCsv(line);
+                    if(row.size() != header.size())
+                    {
+                        return false;
+                    }
+                    for(size_t i = 0; i < row.size(); i++)
+                    {
+                        values[header[i]] = row[i];
+                    }
+                }
+
+                BenchmarkRecord record;
+                if(!fromValues(values, record))
+                {
+                    return false;
+                }
+                records.push_back(record);
+            }
+            return true;
+        }
+
+        // Flags every recorded run whose median time exceeds the matching baseline median
+        // by more than thresholdPct percent. Skipped and failed runs are not compared.
+        // Returns the number of regressions.
+        uint32_t compare(std::vector<BenchmarkRecord> const& baseline,
+                         double                              thresholdPct,
+                         std::ostream&                       stream = std::cout) const
+        {
+            uint32_t compared = 0u, missing = 0u, regressions = 0u;
+            for(auto const& current : mRecords)
+            {
+                if(current.mResult == "SKIPPED" || current.mResult == "FAILED")
+                {
+                    continue;
+                }
+
+                auto it = std::find_if(baseline.begin(), baseline.end(), [&](auto const& b) {
+                    return sameKey(b, current);
+                });
+                if(it == baseline.end() || it->mTiming.mMedianMs <= 0.0)
+                {
+                    missing++;
+                    continue;
+                }
+
+                compared++;
+                auto deltaPct
+                    = (current.mTiming.mMedianMs / it->mTiming.mMedianMs - 1.0) * 100.0;
+                if(deltaPct > thresholdPct)
+                {
+                    regressions++;
+                    stream << "REGRESSION: " << current.mSuite << ", gfx" << std::hex
+                           << current.mArch << std::dec << ", " << current.mProblemType << ", "
+                           << current.mKernelConfig << ", " << current.mTBlockX << "x"
+                           << current.mTBlockY << ", " << current.mM << "x" << current.mN << "x"
+                           << current.mK << "x" << current.mBatch
+                           << ", median(ms) baseline: " << it->mTiming.mMedianMs
+                           << ", current: " << current.mTiming.mMedianMs << " (+" << std::fixed
+                           << std::setprecision(2) << deltaPct << "%)" << std::defaultfloat
+                           << std::setprecision(6) << std::endl;
+                }
+            }
+
+            stream << "Benchmark compare: " << compared << " compared, " << missing
+                   << " without baseline, " << regressions << " regressed beyond "
+                   << thresholdPct << "%" << std::endl;
+            return regressions;
+        }
+
+        // Records with the same identifying fields measure the same benchmark
+        static bool sameKey(BenchmarkRecord const& lhs, BenchmarkRecord const& rhs)
+        {
+            return lhs.mSuite == rhs.mSuite && lhs.mArch == rhs.mArch
+                   && lhs.mProblemType == rhs.mProblemType
+                   && lhs.mKernelConfig == rhs.mKernelConfig && lhs.mTBlockX == rhs.mTBlockX
+                   && lhs.mTBlockY == rhs.mTBlockY && lhs.mM == rhs.mM && lhs.mN == rhs.mN
+                   && lhs.mK == rhs.mK && lhs.mBatch == rhs.mBatch;
+        }
+
+        static std::string archString(uint32_t arch)
+        {
+            std::stringstream ss;
+            ss << "gfx" << std::hex << arch;
+            return ss.str();
+        }
+
+    private:
+
+        // Values in schema field order. Strings are flagged for JSON quoting.
+        static std::vector<std::pair<std::string, bool>> toValues(BenchmarkRecord const& r)
+        {
+            auto num = [](auto value) {
+                std::stringstream ss;
+                ss << std::setprecision(10) << value;
+                return std::make_pair(ss.str(), false);
+            };
+            auto str = [](std::string const& value) { return std::make_pair(value, true); };
+
+            return {str(SchemaVersion),
+                    str(r.mSuite),
+                    str(archString(r.mArch)),
+                    str(r.mProblemType),
+                    str(r.mKernelConfig),
+                    num(r.mTBlockX),
+                    num(r.mTBlockY),
+                    num(r.mM),
+                    num(r.mN),
+                    num(r.mK),
+                    num(r.mBatch),
+                    num(r.mRuns),
+                    num(r.mTiming.mMeanMs),
+                    num(r.mTiming.mMedianMs),
+                    num(r.mTiming.mP95Ms),
+                    num(r.mTiming.mStdDevMs),
+                    num(r.mGFlops),
+                    num(r.mTFlopsPerSec),
+                    num(r.mEfficiency),
+                    num(r.mRoofTFlopsPerSec),
+                    str(r.mBound),
+                    str(r.mResult)};
+        }
+
+        static bool fromValues(std::map<std::string, std::string> const& values,
+                               BenchmarkRecord&                          r)
+        {
+            for(auto const& field : fields())
+            {
+                if(values.find(field) == values.end())
+                {
+                    return false;
+                }
+            }
+
+            auto const& arch = values.at("arch");
+            if(values.at("schema") != SchemaVersion || arch.compare(0, 3, "gfx") != 0)
+            {
+                return false;
+            }
+
+            try
+            {
+                r.mSuite            = values.at("suite");
+                r.mArch             = std::stoul(arch.substr(3), nullptr, 16);
+                r.mProblemType      = values.at("problem_type");
+                r.mKernelConfig     = values.at("kernel_config");
+                r.mTBlockX          = std::stoul(values.at("tblock_x"));
+                r.mTBlockY          = std::stoul(values.at("tblock_y"));
+                r.mM                = std::stoul(values.at("m"));
+                r.mN                = std::stoul(values.at("n"));
+                r.mK                = std::stoul(values.at("k"));
+                r.mBatch            = std::stoul(values.at("batch"));
+                r.mRuns             = std::stoul(values.at("runs"));
+                r.mTiming.mMeanMs   = std::stod(values.at("mean_ms"));
+                r.mTiming.mMedianMs = std::stod(values.at("median_ms"));
+                r.mTiming.mP95Ms    = std::stod(values.at("p95_ms"));
+                r.mTiming.mStdDevMs = std::stod(values.at("stddev_ms"));
+                r.mGFlops           = std::stod(values.at("gflops"));
+                r.mTFlopsPerSec     = std::stod(values.at("tflops_per_sec"));
+                r.mEfficiency       = std::stoi(values.at("efficiency_pct"));
+                r.mRoofTFlopsPerSec = std::stod(values.at("roof_tflops_per_sec"));
+                r.mBound            = values.at("bound");
+                r.mResult           = values.at("result");
+
+                auto prefixLength = std::string(CounterPrefix).size();
+                for(auto const& value : values)
+                {
+                    if(value.first.compare(0, prefixLength, CounterPrefix) == 0
+                       && !value.second.empty())
+                    {
+                        r.mCounters.emplace_back(value.first.substr(prefixLength),
+                                                 std::stod(value.second));
+                    }
+                }
+            }
+            catch(std::exception const&)
+            {
+                return false;
+            }
+            return true;
+        }
+
+        void write(std::ostream& stream, BenchmarkRecord const& record)
+        {
+            auto const& names  = fields();
+            auto        values = toValues(record);
+
+            if(mCsv)
+            {
+                if(!mHeaderWritten)
+                {
+                    for(size_t i = 0; i < names.size(); i++)
+                    {
+                        stream << (i ? "," : "") << names[i];
+                    }
+                    for(auto const& name : mCounterNames)
+                    {
+                        stream << "," << CounterPrefix << name;
+                    }
+                    stream << std::endl;
+                    mHeaderWritten = true;
+                }
+                for(size_t i = 0; i < values.size(); i++)
+                {
+                    stream << (i ? "," : "") << values[i].first;
+                }
+
+                // Empty where the device does not support a counter
+                for(auto const& name : mCounterNames)
+                {
+                    stream << ",";
+                    if(auto it = findCounter(record.mCounters, name); it != record.mCounters.end())
+                    {
+                        stream << std::setprecision(10) << it->second << std::setprecision(6);
+                    }
+                }
+                stream << std::endl;
+            }
+            else
+            {
+                stream << "{";
+                for(size_t i = 0; i < values.size(); i++)
+                {
+                    stream << (i ? ", " : "") << "\"" << names[i] << "\": ";
+                    if(values[i].second)
+                    {
+                        stream << "\"" << escapeJson(values[i].first) << "\"";
+                    }
+                    else
+                    {
+                        stream << values[i].first;
+                    }
+                }
+                for(auto const& name : mCounterNames)
+                {
+                    if(auto it = findCounter(record.mCounters, name); it != record.mCounters.end())
+                    {
+                        stream << ", \"" << CounterPrefix << escapeJson(name)
+                               << "\": " << std::setprecision(10) << it->second
+                               << std::setprecision(6);
+                    }
+                }
+                stream << "}" << std::endl;
+            }
+        }
+
+        static std::string escapeJson(std::string const& value)
+        {
+            std::string result;
+            for(auto c : value)
+            {
+                if(c == '"' || c == '\\')
+                {
+                    result += '\\';
+                }
+                result += c;
+            }
+            return result;
+        }
+
+        static std::vector<std::string> splitCsv(std::string const& line)
+        {
+            std::vector<std::string> fields;
+            std::stringstream        lineStream(line);
+            std::string              field;
+            while(std::getline(lineStream, field, ','))
+            {
+                auto first = field.find_first_not_of(" \t\r");
+                auto last  = field.find_last_not_of(" \t\r");
+                fields.push_back(first == std::string::npos
+                                     ? ""
+                                     : field.substr(first, last - first + 1));
+            }
+
+            // getline drops a trailing empty field
+            if(!line.empty() && line.back() == ',')
+            {
+                fields.push_back("");
+            }
+            return fields;
+        }
+
+        // Minimal parser for the flat objects written above: string keys with
+        // string or numeric values.
+        static bool parseJson(std::string const& line, std::map<std::string, std::string>& values)
+        {
+            size_t pos  = 0;
+            auto   skip = [&]() {
+                while(pos < line.size() && std::isspace(static_cast<unsigned char>(line[pos])))
+                {
+                    pos++;
+                }
+            };
+            auto readString = [&](std::string& out) {
+                if(line[pos] != '"')
+                {
+                    return false;
+                }
+                for(pos++; pos < line.size() && line[pos] != '"'; pos++)
+                {
+                    if(line[pos] == '\\' && pos + 1 < line.size())
+                    {
+                        pos++;
+                    }
+                    out += line[pos];
+                }
+                return pos++ < line.size();
+            };
+
+            skip();
+            if(pos >= line.size() || line[pos++] != '{')
+            {
+                return false;
+            }
+
+            while(true)
+            {
+                skip();
+                if(pos >= line.size())
+                {
+                    return false;
+                }
+                if(line[pos] == '}')
+                {
+                    return true;
+                }
+
+                std::string key, value;
+                if(!readString(key))
+                {
+                    return false;
+                }
+                skip();
+                if(pos >= line.size() || line[pos++] != ':')
+                {
+                    return false;
+                }
+                skip();
+                if(pos >= line.size())
+                {
+                    return false;
+                }
+                if(line[pos] == '"')
+                {
+                    if(!readString(value))
+                    {
+                        return false;
+                    }
+                }
+                else
+                {
+                    auto end = line.find_first_of(",}", pos);
+                    if(end == std::string::npos)
+                    {
+                        return false;
+                    }
+                    value = line.substr(pos, end - pos);
+                    value.erase(value.find_last_not_of(" \t\r") + 1);
+                    pos = end;
+                }
+                values[key] = value;
+
+                skip();
+                if(pos < line.size() && line[pos] == ',')
+                {
+                    pos++;
+                }
+            }
+        }
+
+        std::ofstream                mFile;
+        bool                         mCsv           = false;
+        bool                         mHeaderWritten = false;
+        std::vector<BenchmarkRecord> mRecords;
+        std::vector<std::string>     mCounterNames;
+    };
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_TEST_BENCHMARK_LOG_HPP
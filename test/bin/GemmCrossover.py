@@ -0,0 +1,142 @@
+# Crossover analysis of the GEMM shape sweep benchmarks.
+#
+# Reads the --bench_output records of the *_shape_sweep-bench tests of each kernel family,
+# finds the fastest variant of each shape and reports the shape regions each variant wins,
+# with the crossovers between neighbouring grid shapes along M, N and K.
+# Optionally writes the winners as a tuning table, in the format read by GemmDispatcher.
+#
+# E.g.:
+# python3 test/bin/GemmCrossover.py --records sb.csv mb.csv cp.csv --tuning_table table.csv
+import argparse
+import csv
+import json
+import re
+import statistics
+import sys
+from collections import defaultdict
+
+# Kernel family, e.g. PGR1_LB2_MP0_MB_CP of PGR1_LB2_MP0_MB_CP_32x32x16_Workgroup_LdsNT_N_2x2
+FAMILY = re.compile(r"^(.*?)_\d+x\d+x\d+")
+
+
+def load(path):
+    with open(path) as f:
+        lines = [l for l in f if l.strip() and not l.lstrip().startswith("#")]
+    if lines and lines[0].lstrip().startswith("{"):
+        return [json.loads(l) for l in lines]
+    return [{k.strip(): v.strip() for k, v in row.items()}
+            for row in csv.DictReader(lines, skipinitialspace=True)]
+
+
+def variant(record, by):
+    if by == "config":
+        return "{}_{}x{}".format(record["kernel_config"], record["tblock_x"], record["tblock_y"])
+    match = FAMILY.match(record["kernel_config"])
+    return match.group(1) if match else record["kernel_config"]
+
+
+def crossovers(winners):
+    # Neighbouring shapes along one axis, with the other two dimensions fixed
+    result = []
+    for axis, name in enumerate("MNK"):
+        lines = defaultdict(list)
+        for shape in winners:
+            fixed = shape[:axis] + shape[axis + 1:]
+            lines[fixed].append(shape)
+        for fixed, shapes in sorted(lines.items()):
+            shapes.sort(key=lambda s: s[axis])
+            for lo, hi in zip(shapes, shapes[1:]):
+                if winners[lo][0] != winners[hi][0]:
+                    result.append((name, lo, hi, winners[lo][0], winners[hi][0]))
+    return result
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Find the shape regions where each GEMM kernel variant wins")
+    parser.add_argument("--records", nargs="+", required=True,
+                        help="--bench_output files (csv or JSON lines) of the shape sweeps")
+    parser.add_argument("--by", choices=["family", "config"], default="family",
+                        help="compare kernel families, or kernel configs and thread blocks")
+    parser.add_argument("--variants", nargs="*", default=[],
+                        help="only consider these variants, e.g. the families the dispatcher runs")
+    parser.add_argument("--tuning_table", help="write the fastest config per shape to this file")
+    parser.add_argument("--crossovers", help="write the crossovers to this csv file")
+    args = parser.parse_args()
+
+    # Fastest record per (arch, problem type, shape) and variant
+    best = defaultdict(dict)
+    for path in args.records:
+        for r in load(path):
+            if r["result"] in ("SKIPPED", "FAILED") or float(r["tflops_per_sec"]) <= 0.0:
+                continue
+            v = variant(r, args.by)
+            if args.variants and v not in args.variants:
+                continue
+            key = (r["arch"], r["problem_type"])
+            shape = (int(r["m"]), int(r["n"]), int(r["k"]))
+            current = best[key].setdefault(shape, {}).get(v)
+            if current is None or float(r["tflops_per_sec"]) > float(current["tflops_per_sec"]):
+                best[key][shape][v] = r
+
+    if not best:
+        print("No benchmark records to compare")
+        return 1
+
+    table = []
+    crossings = []
+    for (arch, problemType), shapes in sorted(best.items()):
+        # Winner of each shape, and its margin over the fastest other variant
+        winners = {}
+        for shape, variants in shapes.items():
+            ranked = sorted(variants.items(), key=lambda i: -float(i[1]["tflops_per_sec"]))
+            v, r = ranked[0]
+            margin = (float(r["tflops_per_sec"]) / float(ranked[1][1]["tflops_per_sec"])
+                      if len(ranked) > 1 else float("nan"))
+            winners[shape] = (v, r, margin)
+            table.append(r)
+
+        print("{}, {}: {} shapes".format(arch, problemType, len(winners)))
+        print("  {:<48} {:>6} {:>8} {:>14}".format("Variant", "Wins", "Share", "Median margin"))
+        wins = defaultdict(list)
+        for v, _, margin in winners.values():
+            wins[v].append(margin)
+        for v, margins in sorted(wins.items(), key=lambda i: -len(i[1])):
+            known = [m for m in margins if m == m]
+            print("  {:<48} {:>6} {:>7.1f}% {:>13.2f}x".format(
+                v, len(margins), 100.0 * len(margins) / len(winners),
+                statistics.median(known) if known else float("nan")))
+
+            # Bounding box of the won shapes
+            won = [s for s, w in winners.items() if w[0] == v]
+            print("    M {}..{}, N {}..{}, K {}..{}".format(
+                *[f(s[d] for s in won) for d in range(3) for f in (min, max)]))
+
+        found = crossovers(winners)
+        print("  Crossovers: {}".format(len(found)))
+        for axis, lo, hi, fromV, toV in found:
+            print("    {}: {}x{}x{} -> {}x{}x{}: {} -> {}".format(axis, *lo, *hi, fromV, toV))
+            crossings.append((arch, problemType, axis, lo, hi, fromV, toV))
+
+    if args.tuning_table:
+        # Same format as GemmTuningTable::write
+        with open(args.tuning_table, "w") as f:
+            f.write("# Arch, ProblemType, MatM, MatN, MatK, KernelConfig, TBlkX, TBlkY, TFlops/s\n")
+            for r in table:
+                f.write(", ".join([r["arch"], r["problem_type"], str(r["m"]), str(r["n"]),
+                                   str(r["k"]), r["kernel_config"], str(r["tblock_x"]),
+                                   str(r["tblock_y"]), str(r["tflops_per_sec"])]) + "\n")
+
+    if args.crossovers:
+        with open(args.crossovers, "w", newline="") as f:
+            writer = csv.writer(f)
+            writer.writerow(["arch", "problem_type", "axis", "m_lo", "n_lo", "k_lo",
+                             "m_hi", "n_hi", "k_hi", "variant_lo", "variant_hi"])
+            for arch, problemType, axis, lo, hi, fromV, toV in crossings:
+                writer.writerow([arch, problemType, axis, *lo, *hi, fromV, toV])
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
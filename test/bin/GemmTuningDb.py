@@ -0,0 +1,146 @@
+# Compiles GEMM tuning tables into the binary tuning db read by GemmTuningDb.
+#
+# Reads one or more csv tuning tables, as written by the autotune tests with --tuning_table
+# or by GemmCrossover.py, keeps the fastest config per (arch, problem type, shape) and
+# writes them with the hashed bucket index of test/gemm/gemm_tuning_db.hpp.
+# Pass a .tdb file to --dump to print a db back as a csv tuning table.
+#
+# E.g.:
+# python3 test/bin/GemmTuningDb.py --tables tuning_gfx90a.csv tuning_gfx942.csv --output tuning.tdb
+import argparse
+import struct
+import sys
+from collections import defaultdict
+
+MAGIC = b"RWTUNEDB"
+VERSION = 1
+HEADER = struct.Struct("<8s8I")
+SLOT = struct.Struct("<QII")
+ENTRY = struct.Struct("<8If")
+
+
+def log2(value):
+    return value.bit_length() - 1 if value > 0 else 0
+
+
+def bucket_key(arch, problem_type, bm, bn, bk):
+    # FNV-1a, as GemmTuningDb::bucketKey
+    h = 0xcbf29ce484222325
+    for byte in struct.pack("<I", arch) + problem_type.encode() + bytes([0, bm, bn, bk]):
+        h = ((h ^ byte) * 0x100000001b3) & 0xffffffffffffffff
+    return h if h else 1
+
+
+def load_table(path, best):
+    with open(path) as f:
+        for line in f:
+            if not line.strip() or line.startswith("#"):
+                continue
+            fields = [x.strip() for x in line.split(",")]
+            if len(fields) != 9 or not fields[0].startswith("gfx"):
+                sys.exit("Malformed tuning table line in {}: {}".format(path, line.strip()))
+            arch = int(fields[0][3:], 16)
+            key = (arch, fields[1], int(fields[2]), int(fields[3]), int(fields[4]))
+            entry = (fields[5], int(fields[6]), int(fields[7]), float(fields[8]))
+            if entry[3] > 0.0 and (key not in best or entry[3] > best[key][3]):
+                best[key] = entry
+
+
+def compile_db(best):
+    strings = bytearray()
+    offsets = {}
+
+    def string(value):
+        if value not in offsets:
+            offsets[value] = len(strings)
+            strings.extend(value.encode() + b"\0")
+        return offsets[value]
+
+    # Entries grouped by bucket key; colliding buckets share a slot
+    groups = defaultdict(list)
+    for (arch, problem_type, m, n, k), entry in sorted(best.items()):
+        groups[bucket_key(arch, problem_type, log2(m), log2(n), log2(k))].append(
+            (arch, problem_type, m, n, k) + entry)
+
+    slot_count = 1
+    while slot_count < 2 * len(groups):
+        slot_count *= 2
+
+    slots = [(0, 0, 0)] * slot_count
+    entries = []
+    max_probe = 1
+    for key, group in groups.items():
+        probe = 0
+        while slots[(key + probe) % slot_count][0] != 0:
+            probe += 1
+        slots[(key + probe) % slot_count] = (key, len(entries), len(group))
+        max_probe = max(max_probe, probe + 1)
+        for arch, problem_type, m, n, k, config, tbx, tby, tflops in group:
+            entries.append((arch, string(problem_type), m, n, k, string(config), tbx, tby, tflops))
+
+    # Non-empty string table, also for an empty db
+    string("")
+    while len(strings) % 4:
+        strings.append(0)
+
+    slots_offset = HEADER.size
+    entries_offset = slots_offset + slot_count * SLOT.size
+    strings_offset = entries_offset + len(entries) * ENTRY.size
+
+    data = bytearray(HEADER.pack(MAGIC, VERSION, len(entries), slot_count, max_probe,
+                                 slots_offset, entries_offset, strings_offset, len(strings)))
+    for slot in slots:
+        data += SLOT.pack(*slot)
+    for entry in entries:
+        data += ENTRY.pack(*entry)
+    data += strings
+    return data, len(groups), max_probe
+
+
+def dump(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    (magic, version, entry_count, _, _, _, entries_offset, strings_offset,
+     _) = HEADER.unpack_from(data)
+    if magic != MAGIC or version != VERSION:
+        sys.exit("Not a version {} tuning db: {}".format(VERSION, path))
+
+    def string(offset):
+        start = strings_offset + offset
+        return data[start:data.index(b"\0", start)].decode()
+
+    print("# Arch, ProblemType, MatM, MatN, MatK, KernelConfig, TBlkX, TBlkY, TFlops/s")
+    for i in range(entry_count):
+        arch, problem_type, m, n, k, config, tbx, tby, tflops = ENTRY.unpack_from(
+            data, entries_offset + i * ENTRY.size)
+        print("gfx{:x}, {}, {}, {}, {}, {}, {}, {}, {:g}".format(
+            arch, string(problem_type), m, n, k, string(config), tbx, tby, tflops))
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Compile GEMM tuning tables into a memory-mapped tuning db")
+    parser.add_argument("--tables", nargs="+", help="csv tuning tables to merge")
+    parser.add_argument("--output", help="tuning db file to write, e.g. tuning.tdb")
+    parser.add_argument("--dump", help="print this tuning db as a csv tuning table")
+    args = parser.parse_args()
+
+    if args.dump:
+        dump(args.dump)
+        return
+    if not args.tables or not args.output:
+        parser.error("--tables and --output are required unless dumping")
+
+    best = {}
+    for path in args.tables:
+        load_table(path, best)
+
+    data, buckets, max_probe = compile_db(best)
+    with open(args.output, "wb") as f:
+        f.write(data)
+    print("{}: {} entries in {} buckets, {} bytes, at most {} probes per bucket".format(
+        args.output, len(best), buckets, len(data), max_probe))
+
+
+if __name__ == "__main__":
+    main()
@@ -15,7 +15,9 @@ args = parser.parse_args()
 if(len(sys.argv) < 2):
   print("Please provide all arguments, csv_fp - path to the csv file and plots_loc - location to store the plots")
   exit(0)
-df = pd.read_csv(args.csv_fp, sep="\t")
+# GEMM benchmark output written with --output_stream
+df = pd.read_csv(args.csv_fp, sep=",", skipinitialspace=True)
+df.columns = df.columns.str.strip()
 lngth = len(df.columns)
 col = list(df.columns)
 skipcol = col[lngth - 1]
@@ -23,9 +25,14 @@ df = df[df[skipcol].notna()]
 pd.set_option('display.max_columns', None)
 pd.set_option('display.max_rows', 3000)
 
-df.columns = df.columns.str.strip()
-
 df = df[df[skipcol].str.contains("SKIPPED")==False]
+df = df.rename(columns={"Problem Size(GFlops)": "GFlops"})
+
+# Library baselines benchmarked alongside rocWMMA, plotted as dashed series
+baselines = [lib for lib in ["rocBLAS", "hipBLASLt"] if (lib + " TFlops/s") in df.columns]
+for c in ["GFlops", "TFlops/s"] + [lib + " TFlops/s" for lib in baselines]:
+  df[c] = pd.to_numeric(df[c], errors='coerce').astype(np.float32)
+
 grouped = df.groupby('Ti_To_Tc')
 
 for key, item in grouped:
@@ -37,13 +44,13 @@ for key, item in grouped:
         df2 = groupMxN.get_group(key1)
 
         groupK = df2.groupby('BlkK')
-        firstK = groupK.get_group(groupK.groups.keys()[0])
+        firstK = groupK.get_group(list(groupK.groups.keys())[0])
 
         groupLayout = firstK.groupby('LytA_LytB_LytC_LytD')
         ng = groupLayout.ngroups
 
         m, n = key1
-        fig, axs = plt.subplots(1, ng, sharex=True, sharey=True)
+        fig, axs = plt.subplots(1, ng, sharex=True, sharey=True, squeeze=False)
         fig.suptitle(str(key) + "-" + str(m) + "x" + str(n), fontsize=15)
 
         for key2, item2 in groupK:
@@ -53,22 +60,27 @@ for key, item in grouped:
             targets = zip(groupLayout.groups.keys(), axs.flatten())
 
             for (key3, ax) in targets:
-                dfLayout = groupLayout.get_group(key3)
-
-                dfLayout["GFlops"] = dfLayout["GFlops"].astype(np.float32)
-                dfLayout["Efficiency"] = dfLayout["Efficiency"].astype(np.float32)
-                dfLayout = dfLayout.sort_values('GFlops')
+                dfLayout = groupLayout.get_group(key3).sort_values('GFlops')
 
                 x = dfLayout["GFlops"]
-                y = dfLayout["Efficiency"]
+                y = dfLayout["TFlops/s"]
 
-                ax.plot(np.arange(len(x)), y, label=key2)
+                ax.plot(np.arange(len(x)), y, label="BlkK " + str(key2))
+                ax.set_xticks(np.arange(len(x)))
                 ax.set_xticklabels(x, rotation=30, horizontalalignment='right', fontsize='x-small')
                 ax.set_title(key3, loc='center',fontsize='small')
+                ax.set_ylabel("TFlops/s")
+
+        # Library results do not depend on BlkK, so plot them once per layout
+        groupLayout = firstK.groupby('LytA_LytB_LytC_LytD')
+        for (key3, ax) in zip(groupLayout.groups.keys(), axs.flatten()):
+            dfLayout = groupLayout.get_group(key3).sort_values('GFlops')
+            for lib in baselines:
+                ax.plot(np.arange(len(dfLayout)), dfLayout[lib + " TFlops/s"], linestyle='--', label=lib)
 
         handles, labels = ax.get_legend_handles_labels()
         unique = [(h, l) for i, (h, l) in enumerate(zip(handles, labels)) if l not in labels[:i]]
-        fig.legend(*zip(*unique),  title="BlkK",loc='best')
+        fig.legend(*zip(*unique), loc='best')
 
         fname = (str(key) + "-" + str(m) + "x" + str(n) + ".png").strip()
         plt.savefig(args.plots_loc+"/"+fname)
@@ -31,6 +31,7 @@
 #warning("Building tests with hfloat16_t requires !HIP_NO_HALF && !__HIP_NO_HALF_CONVERSIONS__. Proceeding without hfloat16_t")
 #endif // !ROCWMMA_NO_HALF && __HIP_NO_HALF_CONVERSIONS__
 
+#include <algorithm>
 #include <iostream>
 #include <mutex>
 #include <tuple>
@@ -115,6 +116,19 @@ namespace rocwmma
         };
 #endif
 
+        // hipBLASLt solves f16, bf16 and f32 inputs with f32 compute,
+        // to outputs of the input type or f32
+        template <typename InputT, typename OutputT, typename ComputeT>
+        struct hipblaslt_supported
+            : std::bool_constant<std::is_same_v<ComputeT, float32_t>
+                                 && (std::is_same_v<InputT, float16_t>
+                                     || std::is_same_v<InputT, bfloat16_t>
+                                     || std::is_same_v<InputT, float32_t>)
+                                 && (std::is_same_v<OutputT, InputT>
+                                     || std::is_same_v<OutputT, float32_t>)>
+        {
+        };
+
     } // namespace quirks
 
     template <typename Layout>
@@ -277,6 +291,35 @@ namespace rocwmma
             fill(mat.data(), m, n);
         }
 
+        // Seeded random fill. Produces the same values as fillRandLaunchKernel
+        // for the same seed; single elements can be regenerated with randFillValue.
+        template <typename DataT>
+        __host__ static inline void fillRand(DataT* mat, uint32_t m, uint32_t n, uint64_t seed)
+        {
+            auto rowMjr = [](uint64_t row, uint64_t col, uint64_t ld) { return row * ld + col; };
+            auto colMjr = [](uint64_t row, uint64_t col, uint64_t ld) { return col * ld + row; };
+
+            auto index = std::is_same<Layout, row_major>::value ? rowMjr : colMjr;
+            auto ld    = std::is_same<Layout, row_major>::value ? n : m;
+
+#pragma omp parallel for
+            for(int i = 0; i < m; ++i) // row
+            {
+                for(int j = 0; j < n; ++j) // col
+                {
+                    mat[index(i, j, ld)] = randFillValue<DataT>(i, j, n, seed);
+                }
+            }
+        }
+
+        template <typename DataT>
+        __host__ static inline void
+            fillRand(std::vector<DataT>& mat, uint32_t m, uint32_t n, uint64_t seed)
+        {
+            assert(mat.size() == n * m);
+            fillRand(mat.data(), m, n, seed);
+        }
+
         template <typename DataT>
         __host__ static inline void fillVal(DataT* mat, uint32_t m, uint32_t n, DataT value)
         {
@@ -326,6 +369,32 @@ namespace rocwmma
                 (fillValKernel<DataT, Layout>), gridDim, blockDim, 0, 0, d_mat, m, n, value);
         }
 
+        // Seeded random fill kernel wrapper for M x N matrix
+        template <typename DataT>
+        __host__ static inline void fillRandLaunchKernel(
+            DataT* d_mat, uint32_t m, uint32_t n, uint64_t seed, hipStream_t stream = 0)
+        {
+            constexpr uint32_t BlockSize = 256u;
+            constexpr uint32_t MaxBlocks = 4096u;
+
+            auto groups
+                = ceilDiv(static_cast<uint64_t>(m) * n, static_cast<uint64_t>(RandFillGroupSize));
+            auto blockDim = dim3(BlockSize, 1, 1);
+            auto gridDim  = dim3(static_cast<uint32_t>(std::min<uint64_t>(
+                                    ceilDiv(groups, static_cast<uint64_t>(BlockSize)), MaxBlocks)),
+                                1,
+                                1);
+            hipLaunchKernelGGL((fillRandKernel<DataT, Layout>),
+                               gridDim,
+                               blockDim,
+                               0,
+                               stream,
+                               d_mat,
+                               m,
+                               n,
+                               seed);
+        }
+
         // fill kernel wrapper for M x N matrix for mat[i] = i
         template <typename DataT>
         __host__ static inline void fillIdxLaunchKernel(DataT* d_mat, uint32_t m, uint32_t n)
@@ -561,7 +630,9 @@ namespace rocwmma
             a.data(), b.data(), m, n, lda, ldb, tolerance);
     }
 
-    // compareEqual kernel wrapper for gemm tests
+    // compareEqual kernel wrapper for gemm tests.
+    // The comparison and max reduction run on the device, and only the max relative
+    // error is copied back to the host.
     template <typename TypeA, typename TypeB, typename LayoutA, typename LayoutB>
     std::pair<bool, double> compareEqualLaunchKernel(
         TypeA* matrixA, TypeB* matrixB, uint32_t m, uint32_t n, double tolerance = 10.0)
@@ -569,20 +640,24 @@ namespace rocwmma
         uint32_t lda = std::is_same<LayoutA, row_major>::value ? n : m;
         uint32_t ldb = std::is_same<LayoutB, row_major>::value ? n : m;
 
-        auto blockDim = dim3(1024, 1, 1);
-        auto gridDim  = dim3(ceilDiv(m * n, blockDim.x), 1, 1);
+        // Each block strides over the matrices, so the grid is capped and one
+        // partial max is kept per block.
+        constexpr uint32_t BlockSize = 256u;
+        constexpr uint32_t MaxBlocks = 1024u;
+
+        auto elements = static_cast<uint64_t>(m) * n;
+        auto blocks   = static_cast<uint32_t>(
+            std::min<uint64_t>(ceilDiv(elements, static_cast<uint64_t>(BlockSize)), MaxBlocks));
+        blocks = std::max(blocks, 1u);
 
         double* d_relativeError;
         double  maxRelativeError;
-        CHECK_HIP_ERROR(hipMalloc(&d_relativeError, m * n * sizeof(double)));
-
-        hipEvent_t syncEvent;
-        CHECK_HIP_ERROR(hipEventCreate(&syncEvent));
+        CHECK_HIP_ERROR(hipMalloc(&d_relativeError, blocks * sizeof(double)));
 
-        // Calculate the relative error for each element of matrix A/B
-        hipLaunchKernelGGL((compareEqualKernel<TypeA, TypeB, LayoutA, LayoutB>),
-                           gridDim,
-                           blockDim,
+        // Max relative error of the elements of each block
+        hipLaunchKernelGGL((compareEqualMaxKernel<BlockSize, TypeA, TypeB, LayoutA, LayoutB>),
+                           dim3(blocks),
+                           dim3(BlockSize),
                            0,
                            0,
                            matrixA,
@@ -592,33 +667,15 @@ namespace rocwmma
                            n,
                            lda,
                            ldb);
-        CHECK_HIP_ERROR(hipEventRecord(syncEvent));
-        CHECK_HIP_ERROR(hipEventSynchronize(syncEvent));
 
-        // Determine the maximum relative error
-        blockDim             = dim3(512, 1, 1);
-        uint32_t maxElements = 1024;
-        uint32_t offset      = 1;
-
-        for(uint32_t i = m * n; i > 1; i = ceilDiv(i, maxElements))
-        {
-            gridDim       = dim3(ceilDiv(i, maxElements), 1, 1);
-            auto elements = i > maxElements ? maxElements : i;
-
-            hipLaunchKernelGGL((maxReduceKernel),
-                               gridDim,
-                               blockDim,
-                               0,
-                               0,
-                               d_relativeError,
-                               elements,
-                               offset,
-                               m * n);
-
-            CHECK_HIP_ERROR(hipEventRecord(syncEvent));
-            CHECK_HIP_ERROR(hipEventSynchronize(syncEvent));
-            offset = offset * maxElements;
-        }
+        // Determine the maximum relative error of all blocks
+        hipLaunchKernelGGL((maxReduceBlockKernel<BlockSize>),
+                           dim3(1),
+                           dim3(BlockSize),
+                           0,
+                           0,
+                           d_relativeError,
+                           blocks);
 
         CHECK_HIP_ERROR(
             hipMemcpy(&maxRelativeError, d_relativeError, sizeof(double), hipMemcpyDeviceToHost));
@@ -646,6 +703,49 @@ namespace rocwmma
         return std::make_pair(retval, maxRelativeError);
     }
 
+    // Reference gemm kernel wrapper for validation: D = alpha * (A x B) + beta * C
+    // with packed leading dimensions. Inputs and output are device pointers.
+    template <typename InputT,
+              typename OutputT,
+              typename ComputeT,
+              typename LayoutA,
+              typename LayoutB,
+              typename LayoutC,
+              typename LayoutD>
+    void gemmReferenceLaunchKernel(uint32_t       m,
+                                   uint32_t       n,
+                                   uint32_t       k,
+                                   InputT const*  d_a,
+                                   InputT const*  d_b,
+                                   OutputT const* d_c,
+                                   OutputT*       d_d,
+                                   ComputeT       alpha,
+                                   ComputeT       beta,
+                                   hipStream_t    stream = 0)
+    {
+        // Threads run along the fast dimension of D
+        auto fastDim  = std::is_same<LayoutD, row_major>::value ? n : m;
+        auto slowDim  = std::is_same<LayoutD, row_major>::value ? m : n;
+        auto blockDim = dim3(256, 1, 1);
+        auto gridDim  = dim3(ceilDiv(fastDim, blockDim.x), slowDim, 1);
+
+        hipLaunchKernelGGL(
+            (gemmReferenceKernel<InputT, OutputT, ComputeT, LayoutA, LayoutB, LayoutC, LayoutD>),
+            gridDim,
+            blockDim,
+            0,
+            stream,
+            m,
+            n,
+            k,
+            d_a,
+            d_b,
+            d_c,
+            d_d,
+            alpha,
+            beta);
+    }
+
     // compareEqual kernel wrapper for batched matrices
     template <typename TypeA, typename TypeB>
     std::pair<bool, double> compareEqualLaunchKernel(
@@ -0,0 +1,103 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+// Reference translation unit for measuring the compile-time cost of the
+// rocWMMA headers. Instantiates a small spread of fragment types through the
+// load / mma / store and cooperative load paths, so that the frontend walks
+// the same metaprogramming as a typical GEMM kernel.
+// Built only by the rocwmma_compile_time_bench target; never linked.
+
+#include <hip/hip_runtime.h>
+
+#include <rocwmma/rocwmma.hpp>
+#include <rocwmma/rocwmma_coop.hpp>
+
+namespace rocwmma
+{
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename InputT,
+              typename ComputeT,
+              typename LayoutA,
+              typename LayoutB,
+              typename LayoutC>
+    __global__ void referenceGemm(uint32_t      k,
+                                  InputT const* a,
+                                  InputT const* b,
+                                  ComputeT*     c,
+                                  uint32_t      lda,
+                                  uint32_t      ldb,
+                                  uint32_t      ldc,
+                                  ComputeT      alpha,
+                                  ComputeT      beta)
+    {
+        using FragA   = fragment<matrix_a, BlockM, BlockN, BlockK, InputT, LayoutA>;
+        using FragB   = fragment<matrix_b, BlockM, BlockN, BlockK, InputT, LayoutB>;
+        using FragAcc = fragment<accumulator, BlockM, BlockN, BlockK, ComputeT>;
+        using FragC   = fragment<accumulator, BlockM, BlockN, BlockK, ComputeT, LayoutC>;
+
+        auto fragA   = FragA();
+        auto fragB   = FragB();
+        auto fragAcc = FragAcc();
+        auto fragC   = FragC();
+
+        fill_fragment(fragAcc, static_cast<ComputeT>(0));
+
+        auto waveIndex = threadIdx.x / Constants::AMDGCN_WAVE_SIZE;
+        auto waveCount = blockDim.x / Constants::AMDGCN_WAVE_SIZE;
+
+        for(uint32_t i = 0; i < k; i += BlockK)
+        {
+            load_matrix_coop_sync(fragA, a + i, lda, waveIndex, waveCount);
+            load_matrix_sync(fragB, b + i, ldb);
+            mma_sync(fragAcc, fragA, fragB, fragAcc);
+        }
+
+        load_matrix_sync(fragC, c, ldc);
+        for(int i = 0; i < fragC.num_elements; ++i)
+        {
+            fragC.x[i] = alpha * fragAcc.x[i] + beta * fragC.x[i];
+        }
+        store_matrix_sync(c, fragC, ldc);
+    }
+
+#define ROCWMMA_REFERENCE_GEMM(BlockM, BlockN, BlockK, InputT, ComputeT, LA, LB, LC) \
+    template __global__ void                                                         \
+        referenceGemm<BlockM, BlockN, BlockK, InputT, ComputeT, LA, LB, LC>(         \
+            uint32_t, InputT const*, InputT const*, ComputeT*, uint32_t, uint32_t,   \
+            uint32_t, ComputeT, ComputeT);
+
+    ROCWMMA_REFERENCE_GEMM(16, 16, 16, float16_t, float32_t, row_major, col_major, row_major)
+    ROCWMMA_REFERENCE_GEMM(16, 16, 32, float16_t, float32_t, col_major, row_major, col_major)
+    ROCWMMA_REFERENCE_GEMM(32, 32, 16, float16_t, float32_t, row_major, row_major, row_major)
+    ROCWMMA_REFERENCE_GEMM(16, 16, 16, bfloat16_t, float32_t, col_major, col_major, row_major)
+    ROCWMMA_REFERENCE_GEMM(32, 32, 8, float32_t, float32_t, row_major, col_major, col_major)
+    ROCWMMA_REFERENCE_GEMM(16, 16, 32, int8_t, int32_t, row_major, col_major, row_major)
+
+#undef ROCWMMA_REFERENCE_GEMM
+
+} // namespace rocwmma
@@ -0,0 +1,354 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+
+#include "common.hpp"
+#include "counter_collector.hpp"
+
+#if ROCWMMA_ROCPROFILER
+#include <rocprofiler-sdk/registration.h>
+#include <rocprofiler-sdk/rocprofiler.h>
+
+#define CHECK_ROCPROFILER_ERROR(expression)                                                    \
+    if(auto status = (expression); status != ROCPROFILER_STATUS_SUCCESS)                       \
+    {                                                                                          \
+        fprintf(stderr,                                                                        \
+                "rocprofiler error: '%s'(%d) at %s:%d\n",                                      \
+                rocprofiler_get_status_string(status),                                         \
+                status,                                                                        \
+                __FILE__,                                                                      \
+                __LINE__);                                                                     \
+    }
+
+namespace
+{
+    using rocwmma::CounterCollector;
+
+    int toolInitialize(rocprofiler_client_finalize_t, void*)
+    {
+        return CounterCollector::instance()->toolInitialize();
+    }
+
+    void toolFinalize(void*)
+    {
+        CounterCollector::instance()->toolFinalize();
+    }
+
+    rocprofiler_tool_configure_result_t*
+        configure(uint32_t, char const*, uint32_t, rocprofiler_client_id_t* clientId)
+    {
+        clientId->name = "rocwmma-counters";
+
+        static auto sResult = rocprofiler_tool_configure_result_t{
+            sizeof(rocprofiler_tool_configure_result_t), &toolInitialize, &toolFinalize, nullptr};
+        return &sResult;
+    }
+
+    void dispatchCallback(rocprofiler_dispatch_counting_service_data_t dispatchData,
+                          rocprofiler_counter_config_id_t*             config,
+                          rocprofiler_user_data_t*,
+                          void*)
+    {
+        CounterCollector::instance()->onDispatch(dispatchData.dispatch_info.agent_id.handle,
+                                                 &config->handle);
+    }
+
+    void recordCallback(rocprofiler_dispatch_counting_service_data_t,
+                        rocprofiler_counter_record_t* records,
+                        size_t                        recordCount,
+                        rocprofiler_user_data_t,
+                        void*)
+    {
+        std::vector<uint64_t> counterIds(recordCount);
+        std::vector<double>   values(recordCount);
+        for(size_t i = 0; i < recordCount; i++)
+        {
+            auto counterId = rocprofiler_counter_id_t{0};
+            rocprofiler_query_record_counter_id(records[i].id, &counterId);
+            counterIds[i] = counterId.handle;
+            values[i]     = records[i].counter_value;
+        }
+        CounterCollector::instance()->onRecords(counterIds.data(), values.data(), recordCount);
+    }
+
+    std::string counterName(uint64_t counterId)
+    {
+        auto info = rocprofiler_counter_info_v0_t{};
+        if(rocprofiler_query_counter_info(rocprofiler_counter_id_t{counterId},
+                                          ROCPROFILER_COUNTER_INFO_VERSION_0,
+                                          static_cast<void*>(&info))
+           != ROCPROFILER_STATUS_SUCCESS)
+        {
+            return "";
+        }
+        return info.name;
+    }
+
+    // Collects the counter ids of an agent by name
+    rocprofiler_status_t supportedCallback(rocprofiler_agent_id_t,
+                                           rocprofiler_counter_id_t* counters,
+                                           size_t                    count,
+                                           void*                     data)
+    {
+        auto& supported = *static_cast<std::map<std::string, uint64_t>*>(data);
+        for(size_t i = 0; i < count; i++)
+        {
+            supported[counterName(counters[i].handle)] = counters[i].handle;
+        }
+        return ROCPROFILER_STATUS_SUCCESS;
+    }
+
+} // namespace
+
+#endif // ROCWMMA_ROCPROFILER
+
+namespace rocwmma
+{
+    std::vector<std::string> const& CounterCollector::defaultCounters()
+    {
+        static std::vector<std::string> const sDefaults = {
+            "MfmaUtil", "VALUBusy", "LDSBankConflict", "L2CacheHit", "FETCH_SIZE", "WRITE_SIZE"};
+        return sDefaults;
+    }
+
+    std::vector<std::string> CounterCollector::parseCounters(std::string const& list)
+    {
+        if(list == "default")
+        {
+            return defaultCounters();
+        }
+
+        std::vector<std::string> names;
+        std::stringstream        listStream(list);
+        std::string              name;
+        while(std::getline(listStream, name, ','))
+        {
+            if(!name.empty())
+            {
+                names.push_back(name);
+            }
+        }
+        return names;
+    }
+
+    CounterCollector::CounterCollector()
+        : mEnabled(false)
+        , mContext(0u)
+        , mPass(0u)
+        , mCollecting(false)
+    {
+    }
+
+    CounterCollector::~CounterCollector() = default;
+
+    bool CounterCollector::initialize(std::vector<std::string> const& names)
+    {
+#if ROCWMMA_ROCPROFILER
+        mNames = names;
+        CHECK_ROCPROFILER_ERROR(rocprofiler_force_configure(&configure));
+        return true;
+#else
+        (void)names;
+        return false;
+#endif // ROCWMMA_ROCPROFILER
+    }
+
+    bool CounterCollector::enabled() const
+    {
+        return mEnabled;
+    }
+
+    std::vector<std::string> const& CounterCollector::names() const
+    {
+        return mNames;
+    }
+
+    CounterValues CounterCollector::collect(std::function<void()> const& launch)
+    {
+        CounterValues result;
+        if(!mEnabled)
+        {
+            return result;
+        }
+
+#if ROCWMMA_ROCPROFILER
+        auto context = rocprofiler_context_id_t{mContext};
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mValues.clear();
+        }
+
+        // The pass count is known once the first dispatch has resolved its agent
+        uint32_t passes = 1u;
+        for(uint32_t pass = 0u; pass < passes; pass++)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                mPass       = pass;
+                mCollecting = true;
+            }
+
+            CHECK_ROCPROFILER_ERROR(rocprofiler_start_context(context));
+            launch();
+            CHECK_HIP_ERROR(hipDeviceSynchronize());
+            CHECK_ROCPROFILER_ERROR(rocprofiler_stop_context(context));
+
+            std::lock_guard<std::mutex> lock(mMutex);
+            mCollecting = false;
+            for(auto const& agentPasses : mAgentPasses)
+            {
+                passes = std::max(passes, static_cast<uint32_t>(agentPasses.second.size()));
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        for(auto const& name : mNames)
+        {
+            if(auto it = mValues.find(name); it != mValues.end())
+            {
+                result.emplace_back(name, it->second);
+            }
+        }
+#else
+        (void)launch;
+#endif // ROCWMMA_ROCPROFILER
+
+        return result;
+    }
+
+    int CounterCollector::toolInitialize()
+    {
+#if ROCWMMA_ROCPROFILER
+        auto context = rocprofiler_context_id_t{0};
+        if(rocprofiler_create_context(&context) != ROCPROFILER_STATUS_SUCCESS
+           || rocprofiler_configure_callback_dispatch_counting_service(
+                  context, &dispatchCallback, nullptr, &recordCallback, nullptr)
+                  != ROCPROFILER_STATUS_SUCCESS)
+        {
+            std::cerr << "Unable to configure rocprofiler counter collection\n";
+            return -1;
+        }
+
+        mContext = context.handle;
+        mEnabled = !mNames.empty();
+#endif // ROCWMMA_ROCPROFILER
+        return 0;
+    }
+
+    void CounterCollector::toolFinalize()
+    {
+        mEnabled = false;
+    }
+
+    void CounterCollector::onDispatch(uint64_t agent, uint64_t* config)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if(!mCollecting)
+        {
+            return;
+        }
+
+        // Dispatches beyond the pass count of their agent are not counted
+        auto const& passes = agentPasses(agent);
+        if(mPass < passes.size())
+        {
+            *config = passes[mPass];
+        }
+    }
+
+    void CounterCollector::onRecords(uint64_t const* counterIds, double const* values, size_t count)
+    {
+#if ROCWMMA_ROCPROFILER
+        std::lock_guard<std::mutex> lock(mMutex);
+        for(size_t i = 0; i < count; i++)
+        {
+            mValues[counterName(counterIds[i])] += values[i];
+        }
+#else
+        (void)counterIds;
+        (void)values;
+        (void)count;
+#endif // ROCWMMA_ROCPROFILER
+    }
+
+    std::vector<uint64_t> const& CounterCollector::agentPasses(uint64_t agent)
+    {
+        if(auto it = mAgentPasses.find(agent); it != mAgentPasses.end())
+        {
+            return it->second;
+        }
+
+        auto& passes = mAgentPasses[agent];
+
+#if ROCWMMA_ROCPROFILER
+        // Match the requested names against the counters of the agent
+        std::map<std::string, uint64_t> supported;
+        rocprofiler_iterate_agent_supported_counters(
+            rocprofiler_agent_id_t{agent}, &supportedCallback, static_cast<void*>(&supported));
+
+        std::vector<rocprofiler_counter_id_t> counters;
+        for(auto const& name : mNames)
+        {
+            if(auto it = supported.find(name); it != supported.end())
+            {
+                counters.push_back({it->second});
+            }
+            else
+            {
+                std::cerr << "Counter not supported on this device: " << name << "\n";
+            }
+        }
+
+        // All counters in a single pass if they fit the hardware, otherwise one pass each
+        auto config = rocprofiler_counter_config_id_t{0};
+        if(!counters.empty()
+           && rocprofiler_create_counter_config(
+                  rocprofiler_agent_id_t{agent}, counters.data(), counters.size(), &config)
+                  == ROCPROFILER_STATUS_SUCCESS)
+        {
+            passes.push_back(config.handle);
+        }
+        else
+        {
+            for(auto& counter : counters)
+            {
+                if(rocprofiler_create_counter_config(
+                       rocprofiler_agent_id_t{agent}, &counter, 1u, &config)
+                   == ROCPROFILER_STATUS_SUCCESS)
+                {
+                    passes.push_back(config.handle);
+                }
+            }
+        }
+#endif // ROCWMMA_ROCPROFILER
+
+        return passes;
+    }
+
+} // namespace rocwmma
@@ -0,0 +1,121 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef ROCWMMA_TEST_COUNTER_COLLECTOR_HPP
+#define ROCWMMA_TEST_COUNTER_COLLECTOR_HPP
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "singleton.hpp"
+
+// Counter collection is compiled out unless building with -DROCWMMA_BUILD_WITH_ROCPROFILER=ON
+#if !defined(ROCWMMA_ROCPROFILER)
+#define ROCWMMA_ROCPROFILER 0
+#endif // !defined(ROCWMMA_ROCPROFILER)
+
+// The CounterCollector class reads hardware counters of benchmarked kernels through the
+// rocprofiler-sdk dispatch counting service. The counter set is chosen on the command line
+// and registered before the HIP runtime starts; collection is only enabled around the
+// dedicated counter runs, so the timed runs are not perturbed.
+// Counters that do not fit the hardware counter slots together are collected over several
+// passes, one dispatch per pass. Values are summed over all instances (XCDs, SEs, channels)
+// of a counter, or are the derived metric as defined by rocprofiler-sdk.
+
+namespace rocwmma
+{
+    // Counter values of one kernel, in the order of the configured counter names
+    using CounterValues = std::vector<std::pair<std::string, double>>;
+
+    inline CounterValues::const_iterator findCounter(CounterValues const& values,
+                                                     std::string const&   name)
+    {
+        return std::find_if(values.begin(), values.end(), [&name](auto const& value) {
+            return value.first == name;
+        });
+    }
+
+    class CounterCollector : public LazySingleton<CounterCollector>
+    {
+    public:
+        // For static initialization
+        friend std::unique_ptr<CounterCollector> std::make_unique<CounterCollector>();
+
+        // Default counter set: MFMA busy, VALU utilization, LDS bank conflicts,
+        // L2 hit rate and HBM read / write kilobytes.
+        static std::vector<std::string> const& defaultCounters();
+
+        // Counter names of a comma separated list, or the default set for "default"
+        static std::vector<std::string> parseCounters(std::string const& list);
+
+    protected:
+        CounterCollector();
+
+    public:
+        ~CounterCollector();
+
+        // Registers the counter set with rocprofiler-sdk. Must be called before the
+        // first HIP call of the process. Returns false if not built with rocprofiler-sdk.
+        bool initialize(std::vector<std::string> const& names);
+
+        bool enabled() const;
+
+        std::vector<std::string> const& names() const;
+
+        // Runs launch once per counter pass, synchronizing after each, and returns the
+        // counter values of the launched kernel. Counters that the device does not
+        // support are missing from the result.
+        CounterValues collect(std::function<void()> const& launch);
+
+        // rocprofiler-sdk tool callbacks
+        int  toolInitialize();
+        void toolFinalize();
+        void onDispatch(uint64_t agent, uint64_t* config);
+        void onRecords(uint64_t const* counterIds, double const* values, size_t count);
+
+    private:
+        // Counter configurations of one agent, one per pass
+        std::vector<uint64_t> const& agentPasses(uint64_t agent);
+
+        std::vector<std::string> mNames;
+        bool                     mEnabled;
+        uint64_t                 mContext;
+        uint32_t                 mPass;
+        bool                     mCollecting;
+
+        std::map<uint64_t, std::vector<uint64_t>> mAgentPasses;
+        std::map<std::string, double>             mValues;
+        mutable std::mutex                        mMutex;
+    };
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_TEST_COUNTER_COLLECTOR_HPP
@@ -30,6 +30,8 @@
 #include <rocwmma/internal/types.hpp>
 #include <rocwmma/rocwmma.hpp>
 
+#include "philox.hpp"
+
 namespace rocwmma
 {
     template <typename T>
@@ -125,6 +127,155 @@ namespace rocwmma
         }
     }
 
+    // Block-wide max of one value per thread, left in sMax[0]. BlockSize must be a power of 2.
+    template <uint32_t BlockSize>
+    __device__ inline void blockMaxReduce(float64_t* sMax, float64_t value)
+    {
+        sMax[threadIdx.x] = value;
+        synchronize_workgroup();
+
+        for(uint32_t i = BlockSize >> 1; i > 0; i = i >> 1)
+        {
+            if(threadIdx.x < i)
+            {
+                sMax[threadIdx.x] = maxDouble(sMax[threadIdx.x], sMax[threadIdx.x + i]);
+            }
+            synchronize_workgroup();
+        }
+    }
+
+    // Fused comparison of two M x N matrices as used in gemm tests.
+    // Each block strides over the matrices and writes the max relative error
+    // of its elements to blockMaxError[blockIdx.x], so that only one value per
+    // block is kept on the device.
+    template <uint32_t BlockSize, typename TypeA, typename TypeB, typename LayoutA, typename LayoutB>
+    __global__ void __launch_bounds__(BlockSize) compareEqualMaxKernel(TypeA const* matrixA,
+                                                                       TypeB const* matrixB,
+                                                                       float64_t*   blockMaxError,
+                                                                       uint32_t     m,
+                                                                       uint32_t     n,
+                                                                       uint32_t     lda,
+                                                                       uint32_t     ldb)
+    {
+        __shared__ float64_t sMax[BlockSize];
+
+        auto threadMax = 0.0;
+        auto elements  = static_cast<uint64_t>(m) * n;
+        for(uint64_t idx = static_cast<uint64_t>(blockIdx.x) * BlockSize + threadIdx.x;
+            idx < elements;
+            idx += static_cast<uint64_t>(gridDim.x) * BlockSize)
+        {
+            // Iterate in the fast dimension of A for coalesced reads
+            uint64_t rowIdx = std::is_same<LayoutA, row_major>::value ? idx / n : idx % m;
+            uint64_t colIdx = std::is_same<LayoutA, row_major>::value ? idx % n : idx / m;
+
+            uint64_t indexA = std::is_same<LayoutA, row_major>::value ? rowIdx * lda + colIdx
+                                                                      : colIdx * lda + rowIdx;
+            uint64_t indexB = std::is_same<LayoutB, row_major>::value ? rowIdx * ldb + colIdx
+                                                                      : colIdx * ldb + rowIdx;
+
+            auto valA = toDouble(matrixA[indexA]);
+            auto valB = toDouble(matrixB[indexB]);
+
+            // Same relative error as compareEqualKernel
+            auto numerator = fabs(valA - valB);
+            auto divisor   = fabs(valA) + fabs(valB) + 1.0;
+            auto relativeError
+                = std::isinf(numerator) || std::isinf(divisor)
+                      ? std::numeric_limits<float64_t>::infinity()
+                      : (std::isnan(numerator) || std::isnan(divisor)
+                             ? std::numeric_limits<float64_t>::signaling_NaN()
+                             : numerator / divisor);
+
+            threadMax = maxDouble(threadMax, relativeError);
+        }
+
+        blockMaxReduce<BlockSize>(sMax, threadMax);
+        if(threadIdx.x == 0)
+        {
+            blockMaxError[blockIdx.x] = sMax[0];
+        }
+    }
+
+    // Single block max of count values, written to values[0]
+    template <uint32_t BlockSize>
+    __global__ void __launch_bounds__(BlockSize) maxReduceBlockKernel(float64_t* values,
+                                                                      uint32_t   count)
+    {
+        __shared__ float64_t sMax[BlockSize];
+
+        auto threadMax = 0.0;
+        for(uint32_t i = threadIdx.x; i < count; i += BlockSize)
+        {
+            threadMax = maxDouble(threadMax, values[i]);
+        }
+
+        blockMaxReduce<BlockSize>(sMax, threadMax);
+        if(threadIdx.x == 0)
+        {
+            values[0] = sMax[0];
+        }
+    }
+
+    // Reference gemm kernel for validation: D = alpha * (A x B) + beta * C.
+    // One thread computes one element of D with a sequential K loop in ComputeT,
+    // accumulating in the same order as gemm_CPU. Threads are mapped along the
+    // fast dimension of D for coalesced writes.
+    template <typename InputT,
+              typename OutputT,
+              typename ComputeT,
+              typename LayoutA,
+              typename LayoutB,
+              typename LayoutC,
+              typename LayoutD>
+    __global__ void gemmReferenceKernel(uint32_t       m,
+                                        uint32_t       n,
+                                        uint32_t       k,
+                                        InputT const*  a,
+                                        InputT const*  b,
+                                        OutputT const* c,
+                                        OutputT*       d,
+                                        ComputeT       alpha,
+                                        ComputeT       beta)
+    {
+        constexpr bool isRowMjrD = std::is_same<LayoutD, row_major>::value;
+
+        uint64_t fastIdx = static_cast<uint64_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+        uint64_t slowIdx = blockIdx.y;
+        uint64_t rowIdx  = isRowMjrD ? slowIdx : fastIdx;
+        uint64_t colIdx  = isRowMjrD ? fastIdx : slowIdx;
+
+        if(rowIdx >= m || colIdx >= n)
+        {
+            return;
+        }
+
+        uint64_t lda = std::is_same<LayoutA, row_major>::value ? k : m;
+        uint64_t ldb = std::is_same<LayoutB, row_major>::value ? n : k;
+        uint64_t ldc = std::is_same<LayoutC, row_major>::value ? n : m;
+        uint64_t ldd = isRowMjrD ? n : m;
+
+        // Strides of A along K, and of B along K
+        uint64_t strideA = std::is_same<LayoutA, row_major>::value ? 1u : lda;
+        uint64_t strideB = std::is_same<LayoutB, row_major>::value ? ldb : 1u;
+
+        auto* aPtr = a + (std::is_same<LayoutA, row_major>::value ? rowIdx * lda : rowIdx);
+        auto* bPtr = b + (std::is_same<LayoutB, row_major>::value ? colIdx : colIdx * ldb);
+
+        ComputeT accum = static_cast<ComputeT>(0);
+        for(uint32_t h = 0; h < k; ++h)
+        {
+            accum += static_cast<ComputeT>(aPtr[h * strideA])
+                     * static_cast<ComputeT>(bPtr[h * strideB]);
+        }
+
+        uint64_t indexC = std::is_same<LayoutC, row_major>::value ? rowIdx * ldc + colIdx
+                                                                  : colIdx * ldc + rowIdx;
+        uint64_t indexD = isRowMjrD ? rowIdx * ldd + colIdx : colIdx * ldd + rowIdx;
+
+        d[indexD] = static_cast<OutputT>(alpha * accum + beta * static_cast<ComputeT>(c[indexC]));
+    }
+
     // Comparitive kernel for batched matrix outputs as used in DLRM tests
     // Compares all values of two M x N matrices over B batches
     template <typename TypeA, typename TypeB>
@@ -291,6 +442,43 @@ namespace rocwmma
             mat[index] = index % 64;
         }
     }
+
+    // Random fill kernel for M x N matrix. Each thread generates one Philox
+    // group of consecutive logical elements per iteration of a grid-stride
+    // loop. Values depend only on (seed, row, col): see randFillValue.
+    template <typename DataT, typename Layout>
+    __global__ void fillRandKernel(DataT* mat, uint32_t m, uint32_t n, uint64_t seed)
+    {
+        auto ld = std::is_same<Layout, row_major>::value ? n : m;
+
+        auto const elements = static_cast<uint64_t>(m) * n;
+        auto const groups   = (elements + RandFillGroupSize - 1u) / RandFillGroupSize;
+        auto const stride   = static_cast<uint64_t>(gridDim.x) * blockDim.x;
+
+        for(uint64_t group = static_cast<uint64_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+            group < groups;
+            group += stride)
+        {
+            auto     rand                     = Philox4x32::generate(seed, group);
+            uint32_t words[RandFillGroupSize] = {rand.x, rand.y, rand.z, rand.w};
+
+#pragma unroll
+            for(uint32_t i = 0; i < RandFillGroupSize; ++i)
+            {
+                auto elementIdx = group * RandFillGroupSize + i;
+                if(elementIdx < elements)
+                {
+                    auto rowIdx = elementIdx / n;
+                    auto colIdx = elementIdx % n;
+                    auto index  = std::is_same<Layout, row_major>::value
+                                      ? rowIdx * static_cast<uint64_t>(ld) + colIdx
+                                      : colIdx * static_cast<uint64_t>(ld) + rowIdx;
+
+                    mat[index] = randFillValue<DataT>(words[i]);
+                }
+            }
+        }
+    }
 } // namespace rocwmma
 
 #endif // ROCWMMA_TEST_DEVICE_COMMON_HPP
@@ -0,0 +1,70 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef ROCWMMA_TEST_DEVICE_PHILOX_HPP
+#define ROCWMMA_TEST_DEVICE_PHILOX_HPP
+
+#include <type_traits>
+
+#include <rocwmma/internal/philox.hpp>
+#include <rocwmma/internal/types.hpp>
+
+namespace rocwmma
+{
+    // Counter-based generator shared with the library, so that any element
+    // of a randomly filled matrix can be regenerated on the host or device.
+    using Philox4x32 = detail::Philox4x32;
+
+    // Random fill values are drawn per 4-element group of the logical
+    // (row-major) element index, so results are independent of storage layout.
+    constexpr static uint32_t RandFillGroupSize = 4u;
+
+    // Map a random word to a small integer in [-4, 4] (or [0, 4] for unsigned
+    // types). Small integers are exact in every rocWMMA data type, including
+    // f8 / bf8, so GEMM results remain exactly reproducible.
+    template <typename DataT>
+    __host__ __device__ inline DataT randFillValue(uint32_t word)
+    {
+        auto value = word % 5u;
+        return (((word >> 16u) & 0x1u) && std::is_signed<DataT>::value)
+                   ? -static_cast<DataT>(value)
+                   : static_cast<DataT>(value);
+    }
+
+    // Regenerate a single element of an M x N matrix filled with the given seed.
+    template <typename DataT>
+    __host__ __device__ inline DataT
+        randFillValue(uint32_t row, uint32_t col, uint32_t n, uint64_t seed)
+    {
+        auto elementIdx = static_cast<uint64_t>(row) * n + col;
+        auto rand       = Philox4x32::generate(seed, elementIdx / RandFillGroupSize);
+        uint32_t words[RandFillGroupSize] = {rand.x, rand.y, rand.z, rand.w};
+        return randFillValue<DataT>(words[elementIdx % RandFillGroupSize]);
+    }
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_TEST_DEVICE_PHILOX_HPP
@@ -0,0 +1,305 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef ROCWMMA_TEST_DEVICE_SHARDS_HPP
+#define ROCWMMA_TEST_DEVICE_SHARDS_HPP
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <hip/hip_runtime_api.h>
+
+#include "common.hpp"
+#include "rocwmma_logging.hpp"
+
+extern char** environ;
+
+namespace rocwmma
+{
+    // Runs the gtest cases of the current executable on several devices at once.
+    // One worker process per device re-runs the executable with the same arguments,
+    // HIP_VISIBLE_DEVICES restricted to its device and gtest sharding splitting the
+    // test cases round robin between the workers, so that the parameterized cases
+    // of a suite spread evenly. When all workers finish, their console output is
+    // printed in shard order with the total test counts, and the output stream,
+    // benchmark output and tuning table files of the workers are merged.
+    class DeviceShards
+    {
+    public:
+        // Worker count for the requested count, where 0 requests all visible devices
+        static uint32_t count(int requested)
+        {
+            int deviceCount = 0;
+            CHECK_HIP_ERROR(hipGetDeviceCount(&deviceCount));
+            return (requested == 0) ? static_cast<uint32_t>(deviceCount)
+                                    : static_cast<uint32_t>(std::min(requested, deviceCount));
+        }
+
+        // Runs the workers and returns the exit status of the whole run
+        static int run(int argc, char** argv, uint32_t shards)
+        {
+            auto devices = visibleDevices(shards);
+            auto tmpDir  = std::filesystem::temp_directory_path();
+
+            std::vector<pid_t>       workers(shards, -1);
+            std::vector<std::string> logFiles(shards);
+            for(uint32_t shard = 0; shard < shards; ++shard)
+            {
+                logFiles[shard] = (tmpDir
+                                   / ("rocwmma_" + std::to_string(getpid()) + "_shard"
+                                      + std::to_string(shard) + ".log"))
+                                      .string();
+                workers[shard] = spawn(workerArgs(argc, argv, shard),
+                                       workerEnv(devices[shard], shard, shards),
+                                       logFiles[shard]);
+            }
+
+            // Merged report in shard order
+            std::vector<int> exitCodes(shards, -1);
+
+            int      status = EXIT_SUCCESS;
+            uint32_t passed = 0u, failed = 0u, skipped = 0u;
+            for(uint32_t shard = 0; shard < shards; ++shard)
+            {
+                int waitStatus = 0;
+                if(workers[shard] > 0 && waitpid(workers[shard], &waitStatus, 0) > 0
+                   && WIFEXITED(waitStatus))
+                {
+                    exitCodes[shard] = WEXITSTATUS(waitStatus);
+                }
+
+                std::cout << "[ SHARD " << shard << " ] device " << devices[shard] << std::endl;
+                std::ifstream log(logFiles[shard]);
+                std::string   line;
+                while(std::getline(log, line))
+                {
+                    std::cout << line << "\n";
+                    countTests(line, "[  PASSED  ] %u test", passed);
+                    countTests(line, "[  FAILED  ] %u test", failed);
+                    countTests(line, "[  SKIPPED ] %u test", skipped);
+                }
+                log.close();
+                std::filesystem::remove(logFiles[shard]);
+
+                if(exitCodes[shard] != EXIT_SUCCESS)
+                {
+                    status = EXIT_FAILURE;
+                }
+            }
+
+            auto& loggingOptions = RocwmmaLogging::instance();
+            mergeFiles(loggingOptions->outputStreamFile(), shards, false);
+            mergeFiles(loggingOptions->benchOutputFile(), shards, false);
+
+            // Tuning tables merge the fastest entries on load, so the workers'
+            // tables are appended to any previous results
+            mergeFiles(loggingOptions->tuningTableFile(), shards, true);
+
+            std::cout << "[ SHARDS ] " << shards << " devices: " << passed << " passed, " << failed
+                      << " failed, " << skipped << " skipped" << std::endl;
+            for(uint32_t shard = 0; shard < shards; ++shard)
+            {
+                std::cout << "[ SHARD " << shard << " ] device " << devices[shard]
+                          << ", exit status " << exitCodes[shard] << std::endl;
+            }
+
+            return status;
+        }
+
+    private:
+        // Device of each worker, as selected through HIP_VISIBLE_DEVICES. Devices
+        // already restricted by the environment are picked from its list.
+        static std::vector<std::string> visibleDevices(uint32_t shards)
+        {
+            std::vector<std::string> devices;
+            if(auto env = std::getenv("HIP_VISIBLE_DEVICES"); env != nullptr && *env != '\0')
+            {
+                std::stringstream list(env);
+                std::string       device;
+                while(std::getline(list, device, ','))
+                {
+                    devices.push_back(device);
+                }
+            }
+            for(uint32_t i = static_cast<uint32_t>(devices.size()); i < shards; ++i)
+            {
+                devices.push_back(std::to_string(i));
+            }
+            devices.resize(shards);
+            return devices;
+        }
+
+        // Per shard output file, keeping the extension that selects its format
+        static std::string shardFileName(std::string const& fileName, uint32_t shard)
+        {
+            std::filesystem::path path(fileName);
+            auto shardName = path.stem().string() + ".shard" + std::to_string(shard)
+                             + path.extension().string();
+            return (path.parent_path() / shardName).string();
+        }
+
+        // The same arguments, writing to per shard output files
+        static std::vector<std::string> workerArgs(int argc, char** argv, uint32_t shard)
+        {
+            std::vector<std::string> args = {argv[0]};
+            for(int i = 1; i < argc; ++i)
+            {
+                std::string arg = argv[i];
+                if(arg == "-sd" || arg == "--shard_devices" || arg == "-d" || arg == "--device")
+                {
+                    i++;
+                    continue;
+                }
+
+                args.push_back(arg);
+                if((arg == "-os" || arg == "--output_stream" || arg == "-bo"
+                    || arg == "--bench_output" || arg == "-tt" || arg == "--tuning_table")
+                   && i + 1 < argc)
+                {
+                    args.push_back(shardFileName(argv[++i], shard));
+                }
+            }
+            return args;
+        }
+
+        static std::vector<std::string>
+            workerEnv(std::string const& device, uint32_t shard, uint32_t shards)
+        {
+            std::vector<std::string> env;
+            for(auto var = environ; *var != nullptr; ++var)
+            {
+                std::string entry = *var;
+                if(entry.rfind("HIP_VISIBLE_DEVICES=", 0) != 0
+                   && entry.rfind("GTEST_TOTAL_SHARDS=", 0) != 0
+                   && entry.rfind("GTEST_SHARD_INDEX=", 0) != 0)
+                {
+                    env.push_back(entry);
+                }
+            }
+            env.push_back("HIP_VISIBLE_DEVICES=" + device);
+            env.push_back("GTEST_TOTAL_SHARDS=" + std::to_string(shards));
+            env.push_back("GTEST_SHARD_INDEX=" + std::to_string(shard));
+            return env;
+        }
+
+        // Spawns a worker re-running this executable, with its console output
+        // redirected to the log file. posix_spawn is safe after HIP has started
+        // its threads, where fork is not.
+        static pid_t spawn(std::vector<std::string> const& args,
+                           std::vector<std::string> const& env,
+                           std::string const&              logFile)
+        {
+            auto toArgv = [](std::vector<std::string> const& strings) {
+                std::vector<char*> result;
+                for(auto const& s : strings)
+                {
+                    result.push_back(const_cast<char*>(s.c_str()));
+                }
+                result.push_back(nullptr);
+                return result;
+            };
+            auto workerArgv = toArgv(args);
+            auto workerEnvp = toArgv(env);
+
+            posix_spawn_file_actions_t actions;
+            posix_spawn_file_actions_init(&actions);
+            posix_spawn_file_actions_addopen(
+                &actions, STDOUT_FILENO, logFile.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            posix_spawn_file_actions_adddup2(&actions, STDOUT_FILENO, STDERR_FILENO);
+
+            pid_t pid    = -1;
+            auto  result = posix_spawn(
+                &pid, "/proc/self/exe", &actions, nullptr, workerArgv.data(), workerEnvp.data());
+            posix_spawn_file_actions_destroy(&actions);
+
+            if(result != 0)
+            {
+                std::cerr << "Unable to spawn shard worker: " << std::strerror(result) << std::endl;
+                return -1;
+            }
+            return pid;
+        }
+
+        // Accumulates the count of a gtest summary line
+        static void countTests(std::string const& line, char const* format, uint32_t& total)
+        {
+            uint32_t count = 0u;
+            if(std::sscanf(line.c_str(), format, &count) == 1)
+            {
+                total += count;
+            }
+        }
+
+        // Concatenates the shard files into fileName and removes them. Leading
+        // lines repeating the first line written, such as CSV headers, are dropped.
+        static void mergeFiles(std::string const& fileName, uint32_t shards, bool append)
+        {
+            if(fileName.empty())
+            {
+                return;
+            }
+
+            std::ofstream merged(fileName, append ? std::ios::app : std::ios::trunc);
+            std::string   header;
+            for(uint32_t shard = 0; shard < shards; ++shard)
+            {
+                auto          shardFile = shardFileName(fileName, shard);
+                std::ifstream input(shardFile);
+                std::string   line;
+                for(bool firstLine = true; std::getline(input, line); firstLine = false)
+                {
+                    if(header.empty())
+                    {
+                        header = line;
+                    }
+                    else if(firstLine && line == header)
+                    {
+                        continue;
+                    }
+                    merged << line << "\n";
+                }
+                input.close();
+                std::filesystem::remove(shardFile);
+            }
+        }
+    };
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_TEST_DEVICE_SHARDS_HPP
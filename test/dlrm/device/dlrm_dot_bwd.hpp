@@ -87,7 +87,8 @@ namespace rocwmma
                                                          uint b,
                                                          uint inputBatchOffset,
                                                          uint upstreamBatchOffset,
-                                                         uint accBatchOffset)
+                                                         uint accBatchOffset,
+                                                         float32_t outputScale)
     {
         using TileMapping = MappingUtil<TILE_DIM, TILE_DIM, DataT, row_major>;
 
@@ -163,7 +164,7 @@ namespace rocwmma
 #pragma unroll
             for(int i = 0; i < fragC.num_elements; i++)
             {
-                fragC.x[i] = static_cast<DataT>(fragAcc.x[i]);
+                fragC.x[i] = static_cast<DataT>(fragAcc.x[i] * outputScale);
             }
 
             // Store the output
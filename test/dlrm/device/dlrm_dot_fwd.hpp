@@ -43,7 +43,8 @@ namespace rocwmma
                                                          uint       b,
                                                          uint       inputBatchOffset,
                                                          uint       outputBatchOffset,
-                                                         uint       accBatchOffset)
+                                                         uint       accBatchOffset,
+                                                         float32_t  outputScale)
     {
         using MappingA   = MappingUtil<TILE_DIM, TILE_DIM, DataT, row_major>;
         using MappingB   = MappingUtil<TILE_DIM, TILE_DIM, DataT, col_major>;
@@ -129,7 +130,8 @@ namespace rocwmma
                     auto outputOffset = k + ((globalRowIdx * (globalRowIdx - 1)) >> 1);
                     output[outputBatchOffset * blockIdx.z + outputOffset + globalColIdx]
                         = static_cast<DataT>(
-                            acc[accBatchOffset * blockIdx.z + globalRowIdx * m + globalColIdx]);
+                            acc[accBatchOffset * blockIdx.z + globalRowIdx * m + globalColIdx]
+                            * outputScale);
                 }
             }
         }
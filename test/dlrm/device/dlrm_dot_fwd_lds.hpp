@@ -42,7 +42,8 @@ namespace rocwmma
                                                             uint       b,
                                                             uint       inputBatchOffset,
                                                             uint       outputBatchOffset,
-                                                            uint       accBatchOffset)
+                                                            uint       accBatchOffset,
+                                                            float32_t  outputScale)
     {
         using MappingA   = MappingUtil<TILE_DIM, TILE_DIM, DataT, row_major>;
         using MappingB   = MappingUtil<TILE_DIM, TILE_DIM, DataT, col_major>;
@@ -181,7 +182,8 @@ namespace rocwmma
                 {
                     auto outputOffset = k + ((globalRowIdx * (globalRowIdx - 1)) >> 1);
                     output[outputBatchOffset * blockIdx.z + outputOffset + globalColIdx]
-                        = static_cast<DataT>(ldsWavePtrAcc[fragRowIdx * TILE_DIM + fragColIdx]);
+                        = static_cast<DataT>(ldsWavePtrAcc[fragRowIdx * TILE_DIM + fragColIdx]
+                                             * outputScale);
                 }
             }
         }
@@ -33,6 +33,7 @@
 
 #include <rocwmma/internal/constants.hpp>
 
+#include "benchmark_log.hpp"
 #include "common.hpp"
 #include "dlrm_resource.hpp"
 #include "hip_device.hpp"
@@ -101,7 +102,8 @@ namespace rocwmma
                                        uint32_t, // b
                                        uint32_t, // inputBatchOffset
                                        uint32_t, // outputBatchOffset
-                                       uint32_t); // accBatchOffset
+                                       uint32_t, // accBatchOffset
+                                       float32_t); // outputScale
 
         // Interface to backwards device kernels
         using KernelBwdFunc = void (*)(const DataT* __restrict, // input
@@ -114,7 +116,8 @@ namespace rocwmma
                                        uint32_t, // b
                                        uint32_t, // inputBatchOffset
                                        uint32_t, // upstreamBatchOffset
-                                       uint32_t); // accBatchOffset
+                                       uint32_t, // accBatchOffset
+                                       float32_t); // outputScale
 
         using KernelTrilFunc = void (*)(const DataT* __restrict, // upstreamGrad
                                         DataT* __restrict, // acc
@@ -148,6 +151,9 @@ namespace rocwmma
         // Reset all members to default values
         virtual void reset();
 
+        // Readable kernel config and problem, naming the ROCTX ranges of the workflow
+        std::string roctxTag() const;
+
     public:
         // KernelI interface fulfillment
         virtual void          setup(ProblemParams const& problem) override;
@@ -167,6 +173,10 @@ namespace rocwmma
         // Padded problem params
         uint32_t mMPadded, mKPadded;
 
+        // Scale of the accumulators narrowed to DataT.
+        // 8-bit float outputs are scaled into range, other types are not.
+        float32_t mOutputScale;
+
         // Execution flow control
         uint32_t mRepeats;
         bool     mRunFlag          = true;
@@ -176,9 +186,24 @@ namespace rocwmma
         DlrmDirection_t passDirection = DlrmDirection_t::Forward;
 
         // Performance
-        float64_t mTotalGFlops, mMeasuredTFlopsPerSec;
-        float64_t mElapsedTimeMs;
-        int32_t   mEfficiency;
+        float64_t   mTotalGFlops, mMeasuredTFlopsPerSec;
+        float64_t   mElapsedTimeMs;
+        int32_t     mEfficiency;
+        float64_t   mRoofTFlopsPerSec;
+        bool        mMemoryBound;
+        TimingStats mTiming;
+
+        // Throughput: samples of the batch and compulsory traffic per second
+        float64_t mSamplesPerSec;
+        float64_t mMeasuredGBytesPerSec;
+
+        // hipGraph replay of the repeats
+        bool      mGraphLaunch;
+        float64_t mGraphElapsedTimeMs;
+        float64_t mGraphSavings;
+
+        // Hardware counters of the kernel, through rocprofiler-sdk
+        CounterValues mCounters;
     };
 
 } // namespace rocwmma
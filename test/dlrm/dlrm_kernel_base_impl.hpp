@@ -46,8 +46,12 @@
 
 #include "../common.hpp"
 #include "./common.hpp"
+#include "counter_collector.hpp"
 #include "dlrm_kernel_base.hpp"
+#include "hip_graph.hpp"
 #include "performance.hpp"
+#include "rocwmma_logging.hpp"
+#include "roctx_range.hpp"
 
 // Library includes
 
@@ -123,6 +127,11 @@ namespace rocwmma
         auto isF16  = std::is_same<DataT, float16_t>::value || isH16;
         auto isBF16 = (std::is_same<DataT, bfloat16_t>::value);
         auto isI8   = (std::is_same<DataT, int8_t>::value);
+        auto isF8
+            = (std::is_same<DataT, float8_t>::value || std::is_same<DataT, bfloat8_t>::value);
+
+        auto isGfx94x = (deviceArch == DeviceInfo::GFX940) || (deviceArch == DeviceInfo::GFX941)
+                        || (deviceArch == DeviceInfo::GFX942);
 
         // Block size
         auto is16x16 = (TileSize == 16);
@@ -133,13 +142,16 @@ namespace rocwmma
         // gfx908 doesn't support f64
         bool gfx908F64Check = !(isGfx908 && isF64);
 
+        // float8_t and bfloat8_t require gfx940/1/2, and BlockK >= 32 with the square tiles
+        bool f8Check = !(isF8 && (!isGfx94x || is16x16));
+
         // gfx11 only supports f16, i8 and bf16 inputs with block size 16
         bool gfx11Check = !(isGfx11 && ((!isF16 && !isBF16 && !isI8) || !is16x16));
 
         // gfx12 only supports f16, i8 and bf16 inputs with block size 16
         bool gfx12Check = !(isGfx12 && ((!isF16 && !isBF16 && !isI8) || !is16x16));
 
-        return unsupportedDeviceCheck && gfx908F64Check && gfx11Check && gfx12Check;
+        return unsupportedDeviceCheck && gfx908F64Check && f8Check && gfx11Check && gfx12Check;
     }
 
     template <uint32_t TileSize, typename DataT>
@@ -160,6 +172,7 @@ namespace rocwmma
     {
         mM = mK = mB = 0;
         mMPadded = mKPadded = 0;
+        mOutputScale = 1.0f;
         mRepeats =
 #if ROCWMMA_VALIDATION_TESTS
             1;
@@ -172,6 +185,14 @@ namespace rocwmma
         mTotalGFlops = mMeasuredTFlopsPerSec = 0.0;
         mElapsedTimeMs                       = 0.0;
         mEfficiency                          = -1;
+        mRoofTFlopsPerSec                    = 0.0;
+        mMemoryBound                         = false;
+        mTiming                              = {0.0, 0.0, 0.0, 0.0};
+        mSamplesPerSec                       = 0.0;
+        mMeasuredGBytesPerSec                = 0.0;
+        mGraphLaunch                         = false;
+        mGraphElapsedTimeMs                  = 0.0;
+        mGraphSavings                        = 0.0;
 
         passDirection = DlrmDirection_t::Forward;
 
@@ -188,18 +209,27 @@ namespace rocwmma
     template <uint32_t TileSize, typename DataT>
     std::ostream& DlrmKernelBase<TileSize, DataT>::printHeader(std::ostream& stream) const
     {
-        return stream << "TileSize, "
-                      << "DataT, "
-                      << "Direction, "
-                      << "MatM, MatK, MatB, "
+        stream << "TileSize, "
+               << "DataT, "
+               << "Direction, "
+               << "MatM, MatK, MatB, "
 #if ROCWMMA_VALIDATION_TESTS
-                      << "maxRelativeDiff, "
-                      << "tolerance, "
+               << "maxRelativeDiff, "
+               << "tolerance, "
 #endif // ROCWMMA_VALIDATION_TESTS
-                      << "elapsedMs, "
-                      << "Problem Size(GFlops), "
-                      << "TFlops/s, "
-                      << "Efficiency(%)" << std::endl;
+               << "elapsedMs, "
+               << "Problem Size(GFlops), "
+               << "TFlops/s, "
+               << "Efficiency(%), "
+               << "Roof(TFlops/s), "
+               << "Bound, "
+               << "Samples/s, "
+               << "GBytes/s" << (mGraphLaunch ? ", Graph elapsedMs, Graph Savings(%)" : "");
+        for(auto const& name : CounterCollector::instance()->names())
+        {
+            stream << ", " << name;
+        }
+        return stream << std::endl;
     }
 
     template <uint32_t TileSize, typename DataT>
@@ -207,26 +237,54 @@ namespace rocwmma
     {
         if(!mRunFlag)
         {
-            return stream << TileSize << ", " << dataTypeToString<DataT>() << ", "
-                          << (passDirection == DlrmDirection_t::Forward ? "Forwards" : "Backwards")
-                          << ", " << mM << ", " << mK << ", " << mB << ", "
+            stream << TileSize << ", " << dataTypeToString<DataT>() << ", "
+                   << (passDirection == DlrmDirection_t::Forward ? "Forwards" : "Backwards") << ", "
+                   << mM << ", " << mK << ", " << mB << ", "
 
 #if ROCWMMA_VALIDATION_TESTS
-                          << "n/a, "
+                   << "n/a, "
 #endif // ROCWMMA_VALIDATION_TESTS
-                          << "n/a, n/a, n/a, n/a, SKIPPED" << std::endl;
+                   << "n/a, n/a, n/a, n/a, n/a, n/a, n/a, n/a, "
+                   << (mGraphLaunch ? "n/a, n/a, " : "");
+            for(size_t i = 0; i < CounterCollector::instance()->names().size(); i++)
+            {
+                stream << "n/a, ";
+            }
+            return stream << "SKIPPED" << std::endl;
         }
         else
         {
-            return stream << TileSize << ", " << dataTypeToString<DataT>() << ", "
-                          << (passDirection == DlrmDirection_t::Forward ? "Forwards" : "Backwards")
-                          << ", " << mM << ", " << mK << ", " << mB << ", "
+            stream << TileSize << ", " << dataTypeToString<DataT>() << ", "
+                   << (passDirection == DlrmDirection_t::Forward ? "Forwards" : "Backwards") << ", "
+                   << mM << ", " << mK << ", " << mB << ", "
 
 #if ROCWMMA_VALIDATION_TESTS
-                          << mMaxRelativeError << ", "
+                   << mMaxRelativeError << ", "
 #endif // ROCWMMA_VALIDATION_TESTS
-                          << mElapsedTimeMs << ", " << mTotalGFlops << ", " << mMeasuredTFlopsPerSec
-                          << ", " << mEfficiency << ", "
+                   << mElapsedTimeMs << ", " << mTotalGFlops << ", " << mMeasuredTFlopsPerSec
+                   << ", " << mEfficiency << ", " << mRoofTFlopsPerSec << ", "
+                   << (mMemoryBound ? "Memory" : "Compute") << ", " << mSamplesPerSec << ", "
+                   << mMeasuredGBytesPerSec << ", ";
+
+            if(mGraphLaunch)
+            {
+                stream << mGraphElapsedTimeMs << ", " << mGraphSavings << ", ";
+            }
+
+            // n/a where the device does not support a counter
+            for(auto const& name : CounterCollector::instance()->names())
+            {
+                if(auto it = findCounter(mCounters, name); it != mCounters.end())
+                {
+                    stream << it->second << ", ";
+                }
+                else
+                {
+                    stream << "n/a, ";
+                }
+            }
+
+            return stream
 #if ROCWMMA_VALIDATION_TESTS
                           << (mValidationResult ? "PASSED" : "FAILED")
 #else
@@ -236,11 +294,23 @@ namespace rocwmma
         }
     }
 
+    template <uint32_t TileSize, typename DataT>
+    std::string DlrmKernelBase<TileSize, DataT>::roctxTag() const
+    {
+        std::stringstream tag;
+        tag << "dlrm " << TileSize << " " << dataTypeToString<DataT>() << " "
+            << (passDirection == DlrmDirection_t::Forward ? "Forwards" : "Backwards") << " "
+            << mTBlockX << "x" << mTBlockY << " " << mM << "x" << mK << "x" << mB;
+        return tag.str();
+    }
+
     template <uint32_t TileSize, typename DataT>
     void DlrmKernelBase<TileSize, DataT>::setup(ProblemParams const& problem)
     {
         // Reset the flags in case of multiple runs
-        mRunFlag = true;
+        mRunFlag     = true;
+        mGraphLaunch = RocwmmaLogging::instance()->hipGraph();
+        mCounters.clear();
 
         // Format incoming problem parameters
         std::tie(mTBlockX, mTBlockY)
@@ -257,6 +327,19 @@ namespace rocwmma
         // Determine whether to run forward or backward pass
         passDirection = problem.passDirection;
 
+        // Fill values are at most 4 in magnitude, so accumulators of the forward (k terms)
+        // and backward (m terms) products are bounded by 16 * max(m, k). 8-bit floats
+        // scale them by a power of 2 to within 128, keeping the scaling exact.
+        mOutputScale = 1.0f;
+        if(std::is_same<DataT, float8_t>::value || std::is_same<DataT, bfloat8_t>::value)
+        {
+            auto accBound = 16.0 * std::max(mM, mK);
+            mOutputScale  = static_cast<float32_t>(
+                std::exp2(-std::max(std::ceil(std::log2(accBound / 128.0)), 0.0)));
+        }
+
+        RoctxRange range(roctxTag(), " setup");
+
         mRunFlag &= checkDevice();
         mRunFlag &= checkSizes();
         mRunFlag &= checkLds();
@@ -303,7 +386,10 @@ namespace rocwmma
     {
         if(mRunFlag)
         {
-            std::function<void()> dlrmKernel;
+            auto       tag = roctxTag();
+            RoctxRange range(tag, " exec");
+
+            std::function<void(hipStream_t)> dlrmKernel;
             if(passDirection == DlrmDirection_t::Forward)
             {
                 if(mM == mMPadded && mK == mKPadded)
@@ -312,13 +398,14 @@ namespace rocwmma
                     uint outputBatchOffset = ((mM * (mM - 1)) / 2) + mK;
                     uint accBatchOffset    = mM * mM;
 
-                    dlrmKernel = [this, inputBatchOffset, outputBatchOffset, accBatchOffset]() {
+                    dlrmKernel = [this, inputBatchOffset, outputBatchOffset, accBatchOffset](
+                                     hipStream_t stream) {
                         auto& dataInstance = DataStorage::instance();
                         hipExtLaunchKernelGGL((this->kernelFwdImpl()),
                                               (this->gridDim()),
                                               (this->blockDim()),
                                               (this->ldsUsage()),
-                                              0,
+                                              stream,
                                               nullptr,
                                               nullptr,
                                               0,
@@ -330,7 +417,8 @@ namespace rocwmma
                                               mB,
                                               inputBatchOffset,
                                               outputBatchOffset,
-                                              accBatchOffset);
+                                              accBatchOffset,
+                                              mOutputScale);
                     };
                 }
             }
@@ -344,18 +432,18 @@ namespace rocwmma
                     uint upstreamBatchOffset = ((mM * (mM - 1)) / 2) + mK;
                     uint accBatchOffset      = mM * mM;
 
-                    dlrmKernel = [this, inputBatchOffset, upstreamBatchOffset, accBatchOffset]() {
+                    dlrmKernel = [this, inputBatchOffset, upstreamBatchOffset, accBatchOffset](
+                                     hipStream_t stream) {
                         auto& dataInstance = DataStorage::instance();
                         auto  trilGridDim
                             = dim3(ceilDiv(mM * mM, static_cast<uint32_t>(mTBlockX)), 1, mB);
 
-                        hipEvent_t syncEvent;
-                        CHECK_HIP_ERROR(hipEventCreate(&syncEvent));
+                        // Stream order keeps the tril kernel ahead of the bwd kernel
                         hipExtLaunchKernelGGL((this->kernelTrilImpl()),
                                               trilGridDim,
                                               this->blockDim(),
                                               0,
-                                              0,
+                                              stream,
                                               nullptr,
                                               nullptr,
                                               0,
@@ -366,14 +454,12 @@ namespace rocwmma
                                               mB,
                                               upstreamBatchOffset,
                                               accBatchOffset);
-                        CHECK_HIP_ERROR(hipEventRecord(syncEvent));
-                        CHECK_HIP_ERROR(hipEventSynchronize(syncEvent));
 
                         hipExtLaunchKernelGGL((this->kernelBwdImpl()),
                                               (this->gridDim()),
                                               (this->blockDim()),
                                               (this->ldsUsage()),
-                                              0,
+                                              stream,
                                               nullptr,
                                               nullptr,
                                               0,
@@ -387,45 +473,108 @@ namespace rocwmma
                                               mB,
                                               inputBatchOffset,
                                               upstreamBatchOffset,
-                                              accBatchOffset);
+                                              accBatchOffset,
+                                              mOutputScale);
                     };
                 }
             }
 
-            hipEvent_t startEvent, stopEvent;
-            CHECK_HIP_ERROR(hipEventCreate(&startEvent));
-            CHECK_HIP_ERROR(hipEventCreate(&stopEvent));
+            // Events between repeats give the per-run samples
+            std::vector<hipEvent_t> runEvents(mRepeats + 1u);
+            for(auto& event : runEvents)
+            {
+                CHECK_HIP_ERROR(hipEventCreate(&event));
+            }
 
-            CHECK_HIP_ERROR(hipEventRecord(startEvent));
+            CHECK_HIP_ERROR(hipEventRecord(runEvents[0]));
             for(uint32_t i = 0; i < mRepeats; ++i)
             {
-                dlrmKernel();
+                RoctxRange runRange(tag, " run ", i);
+                dlrmKernel(0);
+                CHECK_HIP_ERROR(hipEventRecord(runEvents[i + 1u]));
             }
-            CHECK_HIP_ERROR(hipEventRecord(stopEvent));
-            CHECK_HIP_ERROR(hipEventSynchronize(stopEvent));
+            CHECK_HIP_ERROR(hipEventSynchronize(runEvents[mRepeats]));
 
             auto timeMs = 0.0f;
-            CHECK_HIP_ERROR(hipEventElapsedTime(&timeMs, startEvent, stopEvent));
+            CHECK_HIP_ERROR(hipEventElapsedTime(&timeMs, runEvents[0], runEvents[mRepeats]));
+
+            std::vector<double> runTimesMs(mRepeats);
+            for(uint32_t i = 0; i < mRepeats; ++i)
+            {
+                auto runMs = 0.0f;
+                CHECK_HIP_ERROR(hipEventElapsedTime(&runMs, runEvents[i], runEvents[i + 1u]));
+                runTimesMs[i] = runMs;
+            }
+            mTiming = calculateTimingStats(runTimesMs);
 
             // Calculate efficiency
             auto& deviceInfo = DeviceInfo::instance();
 
             auto devicePeakGFlopsPerSec = deviceInfo->peakGFlopsPerSec<DataT>();
+            auto devicePeakGBytesPerSec = deviceInfo->peakGBytesPerSec();
             auto outputSize = (passDirection == DlrmDirection_t::Forward) ? mM * mM : mM * mK;
 
+            // Compulsory traffic: fwd reads input and writes the tril output,
+            // bwd reads input and upstream grad, then writes grad and bottom mlp grad.
+            auto inputCount = static_cast<double>(mM) * static_cast<double>(mK) * mB;
+            auto trilCount
+                = (static_cast<double>(mM) * (mM - 1u) / 2.0 + static_cast<double>(mK)) * mB;
+            auto elementCount = (passDirection == DlrmDirection_t::Forward)
+                                    ? inputCount + trilCount
+                                    : 2.0 * inputCount + trilCount + static_cast<double>(mK) * mB;
+
             mElapsedTimeMs        = float64_t(timeMs);
             mTotalGFlops          = calculateGFlops(outputSize, mB, mK);
             mMeasuredTFlopsPerSec = calculateTFlopsPerSec(outputSize, mB, mK, mElapsedTimeMs)
                                     * static_cast<float64_t>(mRepeats);
 
-            mEfficiency = round(mMeasuredTFlopsPerSec / devicePeakGFlopsPerSec * 100000.0);
+            auto flopsPerByte = mTotalGFlops / (elementCount * sizeof(DataT) * 1.0e-9);
+            auto deviceRoofGFlopsPerSec = deviceInfo->rooflineGFlopsPerSec<DataT>(flopsPerByte);
+
+            mRoofTFlopsPerSec = deviceRoofGFlopsPerSec * 1.0e-3;
+            mMemoryBound
+                = isMemoryBound(devicePeakGFlopsPerSec, devicePeakGBytesPerSec, flopsPerByte);
+            mEfficiency = calculatePercentOfRoof(mMeasuredTFlopsPerSec, deviceRoofGFlopsPerSec);
 
-            CHECK_HIP_ERROR(hipEventDestroy(startEvent));
-            CHECK_HIP_ERROR(hipEventDestroy(stopEvent));
+            // Elapsed time covers all repeats
+            auto elapsedSec       = mElapsedTimeMs * 1.0e-3 / static_cast<float64_t>(mRepeats);
+            mSamplesPerSec        = static_cast<float64_t>(mB) / elapsedSec;
+            mMeasuredGBytesPerSec = elementCount * sizeof(DataT) * 1.0e-9 / elapsedSec;
+
+            for(auto& event : runEvents)
+            {
+                CHECK_HIP_ERROR(hipEventDestroy(event));
+            }
+
+            // Replay the same launch sequence from a hipGraph to measure launch overhead savings
+            if(mGraphLaunch)
+            {
+                RoctxRange graphRange(tag, " graph");
+
+                HipGraphLauncher graph;
+                graph.capture(dlrmKernel);
+
+                auto graphLaunch  = [&graph]() { graph.launch(); };
+                auto directLaunch = [&graph, &dlrmKernel]() { dlrmKernel(graph.stream()); };
+
+                // Compare against direct launches timed the same way, without per-run events
+                auto directElapsedTimeMs = timeBackToBackMs(directLaunch, graph.stream(), mRepeats);
+                mGraphElapsedTimeMs      = timeBackToBackMs(graphLaunch, graph.stream(), mRepeats);
+                mGraphSavings = (1.0 - mGraphElapsedTimeMs / directElapsedTimeMs) * 100.0;
+            }
+
+            // Hardware counters of separate runs, after timing as collection serializes
+            // and instruments the dispatches
+            if(CounterCollector::instance()->enabled())
+            {
+                RoctxRange counterRange(tag, " counters");
+                mCounters = CounterCollector::instance()->collect([&]() { dlrmKernel(0); });
+            }
 
 #if ROCWMMA_VALIDATION_TESTS
 
             // Run reference CPU kernel
+            RoctxRange refRange(tag, " reference");
             std::function<void()> cpuKernel;
             if(passDirection == DlrmDirection_t::Forward)
             {
@@ -435,7 +584,8 @@ namespace rocwmma
                                         dataInstance->hostOutputRef().get(),
                                         mM,
                                         mK,
-                                        mB);
+                                        mB,
+                                        mOutputScale);
                 };
             }
             else
@@ -448,7 +598,8 @@ namespace rocwmma
                                         dataInstance->hostGradRef().get(),
                                         mM,
                                         mK,
-                                        mB);
+                                        mB,
+                                        mOutputScale);
                 };
             }
             cpuKernel();
@@ -462,6 +613,8 @@ namespace rocwmma
 #if ROCWMMA_VALIDATION_TESTS
         if(mRunFlag)
         {
+            RoctxRange range(roctxTag(), " validate");
+
             auto& dataInstance = DataStorage::instance();
             if(passDirection == DlrmDirection_t::Forward)
             {
@@ -519,6 +672,34 @@ namespace rocwmma
             KernelI::sHeaderPrinted = true;
         }
         printKernel();
+
+        // Structured record for -bo || --bench_output and baseline compare.
+        // Shape is the M x M interaction over K features per batch.
+        // LDS kernels are tagged so that both variants key apart.
+        auto isForward = (passDirection == DlrmDirection_t::Forward);
+        auto result    = (bool)ROCWMMA_VALIDATION_TESTS ? (mValidationResult ? "PASSED" : "FAILED")
+                                                     : "BENCH";
+
+        BenchmarkLog::instance()->record(
+            {"dlrm",
+             static_cast<uint32_t>(DeviceInfo::instance()->getGcnArch()),
+             std::string(dataTypeToString<DataT>()) + (isForward ? "_Forwards" : "_Backwards"),
+             std::to_string(TileSize) + (ldsUsage() > 0u ? "_Lds" : ""),
+             mTBlockX,
+             mTBlockY,
+             mM,
+             mM,
+             mK,
+             mB,
+             mRunFlag ? mRepeats : 0u,
+             mTiming,
+             mTotalGFlops,
+             mMeasuredTFlopsPerSec,
+             mEfficiency,
+             mRoofTFlopsPerSec,
+             mMemoryBound ? "Memory" : "Compute",
+             mRunFlag ? result : "SKIPPED",
+             mCounters});
     }
 
     template <uint32_t TileSize, typename DataT>
@@ -0,0 +1,83 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef DLRM_SHAPE_SWEEP_HPP
+#define DLRM_SHAPE_SWEEP_HPP
+
+#include <algorithm>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "hip_device.hpp"
+
+namespace rocwmma
+{
+    // Problem shapes of the DLRM sweep benchmarks at production (Criteo-like) sizes, shared
+    // by the global and LDS kernels so that their results line up shape for shape.
+    struct DlrmShapeSweep
+    {
+        using ThreadBlockT = std::pair<int64_t, int64_t>;
+        using ProblemSizeT = std::tuple<int64_t, int64_t, int64_t>;
+
+        // M (num_features), K (embedding dim), BatchSize:
+        // : Features 32, 64, 128. The interaction kernels need whole tiles, so the 27
+        //   features of Criteo (26 sparse + 1 dense) run padded to 32.
+        // : Embedding dims 64, 128, 256.
+        // : Batch sizes 1K ... 64K, spaced by 4x.
+        // Shapes whose input or m x m accumulators exceed 2^28 elements are left out,
+        // bounding device memory to 1GB per buffer.
+        static inline std::vector<ProblemSizeT> problemSizes()
+        {
+            std::vector<ProblemSizeT> result;
+
+            for(int64_t b = 1024; b <= 65536; b *= 4)
+            {
+                for(int64_t m = 32; m <= 128; m *= 2)
+                {
+                    for(int64_t k = 64; k <= 256; k *= 2)
+                    {
+                        if(m * std::max(m, k) * b <= (int64_t(1) << 28))
+                        {
+                            result.push_back({m, k, b});
+                        }
+                    }
+                }
+            }
+
+            return result;
+        }
+
+        static inline std::vector<ThreadBlockT> threadBlocks()
+        {
+            auto warpSize = HipDevice::instance()->warpSize();
+            return {{warpSize * 2, 1}};
+        }
+    };
+
+} // namespace rocwmma
+
+#endif // DLRM_SHAPE_SWEEP_HPP
@@ -33,16 +33,21 @@ namespace rocwmma
 {
     struct TestParams : public DlrmTestParams
     {
-        // Types: 32 and 16 bit float
-        // Block Sizes: 16 x 16 x 16
-        using Base      = DlrmTestParams;
-        using Types     = typename Base::DataTypes;
-        using TileSizes = typename Base::TileSizes;
+        // Types: 32, 16 and 8 bit float
+        // Block Sizes: 16 x 16 x 16, 32 x 32 x 32
+        using Base        = DlrmTestParams;
+        using Types       = typename Base::DataTypes;
+        using TileSizes   = typename Base::TileSizes;
+        using TypesF8     = typename Base::DataTypesF8;
+        using TileSizesF8 = typename Base::TileSizesF8;
 
         // Lds parameters
         using MappingLds = typename Base::TestMappingLds;
 
-        using KernelParams = typename CombineLists<Types, TileSizes, MappingLds>::Result;
+        using KernelParamsF8 = typename CombineLists<TypesF8, TileSizesF8, MappingLds>::Result;
+        using KernelParams
+            = typename Concat<typename CombineLists<Types, TileSizes, MappingLds>::Result,
+                              KernelParamsF8>::Result;
 
         using GeneratorImpl   = DlrmDotLdsGenerator;
         using KernelGenerator = KernelGenerator<KernelParams, GeneratorImpl>;
@@ -0,0 +1,117 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "detail/dlrm_dot.hpp"
+#include "detail/dlrm_dot_lds.hpp"
+#include "dlrm_dot_test.hpp"
+#include "dlrm_test_params.hpp"
+#include "kernel_generator.hpp"
+
+///
+/// Perf regression suite. The global and LDS interaction kernels over a curated set of
+/// production shapes, whose throughput is checked against the golden of the current arch.
+/// Cases fail when throughput drops beyond the tolerance, or when they have no golden
+/// record.
+///
+/// Usage: <binary> [-pg || --perf_golden *directory*] [-pt || --perf_tolerance *percent*]
+///
+
+namespace rocwmma
+{
+    struct PerfRegressionTestParams : public DlrmTestParams
+    {
+        // Types: 16 bit float
+        // Block Sizes: 16 x 16 x 16, 32 x 32 x 32
+        using Base      = DlrmTestParams;
+        using Types     = std::tuple<std::tuple<float16_t>>;
+        using TileSizes = typename Base::TileSizes;
+
+        // Lds parameters
+        using MappingLds = typename Base::TestMappingLds;
+
+        using KernelParams    = typename CombineLists<Types, TileSizes>::Result;
+        using KernelParamsLds = typename CombineLists<Types, TileSizes, MappingLds>::Result;
+
+        using KernelGeneratorGlobal = KernelGenerator<KernelParams, DlrmDotGenerator>;
+        using KernelGeneratorLds    = KernelGenerator<KernelParamsLds, DlrmDotLdsGenerator>;
+
+        // Sanity check for kernel generators
+        static_assert(
+            std::is_same<typename DlrmDotGenerator::ResultT, typename Base::KernelT>::value,
+            "Kernels from this generator do not match testing interface");
+        static_assert(
+            std::is_same<typename DlrmDotLdsGenerator::ResultT, typename Base::KernelT>::value,
+            "Kernels from this generator do not match testing interface");
+
+        static inline typename KernelGeneratorGlobal::ResultT kernels()
+        {
+            auto result = KernelGeneratorGlobal::generate();
+            KernelGeneratorLds::generate(result);
+            return result;
+        }
+
+        // Shapes are part of the golden key: changing them invalidates the goldens
+        // M (num_features), K (embedding dim), BatchSize
+        static inline std::vector<ProblemSizeT> problemSizes()
+        {
+            return {
+                // clang-format off
+                // Criteo, padded to 32 features
+                {32, 128, 16384},
+                {32, 128, 65536},
+                // Wide embeddings
+                {64, 256, 16384},
+                // Many features
+                {128, 128, 16384}
+                // clang-format on
+            };
+        }
+    };
+
+} // namespace rocwmma
+
+class DlrmDotPerfRegressionTest : public rocwmma::DlrmDotTest
+{
+};
+
+TEST_P(DlrmDotPerfRegressionTest, RunKernel)
+{
+    static bool ranWarmup = false;
+    if(!ranWarmup)
+    {
+        this->Warmup();
+        ranWarmup = true;
+    }
+    this->RunKernel();
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    DlrmKernelTests,
+    DlrmDotPerfRegressionTest,
+    ::testing::Combine(::testing::ValuesIn(rocwmma::PerfRegressionTestParams::kernels()),
+                       ::testing::ValuesIn(rocwmma::PerfRegressionTestParams::threadBlocks()),
+                       ::testing::ValuesIn(rocwmma::PerfRegressionTestParams::problemSizes()),
+                       ::testing::ValuesIn(rocwmma::PerfRegressionTestParams::passDirections())));
@@ -33,12 +33,16 @@ namespace rocwmma
 {
     struct TestParams : public DlrmTestParams
     {
-        // Types: 32 and 16 bit float
-        // Block Sizes: 16 x 16 x 16
+        // Types: 32, 16 and 8 bit float
+        // Block Sizes: 16 x 16 x 16, 32 x 32 x 32
         using Base         = DlrmTestParams;
         using Types        = typename Base::DataTypes;
         using TileSizes    = typename Base::TileSizes;
-        using KernelParams = typename CombineLists<Types, TileSizes>::Result;
+        using TypesF8      = typename Base::DataTypesF8;
+        using TileSizesF8  = typename Base::TileSizesF8;
+        using KernelParams
+            = typename Concat<typename CombineLists<Types, TileSizes>::Result,
+                              typename CombineLists<TypesF8, TileSizesF8>::Result>::Result;
 
         using GeneratorImpl   = DlrmDotGenerator;
         using KernelGenerator = KernelGenerator<KernelParams, GeneratorImpl>;
@@ -31,6 +31,7 @@
 
 #include "dlrm_kernel_base.hpp"
 #include "dlrm_test_params.hpp"
+#include "perf_golden.hpp"
 
 namespace rocwmma
 {
@@ -78,6 +79,9 @@ namespace rocwmma
             kernel->exec();
             kernel->validateResults();
             kernel->reportResults();
+
+            // Throughput against golden with -pg || --perf_golden
+            expectPerfGolden();
         }
 
         virtual void Warmup()
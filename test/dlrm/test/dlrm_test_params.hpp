@@ -48,9 +48,15 @@ namespace rocwmma
         using PassDirectionT = DlrmDirection_t;
         using TestMappingLds = std::tuple<std::tuple<LdsRF>>;
 
-        using DataTypes = std::tuple<std::tuple<float32_t>, std::tuple<float16_t>>;
+        using DataTypes
+            = std::tuple<std::tuple<float32_t>, std::tuple<float16_t>, std::tuple<bfloat16_t>>;
         using TileSizes = std::tuple<std::tuple<I<16>>, std::tuple<I<32>>>;
 
+        // 8-bit floats accumulate in float32_t, with scaled outputs.
+        // Square tiles need BlockK >= 32: 32 x 32 x 32 only.
+        using DataTypesF8 = std::tuple<std::tuple<float8_t>, std::tuple<bfloat8_t>>;
+        using TileSizesF8 = std::tuple<std::tuple<I<32>>>;
+
         // M, K, BatchSize
         static inline std::vector<ProblemSizeT> problemSizes()
         {
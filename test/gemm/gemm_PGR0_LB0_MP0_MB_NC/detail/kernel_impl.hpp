@@ -154,6 +154,17 @@ namespace rocwmma
         {
             return Base::printKernel(stream << BlocksX << ", " << BlocksY << ", ");
         }
+
+        std::ostream& printKernelConfig(std::ostream& stream) const final
+        {
+            return Base::printKernelConfig(stream << "PGR0_LB0_MP0_MB_NC_")
+                   << "_" << BlocksX << "x" << BlocksY;
+        }
+
+        std::tuple<uint32_t, uint32_t, uint32_t> waveTileSize() const final
+        {
+            return std::make_tuple(BlockM * BlocksX, BlockN * BlocksY, BlockK);
+        }
     };
 
 } // namespace rocwmma
@@ -34,6 +34,7 @@
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
 #include "kernel_predicates.hpp"
 #include <rocwmma/rocwmma.hpp>
+#include <rocwmma/rocwmma_epilogue.hpp>
 #pragma GCC diagnostic pop
 
 namespace rocwmma
@@ -199,17 +200,21 @@ namespace rocwmma
                 }
             }
 
-            // Initialize C frags
+            // Initialize C frags. C is only read when beta != 0
             FragC fragsC[BlocksX][BlocksY];
+            auto  linearCase = get_linear_combination(alpha, beta);
 
-#pragma unroll
-            for(int i = 0; i < BlocksX; i++)
+            if(linearCase == linear_full)
             {
 #pragma unroll
-                for(int j = 0; j < BlocksY; j++)
+                for(int i = 0; i < BlocksX; i++)
                 {
-                    auto* addrC = MappingC::dataCoord(c, subMatrixCoordsC[i][j], ldc);
-                    load_matrix_sync(fragsC[i][j], addrC, ldc);
+#pragma unroll
+                    for(int j = 0; j < BlocksY; j++)
+                    {
+                        auto* addrC = MappingC::dataCoord(c, subMatrixCoordsC[i][j], ldc);
+                        load_matrix_sync(fragsC[i][j], addrC, ldc);
+                    }
                 }
             }
 
@@ -223,11 +228,22 @@ namespace rocwmma
                     auto& fragAcc = fragsAccum[i][j];
                     auto& fragC   = fragsC[i][j];
 
+                    if(linearCase == linear_full)
+                    {
 #pragma unroll
-                    for(int e = 0; e < fragC.num_elements; ++e)
+                        for(int e = 0; e < fragC.num_elements; ++e)
+                        {
+                            fragC.x[e] = OutputT(alpha * ComputeT(fragAcc.x[e])
+                                                 + beta * ComputeT(fragC.x[e]));
+                        }
+                    }
+                    else
                     {
-                        fragC.x[e]
-                            = OutputT(alpha * ComputeT(fragAcc.x[e]) + beta * ComputeT(fragC.x[e]));
+#pragma unroll
+                        for(int e = 0; e < fragC.num_elements; ++e)
+                        {
+                            fragC.x[e] = OutputT(alpha * ComputeT(fragAcc.x[e]));
+                        }
                     }
 
                     // Output addresss
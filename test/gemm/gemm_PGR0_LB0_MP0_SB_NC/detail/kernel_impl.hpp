@@ -123,6 +123,11 @@ namespace rocwmma
         {
             return Base::template dispatchKernelFunc<TestKernelFunc>();
         }
+
+        std::ostream& printKernelConfig(std::ostream& stream) const final
+        {
+            return Base::printKernelConfig(stream << "PGR0_LB0_MP0_SB_NC_");
+        }
     };
 
 } // namespace rocwmma
@@ -34,6 +34,7 @@
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
 #include "kernel_predicates.hpp"
 #include <rocwmma/rocwmma.hpp>
+#include <rocwmma/rocwmma_epilogue.hpp>
 #pragma GCC diagnostic pop
 
 namespace rocwmma
@@ -113,10 +114,14 @@ namespace rocwmma
                 return;
             }
 
-            // Initialize accumulator
+            // Initialize accumulator.
+            // The K loop accumulates in the native register layout of the mma backend.
             auto fragAcc = FragAcc();
             fill_fragment(fragAcc, static_cast<ComputeT>(0));
 
+            auto accum = native_accumulator<BlockM, BlockN, BlockK, InputT, ComputeT>();
+            to_native(accum, fragAcc);
+
             // Setup starting addresses
             // Offset A to col 0
             // Offset B to row 0
@@ -144,23 +149,38 @@ namespace rocwmma
                 // Load and multiply
                 load_matrix_sync(fragA, addrA, lda);
                 load_matrix_sync(fragB, addrB, ldb);
-                mma_sync(fragAcc, fragA, fragB, fragAcc);
+                mma_sync(accum, fragA, fragB);
 
                 addrA += incrA;
                 addrB += incrB;
             }
 
+            from_native(fragAcc, accum);
+
             auto fragC = FragC();
 
-            // Setup address and load C
-            auto* addrC = MappingC::dataCoord(c, matrixCoordC, ldc);
-            load_matrix_sync(fragC, addrC, ldc);
+            // D = alpha * accumAB + beta * C. C is only read when beta != 0
+            auto linearCase = get_linear_combination(alpha, beta);
+            if(linearCase == linear_full)
+            {
+                // Setup address and load C
+                auto* addrC = MappingC::dataCoord(c, matrixCoordC, ldc);
+                load_matrix_sync(fragC, addrC, ldc);
 
-            // D = alpha * accumAB + beta * C
 #pragma unroll
-            for(int i = 0; i < fragC.num_elements; ++i)
+                for(int i = 0; i < fragC.num_elements; ++i)
+                {
+                    fragC.x[i]
+                        = OutputT(alpha * ComputeT(fragAcc.x[i]) + beta * ComputeT(fragC.x[i]));
+                }
+            }
+            else
             {
-                fragC.x[i] = OutputT(alpha * ComputeT(fragAcc.x[i]) + beta * ComputeT(fragC.x[i]));
+#pragma unroll
+                for(int i = 0; i < fragC.num_elements; ++i)
+                {
+                    fragC.x[i] = OutputT(alpha * ComputeT(fragAcc.x[i]));
+                }
             }
 
             // Output addresss
@@ -30,6 +30,7 @@
 #include "device/kernel_device_func.hpp"
 #include "gemm_kernel_base.hpp"
 #include "helper_macros.hpp"
+#include "profile_stamps.hpp"
 
 namespace rocwmma
 {
@@ -133,6 +134,13 @@ namespace rocwmma
 
         dim3 gridDim() const final
         {
+            // K sliced workgroups cover a single wave tile
+            if constexpr(CooperativeGemm::KSlice_v<GemmConfig>)
+            {
+                return dim3(ceilDiv(Base::mM, BlockM * BlocksX),
+                            ceilDiv(Base::mN, BlockN * BlocksY));
+            }
+
             return dim3(ceilDiv(Base::mM,
                                 BlockM * BlocksX * Base::mTBlockX
                                     / Base::DeviceInfo::instance()->warpSize()),
@@ -141,6 +149,12 @@ namespace rocwmma
 
         bool checkSizes() const final
         {
+            if constexpr(CooperativeGemm::KSlice_v<GemmConfig>)
+            {
+                return ((BlockM * BlocksX) <= Base::mM) && ((BlockN * BlocksY) <= Base::mN)
+                       && (BlockK <= Base::mK);
+            }
+
             return ((BlockM * BlocksX * Base::mTBlockX / Base::DeviceInfo::instance()->warpSize())
                     <= Base::mM)
                    && ((BlockN * BlocksY * Base::mTBlockY) <= Base::mN) && (BlockK <= Base::mK);
@@ -156,8 +170,8 @@ namespace rocwmma
 
             // Cooperative workgroup kernels quirks
             auto wgQuirksCheck = true;
-            if(std::is_same<GemmConfig, CooperativeGemm::WorkgroupLevel::LdsNT>::value
-               || std::is_same<GemmConfig, CooperativeGemm::WorkgroupLevel::LdsTN>::value)
+            if(std::is_base_of<CooperativeGemm::WorkgroupLevel::LdsNT, GemmConfig>::value
+               || std::is_base_of<CooperativeGemm::WorkgroupLevel::LdsTN, GemmConfig>::value)
             {
                 // TODO: Fp64 fails validation for BlockK > 16 for 16 x 16.
                 wgQuirksCheck &= !(std::is_same<InputT, float64_t>::value && (BlockM == 16)
@@ -166,8 +180,8 @@ namespace rocwmma
 
             // Cooperative wave kernels quirks
             auto waveQuirksCheck = true;
-            if(std::is_same<GemmConfig, CooperativeGemm::WaveLevel::LdsNT>::value
-               || std::is_same<GemmConfig, CooperativeGemm::WaveLevel::LdsTN>::value)
+            if(std::is_base_of<CooperativeGemm::WaveLevel::LdsNT, GemmConfig>::value
+               || std::is_base_of<CooperativeGemm::WaveLevel::LdsTN, GemmConfig>::value)
             {
                 // TODO: On gfx90a, TN config with 4x4 blocks of 32 x 32 x 8
                 // Produces compile time issues
@@ -186,11 +200,26 @@ namespace rocwmma
         // Lds memory usage in bytes
         uint32_t ldsUsage() const final
         {
-            // Uses 2 lds blocks for prefetch loop
-            return 2 * sizeof(InputT)
-                   * (Base::mTBlockX / Base::DeviceInfo::instance()->warpSize() * BlocksX * BlockM
-                      + Base::mTBlockY * BlocksY * BlockN)
-                   * BlockK;
+            // K sliced configs only exchange one accumulator block per wave but wave 0.
+            // Each channel holds the block and its 2 counters, rounded up to 16B.
+            if constexpr(CooperativeGemm::KSlice_v<GemmConfig>)
+            {
+                auto waveCount = Base::mTBlockX / Base::DeviceInfo::instance()->warpSize()
+                                 * Base::mTBlockY;
+                auto channelBytes
+                    = ceilDiv(BlockM * BlockN * sizeof(ComputeT) + 2 * sizeof(uint32_t), 16u)
+                      * 16u;
+                return (waveCount - 1u) * channelBytes;
+            }
+
+            // Uses 2 lds blocks for prefetch loop, in the staging datatype. Stage synced
+            // configs follow them with a full and an empty counter per block.
+            return 2 * sizeof(CooperativeGemm::StageType_t<GemmConfig, InputT>)
+                       * (Base::mTBlockX / Base::DeviceInfo::instance()->warpSize() * BlocksX
+                              * BlockM
+                          + Base::mTBlockY * BlocksY * BlockN)
+                       * BlockK
+                   + (CooperativeGemm::StageSync_v<GemmConfig> ? 2 * 2 * sizeof(uint32_t) : 0u);
         }
 
         typename Base::KernelFunc kernelImpl() const final
@@ -198,6 +227,30 @@ namespace rocwmma
             return Base::template dispatchKernelFunc<TestKernelFunc>();
         }
 
+#if ROCWMMA_PROFILE_STAMPS
+        // Record phase stamps of every wave over all runs, then report the breakdown.
+        // The stamp buffer is bound here, in the translation unit of the kernel.
+        void exec() final
+        {
+            if(!Base::mRunFlag)
+            {
+                return Base::exec();
+            }
+
+            auto grid      = gridDim();
+            auto waveCount = grid.x * grid.y
+                             * ceilDiv(Base::mTBlockX * Base::mTBlockY,
+                                       Base::DeviceInfo::instance()->warpSize());
+
+            ProfileStamps stamps(waveCount);
+            profile::set_stamp_buffer(stamps.buffer());
+            Base::exec();
+            profile::set_stamp_buffer(profile::stamp_buffer{});
+
+            stamps.report(std::cout);
+        }
+#endif // ROCWMMA_PROFILE_STAMPS
+
         std::ostream& printHeader(std::ostream& stream = std::cout) const final
         {
             return Base::printHeader(stream << "GemmConfig, LytLds, BlocksX, BlocksY, ");
@@ -209,6 +262,18 @@ namespace rocwmma
                                             << dataTypeToString<LayoutLds>() << ", " << BlocksX
                                             << ", " << BlocksY << ", ");
         }
+
+        std::ostream& printKernelConfig(std::ostream& stream) const final
+        {
+            return Base::printKernelConfig(stream << "PGR1_LB2_MP0_MB_CP_")
+                   << "_" << dataTypeToString<GemmConfig>() << "_" << dataTypeToString<LayoutLds>()
+                   << "_" << BlocksX << "x" << BlocksY;
+        }
+
+        std::tuple<uint32_t, uint32_t, uint32_t> waveTileSize() const final
+        {
+            return std::make_tuple(BlockM * BlocksX, BlockN * BlocksY, BlockK);
+        }
     };
 
 } // namespace rocwmma
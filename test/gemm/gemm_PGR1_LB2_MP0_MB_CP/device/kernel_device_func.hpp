@@ -33,6 +33,7 @@
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
 #include "gemm_config.hpp"
+#include "gemm_pipeline.hpp"
 #include "kernel_predicates.hpp"
 #include <rocwmma/rocwmma.hpp>
 #include <rocwmma/rocwmma_coop.hpp>
@@ -44,6 +45,7 @@ namespace rocwmma
     /// Device function GEMM kernel:
     ///
     /// PGR1 = Prefetch Global Read, x1 step prefetch
+    ///        (x(N-1) step prefetch for N-stage pipelined configs)
     /// LB2 = Lds Buffer, x2 buffers
     /// MP0 = Mfma Priority, 0
     /// MB = Multi-block output
@@ -101,12 +103,18 @@ namespace rocwmma
                                                    ArchId>::enableBuild())
         {
             ///
-            /// Assemble the gemm driver from the incoming gemm configuration
+            /// Assemble the gemm driver from the incoming gemm configuration.
+            /// A and B are staged through LDS and multiplied in StageT, converted from
+            /// InputT by the global reads if they differ.
             ///
+            using StageT = CooperativeGemm::StageType_t<GemmConfig, InputT>;
+            static_assert(!CooperativeGemm::KSlice_v<GemmConfig> || is_same_v<StageT, InputT>,
+                          "K sliced configurations read A and B without staging");
+
             using GlobalMapping = typename GemmConfig::template GlobalMapping<BlockM,
                                                                               BlockN,
                                                                               BlockK,
-                                                                              InputT,
+                                                                              StageT,
                                                                               OutputT,
                                                                               ComputeT,
                                                                               LayoutA,
@@ -123,10 +131,19 @@ namespace rocwmma
             using CoopSchedulerB = typename GemmConfig::template CoopSchedulerB<TBlockX, TBlockY>;
             using GemmDriver     = typename GemmConfig::
                 template GemmDriver<GlobalMapping, LdsMapping, CoopSchedulerA, CoopSchedulerB>;
-
-            // Global fragments used in pre-fetching
-            using GRFragA = typename GlobalMapping::GRFragA;
-            using GRFragB = typename GlobalMapping::GRFragB;
+            // Stage synced pipelines count the arrivals of every wave of the workgroup
+            constexpr uint32_t StageSyncWaves
+                = CooperativeGemm::StageSync_v<GemmConfig> ? TBlockX / WaveSize * TBlockY : 0u;
+
+            using GemmPipeline
+                = CooperativeGemm::GemmPipeline<GemmDriver,
+                                                GlobalMapping,
+                                                LdsMapping,
+                                                CooperativeGemm::PipelineStages_v<GemmConfig>,
+                                                CooperativeGemm::SchedulePolicy_t<GemmConfig>,
+                                                CooperativeGemm::PingPongPriority_v<GemmConfig>,
+                                                CooperativeGemm::KUnroll_v<GemmConfig>,
+                                                StageSyncWaves>;
 
             // Fragments for mfma
             using MfmaFragA   = typename GlobalMapping::MfmaFragA;
@@ -136,11 +153,8 @@ namespace rocwmma
             using MfmaFragAcc = typename GlobalMapping::MfmaFragAcc;
 
             // Mapping utils for each fragment type
-            using DataMappingA   = GetDataLayout_t<MfmaFragA>;
-            using DataMappingB   = GetDataLayout_t<MfmaFragB>;
-            using DataMappingC   = GetDataLayout_t<MfmaFragC>;
-            using DataMappingD   = GetDataLayout_t<MfmaFragD>;
-            using DataMappingLds = typename LdsMapping::DataLayout;
+            using DataMappingC = GetDataLayout_t<MfmaFragC>;
+            using DataMappingD = GetDataLayout_t<MfmaFragD>;
 
             ///
             /// Target starting C / D macro tile matrix coordinate on 2D grid
@@ -163,51 +177,15 @@ namespace rocwmma
             ///
             /// Setup global addressing offsets in 1D
             ///
-            auto globalReadOffsetA
-                = DataMappingA::fromMatrixCoord(GlobalMapping::readCoordA(), lda);
-            auto globalReadOffsetB
-                = DataMappingB::fromMatrixCoord(GlobalMapping::readCoordB(), ldb);
             auto globalReadOffsetC
                 = DataMappingC::fromMatrixCoord(GlobalMapping::readCoordC(), ldc);
             auto globalWriteOffsetD
                 = DataMappingD::fromMatrixCoord(GlobalMapping::writeCoordD(), ldd);
 
-            auto kStepOffsetA = DataMappingA::fromMatrixCoord(GlobalMapping::kStepOffsetA(), lda);
-            auto kStepOffsetB = DataMappingB::fromMatrixCoord(GlobalMapping::kStepOffsetB(), ldb);
-
-            ///
-            /// Start global prefetch
-            ///
-            typename GlobalMapping::GRBuffA grBuffA;
-            typename GlobalMapping::GRBuffB grBuffB;
-            GemmDriver::globalReadCoopA(grBuffA, a + globalReadOffsetA, lda);
-            GemmDriver::globalReadCoopB(grBuffB, b + globalReadOffsetB, ldb);
-            globalReadOffsetA += kStepOffsetA;
-            globalReadOffsetB += kStepOffsetB;
-
-            ///
-            /// Setup LDS addressing
-            /// This kernel will use 2 separate LDS blocks
-            /// for pipelining in the accumulation loop
-            ///
-            HIP_DYNAMIC_SHARED(void*, localMemPtr);
-            auto  sizeLds  = LdsMapping::sizeLds();
-            auto* ldsPtrLo = reinterpret_cast<InputT*>(localMemPtr);
-            auto* ldsPtrHi = ldsPtrLo + get<0>(sizeLds) * get<1>(sizeLds);
-
-            auto ldlds = LdsMapping::ldLds();
-            auto ldsWriteOffsetA
-                = DataMappingLds::fromMatrixCoord(LdsMapping::writeCoordA(), ldlds);
-            auto ldsWriteOffsetB
-                = DataMappingLds::fromMatrixCoord(LdsMapping::writeCoordB(), ldlds);
-            auto ldsReadOffsetA = DataMappingLds::fromMatrixCoord(LdsMapping::readCoordA(), ldlds);
-            auto ldsReadOffsetB = DataMappingLds::fromMatrixCoord(LdsMapping::readCoordB(), ldlds);
-
             ///
-            /// Write prefetch to local
+            /// Phase stamps, compiled out unless ROCWMMA_PROFILE_STAMPS is enabled
             ///
-            GemmDriver::localWriteCoopA(ldsPtrLo + ldsWriteOffsetA, grBuffA, ldlds);
-            GemmDriver::localWriteCoopB(ldsPtrLo + ldsWriteOffsetB, grBuffB, ldlds);
+            profile::stamp_ring stamps;
 
             ///
             /// Initialize accumulation frags
@@ -215,70 +193,119 @@ namespace rocwmma
             typename GlobalMapping::MfmaBuffAcc fragsAcc;
             GemmDriver::fill(fragsAcc, static_cast<ComputeT>(0));
 
-            ///
-            /// Synchronize waves and memory
-            ///
-            GemmDriver::syncWorkgroup();
+            HIP_DYNAMIC_SHARED(void*, localMemPtr);
 
-            ///
-            /// Accumulate A * B
-            ///
-            for(auto currentK = BlockK; currentK < k; currentK += BlockK)
+            // C is only read when beta != 0
+            typename GlobalMapping::MfmaBuffC fragsC;
+            auto linearCase = get_linear_combination(alpha, beta);
+
+            if constexpr(CooperativeGemm::KSlice_v<GemmConfig>)
             {
+                ///
+                /// Accumulate A * B over every KSlices-th K step, from the K slice
+                /// of the current wave. Each wave reads its own MFMA blocks, without LDS.
+                ///
+                constexpr uint32_t KSlices = TBlockX / WaveSize * TBlockY;
+                using Reduction            = lds_reduction<MfmaFragAcc, KSlices, WaveSize>;
+                using DataMappingA         = GetDataLayout_t<MfmaFragA>;
+                using DataMappingB         = GetDataLayout_t<MfmaFragB>;
+
+                auto kSlice = GlobalMapping::kSliceIndex();
+                auto kStart = kSlice * BlockK;
+
+                Reduction reduction(localMemPtr, kSlice);
+                if(kSlice == 0u)
+                {
+                    reduction.reset();
+                }
+
+                auto* globalAddrA
+                    = a
+                      + DataMappingA::fromMatrixCoord(
+                          GlobalMapping::readCoordA() + make_coord2d(0u, kStart), lda);
+                auto* globalAddrB
+                    = b
+                      + DataMappingB::fromMatrixCoord(
+                          GlobalMapping::readCoordB() + make_coord2d(kStart, 0u), ldb);
+                auto kSliceStepA
+                    = DataMappingA::fromMatrixCoord(make_coord2d(0u, KSlices * BlockK), lda);
+                auto kSliceStepB
+                    = DataMappingB::fromMatrixCoord(make_coord2d(KSlices * BlockK, 0u), ldb);
+
                 typename GlobalMapping::MfmaBuffA fragsA;
                 typename GlobalMapping::MfmaBuffB fragsB;
 
-                // Local read mfma frags
-                GemmDriver::localReadA(fragsA, ldsPtrLo + ldsReadOffsetA, ldlds);
-                GemmDriver::localReadB(fragsB, ldsPtrLo + ldsReadOffsetB, ldlds);
-
-                // Start fetching next round of frags
-                GemmDriver::globalReadCoopA(grBuffA, a + globalReadOffsetA, lda);
-                GemmDriver::globalReadCoopB(grBuffB, b + globalReadOffsetB, ldb);
-
-                // Advance offsets to next k step
-                globalReadOffsetA += kStepOffsetA;
-                globalReadOffsetB += kStepOffsetB;
-
-                // accum(A * B)
-                GemmDriver::mfma(fragsAcc, fragsA, fragsB, fragsAcc);
-
-                GemmDriver::localWriteCoopA(ldsPtrHi + ldsWriteOffsetA, grBuffA, ldlds);
-                GemmDriver::localWriteCoopB(ldsPtrHi + ldsWriteOffsetB, grBuffB, ldlds);
-
-                // Make sure that all waves have finished reading / writing to lds.
+                stamps.stamp(profile::phase_mma);
+                for(auto kStep = kStart; kStep < k; kStep += KSlices * BlockK)
+                {
+                    GemmDriver::globalReadA(fragsA, globalAddrA, lda);
+                    GemmDriver::globalReadB(fragsB, globalAddrB, ldb);
+                    GemmDriver::mfma(fragsAcc, fragsA, fragsB, fragsAcc);
+
+                    globalAddrA += kSliceStepA;
+                    globalAddrB += kSliceStepB;
+                }
+
+                ///
+                /// Sum the accumulators of all K slices into wave 0, one MFMA block
+                /// per reduction. Wave 0 reads C in the meantime, and alone writes D.
+                /// The barrier also publishes the counters reset by wave 0.
+                ///
+                if(kSlice == 0u && linearCase == linear_full)
+                {
+                    GemmDriver::globalReadC(fragsC, c + globalReadOffsetC, ldc);
+                }
                 GemmDriver::syncWorkgroup();
 
-                // Swap Lds buffers
-                auto* tmp = ldsPtrLo;
-                ldsPtrLo  = ldsPtrHi;
-                ldsPtrHi  = tmp;
+                auto seq = 0u;
+#pragma unroll
+                for(uint32_t i = 0; i < BlocksX; i++)
+                {
+#pragma unroll
+                    for(uint32_t j = 0; j < BlocksY; j++)
+                    {
+                        reduction.reduce(fragsAcc[i][j], seq++);
+                    }
+                }
+
+                if(kSlice != 0u)
+                {
+                    stamps.flush();
+                    return;
+                }
+            }
+            else
+            {
+                ///
+                /// Accumulate A * B
+                /// Pipeline uses 2 separate LDS blocks, rotated at every K step.
+                /// Loading of C is started before the tail A * B
+                ///
+                GemmPipeline::accumulate(fragsAcc,
+                                         a,
+                                         b,
+                                         lda,
+                                         ldb,
+                                         k,
+                                         reinterpret_cast<StageT*>(localMemPtr),
+                                         [&]() {
+                                             if(linearCase == linear_full)
+                                             {
+                                                 GemmDriver::globalReadC(
+                                                     fragsC, c + globalReadOffsetC, ldc);
+                                             }
+                                         },
+                                         stamps);
             }
-
-            ///
-            /// Start loading C
-            ///
-
-            typename GlobalMapping::MfmaBuffC fragsC;
-            GemmDriver::globalReadC(fragsC, c + globalReadOffsetC, ldc);
-
-            ///
-            /// Clean up tail A * B
-            ///
-
-            typename GlobalMapping::MfmaBuffA fragsA;
-            typename GlobalMapping::MfmaBuffB fragsB;
-
-            GemmDriver::localReadA(fragsA, ldsPtrLo + ldsReadOffsetA, ldlds);
-            GemmDriver::localReadB(fragsB, ldsPtrLo + ldsReadOffsetB, ldlds);
-            GemmDriver::mfma(fragsAcc, fragsA, fragsB, fragsAcc);
 
             ///
             /// D = alpha * accum + beta * C
             ///
+            stamps.stamp(profile::phase_epilogue);
             typename GlobalMapping::MfmaBuffD fragsD;
-            GemmDriver::uniformFma(fragsD, alpha, fragsAcc, beta, fragsC);
+            GemmDriver::uniformFma(fragsD, linearCase, alpha, fragsAcc, beta, fragsC);
             GemmDriver::globalWriteD(d + globalWriteOffsetD, fragsD, ldd);
+            stamps.flush();
         }
     }
 } // namespace rocwmma
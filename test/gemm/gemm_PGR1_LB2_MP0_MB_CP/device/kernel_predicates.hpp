@@ -31,6 +31,7 @@
 
 namespace rocwmma
 {
+    // Stage converted configurations are guarded on their mfma datatype StageT
     template <uint32_t BlockM,
               uint32_t BlockN,
               uint32_t BlockK,
@@ -49,23 +50,24 @@ namespace rocwmma
               uint32_t TBlockY,
               uint32_t WaveSize,
               uint32_t ArchId>
-    struct gemm_PGR1_LB2_MP0_MB_CP_guard : public GemmPredicatesBase<BlockM,
-                                                                     BlockN,
-                                                                     BlockK,
-                                                                     InputT,
-                                                                     OutputT,
-                                                                     ComputeT,
-                                                                     BlocksX,
-                                                                     BlocksY,
-                                                                     TBlockX,
-                                                                     TBlockY,
-                                                                     WaveSize,
-                                                                     ArchId>
+    struct gemm_PGR1_LB2_MP0_MB_CP_guard
+        : public GemmPredicatesBase<BlockM,
+                                    BlockN,
+                                    BlockK,
+                                    CooperativeGemm::StageType_t<GemmConfig, InputT>,
+                                    OutputT,
+                                    ComputeT,
+                                    BlocksX,
+                                    BlocksY,
+                                    TBlockX,
+                                    TBlockY,
+                                    WaveSize,
+                                    ArchId>
     {
         using Base = GemmPredicatesBase<BlockM,
                                         BlockN,
                                         BlockK,
-                                        InputT,
+                                        CooperativeGemm::StageType_t<GemmConfig, InputT>,
                                         OutputT,
                                         ComputeT,
                                         BlocksX,
@@ -100,6 +100,17 @@ namespace rocwmma
 
             };
         }
+
+        // alpha = 1 and beta = 0 cover the cases which skip the load of C
+        static inline std::vector<AlphaT> alphas()
+        {
+            return {static_cast<AlphaT>(2), static_cast<AlphaT>(1)};
+        }
+
+        static inline std::vector<BetaT> betas()
+        {
+            return {static_cast<BetaT>(2), static_cast<BetaT>(0)};
+        }
     };
 
 } // namespace rocwmma
@@ -0,0 +1,120 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef ROCWMMA_GEMM_AUTOTUNE_TEST_PARAMS
+#define ROCWMMA_GEMM_AUTOTUNE_TEST_PARAMS
+
+#include "test/test_includes.hpp"
+
+///
+/// Autotuning search space, shared by the autotune and dispatch tests.
+///
+
+namespace rocwmma
+{
+
+    struct AutotuneTestParams : public CommonTestParams
+    {
+        using Base = CommonTestParams;
+
+        // Search space
+        // Types: f16 inputs, f32 compute
+        // Block Sizes: 16 x 16 x (32, 64), 32 x 32 x (16, 32)
+        // Layouts: NN, NT, TN, TT
+        // Gemm configs: workgroup level
+        // Blocks: 2x2, 2x4, 4x2, 4x4
+        using Types       = std::tuple<std::tuple<float16_t, float16_t, float32_t>,
+                                 std::tuple<float16_t, float32_t, float32_t>>;
+        using BlockSizes  = std::tuple<std::tuple<I<16>, I<16>, I<32>>,
+                                      std::tuple<I<16>, I<16>, I<64>>,
+                                      std::tuple<I<32>, I<32>, I<16>>,
+                                      std::tuple<I<32>, I<32>, I<32>>>;
+        using Layouts     = typename Concat<typename Base::TestLayoutsNN,
+                                        typename Base::TestLayoutsNT,
+                                        typename Base::TestLayoutsTN,
+                                        typename Base::TestLayoutsTT>::Result;
+        using LayoutsLds  = std::tuple<col_major>;
+        using GemmConfigs = typename Base::TestGemmConfigsWgLevel;
+        using BlocksXY    = std::tuple<std::tuple<I<2>, I<2>>,
+                                    std::tuple<I<2>, I<4>>,
+                                    std::tuple<I<4>, I<2>>,
+                                    std::tuple<I<4>, I<4>>>;
+        using KernelParams =
+            typename CombineLists<Types, BlockSizes, Layouts, LayoutsLds, GemmConfigs, BlocksXY>::
+                Result;
+
+        // Assemble the kernel generator
+        using GeneratorImpl   = KernelGeneratorImpl;
+        using KernelGenerator = KernelGenerator<KernelParams, GeneratorImpl>;
+
+        // Sanity check for kernel generator
+        static_assert(std::is_same<typename GeneratorImpl::ResultT, typename Base::KernelT>::value,
+                      "Kernels from this generator do not match testing interface");
+
+        static inline typename KernelGenerator::ResultT kernels()
+        {
+            return KernelGenerator::generate();
+        }
+
+        static inline std::vector<ThreadBlockT> threadBlocks()
+        {
+            auto warpSize = HipDevice::instance()->warpSize();
+
+            // 4 wave workgroups
+            std::vector<ThreadBlockT> result = {{warpSize, 4}, {warpSize * 2, 2}, {warpSize * 4, 1}};
+
+            // Wave32 targets (gfx11, gfx12) also fit 8 wave workgroups in 256 threads
+            if(warpSize == Constants::AMDGCN_WAVE_SIZE_32)
+            {
+                result.insert(result.end(), {{warpSize * 2, 4}, {warpSize * 4, 2}});
+            }
+
+            return result;
+        }
+
+        static inline std::vector<ProblemSizeT> problemSizes()
+        {
+            return {
+                // clang-format off
+                // Square
+                {1024, 1024, 1024},
+                {2048, 2048, 2048},
+                {4096, 4096, 4096},
+                {8192, 8192, 8192},
+                // Tall / wide
+                {8192, 1024, 4096},
+                {1024, 8192, 4096},
+                // Small output, deep K
+                {256, 256, 8192},
+                {512, 512, 8192}
+                // clang-format on
+            };
+        }
+    };
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_GEMM_AUTOTUNE_TEST_PARAMS
@@ -61,6 +61,27 @@ namespace rocwmma
 
         } // namespace WaveLevel
 
+        template <typename GemmConfigT, uint32_t Stages>
+        struct Pipelined;
+
+        template <typename GemmConfigT, uint32_t XcdCount, uint32_t GroupX>
+        struct XcdAware;
+
+        template <typename GemmConfigT, int32_t MfmaPriority>
+        struct PingPong;
+
+        template <typename GemmConfigT, uint32_t Depth>
+        struct KUnrolled;
+
+        template <typename GemmConfigT>
+        struct StageSynced;
+
+        template <typename GemmConfigT>
+        struct KSliced;
+
+        template <typename GemmConfigT, typename StageT>
+        struct StageConverted;
+
     } // namespace CooperativeGemm
 
     ///
@@ -86,10 +107,54 @@ namespace rocwmma
             = std::tuple<std::tuple<typename CooperativeGemm::WaveLevel::LdsNT>,
                          std::tuple<typename CooperativeGemm::WaveLevel::LdsTN>>;
 
+        using TestGemmConfigsWaveLevelPipelined = std::tuple<
+            std::tuple<typename CooperativeGemm::Pipelined<CooperativeGemm::WaveLevel::LdsNT, 3u>>,
+            std::tuple<typename CooperativeGemm::Pipelined<CooperativeGemm::WaveLevel::LdsTN, 3u>>,
+            std::tuple<typename CooperativeGemm::Pipelined<CooperativeGemm::WaveLevel::LdsNT, 4u>>,
+            std::tuple<typename CooperativeGemm::Pipelined<CooperativeGemm::WaveLevel::LdsTN, 4u>>,
+            std::tuple<typename CooperativeGemm::Scheduled<CooperativeGemm::WaveLevel::LdsNT,
+                                                           CooperativeGemm::SchedMfmaDsVmem>>,
+            std::tuple<typename CooperativeGemm::Scheduled<
+                CooperativeGemm::Pipelined<CooperativeGemm::WaveLevel::LdsTN, 3u>,
+                CooperativeGemm::SchedMfmaDsVmem>>,
+            std::tuple<typename CooperativeGemm::PingPong<CooperativeGemm::WaveLevel::LdsNT, 1>>,
+            std::tuple<typename CooperativeGemm::PingPong<
+                CooperativeGemm::Pipelined<CooperativeGemm::WaveLevel::LdsTN, 3u>,
+                1>>,
+            std::tuple<typename CooperativeGemm::KUnrolled<CooperativeGemm::WaveLevel::LdsNT, 4u>>,
+            std::tuple<typename CooperativeGemm::KUnrolled<
+                CooperativeGemm::Pipelined<CooperativeGemm::WaveLevel::LdsTN, 3u>,
+                2u>>,
+            std::tuple<typename CooperativeGemm::StageSynced<CooperativeGemm::WaveLevel::LdsNT>>,
+            std::tuple<typename CooperativeGemm::StageSynced<
+                CooperativeGemm::Pipelined<CooperativeGemm::WaveLevel::LdsTN, 3u>>>>;
+
+        // Waves of the workgroup split K over a single wave tile
+        using TestGemmConfigsWaveLevelKSliced = std::tuple<
+            std::tuple<typename CooperativeGemm::KSliced<CooperativeGemm::WaveLevel::LdsNT>>,
+            std::tuple<typename CooperativeGemm::KSliced<CooperativeGemm::WaveLevel::LdsTN>>>;
+
+        // Wave level, with float32_t operands staged through LDS and multiplied in StageT
+        template <typename StageT>
+        using StageConvertedNT
+            = CooperativeGemm::StageConverted<CooperativeGemm::WaveLevel::LdsNT, StageT>;
+
+        using TestGemmConfigsWaveLevelConverted
+            = std::tuple<std::tuple<StageConvertedNT<float16_t>>,
+                         std::tuple<StageConvertedNT<bfloat16_t>>>;
+
         using TestGemmConfigsWgLevel
             = std::tuple<std::tuple<typename CooperativeGemm::WorkgroupLevel::LdsNT>,
                          std::tuple<typename CooperativeGemm::WorkgroupLevel::LdsTN>>;
 
+        // Workgroup level, rasterized over the 8 XCDs of MI300 in bands of 4 macro tiles
+        template <typename GemmConfigT>
+        using XcdAwareMI300 = CooperativeGemm::XcdAware<GemmConfigT, 8u, 4u>;
+
+        using TestGemmConfigsWgLevelXcd
+            = std::tuple<std::tuple<XcdAwareMI300<CooperativeGemm::WorkgroupLevel::LdsNT>>,
+                         std::tuple<XcdAwareMI300<CooperativeGemm::WorkgroupLevel::LdsTN>>>;
+
         ///
         /// Kernel generator impl objects
         ///
@@ -0,0 +1,173 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <set>
+
+#include "gemm_dispatcher.hpp"
+#include "test/autotune_test_params.hpp"
+
+///
+/// Kernel dispatch. For each problem type and the common mixed problem sizes, selects
+/// one kernel of the autotuning search space with GemmDispatcher, then runs it.
+///
+/// Usage: <binary> [-tt || --tuning_table *table.csv|table.tdb*]
+/// Without a tuning table, kernels are selected by the analytic heuristic.
+///
+
+// Instantiate referenced kernels for
+// dispatch test only
+#include "gemm_kernel_base_impl.hpp"
+#include "gemm_resource_impl.hpp"
+namespace rocwmma
+{
+    bool KernelI::sHeaderPrinted = false;
+}
+
+namespace rocwmma
+{
+    struct GemmDispatchTest
+        : public ::testing::TestWithParam<
+              std::tuple<std::string, typename AutotuneTestParams::ProblemSizeT>>
+    {
+        using Base = ::testing::TestWithParam<
+            std::tuple<std::string, typename AutotuneTestParams::ProblemSizeT>>;
+
+        static GemmDispatcher const& dispatcher()
+        {
+            static auto sDispatcher = []() {
+                auto& tuningTable = GemmTuningTable::instance();
+                auto& tuningDb    = GemmTuningDb::instance();
+                auto& tuningFile  = RocwmmaLogging::instance()->tuningTableFile();
+                if(!tuningFile.empty()
+                   && !(GemmTuningDb::isDbFile(tuningFile) ? tuningDb->open(tuningFile)
+                                                           : tuningTable->load(tuningFile)))
+                {
+                    std::cerr << "Unable to load tuning table: " << tuningFile << std::endl;
+                }
+
+                return GemmDispatcher(AutotuneTestParams::kernels(),
+                                      AutotuneTestParams::threadBlocks(),
+                                      tuningTable.get(),
+                                      tuningDb.get());
+            }();
+            return sDispatcher;
+        }
+
+        // Distinct problem types of the search space
+        static std::vector<std::string> problemTypes()
+        {
+            std::set<std::string> result;
+            for(auto const& kernel : AutotuneTestParams::kernels())
+            {
+                std::stringstream problemType;
+                kernel->printProblemType(problemType);
+                result.insert(problemType.str());
+            }
+            return std::vector<std::string>(result.begin(), result.end());
+        }
+
+        void RunDispatched()
+        {
+            auto param       = Base::GetParam();
+            auto problemType = std::get<0>(param);
+            auto problemSize = std::get<1>(param);
+
+            auto selection = dispatcher().select(problemType,
+                                                 std::get<0>(problemSize),
+                                                 std::get<1>(problemSize),
+                                                 std::get<2>(problemSize));
+            if(!selection.mKernel)
+            {
+                GTEST_SKIP() << "No kernel selected for " << problemType;
+            }
+
+            auto kernel = selection.mKernel;
+
+            // Cleanup previously used resources if the resource context changes.
+            static HipResource* sLastResourceRun = nullptr;
+            if(sLastResourceRun && sLastResourceRun != kernel->getResource())
+            {
+                sLastResourceRun->reset();
+            }
+            sLastResourceRun = kernel->getResource();
+
+            ProblemParams params = {selection.mThreadBlock,
+                                    problemSize,
+                                    AutotuneTestParams::alphas()[0],
+                                    AutotuneTestParams::betas()[0]};
+
+            using Options        = rocwmma::RocwmmaLogging;
+            auto& loggingOptions = Options::instance();
+
+            kernel->setup(params);
+            kernel->exec();
+            kernel->validateResults();
+
+            if(!loggingOptions->omitCout())
+            {
+                kernel->reportResults(std::cout,
+                                      KernelI::sHeaderPrinted,
+                                      loggingOptions->omitSkipped(),
+                                      loggingOptions->omitFailed(),
+                                      loggingOptions->omitPassed());
+            }
+
+            if(loggingOptions->ostream().isOpen())
+            {
+                kernel->reportResults(loggingOptions->ostream().fstream(),
+                                      KernelI::sHeaderPrinted,
+                                      loggingOptions->omitSkipped(),
+                                      loggingOptions->omitFailed(),
+                                      loggingOptions->omitPassed());
+            }
+
+            // Print the header only once
+            if(!KernelI::sHeaderPrinted)
+            {
+                KernelI::sHeaderPrinted = true;
+            }
+
+            // Structured record for -bo || --bench_output and baseline compare
+            BenchmarkLog::instance()->record(kernel->benchmarkRecord());
+
+            kernel->tearDown();
+        }
+    };
+
+} // namespace rocwmma
+
+using rocwmma::GemmDispatchTest;
+
+TEST_P(GemmDispatchTest, RunDispatched)
+{
+    this->RunDispatched();
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    Gemm_PGR1_LB2_MP0_MB_CP,
+    GemmDispatchTest,
+    ::testing::Combine(::testing::ValuesIn(GemmDispatchTest::problemTypes()),
+                       ::testing::ValuesIn(rocwmma::GemmCommonTestParams::problemSizes())));
@@ -0,0 +1,235 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <iostream>
+#include <string>
+
+#include "gemm_bench_list.hpp"
+#include "gemm_dispatcher.hpp"
+#include "test/autotune_test_params.hpp"
+
+///
+/// Standalone GEMM benchmark. Runs each problem of a csv list with the precompiled
+/// kernels of the autotuning search space, so that the benchmarked shapes can change
+/// without rebuilding. Kernels are selected by GemmDispatcher unless the list names
+/// a kernel config and thread block.
+///
+/// Usage: rocwmma-bench -bl || --bench_list *list.csv*
+///                      [-tt || --tuning_table *table.csv|table.tdb*]
+///                      [-bo || --bench_output *file.json|file.csv*]
+///                      [-bb || --bench_baseline *file.json|file.csv*] [-bt *percent*]
+///
+/// List format, one problem per line:
+/// ProblemType, MatM, MatN, MatK, Alpha, Beta[, KernelConfig[, TBlkX, TBlkY]]
+///
+/// E.g.:
+/// f16_f32_f32_N_T_N_N, 4096, 4096, 4096, 1.0, 1.0
+/// f16_f32_f32_N_T_N_N, 8192, 1024, 4096, 2.0, 0.0, PGR1_LB2_MP0_MB_CP_32x32x16_Workgroup_LdsNT_N_2x2, 128, 2
+///
+
+// Instantiate referenced kernels for
+// the benchmark only
+#include "gemm_kernel_base_impl.hpp"
+#include "gemm_resource_impl.hpp"
+namespace rocwmma
+{
+    bool KernelI::sHeaderPrinted = false;
+}
+
+namespace rocwmma
+{
+    // Record of a problem that no kernel could run
+    BenchmarkRecord skippedRecord(GemmBenchEntry const& entry)
+    {
+        BenchmarkRecord record = {};
+        record.mSuite          = "gemm";
+        record.mArch           = static_cast<uint32_t>(HipDevice::instance()->getGcnArch());
+        record.mProblemType    = entry.mProblemType;
+        record.mKernelConfig   = entry.mKernelConfig.empty() ? "auto" : entry.mKernelConfig;
+        record.mTBlockX        = entry.mTBlockX;
+        record.mTBlockY        = entry.mTBlockY;
+        record.mM              = entry.mM;
+        record.mN              = entry.mN;
+        record.mK              = entry.mK;
+        record.mBatch          = 1u;
+        record.mBound          = "Compute";
+        record.mResult         = "SKIPPED";
+        return record;
+    }
+
+    int runBenchList(GemmBenchList const& benchList)
+    {
+        using Options        = rocwmma::RocwmmaLogging;
+        auto& loggingOptions = Options::instance();
+
+        auto& tuningTable = GemmTuningTable::instance();
+        auto& tuningDb    = GemmTuningDb::instance();
+        auto& tuningFile  = loggingOptions->tuningTableFile();
+        if(!tuningFile.empty()
+           && !(GemmTuningDb::isDbFile(tuningFile) ? tuningDb->open(tuningFile)
+                                                   : tuningTable->load(tuningFile)))
+        {
+            std::cerr << "Unable to load tuning table: " << tuningFile << std::endl;
+        }
+
+        GemmDispatcher dispatcher(AutotuneTestParams::kernels(),
+                                  AutotuneTestParams::threadBlocks(),
+                                  tuningTable.get(),
+                                  tuningDb.get());
+
+        HipResource* lastResourceRun = nullptr;
+        for(auto const& entry : benchList.entries())
+        {
+            auto selection
+                = entry.mKernelConfig.empty()
+                      ? dispatcher.select(entry.mProblemType, entry.mM, entry.mN, entry.mK)
+                      : dispatcher.select(entry.mProblemType,
+                                          entry.mKernelConfig,
+                                          {entry.mTBlockX, entry.mTBlockY},
+                                          entry.mM,
+                                          entry.mN,
+                                          entry.mK);
+
+            if(!selection.mKernel)
+            {
+                if(!loggingOptions->omitCout() && !loggingOptions->omitSkipped())
+                {
+                    std::cout << "No kernel selected for " << entry.mProblemType << ", "
+                              << entry.mM << "x" << entry.mN << "x" << entry.mK << std::endl;
+                }
+                BenchmarkLog::instance()->record(skippedRecord(entry));
+                continue;
+            }
+
+            auto kernel = selection.mKernel;
+
+            // Cleanup previously used resources if the resource context changes.
+            if(lastResourceRun && lastResourceRun != kernel->getResource())
+            {
+                lastResourceRun->reset();
+            }
+            lastResourceRun = kernel->getResource();
+
+            ProblemParams params = {selection.mThreadBlock,
+                                    {entry.mM, entry.mN, entry.mK},
+                                    entry.mAlpha,
+                                    entry.mBeta};
+
+            kernel->setup(params);
+            kernel->exec();
+            kernel->validateResults();
+
+            if(!loggingOptions->omitCout())
+            {
+                kernel->reportResults(std::cout,
+                                      KernelI::sHeaderPrinted,
+                                      loggingOptions->omitSkipped(),
+                                      loggingOptions->omitFailed(),
+                                      loggingOptions->omitPassed());
+            }
+
+            if(loggingOptions->ostream().isOpen())
+            {
+                kernel->reportResults(loggingOptions->ostream().fstream(),
+                                      KernelI::sHeaderPrinted,
+                                      loggingOptions->omitSkipped(),
+                                      loggingOptions->omitFailed(),
+                                      loggingOptions->omitPassed());
+            }
+
+            // Print the header only once
+            KernelI::sHeaderPrinted = true;
+
+            BenchmarkLog::instance()->record(kernel->benchmarkRecord());
+
+            kernel->tearDown();
+        }
+
+        if(lastResourceRun)
+        {
+            lastResourceRun->reset();
+        }
+
+        return EXIT_SUCCESS;
+    }
+
+} // namespace rocwmma
+
+int main(int argc, char** argv)
+{
+    using Options        = rocwmma::RocwmmaLogging;
+    auto& loggingOptions = Options::instance();
+    loggingOptions->parseOptions(argc, argv);
+
+    // Device sharding splits gtest cases, so it does not apply here
+    if(loggingOptions->shardDevices() >= 0)
+    {
+        std::cerr << "Device sharding is only supported by the gtest executables\n";
+        return EXIT_FAILURE;
+    }
+
+    if(auto device = loggingOptions->device(); device >= 0)
+    {
+        CHECK_HIP_ERROR(hipSetDevice(device));
+    }
+
+    auto& listFile = loggingOptions->benchListFile();
+    if(listFile.empty())
+    {
+        std::cerr << "Missing benchmark list file\n";
+        std::cerr << "Usage: -bl || --bench_list *file.csv*\n";
+        return EXIT_FAILURE;
+    }
+
+    rocwmma::GemmBenchList benchList;
+    if(!benchList.load(listFile))
+    {
+        std::cerr << "Unable to load benchmark list: " << listFile << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    int status = rocwmma::runBenchList(benchList);
+
+    // Compare recorded benchmarks against the baseline, failing on regressions
+    auto& baselineFile = loggingOptions->benchBaselineFile();
+    if(!baselineFile.empty())
+    {
+        std::vector<rocwmma::BenchmarkRecord> baseline;
+        if(!rocwmma::BenchmarkLog::load(baselineFile, baseline))
+        {
+            std::cerr << "Unable to load benchmark baseline: " << baselineFile << std::endl;
+            status = EXIT_FAILURE;
+        }
+        else if(rocwmma::BenchmarkLog::instance()->compare(baseline,
+                                                           loggingOptions->benchThreshold())
+                > 0u)
+        {
+            status = EXIT_FAILURE;
+        }
+    }
+
+    return status;
+}
@@ -0,0 +1,99 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "gemm_shape_sweep.hpp"
+#include "test/test_includes.hpp"
+
+///
+/// Shape sweep. Benchmarks the kernel configs of this family over the log and linear
+/// shape grids of GemmShapeSweep, for the crossover analysis of GemmCrossover.py.
+/// The fastest config per shape is merged into the tuning table, so sweeping each
+/// family with the same table keeps the fastest kernel across families.
+///
+/// Usage: <binary> -bo || --bench_output *file.csv* [-tt || --tuning_table *table.csv*]
+///
+
+// Instantiate referenced kernels for
+// shape sweep only
+#include "gemm_kernel_base_impl.hpp"
+#include "gemm_resource_impl.hpp"
+namespace rocwmma
+{
+    bool KernelI::sHeaderPrinted = false;
+}
+
+namespace rocwmma
+{
+
+    struct ShapeSweepTestParams : public CommonTestParams
+    {
+        using Base = CommonTestParams;
+
+        // Types: f16 inputs, f32 outputs and compute
+        // Block Sizes: 16 x 16 x 32, 32 x 32 x 16
+        // Layouts: NT
+        // Gemm configs: workgroup level
+        // Blocks: 2x2, 4x4
+        using Types       = std::tuple<std::tuple<float16_t, float32_t, float32_t>>;
+        using BlockSizes  = std::tuple<std::tuple<I<16>, I<16>, I<32>>,
+                                       std::tuple<I<32>, I<32>, I<16>>>;
+        using Layouts     = std::tuple<std::tuple<col_major, row_major, col_major>>;
+        using LayoutsLds  = std::tuple<col_major>;
+        using GemmConfigs = typename Base::TestGemmConfigsWgLevel;
+        using BlocksXY    = std::tuple<std::tuple<I<2>, I<2>>, std::tuple<I<4>, I<4>>>;
+        using KernelParams =
+            typename CombineLists<Types, BlockSizes, Layouts, LayoutsLds, GemmConfigs, BlocksXY>::
+                Result;
+
+        // Assemble the kernel generator
+        using GeneratorImpl   = typename Base::KernelGeneratorImpl;
+        using KernelGenerator = KernelGenerator<KernelParams, GeneratorImpl>;
+
+        // Sanity check for kernel generator
+        static_assert(std::is_same<typename GeneratorImpl::ResultT, typename Base::KernelT>::value,
+                      "Kernels from this generator do not match testing interface");
+
+        static inline typename KernelGenerator::ResultT kernels()
+        {
+            return KernelGenerator::generate();
+        }
+
+        static inline std::vector<ThreadBlockT> threadBlocks()
+        {
+            return GemmShapeSweep::threadBlocks();
+        }
+
+        static inline std::vector<ProblemSizeT> problemSizes()
+        {
+            return GemmShapeSweep::problemSizes();
+        }
+    };
+
+} // namespace rocwmma
+
+ROCWMMA_INSTANTIATE_GEMM_GTEST_TUNING_SUITE(Gemm_PGR1_LB2_MP0_MB_CP,
+                                            ShapeSweep,
+                                            rocwmma::ShapeSweepTestParams);
@@ -0,0 +1,106 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "test/test_includes.hpp"
+
+///
+/// XCD-aware rasterization benchmark. Compares workgroup level kernels with and without
+/// raster::xcd on large and K-heavy shapes, where neighbouring macro tiles re-use A / B
+/// panels in the L2 of the same XCD. Targets MI300 (gfx942) with 8 XCDs.
+///
+
+// Instantiate referenced kernels for
+// xcd benchmark only
+#include "gemm_kernel_base_impl.hpp"
+#include "gemm_resource_impl.hpp"
+namespace rocwmma
+{
+    bool KernelI::sHeaderPrinted = false;
+}
+
+namespace rocwmma
+{
+
+    struct XcdTestParams : public CommonTestParams
+    {
+        using Base = CommonTestParams;
+
+        // Types: f16 inputs, f32 compute
+        // Block Sizes: 32 x 32 x 16
+        // Layouts: NT, TN
+        // Gemm configs: workgroup level, linear and XCD-aware rasterization
+        // Blocks: 2x2
+        using Types       = std::tuple<std::tuple<float16_t, float32_t, float32_t>>;
+        using BlockSizes  = std::tuple<std::tuple<I<32>, I<32>, I<16>>>;
+        using Layouts     = typename Concat<typename Base::TestLayoutsNT,
+                                        typename Base::TestLayoutsTN>::Result;
+        using LayoutsLds  = std::tuple<col_major>;
+        using GemmConfigs = typename Concat<typename Base::TestGemmConfigsWgLevel,
+                                            typename Base::TestGemmConfigsWgLevelXcd>::Result;
+        using BlocksXY    = std::tuple<std::tuple<I<2>, I<2>>>;
+        using KernelParams =
+            typename CombineLists<Types, BlockSizes, Layouts, LayoutsLds, GemmConfigs, BlocksXY>::
+                Result;
+
+        // Assemble the kernel generator
+        using GeneratorImpl   = KernelGeneratorImpl;
+        using KernelGenerator = KernelGenerator<KernelParams, GeneratorImpl>;
+
+        // Sanity check for kernel generator
+        static_assert(std::is_same<typename GeneratorImpl::ResultT, typename Base::KernelT>::value,
+                      "Kernels from this generator do not match testing interface");
+
+        static inline typename KernelGenerator::ResultT kernels()
+        {
+            return KernelGenerator::generate();
+        }
+
+        static inline std::vector<ThreadBlockT> threadBlocks()
+        {
+            auto warpSize = HipDevice::instance()->warpSize();
+
+            return {{warpSize * 2, 2}};
+        }
+
+        static inline std::vector<ProblemSizeT> problemSizes()
+        {
+            return {
+                // clang-format off
+                // Square
+                {8192, 8192, 8192},
+                {16384, 16384, 16384},
+                // K-heavy
+                {4096, 4096, 16384},
+                {2048, 2048, 32768},
+                {8192, 4096, 16384}
+                // clang-format on
+            };
+        }
+    };
+
+} // namespace rocwmma
+
+ROCWMMA_INSTANTIATE_GEMM_GTEST_SUITE(Gemm_PGR1_LB2_MP0_MB_CP, Wg_Xcd, rocwmma::XcdTestParams);
@@ -0,0 +1,133 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef ROCWMMA_GEMM_BENCH_LIST_HPP
+#define ROCWMMA_GEMM_BENCH_LIST_HPP
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace rocwmma
+{
+    // One problem of a runtime benchmark list. An empty or "auto" KernelConfig
+    // lets GemmDispatcher choose the kernel, and zero sized thread blocks let the
+    // dispatcher heuristic choose the thread block of the kernel.
+    struct GemmBenchEntry
+    {
+        std::string mProblemType;
+        uint32_t    mM, mN, mK;
+        double      mAlpha, mBeta;
+        std::string mKernelConfig;
+        uint32_t    mTBlockX, mTBlockY;
+    };
+
+    // Benchmark problems read at runtime.
+    // Lists are stored as csv, one problem per line:
+    // ProblemType, MatM, MatN, MatK, Alpha, Beta[, KernelConfig[, TBlkX, TBlkY]]
+    class GemmBenchList
+    {
+    public:
+        std::vector<GemmBenchEntry> const& entries() const
+        {
+            return mEntries;
+        }
+
+        // Appends the problems of the stream to the list.
+        // Returns false on malformed lines, reporting the line number.
+        bool read(std::istream& stream)
+        {
+            std::string line;
+            uint32_t    lineNumber = 0u;
+            while(std::getline(stream, line))
+            {
+                lineNumber++;
+
+                auto start = line.find_first_not_of(" \t\r");
+                if(start == std::string::npos || line[start] == '#')
+                {
+                    continue;
+                }
+
+                std::vector<std::string> fields;
+                std::stringstream        lineStream(line);
+                std::string              field;
+                while(std::getline(lineStream, field, ','))
+                {
+                    auto first = field.find_first_not_of(" \t\r");
+                    auto last  = field.find_last_not_of(" \t\r");
+                    fields.push_back(first == std::string::npos
+                                         ? ""
+                                         : field.substr(first, last - first + 1));
+                }
+
+                if(fields.size() != 6 && fields.size() != 7 && fields.size() != 9)
+                {
+                    std::cerr << "Benchmark list line " << lineNumber << ": expected 6, 7 or 9 "
+                              << "fields, found " << fields.size() << std::endl;
+                    return false;
+                }
+
+                GemmBenchEntry entry;
+                try
+                {
+                    entry.mProblemType  = fields[0];
+                    entry.mM            = std::stoul(fields[1]);
+                    entry.mN            = std::stoul(fields[2]);
+                    entry.mK            = std::stoul(fields[3]);
+                    entry.mAlpha        = std::stod(fields[4]);
+                    entry.mBeta         = std::stod(fields[5]);
+                    entry.mKernelConfig = fields.size() > 6 && fields[6] != "auto" ? fields[6] : "";
+                    entry.mTBlockX      = fields.size() > 7 ? std::stoul(fields[7]) : 0u;
+                    entry.mTBlockY      = fields.size() > 7 ? std::stoul(fields[8]) : 0u;
+                }
+                catch(std::exception const&)
+                {
+                    std::cerr << "Benchmark list line " << lineNumber << ": malformed value"
+                              << std::endl;
+                    return false;
+                }
+
+                mEntries.push_back(entry);
+            }
+            return true;
+        }
+
+        bool load(std::string const& fileName)
+        {
+            std::ifstream file(fileName);
+            return file.is_open() && read(file);
+        }
+
+    private:
+        std::vector<GemmBenchEntry> mEntries;
+    };
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_GEMM_BENCH_LIST_HPP
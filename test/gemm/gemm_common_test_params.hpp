@@ -303,7 +303,10 @@ namespace rocwmma
                 {warpSize, 2}, {warpSize * 2, 1}, // 2 wave
 #endif // ROCWMMA_VALIDATION_TESTS || ROCWMMA_EXTENDED_TESTS
                 {warpSize, 4}, {warpSize * 2, 2}, // 4 wave
-                {warpSize * 4, 1}  // 4 wave
+                {warpSize * 4, 1}, // 4 wave
+#if ROCWMMA_EXTENDED_TESTS
+                {0, 0}, // Selected per problem by GemmMappingSelector
+#endif // ROCWMMA_EXTENDED_TESTS
                 // clang-format on
             };
         }
@@ -30,6 +30,7 @@
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
 #include <rocwmma/rocwmma.hpp>
 #include <rocwmma/rocwmma_coop.hpp>
+#include <rocwmma/rocwmma_epilogue.hpp>
 #include <rocwmma/rocwmma_transforms.hpp>
 #pragma GCC diagnostic pop
 
@@ -430,6 +431,291 @@ namespace rocwmma
 
         } // namespace WorkgroupLevel
 
+        /* Pipelined GEMMs:
+        *  This GEMM configuration wraps any of the above configurations and
+        *  sets the number of stages of the accumulation pipeline in the
+        *  kernels that support it (see GemmPipeline).
+        *
+        *  Stages = 2 is double-buffering, or prefetch x1 K step.
+        *  Stages = 3 and 4 prefetch x2 and x3 K steps from global memory.
+        */
+        template <typename GemmConfigT, uint32_t Stages>
+        struct Pipelined : public GemmConfigT
+        {
+            constexpr static uint32_t PipelineStages = Stages;
+        };
+
+        // Number of pipeline stages of the GEMM configuration (default 2)
+        template <typename GemmConfig, typename Enabler = void>
+        struct PipelineStages : public std::integral_constant<uint32_t, 2u>
+        {
+        };
+
+        template <typename GemmConfig>
+        struct PipelineStages<GemmConfig, std::void_t<decltype(GemmConfig::PipelineStages)>>
+            : public std::integral_constant<uint32_t, GemmConfig::PipelineStages>
+        {
+        };
+
+        template <typename GemmConfig>
+        constexpr static uint32_t PipelineStages_v = PipelineStages<GemmConfig>::value;
+
+        /* Scheduled GEMMs:
+        *  This GEMM configuration wraps any of the above configurations and
+        *  sets the instruction scheduling policy of each K step of the
+        *  accumulation pipeline in the kernels that support it (see GemmPipeline).
+        */
+        template <typename GemmConfigT, typename SchedPolicyT>
+        struct Scheduled : public GemmConfigT
+        {
+            using SchedPolicy = SchedPolicyT;
+        };
+
+        // Scheduling policy of the GEMM configuration (default SchedNone)
+        template <typename GemmConfig, typename Enabler = void>
+        struct SchedulePolicy
+        {
+            using type = SchedNone;
+        };
+
+        template <typename GemmConfig>
+        struct SchedulePolicy<GemmConfig, std::void_t<typename GemmConfig::SchedPolicy>>
+        {
+            using type = typename GemmConfig::SchedPolicy;
+        };
+
+        template <typename GemmConfig>
+        using SchedulePolicy_t = typename SchedulePolicy<GemmConfig>::type;
+
+        // Interleaves each mfma with local reads and global reads of the next K step
+        using SchedMfmaDsVmem = SchedInterleave<4u,
+                                                SchedGroup<SchedMask::Mma, 1>,
+                                                SchedGroup<SchedMask::DsRead, 2>,
+                                                SchedGroup<SchedMask::VmemRead, 1>>;
+
+        /* Ping-pong GEMMs:
+        *  This GEMM configuration wraps any of the above configurations and
+        *  alternates two groups of waves between the memory and mfma phases
+        *  of each K step in the kernels that support it (see GemmPipeline).
+        *
+        *  Mfma phases run at wave priority MfmaPriority (s_setprio 0 - 3).
+        *  Waves pair up on each SIMD with 8 waves of 64 per workgroup.
+        */
+        template <typename GemmConfigT, int32_t MfmaPriority = 1>
+        struct PingPong : public GemmConfigT
+        {
+            static_assert(MfmaPriority >= 0 && MfmaPriority <= 3,
+                          "Wave priority must be 0, 1, 2 or 3");
+            constexpr static int32_t PingPongPriority = MfmaPriority;
+        };
+
+        // Mfma wave priority of the ping-pong GEMM configuration (default -1, disabled)
+        template <typename GemmConfig, typename Enabler = void>
+        struct PingPongPriority : public std::integral_constant<int32_t, -1>
+        {
+        };
+
+        template <typename GemmConfig>
+        struct PingPongPriority<GemmConfig, std::void_t<decltype(GemmConfig::PingPongPriority)>>
+            : public std::integral_constant<int32_t, GemmConfig::PingPongPriority>
+        {
+        };
+
+        template <typename GemmConfig>
+        constexpr static int32_t PingPongPriority_v = PingPongPriority<GemmConfig>::value;
+
+        /* K-unrolled GEMMs:
+        *  This GEMM configuration wraps any of the above configurations and
+        *  unrolls the K loop of the accumulation pipeline by Depth times its
+        *  prefetch depth in the kernels that support it (see GemmPipeline).
+        */
+        template <typename GemmConfigT, uint32_t Depth>
+        struct KUnrolled : public GemmConfigT
+        {
+            static_assert(Depth >= 1u, "K loop unroll depth must be at least 1");
+            constexpr static uint32_t KUnroll = Depth;
+        };
+
+        // K loop unroll depth of the GEMM configuration (default 1)
+        template <typename GemmConfig, typename Enabler = void>
+        struct KUnroll : public std::integral_constant<uint32_t, 1u>
+        {
+        };
+
+        template <typename GemmConfig>
+        struct KUnroll<GemmConfig, std::void_t<decltype(GemmConfig::KUnroll)>>
+            : public std::integral_constant<uint32_t, GemmConfig::KUnroll>
+        {
+        };
+
+        template <typename GemmConfig>
+        constexpr static uint32_t KUnroll_v = KUnroll<GemmConfig>::value;
+
+        /* Stage synced GEMMs:
+        *  This GEMM configuration wraps any of the above configurations and
+        *  replaces the workgroup barrier of each K step with LDS counters per
+        *  LDS buffer in the kernels that support it (see GemmPipeline). Waves
+        *  only wait on the local reads and writes of the buffers they use.
+        */
+        template <typename GemmConfigT>
+        struct StageSynced : public GemmConfigT
+        {
+            constexpr static bool StageSync = true;
+        };
+
+        // Whether the GEMM configuration synchronizes per LDS buffer (default false)
+        template <typename GemmConfig, typename Enabler = void>
+        struct StageSync : public std::integral_constant<bool, false>
+        {
+        };
+
+        template <typename GemmConfig>
+        struct StageSync<GemmConfig, std::void_t<decltype(GemmConfig::StageSync)>>
+            : public std::integral_constant<bool, GemmConfig::StageSync>
+        {
+        };
+
+        template <typename GemmConfig>
+        constexpr static bool StageSync_v = StageSync<GemmConfig>::value;
+
+        /* Stage converted GEMMs:
+        *  This GEMM configuration wraps any of the above configurations and
+        *  stages A and B through LDS in StageT, e.g. float16_t or bfloat16_t
+        *  for float32_t operands, in the kernels that support it (see
+        *  GemmPipeline). The global reads convert each vector to StageT in
+        *  registers (see GemmDriver::globalReadCoopConvertA / B), such that
+        *  LDS, the local reads and the mfma all use StageT. The converted
+        *  operands are never written to global memory.
+        */
+        template <typename GemmConfigT, typename StageT>
+        struct StageConverted : public GemmConfigT
+        {
+            using StageType = StageT;
+        };
+
+        // Datatype of A and B in LDS and in the mfma (default InputT)
+        template <typename GemmConfig, typename InputT, typename Enabler = void>
+        struct StageType
+        {
+            using type = InputT;
+        };
+
+        template <typename GemmConfig, typename InputT>
+        struct StageType<GemmConfig, InputT, std::void_t<typename GemmConfig::StageType>>
+        {
+            using type = typename GemmConfig::StageType;
+        };
+
+        template <typename GemmConfig, typename InputT>
+        using StageType_t = typename StageType<GemmConfig, InputT>::type;
+
+        /* K-sliced GEMMs:
+        *  This GEMM configuration wraps a wave level configuration for small
+        *  M x N, large K problems such as GEMV or attention decode, where a wave
+        *  tile per wave leaves most waves without work. All waves of the workgroup
+        *  compute the same wave tile over different K steps (see KSlicedMapping),
+        *  reading MFMA blocks directly from global memory. Their accumulators are
+        *  then summed into the first wave over LDS (see lds_reduction), which
+        *  alone writes D.
+        */
+        template <typename GemmConfigT>
+        struct KSliced : public GemmConfigT
+        {
+            constexpr static bool KSlice = true;
+
+            template <uint32_t BlockM,
+                      uint32_t BlockN,
+                      uint32_t BlockK,
+                      typename InputT,
+                      typename OutputT,
+                      typename ComputeT,
+                      typename LayoutA,
+                      typename LayoutB,
+                      typename LayoutC,
+                      typename LayoutD,
+                      uint32_t BlocksX,
+                      uint32_t BlocksY,
+                      uint32_t TBlockX = 0,
+                      uint32_t TBlockY = 0>
+            using GlobalMapping = GlobalMapping::KSlicedMapping<BlockM,
+                                                                BlockN,
+                                                                BlockK,
+                                                                InputT,
+                                                                OutputT,
+                                                                ComputeT,
+                                                                LayoutA,
+                                                                LayoutB,
+                                                                LayoutC,
+                                                                LayoutD,
+                                                                BlocksX,
+                                                                BlocksY,
+                                                                TBlockX,
+                                                                TBlockY>;
+        };
+
+        // Whether the waves of the GEMM configuration split K (default false)
+        template <typename GemmConfig, typename Enabler = void>
+        struct KSlice : public std::integral_constant<bool, false>
+        {
+        };
+
+        template <typename GemmConfig>
+        struct KSlice<GemmConfig, std::void_t<decltype(GemmConfig::KSlice)>>
+            : public std::integral_constant<bool, GemmConfig::KSlice>
+        {
+        };
+
+        template <typename GemmConfig>
+        constexpr static bool KSlice_v = KSlice<GemmConfig>::value;
+
+        /* XCD-aware GEMMs:
+        *  This GEMM configuration wraps a workgroup level configuration and
+        *  rasterizes its macro tiles for multi-die GPUs (see raster::xcd).
+        *
+        *  MI300 dispatches workgroup IDs round-robin over XcdCount XCDs, each
+        *  with a private L2, such that neighbouring macro tiles sharing A / B
+        *  panels run on different dies. The workgroup IDs of each XCD are
+        *  remapped to a contiguous range of macro tiles, visited in bands of
+        *  GroupX macro tile rows, so operand panels are re-used within the
+        *  L2 of each die.
+        */
+        template <typename GemmConfigT, uint32_t XcdCount = 8u, uint32_t GroupX = 4u>
+        struct XcdAware : public GemmConfigT
+        {
+            using RasterPolicy = raster::xcd<XcdCount, raster::grouped<GroupX>>;
+
+            template <uint32_t BlockM,
+                      uint32_t BlockN,
+                      uint32_t BlockK,
+                      typename InputT,
+                      typename OutputT,
+                      typename ComputeT,
+                      typename LayoutA,
+                      typename LayoutB,
+                      typename LayoutC,
+                      typename LayoutD,
+                      uint32_t BlocksX,
+                      uint32_t BlocksY,
+                      uint32_t TBlockX,
+                      uint32_t TBlockY>
+            using GlobalMapping
+                = GlobalMapping::WorkgroupLevelMapping<BlockM,
+                                                       BlockN,
+                                                       BlockK,
+                                                       InputT,
+                                                       OutputT,
+                                                       ComputeT,
+                                                       LayoutA,
+                                                       LayoutB,
+                                                       LayoutC,
+                                                       LayoutD,
+                                                       BlocksX,
+                                                       BlocksY,
+                                                       TBlockX,
+                                                       TBlockY,
+                                                       RasterPolicy>;
+        };
+
     } // namespace CooperativeGemm
 
     template <>
@@ -474,6 +760,135 @@ namespace rocwmma
         return "Workgroup_LdsTN";
     }
 
+    template <>
+    constexpr const char*
+        dataTypeToString<typename CooperativeGemm::Pipelined<CooperativeGemm::WaveLevel::LdsNT, 3u>>()
+    {
+        return "Wave_LdsNT_PS3";
+    }
+
+    template <>
+    constexpr const char*
+        dataTypeToString<typename CooperativeGemm::Pipelined<CooperativeGemm::WaveLevel::LdsNT, 4u>>()
+    {
+        return "Wave_LdsNT_PS4";
+    }
+
+    template <>
+    constexpr const char*
+        dataTypeToString<typename CooperativeGemm::Pipelined<CooperativeGemm::WaveLevel::LdsTN, 3u>>()
+    {
+        return "Wave_LdsTN_PS3";
+    }
+
+    template <>
+    constexpr const char*
+        dataTypeToString<typename CooperativeGemm::Pipelined<CooperativeGemm::WaveLevel::LdsTN, 4u>>()
+    {
+        return "Wave_LdsTN_PS4";
+    }
+
+    template <>
+    constexpr const char*
+        dataTypeToString<typename CooperativeGemm::Scheduled<CooperativeGemm::WaveLevel::LdsNT,
+                                                             CooperativeGemm::SchedMfmaDsVmem>>()
+    {
+        return "Wave_LdsNT_SI";
+    }
+
+    template <>
+    constexpr const char* dataTypeToString<typename CooperativeGemm::Scheduled<
+        CooperativeGemm::Pipelined<CooperativeGemm::WaveLevel::LdsTN, 3u>,
+        CooperativeGemm::SchedMfmaDsVmem>>()
+    {
+        return "Wave_LdsTN_PS3_SI";
+    }
+
+    template <>
+    constexpr const char*
+        dataTypeToString<typename CooperativeGemm::PingPong<CooperativeGemm::WaveLevel::LdsNT>>()
+    {
+        return "Wave_LdsNT_PP";
+    }
+
+    template <>
+    constexpr const char* dataTypeToString<typename CooperativeGemm::PingPong<
+        CooperativeGemm::Pipelined<CooperativeGemm::WaveLevel::LdsTN, 3u>>>()
+    {
+        return "Wave_LdsTN_PS3_PP";
+    }
+
+    template <>
+    constexpr const char*
+        dataTypeToString<typename CooperativeGemm::KUnrolled<CooperativeGemm::WaveLevel::LdsNT, 4u>>()
+    {
+        return "Wave_LdsNT_KU4";
+    }
+
+    template <>
+    constexpr const char* dataTypeToString<typename CooperativeGemm::KUnrolled<
+        CooperativeGemm::Pipelined<CooperativeGemm::WaveLevel::LdsTN, 3u>,
+        2u>>()
+    {
+        return "Wave_LdsTN_PS3_KU2";
+    }
+
+    template <>
+    constexpr const char*
+        dataTypeToString<typename CooperativeGemm::StageSynced<CooperativeGemm::WaveLevel::LdsNT>>()
+    {
+        return "Wave_LdsNT_SS";
+    }
+
+    template <>
+    constexpr const char* dataTypeToString<typename CooperativeGemm::StageSynced<
+        CooperativeGemm::Pipelined<CooperativeGemm::WaveLevel::LdsTN, 3u>>>()
+    {
+        return "Wave_LdsTN_PS3_SS";
+    }
+
+    template <>
+    constexpr const char* dataTypeToString<
+        typename CooperativeGemm::StageConverted<CooperativeGemm::WaveLevel::LdsNT, float16_t>>()
+    {
+        return "Wave_LdsNT_CS_F16";
+    }
+
+    template <>
+    constexpr const char* dataTypeToString<
+        typename CooperativeGemm::StageConverted<CooperativeGemm::WaveLevel::LdsNT, bfloat16_t>>()
+    {
+        return "Wave_LdsNT_CS_BF16";
+    }
+
+    template <>
+    constexpr const char*
+        dataTypeToString<typename CooperativeGemm::KSliced<CooperativeGemm::WaveLevel::LdsNT>>()
+    {
+        return "Wave_LdsNT_KS";
+    }
+
+    template <>
+    constexpr const char*
+        dataTypeToString<typename CooperativeGemm::KSliced<CooperativeGemm::WaveLevel::LdsTN>>()
+    {
+        return "Wave_LdsTN_KS";
+    }
+
+    template <>
+    constexpr const char*
+        dataTypeToString<typename CooperativeGemm::XcdAware<CooperativeGemm::WorkgroupLevel::LdsNT>>()
+    {
+        return "Workgroup_LdsNT_XCD8";
+    }
+
+    template <>
+    constexpr const char*
+        dataTypeToString<typename CooperativeGemm::XcdAware<CooperativeGemm::WorkgroupLevel::LdsTN>>()
+    {
+        return "Workgroup_LdsTN_XCD8";
+    }
+
 } // namespace rocwmma
 
 #endif // GEMM_CONFIG_HPP
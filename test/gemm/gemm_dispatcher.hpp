@@ -0,0 +1,322 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef ROCWMMA_GEMM_DISPATCHER_HPP
+#define ROCWMMA_GEMM_DISPATCHER_HPP
+
+#include <cmath>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <rocwmma/internal/utils.hpp>
+
+#include "gemm_kernel_base.hpp"
+#include "gemm_mapping_selector.hpp"
+#include "gemm_tuning_db.hpp"
+#include "gemm_tuning_table.hpp"
+#include "hip_device.hpp"
+
+namespace rocwmma
+{
+    // Host-side selection of a precompiled GEMM kernel and thread block size
+    // per problem shape. Selection follows, in order:
+    // 1. Tuning table or tuning db entry of the exact shape
+    // 2. Tuning table or tuning db entry of the nearest tuned shape, within 2x of each dimension
+    // 3. Analytic heuristic over the candidate kernels (GemmMappingSelector)
+    // The tuning db is looked up first, without allocating.
+    class GemmDispatcher
+    {
+    public:
+        using KernelT      = std::shared_ptr<KernelI>;
+        using ThreadBlockT = std::pair<int64_t, int64_t>;
+
+        struct Selection
+        {
+            KernelT      mKernel;
+            ThreadBlockT mThreadBlock;
+        };
+
+        GemmDispatcher(std::vector<KernelT> const&      kernels,
+                       std::vector<ThreadBlockT> const& threadBlocks,
+                       GemmTuningTable const*           tuningTable = nullptr,
+                       GemmTuningDb const*              tuningDb    = nullptr)
+            : mThreadBlocks(threadBlocks)
+            , mTuningTable(tuningTable)
+            , mTuningDb(tuningDb)
+        {
+            for(auto const& kernel : kernels)
+            {
+                std::stringstream problemType, kernelConfig;
+                kernel->printProblemType(problemType);
+                kernel->printKernelConfig(kernelConfig);
+                mCandidates.push_back(
+                    {kernel, problemType.str(), kernelConfig.str(), kernel->waveTileSize()});
+            }
+        }
+
+        // Returns a null kernel if no candidate computes the problem type,
+        // or the problem is smaller than every candidate's workgroup tile.
+        Selection
+            select(std::string const& problemType, uint32_t m, uint32_t n, uint32_t k) const
+        {
+            auto result = fromTuningDb(problemType, m, n, k);
+            if(!result.mKernel)
+            {
+                result = fromTuningTable(problemType, m, n, k);
+            }
+            if(!result.mKernel)
+            {
+                result = fromHeuristic(problemType, "", m, n, k);
+            }
+            return result;
+        }
+
+        // Selects the named kernel configuration. If no thread block is given
+        // (zero sized), the heuristic picks one of the candidate thread blocks.
+        // Returns a null kernel if the configuration does not exist or does not fit.
+        Selection select(std::string const&  problemType,
+                         std::string const&  kernelConfig,
+                         ThreadBlockT const& threadBlock,
+                         uint32_t            m,
+                         uint32_t            n,
+                         uint32_t            k) const
+        {
+            if(threadBlock.first > 0 && threadBlock.second > 0)
+            {
+                return fromConfig(problemType, kernelConfig.c_str(), threadBlock, m, n, k);
+            }
+            return fromHeuristic(problemType, kernelConfig, m, n, k);
+        }
+
+    private:
+        struct Candidate
+        {
+            KernelT                                  mKernel;
+            std::string                              mProblemType;
+            std::string                              mKernelConfig;
+            std::tuple<uint32_t, uint32_t, uint32_t> mWaveTileSize;
+        };
+
+        // The problem must be a whole number of workgroup tiles of the candidate,
+        // as the kernels have no tail for the remainders (see checkSizes)
+        static bool fits(Candidate const&    candidate,
+                         ThreadBlockT const& threadBlock,
+                         uint32_t            m,
+                         uint32_t            n,
+                         uint32_t            k)
+        {
+            auto warpSize = static_cast<uint32_t>(HipDevice::instance()->warpSize());
+            return GemmMappingSelector::fits(
+                candidate.mWaveTileSize, threadBlock, warpSize, m, n, k);
+        }
+
+        Selection fromConfig(std::string const&  problemType,
+                             char const*         kernelConfig,
+                             ThreadBlockT const& threadBlock,
+                             uint32_t            m,
+                             uint32_t            n,
+                             uint32_t            k) const
+        {
+            for(auto const& candidate : mCandidates)
+            {
+                if(candidate.mProblemType == problemType
+                   && candidate.mKernelConfig == kernelConfig
+                   && fits(candidate, threadBlock, m, n, k))
+                {
+                    return {candidate.mKernel, threadBlock};
+                }
+            }
+            return {nullptr, {0, 0}};
+        }
+
+        Selection fromEntry(GemmTuningEntry const& entry, uint32_t m, uint32_t n, uint32_t k) const
+        {
+            return fromConfig(entry.mProblemType,
+                              entry.mKernelConfig.c_str(),
+                              {entry.mTBlockX, entry.mTBlockY},
+                              m,
+                              n,
+                              k);
+        }
+
+        Selection fromDbEntry(GemmTuningDb::Entry const& entry,
+                              std::string const&         problemType,
+                              uint32_t                   m,
+                              uint32_t                   n,
+                              uint32_t                   k) const
+        {
+            return fromConfig(problemType,
+                              mTuningDb->string(entry.mKernelConfig),
+                              {entry.mTBlockX, entry.mTBlockY},
+                              m,
+                              n,
+                              k);
+        }
+
+        Selection fromTuningDb(std::string const& problemType,
+                               uint32_t           m,
+                               uint32_t           n,
+                               uint32_t           k) const
+        {
+            if(mTuningDb == nullptr || !mTuningDb->isOpen())
+            {
+                return {nullptr, {0, 0}};
+            }
+
+            auto arch = static_cast<uint32_t>(HipDevice::instance()->getGcnArch());
+
+            // Exact shape
+            if(auto entry = mTuningDb->find(arch, problemType, m, n, k))
+            {
+                auto result = fromDbEntry(*entry, problemType, m, n, k);
+                if(result.mKernel)
+                {
+                    return result;
+                }
+            }
+
+            // Nearest tuned shape that a candidate can run
+            auto nearest = mTuningDb->findNearest(
+                arch, problemType, m, n, k, [&](GemmTuningDb::Entry const& entry) {
+                    return fromDbEntry(entry, problemType, m, n, k).mKernel != nullptr;
+                });
+            return nearest ? fromDbEntry(*nearest, problemType, m, n, k)
+                           : Selection{nullptr, {0, 0}};
+        }
+
+        Selection fromTuningTable(std::string const& problemType,
+                                  uint32_t           m,
+                                  uint32_t           n,
+                                  uint32_t           k) const
+        {
+            if(mTuningTable == nullptr)
+            {
+                return {nullptr, {0, 0}};
+            }
+
+            auto arch = static_cast<uint32_t>(HipDevice::instance()->getGcnArch());
+
+            // Exact shape
+            if(auto entry = mTuningTable->find(arch, problemType, m, n, k))
+            {
+                auto result = fromEntry(*entry, m, n, k);
+                if(result.mKernel)
+                {
+                    return result;
+                }
+            }
+
+            // Nearest tuned shape, by log distance
+            auto logRatio = [](uint32_t lhs, uint32_t rhs) {
+                return std::fabs(std::log2(double(lhs) / double(rhs)));
+            };
+
+            auto                   bestDistance = 0.0;
+            GemmTuningEntry const* nearest      = nullptr;
+            for(auto const& entry : mTuningTable->entries())
+            {
+                if(entry.mArch != arch || entry.mProblemType != problemType
+                   || !fromEntry(entry, m, n, k).mKernel)
+                {
+                    continue;
+                }
+
+                auto dm = logRatio(m, entry.mM);
+                auto dn = logRatio(n, entry.mN);
+                auto dk = logRatio(k, entry.mK);
+
+                // Within 2x of each dimension
+                if(dm > 1.0 || dn > 1.0 || dk > 1.0)
+                {
+                    continue;
+                }
+
+                auto distance = dm + dn + dk;
+                if(nearest == nullptr || distance < bestDistance)
+                {
+                    nearest      = &entry;
+                    bestDistance = distance;
+                }
+            }
+
+            return nearest ? fromEntry(*nearest, m, n, k) : Selection{nullptr, {0, 0}};
+        }
+
+        // Scores each candidate and thread block with GemmMappingSelector::cost.
+        // An empty kernelConfig considers all candidates of the problem type.
+        Selection fromHeuristic(std::string const& problemType,
+                                std::string const& kernelConfig,
+                                uint32_t           m,
+                                uint32_t           n,
+                                uint32_t           k) const
+        {
+            auto& deviceInfo = HipDevice::instance();
+            auto  warpSize   = static_cast<uint32_t>(deviceInfo->warpSize());
+            auto  cuCount    = static_cast<uint32_t>(deviceInfo->cuCount());
+
+            auto      bestScore = 0.0;
+            Selection result    = {nullptr, {0, 0}};
+            for(auto const& candidate : mCandidates)
+            {
+                if(candidate.mProblemType != problemType
+                   || (!kernelConfig.empty() && candidate.mKernelConfig != kernelConfig))
+                {
+                    continue;
+                }
+
+                for(auto const& threadBlock : mThreadBlocks)
+                {
+                    if(!fits(candidate, threadBlock, m, n, k))
+                    {
+                        continue;
+                    }
+
+                    auto score = GemmMappingSelector::cost(
+                                     candidate.mWaveTileSize, threadBlock, warpSize, cuCount, m, n)
+                                     .score();
+                    if(score > bestScore)
+                    {
+                        bestScore = score;
+                        result    = {candidate.mKernel, threadBlock};
+                    }
+                }
+            }
+
+            return result;
+        }
+
+        std::vector<Candidate>    mCandidates;
+        std::vector<ThreadBlockT> mThreadBlocks;
+        GemmTuningTable const*    mTuningTable;
+        GemmTuningDb const*       mTuningDb;
+    };
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_GEMM_DISPATCHER_HPP
@@ -125,14 +125,51 @@ namespace rocwmma
                                                           GetDataType_t<GRFragB> const* gAddrB,
                                                           uint32_t                      ldb);
 
+            // Global A/B reads in cooperative mode from SrcT data (e.g. float32_t), converted
+            // to the datatype of the GR frags in registers. The converted operands are written
+            // to LDS by the local writes, and never to global memory.
+            template <uint32_t BlocksX, typename SrcT>
+            __device__ static inline void globalReadCoopConvertA(GRFragA (&fragsA)[BlocksX],
+                                                                 SrcT const* gAddrA,
+                                                                 uint32_t    lda);
+            template <typename SrcT>
+            __device__ static inline void
+                globalReadCoopConvertA(GRFragA& grFragA, SrcT const* gAddrA, uint32_t lda);
+
+            template <uint32_t BlocksY, typename SrcT>
+            __device__ static inline void globalReadCoopConvertB(GRFragB (&fragsB)[BlocksY],
+                                                                 SrcT const* gAddrB,
+                                                                 uint32_t    ldb);
+            template <typename SrcT>
+            __device__ static inline void
+                globalReadCoopConvertB(GRFragB& grFragB, SrcT const* gAddrB, uint32_t ldb);
+
+            // Global A/B reads non-cooperative, straight to MFMA frags
+            // Single or BlocksX / BlocksY frags
+            template <uint32_t BlocksX>
+            __device__ static inline void globalReadA(MfmaFragA (&fragsA)[BlocksX],
+                                                      GetDataType_t<MfmaFragA> const* gAddrA,
+                                                      uint32_t                        lda);
+            __device__ static inline void
+                globalReadA(MfmaFragA& fragA, GetDataType_t<MfmaFragA> const* gAddrA, uint32_t lda);
+
+            template <uint32_t BlocksY>
+            __device__ static inline void globalReadB(MfmaFragB (&fragsB)[BlocksY],
+                                                      GetDataType_t<MfmaFragB> const* gAddrB,
+                                                      uint32_t                        ldb);
+            __device__ static inline void
+                globalReadB(MfmaFragB& fragB, GetDataType_t<MfmaFragB> const* gAddrB, uint32_t ldb);
+
             // Global C reads non-cooperative
             // Single or BlocksX * BlocksY frags
-            template <uint32_t BlocksX, uint32_t BlocksY>
-            __device__ static inline void globalReadC(MfmaFragC (&fragC)[BlocksX][BlocksY],
-                                                      GetDataType_t<MfmaFragC> const* gAddrC,
-                                                      uint32_t                        ldc);
+            // FragC is MfmaFragC, or an accumulator of the same shape in another datatype or layout
+            template <typename FragC, uint32_t BlocksX, uint32_t BlocksY>
+            __device__ static inline void globalReadC(FragC (&fragC)[BlocksX][BlocksY],
+                                                      GetDataType_t<FragC> const* gAddrC,
+                                                      uint32_t                    ldc);
+            template <typename FragC>
             __device__ static inline void
-                globalReadC(MfmaFragC& fragC, GetDataType_t<MfmaFragC> const* gAddrC, uint32_t ldc);
+                globalReadC(FragC& fragC, GetDataType_t<FragC> const* gAddrC, uint32_t ldc);
 
             // Global D writes non-cooperative
             // Single or BlocksX * BlocksY frags
@@ -205,19 +242,26 @@ namespace rocwmma
             /// Uniform fused multiply - add (FMA)
             ///
 
-            // Performs D = alpha * acc + beta * C, where alpha, beta are uniform scalars
-            template <uint32_t BlocksX, uint32_t BlocksY>
+            // Performs D = alpha * acc + beta * C, where alpha, beta are uniform scalars.
+            // The case lc of alpha and beta is uniform: unless it is linear_full, C is not
+            // read and need not be loaded.
+            // C may be held in another datatype and data layout than D: it is converted to
+            // the compute type in registers.
+            template <typename FragC, uint32_t BlocksX, uint32_t BlocksY>
             __device__ static inline void
                                           uniformFma(MfmaFragD (&fragsD)[BlocksX][BlocksY],
+                                                     linear_combination_t       lc,
                                                      GetDataType_t<MfmaFragAcc> alpha,
                                                      MfmaFragAcc const (&fragsAcc)[BlocksX][BlocksY],
                                                      GetDataType_t<MfmaFragAcc> beta,
-                                                     MfmaFragC const (&fragsC)[BlocksX][BlocksY]);
+                                                     FragC const (&fragsC)[BlocksX][BlocksY]);
+            template <typename FragC>
             __device__ static inline void uniformFma(MfmaFragD&                 fragD,
+                                                     linear_combination_t       lc,
                                                      GetDataType_t<MfmaFragAcc> alpha,
                                                      MfmaFragAcc const&         fragAcc,
                                                      GetDataType_t<MfmaFragAcc> beta,
-                                                     MfmaFragC const&           fragC);
+                                                     FragC const&               fragC);
 
             ///
             /// Wave synchronization
@@ -230,6 +274,11 @@ namespace rocwmma
             template <int32_t mask = 0>
             __device__ static inline void sched_barrier();
 
+            // Shapes the instruction schedule of the current region with SchedPolicy
+            // (e.g. SchedInterleave). Call at the end of the region.
+            template <typename SchedPolicy>
+            __device__ static inline void schedule();
+
             template <int32_t vmcnt = 0, int32_t lgkmcnt = 0>
             __device__ static inline void mem_barrier();
 
@@ -238,6 +287,25 @@ namespace rocwmma
 
             template <int32_t lgkmcnt = 0>
             __device__ static inline void lds_mem_barrier();
+
+            ///
+            /// Ping-pong wave groups
+            ///
+
+            // Workgroup barrier without memory waits or fences, such that global
+            // reads stay in flight across it. Memory accesses are not moved across
+            // the barrier by the compiler.
+            __device__ static inline void syncWaves();
+
+            // Waits on the LDS accesses of the wave, then syncWaves(). Targets other than
+            // gfx9 synchronize the workgroup instead.
+            __device__ static inline void syncLds();
+
+            // Waves are split into a ping group, the first half of the workgroup in
+            // hardware wave order, and a pong group, the second half. Waves are
+            // dispatched to the SIMDs round-robin, such that with two waves per SIMD
+            // each SIMD holds one ping and one pong wave.
+            __device__ static inline bool isPongWave();
         };
 
     } // namespace CooperativeGemm
@@ -30,6 +30,7 @@
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
 #include <rocwmma/rocwmma.hpp>
 #include <rocwmma/rocwmma_coop.hpp>
+#include <rocwmma/rocwmma_epilogue.hpp>
 #include <rocwmma/rocwmma_transforms.hpp>
 #pragma GCC diagnostic pop
 
@@ -76,23 +77,41 @@ namespace rocwmma
                         grFragB, gAddrB, ldb, CoopSchedulerB::waveIndex());
                 }
 
-                template <typename LWFragA>
+                template <typename GRFragA, typename SrcT>
+                __device__ static inline void
+                    globalReadCoopConvertA(GRFragA& grFragA, SrcT const* gAddrA, uint32_t lda)
+                {
+                    rocwmma::template load_matrix_coop_convert_sync<CoopSchedulerA::waveCount()>(
+                        grFragA, gAddrA, lda, CoopSchedulerA::waveIndex());
+                }
+
+                template <typename GRFragB, typename SrcT>
+                __device__ static inline void
+                    globalReadCoopConvertB(GRFragB& grFragB, SrcT const* gAddrB, uint32_t ldb)
+                {
+                    rocwmma::template load_matrix_coop_convert_sync<CoopSchedulerB::waveCount()>(
+                        grFragB, gAddrB, ldb, CoopSchedulerB::waveIndex());
+                }
+
+                // SplitCount is unused by stores with an access policy
+                template <typename AccessPolicy, typename LWFragA>
                 __device__ static inline void localWriteCoopA(GetDataType_t<LWFragA>* ldsAddr,
                                                               LWFragA const&          lwFragA,
                                                               uint32_t                ldlds)
                 {
-                    rocwmma::template store_matrix_coop_sync<CoopSchedulerA::waveCount(),
-                                                             SplitCountA>(
+                    rocwmma::template store_matrix_coop_sync<AccessPolicy,
+                                                             CoopSchedulerA::waveCount()>(
                         ldsAddr, lwFragA, ldlds, CoopSchedulerA::waveIndex());
                 }
 
-                template <typename LWFragB>
+                // SplitCount is unused by stores with an access policy
+                template <typename AccessPolicy, typename LWFragB>
                 __device__ static inline void localWriteCoopB(GetDataType_t<LWFragB>* ldsAddr,
                                                               LWFragB const&          lwFragB,
                                                               uint32_t                ldlds)
                 {
-                    rocwmma::template store_matrix_coop_sync<CoopSchedulerB::waveCount(),
-                                                             SplitCountB>(
+                    rocwmma::template store_matrix_coop_sync<AccessPolicy,
+                                                             CoopSchedulerB::waveCount()>(
                         ldsAddr, lwFragB, ldlds, CoopSchedulerB::waveIndex());
                 }
             };
@@ -129,30 +148,54 @@ namespace rocwmma
                                                    SplitCountB);
                 }
 
-                template <typename LWFragA>
+                template <typename GRFragA, typename SrcT>
+                __device__ static inline void
+                    globalReadCoopConvertA(GRFragA& grFragA, SrcT const* gAddrA, uint32_t lda)
+                {
+                    rocwmma::load_matrix_coop_convert_sync(grFragA,
+                                                           gAddrA,
+                                                           lda,
+                                                           CoopSchedulerA::waveIndex(),
+                                                           CoopSchedulerA::waveCount());
+                }
+
+                template <typename GRFragB, typename SrcT>
+                __device__ static inline void
+                    globalReadCoopConvertB(GRFragB& grFragB, SrcT const* gAddrB, uint32_t ldb)
+                {
+                    rocwmma::load_matrix_coop_convert_sync(grFragB,
+                                                           gAddrB,
+                                                           ldb,
+                                                           CoopSchedulerB::waveIndex(),
+                                                           CoopSchedulerB::waveCount());
+                }
+
+                // SplitCount is unused by stores with an access policy
+                template <typename AccessPolicy, typename LWFragA>
                 __device__ static inline void localWriteCoopA(GetDataType_t<LWFragA>* ldsAddr,
                                                               LWFragA const&          lwFragA,
                                                               uint32_t                ldlds)
                 {
-                    rocwmma::store_matrix_coop_sync(ldsAddr,
-                                                    lwFragA,
-                                                    ldlds,
-                                                    CoopSchedulerA::waveIndex(),
-                                                    CoopSchedulerA::waveCount(),
-                                                    SplitCountA);
+                    rocwmma::template store_matrix_coop_sync<AccessPolicy>(
+                        ldsAddr,
+                        lwFragA,
+                        ldlds,
+                        CoopSchedulerA::waveIndex(),
+                        CoopSchedulerA::waveCount());
                 }
 
-                template <typename LWFragB>
+                // SplitCount is unused by stores with an access policy
+                template <typename AccessPolicy, typename LWFragB>
                 __device__ static inline void localWriteCoopB(GetDataType_t<LWFragB>* ldsAddr,
                                                               LWFragB const&          lwFragB,
                                                               uint32_t                ldlds)
                 {
-                    rocwmma::store_matrix_coop_sync(ldsAddr,
-                                                    lwFragB,
-                                                    ldlds,
-                                                    CoopSchedulerB::waveIndex(),
-                                                    CoopSchedulerB::waveCount(),
-                                                    SplitCountB);
+                    rocwmma::template store_matrix_coop_sync<AccessPolicy>(
+                        ldsAddr,
+                        lwFragB,
+                        ldlds,
+                        CoopSchedulerB::waveIndex(),
+                        CoopSchedulerB::waveCount());
                 }
             };
         }
@@ -206,6 +249,52 @@ namespace rocwmma
             CoopApiSelector::globalReadCoopB(grFragB, gAddrB, ldb);
         }
 
+        template <GemmDriverT>
+        template <uint32_t BlocksX, typename SrcT>
+        __device__ inline void GemmDriver<GemmDriverT_impl>::globalReadCoopConvertA(
+            GRFragA (&grFragsA)[BlocksX], SrcT const* gAddrA, uint32_t lda)
+        {
+            auto blockOffset = MappingUtil<GRFragA>::dataOffset(GlobalMapping::blockOffsetA(), lda);
+#pragma unroll
+            for(int i = 0; i < BlocksX; i++)
+            {
+                globalReadCoopConvertA(grFragsA[i], gAddrA + i * blockOffset, lda);
+            }
+        }
+
+        template <GemmDriverT>
+        template <typename SrcT>
+        __device__ inline void GemmDriver<GemmDriverT_impl>::globalReadCoopConvertA(
+            GRFragA& grFragA, SrcT const* gAddrA, uint32_t lda)
+        {
+            using CoopApiSelector
+                = detail::CoopApiSelector<CoopSchedulerA, CoopSchedulerB, splitCountA, splitCountB>;
+            CoopApiSelector::globalReadCoopConvertA(grFragA, gAddrA, lda);
+        }
+
+        template <GemmDriverT>
+        template <uint32_t BlocksY, typename SrcT>
+        __device__ inline void GemmDriver<GemmDriverT_impl>::globalReadCoopConvertB(
+            GRFragB (&grFragsB)[BlocksY], SrcT const* gAddrB, uint32_t ldb)
+        {
+            auto blockOffset = MappingUtil<GRFragB>::dataOffset(GlobalMapping::blockOffsetB(), ldb);
+#pragma unroll
+            for(int i = 0; i < BlocksY; i++)
+            {
+                globalReadCoopConvertB(grFragsB[i], gAddrB + i * blockOffset, ldb);
+            }
+        }
+
+        template <GemmDriverT>
+        template <typename SrcT>
+        __device__ inline void GemmDriver<GemmDriverT_impl>::globalReadCoopConvertB(
+            GRFragB& grFragB, SrcT const* gAddrB, uint32_t ldb)
+        {
+            using CoopApiSelector
+                = detail::CoopApiSelector<CoopSchedulerA, CoopSchedulerB, splitCountA, splitCountB>;
+            CoopApiSelector::globalReadCoopConvertB(grFragB, gAddrB, ldb);
+        }
+
         template <GemmDriverT>
         template <uint32_t BlocksX>
         __device__ inline void GemmDriver<GemmDriverT_impl>::localWriteCoopA(
@@ -225,7 +314,7 @@ namespace rocwmma
         {
             using CoopApiSelector
                 = detail::CoopApiSelector<CoopSchedulerA, CoopSchedulerB, splitCountA, splitCountB>;
-            CoopApiSelector::localWriteCoopA(
+            CoopApiSelector::template localWriteCoopA<typename LdsMapping::AccessPolicy>(
                 ldsAddr,
                 LdsMapping::template formatLWFragA<CoopSchedulerA::waveCount()>(grFragA),
                 ldlds);
@@ -250,7 +339,7 @@ namespace rocwmma
         {
             using CoopApiSelector
                 = detail::CoopApiSelector<CoopSchedulerA, CoopSchedulerB, splitCountA, splitCountB>;
-            CoopApiSelector::localWriteCoopB(
+            CoopApiSelector::template localWriteCoopB<typename LdsMapping::AccessPolicy>(
                 ldsAddr,
                 LdsMapping::template formatLWFragB<CoopSchedulerB::waveCount()>(grFragB),
                 ldlds);
@@ -260,7 +349,8 @@ namespace rocwmma
         __device__ inline void GemmDriver<GemmDriverT_impl>::localReadA(
             MfmaFragA& fragsA, GetDataType_t<MfmaFragA> const* ldsAddrA, uint32_t ldlds)
         {
-            rocwmma::load_matrix_sync(reinterpret_cast<LRFragA&>(fragsA), ldsAddrA, ldlds);
+            rocwmma::template load_matrix_sync<typename LdsMapping::AccessPolicy>(
+                reinterpret_cast<LRFragA&>(fragsA), ldsAddrA, ldlds);
         }
 
         template <GemmDriverT>
@@ -281,7 +371,8 @@ namespace rocwmma
         __device__ inline void GemmDriver<GemmDriverT_impl>::localReadB(
             MfmaFragB& fragsB, GetDataType_t<MfmaFragB> const* ldsAddrB, uint32_t ldlds)
         {
-            rocwmma::load_matrix_sync(reinterpret_cast<LRFragB&>(fragsB), ldsAddrB, ldlds);
+            rocwmma::template load_matrix_sync<typename LdsMapping::AccessPolicy>(
+                reinterpret_cast<LRFragB&>(fragsB), ldsAddrB, ldlds);
         }
 
         template <GemmDriverT>
@@ -351,23 +442,68 @@ namespace rocwmma
         }
 
         template <GemmDriverT>
+        __device__ inline void GemmDriver<GemmDriverT_impl>::globalReadA(
+            MfmaFragA& fragA, GetDataType_t<MfmaFragA> const* gAddrA, uint32_t lda)
+        {
+            rocwmma::load_matrix_sync(fragA, gAddrA, lda);
+        }
+
+        template <GemmDriverT>
+        template <uint32_t BlocksX>
+        __device__ inline void GemmDriver<GemmDriverT_impl>::globalReadA(
+            MfmaFragA (&fragsA)[BlocksX], GetDataType_t<MfmaFragA> const* gAddrA, uint32_t lda)
+        {
+            auto blockStep
+                = MappingUtil<MfmaFragA>::dataOffset(GlobalMapping::blockOffsetA(), lda);
+#pragma unroll
+            for(int i = 0; i < BlocksX; i++)
+            {
+                globalReadA(fragsA[i], gAddrA, lda);
+                gAddrA += blockStep;
+            }
+        }
+
+        template <GemmDriverT>
+        __device__ inline void GemmDriver<GemmDriverT_impl>::globalReadB(
+            MfmaFragB& fragB, GetDataType_t<MfmaFragB> const* gAddrB, uint32_t ldb)
+        {
+            rocwmma::load_matrix_sync(fragB, gAddrB, ldb);
+        }
+
+        template <GemmDriverT>
+        template <uint32_t BlocksY>
+        __device__ inline void GemmDriver<GemmDriverT_impl>::globalReadB(
+            MfmaFragB (&fragsB)[BlocksY], GetDataType_t<MfmaFragB> const* gAddrB, uint32_t ldb)
+        {
+            auto blockStep
+                = MappingUtil<MfmaFragB>::dataOffset(GlobalMapping::blockOffsetB(), ldb);
+#pragma unroll
+            for(int i = 0; i < BlocksY; i++)
+            {
+                globalReadB(fragsB[i], gAddrB, ldb);
+                gAddrB += blockStep;
+            }
+        }
+
+        template <GemmDriverT>
+        template <typename FragC>
         __device__ inline void GemmDriver<GemmDriverT_impl>::globalReadC(
-            MfmaFragC& fragC, GetDataType_t<MfmaFragC> const* gAddrC, uint32_t ldc)
+            FragC& fragC, GetDataType_t<FragC> const* gAddrC, uint32_t ldc)
         {
+            static_assert(is_same_v<GetIOShape_t<FragC>, GetIOShape_t<MfmaFragC>>,
+                          "C fragment must have the shape of MfmaFragC");
             rocwmma::load_matrix_sync(fragC, gAddrC, ldc);
         }
 
         template <GemmDriverT>
-        template <uint32_t BlocksX, uint32_t BlocksY>
+        template <typename FragC, uint32_t BlocksX, uint32_t BlocksY>
         __device__ inline void
-            GemmDriver<GemmDriverT_impl>::globalReadC(MfmaFragC (&fragC)[BlocksX][BlocksY],
-                                                      GetDataType_t<MfmaFragC> const* gAddrC,
-                                                      uint32_t                        ldc)
+            GemmDriver<GemmDriverT_impl>::globalReadC(FragC (&fragC)[BlocksX][BlocksY],
+                                                      GetDataType_t<FragC> const* gAddrC,
+                                                      uint32_t                    ldc)
         {
-            auto blockStepX
-                = MappingUtil<MfmaFragC>::dataOffset(GlobalMapping::blockOffsetA(), ldc);
-            auto blockStepY
-                = MappingUtil<MfmaFragC>::dataOffset(GlobalMapping::blockOffsetB(), ldc);
+            auto blockStepX = MappingUtil<FragC>::dataOffset(GlobalMapping::blockOffsetA(), ldc);
+            auto blockStepY = MappingUtil<FragC>::dataOffset(GlobalMapping::blockOffsetB(), ldc);
 #pragma unroll
             for(int i = 0; i < BlocksX; i++)
             {
@@ -417,30 +553,52 @@ namespace rocwmma
         }
 
         template <GemmDriverT>
+        template <typename FragC>
         __device__ inline void
             GemmDriver<GemmDriverT_impl>::uniformFma(MfmaFragD&                 fragD,
+                                                     linear_combination_t       lc,
                                                      GetDataType_t<MfmaFragAcc> alpha,
                                                      MfmaFragAcc const&         fragAcc,
                                                      GetDataType_t<MfmaFragAcc> beta,
-                                                     MfmaFragC const&           fragC)
+                                                     FragC const&               fragC)
         {
-            for(int i = 0; i < fragD.num_elements; i++)
+            using ComputeT = GetDataType_t<MfmaFragAcc>;
+
+            static_assert(is_same_v<GetIOShape_t<FragC>, GetIOShape_t<MfmaFragD>>,
+                          "C fragment must have the shape of MfmaFragD");
+            rocwmma::detail::checkCoIndexed<MfmaFragD, FragC>();
+
+            if(lc == linear_full)
+            {
+                // Element-wise conversion of the whole vector, as mma_sync does for a mixed C
+                auto c = Convert<GetDataType_t<FragC>, ComputeT>::exec(fragC.mAccess);
+                for(int i = 0; i < fragD.num_elements; i++)
+                {
+                    // Perform computation in ComputeT and cast back to OutputT
+                    fragD.x[i] = static_cast<GetDataType_t<MfmaFragD>>(alpha * fragAcc.x[i]
+                                                                       + beta * c.data[i]);
+                }
+            }
+            else
             {
-                // Perform computation in ComputeT and cast back to OutputT
-                fragD.x[i] = static_cast<GetDataType_t<MfmaFragD>>(
-                    alpha * fragAcc.x[i]
-                    + beta * static_cast<GetDataType_t<MfmaFragAcc>>(fragC.x[i]));
+                // beta == 0: fragC is not read. The cast matches the reference, which doesn't
+                // saturate, unlike the packed conversions of apply_epilogue.
+                for(int i = 0; i < fragD.num_elements; i++)
+                {
+                    fragD.x[i] = static_cast<GetDataType_t<MfmaFragD>>(alpha * fragAcc.x[i]);
+                }
             }
         }
 
         template <GemmDriverT>
-        template <uint32_t BlocksX, uint32_t BlocksY>
+        template <typename FragC, uint32_t BlocksX, uint32_t BlocksY>
         __device__ inline void GemmDriver<GemmDriverT_impl>::uniformFma(
             MfmaFragD (&fragsD)[BlocksX][BlocksY],
+            linear_combination_t       lc,
             GetDataType_t<MfmaFragAcc> alpha,
             MfmaFragAcc const (&fragsAcc)[BlocksX][BlocksY],
             GetDataType_t<MfmaFragAcc> beta,
-            MfmaFragC const (&fragsC)[BlocksX][BlocksY])
+            FragC const (&fragsC)[BlocksX][BlocksY])
         {
 #pragma unroll
             for(int i = 0; i < BlocksX; i++)
@@ -448,7 +606,7 @@ namespace rocwmma
 #pragma unroll
                 for(int j = 0; j < BlocksY; j++)
                 {
-                    uniformFma(fragsD[i][j], alpha, fragsAcc[i][j], beta, fragsC[i][j]);
+                    uniformFma(fragsD[i][j], lc, alpha, fragsAcc[i][j], beta, fragsC[i][j]);
                 }
             }
         }
@@ -475,6 +633,13 @@ namespace rocwmma
             SchedBarrier::exec();
         }
 
+        template <GemmDriverT>
+        template <typename SchedPolicy>
+        __device__ inline void GemmDriver<GemmDriverT_impl>::schedule()
+        {
+            SchedPolicy::exec();
+        }
+
         template <GemmDriverT>
         template <int32_t vmcnt, int32_t lgkmcnt>
         __device__ inline void GemmDriver<GemmDriverT_impl>::mem_barrier()
@@ -499,6 +664,38 @@ namespace rocwmma
             WaitLgkmcnt::exec();
         }
 
+        template <GemmDriverT>
+        __device__ inline void GemmDriver<GemmDriverT_impl>::syncWaves()
+        {
+            // Compiler-only fences: s_barrier alone does not order memory accesses
+            __atomic_signal_fence(__ATOMIC_SEQ_CST);
+            sched_barrier<0>();
+            Barrier::exec();
+            sched_barrier<0>();
+            __atomic_signal_fence(__ATOMIC_SEQ_CST);
+        }
+
+        template <GemmDriverT>
+        __device__ inline void GemmDriver<GemmDriverT_impl>::syncLds()
+        {
+#if ROCWMMA_ARCH_GFX9
+            // vmcnt = 63 does not wait on global memory
+            mem_barrier<63, 0>();
+            syncWaves();
+#else
+            // Waitcnt is encoded in the gfx9 layout
+            syncWorkgroup();
+#endif // ROCWMMA_ARCH_GFX9
+        }
+
+        template <GemmDriverT>
+        __device__ inline bool GemmDriver<GemmDriverT_impl>::isPongWave()
+        {
+            // Column major wave order of the workgroup is the hardware wave order
+            using WaveOrder = Schedule::AllColMajor<>;
+            return WaveOrder::waveIndex() >= (WaveOrder::waveCount() / 2u);
+        }
+
 #undef GemmDriverT
 #undef GemmDriverT_impl
 
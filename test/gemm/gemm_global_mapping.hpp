@@ -30,6 +30,7 @@
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
 #include <rocwmma/rocwmma.hpp>
 #include <rocwmma/rocwmma_coop.hpp>
+#include <rocwmma/rocwmma_tile.hpp>
 #include <rocwmma/rocwmma_transforms.hpp>
 #pragma GCC diagnostic pop
 
@@ -52,7 +53,8 @@ namespace rocwmma
                       uint32_t BlocksX, // MFMA blocks per wave in X direction
                       uint32_t BlocksY, // MFMA blocks per wave in Y direction
                       uint32_t TBlockX = 0, // Thread block X dimension
-                      uint32_t TBlockY = 0> // Thread block Y dimension
+                      uint32_t TBlockY = 0, // Thread block Y dimension
+                      typename RasterPolicy = raster::linear> // Workgroup to macro tile order
             struct MappingBase
             {
                 /*
@@ -188,7 +190,8 @@ namespace rocwmma
                   uint32_t BlocksX,
                   uint32_t BlocksY,
                   uint32_t TBlockX = 0,
-                  uint32_t TBlockY = 0>
+                  uint32_t TBlockY = 0,
+                  typename RasterPolicy = raster::linear>
         struct BlockLevelMapping : public detail::MappingBase<BlockM,
                                                               BlockN,
                                                               BlockK,
@@ -202,7 +205,8 @@ namespace rocwmma
                                                               BlocksX,
                                                               BlocksY,
                                                               TBlockX,
-                                                              TBlockY>
+                                                              TBlockY,
+                                                              RasterPolicy>
         {
             /*
             * This flavour of Global Mapping targets A/B/C/D wave tiles iteratively
@@ -228,7 +232,8 @@ namespace rocwmma
                                              BlocksX,
                                              BlocksY,
                                              TBlockX,
-                                             TBlockY>;
+                                             TBlockY,
+                                             RasterPolicy>;
 
             // Global wave tile R/W be in sections of MFMA sized fragments
             using GRFragA = typename Base::MfmaFragA;
@@ -280,7 +285,8 @@ namespace rocwmma
                   uint32_t BlocksX,
                   uint32_t BlocksY,
                   uint32_t TBlockX = 0,
-                  uint32_t TBlockY = 0>
+                  uint32_t TBlockY = 0,
+                  typename RasterPolicy = raster::linear>
         struct WaveLevelMapping : public detail::MappingBase<BlockM,
                                                              BlockN,
                                                              BlockK,
@@ -294,7 +300,8 @@ namespace rocwmma
                                                              BlocksX,
                                                              BlocksY,
                                                              TBlockX,
-                                                             TBlockY>
+                                                             TBlockY,
+                                                             RasterPolicy>
         {
             /*
             * This flavour of Global Mapping targets A/B as a single wave tile sized fragment.
@@ -322,7 +329,8 @@ namespace rocwmma
                                              BlocksX,
                                              BlocksY,
                                              TBlockX,
-                                             TBlockY>;
+                                             TBlockY,
+                                             RasterPolicy>;
 
             // Global reads for A/B are single fragment of wave tile size
             // Global R/W for C/D are MFMA sized fragments
@@ -379,7 +387,8 @@ namespace rocwmma
                   uint32_t BlocksX,
                   uint32_t BlocksY,
                   uint32_t TBlockX,
-                  uint32_t TBlockY>
+                  uint32_t TBlockY,
+                  typename RasterPolicy = raster::linear>
         struct WorkgroupLevelMapping : public detail::MappingBase<BlockM,
                                                                   BlockN,
                                                                   BlockK,
@@ -393,7 +402,8 @@ namespace rocwmma
                                                                   BlocksX,
                                                                   BlocksY,
                                                                   TBlockX,
-                                                                  TBlockY>
+                                                                  TBlockY,
+                                                                  RasterPolicy>
         {
 
             // Must provide valid TBlockX/Y params at compile time.
@@ -425,7 +435,8 @@ namespace rocwmma
                                              BlocksX,
                                              BlocksY,
                                              TBlockX,
-                                             TBlockY>;
+                                             TBlockY,
+                                             RasterPolicy>;
 
             // Global reads for A/B are single fragment of macro tile size
             // Global R/W for C/D are MFMA sized fragments
@@ -475,6 +486,118 @@ namespace rocwmma
             }
         };
 
+        template <uint32_t BlockM,
+                  uint32_t BlockN,
+                  uint32_t BlockK,
+                  typename InputT,
+                  typename OutputT,
+                  typename ComputeT,
+                  typename LayoutA,
+                  typename LayoutB,
+                  typename LayoutC,
+                  typename LayoutD,
+                  uint32_t BlocksX,
+                  uint32_t BlocksY,
+                  uint32_t TBlockX = 0,
+                  uint32_t TBlockY = 0,
+                  typename RasterPolicy = raster::linear>
+        struct KSlicedMapping : public WaveLevelMapping<BlockM,
+                                                        BlockN,
+                                                        BlockK,
+                                                        InputT,
+                                                        OutputT,
+                                                        ComputeT,
+                                                        LayoutA,
+                                                        LayoutB,
+                                                        LayoutC,
+                                                        LayoutD,
+                                                        BlocksX,
+                                                        BlocksY,
+                                                        TBlockX,
+                                                        TBlockY,
+                                                        RasterPolicy>
+        {
+            /*
+            * This flavour of Global Mapping aligns every wave of the workgroup with
+            * the same C/D wave tile, such that the macro tile is a single wave tile.
+            * Waves split the K dimension instead: of S = WgDim.x * WgDim.y waves, the
+            * wave of K slice s accumulates the K steps s, s + S, s + 2S, ...
+            *
+            * Block size:      (BlockM x BlockN)
+            * Wave tile size:  (BlocksX * BlockSize.x) x (BlocksY * BlockSize.y)
+            * Macro Tile size: Wave tile size
+            *
+            * Each wave reads A/B in MFMA sized fragments of its own K steps. The
+            * partial accumulators of all waves must be reduced before writing D.
+            */
+            using Base = WaveLevelMapping<BlockM,
+                                          BlockN,
+                                          BlockK,
+                                          InputT,
+                                          OutputT,
+                                          ComputeT,
+                                          LayoutA,
+                                          LayoutB,
+                                          LayoutC,
+                                          LayoutD,
+                                          BlocksX,
+                                          BlocksY,
+                                          TBlockX,
+                                          TBlockY,
+                                          RasterPolicy>;
+
+            using WaveSpace = typename Base::WaveSpace;
+
+            // All waves share the wave tile of the workgroup
+            __device__ constexpr static inline auto macroTileSizeC()
+            {
+                return Base::waveTileSizeC();
+            }
+
+            __device__ constexpr static inline auto macroTileCoordC()
+            {
+                return raster_workgroup_coord<RasterPolicy>() * macroTileSizeC();
+            }
+
+            __device__ constexpr static inline auto waveTileCoordC()
+            {
+                return macroTileCoordC();
+            }
+
+            // A/B/C/D global R/W on the shared wave tile
+            __device__ constexpr static inline auto readCoordA()
+            {
+                return Base::projCoordA(readCoordC());
+            }
+            __device__ constexpr static inline auto readCoordB()
+            {
+                return Base::projCoordB(readCoordC());
+            }
+            __device__ constexpr static inline auto readCoordC()
+            {
+                return waveTileCoordC();
+            }
+            __device__ constexpr static inline auto writeCoordD()
+            {
+                return waveTileCoordC();
+            }
+
+            // K slice of the current wave, in row major order of the waves
+            __device__ constexpr static inline uint32_t kSliceIndex()
+            {
+                auto localWaveCoord = WaveSpace::localWaveCoord();
+                return get<0>(localWaveCoord) * get<1>(WaveSpace::workgroupDim())
+                       + get<1>(localWaveCoord);
+            }
+
+            // Number of K slices, one per wave
+            __device__ constexpr static inline uint32_t kSliceCount()
+            {
+                auto wgDim = WaveSpace::workgroupDim();
+                return get<0>(wgDim) * get<1>(wgDim);
+            }
+        };
+
     } // namespace GlobalMapping
 
 } // namespace rocwmma
@@ -39,11 +39,12 @@ namespace rocwmma
 #define MappingBaseT                                                                               \
     uint32_t BlockM, uint32_t BlockN, uint32_t BlockK, typename InputT, typename OutputT,          \
         typename ComputeT, typename LayoutA, typename LayoutB, typename LayoutC, typename LayoutD, \
-        uint32_t BlocksX, uint32_t BlocksY, uint32_t TBlockX, uint32_t TBlockY
+        uint32_t BlocksX, uint32_t BlocksY, uint32_t TBlockX, uint32_t TBlockY,                    \
+        typename RasterPolicy
 
 #define MappingBaseT_impl                                                                  \
     BlockM, BlockN, BlockK, InputT, OutputT, ComputeT, LayoutA, LayoutB, LayoutC, LayoutD, \
-        BlocksX, BlocksY, TBlockX, TBlockY
+        BlocksX, BlocksY, TBlockX, TBlockY, RasterPolicy
 
             template <MappingBaseT>
             template <typename CoordC>
@@ -149,7 +150,7 @@ namespace rocwmma
             template <MappingBaseT>
             __device__ constexpr inline auto MappingBase<MappingBaseT_impl>::macroTileCoordC()
             {
-                return WaveSpace::workgroupCoord() * macroTileSizeC();
+                return raster_workgroup_coord<RasterPolicy>() * macroTileSizeC();
             }
 
             template <MappingBaseT>
@@ -31,14 +31,20 @@
 #include <sstream>
 #include <string>
 
+#include <rocwmma/rocwmma_dispatch.hpp>
+
+#include "benchmark_log.hpp"
+#include "gemm_mapping_selector.hpp"
 #include "gemm_resource.hpp"
+#include "gemm_tuning_table.hpp"
 #include "hip_device.hpp"
 
 namespace rocwmma
 {
 
     // Basic structure to hold runtime problem
-    // parameters
+    // parameters. A zero sized thread block is
+    // selected per problem by GemmMappingSelector.
     struct ProblemParams
     {
         std::pair<int64_t, int64_t>           threadBlockSize;
@@ -67,6 +73,17 @@ namespace rocwmma
         virtual std::ostream& printHeader(std::ostream& stream) const = 0;
         virtual std::ostream& printKernel(std::ostream& stream) const = 0;
 
+        // Tuning and dispatch interface
+        virtual std::ostream&   printProblemType(std::ostream& stream) const  = 0;
+        virtual std::ostream&   printKernelConfig(std::ostream& stream) const = 0;
+        virtual GemmTuningEntry tuningEntry() const                           = 0;
+
+        // Structured benchmark output
+        virtual BenchmarkRecord benchmarkRecord() const = 0;
+
+        // Output block M x N, and K step computed by each wave
+        virtual std::tuple<uint32_t, uint32_t, uint32_t> waveTileSize() const = 0;
+
         static bool sHeaderPrinted;
     };
 
@@ -127,6 +144,10 @@ namespace rocwmma
         virtual dim3     gridDim() const;
         virtual dim3     blockDim() const;
 
+        // Runtime occupancy of the kernel with the launch parameters on the device.
+        // Persistent kernels size their grid with resident_blocks().
+        virtual launch_occupancy occupancy() const;
+
         // Kernel run checks.
         // True = run test
         // False = skip test
@@ -146,6 +167,9 @@ namespace rocwmma
         template <template <uint32_t, uint32_t, uint32_t, uint32_t> class KernelClass>
         KernelFunc dispatchKernelFunc() const;
 
+        // Readable kernel config and problem, naming the ROCTX ranges of the workflow
+        std::string roctxTag() const;
+
     public:
         // KernelI interface fulfillment
         virtual void          setup(ProblemParams const& problem) override;
@@ -161,6 +185,17 @@ namespace rocwmma
         virtual std::ostream& printHeader(std::ostream& stream) const override;
         virtual std::ostream& printKernel(std::ostream& stream) const override;
 
+        // Problem type identifies the data types and layouts.
+        // Kernel config identifies the kernel family and compile-time tiling.
+        // Derived kernels prepend their own template parameters.
+        virtual std::ostream&   printProblemType(std::ostream& stream) const override;
+        virtual std::ostream&   printKernelConfig(std::ostream& stream) const override;
+        virtual GemmTuningEntry tuningEntry() const override;
+        virtual BenchmarkRecord benchmarkRecord() const override;
+
+        // Base assumes one output block per wave
+        virtual std::tuple<uint32_t, uint32_t, uint32_t> waveTileSize() const override;
+
     protected:
         // Problem params for kernel
         uint32_t mTBlockX, mTBlockY;
@@ -176,15 +211,49 @@ namespace rocwmma
         double   mMaxRelativeError;
 
         // Performance
-        float64_t mElapsedTimeMs, mTotalGFlops, mMeasuredTFlopsPerSec;
-        int32_t   mEfficiency;
+        float64_t   mElapsedTimeMs, mTotalGFlops, mMeasuredTFlopsPerSec;
+        int32_t     mEfficiency;
+        float64_t   mRoofTFlopsPerSec;
+        bool        mMemoryBound;
+        TimingStats mTiming;
+
+        // Occupancy of the launch, queried in setup
+        launch_occupancy mOccupancy;
+
+        // Download of the host inputs for Cpu validation
+        hipStream_t mCopyStream;
+
+        // Seeds of the random input data. Fixed so that runs are reproducible
+        // and host data can be regenerated without a download.
+        constexpr static uint64_t mSeedA = 0x5EEDA;
+        constexpr static uint64_t mSeedB = 0x5EEDB;
+        constexpr static uint64_t mSeedC = 0x5EEDC;
+
+        // hipGraph replay of the hot runs
+        bool      mGraphLaunch;
+        float64_t mGraphElapsedTimeMs;
+        float64_t mGraphSavings;
+
+        // Board energy of the runs, through the rocm-smi energy counter
+        bool      mEnergy;
+        float64_t mJoulesPerRun, mAvgPowerW, mGFlopsPerWatt;
+
+        constexpr static float64_t mEnergyWindowMs = 200.0;
+
+        // Hardware counters of the kernel, through rocprofiler-sdk
+        CounterValues mCounters;
 
         // Reference
         float64_t         mRefMeasuredTFlopsPerSec;
         int32_t           mRefEfficiency;
-        static const bool mIsCpuRef;
+        static const bool mIsNativeRef;
         static const bool mRunRefFlag;
         static const bool mBenchRef;
+
+        // hipBLASLt baseline of the same problem
+        float64_t         mHipblasLtTFlopsPerSec;
+        int32_t           mHipblasLtEfficiency;
+        static const bool mBenchHipblasLt;
     };
 
 } // namespace rocwmma
@@ -40,21 +40,29 @@
 #include <rocwmma/internal/utils.hpp>
 
 #include "common.hpp"
+#include "counter_collector.hpp"
 #include "gemm_kernel_base.hpp"
+#include "hip_graph.hpp"
 #include "performance.hpp"
+#include "rocwmma_logging.hpp"
+#include "roctx_range.hpp"
 
-#if ROCWMMA_VALIDATION_TESTS
-#include "reference.hpp" // Vanilla CPU kernel
-#endif // ROCWMMA_VALIDATION_TESTS
+#if ROCWMMA_VALIDATION_TESTS && ROCWMMA_VALIDATE_WITH_CPU
+#include "reference.hpp" // Blocked CPU kernel
+#endif // ROCWMMA_VALIDATION_TESTS && ROCWMMA_VALIDATE_WITH_CPU
 
 #if ROCWMMA_ROCBLAS_INTEGRATION
 #include "rocblas_reference.hpp" // rocBLAS GPU kernel
 #endif // ROCWMMA_ROCBLAS_INTEGRATION
 
+#if ROCWMMA_BENCHMARK_WITH_HIPBLASLT
+#include "hipblaslt_reference.hpp" // hipBLASLt GPU kernel
+#endif // ROCWMMA_BENCHMARK_WITH_HIPBLASLT
+
 namespace rocwmma
 {
 
-    // Using Cpu reference kernel if:
+    // Using the native reference kernel on the device if:
     // - Not using rocBLAS OR
     // - Using rocBLAS and it cannot solve the problem
     template <uint32_t BlockM,
@@ -76,7 +84,7 @@ namespace rocwmma
                                   LayoutA,
                                   LayoutB,
                                   LayoutC,
-                                  LayoutD>::mIsCpuRef
+                                  LayoutD>::mIsNativeRef
         = !(bool)ROCWMMA_ROCBLAS_INTEGRATION
           || ((bool)ROCWMMA_ROCBLAS_INTEGRATION
               && !quirks::rocblas_supported<InputT, OutputT, ComputeT>::value);
@@ -132,6 +140,32 @@ namespace rocwmma
         = ((bool)ROCWMMA_BENCHMARK_TESTS && ROCWMMA_BENCHMARK_WITH_ROCBLAS
            && quirks::rocblas_supported<InputT, OutputT, ComputeT>::value);
 
+    // Benchmark hipBLASLt if:
+    // - Benchmarking with hipBLASLt AND
+    // - hipBLASLt can solve the problem
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename InputT,
+              typename OutputT,
+              typename ComputeT,
+              typename LayoutA,
+              typename LayoutB,
+              typename LayoutC,
+              typename LayoutD>
+    constexpr bool GemmKernelBase<BlockM,
+                                  BlockN,
+                                  BlockK,
+                                  InputT,
+                                  OutputT,
+                                  ComputeT,
+                                  LayoutA,
+                                  LayoutB,
+                                  LayoutC,
+                                  LayoutD>::mBenchHipblasLt
+        = ((bool)ROCWMMA_BENCHMARK_TESTS && ROCWMMA_BENCHMARK_WITH_HIPBLASLT
+           && quirks::hipblaslt_supported<InputT, OutputT, ComputeT>::value);
+
     template <uint32_t BlockM,
               uint32_t BlockN,
               uint32_t BlockK,
@@ -252,6 +286,31 @@ namespace rocwmma
         return dim3(mTBlockX, mTBlockY);
     }
 
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename InputT,
+              typename OutputT,
+              typename ComputeT,
+              typename LayoutA,
+              typename LayoutB,
+              typename LayoutC,
+              typename LayoutD>
+    launch_occupancy GemmKernelBase<BlockM,
+                                    BlockN,
+                                    BlockK,
+                                    InputT,
+                                    OutputT,
+                                    ComputeT,
+                                    LayoutA,
+                                    LayoutB,
+                                    LayoutC,
+                                    LayoutD>::occupancy() const
+    {
+        auto blockSize = blockDim();
+        return get_launch_occupancy(kernelImpl(), blockSize.x * blockSize.y, ldsUsage());
+    }
+
     // Kernel run checks. Virtual as different GEMM kernels have different requirements
     // True = run test
     // False = skip test
@@ -402,8 +461,27 @@ namespace rocwmma
         mElapsedTimeMs = mTotalGFlops = mMeasuredTFlopsPerSec = 0.0;
         mEfficiency                                           = -1;
 
-        mMeasuredTFlopsPerSec = 0.0;
-        mRefEfficiency        = -1;
+        mRoofTFlopsPerSec = 0.0;
+        mMemoryBound      = false;
+        mTiming           = {0.0, 0.0, 0.0, 0.0};
+        mOccupancy        = {0u, 0u, 0.0, 0u, occupancy_limiter_none};
+
+        mCopyStream = nullptr;
+
+        mGraphLaunch        = false;
+        mGraphElapsedTimeMs = 0.0;
+        mGraphSavings       = 0.0;
+
+        mEnergy        = false;
+        mJoulesPerRun  = 0.0;
+        mAvgPowerW     = 0.0;
+        mGFlopsPerWatt = 0.0;
+
+        mRefMeasuredTFlopsPerSec = 0.0;
+        mRefEfficiency           = -1;
+
+        mHipblasLtTFlopsPerSec = 0.0;
+        mHipblasLtEfficiency   = -1;
     }
 
     template <uint32_t BlockM,
@@ -451,18 +529,200 @@ namespace rocwmma
                                  LayoutC,
                                  LayoutD>::printHeader(std::ostream& stream /* = std::cout */) const
     {
-        return stream << "TBlkX, TBlkY, "
-                      << "BlkM, BlkN, BlkK, "
-                      << "MatM, MatN, MatK, "
-                      << "alpha, lda, ldb, beta, ldc, ldd, "
-                      << "LytA_LytB_LytC_LytD, "
-                      << "Ti_To_Tc, "
-                      << "elapsedMs, "
-                      << "Problem Size(GFlops), "
-                      << "TFlops/s, "
-                      << "Efficiency(%), "
-                      << (mBenchRef ? "rocBLAS TFlops/s(%), rocBLAS Efficiency(%), " : "")
-                      << "Result" << std::endl;
+        stream << "TBlkX, TBlkY, "
+               << "BlkM, BlkN, BlkK, "
+               << "MatM, MatN, MatK, "
+               << "alpha, lda, ldb, beta, ldc, ldd, "
+               << "LytA_LytB_LytC_LytD, "
+               << "Ti_To_Tc, "
+               << "elapsedMs, "
+               << "Problem Size(GFlops), "
+               << "TFlops/s, "
+               << "Efficiency(%), "
+               << "Roof(TFlops/s), "
+               << "Bound, "
+               << "Occupancy(waves/SIMD), "
+               << "Occupancy Limiter, "
+               << (mGraphLaunch ? "Graph elapsedMs, Graph Savings(%), " : "")
+               << (mEnergy ? "Energy(J/run), Power(W), GFlops/W, " : "")
+               << (mBenchRef ? "rocBLAS TFlops/s, rocBLAS Efficiency(%), "
+                               "Speedup vs rocBLAS, "
+                             : "")
+               << (mBenchHipblasLt ? "hipBLASLt TFlops/s, hipBLASLt Efficiency(%), "
+                                     "Speedup vs hipBLASLt, "
+                                   : "");
+        for(auto const& name : CounterCollector::instance()->names())
+        {
+            stream << name << ", ";
+        }
+        return stream << "Result" << std::endl;
+    }
+
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename InputT,
+              typename OutputT,
+              typename ComputeT,
+              typename LayoutA,
+              typename LayoutB,
+              typename LayoutC,
+              typename LayoutD>
+    std::ostream& GemmKernelBase<BlockM,
+                                 BlockN,
+                                 BlockK,
+                                 InputT,
+                                 OutputT,
+                                 ComputeT,
+                                 LayoutA,
+                                 LayoutB,
+                                 LayoutC,
+                                 LayoutD>::printProblemType(std::ostream& stream) const
+    {
+        return stream << dataTypeToString<InputT>() << "_" << dataTypeToString<OutputT>() << "_"
+                      << dataTypeToString<ComputeT>() << "_" << dataTypeToString<LayoutA>() << "_"
+                      << dataTypeToString<LayoutB>() << "_" << dataTypeToString<LayoutC>() << "_"
+                      << dataTypeToString<LayoutD>();
+    }
+
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename InputT,
+              typename OutputT,
+              typename ComputeT,
+              typename LayoutA,
+              typename LayoutB,
+              typename LayoutC,
+              typename LayoutD>
+    std::tuple<uint32_t, uint32_t, uint32_t> GemmKernelBase<BlockM,
+                                                            BlockN,
+                                                            BlockK,
+                                                            InputT,
+                                                            OutputT,
+                                                            ComputeT,
+                                                            LayoutA,
+                                                            LayoutB,
+                                                            LayoutC,
+                                                            LayoutD>::waveTileSize() const
+    {
+        return std::make_tuple(BlockM, BlockN, BlockK);
+    }
+
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename InputT,
+              typename OutputT,
+              typename ComputeT,
+              typename LayoutA,
+              typename LayoutB,
+              typename LayoutC,
+              typename LayoutD>
+    std::ostream& GemmKernelBase<BlockM,
+                                 BlockN,
+                                 BlockK,
+                                 InputT,
+                                 OutputT,
+                                 ComputeT,
+                                 LayoutA,
+                                 LayoutB,
+                                 LayoutC,
+                                 LayoutD>::printKernelConfig(std::ostream& stream) const
+    {
+        return stream << BlockM << "x" << BlockN << "x" << BlockK;
+    }
+
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename InputT,
+              typename OutputT,
+              typename ComputeT,
+              typename LayoutA,
+              typename LayoutB,
+              typename LayoutC,
+              typename LayoutD>
+    GemmTuningEntry GemmKernelBase<BlockM,
+                                   BlockN,
+                                   BlockK,
+                                   InputT,
+                                   OutputT,
+                                   ComputeT,
+                                   LayoutA,
+                                   LayoutB,
+                                   LayoutC,
+                                   LayoutD>::tuningEntry() const
+    {
+        std::stringstream problemType;
+        printProblemType(problemType);
+
+        std::stringstream kernelConfig;
+        printKernelConfig(kernelConfig);
+
+        // Skipped or failed kernels are not eligible
+        bool eligible = mRunFlag && (!(bool)ROCWMMA_VALIDATION_TESTS || mValidationResult);
+
+        return {static_cast<uint32_t>(DeviceInfo::instance()->getGcnArch()),
+                problemType.str(),
+                mM,
+                mN,
+                mK,
+                kernelConfig.str(),
+                mTBlockX,
+                mTBlockY,
+                eligible ? mMeasuredTFlopsPerSec : 0.0};
+    }
+
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename InputT,
+              typename OutputT,
+              typename ComputeT,
+              typename LayoutA,
+              typename LayoutB,
+              typename LayoutC,
+              typename LayoutD>
+    BenchmarkRecord GemmKernelBase<BlockM,
+                                   BlockN,
+                                   BlockK,
+                                   InputT,
+                                   OutputT,
+                                   ComputeT,
+                                   LayoutA,
+                                   LayoutB,
+                                   LayoutC,
+                                   LayoutD>::benchmarkRecord() const
+    {
+        std::stringstream problemType;
+        printProblemType(problemType);
+
+        std::stringstream kernelConfig;
+        printKernelConfig(kernelConfig);
+
+        auto result = (bool)ROCWMMA_VALIDATION_TESTS ? (mValidationResult ? "PASSED" : "FAILED")
+                                                     : "BENCH";
+
+        return {"gemm",
+                static_cast<uint32_t>(DeviceInfo::instance()->getGcnArch()),
+                problemType.str(),
+                kernelConfig.str(),
+                mTBlockX,
+                mTBlockY,
+                mM,
+                mN,
+                mK,
+                1u,
+                mRunFlag ? mHotRuns : 0u,
+                mTiming,
+                mTotalGFlops,
+                mMeasuredTFlopsPerSec,
+                mEfficiency,
+                mRoofTFlopsPerSec,
+                mMemoryBound ? "Memory" : "Compute",
+                mRunFlag ? result : "SKIPPED",
+                mCounters};
     }
 
     template <uint32_t BlockM,
@@ -503,17 +763,79 @@ namespace rocwmma
                    << "n/a"
                    << ", "
                    << "n/a"
-                   << ", " << (mBenchRef ? "n/a, n/a, " : "") << "SKIPPED" << std::endl;
+                   << ", "
+                   << "n/a"
+                   << ", "
+                   << "n/a"
+                   << ", "
+                   << "n/a"
+                   << ", "
+                   << "n/a"
+                   << ", " << (mGraphLaunch ? "n/a, n/a, " : "")
+                   << (mEnergy ? "n/a, n/a, n/a, " : "") << (mBenchRef ? "n/a, n/a, n/a, " : "")
+                   << (mBenchHipblasLt ? "n/a, n/a, n/a, " : "");
+            for(size_t i = 0; i < CounterCollector::instance()->names().size(); i++)
+            {
+                stream << "n/a, ";
+            }
+            stream << "SKIPPED" << std::endl;
         }
         else
         {
 
             stream << mElapsedTimeMs << ", " << mTotalGFlops << ", " << mMeasuredTFlopsPerSec
-                   << ", " << mEfficiency << ", "
-                   << (mBenchRef ? (std::to_string(mRefMeasuredTFlopsPerSec) + ", "
-                                    + std::to_string(mRefEfficiency) + ", ")
-                                 : "")
-                   << ((bool)ROCWMMA_VALIDATION_TESTS ? (mValidationResult ? "PASSED" : "FAILED")
+                   << ", " << mEfficiency << ", " << mRoofTFlopsPerSec << ", "
+                   << (mMemoryBound ? "Memory" : "Compute") << ", " << mOccupancy.waves_per_simd
+                   << "/" << mOccupancy.max_waves_per_simd << ", "
+                   << occupancy_limiter_name(mOccupancy.limiter) << ", ";
+
+            if(mGraphLaunch)
+            {
+                stream << mGraphElapsedTimeMs << ", " << mGraphSavings << ", ";
+            }
+
+            if(mEnergy)
+            {
+                stream << mJoulesPerRun << ", " << mAvgPowerW << ", " << mGFlopsPerWatt << ", ";
+            }
+
+            // Speedup of rocWMMA over the library baselines, n/a if a library did not run
+            auto printBaseline = [this, &stream](float64_t tFlopsPerSec, int32_t efficiency) {
+                if(tFlopsPerSec > 0.0)
+                {
+                    stream << tFlopsPerSec << ", " << efficiency << ", "
+                           << mMeasuredTFlopsPerSec / tFlopsPerSec << ", ";
+                }
+                else
+                {
+                    stream << "n/a, n/a, n/a, ";
+                }
+            };
+
+            if(mBenchRef)
+            {
+                printBaseline(mRefMeasuredTFlopsPerSec, mRefEfficiency);
+            }
+
+            if(mBenchHipblasLt)
+            {
+                printBaseline(mHipblasLtTFlopsPerSec, mHipblasLtEfficiency);
+            }
+
+            // n/a where the device does not support a counter
+            for(auto const& name : CounterCollector::instance()->names())
+            {
+                if(auto it = findCounter(mCounters, name); it != mCounters.end())
+                {
+                    stream << it->second << ", ";
+                }
+                else
+                {
+                    stream << "n/a, ";
+                }
+            }
+
+            stream << ((bool)ROCWMMA_VALIDATION_TESTS ? (mValidationResult ? "PASSED" : "FAILED")
                                                       : "BENCH")
                    << std::endl;
         }
@@ -521,6 +843,36 @@ namespace rocwmma
         return stream;
     }
 
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              uint32_t BlockK,
+              typename InputT,
+              typename OutputT,
+              typename ComputeT,
+              typename LayoutA,
+              typename LayoutB,
+              typename LayoutC,
+              typename LayoutD>
+    std::string GemmKernelBase<BlockM,
+                               BlockN,
+                               BlockK,
+                               InputT,
+                               OutputT,
+                               ComputeT,
+                               LayoutA,
+                               LayoutB,
+                               LayoutC,
+                               LayoutD>::roctxTag() const
+    {
+        std::stringstream tag;
+        tag << "gemm ";
+        printKernelConfig(tag);
+        tag << " ";
+        printProblemType(tag);
+        tag << " " << mTBlockX << "x" << mTBlockY << " " << mM << "x" << mN << "x" << mK;
+        return tag.str();
+    }
+
     template <uint32_t BlockM,
               uint32_t BlockN,
               uint32_t BlockK,
@@ -545,6 +897,11 @@ namespace rocwmma
         // Reset the flags in case of multiple runs
         mRunFlag          = true;
         mValidationResult = false;
+        mGraphLaunch      = RocwmmaLogging::instance()->hipGraph();
+        mEnergy           = RocwmmaLogging::instance()->energy();
+
+        mJoulesPerRun = mAvgPowerW = mGFlopsPerWatt = 0.0;
+        mCounters.clear();
 
         // Format incoming problem parameters
         std::tie(mTBlockX, mTBlockY)
@@ -562,32 +919,70 @@ namespace rocwmma
                        (std::is_same<LayoutC, row_major>::value ? mN : mM),
                        (std::is_same<LayoutC, row_major>::value ? mN : mM));
 
+        RoctxRange range(roctxTag(), " setup");
+
+        // Select the thread block of the best mapping for the problem, among
+        // those compiled by dispatchKernelFunc. LDS usage and quirks are still
+        // checked below for the selection.
+        if(mTBlockX == 0u || mTBlockY == 0u)
+        {
+            auto& deviceInfo  = DeviceInfo::instance();
+            auto  threadBlock = GemmMappingSelector::select(waveTileSize(),
+                                                           deviceInfo->warpSize(),
+                                                           deviceInfo->cuCount(),
+                                                           mM,
+                                                           mN,
+                                                           mK);
+            mTBlockX          = static_cast<uint32_t>(threadBlock.first);
+            mTBlockY          = static_cast<uint32_t>(threadBlock.second);
+        }
+
         // Clear the kernel to run
         mRunFlag &= checkDevice();
-        mRunFlag &= checkSizes();
+        mRunFlag &= (mTBlockX > 0u) && (mTBlockY > 0u) && checkSizes();
         mRunFlag &= checkLds();
         mRunFlag &= checkQuirks();
 
         if(mRunFlag)
         {
+            mOccupancy = occupancy();
+
             auto& dataInstance = DataStorage::instance();
 
             // Initialize matrix storage
             dataInstance->resizeStorage(problem.problemSize);
 
             // Initialize matrix data on device
-            MatrixUtil<LayoutA>::fillLaunchKernel(dataInstance->deviceA().get(), mM, mK);
-            MatrixUtil<LayoutB>::fillLaunchKernel(dataInstance->deviceB().get(), mK, mN);
-            MatrixUtil<LayoutC>::fillLaunchKernel(dataInstance->deviceC().get(), mM, mN);
+            MatrixUtil<LayoutA>::fillRandLaunchKernel(
+                dataInstance->deviceA().get(), mM, mK, mSeedA);
+            MatrixUtil<LayoutB>::fillRandLaunchKernel(
+                dataInstance->deviceB().get(), mK, mN, mSeedB);
+            MatrixUtil<LayoutC>::fillRandLaunchKernel(
+                dataInstance->deviceC().get(), mM, mN, mSeedC);
             MatrixUtil<LayoutD>::fillValLaunchKernel(dataInstance->deviceD().get(),
                                                      mM,
                                                      mN,
                                                      std::numeric_limits<OutputT>::signaling_NaN());
 
             // Initialize the host data if we are to use Cpu validation.
-            if constexpr(mRunRefFlag && mIsCpuRef)
+            // The inputs are downloaded to pinned host memory on a separate stream,
+            // overlapping with the rocWMMA warm-up runs. D is not needed on the host
+            // and is written by the rocWMMA runs.
+            if constexpr(mRunRefFlag && mIsNativeRef && (bool)ROCWMMA_VALIDATE_WITH_CPU)
             {
-                dataInstance->copyDeviceToHostAll();
+                hipEvent_t fillEvent;
+                CHECK_HIP_ERROR(hipEventCreate(&fillEvent));
+                CHECK_HIP_ERROR(hipEventRecord(fillEvent));
+                CHECK_HIP_ERROR(hipStreamCreateWithFlags(&mCopyStream, hipStreamNonBlocking));
+                CHECK_HIP_ERROR(hipStreamWaitEvent(mCopyStream, fillEvent, 0));
+                CHECK_HIP_ERROR(hipEventDestroy(fillEvent));
+
+                dataInstance->copyDataAsync(
+                    dataInstance->hostA(), dataInstance->deviceA(), mM * mK, mCopyStream);
+                dataInstance->copyDataAsync(
+                    dataInstance->hostB(), dataInstance->deviceB(), mK * mN, mCopyStream);
+                dataInstance->copyDataAsync(
+                    dataInstance->hostC(), dataInstance->deviceC(), mM * mN, mCopyStream);
             }
         }
     }
@@ -615,17 +1010,20 @@ namespace rocwmma
     {
         if(mRunFlag)
         {
+            auto       tag = roctxTag();
+            RoctxRange range(tag, " exec");
+
             ///
             /// Run ROCWMMA kernel
             ///
 
-            auto rocwmmaKernel = [this]() {
+            auto rocwmmaKernel = [this](hipStream_t stream) {
                 auto& dataInstance = DataStorage::instance();
                 hipExtLaunchKernelGGL((this->kernelImpl()), // Kernel to launch
                                       (this->gridDim()), // Wg grid size
                                       (this->blockDim()), // Thread block size
                                       (this->ldsUsage()), // sharedMemBytes
-                                      0, // stream
+                                      stream, // stream
                                       nullptr, // Event start
                                       nullptr, // event stop
                                       0, // flags
@@ -647,51 +1045,144 @@ namespace rocwmma
             // Cold runs for frequency warm-up
             for(uint32_t i = 0; i < mColdRuns; ++i)
             {
-                rocwmmaKernel();
+                rocwmmaKernel(0);
+            }
+
+            // Finish the host input download before the timed runs
+            if(mCopyStream != nullptr)
+            {
+                CHECK_HIP_ERROR(hipStreamSynchronize(mCopyStream));
+                CHECK_HIP_ERROR(hipStreamDestroy(mCopyStream));
+                mCopyStream = nullptr;
             }
 
-            // Use the hot runs for timing
-            hipEvent_t startEvent, stopEvent;
-            CHECK_HIP_ERROR(hipEventCreate(&startEvent));
-            CHECK_HIP_ERROR(hipEventCreate(&stopEvent));
-            CHECK_HIP_ERROR(hipEventRecord(startEvent));
+            // Use the hot runs for timing. Events between runs give
+            // the per-run samples without adding synchronization.
+            std::vector<hipEvent_t> runEvents(mHotRuns + 1u);
+            for(auto& event : runEvents)
+            {
+                CHECK_HIP_ERROR(hipEventCreate(&event));
+            }
+            CHECK_HIP_ERROR(hipEventRecord(runEvents[0]));
             for(uint32_t i = 0; i < mHotRuns; ++i)
             {
-                rocwmmaKernel();
+                RoctxRange runRange(tag, " run ", i);
+                rocwmmaKernel(0);
+                CHECK_HIP_ERROR(hipEventRecord(runEvents[i + 1u]));
             }
-            CHECK_HIP_ERROR(hipEventRecord(stopEvent));
-            CHECK_HIP_ERROR(hipEventSynchronize(stopEvent));
+            CHECK_HIP_ERROR(hipEventSynchronize(runEvents[mHotRuns]));
 
             auto timeMs = 0.0f;
-            CHECK_HIP_ERROR(hipEventElapsedTime(&timeMs, startEvent, stopEvent));
+            CHECK_HIP_ERROR(hipEventElapsedTime(&timeMs, runEvents[0], runEvents[mHotRuns]));
+
+            std::vector<double> runTimesMs(mHotRuns);
+            for(uint32_t i = 0; i < mHotRuns; ++i)
+            {
+                auto runMs = 0.0f;
+                CHECK_HIP_ERROR(hipEventElapsedTime(&runMs, runEvents[i], runEvents[i + 1u]));
+                runTimesMs[i] = runMs;
+            }
+            mTiming = calculateTimingStats(runTimesMs);
 
             // Calculate efficiency
             auto& deviceInfo = DeviceInfo::instance();
 
+            auto totalGBytes  = calculateGemmGBytes<InputT, OutputT>(mM, mN, mK);
+            auto flopsPerByte = calculateGFlops(mM, mN, mK) / totalGBytes;
+
             auto devicePeakGFlopsPerSec = deviceInfo->peakGFlopsPerSec<InputT>();
+            auto devicePeakGBytesPerSec = deviceInfo->peakGBytesPerSec();
+            auto deviceRoofGFlopsPerSec = deviceInfo->rooflineGFlopsPerSec<InputT>(flopsPerByte);
 
             mElapsedTimeMs        = float64_t(timeMs);
             mTotalGFlops          = calculateGFlops(mM, mN, mK);
             mMeasuredTFlopsPerSec = calculateTFlopsPerSec(mM, mN, mK, mElapsedTimeMs)
                                     * static_cast<float64_t>(mHotRuns);
 
-            mEfficiency = round(mMeasuredTFlopsPerSec / devicePeakGFlopsPerSec * 100000.0);
+            // Report against the applicable roof: bandwidth for low intensity, compute otherwise
+            mRoofTFlopsPerSec = deviceRoofGFlopsPerSec * 1.0e-3;
+            mMemoryBound
+                = isMemoryBound(devicePeakGFlopsPerSec, devicePeakGBytesPerSec, flopsPerByte);
+            mEfficiency = calculatePercentOfRoof(mMeasuredTFlopsPerSec, deviceRoofGFlopsPerSec);
 
-            CHECK_HIP_ERROR(hipEventDestroy(startEvent));
-            CHECK_HIP_ERROR(hipEventDestroy(stopEvent));
+            for(auto& event : runEvents)
+            {
+                CHECK_HIP_ERROR(hipEventDestroy(event));
+            }
+
+            // Board energy of back to back runs over at least mEnergyWindowMs, as the
+            // energy counter only updates about every millisecond.
+            if(mEnergy)
+            {
+                RoctxRange energyRange(tag, " energy");
+
+                auto runMs = std::max(mTiming.mMeanMs, 1.0e-3);
+                auto runs  = std::max(mHotRuns,
+                                     static_cast<uint32_t>(std::ceil(mEnergyWindowMs / runMs)));
+
+                auto startJ = 0.0, endJ = 0.0;
+                auto started  = deviceInfo->energyJoules(startJ);
+                auto energyMs = timeBackToBackMs([&]() { rocwmmaKernel(0); }, 0, runs);
+
+                if(started && deviceInfo->energyJoules(endJ) && endJ > startJ)
+                {
+                    mJoulesPerRun  = (endJ - startJ) / static_cast<float64_t>(runs);
+                    mAvgPowerW     = (endJ - startJ) / (energyMs * 1.0e-3);
+                    mGFlopsPerWatt = calculateGFlopsPerWatt(mTotalGFlops, mJoulesPerRun);
+                }
+            }
+
+            // Hardware counters of separate runs, after timing as collection serializes
+            // and instruments the dispatches
+            if(CounterCollector::instance()->enabled())
+            {
+                RoctxRange counterRange(tag, " counters");
+                mCounters = CounterCollector::instance()->collect([&]() { rocwmmaKernel(0); });
+            }
+
+            // Replay the same launch sequence from a hipGraph to measure launch overhead savings
+            if(mGraphLaunch)
+            {
+                RoctxRange graphRange(tag, " graph");
+
+                HipGraphLauncher graph;
+                graph.capture(rocwmmaKernel);
+
+                auto graphLaunch  = [&graph]() { graph.launch(); };
+                auto directLaunch = [&graph, &rocwmmaKernel]() { rocwmmaKernel(graph.stream()); };
+                for(uint32_t i = 0; i < mColdRuns; ++i)
+                {
+                    graphLaunch();
+                }
+
+                // Compare against direct launches timed the same way, without per-run events
+                auto directElapsedTimeMs
+                    = timeBackToBackMs(directLaunch, graph.stream(), mHotRuns);
+                mGraphElapsedTimeMs = timeBackToBackMs(graphLaunch, graph.stream(), mHotRuns);
+                mGraphSavings       = (1.0 - mGraphElapsedTimeMs / directElapsedTimeMs) * 100.0;
+            }
 
             if constexpr(mRunRefFlag)
             {
                 // Reference kernel selection
                 std::function<void()> refKernel;
 
-                if constexpr(mIsCpuRef)
+#if ROCWMMA_ROCBLAS_INTEGRATION
+                rocblas_handle rocBlasHandle = nullptr;
+#endif // ROCWMMA_ROCBLAS_INTEGRATION
+
+                // Reference result buffer:
+                // - Native ref: output of the reference kernel
+                // - rocBLAS ref: cache of the rocWMMA result
+                auto refCacheD = DataStorage::template allocDevice<OutputT>(0);
+
+                if constexpr(mIsNativeRef)
                 {
 
-#if ROCWMMA_VALIDATION_TESTS
+#if ROCWMMA_VALIDATION_TESTS && ROCWMMA_VALIDATE_WITH_CPU
 
-                    // Define fallback CPU kernel
-                    auto cpuKernel = [this]() {
+                    // Define CPU kernel, copying the result to the local device pointer
+                    auto cpuKernel = [this, &refCacheD]() {
                         auto& dataInstance = DataStorage::instance();
                         gemm_CPU<InputT, OutputT, ComputeT, LayoutA, LayoutB, LayoutC, LayoutD>(
                             this->mM,
@@ -703,11 +1194,40 @@ namespace rocwmma
                             dataInstance->hostD().get(),
                             this->mAlpha,
                             this->mBeta);
+                        dataInstance->copyData(
+                            refCacheD, dataInstance->hostD(), this->mM * this->mN);
                     };
 
                     // Assign cpu func
                     refKernel = cpuKernel;
 
+#elif ROCWMMA_VALIDATION_TESTS
+
+                    // Define native reference kernel. A, B and C are still on the device
+                    // from the rocWMMA run, so only the max error of the comparison is
+                    // copied back to the host.
+                    auto nativeKernel = [this, &refCacheD]() {
+                        auto& dataInstance = DataStorage::instance();
+                        gemmReferenceLaunchKernel<InputT,
+                                                  OutputT,
+                                                  ComputeT,
+                                                  LayoutA,
+                                                  LayoutB,
+                                                  LayoutC,
+                                                  LayoutD>(this->mM,
+                                                           this->mN,
+                                                           this->mK,
+                                                           dataInstance->deviceA().get(),
+                                                           dataInstance->deviceB().get(),
+                                                           dataInstance->deviceC().get(),
+                                                           refCacheD.get(),
+                                                           this->mAlpha,
+                                                           this->mBeta);
+                    };
+
+                    // Assign native func
+                    refKernel = nativeKernel;
+
 #endif // ROCWMMA_VALIDATION_TESTS
                 }
                 else
@@ -715,11 +1235,11 @@ namespace rocwmma
 
 #if ROCWMMA_ROCBLAS_INTEGRATION
 
-                    auto rocBlasKernel = [this]() {
-                        // Create a rocBLAS handle to be used with rocBLAS API
-                        rocblas_handle handle;
-                        CHECK_ROCBLAS_ERROR(rocblas_create_handle(&handle));
+                    // Create a rocBLAS handle to be used with rocBLAS API. It outlives
+                    // the reference runs, so that benchmarks only time the GEMM.
+                    CHECK_ROCBLAS_ERROR(rocblas_create_handle(&rocBlasHandle));
 
+                    auto rocBlasKernel = [this, handle = rocBlasHandle]() {
                         auto& dataInstance = DataStorage::instance();
 
                         static_assert((!std::is_same_v<InputT, float8_t>
@@ -752,11 +1272,9 @@ namespace rocwmma
                                              rocblas_gemm_algo_standard, // algo
                                              0, // solution_index
                                              0)); // flags
-
-                        rocblas_destroy_handle(handle);
                     };
 
-                    // Assign cpu func
+                    // Assign rocBLAS func
                     refKernel = rocBlasKernel;
 
 #endif // ROCWMMA_ROCBLAS_INTEGRATION
@@ -772,9 +1290,13 @@ namespace rocwmma
                 // Prepare inputs for the reference kernel
                 auto& dataInstance = DataStorage::instance();
 
-                // rocBLAS ref
-                auto rocWMMACacheD = DataStorage::template allocDevice<OutputT>(0);
-                if constexpr(!mIsCpuRef)
+                if constexpr(mIsNativeRef)
+                {
+                    // A, B, C & D are cached on device pointers from the rocWMMA run.
+                    // The reference result is written to the local device pointer.
+                    dataInstance->template reallocDevice<OutputT>(refCacheD, mM * mN);
+                }
+                else
                 {
                     // A, B, C & D are cached on on device pointers from the rocWMMA run.
                     // Need to cache rocWMMA D result device memory, then re-initialize
@@ -783,15 +1305,15 @@ namespace rocwmma
                     // Cache rocWMMA result on device only if we are validating
                     if constexpr(!mBenchRef)
                     {
-                        dataInstance->template reallocDevice<OutputT>(rocWMMACacheD, mM * mN);
-                        dataInstance->copyData(rocWMMACacheD, dataInstance->deviceD(), mM * mN);
+                        dataInstance->template reallocDevice<OutputT>(refCacheD, mM * mN);
+                        dataInstance->copyData(refCacheD, dataInstance->deviceD(), mM * mN);
                     }
 
                     // rocBLAS matrix C is always in col_major, so adjust it if needed
                     if(!std::is_same<LayoutC, col_major>::value)
                     {
-                        MatrixUtil<col_major>::fillLaunchKernel(
-                            dataInstance->deviceC().get(), mM, mN);
+                        MatrixUtil<col_major>::fillRandLaunchKernel(
+                            dataInstance->deviceC().get(), mM, mN, mSeedC);
                     }
 
                     // Reset device D with NaN
@@ -802,56 +1324,58 @@ namespace rocwmma
                         std::numeric_limits<OutputT>::signaling_NaN());
                 }
 
-                // Cold runs for frequency warm-up
-                for(uint32_t i = 0; i < mColdRuns; ++i)
-                {
-                    refKernel();
-                }
+                RoctxRange refRange(tag, " reference");
 
-                // Hot runs for timing
-                hipEvent_t startEvent, stopEvent;
-                CHECK_HIP_ERROR(hipEventCreate(&startEvent));
-                CHECK_HIP_ERROR(hipEventCreate(&stopEvent));
-                CHECK_HIP_ERROR(hipEventRecord(startEvent));
-                for(uint32_t i = 0; i < mHotRuns; ++i)
+                // Validation only needs a single reference run
+                if constexpr(!mBenchRef)
                 {
                     refKernel();
                 }
-                CHECK_HIP_ERROR(hipEventRecord(stopEvent));
-                CHECK_HIP_ERROR(hipEventSynchronize(stopEvent));
-
-                auto timeMs = 0.0f;
-                CHECK_HIP_ERROR(hipEventElapsedTime(&timeMs, startEvent, stopEvent));
-                CHECK_HIP_ERROR(hipEventDestroy(startEvent));
-                CHECK_HIP_ERROR(hipEventDestroy(stopEvent));
-
                 // Calculate reference efficiency
-                if constexpr(mBenchRef)
+                else
                 {
+                    // Cold runs for frequency warm-up
+                    for(uint32_t i = 0; i < mColdRuns; ++i)
+                    {
+                        refKernel();
+                    }
+
+                    // Hot runs for timing
+                    hipEvent_t startEvent, stopEvent;
+                    CHECK_HIP_ERROR(hipEventCreate(&startEvent));
+                    CHECK_HIP_ERROR(hipEventCreate(&stopEvent));
+                    CHECK_HIP_ERROR(hipEventRecord(startEvent));
+                    for(uint32_t i = 0; i < mHotRuns; ++i)
+                    {
+                        refKernel();
+                    }
+                    CHECK_HIP_ERROR(hipEventRecord(stopEvent));
+                    CHECK_HIP_ERROR(hipEventSynchronize(stopEvent));
 
-                    auto& deviceInfo             = DeviceInfo::instance();
-                    auto  devicePeakGFlopsPerSec = deviceInfo->peakGFlopsPerSec<InputT>();
+                    auto timeMs = 0.0f;
+                    CHECK_HIP_ERROR(hipEventElapsedTime(&timeMs, startEvent, stopEvent));
+                    CHECK_HIP_ERROR(hipEventDestroy(startEvent));
+                    CHECK_HIP_ERROR(hipEventDestroy(stopEvent));
 
                     auto elapsedTimeMs        = float64_t(timeMs);
                     auto measuredTFlopsPerSec = calculateTFlopsPerSec(mM, mN, mK, elapsedTimeMs)
                                                 * static_cast<float64_t>(mHotRuns);
 
                     mRefMeasuredTFlopsPerSec = measuredTFlopsPerSec;
-                    mRefEfficiency
-                        = round(measuredTFlopsPerSec / devicePeakGFlopsPerSec * 100000.0);
+                    mRefEfficiency = calculatePercentOfRoof(measuredTFlopsPerSec,
+                                                            mRoofTFlopsPerSec * 1.0e3);
                 }
 
                 // Prepare data for validation
                 if constexpr((bool)ROCWMMA_VALIDATION_TESTS)
                 {
-                    if constexpr(mIsCpuRef)
+                    if constexpr(mIsNativeRef)
                     {
                         // A, B, C & D from rocWMMA run are cached on device pointers.
-                        // A, B, C & D from reference are cached on host pointers.
-                        // Copy the reference host D result to C device pointer so we
+                        // D from reference is cached in local device pointer.
+                        // Copy the reference local result to C device pointer so we
                         // can validate the reference (device C) vs rocWMMA (device D).
-                        dataInstance->copyData(
-                            dataInstance->deviceC(), dataInstance->hostD(), mM * mN);
+                        dataInstance->copyData(dataInstance->deviceC(), refCacheD, mM * mN);
                     }
                     else
                     {
@@ -859,10 +1383,75 @@ namespace rocwmma
                         // D from rocWMMA is cached in local device pointer.
                         // Copy the rocWMMA local result to C device pointer so we can
                         // validate the reference (device D) vs rocWMMA (device C).
-                        dataInstance->copyData(dataInstance->deviceC(), rocWMMACacheD, mM * mN);
+                        dataInstance->copyData(dataInstance->deviceC(), refCacheD, mM * mN);
                     }
                 }
+
+#if ROCWMMA_ROCBLAS_INTEGRATION
+                if(rocBlasHandle != nullptr)
+                {
+                    CHECK_ROCBLAS_ERROR(rocblas_destroy_handle(rocBlasHandle));
+                }
+#endif // ROCWMMA_ROCBLAS_INTEGRATION
             }
+
+#if ROCWMMA_BENCHMARK_WITH_HIPBLASLT
+
+            // Time hipBLASLt on the same inputs, after any reference run
+            if constexpr(mBenchHipblasLt)
+            {
+                RoctxRange hipblasLtRange(tag, " hipBLASLt");
+
+                auto& dataInstance = DataStorage::instance();
+
+                // hipBLASLt matrix C is always in col_major, so adjust it if needed.
+                // Benchmarks do not validate, so the rocWMMA D is overwritten.
+                if(!std::is_same<LayoutC, col_major>::value)
+                {
+                    MatrixUtil<col_major>::fillRandLaunchKernel(
+                        dataInstance->deviceC().get(), mM, mN, mSeedC);
+                }
+
+                HipblasLtGemm hipblasLtGemm(hipblaslt_layout<LayoutA>::operation(),
+                                            hipblaslt_layout<LayoutB>::operation(),
+                                            mM,
+                                            mN,
+                                            mK,
+                                            hipblaslt_types<InputT>::type(),
+                                            hipblaslt_types<OutputT>::type(),
+                                            mLda,
+                                            mLdb,
+                                            mM, // ldc (col major output only)
+                                            mM); // ldd (col major output only)
+
+                if(hipblasLtGemm.hasAlgo())
+                {
+                    auto hipblasLtKernel = [this, &hipblasLtGemm, &dataInstance]() {
+                        hipblasLtGemm(&(this->mAlpha),
+                                      dataInstance->deviceA().get(),
+                                      dataInstance->deviceB().get(),
+                                      &(this->mBeta),
+                                      dataInstance->deviceC().get(),
+                                      dataInstance->deviceD().get());
+                    };
+
+                    // Cold runs for frequency warm-up
+                    for(uint32_t i = 0; i < mColdRuns; ++i)
+                    {
+                        hipblasLtKernel();
+                    }
+
+                    // Hot runs timed like the rocBLAS reference
+                    auto elapsedTimeMs = timeBackToBackMs(hipblasLtKernel, 0, mHotRuns);
+
+                    mHipblasLtTFlopsPerSec = calculateTFlopsPerSec(mM, mN, mK, elapsedTimeMs)
+                                             * static_cast<float64_t>(mHotRuns);
+                    mHipblasLtEfficiency   = calculatePercentOfRoof(mHipblasLtTFlopsPerSec,
+                                                                    mRoofTFlopsPerSec * 1.0e3);
+                }
+            }
+
+#endif // ROCWMMA_BENCHMARK_WITH_HIPBLASLT
         }
     }
 
@@ -890,18 +1479,20 @@ namespace rocwmma
 
         if(mRunFlag && (bool)ROCWMMA_VALIDATION_TESTS)
         {
-            // If CPU reference, result layout is LayoutD, otherwise rocBLAS ref is always in col_major;
-            using DeviceRefLayout = typename std::conditional_t<mIsCpuRef, LayoutD, col_major>;
+            RoctxRange range(roctxTag(), " validate");
+
+            // If native reference, result layout is LayoutD, otherwise rocBLAS ref is always in col_major;
+            using DeviceRefLayout = typename std::conditional_t<mIsNativeRef, LayoutD, col_major>;
 
             auto& dataInstance = DataStorage::instance();
 
-            // If CPU ref, the rocWMMA result is in device D, otherwise device C
+            // If native ref, the rocWMMA result is in device D, otherwise device C
             auto* rocWMMAResult
-                = mIsCpuRef ? dataInstance->deviceD().get() : dataInstance->deviceC().get();
+                = mIsNativeRef ? dataInstance->deviceD().get() : dataInstance->deviceC().get();
 
-            // If CPU ref, the reference result is in device C, otherwise device D
+            // If native ref, the reference result is in device C, otherwise device D
             auto* refResult
-                = mIsCpuRef ? dataInstance->deviceC().get() : dataInstance->deviceD().get();
+                = mIsNativeRef ? dataInstance->deviceC().get() : dataInstance->deviceD().get();
 
             // Give more error tolerance to ComputeT = fp16,
             // due to MFMA output is always fp32. We downcast the MFMA result to fp16, which
@@ -981,6 +1572,13 @@ namespace rocwmma
                         LayoutC,
                         LayoutD>::tearDown()
     {
+        // Download stream of a setup that was not executed
+        if(mCopyStream != nullptr)
+        {
+            CHECK_HIP_ERROR(hipStreamSynchronize(mCopyStream));
+            CHECK_HIP_ERROR(hipStreamDestroy(mCopyStream));
+            mCopyStream = nullptr;
+        }
     }
 
 } // namespace rocwmma
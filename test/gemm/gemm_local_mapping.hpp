@@ -37,7 +37,9 @@ namespace rocwmma
 {
     namespace LocalMapping
     {
-        template <typename GlobalMapping, typename LayoutLds>
+        template <typename GlobalMapping,
+                  typename LayoutLds,
+                  typename LdsAccessPolicy = lds_access>
         struct LdsMappingTN
         {
             /*
@@ -77,6 +79,9 @@ namespace rocwmma
 
             using DataLayout = DataLayout::Array1d<LayoutLds>;
 
+            // Access policy of local writes and reads (lds_access or xor_swizzle)
+            using AccessPolicy = LdsAccessPolicy;
+
             /// LOCAL WRITE -> GR frags
             // K = BlockHeight
             // GRFragA Transposed
@@ -156,7 +161,9 @@ namespace rocwmma
             }
         };
 
-        template <typename GlobalMapping, typename LayoutLds>
+        template <typename GlobalMapping,
+                  typename LayoutLds,
+                  typename LdsAccessPolicy = lds_access>
         struct LdsMappingNT
         {
             /* LdsMappingNT (Block Width = LDS Width = BlockK)
@@ -207,6 +214,9 @@ namespace rocwmma
 
             using DataLayout = DataLayout::Array1d<LayoutLds>;
 
+            // Access policy of local writes and reads (lds_access or xor_swizzle)
+            using AccessPolicy = LdsAccessPolicy;
+
             /// LOCAL WRITE -> GR frags
             // K = BlockWidth
             // GRFragA unchanged
@@ -285,7 +295,9 @@ namespace rocwmma
             }
         };
 
-        template <typename GlobalMapping, typename LayoutLds>
+        template <typename GlobalMapping,
+                  typename LayoutLds,
+                  typename LdsAccessPolicy = lds_access>
         struct LdsMappingRF
         {
             /*
@@ -347,6 +359,9 @@ namespace rocwmma
 
             using DataLayout = DataLayout::Array1d<LayoutLds>;
 
+            // Access policy of local writes and reads (lds_access or xor_swizzle)
+            using AccessPolicy = LdsAccessPolicy;
+
             /// LOCAL WRITE -> GR frags (MFMA blocks)
             // LDS width = AMDGCN_WAVE_SIZE
             // GRFragA transformed to register file
@@ -34,9 +34,9 @@ namespace rocwmma
     namespace LocalMapping
     {
 
-#define LdsMappingT typename GlobalMapping, typename LayoutLds
+#define LdsMappingT typename GlobalMapping, typename LayoutLds, typename LdsAccessPolicy
 
-#define LdsMappingT_impl GlobalMapping, LayoutLds
+#define LdsMappingT_impl GlobalMapping, LayoutLds, LdsAccessPolicy
 
         template <LdsMappingT>
         __device__ constexpr inline auto LdsMappingTN<LdsMappingT_impl>::waveOffsetA()
@@ -114,9 +114,9 @@ namespace rocwmma
 #undef LdsMappingT
 #undef LdsMappingT_impl
 
-#define LdsMappingT typename GlobalMapping, typename LayoutLds
+#define LdsMappingT typename GlobalMapping, typename LayoutLds, typename LdsAccessPolicy
 
-#define LdsMappingT_impl GlobalMapping, LayoutLds
+#define LdsMappingT_impl GlobalMapping, LayoutLds, LdsAccessPolicy
 
         template <LdsMappingT>
         __device__ constexpr inline auto LdsMappingNT<LdsMappingT_impl>::waveOffsetA()
@@ -197,9 +197,9 @@ namespace rocwmma
 #undef LdsMappingT
 #undef LdsMappingT_impl
 
-#define LdsMappingT typename GlobalMapping, typename LayoutLds
+#define LdsMappingT typename GlobalMapping, typename LayoutLds, typename LdsAccessPolicy
 
-#define LdsMappingT_impl GlobalMapping, LayoutLds
+#define LdsMappingT_impl GlobalMapping, LayoutLds, LdsAccessPolicy
 
         template <LdsMappingT>
         __device__ constexpr inline auto
@@ -0,0 +1,168 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef ROCWMMA_GEMM_MAPPING_SELECTOR_HPP
+#define ROCWMMA_GEMM_MAPPING_SELECTOR_HPP
+
+#include <cstdint>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <rocwmma/internal/utils.hpp>
+
+namespace rocwmma
+{
+    // Host-side cost model of the global mappings. A mapping is one point of the
+    // compile-time family of wave tiles (BlockM * BlocksX) x (BlockN * BlocksY), each
+    // instantiated for the thread blocks of GemmKernelBase::dispatchKernelFunc.
+    // For a problem shape, the workgroup (macro) tile of each mapping is scored on:
+    // - Reuse: MACs per loaded A / B element of the macro tile
+    // - Tile efficiency: useful fraction of the padded output, lost to partial macro tiles
+    // - Wave efficiency: busy fraction of the SIMDs over all rounds of waves, lost to
+    //   too few waves, or to a partial last round
+    struct GemmMappingSelector
+    {
+        using ThreadBlockT = std::pair<int64_t, int64_t>;
+        using WaveTileT    = std::tuple<uint32_t, uint32_t, uint32_t>;
+
+        // Waves in flight per CU at which the SIMDs are all busy
+        constexpr static uint32_t SimdsPerCu = 4u;
+
+        struct Cost
+        {
+            double mReuse;
+            double mTileEfficiency;
+            double mWaveEfficiency;
+
+            double score() const
+            {
+                return mReuse * mTileEfficiency * mWaveEfficiency;
+            }
+        };
+
+        // Thread blocks compiled by GemmKernelBase::dispatchKernelFunc:
+        // TBlockX of [32, 64, 128, 256] in whole waves, TBlockY of [1, 2, 4]
+        static std::vector<ThreadBlockT> threadBlocks(uint32_t warpSize)
+        {
+            std::vector<ThreadBlockT> result;
+            for(uint32_t tBlockX : {32u, 64u, 128u, 256u})
+            {
+                for(uint32_t tBlockY : {1u, 2u, 4u})
+                {
+                    if(tBlockX % warpSize == 0u)
+                    {
+                        result.push_back({tBlockX, tBlockY});
+                    }
+                }
+            }
+            return result;
+        }
+
+        // Macro tile of the wave tile and thread block, in (M, N)
+        static std::pair<uint32_t, uint32_t>
+            macroTile(WaveTileT const& waveTile, ThreadBlockT const& threadBlock, uint32_t warpSize)
+        {
+            return {std::get<0>(waveTile) * static_cast<uint32_t>(threadBlock.first) / warpSize,
+                    std::get<1>(waveTile) * static_cast<uint32_t>(threadBlock.second)};
+        }
+
+        // The macro tile must fit inside the problem. Kernels without tail handling
+        // (exact = true) also require the problem to be a whole number of macro tiles.
+        static bool fits(WaveTileT const&    waveTile,
+                         ThreadBlockT const& threadBlock,
+                         uint32_t            warpSize,
+                         uint32_t            m,
+                         uint32_t            n,
+                         uint32_t            k,
+                         bool                exact = true)
+        {
+            uint32_t wgM, wgN;
+            std::tie(wgM, wgN) = macroTile(waveTile, threadBlock, warpSize);
+            auto tileK         = std::get<2>(waveTile);
+
+            if(wgM == 0u || wgM > m || wgN > n || tileK > k || k % tileK != 0u)
+            {
+                return false;
+            }
+            return !exact || (m % wgM == 0u && n % wgN == 0u);
+        }
+
+        static Cost cost(WaveTileT const&    waveTile,
+                         ThreadBlockT const& threadBlock,
+                         uint32_t            warpSize,
+                         uint32_t            cuCount,
+                         uint32_t            m,
+                         uint32_t            n)
+        {
+            uint32_t wgM, wgN;
+            std::tie(wgM, wgN) = macroTile(waveTile, threadBlock, warpSize);
+
+            auto tiles        = ceilDiv(m, wgM) * ceilDiv(n, wgN);
+            auto wavesPerTile = static_cast<uint32_t>(threadBlock.first) / warpSize
+                                * static_cast<uint32_t>(threadBlock.second);
+
+            auto waves  = tiles * wavesPerTile;
+            auto slots  = cuCount * SimdsPerCu;
+            auto rounds = ceilDiv(waves, slots);
+
+            return {double(wgM) * wgN / (wgM + wgN),
+                    double(m) * n / (double(tiles) * wgM * wgN),
+                    double(waves) / (double(rounds) * slots)};
+        }
+
+        // Best thread block of the family for the wave tile, or {0, 0} if none fits
+        static ThreadBlockT select(WaveTileT const& waveTile,
+                                   uint32_t         warpSize,
+                                   uint32_t         cuCount,
+                                   uint32_t         m,
+                                   uint32_t         n,
+                                   uint32_t         k,
+                                   bool             exact = true)
+        {
+            auto         bestScore = 0.0;
+            ThreadBlockT result    = {0, 0};
+            for(auto const& threadBlock : threadBlocks(warpSize))
+            {
+                if(!fits(waveTile, threadBlock, warpSize, m, n, k, exact))
+                {
+                    continue;
+                }
+
+                auto score = cost(waveTile, threadBlock, warpSize, cuCount, m, n).score();
+                if(score > bestScore)
+                {
+                    bestScore = score;
+                    result    = threadBlock;
+                }
+            }
+            return result;
+        }
+    };
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_GEMM_MAPPING_SELECTOR_HPP
@@ -0,0 +1,196 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GEMM_PIPELINE_HPP
+#define GEMM_PIPELINE_HPP
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+#include <rocwmma/rocwmma.hpp>
+#include <rocwmma/rocwmma_coop.hpp>
+#include <rocwmma/rocwmma_pipeline.hpp>
+#include <rocwmma/rocwmma_profile.hpp>
+#pragma GCC diagnostic pop
+
+namespace rocwmma
+{
+    namespace CooperativeGemm
+    {
+        /* GemmPipeline class:
+        * This class implements a multi-stage software pipeline for the
+        * A * B accumulation loop, using the workflow steps of a GemmDriver.
+        *
+        * Stages = number of K tiles in flight, where:
+        * - (Stages - 1) K tiles are prefetched from global memory into
+        *   a ring of global read buffers (registers)
+        * - 1 K tile is consumed from LDS by local reads and mfma
+        *
+        * LDS is double-buffered: the next K tile is written to LDS while
+        * the current K tile is being consumed. Buffers are rotated at every
+        * K step. Deeper pipelines hide more global memory latency at the
+        * cost of additional global read buffer registers.
+        *
+        * Schedule at K step t, with P = Stages - 1:
+        *
+        *  Prologue: GR(0) ... GR(P - 1) -> LW(0) -> Sync
+        *
+        *  Step t:   LR(t) -> GR(t + P) -> MFMA(t) -> LW(t + 1) -> Sync
+        *
+        *  GR = global read, LR = local read, LW = local write
+        *
+        * Stages = 2 is equivalent to the PGR1_LB2 workflow.
+        *
+        * SchedPolicy shapes the instruction schedule of each K step, e.g.
+        * interleaving mfma with local and global reads (see SchedInterleave).
+        *
+        * PingPongPriority >= 0 enables ping-pong scheduling: the ping and pong
+        * wave groups (see GemmDriver::isPongWave) alternate between the memory
+        * phase (LR, GR, LW) and the mfma phase of each K step, one barrier apart.
+        * While the ping waves run mfma, the pong waves issue memory accesses and
+        * vice versa. Mfma phases run at wave priority PingPongPriority, so the
+        * SIMD keeps feeding the matrix cores ahead of its memory wave.
+        * Step barriers only wait on LDS, so global reads stay in flight.
+        *
+        *  Ping: Sync -> | Mem(t)  | MFMA(t) | Mem(t + 1) | ... | Barrier
+        *  Pong: Sync -> | Barrier | Mem(t)  | MFMA(t)    | ...
+        *
+        * Ping-pong is most effective with two waves per SIMD, i.e. 8 waves of 64.
+        *
+        * The K loop is unrolled by PrefetchDepth * KUnroll steps, such that ring
+        * slots are static. Deeper unrolling trades code size for fewer loop
+        * branches and more freedom to pack mfma across K steps, e.g. for short K.
+        *
+        * StageSyncWaves > 0 replaces the workgroup barrier of each K step with
+        * per LDS buffer counters (see lds_stage_barrier), for a workgroup of
+        * StageSyncWaves waves. Each wave only waits for the local writes of the
+        * buffer it reads, and for the local reads of the buffer it overwrites,
+        * such that waves skew by up to one K step instead of all waiting on the
+        * slowest one. Arrivals release the wave's memory accesses at workgroup
+        * scope.
+        *
+        *  Step t:   Wait(t) -> LR(t) -> Release(t) -> GR(t + P) -> MFMA(t)
+        *            -> Acquire(t + 1) -> LW(t + 1) -> Commit(t + 1)
+        */
+        template <typename GemmDriver,
+                  typename GlobalMapping,
+                  typename LdsMapping,
+                  uint32_t Stages           = 2u,
+                  typename SchedPolicy      = SchedNone,
+                  int32_t  PingPongPriority = -1,
+                  uint32_t KUnroll          = 1u,
+                  uint32_t StageSyncWaves   = 0u>
+        struct GemmPipeline
+        {
+            static_assert(Stages >= 2u && Stages <= 4u, "Pipeline stages must be 2, 3 or 4");
+            static_assert(PingPongPriority <= 3, "Wave priority must be 0, 1, 2 or 3");
+            static_assert(KUnroll >= 1u, "K loop unroll depth must be at least 1");
+            static_assert(PingPongPriority < 0 || StageSyncWaves == 0u,
+                          "Ping-pong pipelines synchronize with workgroup barriers");
+
+            enum : uint32_t
+            {
+                PrefetchDepth = Stages - 1u,
+                LdsBuffers    = 2u,
+                UnrollSteps   = PrefetchDepth * KUnroll
+            };
+
+            constexpr static bool PingPong = (PingPongPriority >= 0);
+
+            constexpr static bool StageSync = (StageSyncWaves > 0u);
+
+            // Counters of the LDS buffers, behind the buffers in LDS. Every wave writes
+            // and reads each buffer.
+            constexpr static uint32_t StageWaves = StageSync ? StageSyncWaves : 1u;
+            using StageBarrier = lds_stage_barrier<LdsBuffers, StageWaves, StageWaves>;
+
+            using InputT = GetDataType_t<typename GlobalMapping::GRFragA>;
+
+            // Global prefetch buffers
+            using GRBuffA = typename GlobalMapping::GRBuffA;
+            using GRBuffB = typename GlobalMapping::GRBuffB;
+
+            // Mfma buffers
+            using MfmaBuffA   = typename GlobalMapping::MfmaBuffA;
+            using MfmaBuffB   = typename GlobalMapping::MfmaBuffB;
+            using MfmaBuffAcc = typename GlobalMapping::MfmaBuffAcc;
+
+            // Total LDS size required by the pipeline, in elements
+            __device__ constexpr static inline uint32_t sizeLds();
+
+            // Performs fragsAcc += A * B over the full k dimension.
+            // A and B are read in SrcT. If SrcT differs from InputT, the global reads
+            // convert them to InputT in registers, e.g. float32_t to float16_t.
+            // The preTail functor is invoked once before the last K tile is consumed,
+            // which is a good place to issue epilogue loads (e.g. C).
+            // Entry to each pipeline phase is recorded in stamps, which compiles out
+            // unless ROCWMMA_PROFILE_STAMPS is enabled.
+            template <typename SrcT, typename PreTailOp>
+            __device__ static inline void accumulate(MfmaBuffAcc&         fragsAcc,
+                                                     SrcT const*          a,
+                                                     SrcT const*          b,
+                                                     uint32_t             lda,
+                                                     uint32_t             ldb,
+                                                     uint32_t             k,
+                                                     InputT*              ldsPtr,
+                                                     PreTailOp&&          preTail,
+                                                     profile::stamp_ring& stamps);
+
+            template <typename SrcT, typename PreTailOp>
+            __device__ static inline void accumulate(MfmaBuffAcc& fragsAcc,
+                                                     SrcT const*  a,
+                                                     SrcT const*  b,
+                                                     uint32_t     lda,
+                                                     uint32_t     ldb,
+                                                     uint32_t     k,
+                                                     InputT*      ldsPtr,
+                                                     PreTailOp&&  preTail);
+
+            template <typename SrcT>
+            __device__ static inline void accumulate(MfmaBuffAcc& fragsAcc,
+                                                     SrcT const*  a,
+                                                     SrcT const*  b,
+                                                     uint32_t     lda,
+                                                     uint32_t     ldb,
+                                                     uint32_t     k,
+                                                     InputT*      ldsPtr);
+
+        private:
+            // Global reads of one K tile of A and B, converting SrcT to InputT if they differ
+            template <typename SrcT>
+            __device__ static inline void globalReadCoop(GRBuffA&    grBuffA,
+                                                         GRBuffB&    grBuffB,
+                                                         SrcT const* gAddrA,
+                                                         SrcT const* gAddrB,
+                                                         uint32_t    lda,
+                                                         uint32_t    ldb);
+        };
+
+    } // namespace CooperativeGemm
+
+} // namespace rocwmma
+
+#include "gemm_pipeline_impl.hpp"
+
+#endif // GEMM_PIPELINE_HPP
@@ -0,0 +1,372 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GEMM_PIPELINE_IMPL_HPP
+#define GEMM_PIPELINE_IMPL_HPP
+
+#include "gemm_pipeline.hpp"
+
+namespace rocwmma
+{
+    namespace CooperativeGemm
+    {
+
+#define GemmPipelineT                                                                 \
+    typename GemmDriver, typename GlobalMapping, typename LdsMapping, uint32_t Stages, \
+        typename SchedPolicy, int32_t PingPongPriority, uint32_t KUnroll, uint32_t StageSyncWaves
+
+#define GemmPipelineT_impl                                                              \
+    GemmDriver, GlobalMapping, LdsMapping, Stages, SchedPolicy, PingPongPriority, KUnroll, \
+        StageSyncWaves
+
+        template <GemmPipelineT>
+        __device__ constexpr inline uint32_t GemmPipeline<GemmPipelineT_impl>::sizeLds()
+        {
+            auto sizeLds     = LdsMapping::sizeLds();
+            auto sizeBuffers = LdsBuffers * get<0>(sizeLds) * get<1>(sizeLds);
+            if constexpr(StageSync)
+            {
+                return sizeBuffers
+                       + (StageBarrier::size_bytes + sizeof(InputT) - 1u) / sizeof(InputT);
+            }
+            else
+            {
+                return sizeBuffers;
+            }
+        }
+
+        template <GemmPipelineT>
+        template <typename SrcT>
+        __device__ inline void
+            GemmPipeline<GemmPipelineT_impl>::globalReadCoop(GRBuffA&    grBuffA,
+                                                             GRBuffB&    grBuffB,
+                                                             SrcT const* gAddrA,
+                                                             SrcT const* gAddrB,
+                                                             uint32_t    lda,
+                                                             uint32_t    ldb)
+        {
+            if constexpr(is_same_v<SrcT, InputT>)
+            {
+                GemmDriver::globalReadCoopA(grBuffA, gAddrA, lda);
+                GemmDriver::globalReadCoopB(grBuffB, gAddrB, ldb);
+            }
+            else
+            {
+                GemmDriver::globalReadCoopConvertA(grBuffA, gAddrA, lda);
+                GemmDriver::globalReadCoopConvertB(grBuffB, gAddrB, ldb);
+            }
+        }
+
+        template <GemmPipelineT>
+        template <typename SrcT, typename PreTailOp>
+        __device__ inline void
+            GemmPipeline<GemmPipelineT_impl>::accumulate(MfmaBuffAcc&         fragsAcc,
+                                                         SrcT const*          a,
+                                                         SrcT const*          b,
+                                                         uint32_t             lda,
+                                                         uint32_t             ldb,
+                                                         uint32_t             k,
+                                                         InputT*              ldsPtr,
+                                                         PreTailOp&&          preTail,
+                                                         profile::stamp_ring& stamps)
+        {
+            using DataMappingA   = GetDataLayout_t<typename GlobalMapping::MfmaFragA>;
+            using DataMappingB   = GetDataLayout_t<typename GlobalMapping::MfmaFragB>;
+            using DataMappingLds = typename LdsMapping::DataLayout;
+
+            constexpr uint32_t BlockK = GetIOShape_t<typename GlobalMapping::MfmaFragA>::KDim;
+
+            ///
+            /// Setup global addressing offsets in 1D
+            ///
+            auto globalReadOffsetA
+                = DataMappingA::fromMatrixCoord(GlobalMapping::readCoordA(), lda);
+            auto globalReadOffsetB
+                = DataMappingB::fromMatrixCoord(GlobalMapping::readCoordB(), ldb);
+
+            auto kStepOffsetA = DataMappingA::fromMatrixCoord(GlobalMapping::kStepOffsetA(), lda);
+            auto kStepOffsetB = DataMappingB::fromMatrixCoord(GlobalMapping::kStepOffsetB(), ldb);
+
+            ///
+            /// Setup LDS addressing, rotating between 2 LDS blocks
+            ///
+            auto  sizeLds  = LdsMapping::sizeLds();
+            auto* ldsPtrLo = ldsPtr;
+            auto* ldsPtrHi = ldsPtrLo + get<0>(sizeLds) * get<1>(sizeLds);
+
+            auto ldlds = LdsMapping::ldLds();
+            auto ldsWriteOffsetA
+                = DataMappingLds::fromMatrixCoord(LdsMapping::writeCoordA(), ldlds);
+            auto ldsWriteOffsetB
+                = DataMappingLds::fromMatrixCoord(LdsMapping::writeCoordB(), ldlds);
+            auto ldsReadOffsetA = DataMappingLds::fromMatrixCoord(LdsMapping::readCoordA(), ldlds);
+            auto ldsReadOffsetB = DataMappingLds::fromMatrixCoord(LdsMapping::readCoordB(), ldlds);
+
+            auto const kTiles = k / BlockK;
+
+            ///
+            /// Setup the LDS buffer counters, zeroed before any wave arrives on them
+            ///
+            auto* ldsFlags = ldsPtr + LdsBuffers * get<0>(sizeLds) * get<1>(sizeLds);
+
+            [[maybe_unused]] StageBarrier stageBarrier(reinterpret_cast<uint32_t*>(ldsFlags));
+            if constexpr(StageSync)
+            {
+                if(threadIdx.x < Constants::AMDGCN_WAVE_SIZE && threadIdx.y == 0u)
+                {
+                    stageBarrier.reset();
+                }
+                GemmDriver::syncWorkgroup();
+            }
+
+            ///
+            /// Prologue: fill the global prefetch ring
+            ///
+            GRBuffA grBuffsA[PrefetchDepth];
+            GRBuffB grBuffsB[PrefetchDepth];
+
+            stamps.stamp(profile::phase_global_read);
+#pragma unroll
+            for(uint32_t s = 0; s < PrefetchDepth; s++)
+            {
+                if(s < kTiles)
+                {
+                    globalReadCoop(grBuffsA[s],
+                                   grBuffsB[s],
+                                   a + globalReadOffsetA,
+                                   b + globalReadOffsetB,
+                                   lda,
+                                   ldb);
+                    globalReadOffsetA += kStepOffsetA;
+                    globalReadOffsetB += kStepOffsetB;
+                }
+            }
+
+            ///
+            /// Write first K tile to local
+            ///
+            stamps.stamp(profile::phase_local_write);
+            GemmDriver::localWriteCoopA(ldsPtrLo + ldsWriteOffsetA, grBuffsA[0], ldlds);
+            GemmDriver::localWriteCoopB(ldsPtrLo + ldsWriteOffsetB, grBuffsB[0], ldlds);
+
+            ///
+            /// Synchronize waves and memory
+            /// Stage synced waves publish their local writes to the waves reading them.
+            ///
+            if constexpr(StageSync)
+            {
+                stageBarrier.producer_commit(0u);
+            }
+            else
+            {
+                GemmDriver::syncWorkgroup();
+            }
+
+            // Pong waves start one barrier behind the ping waves
+            bool const isPong = PingPong && GemmDriver::isPongWave();
+            if(isPong)
+            {
+                GemmDriver::syncWaves();
+            }
+
+            ///
+            /// Accumulate A * B
+            /// Unrolled by a multiple of the prefetch depth, such that ring slots are static.
+            ///
+            for(uint32_t t0 = 0; t0 < kTiles; t0 += UnrollSteps)
+            {
+#pragma unroll
+                for(uint32_t j = 0; j < UnrollSteps; j++)
+                {
+                    auto const t    = t0 + j;
+                    auto const slot = j % PrefetchDepth;
+                    if(t < kTiles)
+                    {
+                        bool const isTail = (t + 1u == kTiles);
+                        if(isTail)
+                        {
+                            stamps.stamp(profile::phase_epilogue);
+                            preTail();
+                        }
+
+                        MfmaBuffA fragsA;
+                        MfmaBuffB fragsB;
+
+                        // Local read mfma frags, once all waves have written K tile t
+                        if constexpr(StageSync)
+                        {
+                            stageBarrier.consumer_wait(t);
+                        }
+                        stamps.stamp(profile::phase_local_read);
+                        GemmDriver::localReadA(fragsA, ldsPtrLo + ldsReadOffsetA, ldlds);
+                        GemmDriver::localReadB(fragsB, ldsPtrLo + ldsReadOffsetB, ldlds);
+
+                        // The slot is free: its K tile is already in LDS.
+                        // Start fetching K tile (t + PrefetchDepth).
+                        if(t + PrefetchDepth < kTiles)
+                        {
+                            stamps.stamp(profile::phase_global_read);
+                            globalReadCoop(grBuffsA[slot],
+                                           grBuffsB[slot],
+                                           a + globalReadOffsetA,
+                                           b + globalReadOffsetB,
+                                           lda,
+                                           ldb);
+                            globalReadOffsetA += kStepOffsetA;
+                            globalReadOffsetB += kStepOffsetB;
+                        }
+
+                        // Done reading K tile t, after issuing the global reads
+                        if constexpr(StageSync)
+                        {
+                            stageBarrier.consumer_release(t);
+                        }
+
+                        if constexpr(PingPong)
+                        {
+                            if(!isTail)
+                            {
+                                // Write K tile (t + 1) to LDS from the next ring slot
+                                auto const next = (slot + 1u) % PrefetchDepth;
+                                stamps.stamp(profile::phase_local_write);
+                                GemmDriver::localWriteCoopA(
+                                    ldsPtrHi + ldsWriteOffsetA, grBuffsA[next], ldlds);
+                                GemmDriver::localWriteCoopB(
+                                    ldsPtrHi + ldsWriteOffsetB, grBuffsB[next], ldlds);
+                            }
+
+                            // End of the memory phase: the other group starts its mfma
+                            // phase, or its memory phase of the same K step.
+                            GemmDriver::template schedule<SchedPolicy>();
+                            GemmDriver::syncLds();
+
+                            // accum(A * B)
+                            stamps.stamp(profile::phase_mma);
+                            GemmDriver::template prioritize_wavefront<PingPongPriority>();
+                            GemmDriver::mfma(fragsAcc, fragsA, fragsB, fragsAcc);
+                            GemmDriver::template prioritize_wavefront<0>();
+
+                            // End of the mfma phase
+                            GemmDriver::syncWaves();
+
+                            // Rotate Lds buffers
+                            auto* tmp = ldsPtrLo;
+                            ldsPtrLo  = ldsPtrHi;
+                            ldsPtrHi  = tmp;
+                        }
+                        else
+                        {
+                            // accum(A * B)
+                            stamps.stamp(profile::phase_mma);
+                            GemmDriver::mfma(fragsAcc, fragsA, fragsB, fragsAcc);
+
+                            if(!isTail)
+                            {
+                                // Write K tile (t + 1) to LDS from the next ring slot, once all
+                                // waves have read K tile (t - 1) from the same buffer
+                                auto const next = (slot + 1u) % PrefetchDepth;
+                                if constexpr(StageSync)
+                                {
+                                    stageBarrier.producer_acquire(t + 1u);
+                                }
+                                stamps.stamp(profile::phase_local_write);
+                                GemmDriver::localWriteCoopA(
+                                    ldsPtrHi + ldsWriteOffsetA, grBuffsA[next], ldlds);
+                                GemmDriver::localWriteCoopB(
+                                    ldsPtrHi + ldsWriteOffsetB, grBuffsB[next], ldlds);
+
+                                // Shape the schedule of this K step before the barrier closes it
+                                GemmDriver::template schedule<SchedPolicy>();
+
+                                // Make sure that all waves have finished reading / writing to lds.
+                                if constexpr(StageSync)
+                                {
+                                    stageBarrier.producer_commit(t + 1u);
+                                }
+                                else
+                                {
+                                    GemmDriver::syncWorkgroup();
+                                }
+
+                                // Rotate Lds buffers
+                                auto* tmp = ldsPtrLo;
+                                ldsPtrLo  = ldsPtrHi;
+                                ldsPtrHi  = tmp;
+                            }
+                            else
+                            {
+                                GemmDriver::template schedule<SchedPolicy>();
+                            }
+                        }
+                    }
+                }
+            }
+
+            // Ping waves catch up on the barrier the pong waves started with
+            if(PingPong && !isPong)
+            {
+                GemmDriver::syncWaves();
+            }
+        }
+
+        template <GemmPipelineT>
+        template <typename SrcT, typename PreTailOp>
+        __device__ inline void
+            GemmPipeline<GemmPipelineT_impl>::accumulate(MfmaBuffAcc& fragsAcc,
+                                                         SrcT const*  a,
+                                                         SrcT const*  b,
+                                                         uint32_t     lda,
+                                                         uint32_t     ldb,
+                                                         uint32_t     k,
+                                                         InputT*      ldsPtr,
+                                                         PreTailOp&&  preTail)
+        {
+            profile::stamp_ring stamps;
+            accumulate(fragsAcc, a, b, lda, ldb, k, ldsPtr, preTail, stamps);
+            stamps.flush();
+        }
+
+        template <GemmPipelineT>
+        template <typename SrcT>
+        __device__ inline void
+            GemmPipeline<GemmPipelineT_impl>::accumulate(MfmaBuffAcc& fragsAcc,
+                                                         SrcT const*  a,
+                                                         SrcT const*  b,
+                                                         uint32_t     lda,
+                                                         uint32_t     ldb,
+                                                         uint32_t     k,
+                                                         InputT*      ldsPtr)
+        {
+            accumulate(fragsAcc, a, b, lda, ldb, k, ldsPtr, []() {});
+        }
+
+#undef GemmPipelineT
+#undef GemmPipelineT_impl
+
+    } // namespace CooperativeGemm
+
+} // namespace rocwmma
+
+#endif // GEMM_PIPELINE_IMPL_HPP
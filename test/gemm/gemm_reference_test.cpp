@@ -0,0 +1,159 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <chrono>
+#include <iostream>
+#include <tuple>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "common.hpp"
+#include "reference.hpp"
+
+// Checks the blocked CPU reference gemm against the naive triple loop for each
+// Input/Output/Compute type, and times both for CPU validation.
+namespace rocwmma
+{
+    template <typename TestTypes>
+    struct GemmReferenceTest : public ::testing::Test
+    {
+        using InputT   = std::tuple_element_t<0, TestTypes>;
+        using OutputT  = std::tuple_element_t<1, TestTypes>;
+        using ComputeT = std::tuple_element_t<2, TestTypes>;
+
+        struct Result
+        {
+            bool   pass;
+            double maxRelativeError;
+            double blockedMs;
+            double naiveMs;
+        };
+
+        template <typename LayoutA, typename LayoutB, typename LayoutD>
+        static Result run(uint32_t m, uint32_t n, uint32_t k)
+        {
+            std::vector<InputT>  a(m * k);
+            std::vector<InputT>  b(k * n);
+            std::vector<OutputT> c(m * n);
+            std::vector<OutputT> dBlocked(m * n);
+            std::vector<OutputT> dNaive(m * n);
+
+            MatrixUtil<LayoutA>::fill(a, m, k);
+            MatrixUtil<LayoutB>::fill(b, k, n);
+            MatrixUtil<LayoutD>::fill(c, m, n);
+
+            auto alpha = static_cast<ComputeT>(2);
+            auto beta  = static_cast<ComputeT>(2);
+
+            auto timeMs = [](auto&& func) {
+                auto start = std::chrono::steady_clock::now();
+                func();
+                auto stop = std::chrono::steady_clock::now();
+                return std::chrono::duration<double, std::milli>(stop - start).count();
+            };
+
+            auto blockedMs = timeMs([&]() {
+                gemm_CPU<InputT, OutputT, ComputeT, LayoutA, LayoutB, LayoutD, LayoutD>(
+                    m, n, k, a.data(), b.data(), c.data(), dBlocked.data(), alpha, beta);
+            });
+
+            auto naiveMs = timeMs([&]() {
+                gemm_CPU_naive<InputT, OutputT, ComputeT, LayoutA, LayoutB, LayoutD, LayoutD>(
+                    m, n, k, a.data(), b.data(), c.data(), dNaive.data(), alpha, beta);
+            });
+
+            // Accumulation order is the same, so results match up to FMA contraction
+            auto res = compareEqual<OutputT, OutputT, LayoutD, LayoutD>(dBlocked, dNaive, m, n);
+            return {std::get<0>(res), std::get<1>(res), blockedMs, naiveMs};
+        }
+
+        template <typename LayoutA, typename LayoutB, typename LayoutD>
+        static void validate()
+        {
+            // Sizes around the cache blocking, with ragged edges
+            for(auto size : {std::make_tuple(1u, 1u, 1u),
+                             std::make_tuple(67u, 45u, 130u),
+                             std::make_tuple(128u, 192u, 257u)})
+            {
+                auto [m, n, k] = size;
+                auto res       = run<LayoutA, LayoutB, LayoutD>(m, n, k);
+                EXPECT_TRUE(res.pass) << "M, N, K: " << m << ", " << n << ", " << k
+                                      << " Max relative error: " << res.maxRelativeError;
+            }
+        }
+
+        template <typename LayoutA, typename LayoutB>
+        static void benchmark(uint32_t size)
+        {
+            auto res = run<LayoutA, LayoutB, col_major>(size, size, size);
+            EXPECT_TRUE(res.pass) << "Max relative error: " << res.maxRelativeError;
+
+            std::cout << dataTypeToString<InputT>() << ", " << dataTypeToString<OutputT>() << ", "
+                      << dataTypeToString<ComputeT>() << ", " << dataTypeToString<LayoutA>()
+                      << ", " << dataTypeToString<LayoutB>() << ", " << size << ", "
+                      << res.naiveMs << ", " << res.blockedMs << ", "
+                      << res.naiveMs / res.blockedMs << std::endl;
+        }
+    };
+
+    using GemmReferenceTestTypes = ::testing::Types<std::tuple<int8_t, int32_t, int32_t>,
+                                                    std::tuple<float8_t, float32_t, float32_t>,
+                                                    std::tuple<bfloat8_t, float32_t, float32_t>,
+                                                    std::tuple<bfloat16_t, float32_t, float32_t>,
+                                                    std::tuple<float16_t, float32_t, float32_t>,
+                                                    std::tuple<float16_t, float16_t, float16_t>,
+#if !ROCWMMA_TESTS_NO_HALF
+                                                    std::tuple<hfloat16_t, float32_t, float32_t>,
+#endif // !ROCWMMA_TESTS_NO_HALF
+                                                    std::tuple<float32_t, float32_t, float32_t>,
+                                                    std::tuple<xfloat32_t, float32_t, float32_t>,
+                                                    std::tuple<float64_t, float64_t, float64_t>>;
+
+    TYPED_TEST_SUITE(GemmReferenceTest, GemmReferenceTestTypes);
+
+    TYPED_TEST(GemmReferenceTest, Validate)
+    {
+        TestFixture::template validate<row_major, row_major, row_major>();
+        TestFixture::template validate<row_major, col_major, col_major>();
+        TestFixture::template validate<col_major, row_major, row_major>();
+        TestFixture::template validate<col_major, col_major, col_major>();
+    }
+
+    TYPED_TEST(GemmReferenceTest, Benchmark)
+    {
+        constexpr uint32_t size = 512u;
+
+        std::cout << "InputT, OutputT, ComputeT, LayoutA, LayoutB, M=N=K, NaiveMs, BlockedMs, "
+                     "Speedup"
+                  << std::endl;
+        TestFixture::template benchmark<row_major, row_major>(size);
+        TestFixture::template benchmark<row_major, col_major>(size);
+        TestFixture::template benchmark<col_major, row_major>(size);
+        TestFixture::template benchmark<col_major, col_major>(size);
+    }
+
+} // namespace rocwmma
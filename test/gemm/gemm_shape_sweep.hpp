@@ -0,0 +1,97 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef ROCWMMA_GEMM_SHAPE_SWEEP_HPP
+#define ROCWMMA_GEMM_SHAPE_SWEEP_HPP
+
+#include <set>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "hip_device.hpp"
+
+namespace rocwmma
+{
+    // Problem shapes and thread blocks of the shape sweep benchmarks, shared by all
+    // kernel families so that their results line up shape for shape.
+    // The sweep problem type is f16 inputs, f32 outputs and compute, NT layouts.
+    struct GemmShapeSweep
+    {
+        using ThreadBlockT = std::pair<int64_t, int64_t>;
+        using ProblemSizeT = std::tuple<int64_t, int64_t, int64_t>;
+
+        // Log grid: M, N in 256 ... 8192 and K in 512, 2048, 8192, spaced by powers of 2.
+        // The 2x spacing matches the nearest shape lookup of GemmDispatcher, so the winners
+        // of the log grid cover every shape within the grid bounds.
+        // Linear grid: M, N or K in 1024 ... 8192 in steps of 1024, the other two at 4096,
+        // to resolve crossovers between the log grid points of large problems.
+        static inline std::vector<ProblemSizeT> problemSizes()
+        {
+            std::set<ProblemSizeT> result;
+
+            for(int64_t m = 256; m <= 8192; m *= 2)
+            {
+                for(int64_t n = 256; n <= 8192; n *= 2)
+                {
+                    for(int64_t k = 512; k <= 8192; k *= 4)
+                    {
+                        result.insert({m, n, k});
+                    }
+                }
+            }
+
+            for(int64_t d = 1024; d <= 8192; d += 1024)
+            {
+                result.insert({d, 4096, 4096});
+                result.insert({4096, d, 4096});
+                result.insert({4096, 4096, d});
+            }
+
+            return std::vector<ProblemSizeT>(result.begin(), result.end());
+        }
+
+        static inline std::vector<ThreadBlockT> threadBlocks()
+        {
+            auto warpSize = HipDevice::instance()->warpSize();
+
+            // 4 wave workgroups
+            std::vector<ThreadBlockT> result
+                = {{warpSize, 4}, {warpSize * 2, 2}, {warpSize * 4, 1}};
+
+            // Wave32 targets (gfx11, gfx12) also fit 8 wave workgroups in 256 threads
+            if(warpSize == Constants::AMDGCN_WAVE_SIZE_32)
+            {
+                result.insert(result.end(), {{warpSize * 2, 4}, {warpSize * 4, 2}});
+            }
+
+            return result;
+        }
+    };
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_GEMM_SHAPE_SWEEP_HPP
@@ -31,6 +31,8 @@
 
 #include "gemm_common_test_params.hpp"
 #include "gemm_kernel_base.hpp"
+#include "gemm_tuning_table.hpp"
+#include "perf_golden.hpp"
 #include "rocwmma_logging.hpp"
 
 namespace rocwmma
@@ -119,6 +121,12 @@ namespace rocwmma
             {
                 KernelI::sHeaderPrinted = true;
             }
+
+            // Structured record for -bo || --bench_output and baseline compare
+            BenchmarkLog::instance()->record(kernel->benchmarkRecord());
+
+            // Throughput against golden with -pg || --perf_golden
+            expectPerfGolden();
         }
 
         virtual void RunKernelWithoutWarmup()
@@ -157,6 +165,43 @@ namespace rocwmma
             {
                 KernelI::sHeaderPrinted = true;
             }
+
+            // Structured record for -bo || --bench_output and baseline compare
+            BenchmarkLog::instance()->record(kernel->benchmarkRecord());
+
+            // Throughput against golden with -pg || --perf_golden
+            expectPerfGolden();
+        }
+
+        // Benchmarks the kernel, then records it in the tuning table if it is the
+        // fastest for its problem so far. The table is saved after each update
+        // when a tuning table file is given with -tt || --tuning_table.
+        virtual void RunTuning()
+        {
+            RunKernel();
+
+            auto param  = Base::GetParam();
+            auto kernel = std::get<0>(param);
+
+            using Options        = rocwmma::RocwmmaLogging;
+            auto& loggingOptions = Options::instance();
+            auto& tuningTable    = GemmTuningTable::instance();
+            auto& tuningFile     = loggingOptions->tuningTableFile();
+
+            // Merge with previous tuning results
+            static bool loadedTable = false;
+            if(!loadedTable && !tuningFile.empty())
+            {
+                tuningTable->load(tuningFile);
+                loadedTable = true;
+            }
+
+            tuningTable->update(kernel->tuningEntry());
+
+            if(!tuningFile.empty() && !tuningTable->save(tuningFile))
+            {
+                std::cerr << "Unable to save tuning table: " << tuningFile << std::endl;
+            }
         }
 
         void TearDown() override
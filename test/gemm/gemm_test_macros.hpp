@@ -137,4 +137,23 @@
                                     ROCWMMA_GEMM_GTEST_PARAM_TRIAGE, \
                                     test_params)
 
+///
+/// Specific to GEMM gtest interface of rocwmma::GemmTest
+/// @params
+/// test_suite_prefix = used as the general test context (e.g. gemm_kernel_tests)
+/// test_suite_name = specific test context (e.g. gemm_my_kernel_autotune)
+/// test_params = the object generated by ROCWMMA_GENERATE_GEMM_GTEST_SUITE_PARAMS
+/// Note: The rocwmma::GemmTest interface is paired here explicitly with the
+/// ROCWMMA_GEMM_GTEST_PARAM_TRIAGE macro to ensure matching of gtest parameters.
+/// Invokes the RunTuning() function in rocwmma::GemmTest object.
+///
+#define ROCWMMA_INSTANTIATE_GEMM_GTEST_TUNING_SUITE(                 \
+    test_suite_prefix, test_suite_name, test_params)                 \
+    ROCWMMA_INSTANTIATE_GTEST_SUITE(test_suite_prefix,               \
+                                    test_suite_name,                 \
+                                    rocwmma::GemmTest,               \
+                                    RunTuning,                       \
+                                    ROCWMMA_GEMM_GTEST_PARAM_TRIAGE, \
+                                    test_params)
+
 #endif // ROCWMMA_GEMM_TEST_MACROS_HPP
@@ -0,0 +1,382 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef ROCWMMA_GEMM_TUNING_DB_HPP
+#define ROCWMMA_GEMM_TUNING_DB_HPP
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "singleton.hpp"
+
+namespace rocwmma
+{
+    // Binary tuning database, compiled from GemmTuningTable csv files by
+    // test/bin/GemmTuningDb.py and memory-mapped read-only at load.
+    // Lookups hash into a bucket index, do not allocate and do not parse text.
+    //
+    // Layout, little endian and 4B aligned:
+    // Header, Slot[slotCount], Entry[entryCount], null-terminated strings.
+    // Entries are grouped by bucket: (arch, problem type, floor(log2) of M, N and K).
+    // Each bucket owns one slot of an open addressing table, keyed by the FNV-1a hash of
+    // the bucket and probed linearly for at most maxProbe slots.
+    class GemmTuningDb : public LazySingleton<GemmTuningDb>
+    {
+    public:
+        static constexpr char     Magic[8] = {'R', 'W', 'T', 'U', 'N', 'E', 'D', 'B'};
+        static constexpr uint32_t Version  = 1u;
+
+        struct Header
+        {
+            char     mMagic[8];
+            uint32_t mVersion;
+            uint32_t mEntryCount;
+            uint32_t mSlotCount; // Power of 2
+            uint32_t mMaxProbe;
+            uint32_t mSlotsOffset;
+            uint32_t mEntriesOffset;
+            uint32_t mStringsOffset;
+            uint32_t mStringsBytes;
+        };
+
+        struct Slot
+        {
+            uint64_t mKey; // 0 for empty slots
+            uint32_t mFirst, mCount;
+        };
+
+        // String fields are offsets into the string table
+        struct Entry
+        {
+            uint32_t mArch;
+            uint32_t mProblemType;
+            uint32_t mM, mN, mK;
+            uint32_t mKernelConfig;
+            uint32_t mTBlockX, mTBlockY;
+            float    mTFlopsPerSec;
+        };
+
+        static_assert(sizeof(Header) == 40u && sizeof(Slot) == 16u && sizeof(Entry) == 36u,
+                      "Tuning db layout must match test/bin/GemmTuningDb.py");
+
+        GemmTuningDb()
+            : mData(nullptr)
+            , mBytes(0u)
+            , mHeader(nullptr)
+            , mSlots(nullptr)
+            , mEntries(nullptr)
+            , mStrings(nullptr)
+        {
+        }
+
+        ~GemmTuningDb()
+        {
+            close();
+        }
+
+        GemmTuningDb(GemmTuningDb const&)            = delete;
+        GemmTuningDb& operator=(GemmTuningDb const&) = delete;
+
+        // Tuning db files are told apart from csv tuning tables by the .tdb extension
+        static bool isDbFile(std::string const& fileName)
+        {
+            return fileName.size() >= 4
+                   && fileName.compare(fileName.size() - 4, 4, ".tdb") == 0;
+        }
+
+        // Maps the file and validates its layout.
+        // Returns false if the file can't be mapped or is not a tuning db of this version.
+        bool open(std::string const& fileName)
+        {
+            close();
+
+            auto fd = ::open(fileName.c_str(), O_RDONLY);
+            if(fd < 0)
+            {
+                return false;
+            }
+
+            struct stat fileStat;
+            if(fstat(fd, &fileStat) == 0 && fileStat.st_size >= off_t(sizeof(Header)))
+            {
+                mBytes = static_cast<size_t>(fileStat.st_size);
+                mData  = mmap(nullptr, mBytes, PROT_READ, MAP_PRIVATE, fd, 0);
+                if(mData == MAP_FAILED)
+                {
+                    mData = nullptr;
+                }
+            }
+            ::close(fd);
+
+            if(mData == nullptr || !validate())
+            {
+                close();
+                return false;
+            }
+            return true;
+        }
+
+        void close()
+        {
+            if(mData != nullptr)
+            {
+                munmap(mData, mBytes);
+            }
+            mData    = nullptr;
+            mBytes   = 0u;
+            mHeader  = nullptr;
+            mSlots   = nullptr;
+            mEntries = nullptr;
+            mStrings = nullptr;
+        }
+
+        bool isOpen() const
+        {
+            return mHeader != nullptr;
+        }
+
+        uint32_t size() const
+        {
+            return isOpen() ? mHeader->mEntryCount : 0u;
+        }
+
+        char const* string(uint32_t offset) const
+        {
+            return mStrings + offset;
+        }
+
+        // Exact shape lookup. Returns nullptr if the shape has not been tuned.
+        Entry const* find(uint32_t           arch,
+                          std::string const& problemType,
+                          uint32_t           m,
+                          uint32_t           n,
+                          uint32_t           k) const
+        {
+            Entry const* result = nullptr;
+            forBucket(arch, problemType, log2(m), log2(n), log2(k), [&](Entry const& entry) {
+                if(entry.mM == m && entry.mN == n && entry.mK == k)
+                {
+                    result = &entry;
+                }
+            });
+            return result;
+        }
+
+        // Nearest tuned shape within 2x of each dimension, by log distance, over the
+        // entries that accept() takes. These are in the bucket of the shape or one of
+        // its 26 neighbours, so at most 27 probes are made.
+        template <typename AcceptT>
+        Entry const* findNearest(uint32_t           arch,
+                                 std::string const& problemType,
+                                 uint32_t           m,
+                                 uint32_t           n,
+                                 uint32_t           k,
+                                 AcceptT&&          accept) const
+        {
+            auto logRatio = [](uint32_t lhs, uint32_t rhs) {
+                return std::fabs(std::log2(double(lhs) / double(rhs)));
+            };
+
+            auto         bestDistance = 0.0;
+            Entry const* nearest      = nullptr;
+            auto         visit        = [&](Entry const& entry) {
+                auto dm = logRatio(m, entry.mM);
+                auto dn = logRatio(n, entry.mN);
+                auto dk = logRatio(k, entry.mK);
+                if(dm > 1.0 || dn > 1.0 || dk > 1.0)
+                {
+                    return;
+                }
+
+                auto distance = dm + dn + dk;
+                if((nearest == nullptr || distance < bestDistance) && accept(entry))
+                {
+                    nearest      = &entry;
+                    bestDistance = distance;
+                }
+            };
+
+            auto bm = log2(m), bn = log2(n), bk = log2(k);
+            for(auto im = bm > 0u ? bm - 1u : 0u; im <= bm + 1u; im++)
+            {
+                for(auto in = bn > 0u ? bn - 1u : 0u; in <= bn + 1u; in++)
+                {
+                    for(auto ik = bk > 0u ? bk - 1u : 0u; ik <= bk + 1u; ik++)
+                    {
+                        forBucket(arch, problemType, im, in, ik, visit);
+                    }
+                }
+            }
+            return nearest;
+        }
+
+        // FNV-1a over the arch (4B little endian), the problem type, a null byte and
+        // the M, N and K buckets (1B each). Never 0, which marks empty slots.
+        static uint64_t bucketKey(
+            uint32_t arch, std::string const& problemType, uint32_t bm, uint32_t bn, uint32_t bk)
+        {
+            uint64_t hash = 0xcbf29ce484222325ull;
+            auto     mix  = [&hash](uint8_t byte) {
+                hash ^= byte;
+                hash *= 0x100000001b3ull;
+            };
+
+            for(uint32_t i = 0u; i < 4u; i++)
+            {
+                mix(static_cast<uint8_t>(arch >> (8u * i)));
+            }
+            for(auto c : problemType)
+            {
+                mix(static_cast<uint8_t>(c));
+            }
+            mix(0u);
+            mix(static_cast<uint8_t>(bm));
+            mix(static_cast<uint8_t>(bn));
+            mix(static_cast<uint8_t>(bk));
+            return hash == 0u ? 1u : hash;
+        }
+
+        // Bucket of a dimension: floor(log2), 0 for 0
+        static uint32_t log2(uint32_t value)
+        {
+            uint32_t result = 0u;
+            while(value >>= 1u)
+            {
+                result++;
+            }
+            return result;
+        }
+
+    private:
+        template <typename VisitT>
+        void forBucket(uint32_t           arch,
+                       std::string const& problemType,
+                       uint32_t           bm,
+                       uint32_t           bn,
+                       uint32_t           bk,
+                       VisitT&&           visit) const
+        {
+            if(!isOpen())
+            {
+                return;
+            }
+
+            auto key  = bucketKey(arch, problemType, bm, bn, bk);
+            auto mask = mHeader->mSlotCount - 1u;
+            for(uint32_t probe = 0u; probe < mHeader->mMaxProbe; probe++)
+            {
+                auto const& slot = mSlots[(key + probe) & mask];
+                if(slot.mKey == 0u)
+                {
+                    return;
+                }
+                if(slot.mKey != key)
+                {
+                    continue;
+                }
+
+                // Entries of a hash collision are told apart by their fields
+                for(auto i = slot.mFirst; i < slot.mFirst + slot.mCount; i++)
+                {
+                    auto const& entry = mEntries[i];
+                    if(entry.mArch == arch && problemType == string(entry.mProblemType)
+                       && log2(entry.mM) == bm && log2(entry.mN) == bn && log2(entry.mK) == bk)
+                    {
+                        visit(entry);
+                    }
+                }
+                return;
+            }
+        }
+
+        // Checks that all sections, slot ranges and string offsets are within the file
+        bool validate()
+        {
+            auto base   = static_cast<char const*>(mData);
+            auto header = reinterpret_cast<Header const*>(base);
+            if(std::memcmp(header->mMagic, Magic, sizeof(Magic)) != 0
+               || header->mVersion != Version || header->mSlotCount == 0u
+               || (header->mSlotCount & (header->mSlotCount - 1u)) != 0u
+               || header->mMaxProbe > header->mSlotCount)
+            {
+                return false;
+            }
+
+            auto within = [this](uint64_t offset, uint64_t bytes) {
+                return offset % 4u == 0u && offset + bytes <= mBytes;
+            };
+            if(!within(header->mSlotsOffset, uint64_t(header->mSlotCount) * sizeof(Slot))
+               || !within(header->mEntriesOffset, uint64_t(header->mEntryCount) * sizeof(Entry))
+               || !within(header->mStringsOffset, header->mStringsBytes)
+               || header->mStringsBytes == 0u
+               || base[header->mStringsOffset + header->mStringsBytes - 1u] != '\0')
+            {
+                return false;
+            }
+
+            auto slots   = reinterpret_cast<Slot const*>(base + header->mSlotsOffset);
+            auto entries = reinterpret_cast<Entry const*>(base + header->mEntriesOffset);
+            for(uint32_t i = 0u; i < header->mSlotCount; i++)
+            {
+                if(uint64_t(slots[i].mFirst) + slots[i].mCount > header->mEntryCount)
+                {
+                    return false;
+                }
+            }
+            for(uint32_t i = 0u; i < header->mEntryCount; i++)
+            {
+                if(entries[i].mProblemType >= header->mStringsBytes
+                   || entries[i].mKernelConfig >= header->mStringsBytes)
+                {
+                    return false;
+                }
+            }
+
+            mHeader  = header;
+            mSlots   = slots;
+            mEntries = entries;
+            mStrings = base + header->mStringsOffset;
+            return true;
+        }
+
+        void*         mData;
+        size_t        mBytes;
+        Header const* mHeader;
+        Slot const*   mSlots;
+        Entry const*  mEntries;
+        char const*   mStrings;
+    };
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_GEMM_TUNING_DB_HPP
@@ -0,0 +1,193 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef ROCWMMA_GEMM_TUNING_TABLE_HPP
+#define ROCWMMA_GEMM_TUNING_TABLE_HPP
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "singleton.hpp"
+
+namespace rocwmma
+{
+    // Benchmark result of one kernel configuration on one problem shape.
+    // ProblemType identifies what is computed (data types and layouts), while
+    // KernelConfig identifies how (kernel family and compile-time tiling).
+    struct GemmTuningEntry
+    {
+        uint32_t    mArch;
+        std::string mProblemType;
+        uint32_t    mM, mN, mK;
+        std::string mKernelConfig;
+        uint32_t    mTBlockX, mTBlockY;
+        double      mTFlopsPerSec;
+    };
+
+    // Shape -> best kernel configuration lookup table.
+    // Tables are stored as csv, one entry per line:
+    // Arch, ProblemType, MatM, MatN, MatK, KernelConfig, TBlkX, TBlkY, TFlops/s
+    class GemmTuningTable : public LazySingleton<GemmTuningTable>
+    {
+    public:
+        // Keeps the fastest entry per (arch, problem type, shape).
+        // Entries of kernels that did not run or failed validation report 0 TFlops/s
+        // and are ignored.
+        void update(GemmTuningEntry const& entry)
+        {
+            if(entry.mTFlopsPerSec <= 0.0)
+            {
+                return;
+            }
+
+            auto it = std::find_if(mEntries.begin(), mEntries.end(), [&entry](auto const& e) {
+                return matches(e, entry.mArch, entry.mProblemType, entry.mM, entry.mN, entry.mK);
+            });
+            if(it == mEntries.end())
+            {
+                mEntries.push_back(entry);
+            }
+            else if(entry.mTFlopsPerSec > it->mTFlopsPerSec)
+            {
+                *it = entry;
+            }
+        }
+
+        // Exact shape lookup. Returns nullptr if the shape has not been tuned.
+        GemmTuningEntry const* find(uint32_t           arch,
+                                    std::string const& problemType,
+                                    uint32_t           m,
+                                    uint32_t           n,
+                                    uint32_t           k) const
+        {
+            auto it = std::find_if(mEntries.begin(), mEntries.end(), [&](auto const& e) {
+                return matches(e, arch, problemType, m, n, k);
+            });
+            return it == mEntries.end() ? nullptr : &(*it);
+        }
+
+        std::vector<GemmTuningEntry> const& entries() const
+        {
+            return mEntries;
+        }
+
+        void clear()
+        {
+            mEntries.clear();
+        }
+
+        std::ostream& write(std::ostream& stream) const
+        {
+            stream << "# Arch, ProblemType, MatM, MatN, MatK, KernelConfig, TBlkX, TBlkY, TFlops/s"
+                   << std::endl;
+            for(auto const& entry : mEntries)
+            {
+                stream << "gfx" << std::hex << entry.mArch << std::dec << ", "
+                       << entry.mProblemType << ", " << entry.mM << ", " << entry.mN << ", "
+                       << entry.mK << ", " << entry.mKernelConfig << ", " << entry.mTBlockX
+                       << ", " << entry.mTBlockY << ", " << entry.mTFlopsPerSec << std::endl;
+            }
+            return stream;
+        }
+
+        // Merges the entries of the stream into the table.
+        // Returns false on malformed lines.
+        bool read(std::istream& stream)
+        {
+            std::string line;
+            while(std::getline(stream, line))
+            {
+                if(line.empty() || line[0] == '#')
+                {
+                    continue;
+                }
+
+                std::vector<std::string> fields;
+                std::stringstream        lineStream(line);
+                std::string              field;
+                while(std::getline(lineStream, field, ','))
+                {
+                    auto first = field.find_first_not_of(' ');
+                    auto last  = field.find_last_not_of(' ');
+                    fields.push_back(first == std::string::npos
+                                         ? ""
+                                         : field.substr(first, last - first + 1));
+                }
+
+                if(fields.size() != 9 || fields[0].compare(0, 3, "gfx") != 0)
+                {
+                    return false;
+                }
+
+                GemmTuningEntry entry;
+                entry.mArch         = std::stoul(fields[0].substr(3), nullptr, 16);
+                entry.mProblemType  = fields[1];
+                entry.mM            = std::stoul(fields[2]);
+                entry.mN            = std::stoul(fields[3]);
+                entry.mK            = std::stoul(fields[4]);
+                entry.mKernelConfig = fields[5];
+                entry.mTBlockX      = std::stoul(fields[6]);
+                entry.mTBlockY      = std::stoul(fields[7]);
+                entry.mTFlopsPerSec = std::stod(fields[8]);
+                update(entry);
+            }
+            return true;
+        }
+
+        bool save(std::string const& fileName) const
+        {
+            std::ofstream file(fileName);
+            return file.is_open() && write(file).good();
+        }
+
+        bool load(std::string const& fileName)
+        {
+            std::ifstream file(fileName);
+            return file.is_open() && read(file);
+        }
+
+    private:
+        static bool matches(GemmTuningEntry const& entry,
+                            uint32_t               arch,
+                            std::string const&     problemType,
+                            uint32_t               m,
+                            uint32_t               n,
+                            uint32_t               k)
+        {
+            return entry.mArch == arch && entry.mProblemType == problemType && entry.mM == m
+                   && entry.mN == n && entry.mK == k;
+        }
+
+        std::vector<GemmTuningEntry> mEntries;
+    };
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_GEMM_TUNING_TABLE_HPP
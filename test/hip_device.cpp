@@ -24,6 +24,8 @@
  *
  *******************************************************************************/
 
+#include <rocwmma/rocwmma_dispatch.hpp>
+
 #include "hip_device.hpp"
 #include "common.hpp"
 
@@ -37,54 +39,16 @@ namespace rocwmma
         , mCuCount(0)
         , mMaxFreqMhz(0)
         , mCurFreqMhz(0)
+        , mMemFreqMhz(0)
+        , mMemBusWidth(0)
+        , mSmiDeviceIndex(std::numeric_limits<uint32_t>::max())
     {
         CHECK_HIP_ERROR(hipGetDevice(&mHandle));
         CHECK_HIP_ERROR(hipGetDeviceProperties(&mProps, mHandle));
 
         mArch = mProps.arch;
 
-        std::string deviceName(mProps.gcnArchName);
-
-        if(deviceName.find("gfx908") != std::string::npos)
-        {
-            mGcnArch = hipGcnArch_t::GFX908;
-        }
-        else if(deviceName.find("gfx90a") != std::string::npos)
-        {
-            mGcnArch = hipGcnArch_t::GFX90A;
-        }
-        else if(deviceName.find("gfx940") != std::string::npos)
-        {
-            mGcnArch = hipGcnArch_t::GFX940;
-        }
-        else if(deviceName.find("gfx941") != std::string::npos)
-        {
-            mGcnArch = hipGcnArch_t::GFX941;
-        }
-        else if(deviceName.find("gfx942") != std::string::npos)
-        {
-            mGcnArch = hipGcnArch_t::GFX942;
-        }
-        else if(deviceName.find("gfx1100") != std::string::npos)
-        {
-            mGcnArch = hipGcnArch_t::GFX1100;
-        }
-        else if(deviceName.find("gfx1101") != std::string::npos)
-        {
-            mGcnArch = hipGcnArch_t::GFX1101;
-        }
-        else if(deviceName.find("gfx1102") != std::string::npos)
-        {
-            mGcnArch = hipGcnArch_t::GFX1102;
-        }
-        else if(deviceName.find("gfx1200") != std::string::npos)
-        {
-            mGcnArch = hipGcnArch_t::GFX1200;
-        }
-        else if(deviceName.find("gfx1201") != std::string::npos)
-        {
-            mGcnArch = hipGcnArch_t::GFX1201;
-        }
+        mGcnArch = static_cast<hipGcnArch_t>(arch_id_from_name(mProps.gcnArchName));
 
         switch(mProps.warpSize)
         {
@@ -98,6 +62,8 @@ namespace rocwmma
         mCuCount       = mProps.multiProcessorCount;
         mMaxFreqMhz    = static_cast<int>(static_cast<double>(mProps.clockRate) / 1000.0);
         mCurFreqMhz    = mMaxFreqMhz;
+        mMemFreqMhz    = static_cast<int>(static_cast<double>(mProps.memoryClockRate) / 1000.0);
+        mMemBusWidth   = mProps.memoryBusWidth;
 
 #if ROCWMMA_BENCHMARK_TESTS
         bool smiErrorFlag = false;
@@ -113,7 +79,6 @@ namespace rocwmma
             CHECK_RSMI_ERROR(rsmi_num_monitor_devices(&smiCount), smiErrorFlag);
             if(!smiErrorFlag)
             {
-                uint32_t smiDeviceIndex = std::numeric_limits<uint32_t>::max();
                 for(uint32_t smiIndex = 0; smiIndex < smiCount; smiIndex++)
                 {
                     uint64_t rsmiPCIID = 0;
@@ -124,16 +89,16 @@ namespace rocwmma
                     }
                     else if(hipPCIID == rsmiPCIID)
                     {
-                        smiDeviceIndex = smiIndex;
+                        mSmiDeviceIndex = smiIndex;
                         break;
                     }
                 }
 
-                if(!smiErrorFlag && (smiDeviceIndex != std::numeric_limits<uint32_t>::max()))
+                if(!smiErrorFlag && (mSmiDeviceIndex != std::numeric_limits<uint32_t>::max()))
                 {
                     rsmi_frequencies_t freq;
                     CHECK_RSMI_ERROR(
-                        rsmi_dev_gpu_clk_freq_get(smiDeviceIndex, RSMI_CLK_TYPE_SYS, &freq),
+                        rsmi_dev_gpu_clk_freq_get(mSmiDeviceIndex, RSMI_CLK_TYPE_SYS, &freq),
                         smiErrorFlag);
                     if(!smiErrorFlag)
                     {
@@ -190,6 +155,40 @@ namespace rocwmma
         return mCurFreqMhz;
     }
 
+    int HipDevice::memFreqMhz() const
+    {
+        return mMemFreqMhz;
+    }
+
+    int HipDevice::memBusWidth() const
+    {
+        return mMemBusWidth;
+    }
+
+    double HipDevice::peakGBytesPerSec() const
+    {
+        return calculatePeakGBytesPerSec(mMemFreqMhz, mMemBusWidth);
+    }
+
+    bool HipDevice::energyJoules(double& joules) const
+    {
+#if ROCWMMA_BENCHMARK_TESTS
+        if(mSmiDeviceIndex != std::numeric_limits<uint32_t>::max())
+        {
+            uint64_t count      = 0;
+            float    resolution = 0.0f; // Microjoules per count
+            uint64_t timestamp  = 0;
+            if(rsmi_dev_energy_count_get(mSmiDeviceIndex, &count, &resolution, &timestamp)
+               == RSMI_STATUS_SUCCESS)
+            {
+                joules = static_cast<double>(count) * static_cast<double>(resolution) * 1.0e-6;
+                return true;
+            }
+        }
+#endif // ROCWMMA_BENCHMARK_TESTS
+        return false;
+    }
+
     HipDevice::~HipDevice()
     {
 #if ROCWMMA_BENCHMARK_TESTS
@@ -80,10 +80,22 @@ namespace rocwmma
         int cuCount() const;
         int maxFreqMhz() const;
         int curFreqMhz() const;
+        int memFreqMhz() const;
+        int memBusWidth() const;
 
         template <typename InputT>
         double peakGFlopsPerSec() const;
 
+        double peakGBytesPerSec() const;
+
+        // Reads the accumulated energy counter of the board through rocm-smi.
+        // Returns false if the counter is unavailable, e.g. outside of benchmark tests.
+        bool energyJoules(double& joules) const;
+
+        // Attainable GFlops/s for the given arithmetic intensity (flops per byte)
+        template <typename InputT>
+        double rooflineGFlopsPerSec(double flopsPerByte) const;
+
         ~HipDevice();
 
     private:
@@ -96,6 +108,9 @@ namespace rocwmma
         int             mCuCount;
         int             mMaxFreqMhz;
         int             mCurFreqMhz;
+        int             mMemFreqMhz;
+        int             mMemBusWidth;
+        uint32_t        mSmiDeviceIndex;
     };
 
     template <typename InputT>
@@ -112,11 +127,35 @@ namespace rocwmma
             result = calculatePeakGFlopsPerSec<InputT, ArchGfx90a>(mCurFreqMhz, mCuCount);
             break;
 
+        case hipGcnArch_t::GFX940:
+        case hipGcnArch_t::GFX941:
+        case hipGcnArch_t::GFX942:
+            result = calculatePeakGFlopsPerSec<InputT, ArchGfx940>(mCurFreqMhz, mCuCount);
+            break;
+
+        case hipGcnArch_t::GFX1100:
+        case hipGcnArch_t::GFX1101:
+        case hipGcnArch_t::GFX1102:
+            result = calculatePeakGFlopsPerSec<InputT, ArchGfx11>(mCurFreqMhz, mCuCount);
+            break;
+
+        case hipGcnArch_t::GFX1200:
+        case hipGcnArch_t::GFX1201:
+            result = calculatePeakGFlopsPerSec<InputT, ArchGfx12>(mCurFreqMhz, mCuCount);
+            break;
+
         default:
             result = calculatePeakGFlopsPerSec<InputT>(mCurFreqMhz, mCuCount);
         }
         return result;
     }
+
+    template <typename InputT>
+    double HipDevice::rooflineGFlopsPerSec(double flopsPerByte) const
+    {
+        return calculateRooflineGFlopsPerSec(
+            peakGFlopsPerSec<InputT>(), peakGBytesPerSec(), flopsPerByte);
+    }
 } // namespace rocwmma
 
 #endif // ROCWMMA_TEST_HIP_DEVICE_HPP
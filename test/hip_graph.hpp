@@ -0,0 +1,130 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef ROCWMMA_TEST_HIP_GRAPH_HPP
+#define ROCWMMA_TEST_HIP_GRAPH_HPP
+
+#include <functional>
+
+#include <hip/hip_runtime_api.h>
+
+#include "common.hpp"
+
+namespace rocwmma
+{
+    // Captures the work enqueued by a launch function into a hipGraph once,
+    // then replays all of it with a single hipGraphLaunch per invocation.
+    // The launch function must only enqueue onto the given stream: host
+    // synchronization is not allowed while capturing.
+    class HipGraphLauncher
+    {
+    public:
+        using LaunchFunc = std::function<void(hipStream_t)>;
+
+        HipGraphLauncher()
+            : mStream(nullptr)
+            , mGraph(nullptr)
+            , mGraphExec(nullptr)
+        {
+            CHECK_HIP_ERROR(hipStreamCreateWithFlags(&mStream, hipStreamNonBlocking));
+        }
+
+        ~HipGraphLauncher()
+        {
+            reset();
+            CHECK_HIP_ERROR(hipStreamDestroy(mStream));
+        }
+
+        HipGraphLauncher(HipGraphLauncher const&)            = delete;
+        HipGraphLauncher& operator=(HipGraphLauncher const&) = delete;
+
+        void capture(LaunchFunc const& launchFunc)
+        {
+            reset();
+            CHECK_HIP_ERROR(hipStreamBeginCapture(mStream, hipStreamCaptureModeThreadLocal));
+            launchFunc(mStream);
+            CHECK_HIP_ERROR(hipStreamEndCapture(mStream, &mGraph));
+            CHECK_HIP_ERROR(hipGraphInstantiate(&mGraphExec, mGraph, nullptr, nullptr, 0));
+        }
+
+        void launch()
+        {
+            CHECK_HIP_ERROR(hipGraphLaunch(mGraphExec, mStream));
+        }
+
+        hipStream_t stream() const
+        {
+            return mStream;
+        }
+
+        void reset()
+        {
+            if(mGraphExec)
+            {
+                CHECK_HIP_ERROR(hipGraphExecDestroy(mGraphExec));
+                mGraphExec = nullptr;
+            }
+            if(mGraph)
+            {
+                CHECK_HIP_ERROR(hipGraphDestroy(mGraph));
+                mGraph = nullptr;
+            }
+        }
+
+    private:
+        hipStream_t    mStream;
+        hipGraph_t     mGraph;
+        hipGraphExec_t mGraphExec;
+    };
+
+    // Total elapsed time of back-to-back runs on a stream, including any
+    // host launch gaps between them.
+    template <typename LaunchT>
+    inline float64_t timeBackToBackMs(LaunchT&& launch, hipStream_t stream, uint32_t runs)
+    {
+        hipEvent_t startEvent, stopEvent;
+        CHECK_HIP_ERROR(hipEventCreate(&startEvent));
+        CHECK_HIP_ERROR(hipEventCreate(&stopEvent));
+
+        CHECK_HIP_ERROR(hipEventRecord(startEvent, stream));
+        for(uint32_t i = 0; i < runs; ++i)
+        {
+            launch();
+        }
+        CHECK_HIP_ERROR(hipEventRecord(stopEvent, stream));
+        CHECK_HIP_ERROR(hipEventSynchronize(stopEvent));
+
+        auto timeMs = 0.0f;
+        CHECK_HIP_ERROR(hipEventElapsedTime(&timeMs, startEvent, stopEvent));
+        CHECK_HIP_ERROR(hipEventDestroy(startEvent));
+        CHECK_HIP_ERROR(hipEventDestroy(stopEvent));
+
+        return static_cast<float64_t>(timeMs);
+    }
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_TEST_HIP_GRAPH_HPP
@@ -0,0 +1,197 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <limits>
+
+#include "common.hpp"
+#include "hip_memory_pool.hpp"
+
+namespace rocwmma
+{
+    HipMemoryPool::HipMemoryPool()
+        : mStreamOrdered(false)
+        , mDevicePool(nullptr)
+        , mStats({0u, 0u, 0u, 0u})
+    {
+        int device;
+        CHECK_HIP_ERROR(hipGetDevice(&device));
+
+        int poolsSupported = 0;
+        if(hipDeviceGetAttribute(&poolsSupported, hipDeviceAttributeMemoryPoolsSupported, device)
+               == hipSuccess
+           && poolsSupported != 0
+           && hipDeviceGetDefaultMemPool(&mDevicePool, device) == hipSuccess)
+        {
+            // Keep freed memory in the pool instead of releasing it at each sync
+            uint64_t threshold = std::numeric_limits<uint64_t>::max();
+            mStreamOrdered
+                = hipMemPoolSetAttribute(mDevicePool, hipMemPoolAttrReleaseThreshold, &threshold)
+                  == hipSuccess;
+        }
+
+        // Clear the sticky error of an unsupported query
+        (void)hipGetLastError();
+    }
+
+    HipMemoryPool::~HipMemoryPool()
+    {
+        // The runtime may already be shutting down, so errors are ignored
+        for(auto& block : mLiveBlocks)
+        {
+            (void)hipFree(block.first);
+        }
+        for(auto& block : mFreeBlocks)
+        {
+            (void)hipFree(block.second);
+        }
+    }
+
+    uint64_t HipMemoryPool::sizeClass(uint64_t bytes)
+    {
+        constexpr uint64_t MinBytes = 512u;
+        if(bytes <= MinBytes)
+        {
+            return MinBytes;
+        }
+
+        // Largest power of 2 below bytes, split in 4 steps
+        uint64_t pow2 = MinBytes;
+        while(pow2 * 2u < bytes)
+        {
+            pow2 <<= 1u;
+        }
+
+        auto step = pow2 / 4u;
+        return ceilDiv(bytes, step) * step;
+    }
+
+    void* HipMemoryPool::allocate(uint64_t bytes)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStats.allocs++;
+
+        void* ptr = nullptr;
+        if(mStreamOrdered)
+        {
+            if(hipMallocAsync(&ptr, bytes, 0) != hipSuccess)
+            {
+                (void)hipGetLastError();
+                trimLocked();
+                CHECK_HIP_ERROR(hipMallocAsync(&ptr, bytes, 0));
+            }
+            return ptr;
+        }
+
+        auto size  = sizeClass(bytes);
+        auto block = mFreeBlocks.find(size);
+        if(block != mFreeBlocks.end())
+        {
+            ptr = block->second;
+            mFreeBlocks.erase(block);
+            mStats.hits++;
+            mStats.cachedBytes -= size;
+        }
+        else
+        {
+            // Release the cache and retry if the device is out of memory
+            if(hipMalloc(&ptr, size) != hipSuccess)
+            {
+                (void)hipGetLastError();
+                trimLocked();
+                CHECK_HIP_ERROR(hipMalloc(&ptr, size));
+            }
+            mStats.reservedBytes += size;
+        }
+
+        mLiveBlocks.emplace(ptr, size);
+        return ptr;
+    }
+
+    void HipMemoryPool::release(void* ptr)
+    {
+        if(ptr == nullptr)
+        {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        if(mStreamOrdered)
+        {
+            CHECK_HIP_ERROR(hipFreeAsync(ptr, 0));
+            return;
+        }
+
+        auto block = mLiveBlocks.find(ptr);
+        if(block == mLiveBlocks.end())
+        {
+            // Not from this pool
+            CHECK_HIP_ERROR(hipFree(ptr));
+            return;
+        }
+
+        mFreeBlocks.emplace(block->second, ptr);
+        mStats.cachedBytes += block->second;
+        mLiveBlocks.erase(block);
+    }
+
+    void HipMemoryPool::trim()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        trimLocked();
+    }
+
+    void HipMemoryPool::trimLocked()
+    {
+        // Work still in flight on the null stream may use freed memory
+        CHECK_HIP_ERROR(hipDeviceSynchronize());
+
+        if(mStreamOrdered)
+        {
+            CHECK_HIP_ERROR(hipMemPoolTrimTo(mDevicePool, 0));
+            return;
+        }
+
+        for(auto& block : mFreeBlocks)
+        {
+            CHECK_HIP_ERROR(hipFree(block.second));
+            mStats.reservedBytes -= block.first;
+        }
+        mFreeBlocks.clear();
+        mStats.cachedBytes = 0u;
+    }
+
+    bool HipMemoryPool::isStreamOrdered() const
+    {
+        return mStreamOrdered;
+    }
+
+    auto HipMemoryPool::stats() const -> Stats
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mStats;
+    }
+
+} // namespace rocwmma
@@ -0,0 +1,96 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef ROCWMMA_TEST_HIP_MEMORY_POOL_HPP
+#define ROCWMMA_TEST_HIP_MEMORY_POOL_HPP
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
+#include <hip/hip_runtime_api.h>
+
+#include "singleton.hpp"
+
+// The HipMemoryPool class caches device allocations for re-use across problem sizes,
+// so that sweeps over many problems do not pay for hipMalloc / hipFree on every resize.
+// Where the device supports memory pools, allocations are stream-ordered through
+// hipMallocAsync on the default pool, with its release threshold raised to keep freed
+// memory cached. Otherwise, freed blocks are kept in size-class buckets and handed out
+// again to requests of the same size class. Memory is ordered on the null stream.
+
+namespace rocwmma
+{
+
+    class HipMemoryPool : public LazySingleton<HipMemoryPool>
+    {
+    public:
+        // For static initialization
+        friend std::unique_ptr<HipMemoryPool> std::make_unique<HipMemoryPool>();
+
+        struct Stats
+        {
+            uint64_t allocs;
+            uint64_t hits; // Allocations served from cached blocks (bucket arena only)
+            uint64_t reservedBytes; // Device memory held by the pool (bucket arena only)
+            uint64_t cachedBytes; // Reserved memory in free blocks (bucket arena only)
+        };
+
+    protected:
+        HipMemoryPool();
+
+    public:
+        ~HipMemoryPool();
+
+        void* allocate(uint64_t bytes);
+        void  release(void* ptr);
+
+        // Return cached memory to the device
+        void trim();
+
+        bool  isStreamOrdered() const;
+        Stats stats() const;
+
+        // Rounds up to 4 size classes per power of 2, wasting at most 25%
+        static uint64_t sizeClass(uint64_t bytes);
+
+    private:
+        void trimLocked();
+
+        bool               mStreamOrdered;
+        hipMemPool_t       mDevicePool;
+        Stats              mStats;
+        mutable std::mutex mMutex;
+
+        // Live blocks and their size class, and free blocks by size class
+        std::unordered_map<void*, uint64_t> mLiveBlocks;
+        std::multimap<uint64_t, void*>      mFreeBlocks;
+    };
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_TEST_HIP_MEMORY_POOL_HPP
@@ -28,11 +28,17 @@
 #define ROCWMMA_HIP_RESOURCE_HPP
 
 #include <memory>
+
+#include <hip/hip_runtime_api.h>
+
 #include <rocwmma/internal/types.hpp>
 
 // The HipResource class is intended as a wrapper for allocation, deletion and copying
 // between host and device resources using the HIP backend.
 // Memory is treated as a 1D array, and is managed through the std::unique_ptr class.
+// Device memory is sub-allocated from the HipMemoryPool cache.
+// Host memory is pinned when possible, so that copies run at full bandwidth and the
+// async copies can overlap with kernels on other streams.
 
 namespace rocwmma
 {
@@ -55,7 +61,7 @@ namespace rocwmma
         using DevicePtrT = std::unique_ptr<DataT, void (*)(DataT*)>;
 
         template <typename DataT>
-        using HostPtrT = std::unique_ptr<DataT[]>;
+        using HostPtrT = std::unique_ptr<DataT[], void (*)(DataT*)>;
 
         // Alloc
         template <typename DataT>
@@ -88,6 +94,28 @@ namespace rocwmma
         static void
             copyData(DevicePtrT<DataT>& dst, DevicePtrT<DataT> const& src, int64_t numElements);
 
+        // Async transfer wrappers, ordered on the given stream
+        template <typename DataT>
+        static void copyDataAsync(HostPtrT<DataT>&         dst,
+                                  DevicePtrT<DataT> const& src,
+                                  int64_t                  numElements,
+                                  hipStream_t              stream);
+        template <typename DataT>
+        static void copyDataAsync(DevicePtrT<DataT>&     dst,
+                                  HostPtrT<DataT> const& src,
+                                  int64_t                numElements,
+                                  hipStream_t            stream);
+        template <typename DataT>
+        static void copyDataAsync(HostPtrT<DataT>&       dst,
+                                  HostPtrT<DataT> const& src,
+                                  int64_t                numElements,
+                                  hipStream_t            stream);
+        template <typename DataT>
+        static void copyDataAsync(DevicePtrT<DataT>&       dst,
+                                  DevicePtrT<DataT> const& src,
+                                  int64_t                  numElements,
+                                  hipStream_t              stream);
+
         virtual void reset() = 0;
     };
 
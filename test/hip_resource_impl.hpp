@@ -30,6 +30,7 @@
 #include <hip/hip_runtime_api.h>
 
 #include "common.hpp"
+#include "hip_memory_pool.hpp"
 #include "hip_resource.hpp"
 
 namespace rocwmma
@@ -38,9 +39,15 @@ namespace rocwmma
     template <typename DataT>
     auto inline HipResource::allocDevice(int64_t numElements) -> DevicePtrT<DataT>
     {
-        DataT* data;
-        CHECK_HIP_ERROR(hipMalloc(&data, numElements * sizeof(DataT)));
-        return DevicePtrT<DataT>(data, [](DataT* d) { CHECK_HIP_ERROR(hipFree(d)); });
+        if(numElements == 0)
+        {
+            return DevicePtrT<DataT>(nullptr, [](DataT*) {});
+        }
+
+        // Device memory is cached in the pool for re-use by later allocations
+        auto* data = reinterpret_cast<DataT*>(
+            HipMemoryPool::instance()->allocate(numElements * sizeof(DataT)));
+        return DevicePtrT<DataT>(data, [](DataT* d) { HipMemoryPool::instance()->release(d); });
     }
 
     template <typename DataT>
@@ -54,7 +61,22 @@ namespace rocwmma
     template <typename DataT>
     auto HipResource::allocHost(int64_t numElements) -> HostPtrT<DataT>
     {
-        return HostPtrT<DataT>(new DataT[numElements]);
+        if(numElements == 0)
+        {
+            return HostPtrT<DataT>(nullptr, [](DataT*) {});
+        }
+
+        // Pinned host memory, falling back to pageable memory if the pinned
+        // allocation is not available (e.g. exceeds the locked memory limit).
+        DataT* data;
+        if(hipHostMalloc(&data, numElements * sizeof(DataT), hipHostMallocDefault) == hipSuccess)
+        {
+            return HostPtrT<DataT>(data, [](DataT* d) { CHECK_HIP_ERROR(hipHostFree(d)); });
+        }
+
+        // Clear the sticky error of the failed allocation
+        (void)hipGetLastError();
+        return HostPtrT<DataT>(new DataT[numElements], [](DataT* d) { delete[] d; });
     }
 
     template <typename DataT>
@@ -109,6 +131,46 @@ namespace rocwmma
             hipMemcpy(dst.get(), src.get(), numElements * sizeof(DataT), hipMemcpyDeviceToDevice));
     }
 
+    template <typename DataT>
+    void HipResource::copyDataAsync(HostPtrT<DataT>&         dst,
+                                    DevicePtrT<DataT> const& src,
+                                    int64_t                  numElements,
+                                    hipStream_t              stream)
+    {
+        CHECK_HIP_ERROR(hipMemcpyAsync(
+            dst.get(), src.get(), numElements * sizeof(DataT), hipMemcpyDeviceToHost, stream));
+    }
+
+    template <typename DataT>
+    void HipResource::copyDataAsync(DevicePtrT<DataT>&     dst,
+                                    HostPtrT<DataT> const& src,
+                                    int64_t                numElements,
+                                    hipStream_t            stream)
+    {
+        CHECK_HIP_ERROR(hipMemcpyAsync(
+            dst.get(), src.get(), numElements * sizeof(DataT), hipMemcpyHostToDevice, stream));
+    }
+
+    template <typename DataT>
+    void HipResource::copyDataAsync(HostPtrT<DataT>&       dst,
+                                    HostPtrT<DataT> const& src,
+                                    int64_t                numElements,
+                                    hipStream_t            stream)
+    {
+        CHECK_HIP_ERROR(hipMemcpyAsync(
+            dst.get(), src.get(), numElements * sizeof(DataT), hipMemcpyHostToHost, stream));
+    }
+
+    template <typename DataT>
+    void HipResource::copyDataAsync(DevicePtrT<DataT>&       dst,
+                                    DevicePtrT<DataT> const& src,
+                                    int64_t                  numElements,
+                                    hipStream_t              stream)
+    {
+        CHECK_HIP_ERROR(hipMemcpyAsync(
+            dst.get(), src.get(), numElements * sizeof(DataT), hipMemcpyDeviceToDevice, stream));
+    }
+
 } // namespace rocwmma
 
 #endif //ROCWMMA_HIP_RESOURCE_IMPL_HPP
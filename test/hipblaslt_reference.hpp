@@ -0,0 +1,232 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_HIPBLASLT_REFERENCE_HPP
+#define ROCWMMA_HIPBLASLT_REFERENCE_HPP
+
+#include <hipblaslt/hipblaslt.h>
+
+#define CHECK_HIPBLASLT_ERROR(expression)                             \
+    if(auto status = (expression); status != HIPBLAS_STATUS_SUCCESS) \
+    {                                                                 \
+        fprintf(stderr,                                               \
+                "hipBLASLt error: '%s'(%d) at %s:%d\n",               \
+                hipblasStatusToString(status),                        \
+                status,                                               \
+                __FILE__,                                             \
+                __LINE__);                                            \
+        exit(EXIT_FAILURE);                                           \
+    }
+
+#include "common.hpp"
+#include <rocwmma/internal/types.hpp>
+
+namespace rocwmma
+{
+
+    template <typename DataT>
+    struct hipblaslt_types;
+
+    template <>
+    struct hipblaslt_types<float16_t>
+    {
+        constexpr static inline hipDataType type()
+        {
+            return HIP_R_16F;
+        }
+    };
+
+    template <>
+    struct hipblaslt_types<bfloat16_t>
+    {
+        constexpr static inline hipDataType type()
+        {
+            return HIP_R_16BF;
+        }
+    };
+
+    template <>
+    struct hipblaslt_types<float32_t>
+    {
+        constexpr static inline hipDataType type()
+        {
+            return HIP_R_32F;
+        }
+    };
+
+    template <typename DataLayoutT>
+    struct hipblaslt_layout;
+
+    template <>
+    struct hipblaslt_layout<row_major>
+    {
+        using Layout = row_major;
+        constexpr static inline hipblasOperation_t operation()
+        {
+            return HIPBLAS_OP_T;
+        }
+    };
+
+    template <>
+    struct hipblaslt_layout<col_major>
+    {
+        using Layout = col_major;
+        constexpr static inline hipblasOperation_t operation()
+        {
+            return HIPBLAS_OP_N;
+        }
+    };
+
+    /*
+    * hipBLASLt matmul of D = alpha * (A x B) + beta * C with f32 compute.
+    * Like rocBLAS, C and D are always col_major and row_major A or B are
+    * transposed (T) operands.
+    *
+    * The handle, descriptors, heuristic algorithm and workspace are set up
+    * on construction, so that calls only launch the matmul and can be timed
+    * back to back.
+    */
+    class HipblasLtGemm
+    {
+    public:
+        HipblasLtGemm(hipblasOperation_t opA,
+                      hipblasOperation_t opB,
+                      uint32_t           m,
+                      uint32_t           n,
+                      uint32_t           k,
+                      hipDataType        inputType,
+                      hipDataType        outputType,
+                      uint32_t           lda,
+                      uint32_t           ldb,
+                      uint32_t           ldc,
+                      uint32_t           ldd)
+            : mWorkspace(nullptr)
+            , mHasAlgo(false)
+        {
+            CHECK_HIPBLASLT_ERROR(hipblasLtCreate(&mHandle));
+            CHECK_HIPBLASLT_ERROR(
+                hipblasLtMatmulDescCreate(&mMatmulDesc, HIPBLAS_COMPUTE_32F, HIP_R_32F));
+            CHECK_HIPBLASLT_ERROR(hipblasLtMatmulDescSetAttribute(
+                mMatmulDesc, HIPBLASLT_MATMUL_DESC_TRANSA, &opA, sizeof(opA)));
+            CHECK_HIPBLASLT_ERROR(hipblasLtMatmulDescSetAttribute(
+                mMatmulDesc, HIPBLASLT_MATMUL_DESC_TRANSB, &opB, sizeof(opB)));
+
+            // Layouts describe the stored, col_major matrices
+            auto transA = (opA == HIPBLAS_OP_T);
+            auto transB = (opB == HIPBLAS_OP_T);
+            CHECK_HIPBLASLT_ERROR(hipblasLtMatrixLayoutCreate(
+                &mLayoutA, inputType, transA ? k : m, transA ? m : k, lda));
+            CHECK_HIPBLASLT_ERROR(hipblasLtMatrixLayoutCreate(
+                &mLayoutB, inputType, transB ? n : k, transB ? k : n, ldb));
+            CHECK_HIPBLASLT_ERROR(hipblasLtMatrixLayoutCreate(&mLayoutC, outputType, m, n, ldc));
+            CHECK_HIPBLASLT_ERROR(hipblasLtMatrixLayoutCreate(&mLayoutD, outputType, m, n, ldd));
+
+            CHECK_HIP_ERROR(hipMalloc(&mWorkspace, mWorkspaceBytes));
+
+            hipblasLtMatmulPreference_t preference;
+            CHECK_HIPBLASLT_ERROR(hipblasLtMatmulPreferenceCreate(&preference));
+            CHECK_HIPBLASLT_ERROR(
+                hipblasLtMatmulPreferenceSetAttribute(preference,
+                                                      HIPBLASLT_MATMUL_PREF_MAX_WORKSPACE_BYTES,
+                                                      &mWorkspaceBytes,
+                                                      sizeof(mWorkspaceBytes)));
+
+            // Best heuristic algorithm only, as a library user would get by default
+            int algoCount = 0;
+            CHECK_HIPBLASLT_ERROR(hipblasLtMatmulAlgoGetHeuristic(mHandle,
+                                                                  mMatmulDesc,
+                                                                  mLayoutA,
+                                                                  mLayoutB,
+                                                                  mLayoutC,
+                                                                  mLayoutD,
+                                                                  preference,
+                                                                  1,
+                                                                  &mHeuristic,
+                                                                  &algoCount));
+            CHECK_HIPBLASLT_ERROR(hipblasLtMatmulPreferenceDestroy(preference));
+            mHasAlgo = (algoCount > 0);
+        }
+
+        ~HipblasLtGemm()
+        {
+            CHECK_HIP_ERROR(hipFree(mWorkspace));
+            CHECK_HIPBLASLT_ERROR(hipblasLtMatrixLayoutDestroy(mLayoutD));
+            CHECK_HIPBLASLT_ERROR(hipblasLtMatrixLayoutDestroy(mLayoutC));
+            CHECK_HIPBLASLT_ERROR(hipblasLtMatrixLayoutDestroy(mLayoutB));
+            CHECK_HIPBLASLT_ERROR(hipblasLtMatrixLayoutDestroy(mLayoutA));
+            CHECK_HIPBLASLT_ERROR(hipblasLtMatmulDescDestroy(mMatmulDesc));
+            CHECK_HIPBLASLT_ERROR(hipblasLtDestroy(mHandle));
+        }
+
+        HipblasLtGemm(HipblasLtGemm const&)            = delete;
+        HipblasLtGemm& operator=(HipblasLtGemm const&) = delete;
+
+        // False if hipBLASLt has no algorithm for the problem
+        bool hasAlgo() const
+        {
+            return mHasAlgo;
+        }
+
+        // Alpha and beta are f32
+        void operator()(void const* alpha,
+                        void const* a,
+                        void const* b,
+                        void const* beta,
+                        void const* c,
+                        void*       d,
+                        hipStream_t stream = 0) const
+        {
+            CHECK_HIPBLASLT_ERROR(hipblasLtMatmul(mHandle,
+                                                  mMatmulDesc,
+                                                  alpha,
+                                                  a,
+                                                  mLayoutA,
+                                                  b,
+                                                  mLayoutB,
+                                                  beta,
+                                                  c,
+                                                  mLayoutC,
+                                                  d,
+                                                  mLayoutD,
+                                                  &mHeuristic.algo,
+                                                  mWorkspace,
+                                                  mWorkspaceBytes,
+                                                  stream));
+        }
+
+    private:
+        constexpr static uint64_t mWorkspaceBytes = 32ull * 1024ull * 1024ull;
+
+        hipblasLtHandle_t                mHandle;
+        hipblasLtMatmulDesc_t            mMatmulDesc;
+        hipblasLtMatrixLayout_t          mLayoutA, mLayoutB, mLayoutC, mLayoutD;
+        hipblasLtMatmulHeuristicResult_t mHeuristic;
+        void*                            mWorkspace;
+        bool                             mHasAlgo;
+    };
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_HIPBLASLT_REFERENCE_HPP
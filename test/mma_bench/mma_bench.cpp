@@ -0,0 +1,351 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "benchmark_log.hpp"
+#include "common.hpp"
+#include "hip_device.hpp"
+#include "hip_resource.hpp"
+#include "mma_bench.hpp"
+#include "rocwmma_logging.hpp"
+
+///
+/// MFMA / WMMA instruction microbenchmark. For each amdgcn_mfma and amdgcn_wmma
+/// specialization implemented by the current device, measures:
+/// - Latency: one dependent accumulation chain per wave and one wave per CU,
+///   reported in cycles per instruction.
+/// - Throughput: independent chains on every SIMD of every CU, reported in
+///   flops per cycle per CU against the MfmaPerfTraits peak.
+///
+/// Usage: rocwmma-mma-bench [-bo || --bench_output *file.json|file.csv*]
+///                          [-bb || --bench_baseline *file.json|file.csv*] [-bt *percent*]
+///
+/// Records use the suites mma_latency and mma_throughput, with the problem type
+/// as InputT_ComputeT, the kernel config as the instruction family, M, N and K as
+/// the instruction block sizes and batch as the instructions issued per wave.
+///
+
+namespace rocwmma
+{
+    namespace MmaBench
+    {
+        constexpr uint32_t Iterations = 4096u;
+        constexpr uint32_t Runs       = 10u;
+
+        // Independent chains per wave in the throughput kernel; enough to cover the
+        // dependent latency of the deepest instructions.
+        constexpr uint32_t ThroughputChains = 8u;
+
+        // Throughput launch: waves per workgroup and workgroups per CU
+        constexpr uint32_t ThroughputWaves       = 4u;
+        constexpr uint32_t ThroughputBlocksPerCu = 2u;
+
+        struct Launch
+        {
+            char const* mSuite;
+            uint32_t    mChains;
+            uint32_t    mWavesPerBlock;
+            uint32_t    mBlocksPerCu;
+        };
+
+        // Times Runs launches of the kernel after one warmup
+        template <typename KernelF>
+        TimingStats timeKernel(KernelF&& kernel)
+        {
+            kernel();
+
+            std::vector<hipEvent_t> runEvents(Runs + 1u);
+            for(auto& event : runEvents)
+            {
+                CHECK_HIP_ERROR(hipEventCreate(&event));
+            }
+            CHECK_HIP_ERROR(hipEventRecord(runEvents[0]));
+            for(uint32_t i = 0; i < Runs; ++i)
+            {
+                kernel();
+                CHECK_HIP_ERROR(hipEventRecord(runEvents[i + 1u]));
+            }
+            CHECK_HIP_ERROR(hipEventSynchronize(runEvents[Runs]));
+
+            std::vector<double> runTimesMs(Runs);
+            for(uint32_t i = 0; i < Runs; ++i)
+            {
+                auto runMs = 0.0f;
+                CHECK_HIP_ERROR(hipEventElapsedTime(&runMs, runEvents[i], runEvents[i + 1u]));
+                runTimesMs[i] = runMs;
+            }
+
+            for(auto& event : runEvents)
+            {
+                CHECK_HIP_ERROR(hipEventDestroy(event));
+            }
+
+            return calculateTimingStats(runTimesMs);
+        }
+
+        void printHeader(std::ostream& stream)
+        {
+            stream << "Suite, Instr, ProblemType, MxNxK, Waves, Instrs/Wave, "
+                      "MedianMs, Cycles/Instr, Flops/Cycle/CU, PeakFlops/Cycle/CU, %Peak"
+                   << std::endl;
+        }
+
+        template <typename Instr,
+                  typename InputT,
+                  typename ComputeT,
+                  uint32_t BlockM,
+                  uint32_t BlockN>
+        void run(char const* family)
+        {
+            using Options        = RocwmmaLogging;
+            auto& loggingOptions = Options::instance();
+            auto& deviceInfo     = HipDevice::instance();
+
+            std::string problemType
+                = std::string(dataTypeToString<InputT>()) + "_" + dataTypeToString<ComputeT>();
+
+            // The device pass decides whether the instruction exists, and its K
+            auto kPerInstrD = HipResource::allocDevice<uint32_t>(1);
+            hipLaunchKernelGGL((mmaProbe<Instr>), dim3(1), dim3(1), 0, 0, kPerInstrD.get());
+            CHECK_HIP_ERROR(hipGetLastError());
+
+            uint32_t kPerInstr = 0u;
+            CHECK_HIP_ERROR(
+                hipMemcpy(&kPerInstr, kPerInstrD.get(), sizeof(uint32_t), hipMemcpyDeviceToHost));
+
+            if(kPerInstr == 0u)
+            {
+                if(!loggingOptions->omitCout() && !loggingOptions->omitSkipped())
+                {
+                    std::cout << family << " " << problemType << " " << BlockM << "x" << BlockN
+                              << ": not supported on this device" << std::endl;
+                }
+                return;
+            }
+
+            auto warpSize   = static_cast<uint32_t>(deviceInfo->warpSize());
+            auto cuCount    = static_cast<uint32_t>(deviceInfo->cuCount());
+            auto freqMhz    = static_cast<double>(deviceInfo->curFreqMhz());
+            auto peakGFlops = deviceInfo->peakGFlopsPerSec<InputT>();
+
+            std::string kernelConfig = std::string(family) + "_" + std::to_string(BlockM) + "x"
+                                       + std::to_string(BlockN) + "x" + std::to_string(kPerInstr);
+
+            for(auto const& launch : {Launch{"mma_latency", 1u, 1u, 1u},
+                                      Launch{"mma_throughput",
+                                             ThroughputChains,
+                                             ThroughputWaves,
+                                             ThroughputBlocksPerCu}})
+            {
+                auto blockSize  = launch.mWavesPerBlock * warpSize;
+                auto blockCount = launch.mBlocksPerCu * cuCount;
+                auto out        = HipResource::allocDevice<float32_t>(blockSize * blockCount);
+
+                TimingStats timing;
+                if(launch.mChains == 1u)
+                {
+                    timing = timeKernel([&]() {
+                        hipLaunchKernelGGL((mmaChain<Instr, 1u>),
+                                           dim3(blockCount),
+                                           dim3(blockSize),
+                                           0,
+                                           0,
+                                           Iterations,
+                                           out.get());
+                    });
+                }
+                else
+                {
+                    timing = timeKernel([&]() {
+                        hipLaunchKernelGGL((mmaChain<Instr, ThroughputChains>),
+                                           dim3(blockCount),
+                                           dim3(blockSize),
+                                           0,
+                                           0,
+                                           Iterations,
+                                           out.get());
+                    });
+                }
+                CHECK_HIP_ERROR(hipGetLastError());
+
+                auto waves         = blockCount * launch.mWavesPerBlock;
+                auto instrsPerWave = Iterations * launch.mChains;
+
+                auto gFlops = calculateGFlops(BlockM, BlockN, kPerInstr) * waves * instrsPerWave;
+                auto tFlopsPerSec = gFlops / timing.mMedianMs;
+                auto cycles       = timing.mMedianMs * freqMhz * 1.0e3;
+
+                auto cyclesPerInstr = cycles / static_cast<double>(instrsPerWave);
+                auto flopsPerCycle  = gFlops * 1.0e9 / (cycles * cuCount);
+                auto peakPerCycle   = peakGFlops * 1.0e3 / (freqMhz * cuCount);
+                auto efficiency     = calculatePercentOfRoof(tFlopsPerSec, peakGFlops);
+
+                auto report = [&](std::ostream& stream) {
+                    stream << launch.mSuite << ", " << family << ", " << problemType << ", "
+                           << BlockM << "x" << BlockN << "x" << kPerInstr << ", " << waves
+                           << ", " << instrsPerWave << ", " << timing.mMedianMs << ", "
+                           << cyclesPerInstr << ", " << flopsPerCycle << ", " << peakPerCycle
+                           << ", " << efficiency << std::endl;
+                };
+
+                if(!loggingOptions->omitCout())
+                {
+                    report(std::cout);
+                }
+
+                if(loggingOptions->ostream().isOpen())
+                {
+                    report(loggingOptions->ostream().fstream());
+                }
+
+                BenchmarkLog::instance()->record(
+                    {launch.mSuite,
+                     static_cast<uint32_t>(deviceInfo->getGcnArch()),
+                     problemType,
+                     kernelConfig,
+                     blockSize,
+                     1u,
+                     BlockM,
+                     BlockN,
+                     kPerInstr,
+                     instrsPerWave,
+                     Runs,
+                     timing,
+                     gFlops,
+                     tFlopsPerSec,
+                     efficiency,
+                     peakGFlops * 1.0e-3,
+                     "Compute",
+                     "BENCH"});
+            }
+        }
+
+        template <typename InputT, typename ComputeT, uint32_t BlockM, uint32_t BlockN>
+        void runMfma()
+        {
+            run<detail::amdgcn_mfma<InputT, ComputeT, BlockM, BlockN>,
+                InputT,
+                ComputeT,
+                BlockM,
+                BlockN>("MFMA");
+        }
+
+        template <typename InputT, typename ComputeT, uint32_t BlockM, uint32_t BlockN>
+        void runWmma()
+        {
+            run<detail::amdgcn_wmma<InputT, ComputeT, BlockM, BlockN>,
+                InputT,
+                ComputeT,
+                BlockM,
+                BlockN>("WMMA");
+        }
+
+        void runAll()
+        {
+            if(!RocwmmaLogging::instance()->omitCout())
+            {
+                printHeader(std::cout);
+            }
+
+            runMfma<float16_t, float32_t, 16, 16>();
+            runMfma<float16_t, float32_t, 32, 32>();
+            runMfma<float16_t, float16_t, 16, 16>();
+            runMfma<float16_t, float16_t, 32, 32>();
+            runMfma<bfloat16_t, float32_t, 16, 16>();
+            runMfma<bfloat16_t, float32_t, 32, 32>();
+            runMfma<bfloat16_t, bfloat16_t, 16, 16>();
+            runMfma<bfloat16_t, bfloat16_t, 32, 32>();
+            runMfma<int8_t, int32_t, 16, 16>();
+            runMfma<int8_t, int32_t, 32, 32>();
+            runMfma<float32_t, float32_t, 16, 16>();
+            runMfma<float32_t, float32_t, 32, 32>();
+            runMfma<float64_t, float64_t, 16, 16>();
+            runMfma<float8_t, float32_t, 16, 16>();
+            runMfma<float8_t, float32_t, 32, 32>();
+            runMfma<bfloat8_t, float32_t, 16, 16>();
+            runMfma<bfloat8_t, float32_t, 32, 32>();
+            runMfma<xfloat32_t, float32_t, 16, 16>();
+            runMfma<xfloat32_t, float32_t, 32, 32>();
+
+            runWmma<float16_t, float32_t, 16, 16>();
+            runWmma<float16_t, float16_t, 16, 16>();
+            runWmma<bfloat16_t, float32_t, 16, 16>();
+            runWmma<bfloat16_t, bfloat16_t, 16, 16>();
+            runWmma<int8_t, int32_t, 16, 16>();
+            runWmma<float8_t, float32_t, 16, 16>();
+            runWmma<bfloat8_t, float32_t, 16, 16>();
+        }
+
+    } // namespace MmaBench
+
+} // namespace rocwmma
+
+int main(int argc, char** argv)
+{
+    using Options        = rocwmma::RocwmmaLogging;
+    auto& loggingOptions = Options::instance();
+    loggingOptions->parseOptions(argc, argv);
+
+    // Device sharding splits gtest cases, so it does not apply here
+    if(loggingOptions->shardDevices() >= 0)
+    {
+        std::cerr << "Device sharding is only supported by the gtest executables\n";
+        return EXIT_FAILURE;
+    }
+
+    if(auto device = loggingOptions->device(); device >= 0)
+    {
+        CHECK_HIP_ERROR(hipSetDevice(device));
+    }
+
+    rocwmma::MmaBench::runAll();
+
+    int status = EXIT_SUCCESS;
+
+    // Compare recorded benchmarks against the baseline, failing on regressions
+    auto& baselineFile = loggingOptions->benchBaselineFile();
+    if(!baselineFile.empty())
+    {
+        std::vector<rocwmma::BenchmarkRecord> baseline;
+        if(!rocwmma::BenchmarkLog::load(baselineFile, baseline))
+        {
+            std::cerr << "Unable to load benchmark baseline: " << baselineFile << std::endl;
+            status = EXIT_FAILURE;
+        }
+        else if(rocwmma::BenchmarkLog::instance()->compare(baseline,
+                                                           loggingOptions->benchThreshold())
+                > 0u)
+        {
+            status = EXIT_FAILURE;
+        }
+    }
+
+    return status;
+}
@@ -0,0 +1,146 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef ROCWMMA_TEST_MMA_BENCH_HPP
+#define ROCWMMA_TEST_MMA_BENCH_HPP
+
+#include <type_traits>
+
+#include <rocwmma/internal/mfma.hpp>
+#include <rocwmma/internal/wmma.hpp>
+
+namespace rocwmma
+{
+    // Availability and K depth of an amdgcn_mfma or amdgcn_wmma specialization
+    // in the current compilation pass. Specializations that the target arch does
+    // not implement have no Traits.
+    template <typename Instr, typename Enabler = void>
+    struct MmaInstrTraits
+    {
+        constexpr static bool     Supported = false;
+        constexpr static uint32_t KPerInstr = 0u;
+    };
+
+    template <typename Instr>
+    struct MmaInstrTraits<Instr, std::void_t<decltype(Instr::Traits::KPerMfma)>>
+    {
+        constexpr static bool     Supported = true;
+        constexpr static uint32_t KPerInstr = Instr::Traits::KPerMfma;
+    };
+
+    template <typename Instr>
+    struct MmaInstrTraits<Instr, std::void_t<decltype(Instr::Traits::KPerWmma)>>
+    {
+        constexpr static bool     Supported = true;
+        constexpr static uint32_t KPerInstr = Instr::Traits::KPerWmma;
+    };
+
+    // Reports the K depth of the instruction as compiled for the device,
+    // or 0 if the device does not implement it.
+    template <typename Instr>
+    __global__ void mmaProbe(uint32_t* kPerInstr)
+    {
+        if(blockIdx.x == 0 && threadIdx.x == 0)
+        {
+            *kPerInstr = MmaInstrTraits<Instr>::KPerInstr;
+        }
+    }
+
+    // Each wave issues iterations x Chains instructions as Chains independent
+    // accumulation chains on the same A and B registers.
+    // With one chain every instruction waits on the previous result, measuring
+    // the dependent latency. With enough chains to cover that latency, issue
+    // rate is bound by the matrix core throughput.
+    template <typename Instr, uint32_t Chains>
+    __global__ void __launch_bounds__(256) mmaChain(uint32_t iterations, float32_t* out)
+    {
+        if constexpr(MmaInstrTraits<Instr>::Supported)
+        {
+            using ARegsT = typename Instr::Traits::ARegsT;
+            using BRegsT = typename Instr::Traits::BRegsT;
+            using CRegsT = typename Instr::Traits::CRegsT;
+
+            static_assert(std::is_same_v<CRegsT, typename Instr::Traits::DRegsT>,
+                          "C and D registers must be of same type");
+
+            using DataA = typename VecTraits<ARegsT>::DataT;
+            using DataB = typename VecTraits<BRegsT>::DataT;
+            using DataC = typename VecTraits<CRegsT>::DataT;
+
+            // Seed the registers from the thread index so that nothing can be folded
+            ARegsT regsA;
+            BRegsT regsB;
+            CRegsT accum[Chains];
+
+#pragma unroll
+            for(uint32_t i = 0; i < VecTraits<ARegsT>::size(); i++)
+            {
+                regsA.data[i] = static_cast<DataA>(threadIdx.x + i);
+            }
+
+#pragma unroll
+            for(uint32_t i = 0; i < VecTraits<BRegsT>::size(); i++)
+            {
+                regsB.data[i] = static_cast<DataB>(threadIdx.x - i);
+            }
+
+#pragma unroll
+            for(uint32_t c = 0; c < Chains; c++)
+            {
+#pragma unroll
+                for(uint32_t i = 0; i < VecTraits<CRegsT>::size(); i++)
+                {
+                    accum[c].data[i] = static_cast<DataC>(c);
+                }
+            }
+
+            for(uint32_t i = 0; i < iterations; i++)
+            {
+#pragma unroll
+                for(uint32_t c = 0; c < Chains; c++)
+                {
+                    accum[c] = Instr::exec(regsA, regsB, accum[c]);
+                }
+            }
+
+            // Keep the chains live
+            auto sum = static_cast<DataC>(0);
+#pragma unroll
+            for(uint32_t c = 0; c < Chains; c++)
+            {
+#pragma unroll
+                for(uint32_t i = 0; i < VecTraits<CRegsT>::size(); i++)
+                {
+                    sum += accum[c].data[i];
+                }
+            }
+            out[blockIdx.x * blockDim.x + threadIdx.x] = static_cast<float32_t>(sum);
+        }
+    }
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_TEST_MMA_BENCH_HPP
@@ -0,0 +1,180 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef ROCWMMA_TEST_PERF_GOLDEN_HPP
+#define ROCWMMA_TEST_PERF_GOLDEN_HPP
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "benchmark_log.hpp"
+#include "rocwmma_logging.hpp"
+#include "singleton.hpp"
+
+namespace rocwmma
+{
+    // Golden throughput for the perf regression suites.
+    // Goldens are benchmark records (-bo || --bench_output) measured on reference hardware,
+    // one JSON lines or csv file per arch named <dir>/gfx<arch>.json or <dir>/gfx<arch>.csv.
+    // All suites of an arch share its file; outputs of several executables concatenate.
+    class PerfGolden : public LazySingleton<PerfGolden>
+    {
+    public:
+        enum class Status
+        {
+            NoGolden, // No golden file for the arch
+            Untracked, // Golden file has no record for this run
+            Passed,
+            Regressed
+        };
+
+        // Loaded once per arch. Returns nullptr if the arch has no golden file.
+        std::vector<BenchmarkRecord> const* goldens(std::string const& directory, uint32_t arch)
+        {
+            auto it = mGoldens.find(arch);
+            if(it == mGoldens.end())
+            {
+                auto  base    = directory + "/" + BenchmarkLog::archString(arch);
+                auto& entry   = mGoldens[arch];
+                entry.mLoaded = BenchmarkLog::load(base + ".json", entry.mRecords)
+                                || BenchmarkLog::load(base + ".csv", entry.mRecords);
+                if(!entry.mLoaded)
+                {
+                    std::cerr << "No perf golden for " << BenchmarkLog::archString(arch)
+                              << " in " << directory << std::endl;
+                }
+                it = mGoldens.find(arch);
+            }
+
+            return it->second.mLoaded ? &it->second.mRecords : nullptr;
+        }
+
+        // Throughput is compared as golden median time over current median time, which
+        // holds for flop and bandwidth bound suites alike. Runs regress when their throughput
+        // falls more than tolerancePct percent below the golden.
+        Status check(BenchmarkRecord const& current,
+                     std::string const&     directory,
+                     double                 tolerancePct,
+                     std::ostream&          stream = std::cout)
+        {
+            auto records = goldens(directory, current.mArch);
+            if(records == nullptr)
+            {
+                return Status::NoGolden;
+            }
+
+            // Latest golden wins when a file holds repeated measurements
+            auto it = std::find_if(records->rbegin(), records->rend(), [&](auto const& g) {
+                return BenchmarkLog::sameKey(g, current);
+            });
+            if(it == records->rend() || it->mTiming.mMedianMs <= 0.0)
+            {
+                stream << "UNTRACKED: " << describe(current) << std::endl;
+                return Status::Untracked;
+            }
+
+            auto throughputPct = it->mTiming.mMedianMs / current.mTiming.mMedianMs * 100.0;
+            if(throughputPct < 100.0 - tolerancePct)
+            {
+                stream << "PERF REGRESSION: " << describe(current) << ", median(ms) golden: "
+                       << it->mTiming.mMedianMs << ", current: " << current.mTiming.mMedianMs
+                       << ", TFlops/s golden: " << it->mTFlopsPerSec
+                       << ", current: " << current.mTFlopsPerSec << " (" << std::fixed
+                       << std::setprecision(2) << throughputPct << "% of golden)"
+                       << std::defaultfloat << std::setprecision(6) << std::endl;
+                return Status::Regressed;
+            }
+
+            return Status::Passed;
+        }
+
+    private:
+        struct Entry
+        {
+            bool                         mLoaded = false;
+            std::vector<BenchmarkRecord> mRecords;
+        };
+
+        static std::string describe(BenchmarkRecord const& r)
+        {
+            std::stringstream ss;
+            ss << r.mSuite << ", " << BenchmarkLog::archString(r.mArch) << ", " << r.mProblemType
+               << ", " << r.mKernelConfig << ", " << r.mTBlockX << "x" << r.mTBlockY << ", "
+               << r.mM << "x" << r.mN << "x" << r.mK << "x" << r.mBatch;
+            return ss.str();
+        }
+
+        std::map<uint32_t, Entry> mGoldens;
+    };
+
+    // Checks the latest benchmark record against the golden of its arch.
+    // Fails the current test if throughput dropped beyond -pt || --perf_tolerance. Runs
+    // without a golden record are skipped, or fail under -ps || --perf_strict, the default of
+    // the perf regression suites. Runs on an arch without a golden file are always skipped,
+    // as the suites are built for every arch with one. Does nothing unless a golden directory
+    // is given with -pg || --perf_golden or compiled in by the perf regression suites.
+    inline void expectPerfGolden()
+    {
+        auto& loggingOptions = RocwmmaLogging::instance();
+        auto& directory      = loggingOptions->perfGoldenDir();
+        auto& records        = BenchmarkLog::instance()->records();
+        if(directory.empty() || records.empty())
+        {
+            return;
+        }
+
+        // Skipped, failed or untimed runs have no throughput to compare
+        auto const& current = records.back();
+        if(current.mResult == "SKIPPED" || current.mResult == "FAILED" || current.mRuns == 0u
+           || current.mTiming.mMedianMs <= 0.0)
+        {
+            return;
+        }
+
+        auto status = PerfGolden::instance()->check(
+            current, directory, loggingOptions->perfTolerance());
+        if(status == PerfGolden::Status::NoGolden)
+        {
+            GTEST_SKIP() << "No perf golden for " << BenchmarkLog::archString(current.mArch);
+        }
+
+        EXPECT_TRUE(status != PerfGolden::Status::Untracked || !loggingOptions->perfStrict())
+            << "No perf golden record for this run";
+
+        EXPECT_TRUE(status != PerfGolden::Status::Regressed)
+            << "Throughput regressed beyond " << loggingOptions->perfTolerance() << "%";
+    }
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_TEST_PERF_GOLDEN_HPP
@@ -26,6 +26,9 @@
 #ifndef ROCWMMA_PERFORMANCE_HPP
 #define ROCWMMA_PERFORMANCE_HPP
 
+#include <algorithm>
+#include <cmath>
+
 #include <rocwmma/internal/types.hpp>
 
 namespace rocwmma
@@ -34,6 +37,9 @@ namespace rocwmma
     // Architectures
     class ArchGfx908;
     class ArchGfx90a;
+    class ArchGfx940; // gfx940, gfx941 & gfx942
+    class ArchGfx11; // gfx1100, gfx1101 & gfx1102
+    class ArchGfx12; // gfx1200 & gfx1201
     class Vega20;
     class DefaultArch;
 
@@ -258,6 +264,225 @@ namespace rocwmma
         };
     };
 
+    // gfx940, gfx941 & gfx942
+    template <>
+    struct MfmaPerfTraits<ArchGfx940, int8_t>
+    {
+        enum : uint32_t
+        {
+            Multiplier = 4096
+        };
+    };
+
+    template <>
+    struct MfmaPerfTraits<ArchGfx940, float8_t>
+    {
+        enum : uint32_t
+        {
+            Multiplier = 4096
+        };
+    };
+
+    template <>
+    struct MfmaPerfTraits<ArchGfx940, bfloat8_t>
+    {
+        enum : uint32_t
+        {
+            Multiplier = 4096
+        };
+    };
+
+    template <>
+    struct MfmaPerfTraits<ArchGfx940, bfloat16_t>
+    {
+        enum : uint32_t
+        {
+            Multiplier = 2048
+        };
+    };
+
+    template <>
+    struct MfmaPerfTraits<ArchGfx940, float16_t>
+    {
+        enum : uint32_t
+        {
+            Multiplier = 2048
+        };
+    };
+
+    template <>
+    struct MfmaPerfTraits<ArchGfx940, float32_t>
+    {
+        enum : uint32_t
+        {
+            Multiplier = 256
+        };
+    };
+
+    template <>
+    struct MfmaPerfTraits<ArchGfx940, xfloat32_t>
+    {
+        enum : uint32_t
+        {
+            Multiplier = 1024
+        };
+    };
+
+    template <>
+    struct MfmaPerfTraits<ArchGfx940, float64_t>
+    {
+        enum : uint32_t
+        {
+            Multiplier = 256
+        };
+    };
+
+    // gfx11 (WMMA)
+    template <>
+    struct MfmaPerfTraits<ArchGfx11, int8_t>
+    {
+        enum : uint32_t
+        {
+            Multiplier = 512
+        };
+    };
+
+    template <>
+    struct MfmaPerfTraits<ArchGfx11, float8_t>
+    {
+        enum : uint32_t
+        {
+            Multiplier = 0
+        };
+    };
+
+    template <>
+    struct MfmaPerfTraits<ArchGfx11, bfloat8_t>
+    {
+        enum : uint32_t
+        {
+            Multiplier = 0
+        };
+    };
+
+    template <>
+    struct MfmaPerfTraits<ArchGfx11, bfloat16_t>
+    {
+        enum : uint32_t
+        {
+            Multiplier = 512
+        };
+    };
+
+    template <>
+    struct MfmaPerfTraits<ArchGfx11, float16_t>
+    {
+        enum : uint32_t
+        {
+            Multiplier = 512
+        };
+    };
+
+    template <>
+    struct MfmaPerfTraits<ArchGfx11, float32_t>
+    {
+        enum : uint32_t
+        {
+            Multiplier = 0
+        };
+    };
+
+    template <>
+    struct MfmaPerfTraits<ArchGfx11, xfloat32_t>
+    {
+        enum : uint32_t
+        {
+            Multiplier = 0
+        };
+    };
+
+    template <>
+    struct MfmaPerfTraits<ArchGfx11, float64_t>
+    {
+        enum : uint32_t
+        {
+            Multiplier = 0
+        };
+    };
+
+    // gfx12 (WMMA)
+    template <>
+    struct MfmaPerfTraits<ArchGfx12, int8_t>
+    {
+        enum : uint32_t
+        {
+            Multiplier = 2048
+        };
+    };
+
+    template <>
+    struct MfmaPerfTraits<ArchGfx12, float8_t>
+    {
+        enum : uint32_t
+        {
+            Multiplier = 2048
+        };
+    };
+
+    template <>
+    struct MfmaPerfTraits<ArchGfx12, bfloat8_t>
+    {
+        enum : uint32_t
+        {
+            Multiplier = 2048
+        };
+    };
+
+    template <>
+    struct MfmaPerfTraits<ArchGfx12, bfloat16_t>
+    {
+        enum : uint32_t
+        {
+            Multiplier = 1024
+        };
+    };
+
+    template <>
+    struct MfmaPerfTraits<ArchGfx12, float16_t>
+    {
+        enum : uint32_t
+        {
+            Multiplier = 1024
+        };
+    };
+
+    template <>
+    struct MfmaPerfTraits<ArchGfx12, float32_t>
+    {
+        enum : uint32_t
+        {
+            Multiplier = 0
+        };
+    };
+
+    template <>
+    struct MfmaPerfTraits<ArchGfx12, xfloat32_t>
+    {
+        enum : uint32_t
+        {
+            Multiplier = 0
+        };
+    };
+
+    template <>
+    struct MfmaPerfTraits<ArchGfx12, float64_t>
+    {
+        enum : uint32_t
+        {
+            Multiplier = 0
+        };
+    };
+
 #if !ROCWMMA_TESTS_NO_HALF
     template <typename GfxArch>
     struct MfmaPerfTraits<GfxArch, hfloat16_t> : public MfmaPerfTraits<GfxArch, float16_t>
@@ -387,6 +612,53 @@ namespace rocwmma
                * static_cast<double>(cuCount) * static_cast<double>(freqMHz) * 1.0e-3;
     }
 
+    // Theoretical DRAM bandwidth from the memory clock (double data rate) and bus width.
+    inline double calculatePeakGBytesPerSec(uint32_t memFreqMHz, uint32_t busWidthBits)
+    {
+        return 2.0 * static_cast<double>(memFreqMHz) * static_cast<double>(busWidthBits) / 8.0
+               * 1.0e-3;
+    }
+
+    // Compulsory GEMM traffic: A and B read once, C read once and D written once.
+    template <typename InputT, typename OutputT>
+    inline double calculateGemmGBytes(uint32_t m, uint32_t n, uint32_t k)
+    {
+        auto elementsAB = static_cast<double>(m) * static_cast<double>(k)
+                          + static_cast<double>(k) * static_cast<double>(n);
+        auto elementsCD = 2.0 * static_cast<double>(m) * static_cast<double>(n);
+        return (elementsAB * sizeof(InputT) + elementsCD * sizeof(OutputT)) * 1.0e-9;
+    }
+
+    // Attainable throughput for a given arithmetic intensity (flops per byte):
+    // the lesser of the compute roof and the bandwidth roof.
+    inline double calculateRooflineGFlopsPerSec(double peakGFlopsPerSec,
+                                                double peakGBytesPerSec,
+                                                double flopsPerByte)
+    {
+        return std::min(peakGFlopsPerSec, peakGBytesPerSec * flopsPerByte);
+    }
+
+    inline bool isMemoryBound(double peakGFlopsPerSec, double peakGBytesPerSec, double flopsPerByte)
+    {
+        return peakGBytesPerSec * flopsPerByte < peakGFlopsPerSec;
+    }
+
+    // Efficiency in percent of the applicable roof, or -1 when the roof is unknown.
+    inline int32_t calculatePercentOfRoof(double measuredTFlopsPerSec, double roofGFlopsPerSec)
+    {
+        return roofGFlopsPerSec > 0.0
+                   ? static_cast<int32_t>(
+                       std::round(measuredTFlopsPerSec / roofGFlopsPerSec * 100000.0))
+                   : -1;
+    }
+
+    // Energy efficiency from the board energy of one run: GFlops per joule, i.e. GFlops/s per
+    // watt. 0 when the energy is unknown.
+    inline double calculateGFlopsPerWatt(double gFlops, double joulesPerRun)
+    {
+        return joulesPerRun > 0.0 ? gFlops / joulesPerRun : 0.0;
+    }
+
 } // namespace rocwmma
 
 #endif // ROCWMMA_PERFORMANCE_HPP
@@ -0,0 +1,107 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef ROCWMMA_TEST_PROFILE_STAMPS_HPP
+#define ROCWMMA_TEST_PROFILE_STAMPS_HPP
+
+#include <iostream>
+#include <vector>
+
+#include <rocwmma/rocwmma_profile.hpp>
+
+#include "common.hpp"
+
+namespace rocwmma
+{
+    // Host side owner of a device stamp buffer.
+    // Binding with profile::set_stamp_buffer() is left to the caller, as it must happen in
+    // the translation unit of the instrumented kernel.
+    class ProfileStamps
+    {
+    public:
+        enum : uint32_t
+        {
+            DefaultCapacity = 4096u
+        };
+
+        ProfileStamps(uint32_t waveCount, uint32_t capacity = DefaultCapacity)
+        {
+            auto recordCount = static_cast<size_t>(waveCount) * capacity;
+
+            mBuffer.capacity  = capacity;
+            mBuffer.waveCount = waveCount;
+            CHECK_HIP_ERROR(
+                hipMalloc(&mBuffer.records, recordCount * sizeof(profile::stamp_record)));
+            CHECK_HIP_ERROR(hipMalloc(&mBuffer.counts, waveCount * sizeof(uint32_t)));
+            CHECK_HIP_ERROR(hipMemset(mBuffer.counts, 0, waveCount * sizeof(uint32_t)));
+        }
+
+        ~ProfileStamps()
+        {
+            CHECK_HIP_ERROR(hipFree(mBuffer.records));
+            CHECK_HIP_ERROR(hipFree(mBuffer.counts));
+        }
+
+        ProfileStamps(ProfileStamps const&)            = delete;
+        ProfileStamps& operator=(ProfileStamps const&) = delete;
+
+        profile::stamp_buffer const& buffer() const
+        {
+            return mBuffer;
+        }
+
+        // Copies the rings back to host and decodes them
+        profile::phase_summary summary() const
+        {
+            auto recordCount = static_cast<size_t>(mBuffer.waveCount) * mBuffer.capacity;
+
+            std::vector<profile::stamp_record> records(recordCount);
+            std::vector<uint32_t>              counts(mBuffer.waveCount);
+            CHECK_HIP_ERROR(hipMemcpy(records.data(),
+                                      mBuffer.records,
+                                      recordCount * sizeof(profile::stamp_record),
+                                      hipMemcpyDeviceToHost));
+            CHECK_HIP_ERROR(hipMemcpy(counts.data(),
+                                      mBuffer.counts,
+                                      mBuffer.waveCount * sizeof(uint32_t),
+                                      hipMemcpyDeviceToHost));
+
+            return profile::decode_stamps(
+                records.data(), counts.data(), mBuffer.capacity, mBuffer.waveCount);
+        }
+
+        std::ostream& report(std::ostream& stream = std::cout) const
+        {
+            return profile::print_phase_summary(stream, summary());
+        }
+
+    private:
+        profile::stamp_buffer mBuffer = {};
+    };
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_TEST_PROFILE_STAMPS_HPP
@@ -51,9 +51,33 @@ namespace rocwmma
                   ComputeT       alpha,
                   ComputeT       beta);
 
+    // Unblocked triple loop, as a reference for gemm_CPU
+    template <typename InputT,
+              typename OutputT,
+              typename ComputeT,
+              typename LayoutA,
+              typename LayoutB,
+              typename LayoutC,
+              typename LayoutD>
+    void gemm_CPU_naive(uint32_t       m,
+                        uint32_t       n,
+                        uint32_t       k,
+                        InputT const*  a,
+                        InputT const*  b,
+                        OutputT const* c,
+                        OutputT*       d,
+                        ComputeT       alpha,
+                        ComputeT       beta);
+
+    // DLRM interaction references, accumulating in float32_t.
+    // Accumulators are multiplied by outputScale before the conversion to DataT.
     template <typename DataT>
-    void
-        dlrm_fwd_CPU(DataT const* input, DataT* output, uint32_t m, uint32_t k, uint32_t batchSize);
+    void dlrm_fwd_CPU(DataT const* input,
+                      DataT*       output,
+                      uint32_t     m,
+                      uint32_t     k,
+                      uint32_t     batchSize,
+                      float32_t    outputScale = 1.0f);
 
     template <typename DataT>
     void dlrm_bwd_CPU(DataT const* input,
@@ -62,7 +86,8 @@ namespace rocwmma
                       DataT*       output,
                       uint32_t     m,
                       uint32_t     k,
-                      uint32_t     batchSize);
+                      uint32_t     batchSize,
+                      float32_t    outputScale = 1.0f);
 
     template <uint32_t ElementIdx,
               uint32_t GroupSize,
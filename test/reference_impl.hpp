@@ -26,9 +26,13 @@
 #ifndef ROCWMMA_REFERENCE_IMPL_HPP
 #define ROCWMMA_REFERENCE_IMPL_HPP
 
+#include <algorithm>
+#include <vector>
+
 #include "hip_device.hpp"
 #include "reference.hpp"
 #include <rocwmma/internal/pack_util.hpp>
+#include <rocwmma/internal/utils.hpp>
 
 namespace rocwmma
 {
@@ -49,6 +53,123 @@ namespace rocwmma
                   OutputT*       d,
                   ComputeT       alpha,
                   ComputeT       beta)
+    {
+        // Cache blocking of the output tile and of K. Each thread packs an
+        // MB x KB panel of A and a KB x NB panel of B as ComputeT, so that
+        // emulated input types (f8, bf8, xf32, f16) are converted once per
+        // panel instead of once per multiply. B panels are packed along N so
+        // the inner loop runs over contiguous independent accumulators, which
+        // the compiler vectorizes without re-associating the K sum.
+        constexpr uint32_t MB = 64u;
+        constexpr uint32_t NB = 64u;
+        constexpr uint32_t KB = 128u;
+
+        uint64_t lda = std::is_same<LayoutA, row_major>::value ? k : m;
+        uint64_t ldb = std::is_same<LayoutB, row_major>::value ? n : k;
+        uint64_t ldc = std::is_same<LayoutC, row_major>::value ? n : m;
+        uint64_t ldd = std::is_same<LayoutD, row_major>::value ? n : m;
+
+        auto rowMjr = [](uint64_t row, uint64_t col, uint64_t ld) { return row * ld + col; };
+        auto colMjr = [](uint64_t row, uint64_t col, uint64_t ld) { return col * ld + row; };
+
+        auto aIndex = std::is_same<LayoutA, row_major>::value ? rowMjr : colMjr;
+        auto bIndex = std::is_same<LayoutB, row_major>::value ? rowMjr : colMjr;
+        auto cIndex = std::is_same<LayoutC, row_major>::value ? rowMjr : colMjr;
+        auto dIndex = std::is_same<LayoutD, row_major>::value ? rowMjr : colMjr;
+
+        int blocksM = static_cast<int>(ceilDiv(m, MB));
+        int blocksN = static_cast<int>(ceilDiv(n, NB));
+
+#pragma omp parallel
+        {
+            // Per-thread packed panels and accumulator tile
+            std::vector<ComputeT> aPanel(MB * KB);
+            std::vector<ComputeT> bPanel(KB * NB);
+            std::vector<ComputeT> accum(MB * NB);
+
+#pragma omp for collapse(2) schedule(dynamic)
+            for(int bm = 0; bm < blocksM; ++bm)
+            {
+                for(int bn = 0; bn < blocksN; ++bn)
+                {
+                    uint32_t i0 = bm * MB;
+                    uint32_t j0 = bn * NB;
+                    uint32_t mb = std::min(MB, m - i0);
+                    uint32_t nb = std::min(NB, n - j0);
+
+                    std::fill(accum.begin(), accum.end(), static_cast<ComputeT>(0));
+
+                    // K blocks in ascending order keep the naive accumulation order
+                    for(uint32_t h0 = 0; h0 < k; h0 += KB)
+                    {
+                        uint32_t kb = std::min(KB, k - h0);
+
+                        // Pack A panel as MB x KB row major
+                        for(uint32_t i = 0; i < mb; ++i)
+                        {
+                            for(uint32_t h = 0; h < kb; ++h)
+                            {
+                                aPanel[i * KB + h]
+                                    = static_cast<ComputeT>(a[aIndex(i0 + i, h0 + h, lda)]);
+                            }
+                        }
+
+                        // Pack B panel as KB x NB row major
+                        for(uint32_t h = 0; h < kb; ++h)
+                        {
+                            for(uint32_t j = 0; j < nb; ++j)
+                            {
+                                bPanel[h * NB + j]
+                                    = static_cast<ComputeT>(b[bIndex(h0 + h, j0 + j, ldb)]);
+                            }
+                        }
+
+                        for(uint32_t i = 0; i < mb; ++i)
+                        {
+                            auto* accumRow = accum.data() + i * NB;
+                            for(uint32_t h = 0; h < kb; ++h)
+                            {
+                                auto  aVal = aPanel[i * KB + h];
+                                auto* bRow = bPanel.data() + h * NB;
+#pragma omp simd
+                                for(uint32_t j = 0; j < nb; ++j)
+                                {
+                                    accumRow[j] += aVal * bRow[j];
+                                }
+                            }
+                        }
+                    }
+
+                    for(uint32_t i = 0; i < mb; ++i)
+                    {
+                        for(uint32_t j = 0; j < nb; ++j)
+                        {
+                            d[dIndex(i0 + i, j0 + j, ldd)] = static_cast<OutputT>(
+                                alpha * accum[i * NB + j]
+                                + beta * static_cast<ComputeT>(c[cIndex(i0 + i, j0 + j, ldc)]));
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    template <typename InputT,
+              typename OutputT,
+              typename ComputeT,
+              typename LayoutA,
+              typename LayoutB,
+              typename LayoutC,
+              typename LayoutD>
+    void gemm_CPU_naive(uint32_t       m,
+                        uint32_t       n,
+                        uint32_t       k,
+                        InputT const*  a,
+                        InputT const*  b,
+                        OutputT const* c,
+                        OutputT*       d,
+                        ComputeT       alpha,
+                        ComputeT       beta)
     {
         int lda = std::is_same<LayoutA, row_major>::value ? k : m;
         int ldb = std::is_same<LayoutB, row_major>::value ? n : k;
@@ -81,7 +202,12 @@ namespace rocwmma
     }
 
     template <typename DataT>
-    void dlrm_fwd_CPU(DataT const* input, DataT* output, uint32_t m, uint32_t k, uint32_t batchSize)
+    void dlrm_fwd_CPU(DataT const* input,
+                      DataT*       output,
+                      uint32_t     m,
+                      uint32_t     k,
+                      uint32_t     batchSize,
+                      float32_t    outputScale)
     {
         auto batchOffset       = m * k;
         uint outputBatchOffset = ((m * (m - 1)) / 2) + k;
@@ -110,7 +236,7 @@ namespace rocwmma
 
                     if(j < i)
                     {
-                        output[outputIdx] = static_cast<DataT>(accum);
+                        output[outputIdx] = static_cast<DataT>(accum * outputScale);
                         outputIdx++;
                     }
                 }
@@ -125,7 +251,8 @@ namespace rocwmma
                       DataT*       output,
                       uint32_t     m,
                       uint32_t     k,
-                      uint32_t     batchSize)
+                      uint32_t     batchSize,
+                      float32_t    outputScale)
     {
         auto batchOffset = m * k;
         auto accOffset   = m * m;
@@ -171,7 +298,7 @@ namespace rocwmma
                         accum += static_cast<float>(acc[b * accOffset + i * m + h])
                                  * static_cast<float>(input[b * batchOffset + h * k + j]);
                     }
-                    output[b * batchOffset + i * k + j] = static_cast<DataT>(accum);
+                    output[b * batchOffset + i * k + j] = static_cast<DataT>(accum * outputScale);
                 }
             }
         }
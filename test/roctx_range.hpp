@@ -0,0 +1,75 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef ROCWMMA_TEST_ROCTX_RANGE_HPP
+#define ROCWMMA_TEST_ROCTX_RANGE_HPP
+
+#include <sstream>
+#include <string>
+
+// ROCTX annotations are compiled out unless building with -DROCWMMA_BUILD_WITH_ROCTX=ON
+#if !defined(ROCWMMA_ROCTX)
+#define ROCWMMA_ROCTX 0
+#endif // !defined(ROCWMMA_ROCTX)
+
+#if ROCWMMA_ROCTX
+#include <roctracer/roctx.h>
+#endif // ROCWMMA_ROCTX
+
+namespace rocwmma
+{
+    // Scoped ROCTX range, named by the concatenation of the given parts.
+    // Ranges nest on the calling thread and show up in rocprof and Omnitrace
+    // timelines around the kernels enqueued within them.
+    class RoctxRange
+    {
+    public:
+        template <typename... Parts>
+        explicit RoctxRange(Parts const&... parts)
+        {
+#if ROCWMMA_ROCTX
+            std::stringstream name;
+            (name << ... << parts);
+            roctxRangePushA(name.str().c_str());
+#else
+            ((void)parts, ...);
+#endif // ROCWMMA_ROCTX
+        }
+
+        ~RoctxRange()
+        {
+#if ROCWMMA_ROCTX
+            roctxRangePop();
+#endif // ROCWMMA_ROCTX
+        }
+
+        RoctxRange(RoctxRange const&)            = delete;
+        RoctxRange& operator=(RoctxRange const&) = delete;
+    };
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_TEST_ROCTX_RANGE_HPP
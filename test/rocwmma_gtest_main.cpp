@@ -25,6 +25,7 @@
  *******************************************************************************/
 
 #include "common.hpp"
+#include "device_shards.hpp"
 #include "rocwmma_logging.hpp"
 #include <gtest/gtest.h>
 
@@ -34,11 +35,47 @@ int main(int argc, char** argv)
     auto& loggingOptions = Options::instance();
     loggingOptions->parseOptions(argc, argv);
 
+    // Split the tests across one worker process per device
+    if(auto shardDevices = loggingOptions->shardDevices(); shardDevices >= 0)
+    {
+        auto shards = rocwmma::DeviceShards::count(shardDevices);
+        if(shards > 1u)
+        {
+            return rocwmma::DeviceShards::run(argc, argv, shards);
+        }
+
+        // A single device runs in this process
+        loggingOptions->openOutputs();
+    }
+
+    if(auto device = loggingOptions->device(); device >= 0)
+    {
+        CHECK_HIP_ERROR(hipSetDevice(device));
+    }
+
     // Initialize Google Tests
     testing::InitGoogleTest(&argc, argv);
 
     // Run the tests
     int status = RUN_ALL_TESTS();
 
+    // Compare recorded benchmarks against the baseline, failing on regressions
+    auto& baselineFile = loggingOptions->benchBaselineFile();
+    if(!baselineFile.empty())
+    {
+        std::vector<rocwmma::BenchmarkRecord> baseline;
+        if(!rocwmma::BenchmarkLog::load(baselineFile, baseline))
+        {
+            std::cerr << "Unable to load benchmark baseline: " << baselineFile << std::endl;
+            status = EXIT_FAILURE;
+        }
+        else if(rocwmma::BenchmarkLog::instance()->compare(baseline,
+                                                           loggingOptions->benchThreshold())
+                > 0u)
+        {
+            status = EXIT_FAILURE;
+        }
+    }
+
     return status;
 }
@@ -27,6 +27,8 @@
 #ifndef ROCWMMA_LOGGING_HPP
 #define ROCWMMA_LOGGING_HPP
 
+#include "benchmark_log.hpp"
+#include "counter_collector.hpp"
 #include "rocwmma/rocwmma-version.hpp"
 #include "rocwmma_ostream.hpp"
 #include "singleton.hpp"
@@ -54,7 +56,20 @@ namespace rocwmma
             , mOmitFailed(false)
             , mOmitPassed(false)
             , mOmitCout(false)
+            , mBenchThreshold(5.0)
+            , mPerfTolerance(5.0)
+            , mPerfStrict(false)
+            , mHipGraph(false)
+            , mEnergy(false)
+            , mDevice(-1)
+            , mShardDevices(-1)
         {
+#ifdef ROCWMMA_PERF_GOLDEN_DIR
+            // Perf regression suites check against the in-tree goldens by default,
+            // and fail cases that have none
+            mPerfGoldenDir = ROCWMMA_PERF_GOLDEN_DIR;
+            mPerfStrict    = true;
+#endif
         }
 
         void setOmits(int mask)
@@ -101,9 +116,159 @@ namespace rocwmma
                     }
                     setOmits(std::stoi(args[i + 1]));
                 }
+                if(args[i] == "-tt" || args[i] == "--tuning_table")
+                {
+                    if(i + 2 >= argc)
+                    {
+                        std::cerr << "Missing tuning table file\n";
+                        std::cerr << "Usage: -tt || --tuning_table *file.csv*\n";
+                        exit(EXIT_FAILURE);
+                    }
+                    mTuningTableFile = args[i + 1];
+                    i++;
+                }
+                if(args[i] == "-bl" || args[i] == "--bench_list")
+                {
+                    if(i + 2 >= argc)
+                    {
+                        std::cerr << "Missing benchmark list file\n";
+                        std::cerr << "Usage: -bl || --bench_list *file.csv*\n";
+                        exit(EXIT_FAILURE);
+                    }
+                    mBenchListFile = args[i + 1];
+                    i++;
+                }
+                if(args[i] == "-ps" || args[i] == "--perf_strict")
+                {
+                    mPerfStrict = true;
+                }
+                if(args[i] == "-hg" || args[i] == "--hip_graph")
+                {
+                    mHipGraph = true;
+                }
+                if(args[i] == "-en" || args[i] == "--energy")
+                {
+                    mEnergy = true;
+                }
+                if(args[i] == "-bo" || args[i] == "--bench_output")
+                {
+                    if(i + 2 >= argc)
+                    {
+                        std::cerr << "Missing benchmark output file\n";
+                        std::cerr << "Usage: -bo || --bench_output *file.json|file.csv*\n";
+                        exit(EXIT_FAILURE);
+                    }
+                    mBenchOutputFile = args[i + 1];
+                    i++;
+                }
+                if(args[i] == "-bb" || args[i] == "--bench_baseline")
+                {
+                    if(i + 2 >= argc)
+                    {
+                        std::cerr << "Missing benchmark baseline file\n";
+                        std::cerr << "Usage: -bb || --bench_baseline *file.json|file.csv*\n";
+                        exit(EXIT_FAILURE);
+                    }
+                    mBenchBaselineFile = args[i + 1];
+                    i++;
+                }
+                if(args[i] == "-bt" || args[i] == "--bench_threshold")
+                {
+                    if(i + 2 >= argc)
+                    {
+                        std::cerr << "Missing benchmark regression threshold\n";
+                        std::cerr << "Usage: -bt || --bench_threshold *percent*\n";
+                        exit(EXIT_FAILURE);
+                    }
+                    mBenchThreshold = std::stod(args[i + 1]);
+                    i++;
+                }
+                if(args[i] == "-pg" || args[i] == "--perf_golden")
+                {
+                    if(i + 2 >= argc)
+                    {
+                        std::cerr << "Missing perf golden directory\n";
+                        std::cerr << "Usage: -pg || --perf_golden *directory*\n";
+                        exit(EXIT_FAILURE);
+                    }
+                    mPerfGoldenDir = args[i + 1];
+                    i++;
+                }
+                if(args[i] == "-pt" || args[i] == "--perf_tolerance")
+                {
+                    if(i + 2 >= argc)
+                    {
+                        std::cerr << "Missing perf regression tolerance\n";
+                        std::cerr << "Usage: -pt || --perf_tolerance *percent*\n";
+                        exit(EXIT_FAILURE);
+                    }
+                    mPerfTolerance = std::stod(args[i + 1]);
+                    i++;
+                }
+                if(args[i] == "-pc" || args[i] == "--perf_counters")
+                {
+                    if(i + 2 >= argc)
+                    {
+                        std::cerr << "Missing performance counter list\n";
+                        std::cerr << "Usage: -pc || --perf_counters *name,name,...|default*\n";
+                        exit(EXIT_FAILURE);
+                    }
+                    mPerfCounters = CounterCollector::parseCounters(args[i + 1]);
+                    i++;
+                }
+                if(args[i] == "-d" || args[i] == "--device")
+                {
+                    if(i + 2 >= argc)
+                    {
+                        std::cerr << "Missing device id\n";
+                        std::cerr << "Usage: -d || --device *device_id*\n";
+                        exit(EXIT_FAILURE);
+                    }
+                    mDevice = std::stoi(args[i + 1]);
+                    i++;
+                }
+                if(args[i] == "-sd" || args[i] == "--shard_devices")
+                {
+                    if(i + 2 >= argc)
+                    {
+                        std::cerr << "Missing shard device count\n";
+                        std::cerr << "Usage: -sd || --shard_devices *count, 0 for all*\n";
+                        exit(EXIT_FAILURE);
+                    }
+                    mShardDevices = std::stoi(args[i + 1]);
+                    i++;
+                }
+            }
+
+            mOutputStreamFile = fileName;
+
+            // Counters are registered with rocprofiler-sdk before the HIP runtime starts
+            if(!mPerfCounters.empty())
+            {
+                if(!CounterCollector::instance()->initialize(mPerfCounters))
+                {
+                    std::cerr << "Performance counters require ROCWMMA_BUILD_WITH_ROCPROFILER\n";
+                    exit(EXIT_FAILURE);
+                }
+                BenchmarkLog::instance()->setCounterNames(mPerfCounters);
             }
 
-            mOstream.initializeStream(fileName);
+            // Shard workers write the outputs, which are merged afterwards
+            if(mShardDevices < 0)
+            {
+                openOutputs();
+            }
+        }
+
+        void openOutputs()
+        {
+            mOstream.initializeStream(mOutputStreamFile);
+
+            if(!mBenchOutputFile.empty() && !BenchmarkLog::instance()->open(mBenchOutputFile))
+            {
+                std::cerr << "Unable to open benchmark output: " << mBenchOutputFile << "\n";
+                exit(EXIT_FAILURE);
+            }
         }
 
         rocwmmaOStream& ostream()
@@ -131,8 +296,96 @@ namespace rocwmma
             return mOmitCout;
         }
 
+        std::string const& tuningTableFile()
+        {
+            return mTuningTableFile;
+        }
+
+        std::string const& benchBaselineFile()
+        {
+            return mBenchBaselineFile;
+        }
+
+        std::string const& benchListFile()
+        {
+            return mBenchListFile;
+        }
+
+        double benchThreshold()
+        {
+            return mBenchThreshold;
+        }
+
+        // Golden throughput directory, empty unless perf regressions are checked
+        std::string const& perfGoldenDir()
+        {
+            return mPerfGoldenDir;
+        }
+
+        double perfTolerance()
+        {
+            return mPerfTolerance;
+        }
+
+        // Fail, rather than skip or report, runs without a golden record
+        bool perfStrict()
+        {
+            return mPerfStrict;
+        }
+
+        bool hipGraph()
+        {
+            return mHipGraph;
+        }
+
+        bool energy()
+        {
+            return mEnergy;
+        }
+
+        // Device to run on, or -1 for the current device
+        int device()
+        {
+            return mDevice;
+        }
+
+        // Requested shard worker count: 0 for all visible devices, -1 if not sharding
+        int shardDevices()
+        {
+            return mShardDevices;
+        }
+
+        std::vector<std::string> const& perfCounters()
+        {
+            return mPerfCounters;
+        }
+
+        std::string const& outputStreamFile()
+        {
+            return mOutputStreamFile;
+        }
+
+        std::string const& benchOutputFile()
+        {
+            return mBenchOutputFile;
+        }
+
     protected:
-        rocwmmaOStream mOstream;
+        rocwmmaOStream           mOstream;
+        std::string              mOutputStreamFile;
+        std::string              mTuningTableFile;
+        std::string              mBenchOutputFile;
+        std::string              mBenchBaselineFile;
+        std::string              mBenchListFile;
+        std::string              mPerfGoldenDir;
+        std::vector<std::string> mPerfCounters;
+        double                   mBenchThreshold;
+        double                   mPerfTolerance;
+        bool                     mPerfStrict;
+        bool                     mHipGraph;
+        bool                     mEnergy;
+        int                      mDevice;
+        int                      mShardDevices;
 
         bool mOmitSkipped, mOmitFailed, mOmitPassed, mOmitCout;
     };
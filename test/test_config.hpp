@@ -61,13 +61,19 @@
 #define ROCWMMA_VALIDATE_WITH_ROCBLAS 0
 #endif
 
+#if defined(ROCWMMA_BENCHMARK_WITH_HIPBLASLT)
+#define ROCWMMA_BENCHMARK_WITH_HIPBLASLT 1
+#else
+#define ROCWMMA_BENCHMARK_WITH_HIPBLASLT 0
+#endif
+
 #if ROCWMMA_BENCHMARK_WITH_ROCBLAS || ROCWMMA_VALIDATE_WITH_ROCBLAS
 #define ROCWMMA_ROCBLAS_INTEGRATION 1
 #else
 #define ROCWMMA_ROCBLAS_INTEGRATION 0
 #endif
 
-#if ROCWMMA_VALIDATION_TESTS && !ROCWMMA_VALIDATE_WITH_ROCBLAS
+#if defined(ROCWMMA_VALIDATE_WITH_CPU)
 #define ROCWMMA_VALIDATE_WITH_CPU 1
 #else
 #define ROCWMMA_VALIDATE_WITH_CPU 0
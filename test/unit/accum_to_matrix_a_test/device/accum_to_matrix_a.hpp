@@ -0,0 +1,111 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef ROCWMMA_DEVICE_ACCUM_TO_MATRIX_A_HPP
+#define ROCWMMA_DEVICE_ACCUM_TO_MATRIX_A_HPP
+
+#include <rocwmma/internal/mapping_util.hpp>
+#include <rocwmma/rocwmma.hpp>
+#include <rocwmma/rocwmma_transforms.hpp>
+
+#include "unit_test_traits.hpp"
+
+namespace rocwmma
+{
+
+    // The accumulator register layout of C^T matches the matrix_a layout of C on:
+    // - gfx9: 16 x 16 blocks, or 32 x 32 blocks of 32-bit data
+    // - gfx12: 16 x 16 blocks of 8 and 16-bit data
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              typename DataT,
+              typename Layout,
+              uint32_t WaveSize,
+              uint32_t ArchId>
+    struct AccumToMatrixA_guard
+    {
+        using TestTraits = UnitTestTraits<BlockM, BlockN, DataT, Layout, WaveSize, ArchId>;
+
+    private:
+        enum struct Gfx9Predicates : bool
+        {
+            BlockTest = ((BlockM == 16u && BlockN == 16u && sizeof(DataT) <= 4u)
+                         || (BlockM == 32u && BlockN == 32u && sizeof(DataT) == 4u)),
+            Enable    = ((bool)TestTraits::IsGfx9 && (bool)TestTraits::IsWave64 && BlockTest)
+        };
+
+        enum struct Gfx12Predicates : bool
+        {
+            BlockTest = (BlockM == 16u && BlockN == 16u && sizeof(DataT) <= 2u),
+            Enable    = ((bool)TestTraits::IsGfx12 && (bool)TestTraits::IsWave32 && BlockTest)
+        };
+
+    public:
+        constexpr static bool enable()
+        {
+            return ((bool)Gfx9Predicates::Enable || (bool)Gfx12Predicates::Enable);
+        }
+    };
+
+    template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename DataLayout>
+    __global__ void AccumToMatrixA(uint32_t     m,
+                                   uint32_t     n,
+                                   DataT const* in,
+                                   DataT*       out,
+                                   uint32_t     ld,
+                                   DataT        param1,
+                                   DataT        param2)
+    {
+        if constexpr(AccumToMatrixA_guard<BlockM,
+                                          BlockN,
+                                          DataT,
+                                          DataLayout,
+                                          Constants::AMDGCN_WAVE_SIZE,
+                                          Constants::AMDGCN_CURRENT_ARCH_ID>::enable())
+        {
+            using Mapping = MappingUtil<BlockM, BlockN, DataT, DataLayout>;
+
+            // Mapping:
+            // Incoming -> Matrix C^T (RowNT)
+            // BlockM -> BlockM
+            // BlockN -> BlockN
+            // <Dummy> -> BlockK
+            auto frag = fragment<accumulator, BlockM, BlockN, 1, DataT, DataLayout>();
+
+            // Map, load and reinterpret as matrix_a of C (BlockN x BlockM).
+            auto* read  = Mapping::dataCoord(in, ld);
+            auto* write = Mapping::dataCoord(out, ld);
+            load_matrix_sync(frag, read, ld);
+
+            // Storing C in the orthogonal layout writes back C^T, the input block.
+            auto fragA = applyAccumToMatrixA<BlockM>(frag);
+            store_matrix_sync(write, fragA, ld);
+        }
+    }
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_DEVICE_ACCUM_TO_MATRIX_A_HPP
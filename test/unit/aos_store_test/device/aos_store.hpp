@@ -0,0 +1,171 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef ROCWMMA_DEVICE_AOS_STORE_HPP
+#define ROCWMMA_DEVICE_AOS_STORE_HPP
+
+#include <rocwmma/internal/aos_store.hpp>
+#include <rocwmma/internal/mapping_util.hpp>
+#include <rocwmma/internal/opaque_load.hpp>
+#include <rocwmma/rocwmma.hpp>
+
+#include "unit_test_traits.hpp"
+
+namespace rocwmma
+{
+
+    // Store paths of a row_major accumulator block
+    struct AosStorePath
+    {
+        enum : uint32_t
+        {
+            // store_matrix_sync, as selected by IOConfig
+            Selected = 0u,
+
+            // VW = 1 stores in mma order
+            Direct = 1u,
+
+            // SoaToAos, then stores of VW along BlockDim in AOS order
+            SoaToAos = 2u
+        };
+    };
+
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              typename DataT,
+              typename DataLayout,
+              uint32_t VectorWidth>
+    __global__ void AosStorePaths(uint32_t     m,
+                                  uint32_t     n,
+                                  DataT const* in,
+                                  DataT*       out,
+                                  uint32_t     ld,
+                                  DataT        param1,
+                                  DataT        param2)
+    {
+        if constexpr(FragSize_guard<BlockM,
+                                    BlockN,
+                                    DataT,
+                                    DataLayout,
+                                    Constants::AMDGCN_WAVE_SIZE,
+                                    Constants::AMDGCN_CURRENT_ARCH_ID>::enable())
+        {
+            using Mapping = MappingUtil<BlockM, BlockN, DataT, DataLayout>;
+
+            // Mapping:
+            // Incoming -> Matrix C (RowNT)
+            // BlockM -> BlockM
+            // BlockN -> BlockN
+            // <Dummy> -> BlockK
+            using FragT = fragment<accumulator, BlockM, BlockN, 1, DataT, DataLayout>;
+
+            using IOConfig = GetIOConfig_t<FragT>;
+            using IOShape  = GetIOShape_t<FragT>;
+            using IOLayout = typename IOConfig::IOLayout;
+
+            constexpr uint32_t BlockDim = IOShape::BlockDim;
+            constexpr uint32_t BlockK   = IOShape::KDim;
+
+            // Pin the path store_matrix_sync takes for this fragment
+            constexpr bool ExpectAosStore
+                = is_same<DataLayout, row_major>::value
+                  && detail::SoaLoadSelector<BlockDim, BlockK, DataT, IOLayout::MaxVW, 8u>::Result;
+            static_assert((bool)IOLayout::AosStore == ExpectAosStore,
+                          "IOLayout does not follow SoaLoadSelector");
+            static_assert(BlockDim <= 32u || !(bool)IOLayout::AosStore,
+                          "Wide AOS stores are only for BlockDim <= 32");
+            static_assert(!(bool)IOLayout::SoaLoad, "Accumulators load in mma order");
+            static_assert(
+                is_same<typename IOConfig::Storer,
+                        conditional_t<ExpectAosStore,
+                                      AosStore<BlockDim,
+                                               BlockK,
+                                               DataT,
+                                               typename IOLayout::DataLayout,
+                                               typename IOLayout::AosStoreMatrixLayout,
+                                               IOLayout::MaxVW>,
+                                      OpaqueStore<BlockDim,
+                                                  BlockK,
+                                                  DataT,
+                                                  typename IOLayout::DataLayout,
+                                                  typename IOLayout::MatrixLayout,
+                                                  IOLayout::VW>>>::value,
+                "Unexpected storer for store_matrix_sync");
+
+            // Both paths store the SOA registers of MaxVW = VectorWidth, which are
+            // loaded directly in the same order.
+            using DirectLayout
+                = rocwmma::MatrixLayout::RowOrthoVW<BlockDim, BlockK, DataT, 1, VectorWidth>;
+            using AosLayout = rocwmma::MatrixLayout::
+                RowInlineVW<BlockDim, BlockK, DataT, VectorWidth, VectorWidth>;
+
+            using DirectLoader = OpaqueLoad<BlockDim,
+                                            BlockK,
+                                            DataT,
+                                            typename IOLayout::DataLayout,
+                                            DirectLayout,
+                                            1>;
+            using DirectStorer = OpaqueStore<BlockDim,
+                                             BlockK,
+                                             DataT,
+                                             typename IOLayout::DataLayout,
+                                             DirectLayout,
+                                             1>;
+            using AosStorer    = AosStore<BlockDim,
+                                       BlockK,
+                                       DataT,
+                                       typename IOLayout::DataLayout,
+                                       AosLayout,
+                                       VectorWidth>;
+
+            auto frag = FragT();
+
+            auto* read  = Mapping::dataCoord(in, ld);
+            auto* write = Mapping::dataCoord(out, ld);
+
+            // param1 selects the store path
+            auto path = static_cast<uint32_t>(static_cast<float32_t>(param1));
+            if(path == AosStorePath::Direct)
+            {
+                DirectLoader::exec(frag.mAccess, read, ld);
+                DirectStorer::exec(write, frag.mAccess, ld);
+            }
+            else if(path == AosStorePath::SoaToAos)
+            {
+                DirectLoader::exec(frag.mAccess, read, ld);
+                AosStorer::exec(write, frag.mAccess, ld);
+            }
+            else
+            {
+                load_matrix_sync(frag, read, ld);
+                store_matrix_sync(write, frag, ld);
+            }
+        }
+    }
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_DEVICE_AOS_STORE_HPP
@@ -0,0 +1,111 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <type_traits>
+
+#include "detail/aos_store.hpp"
+#include "kernel_generator.hpp"
+#include "unit_test.hpp"
+
+namespace rocwmma
+{
+
+    // Pin the SoaLoadSelector decisions for stores, with their IssueWeight of 8.
+    // Both wave sizes agree. Small float32_t and float16_t accumulators store through
+    // SoaToAos, including the VW 2 and 16 boundaries.
+    static_assert(detail::SoaLoadSelector<16, 16, float32_t, 4, 8>::Result, "");
+    static_assert(detail::SoaLoadSelector<32, 32, float32_t, 4, 8>::Result, "");
+    static_assert(detail::SoaLoadSelector<16, 16, float16_t, 4, 8>::Result, "");
+    static_assert(detail::SoaLoadSelector<16, 64, float32_t, 2, 8>::Result, "");
+    static_assert(detail::SoaLoadSelector<16, 64, float32_t, 16, 8>::Result, "");
+
+    // At the load weight, the same float32_t block is a cost tie and stays direct
+    static_assert(!detail::SoaLoadSelector<16, 16, float32_t, 4>::Result, "");
+
+    // BlockDim 256, float64_t and VW 1 always store directly
+    static_assert(!detail::SoaLoadSelector<256, 16, float32_t, 2, 8>::Result, "");
+    static_assert(!detail::SoaLoadSelector<256, 16, float32_t, 16, 8>::Result, "");
+    static_assert(!detail::SoaLoadSelector<16, 16, float64_t, 2, 8>::Result, "");
+    static_assert(!detail::SoaLoadSelector<16, 16, float32_t, 1, 8>::Result, "");
+
+    // col_major accumulators already store MaxVW wide vectors, and no accumulator
+    // loads through AosToSoa
+    static_assert(!IOLayout<accumulator, 16, 16, float32_t, col_major, 1>::AosStore, "");
+    static_assert(!IOLayout<accumulator, 16, 16, float64_t, row_major, 1>::AosStore, "");
+    static_assert(!IOLayout<accumulator, 16, 16, float32_t, row_major, 1>::SoaLoad, "");
+
+    struct TestParams : public UnitTestParams
+    {
+        using Base = UnitTestParams;
+
+        // Types: float16_t, float32_t
+        // Block Sizes: 64 x 16, 32 x 32 and 16 x 256, BlockDim 16, 32 and 256
+        // Layouts: row_major, where accumulator registers run along BlockK
+        // Vector Widths: 2, 4, 16
+        using Types        = std::tuple<float16_t, float32_t>;
+        using BlockSizes   = std::tuple<std::tuple<I<64>, I<16>>,
+                                      std::tuple<I<32>, I<32>>,
+                                      std::tuple<I<16>, I<256>>>;
+        using Layouts      = std::tuple<row_major>;
+        using VectorWidths = std::tuple<I<2>, I<4>, I<16>>;
+        using KernelParams =
+            typename CombineLists<Types, BlockSizes, Layouts, VectorWidths>::Result;
+
+        // Assemble the kernel generator
+        // Kernel: AosStorePaths
+        using GeneratorImpl   = AosStoreGenerator;
+        using KernelGenerator = KernelGenerator<KernelParams, GeneratorImpl>;
+
+        // Sanity check for kernel generator
+        static_assert(std::is_same<typename GeneratorImpl::ResultT, typename Base::KernelT>::value,
+                      "Kernels from this generator do not match testing interface");
+
+        static inline typename KernelGenerator::ResultT kernels()
+        {
+            return KernelGenerator::generate();
+        }
+    };
+
+} // namespace rocwmma
+
+// Test suite for unique parameterization
+class AosStoreTestAcc : public rocwmma::UnitTest
+{
+};
+
+TEST_P(AosStoreTestAcc, RunKernel)
+{
+    this->RunKernel();
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    KernelTests,
+    AosStoreTestAcc,
+    ::testing::Combine(::testing::ValuesIn(rocwmma::TestParams::kernels()),
+                       ::testing::ValuesIn(rocwmma::TestParams::threadBlocks()),
+                       ::testing::ValuesIn(rocwmma::TestParams::problemSizes()),
+                       ::testing::ValuesIn(rocwmma::TestParams::param1s()),
+                       ::testing::ValuesIn(rocwmma::TestParams::param2s())));
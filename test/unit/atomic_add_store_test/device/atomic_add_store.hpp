@@ -0,0 +1,79 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_DEVICE_ATOMIC_ADD_STORE_HPP
+#define ROCWMMA_DEVICE_ATOMIC_ADD_STORE_HPP
+
+#include <rocwmma/internal/mapping_util.hpp>
+#include <rocwmma/rocwmma.hpp>
+
+#include "unit_test_traits.hpp"
+
+namespace rocwmma
+{
+
+    // Number of partial products atomically added to each block of out
+    constexpr uint32_t AtomicAddStoreTestSplits = 3u;
+
+    // out[row, col] += Splits * in[row, col], as each split adds the same partial block
+    template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename DataLayout>
+    __global__ void AtomicAddStoreAcc(uint32_t     m,
+                                      uint32_t     n,
+                                      DataT const* in,
+                                      DataT*       out,
+                                      uint32_t     ld,
+                                      DataT        param1,
+                                      DataT        param2)
+    {
+        if constexpr(FragSize_guard<BlockM,
+                                    BlockN,
+                                    DataT,
+                                    DataLayout,
+                                    Constants::AMDGCN_WAVE_SIZE,
+                                    Constants::AMDGCN_CURRENT_ARCH_ID>::enable())
+        {
+            using Mapping = MappingUtil<BlockM, BlockN, DataT, DataLayout>;
+
+            // Mapping:
+            // Incoming -> Matrix C (RowNT)
+            // BlockM -> BlockM
+            // BlockN -> BlockN
+            // <Dummy> -> BlockK
+            auto frag = fragment<accumulator, BlockM, BlockN, 1, DataT, DataLayout>();
+
+            // Load in place, then accumulate the splits back in place
+            load_matrix_sync(frag, Mapping::dataCoord(in, ld), ld);
+
+#pragma unroll
+            for(uint32_t i = 0u; i < AtomicAddStoreTestSplits; i++)
+            {
+                store_matrix_atomic_add_sync(Mapping::dataCoord(out, ld), frag, ld);
+            }
+        }
+    }
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_DEVICE_ATOMIC_ADD_STORE_HPP
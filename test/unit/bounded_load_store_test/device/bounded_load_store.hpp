@@ -0,0 +1,193 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef ROCWMMA_DEVICE_BOUNDED_LOAD_STORE_HPP
+#define ROCWMMA_DEVICE_BOUNDED_LOAD_STORE_HPP
+
+#include <rocwmma/internal/mapping_util.hpp>
+#include <rocwmma/rocwmma.hpp>
+
+#include "unit_test_traits.hpp"
+
+namespace rocwmma
+{
+
+    // Valid extent of the block at origin, for a matrix
+    // extent trimmed by the given amount.
+    ROCWMMA_DEVICE inline uint32_t boundedExtent(uint32_t extent, uint32_t trim, uint32_t origin)
+    {
+        return (extent > trim + origin) ? (extent - trim - origin) : 0u;
+    }
+
+    // Loads are bounded to the (m - param1) x (n - param1) matrix.
+    // Stores are bounded to the (m - param2) x (n - param2) matrix.
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              typename DataT,
+              typename DataLayout>
+    __global__ void BoundedLoadStoreA(uint32_t     m,
+                                      uint32_t     n,
+                                      DataT const* in,
+                                      DataT*       out,
+                                      uint32_t     ld,
+                                      DataT        param1,
+                                      DataT        param2)
+    {
+        if constexpr(FragSize_guard<BlockM,
+                                    BlockN,
+                                    DataT,
+                                    DataLayout,
+                                    Constants::AMDGCN_WAVE_SIZE,
+                                    Constants::AMDGCN_CURRENT_ARCH_ID>::enable())
+        {
+            using Mapping = MappingUtil<BlockM, BlockN, DataT, DataLayout>;
+
+            // Mapping:
+            // Incoming -> Matrix A (ColNT)
+            // BlockM -> BlockM
+            // <Dummy> -> BlockN
+            // BlockN -> BlockK
+            auto frag = fragment<matrix_a, BlockM, 1, BlockN, DataT, DataLayout>();
+
+            auto coord     = Mapping::matrixCoord();
+            auto loadTrim  = static_cast<uint32_t>(param1);
+            auto storeTrim = static_cast<uint32_t>(param2);
+
+            // Map, bounded load and bounded store.
+            auto* read  = Mapping::dataCoord(in, ld);
+            auto* write = Mapping::dataCoord(out, ld);
+            load_matrix_bounded_sync(frag,
+                                     read,
+                                     ld,
+                                     boundedExtent(m, loadTrim, get<0>(coord)),
+                                     boundedExtent(n, loadTrim, get<1>(coord)));
+            store_matrix_bounded_sync(write,
+                                      frag,
+                                      ld,
+                                      boundedExtent(m, storeTrim, get<0>(coord)),
+                                      boundedExtent(n, storeTrim, get<1>(coord)));
+        }
+    }
+
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              typename DataT,
+              typename DataLayout>
+    __global__ void BoundedLoadStoreB(uint32_t     m,
+                                      uint32_t     n,
+                                      DataT const* in,
+                                      DataT*       out,
+                                      uint32_t     ld,
+                                      DataT        param1,
+                                      DataT        param2)
+    {
+        if constexpr(FragSize_guard<BlockM,
+                                    BlockN,
+                                    DataT,
+                                    DataLayout,
+                                    Constants::AMDGCN_WAVE_SIZE,
+                                    Constants::AMDGCN_CURRENT_ARCH_ID>::enable())
+        {
+            using Mapping = MappingUtil<BlockM, BlockN, DataT, DataLayout>;
+
+            // Mapping:
+            // Incoming -> Matrix B (RowNT)
+            // <Dummy> -> BlockM
+            // BlockN -> BlockN
+            // BlockM -> BlockK
+            auto frag = fragment<matrix_b, 1, BlockN, BlockM, DataT, DataLayout>();
+
+            auto coord     = Mapping::matrixCoord();
+            auto loadTrim  = static_cast<uint32_t>(param1);
+            auto storeTrim = static_cast<uint32_t>(param2);
+
+            // Map, bounded load and bounded store.
+            auto* read  = Mapping::dataCoord(in, ld);
+            auto* write = Mapping::dataCoord(out, ld);
+            load_matrix_bounded_sync(frag,
+                                     read,
+                                     ld,
+                                     boundedExtent(m, loadTrim, get<0>(coord)),
+                                     boundedExtent(n, loadTrim, get<1>(coord)));
+            store_matrix_bounded_sync(write,
+                                      frag,
+                                      ld,
+                                      boundedExtent(m, storeTrim, get<0>(coord)),
+                                      boundedExtent(n, storeTrim, get<1>(coord)));
+        }
+    }
+
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              typename DataT,
+              typename DataLayout>
+    __global__ void BoundedLoadStoreAcc(uint32_t     m,
+                                        uint32_t     n,
+                                        DataT const* in,
+                                        DataT*       out,
+                                        uint32_t     ld,
+                                        DataT        param1,
+                                        DataT        param2)
+    {
+        if constexpr(FragSize_guard<BlockM,
+                                    BlockN,
+                                    DataT,
+                                    DataLayout,
+                                    Constants::AMDGCN_WAVE_SIZE,
+                                    Constants::AMDGCN_CURRENT_ARCH_ID>::enable())
+        {
+            using Mapping = MappingUtil<BlockM, BlockN, DataT, DataLayout>;
+
+            // Mapping:
+            // Incoming -> Matrix C (Row4T)
+            // BlockM -> BlockM
+            // BlockN -> BlockN
+            // <Dummy> -> BlockK
+            auto frag = fragment<accumulator, BlockM, BlockN, 1, DataT, DataLayout>();
+
+            auto coord     = Mapping::matrixCoord();
+            auto loadTrim  = static_cast<uint32_t>(param1);
+            auto storeTrim = static_cast<uint32_t>(param2);
+
+            // Map, bounded load and bounded store.
+            auto* read  = Mapping::dataCoord(in, ld);
+            auto* write = Mapping::dataCoord(out, ld);
+            load_matrix_bounded_sync(frag,
+                                     read,
+                                     ld,
+                                     boundedExtent(m, loadTrim, get<0>(coord)),
+                                     boundedExtent(n, loadTrim, get<1>(coord)));
+            store_matrix_bounded_sync(write,
+                                      frag,
+                                      ld,
+                                      boundedExtent(m, storeTrim, get<0>(coord)),
+                                      boundedExtent(n, storeTrim, get<1>(coord)));
+        }
+    }
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_DEVICE_BOUNDED_LOAD_STORE_HPP
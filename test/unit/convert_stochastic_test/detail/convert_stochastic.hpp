@@ -0,0 +1,268 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_DETAIL_CONVERT_STOCHASTIC_HPP
+#define ROCWMMA_DETAIL_CONVERT_STOCHASTIC_HPP
+
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include "device/convert_stochastic.hpp"
+#include "helper_macros.hpp"
+#include "unit_kernel_base.hpp"
+
+namespace rocwmma
+{
+
+    // Wrapper into the actual device function
+    template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename Layout, typename OutputT>
+    struct ConvertStochasticKernel : public UnitKernelBase<BlockM, BlockN, DataT, Layout>
+    {
+    private:
+        using Base = UnitKernelBase<BlockM, BlockN, DataT, Layout>;
+
+        // Both the input and output fragments must be supported
+        template <uint32_t WaveSize, uint32_t ArchId>
+        struct TestGuard
+        {
+            static constexpr bool enable()
+            {
+                using InGuard  = FragSize_guard<BlockM, BlockN, DataT, Layout, WaveSize, ArchId>;
+                using OutGuard = FragSize_guard<BlockM, BlockN, OutputT, Layout, WaveSize, ArchId>;
+                return InGuard::enable() && OutGuard::enable();
+            }
+        };
+
+        // Minimum count of inexact inputs before we expect SR to diverge from RNE
+        // and from a run with another offset.
+        static constexpr int64_t MinInexact = 64;
+
+        // Relaunch with the given offset and copy back the result. Bypasses exec()
+        // so the timing samples of the tested run are kept.
+        std::vector<DataT> rerun(DataT offset) const
+        {
+            auto&         dataInstance = Base::DataStorage::instance();
+            const int64_t sizeD        = Base::mM * Base::mN;
+
+            hipLaunchKernelGGL((kernelImpl()),
+                               (Base::gridDim()),
+                               (Base::blockDim()),
+                               (Base::ldsUsage()),
+                               0,
+                               Base::mM,
+                               Base::mN,
+                               dataInstance->deviceIn().get(),
+                               dataInstance->deviceOut().get(),
+                               Base::mLd,
+                               Base::mParam1,
+                               offset);
+            CHECK_HIP_ERROR(hipDeviceSynchronize());
+
+            dataInstance->copyData(dataInstance->hostOut(), dataInstance->deviceOut(), sizeD);
+            auto const* out = dataInstance->hostOut().get();
+            return std::vector<DataT>(out, out + sizeD);
+        }
+
+        static bool bitwiseEqual(std::vector<DataT> const& lhs, std::vector<DataT> const& rhs)
+        {
+            return std::memcmp(lhs.data(), rhs.data(), lhs.size() * sizeof(DataT)) == 0;
+        }
+
+    public:
+        ConvertStochasticKernel()          = default;
+        virtual ~ConvertStochasticKernel() = default;
+
+        void setupImpl(typename Base::DataStorage::ProblemSize const& probsize) final
+        {
+            auto& dataInstance = Base::DataStorage::instance();
+
+            // Initialize matrix storage
+            dataInstance->resizeStorage(probsize);
+
+            // Positive values spanning a few binades, in range for every OutputT.
+            // Most are not representable in OutputT, so rounding has a choice to make.
+            const int64_t sizeD = Base::mM * Base::mN;
+            auto          gen   = std::mt19937(5489u);
+            auto          frac  = std::uniform_real_distribution<float32_t>(0.0f, 1.0f);
+            auto          exp   = std::uniform_int_distribution<int>(-1, 2);
+
+            auto* in = dataInstance->hostIn().get();
+            for(int64_t i = 0; i < sizeD; i++)
+            {
+                in[i] = static_cast<DataT>(std::ldexp(1.0f + frac(gen), exp(gen)));
+            }
+
+            dataInstance->copyData(dataInstance->deviceIn(), dataInstance->hostIn(), sizeD);
+            MatrixUtil<Layout>::fillValLaunchKernel(dataInstance->deviceOut().get(),
+                                                    Base::mM,
+                                                    Base::mN,
+                                                    std::numeric_limits<DataT>::signaling_NaN());
+        }
+
+        void validateResultsImpl() final
+        {
+            auto& dataInstance = Base::DataStorage::instance();
+
+            const int64_t sizeD = Base::mM * Base::mN;
+
+            // Cache current kernel result from device
+            dataInstance->copyData(dataInstance->hostOut(), dataInstance->deviceOut(), sizeD);
+
+            auto const* in     = dataInstance->hostIn().get();
+            auto const* outPtr = dataInstance->hostOut().get();
+            auto        result = std::vector<DataT>(outPtr, outPtr + sizeD);
+
+            int64_t inexact = 0, differsFromRne = 0;
+            bool    inBounds = true;
+
+            for(size_t i = 0; i < result.size(); i++)
+            {
+                // Stochastic rounding must pick one of the two OutputT neighbours
+                // bracketing the input. The RNE result is always one of them.
+                auto rne     = static_cast<OutputT>(static_cast<float32_t>(in[i]));
+                auto rneVal  = static_cast<float32_t>(rne);
+                auto inVal   = static_cast<float32_t>(in[i]);
+                auto outVal  = static_cast<float32_t>(result[i]);
+                auto neighbr = rne;
+                neighbr.data += (rneVal < inVal) ? 1 : -1;
+
+                if(rneVal == inVal)
+                {
+                    inBounds &= (outVal == inVal);
+                    continue;
+                }
+
+                inexact++;
+                differsFromRne += (outVal != rneVal);
+                inBounds &= (outVal == rneVal || outVal == static_cast<float32_t>(neighbr));
+            }
+
+            Base::mValidationResult = inBounds;
+
+            // Enough inexact inputs make it practically certain that some of them
+            // round away from nearest.
+            if(inexact >= MinInexact)
+            {
+                Base::mValidationResult &= (differsFromRne > 0);
+            }
+
+            // Same seed and offset must reproduce the same bits.
+            Base::mValidationResult &= bitwiseEqual(result, rerun(Base::mParam2));
+
+            // A different offset selects a different random stream.
+            if(inexact >= MinInexact)
+            {
+                auto offset = static_cast<DataT>(static_cast<float32_t>(Base::mParam2) + 1.0f);
+                Base::mValidationResult &= !bitwiseEqual(result, rerun(offset));
+            }
+
+            Base::mMaxRelativeError = 0.0;
+        }
+
+        bool checkQuirks() const final
+        {
+            auto waveSize   = Base::DeviceInfo::instance()->warpSize();
+            auto deviceArch = Base::DeviceInfo::instance()->getGcnArch();
+
+            // The test guard for this class requires 2 values at runtime.
+            auto dispatchGuard = [waveSize, deviceArch]() {
+                bool dispatchResult = false;
+
+#define CASE_IMPL_ASSIGN2(WAVE_SIZE, ARCH_ID) \
+    dispatchResult = TestGuard<WAVE_SIZE, ARCH_ID>::enable();
+
+#define SWITCH_BODY_WAVE_SIZE(ARCH_ID) \
+    ROCWMMA_SWITCH_BODY2_ARG2(         \
+        waveSize, CASE_IMPL_ASSIGN2, HipDevice::Wave32, HipDevice::Wave64, ARCH_ID)
+
+#define DISPATCH_GUARD_BODY                           \
+    ROCWMMA_SWITCH_BODY10_ARG1(deviceArch,            \
+                               SWITCH_BODY_WAVE_SIZE, \
+                               HipDevice::GFX908,     \
+                               HipDevice::GFX90A,     \
+                               HipDevice::GFX940,     \
+                               HipDevice::GFX941,     \
+                               HipDevice::GFX942,     \
+                               HipDevice::GFX1100,    \
+                               HipDevice::GFX1101,    \
+                               HipDevice::GFX1102,    \
+                               HipDevice::GFX1200,    \
+                               HipDevice::GFX1201)
+
+                DISPATCH_GUARD_BODY
+
+#undef CASE_IMPL_ASSIGN2
+#undef SWITCH_BODY_WAVE_SIZE
+#undef DISPATCH_GUARD_BODY
+
+                return dispatchResult;
+            };
+
+            return Base::checkQuirks() && dispatchGuard();
+        }
+
+        typename Base::KernelFunc kernelImpl() const final
+        {
+            return typename Base::KernelFunc(
+                ConvertStochastic<BlockM, BlockN, DataT, Layout, OutputT>);
+        }
+    };
+
+    struct ConvertStochasticGenerator
+    {
+        // Indices to test parameters
+        enum : uint32_t
+        {
+            DataT   = 0,
+            BlockM  = 1,
+            BlockN  = 2,
+            Layout  = 3,
+            OutputT = 4
+        };
+
+        using ResultT = std::shared_ptr<KernelI>;
+
+        template <typename... Ts>
+        static ResultT generate(std::tuple<Ts...> testParams)
+        {
+            // Map GTest params to Kernel params
+            using TestParamsT = std::tuple<Ts...>;
+            using KernelT = ConvertStochasticKernel<
+                std::tuple_element_t<BlockM, TestParamsT>::value, // BlockM
+                std::tuple_element_t<BlockN, TestParamsT>::value, // BlockN
+                std::tuple_element_t<DataT, TestParamsT>, // DataT
+                std::tuple_element_t<Layout, TestParamsT>, // Layout
+                std::tuple_element_t<OutputT, TestParamsT>>; // OutputT
+
+            return std::make_shared<KernelT>();
+        }
+    };
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_DETAIL_CONVERT_STOCHASTIC_HPP
@@ -0,0 +1,345 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_DETAIL_CONVERT_HPP
+#define ROCWMMA_DETAIL_CONVERT_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include "device/convert.hpp"
+#include "helper_macros.hpp"
+#include "unit_kernel_base.hpp"
+
+namespace rocwmma
+{
+
+    // Wrapper into the actual device function
+    template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename Layout, typename OutputT>
+    struct ConvertVectorKernel : public UnitKernelBase<BlockM, BlockN, DataT, Layout>
+    {
+    private:
+        using Base = UnitKernelBase<BlockM, BlockN, DataT, Layout>;
+
+        // Both the input and output fragments must be supported
+        template <uint32_t WaveSize, uint32_t ArchId>
+        struct TestGuard
+        {
+            static constexpr bool enable()
+            {
+                using InGuard  = FragSize_guard<BlockM, BlockN, DataT, Layout, WaveSize, ArchId>;
+                using OutGuard = FragSize_guard<BlockM, BlockN, OutputT, Layout, WaveSize, ArchId>;
+                return InGuard::enable() && OutGuard::enable();
+            }
+        };
+
+        static float32_t fromBits(uint32_t bits)
+        {
+            float32_t result;
+            std::memcpy(&result, &bits, sizeof(result));
+            return result;
+        }
+
+        // Inputs where the conversion has an edge to get right
+        static std::vector<DataT> edgeValues()
+        {
+            if constexpr(std::is_same<DataT, int32_t>::value)
+            {
+                // Limits of int8, just beyond them and far beyond them. 384 and -385
+                // truncate to -128 and 127: a truncating conversion flips their sign.
+                return {0,
+                        1,
+                        -1,
+                        127,
+                        -128,
+                        128,
+                        -129,
+                        255,
+                        256,
+                        384,
+                        -385,
+                        1000,
+                        -1000,
+                        std::numeric_limits<int32_t>::max(),
+                        std::numeric_limits<int32_t>::min()};
+            }
+            else
+            {
+                return {// bfloat16 ties: to even below, to even above, and negated
+                        fromBits(0x3F808000u),
+                        fromBits(0x3F818000u),
+                        fromBits(0xBF808000u),
+                        fromBits(0xBF818000u),
+                        // Either side of a bfloat16 tie
+                        fromBits(0x3F807FFFu),
+                        fromBits(0x3F808001u),
+                        // Overflows bfloat16 to Inf when rounding up
+                        std::numeric_limits<float32_t>::max(),
+                        -std::numeric_limits<float32_t>::max(),
+                        // Zeros and denorms
+                        0.0f,
+                        -0.0f,
+                        std::numeric_limits<float32_t>::denorm_min(),
+                        // Inf and NaN. 0x7F800001 has no payload in the bfloat16 bits
+                        std::numeric_limits<float32_t>::infinity(),
+                        -std::numeric_limits<float32_t>::infinity(),
+                        std::numeric_limits<float32_t>::quiet_NaN(),
+                        fromBits(0x7F800001u),
+                        fromBits(0xFFC00001u),
+                        // float8 (E4M3) and bfloat8 (E5M2) ties
+                        1.0625f,
+                        1.1875f,
+                        1.125f,
+                        1.375f,
+                        -1.1875f,
+                        -1.375f,
+                        // Limits of the 8-bit floating point formats, and beyond them
+                        240.0f,
+                        248.0f,
+                        300.0f,
+                        -300.0f,
+                        448.0f,
+                        464.0f,
+                        57344.0f,
+                        61440.0f,
+                        1.0e6f,
+                        -1.0e6f};
+            }
+        }
+
+        // Saturating int8 for int32 inputs, the host cast otherwise.
+        // The result is widened back to DataT, as in the device kernel.
+        static DataT reference(DataT v)
+        {
+            if constexpr(std::is_same<OutputT, int8_t>::value)
+            {
+                return std::clamp(v, DataT(-128), DataT(127));
+            }
+            else
+            {
+                return static_cast<DataT>(static_cast<OutputT>(v));
+            }
+        }
+
+        // Bitwise equal, or both NaN
+        static bool sameValue(DataT lhs, DataT rhs)
+        {
+            if constexpr(std::is_floating_point<DataT>::value)
+            {
+                if(std::isnan(lhs) || std::isnan(rhs))
+                {
+                    return std::isnan(lhs) && std::isnan(rhs);
+                }
+            }
+            return std::memcmp(&lhs, &rhs, sizeof(DataT)) == 0;
+        }
+
+        // Relaunch on the element-wise path and copy back the result. Bypasses
+        // exec() so the timing samples of the tested run are kept.
+        std::vector<DataT> rerunElementWise() const
+        {
+            auto&         dataInstance = Base::DataStorage::instance();
+            const int64_t sizeD        = Base::mM * Base::mN;
+
+            hipLaunchKernelGGL((kernelImpl()),
+                               (Base::gridDim()),
+                               (Base::blockDim()),
+                               (Base::ldsUsage()),
+                               0,
+                               Base::mM,
+                               Base::mN,
+                               dataInstance->deviceIn().get(),
+                               dataInstance->deviceOut().get(),
+                               Base::mLd,
+                               static_cast<DataT>(1),
+                               Base::mParam2);
+            CHECK_HIP_ERROR(hipDeviceSynchronize());
+
+            dataInstance->copyData(dataInstance->hostOut(), dataInstance->deviceOut(), sizeD);
+            auto const* out = dataInstance->hostOut().get();
+            return std::vector<DataT>(out, out + sizeD);
+        }
+
+    public:
+        ConvertVectorKernel()          = default;
+        virtual ~ConvertVectorKernel() = default;
+
+        void setupImpl(typename Base::DataStorage::ProblemSize const& probsize) final
+        {
+            auto& dataInstance = Base::DataStorage::instance();
+
+            // Initialize matrix storage
+            dataInstance->resizeStorage(probsize);
+
+            // Every third input is an edge value, cycling through the table so that
+            // each lands in every position of a packed register. The rest are random
+            // values mostly in range of OutputT.
+            const int64_t sizeD = Base::mM * Base::mN;
+            auto const    edges = edgeValues();
+            auto          gen   = std::mt19937(5489u);
+            auto          ints  = std::uniform_int_distribution<int32_t>(-200, 200);
+            auto          frac  = std::uniform_real_distribution<float32_t>(-2.0f, 2.0f);
+            auto          exp   = std::uniform_int_distribution<int>(-8, 8);
+
+            auto* in = dataInstance->hostIn().get();
+            for(int64_t i = 0; i < sizeD; i++)
+            {
+                if(i % 3 == 0)
+                {
+                    in[i] = edges[(i / 3) % edges.size()];
+                }
+                else if constexpr(std::is_same<DataT, int32_t>::value)
+                {
+                    in[i] = ints(gen);
+                }
+                else
+                {
+                    in[i] = std::ldexp(frac(gen), exp(gen));
+                }
+            }
+
+            dataInstance->copyData(dataInstance->deviceIn(), dataInstance->hostIn(), sizeD);
+
+            auto const sentinel = std::is_floating_point<DataT>::value
+                                      ? std::numeric_limits<DataT>::signaling_NaN()
+                                      : std::numeric_limits<DataT>::max();
+            MatrixUtil<Layout>::fillValLaunchKernel(
+                dataInstance->deviceOut().get(), Base::mM, Base::mN, sentinel);
+        }
+
+        void validateResultsImpl() final
+        {
+            auto& dataInstance = Base::DataStorage::instance();
+
+            const int64_t sizeD = Base::mM * Base::mN;
+
+            // Cache current kernel result from device
+            dataInstance->copyData(dataInstance->hostOut(), dataInstance->deviceOut(), sizeD);
+
+            auto const* in     = dataInstance->hostIn().get();
+            auto const* outPtr = dataInstance->hostOut().get();
+            auto        packed = std::vector<DataT>(outPtr, outPtr + sizeD);
+
+            // The packed and element-wise paths must both match the host reference
+            auto elementWise = rerunElementWise();
+
+            bool matches = true;
+            for(int64_t i = 0; i < sizeD; i++)
+            {
+                auto expected = reference(in[i]);
+                matches &= sameValue(packed[i], expected);
+                matches &= sameValue(elementWise[i], expected);
+            }
+
+            Base::mValidationResult = matches;
+            Base::mMaxRelativeError = 0.0;
+        }
+
+        bool checkQuirks() const final
+        {
+            auto waveSize   = Base::DeviceInfo::instance()->warpSize();
+            auto deviceArch = Base::DeviceInfo::instance()->getGcnArch();
+
+            // The test guard for this class requires 2 values at runtime.
+            auto dispatchGuard = [waveSize, deviceArch]() {
+                bool dispatchResult = false;
+
+#define CASE_IMPL_ASSIGN2(WAVE_SIZE, ARCH_ID) \
+    dispatchResult = TestGuard<WAVE_SIZE, ARCH_ID>::enable();
+
+#define SWITCH_BODY_WAVE_SIZE(ARCH_ID) \
+    ROCWMMA_SWITCH_BODY2_ARG2(         \
+        waveSize, CASE_IMPL_ASSIGN2, HipDevice::Wave32, HipDevice::Wave64, ARCH_ID)
+
+#define DISPATCH_GUARD_BODY                           \
+    ROCWMMA_SWITCH_BODY10_ARG1(deviceArch,            \
+                               SWITCH_BODY_WAVE_SIZE, \
+                               HipDevice::GFX908,     \
+                               HipDevice::GFX90A,     \
+                               HipDevice::GFX940,     \
+                               HipDevice::GFX941,     \
+                               HipDevice::GFX942,     \
+                               HipDevice::GFX1100,    \
+                               HipDevice::GFX1101,    \
+                               HipDevice::GFX1102,    \
+                               HipDevice::GFX1200,    \
+                               HipDevice::GFX1201)
+
+                DISPATCH_GUARD_BODY
+
+#undef CASE_IMPL_ASSIGN2
+#undef SWITCH_BODY_WAVE_SIZE
+#undef DISPATCH_GUARD_BODY
+
+                return dispatchResult;
+            };
+
+            return Base::checkQuirks() && dispatchGuard();
+        }
+
+        typename Base::KernelFunc kernelImpl() const final
+        {
+            return typename Base::KernelFunc(ConvertVector<BlockM, BlockN, DataT, Layout, OutputT>);
+        }
+    };
+
+    struct ConvertVectorGenerator
+    {
+        // Indices to test parameters
+        enum : uint32_t
+        {
+            DataT   = 0,
+            BlockM  = 1,
+            BlockN  = 2,
+            Layout  = 3,
+            OutputT = 4
+        };
+
+        using ResultT = std::shared_ptr<KernelI>;
+
+        template <typename... Ts>
+        static ResultT generate(std::tuple<Ts...> testParams)
+        {
+            // Map GTest params to Kernel params
+            using TestParamsT = std::tuple<Ts...>;
+            using KernelT = ConvertVectorKernel<
+                std::tuple_element_t<BlockM, TestParamsT>::value, // BlockM
+                std::tuple_element_t<BlockN, TestParamsT>::value, // BlockN
+                std::tuple_element_t<DataT, TestParamsT>, // DataT
+                std::tuple_element_t<Layout, TestParamsT>, // Layout
+                std::tuple_element_t<OutputT, TestParamsT>>; // OutputT
+
+            return std::make_shared<KernelT>();
+        }
+    };
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_DETAIL_CONVERT_HPP
@@ -0,0 +1,107 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_DEVICE_CONVERT_HPP
+#define ROCWMMA_DEVICE_CONVERT_HPP
+
+#include <rocwmma/internal/convert.hpp>
+#include <rocwmma/internal/mapping_util.hpp>
+#include <rocwmma/rocwmma.hpp>
+
+#include "unit_test_traits.hpp"
+
+namespace rocwmma
+{
+
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              typename DataT,
+              typename DataLayout,
+              typename OutputT>
+    __global__ void ConvertVector(uint32_t     m,
+                                  uint32_t     n,
+                                  DataT const* in,
+                                  DataT*       out,
+                                  uint32_t     ld,
+                                  DataT        param1,
+                                  DataT        param2)
+    {
+        if constexpr(FragSize_guard<BlockM,
+                                    BlockN,
+                                    DataT,
+                                    DataLayout,
+                                    Constants::AMDGCN_WAVE_SIZE,
+                                    Constants::AMDGCN_CURRENT_ARCH_ID>::enable()
+                     && FragSize_guard<BlockM,
+                                       BlockN,
+                                       OutputT,
+                                       DataLayout,
+                                       Constants::AMDGCN_WAVE_SIZE,
+                                       Constants::AMDGCN_CURRENT_ARCH_ID>::enable())
+        {
+            using Mapping  = MappingUtil<BlockM, BlockN, DataT, DataLayout>;
+            using ConvertT = Convert<DataT, OutputT>;
+
+            // Mapping:
+            // Incoming -> Matrix C (RowNT)
+            // BlockM -> BlockM
+            // BlockN -> BlockN
+            // <Dummy> -> BlockK
+            auto frag = fragment<accumulator, BlockM, BlockN, 1, DataT, DataLayout>();
+
+            auto* read  = Mapping::dataCoord(in, ld);
+            auto* write = Mapping::dataCoord(out, ld);
+            load_matrix_sync(frag, read, ld);
+
+            // param1 == 0: convert the whole register vector, taking the packed path.
+            // Otherwise convert one element at a time, taking the element-wise path.
+            if(param1 == static_cast<DataT>(0))
+            {
+                auto result = ConvertT::exec(frag.mAccess);
+
+                // Widen the converted values back to DataT for validation.
+                for(uint32_t i = 0; i < frag.num_elements; i++)
+                {
+                    frag.mAccess.data[i] = static_cast<DataT>(result.data[i]);
+                }
+            }
+            else
+            {
+                for(uint32_t i = 0; i < frag.num_elements; i++)
+                {
+                    VecT<DataT, 1> elem;
+                    elem.data[0] = frag.mAccess.data[i];
+
+                    auto result          = ConvertT::exec(elem);
+                    frag.mAccess.data[i] = static_cast<DataT>(result.data[0]);
+                }
+            }
+            store_matrix_sync(write, frag, ld);
+        }
+    }
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_DEVICE_CONVERT_HPP
@@ -32,6 +32,10 @@
 #include "unit_kernel_base.hpp"
 #include <rocwmma/internal/pack_util.hpp>
 
+#include <algorithm>
+#include <array>
+#include <limits>
+
 namespace rocwmma
 {
 
@@ -101,7 +105,7 @@ namespace rocwmma
                    && dppWaterfallBCastCheck;
         }
 
-        std::ostream& printHeader(std::ostream& stream = std::cout) const final
+        std::ostream& printHeader(std::ostream& stream = std::cout) const override
         {
             return stream << "DataT,"
                           << "Op_Id, "
@@ -113,7 +117,7 @@ namespace rocwmma
                           << "BoundCtrl, "
                           << "Result" << std::endl;
         }
-        std::ostream& printKernel(std::ostream& stream = std::cout) const final
+        std::ostream& printKernel(std::ostream& stream = std::cout) const override
         {
             std::ios_base::fmtflags f(stream.flags()); // save flags state
             stream << dataTypeToString<DataT>() << ", " << CrossLaneOp::opId() << ", "
@@ -150,7 +154,7 @@ namespace rocwmma
             dataInstance->copyData(dataInstance->deviceOut(), dataInstance->hostOut(), 1);
         }
 
-        void validateResultsImpl() final
+        void validateResultsImpl() override
         {
             auto& dataInstance = Base::DataStorage::instance();
             // Cache current kernel result from device
@@ -232,6 +236,194 @@ namespace rocwmma
         }
     };
 
+    // Validates the cross-lane op selected for the target. Benchmarks also time a chain
+    // of each candidate op, and check that the selected candidate is the fastest.
+    template <typename DataT, typename CrossLaneOp>
+    struct SelectOpsKernel final : public CrossLaneOpsKernelBase<DataT, CrossLaneOp>
+    {
+    private:
+        using Base = UnitKernelBase<1, 1, DataT, col_major>;
+
+        // Timing noise allowed between the selected and the fastest candidate
+        constexpr static float64_t SelectTolerance = 1.1;
+
+        // Test result, selected candidate index and supported candidates mask
+        constexpr static uint32_t OutputSize = 3u;
+
+    public:
+        SelectOpsKernel()  = default;
+        ~SelectOpsKernel() = default;
+
+        typename Base::KernelFunc kernelImpl() const final
+        {
+            return typename Base::KernelFunc(selectOpsTest<DataT, CrossLaneOp>);
+        }
+
+        void setupImpl(typename Base::DataStorage::ProblemSize const& /*probsize*/) final
+        {
+            auto& dataInstance = Base::DataStorage::instance();
+
+            dataInstance->resizeStorage({OutputSize, 1});
+
+            dataInstance->hostOut().get()[0] = static_cast<DataT>(ERROR_VALUE);
+            dataInstance->copyData(dataInstance->deviceOut(), dataInstance->hostOut(), 1);
+
+            mCandidateMs.fill(0.0);
+        }
+
+        void exec() final
+        {
+            Base::exec();
+
+#if ROCWMMA_BENCHMARK_TESTS
+            if(Base::mRunFlag)
+            {
+                benchCandidates(
+                    std::make_integer_sequence<uint32_t, CrossLaneOp::candidateCount()>{});
+            }
+#endif // ROCWMMA_BENCHMARK_TESTS
+        }
+
+        void validateResultsImpl() final
+        {
+            auto& dataInstance = Base::DataStorage::instance();
+            dataInstance->copyData(dataInstance->hostOut(), dataInstance->deviceOut(), OutputSize);
+
+            auto result    = dataInstance->hostOut().get();
+            mSelectedIdx   = static_cast<uint32_t>(result[1]);
+            mSupportedMask = static_cast<uint32_t>(result[2]);
+
+            Base::mValidationResult = (result[0] == DataT(SUCCESS_VALUE))
+                                      && (mSelectedIdx < CrossLaneOp::candidateCount());
+
+#if ROCWMMA_BENCHMARK_TESTS
+            auto fastestMs = std::numeric_limits<float64_t>::max();
+            for(uint32_t i = 0; i < CrossLaneOp::candidateCount(); ++i)
+            {
+                if(mSupportedMask & (1u << i))
+                {
+                    fastestMs = std::min(fastestMs, mCandidateMs[i]);
+                }
+            }
+            Base::mValidationResult = Base::mValidationResult
+                                      && (mCandidateMs[mSelectedIdx] <= fastestMs * SelectTolerance);
+#endif // ROCWMMA_BENCHMARK_TESTS
+        }
+
+        std::ostream& printHeader(std::ostream& stream = std::cout) const final
+        {
+            return stream << "DataT, "
+                          << "Op_Id, "
+                          << "Wave_Size, "
+                          << "Group_Size, "
+                          << "Selected_Impl, "
+                          << "Candidate_Impls, "
+                          << "Candidate_Ms, "
+                          << "Result" << std::endl;
+        }
+
+        std::ostream& printKernel(std::ostream& stream = std::cout) const final
+        {
+            stream << dataTypeToString<DataT>() << ", " << CrossLaneOp::opId() << ", "
+                   << "w" << Base::DeviceInfo::instance()->warpSize() << ", "
+                   << CrossLaneOp::groupSize() << ", ";
+
+            if(!Base::mRunFlag)
+            {
+                return stream << "n/a, n/a, n/a, SKIPPED" << std::endl;
+            }
+
+            stream << CrossLaneOp::candidateImpl(mSelectedIdx) << ", ";
+            for(uint32_t i = 0; i < CrossLaneOp::candidateCount(); ++i)
+            {
+                stream << (i ? "/" : "") << CrossLaneOp::candidateImpl(i);
+            }
+            stream << ", ";
+            for(uint32_t i = 0; i < CrossLaneOp::candidateCount(); ++i)
+            {
+                stream << (i ? "/" : "");
+                if(mSupportedMask & (1u << i))
+                {
+                    stream << mCandidateMs[i];
+                }
+                else
+                {
+                    stream << "n/a";
+                }
+            }
+
+            return stream << ", " << (Base::mValidationResult ? "PASSED" : "FAILED") << std::endl;
+        }
+
+    private:
+        template <uint32_t... CandidateIdx>
+        void benchCandidates(std::integer_sequence<uint32_t, CandidateIdx...>)
+        {
+            ((mCandidateMs[CandidateIdx] = benchCandidate(typename Base::KernelFunc(
+                  selectOpsBench<DataT, CrossLaneOp, CandidateIdx>))),
+             ...);
+        }
+
+        // Median time of the hot runs of one candidate chain
+        float64_t benchCandidate(typename Base::KernelFunc kernel) const
+        {
+            auto& dataInstance = Base::DataStorage::instance();
+
+            auto benchKernel = [this, &dataInstance, kernel](hipEvent_t startEvent,
+                                                              hipEvent_t stopEvent) {
+                hipExtLaunchKernelGGL(kernel, // Kernel to launch
+                                      (this->gridDim()), // Wg grid size
+                                      (this->blockDim()), // Thread block size
+                                      (this->ldsUsage()), // sharedMemBytes
+                                      0, // stream
+                                      startEvent, // Event start
+                                      stopEvent, // event stop
+                                      0, // flags
+                                      Base::mM, // M
+                                      Base::mN, // N
+                                      dataInstance->deviceIn().get(), // In*
+                                      dataInstance->deviceOut().get(), // Out*
+                                      Base::mLd, // ld
+                                      Base::mParam1, // param1
+                                      Base::mParam2); // param2
+            };
+
+            for(uint32_t i = 0; i < Base::mColdRuns; ++i)
+            {
+                benchKernel(nullptr, nullptr);
+            }
+
+            std::vector<hipEvent_t> runEvents(Base::mHotRuns + 1u);
+            for(auto& event : runEvents)
+            {
+                CHECK_HIP_ERROR(hipEventCreate(&event));
+            }
+            for(uint32_t i = 0; i < Base::mHotRuns; ++i)
+            {
+                benchKernel(runEvents[i], runEvents[i + 1u]);
+            }
+            CHECK_HIP_ERROR(hipEventSynchronize(runEvents[Base::mHotRuns]));
+
+            std::vector<double> runTimesMs(Base::mHotRuns);
+            for(uint32_t i = 0; i < Base::mHotRuns; ++i)
+            {
+                auto runMs = 0.0f;
+                CHECK_HIP_ERROR(hipEventElapsedTime(&runMs, runEvents[i], runEvents[i + 1u]));
+                runTimesMs[i] = runMs;
+            }
+            for(auto& event : runEvents)
+            {
+                CHECK_HIP_ERROR(hipEventDestroy(event));
+            }
+
+            return calculateTimingStats(runTimesMs).mMedianMs;
+        }
+
+        std::array<float64_t, CrossLaneOp::candidateCount()> mCandidateMs;
+        uint32_t                                             mSelectedIdx   = 0u;
+        uint32_t                                             mSupportedMask = 0u;
+    };
+
     // This is the GeneratorImpl class
     struct DppOpsGenerator
     {
@@ -339,6 +531,31 @@ namespace rocwmma
         }
     };
 
+    struct SelectOpsGenerator
+    {
+        // Indices to test parameters
+        enum : uint32_t
+        {
+            DataT       = 0,
+            CrossLaneOp = 1
+        };
+
+        using ResultT = std::shared_ptr<KernelI>;
+
+        template <typename... Ts>
+        static ResultT generate(std::tuple<Ts...> testParams)
+        {
+            // Map GTest params to Kernel params
+            using TestParamsT = std::tuple<Ts...>;
+            using KernelT
+                = SelectOpsKernel<std::tuple_element_t<DataT, TestParamsT>, // DataT
+                                  std::tuple_element_t<CrossLaneOp, TestParamsT> // CrossLaneOp
+                                  >;
+
+            return std::make_shared<KernelT>();
+        }
+    };
+
 } // namespace rocwmma
 
 #endif // ROCWMMA_DETAIL_CROSS_LANE_OPS_HPP
@@ -31,6 +31,7 @@
 #include "device/blend_ops.hpp"
 #include "device/dpp_ops.hpp"
 #include "device/permute_ops.hpp"
+#include "device/select_ops.hpp"
 #include "device/swizzle_ops.hpp"
 #include <rocwmma/rocwmma.hpp>
 
@@ -144,6 +145,48 @@ namespace rocwmma
             blendOpsTestCase<DataT, CrossLaneOp>, m, n, in, out, ld, param1, param2);
     }
 
+    template <typename DataT, typename CrossLaneOp>
+    ROCWMMA_KERNEL void selectOpsTest(uint32_t     m,
+                                      uint32_t     n,
+                                      DataT const* in,
+                                      DataT*       out,
+                                      uint32_t     ld,
+                                      DataT        param1,
+                                      DataT        param2)
+    {
+        __shared__ uint32_t sharedSrcValues[Constants::AMDGCN_WAVE_SIZE];
+        uint32_t*           srcValues = sharedSrcValues;
+        crossLaneOpsTest<DataT>(
+            [srcValues]() { return selectOpsTestCase<DataT, CrossLaneOp>(srcValues); },
+            m,
+            n,
+            in,
+            out,
+            ld,
+            param1,
+            param2);
+
+        // Report the selection of the target to the host
+        if(threadIdx.x == 0 && threadIdx.y == 0 && threadIdx.z == 0 && blockIdx.x == 0
+           && blockIdx.y == 0 && blockIdx.z == 0)
+        {
+            out[1] = static_cast<DataT>(CrossLaneOp::selectedIdx());
+            out[2] = static_cast<DataT>(CrossLaneOp::supportedMask());
+        }
+    }
+
+    template <typename DataT, typename CrossLaneOp, uint32_t CandidateIdx>
+    ROCWMMA_KERNEL void selectOpsBench(uint32_t /*m*/,
+                                       uint32_t /*n*/,
+                                       DataT const* /*in*/,
+                                       DataT* out,
+                                       uint32_t /*ld*/,
+                                       DataT /*param1*/,
+                                       DataT /*param2*/)
+    {
+        selectOpsBenchCase<DataT, typename CrossLaneOp::template Candidate<CandidateIdx>>(out);
+    }
+
 } // namespace rocwmma
 
 #endif // ROCWMMA_DEVICE_CROSS_LANE_OPS_HPP
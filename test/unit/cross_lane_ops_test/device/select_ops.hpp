@@ -0,0 +1,140 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef ROCWMMA_DEVICE_SELECT_OPS_HPP
+#define ROCWMMA_DEVICE_SELECT_OPS_HPP
+
+#include <tuple>
+#include <type_traits>
+
+#include "device/dpp_ops.hpp"
+#include "device/permute_ops.hpp"
+#include "device/swizzle_ops.hpp"
+
+namespace rocwmma
+{
+    // Backend placeholder of ops selected in device code
+    constexpr uint32_t OP_IMPL_SELECT = 0x3F;
+
+    // Length of the dependent op chain timed by the benchmark
+    constexpr uint32_t SELECT_OPS_BENCH_CHAIN = 1024u;
+
+    /*! \class CrossLaneSelect
+    *  \brief Candidate ops of a CrossLane::Select. The selection depends on the target,
+    * so the cheapest candidate is only resolved in device code.
+    */
+    template <typename CandidateOp, typename... CandidateOps>
+    struct CrossLaneSelect
+        : public CrossLaneOps::OpBase<CandidateOp::opId(), CandidateOp::groupSize(), OP_IMPL_SELECT>
+    {
+        using Candidates = std::tuple<CandidateOp, CandidateOps...>;
+        using SelectedOp = CrossLaneOps::OpSelect_t<CandidateOp, CandidateOps...>;
+
+        template <uint32_t Idx>
+        using Candidate = std::tuple_element_t<Idx, Candidates>;
+
+        constexpr static uint32_t candidateCount()
+        {
+            return std::tuple_size<Candidates>::value;
+        }
+
+        // Backend of candidate idx
+        constexpr static uint32_t candidateImpl(uint32_t idx)
+        {
+            constexpr uint32_t impls[] = {CandidateOp::opImpl(), CandidateOps::opImpl()...};
+            return idx < candidateCount() ? impls[idx] : OP_IMPL_SELECT;
+        }
+
+        // Index of the selected op in the candidates
+        constexpr static uint32_t selectedIdx()
+        {
+            constexpr bool isSelected[] = {std::is_same<SelectedOp, CandidateOp>::value,
+                                           std::is_same<SelectedOp, CandidateOps>::value...};
+            uint32_t       idx          = 0u;
+            while(!isSelected[idx])
+            {
+                ++idx;
+            }
+            return idx;
+        }
+
+        // Bit i is set if the target supports candidate i
+        constexpr static uint32_t supportedMask()
+        {
+            constexpr bool isSupported[] = {CrossLaneOps::isSupported<CandidateOp>(),
+                                            CrossLaneOps::isSupported<CandidateOps>()...};
+            uint32_t       mask          = 0u;
+            for(uint32_t i = 0u; i < candidateCount(); ++i)
+            {
+                mask |= static_cast<uint32_t>(isSupported[i]) << i;
+            }
+            return mask;
+        }
+    };
+
+    template <typename DataT, typename CrossLaneOp>
+    ROCWMMA_DEVICE inline bool selectOpsTestCase(uint32_t* srcValues)
+    {
+        // Validate the selected op with the test case of its backend
+        using SelectedOp = typename CrossLaneOp::SelectedOp;
+        if constexpr(SelectedOp::opImpl() == CrossLaneOps::OP_IMPL_DPP)
+        {
+            return dppOpsTestCase<DataT, SelectedOp, 0xF, 0xF, false>();
+        }
+        else if constexpr(SelectedOp::opImpl() == CrossLaneOps::OP_IMPL_SWIZZLE)
+        {
+            return swizzleOpsTestCase<DataT, SelectedOp>();
+        }
+        else
+        {
+            return permuteOpsTestCase<DataT, SelectedOp>(srcValues);
+        }
+    }
+
+    template <typename DataT, typename CandidateOp>
+    ROCWMMA_DEVICE inline void selectOpsBenchCase(DataT* out)
+    {
+        // Unsupported candidates are reported by supportedMask and not timed
+        if constexpr(CrossLaneOps::isSupported<CandidateOp>())
+        {
+            auto v = makeValueFromU32<DataT>(threadIdx.x);
+            for(uint32_t i = 0u; i < SELECT_OPS_BENCH_CHAIN; ++i)
+            {
+                v = CrossLane::Driver<CandidateOp>::exec(v);
+            }
+
+            // Cross-lane ops only move lane ids around, so the store never happens.
+            // It keeps the chain from being optimized out.
+            if(v == makeValueFromU32<DataT>(VALUE_OUT_OF_RANGE))
+            {
+                out[0] = v;
+            }
+        }
+    }
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_DEVICE_SELECT_OPS_HPP
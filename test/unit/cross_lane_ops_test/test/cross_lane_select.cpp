@@ -0,0 +1,116 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <tuple>
+#include <type_traits>
+
+#include "detail/cross_lane_ops.hpp"
+#include "kernel_generator.hpp"
+#include "unit_test.hpp"
+
+namespace rocwmma
+{
+
+    struct TestParams : public UnitTestParams
+    {
+        using Base = UnitTestParams;
+
+        using Types = typename std::tuple<uint32_t, uint64_t>;
+
+        // Candidates of each CrossLane op
+        using SelectOps = std::tuple<
+            CrossLaneSelect<DppImpl::Ops::BCast16<5>, SwizzleImpl::Ops::BCast16<5>>,
+            CrossLaneSelect<DppImpl::Ops::BCast4<2>, SwizzleImpl::Ops::BCast4<2>>,
+            CrossLaneSelect<DppImpl::Ops::Reverse16, SwizzleImpl::Ops::Reverse16>,
+            CrossLaneSelect<DppImpl::Ops::Reverse8, SwizzleImpl::Ops::Reverse8>,
+            CrossLaneSelect<DppImpl::Ops::Reverse4, SwizzleImpl::Ops::Reverse4>,
+            CrossLaneSelect<DppImpl::Ops::Reverse2, SwizzleImpl::Ops::Reverse2>,
+            CrossLaneSelect<DppImpl::Ops::RotateR16<1>, SwizzleImpl::Ops::RotateR16<1>>,
+            CrossLaneSelect<DppImpl::Ops::RotateR16<14>, SwizzleImpl::Ops::RotateR16<14>>,
+            CrossLaneSelect<DppImpl::Ops::RotateR4<3>, SwizzleImpl::Ops::RotateR4<3>>,
+            CrossLaneSelect<DppImpl::Ops::RotateL2<1>, SwizzleImpl::Ops::RotateL2<1>>,
+            CrossLaneSelect<DppImpl::Ops::Shuffle4<2, 3, 0, 1>,
+                            SwizzleImpl::Ops::Shuffle4<2, 3, 0, 1>>,
+            CrossLaneSelect<DppImpl::Ops::Swap2, SwizzleImpl::Ops::Swap2>,
+            CrossLaneSelect<DppImpl::Ops::RotateWaveR1, PermuteImpl::Ops::RotateWaveR<1>>,
+            CrossLaneSelect<DppImpl::Ops::RotateWaveL1, PermuteImpl::Ops::RotateWaveL<1>>>;
+
+        using KernelParams = typename CombineLists<Types, SelectOps>::Result;
+
+        // Assemble the kernel generator
+        // Kernel: SelectOps
+        using GeneratorImpl   = SelectOpsGenerator;
+        using KernelGenerator = KernelGenerator<KernelParams, GeneratorImpl>;
+
+        // Sanity check for kernel generator
+        static_assert(std::is_same<typename GeneratorImpl::ResultT, typename Base::KernelT>::value,
+                      "Kernels from this generator do not match testing interface");
+
+        // Must be TBlockY must be 1.
+        static inline std::vector<ThreadBlockT> threadBlocks()
+        {
+            auto warpSize = HipDevice::instance()->warpSize();
+            return {{warpSize, 1}};
+        }
+
+        static inline std::vector<ProblemSizeT> problemSizes()
+        {
+            auto warpSize = HipDevice::instance()->warpSize();
+            return {{warpSize, 1}};
+        }
+
+        // 'prev' values
+        static inline std::vector<Param1T> param1s()
+        {
+            return {5.0};
+        }
+
+        static inline typename KernelGenerator::ResultT kernels()
+        {
+            return KernelGenerator::generate();
+        }
+    };
+
+} // namespace rocwmma
+
+// Test suite for unique parameterization
+class CrossLaneSelectTest : public rocwmma::UnitTest
+{
+};
+
+TEST_P(CrossLaneSelectTest, RunKernel)
+{
+    this->RunKernel();
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    CrossLaneOpTests,
+    CrossLaneSelectTest,
+    ::testing::Combine(::testing::ValuesIn(rocwmma::TestParams::kernels()),
+                       ::testing::ValuesIn(rocwmma::TestParams::threadBlocks()),
+                       ::testing::ValuesIn(rocwmma::TestParams::problemSizes()),
+                       ::testing::ValuesIn(rocwmma::TestParams::param1s()),
+                       ::testing::ValuesIn(rocwmma::TestParams::param2s())));
@@ -0,0 +1,303 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef ROCWMMA_DETAIL_DEQUANT_LOAD_HPP
+#define ROCWMMA_DETAIL_DEQUANT_LOAD_HPP
+
+#include <type_traits>
+#include <vector>
+
+#include "device/dequant_load.hpp"
+#include "helper_macros.hpp"
+#include "unit_kernel_base.hpp"
+
+namespace rocwmma
+{
+
+    // Wrapper into the actual device function.
+    // A PageSize of 0 loads contiguous data, otherwise a page pool through a page table.
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              typename DataT,
+              typename Layout,
+              typename QuantT,
+              uint32_t PageSize = 0u>
+    struct DequantLoadKernel : public UnitKernelBase<BlockM, BlockN, DataT, Layout>
+    {
+    private:
+        using Base = UnitKernelBase<BlockM, BlockN, DataT, Layout>;
+
+        template <uint32_t WaveSize, uint32_t ArchId>
+        using TestGuard = FragSize_guard<BlockM, BlockN, DataT, Layout, WaveSize, ArchId>;
+
+        // Exactly representable values of each quantized type, by element index
+        static inline float32_t quantValue(uint32_t idx)
+        {
+            if constexpr(std::is_same<QuantT, int4x2_t>::value)
+            {
+                return static_cast<float32_t>(static_cast<int32_t>(idx % 16u) - 8);
+            }
+            else if constexpr(std::is_same<QuantT, int8_t>::value)
+            {
+                return static_cast<float32_t>(static_cast<int32_t>(idx % 256u) - 128);
+            }
+            else
+            {
+                return static_cast<float32_t>(static_cast<int32_t>(idx % 32u) - 16) * 0.25f;
+            }
+        }
+
+    public:
+        DequantLoadKernel()          = default;
+        virtual ~DequantLoadKernel() = default;
+
+        // Page table of each wave in LDS
+        uint32_t ldsUsage() const final
+        {
+            if constexpr(PageSize == 0u)
+            {
+                return Base::ldsUsage();
+            }
+            else
+            {
+                constexpr bool IsRowMajor = std::is_same<Layout, row_major>::value;
+                auto           waveCount
+                    = Base::mTBlockX * Base::mTBlockY / Base::DeviceInfo::instance()->warpSize();
+                return waveCount * ((IsRowMajor ? BlockM : BlockN) / PageSize + 1u)
+                       * sizeof(index_t);
+            }
+        }
+
+        void setupImpl(typename Base::DataStorage::ProblemSize const& probsize) final
+        {
+            auto& dataInstance = Base::DataStorage::instance();
+
+            // Initialize matrix storage
+            const int64_t sizeD = Base::mM * Base::mN;
+            dataInstance->resizeStorage(probsize);
+
+            // Quantized data occupies the front of the input buffer.
+            auto* quant = reinterpret_cast<uint8_t*>(dataInstance->hostIn().get());
+            for(int64_t i = 0; i < sizeD; i++)
+            {
+                if constexpr(std::is_same<QuantT, int4x2_t>::value)
+                {
+                    // Low nibble first
+                    auto nibble = static_cast<uint8_t>(static_cast<int32_t>(quantValue(i)) & 0xF);
+                    auto& bits  = quant[i / 2u];
+                    bits        = (i % 2u == 0u) ? nibble
+                                                 : static_cast<uint8_t>(bits | (nibble << 4u));
+                }
+                else
+                {
+                    reinterpret_cast<QuantT*>(quant)[i] = static_cast<QuantT>(quantValue(i));
+                }
+            }
+
+            dataInstance->copyData(dataInstance->deviceIn(), dataInstance->hostIn(), sizeD);
+
+            MatrixUtil<Layout>::fillValLaunchKernel(dataInstance->deviceOut().get(),
+                                                    Base::mM,
+                                                    Base::mN,
+                                                    std::numeric_limits<DataT>::signaling_NaN());
+        }
+
+        void validateResultsImpl() final
+        {
+            auto& dataInstance = Base::DataStorage::instance();
+
+            const int64_t sizeD = Base::mM * Base::mN;
+
+            // Cache current kernel result from device
+            dataInstance->copyData(dataInstance->hostOut(), dataInstance->deviceOut(), sizeD);
+
+            // Output elements have the same data offsets as their quantized sources
+            auto ref = std::vector<DataT>(sizeD);
+            if constexpr(PageSize == 0u)
+            {
+                for(int64_t i = 0; i < sizeD; i++)
+                {
+                    ref[i] = static_cast<DataT>(quantValue(i));
+                }
+            }
+            else
+            {
+                constexpr bool IsRowMajor = std::is_same<Layout, row_major>::value;
+
+                auto index = [this](int64_t row, int64_t col) {
+                    return IsRowMajor ? row * Base::mN + col : col * Base::mM + row;
+                };
+
+                // Major vectors of the logical matrix map to the pool vectors of their pages
+                auto pages = (IsRowMajor ? Base::mM : Base::mN) / PageSize;
+                for(uint32_t row = 0; row < Base::mM; row++)
+                {
+                    for(uint32_t col = 0; col < Base::mN; col++)
+                    {
+                        auto major = IsRowMajor ? row : col;
+                        auto page  = dequantTestPage(major / PageSize, pages);
+                        if(page < 0)
+                        {
+                            ref[index(row, col)] = static_cast<DataT>(0);
+                            continue;
+                        }
+
+                        auto vector = static_cast<int64_t>(page) * PageSize + major % PageSize;
+                        auto pooled = IsRowMajor ? index(vector, col) : index(row, vector);
+                        ref[index(row, col)] = static_cast<DataT>(quantValue(pooled));
+                    }
+                }
+            }
+
+            double errorTolerance = 10.0;
+
+            std::tie(Base::mValidationResult, Base::mMaxRelativeError)
+                = compareEqual<DataT, DataT, Layout, Layout>(
+                    dataInstance->hostOut().get(), ref.data(), Base::mM, Base::mN, errorTolerance);
+        }
+
+        bool checkQuirks() const final
+        {
+            auto waveSize   = Base::DeviceInfo::instance()->warpSize();
+            auto deviceArch = Base::DeviceInfo::instance()->getGcnArch();
+
+            // The test guard for this class requires 2 values at runtime.
+            auto dispatchGuard = [waveSize, deviceArch]() {
+                bool dispatchResult = false;
+
+#define CASE_IMPL_ASSIGN2(WAVE_SIZE, ARCH_ID) \
+    dispatchResult = TestGuard<WAVE_SIZE, ARCH_ID>::enable();
+
+#define SWITCH_BODY_WAVE_SIZE(ARCH_ID) \
+    ROCWMMA_SWITCH_BODY2_ARG2(         \
+        waveSize, CASE_IMPL_ASSIGN2, HipDevice::Wave32, HipDevice::Wave64, ARCH_ID)
+
+#define DISPATCH_GUARD_BODY                           \
+    ROCWMMA_SWITCH_BODY10_ARG1(deviceArch,            \
+                               SWITCH_BODY_WAVE_SIZE, \
+                               HipDevice::GFX908,     \
+                               HipDevice::GFX90A,     \
+                               HipDevice::GFX940,     \
+                               HipDevice::GFX941,     \
+                               HipDevice::GFX942,     \
+                               HipDevice::GFX1100,    \
+                               HipDevice::GFX1101,    \
+                               HipDevice::GFX1102,    \
+                               HipDevice::GFX1200,    \
+                               HipDevice::GFX1201)
+
+                DISPATCH_GUARD_BODY
+
+#undef CASE_IMPL_ASSIGN2
+#undef SWITCH_BODY_WAVE_SIZE
+#undef DISPATCH_GUARD_BODY
+
+                return dispatchResult;
+            };
+
+            return Base::checkQuirks() && dispatchGuard();
+        }
+
+        typename Base::KernelFunc kernelImpl() const final
+        {
+            if constexpr(PageSize == 0u)
+            {
+                return typename Base::KernelFunc(
+                    DequantLoadB<BlockM, BlockN, DataT, Layout, QuantT>);
+            }
+            else
+            {
+                return typename Base::KernelFunc(
+                    DequantPagedLoadB<BlockM, BlockN, DataT, Layout, QuantT, PageSize>);
+            }
+        }
+    };
+
+    struct DequantLoadGenerator
+    {
+        // Indices to test parameters
+        enum : uint32_t
+        {
+            DataT  = 0,
+            BlockM = 1,
+            BlockN = 2,
+            Layout = 3,
+            QuantT = 4
+        };
+
+        using ResultT = std::shared_ptr<KernelI>;
+
+        template <typename... Ts>
+        static ResultT generate(std::tuple<Ts...> testParams)
+        {
+            // Map GTest params to Kernel params
+            using TestParamsT = std::tuple<Ts...>;
+            using KernelT
+                = DequantLoadKernel<std::tuple_element_t<BlockM, TestParamsT>::value, // BlockM
+                                    std::tuple_element_t<BlockN, TestParamsT>::value, // BlockN
+                                    std::tuple_element_t<DataT, TestParamsT>, // DataT
+                                    std::tuple_element_t<Layout, TestParamsT>, // Layout
+                                    std::tuple_element_t<QuantT, TestParamsT>>; // QuantT
+
+            return std::make_shared<KernelT>();
+        }
+    };
+
+    struct DequantPagedLoadGenerator
+    {
+        // Indices to test parameters
+        enum : uint32_t
+        {
+            DataT    = 0,
+            BlockM   = 1,
+            BlockN   = 2,
+            Layout   = 3,
+            QuantT   = 4,
+            PageSize = 5
+        };
+
+        using ResultT = std::shared_ptr<KernelI>;
+
+        template <typename... Ts>
+        static ResultT generate(std::tuple<Ts...> testParams)
+        {
+            // Map GTest params to Kernel params
+            using TestParamsT = std::tuple<Ts...>;
+            using KernelT
+                = DequantLoadKernel<std::tuple_element_t<BlockM, TestParamsT>::value, // BlockM
+                                    std::tuple_element_t<BlockN, TestParamsT>::value, // BlockN
+                                    std::tuple_element_t<DataT, TestParamsT>, // DataT
+                                    std::tuple_element_t<Layout, TestParamsT>, // Layout
+                                    std::tuple_element_t<QuantT, TestParamsT>, // QuantT
+                                    std::tuple_element_t<PageSize, TestParamsT>::value>; // PageSize
+
+            return std::make_shared<KernelT>();
+        }
+    };
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_DETAIL_DEQUANT_LOAD_HPP
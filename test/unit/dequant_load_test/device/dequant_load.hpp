@@ -0,0 +1,154 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef ROCWMMA_DEVICE_DEQUANT_LOAD_HPP
+#define ROCWMMA_DEVICE_DEQUANT_LOAD_HPP
+
+#include <rocwmma/internal/mapping_util.hpp>
+#include <rocwmma/rocwmma.hpp>
+
+#include "unit_test_traits.hpp"
+
+namespace rocwmma
+{
+
+    // The input buffer holds the quantized QuantT data.
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              typename DataT,
+              typename DataLayout,
+              typename QuantT>
+    __global__ void DequantLoadB(uint32_t     m,
+                                 uint32_t     n,
+                                 DataT const* in,
+                                 DataT*       out,
+                                 uint32_t     ld,
+                                 DataT        param1,
+                                 DataT        param2)
+    {
+        if constexpr(FragSize_guard<BlockM,
+                                    BlockN,
+                                    DataT,
+                                    DataLayout,
+                                    Constants::AMDGCN_WAVE_SIZE,
+                                    Constants::AMDGCN_CURRENT_ARCH_ID>::enable())
+        {
+            using Mapping = MappingUtil<BlockM, BlockN, DataT, DataLayout>;
+
+            // Mapping:
+            // Incoming -> Matrix B (RowNT)
+            // <Dummy> -> BlockM
+            // BlockN -> BlockN
+            // BlockM -> BlockK
+            auto frag = fragment<matrix_b, 1, BlockN, BlockM, DataT, DataLayout>();
+
+            // Packed int4 has two elements per byte
+            auto offset = Mapping::dataOffset(Mapping::matrixCoord(), ld);
+            auto read   = reinterpret_cast<QuantT const*>(in)
+                        + (is_same<QuantT, int4x2_t>::value ? offset / 2u : offset);
+
+            // Map, dequant load and store.
+            auto* write = Mapping::dataCoord(out, ld);
+            load_matrix_dequant_sync(frag, read, ld);
+            store_matrix_sync(write, frag, ld);
+        }
+    }
+
+    // Page of the pool holding logical page p of a matrix of the given number of pages.
+    // Pages are stored in reverse order, with every 5th page not allocated (-1).
+    ROCWMMA_HOST_DEVICE constexpr inline index_t dequantTestPage(uint32_t page, uint32_t pages)
+    {
+        return (page % 5u == 2u) ? -1 : static_cast<index_t>(pages - 1u - page);
+    }
+
+    // The input buffer holds a page pool of quantized QuantT data, of pages of PageSize
+    // rows (row_major) or columns (col_major).
+    // out = the logical matrix of the page table, with zeros in unallocated pages.
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              typename DataT,
+              typename DataLayout,
+              typename QuantT,
+              uint32_t PageSize>
+    __global__ void DequantPagedLoadB(uint32_t     m,
+                                      uint32_t     n,
+                                      DataT const* in,
+                                      DataT*       out,
+                                      uint32_t     ld,
+                                      DataT        param1,
+                                      DataT        param2)
+    {
+        if constexpr(FragSize_guard<BlockM,
+                                    BlockN,
+                                    DataT,
+                                    DataLayout,
+                                    Constants::AMDGCN_WAVE_SIZE,
+                                    Constants::AMDGCN_CURRENT_ARCH_ID>::enable())
+        {
+            using Mapping = MappingUtil<BlockM, BlockN, DataT, DataLayout>;
+
+            constexpr bool     IsRowMajor = is_same<DataLayout, row_major>::value;
+            constexpr uint32_t TableSize  = (IsRowMajor ? BlockM : BlockN) / PageSize + 1u;
+
+            // Mapping:
+            // Incoming -> Matrix B (RowNT)
+            // <Dummy> -> BlockM
+            // BlockN -> BlockN
+            // BlockM -> BlockK
+            auto frag = fragment<matrix_b, 1, BlockN, BlockM, DataT, DataLayout>();
+
+            auto coord = Mapping::matrixCoord();
+            auto major = get<IsRowMajor ? 0 : 1>(coord);
+            auto pages = (IsRowMajor ? m : n) / PageSize;
+
+            // Each wave builds the page table of its block in LDS, starting at the page of
+            // the block origin
+            HIP_DYNAMIC_SHARED(void*, localMemPtr);
+            auto workgroupDim = Mapping::workgroupDim();
+            auto waveCoord    = Mapping::waveCoord();
+            auto waveIndex    = get<0>(waveCoord) * get<1>(workgroupDim) + get<1>(waveCoord);
+            auto firstPage    = major / PageSize;
+
+            auto* table = reinterpret_cast<index_t*>(localMemPtr) + waveIndex * TableSize;
+            for(auto i = Mapping::laneId(); i < TableSize; i += Constants::AMDGCN_WAVE_SIZE)
+            {
+                table[i] = (firstPage + i < pages) ? dequantTestPage(firstPage + i, pages) : -1;
+            }
+            __syncthreads();
+
+            // Load from the block origin relative to the first page of the table, then store
+            // in place
+            auto row = IsRowMajor ? major % PageSize : get<0>(coord);
+            auto col = IsRowMajor ? get<1>(coord) : major % PageSize;
+            load_matrix_paged_dequant_sync(
+                frag, reinterpret_cast<QuantT const*>(in), table, PageSize, ld, row, col);
+            store_matrix_sync(Mapping::dataCoord(out, ld), frag, ld);
+        }
+    }
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_DEVICE_DEQUANT_LOAD_HPP
@@ -0,0 +1,220 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef ROCWMMA_DETAIL_FAST_MATH_HPP
+#define ROCWMMA_DETAIL_FAST_MATH_HPP
+
+#include <cmath>
+#include <type_traits>
+#include <vector>
+
+#include "device/fast_math.hpp"
+#include "helper_macros.hpp"
+#include "unit_kernel_base.hpp"
+
+namespace rocwmma
+{
+
+    // Wrapper into the actual device function
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              typename DataT,
+              typename Layout,
+              typename ActivationT>
+    struct FastMathKernel : public UnitKernelBase<BlockM, BlockN, DataT, Layout>
+    {
+    private:
+        using Base = UnitKernelBase<BlockM, BlockN, DataT, Layout>;
+
+        template <uint32_t WaveSize, uint32_t ArchId>
+        using TestGuard = FragSize_guard<BlockM, BlockN, DataT, Layout, WaveSize, ArchId>;
+
+        // Index of (row, col) in the input
+        int64_t index(uint32_t row, uint32_t col) const
+        {
+            return std::is_same<Layout, row_major>::value ? int64_t(row) * Base::mN + col
+                                                           : int64_t(col) * Base::mM + row;
+        }
+
+        // Precise activation of the input
+        static inline double reference(double x)
+        {
+            if constexpr(std::is_same_v<ActivationT, epilogue::FastSigmoid>)
+            {
+                return 1.0 / (1.0 + std::exp(-x));
+            }
+            else if constexpr(std::is_same_v<ActivationT, epilogue::FastTanh>)
+            {
+                return std::tanh(x);
+            }
+            else if constexpr(std::is_same_v<ActivationT, epilogue::FastGelu>)
+            {
+                auto inner = 0.7978845608028654 * (x + 0.044715 * x * x * x);
+                return 0.5 * x * (1.0 + std::tanh(inner));
+            }
+            else
+            {
+                return x / (1.0 + std::exp(-x));
+            }
+        }
+
+    public:
+        FastMathKernel()          = default;
+        virtual ~FastMathKernel() = default;
+
+        void setupImpl(typename Base::DataStorage::ProblemSize const& probsize) final
+        {
+            auto& dataInstance = Base::DataStorage::instance();
+
+            // Initialize matrix storage
+            const int64_t sizeD = Base::mM * Base::mN;
+            dataInstance->resizeStorage(probsize);
+
+            // Initialize data on host: a sweep over [-8, 8), covering saturation of all activations
+            auto* in = dataInstance->hostIn().get();
+            for(uint32_t row = 0; row < Base::mM; row++)
+            {
+                for(uint32_t col = 0; col < Base::mN; col++)
+                {
+                    auto step           = (row * 131u + col * 17u) % 1024u;
+                    in[index(row, col)] = static_cast<DataT>(-8.0 + 16.0 * step / 1024.0);
+                }
+            }
+
+            dataInstance->copyData(dataInstance->deviceIn(), dataInstance->hostIn(), sizeD);
+
+            MatrixUtil<Layout>::fillValLaunchKernel(dataInstance->deviceOut().get(),
+                                                    Base::mM,
+                                                    Base::mN,
+                                                    std::numeric_limits<DataT>::signaling_NaN());
+        }
+
+        void validateResultsImpl() final
+        {
+            auto& dataInstance = Base::DataStorage::instance();
+
+            const int64_t sizeD = Base::mM * Base::mN;
+
+            // Cache current kernel result from device
+            dataInstance->copyData(dataInstance->hostOut(), dataInstance->deviceOut(), sizeD);
+
+            // Element-wise, so independent of the layout.
+            auto const* in  = dataInstance->hostIn().get();
+            auto        ref = std::vector<DataT>(sizeD);
+            for(int64_t i = 0; i < sizeD; i++)
+            {
+                ref[i] = static_cast<DataT>(reference(static_cast<double>(in[i])));
+            }
+
+            // Bounds of the float32_t approximations are within 2^-19 on [-8, 8)
+            double errorTolerance = 32.0;
+
+            std::tie(Base::mValidationResult, Base::mMaxRelativeError)
+                = compareEqual<DataT, DataT, Layout, Layout>(
+                    dataInstance->hostOut().get(), ref.data(), Base::mM, Base::mN, errorTolerance);
+        }
+
+        bool checkQuirks() const final
+        {
+            auto waveSize   = Base::DeviceInfo::instance()->warpSize();
+            auto deviceArch = Base::DeviceInfo::instance()->getGcnArch();
+
+            // The test guard for this class requires 2 values at runtime.
+            auto dispatchGuard = [waveSize, deviceArch]() {
+                bool dispatchResult = false;
+
+#define CASE_IMPL_ASSIGN2(WAVE_SIZE, ARCH_ID) \
+    dispatchResult = TestGuard<WAVE_SIZE, ARCH_ID>::enable();
+
+#define SWITCH_BODY_WAVE_SIZE(ARCH_ID) \
+    ROCWMMA_SWITCH_BODY2_ARG2(         \
+        waveSize, CASE_IMPL_ASSIGN2, HipDevice::Wave32, HipDevice::Wave64, ARCH_ID)
+
+#define DISPATCH_GUARD_BODY                           \
+    ROCWMMA_SWITCH_BODY10_ARG1(deviceArch,            \
+                               SWITCH_BODY_WAVE_SIZE, \
+                               HipDevice::GFX908,     \
+                               HipDevice::GFX90A,     \
+                               HipDevice::GFX940,     \
+                               HipDevice::GFX941,     \
+                               HipDevice::GFX942,     \
+                               HipDevice::GFX1100,    \
+                               HipDevice::GFX1101,    \
+                               HipDevice::GFX1102,    \
+                               HipDevice::GFX1200,    \
+                               HipDevice::GFX1201)
+
+                DISPATCH_GUARD_BODY
+
+#undef CASE_IMPL_ASSIGN2
+#undef SWITCH_BODY_WAVE_SIZE
+#undef DISPATCH_GUARD_BODY
+
+                return dispatchResult;
+            };
+
+            return Base::checkQuirks() && dispatchGuard();
+        }
+
+        typename Base::KernelFunc kernelImpl() const final
+        {
+            return typename Base::KernelFunc(FastMath<BlockM, BlockN, DataT, Layout, ActivationT>);
+        }
+    };
+
+    struct FastMathGenerator
+    {
+        // Indices to test parameters
+        enum : uint32_t
+        {
+            DataT      = 0,
+            BlockM     = 1,
+            BlockN     = 2,
+            Layout     = 3,
+            Activation = 4
+        };
+
+        using ResultT = std::shared_ptr<KernelI>;
+
+        template <typename... Ts>
+        static ResultT generate(std::tuple<Ts...> testParams)
+        {
+            // Map GTest params to Kernel params
+            using TestParamsT = std::tuple<Ts...>;
+            using KernelT
+                = FastMathKernel<std::tuple_element_t<BlockM, TestParamsT>::value, // BlockM
+                                 std::tuple_element_t<BlockN, TestParamsT>::value, // BlockN
+                                 std::tuple_element_t<DataT, TestParamsT>, // DataT
+                                 std::tuple_element_t<Layout, TestParamsT>, // Layout
+                                 std::tuple_element_t<Activation, TestParamsT>>; // Activation
+
+            return std::make_shared<KernelT>();
+        }
+    };
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_DETAIL_FAST_MATH_HPP
@@ -0,0 +1,162 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef ROCWMMA_DETAIL_FRAGMENT_ARRAY_HPP
+#define ROCWMMA_DETAIL_FRAGMENT_ARRAY_HPP
+
+#include "device/fragment_array.hpp"
+#include "load_store_matrix_sync_test/detail/load_store_matrix_sync.hpp"
+
+namespace rocwmma
+{
+
+    // Each wave covers a 2 x 2 tile of BlockM x BlockN fragments
+    template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename Layout>
+    struct FragmentArrayKernelA final
+        : public LoadStoreMatrixSyncKernel<2u * BlockM, 2u * BlockN, DataT, Layout>
+    {
+    private:
+        using Base = LoadStoreMatrixSyncKernel<2u * BlockM, 2u * BlockN, DataT, Layout>;
+
+    protected:
+        typename Base::KernelFunc kernelImpl() const final
+        {
+            return typename Base::KernelFunc(FragmentArrayA<BlockM, BlockN, DataT, Layout>);
+        }
+    };
+
+    template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename Layout>
+    struct FragmentArrayKernelB final
+        : public LoadStoreMatrixSyncKernel<2u * BlockM, 2u * BlockN, DataT, Layout>
+    {
+    private:
+        using Base = LoadStoreMatrixSyncKernel<2u * BlockM, 2u * BlockN, DataT, Layout>;
+
+    protected:
+        typename Base::KernelFunc kernelImpl() const final
+        {
+            return typename Base::KernelFunc(FragmentArrayB<BlockM, BlockN, DataT, Layout>);
+        }
+    };
+
+    template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename Layout>
+    struct FragmentArrayKernelAcc final
+        : public LoadStoreMatrixSyncKernel<2u * BlockM, 2u * BlockN, DataT, Layout>
+    {
+    private:
+        using Base = LoadStoreMatrixSyncKernel<2u * BlockM, 2u * BlockN, DataT, Layout>;
+
+    protected:
+        typename Base::KernelFunc kernelImpl() const final
+        {
+            return typename Base::KernelFunc(FragmentArrayAcc<BlockM, BlockN, DataT, Layout>);
+        }
+    };
+
+    // Each wave covers a super-block of 4 x 1, 1 x 4 or 2 x 2 BlockM x BlockN tiles
+    template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename Layout>
+    struct SuperFragmentKernelA final
+        : public LoadStoreMatrixSyncKernel<4u * BlockM, BlockN, DataT, Layout>
+    {
+    private:
+        using Base = LoadStoreMatrixSyncKernel<4u * BlockM, BlockN, DataT, Layout>;
+
+    protected:
+        typename Base::KernelFunc kernelImpl() const final
+        {
+            return typename Base::KernelFunc(SuperFragmentA<BlockM, BlockN, DataT, Layout>);
+        }
+    };
+
+    template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename Layout>
+    struct SuperFragmentKernelB final
+        : public LoadStoreMatrixSyncKernel<BlockM, 4u * BlockN, DataT, Layout>
+    {
+    private:
+        using Base = LoadStoreMatrixSyncKernel<BlockM, 4u * BlockN, DataT, Layout>;
+
+    protected:
+        typename Base::KernelFunc kernelImpl() const final
+        {
+            return typename Base::KernelFunc(SuperFragmentB<BlockM, BlockN, DataT, Layout>);
+        }
+    };
+
+    template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename Layout>
+    struct SuperFragmentKernelAcc final
+        : public LoadStoreMatrixSyncKernel<2u * BlockM, 2u * BlockN, DataT, Layout>
+    {
+    private:
+        using Base = LoadStoreMatrixSyncKernel<2u * BlockM, 2u * BlockN, DataT, Layout>;
+
+    protected:
+        typename Base::KernelFunc kernelImpl() const final
+        {
+            return typename Base::KernelFunc(SuperFragmentAcc<BlockM, BlockN, DataT, Layout>);
+        }
+    };
+
+    // Each wave round trips one BlockM x BlockN fragment through K slices
+    template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename Layout>
+    struct FragmentSliceKernelA final
+        : public LoadStoreMatrixSyncKernel<BlockM, BlockN, DataT, Layout>
+    {
+    private:
+        using Base = LoadStoreMatrixSyncKernel<BlockM, BlockN, DataT, Layout>;
+
+    protected:
+        typename Base::KernelFunc kernelImpl() const final
+        {
+            return typename Base::KernelFunc(FragmentSliceA<BlockM, BlockN, DataT, Layout>);
+        }
+    };
+
+    template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename Layout>
+    struct FragmentSliceKernelB final
+        : public LoadStoreMatrixSyncKernel<BlockM, BlockN, DataT, Layout>
+    {
+    private:
+        using Base = LoadStoreMatrixSyncKernel<BlockM, BlockN, DataT, Layout>;
+
+    protected:
+        typename Base::KernelFunc kernelImpl() const final
+        {
+            return typename Base::KernelFunc(FragmentSliceB<BlockM, BlockN, DataT, Layout>);
+        }
+    };
+
+    using FragmentArrayGeneratorA   = LoadStoreMatrixSyncGenerator<FragmentArrayKernelA>;
+    using FragmentArrayGeneratorB   = LoadStoreMatrixSyncGenerator<FragmentArrayKernelB>;
+    using FragmentArrayGeneratorAcc = LoadStoreMatrixSyncGenerator<FragmentArrayKernelAcc>;
+    using SuperFragmentGeneratorA   = LoadStoreMatrixSyncGenerator<SuperFragmentKernelA>;
+    using SuperFragmentGeneratorB   = LoadStoreMatrixSyncGenerator<SuperFragmentKernelB>;
+    using SuperFragmentGeneratorAcc = LoadStoreMatrixSyncGenerator<SuperFragmentKernelAcc>;
+    using FragmentSliceGeneratorA   = LoadStoreMatrixSyncGenerator<FragmentSliceKernelA>;
+    using FragmentSliceGeneratorB   = LoadStoreMatrixSyncGenerator<FragmentSliceKernelB>;
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_DETAIL_FRAGMENT_ARRAY_HPP
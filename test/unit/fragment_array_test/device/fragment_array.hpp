@@ -0,0 +1,369 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef ROCWMMA_DEVICE_FRAGMENT_ARRAY_HPP
+#define ROCWMMA_DEVICE_FRAGMENT_ARRAY_HPP
+
+#include <rocwmma/internal/mapping_util.hpp>
+#include <rocwmma/rocwmma.hpp>
+#include <rocwmma/rocwmma_tile.hpp>
+
+#include "unit_test_traits.hpp"
+
+namespace rocwmma
+{
+
+    // Each wave loads its block tile with one fragment_array load, and checks each block
+    // against a load_matrix_sync from the offset of the same block. The tile is only
+    // stored back if every block matches, such that a wrong offset leaves unwritten output.
+    template <typename FragArrayT,
+              uint32_t TileM,
+              uint32_t TileN,
+              typename DataT,
+              typename DataLayout,
+              typename... LayoutT>
+    __device__ void fragmentArrayLoadStore(DataT const* in,
+                                           DataT*       out,
+                                           uint32_t     ld,
+                                           LayoutT... layout)
+    {
+        using Mapping = MappingUtil<TileM, TileN, DataT, DataLayout>;
+        using FragT   = typename FragArrayT::fragment_type;
+
+        FragArrayT frags;
+        load_matrix_sync(frags, Mapping::dataCoord(in, ld), ld, layout...);
+
+        auto tileCoord = Mapping::matrixCoord();
+        bool match     = true;
+
+        for(uint32_t i = 0; i < FragArrayT::blocks_x; i++)
+        {
+            for(uint32_t j = 0; j < FragArrayT::blocks_y; j++)
+            {
+                auto blockCoord = tileCoord
+                                  + make_coord2d(i * FragArrayT::block_height,
+                                                 j * FragArrayT::block_width);
+
+                FragT ref;
+                load_matrix_sync(
+                    ref, Mapping::dataCoord(in, blockCoord, ld), ld, layout...);
+
+                for(uint32_t k = 0; k < FragT::num_elements; k++)
+                {
+                    match = match && (frags(i, j).x[k] == ref.x[k]);
+                }
+            }
+        }
+
+        if(match)
+        {
+            store_matrix_sync(Mapping::dataCoord(out, ld), frags, ld, layout...);
+        }
+    }
+
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              typename DataT,
+              typename DataLayout>
+    __global__ void FragmentArrayA(uint32_t     m,
+                                   uint32_t     n,
+                                   DataT const* in,
+                                   DataT*       out,
+                                   uint32_t     ld,
+                                   DataT        param1,
+                                   DataT        param2)
+    {
+        if constexpr (FragSize_guard<2u * BlockM,
+                                 2u * BlockN,
+                                 DataT,
+                                 DataLayout,
+                                 Constants::AMDGCN_WAVE_SIZE,
+                                 Constants::AMDGCN_CURRENT_ARCH_ID>::enable())
+        {
+            // Mapping:
+            // Incoming -> 2 x 2 blocks of Matrix A (ColNT)
+            // BlockM -> BlockM
+            // <Dummy> -> BlockN
+            // BlockN -> BlockK
+            using FragT = fragment<matrix_a, BlockM, 1, BlockN, DataT, DataLayout>;
+            fragmentArrayLoadStore<fragment_array<FragT, 2u, 2u>,
+                                   2u * BlockM,
+                                   2u * BlockN,
+                                   DataT,
+                                   DataLayout>(in, out, ld);
+        }
+    }
+
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              typename DataT,
+              typename DataLayout>
+    __global__ void FragmentArrayB(uint32_t     m,
+                                   uint32_t     n,
+                                   DataT const* in,
+                                   DataT*       out,
+                                   uint32_t     ld,
+                                   DataT        param1,
+                                   DataT        param2)
+    {
+        if constexpr (FragSize_guard<2u * BlockM,
+                                 2u * BlockN,
+                                 DataT,
+                                 DataLayout,
+                                 Constants::AMDGCN_WAVE_SIZE,
+                                 Constants::AMDGCN_CURRENT_ARCH_ID>::enable())
+        {
+            // Mapping:
+            // Incoming -> 2 x 2 blocks of Matrix B (RowNT)
+            // <Dummy> -> BlockM
+            // BlockN -> BlockN
+            // BlockM -> BlockK
+            using FragT = fragment<matrix_b, 1, BlockN, BlockM, DataT, DataLayout>;
+            fragmentArrayLoadStore<fragment_array<FragT, 2u, 2u>,
+                                   2u * BlockM,
+                                   2u * BlockN,
+                                   DataT,
+                                   DataLayout>(in, out, ld);
+        }
+    }
+
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              typename DataT,
+              typename DataLayout>
+    __global__ void FragmentArrayAcc(uint32_t     m,
+                                     uint32_t     n,
+                                     DataT const* in,
+                                     DataT*       out,
+                                     uint32_t     ld,
+                                     DataT        param1,
+                                     DataT        param2)
+    {
+        if constexpr (FragSize_guard<2u * BlockM,
+                                 2u * BlockN,
+                                 DataT,
+                                 DataLayout,
+                                 Constants::AMDGCN_WAVE_SIZE,
+                                 Constants::AMDGCN_CURRENT_ARCH_ID>::enable())
+        {
+            // Mapping:
+            // Incoming -> 2 x 2 blocks of Accumulator, with the layout at runtime
+            // BlockM -> BlockM
+            // BlockN -> BlockN
+            // <Dummy> -> BlockK
+            using FragT = fragment<accumulator, BlockM, BlockN, 1, DataT>;
+            constexpr auto layout = std::is_same_v<DataLayout, row_major> ? mem_row_major
+                                                                          : mem_col_major;
+            fragmentArrayLoadStore<fragment_array<FragT, 2u, 2u>,
+                                   2u * BlockM,
+                                   2u * BlockN,
+                                   DataT,
+                                   DataLayout>(in, out, ld, layout);
+        }
+    }
+
+    // Super fragments of 4 * BlockM rows of matrix_a, 4 * BlockN columns of matrix_b and
+    // 2 * BlockM x 2 * BlockN accumulators, each checked block by block against the
+    // native fragments they are composed of.
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              typename DataT,
+              typename DataLayout>
+    __global__ void SuperFragmentA(uint32_t     m,
+                                   uint32_t     n,
+                                   DataT const* in,
+                                   DataT*       out,
+                                   uint32_t     ld,
+                                   DataT        param1,
+                                   DataT        param2)
+    {
+        if constexpr (FragSize_guard<4u * BlockM,
+                                 BlockN,
+                                 DataT,
+                                 DataLayout,
+                                 Constants::AMDGCN_WAVE_SIZE,
+                                 Constants::AMDGCN_CURRENT_ARCH_ID>::enable())
+        {
+            // Mapping:
+            // Incoming -> 4 * BlockM rows of Matrix A
+            // 4 * BlockM -> SuperM
+            // 4 * BlockM -> SuperN
+            // BlockN -> BlockK
+            using SuperFragT
+                = super_fragment<matrix_a, 4u * BlockM, 4u * BlockM, BlockN, DataT, DataLayout>;
+            fragmentArrayLoadStore<SuperFragT, 4u * BlockM, BlockN, DataT, DataLayout>(
+                in, out, ld);
+        }
+    }
+
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              typename DataT,
+              typename DataLayout>
+    __global__ void SuperFragmentB(uint32_t     m,
+                                   uint32_t     n,
+                                   DataT const* in,
+                                   DataT*       out,
+                                   uint32_t     ld,
+                                   DataT        param1,
+                                   DataT        param2)
+    {
+        if constexpr (FragSize_guard<BlockM,
+                                 4u * BlockN,
+                                 DataT,
+                                 DataLayout,
+                                 Constants::AMDGCN_WAVE_SIZE,
+                                 Constants::AMDGCN_CURRENT_ARCH_ID>::enable())
+        {
+            // Mapping:
+            // Incoming -> 4 * BlockN columns of Matrix B
+            // 4 * BlockN -> SuperM
+            // 4 * BlockN -> SuperN
+            // BlockM -> BlockK
+            using SuperFragT
+                = super_fragment<matrix_b, 4u * BlockN, 4u * BlockN, BlockM, DataT, DataLayout>;
+            fragmentArrayLoadStore<SuperFragT, BlockM, 4u * BlockN, DataT, DataLayout>(
+                in, out, ld);
+        }
+    }
+
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              typename DataT,
+              typename DataLayout>
+    __global__ void SuperFragmentAcc(uint32_t     m,
+                                     uint32_t     n,
+                                     DataT const* in,
+                                     DataT*       out,
+                                     uint32_t     ld,
+                                     DataT        param1,
+                                     DataT        param2)
+    {
+        if constexpr (FragSize_guard<2u * BlockM,
+                                 2u * BlockN,
+                                 DataT,
+                                 DataLayout,
+                                 Constants::AMDGCN_WAVE_SIZE,
+                                 Constants::AMDGCN_CURRENT_ARCH_ID>::enable())
+        {
+            // Mapping:
+            // Incoming -> 2 * BlockM x 2 * BlockN super-block of Accumulator
+            // 2 * BlockM -> SuperM
+            // 2 * BlockN -> SuperN
+            // <Dummy> -> BlockK
+            using SuperFragT
+                = super_fragment<accumulator, 2u * BlockM, 2u * BlockN, 1, DataT, DataLayout>;
+            fragmentArrayLoadStore<SuperFragT, 2u * BlockM, 2u * BlockN, DataT, DataLayout>(
+                in, out, ld);
+        }
+    }
+
+    // Copies a loaded fragment into another, half of K at a time through fragment_slice
+    // views of both. The round trip only holds if the two slices partition the registers.
+    // Slices are of 16 K or more, the smallest of which all test types fill a register.
+    template <typename FragT, uint32_t TileM, uint32_t TileN, typename DataT, typename DataLayout>
+    __device__ void fragmentSliceLoadStore(DataT const* in, DataT* out, uint32_t ld)
+    {
+        using Mapping = MappingUtil<TileM, TileN, DataT, DataLayout>;
+
+        FragT src, dst;
+        load_matrix_sync(src, Mapping::dataCoord(in, ld), ld);
+
+        constexpr uint32_t BlockK = FragT::kDim();
+        if constexpr(BlockK >= 32u)
+        {
+            fragment_slice<0u, BlockK / 2u>(dst) = fragment_slice<0u, BlockK / 2u>(src);
+            fragment_slice<BlockK / 2u, BlockK>(dst) = fragment_slice<BlockK / 2u, BlockK>(src);
+        }
+        else
+        {
+            dst = src;
+        }
+
+        store_matrix_sync(Mapping::dataCoord(out, ld), dst, ld);
+    }
+
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              typename DataT,
+              typename DataLayout>
+    __global__ void FragmentSliceA(uint32_t     m,
+                                   uint32_t     n,
+                                   DataT const* in,
+                                   DataT*       out,
+                                   uint32_t     ld,
+                                   DataT        param1,
+                                   DataT        param2)
+    {
+        if constexpr (FragSize_guard<BlockM,
+                                 BlockN,
+                                 DataT,
+                                 DataLayout,
+                                 Constants::AMDGCN_WAVE_SIZE,
+                                 Constants::AMDGCN_CURRENT_ARCH_ID>::enable())
+        {
+            // Mapping:
+            // Incoming -> Matrix A (ColNT)
+            // BlockM -> BlockM
+            // <Dummy> -> BlockN
+            // BlockN -> BlockK
+            using FragT = fragment<matrix_a, BlockM, 1, BlockN, DataT, DataLayout>;
+            fragmentSliceLoadStore<FragT, BlockM, BlockN, DataT, DataLayout>(in, out, ld);
+        }
+    }
+
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              typename DataT,
+              typename DataLayout>
+    __global__ void FragmentSliceB(uint32_t     m,
+                                   uint32_t     n,
+                                   DataT const* in,
+                                   DataT*       out,
+                                   uint32_t     ld,
+                                   DataT        param1,
+                                   DataT        param2)
+    {
+        if constexpr (FragSize_guard<BlockM,
+                                 BlockN,
+                                 DataT,
+                                 DataLayout,
+                                 Constants::AMDGCN_WAVE_SIZE,
+                                 Constants::AMDGCN_CURRENT_ARCH_ID>::enable())
+        {
+            // Mapping:
+            // Incoming -> Matrix B (RowNT)
+            // <Dummy> -> BlockM
+            // BlockN -> BlockN
+            // BlockM -> BlockK
+            using FragT = fragment<matrix_b, 1, BlockN, BlockM, DataT, DataLayout>;
+            fragmentSliceLoadStore<FragT, BlockM, BlockN, DataT, DataLayout>(in, out, ld);
+        }
+    }
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_DEVICE_FRAGMENT_ARRAY_HPP
@@ -0,0 +1,139 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_DEVICE_GATHER_SCATTER_HPP
+#define ROCWMMA_DEVICE_GATHER_SCATTER_HPP
+
+#include <rocwmma/internal/mapping_util.hpp>
+#include <rocwmma/rocwmma.hpp>
+
+#include "unit_test_traits.hpp"
+
+namespace rocwmma
+{
+
+    // Row index permutation of an m row matrix, with every 7th row dropped (-1).
+    // Reversing and then flipping the low bits of the row is a permutation for
+    // m a multiple of 8, that maps rows across block boundaries.
+    ROCWMMA_HOST_DEVICE constexpr inline index_t gatherScatterTestIndex(uint32_t row, uint32_t m)
+    {
+        return (row % 7u == 3u) ? -1 : static_cast<index_t>((m - 1u - row) ^ 5u);
+    }
+
+    // Each wave builds the row indices of its block in LDS, such that the index
+    // array read by the gather / scatter lives in local memory.
+    template <uint32_t BlockM, typename Mapping>
+    ROCWMMA_DEVICE inline index_t const* gatherScatterTestIndices(uint32_t m)
+    {
+        HIP_DYNAMIC_SHARED(void*, localMemPtr);
+
+        auto workgroupDim = Mapping::workgroupDim();
+        auto waveCoord    = Mapping::waveCoord();
+        auto waveIndex    = get<0>(waveCoord) * get<1>(workgroupDim) + get<1>(waveCoord);
+
+        auto* indices = reinterpret_cast<index_t*>(localMemPtr) + waveIndex * BlockM;
+        auto  row     = get<0>(Mapping::matrixCoord());
+        for(auto i = Mapping::laneId(); i < BlockM; i += Constants::AMDGCN_WAVE_SIZE)
+        {
+            indices[i] = gatherScatterTestIndex(row + i, m);
+        }
+
+        __syncthreads();
+        return indices;
+    }
+
+    // out[row] = in[index(row)], or zero for dropped rows
+    template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename DataLayout>
+    __global__ void GatherLoadA(uint32_t     m,
+                                uint32_t     n,
+                                DataT const* in,
+                                DataT*       out,
+                                uint32_t     ld,
+                                DataT        param1,
+                                DataT        param2)
+    {
+        if constexpr(FragSize_guard<BlockM,
+                                    BlockN,
+                                    DataT,
+                                    DataLayout,
+                                    Constants::AMDGCN_WAVE_SIZE,
+                                    Constants::AMDGCN_CURRENT_ARCH_ID>::enable())
+        {
+            using Mapping = MappingUtil<BlockM, BlockN, DataT, DataLayout>;
+
+            // Mapping:
+            // Incoming -> Matrix A (ColNT)
+            // BlockM -> BlockM
+            // <Dummy> -> BlockN
+            // BlockN -> BlockK
+            auto frag = fragment<matrix_a, BlockM, 1, BlockN, DataT, DataLayout>();
+
+            // Gather rows from the K origin of the block, then store in place
+            auto  indices = gatherScatterTestIndices<BlockM, Mapping>(m);
+            auto  coord   = Mapping::matrixCoord();
+            auto* read    = Mapping::dataCoord(in, make_coord2d(0u, get<1>(coord)), ld);
+            load_matrix_gather_sync(frag, read, indices, ld);
+            store_matrix_sync(Mapping::dataCoord(out, ld), frag, ld);
+        }
+    }
+
+    // out[index(row)] = in[row], dropped rows are not written
+    template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename DataLayout>
+    __global__ void ScatterStoreAcc(uint32_t     m,
+                                    uint32_t     n,
+                                    DataT const* in,
+                                    DataT*       out,
+                                    uint32_t     ld,
+                                    DataT        param1,
+                                    DataT        param2)
+    {
+        if constexpr(FragSize_guard<BlockM,
+                                    BlockN,
+                                    DataT,
+                                    DataLayout,
+                                    Constants::AMDGCN_WAVE_SIZE,
+                                    Constants::AMDGCN_CURRENT_ARCH_ID>::enable())
+        {
+            using Mapping = MappingUtil<BlockM, BlockN, DataT, DataLayout>;
+
+            // Mapping:
+            // Incoming -> Matrix C (RowNT)
+            // BlockM -> BlockM
+            // BlockN -> BlockN
+            // <Dummy> -> BlockK
+            auto frag = fragment<accumulator, BlockM, BlockN, 1, DataT, DataLayout>();
+
+            // Load in place, then scatter rows from the N origin of the block
+            auto  indices = gatherScatterTestIndices<BlockM, Mapping>(m);
+            auto  coord   = Mapping::matrixCoord();
+            auto* write   = Mapping::dataCoord(out, make_coord2d(0u, get<1>(coord)), ld);
+            load_matrix_sync(frag, Mapping::dataCoord(in, ld), ld);
+            store_matrix_scatter_sync(write, frag, indices, ld);
+        }
+    }
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_DEVICE_GATHER_SCATTER_HPP
@@ -0,0 +1,250 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef ROCWMMA_DETAIL_IM2COL_LOAD_HPP
+#define ROCWMMA_DETAIL_IM2COL_LOAD_HPP
+
+#include <vector>
+
+#include "device/im2col_load.hpp"
+#include "helper_macros.hpp"
+#include "unit_kernel_base.hpp"
+
+namespace rocwmma
+{
+
+    // Wrapper into the actual device function. Dgrad selects the backward data
+    // gather of the output gradient instead of the forward im2col gather.
+    template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename Layout, bool Dgrad = false>
+    struct Im2colLoadKernel : public UnitKernelBase<BlockM, BlockN, DataT, Layout>
+    {
+    private:
+        using Base = UnitKernelBase<BlockM, BlockN, DataT, Layout>;
+
+        template <uint32_t WaveSize, uint32_t ArchId>
+        using TestGuard = FragSize_guard<BlockM, BlockN, DataT, Layout, WaveSize, ArchId>;
+
+        // Exactly representable input values, by element index
+        static inline DataT inputValue(int64_t idx)
+        {
+            return static_cast<DataT>(static_cast<float32_t>(idx % 64 - 32));
+        }
+
+    public:
+        Im2colLoadKernel()          = default;
+        virtual ~Im2colLoadKernel() = default;
+
+        void setupImpl(typename Base::DataStorage::ProblemSize const& probsize) final
+        {
+            auto& dataInstance = Base::DataStorage::instance();
+
+            // Initialize matrix storage
+            const int64_t sizeD = Base::mM * Base::mN;
+            dataInstance->resizeStorage(probsize);
+
+            // The NHWC input, or NPQK output gradient, occupies the front of the input buffer
+            auto conv      = Dgrad ? im2colDgradTestConv(Base::mM, Base::mN).conv
+                                   : im2colTestConv(Base::mM, Base::mN);
+            auto sizeInput = Dgrad ? static_cast<int64_t>(conv.n) * conv.p * conv.q * conv.k
+                                   : static_cast<int64_t>(conv.n) * conv.h * conv.w * conv.c;
+            for(int64_t i = 0; i < sizeInput; i++)
+            {
+                dataInstance->hostIn().get()[i] = inputValue(i);
+            }
+
+            dataInstance->copyData(dataInstance->deviceIn(), dataInstance->hostIn(), sizeD);
+
+            MatrixUtil<Layout>::fillValLaunchKernel(dataInstance->deviceOut().get(),
+                                                    Base::mM,
+                                                    Base::mN,
+                                                    std::numeric_limits<DataT>::signaling_NaN());
+        }
+
+        void validateResultsImpl() final
+        {
+            auto& dataInstance = Base::DataStorage::instance();
+
+            const int64_t sizeD = Base::mM * Base::mN;
+
+            // Cache current kernel result from device
+            dataInstance->copyData(dataInstance->hostOut(), dataInstance->deviceOut(), sizeD);
+
+            // Materialize the im2col, or dgrad, matrix on the host
+            auto conv = Dgrad ? im2colDgradTestConv(Base::mM, Base::mN).conv
+                              : im2colTestConv(Base::mM, Base::mN);
+            auto ref  = std::vector<DataT>(sizeD);
+            for(uint32_t row = 0; row < Base::mM; row++)
+            {
+                for(uint32_t col = 0; col < Base::mN; col++)
+                {
+                    if constexpr(Dgrad)
+                    {
+                        auto w = row % conv.w;
+                        auto h = (row / conv.w) % conv.h;
+                        auto n = row / (conv.w * conv.h);
+                        auto k = col % conv.k;
+                        auto s = (col / conv.k) % conv.s;
+                        auto r = col / (conv.k * conv.s);
+
+                        auto ph = static_cast<int32_t>(h + conv.padH)
+                                  - static_cast<int32_t>(r * conv.dilationH);
+                        auto qw = static_cast<int32_t>(w + conv.padW)
+                                  - static_cast<int32_t>(s * conv.dilationW);
+
+                        bool inBounds = ph >= 0 && qw >= 0 && ph % conv.strideH == 0
+                                        && qw % conv.strideW == 0 && ph / conv.strideH < conv.p
+                                        && qw / conv.strideW < conv.q;
+
+                        auto p   = inBounds ? ph / conv.strideH : 0u;
+                        auto q   = inBounds ? qw / conv.strideW : 0u;
+                        auto idx
+                            = ((static_cast<int64_t>(n) * conv.p + p) * conv.q + q) * conv.k + k;
+                        ref[row * Base::mN + col]
+                            = inBounds ? inputValue(idx) : static_cast<DataT>(0);
+                    }
+                    else
+                    {
+                        auto q = row % conv.q;
+                        auto p = (row / conv.q) % conv.p;
+                        auto n = row / (conv.q * conv.p);
+                        auto c = col % conv.c;
+                        auto s = (col / conv.c) % conv.s;
+                        auto r = col / (conv.c * conv.s);
+
+                        auto h = static_cast<int32_t>(p * conv.strideH + r * conv.dilationH)
+                                 - static_cast<int32_t>(conv.padH);
+                        auto w = static_cast<int32_t>(q * conv.strideW + s * conv.dilationW)
+                                 - static_cast<int32_t>(conv.padW);
+
+                        bool inBounds = h >= 0 && h < static_cast<int32_t>(conv.h) && w >= 0
+                                        && w < static_cast<int32_t>(conv.w);
+
+                        auto idx
+                            = ((static_cast<int64_t>(n) * conv.h + h) * conv.w + w) * conv.c + c;
+                        ref[row * Base::mN + col]
+                            = inBounds ? inputValue(idx) : static_cast<DataT>(0);
+                    }
+                }
+            }
+
+            double errorTolerance = 10.0;
+
+            std::tie(Base::mValidationResult, Base::mMaxRelativeError)
+                = compareEqual<DataT, DataT, Layout, row_major>(
+                    dataInstance->hostOut().get(), ref.data(), Base::mM, Base::mN, errorTolerance);
+        }
+
+        bool checkQuirks() const final
+        {
+            auto waveSize   = Base::DeviceInfo::instance()->warpSize();
+            auto deviceArch = Base::DeviceInfo::instance()->getGcnArch();
+
+            // The test guard for this class requires 2 values at runtime.
+            auto dispatchGuard = [waveSize, deviceArch]() {
+                bool dispatchResult = false;
+
+#define CASE_IMPL_ASSIGN2(WAVE_SIZE, ARCH_ID) \
+    dispatchResult = TestGuard<WAVE_SIZE, ARCH_ID>::enable();
+
+#define SWITCH_BODY_WAVE_SIZE(ARCH_ID) \
+    ROCWMMA_SWITCH_BODY2_ARG2(         \
+        waveSize, CASE_IMPL_ASSIGN2, HipDevice::Wave32, HipDevice::Wave64, ARCH_ID)
+
+#define DISPATCH_GUARD_BODY                           \
+    ROCWMMA_SWITCH_BODY10_ARG1(deviceArch,            \
+                               SWITCH_BODY_WAVE_SIZE, \
+                               HipDevice::GFX908,     \
+                               HipDevice::GFX90A,     \
+                               HipDevice::GFX940,     \
+                               HipDevice::GFX941,     \
+                               HipDevice::GFX942,     \
+                               HipDevice::GFX1100,    \
+                               HipDevice::GFX1101,    \
+                               HipDevice::GFX1102,    \
+                               HipDevice::GFX1200,    \
+                               HipDevice::GFX1201)
+
+                DISPATCH_GUARD_BODY
+
+#undef CASE_IMPL_ASSIGN2
+#undef SWITCH_BODY_WAVE_SIZE
+#undef DISPATCH_GUARD_BODY
+
+                return dispatchResult;
+            };
+
+            return Base::checkQuirks() && dispatchGuard();
+        }
+
+        typename Base::KernelFunc kernelImpl() const final
+        {
+            if constexpr(Dgrad)
+            {
+                return typename Base::KernelFunc(Im2colDgradLoadA<BlockM, BlockN, DataT, Layout>);
+            }
+            else
+            {
+                return typename Base::KernelFunc(Im2colLoadA<BlockM, BlockN, DataT, Layout>);
+            }
+        }
+    };
+
+    template <bool Dgrad>
+    struct Im2colLoadGeneratorBase
+    {
+        // Indices to test parameters
+        enum : uint32_t
+        {
+            DataT  = 0,
+            BlockM = 1,
+            BlockN = 2,
+            Layout = 3
+        };
+
+        using ResultT = std::shared_ptr<KernelI>;
+
+        template <typename... Ts>
+        static ResultT generate(std::tuple<Ts...> testParams)
+        {
+            // Map GTest params to Kernel params
+            using TestParamsT = std::tuple<Ts...>;
+            using KernelT
+                = Im2colLoadKernel<std::tuple_element_t<BlockM, TestParamsT>::value, // BlockM
+                                   std::tuple_element_t<BlockN, TestParamsT>::value, // BlockN
+                                   std::tuple_element_t<DataT, TestParamsT>, // DataT
+                                   std::tuple_element_t<Layout, TestParamsT>, // Layout
+                                   Dgrad>;
+
+            return std::make_shared<KernelT>();
+        }
+    };
+
+    using Im2colLoadGenerator      = Im2colLoadGeneratorBase<false>;
+    using Im2colDgradLoadGenerator = Im2colLoadGeneratorBase<true>;
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_DETAIL_IM2COL_LOAD_HPP
@@ -0,0 +1,129 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef ROCWMMA_DEVICE_IM2COL_LOAD_HPP
+#define ROCWMMA_DEVICE_IM2COL_LOAD_HPP
+
+#include <rocwmma/internal/mapping_util.hpp>
+#include <rocwmma/rocwmma.hpp>
+
+#include "unit_test_traits.hpp"
+
+namespace rocwmma
+{
+
+    // Convolution whose im2col matrix is m x n:
+    // - 1 x 2 filters over n / 2 channels, K = n
+    // - One image of (m / 4) x 3 pixels, padded by 1 in width, P x Q = (m / 4) x 4
+    // Both edge columns of the output read padding for one of the filter taps.
+    ROCWMMA_HOST_DEVICE constexpr inline conv2d_nhwc im2colTestConv(uint32_t m, uint32_t n)
+    {
+        return make_conv2d_nhwc(1u, m / 4u, 3u, n / 2u, 1u, 1u, 2u, 0u, 1u);
+    }
+
+    // Convolution whose dgrad matrix is m x n:
+    // - n / 2 filters of 1 x 2 taps, K = n
+    // - One image of (m / 4) x 4 pixels, padded by 1 in width, with a width stride of 2,
+    //   P x Q = (m / 4) x 3
+    // Half of the taps of each input pixel fall between strided output pixels.
+    ROCWMMA_HOST_DEVICE constexpr inline conv2d_nhwc_dgrad im2colDgradTestConv(uint32_t m,
+                                                                               uint32_t n)
+    {
+        return conv2d_nhwc_dgrad{
+            make_conv2d_nhwc(1u, m / 4u, 4u, 1u, n / 2u, 1u, 2u, 0u, 1u, 1u, 2u)};
+    }
+
+    // The input buffer holds the NHWC input tensor.
+    template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename DataLayout>
+    __global__ void Im2colLoadA(uint32_t     m,
+                                uint32_t     n,
+                                DataT const* in,
+                                DataT*       out,
+                                uint32_t     ld,
+                                DataT        param1,
+                                DataT        param2)
+    {
+        if constexpr(FragSize_guard<BlockM,
+                                    BlockN,
+                                    DataT,
+                                    DataLayout,
+                                    Constants::AMDGCN_WAVE_SIZE,
+                                    Constants::AMDGCN_CURRENT_ARCH_ID>::enable())
+        {
+            using Mapping = MappingUtil<BlockM, BlockN, DataT, DataLayout>;
+
+            // Mapping:
+            // Incoming -> Matrix A (im2col)
+            // BlockM -> BlockM
+            // <Dummy> -> BlockN
+            // BlockN -> BlockK
+            auto frag = fragment<matrix_a, BlockM, 1, BlockN, DataT, row_major>();
+
+            // Gather the im2col block of this wave, then store it out
+            auto coord = Mapping::matrixCoord();
+            auto conv  = im2colTestConv(m, n);
+            load_matrix_im2col_sync(frag, in, conv, get<0>(coord), get<1>(coord));
+            store_matrix_sync(Mapping::dataCoord(out, ld), frag, ld);
+        }
+    }
+
+    // The input buffer holds the NPQK output gradient tensor.
+    template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename DataLayout>
+    __global__ void Im2colDgradLoadA(uint32_t     m,
+                                     uint32_t     n,
+                                     DataT const* in,
+                                     DataT*       out,
+                                     uint32_t     ld,
+                                     DataT        param1,
+                                     DataT        param2)
+    {
+        if constexpr(FragSize_guard<BlockM,
+                                    BlockN,
+                                    DataT,
+                                    DataLayout,
+                                    Constants::AMDGCN_WAVE_SIZE,
+                                    Constants::AMDGCN_CURRENT_ARCH_ID>::enable())
+        {
+            using Mapping = MappingUtil<BlockM, BlockN, DataT, DataLayout>;
+
+            // Mapping:
+            // Incoming -> Matrix A (dgrad)
+            // BlockM -> BlockM
+            // <Dummy> -> BlockN
+            // BlockN -> BlockK
+            auto frag = fragment<matrix_a, BlockM, 1, BlockN, DataT, row_major>();
+
+            // Gather the dgrad block of this wave, then store it out
+            auto coord = Mapping::matrixCoord();
+            auto dgrad = im2colDgradTestConv(m, n);
+            load_matrix_im2col_sync(frag, in, dgrad, get<0>(coord), get<1>(coord));
+            store_matrix_sync(Mapping::dataCoord(out, ld), frag, ld);
+        }
+    }
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_DEVICE_IM2COL_LOAD_HPP
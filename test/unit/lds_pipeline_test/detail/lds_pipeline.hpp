@@ -0,0 +1,142 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_DETAIL_LDS_PIPELINE_HPP
+#define ROCWMMA_DETAIL_LDS_PIPELINE_HPP
+
+#include "device/lds_pipeline.hpp"
+#include "load_store_matrix_sync_test/detail/load_store_matrix_sync.hpp"
+
+namespace rocwmma
+{
+
+    template <uint32_t Depth,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              typename DataT,
+              typename Layout,
+              bool WaveSpecialized = false,
+              bool FragPipelined   = false>
+    struct LdsPipelineKernel final : public LoadStoreMatrixSyncKernel<BlockM, BlockN, DataT, Layout>
+    {
+    private:
+        using Base = LoadStoreMatrixSyncKernel<BlockM, BlockN, DataT, Layout>;
+
+    protected:
+        // Depth stages of the A block and the transposed B block in LDS,
+        // followed by the stage counters when wave specialized
+        uint32_t ldsUsage() const final
+        {
+            return Depth * 2u * BlockM * BlockN * sizeof(DataT)
+                   + (WaveSpecialized ? 2u * Depth * sizeof(uint32_t) : 0u);
+        }
+
+        typename Base::KernelFunc kernelImpl() const final
+        {
+            return typename Base::KernelFunc(
+                LdsPipeline<Depth, BlockM, BlockN, DataT, Layout, WaveSpecialized, FragPipelined>);
+        }
+    };
+
+    // Double buffered
+    template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename Layout>
+    using LdsPipelineKernel2 = LdsPipelineKernel<2u, BlockM, BlockN, DataT, Layout>;
+
+    // Triple buffered
+    template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename Layout>
+    using LdsPipelineKernel3 = LdsPipelineKernel<3u, BlockM, BlockN, DataT, Layout>;
+
+    // Double buffered, with a producer wave synchronized per stage
+    template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename Layout>
+    using LdsPipelineKernelWs2 = LdsPipelineKernel<2u, BlockM, BlockN, DataT, Layout, true>;
+
+    // Triple buffered, with the frags double buffered in registers by fragment_pipeline
+    template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename Layout>
+    using LdsPipelineKernelFp3 = LdsPipelineKernel<3u, BlockM, BlockN, DataT, Layout, false, true>;
+
+    template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename Layout>
+    struct LdsStashKernel final : public LoadStoreMatrixSyncKernel<BlockM, BlockN, DataT, Layout>
+    {
+    private:
+        using Base = LoadStoreMatrixSyncKernel<BlockM, BlockN, DataT, Layout>;
+
+    protected:
+        // Two slots of one block per wave, of at least one register per lane
+        uint32_t ldsUsage() const final
+        {
+            auto warpSize  = Base::DeviceInfo::instance()->warpSize();
+            auto slotBytes = std::max<uint32_t>(BlockM * BlockN * sizeof(DataT), warpSize * 4u);
+            return this->mTBlockX / warpSize * this->mTBlockY * 2u * slotBytes;
+        }
+
+        typename Base::KernelFunc kernelImpl() const final
+        {
+            return typename Base::KernelFunc(LdsStash<BlockM, BlockN, DataT, Layout>);
+        }
+    };
+
+    template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename Layout, bool Reduce>
+    struct LdsExchangeKernel final : public LoadStoreMatrixSyncKernel<BlockM, BlockN, DataT, Layout>
+    {
+    private:
+        using Base = LoadStoreMatrixSyncKernel<BlockM, BlockN, DataT, Layout>;
+
+    protected:
+        // A channel per wave of two slots for the ring, or one slot per wave but wave 0 for
+        // the reduction, each followed by its counters
+        uint32_t ldsUsage() const final
+        {
+            auto warpSize  = Base::DeviceInfo::instance()->warpSize();
+            auto waveCount = this->mTBlockX / warpSize * this->mTBlockY;
+            auto slotBytes = std::max<uint32_t>(BlockM * BlockN * sizeof(DataT), warpSize * 4u);
+            auto slots     = Reduce ? 1u : 2u;
+            auto channelBytes
+                = (slots * slotBytes + 2u * slots * sizeof(uint32_t) + 15u) / 16u * 16u;
+            return (Reduce ? waveCount - 1u : waveCount) * channelBytes;
+        }
+
+        typename Base::KernelFunc kernelImpl() const final
+        {
+            return typename Base::KernelFunc(LdsExchange<BlockM, BlockN, DataT, Layout, Reduce>);
+        }
+    };
+
+    template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename Layout>
+    using LdsChannelKernel = LdsExchangeKernel<BlockM, BlockN, DataT, Layout, false>;
+
+    template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename Layout>
+    using LdsReductionKernel = LdsExchangeKernel<BlockM, BlockN, DataT, Layout, true>;
+
+    using LdsPipelineGenerator2   = LoadStoreMatrixSyncGenerator<LdsPipelineKernel2>;
+    using LdsPipelineGenerator3   = LoadStoreMatrixSyncGenerator<LdsPipelineKernel3>;
+    using LdsPipelineGeneratorWs2 = LoadStoreMatrixSyncGenerator<LdsPipelineKernelWs2>;
+    using LdsPipelineGeneratorFp3 = LoadStoreMatrixSyncGenerator<LdsPipelineKernelFp3>;
+    using LdsStashGenerator       = LoadStoreMatrixSyncGenerator<LdsStashKernel>;
+    using LdsChannelGenerator     = LoadStoreMatrixSyncGenerator<LdsChannelKernel>;
+    using LdsReductionGenerator   = LoadStoreMatrixSyncGenerator<LdsReductionKernel>;
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_DETAIL_LDS_PIPELINE_HPP
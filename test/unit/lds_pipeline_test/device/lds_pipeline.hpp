@@ -0,0 +1,616 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_DEVICE_LDS_PIPELINE_HPP
+#define ROCWMMA_DEVICE_LDS_PIPELINE_HPP
+
+#include <rocwmma/internal/mapping_util.hpp>
+#include <rocwmma/rocwmma.hpp>
+#include <rocwmma/rocwmma_pipeline.hpp>
+
+#include "unit_test_traits.hpp"
+
+namespace rocwmma
+{
+
+    // Streams the blocks of the workgroup through the LDS pipeline, one block per K step.
+    // The wave with index b keeps block b: even waves through the A path, and odd waves
+    // through the B path. B views the same block with the orthogonal layout, such that
+    // B(k, j) = A(j, k).
+    template <uint32_t Depth,
+              uint32_t WaveCount,
+              typename FragA,
+              typename FragB,
+              typename Mapping,
+              typename DataT>
+    __device__ void ldsPipelineBlocks(FragA&       fragA,
+                                      FragB&       fragB,
+                                      DataT*       ldsPtr,
+                                      DataT const* in,
+                                      uint32_t     ld,
+                                      uint32_t     waveIndex)
+    {
+        using Pipeline = lds_pipeline<Depth, WaveCount, FragA, FragB>;
+
+        auto workgroupDim      = Mapping::workgroupDim();
+        auto waveCoord         = Mapping::waveCoord();
+        auto currentBlockCoord = Mapping::blockCoord();
+
+        // Start at the first block in WG coverage
+        auto startBlockCoord = currentBlockCoord - waveCoord;
+        auto blockCount      = get<0>(workgroupDim) * get<1>(workgroupDim);
+
+        auto readBlock = [&](uint32_t blockIndex) {
+            auto blockCoord = startBlockCoord
+                              + make_coord2d(blockIndex / get<1>(workgroupDim),
+                                             blockIndex % get<1>(workgroupDim));
+            return Mapping::dataCoord(in, Mapping::matrixCoord(blockCoord), ld);
+        };
+
+        Pipeline pipeline(ldsPtr, waveIndex);
+
+        auto localRead = [&](uint32_t blockIndex) {
+            if(blockIndex == waveIndex)
+            {
+                if(waveIndex % 2u == 0u)
+                {
+                    pipeline.local_read_a(fragA, 0u);
+                }
+                else
+                {
+                    pipeline.local_read_b(fragB, 0u);
+                }
+            }
+        };
+
+        // Prologue fills Depth - 1 stages
+        auto prologue = (Depth - 1u < blockCount) ? Depth - 1u : blockCount;
+        for(uint32_t b = 0; b < prologue; b++)
+        {
+            pipeline.global_read(readBlock(b), ld, readBlock(b), ld);
+            pipeline.local_write();
+        }
+
+        synchronize_workgroup();
+
+        for(uint32_t b = prologue; b < blockCount; b++)
+        {
+            localRead(b - prologue);
+
+            if constexpr(Depth >= 3u)
+            {
+                synchronize_workgroup();
+            }
+
+            pipeline.global_read(readBlock(b), ld, readBlock(b), ld);
+            pipeline.local_write();
+
+            if constexpr(Depth == 2u)
+            {
+                synchronize_workgroup();
+            }
+
+            pipeline.advance();
+        }
+
+        if constexpr(Depth >= 3u)
+        {
+            synchronize_workgroup();
+        }
+
+        // Drain the remaining stages
+        for(uint32_t b = blockCount - prologue; b < blockCount; b++)
+        {
+            localRead(b);
+            pipeline.advance();
+        }
+    }
+
+    // Streams the same blocks as ldsPipelineBlocks with specialized waves: wave 0 is the
+    // only producer, and all waves consume. Stages are synchronized by lds_stage_barrier,
+    // whose counters follow the LDS stages, instead of workgroup barriers.
+    template <uint32_t Depth,
+              uint32_t WaveCount,
+              typename FragA,
+              typename FragB,
+              typename Mapping,
+              typename DataT>
+    __device__ void ldsPipelineBlocksWs(FragA&       fragA,
+                                        FragB&       fragB,
+                                        DataT*       ldsPtr,
+                                        DataT const* in,
+                                        uint32_t     ld,
+                                        uint32_t     waveIndex)
+    {
+        using Pipeline     = lds_pipeline<Depth, 1u, FragA, FragB>;
+        using StageBarrier = lds_stage_barrier<Depth, 1u, WaveCount>;
+
+        auto workgroupDim      = Mapping::workgroupDim();
+        auto waveCoord         = Mapping::waveCoord();
+        auto currentBlockCoord = Mapping::blockCoord();
+
+        // Start at the first block in WG coverage
+        auto startBlockCoord = currentBlockCoord - waveCoord;
+        auto blockCount      = get<0>(workgroupDim) * get<1>(workgroupDim);
+
+        auto readBlock = [&](uint32_t blockIndex) {
+            auto blockCoord = startBlockCoord
+                              + make_coord2d(blockIndex / get<1>(workgroupDim),
+                                             blockIndex % get<1>(workgroupDim));
+            return Mapping::dataCoord(in, Mapping::matrixCoord(blockCoord), ld);
+        };
+
+        Pipeline     pipeline(ldsPtr, 0u);
+        StageBarrier barrier(reinterpret_cast<uint32_t*>(ldsPtr + Depth * Pipeline::stage_size));
+
+        if(waveIndex == 0u)
+        {
+            barrier.reset();
+        }
+        synchronize_workgroup();
+
+        auto consume = [&](uint32_t blockIndex) {
+            barrier.consumer_wait(blockIndex);
+            if(blockIndex == waveIndex)
+            {
+                if(waveIndex % 2u == 0u)
+                {
+                    pipeline.local_read_a(fragA, 0u);
+                }
+                else
+                {
+                    pipeline.local_read_b(fragB, 0u);
+                }
+            }
+            barrier.consumer_release(blockIndex);
+            pipeline.advance();
+        };
+
+        // The producer also consumes, lagging Depth - 1 blocks behind its local writes
+        constexpr uint32_t lag = Depth - 1u;
+        for(uint32_t b = 0; b < blockCount; b++)
+        {
+            if(waveIndex == 0u)
+            {
+                pipeline.global_read(readBlock(b), ld, readBlock(b), ld);
+                barrier.producer_acquire(b);
+                pipeline.local_write();
+                barrier.producer_commit(b);
+
+                if(b >= lag)
+                {
+                    consume(b - lag);
+                }
+            }
+            else
+            {
+                consume(b);
+            }
+        }
+
+        // Drain the producer's remaining blocks
+        if(waveIndex == 0u)
+        {
+            for(uint32_t b = (blockCount > lag ? blockCount - lag : 0u); b < blockCount; b++)
+            {
+                consume(b);
+            }
+        }
+    }
+
+    // Streams the same blocks as ldsPipelineBlocks, with the A / B frags of each block read
+    // one block ahead into the registers of a fragment_pipeline. Requires Depth >= 3, such
+    // that the stage of the next block is readable while the current stage is written.
+    template <uint32_t Depth,
+              uint32_t WaveCount,
+              typename FragA,
+              typename FragB,
+              typename Mapping,
+              typename DataT>
+    __device__ void ldsPipelineBlocksFp(FragA&       fragA,
+                                        FragB&       fragB,
+                                        DataT*       ldsPtr,
+                                        DataT const* in,
+                                        uint32_t     ld,
+                                        uint32_t     waveIndex)
+    {
+        static_assert(Depth >= 3u, "Register double buffering requires at least 3 stages");
+
+        using Pipeline = lds_pipeline<Depth, WaveCount, FragA, FragB>;
+
+        auto workgroupDim      = Mapping::workgroupDim();
+        auto waveCoord         = Mapping::waveCoord();
+        auto currentBlockCoord = Mapping::blockCoord();
+
+        // Start at the first block in WG coverage
+        auto startBlockCoord = currentBlockCoord - waveCoord;
+        auto blockCount      = get<0>(workgroupDim) * get<1>(workgroupDim);
+
+        auto readBlock = [&](uint32_t blockIndex) {
+            auto blockCoord = startBlockCoord
+                              + make_coord2d(blockIndex / get<1>(workgroupDim),
+                                             blockIndex % get<1>(workgroupDim));
+            return Mapping::dataCoord(in, Mapping::matrixCoord(blockCoord), ld);
+        };
+
+        Pipeline pipeline(ldsPtr, waveIndex);
+
+        // Prologue fills Depth - 1 stages
+        auto prologue = (Depth - 1u < blockCount) ? Depth - 1u : blockCount;
+        for(uint32_t b = 0; b < prologue; b++)
+        {
+            pipeline.global_read(readBlock(b), ld, readBlock(b), ld);
+            pipeline.local_write();
+        }
+
+        synchronize_workgroup();
+
+        fragment_pipeline<FragA, FragB> frags;
+        frags.run(
+            blockCount,
+            [&](FragA& a, FragB& b, uint32_t) {
+                pipeline.local_read_a(a, 0u);
+                pipeline.local_read_b(b, 0u);
+                pipeline.advance();
+            },
+            [&](FragA const& a, FragB const& b, uint32_t blockIndex) {
+                auto prefetch = blockIndex + prologue < blockCount;
+                if(prefetch)
+                {
+                    auto next = readBlock(blockIndex + prologue);
+                    pipeline.global_read(next, ld, next, ld);
+                    pipeline.local_write();
+                }
+
+                if(blockIndex == waveIndex)
+                {
+                    if(waveIndex % 2u == 0u)
+                    {
+                        fragA = a;
+                    }
+                    else
+                    {
+                        fragB = b;
+                    }
+                }
+
+                if(prefetch)
+                {
+                    synchronize_workgroup();
+                }
+            });
+    }
+
+    template <uint32_t Depth,
+              bool     WaveSpecialized,
+              bool     FragPipelined,
+              uint32_t WaveCount,
+              typename FragA,
+              typename FragB,
+              typename Mapping,
+              typename DataT>
+    __device__ inline void ldsPipelineRun(FragA&       fragA,
+                                          FragB&       fragB,
+                                          DataT*       ldsPtr,
+                                          DataT const* in,
+                                          uint32_t     ld,
+                                          uint32_t     waveIndex)
+    {
+        if constexpr(WaveSpecialized)
+        {
+            ldsPipelineBlocksWs<Depth, WaveCount, FragA, FragB, Mapping>(
+                fragA, fragB, ldsPtr, in, ld, waveIndex);
+        }
+        else if constexpr(FragPipelined)
+        {
+            ldsPipelineBlocksFp<Depth, WaveCount, FragA, FragB, Mapping>(
+                fragA, fragB, ldsPtr, in, ld, waveIndex);
+        }
+        else
+        {
+            ldsPipelineBlocks<Depth, WaveCount, FragA, FragB, Mapping>(
+                fragA, fragB, ldsPtr, in, ld, waveIndex);
+        }
+    }
+
+    template <uint32_t Depth,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              typename DataT,
+              typename DataLayout,
+              bool WaveSpecialized = false,
+              bool FragPipelined   = false>
+    __global__ void LdsPipeline(uint32_t     m,
+                                uint32_t     n,
+                                DataT const* in,
+                                DataT*       out,
+                                uint32_t     ld,
+                                DataT        param1,
+                                DataT        param2)
+    {
+        if constexpr (FragSize_guard<BlockM,
+                                 BlockN,
+                                 DataT,
+                                 DataLayout,
+                                 Constants::AMDGCN_WAVE_SIZE,
+                                 Constants::AMDGCN_CURRENT_ARCH_ID>::enable())
+        {
+            // Mapping:
+            // Incoming -> Matrix A (ColNT)
+            // BlockM -> BlockM
+            // <Dummy> -> BlockN
+            // BlockN -> BlockK
+            // Matrix B views the same block transposed (BlockK x BlockM)
+            using OrthoLayout = orthogonal_layout_t<DataLayout>;
+            auto fragA = fragment<matrix_a, BlockM, 1, BlockN, DataT, DataLayout>();
+            auto fragB = fragment<matrix_b, 1, BlockM, BlockN, DataT, OrthoLayout>();
+
+            using Mapping = MappingUtil<BlockM, BlockN, DataT, DataLayout>;
+
+            HIP_DYNAMIC_SHARED(void*, localMemPtr);
+            auto* ldsPtr = reinterpret_cast<DataT*>(localMemPtr);
+
+            // All waves in the workgroup cooperate in 'row major' order
+            auto workgroupDim = Mapping::workgroupDim();
+            auto waveCoord    = Mapping::waveCoord();
+            auto waveIndex    = get<0>(waveCoord) * get<1>(workgroupDim) + get<1>(waveCoord);
+            auto waveCount    = get<0>(workgroupDim) * get<1>(workgroupDim);
+
+            using FragA = decltype(fragA);
+            using FragB = decltype(fragB);
+
+            switch(waveCount)
+            {
+            case 1:
+                ldsPipelineRun<Depth, WaveSpecialized, FragPipelined, 1, FragA, FragB, Mapping>(
+                    fragA, fragB, ldsPtr, in, ld, waveIndex);
+                break;
+            case 2:
+                ldsPipelineRun<Depth, WaveSpecialized, FragPipelined, 2, FragA, FragB, Mapping>(
+                    fragA, fragB, ldsPtr, in, ld, waveIndex);
+                break;
+            case 4:
+                ldsPipelineRun<Depth, WaveSpecialized, FragPipelined, 4, FragA, FragB, Mapping>(
+                    fragA, fragB, ldsPtr, in, ld, waveIndex);
+                break;
+            case 8:
+                ldsPipelineRun<Depth, WaveSpecialized, FragPipelined, 8, FragA, FragB, Mapping>(
+                    fragA, fragB, ldsPtr, in, ld, waveIndex);
+                break;
+            default:
+                return;
+            }
+
+            // B stores with the orthogonal layout, to the same block as A
+            if(waveIndex % 2u == 0u)
+            {
+                store_matrix_sync(Mapping::dataCoord(out, ld), fragA, ld);
+            }
+            else
+            {
+                store_matrix_sync(Mapping::dataCoord(out, ld), fragB, ld);
+            }
+        }
+    }
+
+    // Round trips the block of each wave through an lds_stash of two slots: the block is
+    // stashed to slot 0 and a filled fragment to slot 1, then slot 0 is restored over it.
+    template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename DataLayout>
+    __global__ void LdsStash(uint32_t     m,
+                             uint32_t     n,
+                             DataT const* in,
+                             DataT*       out,
+                             uint32_t     ld,
+                             DataT        param1,
+                             DataT        param2)
+    {
+        if constexpr (FragSize_guard<BlockM,
+                                 BlockN,
+                                 DataT,
+                                 DataLayout,
+                                 Constants::AMDGCN_WAVE_SIZE,
+                                 Constants::AMDGCN_CURRENT_ARCH_ID>::enable())
+        {
+            using FragA   = fragment<matrix_a, BlockM, 1, BlockN, DataT, DataLayout>;
+            using Mapping = MappingUtil<BlockM, BlockN, DataT, DataLayout>;
+            using Stash   = lds_stash<FragA, 2u>;
+
+            HIP_DYNAMIC_SHARED(void*, localMemPtr);
+
+            auto workgroupDim = Mapping::workgroupDim();
+            auto waveCoord    = Mapping::waveCoord();
+            auto waveIndex    = get<0>(waveCoord) * get<1>(workgroupDim) + get<1>(waveCoord);
+
+            auto fragA = FragA();
+            load_matrix_sync(fragA, Mapping::dataCoord(in, ld), ld);
+
+            Stash stash(localMemPtr, waveIndex);
+            stash.stash(0u, fragA);
+            fill_fragment(fragA, param1);
+            stash.stash(1u, fragA);
+            stash.restore(fragA, 0u);
+
+            store_matrix_sync(Mapping::dataCoord(out, ld), fragA, ld);
+        }
+    }
+
+    // Passes the block of each wave to the next wave in a ring of lds_channels of 2 slots.
+    // Wave w sends on channel (w + 1) % WaveCount: two filled fragments, then its block, such
+    // that the last message reuses the first slot. The receiver stores the block of the sender.
+    template <uint32_t WaveCount, typename FragA, typename Mapping, typename DataT>
+    __device__ void ldsChannelRing(DataT const* in,
+                                   DataT*       out,
+                                   uint32_t     ld,
+                                   void*        ldsPtr,
+                                   uint32_t     waveIndex,
+                                   DataT        param1,
+                                   DataT        param2)
+    {
+        using Channel = lds_channel<FragA, 2u>;
+
+        auto workgroupDim      = Mapping::workgroupDim();
+        auto waveCoord         = Mapping::waveCoord();
+        auto currentBlockCoord = Mapping::blockCoord();
+        auto startBlockCoord   = currentBlockCoord - waveCoord;
+
+        auto blockData = [&](auto* data, uint32_t blockIndex) {
+            auto blockCoord = startBlockCoord
+                              + make_coord2d(blockIndex / get<1>(workgroupDim),
+                                             blockIndex % get<1>(workgroupDim));
+            return Mapping::dataCoord(data, Mapping::matrixCoord(blockCoord), ld);
+        };
+
+        auto* lds         = reinterpret_cast<char*>(ldsPtr);
+        auto  sendChannel = Channel(lds + ((waveIndex + 1u) % WaveCount) * Channel::size_bytes);
+        auto  recvChannel = Channel(lds + waveIndex * Channel::size_bytes);
+
+        recvChannel.reset();
+        synchronize_workgroup();
+
+        FragA messages[3];
+        fill_fragment(messages[0], param1);
+        fill_fragment(messages[1], param2);
+        load_matrix_sync(messages[2], blockData(in, waveIndex), ld);
+
+        FragA received;
+        for(uint32_t seq = 0u; seq < 3u; seq++)
+        {
+            send_fragment(sendChannel, messages[seq], seq);
+            recv_fragment(received, recvChannel, seq);
+        }
+
+        auto sender = (waveIndex + WaveCount - 1u) % WaveCount;
+        store_matrix_sync(blockData(out, sender), received, ld);
+    }
+
+    // Routes the block of each wave to wave 0 through one lds_reduction per wave: in round r,
+    // all waves read the block of wave r, and only wave r contributes it, the others zeros.
+    // Wave 0 stores the result of each round to the block of wave r.
+    template <uint32_t WaveCount, typename FragA, typename Mapping, typename DataT>
+    __device__ void ldsReductionRounds(
+        DataT const* in, DataT* out, uint32_t ld, void* ldsPtr, uint32_t waveIndex)
+    {
+        using Reduction = lds_reduction<FragA, WaveCount>;
+
+        auto workgroupDim      = Mapping::workgroupDim();
+        auto waveCoord         = Mapping::waveCoord();
+        auto currentBlockCoord = Mapping::blockCoord();
+        auto startBlockCoord   = currentBlockCoord - waveCoord;
+
+        auto blockData = [&](auto* data, uint32_t blockIndex) {
+            auto blockCoord = startBlockCoord
+                              + make_coord2d(blockIndex / get<1>(workgroupDim),
+                                             blockIndex % get<1>(workgroupDim));
+            return Mapping::dataCoord(data, Mapping::matrixCoord(blockCoord), ld);
+        };
+
+        Reduction reduction(ldsPtr, waveIndex);
+        if(waveIndex == 0u)
+        {
+            reduction.reset();
+        }
+        synchronize_workgroup();
+
+        for(uint32_t r = 0u; r < WaveCount; r++)
+        {
+            FragA fragA;
+            load_matrix_sync(fragA, blockData(in, r), ld);
+            if(waveIndex != r)
+            {
+                fill_fragment(fragA, static_cast<DataT>(0));
+            }
+
+            reduction.reduce(fragA, r);
+
+            if(waveIndex == 0u)
+            {
+                store_matrix_sync(blockData(out, r), fragA, ld);
+            }
+        }
+    }
+
+    template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename DataLayout, bool Reduce>
+    __global__ void LdsExchange(uint32_t     m,
+                                uint32_t     n,
+                                DataT const* in,
+                                DataT*       out,
+                                uint32_t     ld,
+                                DataT        param1,
+                                DataT        param2)
+    {
+        if constexpr (FragSize_guard<BlockM,
+                                 BlockN,
+                                 DataT,
+                                 DataLayout,
+                                 Constants::AMDGCN_WAVE_SIZE,
+                                 Constants::AMDGCN_CURRENT_ARCH_ID>::enable())
+        {
+            using FragA   = fragment<matrix_a, BlockM, 1, BlockN, DataT, DataLayout>;
+            using Mapping = MappingUtil<BlockM, BlockN, DataT, DataLayout>;
+
+            HIP_DYNAMIC_SHARED(void*, localMemPtr);
+
+            auto workgroupDim = Mapping::workgroupDim();
+            auto waveCoord    = Mapping::waveCoord();
+            auto waveIndex    = get<0>(waveCoord) * get<1>(workgroupDim) + get<1>(waveCoord);
+            auto waveCount    = get<0>(workgroupDim) * get<1>(workgroupDim);
+
+            auto run = [&](auto waveCountC) {
+                constexpr uint32_t WaveCount = decltype(waveCountC)::value;
+                if constexpr(Reduce)
+                {
+                    ldsReductionRounds<WaveCount, FragA, Mapping>(
+                        in, out, ld, localMemPtr, waveIndex);
+                }
+                else
+                {
+                    ldsChannelRing<WaveCount, FragA, Mapping>(
+                        in, out, ld, localMemPtr, waveIndex, param1, param2);
+                }
+            };
+
+            switch(waveCount)
+            {
+            case 1:
+                run(std::integral_constant<uint32_t, 1u>{});
+                break;
+            case 2:
+                run(std::integral_constant<uint32_t, 2u>{});
+                break;
+            case 4:
+                run(std::integral_constant<uint32_t, 4u>{});
+                break;
+            case 8:
+                run(std::integral_constant<uint32_t, 8u>{});
+                break;
+            default:
+                return;
+            }
+        }
+    }
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_DEVICE_LDS_PIPELINE_HPP
@@ -0,0 +1,208 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <type_traits>
+
+#include "detail/lds_pipeline.hpp"
+#include "kernel_generator.hpp"
+#include "unit_test.hpp"
+
+namespace rocwmma
+{
+
+    template <typename GeneratorImpl>
+    struct TestParams : public UnitTestParams
+    {
+        using Base = UnitTestParams;
+
+        // Types: Base IOC
+        // Block Sizes: 64 x BlockK
+        // Layouts: N, T
+        using Types        = typename Base::TestTypesIOC;
+        using BlockSizes   = typename Base::TestBlockSizes64;
+        using Layouts      = typename Base::TestLayoutsAll;
+        using KernelParams = typename CombineLists<Types, BlockSizes, Layouts>::Result;
+
+        // Assemble the kernel generator
+        using KernelGenerator = KernelGenerator<KernelParams, GeneratorImpl>;
+
+        // Sanity check for kernel generator
+        static_assert(std::is_same<typename GeneratorImpl::ResultT, typename Base::KernelT>::value,
+                      "Kernels from this generator do not match testing interface");
+
+        static inline typename KernelGenerator::ResultT kernels()
+        {
+            return KernelGenerator::generate();
+        }
+    };
+
+    // Kernel: LdsPipeline, double and triple buffered
+    using TestParams2 = TestParams<LdsPipelineGenerator2>;
+    using TestParams3 = TestParams<LdsPipelineGenerator3>;
+
+    // Kernel: LdsPipeline, double buffered with a specialized producer wave
+    using TestParamsWs2 = TestParams<LdsPipelineGeneratorWs2>;
+
+    // Kernel: LdsPipeline, triple buffered with register double buffered frags
+    using TestParamsFp3 = TestParams<LdsPipelineGeneratorFp3>;
+
+    // Kernel: LdsStash, round trip of each wave's block through LDS slots
+    using TestParamsStash = TestParams<LdsStashGenerator>;
+
+    // Kernel: LdsChannel, ring of each wave's block through the channel of the next wave
+    using TestParamsChannel = TestParams<LdsChannelGenerator>;
+
+    // Kernel: LdsReduction, each wave's block routed to wave 0 by a tree reduction
+    using TestParamsReduction = TestParams<LdsReductionGenerator>;
+
+} // namespace rocwmma
+
+// Test suites for unique parameterization
+class LdsPipelineTest64 : public rocwmma::UnitTest
+{
+};
+
+class LdsPipelineTripleTest64 : public rocwmma::UnitTest
+{
+};
+
+class LdsPipelineWsTest64 : public rocwmma::UnitTest
+{
+};
+
+class LdsPipelineFragTest64 : public rocwmma::UnitTest
+{
+};
+
+class LdsStashTest64 : public rocwmma::UnitTest
+{
+};
+
+class LdsChannelTest64 : public rocwmma::UnitTest
+{
+};
+
+class LdsReductionTest64 : public rocwmma::UnitTest
+{
+};
+
+TEST_P(LdsPipelineTest64, RunKernel)
+{
+    this->RunKernel();
+}
+
+TEST_P(LdsPipelineTripleTest64, RunKernel)
+{
+    this->RunKernel();
+}
+
+TEST_P(LdsPipelineWsTest64, RunKernel)
+{
+    this->RunKernel();
+}
+
+TEST_P(LdsPipelineFragTest64, RunKernel)
+{
+    this->RunKernel();
+}
+
+TEST_P(LdsStashTest64, RunKernel)
+{
+    this->RunKernel();
+}
+
+TEST_P(LdsChannelTest64, RunKernel)
+{
+    this->RunKernel();
+}
+
+TEST_P(LdsReductionTest64, RunKernel)
+{
+    this->RunKernel();
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    KernelTests,
+    LdsPipelineTest64,
+    ::testing::Combine(::testing::ValuesIn(rocwmma::TestParams2::kernels()),
+                       ::testing::ValuesIn(rocwmma::TestParams2::threadBlocks()),
+                       ::testing::ValuesIn(rocwmma::TestParams2::problemSizes()),
+                       ::testing::ValuesIn(rocwmma::TestParams2::param1s()),
+                       ::testing::ValuesIn(rocwmma::TestParams2::param2s())));
+
+INSTANTIATE_TEST_SUITE_P(
+    KernelTests,
+    LdsPipelineTripleTest64,
+    ::testing::Combine(::testing::ValuesIn(rocwmma::TestParams3::kernels()),
+                       ::testing::ValuesIn(rocwmma::TestParams3::threadBlocks()),
+                       ::testing::ValuesIn(rocwmma::TestParams3::problemSizes()),
+                       ::testing::ValuesIn(rocwmma::TestParams3::param1s()),
+                       ::testing::ValuesIn(rocwmma::TestParams3::param2s())));
+
+INSTANTIATE_TEST_SUITE_P(
+    KernelTests,
+    LdsPipelineWsTest64,
+    ::testing::Combine(::testing::ValuesIn(rocwmma::TestParamsWs2::kernels()),
+                       ::testing::ValuesIn(rocwmma::TestParamsWs2::threadBlocks()),
+                       ::testing::ValuesIn(rocwmma::TestParamsWs2::problemSizes()),
+                       ::testing::ValuesIn(rocwmma::TestParamsWs2::param1s()),
+                       ::testing::ValuesIn(rocwmma::TestParamsWs2::param2s())));
+
+INSTANTIATE_TEST_SUITE_P(
+    KernelTests,
+    LdsPipelineFragTest64,
+    ::testing::Combine(::testing::ValuesIn(rocwmma::TestParamsFp3::kernels()),
+                       ::testing::ValuesIn(rocwmma::TestParamsFp3::threadBlocks()),
+                       ::testing::ValuesIn(rocwmma::TestParamsFp3::problemSizes()),
+                       ::testing::ValuesIn(rocwmma::TestParamsFp3::param1s()),
+                       ::testing::ValuesIn(rocwmma::TestParamsFp3::param2s())));
+
+INSTANTIATE_TEST_SUITE_P(
+    KernelTests,
+    LdsStashTest64,
+    ::testing::Combine(::testing::ValuesIn(rocwmma::TestParamsStash::kernels()),
+                       ::testing::ValuesIn(rocwmma::TestParamsStash::threadBlocks()),
+                       ::testing::ValuesIn(rocwmma::TestParamsStash::problemSizes()),
+                       ::testing::ValuesIn(rocwmma::TestParamsStash::param1s()),
+                       ::testing::ValuesIn(rocwmma::TestParamsStash::param2s())));
+
+INSTANTIATE_TEST_SUITE_P(
+    KernelTests,
+    LdsChannelTest64,
+    ::testing::Combine(::testing::ValuesIn(rocwmma::TestParamsChannel::kernels()),
+                       ::testing::ValuesIn(rocwmma::TestParamsChannel::threadBlocks()),
+                       ::testing::ValuesIn(rocwmma::TestParamsChannel::problemSizes()),
+                       ::testing::ValuesIn(rocwmma::TestParamsChannel::param1s()),
+                       ::testing::ValuesIn(rocwmma::TestParamsChannel::param2s())));
+
+INSTANTIATE_TEST_SUITE_P(
+    KernelTests,
+    LdsReductionTest64,
+    ::testing::Combine(::testing::ValuesIn(rocwmma::TestParamsReduction::kernels()),
+                       ::testing::ValuesIn(rocwmma::TestParamsReduction::threadBlocks()),
+                       ::testing::ValuesIn(rocwmma::TestParamsReduction::problemSizes()),
+                       ::testing::ValuesIn(rocwmma::TestParamsReduction::param1s()),
+                       ::testing::ValuesIn(rocwmma::TestParamsReduction::param2s())));
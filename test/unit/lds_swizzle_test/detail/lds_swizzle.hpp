@@ -0,0 +1,126 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef ROCWMMA_DETAIL_LDS_SWIZZLE_HPP
+#define ROCWMMA_DETAIL_LDS_SWIZZLE_HPP
+
+#include "device/lds_swizzle.hpp"
+#include "load_store_matrix_sync_test/detail/load_store_matrix_sync.hpp"
+
+namespace rocwmma
+{
+
+    template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename Layout>
+    struct LdsSwizzleKernel : public LoadStoreMatrixSyncKernel<BlockM, BlockN, DataT, Layout>
+    {
+    private:
+        using Base = LoadStoreMatrixSyncKernel<BlockM, BlockN, DataT, Layout>;
+
+    protected:
+        // One swizzled block in LDS per wave
+        uint32_t ldsUsage() const final
+        {
+            auto waveCount
+                = Base::mTBlockX * Base::mTBlockY / Base::DeviceInfo::instance()->warpSize();
+            return waveCount * BlockM * BlockN * sizeof(DataT);
+        }
+    };
+
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              typename DataT,
+              typename Layout,
+              typename AccessPolicy = LdsSwizzle>
+    struct LdsSwizzleKernelA final : public LdsSwizzleKernel<BlockM, BlockN, DataT, Layout>
+    {
+    private:
+        using Base = LdsSwizzleKernel<BlockM, BlockN, DataT, Layout>;
+
+    protected:
+        typename Base::KernelFunc kernelImpl() const final
+        {
+            return typename Base::KernelFunc(
+                LdsSwizzleA<BlockM, BlockN, DataT, Layout, AccessPolicy>);
+        }
+    };
+
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              typename DataT,
+              typename Layout,
+              typename AccessPolicy = LdsSwizzle>
+    struct LdsSwizzleKernelB final : public LdsSwizzleKernel<BlockM, BlockN, DataT, Layout>
+    {
+    private:
+        using Base = LdsSwizzleKernel<BlockM, BlockN, DataT, Layout>;
+
+    protected:
+        typename Base::KernelFunc kernelImpl() const final
+        {
+            return typename Base::KernelFunc(
+                LdsSwizzleB<BlockM, BlockN, DataT, Layout, AccessPolicy>);
+        }
+    };
+
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              typename DataT,
+              typename Layout,
+              typename AccessPolicy = LdsSwizzle>
+    struct LdsSwizzleKernelAcc final : public LdsSwizzleKernel<BlockM, BlockN, DataT, Layout>
+    {
+    private:
+        using Base = LdsSwizzleKernel<BlockM, BlockN, DataT, Layout>;
+
+    protected:
+        typename Base::KernelFunc kernelImpl() const final
+        {
+            return typename Base::KernelFunc(
+                LdsSwizzleAcc<BlockM, BlockN, DataT, Layout, AccessPolicy>);
+        }
+    };
+
+    // Unswizzled round trips through the LDS address space
+    template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename Layout>
+    using LdsAccessKernelA = LdsSwizzleKernelA<BlockM, BlockN, DataT, Layout, lds_access>;
+
+    template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename Layout>
+    using LdsAccessKernelB = LdsSwizzleKernelB<BlockM, BlockN, DataT, Layout, lds_access>;
+
+    template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename Layout>
+    using LdsAccessKernelAcc = LdsSwizzleKernelAcc<BlockM, BlockN, DataT, Layout, lds_access>;
+
+    using LdsSwizzleGeneratorA   = LoadStoreMatrixSyncGenerator<LdsSwizzleKernelA>;
+    using LdsSwizzleGeneratorB   = LoadStoreMatrixSyncGenerator<LdsSwizzleKernelB>;
+    using LdsSwizzleGeneratorAcc = LoadStoreMatrixSyncGenerator<LdsSwizzleKernelAcc>;
+
+    using LdsAccessGeneratorA   = LoadStoreMatrixSyncGenerator<LdsAccessKernelA>;
+    using LdsAccessGeneratorB   = LoadStoreMatrixSyncGenerator<LdsAccessKernelB>;
+    using LdsAccessGeneratorAcc = LoadStoreMatrixSyncGenerator<LdsAccessKernelAcc>;
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_DETAIL_LDS_SWIZZLE_HPP
@@ -0,0 +1,184 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef ROCWMMA_DEVICE_LDS_SWIZZLE_HPP
+#define ROCWMMA_DEVICE_LDS_SWIZZLE_HPP
+
+#include <rocwmma/internal/mapping_util.hpp>
+#include <rocwmma/rocwmma.hpp>
+#include <rocwmma/rocwmma_coop.hpp>
+
+#include "unit_test_traits.hpp"
+
+namespace rocwmma
+{
+
+    // 16B chunks permuted over 128B rows, covering all 32 banks.
+    // IO vectors are at most 16B and LDS tiles are multiples of 128B.
+    using LdsSwizzle = xor_swizzle<8u, 16u, 128u>;
+
+    // Swizzle must be a non-trivial involution.
+    static_assert(detail::XorSwizzle<8u, 16u, 128u>::exec(0u) == 0u, "Unexpected swizzle");
+    static_assert(detail::XorSwizzle<8u, 16u, 128u>::exec(128u) == 144u, "Unexpected swizzle");
+    static_assert(detail::XorSwizzle<8u, 16u, 128u>::exec(144u) == 128u, "Unexpected swizzle");
+    static_assert(detail::XorSwizzle<8u, 16u, 128u>::exec(1028u) == 1028u, "Unexpected swizzle");
+    static_assert(detail::XorSwizzle<8u, 16u, 128u>::exec(1924u) == 2036u, "Unexpected swizzle");
+
+    // Round trip of each wave's block through its own LDS tile, with the LDS access policy
+    template <typename FragT, typename Mapping, typename AccessPolicy, typename DataT>
+    __device__ inline void ldsSwizzleRoundTrip(
+        FragT& frag, void* localMemPtr, DataT const* in, DataT* out, uint32_t ld)
+    {
+        using IOShape          = GetIOShape_t<FragT>;
+        constexpr uint32_t Ldl = std::is_same<GetDataLayout_t<FragT>, row_major>::value
+                                     ? IOShape::BlockWidth
+                                     : IOShape::BlockHeight;
+        constexpr uint32_t BlockSize = IOShape::BlockHeight * IOShape::BlockWidth;
+
+        auto workgroupDim = Mapping::workgroupDim();
+        auto waveCoord    = Mapping::waveCoord();
+        auto waveIndex    = get<0>(waveCoord) * get<1>(workgroupDim) + get<1>(waveCoord);
+        auto* ldsPtr      = reinterpret_cast<DataT*>(localMemPtr) + waveIndex * BlockSize;
+
+        load_matrix_sync(frag, Mapping::dataCoord(in, ld), ld);
+        store_matrix_sync<AccessPolicy>(ldsPtr, frag, Ldl);
+
+        // Scramble the fragment before reading back
+        fill_fragment(frag, static_cast<DataT>(0));
+        synchronize_workgroup();
+
+        load_matrix_sync<AccessPolicy>(frag, ldsPtr, Ldl);
+        store_matrix_sync(Mapping::dataCoord(out, ld), frag, ld);
+    }
+
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              typename DataT,
+              typename DataLayout,
+              typename AccessPolicy = LdsSwizzle>
+    __global__ void LdsSwizzleA(uint32_t     m,
+                                uint32_t     n,
+                                DataT const* in,
+                                DataT*       out,
+                                uint32_t     ld,
+                                DataT        param1,
+                                DataT        param2)
+    {
+        if constexpr (FragSize_guard<BlockM,
+                                 BlockN,
+                                 DataT,
+                                 DataLayout,
+                                 Constants::AMDGCN_WAVE_SIZE,
+                                 Constants::AMDGCN_CURRENT_ARCH_ID>::enable())
+        {
+            using Mapping = MappingUtil<BlockM, BlockN, DataT, DataLayout>;
+
+            // Mapping:
+            // Incoming -> Matrix A (ColNT)
+            // BlockM -> BlockM
+            // <Dummy> -> BlockN
+            // BlockN -> BlockK
+            auto frag = fragment<matrix_a, BlockM, 1, BlockN, DataT, DataLayout>();
+
+            HIP_DYNAMIC_SHARED(void*, localMemPtr);
+            ldsSwizzleRoundTrip<decltype(frag), Mapping, AccessPolicy>(
+                frag, localMemPtr, in, out, ld);
+        }
+    }
+
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              typename DataT,
+              typename DataLayout,
+              typename AccessPolicy = LdsSwizzle>
+    __global__ void LdsSwizzleB(uint32_t     m,
+                                uint32_t     n,
+                                DataT const* in,
+                                DataT*       out,
+                                uint32_t     ld,
+                                DataT        param1,
+                                DataT        param2)
+    {
+        if constexpr (FragSize_guard<BlockM,
+                                 BlockN,
+                                 DataT,
+                                 DataLayout,
+                                 Constants::AMDGCN_WAVE_SIZE,
+                                 Constants::AMDGCN_CURRENT_ARCH_ID>::enable())
+        {
+            using Mapping = MappingUtil<BlockM, BlockN, DataT, DataLayout>;
+
+            // Mapping:
+            // Incoming -> Matrix B (RowNT)
+            // <Dummy> -> BlockM
+            // BlockN -> BlockN
+            // BlockM -> BlockK
+            auto frag = fragment<matrix_b, 1, BlockN, BlockM, DataT, DataLayout>();
+
+            HIP_DYNAMIC_SHARED(void*, localMemPtr);
+            ldsSwizzleRoundTrip<decltype(frag), Mapping, AccessPolicy>(
+                frag, localMemPtr, in, out, ld);
+        }
+    }
+
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              typename DataT,
+              typename DataLayout,
+              typename AccessPolicy = LdsSwizzle>
+    __global__ void LdsSwizzleAcc(uint32_t     m,
+                                  uint32_t     n,
+                                  DataT const* in,
+                                  DataT*       out,
+                                  uint32_t     ld,
+                                  DataT        param1,
+                                  DataT        param2)
+    {
+        if constexpr (FragSize_guard<BlockM,
+                                 BlockN,
+                                 DataT,
+                                 DataLayout,
+                                 Constants::AMDGCN_WAVE_SIZE,
+                                 Constants::AMDGCN_CURRENT_ARCH_ID>::enable())
+        {
+            using Mapping = MappingUtil<BlockM, BlockN, DataT, DataLayout>;
+
+            // Mapping:
+            // Incoming -> Matrix C (Row4T)
+            // BlockM -> BlockM
+            // BlockN -> BlockN
+            // <Dummy> -> BlockK
+            auto frag = fragment<accumulator, BlockM, BlockN, 1, DataT, DataLayout>();
+
+            HIP_DYNAMIC_SHARED(void*, localMemPtr);
+            ldsSwizzleRoundTrip<decltype(frag), Mapping, AccessPolicy>(
+                frag, localMemPtr, in, out, ld);
+        }
+    }
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_DEVICE_LDS_SWIZZLE_HPP
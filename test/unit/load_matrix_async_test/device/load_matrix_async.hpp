@@ -0,0 +1,159 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef ROCWMMA_DEVICE_LOAD_MATRIX_ASYNC_HPP
+#define ROCWMMA_DEVICE_LOAD_MATRIX_ASYNC_HPP
+
+#include <rocwmma/internal/mapping_util.hpp>
+#include <rocwmma/rocwmma.hpp>
+#include <rocwmma/rocwmma_coop.hpp>
+
+#include "unit_test_traits.hpp"
+
+namespace rocwmma
+{
+
+    template <uint32_t WaveCount, typename FragT, typename Mapping, typename DataT>
+    __device__ void loadMatrixAsyncBlocks(FragT&       frag,
+                                          DataT*       ldsPtr,
+                                          DataT const* in,
+                                          uint32_t     ld,
+                                          uint32_t     waveIndex)
+    {
+        using IOShape          = GetIOShape_t<FragT>;
+        constexpr uint32_t Ldl = std::is_same<GetDataLayout_t<FragT>, row_major>::value
+                                     ? IOShape::BlockWidth
+                                     : IOShape::BlockHeight;
+        constexpr uint32_t BlockSize = IOShape::BlockHeight * IOShape::BlockWidth;
+
+        auto workgroupDim      = Mapping::workgroupDim();
+        auto waveCoord         = Mapping::waveCoord();
+        auto currentBlockCoord = Mapping::blockCoord();
+
+        // Start at the first block in WG coverage
+        auto startBlockCoord = currentBlockCoord - waveCoord;
+        auto blockCount      = get<0>(workgroupDim) * get<1>(workgroupDim);
+
+        auto readBlock = [&](uint32_t blockIndex) {
+            auto blockCoord = startBlockCoord
+                              + make_coord2d(blockIndex / get<1>(workgroupDim),
+                                             blockIndex % get<1>(workgroupDim));
+            return Mapping::dataCoord(in, Mapping::matrixCoord(blockCoord), ld);
+        };
+
+        // Double buffered LDS: prefetch the next block while waiting on the current.
+        auto token = load_matrix_async<WaveCount>(frag, ldsPtr, readBlock(0u), ld, waveIndex);
+        for(uint32_t b = 0; b < blockCount; b++)
+        {
+            auto* ldsCurrent = ldsPtr + (b % 2u) * BlockSize;
+
+            if(b + 1u < blockCount)
+            {
+                auto next = load_matrix_async<WaveCount>(
+                    frag, ldsPtr + ((b + 1u) % 2u) * BlockSize, readBlock(b + 1u), ld, waveIndex);
+
+                // Next block can remain in flight
+                wait_async(token, next);
+                token = next;
+            }
+            else
+            {
+                wait_async(token);
+            }
+
+            synchronize_workgroup();
+
+            if(b == waveIndex)
+            {
+                load_matrix_sync(frag, ldsCurrent, Ldl);
+            }
+
+            synchronize_workgroup();
+        }
+    }
+
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              typename DataT,
+              typename DataLayout>
+    __global__ void LoadMatrixAsyncA(uint32_t     m,
+                                     uint32_t     n,
+                                     DataT const* in,
+                                     DataT*       out,
+                                     uint32_t     ld,
+                                     DataT        param1,
+                                     DataT        param2)
+    {
+        if constexpr (FragSize_guard<BlockM,
+                                 BlockN,
+                                 DataT,
+                                 DataLayout,
+                                 Constants::AMDGCN_WAVE_SIZE,
+                                 Constants::AMDGCN_CURRENT_ARCH_ID>::enable())
+        {
+            // Mapping:
+            // Incoming -> Matrix A (ColNT)
+            // BlockM -> BlockM
+            // <Dummy> -> BlockN
+            // BlockN -> BlockK
+            auto frag = fragment<matrix_a, BlockM, 1, BlockN, DataT, DataLayout>();
+
+            using Mapping = MappingUtil<BlockM, BlockN, DataT, DataLayout>;
+
+            HIP_DYNAMIC_SHARED(void*, localMemPtr);
+            auto* ldsPtr = reinterpret_cast<DataT*>(localMemPtr);
+
+            // All waves in the workgroup cooperate in 'row major' order
+            auto workgroupDim = Mapping::workgroupDim();
+            auto waveCoord    = Mapping::waveCoord();
+            auto waveIndex    = get<0>(waveCoord) * get<1>(workgroupDim) + get<1>(waveCoord);
+            auto waveCount    = get<0>(workgroupDim) * get<1>(workgroupDim);
+
+            switch(waveCount)
+            {
+            case 1:
+                loadMatrixAsyncBlocks<1, decltype(frag), Mapping>(frag, ldsPtr, in, ld, waveIndex);
+                break;
+            case 2:
+                loadMatrixAsyncBlocks<2, decltype(frag), Mapping>(frag, ldsPtr, in, ld, waveIndex);
+                break;
+            case 4:
+                loadMatrixAsyncBlocks<4, decltype(frag), Mapping>(frag, ldsPtr, in, ld, waveIndex);
+                break;
+            case 8:
+                loadMatrixAsyncBlocks<8, decltype(frag), Mapping>(frag, ldsPtr, in, ld, waveIndex);
+                break;
+            default:
+                return;
+            }
+
+            store_matrix_sync(Mapping::dataCoord(out, ld), frag, ld);
+        }
+    }
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_DEVICE_LOAD_MATRIX_ASYNC_HPP
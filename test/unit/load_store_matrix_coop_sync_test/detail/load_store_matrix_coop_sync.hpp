@@ -33,6 +33,16 @@
 namespace rocwmma
 {
 
+    // Waves cooperating on each block, per sharingDim (param1):
+    // 0 = waves in same row, 1 = waves in same col.
+    template <typename DataT>
+    inline uint32_t coopWaveCount(uint32_t tBlockX, uint32_t tBlockY, DataT sharingDim)
+    {
+        return static_cast<uint32_t>(rocwmma::convert<float32_t>(sharingDim)) == 0u
+                   ? tBlockY
+                   : tBlockX / HipDevice::instance()->warpSize();
+    }
+
     template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename Layout>
     struct LoadStoreMatrixCoopSyncKernelA final
         : public LoadStoreMatrixSyncKernel<BlockM, BlockN, DataT, Layout>
@@ -46,6 +56,22 @@ namespace rocwmma
             return
                 typename Base::KernelFunc(LoadStoreMatrixCoopSyncA<BlockM, BlockN, DataT, Layout>);
         }
+
+        typename Base::VWFunc vwImpl() const final
+        {
+            return typename Base::VWFunc(
+                LoadStoreMatrixSyncVW<matrix_a, BlockM, BlockN, DataT, Layout>);
+        }
+
+        char const* matrixName() const final
+        {
+            return "A";
+        }
+
+        uint32_t waveCount() const final
+        {
+            return coopWaveCount(Base::mTBlockX, Base::mTBlockY, Base::mParam1);
+        }
     };
 
     template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename Layout>
@@ -61,6 +87,22 @@ namespace rocwmma
             return
                 typename Base::KernelFunc(LoadStoreMatrixCoopSyncB<BlockM, BlockN, DataT, Layout>);
         }
+
+        typename Base::VWFunc vwImpl() const final
+        {
+            return typename Base::VWFunc(
+                LoadStoreMatrixSyncVW<matrix_b, BlockM, BlockN, DataT, Layout>);
+        }
+
+        char const* matrixName() const final
+        {
+            return "B";
+        }
+
+        uint32_t waveCount() const final
+        {
+            return coopWaveCount(Base::mTBlockX, Base::mTBlockY, Base::mParam1);
+        }
     };
 
     template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename Layout>
@@ -76,6 +118,22 @@ namespace rocwmma
             return typename Base::KernelFunc(
                 LoadStoreMatrixCoopSyncAcc<BlockM, BlockN, DataT, Layout>);
         }
+
+        typename Base::VWFunc vwImpl() const final
+        {
+            return typename Base::VWFunc(
+                LoadStoreMatrixSyncVW<accumulator, BlockM, BlockN, DataT, Layout>);
+        }
+
+        char const* matrixName() const final
+        {
+            return "Acc";
+        }
+
+        uint32_t waveCount() const final
+        {
+            return coopWaveCount(Base::mTBlockX, Base::mTBlockY, Base::mParam1);
+        }
     };
 
     using LoadStoreMatrixCoopSyncGeneratorA
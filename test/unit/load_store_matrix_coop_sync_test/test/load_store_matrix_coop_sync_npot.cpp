@@ -0,0 +1,156 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <type_traits>
+
+#include "detail/load_store_matrix_coop_sync.hpp"
+#include "kernel_generator.hpp"
+#include "unit_test.hpp"
+
+namespace rocwmma
+{
+
+    // Cooperative loads and stores amongst wave counts that are not powers of 2.
+    // The work items are split evenly amongst the largest wave count that divides them.
+    template <typename GeneratorImpl>
+    struct TestParams : public UnitTestParams
+    {
+        using Base = UnitTestParams;
+
+        // Types: Base IOC
+        // Block Sizes: 16, 32 and 64 x BlockK
+        // Layouts: N, T
+        using Types = typename Base::TestTypesIOC;
+        using BlockSizes =
+            typename Concat<typename Base::TestBlockSizes16,
+                            typename Concat<typename Base::TestBlockSizes32,
+                                            typename Base::TestBlockSizes64>::Result>::Result;
+        using Layouts      = typename Base::TestLayoutsAll;
+        using KernelParams = typename CombineLists<Types, BlockSizes, Layouts>::Result;
+
+        // Assemble the kernel generator
+        using KernelGenerator = KernelGenerator<KernelParams, GeneratorImpl>;
+
+        // Sanity check for kernel generator
+        static_assert(std::is_same<typename GeneratorImpl::ResultT, typename Base::KernelT>::value,
+                      "Kernels from this generator do not match testing interface");
+
+        static inline typename KernelGenerator::ResultT kernels()
+        {
+            return KernelGenerator::generate();
+        }
+
+        static inline std::vector<ThreadBlockT> threadBlocks()
+        {
+            auto warpSize = HipDevice::instance()->warpSize();
+
+            // clang-format off
+            return { {warpSize * 3, 1}, {warpSize, 3}, // 3 Waves
+                     {warpSize * 3, 2}, {warpSize * 2, 3}, // 6 Waves
+#if ROCWMMA_EXTENDED_TESTS
+                     {warpSize * 3, 4}, {warpSize * 4, 3} // 12 Waves
+#endif // ROCWMMA_EXTENDED_TESTS
+            };
+            // clang-format on
+        }
+
+        static inline std::vector<ProblemSizeT> problemSizes()
+        {
+            // Multiples of 3 and 4 macro tiles
+            return {{192, 192}, {384, 384}, {768, 768}, {768, 1536}, {1536, 768}};
+        }
+
+        static inline std::vector<Base::Param1T> param1s()
+        {
+            return {0.0, 1.0}; // Split by waves in same row and col
+        }
+
+        static inline std::vector<Base::Param2T> param2s()
+        {
+            return {0.0, 1.0, 2.0, 3.0};
+        }
+    };
+
+    using TestParamsA   = TestParams<LoadStoreMatrixCoopSyncGeneratorA>;
+    using TestParamsB   = TestParams<LoadStoreMatrixCoopSyncGeneratorB>;
+    using TestParamsAcc = TestParams<LoadStoreMatrixCoopSyncGeneratorAcc>;
+
+} // namespace rocwmma
+
+// Test suites for unique parameterization
+class LoadStoreMatrixSyncCoopATestNpot : public rocwmma::UnitTest
+{
+};
+
+class LoadStoreMatrixSyncCoopBTestNpot : public rocwmma::UnitTest
+{
+};
+
+class LoadStoreMatrixSyncCoopAccTestNpot : public rocwmma::UnitTest
+{
+};
+
+TEST_P(LoadStoreMatrixSyncCoopATestNpot, RunKernel)
+{
+    this->RunKernel();
+}
+
+TEST_P(LoadStoreMatrixSyncCoopBTestNpot, RunKernel)
+{
+    this->RunKernel();
+}
+
+TEST_P(LoadStoreMatrixSyncCoopAccTestNpot, RunKernel)
+{
+    this->RunKernel();
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    KernelTests,
+    LoadStoreMatrixSyncCoopATestNpot,
+    ::testing::Combine(::testing::ValuesIn(rocwmma::TestParamsA::kernels()),
+                       ::testing::ValuesIn(rocwmma::TestParamsA::threadBlocks()),
+                       ::testing::ValuesIn(rocwmma::TestParamsA::problemSizes()),
+                       ::testing::ValuesIn(rocwmma::TestParamsA::param1s()),
+                       ::testing::ValuesIn(rocwmma::TestParamsA::param2s())));
+
+INSTANTIATE_TEST_SUITE_P(
+    KernelTests,
+    LoadStoreMatrixSyncCoopBTestNpot,
+    ::testing::Combine(::testing::ValuesIn(rocwmma::TestParamsB::kernels()),
+                       ::testing::ValuesIn(rocwmma::TestParamsB::threadBlocks()),
+                       ::testing::ValuesIn(rocwmma::TestParamsB::problemSizes()),
+                       ::testing::ValuesIn(rocwmma::TestParamsB::param1s()),
+                       ::testing::ValuesIn(rocwmma::TestParamsB::param2s())));
+
+INSTANTIATE_TEST_SUITE_P(
+    KernelTests,
+    LoadStoreMatrixSyncCoopAccTestNpot,
+    ::testing::Combine(::testing::ValuesIn(rocwmma::TestParamsAcc::kernels()),
+                       ::testing::ValuesIn(rocwmma::TestParamsAcc::threadBlocks()),
+                       ::testing::ValuesIn(rocwmma::TestParamsAcc::problemSizes()),
+                       ::testing::ValuesIn(rocwmma::TestParamsAcc::param1s()),
+                       ::testing::ValuesIn(rocwmma::TestParamsAcc::param2s())));
@@ -44,6 +44,27 @@ namespace rocwmma
         template <uint32_t WaveSize, uint32_t ArchId>
         using TestGuard = FragSize_guard<BlockM, BlockN, DataT, Layout, WaveSize, ArchId>;
 
+    protected:
+        // Device probe of the fragment vector widths, if the
+        // kernel maps one fragment straight to global memory.
+        using VWFunc = void (*)(uint32_t*);
+
+        virtual VWFunc vwImpl() const
+        {
+            return nullptr;
+        }
+
+        virtual char const* matrixName() const
+        {
+            return "";
+        }
+
+        // Waves sharing the load / store of each block
+        virtual uint32_t waveCount() const
+        {
+            return 1u;
+        }
+
     public:
         LoadStoreMatrixSyncKernel()          = default;
         virtual ~LoadStoreMatrixSyncKernel() = default;
@@ -63,6 +84,34 @@ namespace rocwmma
                                                     Base::mM,
                                                     Base::mN,
                                                     std::numeric_limits<DataT>::signaling_NaN());
+
+            // Record the vector widths chosen for this fragment
+            if(vwImpl() != nullptr)
+            {
+                auto vw = HipResource::allocDevice<uint32_t>(2);
+                hipLaunchKernelGGL((vwImpl()), dim3(1), dim3(1), 0, 0, vw.get());
+                CHECK_HIP_ERROR(hipMemcpy(mVW, vw.get(), sizeof(mVW), hipMemcpyDeviceToHost));
+            }
+        }
+
+        // Each element is loaded once and stored once
+        float64_t ioBytes() const final
+        {
+            return 2.0 * static_cast<float64_t>(Base::mM) * static_cast<float64_t>(Base::mN)
+                   * sizeof(DataT);
+        }
+
+        std::string kernelConfig() const final
+        {
+            if(vwImpl() == nullptr)
+            {
+                return Base::kernelConfig();
+            }
+
+            std::stringstream config;
+            config << matrixName() << "_VW" << mVW[0] << "_MaxVW" << mVW[1] << "_Waves"
+                   << waveCount();
+            return config.str();
         }
 
         void validateResultsImpl() final
@@ -125,6 +174,9 @@ namespace rocwmma
         }
 
         virtual typename Base::KernelFunc kernelImpl() const = 0;
+
+    private:
+        uint32_t mVW[2] = {0u, 0u};
     };
 
     template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename Layout>
@@ -139,6 +191,17 @@ namespace rocwmma
         {
             return typename Base::KernelFunc(LoadStoreMatrixSyncA<BlockM, BlockN, DataT, Layout>);
         }
+
+        typename Base::VWFunc vwImpl() const final
+        {
+            return typename Base::VWFunc(
+                LoadStoreMatrixSyncVW<matrix_a, BlockM, BlockN, DataT, Layout>);
+        }
+
+        char const* matrixName() const final
+        {
+            return "A";
+        }
     };
 
     template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename Layout>
@@ -153,6 +216,17 @@ namespace rocwmma
         {
             return typename Base::KernelFunc(LoadStoreMatrixSyncB<BlockM, BlockN, DataT, Layout>);
         }
+
+        typename Base::VWFunc vwImpl() const final
+        {
+            return typename Base::VWFunc(
+                LoadStoreMatrixSyncVW<matrix_b, BlockM, BlockN, DataT, Layout>);
+        }
+
+        char const* matrixName() const final
+        {
+            return "B";
+        }
     };
 
     template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename Layout>
@@ -167,6 +241,17 @@ namespace rocwmma
         {
             return typename Base::KernelFunc(LoadStoreMatrixSyncAcc<BlockM, BlockN, DataT, Layout>);
         }
+
+        typename Base::VWFunc vwImpl() const final
+        {
+            return typename Base::VWFunc(
+                LoadStoreMatrixSyncVW<accumulator, BlockM, BlockN, DataT, Layout>);
+        }
+
+        char const* matrixName() const final
+        {
+            return "Acc";
+        }
     };
 
     template <template <uint32_t, uint32_t, typename, typename> class KernelClass>
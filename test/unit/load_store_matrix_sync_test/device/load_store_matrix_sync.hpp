@@ -143,6 +143,37 @@ namespace rocwmma
         }
     }
 
+    // Reads back the IOLayout vector widths of the fragments used above.
+    // They depend on the device wave size, so only device code knows them.
+    template <typename MatrixT,
+              uint32_t BlockM,
+              uint32_t BlockN,
+              typename DataT,
+              typename DataLayout>
+    __global__ void LoadStoreMatrixSyncVW(uint32_t* vw)
+    {
+        if constexpr (FragSize_guard<BlockM,
+                                 BlockN,
+                                 DataT,
+                                 DataLayout,
+                                 Constants::AMDGCN_WAVE_SIZE,
+                                 Constants::AMDGCN_CURRENT_ARCH_ID>::enable())
+        {
+            // Same mappings as the load / store kernels
+            using FragT = conditional_t<
+                is_same<MatrixT, matrix_a>::value,
+                fragment<matrix_a, BlockM, 1, BlockN, DataT, DataLayout>,
+                conditional_t<is_same<MatrixT, matrix_b>::value,
+                              fragment<matrix_b, 1, BlockN, BlockM, DataT, DataLayout>,
+                              fragment<accumulator, BlockM, BlockN, 1, DataT, DataLayout>>>;
+
+            using IOLayout = typename GetIOConfig_t<FragT>::IOLayout;
+
+            vw[0] = IOLayout::VW;
+            vw[1] = IOLayout::MaxVW;
+        }
+    }
+
 } // namespace rocwmma
 
 #endif // ROCWMMA_DEVICE_LOAD_STORE_MATRIX_SYNC_HPP
@@ -0,0 +1,111 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <type_traits>
+
+#include "detail/load_store_matrix_sync.hpp"
+#include "kernel_generator.hpp"
+#include "unit_test.hpp"
+
+///
+/// Perf regression suite. Load / store bandwidth of the A, B and accumulator fragments
+/// over a curated set of block sizes and HBM-sized matrices, checked against the golden of
+/// the current arch. Cases fail when throughput drops beyond the tolerance, or when they
+/// have no golden record.
+///
+/// Usage: <binary> [-pg || --perf_golden *directory*] [-pt || --perf_tolerance *percent*]
+///
+
+namespace rocwmma
+{
+
+    struct PerfRegressionTestParams : public UnitTestParams
+    {
+        using Base = UnitTestParams;
+
+        // Types: f16, f32
+        // Block Sizes: 16 x 16, 32 x 16
+        // Layouts: N, T
+        using Types        = std::tuple<float16_t, float32_t>;
+        using BlockSizes   = std::tuple<std::tuple<I<16>, I<16>>, std::tuple<I<32>, I<16>>>;
+        using Layouts      = typename Base::TestLayoutsAll;
+        using KernelParams = typename CombineLists<Types, BlockSizes, Layouts>::Result;
+
+        // Assemble the kernel generators
+        // Kernels: LoadStoreMatrixSyncA, LoadStoreMatrixSyncB, LoadStoreMatrixSyncAcc
+        using KernelGeneratorA = KernelGenerator<KernelParams, LoadStoreMatrixSyncGeneratorA>;
+        using KernelGeneratorB = KernelGenerator<KernelParams, LoadStoreMatrixSyncGeneratorB>;
+        using KernelGeneratorAcc
+            = KernelGenerator<KernelParams, LoadStoreMatrixSyncGeneratorAcc>;
+
+        // Sanity check for kernel generator
+        static_assert(std::is_same<typename LoadStoreMatrixSyncGeneratorA::ResultT,
+                                   typename Base::KernelT>::value,
+                      "Kernels from this generator do not match testing interface");
+
+        static inline typename KernelGeneratorA::ResultT kernels()
+        {
+            auto result = KernelGeneratorA::generate();
+            KernelGeneratorB::generate(result);
+            KernelGeneratorAcc::generate(result);
+            return result;
+        }
+
+        static inline std::vector<ThreadBlockT> threadBlocks()
+        {
+            auto warpSize = HipDevice::instance()->warpSize();
+
+            return {{warpSize * 2, 2}};
+        }
+
+        // Shapes are part of the golden key: changing them invalidates the goldens
+        static inline std::vector<ProblemSizeT> problemSizes()
+        {
+            // Large enough to stream from HBM rather than cache
+            return {{4096, 4096}, {8192, 8192}};
+        }
+    };
+
+} // namespace rocwmma
+
+// Test suite for unique parameterization
+class LoadStoreMatrixSyncPerfRegressionTest : public rocwmma::UnitTest
+{
+};
+
+TEST_P(LoadStoreMatrixSyncPerfRegressionTest, RunKernel)
+{
+    this->RunKernel();
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    KernelTests,
+    LoadStoreMatrixSyncPerfRegressionTest,
+    ::testing::Combine(::testing::ValuesIn(rocwmma::PerfRegressionTestParams::kernels()),
+                       ::testing::ValuesIn(rocwmma::PerfRegressionTestParams::threadBlocks()),
+                       ::testing::ValuesIn(rocwmma::PerfRegressionTestParams::problemSizes()),
+                       ::testing::ValuesIn(rocwmma::PerfRegressionTestParams::param1s()),
+                       ::testing::ValuesIn(rocwmma::PerfRegressionTestParams::param2s())));
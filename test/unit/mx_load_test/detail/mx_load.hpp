@@ -0,0 +1,294 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+
+#ifndef ROCWMMA_DETAIL_MX_LOAD_HPP
+#define ROCWMMA_DETAIL_MX_LOAD_HPP
+
+#include <cmath>
+#include <type_traits>
+#include <vector>
+
+#include "device/mx_load.hpp"
+#include "helper_macros.hpp"
+#include "unit_kernel_base.hpp"
+
+namespace rocwmma
+{
+
+    // Wrapper into the actual device function
+    template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename Layout, typename QuantT>
+    struct MxLoadKernel : public UnitKernelBase<BlockM, BlockN, DataT, Layout>
+    {
+    private:
+        using Base = UnitKernelBase<BlockM, BlockN, DataT, Layout>;
+
+        template <uint32_t WaveSize, uint32_t ArchId>
+        using TestGuard = FragSize_guard<BlockM, BlockN, DataT, Layout, WaveSize, ArchId>;
+
+        static constexpr bool IsFp4     = std::is_same<QuantT, float4_e2m1x2_t>::value;
+        static constexpr bool IsFp6E2m3 = std::is_same<QuantT, float6_e2m3x4_t>::value;
+        static constexpr bool IsFp6E3m2 = std::is_same<QuantT, float6_e3m2x4_t>::value;
+
+        // Element encoding at each element index, cycling through all encodings
+        // with finite values.
+        static inline uint32_t code(int64_t idx)
+        {
+            if constexpr(IsFp4)
+            {
+                return static_cast<uint32_t>(idx % 16);
+            }
+            else if constexpr(IsFp6E2m3 || IsFp6E3m2)
+            {
+                return static_cast<uint32_t>(idx % 64);
+            }
+            else
+            {
+                auto bits = static_cast<uint32_t>(idx % 256);
+                auto inf  = std::is_same<QuantT, float8_ocp_t>::value ? 0x7Fu : 0x7Cu;
+                return (bits & 0x7Fu) >= inf ? 0u : bits;
+            }
+        }
+
+        // Reference decode of the sign, exponent and mantissa fields of MX elements
+        static inline float32_t decode(uint32_t bits, int expBits, int manBits)
+        {
+            auto bias = (1 << (expBits - 1)) - 1;
+            auto sign = (bits >> (expBits + manBits)) & 1u;
+            auto exp  = static_cast<int>((bits >> manBits) & ((1u << expBits) - 1u));
+            auto man  = static_cast<float32_t>(bits & ((1u << manBits) - 1u));
+
+            auto value = exp == 0 ? std::ldexp(man, 1 - bias - manBits)
+                                  : std::ldexp(1.0f + std::ldexp(man, -manBits), exp - bias);
+            return sign ? -value : value;
+        }
+
+        static inline float32_t elementValue(int64_t idx)
+        {
+            if constexpr(IsFp4)
+            {
+                return decode(code(idx), 2, 1);
+            }
+            else if constexpr(IsFp6E2m3)
+            {
+                return decode(code(idx), 2, 3);
+            }
+            else if constexpr(IsFp6E3m2)
+            {
+                return decode(code(idx), 3, 2);
+            }
+            else if constexpr(std::is_same<QuantT, float8_ocp_t>::value)
+            {
+                return decode(code(idx), 4, 3);
+            }
+            else
+            {
+                return decode(code(idx), 5, 2);
+            }
+        }
+
+        // Scale exponent of each scale block, in [-4, 3]
+        static inline int scaleExp(int64_t scaleRow, int64_t col)
+        {
+            return static_cast<int>((scaleRow + col) % 8) - 4;
+        }
+
+        // Matrix coordinate of the element at data offset idx
+        std::pair<int64_t, int64_t> coord(int64_t idx) const
+        {
+            return std::is_same<Layout, row_major>::value
+                       ? std::make_pair(idx / Base::mN, idx % Base::mN)
+                       : std::make_pair(idx % Base::mM, idx / Base::mM);
+        }
+
+    public:
+        MxLoadKernel()          = default;
+        virtual ~MxLoadKernel() = default;
+
+        void setupImpl(typename Base::DataStorage::ProblemSize const& probsize) final
+        {
+            auto& dataInstance = Base::DataStorage::instance();
+
+            // Initialize matrix storage
+            const int64_t sizeD = Base::mM * Base::mN;
+            dataInstance->resizeStorage(probsize);
+
+            // MX elements occupy the front of the input buffer
+            auto* quant = reinterpret_cast<uint8_t*>(dataInstance->hostIn().get());
+            std::fill(quant, quant + sizeD, 0u);
+            for(int64_t i = 0; i < sizeD; i++)
+            {
+                auto bits = code(i);
+                if constexpr(IsFp4)
+                {
+                    // Low nibble first
+                    quant[i / 2] |= static_cast<uint8_t>(bits << (4 * (i % 2)));
+                }
+                else if constexpr(IsFp6E2m3 || IsFp6E3m2)
+                {
+                    // Element i % 4 in bits [6 * (i % 4), 6 * (i % 4) + 6) of its 3 bytes
+                    auto  shift = 6 * (i % 4);
+                    auto* group = quant + 3 * (i / 4);
+                    group[shift / 8] |= static_cast<uint8_t>(bits << (shift % 8));
+                    if(shift % 8 > 2)
+                    {
+                        group[shift / 8 + 1] |= static_cast<uint8_t>(bits >> (8 - shift % 8));
+                    }
+                }
+                else
+                {
+                    quant[i] = static_cast<uint8_t>(bits);
+                }
+            }
+
+            // Followed by ceil(m / 32) x n scales, in the same layout
+            const int64_t scaleRows = (Base::mM + 31) / 32;
+            auto*         scales    = reinterpret_cast<e8m0_t*>(quant + sizeD);
+            for(int64_t r = 0; r < scaleRows; r++)
+            {
+                for(int64_t c = 0; c < Base::mN; c++)
+                {
+                    auto idx = std::is_same<Layout, row_major>::value ? r * Base::mN + c
+                                                                      : c * scaleRows + r;
+                    scales[idx].data = static_cast<uint8_t>(127 + scaleExp(r, c));
+                }
+            }
+
+            dataInstance->copyData(dataInstance->deviceIn(), dataInstance->hostIn(), sizeD);
+
+            MatrixUtil<Layout>::fillValLaunchKernel(dataInstance->deviceOut().get(),
+                                                    Base::mM,
+                                                    Base::mN,
+                                                    std::numeric_limits<DataT>::signaling_NaN());
+        }
+
+        void validateResultsImpl() final
+        {
+            auto& dataInstance = Base::DataStorage::instance();
+
+            const int64_t sizeD = Base::mM * Base::mN;
+
+            // Cache current kernel result from device
+            dataInstance->copyData(dataInstance->hostOut(), dataInstance->deviceOut(), sizeD);
+
+            // Output elements have the same data offsets as their MX sources.
+            // Scaled values are exact in DataT.
+            auto ref = std::vector<DataT>(sizeD);
+            for(int64_t i = 0; i < sizeD; i++)
+            {
+                auto rc = coord(i);
+                ref[i]  = static_cast<DataT>(
+                    std::ldexp(elementValue(i), scaleExp(rc.first / 32, rc.second)));
+            }
+
+            double errorTolerance = 10.0;
+
+            std::tie(Base::mValidationResult, Base::mMaxRelativeError)
+                = compareEqual<DataT, DataT, Layout, Layout>(
+                    dataInstance->hostOut().get(), ref.data(), Base::mM, Base::mN, errorTolerance);
+        }
+
+        bool checkQuirks() const final
+        {
+            auto waveSize   = Base::DeviceInfo::instance()->warpSize();
+            auto deviceArch = Base::DeviceInfo::instance()->getGcnArch();
+
+            // The test guard for this class requires 2 values at runtime.
+            auto dispatchGuard = [waveSize, deviceArch]() {
+                bool dispatchResult = false;
+
+#define CASE_IMPL_ASSIGN2(WAVE_SIZE, ARCH_ID) \
+    dispatchResult = TestGuard<WAVE_SIZE, ARCH_ID>::enable();
+
+#define SWITCH_BODY_WAVE_SIZE(ARCH_ID) \
+    ROCWMMA_SWITCH_BODY2_ARG2(         \
+        waveSize, CASE_IMPL_ASSIGN2, HipDevice::Wave32, HipDevice::Wave64, ARCH_ID)
+
+#define DISPATCH_GUARD_BODY                           \
+    ROCWMMA_SWITCH_BODY10_ARG1(deviceArch,            \
+                               SWITCH_BODY_WAVE_SIZE, \
+                               HipDevice::GFX908,     \
+                               HipDevice::GFX90A,     \
+                               HipDevice::GFX940,     \
+                               HipDevice::GFX941,     \
+                               HipDevice::GFX942,     \
+                               HipDevice::GFX1100,    \
+                               HipDevice::GFX1101,    \
+                               HipDevice::GFX1102,    \
+                               HipDevice::GFX1200,    \
+                               HipDevice::GFX1201)
+
+                DISPATCH_GUARD_BODY
+
+#undef CASE_IMPL_ASSIGN2
+#undef SWITCH_BODY_WAVE_SIZE
+#undef DISPATCH_GUARD_BODY
+
+                return dispatchResult;
+            };
+
+            return Base::checkQuirks() && dispatchGuard();
+        }
+
+        typename Base::KernelFunc kernelImpl() const final
+        {
+            return typename Base::KernelFunc(MxLoadB<BlockM, BlockN, DataT, Layout, QuantT>);
+        }
+    };
+
+    struct MxLoadGenerator
+    {
+        // Indices to test parameters
+        enum : uint32_t
+        {
+            DataT  = 0,
+            BlockM = 1,
+            BlockN = 2,
+            Layout = 3,
+            QuantT = 4
+        };
+
+        using ResultT = std::shared_ptr<KernelI>;
+
+        template <typename... Ts>
+        static ResultT generate(std::tuple<Ts...> testParams)
+        {
+            // Map GTest params to Kernel params
+            using TestParamsT = std::tuple<Ts...>;
+            using KernelT
+                = MxLoadKernel<std::tuple_element_t<BlockM, TestParamsT>::value, // BlockM
+                               std::tuple_element_t<BlockN, TestParamsT>::value, // BlockN
+                               std::tuple_element_t<DataT, TestParamsT>, // DataT
+                               std::tuple_element_t<Layout, TestParamsT>, // Layout
+                               std::tuple_element_t<QuantT, TestParamsT>>; // QuantT
+
+            return std::make_shared<KernelT>();
+        }
+    };
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_DETAIL_MX_LOAD_HPP
@@ -0,0 +1,100 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+
+#ifndef ROCWMMA_DEVICE_MX_LOAD_HPP
+#define ROCWMMA_DEVICE_MX_LOAD_HPP
+
+#include <rocwmma/internal/mapping_util.hpp>
+#include <rocwmma/rocwmma.hpp>
+
+#include "unit_test_traits.hpp"
+
+namespace rocwmma
+{
+
+    // MX elements per QuantT storage element
+    template <typename QuantT>
+    constexpr uint32_t MxPackRatio = is_same<QuantT, float4_e2m1x2_t>::value ? 2u
+                                     : (is_same<QuantT, float6_e2m3x4_t>::value
+                                        || is_same<QuantT, float6_e3m2x4_t>::value)
+                                         ? 4u
+                                         : 1u;
+
+    // The input buffer holds the m x n MX elements of QuantT, followed by their
+    // ceil(m / 32) x n e8m0_t scales in the same layout.
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              typename DataT,
+              typename DataLayout,
+              typename QuantT>
+    __global__ void MxLoadB(uint32_t     m,
+                            uint32_t     n,
+                            DataT const* in,
+                            DataT*       out,
+                            uint32_t     ld,
+                            DataT        param1,
+                            DataT        param2)
+    {
+        if constexpr(FragSize_guard<BlockM,
+                                    BlockN,
+                                    DataT,
+                                    DataLayout,
+                                    Constants::AMDGCN_WAVE_SIZE,
+                                    Constants::AMDGCN_CURRENT_ARCH_ID>::enable())
+        {
+            using Mapping = MappingUtil<BlockM, BlockN, DataT, DataLayout>;
+
+            // Mapping:
+            // Incoming -> Matrix B (RowNT)
+            // <Dummy> -> BlockM
+            // BlockN -> BlockN
+            // BlockM -> BlockK
+            auto frag = fragment<matrix_b, 1, BlockN, BlockM, DataT, DataLayout>();
+
+            // Packed types have several elements per storage element
+            auto coord  = Mapping::matrixCoord();
+            auto offset = Mapping::dataOffset(coord, ld);
+            auto bytes  = reinterpret_cast<uint8_t const*>(in);
+            auto read   = reinterpret_cast<QuantT const*>(bytes) + offset / MxPackRatio<QuantT>;
+
+            // Scale of the block origin. K is the row dimension of matrix_b.
+            auto scaleRows  = (m + 31u) / 32u;
+            auto lds        = is_same<DataLayout, row_major>::value ? n : scaleRows;
+            auto scaleCoord = make_coord2d(get<0>(coord) / 32u, get<1>(coord));
+            auto scales     = reinterpret_cast<e8m0_t const*>(bytes + m * n)
+                          + Mapping::dataOffset(scaleCoord, lds);
+
+            // Map, MX load and store.
+            auto* write = Mapping::dataCoord(out, ld);
+            load_matrix_mx_sync(frag, read, scales, ld, lds);
+            store_matrix_sync(write, frag, ld);
+        }
+    }
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_DEVICE_MX_LOAD_HPP
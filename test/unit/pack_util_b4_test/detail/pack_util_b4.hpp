@@ -0,0 +1,144 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef ROCWMMA_DETAIL_PACK_UTIL_B4_TEST_HPP
+#define ROCWMMA_DETAIL_PACK_UTIL_B4_TEST_HPP
+
+#include <limits>
+#include <sstream>
+
+#include "device/pack_util_b4.hpp"
+#include "unit_kernel_base.hpp"
+
+namespace rocwmma
+{
+
+    // Wrapper into the actual device function
+    template <uint32_t BlockN, uint32_t VecSize>
+    struct PackUtilB4Kernel final : public UnitKernelBase<1, BlockN, int8_t, row_major>
+    {
+    private:
+        using Base = UnitKernelBase<1, BlockN, int8_t, row_major>;
+
+        static_assert(VecSize % PackTraits<int4_t>::PackRatio == 0,
+                      "VecSize must be a whole number of packed registers");
+        static_assert(BlockN % VecSize == 0, "BlockN must be a multiple of VecSize");
+
+    public:
+        PackUtilB4Kernel()        = default;
+        ~PackUtilB4Kernel() final = default;
+
+        void setupImpl(typename Base::DataStorage::ProblemSize const& probsize) final
+        {
+            auto& dataInstance = Base::DataStorage::instance();
+
+            // Initialize matrix storage
+            const int64_t sizeD = Base::mM * Base::mN;
+            dataInstance->resizeStorage(probsize);
+
+            // Every int4 value, in a pattern that varies along the row
+            auto* in = dataInstance->hostIn().get();
+            for(int64_t i = 0; i < sizeD; i++)
+            {
+                in[i] = static_cast<int8_t>(static_cast<int32_t>((i * 5 + i / 16) % 16) - 8);
+            }
+            dataInstance->copyData(dataInstance->deviceIn(), dataInstance->hostIn(), sizeD);
+
+            // Output starts out of the int4 range
+            MatrixUtil<row_major>::fillValLaunchKernel(dataInstance->deviceOut().get(),
+                                                       Base::mM,
+                                                       Base::mN,
+                                                       std::numeric_limits<int8_t>::max());
+        }
+
+        void validateResultsImpl() final
+        {
+            auto& dataInstance = Base::DataStorage::instance();
+
+            const int64_t sizeD = Base::mM * Base::mN;
+
+            // Cache current kernel result from device
+            dataInstance->copyData(dataInstance->hostOut(), dataInstance->deviceOut(), sizeD);
+
+            // The round trip must reproduce the input exactly
+            double errorTolerance = 10.0;
+
+            std::tie(Base::mValidationResult, Base::mMaxRelativeError)
+                = compareEqual<int8_t, int8_t, row_major, row_major>(dataInstance->hostOut().get(),
+                                                                     dataInstance->hostIn().get(),
+                                                                     Base::mM,
+                                                                     Base::mN,
+                                                                     errorTolerance);
+        }
+
+        float64_t ioBytes() const final
+        {
+            return 2.0 * static_cast<float64_t>(Base::mM) * static_cast<float64_t>(Base::mN)
+                   * sizeof(int8_t);
+        }
+
+        std::string kernelConfig() const final
+        {
+            std::stringstream config;
+            config << "int4_VecSize" << VecSize;
+            return config.str();
+        }
+
+        typename Base::KernelFunc kernelImpl() const final
+        {
+            return typename Base::KernelFunc(packUtilB4Test<BlockN, VecSize>);
+        }
+    };
+
+    // This is the GeneratorImpl class
+    struct PackUtilB4Generator
+    {
+        // Indices to test parameters
+        enum : uint32_t
+        {
+            BlockN  = 0,
+            VecSize = 1
+        };
+
+        using ResultT = std::shared_ptr<KernelI>;
+
+        template <typename... Ts>
+        static ResultT generate(std::tuple<Ts...> testParams)
+        {
+            // Map GTest params to Kernel params
+            using TestParamsT = std::tuple<Ts...>;
+            using KernelT
+                = PackUtilB4Kernel<std::tuple_element_t<BlockN, TestParamsT>::value, // BlockN
+                                   std::tuple_element_t<VecSize, TestParamsT>::value // VecSize
+                                   >;
+
+            return std::make_shared<KernelT>();
+        }
+    };
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_DETAIL_PACK_UTIL_B4_TEST_HPP
@@ -0,0 +1,82 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef ROCWMMA_DEVICE_PACK_UTIL_B4_TEST_HPP
+#define ROCWMMA_DEVICE_PACK_UTIL_B4_TEST_HPP
+
+#include <rocwmma/rocwmma.hpp>
+
+namespace rocwmma
+{
+
+    // Each wave packs BlockN int4 elements of one row, held as sign-extended
+    // int8_t, to nibbles and unpacks them again to the output.
+    // Elements whose packed nibble does not match are marked in the output.
+    template <uint32_t BlockN, uint32_t VecSize>
+    __global__ void packUtilB4Test(uint32_t      m,
+                                   uint32_t      n,
+                                   int8_t const* in,
+                                   int8_t*       out,
+                                   uint32_t      ld,
+                                   int8_t        param1,
+                                   int8_t        param2)
+    {
+        using PackUtil = rocwmma::PackUtil<int4_t>;
+        using VecType  = VecT<int8_t, VecSize>;
+
+        constexpr uint32_t WaveSize = Constants::AMDGCN_WAVE_SIZE;
+        constexpr int8_t   ErrorVal = 0x7F;
+
+        auto row  = blockIdx.x * (blockDim.x / WaveSize) + threadIdx.x / WaveSize;
+        auto lane = threadIdx.x % WaveSize;
+        auto col  = (blockIdx.y * blockDim.y + threadIdx.y) * BlockN;
+
+        for(auto i = lane * VecSize; i < BlockN; i += WaveSize * VecSize)
+        {
+            auto offset   = row * ld + col + i;
+            auto unpacked = *reinterpret_cast<VecType const*>(in + offset);
+
+            auto packed = PackUtil::pack(unpacked);
+            auto result = PackUtil::unpack(packed);
+
+            // Element j is the sign-extended nibble j % 8 of packed register j / 8
+#pragma unroll
+            for(uint32_t j = 0; j < VecSize; j++)
+            {
+                auto nibble = __builtin_amdgcn_sbfe(packed.data[j / 8u], 4u * (j % 8u), 4u);
+                if(nibble != static_cast<int32_t>(unpacked.data[j]))
+                {
+                    result.data[j] = ErrorVal;
+                }
+            }
+
+            *reinterpret_cast<VecType*>(out + offset) = result;
+        }
+    }
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_DEVICE_PACK_UTIL_B4_TEST_HPP
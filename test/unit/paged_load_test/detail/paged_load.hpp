@@ -0,0 +1,266 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_DETAIL_PAGED_LOAD_HPP
+#define ROCWMMA_DETAIL_PAGED_LOAD_HPP
+
+#include <type_traits>
+#include <vector>
+
+#include "device/paged_load.hpp"
+#include "helper_macros.hpp"
+#include "unit_kernel_base.hpp"
+
+namespace rocwmma
+{
+
+    // Wrapper into the actual device function
+    template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename Layout, uint32_t PageSize>
+    struct PagedLoadKernel : public UnitKernelBase<BlockM, BlockN, DataT, Layout>
+    {
+    protected:
+        using Base = UnitKernelBase<BlockM, BlockN, DataT, Layout>;
+
+        template <uint32_t WaveSize, uint32_t ArchId>
+        using TestGuard = FragSize_guard<BlockM, BlockN, DataT, Layout, WaveSize, ArchId>;
+
+        // Stores write the logical matrix into the page pool, loads read it back out
+        virtual bool isStore() const
+        {
+            return false;
+        }
+
+    public:
+        PagedLoadKernel()          = default;
+        virtual ~PagedLoadKernel() = default;
+
+        // Page table of each wave in LDS
+        uint32_t ldsUsage() const final
+        {
+            auto waveCount
+                = Base::mTBlockX * Base::mTBlockY / Base::DeviceInfo::instance()->warpSize();
+            return waveCount * pagedTestTableSize<BlockM, BlockN, Layout, PageSize>()
+                   * sizeof(index_t);
+        }
+
+        void setupImpl(typename Base::DataStorage::ProblemSize const& probsize) final
+        {
+            auto& dataInstance = Base::DataStorage::instance();
+
+            // Initialize matrix storage
+            dataInstance->resizeStorage(probsize);
+
+            // Initialize data on device
+            MatrixUtil<Layout>::fillLaunchKernel(
+                dataInstance->deviceIn().get(), Base::mM, Base::mN);
+            // Unallocated pages of a stored pool must stay untouched
+            MatrixUtil<Layout>::fillValLaunchKernel(dataInstance->deviceOut().get(),
+                                                    Base::mM,
+                                                    Base::mN,
+                                                    isStore()
+                                                        ? static_cast<DataT>(0)
+                                                        : std::numeric_limits<DataT>::signaling_NaN());
+        }
+
+        void validateResultsImpl() final
+        {
+            auto& dataInstance = Base::DataStorage::instance();
+
+            const int64_t sizeD = Base::mM * Base::mN;
+
+            // Cache current kernel input and result from device
+            dataInstance->copyData(dataInstance->hostIn(), dataInstance->deviceIn(), sizeD);
+            dataInstance->copyData(dataInstance->hostOut(), dataInstance->deviceOut(), sizeD);
+
+            constexpr bool IsRowMajor = std::is_same<Layout, row_major>::value;
+
+            auto index = [this](int64_t row, int64_t col) {
+                return IsRowMajor ? row * Base::mN + col : col * Base::mM + row;
+            };
+
+            // Major vectors of the logical matrix map to the pool vectors of their pages.
+            // Loads read them into the output, stores write them to the output pool.
+            auto  pages = (IsRowMajor ? Base::mM : Base::mN) / PageSize;
+            auto  ref   = std::vector<DataT>(sizeD, static_cast<DataT>(0));
+            auto* in    = dataInstance->hostIn().get();
+            for(uint32_t row = 0; row < Base::mM; row++)
+            {
+                for(uint32_t col = 0; col < Base::mN; col++)
+                {
+                    auto major = IsRowMajor ? row : col;
+                    auto page  = pagedTestPage(major / PageSize, pages);
+                    if(page < 0)
+                    {
+                        continue;
+                    }
+
+                    auto vector = static_cast<int64_t>(page) * PageSize + major % PageSize;
+                    auto pooled = IsRowMajor ? index(vector, col) : index(row, vector);
+                    if(isStore())
+                    {
+                        ref[pooled] = in[index(row, col)];
+                    }
+                    else
+                    {
+                        ref[index(row, col)] = in[pooled];
+                    }
+                }
+            }
+
+            double errorTolerance = 10.0;
+
+            std::tie(Base::mValidationResult, Base::mMaxRelativeError)
+                = compareEqual<DataT, DataT, Layout, Layout>(
+                    dataInstance->hostOut().get(), ref.data(), Base::mM, Base::mN, errorTolerance);
+        }
+
+        bool checkQuirks() const final
+        {
+            auto waveSize   = Base::DeviceInfo::instance()->warpSize();
+            auto deviceArch = Base::DeviceInfo::instance()->getGcnArch();
+
+            // The test guard for this class requires 2 values at runtime.
+            auto dispatchGuard = [waveSize, deviceArch]() {
+                bool dispatchResult = false;
+
+#define CASE_IMPL_ASSIGN2(WAVE_SIZE, ARCH_ID) \
+    dispatchResult = TestGuard<WAVE_SIZE, ARCH_ID>::enable();
+
+#define SWITCH_BODY_WAVE_SIZE(ARCH_ID) \
+    ROCWMMA_SWITCH_BODY2_ARG2(         \
+        waveSize, CASE_IMPL_ASSIGN2, HipDevice::Wave32, HipDevice::Wave64, ARCH_ID)
+
+#define DISPATCH_GUARD_BODY                           \
+    ROCWMMA_SWITCH_BODY10_ARG1(deviceArch,            \
+                               SWITCH_BODY_WAVE_SIZE, \
+                               HipDevice::GFX908,     \
+                               HipDevice::GFX90A,     \
+                               HipDevice::GFX940,     \
+                               HipDevice::GFX941,     \
+                               HipDevice::GFX942,     \
+                               HipDevice::GFX1100,    \
+                               HipDevice::GFX1101,    \
+                               HipDevice::GFX1102,    \
+                               HipDevice::GFX1200,    \
+                               HipDevice::GFX1201)
+
+                DISPATCH_GUARD_BODY
+
+#undef CASE_IMPL_ASSIGN2
+#undef SWITCH_BODY_WAVE_SIZE
+#undef DISPATCH_GUARD_BODY
+
+                return dispatchResult;
+            };
+
+            return Base::checkQuirks() && dispatchGuard();
+        }
+
+        virtual typename Base::KernelFunc kernelImpl() const = 0;
+    };
+
+    template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename Layout, uint32_t PageSize>
+    struct PagedLoadKernelA final : public PagedLoadKernel<BlockM, BlockN, DataT, Layout, PageSize>
+    {
+    private:
+        using Base = PagedLoadKernel<BlockM, BlockN, DataT, Layout, PageSize>;
+
+    protected:
+        typename Base::KernelFunc kernelImpl() const final
+        {
+            return typename Base::KernelFunc(PagedLoadA<BlockM, BlockN, DataT, Layout, PageSize>);
+        }
+    };
+
+    template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename Layout, uint32_t PageSize>
+    struct PagedLoadKernelB final : public PagedLoadKernel<BlockM, BlockN, DataT, Layout, PageSize>
+    {
+    private:
+        using Base = PagedLoadKernel<BlockM, BlockN, DataT, Layout, PageSize>;
+
+    protected:
+        typename Base::KernelFunc kernelImpl() const final
+        {
+            return typename Base::KernelFunc(PagedLoadB<BlockM, BlockN, DataT, Layout, PageSize>);
+        }
+    };
+
+    template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename Layout, uint32_t PageSize>
+    struct PagedStoreKernelAcc final
+        : public PagedLoadKernel<BlockM, BlockN, DataT, Layout, PageSize>
+    {
+    private:
+        using Base = PagedLoadKernel<BlockM, BlockN, DataT, Layout, PageSize>;
+
+    protected:
+        bool isStore() const final
+        {
+            return true;
+        }
+
+        typename Base::KernelFunc kernelImpl() const final
+        {
+            return typename Base::KernelFunc(
+                PagedStoreAcc<BlockM, BlockN, DataT, Layout, PageSize>);
+        }
+    };
+
+    template <template <uint32_t, uint32_t, typename, typename, uint32_t> class KernelClass>
+    struct PagedLoadGenerator
+    {
+        // Indices to test parameters
+        enum : uint32_t
+        {
+            DataT    = 0,
+            BlockM   = 1,
+            BlockN   = 2,
+            Layout   = 3,
+            PageSize = 4
+        };
+
+        using ResultT = std::shared_ptr<KernelI>;
+
+        template <typename... Ts>
+        static ResultT generate(std::tuple<Ts...> testParams)
+        {
+            // Map GTest params to Kernel params
+            using TestParamsT = std::tuple<Ts...>;
+            using KernelT = KernelClass<std::tuple_element_t<BlockM, TestParamsT>::value, // BlockM
+                                        std::tuple_element_t<BlockN, TestParamsT>::value, // BlockN
+                                        std::tuple_element_t<DataT, TestParamsT>, // DataT
+                                        std::tuple_element_t<Layout, TestParamsT>, // Layout
+                                        std::tuple_element_t<PageSize, TestParamsT>::value>; // PageSize
+
+            return std::make_shared<KernelT>();
+        }
+    };
+
+    using PagedLoadGeneratorA = PagedLoadGenerator<PagedLoadKernelA>;
+    using PagedLoadGeneratorB = PagedLoadGenerator<PagedLoadKernelB>;
+    using PagedStoreGeneratorAcc = PagedLoadGenerator<PagedStoreKernelAcc>;
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_DETAIL_PAGED_LOAD_HPP
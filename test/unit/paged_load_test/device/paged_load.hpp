@@ -0,0 +1,212 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_DEVICE_PAGED_LOAD_HPP
+#define ROCWMMA_DEVICE_PAGED_LOAD_HPP
+
+#include <rocwmma/internal/mapping_util.hpp>
+#include <rocwmma/rocwmma.hpp>
+
+#include "unit_test_traits.hpp"
+
+namespace rocwmma
+{
+
+    // Page of the pool holding logical page p of a matrix of the given number of pages.
+    // Pages are stored in reverse order, with every 5th page not allocated (-1).
+    ROCWMMA_HOST_DEVICE constexpr inline index_t pagedTestPage(uint32_t page, uint32_t pages)
+    {
+        return (page % 5u == 2u) ? -1 : static_cast<index_t>(pages - 1u - page);
+    }
+
+    // Page table entries of each wave, covering the major extent of its block
+    template <uint32_t BlockM, uint32_t BlockN, typename DataLayout, uint32_t PageSize>
+    constexpr uint32_t pagedTestTableSize()
+    {
+        return (is_same<DataLayout, row_major>::value ? BlockM : BlockN) / PageSize + 1u;
+    }
+
+    // Each wave builds the page table of its block in LDS, starting at the page of
+    // the block origin, such that the table read by the load lives in local memory.
+    template <uint32_t TableSize, typename Mapping>
+    ROCWMMA_DEVICE inline index_t const* pagedTestTable(uint32_t firstPage, uint32_t pages)
+    {
+        HIP_DYNAMIC_SHARED(void*, localMemPtr);
+
+        auto workgroupDim = Mapping::workgroupDim();
+        auto waveCoord    = Mapping::waveCoord();
+        auto waveIndex    = get<0>(waveCoord) * get<1>(workgroupDim) + get<1>(waveCoord);
+
+        auto* table = reinterpret_cast<index_t*>(localMemPtr) + waveIndex * TableSize;
+        for(auto i = Mapping::laneId(); i < TableSize; i += Constants::AMDGCN_WAVE_SIZE)
+        {
+            table[i] = (firstPage + i < pages) ? pagedTestPage(firstPage + i, pages) : -1;
+        }
+
+        __syncthreads();
+        return table;
+    }
+
+    // The input is a page pool of pages of PageSize rows (row_major) or columns (col_major).
+    // out = the logical matrix of the page table, with zeros in unallocated pages.
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              typename DataLayout,
+              uint32_t PageSize,
+              typename FragT,
+              typename DataT>
+    ROCWMMA_DEVICE inline void pagedTestLoad(
+        FragT& frag, uint32_t m, uint32_t n, DataT const* in, DataT* out, uint32_t ld)
+    {
+        using Mapping = MappingUtil<BlockM, BlockN, DataT, DataLayout>;
+
+        constexpr bool     IsRowMajor = is_same<DataLayout, row_major>::value;
+        constexpr uint32_t TableSize  = pagedTestTableSize<BlockM, BlockN, DataLayout, PageSize>();
+
+        auto coord = Mapping::matrixCoord();
+        auto major = get<IsRowMajor ? 0 : 1>(coord);
+        auto pages = (IsRowMajor ? m : n) / PageSize;
+        auto table = pagedTestTable<TableSize, Mapping>(major / PageSize, pages);
+
+        // Load from the block origin relative to the first page of the table, then store in place.
+        // The block is prefetched first, which must not fetch unallocated pages.
+        auto row = IsRowMajor ? major % PageSize : get<0>(coord);
+        auto col = IsRowMajor ? get<1>(coord) : major % PageSize;
+        prefetch_matrix_paged_sync(frag, in, table, PageSize, ld, row, col);
+        load_matrix_paged_sync(frag, in, table, PageSize, ld, row, col);
+        store_matrix_sync(Mapping::dataCoord(out, ld), frag, ld);
+    }
+
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              typename DataT,
+              typename DataLayout,
+              uint32_t PageSize>
+    __global__ void PagedLoadA(uint32_t     m,
+                               uint32_t     n,
+                               DataT const* in,
+                               DataT*       out,
+                               uint32_t     ld,
+                               DataT        param1,
+                               DataT        param2)
+    {
+        if constexpr(FragSize_guard<BlockM,
+                                    BlockN,
+                                    DataT,
+                                    DataLayout,
+                                    Constants::AMDGCN_WAVE_SIZE,
+                                    Constants::AMDGCN_CURRENT_ARCH_ID>::enable())
+        {
+            // Mapping:
+            // Incoming -> Matrix A (ColNT)
+            // BlockM -> BlockM
+            // <Dummy> -> BlockN
+            // BlockN -> BlockK
+            auto frag = fragment<matrix_a, BlockM, 1, BlockN, DataT, DataLayout>();
+            pagedTestLoad<BlockM, BlockN, DataLayout, PageSize>(frag, m, n, in, out, ld);
+        }
+    }
+
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              typename DataT,
+              typename DataLayout,
+              uint32_t PageSize>
+    __global__ void PagedLoadB(uint32_t     m,
+                               uint32_t     n,
+                               DataT const* in,
+                               DataT*       out,
+                               uint32_t     ld,
+                               DataT        param1,
+                               DataT        param2)
+    {
+        if constexpr(FragSize_guard<BlockM,
+                                    BlockN,
+                                    DataT,
+                                    DataLayout,
+                                    Constants::AMDGCN_WAVE_SIZE,
+                                    Constants::AMDGCN_CURRENT_ARCH_ID>::enable())
+        {
+            // Mapping:
+            // Incoming -> Matrix B (RowNT)
+            // <Dummy> -> BlockM
+            // BlockN -> BlockN
+            // BlockM -> BlockK
+            auto frag = fragment<matrix_b, 1, BlockN, BlockM, DataT, DataLayout>();
+            pagedTestLoad<BlockM, BlockN, DataLayout, PageSize>(frag, m, n, in, out, ld);
+        }
+    }
+
+    // The output is a page pool of pages of PageSize rows (row_major) or columns (col_major).
+    // out = the page pool of the logical input matrix, untouched in unallocated pages.
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              typename DataT,
+              typename DataLayout,
+              uint32_t PageSize>
+    __global__ void PagedStoreAcc(uint32_t     m,
+                                  uint32_t     n,
+                                  DataT const* in,
+                                  DataT*       out,
+                                  uint32_t     ld,
+                                  DataT        param1,
+                                  DataT        param2)
+    {
+        if constexpr(FragSize_guard<BlockM,
+                                    BlockN,
+                                    DataT,
+                                    DataLayout,
+                                    Constants::AMDGCN_WAVE_SIZE,
+                                    Constants::AMDGCN_CURRENT_ARCH_ID>::enable())
+        {
+            using Mapping = MappingUtil<BlockM, BlockN, DataT, DataLayout>;
+
+            constexpr bool     IsRowMajor = is_same<DataLayout, row_major>::value;
+            constexpr uint32_t TableSize
+                = pagedTestTableSize<BlockM, BlockN, DataLayout, PageSize>();
+
+            // Mapping:
+            // Incoming -> Matrix C (RowNT)
+            // BlockM -> BlockM
+            // BlockN -> BlockN
+            // <Dummy> -> BlockK
+            auto frag = fragment<accumulator, BlockM, BlockN, 1, DataT, DataLayout>();
+
+            auto coord = Mapping::matrixCoord();
+            auto major = get<IsRowMajor ? 0 : 1>(coord);
+            auto pages = (IsRowMajor ? m : n) / PageSize;
+            auto table = pagedTestTable<TableSize, Mapping>(major / PageSize, pages);
+
+            // Load in place, then store to the block origin relative to the first page of the table
+            auto row = IsRowMajor ? major % PageSize : get<0>(coord);
+            auto col = IsRowMajor ? get<1>(coord) : major % PageSize;
+            load_matrix_sync(frag, Mapping::dataCoord(in, ld), ld);
+            store_matrix_paged_sync(out, frag, table, PageSize, ld, row, col);
+        }
+    }
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_DEVICE_PAGED_LOAD_HPP
@@ -0,0 +1,115 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef ROCWMMA_DEVICE_PREFETCH_HPP
+#define ROCWMMA_DEVICE_PREFETCH_HPP
+
+#include <rocwmma/internal/mapping_util.hpp>
+#include <rocwmma/rocwmma.hpp>
+
+#include "unit_test_traits.hpp"
+
+namespace rocwmma
+{
+
+    // Prefetches the block of the wave and the next block along the columns, as a
+    // pipeline would prefetch its next K step, then loads and stores the block in place.
+    // Prefetching must leave both the fragment and the loaded data unchanged.
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              typename DataLayout,
+              typename FragT,
+              typename DataT>
+    ROCWMMA_DEVICE inline void
+        prefetchTestLoad(FragT& frag, uint32_t n, DataT const* in, DataT* out, uint32_t ld)
+    {
+        using Mapping = MappingUtil<BlockM, BlockN, DataT, DataLayout>;
+
+        auto coord = Mapping::matrixCoord();
+        auto next  = make_coord2d(get<0>(coord), (get<1>(coord) + BlockN) % n);
+
+        prefetch_matrix_sync(frag, Mapping::dataCoord(in, ld), ld);
+        prefetch_matrix_sync(frag, Mapping::dataCoord(in, next, ld), ld);
+
+        load_matrix_sync(frag, Mapping::dataCoord(in, ld), ld);
+        store_matrix_sync(Mapping::dataCoord(out, ld), frag, ld);
+    }
+
+    template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename DataLayout>
+    __global__ void PrefetchA(uint32_t     m,
+                              uint32_t     n,
+                              DataT const* in,
+                              DataT*       out,
+                              uint32_t     ld,
+                              DataT        param1,
+                              DataT        param2)
+    {
+        if constexpr(FragSize_guard<BlockM,
+                                    BlockN,
+                                    DataT,
+                                    DataLayout,
+                                    Constants::AMDGCN_WAVE_SIZE,
+                                    Constants::AMDGCN_CURRENT_ARCH_ID>::enable())
+        {
+            // Mapping:
+            // Incoming -> Matrix A (ColNT)
+            // BlockM -> BlockM
+            // <Dummy> -> BlockN
+            // BlockN -> BlockK
+            auto frag = fragment<matrix_a, BlockM, 1, BlockN, DataT, DataLayout>();
+            prefetchTestLoad<BlockM, BlockN, DataLayout>(frag, n, in, out, ld);
+        }
+    }
+
+    template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename DataLayout>
+    __global__ void PrefetchB(uint32_t     m,
+                              uint32_t     n,
+                              DataT const* in,
+                              DataT*       out,
+                              uint32_t     ld,
+                              DataT        param1,
+                              DataT        param2)
+    {
+        if constexpr(FragSize_guard<BlockM,
+                                    BlockN,
+                                    DataT,
+                                    DataLayout,
+                                    Constants::AMDGCN_WAVE_SIZE,
+                                    Constants::AMDGCN_CURRENT_ARCH_ID>::enable())
+        {
+            // Mapping:
+            // Incoming -> Matrix B (RowNT)
+            // <Dummy> -> BlockM
+            // BlockN -> BlockN
+            // BlockM -> BlockK
+            auto frag = fragment<matrix_b, 1, BlockN, BlockM, DataT, DataLayout>();
+            prefetchTestLoad<BlockM, BlockN, DataLayout>(frag, n, in, out, ld);
+        }
+    }
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_DEVICE_PREFETCH_HPP
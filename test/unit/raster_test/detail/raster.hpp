@@ -0,0 +1,186 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef ROCWMMA_DETAIL_RASTER_TEST_HPP
+#define ROCWMMA_DETAIL_RASTER_TEST_HPP
+
+#include <limits>
+#include <sstream>
+
+#include "device/raster.hpp"
+#include "unit_kernel_base.hpp"
+
+namespace rocwmma
+{
+
+    template <typename RasterPolicy>
+    struct RasterName;
+
+    template <>
+    struct RasterName<raster::linear>
+    {
+        static std::string name()
+        {
+            return "Linear";
+        }
+    };
+
+    template <uint32_t GroupX>
+    struct RasterName<raster::grouped<GroupX>>
+    {
+        static std::string name()
+        {
+            return "Grouped" + std::to_string(GroupX);
+        }
+    };
+
+    template <uint32_t Order>
+    struct RasterName<raster::morton<Order>>
+    {
+        static std::string name()
+        {
+            return "Morton" + std::to_string(Order);
+        }
+    };
+
+    template <uint32_t Order>
+    struct RasterName<raster::hilbert<Order>>
+    {
+        static std::string name()
+        {
+            return "Hilbert" + std::to_string(Order);
+        }
+    };
+
+    template <uint32_t XcdCount, typename Inner>
+    struct RasterName<raster::xcd<XcdCount, Inner>>
+    {
+        static std::string name()
+        {
+            return "Xcd" + std::to_string(XcdCount) + "_" + RasterName<Inner>::name();
+        }
+    };
+
+    // Wrapper into the actual device function
+    template <uint32_t BlockN, typename RasterPolicy>
+    struct RasterKernel final : public UnitKernelBase<1, BlockN, float32_t, row_major>
+    {
+    private:
+        using Base = UnitKernelBase<1, BlockN, float32_t, row_major>;
+
+    public:
+        RasterKernel()        = default;
+        ~RasterKernel() final = default;
+
+        void setupImpl(typename Base::DataStorage::ProblemSize const& probsize) final
+        {
+            auto& dataInstance = Base::DataStorage::instance();
+
+            // Initialize matrix storage
+            const int64_t sizeD = Base::mM * Base::mN;
+            dataInstance->resizeStorage(probsize);
+
+            // Expected result: the linear index of each tile, rasterized on host
+            auto* in = dataInstance->hostIn().get();
+            for(int64_t i = 0; i < sizeD; i++)
+            {
+                auto tileCoord = RasterPolicy::tile_coord(
+                    static_cast<uint32_t>(i), Base::mM, Base::mN);
+                in[get<0>(tileCoord) * Base::mN + get<1>(tileCoord)] = static_cast<float32_t>(i);
+            }
+
+            // Tiles not written by the kernel remain NaN
+            MatrixUtil<row_major>::fillValLaunchKernel(
+                dataInstance->deviceOut().get(),
+                Base::mM,
+                Base::mN,
+                std::numeric_limits<float32_t>::signaling_NaN());
+        }
+
+        void validateResultsImpl() final
+        {
+            auto& dataInstance = Base::DataStorage::instance();
+
+            const int64_t sizeD = Base::mM * Base::mN;
+
+            // Cache current kernel result from device
+            dataInstance->copyData(dataInstance->hostOut(), dataInstance->deviceOut(), sizeD);
+
+            // Tile indices must match exactly. Any tile visited twice leaves
+            // another tile unwritten.
+            auto const* in  = dataInstance->hostIn().get();
+            auto const* out = dataInstance->hostOut().get();
+
+            Base::mValidationResult = true;
+            for(int64_t i = 0; i < sizeD; i++)
+            {
+                Base::mValidationResult &= (out[i] == in[i]);
+            }
+            Base::mMaxRelativeError = Base::mValidationResult ? 0.0 : 1.0;
+        }
+
+        std::string kernelConfig() const final
+        {
+            std::stringstream config;
+            config << RasterName<RasterPolicy>::name();
+            return config.str();
+        }
+
+        typename Base::KernelFunc kernelImpl() const final
+        {
+            return typename Base::KernelFunc(rasterTest<BlockN, RasterPolicy>);
+        }
+    };
+
+    // This is the GeneratorImpl class
+    struct RasterGenerator
+    {
+        // Indices to test parameters
+        enum : uint32_t
+        {
+            BlockN       = 0,
+            RasterPolicy = 1
+        };
+
+        using ResultT = std::shared_ptr<KernelI>;
+
+        template <typename... Ts>
+        static ResultT generate(std::tuple<Ts...> testParams)
+        {
+            // Map GTest params to Kernel params
+            using TestParamsT = std::tuple<Ts...>;
+            using KernelT
+                = RasterKernel<std::tuple_element_t<BlockN, TestParamsT>::value, // BlockN
+                               std::tuple_element_t<RasterPolicy, TestParamsT> // RasterPolicy
+                               >;
+
+            return std::make_shared<KernelT>();
+        }
+    };
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_DETAIL_RASTER_TEST_HPP
@@ -0,0 +1,64 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef ROCWMMA_DEVICE_RASTER_TEST_HPP
+#define ROCWMMA_DEVICE_RASTER_TEST_HPP
+
+#include <rocwmma/rocwmma.hpp>
+#include <rocwmma/rocwmma_tile.hpp>
+
+namespace rocwmma
+{
+
+    // Treats the m x n output as a grid of single element tiles. Each wave rasterizes
+    // BlockN linear tile indices of one row, and writes each index to its tile coordinate.
+    template <uint32_t BlockN, typename RasterPolicy>
+    __global__ void rasterTest(uint32_t         m,
+                               uint32_t         n,
+                               float32_t const* in,
+                               float32_t*       out,
+                               uint32_t         ld,
+                               float32_t        param1,
+                               float32_t        param2)
+    {
+        constexpr uint32_t WaveSize = Constants::AMDGCN_WAVE_SIZE;
+
+        auto row  = blockIdx.x * (blockDim.x / WaveSize) + threadIdx.x / WaveSize;
+        auto lane = threadIdx.x % WaveSize;
+        auto col  = (blockIdx.y * blockDim.y + threadIdx.y) * BlockN;
+
+        for(auto i = lane; i < BlockN; i += WaveSize)
+        {
+            auto tileIndex = row * n + col + i;
+            auto tileCoord = RasterPolicy::tile_coord(tileIndex, m, n);
+
+            out[get<0>(tileCoord) * ld + get<1>(tileCoord)] = static_cast<float32_t>(tileIndex);
+        }
+    }
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_DEVICE_RASTER_TEST_HPP
@@ -0,0 +1,226 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef ROCWMMA_DETAIL_REDUCE_HPP
+#define ROCWMMA_DETAIL_REDUCE_HPP
+
+#include <type_traits>
+#include <vector>
+
+#include "device/reduce.hpp"
+#include "helper_macros.hpp"
+#include "unit_kernel_base.hpp"
+
+namespace rocwmma
+{
+
+    // Wrapper into the actual device function
+    template <uint32_t BlockM,
+              uint32_t BlockN,
+              typename DataT,
+              typename Layout,
+              typename ReduceOpT,
+              bool ReduceRowsT>
+    struct ReduceKernel : public UnitKernelBase<BlockM, BlockN, DataT, Layout>
+    {
+    private:
+        using Base = UnitKernelBase<BlockM, BlockN, DataT, Layout>;
+
+        template <uint32_t WaveSize, uint32_t ArchId>
+        using TestGuard = FragSize_guard<BlockM, BlockN, DataT, Layout, WaveSize, ArchId>;
+
+        // Reference reduction type matches the device
+        using ReduceT = std::conditional_t<(sizeof(DataT) < sizeof(uint32_t)), float32_t, DataT>;
+
+    public:
+        ReduceKernel()          = default;
+        virtual ~ReduceKernel() = default;
+
+        void setupImpl(typename Base::DataStorage::ProblemSize const& probsize) final
+        {
+            auto& dataInstance = Base::DataStorage::instance();
+
+            // Initialize matrix storage
+            dataInstance->resizeStorage(probsize);
+
+            // Initialize data on device
+            MatrixUtil<Layout>::fillLaunchKernel(
+                dataInstance->deviceIn().get(), Base::mM, Base::mN);
+            MatrixUtil<Layout>::fillValLaunchKernel(dataInstance->deviceOut().get(),
+                                                    Base::mM,
+                                                    Base::mN,
+                                                    std::numeric_limits<DataT>::signaling_NaN());
+        }
+
+        void validateResultsImpl() final
+        {
+            auto& dataInstance = Base::DataStorage::instance();
+
+            const int64_t sizeD = Base::mM * Base::mN;
+
+            // Cache current kernel input and result from device
+            dataInstance->copyData(dataInstance->hostIn(), dataInstance->deviceIn(), sizeD);
+            dataInstance->copyData(dataInstance->hostOut(), dataInstance->deviceOut(), sizeD);
+
+            auto const* in  = dataInstance->hostIn().get();
+            auto        ref = std::vector<DataT>(sizeD);
+
+            auto index = [ld = std::is_same<Layout, row_major>::value ? Base::mN : Base::mM](
+                             uint32_t row, uint32_t col) {
+                return std::is_same<Layout, row_major>::value ? row * ld + col : col * ld + row;
+            };
+
+            // Reduce each BlockM x BlockN block, then broadcast the result
+            // over the reduced dimension.
+            for(uint32_t blockRow = 0; blockRow < Base::mM; blockRow += BlockM)
+            {
+                for(uint32_t blockCol = 0; blockCol < Base::mN; blockCol += BlockN)
+                {
+                    auto outer = ReduceRowsT ? BlockM : BlockN;
+                    auto inner = ReduceRowsT ? BlockN : BlockM;
+
+                    for(uint32_t i = 0; i < outer; i++)
+                    {
+                        auto coord = [&](uint32_t j) {
+                            return ReduceRowsT ? index(blockRow + i, blockCol + j)
+                                               : index(blockRow + j, blockCol + i);
+                        };
+
+                        auto result = static_cast<ReduceT>(in[coord(0)]);
+                        for(uint32_t j = 1; j < inner; j++)
+                        {
+                            result = ReduceOpT::exec(result, static_cast<ReduceT>(in[coord(j)]));
+                        }
+
+                        for(uint32_t j = 0; j < inner; j++)
+                        {
+                            ref[coord(j)] = static_cast<DataT>(result);
+                        }
+                    }
+                }
+            }
+
+            double errorTolerance = 10.0;
+
+            std::tie(Base::mValidationResult, Base::mMaxRelativeError)
+                = compareEqual<DataT, DataT, Layout, Layout>(
+                    dataInstance->hostOut().get(), ref.data(), Base::mM, Base::mN, errorTolerance);
+        }
+
+        bool checkQuirks() const final
+        {
+            auto waveSize   = Base::DeviceInfo::instance()->warpSize();
+            auto deviceArch = Base::DeviceInfo::instance()->getGcnArch();
+
+            // The test guard for this class requires 2 values at runtime.
+            auto dispatchGuard = [waveSize, deviceArch]() {
+                bool dispatchResult = false;
+
+#define CASE_IMPL_ASSIGN2(WAVE_SIZE, ARCH_ID) \
+    dispatchResult = TestGuard<WAVE_SIZE, ARCH_ID>::enable();
+
+#define SWITCH_BODY_WAVE_SIZE(ARCH_ID) \
+    ROCWMMA_SWITCH_BODY2_ARG2(         \
+        waveSize, CASE_IMPL_ASSIGN2, HipDevice::Wave32, HipDevice::Wave64, ARCH_ID)
+
+#define DISPATCH_GUARD_BODY                           \
+    ROCWMMA_SWITCH_BODY10_ARG1(deviceArch,            \
+                               SWITCH_BODY_WAVE_SIZE, \
+                               HipDevice::GFX908,     \
+                               HipDevice::GFX90A,     \
+                               HipDevice::GFX940,     \
+                               HipDevice::GFX941,     \
+                               HipDevice::GFX942,     \
+                               HipDevice::GFX1100,    \
+                               HipDevice::GFX1101,    \
+                               HipDevice::GFX1102,    \
+                               HipDevice::GFX1200,    \
+                               HipDevice::GFX1201)
+
+                DISPATCH_GUARD_BODY
+
+#undef CASE_IMPL_ASSIGN2
+#undef SWITCH_BODY_WAVE_SIZE
+#undef DISPATCH_GUARD_BODY
+
+                return dispatchResult;
+            };
+
+            return Base::checkQuirks() && dispatchGuard();
+        }
+
+        typename Base::KernelFunc kernelImpl() const final
+        {
+            if constexpr(ReduceRowsT)
+            {
+                return typename Base::KernelFunc(
+                    ReduceRows<BlockM, BlockN, DataT, Layout, ReduceOpT>);
+            }
+            else
+            {
+                return typename Base::KernelFunc(
+                    ReduceCols<BlockM, BlockN, DataT, Layout, ReduceOpT>);
+            }
+        }
+    };
+
+    template <bool ReduceRowsT>
+    struct ReduceGenerator
+    {
+        // Indices to test parameters
+        enum : uint32_t
+        {
+            DataT    = 0,
+            BlockM   = 1,
+            BlockN   = 2,
+            Layout   = 3,
+            ReduceOp = 4
+        };
+
+        using ResultT = std::shared_ptr<KernelI>;
+
+        template <typename... Ts>
+        static ResultT generate(std::tuple<Ts...> testParams)
+        {
+            // Map GTest params to Kernel params
+            using TestParamsT = std::tuple<Ts...>;
+            using KernelT = ReduceKernel<std::tuple_element_t<BlockM, TestParamsT>::value, // BlockM
+                                         std::tuple_element_t<BlockN, TestParamsT>::value, // BlockN
+                                         std::tuple_element_t<DataT, TestParamsT>, // DataT
+                                         std::tuple_element_t<Layout, TestParamsT>, // Layout
+                                         std::tuple_element_t<ReduceOp, TestParamsT>, // ReduceOp
+                                         ReduceRowsT>;
+
+            return std::make_shared<KernelT>();
+        }
+    };
+
+    using ReduceRowsGenerator = ReduceGenerator<true>;
+    using ReduceColsGenerator = ReduceGenerator<false>;
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_DETAIL_REDUCE_HPP
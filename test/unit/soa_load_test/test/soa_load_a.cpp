@@ -0,0 +1,109 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <type_traits>
+
+#include "detail/soa_load.hpp"
+#include "kernel_generator.hpp"
+#include "unit_test.hpp"
+
+namespace rocwmma
+{
+
+    // Pin the SoaLoadSelector decisions at the boundaries. Both wave sizes agree.
+    // Packed 16-bit and 8-bit data take the AosToSoa path at BlockDim 16.
+    static_assert(detail::SoaLoadSelector<16, 64, float16_t, 2>::Result, "");
+    static_assert(detail::SoaLoadSelector<16, 64, float16_t, 16>::Result, "");
+    static_assert(detail::SoaLoadSelector<16, 64, int8_t, 16>::Result, "");
+
+    // float32_t costs the same both ways at VW 2, and more through AosToSoa at VW 16
+    static_assert(!detail::SoaLoadSelector<16, 64, float32_t, 2>::Result, "");
+    static_assert(!detail::SoaLoadSelector<16, 64, float32_t, 16>::Result, "");
+
+    // BlockDim 256 always loads directly
+    static_assert(!detail::SoaLoadSelector<256, 16, float16_t, 2>::Result, "");
+    static_assert(!detail::SoaLoadSelector<256, 16, float16_t, 16>::Result, "");
+    static_assert(!detail::SoaLoadSelector<256, 16, int8_t, 16>::Result, "");
+
+    // Unpackable data, or no vectors to transform
+    static_assert(!detail::SoaLoadSelector<16, 64, float64_t, 2>::Result, "");
+    static_assert(!detail::SoaLoadSelector<16, 64, float16_t, 1>::Result, "");
+
+    // Vectors of row_major matrix_a and col_major matrix_b already run along BlockK
+    static_assert(!IOLayout<matrix_a, 16, 64, float16_t, row_major, 1>::SoaLoad, "");
+    static_assert(!IOLayout<matrix_b, 16, 64, float16_t, col_major, 1>::SoaLoad, "");
+
+    struct TestParams : public UnitTestParams
+    {
+        using Base = UnitTestParams;
+
+        // Types: float16_t, float32_t
+        // Block Sizes: 16 x 64 and 256 x 16, BlockDim 16 and 256
+        // Layouts: col_major, where the vectors of matrix_a run along BlockDim
+        // Vector Widths: 2, 16
+        using Types        = std::tuple<float16_t, float32_t>;
+        using BlockSizes   = std::tuple<std::tuple<I<16>, I<64>>, std::tuple<I<256>, I<16>>>;
+        using Layouts      = std::tuple<col_major>;
+        using Matrices     = std::tuple<matrix_a>;
+        using VectorWidths = std::tuple<I<2>, I<16>>;
+        using KernelParams =
+            typename CombineLists<Types, BlockSizes, Layouts, Matrices, VectorWidths>::Result;
+
+        // Assemble the kernel generator
+        // Kernel: SoaLoadPaths
+        using GeneratorImpl   = SoaLoadGenerator;
+        using KernelGenerator = KernelGenerator<KernelParams, GeneratorImpl>;
+
+        // Sanity check for kernel generator
+        static_assert(std::is_same<typename GeneratorImpl::ResultT, typename Base::KernelT>::value,
+                      "Kernels from this generator do not match testing interface");
+
+        static inline typename KernelGenerator::ResultT kernels()
+        {
+            return KernelGenerator::generate();
+        }
+    };
+
+} // namespace rocwmma
+
+// Test suite for unique parameterization
+class SoaLoadTestA : public rocwmma::UnitTest
+{
+};
+
+TEST_P(SoaLoadTestA, RunKernel)
+{
+    this->RunKernel();
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    KernelTests,
+    SoaLoadTestA,
+    ::testing::Combine(::testing::ValuesIn(rocwmma::TestParams::kernels()),
+                       ::testing::ValuesIn(rocwmma::TestParams::threadBlocks()),
+                       ::testing::ValuesIn(rocwmma::TestParams::problemSizes()),
+                       ::testing::ValuesIn(rocwmma::TestParams::param1s()),
+                       ::testing::ValuesIn(rocwmma::TestParams::param2s())));
@@ -0,0 +1,399 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_DETAIL_SOFTMAX_TOPK_HPP
+#define ROCWMMA_DETAIL_SOFTMAX_TOPK_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+#include "device/softmax_topk.hpp"
+#include "helper_macros.hpp"
+#include "unit_kernel_base.hpp"
+
+namespace rocwmma
+{
+
+    // Wrapper into the actual device function
+    template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename Layout>
+    struct SoftmaxTopkKernel : public UnitKernelBase<BlockM, BlockN, DataT, Layout>
+    {
+    protected:
+        using Base = UnitKernelBase<BlockM, BlockN, DataT, Layout>;
+
+        template <uint32_t WaveSize, uint32_t ArchId>
+        using TestGuard = FragSize_guard<BlockM, BlockN, DataT, Layout, WaveSize, ArchId>;
+
+        // Index of (row, col) in the input
+        int64_t index(uint32_t row, uint32_t col) const
+        {
+            return std::is_same<Layout, row_major>::value ? int64_t(row) * Base::mN + col
+                                                           : int64_t(col) * Base::mM + row;
+        }
+
+    public:
+        SoftmaxTopkKernel()          = default;
+        virtual ~SoftmaxTopkKernel() = default;
+
+        void setupImpl(typename Base::DataStorage::ProblemSize const& probsize) final
+        {
+            auto& dataInstance = Base::DataStorage::instance();
+
+            // Initialize matrix storage
+            const int64_t sizeD = Base::mM * Base::mN;
+            dataInstance->resizeStorage(probsize);
+
+            // Initialize data on host
+            auto* in = dataInstance->hostIn().get();
+            for(uint32_t row = 0; row < Base::mM; row++)
+            {
+                for(uint32_t col = 0; col < Base::mN; col++)
+                {
+                    in[index(row, col)] = static_cast<DataT>(softmaxTopkTestValue(row, col));
+                }
+            }
+
+            dataInstance->copyData(dataInstance->deviceIn(), dataInstance->hostIn(), sizeD);
+
+            MatrixUtil<Layout>::fillValLaunchKernel(
+                dataInstance->deviceOut().get(), Base::mM, Base::mN, static_cast<DataT>(0));
+        }
+
+        bool checkQuirks() const final
+        {
+            auto waveSize   = Base::DeviceInfo::instance()->warpSize();
+            auto deviceArch = Base::DeviceInfo::instance()->getGcnArch();
+
+            // The test guard for this class requires 2 values at runtime.
+            auto dispatchGuard = [waveSize, deviceArch]() {
+                bool dispatchResult = false;
+
+#define CASE_IMPL_ASSIGN2(WAVE_SIZE, ARCH_ID) \
+    dispatchResult = TestGuard<WAVE_SIZE, ARCH_ID>::enable();
+
+#define SWITCH_BODY_WAVE_SIZE(ARCH_ID) \
+    ROCWMMA_SWITCH_BODY2_ARG2(         \
+        waveSize, CASE_IMPL_ASSIGN2, HipDevice::Wave32, HipDevice::Wave64, ARCH_ID)
+
+#define DISPATCH_GUARD_BODY                           \
+    ROCWMMA_SWITCH_BODY10_ARG1(deviceArch,            \
+                               SWITCH_BODY_WAVE_SIZE, \
+                               HipDevice::GFX908,     \
+                               HipDevice::GFX90A,     \
+                               HipDevice::GFX940,     \
+                               HipDevice::GFX941,     \
+                               HipDevice::GFX942,     \
+                               HipDevice::GFX1100,    \
+                               HipDevice::GFX1101,    \
+                               HipDevice::GFX1102,    \
+                               HipDevice::GFX1200,    \
+                               HipDevice::GFX1201)
+
+                DISPATCH_GUARD_BODY
+
+#undef CASE_IMPL_ASSIGN2
+#undef SWITCH_BODY_WAVE_SIZE
+#undef DISPATCH_GUARD_BODY
+
+                return dispatchResult;
+            };
+
+            return Base::checkQuirks() && dispatchGuard();
+        }
+    };
+
+    template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename Layout>
+    struct OnlineSoftmaxRowsKernel final : public SoftmaxTopkKernel<BlockM, BlockN, DataT, Layout>
+    {
+    private:
+        using Base = SoftmaxTopkKernel<BlockM, BlockN, DataT, Layout>;
+
+    public:
+        void validateResultsImpl() final
+        {
+            auto& dataInstance = Base::DataStorage::instance();
+
+            const int64_t sizeD = Base::mM * Base::mN;
+
+            // Cache current kernel result from device
+            dataInstance->copyData(dataInstance->hostOut(), dataInstance->deviceOut(), sizeD);
+
+            auto const* in  = dataInstance->hostIn().get();
+            auto        ref = std::vector<DataT>(sizeD);
+
+            // Softmax over the columns of each block and its right neighbour
+            auto blocksN = Base::mN / BlockN;
+            for(uint32_t row = 0; row < Base::mM; row++)
+            {
+                for(uint32_t blockCol = 0; blockCol < blocksN; blockCol++)
+                {
+                    auto x = [&](uint32_t j) {
+                        auto col = (blockCol + j / BlockN) % blocksN * BlockN + j % BlockN;
+                        return softmaxTestScale * static_cast<double>(in[this->index(row, col)]);
+                    };
+
+                    auto max = x(0);
+                    for(uint32_t j = 1; j < 2u * BlockN; j++)
+                    {
+                        max = std::max(max, x(j));
+                    }
+
+                    auto sum = 0.0;
+                    for(uint32_t j = 0; j < 2u * BlockN; j++)
+                    {
+                        sum += std::exp(x(j) - max);
+                    }
+
+                    for(uint32_t j = 0; j < BlockN; j++)
+                    {
+                        ref[this->index(row, blockCol * BlockN + j)]
+                            = static_cast<DataT>(std::exp(x(j) - max) / sum);
+                    }
+                }
+            }
+
+            double errorTolerance = 10.0;
+
+            std::tie(Base::mValidationResult, Base::mMaxRelativeError)
+                = compareEqual<DataT, DataT, Layout, Layout>(
+                    dataInstance->hostOut().get(), ref.data(), Base::mM, Base::mN, errorTolerance);
+        }
+
+        typename Base::KernelFunc kernelImpl() const final
+        {
+            return typename Base::KernelFunc(OnlineSoftmaxRows<BlockM, BlockN, DataT, Layout>);
+        }
+    };
+
+    template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename Layout, uint32_t K>
+    struct TopkRowsKernel final : public SoftmaxTopkKernel<BlockM, BlockN, DataT, Layout>
+    {
+    private:
+        using Base = SoftmaxTopkKernel<BlockM, BlockN, DataT, Layout>;
+
+    public:
+        void validateResultsImpl() final
+        {
+            auto& dataInstance = Base::DataStorage::instance();
+
+            const int64_t sizeD = Base::mM * Base::mN;
+
+            // Cache current kernel result from device
+            dataInstance->copyData(dataInstance->hostOut(), dataInstance->deviceOut(), sizeD);
+
+            auto const* in  = dataInstance->hostIn().get();
+            auto        ref = std::vector<DataT>(sizeD, static_cast<DataT>(0));
+
+            // Columns of each block row, sorted by descending value then ascending column.
+            // Candidates are stored col_major.
+            auto cols = std::vector<uint32_t>(BlockN);
+            for(uint32_t row = 0; row < Base::mM; row++)
+            {
+                for(uint32_t blockCol = 0; blockCol < Base::mN; blockCol += BlockN)
+                {
+                    auto value = [&](uint32_t j) {
+                        return static_cast<double>(in[this->index(row, blockCol + j)]);
+                    };
+
+                    std::iota(cols.begin(), cols.end(), 0u);
+                    std::stable_sort(cols.begin(), cols.end(), [&](uint32_t a, uint32_t b) {
+                        return value(a) > value(b);
+                    });
+
+                    auto colOffset = topkTestColOffset(blockCol / BlockN, BlockN);
+                    for(uint32_t j = 0; j < K; j++)
+                    {
+                        ref[int64_t(blockCol + j) * Base::mM + row]
+                            = in[this->index(row, blockCol + cols[j])];
+                        ref[int64_t(blockCol + K + j) * Base::mM + row]
+                            = static_cast<DataT>(colOffset + cols[j]);
+                    }
+                }
+            }
+
+            double errorTolerance = 10.0;
+
+            std::tie(Base::mValidationResult, Base::mMaxRelativeError)
+                = compareEqual<DataT, DataT, col_major, col_major>(
+                    dataInstance->hostOut().get(), ref.data(), Base::mM, Base::mN, errorTolerance);
+        }
+
+        typename Base::KernelFunc kernelImpl() const final
+        {
+            return typename Base::KernelFunc(TopkRows<BlockM, BlockN, DataT, Layout, K>);
+        }
+    };
+
+    template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename Layout>
+    struct ArgmaxRowsKernel final : public SoftmaxTopkKernel<BlockM, BlockN, DataT, Layout>
+    {
+    private:
+        using Base = SoftmaxTopkKernel<BlockM, BlockN, DataT, Layout>;
+
+    public:
+        void validateResultsImpl() final
+        {
+            auto& dataInstance = Base::DataStorage::instance();
+
+            const int64_t sizeD = Base::mM * Base::mN;
+
+            // Cache current kernel result from device
+            dataInstance->copyData(dataInstance->hostOut(), dataInstance->deviceOut(), sizeD);
+
+            auto const* in  = dataInstance->hostIn().get();
+            auto        ref = std::vector<DataT>(sizeD, static_cast<DataT>(0));
+
+            // First max of each block row, then of its right neighbour, replaced only by
+            // strictly greater values. Results are stored col_major.
+            auto blocksN = Base::mN / BlockN;
+            for(uint32_t row = 0; row < Base::mM; row++)
+            {
+                for(uint32_t blockCol = 0; blockCol < blocksN; blockCol++)
+                {
+                    auto best  = -std::numeric_limits<double>::infinity();
+                    auto index = -1;
+                    for(auto b : {blockCol, (blockCol + 1) % blocksN})
+                    {
+                        for(uint32_t j = 0; j < BlockN; j++)
+                        {
+                            auto value = static_cast<double>(in[this->index(row, b * BlockN + j)]);
+                            if(value > best)
+                            {
+                                best  = value;
+                                index = topkTestColOffset(b, BlockN) + j;
+                            }
+                        }
+                    }
+
+                    ref[int64_t(blockCol * BlockN) * Base::mM + row] = static_cast<DataT>(best);
+                    ref[int64_t(blockCol * BlockN + 1) * Base::mM + row]
+                        = static_cast<DataT>(index);
+                }
+            }
+
+            double errorTolerance = 10.0;
+
+            std::tie(Base::mValidationResult, Base::mMaxRelativeError)
+                = compareEqual<DataT, DataT, col_major, col_major>(
+                    dataInstance->hostOut().get(), ref.data(), Base::mM, Base::mN, errorTolerance);
+        }
+
+        typename Base::KernelFunc kernelImpl() const final
+        {
+            return typename Base::KernelFunc(ArgmaxRows<BlockM, BlockN, DataT, Layout>);
+        }
+    };
+
+    struct OnlineSoftmaxRowsGenerator
+    {
+        // Indices to test parameters
+        enum : uint32_t
+        {
+            DataT  = 0,
+            BlockM = 1,
+            BlockN = 2,
+            Layout = 3
+        };
+
+        using ResultT = std::shared_ptr<KernelI>;
+
+        template <typename... Ts>
+        static ResultT generate(std::tuple<Ts...> testParams)
+        {
+            // Map GTest params to Kernel params
+            using TestParamsT = std::tuple<Ts...>;
+            using KernelT
+                = OnlineSoftmaxRowsKernel<std::tuple_element_t<BlockM, TestParamsT>::value, // BlockM
+                                          std::tuple_element_t<BlockN, TestParamsT>::value, // BlockN
+                                          std::tuple_element_t<DataT, TestParamsT>, // DataT
+                                          std::tuple_element_t<Layout, TestParamsT>>; // Layout
+
+            return std::make_shared<KernelT>();
+        }
+    };
+
+    struct TopkRowsGenerator
+    {
+        // Indices to test parameters
+        enum : uint32_t
+        {
+            DataT  = 0,
+            BlockM = 1,
+            BlockN = 2,
+            Layout = 3,
+            K      = 4
+        };
+
+        using ResultT = std::shared_ptr<KernelI>;
+
+        template <typename... Ts>
+        static ResultT generate(std::tuple<Ts...> testParams)
+        {
+            // Map GTest params to Kernel params
+            using TestParamsT = std::tuple<Ts...>;
+            using KernelT = TopkRowsKernel<std::tuple_element_t<BlockM, TestParamsT>::value, // BlockM
+                                           std::tuple_element_t<BlockN, TestParamsT>::value, // BlockN
+                                           std::tuple_element_t<DataT, TestParamsT>, // DataT
+                                           std::tuple_element_t<Layout, TestParamsT>, // Layout
+                                           std::tuple_element_t<K, TestParamsT>::value>; // K
+
+            return std::make_shared<KernelT>();
+        }
+    };
+
+    struct ArgmaxRowsGenerator
+    {
+        // Indices to test parameters
+        enum : uint32_t
+        {
+            DataT  = 0,
+            BlockM = 1,
+            BlockN = 2,
+            Layout = 3
+        };
+
+        using ResultT = std::shared_ptr<KernelI>;
+
+        template <typename... Ts>
+        static ResultT generate(std::tuple<Ts...> testParams)
+        {
+            // Map GTest params to Kernel params
+            using TestParamsT = std::tuple<Ts...>;
+            using KernelT
+                = ArgmaxRowsKernel<std::tuple_element_t<BlockM, TestParamsT>::value, // BlockM
+                                   std::tuple_element_t<BlockN, TestParamsT>::value, // BlockN
+                                   std::tuple_element_t<DataT, TestParamsT>, // DataT
+                                   std::tuple_element_t<Layout, TestParamsT>>; // Layout
+
+            return std::make_shared<KernelT>();
+        }
+    };
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_DETAIL_SOFTMAX_TOPK_HPP
@@ -0,0 +1,229 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_DEVICE_SOFTMAX_TOPK_HPP
+#define ROCWMMA_DEVICE_SOFTMAX_TOPK_HPP
+
+#include <rocwmma/internal/mapping_util.hpp>
+#include <rocwmma/rocwmma.hpp>
+#include <rocwmma/rocwmma_epilogue.hpp>
+#include <rocwmma/rocwmma_transforms.hpp>
+
+#include "unit_test_traits.hpp"
+
+namespace rocwmma
+{
+
+    // Input value at (row, col), in [-4, 3.5] and exact in all tested types.
+    // Values repeat every 61 columns, giving ties in the wider blocks.
+    ROCWMMA_HOST_DEVICE constexpr inline float32_t softmaxTopkTestValue(uint32_t row,
+                                                                          uint32_t col)
+    {
+        return static_cast<float32_t>((row * 37u + col * 23u) % 61u) / 8.0f - 4.0f;
+    }
+
+    // Input scale of the softmax, as 1 / temperature
+    constexpr float32_t softmaxTestScale = 0.5f;
+
+    // Column index of the first column of a block, kept small enough to be exact in float16_t
+    ROCWMMA_HOST_DEVICE constexpr inline uint32_t topkTestColOffset(uint32_t blockCol,
+                                                                    uint32_t blockN)
+    {
+        return (blockCol % 4u) * blockN;
+    }
+
+    // Each block (r, c) is one half of the row block of (r, c) and its right neighbour
+    // (r, c + 1), wrapping around. The block is folded first, then its neighbour.
+    // out(r, c) = softmax over both blocks, at the columns of block c
+    template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename DataLayout>
+    __global__ void OnlineSoftmaxRows(uint32_t     m,
+                                      uint32_t     n,
+                                      DataT const* in,
+                                      DataT*       out,
+                                      uint32_t     ld,
+                                      DataT        param1,
+                                      DataT        param2)
+    {
+        if constexpr(FragSize_guard<BlockM,
+                                    BlockN,
+                                    DataT,
+                                    DataLayout,
+                                    Constants::AMDGCN_WAVE_SIZE,
+                                    Constants::AMDGCN_CURRENT_ARCH_ID>::enable())
+        {
+            using Mapping = MappingUtil<BlockM, BlockN, DataT, DataLayout>;
+            using FragT   = fragment<accumulator, BlockM, BlockN, 1, DataT, DataLayout>;
+
+            // Mapping:
+            // Incoming -> Matrix C (RowNT)
+            // BlockM -> BlockM
+            // BlockN -> BlockN
+            // <Dummy> -> BlockK
+            auto frag     = FragT();
+            auto fragNext = FragT();
+            auto fragMax  = FragT();
+            auto fragSum  = FragT();
+
+            auto coord     = Mapping::matrixCoord();
+            auto coordNext = make_coord2d(get<0>(coord), (get<1>(coord) + BlockN) % n);
+            load_matrix_sync(frag, Mapping::dataCoord(in, ld), ld);
+            load_matrix_sync(fragNext, Mapping::dataCoord(in, coordNext, ld), ld);
+
+            fill_fragment(fragMax, numeric_limits<DataT>::lowest());
+            fill_fragment(fragSum, static_cast<DataT>(0));
+
+            // Fold both blocks, then rescale and normalize the first
+            online_softmax_rows(frag, fragMax, fragSum, softmaxTestScale);
+            auto correction = online_softmax_rows(fragNext, fragMax, fragSum, softmaxTestScale);
+
+            for(uint32_t i = 0; i < FragT::num_elements; i++)
+            {
+                frag.x[i] = static_cast<DataT>(static_cast<float32_t>(frag.x[i])
+                                               * static_cast<float32_t>(correction.x[i])
+                                               / static_cast<float32_t>(fragSum.x[i]));
+            }
+
+            store_matrix_sync(Mapping::dataCoord(out, ld), frag, ld);
+        }
+    }
+
+    // Top K of the rows of each block. Out is col_major m x n:
+    // out(row, c + j) = vals[j], out(row, c + K + j) = idx[j], for the first column c of the block.
+    template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename DataLayout, uint32_t K>
+    __global__ void TopkRows(uint32_t     m,
+                             uint32_t     n,
+                             DataT const* in,
+                             DataT*       out,
+                             uint32_t     ld,
+                             DataT        param1,
+                             DataT        param2)
+    {
+        if constexpr(FragSize_guard<BlockM,
+                                    BlockN,
+                                    DataT,
+                                    DataLayout,
+                                    Constants::AMDGCN_WAVE_SIZE,
+                                    Constants::AMDGCN_CURRENT_ARCH_ID>::enable())
+        {
+            using Mapping  = MappingUtil<BlockM, BlockN, DataT, DataLayout>;
+            using FragT    = fragment<accumulator, BlockM, BlockN, 1, DataT, DataLayout>;
+            using FragIdxT = fragment<accumulator, BlockM, BlockN, 1, int32_t, DataLayout>;
+
+            static_assert(2u * K <= BlockN, "Candidates must fit in the block columns");
+
+            // Mapping:
+            // Incoming -> Matrix C (RowNT)
+            // BlockM -> BlockM
+            // BlockN -> BlockN
+            // <Dummy> -> BlockK
+            auto frag = FragT();
+            FragT    vals[K];
+            FragIdxT idx[K];
+            for(uint32_t j = 0; j < K; j++)
+            {
+                fill_fragment(vals[j], numeric_limits<DataT>::lowest());
+                fill_fragment(idx[j], -1);
+            }
+
+            auto coord = Mapping::matrixCoord();
+            load_matrix_sync(frag, Mapping::dataCoord(in, ld), ld);
+            topk_rows(frag, topkTestColOffset(get<1>(coord) / BlockN, BlockN), vals, idx);
+
+            // Candidates as column vectors
+            auto* write = out + get<1>(coord) * m + get<0>(coord);
+            for(uint32_t j = 0; j < K; j++)
+            {
+                auto fragIdx = FragT();
+                for(uint32_t i = 0; i < FragT::num_elements; i++)
+                {
+                    fragIdx.x[i] = static_cast<DataT>(idx[j].x[i]);
+                }
+
+                store_col_vector_sync(write + j * m, vals[j]);
+                store_col_vector_sync(write + (K + j) * m, fragIdx);
+            }
+        }
+    }
+
+    // Running argmax of the rows of each block (r, c) and its right neighbour (r, c + 1),
+    // wrapping around. The block is folded first, then its neighbour. Out is col_major m x n:
+    // out(row, c) = max, out(row, c + 1) = idx, for the first column c of the block.
+    template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename DataLayout>
+    __global__ void ArgmaxRows(uint32_t     m,
+                               uint32_t     n,
+                               DataT const* in,
+                               DataT*       out,
+                               uint32_t     ld,
+                               DataT        param1,
+                               DataT        param2)
+    {
+        if constexpr(FragSize_guard<BlockM,
+                                    BlockN,
+                                    DataT,
+                                    DataLayout,
+                                    Constants::AMDGCN_WAVE_SIZE,
+                                    Constants::AMDGCN_CURRENT_ARCH_ID>::enable())
+        {
+            using Mapping  = MappingUtil<BlockM, BlockN, DataT, DataLayout>;
+            using FragT    = fragment<accumulator, BlockM, BlockN, 1, DataT, DataLayout>;
+            using FragIdxT = fragment<accumulator, BlockM, BlockN, 1, int32_t, DataLayout>;
+
+            // Mapping:
+            // Incoming -> Matrix C (RowNT)
+            // BlockM -> BlockM
+            // BlockN -> BlockN
+            // <Dummy> -> BlockK
+            auto frag     = FragT();
+            auto fragNext = FragT();
+            auto vals     = FragT();
+            auto idx      = FragIdxT();
+
+            auto coord     = Mapping::matrixCoord();
+            auto coordNext = make_coord2d(get<0>(coord), (get<1>(coord) + BlockN) % n);
+            load_matrix_sync(frag, Mapping::dataCoord(in, ld), ld);
+            load_matrix_sync(fragNext, Mapping::dataCoord(in, coordNext, ld), ld);
+
+            fill_fragment(vals, numeric_limits<DataT>::lowest());
+            fill_fragment(idx, -1);
+
+            argmax_rows(frag, topkTestColOffset(get<1>(coord) / BlockN, BlockN), vals, idx);
+            argmax_rows(
+                fragNext, topkTestColOffset(get<1>(coordNext) / BlockN, BlockN), vals, idx);
+
+            auto fragIdx = FragT();
+            for(uint32_t i = 0; i < FragT::num_elements; i++)
+            {
+                fragIdx.x[i] = static_cast<DataT>(idx.x[i]);
+            }
+
+            auto* write = out + get<1>(coord) * m + get<0>(coord);
+            store_col_vector_sync(write, vals);
+            store_col_vector_sync(write + m, fragIdx);
+        }
+    }
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_DEVICE_SOFTMAX_TOPK_HPP
@@ -0,0 +1,162 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef ROCWMMA_DEVICE_TENSOR_LOAD_STORE_HPP
+#define ROCWMMA_DEVICE_TENSOR_LOAD_STORE_HPP
+
+#include <rocwmma/internal/mapping_util.hpp>
+#include <rocwmma/rocwmma.hpp>
+
+#include "unit_test_traits.hpp"
+
+namespace rocwmma
+{
+
+    // Matrix row read through the test view at view row (s, h) = (row / 8, row % 8).
+    // Swaps the two outer modes, e.g. viewing a BHSD tensor as BSHD.
+    ROCWMMA_HOST_DEVICE constexpr inline uint32_t tensorTestRow(uint32_t row, uint32_t m)
+    {
+        return (row % 8u) * (m / 8u) + row / 8u;
+    }
+
+    // The m x n matrix is the tensor (h, s, c) of extents (8, m / 8, n). The view folds
+    // rows as (s, h) and columns as (c), such that vectors along the columns stay
+    // contiguous, and vectors along the rows are strided.
+    template <typename DataLayout>
+    ROCWMMA_DEVICE inline tensor_view tensorTestView(uint32_t m, uint32_t n, uint32_t ld)
+    {
+        int64_t rowStride = is_same<DataLayout, row_major>::value ? ld : 1;
+        int64_t colStride = is_same<DataLayout, row_major>::value ? 1 : ld;
+
+        uint32_t extents[] = {8u, m / 8u, n};
+        int64_t  strides[] = {(m / 8u) * rowStride, rowStride, colStride};
+        return make_tensor_view("hsc", extents, strides, "sh", "c");
+    }
+
+    // out[row] = in[tensorTestRow(row)]
+    template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename DataLayout>
+    __global__ void TensorLoadA(uint32_t     m,
+                                uint32_t     n,
+                                DataT const* in,
+                                DataT*       out,
+                                uint32_t     ld,
+                                DataT        param1,
+                                DataT        param2)
+    {
+        if constexpr(FragSize_guard<BlockM,
+                                    BlockN,
+                                    DataT,
+                                    DataLayout,
+                                    Constants::AMDGCN_WAVE_SIZE,
+                                    Constants::AMDGCN_CURRENT_ARCH_ID>::enable())
+        {
+            using Mapping = MappingUtil<BlockM, BlockN, DataT, DataLayout>;
+
+            // Mapping:
+            // Incoming -> Matrix A (ColNT)
+            // BlockM -> BlockM
+            // <Dummy> -> BlockN
+            // BlockN -> BlockK
+            auto frag = fragment<matrix_a, BlockM, 1, BlockN, DataT, DataLayout>();
+
+            // Load through the view, then store in place
+            auto view  = tensorTestView<DataLayout>(m, n, ld);
+            auto coord = Mapping::matrixCoord();
+            load_matrix_tensor_sync(frag, in, view, get<0>(coord), get<1>(coord));
+            store_matrix_sync(Mapping::dataCoord(out, ld), frag, ld);
+        }
+    }
+
+    // out[row] = in[tensorTestRow(row)]
+    template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename DataLayout>
+    __global__ void TensorLoadB(uint32_t     m,
+                                uint32_t     n,
+                                DataT const* in,
+                                DataT*       out,
+                                uint32_t     ld,
+                                DataT        param1,
+                                DataT        param2)
+    {
+        if constexpr(FragSize_guard<BlockM,
+                                    BlockN,
+                                    DataT,
+                                    DataLayout,
+                                    Constants::AMDGCN_WAVE_SIZE,
+                                    Constants::AMDGCN_CURRENT_ARCH_ID>::enable())
+        {
+            using Mapping = MappingUtil<BlockM, BlockN, DataT, DataLayout>;
+
+            // Mapping:
+            // Incoming -> Matrix B (RowNT)
+            // <Dummy> -> BlockM
+            // BlockN -> BlockN
+            // BlockM -> BlockK
+            auto frag = fragment<matrix_b, 1, BlockN, BlockM, DataT, DataLayout>();
+
+            // Load through the view, then store in place
+            auto view  = tensorTestView<DataLayout>(m, n, ld);
+            auto coord = Mapping::matrixCoord();
+            load_matrix_tensor_sync(frag, in, view, get<0>(coord), get<1>(coord));
+            store_matrix_sync(Mapping::dataCoord(out, ld), frag, ld);
+        }
+    }
+
+    // out[tensorTestRow(row)] = in[row]
+    template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename DataLayout>
+    __global__ void TensorStoreAcc(uint32_t     m,
+                                   uint32_t     n,
+                                   DataT const* in,
+                                   DataT*       out,
+                                   uint32_t     ld,
+                                   DataT        param1,
+                                   DataT        param2)
+    {
+        if constexpr(FragSize_guard<BlockM,
+                                    BlockN,
+                                    DataT,
+                                    DataLayout,
+                                    Constants::AMDGCN_WAVE_SIZE,
+                                    Constants::AMDGCN_CURRENT_ARCH_ID>::enable())
+        {
+            using Mapping = MappingUtil<BlockM, BlockN, DataT, DataLayout>;
+
+            // Mapping:
+            // Incoming -> Matrix C (RowNT)
+            // BlockM -> BlockM
+            // BlockN -> BlockN
+            // <Dummy> -> BlockK
+            auto frag = fragment<accumulator, BlockM, BlockN, 1, DataT, DataLayout>();
+
+            // Load in place, then store through the view
+            auto view  = tensorTestView<DataLayout>(m, n, ld);
+            auto coord = Mapping::matrixCoord();
+            load_matrix_sync(frag, Mapping::dataCoord(in, ld), ld);
+            store_matrix_tensor_sync(out, frag, view, get<0>(coord), get<1>(coord));
+        }
+    }
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_DEVICE_TENSOR_LOAD_STORE_HPP
@@ -31,6 +31,7 @@
 #include <sstream>
 #include <string>
 
+#include "benchmark_log.hpp"
 #include "hip_device.hpp"
 #include "unit_resource.hpp"
 
@@ -53,13 +54,14 @@ namespace rocwmma
         KernelI()          = default;
         virtual ~KernelI() = default;
 
-        virtual void          setup(ProblemParams const& problem)                 = 0;
-        virtual void          validateResults()                                   = 0;
-        virtual void          reportResults()                                     = 0;
-        virtual void          tearDown()                                          = 0;
-        virtual void          exec()                                              = 0;
-        virtual std::ostream& printHeader(std::ostream& stream = std::cout) const = 0;
-        virtual std::ostream& printKernel(std::ostream& stream = std::cout) const = 0;
+        virtual void            setup(ProblemParams const& problem)                 = 0;
+        virtual void            validateResults()                                   = 0;
+        virtual void            reportResults()                                     = 0;
+        virtual void            tearDown()                                          = 0;
+        virtual void            exec()                                              = 0;
+        virtual std::ostream&   printHeader(std::ostream& stream = std::cout) const = 0;
+        virtual std::ostream&   printKernel(std::ostream& stream = std::cout) const = 0;
+        virtual BenchmarkRecord benchmarkRecord() const                             = 0;
 
         bool runFlag() const
         {
@@ -128,18 +130,25 @@ namespace rocwmma
         virtual bool checkLds() const;
         virtual bool checkQuirks() const;
 
+        // Bandwidth benchmarks report the bytes moved by one kernel run
+        // and a kernel config string for the benchmark record.
+        // Kernels that don't move a known amount of data return 0.
+        virtual float64_t   ioBytes() const;
+        virtual std::string kernelConfig() const;
+
         // Reset all members to default values
         virtual void reset();
 
     public:
         // KernelI interface fulfillment
-        virtual void          setup(ProblemParams const& problem) override;
-        virtual void          exec() override;
-        virtual void          validateResults() override;
-        virtual void          reportResults() override;
-        virtual void          tearDown() override;
-        virtual std::ostream& printHeader(std::ostream& stream = std::cout) const override;
-        virtual std::ostream& printKernel(std::ostream& stream = std::cout) const override;
+        virtual void            setup(ProblemParams const& problem) override;
+        virtual void            exec() override;
+        virtual void            validateResults() override;
+        virtual void            reportResults() override;
+        virtual void            tearDown() override;
+        virtual std::ostream&   printHeader(std::ostream& stream = std::cout) const override;
+        virtual std::ostream&   printKernel(std::ostream& stream = std::cout) const override;
+        virtual BenchmarkRecord benchmarkRecord() const override;
 
     protected:
         // Problem params for kernel
@@ -149,12 +158,16 @@ namespace rocwmma
         DataT    mParam1, mParam2;
 
         // Execution flow control
-        double mMaxRelativeError;
+        uint32_t mColdRuns;
+        uint32_t mHotRuns;
+        double   mMaxRelativeError;
 
         // Performance
-        float64_t mTotalGFlops, mMeasuredTFlopsPerSec;
-        float64_t mElapsedTimeMs;
-        int32_t   mEfficiency;
+        float64_t   mTotalGFlops, mMeasuredTFlopsPerSec;
+        float64_t   mMeasuredGBytesPerSec;
+        float64_t   mElapsedTimeMs;
+        int32_t     mEfficiency;
+        TimingStats mTiming;
     };
 
 } // namespace rocwmma
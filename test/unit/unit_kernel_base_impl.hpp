@@ -27,7 +27,9 @@
 #ifndef ROCWMMA_UNIT_KERNEL_BASE_IMPL_HPP
 #define ROCWMMA_UNIT_KERNEL_BASE_IMPL_HPP
 
+#include <cmath>
 #include <tuple>
+#include <vector>
 
 #include <hip/hip_ext.h>
 #include <hip/hip_runtime_api.h>
@@ -121,6 +123,18 @@ namespace rocwmma
         return true;
     }
 
+    template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename Layout>
+    float64_t UnitKernelBase<BlockM, BlockN, DataT, Layout>::ioBytes() const
+    {
+        return 0.0;
+    }
+
+    template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename Layout>
+    std::string UnitKernelBase<BlockM, BlockN, DataT, Layout>::kernelConfig() const
+    {
+        return "";
+    }
+
     template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename Layout>
     void UnitKernelBase<BlockM, BlockN, DataT, Layout>::reset()
     {
@@ -133,9 +147,16 @@ namespace rocwmma
         mValidationResult = false;
         mMaxRelativeError = 0.0;
 
+        // Benchmarks warm up, then time several runs.
+        // Otherwise a single run is enough for validation.
+        mColdRuns = (bool)(ROCWMMA_BENCHMARK_TESTS) ? 1u : 0u;
+        mHotRuns  = (bool)(ROCWMMA_BENCHMARK_TESTS) ? 5u : 1u;
+
         mTotalGFlops = mMeasuredTFlopsPerSec = 0.0;
+        mMeasuredGBytesPerSec                = 0.0;
         mElapsedTimeMs                       = 0.0;
-        mEfficiency                          = 0.0;
+        mEfficiency                          = 0;
+        mTiming                              = {0.0, 0.0, 0.0, 0.0};
     }
 
     template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename Layout>
@@ -144,8 +165,8 @@ namespace rocwmma
     {
 
         return stream << "WSize, TBlkX, TBlkY, BlkM, BlkN, MatM, MatN, Param1, ld, Param2, "
-                         "Lyt, Td, elapsedMs, Problem Size(GFlops), TFlops/s, Efficiency(%), "
-                         "Result"
+                         "Lyt, Td, elapsedMs, Problem Size(GFlops), TFlops/s, GB/s, "
+                         "Efficiency(%), Result"
                       << std::endl;
     }
 
@@ -168,18 +189,55 @@ namespace rocwmma
                    << ", "
                    << "n/a"
                    << ", "
+                   << "n/a"
+                   << ", "
                    << " SKIPPED" << std::endl;
         }
         else
         {
             stream << mElapsedTimeMs << ", " << mTotalGFlops << ", " << mMeasuredTFlopsPerSec
-                   << ", " << mEfficiency << ", " << (mValidationResult ? "PASSED" : "FAILED")
-                   << std::endl;
+                   << ", " << mMeasuredGBytesPerSec << ", " << mEfficiency << ", "
+                   << (mValidationResult ? "PASSED" : "FAILED") << std::endl;
         }
 
         return stream;
     }
 
+    template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename Layout>
+    BenchmarkRecord UnitKernelBase<BlockM, BlockN, DataT, Layout>::benchmarkRecord() const
+    {
+        std::stringstream problemType;
+        problemType << dataTypeToString<DataT>() << "_" << dataTypeToString<Layout>();
+
+        std::stringstream config;
+        config << "BlkM" << BlockM << "_BlkN" << BlockN;
+        if(auto extra = kernelConfig(); !extra.empty())
+        {
+            config << "_" << extra;
+        }
+
+        // Unit kernels are data movement benchmarks: the roof is
+        // the device bandwidth and efficiency is a percent of it.
+        return {"unit",
+                static_cast<uint32_t>(DeviceInfo::instance()->getGcnArch()),
+                problemType.str(),
+                config.str(),
+                mTBlockX,
+                mTBlockY,
+                mM,
+                mN,
+                1u,
+                1u,
+                mRunFlag ? mHotRuns : 0u,
+                mTiming,
+                mTotalGFlops,
+                mMeasuredTFlopsPerSec,
+                mEfficiency,
+                0.0,
+                "Memory",
+                mRunFlag ? (mValidationResult ? "PASSED" : "FAILED") : "SKIPPED"};
+    }
+
     template <uint32_t BlockM, uint32_t BlockN, typename DataT, typename Layout>
     void UnitKernelBase<BlockM, BlockN, DataT, Layout>::setup(ProblemParams const& problem)
     {
@@ -214,35 +272,73 @@ namespace rocwmma
     {
         if(mRunFlag)
         {
-            hipEvent_t startEvent, stopEvent;
-            CHECK_HIP_ERROR(hipEventCreate(&startEvent));
-            CHECK_HIP_ERROR(hipEventCreate(&stopEvent));
-
             auto& dataInstance = DataStorage::instance();
 
-            hipExtLaunchKernelGGL((kernelImpl()), // Kernel to launch
-                                  (gridDim()), // Wg grid size
-                                  (blockDim()), // Thread block size
-                                  (ldsUsage()), // sharedMemBytes
-                                  0, // stream
-                                  startEvent, // Event start
-                                  stopEvent, // event stop
-                                  0, // flags
-                                  mM, // M
-                                  mN, // N
-                                  dataInstance->deviceIn().get(), // In*
-                                  dataInstance->deviceOut().get(), // Out*
-                                  mLd, // ld
-                                  mParam1, // param1
-                                  mParam2); // param2
-
-            auto timeMs = 0.0f;
-            CHECK_HIP_ERROR(hipEventSynchronize(stopEvent));
-            CHECK_HIP_ERROR(hipEventElapsedTime(&timeMs, startEvent, stopEvent));
-            CHECK_HIP_ERROR(hipEventDestroy(startEvent));
-            CHECK_HIP_ERROR(hipEventDestroy(stopEvent));
-
-            mElapsedTimeMs = float64_t(timeMs);
+            auto unitKernel = [this, &dataInstance](hipEvent_t startEvent, hipEvent_t stopEvent) {
+                hipExtLaunchKernelGGL((kernelImpl()), // Kernel to launch
+                                      (gridDim()), // Wg grid size
+                                      (blockDim()), // Thread block size
+                                      (ldsUsage()), // sharedMemBytes
+                                      0, // stream
+                                      startEvent, // Event start
+                                      stopEvent, // event stop
+                                      0, // flags
+                                      mM, // M
+                                      mN, // N
+                                      dataInstance->deviceIn().get(), // In*
+                                      dataInstance->deviceOut().get(), // Out*
+                                      mLd, // ld
+                                      mParam1, // param1
+                                      mParam2); // param2
+            };
+
+            // Cold runs for frequency warm-up
+            for(uint32_t i = 0; i < mColdRuns; ++i)
+            {
+                unitKernel(nullptr, nullptr);
+            }
+
+            // Events around each hot run give the per-run samples
+            std::vector<hipEvent_t> runEvents(mHotRuns + 1u);
+            for(auto& event : runEvents)
+            {
+                CHECK_HIP_ERROR(hipEventCreate(&event));
+            }
+            for(uint32_t i = 0; i < mHotRuns; ++i)
+            {
+                unitKernel(runEvents[i], runEvents[i + 1u]);
+            }
+            CHECK_HIP_ERROR(hipEventSynchronize(runEvents[mHotRuns]));
+
+            std::vector<double> runTimesMs(mHotRuns);
+            for(uint32_t i = 0; i < mHotRuns; ++i)
+            {
+                auto runMs = 0.0f;
+                CHECK_HIP_ERROR(hipEventElapsedTime(&runMs, runEvents[i], runEvents[i + 1u]));
+                runTimesMs[i] = runMs;
+            }
+            for(auto& event : runEvents)
+            {
+                CHECK_HIP_ERROR(hipEventDestroy(event));
+            }
+
+            mTiming        = calculateTimingStats(runTimesMs);
+            mElapsedTimeMs = mTiming.mMedianMs;
+
+            // Bandwidth against the device peak, when the kernel
+            // reports the bytes it moves.
+            auto totalBytes = ioBytes();
+            if(totalBytes > 0.0 && mElapsedTimeMs > 0.0)
+            {
+                auto peakGBytesPerSec = DeviceInfo::instance()->peakGBytesPerSec();
+
+                mMeasuredGBytesPerSec = totalBytes * 1.0e-6 / mElapsedTimeMs;
+                mEfficiency
+                    = peakGBytesPerSec > 0.0
+                          ? static_cast<int32_t>(
+                              std::round(mMeasuredGBytesPerSec / peakGBytesPerSec * 100.0))
+                          : -1;
+            }
         }
     }
 
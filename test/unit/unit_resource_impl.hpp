@@ -39,8 +39,8 @@ namespace rocwmma
     UnitResource<DataT>::UnitResource()
         : mDeviceIn(nullptr, [](DataT*) {})
         , mDeviceOut(nullptr, [](DataT*) {})
-        , mHostIn(nullptr)
-        , mHostOut(nullptr)
+        , mHostIn(nullptr, [](DataT*) {})
+        , mHostOut(nullptr, [](DataT*) {})
         , mCurrentProblemSize({0, 0})
         , mMaxCapacity(0)
     {
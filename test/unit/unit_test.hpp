@@ -29,6 +29,7 @@
 
 #include <gtest/gtest.h>
 
+#include "perf_golden.hpp"
 #include "unit_kernel_base.hpp"
 #include "unit_test_params.hpp"
 
@@ -83,8 +84,14 @@ namespace rocwmma
             kernel->validateResults();
             kernel->reportResults();
 
+            // Structured record for -bo || --bench_output and baseline compare
+            BenchmarkLog::instance()->record(kernel->benchmarkRecord());
+
             // Mark test failures in GTest
             EXPECT_TRUE(kernel->validationResult());
+
+            // Throughput against golden with -pg || --perf_golden
+            expectPerfGolden();
         }
 
         void TearDown() override
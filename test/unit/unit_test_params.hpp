@@ -183,6 +183,14 @@ namespace rocwmma
                  {3584, 3584},
                  {4096, 4096},
 #endif // ROCWMMA_EXTENDED_TESTS
+
+#if ROCWMMA_BENCHMARK_TESTS
+                 // Large enough to stream from HBM rather than cache
+#if !ROCWMMA_EXTENDED_TESTS
+                 {4096, 4096},
+#endif // !ROCWMMA_EXTENDED_TESTS
+                 {8192, 8192},
+#endif // ROCWMMA_BENCHMARK_TESTS
         };
             // clang-format on
         }
@@ -0,0 +1,146 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef ROCWMMA_DETAIL_WARP_TILE_CONFIG_TEST_HPP
+#define ROCWMMA_DETAIL_WARP_TILE_CONFIG_TEST_HPP
+
+#include <limits>
+#include <sstream>
+
+#include "device/warp_tile_config.hpp"
+#include "unit_kernel_base.hpp"
+
+namespace rocwmma
+{
+
+    // Wrapper into the actual device function
+    template <uint32_t BlockN, typename ConfigDataT>
+    struct WarpTileConfigKernel final : public UnitKernelBase<1, BlockN, float32_t, row_major>
+    {
+    private:
+        using Base = UnitKernelBase<1, BlockN, float32_t, row_major>;
+
+        // Params, followed by the compiled wave size
+        constexpr static uint32_t ValueCount = 9u;
+
+    public:
+        WarpTileConfigKernel()        = default;
+        ~WarpTileConfigKernel() final = default;
+
+        void setupImpl(typename Base::DataStorage::ProblemSize const& probsize) final
+        {
+            auto& dataInstance = Base::DataStorage::instance();
+
+            // Initialize matrix storage
+            dataInstance->resizeStorage(probsize);
+
+            // Values not written by the kernel remain NaN
+            MatrixUtil<row_major>::fillValLaunchKernel(
+                dataInstance->deviceOut().get(),
+                Base::mM,
+                Base::mN,
+                std::numeric_limits<float32_t>::signaling_NaN());
+        }
+
+        bool checkSizes() const final
+        {
+            return Base::checkSizes() && (Base::mM * Base::mN >= ValueCount);
+        }
+
+        void validateResultsImpl() final
+        {
+            auto& dataInstance = Base::DataStorage::instance();
+
+            // Cache current kernel result from device
+            dataInstance->copyData(dataInstance->hostOut(), dataInstance->deviceOut(), ValueCount);
+
+            // The host must select the same config as the device code object of its arch,
+            // and the config wave size must match the compiled wave mode.
+            auto params = get_warp_tile_params<ConfigDataT>(
+                Base::DeviceInfo::instance()->getGcnArch());
+
+            uint32_t const expected[ValueCount] = {params.block_m,
+                                                   params.block_n,
+                                                   params.block_k,
+                                                   params.blocks_x,
+                                                   params.blocks_y,
+                                                   params.tblock_x,
+                                                   params.tblock_y,
+                                                   params.wave_size,
+                                                   params.wave_size};
+
+            auto const* out = dataInstance->hostOut().get();
+
+            Base::mValidationResult = true;
+            for(uint32_t i = 0u; i < ValueCount; i++)
+            {
+                Base::mValidationResult &= (out[i] == static_cast<float32_t>(expected[i]));
+            }
+            Base::mMaxRelativeError = Base::mValidationResult ? 0.0 : 1.0;
+        }
+
+        std::string kernelConfig() const final
+        {
+            std::stringstream config;
+            config << dataTypeToString<ConfigDataT>();
+            return config.str();
+        }
+
+        typename Base::KernelFunc kernelImpl() const final
+        {
+            return typename Base::KernelFunc(warpTileConfigTest<ConfigDataT>);
+        }
+    };
+
+    // This is the GeneratorImpl class
+    struct WarpTileConfigGenerator
+    {
+        // Indices to test parameters
+        enum : uint32_t
+        {
+            BlockN      = 0,
+            ConfigDataT = 1
+        };
+
+        using ResultT = std::shared_ptr<KernelI>;
+
+        template <typename... Ts>
+        static ResultT generate(std::tuple<Ts...> testParams)
+        {
+            // Map GTest params to Kernel params
+            using TestParamsT = std::tuple<Ts...>;
+            using KernelT     = WarpTileConfigKernel<
+                std::tuple_element_t<BlockN, TestParamsT>::value, // BlockN
+                std::tuple_element_t<ConfigDataT, TestParamsT> // ConfigDataT
+                >;
+
+            return std::make_shared<KernelT>();
+        }
+    };
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_DETAIL_WARP_TILE_CONFIG_TEST_HPP
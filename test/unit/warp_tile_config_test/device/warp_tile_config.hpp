@@ -0,0 +1,70 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2021-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef ROCWMMA_DEVICE_WARP_TILE_CONFIG_TEST_HPP
+#define ROCWMMA_DEVICE_WARP_TILE_CONFIG_TEST_HPP
+
+#include <rocwmma/rocwmma.hpp>
+#include <rocwmma/rocwmma_tile.hpp>
+
+namespace rocwmma
+{
+
+    // Writes the params of the warp tile config compiled for the current target to the
+    // first row of out, followed by the wave size of the compiled wave mode.
+    template <typename ConfigDataT>
+    __global__ void warpTileConfigTest(uint32_t         m,
+                                       uint32_t         n,
+                                       float32_t const* in,
+                                       float32_t*       out,
+                                       uint32_t         ld,
+                                       float32_t        param1,
+                                       float32_t        param2)
+    {
+        if(threadIdx.x == 0u && threadIdx.y == 0u && blockIdx.x == 0u && blockIdx.y == 0u)
+        {
+            constexpr auto Params = warp_tile_config_t<ConfigDataT>::params();
+
+            uint32_t const values[] = {Params.block_m,
+                                       Params.block_n,
+                                       Params.block_k,
+                                       Params.blocks_x,
+                                       Params.blocks_y,
+                                       Params.tblock_x,
+                                       Params.tblock_y,
+                                       Params.wave_size,
+                                       Constants::AMDGCN_WAVE_SIZE};
+
+            for(uint32_t i = 0u; i < sizeof(values) / sizeof(values[0]); i++)
+            {
+                out[i] = static_cast<float32_t>(values[i]);
+            }
+        }
+    }
+
+} // namespace rocwmma
+
+#endif // ROCWMMA_DEVICE_WARP_TILE_CONFIG_TEST_HPP